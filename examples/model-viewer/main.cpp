@@ -28,6 +28,7 @@ using namespace gfx;
 // just to keep the code short. Note that the Slang API does
 // not use or require any C++ standard library features.
 //
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
@@ -657,33 +658,127 @@ struct ParameterBlock : RefObject
     ParameterBlockEncoder beginEncoding();
 };
 
+// Transient parameter blocks are allocated many times per frame
+// (one per view, and one per batch of model instances), so creating a fresh constant buffer for each of them
+// would put buffer creation on the hot path of every frame.
+//
+// Instead, transient blocks take their constant buffers from a
+// ring with one pool of buffers per frame in flight. Buffers are
+// grouped by size, and a buffer handed out in one frame is only
+// handed out again once the ring comes back around to that frame,
+// by which time the GPU is done reading it.
+//
+// Note: our graphics API abstraction binds a whole buffer as a
+// constant buffer, so the "ring" here is a ring of buffers. An
+// application driving D3D12 or Vulkan directly would more likely
+// sub-allocate every transient block out of one large mapped
+// buffer per frame, and bind each block at an offset.
+//
+struct TransientConstantBufferRing : RefObject
+{
+    // The number of frames the CPU may be ahead of the GPU,
+    // plus the frame being recorded.
+    //
+    enum { kFrameCount = 3 };
+
+    RefPtr<gfx::Renderer> renderer;
+
+    // For each size of buffer, the buffers allocated so far,
+    // and how many of them have been handed out this frame.
+    //
+    struct SizePool
+    {
+        std::vector<RefPtr<BufferResource>> buffers;
+        size_t                              usedCount = 0;
+    };
+    std::map<size_t, SizePool> framePools[kFrameCount];
+    int frameIndex = 0;
+
+    TransientConstantBufferRing(gfx::Renderer* renderer)
+        : renderer(renderer)
+    {}
+
+    // At the start of each frame we move on to the next pool,
+    // making all of the buffers it handed out (three frames ago)
+    // available again.
+    //
+    void beginFrame()
+    {
+        frameIndex = (frameIndex + 1) % kFrameCount;
+        for(auto& entry : framePools[frameIndex])
+        {
+            entry.second.usedCount = 0;
+        }
+    }
+
+    // Allocating hands out the next unused buffer of the
+    // requested size, only creating a buffer when the pool
+    // has run out (which only happens in the first few frames,
+    // or when the scene grows).
+    //
+    RefPtr<BufferResource> allocate(size_t size)
+    {
+        SizePool& pool = framePools[frameIndex][size];
+        if(pool.usedCount < pool.buffers.size())
+        {
+            return pool.buffers[pool.usedCount++];
+        }
+
+        gfx::BufferResource::Desc bufferDesc;
+        bufferDesc.init(size);
+        bufferDesc.setDefaults(gfx::Resource::Usage::ConstantBuffer);
+        bufferDesc.cpuAccessFlags = gfx::Resource::AccessFlag::Write;
+        auto buffer = renderer->createBufferResource(
+            gfx::Resource::Usage::ConstantBuffer,
+            bufferDesc);
+        if(!buffer) return nullptr;
+
+        pool.buffers.push_back(buffer);
+        pool.usedCount++;
+        return buffer;
+    }
+};
+
 // Allocating a parameter block is mostly a matter of allocating
 // the required graphics API objects.
 //
 RefPtr<ParameterBlock> allocateParameterBlockImpl(
-    ParameterBlockLayout*   layout)
+    ParameterBlockLayout*           layout,
+    TransientConstantBufferRing*    transientRing)
 {
     auto renderer = layout->renderer;
 
     // A descriptor set is then used to provide the storage for all
     // resource parameters (including the primary constant buffer, if any).
+    // A transient descriptor set only lives until the end of the frame,
+    // which lets the renderer recycle all of them at once.
     //
-    auto descriptorSet = renderer->createDescriptorSet(
-        layout->descriptorSetLayout);
+    auto descriptorSet = transientRing
+        ? renderer->createTransientDescriptorSet(layout->descriptorSetLayout)
+        : renderer->createDescriptorSet(layout->descriptorSetLayout);
 
     // If the parameter block has any ordinary data, then it requires
-    // a "primary" constant buffer to hold that data.
+    // a "primary" constant buffer to hold that data. A transient
+    // block takes its buffer from the ring, while a persistent
+    // block owns its buffer outright.
     //
     RefPtr<gfx::BufferResource> primaryConstantBuffer = nullptr;
     if(auto primaryConstantBufferSize = layout->primaryConstantBufferSize)
     {
-        gfx::BufferResource::Desc bufferDesc;
-        bufferDesc.init(primaryConstantBufferSize);
-        bufferDesc.setDefaults(gfx::Resource::Usage::ConstantBuffer);
-        bufferDesc.cpuAccessFlags = gfx::Resource::AccessFlag::Write;
-        primaryConstantBuffer = renderer->createBufferResource(
-            gfx::Resource::Usage::ConstantBuffer,
-            bufferDesc);
+        if(transientRing)
+        {
+            primaryConstantBuffer = transientRing->allocate(primaryConstantBufferSize);
+        }
+        else
+        {
+            gfx::BufferResource::Desc bufferDesc;
+            bufferDesc.init(primaryConstantBufferSize);
+            bufferDesc.setDefaults(gfx::Resource::Usage::ConstantBuffer);
+            bufferDesc.cpuAccessFlags = gfx::Resource::AccessFlag::Write;
+            primaryConstantBuffer = renderer->createBufferResource(
+                gfx::Resource::Usage::ConstantBuffer,
+                bufferDesc);
+        }
 
         // The primary constant buffer will always be the first thing
         // stored in the descriptor set for a parameter block.
@@ -709,18 +804,22 @@ RefPtr<ParameterBlock> allocateParameterBlockImpl(
 // blocks that are allocated, filled in, and discarded within
 // a single frame.
 //
-// These two cases warrant very different allocation strategies,
-// but for now we are using the same logic in both cases.
+// These two cases warrant very different allocation strategies.
+// Transient blocks use transient descriptor sets, and take their
+// constant buffers from a `TransientConstantBufferRing`, so that
+// allocating them doesn't create any graphics API objects once
+// the application has been running for a few frames.
 //
 RefPtr<ParameterBlock> allocatePersistentParameterBlock(
     ParameterBlockLayout*   layout)
 {
-    return allocateParameterBlockImpl(layout);
+    return allocateParameterBlockImpl(layout, nullptr);
 }
 RefPtr<ParameterBlock> allocateTransientParameterBlock(
-    ParameterBlockLayout*   layout)
+    ParameterBlockLayout*           layout,
+    TransientConstantBufferRing*    transientRing)
 {
-    return allocateParameterBlockImpl(layout);
+    return allocateParameterBlockImpl(layout, transientRing);
 }
 
 // In order to fill in a parameter block, the application
@@ -1308,13 +1407,53 @@ struct Material : RefObject
     // block will be an implementation of `IMaterial` that
     // provides the evaluation logic for the material.
 
-    // Each subclass of `Material` will provide a routine to
-    // create a parameter block of its chosen type/layout.
-    virtual RefPtr<ParameterBlock> createParameterBlock() = 0;
+    // Each subclass of `Material` will provide the layout of
+    // its chosen type, and a routine to write its parameters
+    // into a block of that layout.
+    virtual ParameterBlockLayout* getParameterBlockLayout() = 0;
+    virtual void fillInParameterBlock(ParameterBlockEncoder& encoder) = 0;
+
+    // Most materials don't change from one frame to the next, so
+    // rather than fill in a parameter block every frame, a material
+    // keeps a persistent block (with its own descriptor set and
+    // constant buffer) that is allocated the first time it is asked
+    // for, and only filled in again after the material has changed.
+    //
+    // A static material thus costs nothing per frame beyond checking
+    // a flag, while an edited material costs one constant buffer
+    // update on the next frame it is drawn.
+    //
+    ParameterBlock* getParameterBlock()
+    {
+        if(!parameterBlock)
+        {
+            parameterBlock = allocatePersistentParameterBlock(
+                getParameterBlockLayout());
+            isDirty = true;
+        }
+        if(isDirty)
+        {
+            ParameterBlockEncoder encoder = parameterBlock->beginEncoding();
+            fillInParameterBlock(encoder);
+            isDirty = false;
+        }
+        return parameterBlock;
+    }
+
+    // Any code that changes the parameters of a material must
+    // mark it dirty, so that its block gets filled in again.
+    //
+    void markDirty() { isDirty = true; }
 
-    // The parameter block for a material will be stashed here
-    // after it is created.
-    RefPtr<ParameterBlock> parameterBlock;
+    // For this application, a material can present a user
+    // interface for people to modify its parameters, and
+    // marks itself dirty if anything was changed.
+    //
+    virtual void doUI() = 0;
+
+private:
+    RefPtr<ParameterBlock>  parameterBlock;
+    bool                    isDirty = true;
 };
 
 // For now we have only a single implementation of `Material`,
@@ -1327,23 +1466,32 @@ struct SimpleMaterial : Material
     glm::vec3   specularColor;
     float       specularity;
 
-    // When asked to create a parameter block, the `SimpleMaterial`
-    // type will allocate a block based on the corresponding
-    // shader type, and fill it in based on the data in the C++
-    // object.
+    // The parameter block for a `SimpleMaterial` uses the layout
+    // of the corresponding shader type, and is filled in based on
+    // the data in the C++ object.
     //
-    RefPtr<ParameterBlock> createParameterBlock() override
+    ParameterBlockLayout* getParameterBlockLayout() override
     {
-        auto parameterBlockLayout = gParameterBlockLayout;
-        auto parameterBlock = allocatePersistentParameterBlock(
-            parameterBlockLayout);
+        return gParameterBlockLayout;
+    }
 
-        ParameterBlockEncoder encoder = parameterBlock->beginEncoding();
+    void fillInParameterBlock(ParameterBlockEncoder& encoder) override
+    {
         encoder.writeField(0, diffuseColor);
         encoder.writeField(1, specularColor);
         encoder.writeField(2, specularity);
+    }
 
-        return parameterBlock;
+    void doUI() override
+    {
+        bool changed = false;
+        changed |= ImGui::ColorEdit3("diffuse", &diffuseColor[0]);
+        changed |= ImGui::ColorEdit3("specular", &specularColor[0]);
+        changed |= ImGui::DragFloat("specularity", &specularity, 1.0f, 0.0f, 1000.0f);
+        if(changed)
+        {
+            markDirty();
+        }
     }
 
     // We cache the corresponding parameter block layout for
@@ -1380,6 +1528,16 @@ struct Model : RefObject
     std::vector<RefPtr<Mesh>>   meshes;
 };
 //
+// When the same model appears many times in a scene, we don't
+// want to pay for a draw call (and a parameter block) per copy.
+// Instead, the per-instance transforms of up to
+// `kMaxInstancesPerBlock` copies are written into one `PerModel`
+// parameter block, and each mesh is drawn for all of them with
+// a single instanced draw call. This must match the size of
+// the `instances` array in the `PerModel` shader type.
+//
+static const int kMaxInstancesPerBlock = 64;
+//
 // Loading a model from disk is done with the help of some utility
 // code for parsing the `.obj` file format, so that the application
 // mostly just registers some callbacks to allocate the objects
@@ -1404,7 +1562,10 @@ RefPtr<Model> loadModel(
             material->specularColor = data.specularColor;
             material->specularity = data.specularity;
 
-            material->parameterBlock = material->createParameterBlock();
+            // The material's parameter block is filled in now, so that
+            // the first frame doesn't pay for every material at once.
+            //
+            material->getParameterBlock();
 
             return material;
         }
@@ -1444,6 +1605,8 @@ RefPtr<Model> loadModel(
     loader.loadFlags = loadFlags;
     loader.scale = scale;
     loader.callbacks = &callbacks;
+    // Keep binary copies of the parsed meshes and decoded textures, so only the first run has to wait for them
+    loader.cacheDirectory = "model-viewer-cache";
     Model* model = nullptr;
     if (SLANG_FAILED(loader.load(inputPath, (void**)&model)))
     {
@@ -1503,8 +1666,9 @@ struct Light : RefObject
     virtual void fillInParameterBlock(ParameterBlockEncoder& encoder) = 0;
 
     // For this application, a light must be able to present a user
-    // interface for people to modify its properties.
-    virtual void doUI() = 0;
+    // interface for people to modify its properties, and report
+    // whether anything was changed.
+    virtual bool doUI() = 0;
 };
 
 // We will provide two nearly trivial implementations of `Light` for now,
@@ -1525,14 +1689,17 @@ struct DirectionalLight : Light
         encoder.writeField(1, color*intensity);
     }
 
-    void doUI() override
+    bool doUI() override
     {
+        bool changed = false;
         if (ImGui::SliderFloat3("direction", &direction[0], -1, 1))
         {
             direction = normalize(direction);
+            changed = true;
         }
-        ImGui::ColorEdit3("color", &color[0]);
-        ImGui::DragFloat("intensity", &intensity, 1.0f, 0.0f, 10000.0f, "%.3f", 2.0f);
+        changed |= ImGui::ColorEdit3("color", &color[0]);
+        changed |= ImGui::DragFloat("intensity", &intensity, 1.0f, 0.0f, 10000.0f, "%.3f", 2.0f);
+        return changed;
     }
 };
 DEFINE_LIGHT_TYPE(DirectionalLight);
@@ -1551,11 +1718,13 @@ struct PointLight : Light
         encoder.writeField(1, color*intensity);
     }
 
-    void doUI() override
+    bool doUI() override
     {
-        ImGui::DragFloat3("position", &position[0], 0.1f);
-        ImGui::ColorEdit3("color", &color[0]);
-        ImGui::DragFloat("intensity", &intensity, 1.0f, 0.0f, 10000.0f, "%.3f", 2.0f);
+        bool changed = false;
+        changed |= ImGui::DragFloat3("position", &position[0], 0.1f);
+        changed |= ImGui::ColorEdit3("color", &color[0]);
+        changed |= ImGui::DragFloat("intensity", &intensity, 1.0f, 0.0f, 10000.0f, "%.3f", 2.0f);
+        return changed;
     }
 };
 DEFINE_LIGHT_TYPE(PointLight);
@@ -1748,6 +1917,7 @@ struct LightEnv : public RefObject
     {
         auto array = getArrayForType(light->getType());
         array->lights.push_back(light);
+        isDirty = true;
     }
 
     virtual void doUI()
@@ -1768,6 +1938,7 @@ struct LightEnv : public RefObject
                 {
                     auto light = array->layout->type->createLight();
                     array->lights.push_back(light);
+                    isDirty = true;
                 }
             }
             ImGui::EndPopup();
@@ -1790,7 +1961,10 @@ struct LightEnv : public RefObject
                     size_t lightIndex = lightCounter++;
                     if (ImGui::TreeNode(light.Ptr(), "%d", (int)lightIndex))
                     {
-                        light->doUI();
+                        if (light->doUI())
+                        {
+                            isDirty = true;
+                        }
                         ImGui::TreePop();
                     }
                 }
@@ -1799,19 +1973,31 @@ struct LightEnv : public RefObject
         }
     }
 
-    // Because the lighting environment will often change between frames,
-    // we will not try to optimize for the case where it doesn't change,
-    // and will instead fill in a "transient" parameter block from
-    // scratch every frame.
+    // The layout of a lighting environment is fixed, and in this
+    // application the lights only change when they are edited in the
+    // UI, so (like a material) the environment keeps a persistent
+    // parameter block that is only filled in again after a change.
     //
-    RefPtr<ParameterBlock> createParameterBlock()
-    {
-        auto parameterBlockLayout = layout->getParameterBlockLayout();
-        auto parameterBlock = allocateTransientParameterBlock(parameterBlockLayout);
-
-        ParameterBlockEncoder encoder = parameterBlock->beginEncoding();
-        fillInParameterBlock(encoder);
+    // A lighting environment that was animated every frame would
+    // instead be better off filling in a transient block each frame.
+    //
+    RefPtr<ParameterBlock>  parameterBlock;
+    bool                    isDirty = true;
 
+    ParameterBlock* getParameterBlock()
+    {
+        if (!parameterBlock)
+        {
+            parameterBlock = allocatePersistentParameterBlock(
+                layout->getParameterBlockLayout());
+            isDirty = true;
+        }
+        if (isDirty)
+        {
+            ParameterBlockEncoder encoder = parameterBlock->beginEncoding();
+            fillInParameterBlock(encoder);
+            isDirty = false;
+        }
         return parameterBlock;
     }
     void fillInParameterBlock(ParameterBlockEncoder& inEncoder)
@@ -1930,6 +2116,48 @@ RefPtr<GUI>         gui;
 std::vector<RefPtr<Model>>  gModels;
 RefPtr<LightEnv>            lightEnv;
 
+// Each model is drawn as a square grid of instances, so that
+// the cost of drawing many objects can be seen by growing the
+// grid from the UI.
+//
+int instanceGridSize = 1;
+float instanceSpacing = 3.0f;
+
+// The constant buffers for transient parameter blocks come from
+// a ring that recycles them once the GPU is done with them.
+//
+RefPtr<TransientConstantBufferRing> transientRing;
+
+// Each frame, the instances of every model are split into batches
+// of up to `kMaxInstancesPerBlock`, each with a transient `PerModel`
+// parameter block holding their transforms.
+//
+struct InstanceBatch
+{
+    Model*                  model;
+    RefPtr<ParameterBlock>  parameterBlock;
+    int                     instanceCount;
+};
+//
+// Every mesh of every batch then becomes an item in a draw list,
+// which holds just what is needed to sort and submit it.
+//
+struct DrawItem
+{
+    ParameterBlockLayout*   materialLayout;
+    ParameterBlock*         materialParameterBlock;
+    int                     batchIndex;
+    Mesh*                   mesh;
+};
+//
+// The lists are kept across frames, so that once they have grown
+// to the size of the scene, building them doesn't allocate.
+//
+std::vector<InstanceBatch>  instanceBatches;
+std::vector<DrawItem>       drawItems;
+std::vector<glm::mat4x4>    instanceTransforms;
+int                         drawCallCount = 0;
+
 
 // During startup the application will load one or more models and
 // add them to the `gModels` list.
@@ -2145,6 +2373,8 @@ Result initialize()
     lightEnv = new LightEnv(lightEnvLayout);
     lightEnv->add(new PointLight());
 
+    transientRing = new TransientConstantBufferRing(gRenderer);
+
     // Once we have created all our graphcis API and application resources,
     // we can start to load models. For now we are keeping things extremely
     // simple by using a trivial `.obj` file that can be checked into source
@@ -2219,6 +2449,11 @@ void renderFrame()
     gRenderer->clearFrame();
     gRenderer->setPrimitiveTopology(PrimitiveTopology::TriangleList);
 
+    // All of the transient parameter blocks allocated this frame
+    // will take their constant buffers from the next pool in the ring.
+    //
+    transientRing->beginFrame();
+
     // Now we will start in on the more interesting rendering logic,
     // by creating the `RenderContext` we will use for submission.
     //
@@ -2240,7 +2475,8 @@ void renderFrame()
     // carefully track and re-use an allocation.
     //
     auto viewParameterBlock = allocateTransientParameterBlock(
-        gPerViewParameterBlockLayout);
+        gPerViewParameterBlockLayout,
+        transientRing);
     {
         auto encoder = viewParameterBlock->beginEncoding();
         encoder.writeField(0, viewProjection);
@@ -2256,75 +2492,146 @@ void renderFrame()
     context.setParameterBlock(0, viewParameterBlock);
 
     // Our `LightEnv` type knows how to turn itself into a parameter
-    // block, so we just create and bind it here.
+    // block, and only fills it in again if a light has changed, so
+    // we just bind it here.
     //
-    auto lightEnvParameterBlock = lightEnv->createParameterBlock();
-    context.setParameterBlock(2, lightEnvParameterBlock);
+    context.setParameterBlock(2, lightEnv->getParameterBlock());
 
-    // The majority of our rendering logic is handled as a loop
-    // over the models in the scene, and their meshes.
+    // Rather than drawing as we walk over the scene, we first
+    // build a list of everything to draw, and then sort it so
+    // that draws sharing state end up next to each other.
+    //
+    // The first step is to write the transforms of the instances
+    // of each model into `PerModel` parameter blocks. Like the view
+    // parameter block, these are transient, since their contents
+    // would be different on the next frame anyway.
     //
+    instanceBatches.clear();
+    drawItems.clear();
     for(auto& model : gModels)
     {
-        gRenderer->setVertexBuffer(0, model->vertexBuffer, sizeof(Model::Vertex));
-        gRenderer->setIndexBuffer(model->indexBuffer, Format::R_UInt32);
+        instanceTransforms.clear();
+        float gridOffset = 0.5f * instanceSpacing * float(instanceGridSize - 1);
+        for(int zz = 0; zz < instanceGridSize; ++zz)
+        for(int xx = 0; xx < instanceGridSize; ++xx)
+        {
+            glm::vec3 position(
+                xx * instanceSpacing - gridOffset,
+                0.0f,
+                zz * instanceSpacing - gridOffset);
+            instanceTransforms.push_back(glm::translate(identity, position));
+        }
 
-        // For each model we provide a parameter
-        // block that holds the per-model transformation
-        // parameters, corresponding to the `PerModel` type
-        // in the shader code.
-        //
-        // Like the view parameter block, it makes sense
-        // to allocate this block as a transient allocation,
-        // since its contents would be different on the next
-        // frame anyway.
-        //
-        glm::mat4x4 modelTransform = identity;
-        glm::mat4x4 inverseTransposeModelTransform = inverse(transpose(modelTransform));
+        int instanceCount = int(instanceTransforms.size());
+        for(int firstInstance = 0; firstInstance < instanceCount; firstInstance += kMaxInstancesPerBlock)
+        {
+            InstanceBatch batch;
+            batch.model = model;
+            batch.instanceCount = std::min(instanceCount - firstInstance, int(kMaxInstancesPerBlock));
+            batch.parameterBlock = allocateTransientParameterBlock(
+                gPerModelParameterBlockLayout,
+                transientRing);
+            {
+                // The only field of `PerModel` is the array of instances,
+                // and each element of that array is a `ModelInstance`
+                // holding the transforms for one instance.
+                //
+                auto encoder = batch.parameterBlock->beginEncoding();
+                auto instancesEncoder = encoder.beginField(0);
+                for(int ii = 0; ii < batch.instanceCount; ++ii)
+                {
+                    glm::mat4x4 modelTransform = instanceTransforms[firstInstance + ii];
+                    glm::mat4x4 inverseTransposeModelTransform = inverse(transpose(modelTransform));
+
+                    auto instanceEncoder = instancesEncoder.beginArrayElement(ii);
+                    instanceEncoder.writeField(0, modelTransform);
+                    instanceEncoder.writeField(1, inverseTransposeModelTransform);
+                }
+            }
+
+            // Every mesh of the model is drawn for every instance
+            // in the batch, so each one gets an item in the draw list.
+            //
+            int batchIndex = int(instanceBatches.size());
+            instanceBatches.push_back(batch);
+            for(auto& mesh : model->meshes)
+            {
+                DrawItem item;
+                item.materialParameterBlock = mesh->material->getParameterBlock();
+                item.materialLayout = item.materialParameterBlock->layout;
+                item.batchIndex = batchIndex;
+                item.mesh = mesh;
+                drawItems.push_back(item);
+            }
+        }
+    }
 
-        auto modelParameterBlock = allocateTransientParameterBlock(
-            gPerModelParameterBlockLayout);
+    // Next we sort the draw list so that the most expensive state
+    // changes happen least often.
+    //
+    // Switching material *layout* changes the concrete type plugged
+    // in for `TMaterial`, and so may require a different specialized
+    // pipeline state, which makes it the most expensive change.
+    // After that we group by batch, since that changes the vertex
+    // and index buffers, as well as the `PerModel` parameter block
+    // (and the `RenderContext` re-binds every block after the
+    // lowest one that changed). Finally, we group by material, which
+    // only re-binds the last parameter block.
+    //
+    std::sort(drawItems.begin(), drawItems.end(),
+        [](DrawItem const& a, DrawItem const& b)
         {
-            auto encoder = modelParameterBlock->beginEncoding();
-            encoder.writeField(0, modelTransform);
-            encoder.writeField(1, inverseTransposeModelTransform);
+            if(a.materialLayout != b.materialLayout) return a.materialLayout < b.materialLayout;
+            if(a.batchIndex != b.batchIndex) return a.batchIndex < b.batchIndex;
+            if(a.materialParameterBlock != b.materialParameterBlock) return a.materialParameterBlock < b.materialParameterBlock;
+            return a.mesh->firstIndex < b.mesh->firstIndex;
+        });
+
+    // With the list sorted, submission is a single loop. The
+    // `RenderContext` already skips binding a parameter block that
+    // hasn't changed, and we skip re-binding vertex and index
+    // buffers the same way.
+    //
+    Model* currentModel = nullptr;
+    drawCallCount = 0;
+    for(auto& item : drawItems)
+    {
+        auto& batch = instanceBatches[item.batchIndex];
+        if(batch.model != currentModel)
+        {
+            currentModel = batch.model;
+            gRenderer->setVertexBuffer(0, currentModel->vertexBuffer, sizeof(Model::Vertex));
+            gRenderer->setIndexBuffer(currentModel->indexBuffer, Format::R_UInt32);
         }
-        context.setParameterBlock(1, modelParameterBlock);
+        context.setParameterBlock(1, batch.parameterBlock);
 
-        // Now we loop over the meshes in the model.
+        // Each mesh has a material, and each material has its own
+        // parameter block that was created at load time, so we
+        // can just re-use the persistent parameter block for the
+        // chosen material.
         //
-        // A more advanced rendering loop would sort things by material
-        // rather than by model, to avoid overly frequent state changes.
-        // We are just doing something simple for the purposes of an
-        // exmple program.
+        // Note that binding the material parameter block here is
+        // both selecting the values to use for various material
+        // parameters as well as the *code* to use for material
+        // evaluation (based on the concrete shader type that
+        // is implementing the `IMaterial` interface).
         //
-        for(auto& mesh : model->meshes)
-        {
-            // Each mesh has a material, and each material has its own
-            // parameter block that was created at load time, so we
-            // can just re-use the persistent parameter block for the
-            // chosen material.
-            //
-            // Note that binding the material parameter block here is
-            // both selecting the values to use for various material
-            // parameters as well as the *code* to use for material
-            // evaluation (based on the concrete shader type that
-            // is implementing the `IMaterial` interface).
-            //
-            context.setParameterBlock(
-                3,
-                mesh->material->parameterBlock);
-
-            // Once we've set up all the parameter blocks needed
-            // for a given drawing operation, we need to flush
-            // any pending state changes (e.g., if the type of
-            // material changed, a shader switch might be
-            // required).
-            //
-            context.flushState();
+        context.setParameterBlock(3, item.materialParameterBlock);
 
-            gRenderer->drawIndexed(mesh->indexCount, mesh->firstIndex);
-        }
+        // Once we've set up all the parameter blocks needed
+        // for a given drawing operation, we need to flush
+        // any pending state changes (e.g., if the type of
+        // material changed, a shader switch might be
+        // required).
+        //
+        context.flushState();
+
+        // One draw call covers the mesh for every instance in
+        // the batch, with the vertex shader using `SV_InstanceID`
+        // to find the transforms of the instance it is drawing.
+        //
+        gRenderer->drawIndexedInstanced(item.mesh->indexCount, batch.instanceCount, item.mesh->firstIndex);
+        drawCallCount++;
     }
 
     ImGui::Begin("Slang Model Viewer Example");
@@ -2333,6 +2640,35 @@ void renderFrame()
     {
         shaderCache->clear();
     }
+    if( ImGui::CollapsingHeader("Scene") )
+    {
+        ImGui::SliderInt("instance grid", &instanceGridSize, 1, 32);
+        ImGui::Text("%d instances in %d batches, %d draw calls",
+            int(gModels.size()) * instanceGridSize * instanceGridSize,
+            int(instanceBatches.size()),
+            drawCallCount);
+    }
+    if( ImGui::CollapsingHeader("Materials") )
+    {
+        // A material may be shared by several meshes, so we
+        // only show each one once.
+        //
+        std::vector<Material*> shownMaterials;
+        for(auto& model : gModels)
+        for(auto& mesh : model->meshes)
+        {
+            Material* material = mesh->material;
+            if(std::find(shownMaterials.begin(), shownMaterials.end(), material) != shownMaterials.end())
+                continue;
+            shownMaterials.push_back(material);
+
+            if(ImGui::TreeNode(material, "%d", int(shownMaterials.size() - 1)))
+            {
+                material->doUI();
+                ImGui::TreePop();
+            }
+        }
+    }
     if( ImGui::CollapsingHeader("Lights") )
     {
         lightEnv->doUI();
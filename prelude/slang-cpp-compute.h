@@ -0,0 +1,345 @@
+// slang-cpp-compute.h
+#ifndef SLANG_CPP_COMPUTE_H
+#define SLANG_CPP_COMPUTE_H
+
+/* A small runtime for running compute kernels produced by the C++ target on the host.
+
+The C++ target emits a `<entryPoint>_Group(groupID_x, groupID_y, groupID_z)` function for
+each compute entry point, which runs all the invocations of one thread group. A dispatch
+runs such a function for every group of a grid, spread over the threads of a `ThreadPool`:
+
+    SlangCompute::ThreadPool pool;
+    const uint32_t groupCount[3] = { 64, 1, 1 };
+    pool.dispatch(groupCount, 0, [](const SlangCompute::GroupContext& context)
+    {
+        computeMain_Group(context.groupID[0], context.groupID[1], context.groupID[2]);
+    });
+
+The header only depends on the C++11 standard library, so that it can be compiled along
+with generated code by any host C++ compiler.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SlangCompute {
+
+    /// The group being run by a dispatch
+struct GroupContext
+{
+    uint32_t groupID[3];
+        /// Memory for the group's groupshared variables, of the size passed to `dispatch`.
+        /// It is private to the group while it runs, and like on a GPU isn't cleared between groups.
+    void* groupShared;
+};
+
+    /// A reusable barrier for a fixed number of threads, as needed by
+    /// `GroupMemoryBarrierWithGroupSync` when the invocations of a group run on separate threads.
+class Barrier
+{
+public:
+        /// Block until all the threads have called `wait`
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        const size_t generation = m_generation;
+        if (++m_arrivedCount == m_threadCount)
+        {
+            m_arrivedCount = 0;
+            m_generation++;
+            m_allArrived.notify_all();
+            return;
+        }
+        m_allArrived.wait(lock, [&]() { return m_generation != generation; });
+    }
+
+    explicit Barrier(size_t threadCount) : m_threadCount(threadCount) {}
+
+protected:
+    std::mutex m_mutex;
+    std::condition_variable m_allArrived;
+    size_t m_threadCount;
+    size_t m_arrivedCount = 0;
+    size_t m_generation = 0;
+};
+
+    /// Run `invocationFunc(threadID, barrier)` for every invocation of a group of `groupSize`, each on its own thread,
+    /// so that the invocations can synchronize with `barrier.wait()`.
+    ///
+    /// This is only needed for kernels that use barriers. Other kernels are much faster run
+    /// with their invocations in a loop, as the `_Group` functions of the C++ target do.
+template <typename F>
+void runGroupInvocations(const uint32_t groupSize[3], const F& invocationFunc)
+{
+    const size_t invocationCount = size_t(groupSize[0]) * groupSize[1] * groupSize[2];
+    Barrier barrier(invocationCount);
+
+    std::vector<std::thread> threads;
+    threads.reserve(invocationCount);
+    for (uint32_t z = 0; z < groupSize[2]; ++z)
+    {
+        for (uint32_t y = 0; y < groupSize[1]; ++y)
+        {
+            for (uint32_t x = 0; x < groupSize[0]; ++x)
+            {
+                threads.emplace_back([&barrier, &invocationFunc, x, y, z]()
+                {
+                    const uint32_t threadID[3] = { x, y, z };
+                    invocationFunc(threadID, barrier);
+                });
+            }
+        }
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+    /// Runs the groups of dispatches over a set of worker threads.
+    ///
+    /// The groups of a dispatch are split into equal ranges, one per thread. A thread that
+    /// finishes its range steals the back half of the largest remaining range of another,
+    /// so uneven group costs still keep all the threads busy.
+class ThreadPool
+{
+public:
+        /// Run `groupFunc(const GroupContext&)` for every group of the `groupCount` grid, and
+        /// return when they have all completed. `groupSharedSize` bytes of group shared memory are provided to each group.
+        /// The calling thread runs groups too. Must not be called concurrently on the same pool.
+    template <typename F>
+    void dispatch(const uint32_t groupCount[3], size_t groupSharedSize, const F& groupFunc)
+    {
+        _dispatch(groupCount, groupSharedSize, &_runGroup<F>, &groupFunc);
+    }
+
+        /// Get the number of threads that run groups, including the thread calling `dispatch`
+    size_t getThreadCount() const { return m_participants.size(); }
+
+        /// Ctor. `threadCount` is the total number of threads to run groups on, including the calling thread.
+        /// If it is 0, one thread per hardware thread is used.
+    explicit ThreadPool(size_t threadCount = 0)
+    {
+        if (threadCount == 0)
+        {
+            threadCount = std::thread::hardware_concurrency();
+            threadCount = threadCount ? threadCount : 1;
+        }
+
+        m_participants = std::vector<Participant>(threadCount);
+
+        // Participant 0 is the thread calling dispatch
+        for (size_t i = 1; i < threadCount; ++i)
+        {
+            m_workers.emplace_back([this, i]() { _workerMain(i); });
+        }
+    }
+
+        /// Dtor. Must not be called while a dispatch is running.
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isShuttingDown = true;
+        }
+        m_dispatchStarted.notify_all();
+        for (auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+protected:
+    typedef void (*RunGroupFunc)(const void* groupFunc, const GroupContext& context);
+
+        /// A thread running groups, and the linear range of group indices [begin, end) it will run next
+    struct Participant
+    {
+        std::mutex mutex;
+        uint64_t begin = 0;
+        uint64_t end = 0;
+        std::vector<uint8_t> groupShared;
+    };
+
+    template <typename F>
+    static void _runGroup(const void* groupFunc, const GroupContext& context)
+    {
+        (*static_cast<const F*>(groupFunc))(context);
+    }
+
+    void _dispatch(const uint32_t groupCount[3], size_t groupSharedSize, RunGroupFunc runGroup, const void* groupFunc)
+    {
+        const uint64_t totalGroupCount = uint64_t(groupCount[0]) * groupCount[1] * groupCount[2];
+        if (totalGroupCount == 0)
+        {
+            return;
+        }
+
+        const size_t participantCount = m_participants.size();
+        for (size_t i = 0; i < participantCount; ++i)
+        {
+            Participant& participant = m_participants[i];
+            participant.begin = (totalGroupCount * i) / participantCount;
+            participant.end = (totalGroupCount * (i + 1)) / participantCount;
+            if (participant.groupShared.size() < groupSharedSize)
+            {
+                participant.groupShared.resize(groupSharedSize);
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (int i = 0; i < 3; ++i)
+            {
+                m_groupCount[i] = groupCount[i];
+            }
+            m_runGroup = runGroup;
+            m_groupFunc = groupFunc;
+            m_activeWorkerCount = m_workers.size();
+            m_dispatchIndex++;
+        }
+        m_dispatchStarted.notify_all();
+
+        _runGroups(0);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_dispatchCompleted.wait(lock, [&]() { return m_activeWorkerCount == 0; });
+    }
+
+    void _workerMain(size_t participantIndex)
+    {
+        uint64_t dispatchIndex = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_dispatchStarted.wait(lock, [&]() { return m_isShuttingDown || m_dispatchIndex != dispatchIndex; });
+                if (m_isShuttingDown)
+                {
+                    return;
+                }
+                dispatchIndex = m_dispatchIndex;
+            }
+
+            _runGroups(participantIndex);
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_activeWorkerCount == 0)
+                {
+                    m_dispatchCompleted.notify_one();
+                }
+            }
+        }
+    }
+
+        /// Take the next group index from the participant's own range. Returns false if the range is empty.
+    bool _takeGroup(Participant& participant, uint64_t& outGroupIndex)
+    {
+        std::lock_guard<std::mutex> lock(participant.mutex);
+        if (participant.begin >= participant.end)
+        {
+            return false;
+        }
+        outGroupIndex = participant.begin++;
+        return true;
+    }
+
+        /// Move the back half of the largest range of another participant to `thief`. Returns false if there is nothing left to steal.
+    bool _steal(size_t thiefIndex)
+    {
+        const size_t participantCount = m_participants.size();
+        for (;;)
+        {
+            // Find the participant with the most groups left. The range may shrink before
+            // it is stolen from, so it is checked again when the half is taken.
+            size_t victimIndex = thiefIndex;
+            uint64_t largestCount = 0;
+            for (size_t i = 0; i < participantCount; ++i)
+            {
+                Participant& participant = m_participants[i];
+                std::lock_guard<std::mutex> lock(participant.mutex);
+                const uint64_t count = participant.end - participant.begin;
+                if (i != thiefIndex && participant.begin < participant.end && count > largestCount)
+                {
+                    largestCount = count;
+                    victimIndex = i;
+                }
+            }
+            if (victimIndex == thiefIndex)
+            {
+                return false;
+            }
+
+            uint64_t begin, end;
+            {
+                Participant& victim = m_participants[victimIndex];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (victim.begin >= victim.end)
+                {
+                    // Emptied since it was chosen, so look again
+                    continue;
+                }
+                end = victim.end;
+                begin = victim.begin + (victim.end - victim.begin) / 2;
+                victim.end = begin;
+            }
+
+            Participant& thief = m_participants[thiefIndex];
+            std::lock_guard<std::mutex> lock(thief.mutex);
+            thief.begin = begin;
+            thief.end = end;
+            return true;
+        }
+    }
+
+    void _runGroups(size_t participantIndex)
+    {
+        Participant& participant = m_participants[participantIndex];
+
+        GroupContext context;
+        context.groupShared = participant.groupShared.empty() ? nullptr : participant.groupShared.data();
+
+        for (;;)
+        {
+            uint64_t groupIndex;
+            if (!_takeGroup(participant, groupIndex))
+            {
+                if (!_steal(participantIndex))
+                {
+                    return;
+                }
+                continue;
+            }
+
+            context.groupID[0] = uint32_t(groupIndex % m_groupCount[0]);
+            context.groupID[1] = uint32_t((groupIndex / m_groupCount[0]) % m_groupCount[1]);
+            context.groupID[2] = uint32_t(groupIndex / (uint64_t(m_groupCount[0]) * m_groupCount[1]));
+
+            m_runGroup(m_groupFunc, context);
+        }
+    }
+
+    std::vector<Participant> m_participants;
+    std::vector<std::thread> m_workers;
+
+    std::mutex m_mutex;
+    std::condition_variable m_dispatchStarted;      ///< Signalled when a dispatch starts or on shutdown
+    std::condition_variable m_dispatchCompleted;    ///< Signalled when the last worker finishes a dispatch
+    uint64_t m_dispatchIndex = 0;                   ///< Incremented for each dispatch
+    size_t m_activeWorkerCount = 0;                 ///< Workers still running groups of the current dispatch
+    bool m_isShuttingDown = false;
+
+    uint32_t m_groupCount[3] = { 0, 0, 0 };
+    RunGroupFunc m_runGroup = nullptr;
+    const void* m_groupFunc = nullptr;
+};
+
+} // namespace SlangCompute
+
+#endif // SLANG_CPP_COMPUTE_H
@@ -0,0 +1,136 @@
+// slang-cpp-types.h
+#ifndef SLANG_CPP_TYPES_H
+#define SLANG_CPP_TYPES_H
+
+/* The vector and matrix types, and the helper functions for them, that C++ generated by the
+C++ target uses.
+
+Generated code includes this header rather than containing the definitions, so the header is
+the same for every kernel, and can be built once as a precompiled header (see
+`CPPCompilerUtil::ensurePrecompiledHeader`).
+
+The names match those the C++ target emits: `Vec` or `Mat`, then the element type (`B` for bool,
+`I` for 32 bit integers, `F` for float, `I64` and `F64` for the 64 bit types), then the size.
+When the element type name is longer than one character the size is separated by an underscore,
+so `VecF3`, `VecF64_3`, `MatF34` and `MatI64_44`. Each type has `<Name>_init` and `<Name>_splat`
+functions, to construct it from its elements and from a single value.
+*/
+
+#include <stdint.h>
+
+    /// Vectors are aligned to the power of two at or above their size, so that they can be loaded
+    /// and stored as whole SIMD registers (a 3 element vector is padded to the size of 4 elements).
+    /// The CPU layout rules in `slang-type-layout.cpp` must match.
+template <typename T, int N>
+struct SlangVector;
+
+template <typename T>
+struct alignas(2 * sizeof(T)) SlangVector<T, 2>
+{
+    T& operator[](int i) { return (&x)[i]; }
+    const T& operator[](int i) const { return (&x)[i]; }
+    T x, y;
+};
+
+template <typename T>
+struct alignas(4 * sizeof(T)) SlangVector<T, 3>
+{
+    T& operator[](int i) { return (&x)[i]; }
+    const T& operator[](int i) const { return (&x)[i]; }
+    T x, y, z;
+};
+
+template <typename T>
+struct alignas(4 * sizeof(T)) SlangVector<T, 4>
+{
+    T& operator[](int i) { return (&x)[i]; }
+    const T& operator[](int i) const { return (&x)[i]; }
+    T x, y, z, w;
+};
+
+    /// A matrix is held as an array of row vectors
+template <typename T, int ROW_COUNT, int COL_COUNT>
+struct SlangMatrix
+{
+    SlangVector<T, COL_COUNT>& operator[](int i) { return rows[i]; }
+    const SlangVector<T, COL_COUNT>& operator[](int i) const { return rows[i]; }
+    SlangVector<T, COL_COUNT> rows[ROW_COUNT];
+};
+
+// Component-wise operators
+
+#define SLANG_PRELUDE_BINARY_OP(OP) \
+    template <typename T, int N> \
+    SlangVector<T, N> operator OP(const SlangVector<T, N>& a, const SlangVector<T, N>& b) \
+    { SlangVector<T, N> r; for (int i = 0; i < N; ++i) r[i] = a[i] OP b[i]; return r; } \
+    template <typename T, int N> \
+    SlangVector<T, N> operator OP(const SlangVector<T, N>& a, T b) \
+    { SlangVector<T, N> r; for (int i = 0; i < N; ++i) r[i] = a[i] OP b; return r; } \
+    template <typename T, int N> \
+    SlangVector<T, N> operator OP(T a, const SlangVector<T, N>& b) \
+    { SlangVector<T, N> r; for (int i = 0; i < N; ++i) r[i] = a OP b[i]; return r; } \
+    template <typename T, int R, int C> \
+    SlangMatrix<T, R, C> operator OP(const SlangMatrix<T, R, C>& a, const SlangMatrix<T, R, C>& b) \
+    { SlangMatrix<T, R, C> r; for (int i = 0; i < R; ++i) r[i] = a[i] OP b[i]; return r; }
+
+SLANG_PRELUDE_BINARY_OP(+)
+SLANG_PRELUDE_BINARY_OP(-)
+SLANG_PRELUDE_BINARY_OP(*)
+SLANG_PRELUDE_BINARY_OP(/)
+
+#undef SLANG_PRELUDE_BINARY_OP
+
+template <typename T, int N>
+SlangVector<T, N> operator-(const SlangVector<T, N>& a)
+{
+    SlangVector<T, N> r;
+    for (int i = 0; i < N; ++i) r[i] = -a[i];
+    return r;
+}
+
+// The named types and their helper functions
+
+#define SLANG_PRELUDE_VECTOR_TYPES(PREFIX, T) \
+    typedef SlangVector<T, 2> PREFIX##2; \
+    typedef SlangVector<T, 3> PREFIX##3; \
+    typedef SlangVector<T, 4> PREFIX##4; \
+    inline PREFIX##2 PREFIX##2_init(T x, T y) { PREFIX##2 r = { x, y }; return r; } \
+    inline PREFIX##3 PREFIX##3_init(T x, T y, T z) { PREFIX##3 r = { x, y, z }; return r; } \
+    inline PREFIX##4 PREFIX##4_init(T x, T y, T z, T w) { PREFIX##4 r = { x, y, z, w }; return r; } \
+    inline PREFIX##2 PREFIX##2_splat(T v) { PREFIX##2 r = { v, v }; return r; } \
+    inline PREFIX##3 PREFIX##3_splat(T v) { PREFIX##3 r = { v, v, v }; return r; } \
+    inline PREFIX##4 PREFIX##4_splat(T v) { PREFIX##4 r = { v, v, v, v }; return r; }
+
+#define SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, R, C) \
+    typedef SlangMatrix<T, R, C> PREFIX##R##C; \
+    inline PREFIX##R##C PREFIX##R##C##_splat(T v) \
+    { PREFIX##R##C r; for (int i = 0; i < R; ++i) for (int j = 0; j < C; ++j) r[i][j] = v; return r; }
+
+#define SLANG_PRELUDE_MATRIX_TYPES(PREFIX, T) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 2, 2) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 2, 3) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 2, 4) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 3, 2) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 3, 3) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 3, 4) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 4, 2) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 4, 3) \
+    SLANG_PRELUDE_MATRIX_TYPE(PREFIX, T, 4, 4)
+
+SLANG_PRELUDE_VECTOR_TYPES(VecB, bool)
+SLANG_PRELUDE_VECTOR_TYPES(VecI, int32_t)
+SLANG_PRELUDE_VECTOR_TYPES(VecF, float)
+SLANG_PRELUDE_VECTOR_TYPES(VecI64_, int64_t)
+SLANG_PRELUDE_VECTOR_TYPES(VecF64_, double)
+
+SLANG_PRELUDE_MATRIX_TYPES(MatB, bool)
+SLANG_PRELUDE_MATRIX_TYPES(MatI, int32_t)
+SLANG_PRELUDE_MATRIX_TYPES(MatF, float)
+SLANG_PRELUDE_MATRIX_TYPES(MatI64_, int64_t)
+SLANG_PRELUDE_MATRIX_TYPES(MatF64_, double)
+
+#undef SLANG_PRELUDE_VECTOR_TYPES
+#undef SLANG_PRELUDE_MATRIX_TYPES
+#undef SLANG_PRELUDE_MATRIX_TYPE
+
+#endif // SLANG_CPP_TYPES_H
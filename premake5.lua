@@ -164,7 +164,7 @@ workspace "slang"
         defines { "NDEBUG" }
     		
     filter { "system:linux" }
-        linkoptions{  "-Wl,-rpath,'$$ORIGIN',--no-as-needed", "-ldl"}
+        linkoptions{  "-Wl,-rpath,'$$ORIGIN',--no-as-needed", "-ldl", "-pthread"}
         
             
 function dump(o)
@@ -473,6 +473,18 @@ tool "slang-test"
     includedirs { "." }
     links { "core", "slang" }
 
+--
+-- `slang-bench` measures compile throughput over a corpus of shaders
+-- from `tests/` and `examples/`, and compares the results against a
+-- stored baseline. Like `slang-test` it uses the `core` library and the
+-- Slang API:
+--
+
+tool "slang-bench"
+    uuid "A9F3C2D1-5B7E-4E8A-9C61-2D4F8B0E7A35"
+    includedirs { "." }
+    links { "core", "slang" }
+
 --
 -- The reflection test harness `slang-reflection-test` is pretty
 -- simple, in that it only needs to link against the slang library
@@ -541,12 +553,12 @@ tool "gfx"
         -- directory into the output directory.
         postbuildcommands { '"$(SolutionDir)tools\\copy-hlsl-libs.bat" "$(WindowsSdkDir)Redist/D3D/%{cfg.platform:lower()}/" "%{cfg.targetdir}/"'}
     else
-         removefiles { "tools/gfx/circular-resource-heap-d3d12.cpp", "tools/gfx/d3d-util.cpp", "tools/gfx/descriptor-heap-d3d12.cpp", "tools/gfx/render-d3d11.cpp", "tools/gfx/render-d3d12.cpp", "tools/gfx/render-gl.cpp", "tools/gfx/resource-d3d12.cpp", "tools/gfx/render-vk.cpp", "tools/gfx/vk-swap-chain.cpp", "tools/gfx/window.cpp" }
+         removefiles { "tools/gfx/circular-resource-heap-d3d12.cpp", "tools/gfx/d3d-util.cpp", "tools/gfx/descriptor-heap-d3d12.cpp", "tools/gfx/heap-allocator-d3d12.cpp", "tools/gfx/render-d3d11.cpp", "tools/gfx/render-d3d12.cpp", "tools/gfx/render-gl.cpp", "tools/gfx/resource-d3d12.cpp", "tools/gfx/render-vk.cpp", "tools/gfx/vk-swap-chain.cpp", "tools/gfx/window.cpp" }
     end
 
 	-- Remove VK from OSX gfx build
 	if os.target() == "macosx" then
-		removefiles { "tools/gfx/render-vk.cpp", "tools/gfx/vk-device-queue.cpp", "tools/gfx/vk-api.cpp", "tools/gfx/vk-module.cpp", "tools/gfx/vk-swap-chain.cpp", "tools/gfx/vk-util.cpp" }
+		removefiles { "tools/gfx/render-vk.cpp", "tools/gfx/vk-device-queue.cpp", "tools/gfx/vk-api.cpp", "tools/gfx/vk-module.cpp", "tools/gfx/vk-swap-chain.cpp", "tools/gfx/vk-util.cpp", "tools/gfx/vk-memory-allocator.cpp", "tools/gfx/vk-descriptor-set-allocator.cpp" }
 	end
     
 --
@@ -593,8 +605,9 @@ standardProject "slang"
 
     -- The `standardProject` operation already added all the code in
     -- `source/slang/*`, but we also want to incldue the umbrella
-    -- `slang.h` header in this prject, so we do that manually here.
-    files { "slang.h" }
+    -- `slang.h` header (and the reflection blob reader that goes with it)
+    -- in this prject, so we do that manually here.
+    files { "slang.h", "slang-reflection-blob.h" }
 
     -- The most challenging part of building `slang` is that we need
     -- to invoke the `slang-generate` tool to generate the version
@@ -0,0 +1,386 @@
+#ifndef SLANG_REFLECTION_BLOB_H
+#define SLANG_REFLECTION_BLOB_H
+
+#include "slang.h"
+
+#include <string.h>
+
+/* A reflection blob holds the layout information of a program, as produced by
+`spReflection_writeBlob`, in a single contiguous block of memory that doesn't contain any
+pointers. It can be saved to a file, and memory mapped (or read) back in by an application
+that doesn't need to keep the compile request, or even the Slang library, around.
+
+`slang::ReflectionBlob` reads a blob, and has the same queries as the reflection API in
+`slang.h` for parameters, entry points, type layouts and variable layouts. Types are only
+described as far as their layouts are (so there are no user attributes, type parameters, or
+resource result types), and the blob can't be used to lay out other types.
+
+The layout of the blob is
+
+* A `ReflectionBlobHeader`, which has the offset and count of each section
+* The sections, each of which is an array of one of the types below
+
+Everything else refers to items in sections by index, and to strings by their offset in
+the string section. All values are in the byte order of the machine that wrote the blob. */
+
+namespace slang {
+
+enum
+{
+    kReflectionBlobMagic = 0x42524c53,          ///< 'SLRB'
+    kReflectionBlobVersion = 1,
+    kReflectionBlobNull = 0xffffffff,           ///< Null index or string offset
+};
+
+enum class ReflectionBlobSection : uint32_t
+{
+    Strings,                ///< char, each string is zero terminated
+    Indices,                ///< uint32_t, lists of indices (of fields, parameters and categories)
+    Sizes,                  ///< ReflectionBlobSize
+    Offsets,                ///< ReflectionBlobOffset
+    TypeLayouts,            ///< ReflectionBlobTypeLayout
+    VarLayouts,             ///< ReflectionBlobVarLayout
+    EntryPoints,            ///< ReflectionBlobEntryPoint
+    CountOf,
+};
+
+    /// A run of items in a section
+struct ReflectionBlobRange
+{
+    uint32_t start;
+    uint32_t count;
+};
+
+    /// The size or stride of a type layout for a category. Categories without an entry are 0.
+struct ReflectionBlobSize
+{
+    uint32_t category;
+    uint32_t pad;
+    uint64_t size;              ///< ~uint64_t(0) if unbounded
+};
+
+    /// The offset and space of a variable layout for a category. Categories without an entry are 0.
+struct ReflectionBlobOffset
+{
+    uint32_t category;
+    uint32_t offset;
+    uint32_t space;
+    uint32_t pad;
+};
+
+struct ReflectionBlobTypeLayout
+{
+    uint32_t kind;                          ///< SlangTypeKind
+    uint32_t name;                          ///< String
+    uint32_t scalarType;                    ///< SlangScalarType
+    uint32_t rowCount;
+    uint32_t columnCount;
+    uint32_t resourceShape;                 ///< SlangResourceShape
+    uint32_t resourceAccess;                ///< SlangResourceAccess
+    uint32_t parameterCategory;             ///< SlangParameterCategory
+    uint32_t matrixLayoutMode;              ///< SlangMatrixLayoutMode
+    int32_t genericParamIndex;
+    uint32_t elementTypeLayout;             ///< TypeLayouts index
+    uint32_t elementVarLayout;              ///< VarLayouts index
+    uint64_t elementCount;                  ///< ~uint64_t(0) if unbounded
+    ReflectionBlobRange fields;             ///< Indices, each a VarLayouts index
+    ReflectionBlobRange categories;         ///< Indices, each a SlangParameterCategory
+    ReflectionBlobRange sizes;              ///< Sizes
+    ReflectionBlobRange strides;            ///< Sizes
+};
+
+struct ReflectionBlobVarLayout
+{
+    uint32_t name;                          ///< String
+    uint32_t typeLayout;                    ///< TypeLayouts index
+    uint32_t semanticName;                  ///< String
+    uint32_t semanticIndex;
+    uint32_t stage;                         ///< SlangStage
+    uint32_t bindingIndex;
+    uint32_t bindingSpace;
+    uint32_t pad;
+    ReflectionBlobRange offsets;            ///< Offsets
+};
+
+struct ReflectionBlobEntryPoint
+{
+    uint32_t name;                          ///< String
+    uint32_t stage;                         ///< SlangStage
+    uint32_t threadGroupSize[3];
+    uint32_t usesAnySampleRateInput;
+    ReflectionBlobRange parameters;         ///< Indices, each a VarLayouts index
+};
+
+struct ReflectionBlobHeader
+{
+    uint32_t magic;                         ///< kReflectionBlobMagic
+    uint32_t version;                       ///< kReflectionBlobVersion
+    uint32_t size;                          ///< Size of the whole blob in bytes
+    uint32_t globalConstantBufferBinding;
+    uint64_t globalConstantBufferSize;
+    ReflectionBlobRange parameters;         ///< Indices, each a VarLayouts index
+    ReflectionBlobRange entryPoints;        ///< EntryPoints
+        /// The offset in bytes from the start of the blob, and the item count, of each section
+    ReflectionBlobRange sections[uint32_t(ReflectionBlobSection::CountOf)];
+};
+
+    /// Reads the contents of a reflection blob.
+    ///
+    /// The queries have the same names and results as those of the reflection API, but items
+    /// are returned as small handles rather than pointers. A handle for something that doesn't
+    /// exist (such as the field of a type that isn't a struct) is null (tests false), and
+    /// queries on it return zero or null.
+    ///
+    /// The reader doesn't copy or own the memory of the blob, which must remain valid
+    /// while the reader (or any handle from it) is used.
+class ReflectionBlob
+{
+public:
+    class TypeLayout;
+    class VariableLayout;
+    class EntryPoint;
+
+        /// Start reading the blob in data. Fails if it isn't a reflection blob this reader can read.
+    SlangResult init(void const* data, size_t size)
+    {
+        m_header = nullptr;
+        if (size < sizeof(ReflectionBlobHeader) || (size_t(data) & 7) != 0)
+            return SLANG_FAIL;
+
+        auto header = (ReflectionBlobHeader const*)data;
+        if (header->magic != kReflectionBlobMagic || header->version != kReflectionBlobVersion || header->size > size)
+            return SLANG_FAIL;
+
+        static const size_t kItemSizes[] =
+        {
+            sizeof(char), sizeof(uint32_t), sizeof(ReflectionBlobSize), sizeof(ReflectionBlobOffset),
+            sizeof(ReflectionBlobTypeLayout), sizeof(ReflectionBlobVarLayout), sizeof(ReflectionBlobEntryPoint),
+        };
+        for (uint32_t i = 0; i < uint32_t(ReflectionBlobSection::CountOf); ++i)
+        {
+            const ReflectionBlobRange& section = header->sections[i];
+            if (section.start > header->size || uint64_t(section.count) * kItemSizes[i] > header->size - section.start)
+                return SLANG_FAIL;
+        }
+
+        // Strings must be terminated within the section
+        const ReflectionBlobRange& strings = header->sections[uint32_t(ReflectionBlobSection::Strings)];
+        if (strings.count && ((char const*)data)[strings.start + strings.count - 1] != 0)
+            return SLANG_FAIL;
+
+        m_header = header;
+        return SLANG_OK;
+    }
+
+    bool isValid() const { return m_header != nullptr; }
+
+    // The program queries (as on `slang::ProgramLayout`)
+
+    unsigned getParameterCount() const { return m_header->parameters.count; }
+    VariableLayout getParameterByIndex(unsigned index) const;
+
+    SlangUInt getEntryPointCount() const { return m_header->entryPoints.count; }
+    EntryPoint getEntryPointByIndex(SlangUInt index) const;
+    EntryPoint findEntryPointByName(char const* name) const;
+
+    SlangUInt getGlobalConstantBufferBinding() const { return m_header->globalConstantBufferBinding; }
+    size_t getGlobalConstantBufferSize() const { return _getSize(m_header->globalConstantBufferSize); }
+
+    class TypeLayout
+    {
+    public:
+        TypeLayout() {}
+        TypeLayout(ReflectionBlob const* blob, uint32_t index) : m_data(blob->_getItem<ReflectionBlobTypeLayout>(ReflectionBlobSection::TypeLayouts, index)), m_blob(m_data ? blob : nullptr) {}
+
+        explicit operator bool() const { return m_data != nullptr; }
+
+        TypeReflection::Kind getKind() const { return TypeReflection::Kind(m_data ? m_data->kind : uint32_t(SLANG_TYPE_KIND_NONE)); }
+        char const* getName() const { return m_data ? m_blob->_getString(m_data->name) : nullptr; }
+
+        size_t getSize(SlangParameterCategory category = SLANG_PARAMETER_CATEGORY_UNIFORM) const { return m_data ? m_blob->_findSize(m_data->sizes, category) : 0; }
+        size_t getElementStride(SlangParameterCategory category) const { return m_data ? m_blob->_findSize(m_data->strides, category) : 0; }
+
+        unsigned int getFieldCount() const { return m_data ? m_data->fields.count : 0; }
+        VariableLayout getFieldByIndex(unsigned int index) const;
+
+        bool isArray() const { return getKind() == TypeReflection::Kind::Array; }
+        TypeLayout unwrapArray() const
+        {
+            TypeLayout typeLayout = *this;
+            while (typeLayout.isArray())
+                typeLayout = typeLayout.getElementTypeLayout();
+            return typeLayout;
+        }
+        size_t getElementCount() const { return m_data ? _getSize(m_data->elementCount) : 0; }
+        TypeLayout getElementTypeLayout() const { return m_data ? TypeLayout(m_blob, m_data->elementTypeLayout) : TypeLayout(); }
+        VariableLayout getElementVarLayout() const;
+
+        ParameterCategory getParameterCategory() const { return ParameterCategory(m_data ? m_data->parameterCategory : uint32_t(SLANG_PARAMETER_CATEGORY_NONE)); }
+        unsigned int getCategoryCount() const { return m_data ? m_data->categories.count : 0; }
+        ParameterCategory getCategoryByIndex(unsigned int index) const
+        {
+            return ParameterCategory(m_data && index < m_data->categories.count ? m_blob->_getIndex(m_data->categories.start + index) : uint32_t(SLANG_PARAMETER_CATEGORY_NONE));
+        }
+
+        unsigned getRowCount() const { return m_data ? m_data->rowCount : 0; }
+        unsigned getColumnCount() const { return m_data ? m_data->columnCount : 0; }
+        TypeReflection::ScalarType getScalarType() const { return TypeReflection::ScalarType(m_data ? m_data->scalarType : uint32_t(SLANG_SCALAR_TYPE_NONE)); }
+        SlangResourceShape getResourceShape() const { return SlangResourceShape(m_data ? m_data->resourceShape : uint32_t(SLANG_RESOURCE_NONE)); }
+        SlangResourceAccess getResourceAccess() const { return SlangResourceAccess(m_data ? m_data->resourceAccess : uint32_t(SLANG_RESOURCE_ACCESS_NONE)); }
+        SlangMatrixLayoutMode getMatrixLayoutMode() const { return SlangMatrixLayoutMode(m_data ? m_data->matrixLayoutMode : uint32_t(SLANG_MATRIX_LAYOUT_MODE_UNKNOWN)); }
+        int getGenericParamIndex() const { return m_data ? m_data->genericParamIndex : -1; }
+
+    protected:
+        ReflectionBlobTypeLayout const* m_data = nullptr;
+        ReflectionBlob const* m_blob = nullptr;
+    };
+
+    class VariableLayout
+    {
+    public:
+        VariableLayout() {}
+        VariableLayout(ReflectionBlob const* blob, uint32_t index) : m_data(blob->_getItem<ReflectionBlobVarLayout>(ReflectionBlobSection::VarLayouts, index)), m_blob(m_data ? blob : nullptr) {}
+
+        explicit operator bool() const { return m_data != nullptr; }
+
+        char const* getName() const { return m_data ? m_blob->_getString(m_data->name) : nullptr; }
+        TypeLayout getTypeLayout() const { return m_data ? TypeLayout(m_blob, m_data->typeLayout) : TypeLayout(); }
+
+        ParameterCategory getCategory() const { return getTypeLayout().getParameterCategory(); }
+        unsigned int getCategoryCount() const { return getTypeLayout().getCategoryCount(); }
+        ParameterCategory getCategoryByIndex(unsigned int index) const { return getTypeLayout().getCategoryByIndex(index); }
+
+        size_t getOffset(SlangParameterCategory category = SLANG_PARAMETER_CATEGORY_UNIFORM) const
+        {
+            auto offset = m_data ? m_blob->_findOffset(m_data->offsets, category) : nullptr;
+            return offset ? offset->offset : 0;
+        }
+        size_t getBindingSpace(SlangParameterCategory category) const
+        {
+            auto offset = m_data ? m_blob->_findOffset(m_data->offsets, category) : nullptr;
+            return offset ? offset->space : 0;
+        }
+        unsigned getBindingIndex() const { return m_data ? m_data->bindingIndex : 0; }
+        unsigned getBindingSpace() const { return m_data ? m_data->bindingSpace : 0; }
+
+        char const* getSemanticName() const { return m_data ? m_blob->_getString(m_data->semanticName) : nullptr; }
+        size_t getSemanticIndex() const { return m_data ? m_data->semanticIndex : 0; }
+        SlangStage getStage() const { return SlangStage(m_data ? m_data->stage : uint32_t(SLANG_STAGE_NONE)); }
+
+    protected:
+        ReflectionBlobVarLayout const* m_data = nullptr;
+        ReflectionBlob const* m_blob = nullptr;
+    };
+
+    class EntryPoint
+    {
+    public:
+        EntryPoint() {}
+        EntryPoint(ReflectionBlob const* blob, uint32_t index) : m_data(blob->_getItem<ReflectionBlobEntryPoint>(ReflectionBlobSection::EntryPoints, index)), m_blob(m_data ? blob : nullptr) {}
+
+        explicit operator bool() const { return m_data != nullptr; }
+
+        char const* getName() const { return m_data ? m_blob->_getString(m_data->name) : nullptr; }
+        SlangStage getStage() const { return SlangStage(m_data ? m_data->stage : uint32_t(SLANG_STAGE_NONE)); }
+
+        unsigned getParameterCount() const { return m_data ? m_data->parameters.count : 0; }
+        VariableLayout getParameterByIndex(unsigned index) const
+        {
+            if (!m_data || index >= m_data->parameters.count)
+                return VariableLayout();
+            return VariableLayout(m_blob, m_blob->_getIndex(m_data->parameters.start + index));
+        }
+
+        void getComputeThreadGroupSize(SlangUInt axisCount, SlangUInt* outSizeAlongAxis) const
+        {
+            for (SlangUInt i = 0; i < axisCount; ++i)
+                outSizeAlongAxis[i] = i < 3 ? (m_data ? m_data->threadGroupSize[i] : 0) : 1;
+        }
+        bool usesAnySampleRateInput() const { return m_data && m_data->usesAnySampleRateInput != 0; }
+
+    protected:
+        ReflectionBlobEntryPoint const* m_data = nullptr;
+        ReflectionBlob const* m_blob = nullptr;
+    };
+
+    // Internal access to the contents, used by the handles
+
+    template <typename T>
+    T const* _getItem(ReflectionBlobSection section, uint32_t index) const
+    {
+        const ReflectionBlobRange& range = m_header->sections[uint32_t(section)];
+        return index < range.count ? ((T const*)((char const*)m_header + range.start)) + index : nullptr;
+    }
+    char const* _getString(uint32_t offset) const { return _getItem<char>(ReflectionBlobSection::Strings, offset); }
+    uint32_t _getIndex(uint32_t index) const
+    {
+        auto value = _getItem<uint32_t>(ReflectionBlobSection::Indices, index);
+        return value ? *value : uint32_t(kReflectionBlobNull);
+    }
+    size_t _findSize(const ReflectionBlobRange& range, SlangParameterCategory category) const
+    {
+        for (uint32_t i = 0; i < range.count; ++i)
+        {
+            auto size = _getItem<ReflectionBlobSize>(ReflectionBlobSection::Sizes, range.start + i);
+            if (size && size->category == category)
+                return _getSize(size->size);
+        }
+        return 0;
+    }
+    ReflectionBlobOffset const* _findOffset(const ReflectionBlobRange& range, SlangParameterCategory category) const
+    {
+        for (uint32_t i = 0; i < range.count; ++i)
+        {
+            auto offset = _getItem<ReflectionBlobOffset>(ReflectionBlobSection::Offsets, range.start + i);
+            if (offset && offset->category == category)
+                return offset;
+        }
+        return nullptr;
+    }
+    static size_t _getSize(uint64_t size) { return size == ~uint64_t(0) ? SLANG_UNBOUNDED_SIZE : size_t(size); }
+
+protected:
+    ReflectionBlobHeader const* m_header = nullptr;
+};
+
+inline ReflectionBlob::VariableLayout ReflectionBlob::getParameterByIndex(unsigned index) const
+{
+    if (index >= m_header->parameters.count)
+        return VariableLayout();
+    return VariableLayout(this, _getIndex(m_header->parameters.start + index));
+}
+
+inline ReflectionBlob::EntryPoint ReflectionBlob::getEntryPointByIndex(SlangUInt index) const
+{
+    if (index >= m_header->entryPoints.count)
+        return EntryPoint();
+    return EntryPoint(this, m_header->entryPoints.start + uint32_t(index));
+}
+
+inline ReflectionBlob::EntryPoint ReflectionBlob::findEntryPointByName(char const* name) const
+{
+    for (uint32_t i = 0; i < m_header->entryPoints.count; ++i)
+    {
+        EntryPoint entryPoint(this, m_header->entryPoints.start + i);
+        char const* entryPointName = entryPoint.getName();
+        if (entryPointName && strcmp(entryPointName, name) == 0)
+            return entryPoint;
+    }
+    return EntryPoint();
+}
+
+inline ReflectionBlob::VariableLayout ReflectionBlob::TypeLayout::getFieldByIndex(unsigned int index) const
+{
+    if (!m_data || index >= m_data->fields.count)
+        return VariableLayout();
+    return VariableLayout(m_blob, m_blob->_getIndex(m_data->fields.start + index));
+}
+
+inline ReflectionBlob::VariableLayout ReflectionBlob::TypeLayout::getElementVarLayout() const
+{
+    return m_data ? VariableLayout(m_blob, m_data->elementVarLayout) : VariableLayout();
+}
+
+} // namespace slang
+
+#endif // SLANG_REFLECTION_BLOB_H
@@ -526,8 +526,15 @@ extern "C"
         SLANG_CONTAINER_FORMAT_NONE,
 
         /* Generate a container in the `.slang-module` format,
-        which includes reflection information, compiled kernels, etc. */
+        which holds the compiled kernels for every target and entry point,
+        and the files the compile depended on. */
         SLANG_CONTAINER_FORMAT_SLANG_MODULE,
+
+        /* Generate a precompiled module in the `.slang-precompiled` format,
+        which holds the declarations and IR of each translation unit, so that
+        it can be imported without its source being parsed and checked again.
+        The name of each module is the name given to `spAddTranslationUnit`. */
+        SLANG_CONTAINER_FORMAT_PRECOMPILED_MODULE,
     };
 
     typedef int SlangPassThrough;
@@ -551,6 +558,24 @@ extern "C"
         /* Skip code generation step, just check the code and generate layout */
         SLANG_COMPILE_FLAG_NO_CODEGEN           = 1 << 4,
 
+        /* Only check the code and generate layout, for reflection. Unlike `SLANG_COMPILE_FLAG_NO_CODEGEN`
+        this also skips generating IR for the translation units, so diagnostics that are only found
+        when generating or checking IR (such as for a missing return) are not reported. */
+        SLANG_COMPILE_FLAG_REFLECTION_ONLY      = 1 << 5,
+
+        /* Only check the bodies of global functions that can be reached from an entry point (or from
+        a function marked `export`), and only generate IR for those. Diagnostics for the bodies of
+        functions that can't be reached are not reported. If a translation unit has no entry points,
+        all of its functions are checked as usual. */
+        SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING = 1 << 6,
+
+        /* Only generate IR for the global functions that can be reached from an entry point (or
+        that are marked `export`). All functions are still checked, but diagnostics that are only
+        found when generating or checking IR (such as for a missing return) are not reported for
+        functions that can't be reached. If a translation unit has no entry points, IR is generated
+        for all of its functions as usual. */
+        SLANG_COMPILE_FLAG_LAZY_LOWERING        = 1 << 7,
+
         /* Deprecated flags: kept around to allow existing applications to
         compile. Note that the relevant features will still be left in
         their default state. */
@@ -569,6 +594,26 @@ extern "C"
            @deprecated This behavior is now enabled unconditionally.
         */
         SLANG_TARGET_FLAG_PARAMETER_BLOCKS_USE_REGISTER_SPACES = 1 << 4,
+
+        /* When compiling to SPIR-V, generate it directly from the Slang IR instead of
+           generating GLSL and compiling that with glslang. Entry points that use features
+           the direct path doesn't support still go through GLSL.
+        */
+        SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY = 1 << 5,
+
+        /* When set, and the target is DXIL (or DXIL assembly), all of the entry points
+           are compiled together as one DXIL library with a `lib_6_x` profile, rather than
+           compiling each entry point separately. The code for each entry point is the
+           whole library.
+        */
+        SLANG_TARGET_FLAG_DXIL_LIBRARY = 1 << 6,
+
+        /* When set, identifiers in generated source code that are longer than 16 characters
+           (such as the names of specialized generics) are replaced with short names made
+           from a hash of the original name, to make the output smaller. Entry point names
+           are kept. Use `spGetOriginalName` to map a short name back to the original.
+        */
+        SLANG_TARGET_FLAG_SHORT_NAMES = 1 << 7,
     };
 
     /*!
@@ -592,6 +637,18 @@ extern "C"
         SLANG_LINE_DIRECTIVE_MODE_NONE,         /**< Don't emit line directives at all. */
         SLANG_LINE_DIRECTIVE_MODE_STANDARD,     /**< Emit standard C-style `#line` directives. */
         SLANG_LINE_DIRECTIVE_MODE_GLSL,         /**< Emit GLSL-style directives with file *number* instead of name */
+        SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP,   /**< Don't emit line directives, record the locations in a source map (see `spGetEntryPointSourceMap`) */
+    };
+
+    /*!
+    @brief Options to stop compilation after preprocessing (see `spSetPreprocessOnlyMode`)
+    */
+    typedef unsigned int SlangPreprocessOnlyMode;
+    enum
+    {
+        SLANG_PREPROCESS_ONLY_NONE = 0,         /**< Compile as normal. */
+        SLANG_PREPROCESS_ONLY_SOURCE,           /**< Output the preprocessed source. */
+        SLANG_PREPROCESS_ONLY_DEPENDENCIES,     /**< Output a Make style rule listing the files the source depends on. */
     };
 
     typedef int SlangSourceLanguage;
@@ -773,6 +830,10 @@ extern "C"
 #define SLANG_E_INTERNAL_FAIL               SLANG_MAKE_CORE_ERROR(6)
     //! Could not complete because some underlying feature (hardware or software) was not available 
 #define SLANG_E_NOT_AVAILABLE               SLANG_MAKE_CORE_ERROR(7)
+    //! A compile took longer than the limit set with `spSetCompileTimeLimit`
+#define SLANG_E_TIME_LIMIT                  SLANG_MAKE_CORE_ERROR(8)
+    //! A compile used more memory than the limit set with `spSetCompileMemoryLimit`
+#define SLANG_E_MEMORY_LIMIT                SLANG_MAKE_CORE_ERROR(9)
 
     /** A "Universally Unique Identifier" (UUID)
 
@@ -995,6 +1056,48 @@ extern "C"
 
     #define SLANG_UUID_ISlangFileSystemExt { 0x5fb632d2, 0x979d, 0x4481, { 0x9f, 0xee, 0x66, 0x3c, 0x3f, 0x14, 0x49, 0xe1 } }
 
+    /** A cache of compiler outputs, that can be shared between compiles, processes and machines.
+
+    The compiler looks up the outputs of a whole compile request before the front end runs, and the output
+    of a downstream compiler (fxc, dxc or glslang) before running it. Keys are null-terminated ASCII strings
+    made from a hash of everything known to affect the output. Entries are opaque blobs that also hold the full
+    key the compiler hashed, so an implementation can store them anywhere (such as in a remote key-value store)
+    without interpreting them, and hash collisions are detected by the compiler. The versions of the downstream
+    compilers aren't part of the keys, so a cache should only be shared by installs with the same downstream
+    compilers.
+
+    When downstream compiles run as more than one job (see `spSetBackEndJobCount`) the methods can be called
+    from several threads at once.
+    */
+    struct ISlangCompileCache : public ISlangUnknown
+    {
+    public:
+        /** Look up the entries for a batch of keys.
+        @param keys The keys to look up
+        @param keyCount The number of keys
+        @param outEntries Receives the entry for each key, or nullptr for a key that has no entry. The caller
+        releases the entries returned.
+        @returns SLANG_OK if the lookup was made, even if no entries were found.
+
+        A cache held on other machines should look up all of the keys with one round trip.
+        */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntries(
+            char const* const*  keys,
+            uint32_t            keyCount,
+            ISlangBlob**        outEntries) = 0;
+
+        /** Store the entry for a key, replacing any entry it already has.
+        @param key The key
+        @param entry The entry. The cache should add a reference to (or copy) the entry to keep it.
+        @returns SLANG_OK if the entry was stored. Failing to store an entry doesn't fail a compile.
+        */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL putEntry(
+            char const*     key,
+            ISlangBlob*     entry) = 0;
+    };
+
+    #define SLANG_UUID_ISlangCompileCache { 0x3c3a1d5e, 0x7b2f, 0x4c1a, { 0x9e, 0x41, 0x6d, 0x8a, 0x52, 0x0f, 0xb3, 0x97 } }
+
     /* Identifies different types of writer target*/
     typedef unsigned int SlangWriterChannel;
     enum
@@ -1111,6 +1214,39 @@ extern "C"
         SlangPassThrough    passThrough
     );
 
+    /*!
+    @brief Statistics about the standard library modules of a session.
+
+    Standard library modules are parsed and checked the first time a compile needs them.
+    Modules that are still pending have not been needed by any compile on the session,
+    so the time to load them has been saved.
+    */
+    struct SlangSessionStdLibStats
+    {
+        SlangUInt loadedModuleCount;        ///< Number of standard library modules loaded
+        SlangUInt pendingModuleCount;       ///< Number of standard library modules not loaded (yet)
+        double loadTimeInSeconds;           ///< Total time spent loading standard library modules
+    };
+
+    /*!
+    @brief Get statistics about the standard library modules loaded by a session
+    @param session Session
+    @param outStats Receives the statistics
+    */
+    SLANG_API void spSessionGetStdLibStats(
+        SlangSession*               session,
+        SlangSessionStdLibStats*    outStats);
+
+    /*!
+    @brief Load any standard library modules that are still pending.
+
+    Modules are otherwise loaded the first time a compile needs them. For a session that is used for many
+    compiles, loading them up front means the time isn't part of whichever compile happens to be first.
+    @param session Session
+    */
+    SLANG_API void spSessionLoadStdLib(
+        SlangSession*               session);
+
     /*!
     @brief Add new builtin declarations to be used in subsequent compiles.
     */
@@ -1131,6 +1267,18 @@ extern "C"
     SLANG_API void spDestroyCompileRequest(
         SlangCompileRequest*    request);
 
+    /*!
+    @brief Reset a compile request, so that it can be used for another compile.
+
+    The translation units, entry points (with their output paths and specialization arguments),
+    diagnostics and outputs of the request are removed. Everything else is kept: options and targets,
+    search paths and preprocessor definitions, source files that have been loaded, and modules that have
+    been imported (which are not loaded again). Compiling many permutations with one request that is
+    reset between them avoids setting up a new request each time.
+    */
+    SLANG_API void spResetCompileRequest(
+        SlangCompileRequest*    request);
+
     /** Set the filesystem hook to use for a compile request
 
     The provided `fileSystem` will be used to load any files that
@@ -1154,6 +1302,396 @@ extern "C"
         SlangCompileRequest*    request,
         SlangCompileFlags       flags);
 
+    /*!
+    @brief Set the directory used to hold the on-disk compile cache.
+
+    When set, the outputs of successful compiles are stored in the directory, keyed by the
+    contents of the sources and the options used. A later compile with the same key (whose
+    `#include`d and `import`ed files are also unchanged) produces its outputs from the cache
+    without running the compiler. On such a hit reflection information is not available.
+    The outputs of downstream compilers (such as fxc, dxc and glslang) are also stored, keyed by the
+    source they are given, their options and the contents of their shared library, so a compile that
+    emits the same source for them doesn't run them again.
+    @param request The compile request
+    @param path The cache directory. Setting nullptr or an empty string disables the cache.
+    */
+    SLANG_API void spSetCompileCacheDirectory(
+        SlangCompileRequest*    request,
+        char const*             path);
+
+    /*!
+    @brief Set the maximum size of the on-disk compile cache.
+
+    When storing a new result would take the cache over this size, the least recently
+    used entries are removed.
+    @param request The compile request
+    @param maxSizeInBytes The maximum size in bytes. 0 means there is no limit (the default).
+    */
+    SLANG_API void spSetCompileCacheMaxSize(
+        SlangCompileRequest*    request,
+        uint64_t                maxSizeInBytes);
+
+    /*!
+    @brief Set a compile cache implemented by the application, such as one shared by a build farm.
+
+    The cache is consulted with the key of the request before the front end runs (after the cache
+    directory set with `spSetCompileCacheDirectory`, which a hit is also stored to), and with the key of
+    each downstream compile before it is run. Outputs that weren't found are stored to the cache. The
+    cache is set on the linkage of the request, so for a request created from a `slang::ISession` it is also
+    used by the other requests of that session.
+    @param request The compile request
+    @param cache The cache, or nullptr to not use one. A reference is held for as long as it is set.
+    */
+    SLANG_API void spSetCompileCache(
+        SlangCompileRequest*    request,
+        ISlangCompileCache*     cache);
+
+    /*!
+    @brief Set whether permutations with the same preprocessed source share their outputs.
+
+    When enabled, the translation units are preprocessed first, and the request is keyed by the
+    preprocessed tokens (and their positions) rather than by the source text and defines. If a
+    compile with the same key was already done with the same session, or is held in the compile
+    cache (see `spSetCompileCacheDirectory`), its outputs are used, and the parse, check, lowering
+    and code generation steps are skipped. This helps when many permutations differ only by defines
+    that don't change the code being compiled. Defines are still part of the key when a translation
+    unit `import`s modules, as the modules are preprocessed with them. As with the compile cache,
+    reflection information isn't available when the outputs of another compile are used.
+    @param request The compile request
+    @param enable Non-zero to enable deduplication (the default is disabled)
+    */
+    SLANG_API void spSetPermutationDeduplicationEnabled(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /*!
+    @brief Set the number of downstream compiles (such as fxc, dxc or glslang) to run at once.
+
+    With more than one job, Slang generates the code for each (target, entry point) pair in turn
+    on the calling thread, and the downstream compile of each pair runs as a job on a pool of worker
+    threads, so that it overlaps with code generation for the pairs after it and with the other
+    compiles. Targets that don't use a downstream compiler are generated serially. Diagnostics are
+    always reported in the same order as for a serial compile.
+    @param request The compile request
+    @param jobCount The number of jobs to run at once. 1 is serial (the default), 0 uses one job per hardware thread.
+    */
+    SLANG_API void spSetBackEndJobCount(
+        SlangCompileRequest*    request,
+        int                     jobCount);
+
+    /*!
+    @brief Start loading the shared libraries of the downstream compilers (such as dxc, fxc or glslang)
+    needed by the targets and pass through mode set on the request so far, on a background thread.
+
+    The libraries are otherwise loaded when the first entry point that needs them is compiled. Call this
+    after setting the targets, so that loading overlaps with setting up the request and the front end.
+    The libraries are held by the session, so only need loading once. A library that fails to load is
+    reported when it is needed.
+    @param request The compile request
+    */
+    SLANG_API void spPreloadDownstreamLibraries(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief Set the number of worker threads that run downstream compiles (such as fxc, dxc or glslang).
+
+    Only applies when the back-end job count (see `spSetBackEndJobCount`) is not 1, and overrides it
+    as the number of downstream compiles to run at once.
+    @param request The compile request
+    @param jobCount The number of downstream compiles to run at once. 0 means the back-end job count (the default).
+    */
+    SLANG_API void spSetDownstreamCompileJobCount(
+        SlangCompileRequest*    request,
+        int                     jobCount);
+
+    /*!
+    @brief A timed phase of a compile, as recorded when profiling is enabled.
+
+    Events cover front-end phases (category "front-end"), code generation for each
+    entry point (category "back-end"), the IR passes run for each entry point
+    (category "ir-pass") and calls to downstream compilers (category "downstream").
+    For IR passes the size of the IR module before and after the pass is also recorded, and for
+    front-end phases the AST node allocations.
+    */
+    struct SlangProfileEvent
+    {
+        char const* name;                   ///< The name of the phase or pass
+        char const* category;               ///< The category of the event
+        char const* detail;                 ///< Extra information (such as a file path or entry point), may be empty
+        double startTimeInSeconds;          ///< Start time, relative to the start of the compile
+        double durationInSeconds;           ///< Time taken
+        SlangUInt threadIndex;              ///< Index of the thread, in order of first use, that ran the phase
+        SlangInt instCountBefore;           ///< IR instruction count before the phase, or -1 if not available
+        SlangInt instCountAfter;            ///< IR instruction count after the phase, or -1 if not available
+        SlangInt memoryBefore;              ///< Bytes of IR module memory before the phase, or -1 if not available
+        SlangInt memoryAfter;               ///< Bytes of IR module memory after the phase, or -1 if not available
+        SlangInt astNodeCountBefore;        ///< AST nodes allocated by the thread before a front-end phase, or -1 if not available
+        SlangInt astNodeCountAfter;         ///< AST nodes allocated by the thread after a front-end phase, or -1 if not available
+        SlangInt astPeakBytesBefore;        ///< Peak bytes of live AST nodes on the thread before a front-end phase, or -1 if not available
+        SlangInt astPeakBytesAfter;         ///< Peak bytes of live AST nodes on the thread after a front-end phase, or -1 if not available
+    };
+
+    /*!
+    @brief Set whether to load files through the process wide shared file cache (see `kSessionFlag_SharedFileCache`).
+
+    Only applies to files loaded from the OS file system (that is, if no file system has been set with `spSetFileSystem`).
+    */
+    SLANG_API void spSetSharedFileCacheEnabled(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /*!
+    @brief Set whether to share imported modules with other compile requests and sessions of the global session (see `kSessionFlag_SharedModuleCache`).
+    */
+    SLANG_API void spSetSharedModuleCacheEnabled(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /*!
+    @brief Set the maximum number of bytes of file contents held by the shared file cache. The default is 256MB.
+    */
+    SLANG_API void spSetSharedFileCacheCapacity(
+        size_t                  capacity);
+
+    /** Statistics for the shared file cache */
+    struct SlangSharedFileCacheStats
+    {
+        SlangInt hitCount;                  ///< Loads that used contents held by the cache
+        SlangInt missCount;                 ///< Loads that read the file
+        SlangInt fileCount;                 ///< Files held
+        SlangInt byteCount;                 ///< Bytes of file contents held
+    };
+
+    /*!
+    @brief Get the statistics for the shared file cache.
+    */
+    SLANG_API void spGetSharedFileCacheStats(
+        SlangSharedFileCacheStats*  outStats);
+
+    /*!
+    @brief Set whether to release the source and function bodies of imported modules once they are lowered to IR (see `kSessionFlag_CompactModules`).
+    */
+    SLANG_API void spSetCompactModulesEnabled(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /** Memory held by a module */
+    struct SlangModuleMemoryStats
+    {
+        SlangInt sourceBytes;               ///< Bytes of source file contents held for the module
+        SlangInt lineTableBytes;            ///< Bytes of the line break tables of the module's source files
+        SlangInt astBytes;                  ///< Bytes of the arena holding the module's AST
+        SlangInt irBytes;                   ///< Bytes of the module's IR
+    };
+
+    /*!
+    @brief Get the memory held by a module imported by the compile request.
+    @param request The compile request
+    @param moduleName The name of the module, as used in `import`
+    @param outStats Receives the memory held by the module
+    @return SLANG_E_NOT_FOUND if no module with the name has been loaded
+    */
+    SLANG_API SlangResult spGetModuleMemoryStats(
+        SlangCompileRequest*    request,
+        char const*             moduleName,
+        SlangModuleMemoryStats* outStats);
+
+    /** Memory held by a session, compile request or `slang::ISession`, by what holds it.
+
+    The sizes are found by visiting the modules, source files and caches that are held, without
+    walking the AST or IR, so are cheap enough to poll. Cache sizes are estimated from the number
+    of entries. Memory shared by several holders (such as a module from the shared module cache)
+    is counted by each of them.
+    */
+    struct SlangMemoryStats
+    {
+        SlangInt irBytes;                   ///< Bytes of IR, for loaded modules and programs
+        SlangInt astBytes;                  ///< Bytes of the arenas holding the AST of loaded modules
+        SlangInt sourceBytes;               ///< Bytes of source file contents
+        SlangInt sourceLocBytes;            ///< Bytes of line break tables, source views and paths, used to find source locations
+        SlangInt nameBytes;                 ///< Bytes of names (identifiers)
+        SlangInt tokenCacheBytes;           ///< Bytes of the tokens of included files kept by the session
+        SlangInt cacheBytes;                ///< Bytes of the type checking, type layout and permutation caches
+        SlangInt outputBytes;               ///< Bytes of compiled code held for entry points
+    };
+
+    /*!
+    @brief Get the memory held by a session (its standard library, shared caches, and modules shared between sessions).
+    */
+    SLANG_API void spGetSessionMemoryStats(
+        SlangSession*           session,
+        SlangMemoryStats*       outStats);
+
+    /*!
+    @brief Get the memory held by a compile request (its loaded modules, translation units, programs and caches).
+
+    Does not include the memory held by the session (see `spGetSessionMemoryStats`).
+    */
+    SLANG_API void spGetCompileRequestMemoryStats(
+        SlangCompileRequest*    request,
+        SlangMemoryStats*       outStats);
+
+    /*!
+    @brief Set whether to record the time taken by each phase of the compile.
+    @param request The compile request
+    @param enable If non-zero, record a profile for each call to `spCompile`
+    */
+    SLANG_API void spSetProfilingEnabled(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /*!
+    @brief Get the number of events recorded by the last compile with profiling enabled.
+    */
+    SLANG_API SlangInt spGetProfileEventCount(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief Get a profile event recorded by the last compile.
+
+    The strings in the event remain valid until the next compile, or the request is destroyed.
+    @param request The compile request
+    @param eventIndex The index of the event (events are in the order they completed)
+    @param outEvent Receives the event
+    */
+    SLANG_API SlangResult spGetProfileEvent(
+        SlangCompileRequest*    request,
+        SlangInt                eventIndex,
+        SlangProfileEvent*      outEvent);
+
+    /*!
+    @brief Get the profile of the last compile in Chrome trace event JSON format (as viewed with chrome://tracing).
+
+    Returns nullptr if profiling was not enabled. The text remains valid until the next call
+    to this function, or the request is destroyed.
+    */
+    SLANG_API char const* spGetProfileChromeTrace(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief The size of the code generated for an entry point, as recorded when code reports are enabled.
+
+    Entry points that are emitted together (such as into one HLSL library) share a report, and
+    `entryPointName` lists all of them, separated by commas.
+    */
+    struct SlangEntryPointCodeStats
+    {
+        char const* entryPointName;         ///< The name of the entry point
+        char const* targetName;             ///< The name of the target
+        SlangInt instCount;                 ///< IR instructions in the module the code was emitted from
+        SlangInt peakLiveValueCount;        ///< The most SSA values live at once in any function (a rough measure of register pressure)
+        SlangInt sourceByteCount;           ///< Bytes of source code emitted
+        SlangInt temporaryCount;            ///< Temporaries declared in the emitted source for intermediate values
+    };
+
+    /*!
+    @brief Set whether to record the size of the code generated for each entry point.
+
+    The report covers source targets (HLSL, GLSL, C and C++) and targets compiled from them. As well as
+    the statistics in `SlangEntryPointCodeStats`, the JSON report (see `spGetCodeReportJSON`) holds the
+    number of IR instructions with each opcode after the major stages of code generation (linking,
+    specialization, legalization and optimization), to help find where code size blows up.
+    @param request The compile request
+    @param enable If non-zero, record a report for each call to `spCompile`
+    */
+    SLANG_API void spSetCodeReportEnabled(
+        SlangCompileRequest*    request,
+        int                     enable);
+
+    /*!
+    @brief Get the number of entry point reports recorded by the last compile with code reports enabled.
+    */
+    SLANG_API SlangInt spGetCodeReportEntryPointCount(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief Get the report for an entry point recorded by the last compile.
+
+    The strings in the report remain valid until the next compile, or the request is destroyed.
+    @param request The compile request
+    @param index The index of the report (in the order code was generated)
+    @param outStats Receives the report
+    */
+    SLANG_API SlangResult spGetCodeReportEntryPoint(
+        SlangCompileRequest*        request,
+        SlangInt                    index,
+        SlangEntryPointCodeStats*   outStats);
+
+    /*!
+    @brief Get the code report of the last compile as JSON.
+
+    Returns nullptr if code reports were not enabled. The text remains valid until the next call
+    to this function, or the request is destroyed.
+    */
+    SLANG_API char const* spGetCodeReportJSON(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief Set the longest time a compile can take.
+
+    The limit is checked between the phases of a compile, and periodically inside long running
+    passes, so a compile can take a little longer than the limit before it stops. A compile that
+    goes over the limit fails with `SLANG_E_TIME_LIMIT`.
+    @param request The compile request
+    @param seconds The limit in seconds. 0 (the default) means there is no limit.
+    */
+    SLANG_API void spSetCompileTimeLimit(
+        SlangCompileRequest*    request,
+        double                  seconds);
+
+    /*!
+    @brief Set the most memory a compile can use.
+
+    The memory measured is that of the AST built by the compile (on the calling thread) and of the
+    IR module being worked on, checked at the same points as the time limit. A compile that goes
+    over the limit fails with `SLANG_E_MEMORY_LIMIT`.
+    @param request The compile request
+    @param maxSizeInBytes The limit in bytes. 0 (the default) means there is no limit.
+    */
+    SLANG_API void spSetCompileMemoryLimit(
+        SlangCompileRequest*    request,
+        uint64_t                maxSizeInBytes);
+
+    /*!
+    @brief Cancel a compile.
+
+    Can be called from any thread, including while `spCompile` is running on another thread,
+    in which case that compile stops at its next check and fails with `SLANG_E_ABORT`. Once
+    cancelled, any later compile with the request also fails.
+    */
+    SLANG_API void spCancelCompile(
+        SlangCompileRequest*    request);
+
+    /*!
+    @brief Set whether compilation stops after preprocessing, and what is output if it does.
+    @param request The compile request
+    @param mode One of the `SLANG_PREPROCESS_ONLY_` values
+
+    Only the translation units are preprocessed (modules they `import` are not loaded), so this
+    is much faster than a full compile. The output is available from `spGetPreprocessOutput`,
+    and `spGetDependencyFileCount` and `spGetDependencyFilePath` give the files that were read.
+    */
+    SLANG_API void spSetPreprocessOnlyMode(
+        SlangCompileRequest*    request,
+        SlangPreprocessOnlyMode mode);
+
+    /*!
+    @brief Set the target named by the rule output with `SLANG_PREPROCESS_ONLY_DEPENDENCIES`.
+    If not set (or nullptr), the path of the first source file is used.
+    */
+    SLANG_API void spSetDependencyRuleTarget(
+        SlangCompileRequest*    request,
+        char const*             target);
+
+    /*!
+    @brief Get the output of the last compile with a preprocess-only mode set.
+
+    Returns nullptr if the last compile wasn't preprocess-only. The text remains valid until the next
+    compile, or the request is destroyed.
+    */
+    SLANG_API char const* spGetPreprocessOutput(
+        SlangCompileRequest*    request);
+
     /*!
     @brief Set whether to dump intermediate results (for debugging) or not.
     */
@@ -1289,7 +1827,9 @@ extern "C"
 
     /** Add a distinct translation unit to the compilation request
 
-    `name` is optional.
+    `name` is optional. If set (and not already used by another translation unit) it is the
+    name of the module the translation unit produces, which is the name a precompiled module
+    (see `SLANG_CONTAINER_FORMAT_PRECOMPILED_MODULE`) is imported by.
     Returns the zero-based index of the translation unit created.
     */
     SLANG_API int spAddTranslationUnit(
@@ -1436,6 +1976,13 @@ extern "C"
     for each existential slot. This function specifies the name of the type
     (or in general a type *expression*) to use for a specific slot at the
     global scope.
+
+    Specializing for every combination of concrete types can require many
+    compiles. A slot may instead be given a tagged union over a closed set of
+    types, e.g. `__TaggedUnion(Matte, Glossy)`, in which case the value stored
+    for the slot holds a tag (the index of its type in the list), and calls
+    through the slot dispatch on that tag at runtime. One compiled kernel then
+    serves every type in the set.
     */
     SLANG_API SlangResult spSetTypeNameForGlobalExistentialTypeParam(
         SlangCompileRequest*    request,
@@ -1539,7 +2086,9 @@ extern "C"
     @param outBlob A pointer that will receive the blob of code
     @returns A `SlangResult` to indicate success or failure.
 
-    The lifetime of the output pointer is the same as `request`.
+    The blob holds the output of the request (and of any downstream compiler) rather than a copy
+    of it, so getting it doesn't copy the code, and the blob can be held after the request is
+    destroyed.
     */
     SLANG_API SlangResult spGetEntryPointCodeBlob(
         SlangCompileRequest*    request,
@@ -1547,8 +2096,78 @@ extern "C"
         int                     targetIndex,
         ISlangBlob**            outBlob);
 
+    /** Write the output code associated with a specific entry point to a writer.
+
+    @param entryPointIndex The index of the entry point to write code for.
+    @param targetIndex The index of the target to write code for.
+    @param writer The writer the code is written to. It is written without an intermediate copy,
+    so the writer can place it directly in memory of the application's own (such as a file or a
+    mapped GPU upload buffer).
+    @returns A `SlangResult` to indicate success or failure. SLANG_FAIL if there is no code for
+    the entry point and target.
+    */
+    SLANG_API SlangResult spWriteEntryPointCode(
+        SlangCompileRequest*    request,
+        int                     entryPointIndex,
+        int                     targetIndex,
+        ISlangWriter*           writer);
+
+    /** Get the source map for the output code of a specific entry point.
+
+    @param entryPointIndex The index of the entry point to get the source map for.
+    @param targetIndex The index of the target to get the source map for.
+    @param outBlob A pointer that will receive the blob holding the source map
+    @returns A `SlangResult` to indicate success or failure. SLANG_E_NOT_FOUND if there is no source
+    map, because the line directive mode isn't `SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP` or the target
+    doesn't output source code.
+
+    With `SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP` the output source contains no `#line` directives, and
+    the source location that each part of the output came from is recorded in a compact binary map
+    instead. All values are little endian.
+
+    * Header: four uint32s: the four-cc 'SLsm', the version (1), the file count and the entry count
+    * Files: for each file a uint32 byte count followed by the UTF-8 path (not zero terminated)
+    * Entries: for each entry, in order of output position, five variable length encoded uint32s
+    (see `ByteEncodeUtil::encodeLiteUInt32`): the output line (as the difference from the output line of the
+    previous entry), the output column, the file index, the source line, the source column (0 if not known)
+
+    Lines and columns start at 1. As with a `#line` directive, the output lines following an entry map to the
+    source lines following the entry's line, up to the next entry.
+    */
+    SLANG_API SlangResult spGetEntryPointSourceMap(
+        SlangCompileRequest*    request,
+        int                     entryPointIndex,
+        int                     targetIndex,
+        ISlangBlob**            outBlob);
+
+    /** Tell the request that the files at `paths` have changed (or been created or deleted).
+
+    Modules loaded by `import` are kept by a request that is reused with `spResetCompileRequest`.
+    This discards the cached contents of just the files at `paths`, and the modules that depend
+    on them, so they are loaded again by the next compile. See `slang::ISession::invalidateFiles`.
+    */
+    SLANG_API void spInvalidateFiles(
+        SlangCompileRequest*    request,
+        char const* const*      paths,
+        SlangInt                pathCount);
+
+    /** Get the identifier that a short name in generated source code replaced.
+
+    Identifiers are only replaced for targets with `SLANG_TARGET_FLAG_SHORT_NAMES` set.
+    Returns null if `shortName` isn't the replacement for an identifier.
+
+    The lifetime of the output pointer is the same as `request`.
+    */
+    SLANG_API char const* spGetOriginalName(
+        SlangCompileRequest*    request,
+        char const*             shortName);
+
     /** Get the output bytecode associated with an entire compile request.
 
+    This is the container set with `spSetOutputContainerFormat`, holding the
+    code for every target and entry point. Returns null if no container
+    format was set.
+
     The lifetime of the output pointer is the same as `request`.
     */
     SLANG_API void const* spGetCompileRequestCode(
@@ -1891,6 +2510,26 @@ extern "C"
     SLANG_API int spReflectionEntryPoint_usesAnySampleRateInput(
         SlangReflectionEntryPoint* entryPoint);
 
+        /** Get a bit mask of the global parameters (see `spReflection_GetParameterByIndex`) used by the
+        code generated for the entry point. Bit `i % 32` of `outMask[i / 32]` is set if parameter `i` is used,
+        and `maskWordCount` words are written.
+
+        Parameters whose uses are all removed as dead code are not used, and don't need to be bound
+        when running the entry point. Returns SLANG_E_NOT_AVAILABLE if code hasn't been generated for
+        the entry point (such as with SLANG_COMPILE_FLAG_NO_CODEGEN).
+        */
+    SLANG_API SlangResult spReflectionEntryPoint_getUsedGlobalParameterMask(
+        SlangReflectionEntryPoint*  entryPoint,
+        SlangUInt                   maskWordCount,
+        uint32_t*                   outMask);
+
+        /** Get whether the global parameter at `parameterIndex` is used by the code generated for the entry point.
+        Returns SLANG_E_NOT_AVAILABLE if code hasn't been generated for the entry point. */
+    SLANG_API SlangResult spReflectionEntryPoint_isGlobalParameterUsed(
+        SlangReflectionEntryPoint*  entryPoint,
+        SlangUInt                   parameterIndex,
+        int*                        outUsed);
+
     // SlangReflectionTypeParameter
     SLANG_API char const* spReflectionTypeParameter_GetName(SlangReflectionTypeParameter* typeParam);
     SLANG_API unsigned spReflectionTypeParameter_GetIndex(SlangReflectionTypeParameter* typeParam);
@@ -1919,6 +2558,20 @@ extern "C"
     SLANG_API SlangUInt spReflection_getGlobalConstantBufferBinding(SlangReflection* reflection);
     SLANG_API size_t spReflection_getGlobalConstantBufferSize(SlangReflection* reflection);
 
+        /** Get the number of specialization constants (global constants marked `[[vk::constant_id(...)]]`).
+        Targets with specialization constants (SPIR-V and GLSL) let the value of each one be set when a
+        pipeline is created; other targets use the default values. */
+    SLANG_API SlangInt spReflection_getSpecializationConstantCount(SlangReflection* reflection);
+    SLANG_API SlangReflectionVariable* spReflection_getSpecializationConstantByIndex(SlangReflection* reflection, SlangInt index);
+        /** Get the constant id of a specialization constant, which identifies it when it is set. */
+    SLANG_API SlangInt spReflection_getSpecializationConstantID(SlangReflection* reflection, SlangInt index);
+        /** Get the value a specialization constant has if it isn't set (1 or 0 for a `bool`). */
+    SLANG_API int64_t spReflection_getSpecializationConstantDefaultValue(SlangReflection* reflection, SlangInt index);
+
+        /** Write the layout information of the program to a blob that can be read with `slang::ReflectionBlob`
+        (see slang-reflection-blob.h), without needing the compile request that produced it. */
+    SLANG_API SlangResult spReflection_writeBlob(SlangReflection* reflection, ISlangBlob** outBlob);
+
     SLANG_API  SlangReflectionType* spReflection_specializeType(
         SlangReflection*            reflection,
         SlangReflectionType*        type,
@@ -1935,6 +2588,36 @@ extern "C"
     SLANG_API SlangInt spEntryPointGroupLayout_getParameterCount(SlangEntryPointGroupLayout* group);
     SLANG_API SlangReflectionVariableLayout* spEntryPointGroupLayout_getParameterByIndex(SlangEntryPointGroupLayout* group, SlangInt index);
 
+    // Binding tables
+
+    /** A leaf of the parameters of a program or entry point group, with the absolute location it was bound to.
+
+    Each leaf has an entry for every kind of resource it uses. For a constant buffer (or parameter block)
+    the buffer itself is the leaf, and the uniform data in it has entries of its own that refer back
+    to it. The resources in an array of structures are found under a path such as `lights[].shadowMap`,
+    with a count covering every element.
+    */
+    struct SlangBindingTableEntry
+    {
+        char const*                 path;           ///< The names from the scope to the leaf, such as `gView.shadows`
+        SlangParameterCategory      category;       ///< The kind of resource
+        SlangReflectionTypeLayout*  typeLayout;     ///< The layout of the leaf
+        SlangUInt                   index;          ///< The register or binding, or for uniform data the byte offset in its buffer
+        SlangUInt                   space;          ///< The register space or descriptor set
+        size_t                      count;          ///< The number of registers or bindings (SLANG_UNBOUNDED_SIZE if unbounded), or for uniform data the size in bytes
+        SlangInt                    bufferIndex;    ///< For uniform data, the index of the entry of the buffer holding it, or -1 if there isn't one
+        SlangInt                    parameterIndex; ///< The index of the parameter of the scope holding the leaf, or -1 (such as for the implicit constant buffer of global uniforms)
+    };
+
+        /** Get the flattened global parameters of the program. The table is computed with the layout,
+        and the entries remain valid as long as the reflection does. */
+    SLANG_API SlangInt spReflection_getBindingTableEntryCount(SlangReflection* reflection);
+    SLANG_API SlangResult spReflection_getBindingTableEntry(SlangReflection* reflection, SlangInt index, SlangBindingTableEntry* outEntry);
+
+        /** Get the flattened parameters of the group, and of its entry points (under the name of each entry point). */
+    SLANG_API SlangInt spEntryPointGroupLayout_getBindingTableEntryCount(SlangEntryPointGroupLayout* group);
+    SLANG_API SlangResult spEntryPointGroupLayout_getBindingTableEntry(SlangEntryPointGroupLayout* group, SlangInt index, SlangBindingTableEntry* outEntry);
+
 
 #ifdef __cplusplus
 }
@@ -2439,6 +3122,16 @@ namespace slang
         {
             return 0 != spReflectionEntryPoint_usesAnySampleRateInput((SlangReflectionEntryPoint*) this);
         }
+
+        SlangResult getUsedGlobalParameterMask(SlangUInt maskWordCount, uint32_t* outMask)
+        {
+            return spReflectionEntryPoint_getUsedGlobalParameterMask((SlangReflectionEntryPoint*) this, maskWordCount, outMask);
+        }
+
+        SlangResult isGlobalParameterUsed(SlangUInt parameterIndex, int* outUsed)
+        {
+            return spReflectionEntryPoint_isGlobalParameterUsed((SlangReflectionEntryPoint*) this, parameterIndex, outUsed);
+        }
     };
     typedef EntryPointReflection EntryPointLayout;
 
@@ -2468,6 +3161,16 @@ namespace slang
         {
             return (VariableLayoutReflection*) spEntryPointGroupLayout_getParameterByIndex((SlangEntryPointGroupLayout*) this, index);
         }
+
+        SlangInt getBindingTableEntryCount()
+        {
+            return spEntryPointGroupLayout_getBindingTableEntryCount((SlangEntryPointGroupLayout*) this);
+        }
+
+        SlangResult getBindingTableEntry(SlangInt index, SlangBindingTableEntry* outEntry)
+        {
+            return spEntryPointGroupLayout_getBindingTableEntry((SlangEntryPointGroupLayout*) this, index, outEntry);
+        }
     };
 
     struct TypeParameterReflection
@@ -2559,6 +3262,41 @@ namespace slang
             return spReflection_getGlobalConstantBufferSize((SlangReflection*)this);
         }
 
+        SlangInt getSpecializationConstantCount()
+        {
+            return spReflection_getSpecializationConstantCount((SlangReflection*)this);
+        }
+
+        VariableReflection* getSpecializationConstantByIndex(SlangInt index)
+        {
+            return (VariableReflection*)spReflection_getSpecializationConstantByIndex((SlangReflection*)this, index);
+        }
+
+        SlangInt getSpecializationConstantID(SlangInt index)
+        {
+            return spReflection_getSpecializationConstantID((SlangReflection*)this, index);
+        }
+
+        int64_t getSpecializationConstantDefaultValue(SlangInt index)
+        {
+            return spReflection_getSpecializationConstantDefaultValue((SlangReflection*)this, index);
+        }
+
+        SlangResult writeBlob(ISlangBlob** outBlob)
+        {
+            return spReflection_writeBlob((SlangReflection*)this, outBlob);
+        }
+
+        SlangInt getBindingTableEntryCount()
+        {
+            return spReflection_getBindingTableEntryCount((SlangReflection*) this);
+        }
+
+        SlangResult getBindingTableEntry(SlangInt index, SlangBindingTableEntry* outEntry)
+        {
+            return spReflection_getBindingTableEntry((SlangReflection*) this, index, outEntry);
+        }
+
         TypeReflection* findTypeByName(const char* name)
         {
             return (TypeReflection*)spReflection_FindTypeByName(
@@ -2619,6 +3357,18 @@ namespace slang
         The global session is currently *not* thread-safe and objects created from
         a single global session should only be used from a single thread at
         a time.
+
+        In particular, no two calls into objects created from the same global
+        session (including different `ISession`s, and compile requests created
+        with `spCreateCompileRequest`) may run in parallel. The standard library
+        AST is shared by all of them, and uses non-atomic reference counting.
+        Compilations that need to run in parallel should each use their own
+        global session. (Sharing a global session isn't supported yet. The work
+        it needs is listed in `docs/design/thread-safety.md`.)
+
+        Each `ISession` holds its own semantic checking caches, so the results of
+        compiling with one session are never affected by what was previously
+        compiled with another.
         */
     struct IGlobalSession : public ISlangUnknown
     {
@@ -2679,6 +3429,60 @@ namespace slang
         You have been warned.
         */
         kSessionFlag_FalcorCustomSharedKeywordSemantics = 1 << 0,
+
+        /** Only reuse loaded modules whose source files are unchanged.
+
+        Normally once a module has been loaded into a session, it is reused by
+        every later `loadModule` call and compile request in the session, even if
+        its source files are changed on disk. With this flag set, each call to
+        `ISession::loadModule` or `ISession::createCompileRequest` first checks the
+        contents of the files every loaded module depends on (including the files
+        of modules it imports, and any `#include`d files). Modules with a changed
+        file are discarded (and so loaded again if they are needed), while the
+        checked AST and IR of the other modules are reused.
+        */
+        kSessionFlag_IncrementalCompilation = 1 << 1,
+
+        /** Load source files through a cache shared by every session in the process that uses it.
+
+        Without this flag each session (and compile request) reads every file it uses,
+        even if the same files have been read by another session. With it, the contents of
+        files loaded from the OS file system are kept in a process wide cache and reused as
+        long as the file's size and modification time are unchanged. See
+        `spSetSharedFileCacheEnabled` to use the cache with a compile request.
+        */
+        kSessionFlag_SharedFileCache = 1 << 2,
+
+        /** Share the modules loaded by `import` with other sessions of the global session that set this flag.
+
+        Without this flag each session loads, parses and checks every module it imports, even if
+        another session has loaded the same file. With it, imported modules are kept by the global
+        session and reused (without being parsed or checked again) by sessions with the same search
+        paths, preprocessor macros and file system, as long as the contents of the files the module
+        depends on are unchanged. Shared modules are immutable, and so can be used by any number of
+        sessions. See `spSetSharedModuleCacheEnabled` to use the cache with a compile request.
+        */
+        kSessionFlag_SharedModuleCache = 1 << 3,
+
+        /** The application reports the source files that change with `ISession::invalidateFiles`.
+
+        With `kSessionFlag_IncrementalCompilation`, `loadModule` and `createCompileRequest` no
+        longer check the contents of every file that loaded modules depend on. Only the modules
+        that depend on files passed to `invalidateFiles` are discarded.
+        */
+        kSessionFlag_FileChangeNotifications = 1 << 4,
+
+        /** Release the source and function bodies of loaded modules once they are lowered to IR.
+
+        A loaded module normally holds on to the contents of its source files, and the AST of
+        every function body, for as long as it is loaded, although only the IR and declarations
+        are used once it has been lowered. With this flag set, source file contents are released
+        (keeping the line break tables, so locations in them can still be reported), and the
+        bodies of functions are removed from the AST, once a module has been lowered. A file
+        included by several modules is released once all of them are lowered. See
+        `IModule::getMemoryStats` for the memory a module holds.
+        */
+        kSessionFlag_CompactModules = 1 << 5,
     };
 
     struct PreprocessorMacroDesc
@@ -2712,6 +3516,27 @@ namespace slang
 
     };
 
+    typedef uint32_t SpecializeBatchFlags;
+    enum
+    {
+        kSpecializeBatchFlags_None = 0,
+
+        /** Compute the layout of every specialized program for each target of the session.
+
+        Without this flag layouts are computed the first time they are asked for.
+        */
+        kSpecializeBatchFlag_Layout = 1 << 0,
+
+        /** Generate the code for every entry point of every specialized program, for each target.
+
+        The code is generated by a pool of threads, one per core. Only one thread
+        lowers and emits code at a time, but the downstream compilers (fxc, dxc,
+        glslang and so on) run in parallel. The results are returned by later calls
+        to `IProgram::getEntryPointCode`.
+        */
+        kSpecializeBatchFlag_GenerateCode = 1 << 1,
+    };
+
         /** A session provides a scope for code that is loaded.
 
         A session can be used to load modules of Slang source code,
@@ -2786,6 +3611,49 @@ namespace slang
             */
         virtual SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) = 0;
+
+            /** Specialize a program for many sets of type arguments in one call.
+
+            `specializationArgs` holds `specializationSetCount` sets of arguments, one after
+            another, with `specializationArgCount` arguments in each. The program specialized
+            for set `i` is written to `outSpecializedPrograms[i]`, and is the same as the
+            program `specializeProgram` would return for that set.
+
+            Work that doesn't depend on the arguments, such as finding the shader parameters
+            of `program`, is only done once, and each conformance of an argument type to a
+            parameter's interface is only checked once for the whole batch. See
+            `SpecializeBatchFlags` for computing layouts or code as part of the call.
+
+            If any set fails to specialize, nothing is written to `outSpecializedPrograms`
+            and `SLANG_FAIL` is returned, with the diagnostics for every set.
+            */
+        virtual SLANG_NO_THROW SlangResult SLANG_MCALL specializeProgramBatch(
+            IProgram*                   program,
+            SlangInt                    specializationSetCount,
+            SlangInt                    specializationArgCount,
+            SpecializationArg const*    specializationArgs,
+            SpecializeBatchFlags        flags,
+            IProgram**                  outSpecializedPrograms,
+            ISlangBlob**                outDiagnostics = nullptr) = 0;
+
+            /** Tell the session that the files at `paths` have changed (or been created or deleted).
+
+            Cached information about just those files is discarded, along with any loaded
+            modules that depend on them (by `#include` or `import`, directly or not), so they
+            are read and loaded again when they are next needed. Other modules are kept.
+            An application can call this from its own file watcher, in place of discarding
+            the whole session. Must not be called while the session is compiling.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL invalidateFiles(
+            char const* const*  paths,
+            SlangInt            pathCount) = 0;
+
+            /** Get the memory held by the session (its loaded modules, source files and caches).
+
+            Does not include the memory held by the global session (see `spGetSessionMemoryStats`).
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL getMemoryStats(
+            SlangMemoryStats*   outStats) = 0;
     };
 
     #define SLANG_UUID_ISession { 0x67618701, 0xd116, 0x468f, { 0xab, 0x3b, 0x47, 0x4b, 0xed, 0xce, 0xe, 0x3d } }
@@ -2805,6 +3673,10 @@ namespace slang
     struct IModule : public ISlangUnknown
     {
     public:
+            /** Get the memory held by the module.
+            */
+        virtual SLANG_NO_THROW void SLANG_MCALL getMemoryStats(
+            SlangModuleMemoryStats* outStats) = 0;
     };
     
     #define SLANG_UUID_IModule { 0xc720e64, 0x8722, 0x4d31, { 0x89, 0x90, 0x63, 0x8a, 0x98, 0xb1, 0xc2, 0x79 } }
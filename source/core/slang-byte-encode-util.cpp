@@ -1,5 +1,28 @@
 #include "slang-byte-encode-util.h"
 
+// Stream vbyte decoding uses a byte shuffle, which needs SSSE3 on x86 (checked for at runtime)
+// or NEON on 64 bit ARM (always available)
+#if SLANG_PROCESSOR_FAMILY_X86 && (SLANG_GCC_FAMILY || SLANG_VC)
+#   define SLANG_BYTE_ENCODE_USE_SSSE3 1
+#   if SLANG_VC
+#       include <intrin.h>
+#       define SLANG_BYTE_ENCODE_SSSE3_TARGET
+#   else
+#       include <tmmintrin.h>
+#       define SLANG_BYTE_ENCODE_SSSE3_TARGET __attribute__((target("ssse3")))
+#   endif
+#elif SLANG_PROCESSOR_ARM_64
+#   define SLANG_BYTE_ENCODE_USE_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#ifndef SLANG_BYTE_ENCODE_USE_SSSE3
+#   define SLANG_BYTE_ENCODE_USE_SSSE3 0
+#endif
+#ifndef SLANG_BYTE_ENCODE_USE_NEON
+#   define SLANG_BYTE_ENCODE_USE_NEON 0
+#endif
+
 namespace Slang {
 
 // Descriptions of algorithms here...
@@ -278,4 +301,214 @@ static const uint32_t s_unalignedUInt32Mask[5] =
     return size_t(encodeIn - encodeStart);
 }
 
+namespace { // anonymous
+
+    /// Tables for decoding a control byte of a stream vbyte encoding (ie four values)
+struct StreamVByteTables
+{
+    StreamVByteTables()
+    {
+        for (int control = 0; control < 256; ++control)
+        {
+            int dataIndex = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const int numBytes = ((control >> (i * 2)) & 3) + 1;
+                for (int j = 0; j < 4; ++j)
+                {
+                    // An index with the top bit set produces 0 (with pshufb and tbl)
+                    shuffle[control][i * 4 + j] = uint8_t((j < numBytes) ? (dataIndex + j) : 0xff);
+                }
+                dataIndex += numBytes;
+            }
+            length[control] = uint8_t(dataIndex);
+        }
+    }
+
+    uint8_t shuffle[256][16];       ///< Shuffles the data bytes of four values into four uint32_t
+    uint8_t length[256];            ///< The total number of data bytes of the four values
+
+    static const StreamVByteTables& get()
+    {
+        static const StreamVByteTables tables;
+        return tables;
+    }
+};
+
+} // anonymous
+
+SLANG_FORCE_INLINE static int _calcStreamVByteNumBytes(uint32_t v)
+{
+    return (v & 0xffff0000) ? ((v & 0xff000000) ? 4 : 3) : ((v & 0x0000ff00) ? 2 : 1);
+}
+
+/* static */size_t ByteEncodeUtil::calcEncodeStreamVByteSizeUInt32(const uint32_t* in, size_t num)
+{
+    size_t size = (num + 3) >> 2;
+    for (size_t i = 0; i < num; ++i)
+    {
+        size += _calcStreamVByteNumBytes(in[i]);
+    }
+    return size;
+}
+
+/* static */size_t ByteEncodeUtil::encodeStreamVByteUInt32(const uint32_t* in, size_t num, uint8_t* encodeOut)
+{
+    uint8_t* controlOut = encodeOut;
+    const size_t numControlBytes = (num + 3) >> 2;
+    uint8_t* dataOut = encodeOut + numControlBytes;
+
+    // Unused bits of the last control byte are 0
+    if (numControlBytes)
+    {
+        controlOut[numControlBytes - 1] = 0;
+    }
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        uint32_t v = in[i];
+        const int numBytes = _calcStreamVByteNumBytes(v);
+
+        const int shift = int(i & 3) * 2;
+        if (shift == 0)
+        {
+            controlOut[i >> 2] = uint8_t(numBytes - 1);
+        }
+        else
+        {
+            controlOut[i >> 2] |= uint8_t((numBytes - 1) << shift);
+        }
+
+        for (int j = 0; j < numBytes; ++j)
+        {
+            *dataOut++ = uint8_t(v);
+            v >>= 8;
+        }
+    }
+    return size_t(dataOut - encodeOut);
+}
+
+/* static */void ByteEncodeUtil::encodeStreamVByteUInt32(const uint32_t* in, size_t num, List<uint8_t>& encodeOut)
+{
+    encodeOut.setCount(Index(calcEncodeStreamVByteSizeUInt32(in, num)));
+    const size_t size = encodeStreamVByteUInt32(in, num, encodeOut.getBuffer());
+    SLANG_UNUSED(size);
+    SLANG_ASSERT(size == size_t(encodeOut.getCount()));
+}
+
+    /// Decode numValues values using the control bytes at controlIn and data at dataIn, returning the end of the data
+static const uint8_t* _decodeStreamVByteScalar(const uint8_t* controlIn, const uint8_t* dataIn, size_t numValues, uint32_t* valuesOut)
+{
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        const int numBytes = ((controlIn[i >> 2] >> ((i & 3) * 2)) & 3) + 1;
+
+        uint32_t value = dataIn[0];
+        switch (numBytes)
+        {
+            case 4: value |= uint32_t(dataIn[3]) << 24;         /* fall thru */
+            case 3: value |= uint32_t(dataIn[2]) << 16;         /* fall thru */
+            case 2: value |= uint32_t(dataIn[1]) << 8;          /* fall thru */
+            case 1: break;
+        }
+        valuesOut[i] = value;
+        dataIn += numBytes;
+    }
+    return dataIn;
+}
+
+    /// Each group of four values has between 4 and 16 bytes of data. SIMD decode reads 16 bytes of
+    /// data for each group, which is only known to be within the encoding if there are at least 4
+    /// groups left. Returns the number of groups that can be decoded with SIMD.
+static size_t _calcStreamVByteSimdGroupCount(size_t numValues)
+{
+    const size_t numGroups = numValues >> 2;
+    return (numGroups >= 4) ? numGroups - 3 : 0;
+}
+
+#if SLANG_BYTE_ENCODE_USE_SSSE3
+
+SLANG_BYTE_ENCODE_SSSE3_TARGET static const uint8_t* _decodeStreamVByteGroupsSSSE3(const uint8_t* controlIn, const uint8_t* dataIn, size_t numGroups, uint32_t* valuesOut)
+{
+    const StreamVByteTables& tables = StreamVByteTables::get();
+    for (size_t i = 0; i < numGroups; ++i)
+    {
+        const uint8_t control = controlIn[i];
+        const __m128i data = _mm_loadu_si128((const __m128i*)dataIn);
+        const __m128i shuffle = _mm_loadu_si128((const __m128i*)tables.shuffle[control]);
+        _mm_storeu_si128((__m128i*)(valuesOut + i * 4), _mm_shuffle_epi8(data, shuffle));
+        dataIn += tables.length[control];
+    }
+    return dataIn;
+}
+
+static bool _calcIsSSSE3Available()
+{
+#   if SLANG_VC
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#   else
+    return __builtin_cpu_supports("ssse3") != 0;
+#   endif
+}
+
+#elif SLANG_BYTE_ENCODE_USE_NEON
+
+static const uint8_t* _decodeStreamVByteGroupsNEON(const uint8_t* controlIn, const uint8_t* dataIn, size_t numGroups, uint32_t* valuesOut)
+{
+    const StreamVByteTables& tables = StreamVByteTables::get();
+    for (size_t i = 0; i < numGroups; ++i)
+    {
+        const uint8_t control = controlIn[i];
+        const uint8x16_t data = vld1q_u8(dataIn);
+        const uint8x16_t shuffle = vld1q_u8(tables.shuffle[control]);
+        vst1q_u8((uint8_t*)(valuesOut + i * 4), vqtbl1q_u8(data, shuffle));
+        dataIn += tables.length[control];
+    }
+    return dataIn;
+}
+
+#endif
+
+/* static */bool ByteEncodeUtil::isStreamVByteSimdAvailable()
+{
+#if SLANG_BYTE_ENCODE_USE_SSSE3
+    static const bool isAvailable = _calcIsSSSE3Available();
+    return isAvailable;
+#elif SLANG_BYTE_ENCODE_USE_NEON
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* static */size_t ByteEncodeUtil::decodeStreamVByteUInt32Scalar(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+{
+    const uint8_t* dataEnd = _decodeStreamVByteScalar(encodeIn, encodeIn + ((numValues + 3) >> 2), numValues, valuesOut);
+    return size_t(dataEnd - encodeIn);
+}
+
+/* static */size_t ByteEncodeUtil::decodeStreamVByteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut)
+{
+    const uint8_t* controlIn = encodeIn;
+    const uint8_t* dataIn = encodeIn + ((numValues + 3) >> 2);
+
+    size_t numSimdGroups = isStreamVByteSimdAvailable() ? _calcStreamVByteSimdGroupCount(numValues) : 0;
+    if (numSimdGroups)
+    {
+#if SLANG_BYTE_ENCODE_USE_SSSE3
+        dataIn = _decodeStreamVByteGroupsSSSE3(controlIn, dataIn, numSimdGroups, valuesOut);
+#elif SLANG_BYTE_ENCODE_USE_NEON
+        dataIn = _decodeStreamVByteGroupsNEON(controlIn, dataIn, numSimdGroups, valuesOut);
+#endif
+        controlIn += numSimdGroups;
+        valuesOut += numSimdGroups * 4;
+        numValues -= numSimdGroups * 4;
+    }
+
+    const uint8_t* dataEnd = _decodeStreamVByteScalar(controlIn, dataIn, numValues, valuesOut);
+    return size_t(dataEnd - encodeIn);
+}
+
 } // namespace Slang
@@ -79,6 +79,40 @@ struct ByteEncodeUtil
         */
     static size_t decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut); 
 
+        /** Calculate the size of the 'stream vbyte' encoding of an array of uint32_t.
+
+        Stream vbyte holds the values in two parts. First a control stream, with 2 bits per value
+        (four values to a byte, lowest bits first) holding the number of bytes used by the value
+        minus 1. Then the data stream, holding each value in that many little endian bytes. As the
+        lengths of four values are known from a single control byte, four values can be decoded at
+        once with a byte shuffle. See https://arxiv.org/abs/1709.08990 */
+    static size_t calcEncodeStreamVByteSizeUInt32(const uint32_t* in, size_t num);
+
+        /** Encode an array of uint32_t with stream vbyte
+        @param in The values to encode
+        @param num The amount of values to encode
+        @param encodeOut The buffer to hold the encoding. MUST be at least calcEncodeStreamVByteSizeUInt32 in size.
+        @return The size of the encoding in bytes
+        */
+    static size_t encodeStreamVByteUInt32(const uint32_t* in, size_t num, uint8_t* encodeOut);
+
+        /// Encode an array of uint32_t with stream vbyte, replacing the contents of encodeOut
+    static void encodeStreamVByteUInt32(const uint32_t* in, size_t num, List<uint8_t>& encodeOut);
+
+        /** Decode an array of uint32_t encoded with stream vbyte. Uses SIMD if it's available (see isStreamVByteSimdAvailable).
+        @param encodeIn The encoded values
+        @param numValues The amount of values to decode (the same as the number encoded)
+        @param valuesOut The buffer to hold the decoded values
+        @return The amount of bytes decoded
+        */
+    static size_t decodeStreamVByteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut);
+
+        /// Decode as decodeStreamVByteUInt32 but never using SIMD
+    static size_t decodeStreamVByteUInt32Scalar(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut);
+
+        /// True if decodeStreamVByteUInt32 can use SIMD (SSSE3 or NEON) on this CPU
+    static bool isStreamVByteSimdAvailable();
+
         /// Table that maps 8 bits to it's most significant bit. If 0 returns -1.
     static const int8_t s_msb8[256];
 };
@@ -0,0 +1,241 @@
+#ifndef SLANG_CORE_CHAR_SCAN_H
+#define SLANG_CORE_CHAR_SCAN_H
+
+#include "../../slang.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SLANG_CHAR_SCAN_SSE2 1
+#   include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#   define SLANG_CHAR_SCAN_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace Slang {
+
+/* Functions for quickly scanning over runs of characters, used by the lexer and for finding line breaks.
+
+Each function returns a pointer to the first character in [cursor, end) that ends the run, or end if there
+isn't one. Where SSE2 or NEON are available 16 characters are tested at a time, otherwise (and for the
+last few characters) they are tested one at a time. The functions only ever read characters in [cursor, end). */
+struct CharScanUtil
+{
+        /// Find the first character that isn't a space or tab
+    static const char* skipHorizontalSpace(const char* cursor, const char* end);
+        /// Find the first character that isn't a letter, digit or '_'
+    static const char* findIdentifierEnd(const char* cursor, const char* end);
+
+        /// Find the first occurrence of a or b
+    static const char* findFirstOf(const char* cursor, const char* end, char a, char b);
+        /// Find the first occurrence of a, b or c
+    static const char* findFirstOf(const char* cursor, const char* end, char a, char b, char c);
+        /// Find the first occurrence of a, b, c or d
+    static const char* findFirstOf(const char* cursor, const char* end, char a, char b, char c, char d);
+
+        /// Find the first '\n' or '\r'
+    static const char* findLineBreak(const char* cursor, const char* end) { return findFirstOf(cursor, end, '\n', '\r'); }
+
+        /// True if c can appear in an identifier (after the first character)
+    SLANG_FORCE_INLINE static bool isIdentifierChar(char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+protected:
+#if SLANG_CHAR_SCAN_SSE2
+    typedef __m128i Vector;
+    SLANG_FORCE_INLINE static Vector _load(const char* p) { return _mm_loadu_si128((const __m128i*)p); }
+    SLANG_FORCE_INLINE static Vector _splat(char c) { return _mm_set1_epi8(c); }
+    SLANG_FORCE_INLINE static Vector _equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+    SLANG_FORCE_INLINE static Vector _or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+    SLANG_FORCE_INLINE static Vector _not(Vector a) { return _mm_xor_si128(a, _mm_set1_epi8(-1)); }
+        /// Lanes where lo <= v <= hi, for lo and hi in 0..127 (lanes >= 128 are never in range)
+    SLANG_FORCE_INLINE static Vector _inRange(Vector v, char lo, char hi) { return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(char(lo - 1))), _mm_cmplt_epi8(v, _mm_set1_epi8(char(hi + 1)))); }
+        /// Get the index of the first set lane, or -1 if no lane is set
+    SLANG_FORCE_INLINE static int _findFirstLane(Vector v)
+    {
+        const uint32_t mask = uint32_t(_mm_movemask_epi8(v));
+        return mask ? _getLowestBitIndex(mask) : -1;
+    }
+#elif SLANG_CHAR_SCAN_NEON
+    typedef uint8x16_t Vector;
+    SLANG_FORCE_INLINE static Vector _load(const char* p) { return vld1q_u8((const uint8_t*)p); }
+    SLANG_FORCE_INLINE static Vector _splat(char c) { return vdupq_n_u8(uint8_t(c)); }
+    SLANG_FORCE_INLINE static Vector _equal(Vector a, Vector b) { return vceqq_u8(a, b); }
+    SLANG_FORCE_INLINE static Vector _or(Vector a, Vector b) { return vorrq_u8(a, b); }
+    SLANG_FORCE_INLINE static Vector _not(Vector a) { return vmvnq_u8(a); }
+    SLANG_FORCE_INLINE static Vector _inRange(Vector v, char lo, char hi) { return vandq_u8(vcgeq_u8(v, vdupq_n_u8(uint8_t(lo))), vcleq_u8(v, vdupq_n_u8(uint8_t(hi)))); }
+        /// NEON has no movemask, so narrow each lane to 4 bits of a 64 bit mask
+    SLANG_FORCE_INLINE static int _findFirstLane(Vector v)
+    {
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+        return mask ? (_getLowestBitIndex64(mask) >> 2) : -1;
+    }
+#endif
+
+        /// Get the index of the lowest set bit of a non zero mask
+    SLANG_FORCE_INLINE static int _getLowestBitIndex(uint32_t mask)
+    {
+#if defined(_MSC_VER)
+        unsigned long index;
+        _BitScanForward(&index, mask);
+        return int(index);
+#else
+        return __builtin_ctz(mask);
+#endif
+    }
+    SLANG_FORCE_INLINE static int _getLowestBitIndex64(uint64_t mask)
+    {
+        const uint32_t low = uint32_t(mask);
+        return low ? _getLowestBitIndex(low) : 32 + _getLowestBitIndex(uint32_t(mask >> 32));
+    }
+};
+
+// ---------------------------------------------------------------------------
+inline /* static */const char* CharScanUtil::skipHorizontalSpace(const char* cursor, const char* end)
+{
+#if SLANG_CHAR_SCAN_SSE2 || SLANG_CHAR_SCAN_NEON
+    const Vector space = _splat(' ');
+    const Vector tab = _splat('\t');
+    while (end - cursor >= 16)
+    {
+        const Vector v = _load(cursor);
+        const int lane = _findFirstLane(_not(_or(_equal(v, space), _equal(v, tab))));
+        if (lane >= 0)
+        {
+            return cursor + lane;
+        }
+        cursor += 16;
+    }
+#endif
+    while (cursor < end && (*cursor == ' ' || *cursor == '\t'))
+    {
+        cursor++;
+    }
+    return cursor;
+}
+
+// ---------------------------------------------------------------------------
+inline /* static */const char* CharScanUtil::findIdentifierEnd(const char* cursor, const char* end)
+{
+    // Most identifiers are short, so check the first few characters before using vectors
+    for (int i = 0; i < 8; ++i, ++cursor)
+    {
+        if (cursor >= end || !isIdentifierChar(*cursor))
+        {
+            return cursor;
+        }
+    }
+
+#if SLANG_CHAR_SCAN_SSE2 || SLANG_CHAR_SCAN_NEON
+    const Vector caseBit = _splat(0x20);
+    const Vector underscore = _splat('_');
+    while (end - cursor >= 16)
+    {
+        const Vector v = _load(cursor);
+        // Setting the 0x20 bit maps upper case letters to lower case, and no other character to a lower case letter
+        const Vector isLetter = _inRange(_or(v, caseBit), 'a', 'z');
+        const Vector isDigit = _inRange(v, '0', '9');
+        const int lane = _findFirstLane(_not(_or(_or(isLetter, isDigit), _equal(v, underscore))));
+        if (lane >= 0)
+        {
+            return cursor + lane;
+        }
+        cursor += 16;
+    }
+#endif
+    while (cursor < end && isIdentifierChar(*cursor))
+    {
+        cursor++;
+    }
+    return cursor;
+}
+
+// ---------------------------------------------------------------------------
+inline /* static */const char* CharScanUtil::findFirstOf(const char* cursor, const char* end, char a, char b)
+{
+#if SLANG_CHAR_SCAN_SSE2 || SLANG_CHAR_SCAN_NEON
+    const Vector va = _splat(a), vb = _splat(b);
+    while (end - cursor >= 16)
+    {
+        const Vector v = _load(cursor);
+        const int lane = _findFirstLane(_or(_equal(v, va), _equal(v, vb)));
+        if (lane >= 0)
+        {
+            return cursor + lane;
+        }
+        cursor += 16;
+    }
+#endif
+    for (; cursor < end; ++cursor)
+    {
+        const char c = *cursor;
+        if (c == a || c == b)
+        {
+            break;
+        }
+    }
+    return cursor;
+}
+
+// ---------------------------------------------------------------------------
+inline /* static */const char* CharScanUtil::findFirstOf(const char* cursor, const char* end, char a, char b, char c)
+{
+#if SLANG_CHAR_SCAN_SSE2 || SLANG_CHAR_SCAN_NEON
+    const Vector va = _splat(a), vb = _splat(b), vc = _splat(c);
+    while (end - cursor >= 16)
+    {
+        const Vector v = _load(cursor);
+        const int lane = _findFirstLane(_or(_or(_equal(v, va), _equal(v, vb)), _equal(v, vc)));
+        if (lane >= 0)
+        {
+            return cursor + lane;
+        }
+        cursor += 16;
+    }
+#endif
+    for (; cursor < end; ++cursor)
+    {
+        const char ch = *cursor;
+        if (ch == a || ch == b || ch == c)
+        {
+            break;
+        }
+    }
+    return cursor;
+}
+
+// ---------------------------------------------------------------------------
+inline /* static */const char* CharScanUtil::findFirstOf(const char* cursor, const char* end, char a, char b, char c, char d)
+{
+#if SLANG_CHAR_SCAN_SSE2 || SLANG_CHAR_SCAN_NEON
+    const Vector va = _splat(a), vb = _splat(b), vc = _splat(c), vd = _splat(d);
+    while (end - cursor >= 16)
+    {
+        const Vector v = _load(cursor);
+        const int lane = _findFirstLane(_or(_or(_equal(v, va), _equal(v, vb)), _or(_equal(v, vc), _equal(v, vd))));
+        if (lane >= 0)
+        {
+            return cursor + lane;
+        }
+        cursor += 16;
+    }
+#endif
+    for (; cursor < end; ++cursor)
+    {
+        const char ch = *cursor;
+        if (ch == a || ch == b || ch == c || ch == d)
+        {
+            break;
+        }
+    }
+    return cursor;
+}
+
+} // namespace Slang
+
+#endif // SLANG_CORE_CHAR_SCAN_H
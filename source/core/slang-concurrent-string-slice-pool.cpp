@@ -0,0 +1,167 @@
+#include "slang-concurrent-string-slice-pool.h"
+
+#include "slang-hash.h"
+
+namespace Slang {
+
+/* static */ const ConcurrentStringSlicePool::Handle ConcurrentStringSlicePool::kNullHandle;
+/* static */ const ConcurrentStringSlicePool::Handle ConcurrentStringSlicePool::kEmptyHandle;
+
+/* static */const int ConcurrentStringSlicePool::kNumDefaultHandles;
+/* static */const int ConcurrentStringSlicePool::kShardBits;
+/* static */const int ConcurrentStringSlicePool::kShardCount;
+/* static */const int ConcurrentStringSlicePool::kPageBits;
+/* static */const Index ConcurrentStringSlicePool::kPageSize;
+/* static */const Index ConcurrentStringSlicePool::kMaxPageCount;
+
+static const UnownedStringSlice s_defaultSlices[ConcurrentStringSlicePool::kNumDefaultHandles] =
+{
+    UnownedStringSlice((const char*)nullptr, (const char*)nullptr),
+    UnownedStringSlice::fromLiteral(""),
+};
+
+ConcurrentStringSlicePool::ConcurrentStringSlicePool()
+{
+}
+
+/* static */int ConcurrentStringSlicePool::_getShardIndex(const Slice& slice)
+{
+    // Use the top bits, as the low bits of the folded hash pick the slot in the shard's map
+    return int(getHashCode64(slice.begin(), slice.size()) >> (64 - kShardBits));
+}
+
+ConcurrentStringSlicePool::Handle ConcurrentStringSlicePool::add(const Slice& slice)
+{
+    if (slice.size() == 0)
+    {
+        return kEmptyHandle;
+    }
+
+    const int shardIndex = _getShardIndex(slice);
+    Shard& shard = m_shards[shardIndex];
+
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+
+    if (const Handle* handlePtr = shard.m_map.TryGetValue(slice))
+    {
+        return *handlePtr;
+    }
+
+    const Index index = shard.m_count;
+    const Index pageIndex = index >> kPageBits;
+    if (pageIndex >= kMaxPageCount)
+    {
+        throw InvalidOperationException("ConcurrentStringSlicePool is full.");
+    }
+
+    UnownedStringSlice*& page = shard.m_pages[pageIndex];
+    if (!page)
+    {
+        page = shard.m_arena.allocateArray<UnownedStringSlice>(size_t(kPageSize));
+    }
+
+    UnownedStringSlice& dst = page[index & (kPageSize - 1)];
+    dst = UnownedStringSlice(shard.m_arena.allocateString(slice.begin(), slice.size()), slice.size());
+
+    const Handle handle = _makeHandle(shardIndex, index);
+    shard.m_map.Add(dst, handle);
+    shard.m_count = index + 1;
+    return handle;
+}
+
+ConcurrentStringSlicePool::Handle ConcurrentStringSlicePool::add(const char* chars)
+{
+    return chars ? add(UnownedStringSlice(chars)) : kNullHandle;
+}
+
+ConcurrentStringSlicePool::Handle ConcurrentStringSlicePool::find(const Slice& slice)
+{
+    if (slice.size() == 0)
+    {
+        return kEmptyHandle;
+    }
+
+    Shard& shard = m_shards[_getShardIndex(slice)];
+
+    std::lock_guard<std::mutex> lock(shard.m_mutex);
+    const Handle* handlePtr = shard.m_map.TryGetValue(slice);
+    return handlePtr ? *handlePtr : kNullHandle;
+}
+
+const UnownedStringSlice& ConcurrentStringSlicePool::getSlice(Handle handle) const
+{
+    const uint32_t value = uint32_t(handle);
+    if (value < uint32_t(kNumDefaultHandles))
+    {
+        return s_defaultSlices[value];
+    }
+
+    const uint32_t shardValue = value - kNumDefaultHandles;
+    const Shard& shard = m_shards[shardValue & (kShardCount - 1)];
+    const Index index = Index(shardValue >> kShardBits);
+
+    SLANG_ASSERT(shard.m_pages[index >> kPageBits]);
+    return shard.m_pages[index >> kPageBits][index & (kPageSize - 1)];
+}
+
+Index ConcurrentStringSlicePool::getSliceCount() const
+{
+    Index count = kNumDefaultHandles;
+    for (const auto& shard : m_shards)
+    {
+        count += shard.m_count;
+    }
+    return count;
+}
+
+void ConcurrentStringSlicePool::addToPool(StringSlicePool& pool, Dictionary<Handle, StringSlicePool::Handle>* handleMapOut) const
+{
+    List<Handle> handles;
+    handles.reserve(getSliceCount());
+    for (int i = 0; i < kShardCount; ++i)
+    {
+        const Index count = m_shards[i].m_count;
+        for (Index j = 0; j < count; ++j)
+        {
+            handles.add(_makeHandle(i, j));
+        }
+    }
+
+    // Slices are unique, so sorting by contents gives a single order
+    handles.sort([&](Handle a, Handle b) -> bool
+    {
+        const UnownedStringSlice& sliceA = getSlice(a);
+        const UnownedStringSlice& sliceB = getSlice(b);
+        const size_t minSize = Math::Min(sliceA.size(), sliceB.size());
+        const int cmp = ::memcmp(sliceA.begin(), sliceB.begin(), minSize);
+        return cmp < 0 || (cmp == 0 && sliceA.size() < sliceB.size());
+    });
+
+    if (handleMapOut)
+    {
+        handleMapOut->Add(kNullHandle, StringSlicePool::kNullHandle);
+        handleMapOut->Add(kEmptyHandle, StringSlicePool::kEmptyHandle);
+    }
+
+    for (auto handle : handles)
+    {
+        const StringSlicePool::Handle poolHandle = pool.add(getSlice(handle));
+        if (handleMapOut)
+        {
+            handleMapOut->Add(handle, poolHandle);
+        }
+    }
+}
+
+void ConcurrentStringSlicePool::clear()
+{
+    for (auto& shard : m_shards)
+    {
+        shard.m_map.Clear();
+        shard.m_arena.deallocateAll();
+        shard.m_count = 0;
+        ::memset(shard.m_pages, 0, sizeof(shard.m_pages));
+    }
+}
+
+} // namespace Slang
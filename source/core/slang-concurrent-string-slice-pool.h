@@ -0,0 +1,101 @@
+#ifndef SLANG_CORE_CONCURRENT_STRING_SLICE_POOL_H
+#define SLANG_CORE_CONCURRENT_STRING_SLICE_POOL_H
+
+#include "slang-string-slice-pool.h"
+
+#include <mutex>
+
+namespace Slang {
+
+    /// A pool of string slices that many threads can add to at the same time, such as front ends parsing
+    /// different translation units in parallel.
+    ///
+    /// Slices are spread over shards by their hash, and each shard has its own lock, so threads adding
+    /// different strings rarely wait on each other. A handle stays valid (and its slice in the same place)
+    /// for as long as the pool does, and `getSlice` doesn't lock.
+    ///
+    /// Handles depend on the order slices were added, which depends on how threads were scheduled.
+    /// Use `addToPool` to get the slices in an order that doesn't.
+class ConcurrentStringSlicePool
+{
+public:
+    typedef ConcurrentStringSlicePool ThisType;
+
+        /// As with StringSlicePool, a handle of 0 is null, and 1 is the empty string
+    enum class Handle : uint32_t;
+    typedef UnownedStringSlice Slice;
+
+    static const Handle kNullHandle = Handle(0);
+    static const Handle kEmptyHandle = Handle(1);
+
+    static const int kNumDefaultHandles = 2;
+
+    static const int kShardBits = 4;
+    static const int kShardCount = 1 << kShardBits;
+
+        /// Slices in a shard are held in pages, which never move
+    static const int kPageBits = 12;
+    static const Index kPageSize = Index(1) << kPageBits;
+        /// The maximum number of pages in a shard (so the maximum number of slices is kShardCount * kMaxPageCount * kPageSize)
+    static const Index kMaxPageCount = 1024;
+
+        /// Add a slice, returning its handle. Can be called from any thread.
+    Handle add(const Slice& slice);
+        /// Add from a string. nullptr gives the null handle.
+    Handle add(const char* chars);
+        /// Add a string
+    Handle add(const String& string) { return add(string.getUnownedSlice()); }
+
+        /// Find the handle of a slice. Returns kNullHandle if it hasn't been added.
+    Handle find(const Slice& slice);
+        /// True if the slice has been added
+    bool has(const Slice& slice) { return find(slice) != kNullHandle; }
+
+        /// Get the slice for a handle. Doesn't lock, but the handle must come from `add` or `find`
+        /// (on any thread, as long as the handle was passed between threads in a synchronized way).
+    const UnownedStringSlice& getSlice(Handle handle) const;
+
+        /// Get the number of slices, including the defaults. Must not be called while slices are being added.
+    Index getSliceCount() const;
+
+        /// Add all of the slices (apart from the defaults) to pool, sorted by their contents, so the order
+        /// is the same however the slices were added. If handleMapOut is set it's given the handle in
+        /// pool of every handle. Must not be called while slices are being added.
+    void addToPool(StringSlicePool& pool, Dictionary<Handle, StringSlicePool::Handle>* handleMapOut = nullptr) const;
+
+        /// Empty contents. Must not be called while slices are being added.
+    void clear();
+
+        /// True if the handle is to a slice that contains characters (ie not null or empty)
+    static bool hasContents(Handle handle) { return uint32_t(handle) >= uint32_t(kNumDefaultHandles); }
+
+        /// Ctor
+    ConcurrentStringSlicePool();
+
+protected:
+    struct Shard
+    {
+        std::mutex m_mutex;
+        Dictionary<UnownedStringSlice, Handle> m_map;
+        MemoryArena m_arena;                    ///< Holds the characters and the pages
+        Index m_count = 0;                      ///< The number of slices in the shard
+        UnownedStringSlice* m_pages[kMaxPageCount] = {};
+
+        Shard() : m_arena(16 * 1024) {}
+    };
+
+    static int _getShardIndex(const Slice& slice);
+
+    static Handle _makeHandle(int shardIndex, Index indexInShard) { return Handle(uint32_t((indexInShard << kShardBits) | shardIndex) + kNumDefaultHandles); }
+
+    Shard m_shards[kShardCount];
+
+private:
+    // Disable
+    ConcurrentStringSlicePool(const ThisType& rhs) = delete;
+    void operator=(const ThisType& rhs) = delete;
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_CONCURRENT_STRING_SLICE_POOL_H
@@ -0,0 +1,310 @@
+// slang-cpp-compiler-cache.cpp
+#include "slang-cpp-compiler-cache.h"
+
+#include "slang-io.h"
+#include "slang-platform.h"
+#include "slang-string-util.h"
+
+#include <stdio.h>
+
+#if !SLANG_WINDOWS_FAMILY
+#   include <sys/stat.h>
+#endif
+
+namespace Slang
+{
+
+// Increment if the key or the layout of the cache directory changes
+static const uint32_t kCPPCompilerCacheVersion = 1;
+
+static const char kKeyExtension[] = ".key";
+
+static SlangResult _readFile(const String& path, List<uint8_t>& outData)
+{
+    FILE* file = fopen(path.getBuffer(), "rb");
+    if (!file)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    SlangResult res = SLANG_OK;
+    outData.setCount(Index(size < 0 ? 0 : size));
+    if (size < 0 || (size > 0 && fread(outData.getBuffer(), size_t(size), 1, file) != 1))
+    {
+        res = SLANG_FAIL;
+    }
+    fclose(file);
+    return res;
+}
+
+static SlangResult _writeFile(const String& path, const void* data, size_t size)
+{
+    // Write to a temporary file first and then move it into place, so that other
+    // processes never see a partially written file.
+    StringBuilder tempPath;
+    tempPath << path << ".tmp";
+
+    FILE* file = fopen(tempPath.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_FAIL;
+    }
+    const bool written = (size == 0 || fwrite(data, size, 1, file) == 1);
+    fclose(file);
+
+    if (!written)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+
+#ifdef _WIN32
+    // `rename` on Windows fails if the destination exists
+    File::remove(path);
+#endif
+    if (rename(tempPath.getBuffer(), path.getBuffer()) != 0)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+    /// Get the path of the file a compile produces for modulePath, or an empty string if the target type isn't cached
+static String _getOutputPath(CPPCompiler::TargetType targetType, const String& modulePath)
+{
+    switch (targetType)
+    {
+        case CPPCompiler::TargetType::SharedLibrary:
+        {
+            return SharedLibrary::calcPlatformPath(modulePath.getUnownedSlice());
+        }
+        case CPPCompiler::TargetType::Executable:
+        {
+            StringBuilder builder;
+            builder << modulePath << ProcessUtil::getExecutableSuffix();
+            return builder;
+        }
+        default: return String();
+    }
+}
+
+    /// Get the name used for the entry for key in the cache directory
+static String _getEntryName(const String& key)
+{
+    const uint64_t hash = GetHashCode64(key.getBuffer(), key.getLength());
+
+    char digits[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        digits[i] = "0123456789abcdef"[(hash >> (60 - i * 4)) & 0xf];
+    }
+    digits[16] = 0;
+    return String(digits);
+}
+
+    /// Get the path named by a `#include` line, or an empty slice if line isn't one
+static UnownedStringSlice _getIncludePath(const UnownedStringSlice& line)
+{
+    UnownedStringSlice text = line.trim();
+    if (!text.startsWith("#"))
+    {
+        return UnownedStringSlice();
+    }
+    text = UnownedStringSlice(text.begin() + 1, text.end()).trim();
+    if (!text.startsWith("include"))
+    {
+        return UnownedStringSlice();
+    }
+    text = UnownedStringSlice(text.begin() + 7, text.end()).trim();
+    if (text.size() < 2 || (text[0] != '"' && text[0] != '<'))
+    {
+        return UnownedStringSlice();
+    }
+
+    const char close = (text[0] == '"') ? '"' : '>';
+    const UnownedStringSlice rest(text.begin() + 1, text.end());
+    const Index closeIndex = rest.indexOf(close);
+    return (closeIndex < 0) ? UnownedStringSlice() : UnownedStringSlice(rest.begin(), rest.begin() + closeIndex);
+}
+
+CachingCPPCompiler::CachingCPPCompiler(CPPCompiler* innerCompiler, const String& directory) :
+    Super(innerCompiler->getDesc()),
+    m_innerCompiler(innerCompiler),
+    m_directory(directory)
+{
+}
+
+void CachingCPPCompiler::_appendFileKey(const char* kind, const String& path, const List<String>& includePaths, HashSet<String>& ioVisited, StringBuilder& out)
+{
+    const String simplifiedPath = Path::simplify(path);
+    if (ioVisited.Contains(simplifiedPath))
+    {
+        return;
+    }
+    ioVisited.Add(simplifiedPath);
+
+    List<uint8_t> contents;
+    if (SLANG_FAILED(_readFile(simplifiedPath, contents)))
+    {
+        // The compile will report the missing file. Recording that it was missing
+        // means that the key changes when it appears.
+        out << kind << ": " << simplifiedPath << " missing\n";
+        return;
+    }
+
+    out << kind << ": " << simplifiedPath << " " << GetHashCode64((const char*)contents.getBuffer(), size_t(contents.getCount())) << "\n";
+
+    // Add the headers the file includes
+    const String directory = Path::getParentDirectory(simplifiedPath);
+    UnownedStringSlice text((const char*)contents.getBuffer(), (const char*)contents.getBuffer() + contents.getCount());
+    UnownedStringSlice line;
+    while (StringUtil::extractLine(text, line))
+    {
+        const UnownedStringSlice includePath = _getIncludePath(line);
+        if (includePath.size() == 0)
+        {
+            continue;
+        }
+
+        // Look relative to the including file, and then through the include paths
+        String foundPath;
+        {
+            const String candidate = Path::combine(directory, String(includePath));
+            if (File::exists(candidate))
+            {
+                foundPath = candidate;
+            }
+        }
+        for (Index i = 0; i < includePaths.getCount() && foundPath.getLength() == 0; ++i)
+        {
+            const String candidate = Path::combine(includePaths[i], String(includePath));
+            if (File::exists(candidate))
+            {
+                foundPath = candidate;
+            }
+        }
+
+        if (foundPath.getLength())
+        {
+            _appendFileKey("include", foundPath, includePaths, ioVisited, out);
+        }
+    }
+}
+
+void CachingCPPCompiler::calcKey(const CompileOptions& options, StringBuilder& out)
+{
+    out << "version: " << kCPPCompilerCacheVersion << "\n";
+
+    const Desc& desc = getDesc();
+    out << "compiler: " << int(desc.type) << " " << desc.majorVersion << " " << desc.minorVersion << "\n";
+
+    out << "source-type: " << int(options.sourceType) << "\n";
+    out << "target-type: " << int(options.targetType) << "\n";
+    out << "optimization: " << int(options.optimizationLevel) << "\n";
+    out << "debug-info: " << int(options.debugInfoType) << "\n";
+    out << "flags: " << uint32_t(options.flags) << "\n";
+
+    for (const auto& define : options.defines)
+    {
+        out << "define: " << define.nameWithSig << "=" << define.value << "\n";
+    }
+    for (const auto& includePath : options.includePaths)
+    {
+        out << "include-path: " << includePath << "\n";
+    }
+    for (const auto& libraryPath : options.libraryPaths)
+    {
+        out << "library-path: " << libraryPath << "\n";
+    }
+
+    HashSet<String> visited;
+    for (const auto& sourceFile : options.sourceFiles)
+    {
+        _appendFileKey("source", sourceFile, options.includePaths, visited, out);
+    }
+}
+
+SlangResult CachingCPPCompiler::compileCached(const CompileOptions& options, Output& outOutput, String& outModulePath)
+{
+    outOutput.reset();
+
+    if (_getOutputPath(options.targetType, options.modulePath).getLength() == 0)
+    {
+        // Not a kind of output that is cached
+        outModulePath = options.modulePath;
+        return m_innerCompiler->compile(options, outOutput);
+    }
+
+    StringBuilder key;
+    calcKey(options, key);
+
+    const String entryName = _getEntryName(key);
+    const String cachedModulePath = Path::combine(m_directory, entryName);
+    const String keyPath = cachedModulePath + kKeyExtension;
+
+    // The key file is written after the output, so if it's present and matches, the output is complete
+    {
+        List<uint8_t> cachedKey;
+        if (SLANG_SUCCEEDED(_readFile(keyPath, cachedKey)) &&
+            UnownedStringSlice((const char*)cachedKey.getBuffer(), (const char*)cachedKey.getBuffer() + cachedKey.getCount()) == key.getUnownedSlice() &&
+            File::exists(_getOutputPath(options.targetType, cachedModulePath)))
+        {
+            m_hitCount++;
+            outModulePath = cachedModulePath;
+            return SLANG_OK;
+        }
+    }
+
+    m_missCount++;
+
+    Path::createDirectory(m_directory);
+
+    // Compile straight into the cache
+    CompileOptions cachedOptions(options);
+    cachedOptions.modulePath = cachedModulePath;
+
+    File::remove(keyPath);
+    SLANG_RETURN_ON_FAIL(m_innerCompiler->compile(cachedOptions, outOutput));
+    if (SLANG_FAILED(outOutput.result))
+    {
+        return SLANG_OK;
+    }
+
+    // Failing to record the key only means the next compile isn't a hit
+    _writeFile(keyPath, key.getBuffer(), size_t(key.getLength()));
+
+    outModulePath = cachedModulePath;
+    return SLANG_OK;
+}
+
+SlangResult CachingCPPCompiler::compile(const CompileOptions& options, Output& outOutput)
+{
+    String cachedModulePath;
+    SLANG_RETURN_ON_FAIL(compileCached(options, outOutput, cachedModulePath));
+    if (SLANG_FAILED(outOutput.result) || cachedModulePath == options.modulePath)
+    {
+        return SLANG_OK;
+    }
+
+    // Copy the output from the cache to where it was asked for
+    const String outputPath = _getOutputPath(options.targetType, options.modulePath);
+    List<uint8_t> data;
+    SLANG_RETURN_ON_FAIL(_readFile(_getOutputPath(options.targetType, cachedModulePath), data));
+    SLANG_RETURN_ON_FAIL(_writeFile(outputPath, data.getBuffer(), size_t(data.getCount())));
+
+#if !SLANG_WINDOWS_FAMILY
+    // Executables need to stay executable
+    if (options.targetType == TargetType::Executable)
+    {
+        chmod(outputPath.getBuffer(), 0755);
+    }
+#endif
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,60 @@
+#ifndef SLANG_CPP_COMPILER_CACHE_H
+#define SLANG_CPP_COMPILER_CACHE_H
+
+#include "slang-cpp-compiler.h"
+#include "slang-dictionary.h"
+
+namespace Slang
+{
+
+/* A CPPCompiler that keeps the outputs of successful compiles in a directory, so that
+compiling the same source again with the same options and compiler reuses the output rather
+than running the compiler.
+
+The key for a compile covers the compiler identity, the options that affect the output, and the
+paths and contents of the source files. Headers included with `#include` are found (relative to the
+including file, and then through the include paths) and their contents are part of the key too.
+Headers that aren't found, such as system headers, are assumed to be covered by the compiler identity.
+
+Only executables and shared libraries are cached. Compiles that fail aren't cached, and a compile that
+is found in the cache has no output messages, so warnings are only reported the first time. */
+class CachingCPPCompiler : public CPPCompiler
+{
+public:
+    typedef CPPCompiler Super;
+
+        /// Compile using the specified options, using the cache if possible. The output is written to options.modulePath as usual.
+    virtual SlangResult compile(const CompileOptions& options, Output& outOutput) SLANG_OVERRIDE;
+
+        /// Compile using the specified options, using the cache if possible, but leave the output in the cache.
+        /// On success outModulePath is the module path of the output in the cache (so a shared library can be loaded
+        /// with `SharedLibrary::calcPlatformPath(outModulePath)` without being copied).
+    SlangResult compileCached(const CompileOptions& options, Output& outOutput, String& outModulePath);
+
+        /// Calculate the key text for compiling with options
+    void calcKey(const CompileOptions& options, StringBuilder& outKey);
+
+        /// The number of compiles found in the cache
+    Index getHitCount() const { return m_hitCount; }
+        /// The number of compiles that ran the compiler
+    Index getMissCount() const { return m_missCount; }
+
+        /// Get the compiler that does compiles that aren't in the cache
+    CPPCompiler* getInnerCompiler() const { return m_innerCompiler; }
+
+        /// Ctor. Compiles that aren't in the cache held in `directory` are done with `innerCompiler`.
+    CachingCPPCompiler(CPPCompiler* innerCompiler, const String& directory);
+
+protected:
+    void _appendFileKey(const char* kind, const String& path, const List<String>& includePaths, HashSet<String>& ioVisited, StringBuilder& out);
+
+    RefPtr<CPPCompiler> m_innerCompiler;
+    String m_directory;
+
+    Index m_hitCount = 0;
+    Index m_missCount = 0;
+};
+
+}
+
+#endif
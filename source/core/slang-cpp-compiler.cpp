@@ -6,6 +6,7 @@
 #include "slang-string-util.h"
 
 #include "slang-io.h"
+#include "slang-process-pool.h"
 #include "slang-shared-library.h"
 
 // if Visual Studio import the visual studio platform specific header
@@ -303,13 +304,27 @@ const CPPCompiler::Desc& CPPCompilerUtil::getCompiledWithDesc()
 
 // Have to do this conditionally because unreferenced static functions are a warning on VC, and warnings are errors.
 #if !SLANG_WINDOWS_FAMILY
-static void _addGCCFamilyCompiler(const String& exeName, CPPCompilerSet* compilerSet)
+static void _addGCCFamilyCompilers(const String* exeNames, Index exeNameCount, CPPCompilerSet* compilerSet)
 {
-    CPPCompiler::Desc desc;
-    if (SLANG_SUCCEEDED(GCCCompilerUtil::calcVersion(exeName, desc)))
+    // The compilers are run to find their versions, which is slow enough to be worth doing at the same time
+    ProcessPool pool(exeNameCount);
+    List<RefPtr<ProcessTask>> tasks;
+    for (Index i = 0; i < exeNameCount; ++i)
     {
-        RefPtr<CPPCompiler> compiler(new GenericCPPCompiler(desc, exeName, &GCCCompilerUtil::calcArgs, &GCCCompilerUtil::parseOutput));
-        compilerSet->addCompiler(compiler);
+        CommandLine cmdLine;
+        GCCCompilerUtil::calcVersionCommandLine(exeNames[i], cmdLine);
+        tasks.add(pool.spawn(cmdLine));
+    }
+
+    // Add in the order given, so the set doesn't depend on which completes first
+    for (Index i = 0; i < exeNameCount; ++i)
+    {
+        CPPCompiler::Desc desc;
+        if (SLANG_SUCCEEDED(tasks[i]->wait()) && SLANG_SUCCEEDED(GCCCompilerUtil::parseVersionResult(tasks[i]->getExecuteResult(), desc)))
+        {
+            RefPtr<CPPCompiler> compiler(new GenericCPPCompiler(desc, exeNames[i], &GCCCompilerUtil::calcArgs, &GCCCompilerUtil::parseOutput));
+            compilerSet->addCompiler(compiler);
+        }
     }
 }
 #endif
@@ -331,8 +346,8 @@ static void _addGCCFamilyCompiler(const String& exeName, CPPCompilerSet* compile
 #if SLANG_WINDOWS_FAMILY
     WinVisualStudioUtil::find(set);
 #else
-    _addGCCFamilyCompiler("clang", set);
-    _addGCCFamilyCompiler("g++", set);
+    const String exeNames[] = { "clang", "g++" };
+    _addGCCFamilyCompilers(exeNames, SLANG_COUNT_OF(exeNames), set);
 #endif
 
     // Set the default to the compiler closest to how this source was compiled
@@ -340,6 +355,86 @@ static void _addGCCFamilyCompiler(const String& exeName, CPPCompilerSet* compile
     return SLANG_OK;
 }
 
+/* static */String CPPCompilerUtil::calcPrecompiledHeaderFilePath(const CPPCompiler::Desc& desc, const String& modulePath)
+{
+    StringBuilder builder;
+    builder << modulePath << ((desc.type == CPPCompiler::CompilerType::VisualStudio) ? ".pch" : ".gch");
+    return builder;
+}
+
+/* static */SlangResult CPPCompilerUtil::ensurePrecompiledHeader(CPPCompiler* compiler, const CompileOptions& options, const String& headerPath, const String& directory, String& outPrecompiledHeaderPath)
+{
+    const CPPCompiler::Desc& desc = compiler->getDesc();
+
+    // Identify the configuration by everything that affects the precompiled header
+    StringBuilder key;
+    key << int(desc.type) << " " << desc.majorVersion << " " << desc.minorVersion << "\n";
+    key << int(options.sourceType) << " " << int(options.optimizationLevel) << " " << int(options.debugInfoType) << " " << uint32_t(options.flags) << "\n";
+    for (const auto& define : options.defines)
+    {
+        key << "define: " << define.nameWithSig << "=" << define.value << "\n";
+    }
+    for (const auto& includePath : options.includePaths)
+    {
+        key << "include-path: " << includePath << "\n";
+    }
+    key << "header: " << headerPath << "\n";
+
+    const uint64_t hash = GetHashCode64(key.getBuffer(), key.getLength());
+    char digits[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        digits[i] = "0123456789abcdef"[(hash >> (60 - i * 4)) & 0xf];
+    }
+    digits[16] = 0;
+
+    const String configDirectory = Path::combine(directory, digits);
+    const String modulePath = Path::combine(configDirectory, Path::getFileName(headerPath));
+    const String filePath = calcPrecompiledHeaderFilePath(desc, modulePath);
+
+    // Only rebuild if the header has been modified since the precompiled header was built
+    {
+        int64_t headerSize, headerModifiedTime;
+        int64_t fileSize, fileModifiedTime;
+        SLANG_RETURN_ON_FAIL(File::getSizeAndModifiedTime(headerPath, headerSize, headerModifiedTime));
+        if (SLANG_SUCCEEDED(File::getSizeAndModifiedTime(filePath, fileSize, fileModifiedTime)) &&
+            fileModifiedTime >= headerModifiedTime)
+        {
+            outPrecompiledHeaderPath = modulePath;
+            return SLANG_OK;
+        }
+    }
+
+    Path::createDirectory(directory);
+    Path::createDirectory(configDirectory);
+
+    // The header is copied next to the precompiled header, so if a compiler rejects the precompiled
+    // header (for example because the options don't match) it falls back to the header itself.
+    try
+    {
+        File::writeAllText(modulePath, File::readAllText(headerPath));
+    }
+    catch (const IOException&)
+    {
+        return SLANG_FAIL;
+    }
+
+    CompileOptions headerOptions(options);
+    headerOptions.targetType = TargetType::PrecompiledHeader;
+    headerOptions.sourceFiles.clear();
+    headerOptions.sourceFiles.add(modulePath);
+    headerOptions.modulePath = modulePath;
+    headerOptions.libraryPaths.clear();
+    headerOptions.precompiledHeaderPath = String();
+
+    CPPCompiler::Output output;
+    SLANG_RETURN_ON_FAIL(compiler->compile(headerOptions, output));
+    SLANG_RETURN_ON_FAIL(output.result);
+
+    outPrecompiledHeaderPath = modulePath;
+    return SLANG_OK;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! CPPCompilerFactory !!!!!!!!!!!!!!!!!!!!!!*/
 
 
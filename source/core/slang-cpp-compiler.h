@@ -65,6 +65,7 @@ public:
         Executable,         ///< Produce an executable
         SharedLibrary,      ///< Produce a shared library object/dll 
         Object,             ///< Produce an object file
+        PrecompiledHeader,  ///< Produce a precompiled header from the header in sourceFiles (see CompileOptions::precompiledHeaderPath)
     };
 
     struct Define
@@ -99,6 +100,12 @@ public:
 
         List<String> includePaths;
         List<String> libraryPaths;
+
+            /// If set, the modulePath a precompiled header was built with, to use for this compile. The header is
+            /// included before the source, so the source's own `#include` of it must be guarded (by an include
+            /// guard or `#pragma once`). The options that affect code generation must be the same as those the
+            /// precompiled header was built with.
+        String precompiledHeaderPath;
     };
 
     struct OutputMessage
@@ -263,6 +270,16 @@ struct CPPCompilerUtil
 
         /// Given a set, registers compilers found through standard means and determines a reasonable default compiler if possible
     static SlangResult initializeSet(CPPCompilerSet* set);
+
+        /// Get the path of the file the compiler writes when building a precompiled header with modulePath
+    static String calcPrecompiledHeaderFilePath(const CPPCompiler::Desc& desc, const String& modulePath);
+
+        /// Make sure there is an up to date precompiled header for headerPath, built with compiler using the code generation
+        /// options of `options`, under directory. Each configuration of the compiler and options has its own precompiled
+        /// header, which is only rebuilt if the header is modified. The header is copied into the configuration's directory
+        /// and built from there, so any headers it includes must be found through the include paths of options.
+        /// On success outPrecompiledHeaderPath can be used as CompileOptions::precompiledHeaderPath for compiles with the same options.
+    static SlangResult ensurePrecompiledHeader(CPPCompiler* compiler, const CompileOptions& options, const String& headerPath, const String& directory, String& outPrecompiledHeaderPath);
 };
 
 
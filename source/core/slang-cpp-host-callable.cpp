@@ -0,0 +1,86 @@
+// slang-cpp-host-callable.cpp
+#include "slang-cpp-host-callable.h"
+
+#include "slang-io.h"
+
+namespace Slang
+{
+
+    /// Get the hash of data as hex digits
+static String _getHashText(const UnownedStringSlice& data)
+{
+    const uint64_t hash = GetHashCode64(data.begin(), data.size());
+
+    char digits[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        digits[i] = "0123456789abcdef"[(hash >> (60 - i * 4)) & 0xf];
+    }
+    digits[16] = 0;
+    return String(digits);
+}
+
+HostCallableCompiler::HostCallableCompiler(CPPCompiler* compiler, const String& directory):
+    m_directory(directory)
+{
+    m_cachingCompiler = new CachingCPPCompiler(compiler, Path::combine(directory, "cache"));
+}
+
+SlangResult HostCallableCompiler::compile(const UnownedStringSlice& source, const CPPCompiler::CompileOptions& options, CPPCompiler::Output& outOutput, RefPtr<Module>& outModule)
+{
+    outOutput.reset();
+    outModule.setNull();
+
+    // The source file is named by its contents, so different source never shares a file (and a module that is
+    // loaded is never overwritten)
+    const String hashText = _getHashText(source);
+
+    StringBuilder sourceName;
+    sourceName << "source-" << hashText << (options.sourceType == CPPCompiler::SourceType::C ? ".c" : ".cpp");
+    const String sourcePath = Path::combine(m_directory, sourceName);
+
+    Path::createDirectory(m_directory);
+    try
+    {
+        File::writeAllText(sourcePath, source);
+    }
+    catch (IOException&)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+
+    CPPCompiler::CompileOptions compileOptions(options);
+    compileOptions.sourceFiles.clear();
+    compileOptions.sourceFiles.add(sourcePath);
+    compileOptions.targetType = CPPCompiler::TargetType::SharedLibrary;
+    compileOptions.modulePath = Path::combine(m_directory, "module-" + hashText);
+
+    // The cache key covers the options and included headers as well as the source
+    StringBuilder key;
+    m_cachingCompiler->calcKey(compileOptions, key);
+
+    if (RefPtr<Module>* module = m_loadedModules.TryGetValue(key))
+    {
+        m_loadedHitCount++;
+        outModule = *module;
+        return SLANG_OK;
+    }
+
+    // The library is loaded from where it is in the cache, rather than being copied out
+    String cachedModulePath;
+    SLANG_RETURN_ON_FAIL(m_cachingCompiler->compileCached(compileOptions, outOutput, cachedModulePath));
+    if (SLANG_FAILED(outOutput.result))
+    {
+        return SLANG_OK;
+    }
+
+    const String libraryPath = SharedLibrary::calcPlatformPath(cachedModulePath.getUnownedSlice());
+    SharedLibrary::Handle handle;
+    SLANG_RETURN_ON_FAIL(SharedLibrary::loadWithPlatformPath(libraryPath.getBuffer(), handle));
+
+    outModule = new Module(handle, libraryPath);
+    m_loadedModules.Add(key, outModule);
+    return SLANG_OK;
+}
+
+}
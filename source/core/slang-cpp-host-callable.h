@@ -0,0 +1,63 @@
+#ifndef SLANG_CPP_HOST_CALLABLE_H
+#define SLANG_CPP_HOST_CALLABLE_H
+
+#include "slang-cpp-compiler-cache.h"
+#include "slang-platform.h"
+
+namespace Slang
+{
+
+/* HostCallableCompiler compiles C or C++ source held in memory into shared libraries that are loaded into the
+current process, so that the functions in them can be called directly.
+
+Compiles go through a CachingCPPCompiler, so source that has been compiled before (in any process using the same
+directory) doesn't run the compiler. Loaded libraries are also kept by the compiler, keyed by the cache key, so
+compiling source that is already loaded - as happens when iterating on a kernel and reverting a change - just
+returns the loaded module. Modules stay loaded for as long as they (or the compiler) are referenced. */
+class HostCallableCompiler : public RefObject
+{
+public:
+    typedef HostCallableCompiler ThisType;
+
+        /// A shared library loaded into the process
+    class Module : public RefObject
+    {
+    public:
+            /// Find the function called name (which should be extern "C"), or nullptr if it isn't found
+        SharedLibrary::FuncPtr findFunction(const char* name) const { return SharedLibrary::findFuncByName(m_handle, name); }
+
+            /// Get the path of the loaded shared library
+        const String& getPath() const { return m_path; }
+
+        Module(SharedLibrary::Handle handle, const String& path): m_handle(handle), m_path(path) {}
+            /// Dtor. Unloads the library, so nothing found in it can be used after this.
+        ~Module() { SharedLibrary::unload(m_handle); }
+
+    protected:
+        SharedLibrary::Handle m_handle;
+        String m_path;
+    };
+
+        /// Compile source as a shared library, and load it. Options are used as is, apart from the source files, target
+        /// type and module path, which are set by the compiler. If compilation fails outOutput holds the messages, and
+        /// outModule is null.
+    SlangResult compile(const UnownedStringSlice& source, const CPPCompiler::CompileOptions& options, CPPCompiler::Output& outOutput, RefPtr<Module>& outModule);
+
+        /// The number of compiles that returned a module that was already loaded
+    Index getLoadedHitCount() const { return m_loadedHitCount; }
+        /// Get the compiler that caches compiled libraries on disk
+    CachingCPPCompiler* getCachingCompiler() const { return m_cachingCompiler; }
+
+        /// Ctor. Compiles are done with compiler, and the source and compiled libraries are held in directory.
+    HostCallableCompiler(CPPCompiler* compiler, const String& directory);
+
+protected:
+    String m_directory;
+    RefPtr<CachingCPPCompiler> m_cachingCompiler;
+    Dictionary<String, RefPtr<Module>> m_loadedModules;     ///< Keyed by the cache key of the compile
+    Index m_loadedHitCount = 0;
+};
+
+}
+
+#endif
@@ -3,11 +3,21 @@
 
 #include "slang-list.h"
 #include "slang-common.h"
-#include "slang-uint-set.h"
 #include "slang-exception.h"
 #include "slang-math.h"
 #include "slang-hash.h"
 
+#if SLANG_PROCESSOR_X86_64 || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define SLANG_DICTIONARY_USE_SSE2 1
+#	include <emmintrin.h>
+#else
+#	define SLANG_DICTIONARY_USE_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
 namespace Slang
 {
 	template<typename TKey, typename TValue>
@@ -66,7 +76,107 @@ namespace Slang
 		return KeyValuePair<TKey, TValue>(k, v);
 	}
 
-	const float MaxLoadFactor = 0.7f;
+	// Dictionary is an open addressing hash table, with a control byte for each slot stored in
+	// an array alongside the slots (in the style of "Swiss tables").
+	//
+	// A control byte is either kDictionaryCtrlEmpty, kDictionaryCtrlDeleted, or for a slot
+	// holding an entry, the low 7 bits of the hash of its key. A lookup loads a group of
+	// control bytes at once and compares them all against the 7 bits of the key's hash, so
+	// that keys are only compared for the (rare) slots with matching hash bits. Groups are
+	// compared with SSE2 when available.
+	//
+	// The capacity is always a power of 2 (and at least one group), so a position is found by
+	// masking, and groups are probed in a triangular sequence that visits every group.
+	//
+	// The control array holds kDictionaryGroupWidth bytes more than the capacity, which mirror
+	// the first bytes, so that a group can be loaded starting at any slot.
+
+	static const int8_t kDictionaryCtrlEmpty = -128;		// 0b10000000
+	static const int8_t kDictionaryCtrlDeleted = -2;		// 0b11111110
+
+#if SLANG_DICTIONARY_USE_SSE2
+	static const int kDictionaryGroupWidth = 16;
+
+		/// A group of control bytes, for matching many slots at once
+	struct DictionaryGroup
+	{
+		explicit DictionaryGroup(const int8_t* ctrl) { m_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl)); }
+
+			/// Returns a bit mask of slots whose control byte is h2
+		uint32_t match(int8_t h2) const { return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_ctrl))); }
+			/// Returns a bit mask of empty slots
+		uint32_t matchEmpty() const { return match(kDictionaryCtrlEmpty); }
+			/// Returns a bit mask of empty or deleted slots (these are the only negative values other than -1)
+		uint32_t matchEmptyOrDeleted() const { return uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_ctrl))); }
+
+		__m128i m_ctrl;
+	};
+#else
+	static const int kDictionaryGroupWidth = 8;
+
+	struct DictionaryGroup
+	{
+		explicit DictionaryGroup(const int8_t* ctrl) : m_ctrl(ctrl) {}
+
+		uint32_t match(int8_t h2) const
+		{
+			uint32_t mask = 0;
+			for (int i = 0; i < kDictionaryGroupWidth; ++i)
+				mask |= uint32_t(m_ctrl[i] == h2) << i;
+			return mask;
+		}
+		uint32_t matchEmpty() const { return match(kDictionaryCtrlEmpty); }
+		uint32_t matchEmptyOrDeleted() const
+		{
+			uint32_t mask = 0;
+			for (int i = 0; i < kDictionaryGroupWidth; ++i)
+				mask |= uint32_t(m_ctrl[i] < -1) << i;
+			return mask;
+		}
+
+		const int8_t* m_ctrl;
+	};
+#endif
+
+		/// Get the index of the lowest set bit. mask must be non zero.
+	SLANG_FORCE_INLINE int dictionaryLowestBitIndex(uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return int(index);
+#elif defined(__GNUC__) || defined(__clang__)
+		return __builtin_ctz(mask);
+#else
+		int index = 0;
+		while (!(mask & 1))
+		{
+			mask >>= 1;
+			index++;
+		}
+		return index;
+#endif
+	}
+
+		/// Get the index of the highest set bit. mask must be non zero.
+	SLANG_FORCE_INLINE int dictionaryHighestBitIndex(uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanReverse(&index, mask);
+		return int(index);
+#elif defined(__GNUC__) || defined(__clang__)
+		return 31 - __builtin_clz(mask);
+#else
+		int index = 31;
+		while (!(mask & 0x80000000))
+		{
+			mask <<= 1;
+			index--;
+		}
+		return index;
+#endif
+	}
 
 	template<typename TKey, typename TValue>
 	class Dictionary
@@ -74,43 +184,50 @@ namespace Slang
 		friend class Iterator;
 		friend class ItemProxy;
 	private:
-		inline int GetProbeOffset(int /*probeId*/) const
-		{
-			// quadratic probing
-			return 1;
-		}
-	private:
-		int bucketSizeMinusOne;
-		int _count;
-		UIntSet marks;
-		KeyValuePair<TKey, TValue>* hashMap;
+		int capacity;					// Number of slots, 0 or a power of 2
+		int _count;						// Number of entries
+		int growthLeft;					// Number of empty slots that can be filled before a rehash
+		int8_t* ctrl;					// capacity + kDictionaryGroupWidth control bytes
+		KeyValuePair<TKey, TValue>* hashMap;	// The slots
+
 		void Free()
 		{
 			if (hashMap)
 				delete[] hashMap;
-			hashMap = 0;
+			if (ctrl)
+				delete[] ctrl;
+			hashMap = nullptr;
+			ctrl = nullptr;
 		}
-		inline bool IsDeleted(int pos) const
+		inline bool IsFull(int pos) const
 		{
-			return marks.contains((pos << 1) + 1);
+			return ctrl[pos] >= 0;
 		}
-		inline bool IsEmpty(int pos) const
+		inline void SetCtrl(int pos, int8_t value)
 		{
-			return !marks.contains((pos << 1));
+			ctrl[pos] = value;
+			// Keep the mirrored bytes at the end up to date
+			if (pos < kDictionaryGroupWidth)
+				ctrl[capacity + pos] = value;
 		}
-		inline void SetDeleted(int pos, bool val)
+			/// The maximum number of entries (full or deleted slots) before a rehash
+		static int CalcMaxLoad(int capacity)
 		{
-			if (val)
-				marks.add((pos << 1) + 1);
-			else
-				marks.remove((pos << 1) + 1);
+			return capacity - capacity / 8;
 		}
-		inline void SetEmpty(int pos, bool val)
+		struct HashBits
 		{
-			if (val)
-				marks.remove((pos << 1));
-			else
-				marks.add((pos << 1));
+			int pos;					// Position to start probing from (before masking)
+			int8_t h2;					// Value stored in the control byte
+		};
+		static HashBits CalcHashBits(const TKey& key)
+		{
+			// Mix the hash, as many hash functions (such as for pointers) have poor low bits
+			const uint64_t hash = uint64_t(uint32_t(GetHashCode(const_cast<TKey&>(key)))) * 0x9E3779B97F4A7C15ull;
+			HashBits bits;
+			bits.pos = int(uint32_t(hash >> 32) >> 7);
+			bits.h2 = int8_t((hash >> 32) & 0x7f);
+			return bits;
 		}
 		struct FindPositionResult
 		{
@@ -128,35 +245,35 @@ namespace Slang
 			}
 
 		};
-		inline int GetHashPos(TKey& key) const
-		{
-			return ((unsigned int)(GetHashCode(key) * 2654435761)) % bucketSizeMinusOne;
-		}
 		FindPositionResult FindPosition(const TKey& key) const
 		{
-			int hashPos = GetHashPos(const_cast<TKey&>(key));
+			if (capacity == 0)
+				return FindPositionResult();
+
+			const HashBits bits = CalcHashBits(key);
+			const int mask = capacity - 1;
+
 			int insertPos = -1;
-			int numProbes = 0;
-			while (numProbes <= bucketSizeMinusOne)
+			int pos = bits.pos & mask;
+			for (int stride = kDictionaryGroupWidth; stride <= capacity + kDictionaryGroupWidth; stride += kDictionaryGroupWidth)
 			{
-				if (IsEmpty(hashPos))
-				{
-					if (insertPos == -1)
-						return FindPositionResult(-1, hashPos);
-					else
-						return FindPositionResult(-1, insertPos);
-				}
-				else if (IsDeleted(hashPos))
+				const DictionaryGroup group(ctrl + pos);
+				for (uint32_t matches = group.match(bits.h2); matches; matches &= matches - 1)
 				{
-					if (insertPos == -1)
-						insertPos = hashPos;
+					const int candidate = (pos + dictionaryLowestBitIndex(matches)) & mask;
+					if (hashMap[candidate].Key == key)
+						return FindPositionResult(candidate, -1);
 				}
-				else if (hashMap[hashPos].Key == key)
+				if (insertPos == -1)
 				{
-					return FindPositionResult(hashPos, -1);
+					const uint32_t available = group.matchEmptyOrDeleted();
+					if (available)
+						insertPos = (pos + dictionaryLowestBitIndex(available)) & mask;
 				}
-				numProbes++;
-				hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
+				// The key would have been placed before any empty slot
+				if (group.matchEmpty())
+					return FindPositionResult(-1, insertPos);
+				pos = (pos + stride) & mask;
 			}
 			if (insertPos != -1)
 				return FindPositionResult(-1, insertPos);
@@ -165,32 +282,52 @@ namespace Slang
 		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
 		{
 			hashMap[pos] = _Move(kvPair);
-			SetEmpty(pos, false);
-			SetDeleted(pos, false);
 			return hashMap[pos].Value;
+		}
+			/// Insert an entry for a key known not to be in the dictionary, at pos (from FindPosition)
+		TValue & _InsertNew(KeyValuePair<TKey, TValue>&& kvPair, int pos)
+		{
+			if (ctrl[pos] == kDictionaryCtrlEmpty)
+				growthLeft--;
+			SetCtrl(pos, CalcHashBits(kvPair.Key).h2);
+			_count++;
+			return _Insert(_Move(kvPair), pos);
 		}
 		void Rehash()
 		{
-			if (bucketSizeMinusOne == -1 || _count >= int(MaxLoadFactor * bucketSizeMinusOne))
+			if (growthLeft > 0)
+				return;
+
+			// If at least half of the used slots are deleted, rebuilding at the same size
+			// is enough, otherwise double the size
+			int newSize = capacity;
+			if (newSize == 0)
+				newSize = 16;
+			else if (_count * 2 > CalcMaxLoad(capacity))
+				newSize = capacity * 2;
+
+			Dictionary<TKey, TValue> newDict;
+			newDict._Allocate(newSize);
+			if (hashMap)
 			{
-				int newSize = (bucketSizeMinusOne + 1) * 2;
-				if (newSize == 0)
+				for (auto & kvPair : *this)
 				{
-					newSize = 16;
+					auto pos = newDict.FindPosition(kvPair.Key);
+					newDict._InsertNew(_Move(kvPair), pos.InsertionPosition);
 				}
-				Dictionary<TKey, TValue> newDict;
-				newDict.bucketSizeMinusOne = newSize - 1;
-				newDict.hashMap = new KeyValuePair<TKey, TValue>[newSize];
-				newDict.marks.resizeAndClear(newSize * 2);
-				if (hashMap)
-				{
-					for (auto & kvPair : *this)
-					{
-						newDict.Add(_Move(kvPair));
-					}
-				}
-				*this = _Move(newDict);
 			}
+			*this = _Move(newDict);
+		}
+		void _Allocate(int size)
+		{
+			Free();
+			capacity = size;
+			_count = 0;
+			growthLeft = CalcMaxLoad(size);
+			hashMap = new KeyValuePair<TKey, TValue>[size];
+			ctrl = new int8_t[size + kDictionaryGroupWidth];
+			for (int i = 0; i < size + kDictionaryGroupWidth; i++)
+				ctrl[i] = kDictionaryCtrlEmpty;
 		}
 
 		bool AddIfNotExists(KeyValuePair<TKey, TValue>&& kvPair)
@@ -201,8 +338,7 @@ namespace Slang
 				return false;
 			else if (pos.InsertionPosition != -1)
 			{
-				_count++;
-				_Insert(_Move(kvPair), pos.InsertionPosition);
+				_InsertNew(_Move(kvPair), pos.InsertionPosition);
 				return true;
 			}
 			else
@@ -220,10 +356,7 @@ namespace Slang
 			if (pos.ObjectPosition != -1)
 				return _Insert(_Move(kvPair), pos.ObjectPosition);
 			else if (pos.InsertionPosition != -1)
-			{
-				_count++;
-				return _Insert(_Move(kvPair), pos.InsertionPosition);
-			}
+				return _InsertNew(_Move(kvPair), pos.InsertionPosition);
 			else
 				throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
 		}
@@ -244,10 +377,10 @@ namespace Slang
 			}
 			Iterator & operator ++()
 			{
-				if (pos > dict->bucketSizeMinusOne)
+				if (pos >= dict->capacity)
 					return *this;
 				pos++;
-				while (pos <= dict->bucketSizeMinusOne && (dict->IsDeleted(pos) || dict->IsEmpty(pos)))
+				while (pos < dict->capacity && !dict->IsFull(pos))
 				{
 					pos++;
 				}
@@ -282,18 +415,13 @@ namespace Slang
 		Iterator begin() const
 		{
 			int pos = 0;
-			while (pos < bucketSizeMinusOne + 1)
-			{
-				if (IsEmpty(pos) || IsDeleted(pos))
-					pos++;
-				else
-					break;
-			}
+			while (pos < capacity && !IsFull(pos))
+				pos++;
 			return Iterator(this, pos);
 		}
 		Iterator end() const
 		{
-			return Iterator(this, bucketSizeMinusOne + 1);
+			return Iterator(this, capacity);
 		}
 	public:
 		void Add(const TKey & key, const TValue & value)
@@ -319,15 +447,34 @@ namespace Slang
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
 			{
-				SetDeleted(pos.ObjectPosition, true);
+				// A probe only moves past a group if every slot in it is in use. If the run of
+				// used slots around this one is shorter than a group, no probe can have passed
+				// over it, so it can be made empty rather than deleted.
+				const int mask = capacity - 1;
+				const uint32_t emptyBefore = DictionaryGroup(ctrl + ((pos.ObjectPosition - kDictionaryGroupWidth) & mask)).matchEmpty();
+				const uint32_t emptyAfter = DictionaryGroup(ctrl + pos.ObjectPosition).matchEmpty();
+				const bool canBeEmpty = emptyBefore && emptyAfter &&
+					(kDictionaryGroupWidth - 1 - dictionaryHighestBitIndex(emptyBefore)) + dictionaryLowestBitIndex(emptyAfter) < kDictionaryGroupWidth;
+				if (canBeEmpty)
+					growthLeft++;
+				SetCtrl(pos.ObjectPosition, canBeEmpty ? kDictionaryCtrlEmpty : kDictionaryCtrlDeleted);
+
+				// Release whatever the entry holds
+				hashMap[pos.ObjectPosition] = KeyValuePair<TKey, TValue>();
 				_count--;
 			}
 		}
 		void Clear()
 		{
+			for (int i = 0; i < capacity; i++)
+			{
+				if (IsFull(i))
+					hashMap[i] = KeyValuePair<TKey, TValue>();
+			}
+			for (int i = 0; i < capacity + (capacity ? kDictionaryGroupWidth : 0); i++)
+				ctrl[i] = kDictionaryCtrlEmpty;
 			_count = 0;
-
-			marks.clear();
+			growthLeft = CalcMaxLoad(capacity);
 		}
 
         TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
@@ -341,9 +488,8 @@ namespace Slang
             else if (pos.InsertionPosition != -1)
             {
                 // Make pair
-                KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(value));
-                _count++;
-                _Insert(_Move(kvPair), pos.InsertionPosition);
+                KeyValuePair<TKey, TValue> kvPair(key, value);
+                _InsertNew(_Move(kvPair), pos.InsertionPosition);
                 return nullptr;
             }
             else
@@ -352,15 +498,11 @@ namespace Slang
 
 		bool ContainsKey(const TKey& key) const
 		{
-			if (bucketSizeMinusOne == -1)
-				return false;
 			auto pos = FindPosition(key);
 			return pos.ObjectPosition != -1;
 		}
 		bool TryGetValue(const TKey& key, TValue& value) const
 		{
-			if (bucketSizeMinusOne == -1)
-				return false;
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
 			{
@@ -371,8 +513,6 @@ namespace Slang
 		}
 		TValue* TryGetValue(const TKey& key) const
 		{
-			if (bucketSizeMinusOne == -1)
-				return nullptr;
 			auto pos = FindPosition(key);
 			if (pos.ObjectPosition != -1)
 			{
@@ -436,6 +576,11 @@ namespace Slang
 		{
 			return _count;
 		}
+		// The bytes allocated for the slots (not including memory the keys and values own)
+		size_t calcMemoryUsed() const
+		{
+			return capacity ? size_t(capacity) * sizeof(KeyValuePair<TKey, TValue>) + size_t(capacity + kDictionaryGroupWidth) : 0;
+		}
 	private:
 		template<typename... Args>
 		void Init(const KeyValuePair<TKey, TValue> & kvPair, Args... args)
@@ -445,23 +590,22 @@ namespace Slang
 		}
 	public:
 		Dictionary()
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
-			bucketSizeMinusOne = -1;
-			_count = 0;
-			hashMap = nullptr;
 		}
 		template<typename Arg, typename... Args>
 		Dictionary(Arg arg, Args... args)
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
 			Init(arg, args...);
 		}
 		Dictionary(const Dictionary<TKey, TValue>& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
 			*this = other;
 		}
 		Dictionary(Dictionary<TKey, TValue>&& other)
-			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+			: capacity(0), _count(0), growthLeft(0), ctrl(nullptr), hashMap(nullptr)
 		{
 			*this = (_Move(other));
 		}
@@ -470,12 +614,21 @@ namespace Slang
 			if (this == &other)
 				return *this;
 			Free();
-			bucketSizeMinusOne = other.bucketSizeMinusOne;
+			capacity = other.capacity;
 			_count = other._count;
-			hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
-			marks = other.marks;
-			for (int i = 0; i <= bucketSizeMinusOne; i++)
-				hashMap[i] = other.hashMap[i];
+			growthLeft = other.growthLeft;
+			if (capacity)
+			{
+				hashMap = new KeyValuePair<TKey, TValue>[capacity];
+				ctrl = new int8_t[capacity + kDictionaryGroupWidth];
+				for (int i = 0; i < capacity + kDictionaryGroupWidth; i++)
+					ctrl[i] = other.ctrl[i];
+				for (int i = 0; i < capacity; i++)
+				{
+					if (IsFull(i))
+						hashMap[i] = other.hashMap[i];
+				}
+			}
 			return *this;
 		}
 		Dictionary<TKey, TValue> & operator = (Dictionary<TKey, TValue>&& other)
@@ -483,13 +636,16 @@ namespace Slang
 			if (this == &other)
 				return *this;
 			Free();
-			bucketSizeMinusOne = other.bucketSizeMinusOne;
+			capacity = other.capacity;
 			_count = other._count;
+			growthLeft = other.growthLeft;
 			hashMap = other.hashMap;
-			marks = _Move(other.marks);
-			other.hashMap = 0;
+			ctrl = other.ctrl;
+			other.hashMap = nullptr;
+			other.ctrl = nullptr;
 			other._count = 0;
-			other.bucketSizeMinusOne = -1;
+			other.capacity = 0;
+			other.growthLeft = 0;
 			return *this;
 		}
 		~Dictionary()
@@ -122,6 +122,20 @@ bool FreeList::isValidAllocation(const void* dataIn) const
 	return false;
 }
 
+Index FreeList::calcBlockCount() const
+{
+	Index count = 0;
+	for (Block* block = m_activeBlocks; block; block = block->m_next)
+	{
+		count++;
+	}
+	for (Block* block = m_freeBlocks; block; block = block->m_next)
+	{
+		count++;
+	}
+	return count;
+}
+
 void* FreeList::_allocate()
 {
 	Block* block = m_freeBlocks;
@@ -52,6 +52,9 @@ class FreeList
 	SLANG_FORCE_INLINE void* allocate();
 		/// Deallocate a block that was previously allocated with allocate
 	SLANG_FORCE_INLINE void deallocate(void* data);
+		/// Deallocate without checking data is a valid allocation. The check searches all of the free elements,
+		/// so is too slow in debug builds for lists that free large numbers of elements.
+	SLANG_FORCE_INLINE void deallocateUnchecked(void* data);
 
 		/// Returns true if this is from a valid allocation
 	bool isValidAllocation(const void* dataIn) const;
@@ -60,6 +63,8 @@ class FreeList
 	SLANG_FORCE_INLINE size_t getElementSize() const { return m_elementSize; }
 		/// Get the total size of each individual block allocation in bytes
 	SLANG_FORCE_INLINE size_t getBlockSize() const { return m_blockSize; }
+		/// Get the number of blocks allocated from the heap (whether or not they hold any elements)
+	Index calcBlockCount() const;
 
 		/// Deallocates all elements
 	void deallocateAll();
@@ -130,7 +135,11 @@ SLANG_FORCE_INLINE void* FreeList::allocate()
 SLANG_FORCE_INLINE void FreeList::deallocate(void* data)
 {
 	assert(isValidAllocation(data));
-
+	deallocateUnchecked(data);
+}
+// --------------------------------------------------------------------------
+SLANG_FORCE_INLINE void FreeList::deallocateUnchecked(void* data)
+{
 	SLANG_FREE_LIST_INIT_DEALLOCATE(data)
 
 	// Put onto the singly linked free element list
@@ -55,15 +55,26 @@ namespace Slang
     return SLANG_FAIL;
 }
 
-SlangResult GCCCompilerUtil::calcVersion(const String& exeName, CPPCompiler::Desc& outDesc)
+/* static */void GCCCompilerUtil::calcVersionCommandLine(const String& exeName, CommandLine& outCmdLine)
+{
+    outCmdLine.reset();
+    outCmdLine.setExecutableFilename(exeName);
+    outCmdLine.addArg("-v");
+}
+
+/* static */SlangResult GCCCompilerUtil::calcVersion(const String& exeName, CPPCompiler::Desc& outDesc)
 {
     CommandLine cmdLine;
-    cmdLine.setExecutableFilename(exeName);
-    cmdLine.addArg("-v");
+    calcVersionCommandLine(exeName, cmdLine);
 
     ExecuteResult exeRes;
     SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
 
+    return parseVersionResult(exeRes, outDesc);
+}
+
+/* static */SlangResult GCCCompilerUtil::parseVersionResult(const ExecuteResult& exeRes, CPPCompiler::Desc& outDesc)
+{
     const UnownedStringSlice prefixes[] =
     {
         UnownedStringSlice::fromLiteral("clang version"),
@@ -394,9 +405,31 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
             cmdLine.addArg("-c");
             break;
         }
+        case TargetType::PrecompiledHeader:
+        {
+            // Compile the header. Both GCC and Clang use the result in place of `modulePath` when it is
+            // named with `-include` (see the precompiledHeaderPath handling below).
+            cmdLine.addArg("-x");
+            cmdLine.addArg(options.sourceType == SourceType::CPP ? "c++-header" : "c-header");
+
+            StringBuilder builder;
+            builder << options.modulePath << ".gch";
+
+            cmdLine.addArg("-o");
+            cmdLine.addArg(builder);
+            break;
+        }
         default: break;
     }
 
+    // A precompiled header is only used if it was built with the same code generation options as the source,
+    // so position independent code is used for everything that involves one, whatever the target type.
+    if (options.targetType == TargetType::PrecompiledHeader ||
+        (options.precompiledHeaderPath.getLength() && options.targetType != TargetType::SharedLibrary))
+    {
+        cmdLine.addArg("-fPIC");
+    }
+
     // Add defines
     for (const auto& define : options.defines)
     {
@@ -410,6 +443,14 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
         cmdLine.addArg(builder);
     }
 
+    // The precompiled header is found next to the path given to `-include`. The source's own `#include`
+    // of the header then does nothing, because of the header's include guard.
+    if (options.precompiledHeaderPath.getLength())
+    {
+        cmdLine.addArg("-include");
+        cmdLine.addArg(options.precompiledHeaderPath);
+    }
+
     // Add includes
     for (const auto& include : options.includePaths)
     {
@@ -452,8 +493,14 @@ static SlangResult _parseGCCFamilyLine(const UnownedStringSlice& line, LineParse
 
     if (options.sourceType == SourceType::CPP)
     {
-        // Make STD libs available
-        cmdLine.addArg("-lstdc++");
+        if (options.targetType != TargetType::PrecompiledHeader)
+        {
+            // Make STD libs available
+            cmdLine.addArg("-lstdc++");
+        }
+        // Generated C++ may use std::thread (such as through prelude/slang-cpp-compute.h).
+        // This also defines _REENTRANT, so is needed for precompiled headers to match.
+        cmdLine.addArg("-pthread");
     }
 }
 
@@ -20,6 +20,10 @@ struct GCCCompilerUtil
 
         /// Runs the exeName, and extracts the version info into outDesc
     static SlangResult calcVersion(const String& exeName, CPPCompiler::Desc& outDesc);
+        /// Get the command line that outputs the version info of exeName
+    static void calcVersionCommandLine(const String& exeName, CommandLine& outCmdLine);
+        /// Extracts the version info from the result of running the version command line (see `calcVersionCommandLine`)
+    static SlangResult parseVersionResult(const ExecuteResult& exeRes, CPPCompiler::Desc& outDesc);
 
         /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static void calcArgs(const CompileOptions& options, CommandLine& cmdLine);
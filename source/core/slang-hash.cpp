@@ -0,0 +1,79 @@
+#include "slang-hash.h"
+
+namespace Slang {
+
+// Based on wyhash (https://github.com/wangyi-fudan/wyhash), which is in the public domain
+
+static const uint64_t kHashSecret[4] = { 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull };
+
+SLANG_FORCE_INLINE static uint64_t _read64(const uint8_t* p) { uint64_t v; ::memcpy(&v, p, sizeof(v)); return v; }
+SLANG_FORCE_INLINE static uint64_t _read32(const uint8_t* p) { uint32_t v; ::memcpy(&v, p, sizeof(v)); return v; }
+// Reads 1 to 3 bytes, touching each byte at least once
+SLANG_FORCE_INLINE static uint64_t _read1To3(const uint8_t* p, size_t size) { return (uint64_t(p[0]) << 16) | (uint64_t(p[size >> 1]) << 8) | p[size - 1]; }
+
+SLANG_FORCE_INLINE static void _multiply128(uint64_t& ioA, uint64_t& ioB)
+{
+    ioA = multiply128(ioA, ioB, ioB);
+}
+
+HashCode64 getHashCode64(const void* data, size_t size, uint64_t seed)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    seed ^= mixHash64(seed ^ kHashSecret[0], kHashSecret[1]);
+
+    uint64_t a, b;
+    if (size <= 16)
+    {
+        if (size >= 4)
+        {
+            // Two (possibly overlapping) pairs of 4 byte reads cover all of the bytes
+            const size_t offset = (size >> 3) << 2;
+            a = (_read32(p) << 32) | _read32(p + offset);
+            b = (_read32(p + size - 4) << 32) | _read32(p + size - 4 - offset);
+        }
+        else if (size > 0)
+        {
+            a = _read1To3(p, size);
+            b = 0;
+        }
+        else
+        {
+            a = b = 0;
+        }
+    }
+    else
+    {
+        size_t remaining = size;
+        if (remaining > 48)
+        {
+            // Three independent lanes, so the multiplies can overlap
+            uint64_t seed1 = seed, seed2 = seed;
+            do
+            {
+                seed = mixHash64(_read64(p) ^ kHashSecret[1], _read64(p + 8) ^ seed);
+                seed1 = mixHash64(_read64(p + 16) ^ kHashSecret[2], _read64(p + 24) ^ seed1);
+                seed2 = mixHash64(_read64(p + 32) ^ kHashSecret[3], _read64(p + 40) ^ seed2);
+                p += 48;
+                remaining -= 48;
+            }
+            while (remaining > 48);
+            seed ^= seed1 ^ seed2;
+        }
+        while (remaining > 16)
+        {
+            seed = mixHash64(_read64(p) ^ kHashSecret[1], _read64(p + 8) ^ seed);
+            p += 16;
+            remaining -= 16;
+        }
+        // The last 16 bytes, which may overlap bytes already hashed
+        a = _read64(p + remaining - 16);
+        b = _read64(p + remaining - 8);
+    }
+
+    a ^= kHashSecret[1];
+    b ^= seed;
+    _multiply128(a, b);
+    return mixHash64(a ^ kHashSecret[0] ^ size, b ^ kHashSecret[1]);
+}
+
+}
@@ -1,60 +1,112 @@
 #ifndef SLANG_CORE_HASH_H
 #define SLANG_CORE_HASH_H
 
+#include "slang-common.h"
 #include "slang-math.h"
 #include <string.h>
 #include <type_traits>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#   include <intrin.h>
+#endif
+
 namespace Slang
 {
     typedef int HashCode;
+    typedef uint64_t HashCode64;
+
+        /// Multiply a and b as 128 bit values, returning the low 64 bits, and setting outHigh to the high 64 bits.
+        /// Made from four 32 bit partial products, so works on any platform.
+    SLANG_FORCE_INLINE uint64_t multiply128Portable(uint64_t a, uint64_t b, uint64_t& outHigh)
+    {
+        const uint64_t aLow = uint32_t(a), aHigh = a >> 32;
+        const uint64_t bLow = uint32_t(b), bHigh = b >> 32;
+        const uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+        const uint64_t mid = (lowLow >> 32) + uint32_t(lowHigh) + uint32_t(highLow);
+        outHigh = highHigh + (lowHigh >> 32) + (highLow >> 32) + (mid >> 32);
+        return (mid << 32) | uint32_t(lowLow);
+    }
+
+        /// Multiply a and b as 128 bit values, returning the low 64 bits, and setting outHigh to the high 64 bits.
+        /// Uses the platform's 128 bit multiply if it has one, which gives the same result as `multiply128Portable`.
+    SLANG_FORCE_INLINE uint64_t multiply128(uint64_t a, uint64_t b, uint64_t& outHigh)
+    {
+#if defined(__SIZEOF_INT128__)
+        const __uint128_t r = __uint128_t(a) * b;
+        outHigh = uint64_t(r >> 64);
+        return uint64_t(r);
+#elif defined(_MSC_VER) && defined(_M_X64)
+        return _umul128(a, b, &outHigh);
+#else
+        return multiply128Portable(a, b, outHigh);
+#endif
+    }
+
+        /// Multiply a and b as 128 bit values, and return the xor of the high and low 64 bits.
+        /// A cheap mix where every bit of the result depends on every bit of the inputs.
+    SLANG_FORCE_INLINE uint64_t mixHash64(uint64_t a, uint64_t b)
+    {
+        uint64_t high;
+        const uint64_t low = multiply128(a, b, high);
+        return low ^ high;
+    }
+
+        /// Hash size bytes of data. Based on wyhash, so reads 8 bytes at a time with few branches, and
+        /// is much faster than hashing a character at a time, as well as distributing better.
+        /// The result is the same on every platform with the same endianness, but may change between
+        /// versions, so shouldn't be stored in files that are shared between builds.
+    HashCode64 getHashCode64(const void* data, size_t size, uint64_t seed = 0);
+
+        /// Hash size bytes of data with 32 bit FNV-1a. Much slower than getHashCode64, but the result
+        /// only depends on the bytes, so is the same on every platform and in every version. Use it
+        /// for hashes that can be seen in output, such as generated names.
+    inline uint32_t getStableHashCode32(const void* data, size_t size)
+    {
+        const uint8_t* bytes = (const uint8_t*)data;
+        uint32_t hash = 2166136261u;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash = (hash ^ bytes[i]) * 16777619u;
+        }
+        return hash;
+    }
+
+        /// Reduce a 64 bit hash to a HashCode
+    SLANG_FORCE_INLINE HashCode foldHashCode64(HashCode64 hash) { return HashCode(uint32_t(hash ^ (hash >> 32))); }
+
+        /// Combine a 64 bit hash with another value
+    SLANG_FORCE_INLINE HashCode64 combineHash64(HashCode64 left, uint64_t right)
+    {
+        return mixHash64(left ^ 0x2d358dccaa6c78a5ull, right ^ 0x8bb84b93962eacc9ull);
+    }
 
 	inline int GetHashCode(double key)
 	{
-		return FloatAsInt((float)key);
+        uint64_t bits;
+        ::memcpy(&bits, &key, sizeof(bits));
+		return foldHashCode64(bits);
 	}
 	inline int GetHashCode(float key)
 	{
 		return FloatAsInt(key);
 	}
+    inline int GetHashCode(const char * buffer, size_t numChars)
+    {
+        return foldHashCode64(getHashCode64(buffer, numChars));
+    }
 	inline int GetHashCode(const char * buffer)
 	{
-		if (!buffer)
-			return 0;
-		int hash = 0;
-		int c;
-		auto str = buffer;
-		c = *str++;
-		while (c)
-		{
-			hash = c + (hash << 6) + (hash << 16) - hash;
-			c = *str++;
-		}
-		return hash;
+        // Must match the hash of the same characters with a size, as strings and slices hash the same
+		return GetHashCode(buffer, buffer ? ::strlen(buffer) : 0);
 	}
 	inline int GetHashCode(char * buffer)
 	{
 		return GetHashCode(const_cast<const char *>(buffer));
 	}
-    inline int GetHashCode(const char * buffer, size_t numChars)
-    {
-        int hash = 0;
-        for (size_t i = 0; i < numChars; ++i)
-        {      
-            hash = int(buffer[i]) + (hash << 6) + (hash << 16) - hash;
-        }
-        return hash;
-    }
 
     inline uint64_t GetHashCode64(const char * buffer, size_t numChars)
     {
-        // Use uints because hash requires wrap around behavior and int is undefined on over/underflows
-        uint64_t hash = 0;
-        for (size_t i = 0; i < numChars; ++i)
-        {
-            hash = uint64_t(int64_t(buffer[i])) + (hash << 6) + (hash << 16) - hash;
-        }
-        return hash;
+        return getHashCode64(buffer, numChars);
     }
 
 	template<int IsInt>
@@ -69,7 +121,8 @@ namespace Slang
 		template<typename TKey>
 		static int GetHashCode(TKey & key)
 		{
-			return (int)key;
+            // Fold, so the high bits of 64 bit values aren't lost
+			return (sizeof(TKey) > sizeof(int)) ? foldHashCode64(uint64_t(key)) : (int)key;
 		}
 	};
 	template<>
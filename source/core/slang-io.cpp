@@ -11,6 +11,7 @@
 
 #ifdef _WIN32
 #   include <direct.h>
+#   include <sys/utime.h>
 
 #   define WIN32_LEAN_AND_MEAN
 #   define VC_EXTRALEAN
@@ -21,6 +22,12 @@
 #   include <unistd.h>
 #endif
 
+#ifndef _WIN32
+#   include <dirent.h>
+#   include <errno.h>
+#   include <utime.h>
+#endif
+
 #if SLANG_APPLE_FAMILY
 #   include <mach-o/dyld.h>
 #endif
@@ -62,6 +69,39 @@ namespace Slang
 #endif
 	}
 
+    /* static */SlangResult File::getSizeAndModifiedTime(const String& fileName, int64_t& outSize, int64_t& outModifiedTime)
+    {
+#ifdef _WIN32
+        struct _stat64 statVar;
+        if (::_wstat64(fileName.toWString(), &statVar) != 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+#else
+        struct stat statVar;
+        if (::stat(fileName.getBuffer(), &statVar) != 0)
+        {
+            return SLANG_E_NOT_FOUND;
+        }
+#endif
+        outSize = int64_t(statVar.st_size);
+        outModifiedTime = int64_t(statVar.st_mtime);
+        return SLANG_OK;
+    }
+
+    /* static */SlangResult File::setModifiedTimeToNow(const String& fileName)
+    {
+#ifdef _WIN32
+        if (::_wutime(fileName.toWString(), nullptr) != 0)
+#else
+        if (::utime(fileName.getBuffer(), nullptr) != 0)
+#endif
+        {
+            return SLANG_FAIL;
+        }
+        return SLANG_OK;
+    }
+
 	String Path::truncateExt(const String& path)
 	{
 		UInt dotPos = path.lastIndexOf('.');
@@ -382,6 +422,56 @@ namespace Slang
     }
 
 
+    /* static */SlangResult Path::getDirectoryContents(const String& path, List<String>& outNames)
+    {
+        outNames.clear();
+#ifdef _WIN32
+        // https://docs.microsoft.com/en-us/windows/win32/api/fileapi/nf-fileapi-findfirstfilea
+        WIN32_FIND_DATAA findData;
+        HANDLE findHandle = ::FindFirstFileA(Path::combine(path, "*").getBuffer(), &findData);
+        if (findHandle == INVALID_HANDLE_VALUE)
+        {
+            const DWORD lastError = ::GetLastError();
+            return (lastError == ERROR_PATH_NOT_FOUND || lastError == ERROR_FILE_NOT_FOUND) ? SLANG_E_NOT_FOUND : SLANG_FAIL;
+        }
+        do
+        {
+            const UnownedStringSlice name(findData.cFileName);
+            if (name == "." || name == "..")
+            {
+                continue;
+            }
+            outNames.add(name);
+            // A path can also name the entry by its short (8.3) name
+            if (findData.cAlternateFileName[0])
+            {
+                outNames.add(findData.cAlternateFileName);
+            }
+        }
+        while (::FindNextFileA(findHandle, &findData));
+        ::FindClose(findHandle);
+        return SLANG_OK;
+#else
+        // https://linux.die.net/man/3/opendir
+        DIR* dir = ::opendir(path.getBuffer());
+        if (!dir)
+        {
+            return (errno == ENOENT || errno == ENOTDIR) ? SLANG_E_NOT_FOUND : SLANG_FAIL;
+        }
+        while (struct dirent* entry = ::readdir(dir))
+        {
+            const UnownedStringSlice name(entry->d_name);
+            if (name == "." || name == "..")
+            {
+                continue;
+            }
+            outNames.add(name);
+        }
+        ::closedir(dir);
+        return SLANG_OK;
+#endif
+    }
+
     /* static */SlangResult Path::getCanonical(const String& path, String& canonicalPathOut)
     {
 #if defined(_WIN32)
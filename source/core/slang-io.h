@@ -16,6 +16,10 @@ namespace Slang
 		static Slang::List<unsigned char> readAllBytes(const Slang::String& fileName);
 		static void writeAllText(const Slang::String& fileName, const Slang::String& text);
         static SlangResult remove(const String& fileName);
+            /// Get the size in bytes and the modification time (in seconds, as reported by stat) of a file
+        static SlangResult getSizeAndModifiedTime(const String& fileName, int64_t& outSize, int64_t& outModifiedTime);
+            /// Set the modification time of a file to the current time
+        static SlangResult setModifiedTimeToNow(const String& fileName);
 	};
 
 	class Path
@@ -68,6 +72,12 @@ namespace Slang
             /// @return SLANG_OK on success
         static SlangResult getPathType(const String& path, SlangPathType* outPathType);
 
+            /// Get the names of the entries in the directory at path (not including `.` and `..`)
+            /// @param path The path of the directory
+            /// @param outNames Holds the names on success
+            /// @return SLANG_OK on success, SLANG_E_NOT_FOUND if there is no directory at path
+        static SlangResult getDirectoryContents(const String& path, List<String>& outNames);
+
             /// Determines the canonical equivalent path to path.
             /// The path returned should reference the identical object - and two different references to the same path should return the same canonical path
             /// @param path Path to get the canonical path for
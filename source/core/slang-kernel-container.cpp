@@ -0,0 +1,300 @@
+#include "slang-kernel-container.h"
+
+#include "slang-dictionary.h"
+
+namespace Slang {
+
+typedef KernelContainerBinary Bin;
+
+namespace { // anonymous
+
+struct ContainerWriter
+{
+    void write(const void* data, size_t size)
+    {
+        const Index start = m_data.getCount();
+        m_data.setCount(start + Index(size));
+        if (size)
+        {
+            ::memcpy(m_data.getBuffer() + start, data, size);
+        }
+    }
+        /// Write zeros until the size is a multiple of alignment
+    void align(size_t alignment)
+    {
+        const size_t size = size_t(m_data.getCount());
+        const size_t alignedSize = (size + alignment - 1) & ~(alignment - 1);
+        m_data.setCount(Index(alignedSize));
+        ::memset(m_data.getBuffer() + size, 0, alignedSize - size);
+    }
+
+        /// Write a chunk header, returning its offset, so the size can be patched by endChunk
+    size_t beginChunk(uint32_t type)
+    {
+        const size_t offset = size_t(m_data.getCount());
+        Bin::Chunk chunk = { type, 0 };
+        write(&chunk, sizeof(chunk));
+        return offset;
+    }
+    void endChunk(size_t chunkOffset)
+    {
+        // All chunks have sizes rounded to dword size
+        align(4);
+        Bin::Chunk* chunk = (Bin::Chunk*)(m_data.getBuffer() + chunkOffset);
+        chunk->m_size = uint32_t(size_t(m_data.getCount()) - (chunkOffset + sizeof(Bin::Chunk)));
+    }
+
+    List<uint8_t> m_data;
+};
+
+struct StringTable
+{
+    uint32_t add(const String& value)
+    {
+        if (const uint32_t* offsetPtr = m_offsets.TryGetValue(value))
+        {
+            return *offsetPtr;
+        }
+        const uint32_t offset = uint32_t(m_data.getCount());
+        m_data.addRange((const char*)value.getBuffer(), value.getLength());
+        m_data.add(0);
+        m_offsets.Add(value, offset);
+        return offset;
+    }
+
+    List<char> m_data;
+    Dictionary<String, uint32_t> m_offsets;
+};
+
+} // anonymous
+
+SlangResult KernelContainerWriter::write(List<uint8_t>& out)
+{
+    StringTable strings;
+
+    List<Bin::KernelEntry> entries;
+    for (const auto& kernel : m_kernels)
+    {
+        Bin::KernelEntry entry;
+        entry.m_target = kernel.target;
+        entry.m_stage = kernel.stage;
+        entry.m_entryPointIndex = kernel.entryPointIndex;
+        entry.m_nameOffset = strings.add(kernel.name);
+        entry.m_profileOffset = strings.add(kernel.profile);
+        // Set when the data is written
+        entry.m_dataOffset = 0;
+        entry.m_dataSize = uint32_t(kernel.size);
+        entry.m_pad = 0;
+        entries.add(entry);
+    }
+
+    List<uint32_t> dependencyOffsets;
+    for (const auto& path : m_dependencies)
+    {
+        dependencyOffsets.add(strings.add(path));
+    }
+
+    ContainerWriter writer;
+    const size_t riffOffset = writer.beginChunk(Bin::kRiffFourCc);
+    {
+        Bin::Header header;
+        header.m_chunk.m_type = Bin::kHeaderFourCc;
+        header.m_chunk.m_size = uint32_t(sizeof(header) - sizeof(Bin::Chunk));
+        header.m_version = Bin::kVersion;
+        header.m_kernelCount = uint32_t(entries.getCount());
+        header.m_dependencyCount = uint32_t(dependencyOffsets.getCount());
+        header.m_flags = 0;
+        writer.write(&header, sizeof(header));
+    }
+
+    const size_t indexOffset = writer.beginChunk(Bin::kIndexFourCc);
+    // Entries are patched with the data offsets once they are known
+    const size_t entriesOffset = size_t(writer.m_data.getCount());
+    writer.write(entries.getBuffer(), sizeof(Bin::KernelEntry) * entries.getCount());
+    writer.endChunk(indexOffset);
+
+    const size_t stringOffset = writer.beginChunk(Bin::kStringFourCc);
+    writer.write(strings.m_data.getBuffer(), size_t(strings.m_data.getCount()));
+    writer.endChunk(stringOffset);
+
+    const size_t dependencyOffset = writer.beginChunk(Bin::kDependencyFourCc);
+    writer.write(dependencyOffsets.getBuffer(), sizeof(uint32_t) * dependencyOffsets.getCount());
+    writer.endChunk(dependencyOffset);
+
+    const size_t dataOffset = writer.beginChunk(Bin::kDataFourCc);
+    for (Index i = 0; i < m_kernels.getCount(); ++i)
+    {
+        const auto& kernel = m_kernels[i];
+        writer.align(Bin::kDataAlignment);
+
+        Bin::KernelEntry* entry = (Bin::KernelEntry*)(writer.m_data.getBuffer() + entriesOffset) + i;
+        entry->m_dataOffset = uint32_t(writer.m_data.getCount());
+        writer.write(kernel.data, kernel.size);
+    }
+    writer.endChunk(dataOffset);
+
+    writer.endChunk(riffOffset);
+
+    // Offsets and sizes are 32 bits
+    if (uint64_t(writer.m_data.getCount()) > 0xffffffff)
+    {
+        return SLANG_FAIL;
+    }
+
+    out.swapWith(writer.m_data);
+    return SLANG_OK;
+}
+
+SlangResult KernelContainerReader::init(const void* data, size_t size)
+{
+    *this = KernelContainerReader();
+
+    const uint8_t* cur = (const uint8_t*)data;
+    {
+        if (size < sizeof(Bin::Chunk))
+        {
+            return SLANG_FAIL;
+        }
+        const Bin::Chunk* riff = (const Bin::Chunk*)cur;
+        if (riff->m_type != Bin::kRiffFourCc || riff->m_size > size - sizeof(Bin::Chunk))
+        {
+            return SLANG_FAIL;
+        }
+        size = riff->m_size + sizeof(Bin::Chunk);
+    }
+
+    const uint8_t* const end = cur + size;
+    cur += sizeof(Bin::Chunk);
+
+    const Bin::Header* header = nullptr;
+    const uint8_t* strings = nullptr;
+    const uint8_t* entries = nullptr;
+    const uint8_t* dependencies = nullptr;
+    size_t stringsSize = 0, entriesSize = 0, dependenciesSize = 0;
+
+    while (size_t(end - cur) >= sizeof(Bin::Chunk))
+    {
+        const Bin::Chunk* chunk = (const Bin::Chunk*)cur;
+        const uint8_t* payload = cur + sizeof(Bin::Chunk);
+        if (chunk->m_size > size_t(end - payload))
+        {
+            return SLANG_FAIL;
+        }
+
+        switch (chunk->m_type)
+        {
+            case Bin::kHeaderFourCc:
+            {
+                if (chunk->m_size < sizeof(Bin::Header) - sizeof(Bin::Chunk))
+                {
+                    return SLANG_FAIL;
+                }
+                header = (const Bin::Header*)chunk;
+                break;
+            }
+            case Bin::kIndexFourCc:
+            {
+                entries = payload;
+                entriesSize = chunk->m_size;
+                break;
+            }
+            case Bin::kStringFourCc:
+            {
+                strings = payload;
+                stringsSize = chunk->m_size;
+                break;
+            }
+            case Bin::kDependencyFourCc:
+            {
+                dependencies = payload;
+                dependenciesSize = chunk->m_size;
+                break;
+            }
+            default: break;
+        }
+
+        // Chunk sizes are rounded up to dword size
+        cur = payload + ((chunk->m_size + 3) & ~uint32_t(3));
+    }
+
+    if (!header || header->m_version != Bin::kVersion ||
+        entriesSize < sizeof(Bin::KernelEntry) * size_t(header->m_kernelCount) ||
+        dependenciesSize < sizeof(uint32_t) * size_t(header->m_dependencyCount))
+    {
+        return SLANG_FAIL;
+    }
+
+    // Strings are zero terminated, so if the last byte is zero, no string runs off the end
+    while (stringsSize > 0 && strings[stringsSize - 1] != 0)
+    {
+        // Skip the chunk padding
+        stringsSize--;
+    }
+
+    m_data = (const uint8_t*)data;
+    m_size = size;
+    m_entries = (const Bin::KernelEntry*)entries;
+    m_kernelCount = header->m_kernelCount;
+    m_dependencyOffsets = (const uint32_t*)dependencies;
+    m_dependencyCount = header->m_dependencyCount;
+    m_strings = (const char*)strings;
+    m_stringsSize = uint32_t(stringsSize);
+
+    for (uint32_t i = 0; i < m_kernelCount; ++i)
+    {
+        const auto& entry = m_entries[i];
+        if (entry.m_nameOffset >= m_stringsSize || entry.m_profileOffset >= m_stringsSize ||
+            entry.m_dataOffset > size || entry.m_dataSize > size - entry.m_dataOffset)
+        {
+            *this = KernelContainerReader();
+            return SLANG_FAIL;
+        }
+    }
+    for (uint32_t i = 0; i < m_dependencyCount; ++i)
+    {
+        if (m_dependencyOffsets[i] >= m_stringsSize)
+        {
+            *this = KernelContainerReader();
+            return SLANG_FAIL;
+        }
+    }
+
+    return SLANG_OK;
+}
+
+UnownedStringSlice KernelContainerReader::_getString(uint32_t offset) const
+{
+    const char* start = m_strings + offset;
+    return UnownedStringSlice(start, start + ::strlen(start));
+}
+
+KernelContainerReader::Kernel KernelContainerReader::getKernel(Index index) const
+{
+    SLANG_ASSERT(index >= 0 && index < Index(m_kernelCount));
+    const auto& entry = m_entries[index];
+
+    Kernel kernel;
+    kernel.target = entry.m_target;
+    kernel.stage = entry.m_stage;
+    kernel.entryPointIndex = entry.m_entryPointIndex;
+    kernel.name = _getString(entry.m_nameOffset);
+    kernel.profile = _getString(entry.m_profileOffset);
+    kernel.data = m_data + entry.m_dataOffset;
+    kernel.size = entry.m_dataSize;
+    return kernel;
+}
+
+Index KernelContainerReader::findKernel(uint32_t target, const UnownedStringSlice& name) const
+{
+    for (uint32_t i = 0; i < m_kernelCount; ++i)
+    {
+        const auto& entry = m_entries[i];
+        if (entry.m_target == target && _getString(entry.m_nameOffset) == name)
+        {
+            return Index(i);
+        }
+    }
+    return -1;
+}
+
+} // namespace Slang
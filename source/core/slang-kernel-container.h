@@ -0,0 +1,145 @@
+#ifndef SLANG_CORE_KERNEL_CONTAINER_H
+#define SLANG_CORE_KERNEL_CONTAINER_H
+
+#include "slang-list.h"
+#include "slang-string.h"
+
+#ifndef SLANG_FOUR_CC
+#define SLANG_FOUR_CC(c0, c1, c2, c3) ((uint32_t(c0) << 0) | (uint32_t(c1) << 8) | (uint32_t(c2) << 16) | (uint32_t(c3) << 24)) 
+#endif
+
+namespace Slang {
+
+    /// The layout of a kernel container.
+    ///
+    /// A kernel container holds the output of a compile for every target and entry point in a single
+    /// RIFF file, so that a runtime can load one file per shader. The index chunk gives the offset and
+    /// size of each kernel, and kernels are held unchanged and 16 byte aligned in the data chunk, so a
+    /// reader working on a memory mapped file can hand out kernels without copying them.
+    ///
+    /// The layout is
+    /// * 'RIFF' chunk, holding
+    ///   * Header chunk - Header (always first)
+    ///   * Index chunk - KernelEntry[kernelCount]
+    ///   * String chunk - zero terminated strings, referenced by byte offset from the start of the payload
+    ///   * Dependency chunk - uint32_t[dependencyCount], string offsets of the paths of files the compile read
+    ///   * Data chunk - the kernels
+struct KernelContainerBinary
+{
+    struct Chunk
+    {
+        uint32_t m_type;
+        uint32_t m_size;            ///< Size of the payload (not including the Chunk), which is padded to a multiple of 4
+    };
+
+    struct Header
+    {
+        Chunk m_chunk;
+        uint32_t m_version;
+        uint32_t m_kernelCount;
+        uint32_t m_dependencyCount;
+        uint32_t m_flags;           ///< Currently always 0
+    };
+
+    struct KernelEntry
+    {
+        uint32_t m_target;          ///< SlangCompileTarget
+        uint32_t m_stage;           ///< SlangStage
+        uint32_t m_entryPointIndex;
+        uint32_t m_nameOffset;      ///< String offset of the entry point name
+        uint32_t m_profileOffset;   ///< String offset of the profile name
+        uint32_t m_dataOffset;      ///< Offset from the start of the container
+        uint32_t m_dataSize;
+        uint32_t m_pad;
+    };
+
+    static const uint32_t kRiffFourCc = SLANG_FOUR_CC('R', 'I', 'F', 'F');
+    static const uint32_t kHeaderFourCc = SLANG_FOUR_CC('S', 'K', 'h', 'd');        ///< First chunk, identifies the RIFF as a kernel container
+
+    static const uint32_t kIndexFourCc = SLANG_FOUR_CC('S', 'K', 'i', 'x');
+    static const uint32_t kStringFourCc = SLANG_FOUR_CC('S', 'K', 's', 't');
+    static const uint32_t kDependencyFourCc = SLANG_FOUR_CC('S', 'K', 'd', 'p');
+    static const uint32_t kDataFourCc = SLANG_FOUR_CC('S', 'K', 'd', 't');
+
+        /// Increment if the layout changes
+    static const uint32_t kVersion = 1;
+        /// Alignment of kernels from the start of the container
+    static const uint32_t kDataAlignment = 16;
+};
+
+    /// Builds a kernel container
+class KernelContainerWriter
+{
+public:
+    struct Kernel
+    {
+        uint32_t target;
+        uint32_t stage;
+        uint32_t entryPointIndex;
+        String name;
+        String profile;
+        const void* data;           ///< Must stay in scope until write is called
+        size_t size;
+    };
+
+        /// Add a kernel. The data is not copied.
+    void addKernel(const Kernel& kernel) { m_kernels.add(kernel); }
+        /// Add the path of a file the compile depended on
+    void addDependency(const String& path) { m_dependencies.add(path); }
+
+        /// Write the container, replacing the contents of out
+    SlangResult write(List<uint8_t>& out);
+
+protected:
+    List<Kernel> m_kernels;
+    List<String> m_dependencies;
+};
+
+    /// Reads a kernel container in place. Nothing is copied, so the memory the reader is initialized with
+    /// (for example a MappedFileBlob) must stay in scope for as long as the reader and anything it returns is used.
+class KernelContainerReader
+{
+public:
+    struct Kernel
+    {
+        uint32_t target;
+        uint32_t stage;
+        uint32_t entryPointIndex;
+        UnownedStringSlice name;
+        UnownedStringSlice profile;
+        const void* data;
+        size_t size;
+    };
+
+        /// Initialize with the contents of a container. Fails if the data isn't a valid container.
+    SlangResult init(const void* data, size_t size);
+
+        /// Get the number of kernels
+    Index getKernelCount() const { return Index(m_kernelCount); }
+        /// Get the kernel at index
+    Kernel getKernel(Index index) const;
+        /// Find the index of the kernel for an entry point (by name) and target. Returns -1 if not found.
+    Index findKernel(uint32_t target, const UnownedStringSlice& name) const;
+
+        /// Get the number of dependencies
+    Index getDependencyCount() const { return Index(m_dependencyCount); }
+        /// Get the path of a dependency
+    UnownedStringSlice getDependency(Index index) const { return _getString(m_dependencyOffsets[index]); }
+
+protected:
+    UnownedStringSlice _getString(uint32_t offset) const;
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+    const KernelContainerBinary::KernelEntry* m_entries = nullptr;
+    uint32_t m_kernelCount = 0;
+    const uint32_t* m_dependencyOffsets = nullptr;
+    uint32_t m_dependencyCount = 0;
+    const char* m_strings = nullptr;
+    uint32_t m_stringsSize = 0;
+};
+
+} // namespace Slang
+
+#endif
@@ -263,10 +263,11 @@ namespace Slang
 					}
 					else*/
 					{
+						// Move (rather than copy) so reference counted elements don't change their counts
 						for (Index i = 0; i < idx; i++)
-							newBuffer[i] = m_buffer[i];
+							newBuffer[i] = static_cast<T&&>(m_buffer[i]);
 						for (Index i = idx; i < m_count; i++)
-							newBuffer[i + n] = T(static_cast<T&&>(m_buffer[i]));
+							newBuffer[i + n] = static_cast<T&&>(m_buffer[i]);
 					}
 					_deallocateBuffer();
 				}
@@ -367,14 +368,10 @@ namespace Slang
 						memcpy(newBuffer, buffer, _count * sizeof(T));
 					else*/
 					{
+						// The new buffer's elements are already default constructed (see _allocate), so the
+						// elements are moved into place
 						for (Index i = 0; i < m_count; i++)
 							newBuffer[i] = static_cast<T&&>(m_buffer[i]);
-
-                        // Default-initialize the remaining elements
-                        for(Index i = m_count; i < size; i++)
-                        {
-                            new(newBuffer + i) T();
-                        }
 					}
 					_deallocateBuffer();
 				}
@@ -0,0 +1,227 @@
+#include "slang-lz4-util.h"
+
+#include <string.h>
+
+namespace Slang {
+
+namespace { // anonymous
+
+enum
+{
+    kMinMatch = 4,                  ///< The smallest match that can be encoded
+    kLastLiterals = 5,              ///< The last bytes of a block are always literals
+    kMatchLimit = 12,               ///< The last match must start at least this many bytes before the end of the block
+    kMaxOffset = 0xffff,            ///< Offsets are held in 16 bits
+    kHashBits = 12,
+};
+
+// Typed, as it's compared against (and selected with) size_t lengths
+const size_t kRunMask = 0xf;                ///< Mask for a length held in a token
+
+} // anonymous
+
+static SLANG_FORCE_INLINE uint32_t _read32(const uint8_t* in)
+{
+    uint32_t value;
+    ::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+static SLANG_FORCE_INLINE uint32_t _hash(uint32_t value)
+{
+    return (value * 2654435761u) >> (32 - kHashBits);
+}
+
+// Write the remainder of a length that didn't fit in a token
+static uint8_t* _writeLength(uint8_t* out, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        *out++ = 255;
+    }
+    *out++ = uint8_t(length);
+    return out;
+}
+
+static uint8_t* _writeLiterals(uint8_t* out, uint8_t* token, const uint8_t* literals, size_t literalLength)
+{
+    *token = uint8_t((literalLength >= kRunMask ? kRunMask : literalLength) << 4);
+    if (literalLength >= kRunMask)
+    {
+        out = _writeLength(out, literalLength - kRunMask);
+    }
+    ::memcpy(out, literals, literalLength);
+    return out + literalLength;
+}
+
+/* static */size_t LZ4Util::compress(const void* srcIn, size_t srcSize, void* dstIn)
+{
+    const uint8_t* src = (const uint8_t*)srcIn;
+    const uint8_t* srcEnd = src + srcSize;
+    uint8_t* out = (uint8_t*)dstIn;
+
+    const uint8_t* anchor = src;
+
+    if (srcSize > kMatchLimit)
+    {
+        // Holds the offset from src of the last position with each hash
+        uint32_t table[1 << kHashBits];
+        ::memset(table, 0, sizeof(table));
+
+        const uint8_t* matchStartLimit = srcEnd - kMatchLimit;
+        const uint8_t* matchEndLimit = srcEnd - kLastLiterals;
+
+        const uint8_t* cur = src;
+        while (cur < matchStartLimit)
+        {
+            const uint32_t sequence = _read32(cur);
+            const uint32_t hash = _hash(sequence);
+            const uint8_t* candidate = src + table[hash];
+            table[hash] = uint32_t(cur - src);
+
+            if (candidate >= cur || size_t(cur - candidate) > kMaxOffset || _read32(candidate) != sequence)
+            {
+                cur++;
+                continue;
+            }
+
+            // Extend the match backwards over literals, and then forwards as far as allowed
+            while (cur > anchor && candidate > src && cur[-1] == candidate[-1])
+            {
+                cur--;
+                candidate--;
+            }
+            const uint8_t* matchEnd = cur + kMinMatch;
+            const uint8_t* ref = candidate + kMinMatch;
+            while (matchEnd < matchEndLimit && *matchEnd == *ref)
+            {
+                matchEnd++;
+                ref++;
+            }
+
+            uint8_t* token = out++;
+            out = _writeLiterals(out, token, anchor, size_t(cur - anchor));
+
+            const size_t offset = size_t(cur - candidate);
+            *out++ = uint8_t(offset);
+            *out++ = uint8_t(offset >> 8);
+
+            const size_t matchLength = size_t(matchEnd - cur) - kMinMatch;
+            *token |= uint8_t(matchLength >= kRunMask ? kRunMask : matchLength);
+            if (matchLength >= kRunMask)
+            {
+                out = _writeLength(out, matchLength - kRunMask);
+            }
+
+            cur = matchEnd;
+            anchor = cur;
+        }
+    }
+
+    // The last sequence is only literals
+    uint8_t* token = out++;
+    out = _writeLiterals(out, token, anchor, size_t(srcEnd - anchor));
+
+    return size_t(out - (uint8_t*)dstIn);
+}
+
+/* static */void LZ4Util::compress(const void* src, size_t srcSize, List<uint8_t>& dstOut)
+{
+    dstOut.setCount(Index(calcMaxCompressedSize(srcSize)));
+    const size_t size = compress(src, srcSize, dstOut.getBuffer());
+    dstOut.setCount(Index(size));
+}
+
+/* static */SlangResult LZ4Util::decompress(const void* srcIn, size_t srcSize, void* dstIn, size_t dstSize)
+{
+    const uint8_t* in = (const uint8_t*)srcIn;
+    const uint8_t* inEnd = in + srcSize;
+    uint8_t* dst = (uint8_t*)dstIn;
+    uint8_t* out = dst;
+    uint8_t* outEnd = dst + dstSize;
+
+    while (in < inEnd)
+    {
+        const uint32_t token = *in++;
+
+        size_t literalLength = token >> 4;
+        if (literalLength == kRunMask)
+        {
+            uint32_t byte;
+            do
+            {
+                if (in >= inEnd)
+                {
+                    return SLANG_FAIL;
+                }
+                byte = *in++;
+                literalLength += byte;
+            }
+            while (byte == 255);
+        }
+        if (literalLength > size_t(inEnd - in) || literalLength > size_t(outEnd - out))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        // The last sequence has no match
+        if (in >= inEnd)
+        {
+            break;
+        }
+
+        if (inEnd - in < 2)
+        {
+            return SLANG_FAIL;
+        }
+        const size_t offset = size_t(in[0]) | (size_t(in[1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > size_t(out - dst))
+        {
+            return SLANG_FAIL;
+        }
+
+        size_t matchLength = token & kRunMask;
+        if (matchLength == kRunMask)
+        {
+            uint32_t byte;
+            do
+            {
+                if (in >= inEnd)
+                {
+                    return SLANG_FAIL;
+                }
+                byte = *in++;
+                matchLength += byte;
+            }
+            while (byte == 255);
+        }
+        matchLength += kMinMatch;
+        if (matchLength > size_t(outEnd - out))
+        {
+            return SLANG_FAIL;
+        }
+
+        const uint8_t* match = out - offset;
+        if (offset >= matchLength)
+        {
+            ::memcpy(out, match, matchLength);
+            out += matchLength;
+        }
+        else
+        {
+            // The match overlaps what is being written (a repeating pattern), so has to be copied a byte at a time
+            for (size_t i = 0; i < matchLength; ++i)
+            {
+                *out++ = *match++;
+            }
+        }
+    }
+
+    return (out == outEnd) ? SLANG_OK : SLANG_FAIL;
+}
+
+} // namespace Slang
@@ -0,0 +1,42 @@
+#ifndef SLANG_CORE_LZ4_UTIL_H
+#define SLANG_CORE_LZ4_UTIL_H
+
+#include "slang-list.h"
+
+namespace Slang {
+
+    /// Compression and decompression in the LZ4 block format.
+    ///
+    /// LZ4 trades compression ratio for decode speed: decoding is little more than
+    /// a sequence of memcpys. The output is compatible with the reference LZ4 block
+    /// format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md), but the
+    /// compressor is a simple greedy one, so it won't produce identical output.
+struct LZ4Util
+{
+        /// The largest compressed size for srcSize bytes of input
+    static size_t calcMaxCompressedSize(size_t srcSize) { return srcSize + (srcSize / 255) + 16; }
+
+        /** Compress
+        @param src The data to compress
+        @param srcSize The size of the data in bytes
+        @param dst Where to write the compressed data. MUST be at least calcMaxCompressedSize(srcSize) bytes
+        @return The size of the compressed data in bytes
+        */
+    static size_t compress(const void* src, size_t srcSize, void* dst);
+
+        /// Compress src, replacing the contents of dstOut
+    static void compress(const void* src, size_t srcSize, List<uint8_t>& dstOut);
+
+        /** Decompress
+        @param src The compressed data
+        @param srcSize The size of the compressed data in bytes
+        @param dst Where to write the decompressed data
+        @param dstSize The size of the decompressed data. Must match the size of the data that was compressed.
+        @return SLANG_OK if the data decompressed to exactly dstSize bytes, otherwise a failure (for example if the data is corrupt)
+        */
+    static SlangResult decompress(const void* src, size_t srcSize, void* dst, size_t dstSize);
+};
+
+} // namespace Slang
+
+#endif
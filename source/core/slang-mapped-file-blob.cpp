@@ -0,0 +1,208 @@
+#include "slang-mapped-file-blob.h"
+
+#include "slang-dictionary.h"
+#include "slang-io.h"
+
+#include <mutex>
+#include <string.h>
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   define VC_EXTRALEAN
+#   include <Windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <unistd.h>
+#endif
+
+namespace Slang {
+
+static const Guid IID_ISlangUnknown = SLANG_UUID_ISlangUnknown;
+static const Guid IID_ISlangBlob = SLANG_UUID_ISlangBlob;
+
+namespace { // anonymous
+
+// All of the mapped blobs in the process, keyed by canonical path. A blob removes itself
+// when it is destroyed, so the map doesn't keep anything mapped.
+//
+// The map is never freed, as blobs may be released during static destruction.
+struct MappedBlobRegistry
+{
+    std::mutex mutex;
+    Dictionary<String, MappedFileBlob*> blobs;
+};
+
+} // anonymous
+
+static MappedBlobRegistry& _getRegistry()
+{
+    static MappedBlobRegistry* registry = new MappedBlobRegistry;
+    return *registry;
+}
+
+static size_t _getPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    ::GetSystemInfo(&info);
+    return size_t(info.dwPageSize);
+#else
+    return size_t(::sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// True if the contents are the same as `File::readAllText` would produce
+static bool _isUsableAsText(const char* data, size_t size)
+{
+    const unsigned char* bytes = (const unsigned char*)data;
+
+    // Byte order marks are removed
+    if (size >= 3 && bytes[0] == 0xef && bytes[1] == 0xbb && bytes[2] == 0xbf)
+    {
+        return false;
+    }
+    if (size >= 2 && ((bytes[0] == 0xff && bytes[1] == 0xfe) || (bytes[0] == 0xfe && bytes[1] == 0xff)))
+    {
+        return false;
+    }
+    // Line endings are converted, and null bytes mean the file is UTF-16
+    return ::memchr(data, '\r', size) == nullptr && ::memchr(data, 0, size) == nullptr;
+}
+
+ISlangUnknown* MappedFileBlob::getInterface(const Guid& guid)
+{
+    return (guid == IID_ISlangUnknown || guid == IID_ISlangBlob) ? static_cast<ISlangBlob*>(this) : nullptr;
+}
+
+uint32_t MappedFileBlob::release()
+{
+    uint32_t count;
+    {
+        // The count must reach zero under the lock, so `loadShared` can't find a blob being destroyed
+        MappedBlobRegistry& registry = _getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        count = --m_refCount;
+        if (count == 0)
+        {
+            MappedFileBlob* registeredBlob = nullptr;
+            if (registry.blobs.TryGetValue(m_key, registeredBlob) && registeredBlob == this)
+            {
+                registry.blobs.Remove(m_key);
+            }
+        }
+    }
+    if (count == 0)
+    {
+        delete this;
+    }
+    return count;
+}
+
+MappedFileBlob::~MappedFileBlob()
+{
+    if (!m_data)
+    {
+        return;
+    }
+#ifdef _WIN32
+    ::UnmapViewOfFile(m_data);
+    ::CloseHandle((HANDLE)m_mappingHandle);
+#else
+    ::munmap((void*)m_data, m_size);
+#endif
+}
+
+/* static */SlangResult MappedFileBlob::loadShared(const String& path, ComPtr<ISlangBlob>& outBlob)
+{
+    String key;
+    SLANG_RETURN_ON_FAIL(Path::getCanonical(path, key));
+
+    int64_t size, modifiedTime;
+    SLANG_RETURN_ON_FAIL(File::getSizeAndModifiedTime(key, size, modifiedTime));
+
+    // When the size isn't a multiple of the page size, the end of the last page of the mapping
+    // is zeroed, so the contents are followed by a 0 (as they are in a `String`).
+    if (size < int64_t(kMinMappedSize) || (size % int64_t(_getPageSize())) == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    MappedBlobRegistry& registry = _getRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        MappedFileBlob* blob = nullptr;
+        if (registry.blobs.TryGetValue(key, blob) && blob->m_size == size_t(size) && blob->m_modifiedTime == modifiedTime)
+        {
+            outBlob = blob;
+            return SLANG_OK;
+        }
+    }
+
+    MappedFileBlob* blob = new MappedFileBlob;
+    ComPtr<ISlangBlob> blobPtr(blob);
+    blob->m_key = key;
+    blob->m_modifiedTime = modifiedTime;
+
+#ifdef _WIN32
+    HANDLE fileHandle = ::CreateFileW(key.toWString(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    HANDLE mappingHandle = ::CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(fileHandle);
+    if (!mappingHandle)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    void* data = ::MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, size_t(size));
+    if (!data)
+    {
+        ::CloseHandle(mappingHandle);
+        return SLANG_E_CANNOT_OPEN;
+    }
+    blob->m_mappingHandle = mappingHandle;
+#else
+    const int fd = ::open(key.getBuffer(), O_RDONLY);
+    if (fd < 0)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    void* data = ::mmap(nullptr, size_t(size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+#endif
+
+    blob->m_data = (const char*)data;
+    blob->m_size = size_t(size);
+
+    if (!_isUsableAsText(blob->m_data, blob->m_size))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        // Another thread may have mapped the same file in the meantime. If so share its mapping.
+        MappedFileBlob* registeredBlob = nullptr;
+        if (registry.blobs.TryGetValue(key, registeredBlob) && registeredBlob->m_size == blob->m_size && registeredBlob->m_modifiedTime == modifiedTime)
+        {
+            outBlob = registeredBlob;
+        }
+        else
+        {
+            // Replaces any mapping of an older version of the file
+            registry.blobs[key] = blob;
+            outBlob = blobPtr;
+        }
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
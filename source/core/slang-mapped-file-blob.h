@@ -0,0 +1,63 @@
+#ifndef SLANG_CORE_MAPPED_FILE_BLOB_H
+#define SLANG_CORE_MAPPED_FILE_BLOB_H
+
+#include "slang-string.h"
+
+#include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
+
+#include <atomic>
+
+namespace Slang {
+
+/** A blob whose contents are a read only memory mapping of a file.
+
+Mappings are shared within the process: loading a file that is already mapped (and hasn't changed
+since, as judged by its size and modification time) returns the same blob. This means the contents
+of a file used by many `Linkage`s (each with its own `CacheFileSystem`) are only held once.
+
+Only files whose bytes can be used as source text as is are mapped. `File::readAllText` converts
+line endings and UTF-16 to UTF-8, so files that need such conversion are not mapped. Small files are
+also read rather than mapped, as reading them is cheaper than setting up a mapping.
+
+NOTE! The contents of a file that is modified in place while it is mapped may change. */
+class MappedFileBlob : public ISlangBlob
+{
+public:
+    // ISlangUnknown
+    SLANG_IUNKNOWN_QUERY_INTERFACE
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE { return ++m_refCount; }
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE;
+
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_size; }
+
+        /// Files smaller than this are not mapped
+    static const size_t kMinMappedSize = 64 * 1024;
+
+        /// Get a blob mapping the file at path, sharing any existing mapping of it.
+        /// Returns SLANG_E_NOT_AVAILABLE if the file should be read instead (see class description).
+    static SlangResult loadShared(const String& path, ComPtr<ISlangBlob>& outBlob);
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid);
+
+    MappedFileBlob() {}
+    virtual ~MappedFileBlob();
+
+    std::atomic<uint32_t> m_refCount = { 0 };
+
+    String m_key;                   ///< The key in the process wide map of mapped files
+    int64_t m_modifiedTime = 0;     ///< Modification time of the file when it was mapped
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_mappingHandle = nullptr;
+#endif
+};
+
+} // namespace Slang
+
+#endif // SLANG_CORE_MAPPED_FILE_BLOB_H
@@ -28,6 +28,13 @@ MemoryArena::MemoryArena(size_t blockPayloadSize, size_t blockAlignment)
     _initialize(blockPayloadSize, blockAlignment);
 }
 
+/* static */MemoryArena& MemoryArena::getThreadTemporaryArena()
+{
+    // Blocks are kept for reuse when the arena is rewound, so are only freed when the thread exits
+    static thread_local MemoryArena t_arena(64 * 1024);
+    return t_arena;
+}
+
 void MemoryArena::init(size_t blockPayloadSize, size_t blockAlignment)
 {
     reset();
@@ -138,6 +138,30 @@ public:
         /// Rewind (and effectively deallocate) all allocations *after* the cursor
     void rewindToCursor(const void* cursor);
 
+        /** Rewinds the arena on destruction to where it was on construction, so the allocations made during the scope
+        are deallocated. Scopes can be nested, but must end in the opposite order to which they began. */
+    class RewindScope
+    {
+    public:
+        RewindScope(MemoryArena& arena):
+            m_arena(arena),
+            m_cursor(arena.getCursor())
+        {
+        }
+        ~RewindScope() { m_arena.rewindToCursor(m_cursor); }
+
+    private:
+        MemoryArena& m_arena;
+        const void* m_cursor;
+    };
+
+        /** Get the arena of the calling thread for temporary allocations (such as the working state of an IR pass).
+
+        Each thread has an arena of its own, so it can be used without locking by passes running on different
+        threads. Allocations should be made within a RewindScope, so the memory is available to reuse once the
+        allocations are no longer needed. */
+    static MemoryArena& getThreadTemporaryArena();
+
         /// Default Ctor
     MemoryArena();
         /// Construct with block size and alignment. Block alignment must be a power of 2.
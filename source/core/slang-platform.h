@@ -46,6 +46,12 @@ namespace Slang
             /// @param The shared library handle as returned by loadPlatformLibrary
         static FuncPtr findFuncByName(Handle handle, char const* name);
 
+            /// Get the path of the shared library (or executable) that func is in
+            /// @param func A function in a loaded library
+            /// @param outPath Set to the path of the library
+            /// @return SLANG_OK if the path was found
+        static SlangResult getPathForFunc(FuncPtr func, String& outPath);
+
             /// Append to the end of dst, the name, with any platform specific additions
             /// The input name should be unadorned with any 'lib' prefix or extension
         static void appendPlatformFileName(const UnownedStringSlice& name, StringBuilder& dst);
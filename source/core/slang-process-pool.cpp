@@ -0,0 +1,97 @@
+// slang-process-pool.cpp
+#include "slang-process-pool.h"
+
+#include "slang-math.h"
+
+namespace Slang {
+
+ProcessTask::ProcessTask(const CommandLine& commandLine, ProcessListener* listener):
+    m_commandLine(commandLine),
+    m_listener(listener)
+{
+    m_executeResult.init();
+}
+
+bool ProcessTask::isComplete()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_isComplete;
+}
+
+SlangResult ProcessTask::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_completed.wait(lock, [this]() { return m_isComplete; });
+    return m_result;
+}
+
+void ProcessTask::execute()
+{
+    SlangResult result = SLANG_FAIL;
+    try
+    {
+        result = ProcessUtil::execute(m_commandLine, m_executeResult, m_listener);
+        if (m_listener)
+        {
+            m_listener->onComplete(result, m_executeResult);
+        }
+    }
+    catch (...)
+    {
+        // Still complete, so nothing waits forever. The thread pool rethrows the exception from `waitForAll`.
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isComplete = true;
+        }
+        m_completed.notify_all();
+        throw;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_result = result;
+        m_isComplete = true;
+    }
+    m_completed.notify_all();
+}
+
+ProcessPool::ProcessPool(Index maxProcessCount):
+    // A thread pool without threads runs jobs as they are submitted, which would make spawn wait
+    m_threadPool(Math::Max(maxProcessCount, Index(1)))
+{
+}
+
+ProcessPool::~ProcessPool()
+{
+    // The thread pool waits for the tasks when it's destroyed, but they must be alive until then
+    try
+    {
+        waitForAll();
+    }
+    catch (...)
+    {
+    }
+}
+
+RefPtr<ProcessTask> ProcessPool::spawn(const CommandLine& commandLine, ProcessListener* listener)
+{
+    RefPtr<ProcessTask> task = new ProcessTask(commandLine, listener);
+    m_tasks.add(task);
+    m_threadPool.submit(task.Ptr());
+    return task;
+}
+
+void ProcessPool::waitForAll()
+{
+    // Release the tasks even if a listener threw (List::clear doesn't destroy elements, so deallocate)
+    struct ReleaseTasks
+    {
+        ~ReleaseTasks() { tasks.clearAndDeallocate(); }
+        List<RefPtr<ProcessTask>>& tasks;
+    };
+    ReleaseTasks releaseTasks{m_tasks};
+
+    m_threadPool.waitForAll();
+}
+
+}
@@ -0,0 +1,77 @@
+// slang-process-pool.h
+#ifndef SLANG_PROCESS_POOL_H
+#define SLANG_PROCESS_POOL_H
+
+#include "slang-process-util.h"
+#include "slang-smart-pointer.h"
+#include "slang-thread-pool.h"
+
+#include <condition_variable>
+#include <mutex>
+
+namespace Slang {
+
+    /// A process spawned by a ProcessPool. The process runs asynchronously, and `wait` gives its result.
+class ProcessTask : public RefObject, public ThreadPoolJob
+{
+public:
+        /// True once the process has completed (or failed to run)
+    bool isComplete();
+        /// Wait for the process to complete. Returns the result of running it (as `ProcessUtil::execute` does).
+    SlangResult wait();
+
+        /// The output and result code of the process. Only valid once complete.
+    const ExecuteResult& getExecuteResult() const { return m_executeResult; }
+        /// The command line the process was spawned with
+    const CommandLine& getCommandLine() const { return m_commandLine; }
+
+    // ThreadPoolJob
+    virtual void execute() SLANG_OVERRIDE;
+
+        /// Ctor
+    ProcessTask(const CommandLine& commandLine, ProcessListener* listener);
+
+protected:
+    CommandLine m_commandLine;
+    ProcessListener* m_listener;
+
+    ExecuteResult m_executeResult;
+
+    std::mutex m_mutex;                             ///< Guards everything below
+    std::condition_variable m_completed;            ///< Signalled when the process completes
+    bool m_isComplete = false;
+    SlangResult m_result = SLANG_FAIL;
+};
+
+    /// Runs processes without waiting for them, with at most a maximum number running at a time. Processes are
+    /// started in the order they are spawned, and the output of each is drained as it is produced, so a process
+    /// with a lot of output never blocks on a full pipe.
+    ///
+    /// `spawn` and `waitForAll` must be called on the same thread.
+class ProcessPool
+{
+public:
+        /// Spawn a process running commandLine. It starts once fewer than the maximum number of processes are running.
+        /// If listener is set, it receives the output as it is produced, and is told when the process completes, on a
+        /// thread of the pool. The listener must stay alive until the process completes.
+    RefPtr<ProcessTask> spawn(const CommandLine& commandLine, ProcessListener* listener = nullptr);
+
+        /// Wait until every spawned process has completed
+    void waitForAll();
+
+        /// Get the maximum number of processes that run at a time
+    Index getMaxProcessCount() const { return m_threadPool.getThreadCount(); }
+
+        /// Ctor. maxProcessCount is the maximum number of processes that run at a time (at least 1).
+    explicit ProcessPool(Index maxProcessCount);
+        /// Dtor. Waits for the spawned processes to complete.
+    ~ProcessPool();
+
+protected:
+    ThreadPool m_threadPool;                        ///< Each thread runs one process at a time
+    List<RefPtr<ProcessTask>> m_tasks;              ///< Spawned since the last waitForAll. The thread pool requires they are kept alive.
+};
+
+}
+
+#endif // SLANG_PROCESS_POOL_H
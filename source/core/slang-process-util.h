@@ -78,6 +78,26 @@ struct ExecuteResult
     Slang::String standardError;
 };
 
+enum class ProcessOutputStream
+{
+    StandardOutput,
+    StandardError,
+};
+
+    /// Receives the output of a process as it is produced.
+class ProcessListener
+{
+public:
+        /// Called with each piece of output as it is read. Calls are never concurrent, but may be made
+        /// on different threads.
+    virtual void onOutput(ProcessOutputStream stream, const UnownedStringSlice& text) { SLANG_UNUSED(stream); SLANG_UNUSED(text); }
+        /// Called once the process has completed (or failed to run), with the result of running it.
+        /// Only called for processes run through a `ProcessPool`.
+    virtual void onComplete(SlangResult result, const ExecuteResult& executeResult) { SLANG_UNUSED(result); SLANG_UNUSED(executeResult); }
+
+    virtual ~ProcessListener() {}
+};
+
 struct ProcessUtil
 {
         /// Get the suffix used on this platform
@@ -86,11 +106,20 @@ struct ProcessUtil
         /// Output how the command line is executed on the target (with escaping and the such like)
     static String getCommandLineString(const CommandLine& commandLine);
 
-        /// Execute the command line 
-    static SlangResult execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult);
+        /// Execute the command line, and wait for it to complete. The output is also passed to listener (if set)
+        /// as it is produced. To run processes without waiting for them, use `ProcessPool`.
+    static SlangResult execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult, ProcessListener* listener = nullptr);
 
         /// Append text escaped for using on a command line
     static void appendCommandLineEscaped(const UnownedStringSlice& slice, StringBuilder& out);
+
+        /// Get the current value of a monotonic high resolution clock, in ticks
+    static uint64_t getClockTick();
+        /// Get the number of clock ticks per second
+    static uint64_t getClockFrequency();
+
+        /// Get the id of the current process
+    static uint64_t getProcessId();
 };
 
 // -----------------------------------------------------------------------
@@ -0,0 +1,136 @@
+// slang-ref-object-pool.cpp
+#include "slang-ref-object-pool.h"
+
+#include <stdlib.h>
+#include <new>
+
+namespace Slang {
+
+namespace { // anonymous
+
+// Every allocation is preceded by a header recording where it came from, so that
+// `deallocate` can tell pool and heap allocations apart. The header is kAlignment
+// bytes, so the object itself keeps the alignment.
+struct ObjectHeader
+{
+    RefObjectPool* pool;        ///< The pool the object was allocated from, or nullptr for the heap
+    Index sizeClass;            ///< The size class in the pool
+};
+
+static const size_t kObjectHeaderSize = RefObjectPool::kAlignment;
+SLANG_COMPILE_TIME_ASSERT(sizeof(ObjectHeader) <= kObjectHeaderSize);
+
+// Size classes with small elements have more elements per block, so every block is about 16K
+static const size_t kBlockSize = 16 * 1024;
+
+static thread_local RefObjectPool* t_currentPool = nullptr;
+static thread_local RefObjectAllocationStats t_stats;
+
+} // anonymous
+
+RefObjectPool::RefObjectPool()
+{
+    for (Index i = 0; i < kSizeClassCount; ++i)
+    {
+        const size_t elementSize = kObjectHeaderSize + size_t(i + 1) * kSizeClassGranularity;
+        m_freeLists[i].init(elementSize, kAlignment, kBlockSize / elementSize);
+    }
+}
+
+Index RefObjectPool::calcBlockCount() const
+{
+    Index count = 0;
+    for (const auto& freeList : m_freeLists)
+    {
+        count += freeList.calcBlockCount();
+    }
+    return count;
+}
+
+size_t RefObjectPool::calcTotalMemoryUsed() const
+{
+    size_t total = 0;
+    for (const auto& freeList : m_freeLists)
+    {
+        total += size_t(freeList.calcBlockCount()) * freeList.getBlockSize();
+    }
+    return total;
+}
+
+/* static */RefObjectPool* RefObjectPool::getCurrent()
+{
+    return t_currentPool;
+}
+
+RefObjectPoolScope::RefObjectPoolScope(RefObjectPool* pool)
+{
+    m_previousPool = t_currentPool;
+    t_currentPool = pool;
+}
+
+RefObjectPoolScope::~RefObjectPoolScope()
+{
+    t_currentPool = m_previousPool;
+}
+
+/* static */const RefObjectAllocationStats& RefObjectAllocationStats::getForThread()
+{
+    return t_stats;
+}
+
+/* static */void* RefObjectPoolAllocator::allocate(size_t sizeInBytes)
+{
+    RefObjectPool* pool = SLANG_ENABLE_REF_OBJECT_POOL ? t_currentPool : nullptr;
+    if (sizeInBytes > RefObjectPool::kMaxPooledSize)
+    {
+        pool = nullptr;
+    }
+
+    ObjectHeader* header;
+    Index sizeClass = 0;
+    if (pool)
+    {
+        sizeClass = Index((sizeInBytes + RefObjectPool::kSizeClassGranularity - 1) / RefObjectPool::kSizeClassGranularity) - 1;
+        sizeClass = (sizeClass < 0) ? 0 : sizeClass;
+
+        header = (ObjectHeader*)pool->allocate(sizeClass);
+        // Released when the object is freed
+        pool->addReference();
+        t_stats.pooledCount++;
+    }
+    else
+    {
+        header = (ObjectHeader*)::malloc(kObjectHeaderSize + sizeInBytes);
+        t_stats.heapCount++;
+    }
+    if (!header)
+    {
+        throw std::bad_alloc();
+    }
+
+    header->pool = pool;
+    header->sizeClass = sizeClass;
+    return (char*)header + kObjectHeaderSize;
+}
+
+/* static */void RefObjectPoolAllocator::deallocate(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    ObjectHeader* header = (ObjectHeader*)((char*)ptr - kObjectHeaderSize);
+    if (RefObjectPool* pool = header->pool)
+    {
+        pool->deallocate(header, header->sizeClass);
+        // May destroy the pool, so must be last
+        pool->releaseReference();
+    }
+    else
+    {
+        ::free(header);
+    }
+}
+
+} // namespace Slang
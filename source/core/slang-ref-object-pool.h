@@ -0,0 +1,97 @@
+// slang-ref-object-pool.h
+#ifndef SLANG_CORE_REF_OBJECT_POOL_H
+#define SLANG_CORE_REF_OBJECT_POOL_H
+
+#include "slang-smart-pointer.h"
+#include "slang-free-list.h"
+
+// Set to 0 to allocate every pooled object from the heap (for comparing against the pools)
+#ifndef SLANG_ENABLE_REF_OBJECT_POOL
+#   define SLANG_ENABLE_REF_OBJECT_POOL 1
+#endif
+
+namespace Slang {
+
+    /// Memory for small `RefObject` derived objects that are created and destroyed in large
+    /// numbers, such as type layouts and the pseudo-types and values used in legalization.
+    ///
+    /// Allocations are rounded up to a size class, and each size class is a `FreeList`, so
+    /// freed memory is reused by later objects of a similar size without going to the heap.
+    /// A type opts in with `SLANG_REF_OBJECT_POOL_ALLOCATED`, and is then allocated from the
+    /// pool that is current on the thread (see `RefObjectPoolScope`), or from the heap if there
+    /// is none or it is too large for any size class.
+    ///
+    /// Every pooled object holds a reference to its pool, so the pool outlives its objects.
+    /// A pool is not thread safe: objects from a pool must be created and freed on one thread at a time.
+class RefObjectPool : public RefObject
+{
+public:
+        /// Allocated memory is at least this aligned
+    static const size_t kAlignment = 16;
+        /// Size classes are multiples of this
+    static const size_t kSizeClassGranularity = 16;
+        /// Larger objects are always allocated from the heap
+    static const size_t kMaxPooledSize = 512;
+    static const Index kSizeClassCount = Index(kMaxPooledSize / kSizeClassGranularity);
+
+        /// Allocate an element of a size class, which holds (sizeClass + 1) * kSizeClassGranularity bytes
+        /// after a kAlignment sized header. Returns nullptr if out of memory.
+    void* allocate(Index sizeClass) { m_liveCount++; return m_freeLists[sizeClass].allocate(); }
+        /// Free an element allocated with `allocate` with the same sizeClass
+    void deallocate(void* ptr, Index sizeClass) { m_liveCount--; m_freeLists[sizeClass].deallocateUnchecked(ptr); }
+
+        /// The number of allocations that haven't been freed
+    Index getLiveCount() const { return m_liveCount; }
+        /// The number of blocks the size classes have allocated from the heap
+    Index calcBlockCount() const;
+        /// The total size of the blocks in bytes
+    size_t calcTotalMemoryUsed() const;
+
+        /// Get the pool objects are allocated from on this thread, or nullptr if they are allocated from the heap
+    static RefObjectPool* getCurrent();
+
+        /// Ctor
+    RefObjectPool();
+
+protected:
+    FreeList m_freeLists[kSizeClassCount];
+    Index m_liveCount = 0;
+};
+
+    /// Sets the pool objects created on this thread are allocated from, for the lifetime of the scope.
+    /// Passing nullptr allocates objects from the heap.
+struct RefObjectPoolScope
+{
+    RefObjectPoolScope(RefObjectPool* pool);
+    ~RefObjectPoolScope();
+
+protected:
+    RefObjectPool* m_previousPool;
+};
+
+    /// Counts of allocations of pool allocated types made on the current thread.
+struct RefObjectAllocationStats
+{
+    Int pooledCount = 0;            ///< The number of objects allocated from a pool
+    Int heapCount = 0;              ///< The number of objects allocated from the heap
+
+        /// Get the stats for the current thread
+    static const RefObjectAllocationStats& getForThread();
+};
+
+    /// Implements the allocation of pool allocated types (used by `SLANG_REF_OBJECT_POOL_ALLOCATED`)
+struct RefObjectPoolAllocator
+{
+    static void* allocate(size_t sizeInBytes);
+    static void deallocate(void* ptr);
+};
+
+} // namespace Slang
+
+    /// Placed in the body of a `RefObject` derived type (usually the base of a hierarchy)
+    /// to allocate it, and the types derived from it, from the current `RefObjectPool`.
+#define SLANG_REF_OBJECT_POOL_ALLOCATED \
+    static void* operator new(size_t size) { return ::Slang::RefObjectPoolAllocator::allocate(size); } \
+    static void operator delete(void* ptr) { ::Slang::RefObjectPoolAllocator::deallocate(ptr); }
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef SLANG_CORE_SHORT_LIST_H
+#define SLANG_CORE_SHORT_LIST_H
+
+#include "slang-list.h"
+
+namespace Slang
+{
+
+    /// A list that holds up to COUNT elements without allocating, and moves its elements
+    /// to the heap if it grows larger.
+    ///
+    /// Intended for the many short lists (of operands, arguments and so on) that are built
+    /// temporarily, usually on the stack. Like `List` every element up to the capacity is
+    /// constructed, so T must be default constructible. The elements are always contiguous.
+template<typename T, Index COUNT>
+class ShortList
+{
+public:
+    typedef ShortList ThisType;
+
+    static_assert(COUNT > 0, "ShortList must hold at least one element without allocating");
+
+    T* begin() const { return m_buffer; }
+    T* end() const { return m_buffer + m_count; }
+
+    Index getCount() const { return m_count; }
+    Index getCapacity() const { return m_capacity; }
+
+    const T* getBuffer() const { return m_buffer; }
+    T* getBuffer() { return m_buffer; }
+
+        /// True if the elements are held in the list itself, rather than on the heap
+    bool isShort() const { return m_buffer == m_shortBuffer; }
+
+    const T& getFirst() const { SLANG_ASSERT(m_count > 0); return m_buffer[0]; }
+    T& getFirst() { SLANG_ASSERT(m_count > 0); return m_buffer[0]; }
+    const T& getLast() const { SLANG_ASSERT(m_count > 0); return m_buffer[m_count - 1]; }
+    T& getLast() { SLANG_ASSERT(m_count > 0); return m_buffer[m_count - 1]; }
+
+    SLANG_FORCE_INLINE T& operator[](Index idx) const
+    {
+        SLANG_ASSERT(idx >= 0 && idx < m_count);
+        return m_buffer[idx];
+    }
+
+    ArrayView<T> getArrayView() const { return ArrayView<T>(m_buffer, int(m_count)); }
+
+    void add(const T& obj)
+    {
+        if (m_count >= m_capacity)
+        {
+            // obj may be an element of this list, so copy it before the elements move
+            T copy(obj);
+            reserve(m_capacity * 2);
+            m_buffer[m_count++] = _Move(copy);
+            return;
+        }
+        m_buffer[m_count++] = obj;
+    }
+    void add(T&& obj)
+    {
+        if (m_count >= m_capacity)
+        {
+            reserve(m_capacity * 2);
+        }
+        m_buffer[m_count++] = _Move(obj);
+    }
+
+    void addRange(const T* vals, Index n)
+    {
+        reserve(m_count + n);
+        for (Index i = 0; i < n; ++i)
+        {
+            m_buffer[m_count + i] = vals[i];
+        }
+        m_count += n;
+    }
+    void addRange(ArrayView<T> view) { addRange(view.getBuffer(), view.getCount()); }
+
+    void removeLast() { SLANG_ASSERT(m_count > 0); m_count--; }
+
+        /// Set the count to 0. As with `List::clear` the elements aren't destroyed until they are overwritten,
+        /// and heap memory is kept.
+    void clear() { m_count = 0; }
+
+    void setCount(Index count)
+    {
+        reserve(count);
+        m_count = count;
+    }
+
+        /// Make sure the list can hold at least capacity elements without allocating again
+    void reserve(Index capacity)
+    {
+        if (capacity <= m_capacity)
+        {
+            return;
+        }
+
+        T* newBuffer = new T[capacity];
+        // Elements are moved, so reference counted elements keep their counts
+        for (Index i = 0; i < m_count; ++i)
+        {
+            newBuffer[i] = _Move(m_buffer[i]);
+        }
+        _deallocateBuffer();
+        m_buffer = newBuffer;
+        m_capacity = capacity;
+    }
+
+    template<typename T2>
+    Index indexOf(const T2& val) const
+    {
+        for (Index i = 0; i < m_count; ++i)
+        {
+            if (m_buffer[i] == val)
+                return i;
+        }
+        return -1;
+    }
+    bool contains(const T& val) const { return indexOf(val) >= 0; }
+
+        /// Copy the elements into a List
+    List<T> toList() const
+    {
+        List<T> list;
+        list.addRange(m_buffer, m_count);
+        return list;
+    }
+
+    ShortList() {}
+    ShortList(const ThisType& rhs) { addRange(rhs.m_buffer, rhs.m_count); }
+    ShortList(ThisType&& rhs) { _moveFrom(rhs); }
+    ~ShortList() { _deallocateBuffer(); }
+
+    ThisType& operator=(const ThisType& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            addRange(rhs.m_buffer, rhs.m_count);
+        }
+        return *this;
+    }
+    ThisType& operator=(ThisType&& rhs)
+    {
+        if (this != &rhs)
+        {
+            clear();
+            _moveFrom(rhs);
+        }
+        return *this;
+    }
+
+protected:
+    void _deallocateBuffer()
+    {
+        if (m_buffer != m_shortBuffer)
+        {
+            delete[] m_buffer;
+        }
+    }
+
+        /// Take the elements of rhs, leaving it empty. This list must be empty.
+    void _moveFrom(ThisType& rhs)
+    {
+        SLANG_ASSERT(m_count == 0);
+        if (rhs.isShort())
+        {
+            // This list's buffer (short or not) holds at least COUNT elements
+            for (Index i = 0; i < rhs.m_count; ++i)
+            {
+                m_buffer[i] = _Move(rhs.m_buffer[i]);
+            }
+        }
+        else
+        {
+            // Take the heap buffer
+            _deallocateBuffer();
+            m_buffer = rhs.m_buffer;
+            m_capacity = rhs.m_capacity;
+
+            rhs.m_buffer = rhs.m_shortBuffer;
+            rhs.m_capacity = COUNT;
+        }
+        m_count = rhs.m_count;
+        rhs.m_count = 0;
+    }
+
+    T* m_buffer = m_shortBuffer;        ///< Points to m_shortBuffer, or a new T[m_capacity] allocated buffer
+    Index m_count = 0;
+    Index m_capacity = COUNT;
+    T m_shortBuffer[COUNT];
+};
+
+}
+
+#endif
@@ -0,0 +1,194 @@
+#include "slang-source-map.h"
+
+#include "slang-byte-encode-util.h"
+
+namespace Slang {
+
+uint32_t SourceMap::addFile(const String& path)
+{
+    if (const uint32_t* indexPtr = m_fileIndices.TryGetValue(path))
+    {
+        return *indexPtr;
+    }
+    const uint32_t index = uint32_t(m_files.getCount());
+    m_files.add(path);
+    m_fileIndices.Add(path, index);
+    return index;
+}
+
+void SourceMap::offsetGeneratedLines(uint32_t lineCount)
+{
+    for (auto& entry : m_entries)
+    {
+        entry.generatedLine += lineCount;
+    }
+}
+
+SlangResult SourceMap::find(uint32_t generatedLine, uint32_t generatedColumn, Entry& outEntry) const
+{
+    // Find the last entry at or before the position
+    Index lo = 0;
+    Index hi = m_entries.getCount();
+    while (lo < hi)
+    {
+        const Index mid = (lo + hi) / 2;
+        const Entry& entry = m_entries[mid];
+        if (entry.generatedLine < generatedLine || (entry.generatedLine == generatedLine && entry.generatedColumn <= generatedColumn))
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    if (lo == 0)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    const Entry& entry = m_entries[lo - 1];
+    outEntry = entry;
+    outEntry.generatedLine = generatedLine;
+    outEntry.generatedColumn = generatedColumn;
+    if (generatedLine != entry.generatedLine)
+    {
+        outEntry.line = entry.line + (generatedLine - entry.generatedLine);
+        outEntry.column = 0;
+    }
+    return SLANG_OK;
+}
+
+void SourceMap::clear()
+{
+    m_files.clear();
+    m_fileIndices.Clear();
+    m_entries.clear();
+}
+
+static void _writeBytes(const void* data, size_t size, List<uint8_t>& out)
+{
+    out.addRange((const uint8_t*)data, Index(size));
+}
+
+static void _writeLite(uint32_t value, List<uint8_t>& out)
+{
+    uint8_t encoded[ByteEncodeUtil::kMaxLiteEncodeUInt32];
+    const int size = ByteEncodeUtil::encodeLiteUInt32(value, encoded);
+    out.addRange(encoded, size);
+}
+
+void SourceMap::write(List<uint8_t>& out) const
+{
+    out.clear();
+
+    Header header;
+    header.m_fourCc = kFourCc;
+    header.m_version = kVersion;
+    header.m_fileCount = uint32_t(m_files.getCount());
+    header.m_entryCount = uint32_t(m_entries.getCount());
+    _writeBytes(&header, sizeof(header), out);
+
+    for (const auto& path : m_files)
+    {
+        const uint32_t size = uint32_t(path.getLength());
+        _writeBytes(&size, sizeof(size), out);
+        _writeBytes(path.getBuffer(), size, out);
+    }
+
+    uint32_t previousLine = 0;
+    for (const auto& entry : m_entries)
+    {
+        _writeLite(entry.generatedLine - previousLine, out);
+        _writeLite(entry.generatedColumn, out);
+        _writeLite(entry.fileIndex, out);
+        _writeLite(entry.line, out);
+        _writeLite(entry.column, out);
+        previousLine = entry.generatedLine;
+    }
+}
+
+SlangResult SourceMap::read(const void* data, size_t size)
+{
+    clear();
+
+    const uint8_t* cur = (const uint8_t*)data;
+    const uint8_t* end = cur + size;
+
+    Header header;
+    if (size < sizeof(header))
+    {
+        return SLANG_FAIL;
+    }
+    ::memcpy(&header, cur, sizeof(header));
+    cur += sizeof(header);
+    if (header.m_fourCc != kFourCc || header.m_version != kVersion)
+    {
+        return SLANG_FAIL;
+    }
+
+    for (uint32_t i = 0; i < header.m_fileCount; ++i)
+    {
+        uint32_t pathSize;
+        if (size_t(end - cur) < sizeof(pathSize))
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(&pathSize, cur, sizeof(pathSize));
+        cur += sizeof(pathSize);
+        if (size_t(end - cur) < pathSize)
+        {
+            return SLANG_FAIL;
+        }
+        addFile(String((const char*)cur, (const char*)cur + pathSize));
+        cur += pathSize;
+    }
+
+    // The decoder may read past the end of a value, so the entries are decoded from a padded copy
+    List<uint8_t> encoded;
+    encoded.addRange(cur, Index(end - cur));
+    const Index encodedSize = encoded.getCount();
+    for (int i = 0; i < ByteEncodeUtil::kMaxLiteEncodeUInt32; ++i)
+    {
+        encoded.add(0);
+    }
+
+    // Every entry takes at least a byte per value
+    if (header.m_entryCount > uint32_t(encodedSize / 5))
+    {
+        clear();
+        return SLANG_FAIL;
+    }
+
+    Index offset = 0;
+    uint32_t previousLine = 0;
+    m_entries.setCount(Index(header.m_entryCount));
+    for (auto& entry : m_entries)
+    {
+        uint32_t values[5];
+        for (auto& value : values)
+        {
+            if (offset >= encodedSize)
+            {
+                clear();
+                return SLANG_FAIL;
+            }
+            offset += ByteEncodeUtil::decodeLiteUInt32(encoded.getBuffer() + offset, &value);
+        }
+        if (offset > encodedSize || values[2] >= header.m_fileCount)
+        {
+            clear();
+            return SLANG_FAIL;
+        }
+
+        entry.generatedLine = previousLine + values[0];
+        entry.generatedColumn = values[1];
+        entry.fileIndex = values[2];
+        entry.line = values[3];
+        entry.column = values[4];
+        previousLine = entry.generatedLine;
+    }
+    return SLANG_OK;
+}
+
+} // namespace Slang
@@ -0,0 +1,84 @@
+#ifndef SLANG_CORE_SOURCE_MAP_H
+#define SLANG_CORE_SOURCE_MAP_H
+
+#include "slang-list.h"
+#include "slang-string.h"
+#include "slang-dictionary.h"
+
+#ifndef SLANG_FOUR_CC
+#define SLANG_FOUR_CC(c0, c1, c2, c3) ((uint32_t(c0) << 0) | (uint32_t(c1) << 8) | (uint32_t(c2) << 16) | (uint32_t(c3) << 24))
+#endif
+
+namespace Slang {
+
+    /// Maps positions in generated source back to the source it was generated from.
+    ///
+    /// Each entry marks where the code generated for a position in a source file starts. As with a `#line`
+    /// directive, the generated lines that follow an entry (up to the next entry) map to the source lines that
+    /// follow the entry's line. Lines and columns are 1 based.
+    ///
+    /// The binary layout (little endian) is
+    /// * Header - SourceMap::Header
+    /// * File paths - for each file a uint32_t byte count, followed by the UTF-8 path (not zero terminated)
+    /// * Entries - for each entry, in order of generated position, five values encoded with
+    ///   `ByteEncodeUtil::encodeLiteUInt32`: the generated line (as the difference from the generated line of the
+    ///   previous entry), the generated column, the file index, the source line and the source column
+class SourceMap
+{
+public:
+    struct Entry
+    {
+        uint32_t generatedLine;
+        uint32_t generatedColumn;
+        uint32_t fileIndex;
+        uint32_t line;
+        uint32_t column;            ///< 0 if not known
+    };
+
+    struct Header
+    {
+        uint32_t m_fourCc;
+        uint32_t m_version;
+        uint32_t m_fileCount;
+        uint32_t m_entryCount;
+    };
+
+    static const uint32_t kFourCc = SLANG_FOUR_CC('S', 'L', 's', 'm');
+        /// Increment if the layout changes
+    static const uint32_t kVersion = 1;
+
+        /// Get the index of the file at path, adding it if it isn't in the map yet
+    uint32_t addFile(const String& path);
+        /// Add an entry. Entries must be added in order of generated position.
+    void addEntry(const Entry& entry) { m_entries.add(entry); }
+
+        /// Add lineCount to the generated line of every entry (for when text is placed before the generated source)
+    void offsetGeneratedLines(uint32_t lineCount);
+
+        /// Find the source position the generated position was generated from. The column is only known (non 0)
+        /// when the generated line is the line of an entry. Returns SLANG_E_NOT_FOUND if the position precedes
+        /// all entries.
+    SlangResult find(uint32_t generatedLine, uint32_t generatedColumn, Entry& outEntry) const;
+
+    Index getFileCount() const { return m_files.getCount(); }
+    const String& getFilePath(Index index) const { return m_files[index]; }
+    Index getEntryCount() const { return m_entries.getCount(); }
+    const Entry& getEntry(Index index) const { return m_entries[index]; }
+
+        /// Remove all the files and entries
+    void clear();
+
+        /// Write the map in the binary layout, replacing the contents of out
+    void write(List<uint8_t>& out) const;
+        /// Read a map in the binary layout, replacing the contents of this map. Fails if data isn't a valid map.
+    SlangResult read(const void* data, size_t size);
+
+protected:
+    List<String> m_files;
+    Dictionary<String, uint32_t> m_fileIndices;
+    List<Entry> m_entries;
+};
+
+} // namespace Slang
+
+#endif
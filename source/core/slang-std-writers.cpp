@@ -4,7 +4,7 @@
 namespace Slang
 {
 
-/* static */StdWriters* StdWriters::s_singleton = nullptr;
+/* static */thread_local StdWriters* StdWriters::s_singleton = nullptr;
 
 /* static */RefPtr<StdWriters> StdWriters::createDefault()
 {
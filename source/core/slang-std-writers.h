@@ -25,6 +25,8 @@ public:
     static RefPtr<StdWriters> createDefault();
     static RefPtr<StdWriters> initDefaultSingleton();
 
+        /// The singleton is per thread, as tools run in process (such as by slang-test) set it for the duration of a run.
+        /// A new thread starts without one, so must set it before using getError etc.
     static StdWriters* getSingleton() { return s_singleton; }
     static void setSingleton(StdWriters* context) { s_singleton = context;  }
 
@@ -36,7 +38,7 @@ protected:
 
     ComPtr<ISlangWriter> m_writers[SLANG_WRITER_CHANNEL_COUNT_OF]; 
     
-    static StdWriters* s_singleton;
+    static thread_local StdWriters* s_singleton;
 };
 
 }
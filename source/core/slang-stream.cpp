@@ -266,7 +266,7 @@ namespace Slang
 
         ::memcpy(buffer, m_contents.begin() + m_position, size_t(length));
         m_position += UInt(length);
-        return maxRead;
+        return length;
     }
     
     Int64 MemoryStream::Write(const void * buffer, Int64 length)
@@ -276,18 +276,264 @@ namespace Slang
             throw IOException("Cannot write this stream.");
         }
 
-        if (m_position == m_contents.getCount())
+        // Overwrite any contents after the position, and append the rest
+        const Index remaining = m_contents.getCount() - m_position;
+        const Index overwriteCount = (Index(length) < remaining) ? Index(length) : remaining;
+
+        ::memcpy(m_contents.begin() + m_position, buffer, size_t(overwriteCount));
+        m_contents.addRange((const uint8_t*)buffer + overwriteCount, UInt(Index(length) - overwriteCount));
+
+        m_atEnd = false;
+
+        m_position += UInt(length);
+        return length;
+    }
+
+    const void* MemoryStream::readView(Int64 size)
+    {
+        if (!CanRead() || size < 0 || size > Int64(m_contents.getCount() - m_position))
         {
-            m_contents.addRange((const uint8_t*)buffer, UInt(length));
+            return nullptr;
         }
-        else
+        const void* view = m_contents.begin() + m_position;
+        m_position += UInt(size);
+        return view;
+    }
+
+    // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! BlobStream !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    BlobStream::BlobStream(ISlangBlob* blob) :
+        m_blob(blob)
+    {
+        if (blob)
         {
-            m_contents.insertRange(m_position, (const uint8_t*)buffer, UInt(length));
+            m_data = (const uint8_t*)blob->getBufferPointer();
+            m_size = blob->getBufferSize();
+        }
+    }
+
+    BlobStream::BlobStream(const void* data, size_t size) :
+        m_data((const uint8_t*)data),
+        m_size(size)
+    {
+    }
+
+    void BlobStream::Seek(SeekOrigin origin, Int64 offset)
+    {
+        Int64 pos = 0;
+        switch (origin)
+        {
+        case Slang::SeekOrigin::Start:
+            pos = offset;
+            break;
+        case Slang::SeekOrigin::End:
+            pos = Int64(m_size) + offset;
+            break;
+        case Slang::SeekOrigin::Current:
+            pos = Int64(m_position) + offset;
+            break;
+        default:
+            throw NotSupportedException("Unsupported seek origin.");
+            break;
         }
 
         m_atEnd = false;
 
-        m_position += UInt(length);
+        // Clamp to the valid range
+        pos = (pos < 0) ? 0 : pos;
+        pos = (pos > Int64(m_size)) ? Int64(m_size) : pos;
+
+        m_position = size_t(pos);
+    }
+
+    Int64 BlobStream::Read(void* buffer, Int64 length)
+    {
+        if (!CanRead())
+        {
+            throw IOException("Cannot read this stream.");
+        }
+
+        const Int64 maxRead = Int64(m_size - m_position);
+        if (maxRead == 0 && length > 0)
+        {
+            m_atEnd = true;
+            throw EndOfStreamException("End of file is reached.");
+        }
+
+        length = length > maxRead ? maxRead : length;
+
+        ::memcpy(buffer, m_data + m_position, size_t(length));
+        m_position += size_t(length);
+        return length;
+    }
+
+    Int64 BlobStream::Write(const void* buffer, Int64 length)
+    {
+        SLANG_UNUSED(buffer);
+        SLANG_UNUSED(length);
+        throw IOException("Cannot write this stream.");
+    }
+
+    void BlobStream::Close()
+    {
+        m_blob.setNull();
+        m_data = nullptr;
+        m_size = 0;
+        m_position = 0;
+    }
+
+    const void* BlobStream::readView(Int64 size)
+    {
+        if (!CanRead() || size < 0 || size > Int64(m_size - m_position))
+        {
+            return nullptr;
+        }
+        const void* view = m_data + m_position;
+        m_position += size_t(size);
+        return view;
+    }
+
+    // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! BufferedStream !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+    BufferedStream::BufferedStream(Stream* stream, size_t bufferSize) :
+        m_stream(stream)
+    {
+        SLANG_ASSERT(stream && bufferSize > 0);
+        m_buffer.setCount(Index(bufferSize));
+    }
+
+    BufferedStream::~BufferedStream()
+    {
+        // Can't throw from a dtor, so to see write failures flush or close explicitly
+        try
+        {
+            flush();
+        }
+        catch (const IOException&)
+        {
+        }
+    }
+
+    void BufferedStream::flush()
+    {
+        if (m_writeCount > 0)
+        {
+            // Reset first, so a failed write isn't attempted again
+            const Index writeCount = m_writeCount;
+            m_writeCount = 0;
+            m_stream->Write(m_buffer.getBuffer(), Int64(writeCount));
+        }
+    }
+
+    void BufferedStream::_discardReads()
+    {
+        const Index unreadCount = m_readEnd - m_readStart;
+        m_readStart = 0;
+        m_readEnd = 0;
+        if (unreadCount > 0)
+        {
+            m_stream->Seek(SeekOrigin::Current, -Int64(unreadCount));
+        }
+    }
+
+    Int64 BufferedStream::GetPosition()
+    {
+        return m_stream->GetPosition() + Int64(m_writeCount) - Int64(m_readEnd - m_readStart);
+    }
+
+    void BufferedStream::Seek(SeekOrigin origin, Int64 offset)
+    {
+        flush();
+        _discardReads();
+        m_stream->Seek(origin, offset);
+    }
+
+    bool BufferedStream::IsEnd()
+    {
+        return (m_readEnd == m_readStart) && m_stream->IsEnd();
+    }
+
+    void BufferedStream::Close()
+    {
+        flush();
+        m_readStart = 0;
+        m_readEnd = 0;
+        m_stream->Close();
+    }
+
+    Int64 BufferedStream::Read(void* buffer, Int64 length)
+    {
+        flush();
+
+        uint8_t* dst = (uint8_t*)buffer;
+        Int64 readCount = 0;
+
+        while (readCount < length)
+        {
+            const Index bufferedCount = m_readEnd - m_readStart;
+            if (bufferedCount > 0)
+            {
+                const Index count = (length - readCount < Int64(bufferedCount)) ? Index(length - readCount) : bufferedCount;
+                ::memcpy(dst + readCount, m_buffer.getBuffer() + m_readStart, size_t(count));
+                m_readStart += count;
+                readCount += count;
+                continue;
+            }
+
+            try
+            {
+                const Int64 remaining = length - readCount;
+                if (remaining >= Int64(m_buffer.getCount()))
+                {
+                    // Large reads go straight to the stream
+                    const Int64 count = m_stream->Read(dst + readCount, remaining);
+                    if (count <= 0)
+                    {
+                        break;
+                    }
+                    readCount += count;
+                }
+                else
+                {
+                    const Int64 count = m_stream->Read(m_buffer.getBuffer(), Int64(m_buffer.getCount()));
+                    if (count <= 0)
+                    {
+                        break;
+                    }
+                    m_readStart = 0;
+                    m_readEnd = Index(count);
+                }
+            }
+            catch (const EndOfStreamException&)
+            {
+                // Only report the end if nothing could be read
+                if (readCount == 0)
+                {
+                    throw;
+                }
+                break;
+            }
+        }
+        return readCount;
+    }
+
+    Int64 BufferedStream::Write(const void* buffer, Int64 length)
+    {
+        _discardReads();
+
+        if (Int64(m_writeCount) + length > Int64(m_buffer.getCount()))
+        {
+            flush();
+        }
+
+        if (length >= Int64(m_buffer.getCount()))
+        {
+            // Large writes go straight to the stream
+            return m_stream->Write(buffer, length);
+        }
+
+        ::memcpy(m_buffer.getBuffer() + m_writeCount, buffer, size_t(length));
+        m_writeCount += Index(length);
         return length;
     }
 
@@ -3,6 +3,8 @@
 
 #include "slang-basic.h"
 
+#include "../../slang-com-ptr.h"
+
 namespace Slang
 {
 	class IOException : public Exception
@@ -44,6 +46,13 @@ namespace Slang
 		virtual bool CanRead() = 0;
 		virtual bool CanWrite() = 0;
 		virtual void Close() = 0;
+
+            /// Get a view of the next size bytes, and move past them, without copying. The view is valid until the
+            /// stream is written to or destroyed. Returns nullptr (and doesn't move) if the stream can't provide views,
+            /// or there are less than size bytes remaining.
+        virtual const void* readView(Int64 size) { SLANG_UNUSED(size); return nullptr; }
+            /// True if the contents are held in memory, so small reads and writes are cheap and don't need buffering
+        virtual bool isInMemory() { return false; }
 	};
 
 	enum class FileMode
@@ -72,6 +81,8 @@ namespace Slang
         virtual bool CanRead() SLANG_OVERRIDE { return (int(m_access) & int(FileAccess::Read)) != 0;  }
         virtual bool CanWrite() SLANG_OVERRIDE { return (int(m_access) & int(FileAccess::Write)) != 0; }
         virtual void Close() SLANG_OVERRIDE { m_access = FileAccess::None;  }
+        virtual const void* readView(Int64 size) SLANG_OVERRIDE;
+        virtual bool isInMemory() SLANG_OVERRIDE { return true; }
 
         MemoryStream(FileAccess access) :
             m_access(access),
@@ -87,6 +98,78 @@ namespace Slang
         List<uint8_t> m_contents;
     };
 
+        /// A read only stream of the contents of a blob (or memory owned by someone else), which can
+        /// hand out views of the contents (see `readView`) without copying.
+    class BlobStream : public Stream
+    {
+    public:
+        virtual Int64 GetPosition() SLANG_OVERRIDE { return Int64(m_position); }
+        virtual void Seek(SeekOrigin origin, Int64 offset) SLANG_OVERRIDE;
+        virtual Int64 Read(void* buffer, Int64 length) SLANG_OVERRIDE;
+        virtual Int64 Write(const void* buffer, Int64 length) SLANG_OVERRIDE;
+        virtual bool IsEnd() SLANG_OVERRIDE { return m_atEnd; }
+        virtual bool CanRead() SLANG_OVERRIDE { return m_data != nullptr; }
+        virtual bool CanWrite() SLANG_OVERRIDE { return false; }
+        virtual void Close() SLANG_OVERRIDE;
+        virtual const void* readView(Int64 size) SLANG_OVERRIDE;
+        virtual bool isInMemory() SLANG_OVERRIDE { return true; }
+
+            /// Get the blob the contents are from. Can be nullptr if the contents are owned by someone else.
+        ISlangBlob* getBlob() const { return m_blob; }
+
+            /// Ctor. The stream holds a reference to the blob, so views remain valid as long as the stream does.
+        explicit BlobStream(ISlangBlob* blob);
+            /// Ctor. The memory must remain valid for as long as the stream (and any views) are used.
+        BlobStream(const void* data, size_t size);
+
+    protected:
+        ComPtr<ISlangBlob> m_blob;
+        const uint8_t* m_data = nullptr;
+        size_t m_size = 0;
+        size_t m_position = 0;
+        bool m_atEnd = false;           ///< Happens when a read is done and nothing can be returned because already at end
+    };
+
+        /// Buffers the reads and writes of another stream, so that many small reads or writes (such as the
+        /// headers of serialized chunks) become a few large ones. Reads or writes at least as large as the buffer
+        /// go straight to the stream.
+        ///
+        /// Writes are only guaranteed to have reached the stream after `flush`, `Seek` or `Close` (or when the
+        /// buffered stream is destroyed). The stream must outlive the buffered stream.
+    class BufferedStream : public Stream
+    {
+    public:
+        virtual Int64 GetPosition() SLANG_OVERRIDE;
+        virtual void Seek(SeekOrigin origin, Int64 offset) SLANG_OVERRIDE;
+        virtual Int64 Read(void* buffer, Int64 length) SLANG_OVERRIDE;
+        virtual Int64 Write(const void* buffer, Int64 length) SLANG_OVERRIDE;
+        virtual bool IsEnd() SLANG_OVERRIDE;
+        virtual bool CanRead() SLANG_OVERRIDE { return m_stream->CanRead(); }
+        virtual bool CanWrite() SLANG_OVERRIDE { return m_stream->CanWrite(); }
+            /// Flushes, and closes the stream
+        virtual void Close() SLANG_OVERRIDE;
+
+            /// Write any buffered writes to the stream
+        void flush();
+
+        static const size_t kDefaultBufferSize = 64 * 1024;
+
+            /// Ctor. stream must outlive the buffered stream.
+        BufferedStream(Stream* stream, size_t bufferSize = kDefaultBufferSize);
+            /// Dtor. Flushes any buffered writes.
+        ~BufferedStream();
+
+    protected:
+            /// Give up any buffered reads, moving the stream back to the position of the next unread byte
+        void _discardReads();
+
+        Stream* m_stream;
+        List<uint8_t> m_buffer;
+        Index m_writeCount = 0;         ///< The number of buffered bytes to write
+        Index m_readStart = 0;          ///< The index of the next unread byte of buffered reads
+        Index m_readEnd = 0;            ///< The end of buffered reads
+    };
+
 	class FileStream : public Stream
 	{
 	private:
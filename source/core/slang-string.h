@@ -802,7 +802,7 @@ namespace Slang
 
 		int GetHashCode() const
 		{
-			return Slang::GetHashCode((const char*)begin());
+			return Slang::GetHashCode(begin(), size_t(getLength()));
 		}
 
         UnownedStringSlice getUnownedSlice() const
@@ -813,10 +813,13 @@ namespace Slang
 
 	class StringBuilder : public String
 	{
-	private:
-        enum { InitialSize = 1024 };
 	public:
-		explicit StringBuilder(UInt bufferSize = InitialSize)
+            /// Storage is allocated on first append (and grows by doubling), so building a short
+            /// string doesn't allocate (and then hold onto) a large buffer
+		StringBuilder()
+		{
+		}
+		explicit StringBuilder(UInt bufferSize)
 		{
             ensureUniqueStorageWithCapacity(bufferSize);
 		}
@@ -0,0 +1,134 @@
+// slang-thread-pool.cpp
+#include "slang-thread-pool.h"
+
+namespace Slang {
+
+ThreadPool::ThreadPool(Index threadCount)
+{
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        m_threads.add(std::thread(&ThreadPool::_workerMain, this));
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobCompleted.wait(lock, [this]() { return m_completedJobCount == m_jobs.getCount(); });
+        m_isShuttingDown = true;
+    }
+    m_jobAvailable.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+/* static */Index ThreadPool::getDefaultThreadCount()
+{
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count ? Index(count) : 1;
+}
+
+void ThreadPool::submit(ThreadPoolJob* job)
+{
+    Index jobIndex;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        jobIndex = m_jobs.getCount();
+
+        QueuedJob queuedJob;
+        queuedJob.job = job;
+        m_jobs.add(queuedJob);
+    }
+
+    if (m_threads.getCount() == 0)
+    {
+        // No workers, so just run the job here
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_nextJobIndex++;
+        }
+        _runJob(jobIndex);
+        return;
+    }
+
+    m_jobAvailable.notify_one();
+}
+
+void ThreadPool::_runJob(Index jobIndex)
+{
+    ThreadPoolJob* job;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job = m_jobs[jobIndex].job;
+    }
+
+    std::exception_ptr exception;
+    try
+    {
+        job->execute();
+    }
+    catch (...)
+    {
+        exception = std::current_exception();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs[jobIndex].exception = exception;
+        m_completedJobCount++;
+    }
+    m_jobCompleted.notify_all();
+}
+
+void ThreadPool::_workerMain()
+{
+    for (;;)
+    {
+        Index jobIndex;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_jobAvailable.wait(lock, [this]() { return m_isShuttingDown || m_nextJobIndex < m_jobs.getCount(); });
+            if (m_nextJobIndex >= m_jobs.getCount())
+            {
+                // Only get here when shutting down, and there is no more work
+                return;
+            }
+            jobIndex = m_nextJobIndex++;
+        }
+        _runJob(jobIndex);
+    }
+}
+
+void ThreadPool::waitForAll()
+{
+    std::exception_ptr exception;
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_jobCompleted.wait(lock, [this]() { return m_completedJobCount == m_jobs.getCount(); });
+
+        for (auto& queuedJob : m_jobs)
+        {
+            if (queuedJob.exception && !exception)
+            {
+                exception = queuedJob.exception;
+            }
+            // List::clear does not destroy elements, so release the exception here
+            queuedJob.exception = nullptr;
+        }
+
+        m_jobs.clear();
+        m_nextJobIndex = 0;
+        m_completedJobCount = 0;
+    }
+
+    if (exception)
+    {
+        std::rethrow_exception(exception);
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+// slang-thread-pool.h
+#ifndef SLANG_THREAD_POOL_H
+#define SLANG_THREAD_POOL_H
+
+#include "slang-list.h"
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Slang {
+
+    /// A unit of work that can be run on a ThreadPool.
+    ///
+    /// Jobs are owned by the code that submits them, and must remain alive until
+    /// `ThreadPool::waitForAll` has returned.
+class ThreadPoolJob
+{
+public:
+        /// Run the job. Any exception thrown is captured and rethrown from `waitForAll`.
+    virtual void execute() = 0;
+
+    virtual ~ThreadPoolJob() {}
+};
+
+    /// A fixed size pool of worker threads that run submitted jobs in submission order.
+    ///
+    /// A pool created with a thread count of 0 has no worker threads. In that case jobs are
+    /// run on the submitting thread inside `submit`, so behavior is the same as a plain loop.
+class ThreadPool
+{
+public:
+        /// Queue a job to be run. Must not be called concurrently with `waitForAll`.
+    void submit(ThreadPoolJob* job);
+
+        /// Wait until every job submitted so far has completed.
+        /// If any job threw, the exception from the earliest submitted job that threw is rethrown.
+    void waitForAll();
+
+        /// Get the number of worker threads
+    Index getThreadCount() const { return m_threads.getCount(); }
+
+        /// Get a reasonable default number of threads for the current machine (always at least 1)
+    static Index getDefaultThreadCount();
+
+        /// Ctor. threadCount is the number of worker threads to start.
+    explicit ThreadPool(Index threadCount);
+        /// Dtor. Waits for outstanding jobs, and then joins the worker threads.
+    ~ThreadPool();
+
+protected:
+    struct QueuedJob
+    {
+        ThreadPoolJob* job = nullptr;
+        std::exception_ptr exception;
+    };
+
+    void _workerMain();
+    void _runJob(Index jobIndex);
+
+    std::mutex m_mutex;
+    std::condition_variable m_jobAvailable;         ///< Signalled when a job is queued or on shutdown
+    std::condition_variable m_jobCompleted;         ///< Signalled when a job finishes
+
+    List<QueuedJob> m_jobs;                         ///< Jobs submitted since the last waitForAll
+    Index m_nextJobIndex = 0;                       ///< Index of the next job in m_jobs to hand out
+    Index m_completedJobCount = 0;
+    bool m_isShuttingDown = false;
+
+    List<std::thread> m_threads;
+};
+
+}
+
+#endif // SLANG_THREAD_POOL_H
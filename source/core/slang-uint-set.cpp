@@ -1,20 +1,294 @@
 #include "slang-uint-set.h"
 
+// The bulk operations work on 128 bits at a time with SSE2 on x86 (always available on x86-64) or NEON on
+// 64 bit ARM, and on 256 bits at a time with AVX2 on x86 if the CPU supports it (checked for at runtime)
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#   define SLANG_UINT_SET_USE_SSE2 1
+#   if SLANG_VC
+#       define SLANG_UINT_SET_USE_AVX2 1
+#       include <intrin.h>
+#       include <immintrin.h>
+#       define SLANG_UINT_SET_AVX2_TARGET
+#   elif SLANG_GCC_FAMILY
+#       define SLANG_UINT_SET_USE_AVX2 1
+#       include <immintrin.h>
+#       define SLANG_UINT_SET_AVX2_TARGET __attribute__((target("avx2")))
+#   else
+#       include <emmintrin.h>
+#   endif
+#elif SLANG_PROCESSOR_ARM_64
+#   define SLANG_UINT_SET_USE_NEON 1
+#   include <arm_neon.h>
+#endif
+
+#ifndef SLANG_UINT_SET_USE_SSE2
+#   define SLANG_UINT_SET_USE_SSE2 0
+#endif
+#ifndef SLANG_UINT_SET_USE_AVX2
+#   define SLANG_UINT_SET_USE_AVX2 0
+#endif
+#ifndef SLANG_UINT_SET_USE_NEON
+#   define SLANG_UINT_SET_USE_NEON 0
+#endif
+
 namespace Slang
 {
 
-static bool _areAllZero(const UIntSet::Element* elems, Index count)
+namespace { // anonymous
+
+typedef UIntSet::Element Element;
+
+#if SLANG_UINT_SET_USE_SSE2
+typedef __m128i Vector;
+SLANG_FORCE_INLINE static Vector _load(const Element* p) { return _mm_loadu_si128((const __m128i*)p); }
+SLANG_FORCE_INLINE static void _store(Element* p, Vector v) { _mm_storeu_si128((__m128i*)p, v); }
+SLANG_FORCE_INLINE static bool _isZero(Vector v) { return _mm_movemask_epi8(_mm_cmpeq_epi32(v, _mm_setzero_si128())) == 0xffff; }
+#elif SLANG_UINT_SET_USE_NEON
+typedef uint32x4_t Vector;
+SLANG_FORCE_INLINE static Vector _load(const Element* p) { return vld1q_u32(p); }
+SLANG_FORCE_INLINE static void _store(Element* p, Vector v) { vst1q_u32(p, v); }
+SLANG_FORCE_INLINE static bool _isZero(Vector v) { return vmaxvq_u32(v) == 0; }
+#endif
+
+#if SLANG_UINT_SET_USE_SSE2 || SLANG_UINT_SET_USE_NEON
+    /// The number of elements in a Vector
+static const Index kVectorElementCount = Index(sizeof(Vector) / sizeof(Element));
+#endif
+
+#if SLANG_UINT_SET_USE_AVX2
+static const Index kWideVectorElementCount = Index(sizeof(__m256i) / sizeof(Element));
+#endif
+
+// The operations combining two sets. Each applies to single elements, and to each vector type available.
+struct OrOp
+{
+    SLANG_FORCE_INLINE static Element apply(Element a, Element b) { return a | b; }
+#if SLANG_UINT_SET_USE_SSE2
+    SLANG_FORCE_INLINE static Vector apply(Vector a, Vector b) { return _mm_or_si128(a, b); }
+#elif SLANG_UINT_SET_USE_NEON
+    SLANG_FORCE_INLINE static Vector apply(Vector a, Vector b) { return vorrq_u32(a, b); }
+#endif
+#if SLANG_UINT_SET_USE_AVX2
+    SLANG_UINT_SET_AVX2_TARGET static __m256i apply(__m256i a, __m256i b) { return _mm256_or_si256(a, b); }
+#endif
+};
+
+struct AndOp
+{
+    SLANG_FORCE_INLINE static Element apply(Element a, Element b) { return a & b; }
+#if SLANG_UINT_SET_USE_SSE2
+    SLANG_FORCE_INLINE static Vector apply(Vector a, Vector b) { return _mm_and_si128(a, b); }
+#elif SLANG_UINT_SET_USE_NEON
+    SLANG_FORCE_INLINE static Vector apply(Vector a, Vector b) { return vandq_u32(a, b); }
+#endif
+#if SLANG_UINT_SET_USE_AVX2
+    SLANG_UINT_SET_AVX2_TARGET static __m256i apply(__m256i a, __m256i b) { return _mm256_and_si256(a, b); }
+#endif
+};
+
+    /// a & ~b
+struct AndNotOp
+{
+    SLANG_FORCE_INLINE static Element apply(Element a, Element b) { return a & ~b; }
+#if SLANG_UINT_SET_USE_SSE2
+    SLANG_FORCE_INLINE static Vector apply(Vector a, Vector b) { return _mm_andnot_si128(b, a); }
+#elif SLANG_UINT_SET_USE_NEON
+    SLANG_FORCE_INLINE static Vector apply(Vector a, Vector b) { return vbicq_u32(a, b); }
+#endif
+#if SLANG_UINT_SET_USE_AVX2
+    SLANG_UINT_SET_AVX2_TARGET static __m256i apply(__m256i a, __m256i b) { return _mm256_andnot_si256(b, a); }
+#endif
+};
+
+#if SLANG_UINT_SET_USE_AVX2
+
+static bool _calcIsAVX2Available()
 {
-    for (Index i = 0; count; ++i)
+#   if SLANG_VC
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+    // The OS must save the AVX registers (OSXSAVE, and the SSE and AVX state enabled in XCR0)
+    __cpuid(info, 1);
+    if ((info[2] & (1 << 27)) == 0 || (_xgetbv(0) & 6) != 6)
+    {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#   else
+    return __builtin_cpu_supports("avx2") != 0;
+#   endif
+}
+
+static bool _isAVX2Available()
+{
+    static const bool isAvailable = _calcIsAVX2Available();
+    return isAvailable;
+}
+
+    /// Returns the number of elements combined (a multiple of kWideVectorElementCount)
+template <typename Op>
+SLANG_UINT_SET_AVX2_TARGET static Index _combineAVX2(Element* dst, const Element* a, const Element* b, Index count)
+{
+    Index i = 0;
+    for (; i + kWideVectorElementCount <= count; i += kWideVectorElementCount)
+    {
+        const __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(dst + i), Op::apply(va, vb));
+    }
+    return i;
+}
+
+    /// Counts the bits of each byte by looking up each nibble (with a byte shuffle), then sums the bytes
+SLANG_UINT_SET_AVX2_TARGET static Index _countBitsAVX2(const Element* elems, Index count, Index& outCount)
+{
+    const __m256i lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+
+    __m256i total = _mm256_setzero_si256();
+    Index i = 0;
+    for (; i + kWideVectorElementCount <= count; i += kWideVectorElementCount)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(elems + i));
+        const __m256i lowCounts = _mm256_shuffle_epi8(lookup, _mm256_and_si256(v, lowMask));
+        const __m256i highCounts = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(lowCounts, highCounts), _mm256_setzero_si256()));
+    }
+
+    uint64_t lanes[4];
+    _mm256_storeu_si256((__m256i*)lanes, total);
+    outCount = Index(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return i;
+}
+
+    /// Returns the index of the first block of kWideVectorElementCount elements from start that isn't all zero,
+    /// or the start of the last partial block
+SLANG_UINT_SET_AVX2_TARGET static Index _findNonZeroAVX2(const Element* elems, Index start, Index count)
+{
+    Index i = start;
+    for (; i + kWideVectorElementCount <= count; i += kWideVectorElementCount)
+    {
+        const __m256i v = _mm256_loadu_si256((const __m256i*)(elems + i));
+        if (!_mm256_testz_si256(v, v))
+        {
+            break;
+        }
+    }
+    return i;
+}
+
+#endif
+
+    /// Count the bits of an element
+SLANG_FORCE_INLINE static Index _countBits(Element v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return Index((((v + (v >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24);
+}
+
+    /// dst[i] = Op::apply(a[i], b[i]) for i in [0, count). dst can be a or b.
+template <typename Op>
+static void _combine(Element* dst, const Element* a, const Element* b, Index count)
+{
+    Index i = 0;
+#if SLANG_UINT_SET_USE_AVX2
+    if (_isAVX2Available())
+    {
+        i = _combineAVX2<Op>(dst, a, b, count);
+    }
+#endif
+#if SLANG_UINT_SET_USE_SSE2 || SLANG_UINT_SET_USE_NEON
+    for (; i + kVectorElementCount <= count; i += kVectorElementCount)
+    {
+        _store(dst + i, Op::apply(_load(a + i), _load(b + i)));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        dst[i] = Op::apply(a[i], b[i]);
+    }
+}
+
+    /// Count all of the bits in elems
+static Index _countBits(const Element* elems, Index count)
+{
+    Index total = 0;
+    Index i = 0;
+#if SLANG_UINT_SET_USE_AVX2
+    if (_isAVX2Available())
+    {
+        i = _countBitsAVX2(elems, count, total);
+    }
+#endif
+#if SLANG_UINT_SET_USE_SSE2
+    {
+        // Count the bits of each byte in parallel, then sum the bytes
+        const __m128i mask1 = _mm_set1_epi8(0x55);
+        const __m128i mask2 = _mm_set1_epi8(0x33);
+        const __m128i mask4 = _mm_set1_epi8(0x0f);
+        __m128i sums = _mm_setzero_si128();
+        for (; i + kVectorElementCount <= count; i += kVectorElementCount)
+        {
+            __m128i v = _load(elems + i);
+            v = _mm_sub_epi8(v, _mm_and_si128(_mm_srli_epi16(v, 1), mask1));
+            v = _mm_add_epi8(_mm_and_si128(v, mask2), _mm_and_si128(_mm_srli_epi16(v, 2), mask2));
+            v = _mm_and_si128(_mm_add_epi8(v, _mm_srli_epi16(v, 4)), mask4);
+            sums = _mm_add_epi64(sums, _mm_sad_epu8(v, _mm_setzero_si128()));
+        }
+        total += Index(_mm_cvtsi128_si32(sums)) + Index(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+#elif SLANG_UINT_SET_USE_NEON
+    for (; i + kVectorElementCount <= count; i += kVectorElementCount)
+    {
+        total += Index(vaddvq_u8(vcntq_u8(vreinterpretq_u8_u32(_load(elems + i)))));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        total += _countBits(elems[i]);
+    }
+    return total;
+}
+
+    /// Returns the index of the first non zero element in [start, count), or count if they are all zero
+static Index _findNonZero(const Element* elems, Index start, Index count)
+{
+    Index i = start;
+#if SLANG_UINT_SET_USE_AVX2
+    if (_isAVX2Available())
+    {
+        i = _findNonZeroAVX2(elems, i, count);
+    }
+#endif
+#if SLANG_UINT_SET_USE_SSE2 || SLANG_UINT_SET_USE_NEON
+    for (; i + kVectorElementCount <= count; i += kVectorElementCount)
+    {
+        if (!_isZero(_load(elems + i)))
+        {
+            break;
+        }
+    }
+#endif
+    for (; i < count; ++i)
     {
         if (elems[i])
         {
-            return false;
+            break;
         }
     }
-    return true;
+    return i;
 }
 
+} // anonymous
+
 UIntSet& UIntSet::operator=(UIntSet&& other)
 {
     m_buffer = _Move(other.m_buffer);
@@ -72,10 +346,7 @@ void UIntSet::clearAndDeallocate()
 void UIntSet::unionWith(const UIntSet& set)
 {
     const Index minCount = Math::Min(set.m_buffer.getCount(), m_buffer.getCount());
-    for (Index i = 0; i < minCount; i++)
-    {
-        m_buffer[i] |= set.m_buffer[i];
-    }
+    _combine<OrOp>(m_buffer.getBuffer(), m_buffer.getBuffer(), set.m_buffer.getBuffer(), minCount);
 
     if (set.m_buffer.getCount() > m_buffer.getCount())
         m_buffer.addRange(set.m_buffer.getBuffer() + m_buffer.getCount(), set.m_buffer.getCount() - m_buffer.getCount());
@@ -91,9 +362,9 @@ bool UIntSet::operator==(const UIntSet& set) const
 
     const Index minCount = Math::Min(aCount, bCount);
     
-    return ::memcmp(aElems, bElems, minCount) == 0 &&
-        _areAllZero(aElems + minCount, aCount - minCount) &&
-        _areAllZero(bElems + minCount, bCount - minCount);
+    return ::memcmp(aElems, bElems, minCount * sizeof(Element)) == 0 &&
+        _findNonZero(aElems, minCount, aCount) == aCount &&
+        _findNonZero(bElems, minCount, bCount) == bCount;
 }
 
 void UIntSet::intersectWith(const UIntSet& set)
@@ -102,20 +373,52 @@ void UIntSet::intersectWith(const UIntSet& set)
         ::memset(m_buffer.getBuffer() + set.m_buffer.getCount(), 0, (m_buffer.getCount() - set.m_buffer.getCount()) * sizeof(Element));
 
     const Index minCount = Math::Min(set.m_buffer.getCount(), m_buffer.getCount());
-    for (Index i = 0; i < minCount; i++)
+    _combine<AndOp>(m_buffer.getBuffer(), m_buffer.getBuffer(), set.m_buffer.getBuffer(), minCount);
+}
+
+void UIntSet::subtractWith(const UIntSet& set)
+{
+    const Index minCount = Math::Min(set.m_buffer.getCount(), m_buffer.getCount());
+    _combine<AndNotOp>(m_buffer.getBuffer(), m_buffer.getBuffer(), set.m_buffer.getBuffer(), minCount);
+}
+
+Index UIntSet::countValues() const
+{
+    return _countBits(m_buffer.getBuffer(), m_buffer.getCount());
+}
+
+Index UIntSet::_findNextInElements(Index elementIndex) const
+{
+    const Index count = m_buffer.getCount();
+    if (elementIndex >= count)
     {
-        m_buffer[i] &= set.m_buffer[i];
+        return -1;
     }
+    const Index idx = _findNonZero(m_buffer.getBuffer(), elementIndex, count);
+    return (idx < count) ? (idx << kElementShift) + _getLowestBitIndex(m_buffer[idx]) : -1;
+}
+
+UIntSet::Iterator UIntSet::_getIterator(Index elementIndex) const
+{
+    const Index count = m_buffer.getCount();
+    const Index idx = (elementIndex < count) ? _findNonZero(m_buffer.getBuffer(), elementIndex, count) : count;
+    return Iterator(this, idx, (idx < count) ? m_buffer[idx] : 0);
 }
 
 /* static */void UIntSet::calcUnion(UIntSet& outRs, const UIntSet& set1, const UIntSet& set2)
 {
-    outRs.m_buffer.setCount(Math::Max(set1.m_buffer.getCount(), set2.m_buffer.getCount()));
-    outRs.clear();
-    for (Index i = 0; i < set1.m_buffer.getCount(); i++)
-        outRs.m_buffer[i] |= set1.m_buffer[i];
-    for (Index i = 0; i < set2.m_buffer.getCount(); i++)
-        outRs.m_buffer[i] |= set2.m_buffer[i];
+    const Index count1 = set1.m_buffer.getCount();
+    const Index count2 = set2.m_buffer.getCount();
+    const Index minCount = Math::Min(count1, count2);
+    const Index maxCount = Math::Max(count1, count2);
+
+    // outRs may be one of the sets, so the buffers are only accessed after it is resized
+    outRs.m_buffer.setCount(maxCount);
+    _combine<OrOp>(outRs.m_buffer.getBuffer(), set1.m_buffer.getBuffer(), set2.m_buffer.getBuffer(), minCount);
+
+    const UIntSet& longer = (count1 > count2) ? set1 : set2;
+    if (&longer != &outRs)
+        ::memcpy(outRs.m_buffer.getBuffer() + minCount, longer.m_buffer.getBuffer() + minCount, (maxCount - minCount) * sizeof(Element));
 }
 
 /* static */void UIntSet::calcIntersection(UIntSet& outRs, const UIntSet& set1, const UIntSet& set2)
@@ -123,17 +426,20 @@ void UIntSet::intersectWith(const UIntSet& set)
     const Index minCount = Math::Min(set1.m_buffer.getCount(), set2.m_buffer.getCount());
     outRs.m_buffer.setCount(minCount);
 
-    for (Index i = 0; i < minCount; i++)
-        outRs.m_buffer[i] = set1.m_buffer[i] & set2.m_buffer[i];
+    _combine<AndOp>(outRs.m_buffer.getBuffer(), set1.m_buffer.getBuffer(), set2.m_buffer.getBuffer(), minCount);
 }
 
 /* static */void UIntSet::calcSubtract(UIntSet& outRs, const UIntSet& set1, const UIntSet& set2)
 {
-    outRs.m_buffer.setCount(set1.m_buffer.getCount());
+    const Index count1 = set1.m_buffer.getCount();
+    const Index minCount = Math::Min(count1, set2.m_buffer.getCount());
+    outRs.m_buffer.setCount(count1);
 
-    const Index minCount = Math::Min(set1.m_buffer.getCount(), set2.m_buffer.getCount());
-    for (Index i = 0; i < minCount; i++)
-        outRs.m_buffer[i] = set1.m_buffer[i] & (~set2.m_buffer[i]);
+    _combine<AndNotOp>(outRs.m_buffer.getBuffer(), set1.m_buffer.getBuffer(), set2.m_buffer.getBuffer(), minCount);
+
+    // Values of set1 past the end of set2 are kept
+    if (&set1 != &outRs)
+        ::memcpy(outRs.m_buffer.getBuffer() + minCount, set1.m_buffer.getBuffer() + minCount, (count1 - minCount) * sizeof(Element));
 }
 
 /* static */bool UIntSet::hasIntersection(const UIntSet& set1, const UIntSet& set2)
@@ -147,5 +453,9 @@ void UIntSet::intersectWith(const UIntSet& set)
     return false;
 }
 
+/* static */bool UIntSet::isSimdAvailable()
+{
+    return SLANG_UINT_SET_USE_SSE2 || SLANG_UINT_SET_USE_NEON;
 }
 
+}
@@ -7,6 +7,10 @@
 
 #include <memory.h>
 
+#if SLANG_VC
+#   include <intrin.h>
+#endif
+
 namespace Slang
 {
 
@@ -59,6 +63,42 @@ public:
     void unionWith(const UIntSet& set);
         /// Store the intersection between this and set in this
     void intersectWith(const UIntSet& set);
+        /// Remove the values in set from this
+    void subtractWith(const UIntSet& set);
+
+        /// Returns the number of values in the set
+    Index countValues() const;
+        /// Returns the smallest value in the set that is >= start, or -1 if there isn't one
+    Index findNext(UInt start) const;
+
+        /// Iterates over the values in the set in increasing order (with `for (auto val : set)`).
+        /// Each element's bits are visited by clearing the lowest set bit, and runs of empty elements are skipped with SIMD.
+    class Iterator
+    {
+    public:
+        UInt operator*() const { return (UInt(m_elementIndex) << kElementShift) + UInt(_getLowestBitIndex(m_bits)); }
+        Iterator& operator++()
+        {
+            m_bits &= m_bits - 1;
+            if (!m_bits)
+            {
+                *this = m_set->_getIterator(m_elementIndex + 1);
+            }
+            return *this;
+        }
+        bool operator!=(const Iterator& rhs) const { return m_elementIndex != rhs.m_elementIndex || m_bits != rhs.m_bits; }
+
+    private:
+        friend class UIntSet;
+        Iterator(const UIntSet* set, Index elementIndex, Element bits) : m_set(set), m_elementIndex(elementIndex), m_bits(bits) {}
+
+        const UIntSet* m_set;
+        Index m_elementIndex;               ///< The element holding the current value
+        Element m_bits;                     ///< The bits of the element not visited yet
+    };
+
+    Iterator begin() const { return _getIterator(0); }
+    Iterator end() const { return Iterator(this, m_buffer.getCount(), 0); }
 
         /// Store the union of set1 and set2 in outRs
     static void calcUnion(UIntSet& outRs, const UIntSet& set1, const UIntSet& set2);
@@ -70,7 +110,19 @@ public:
         /// Returns true if set1 and set2 have a same value set (ie there is an intersection)
     static bool hasIntersection(const UIntSet& set1, const UIntSet& set2);
 
+        /// True if the bulk operations (union, intersection, subtraction, counting and finding values)
+        /// use SIMD on this CPU
+    static bool isSimdAvailable();
+
 private:
+        /// Returns the smallest value in the elements from index elementIndex on, or -1 if there isn't one
+    Index _findNextInElements(Index elementIndex) const;
+        /// Get an iterator at the first non zero element from elementIndex on, or end() if there isn't one
+    Iterator _getIterator(Index elementIndex) const;
+
+        /// Get the index of the lowest set bit of a non zero element
+    SLANG_FORCE_INLINE static Index _getLowestBitIndex(Element v);
+
     enum
     {
         kElementShift = 5,                              ///< How many bits to shift to get Element index from an index
@@ -98,17 +150,53 @@ inline void UIntSet::remove(UInt val)
 inline bool UIntSet::contains(UInt val) const
 {
     const Index idx = Index(val >> kElementShift);
-    return idx <= m_buffer.getCount() &&
+    return idx < m_buffer.getCount() &&
         ((m_buffer[idx] & (Element(1) << (val & kElementMask))) != 0);
 }
 
+// --------------------------------------------------------------------------
+SLANG_FORCE_INLINE /* static */Index UIntSet::_getLowestBitIndex(Element v)
+{
+#if SLANG_VC
+    unsigned long index;
+    _BitScanForward(&index, v);
+    return Index(index);
+#elif SLANG_GCC_FAMILY
+    return Index(__builtin_ctz(v));
+#else
+    Index index = 0;
+    while (!(v & 1))
+    {
+        v >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// --------------------------------------------------------------------------
+inline Index UIntSet::findNext(UInt start) const
+{
+    // The rest of the element holding start is checked here, as values are usually close together
+    const Index idx = Index(start >> kElementShift);
+    if (idx < m_buffer.getCount())
+    {
+        const Element elem = m_buffer[idx] & (~Element(0) << (start & kElementMask));
+        if (elem)
+        {
+            return (idx << kElementShift) + _getLowestBitIndex(elem);
+        }
+    }
+    return _findNextInElements(idx + 1);
+}
+
 // --------------------------------------------------------------------------
 inline void UIntSet::add(UInt val)
 {
     const Index idx = Index(val >> kElementShift);
     if (idx >= m_buffer.getCount())
     {
-        resize(val);
+        resize(val + 1);
     }
     m_buffer[idx] |= Element(1) << (val & kElementMask);
 }
@@ -53,7 +53,9 @@ namespace Slang
     // /Fd - followed by name of the pdb file
     if (options.debugInfoType != DebugInfoType::None)
     {
-        cmdLine.addPrefixPathArg("/Fd", options.modulePath, ".pdb");
+        // A compile that uses a precompiled header has to use the pdb it was built with
+        const String& pdbPath = options.precompiledHeaderPath.getLength() ? options.precompiledHeaderPath : options.modulePath;
+        cmdLine.addPrefixPathArg("/Fd", pdbPath, ".pdb");
     }
 
     switch (options.targetType)
@@ -78,9 +80,28 @@ namespace Slang
             cmdLine.addPrefixPathArg("/Fe", options.modulePath, ".exe");
             break;
         }
+        case TargetType::PrecompiledHeader:
+        {
+            // Compile the header by itself, with everything in it precompiled
+            // https://docs.microsoft.com/en-us/cpp/build/reference/yc-create-precompiled-header-file?view=vs-2019
+            cmdLine.addArg("/c");
+            cmdLine.addArg(options.sourceType == SourceType::CPP ? "/TP" : "/TC");
+            cmdLine.addArg("/Yc");
+            cmdLine.addPrefixPathArg("/Fp", options.modulePath, ".pch");
+            break;
+        }
         default: break;
     }
 
+    if (options.precompiledHeaderPath.getLength())
+    {
+        // Force include the header, and use the precompiled header for it
+        // https://docs.microsoft.com/en-us/cpp/build/reference/yu-use-precompiled-header-file?view=vs-2019
+        cmdLine.addPrefixPathArg("/FI", options.precompiledHeaderPath);
+        cmdLine.addPrefixPathArg("/Yu", options.precompiledHeaderPath);
+        cmdLine.addPrefixPathArg("/Fp", options.precompiledHeaderPath, ".pch");
+    }
+
     // Object file specify it's location - needed if we are out
     cmdLine.addPrefixPathArg("/Fo", options.modulePath, ".obj");
 
@@ -113,6 +134,20 @@ namespace Slang
         cmdLine.addArg(sourceFile);
     }
 
+    if (options.targetType == TargetType::PrecompiledHeader)
+    {
+        // Nothing is linked
+        return;
+    }
+
+    // The object file built along with a precompiled header holds its debug information, and has to be linked
+    if (options.precompiledHeaderPath.getLength() && options.targetType != TargetType::Object)
+    {
+        StringBuilder objectPath;
+        objectPath << options.precompiledHeaderPath << ".obj";
+        cmdLine.addArg(objectPath);
+    }
+
     // Link options (parameters past /link go to linker)
     cmdLine.addArg("/link");
 
@@ -166,6 +166,72 @@ SlangResult FileWriter::setMode(SlangWriterMode mode)
     return SLANG_FAIL;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!! BufferedWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+BufferedWriter::BufferedWriter(ISlangWriter* writer, WriterFlags flags, size_t bufferSize) :
+    Parent(flags),
+    m_writer(writer),
+    m_bufferSize(bufferSize)
+{
+    m_buffer.reserve(Index(bufferSize));
+}
+
+BufferedWriter::~BufferedWriter()
+{
+    writeBuffered();
+}
+
+SlangResult BufferedWriter::writeBuffered()
+{
+    if (m_buffer.getCount() == 0)
+    {
+        return SLANG_OK;
+    }
+    const SlangResult res = m_writer->write(m_buffer.getBuffer(), size_t(m_buffer.getCount()));
+    m_buffer.clear();
+    return res;
+}
+
+SLANG_NO_THROW char* SLANG_MCALL BufferedWriter::beginAppendBuffer(size_t maxNumChars)
+{
+    // Make space in the buffer, and have the chars appended to it directly
+    if (size_t(m_buffer.getCount()) + maxNumChars > m_bufferSize)
+    {
+        writeBuffered();
+    }
+    const Index startIndex = m_buffer.getCount();
+    m_buffer.setCount(startIndex + Index(maxNumChars));
+    return m_buffer.getBuffer() + startIndex;
+}
+
+SLANG_NO_THROW SlangResult SLANG_MCALL BufferedWriter::endAppendBuffer(char* buffer, size_t numChars)
+{
+    SLANG_ASSERT(buffer >= m_buffer.getBuffer() && buffer + numChars <= m_buffer.end());
+    m_buffer.setCount(Index(buffer - m_buffer.getBuffer()) + Index(numChars));
+    return (size_t(m_buffer.getCount()) >= m_bufferSize) ? writeBuffered() : SLANG_OK;
+}
+
+SlangResult BufferedWriter::write(const char* chars, size_t numChars)
+{
+    if (size_t(m_buffer.getCount()) + numChars > m_bufferSize)
+    {
+        SLANG_RETURN_ON_FAIL(writeBuffered());
+        // Too large to be worth holding, so write directly
+        if (numChars >= m_bufferSize)
+        {
+            return m_writer->write(chars, numChars);
+        }
+    }
+    m_buffer.addRange(chars, Index(numChars));
+    return SLANG_OK;
+}
+
+void BufferedWriter::flush()
+{
+    writeBuffered();
+    m_writer->flush();
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!! StringWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
 
 SLANG_NO_THROW char* SLANG_MCALL StringWriter::beginAppendBuffer(size_t maxNumChars)
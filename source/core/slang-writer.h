@@ -4,6 +4,7 @@
 #include "slang-string.h"
 
 #include "../../slang-com-helper.h"
+#include "../../slang-com-ptr.h"
 #include "slang-list.h"
 
 namespace Slang
@@ -33,6 +34,7 @@ struct WriterFlag
         IsConsole = 0x2,            ///< True if console
         IsUnowned = 0x4,            ///< True if doesn't own contained type
         AutoFlush = 0x8,            ///< Automatically flushes after every call
+        IsNotConsole = 0x10,        ///< Known not to be a console (such as a file that was just opened), so there is no need to check
     };
 private:
     WriterFlag() = delete;
@@ -112,9 +114,9 @@ public:
     static bool isConsole(FILE* file);
     static WriterFlags getDefaultFlags(FILE* file) { return isConsole(file) ? WriterFlags(WriterFlag::IsConsole) : 0; }
 
-        /// Ctor
+        /// Ctor. Unless flags has IsNotConsole, checks if file is a console.
     FileWriter(FILE* file, WriterFlags flags) :
-        Parent(flags | getDefaultFlags(file)),
+        Parent((flags & WriterFlag::IsNotConsole) ? flags : (flags | getDefaultFlags(file))),
         m_file(file)
     {}
 
@@ -144,6 +146,42 @@ protected:
     StringBuilder* m_builder;
 };
 
+/* Holds what is written in a large buffer, and only writes it to another writer when the buffer is full, or on flush.
+Turns many small writes (such as of lines of a dump) into a few large ones, with explicit flush points. Writes larger
+than the buffer are passed straight through. Whatever is held is written when the writer is destroyed. */
+class BufferedWriter : public BaseWriter
+{
+public:
+    typedef BaseWriter Parent;
+
+    enum { kDefaultBufferSize = 64 * 1024 };
+
+    // ISlangWriter
+    SLANG_NO_THROW char* SLANG_MCALL beginAppendBuffer(size_t maxNumChars) SLANG_OVERRIDE;
+    SLANG_NO_THROW SlangResult SLANG_MCALL endAppendBuffer(char* buffer, size_t numChars) SLANG_OVERRIDE;
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL write(const char* chars, size_t numChars) SLANG_OVERRIDE;
+        /// Writes everything held to the writer, and flushes it
+    SLANG_NO_THROW virtual void SLANG_MCALL flush() SLANG_OVERRIDE;
+    SLANG_NO_THROW virtual bool SLANG_MCALL isConsole() SLANG_OVERRIDE { return m_writer->isConsole(); }
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL setMode(SlangWriterMode mode) SLANG_OVERRIDE { return m_writer->setMode(mode); }
+
+        /// Write everything held to the writer (without flushing it)
+    SlangResult writeBuffered();
+
+        /// Get the number of chars held, that haven't been written to the writer
+    size_t getBufferedCount() const { return size_t(m_buffer.getCount()); }
+
+        /// Ctor
+    BufferedWriter(ISlangWriter* writer, WriterFlags flags, size_t bufferSize = kDefaultBufferSize);
+        /// Dtor
+    ~BufferedWriter();
+
+protected:
+    ComPtr<ISlangWriter> m_writer;
+    size_t m_bufferSize;
+    List<char> m_buffer;
+};
+
 class NullWriter : public AppendBufferWriter
 {
 public:
@@ -13,6 +13,7 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <time.h>
 #include <unistd.h>
 
 namespace Slang {
@@ -27,6 +28,23 @@ namespace Slang {
 #endif
 }
 
+/* static */uint64_t ProcessUtil::getClockTick()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000000000 + uint64_t(now.tv_nsec);
+}
+
+/* static */uint64_t ProcessUtil::getClockFrequency()
+{
+    return 1000000000;
+}
+
+/* static */uint64_t ProcessUtil::getProcessId()
+{
+    return uint64_t(getpid());
+}
+
 /* static */void ProcessUtil::appendCommandLineEscaped(const UnownedStringSlice& slice, StringBuilder& out)
 {
    // TODO(JS): This escaping is not complete... !
@@ -82,7 +100,7 @@ namespace Slang {
     return cmd.ToString();
 }
 
-/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult)
+/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult, ProcessListener* listener)
 {
     outExecuteResult.init();
     
@@ -128,9 +146,10 @@ namespace Slang {
 
         execvp(argPtrs[0], (char* const*)&argPtrs[0]);
 
-        // If we get here, then `exec` failed
+        // If we get here, then `exec` failed. The child must not return, as it would carry on
+        // running the code (and any threads) of the parent.
         fprintf(stderr, "error: `exec` failed\n");
-        return SLANG_FAIL;
+        _exit(127);
     }
     else
     {
@@ -192,8 +211,14 @@ namespace Slang {
                     pollInfos[0].fd = -1;
                     remainingCount--;
                 }
-
-                outExecuteResult.standardOutput.append(buffer, buffer + count);
+                else
+                {
+                    outExecuteResult.standardOutput.append(buffer, buffer + count);
+                    if (listener)
+                    {
+                        listener->onOutput(ProcessOutputStream::StandardOutput, UnownedStringSlice(buffer, buffer + count));
+                    }
+                }
             }
 
             if (pollInfos[1].revents)
@@ -206,8 +231,14 @@ namespace Slang {
                     pollInfos[1].fd = -1;
                     remainingCount--;
                 }
-
-                outExecuteResult.standardError.append(buffer, buffer + count);
+                else
+                {
+                    outExecuteResult.standardError.append(buffer, buffer + count);
+                    if (listener)
+                    {
+                        listener->onOutput(ProcessOutputStream::StandardError, UnownedStringSlice(buffer, buffer + count));
+                    }
+                }
             }
         }
 
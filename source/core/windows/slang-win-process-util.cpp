@@ -18,6 +18,8 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <mutex>
+
 namespace Slang {
 
 namespace { // anonymous
@@ -26,6 +28,10 @@ struct ThreadInfo
 {
     HANDLE	file;
     String	output;
+
+    ProcessListener* listener = nullptr;        ///< If set, output is passed to it as it is read
+    ProcessOutputStream stream;
+    std::mutex* listenerMutex = nullptr;        ///< Held whilst calling the listener, as both streams are read at once
 };
 
 // Has behavior very similar to unique_ptr - assignment is a move.
@@ -141,6 +147,12 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
         // the length of the buffer, so we ultimately have
         // to just assume null termination...
         outputBuilder.Append(buffer, bytesRead);
+
+        if (info->listener && bytesRead)
+        {
+            std::lock_guard<std::mutex> lock(*info->listenerMutex);
+            info->listener->onOutput(info->stream, UnownedStringSlice(buffer, buffer + bytesRead));
+        }
     }
 
     info->output = outputBuilder.ProduceString();
@@ -154,6 +166,25 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
     return UnownedStringSlice::fromLiteral(".exe");
 }
 
+/* static */uint64_t ProcessUtil::getClockTick()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return counter.QuadPart;
+}
+
+/* static */uint64_t ProcessUtil::getClockFrequency()
+{
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+    return frequency.QuadPart;
+}
+
+/* static */uint64_t ProcessUtil::getProcessId()
+{
+    return uint64_t(GetCurrentProcessId());
+}
+
 /* static */void ProcessUtil::appendCommandLineEscaped(const UnownedStringSlice& slice, StringBuilder& out)
 {
     // TODO(JS): This escaping is not complete... !
@@ -211,7 +242,7 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
 
 #define SLANG_RETURN_FAIL_ON_FALSE(x) if (!(x)) return SLANG_FAIL;
 
-/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult)
+/* static */SlangResult ProcessUtil::execute(const CommandLine& commandLine, ExecuteResult& outExecuteResult, ProcessListener* listener)
 {
     outExecuteResult.init();
 
@@ -305,14 +336,22 @@ static DWORD WINAPI _readerThreadProc(LPVOID threadParam)
         CloseHandle(processInfo.hThread);
     }
 
+    std::mutex listenerMutex;
+
     // Create a thread to read from the child's stdout.
     ThreadInfo stdOutThreadInfo;
     stdOutThreadInfo.file = childStdOutRead;
+    stdOutThreadInfo.listener = listener;
+    stdOutThreadInfo.stream = ProcessOutputStream::StandardOutput;
+    stdOutThreadInfo.listenerMutex = &listenerMutex;
     WinHandle stdOutThread = CreateThread(nullptr, 0, &_readerThreadProc, (LPVOID)&stdOutThreadInfo, 0, nullptr);
 
     // Create a thread to read from the child's stderr.
     ThreadInfo stdErrThreadInfo;
     stdErrThreadInfo.file = childStdErrRead;
+    stdErrThreadInfo.listener = listener;
+    stdErrThreadInfo.stream = ProcessOutputStream::StandardError;
+    stdErrThreadInfo.listenerMutex = &listenerMutex;
     WinHandle stdErrThread = CreateThread(nullptr, 0, &_readerThreadProc, (LPVOID)&stdErrThreadInfo, 0, nullptr);
 
     // wait for the process to exit
@@ -1,68 +1,70 @@
-SLANG_RAW("// Slang `core` library\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Aliases for base types\n")
-SLANG_RAW("typedef half float16_t;\n")
-SLANG_RAW("typedef float float32_t;\n")
-SLANG_RAW("typedef double float64_t;\n")
-SLANG_RAW("\n")
-SLANG_RAW("typedef int int32_t;\n")
-SLANG_RAW("typedef uint uint32_t;\n")
-SLANG_RAW("\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Modifier for variables that must resolve to compile-time constants\n")
-SLANG_RAW("// as part of translation.\n")
-SLANG_RAW("syntax constexpr : ConstExprModifier;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Modifier for variables that should have writes be made\n")
-SLANG_RAW("// visible at the global-memory scope\n")
-SLANG_RAW("syntax globallycoherent : GloballyCoherentModifier;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type that can be used as an operand for builtins\n")
-SLANG_RAW("interface __BuiltinType {}\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type that can be used for arithmetic operations\n")
-SLANG_RAW("interface __BuiltinArithmeticType : __BuiltinType {}\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type that logically has a sign (positive/negative/zero)\n")
-SLANG_RAW("interface __BuiltinSignedArithmeticType : __BuiltinArithmeticType {}\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type that can represent integers\n")
-SLANG_RAW("interface __BuiltinIntegerType : __BuiltinArithmeticType\n")
-SLANG_RAW("{}\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type that can represent non-integers\n")
-SLANG_RAW("interface __BuiltinRealType : __BuiltinArithmeticType {}\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type that uses a floating-point representation\n")
-SLANG_RAW("interface __BuiltinFloatingPointType : __BuiltinRealType, __BuiltinSignedArithmeticType\n")
-SLANG_RAW("{\n")
-SLANG_RAW("    // A builtin floating-point type must have an initializer that takes\n")
-SLANG_RAW("    // a floating-point value...\n")
-SLANG_RAW("    __init(float value);\n")
-SLANG_RAW("}\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type resulting from an `enum` declaration.\n")
-SLANG_RAW("__magic_type(EnumTypeType)\n")
-SLANG_RAW("interface __EnumType\n")
-SLANG_RAW("{\n")
-SLANG_RAW("    // The type of tags for this `enum`\n")
-SLANG_RAW("    //\n")
-SLANG_RAW("    // Note: using `__Tag` instead of `Tag` to avoid any\n")
-SLANG_RAW("    // conflict if a user had an `enum` case called `Tag`\n")
-SLANG_RAW("    associatedtype __Tag : __BuiltinIntegerType;\n")
-SLANG_RAW("};\n")
-SLANG_RAW("\n")
-SLANG_RAW("// A type resulting from an `enum` declaration\n")
-SLANG_RAW("// with the `[flags]` attribute.\n")
-SLANG_RAW("interface __FlagsEnumType : __EnumType\n")
-SLANG_RAW("{\n")
-SLANG_RAW("};\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T,U> __intrinsic_op(Sequence) U operator,(T left, U right);\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T> __intrinsic_op(select) T operator?:(bool condition, T ifTrue, T ifFalse);\n")
-SLANG_RAW("__generic<T, let N : int> __intrinsic_op(select) vector<T,N> operator?:(vector<bool,N> condition, vector<T,N> ifTrue, vector<T,N> ifFalse);\n")
-SLANG_RAW("\n")
+SLANG_RAW(
+"// Slang `core` library\n"
+"\n"
+"// Aliases for base types\n"
+"typedef half float16_t;\n"
+"typedef float float32_t;\n"
+"typedef double float64_t;\n"
+"\n"
+"typedef int int32_t;\n"
+"typedef uint uint32_t;\n"
+"\n"
+"\n"
+"// Modifier for variables that must resolve to compile-time constants\n"
+"// as part of translation.\n"
+"syntax constexpr : ConstExprModifier;\n"
+"\n"
+"// Modifier for variables that should have writes be made\n"
+"// visible at the global-memory scope\n"
+"syntax globallycoherent : GloballyCoherentModifier;\n"
+"\n"
+"// A type that can be used as an operand for builtins\n"
+"interface __BuiltinType {}\n"
+"\n"
+"// A type that can be used for arithmetic operations\n"
+"interface __BuiltinArithmeticType : __BuiltinType {}\n"
+"\n"
+"// A type that logically has a sign (positive/negative/zero)\n"
+"interface __BuiltinSignedArithmeticType : __BuiltinArithmeticType {}\n"
+"\n"
+"// A type that can represent integers\n"
+"interface __BuiltinIntegerType : __BuiltinArithmeticType\n"
+"{}\n"
+"\n"
+"// A type that can represent non-integers\n"
+"interface __BuiltinRealType : __BuiltinArithmeticType {}\n"
+"\n"
+"// A type that uses a floating-point representation\n"
+"interface __BuiltinFloatingPointType : __BuiltinRealType, __BuiltinSignedArithmeticType\n"
+"{\n"
+"    // A builtin floating-point type must have an initializer that takes\n"
+"    // a floating-point value...\n"
+"    __init(float value);\n"
+"}\n"
+"\n"
+"// A type resulting from an `enum` declaration.\n"
+"__magic_type(EnumTypeType)\n"
+"interface __EnumType\n"
+"{\n"
+"    // The type of tags for this `enum`\n"
+"    //\n"
+"    // Note: using `__Tag` instead of `Tag` to avoid any\n"
+"    // conflict if a user had an `enum` case called `Tag`\n"
+"    associatedtype __Tag : __BuiltinIntegerType;\n"
+"};\n"
+"\n"
+"// A type resulting from an `enum` declaration\n"
+"// with the `[flags]` attribute.\n"
+"interface __FlagsEnumType : __EnumType\n"
+"{\n"
+"};\n"
+"\n"
+"__generic<T,U> __intrinsic_op(Sequence) U operator,(T left, U right);\n"
+"\n"
+"__generic<T> __intrinsic_op(select) T operator?:(bool condition, T ifTrue, T ifFalse);\n"
+"__generic<T, let N : int> __intrinsic_op(select) vector<T,N> operator?:(vector<bool,N> condition, vector<T,N> ifTrue, vector<T,N> ifFalse);\n"
+"\n"
+)
 
 // We are going to use code generation to produce the
 // declarations for all of our base types.
@@ -142,10 +144,12 @@ for (int tt = 0; tt < kBaseTypeCount; ++tt)
         // TODO: should this cover the full gamut of integer types?
     case BaseType::Int:
     case BaseType::UInt:
-SLANG_RAW("#line 145 \"core.meta.slang\"")
-SLANG_RAW("\n")
-SLANG_RAW("        __generic<T:__EnumType>\n")
-SLANG_RAW("        __init(T value);\n")
+SLANG_RAW(
+"#line 145 \"core.meta.slang\""
+"\n"
+"        __generic<T:__EnumType>\n"
+"        __init(T value);\n"
+)
 
         break;
 
@@ -158,53 +162,65 @@ SLANG_RAW("        __init(T value);\n")
 
 // Declare built-in pointer type
 // (eventually we can have the traditional syntax sugar for this)
-SLANG_RAW("#line 160 \"core.meta.slang\"")
-SLANG_RAW("\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T>\n")
-SLANG_RAW("__magic_type(PtrType)\n")
-SLANG_RAW("__intrinsic_type(")
+SLANG_RAW(
+"#line 160 \"core.meta.slang\""
+"\n"
+"\n"
+"__generic<T>\n"
+"__magic_type(PtrType)\n"
+"__intrinsic_type("
+)
 SLANG_SPLICE(kIROp_PtrType
 )
-SLANG_RAW(")\n")
-SLANG_RAW("struct Ptr\n")
-SLANG_RAW("{};\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T>\n")
-SLANG_RAW("__magic_type(OutType)\n")
-SLANG_RAW("__intrinsic_type(")
+SLANG_RAW(
+")\n"
+"struct Ptr\n"
+"{};\n"
+"\n"
+"__generic<T>\n"
+"__magic_type(OutType)\n"
+"__intrinsic_type("
+)
 SLANG_SPLICE(kIROp_OutType
 )
-SLANG_RAW(")\n")
-SLANG_RAW("struct Out\n")
-SLANG_RAW("{};\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T>\n")
-SLANG_RAW("__magic_type(InOutType)\n")
-SLANG_RAW("__intrinsic_type(")
+SLANG_RAW(
+")\n"
+"struct Out\n"
+"{};\n"
+"\n"
+"__generic<T>\n"
+"__magic_type(InOutType)\n"
+"__intrinsic_type("
+)
 SLANG_SPLICE(kIROp_InOutType
 )
-SLANG_RAW(")\n")
-SLANG_RAW("struct InOut\n")
-SLANG_RAW("{};\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T>\n")
-SLANG_RAW("__magic_type(RefType)\n")
-SLANG_RAW("__intrinsic_type(")
+SLANG_RAW(
+")\n"
+"struct InOut\n"
+"{};\n"
+"\n"
+"__generic<T>\n"
+"__magic_type(RefType)\n"
+"__intrinsic_type("
+)
 SLANG_SPLICE(kIROp_RefType
 )
-SLANG_RAW(")\n")
-SLANG_RAW("struct Ref\n")
-SLANG_RAW("{};\n")
-SLANG_RAW("\n")
-SLANG_RAW("__magic_type(StringType)\n")
-SLANG_RAW("__intrinsic_type(")
+SLANG_RAW(
+")\n"
+"struct Ref\n"
+"{};\n"
+"\n"
+"__magic_type(StringType)\n"
+"__intrinsic_type("
+)
 SLANG_SPLICE(kIROp_StringType
 )
-SLANG_RAW(")\n")
-SLANG_RAW("struct String\n")
-SLANG_RAW("{};\n")
-SLANG_RAW("\n")
+SLANG_RAW(
+")\n"
+"struct String\n"
+"{};\n"
+"\n"
+)
 
 // Declare vector and matrix types
 
@@ -220,13 +236,15 @@ sb << "    __init(T value);\n";
 sb << "    __init(vector<T,N> value);\n";
 
 sb << "};\n";
-SLANG_RAW("#line 206 \"core.meta.slang\"")
-SLANG_RAW("\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<T = float, let R : int = 4, let C : int = 4>\n")
-SLANG_RAW("__magic_type(Matrix)\n")
-SLANG_RAW("struct matrix {};\n")
-SLANG_RAW("\n")
+SLANG_RAW(
+"#line 206 \"core.meta.slang\""
+"\n"
+"\n"
+"__generic<T = float, let R : int = 4, let C : int = 4>\n"
+"__magic_type(Matrix)\n"
+"struct matrix {};\n"
+"\n"
+)
 
 static const struct {
     char const* name;
@@ -1207,141 +1225,154 @@ for (auto op : binaryOps)
         sb << "__intrinsic_op(" << int(op.opCode) << ") matrix<" << resultType << ",N,M> operator" << op.opName << "(" << leftQual << "matrix<" << leftType << ",N,M> left, " << rightType << " right);\n";
     }
 }
-SLANG_RAW("#line 1192 \"core.meta.slang\"")
-SLANG_RAW("\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Operators to apply to `enum` types\n")
-SLANG_RAW("\n")
-SLANG_RAW("__generic<E : __EnumType>\n")
-SLANG_RAW("__intrinsic_op(")
+SLANG_RAW(
+"#line 1192 \"core.meta.slang\""
+"\n"
+"\n"
+"// Operators to apply to `enum` types\n"
+"\n"
+"__generic<E : __EnumType>\n"
+"__intrinsic_op("
+)
 SLANG_SPLICE(kIROp_Eql
 )
-SLANG_RAW(")\n")
-SLANG_RAW("bool operator==(E left, E right);\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Binding Attributes\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(DeclBase)\n")
-SLANG_RAW("attribute_syntax [vk_binding(binding: int, set: int = 0)]\t\t\t: GLSLBindingAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(DeclBase)\n")
-SLANG_RAW("attribute_syntax [gl_binding(binding: int, set: int = 0)]\t\t\t: GLSLBindingAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(VarDeclBase)\n")
-SLANG_RAW("attribute_syntax [vk_shader_record]\t\t\t                        : ShaderRecordAttribute;\n")
-SLANG_RAW("__attributeTarget(VarDeclBase)\n")
-SLANG_RAW("attribute_syntax [shader_record]\t\t\t                        : ShaderRecordAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(DeclBase)\n")
-SLANG_RAW("attribute_syntax [vk_push_constant]\t\t\t\t\t\t\t\t\t: PushConstantAttribute;\n")
-SLANG_RAW("__attributeTarget(DeclBase)\n")
-SLANG_RAW("attribute_syntax [push_constant]\t\t\t\t\t\t\t\t\t: PushConstantAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Statement Attributes\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(LoopStmt)\n")
-SLANG_RAW("attribute_syntax [unroll(count: int = 0)]   : UnrollAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(LoopStmt)\n")
-SLANG_RAW("attribute_syntax [loop]                 : LoopAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(LoopStmt)\n")
-SLANG_RAW("attribute_syntax [fastopt]              : FastOptAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(LoopStmt)\n")
-SLANG_RAW("attribute_syntax [allow_uav_condition]  : AllowUAVConditionAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(IfStmt)\n")
-SLANG_RAW("attribute_syntax [flatten]              : FlattenAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(IfStmt)\n")
-SLANG_RAW("__attributeTarget(SwitchStmt)\n")
-SLANG_RAW("attribute_syntax [branch]               : BranchAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(SwitchStmt)\n")
-SLANG_RAW("attribute_syntax [forcecase]            : ForceCaseAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(SwitchStmt)\n")
-SLANG_RAW("attribute_syntax [call]                 : CallAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Entry-point Attributes\n")
-SLANG_RAW("\n")
-SLANG_RAW("// All Stages\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [shader(stage)]    : EntryPointAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Hull Shader\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [maxtessfactor(factor: float)]     : MaxTessFactorAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [outputcontrolpoints(count: int)]  : OutputControlPointsAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [outputtopology(topology)]         : OutputTopologyAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [partitioning(mode)]               : PartitioningAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [patchconstantfunc(name)]          : PatchConstantFuncAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Hull/Domain Shader\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [domain(domain)]   : DomainAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Geometry Shader\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [maxvertexcount(count: int)]   : MaxVertexCountAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [instance(count: int)]         : InstanceAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Fragment (\"Pixel\") Shader\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [earlydepthstencil]    : EarlyDepthStencilAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("// Compute Shader\n")
-SLANG_RAW("__attributeTarget(FuncDecl)\n")
-SLANG_RAW("attribute_syntax [numthreads(x: int, y: int = 1, z: int = 1)]   : NumThreadsAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("//\n")
-SLANG_RAW("__attributeTarget(VarDeclBase)\n")
-SLANG_RAW("attribute_syntax [__vulkanRayPayload] : VulkanRayPayloadAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(VarDeclBase)\n")
-SLANG_RAW("attribute_syntax [__vulkanCallablePayload] : VulkanCallablePayloadAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(VarDeclBase)\n")
-SLANG_RAW("attribute_syntax [__vulkanHitAttributes] : VulkanHitAttributesAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(FunctionDeclBase)\n")
-SLANG_RAW("attribute_syntax [mutating] : MutatingAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("    /// Indicates that a function computes its result as a function of its arguments without loading/storing any memory or other state.\n")
-SLANG_RAW("    ///\n")
-SLANG_RAW("    /// This is equivalent to the LLVM `readnone` function attribute.\n")
-SLANG_RAW("__attributeTarget(FunctionDeclBase)\n")
-SLANG_RAW("attribute_syntax [__readNone] : ReadNoneAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("enum _AttributeTargets\n")
-SLANG_RAW("{\n")
-SLANG_RAW("    Struct = ")
+SLANG_RAW(
+")\n"
+"bool operator==(E left, E right);\n"
+"\n"
+"// Binding Attributes\n"
+"\n"
+"__attributeTarget(DeclBase)\n"
+"attribute_syntax [vk_binding(binding: int, set: int = 0)]\t\t\t: GLSLBindingAttribute;\n"
+"\n"
+"__attributeTarget(DeclBase)\n"
+"attribute_syntax [gl_binding(binding: int, set: int = 0)]\t\t\t: GLSLBindingAttribute;\n"
+"\n"
+"\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [vk_shader_record]\t\t\t                        : ShaderRecordAttribute;\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [shader_record]\t\t\t                        : ShaderRecordAttribute;\n"
+"\n"
+"__attributeTarget(DeclBase)\n"
+"attribute_syntax [vk_push_constant]\t\t\t\t\t\t\t\t\t: PushConstantAttribute;\n"
+"__attributeTarget(DeclBase)\n"
+"attribute_syntax [push_constant]\t\t\t\t\t\t\t\t\t: PushConstantAttribute;\n"
+"\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [vk_constant_id(id: int)]                          : SpecializationConstantAttribute;\n"
+"\n"
+"// Statement Attributes\n"
+"\n"
+"__attributeTarget(LoopStmt)\n"
+"attribute_syntax [unroll(count: int = 0)]   : UnrollAttribute;\n"
+"\n"
+"__attributeTarget(LoopStmt)\n"
+"attribute_syntax [loop]                 : LoopAttribute;\n"
+"\n"
+"__attributeTarget(LoopStmt)\n"
+"attribute_syntax [fastopt]              : FastOptAttribute;\n"
+"\n"
+"__attributeTarget(LoopStmt)\n"
+"attribute_syntax [allow_uav_condition]  : AllowUAVConditionAttribute;\n"
+"\n"
+"__attributeTarget(IfStmt)\n"
+"attribute_syntax [flatten]              : FlattenAttribute;\n"
+"\n"
+"__attributeTarget(IfStmt)\n"
+"__attributeTarget(SwitchStmt)\n"
+"attribute_syntax [branch]               : BranchAttribute;\n"
+"\n"
+"__attributeTarget(SwitchStmt)\n"
+"attribute_syntax [forcecase]            : ForceCaseAttribute;\n"
+"\n"
+"__attributeTarget(SwitchStmt)\n"
+"attribute_syntax [call]                 : CallAttribute;\n"
+"\n"
+"// Entry-point Attributes\n"
+"\n"
+"// All Stages\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [shader(stage)]    : EntryPointAttribute;\n"
+"\n"
+"// Hull Shader\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [maxtessfactor(factor: float)]     : MaxTessFactorAttribute;\n"
+"\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [outputcontrolpoints(count: int)]  : OutputControlPointsAttribute;\n"
+"\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [outputtopology(topology)]         : OutputTopologyAttribute;\n"
+"\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [partitioning(mode)]               : PartitioningAttribute;\n"
+"\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [patchconstantfunc(name)]          : PatchConstantFuncAttribute;\n"
+"\n"
+"// Hull/Domain Shader\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [domain(domain)]   : DomainAttribute;\n"
+"\n"
+"// Geometry Shader\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [maxvertexcount(count: int)]   : MaxVertexCountAttribute;\n"
+"\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [instance(count: int)]         : InstanceAttribute;\n"
+"\n"
+"// Fragment (\"Pixel\") Shader\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [earlydepthstencil]    : EarlyDepthStencilAttribute;\n"
+"\n"
+"// Compute Shader\n"
+"__attributeTarget(FuncDecl)\n"
+"attribute_syntax [numthreads(x: int, y: int = 1, z: int = 1)]   : NumThreadsAttribute;\n"
+"\n"
+"//\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [__vulkanRayPayload] : VulkanRayPayloadAttribute;\n"
+"\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [__vulkanCallablePayload] : VulkanCallablePayloadAttribute;\n"
+"\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [__vulkanHitAttributes] : VulkanHitAttributesAttribute;\n"
+"\n"
+"__attributeTarget(FunctionDeclBase)\n"
+"attribute_syntax [mutating] : MutatingAttribute;\n"
+"\n"
+"    /// Indicates that a function computes its result as a function of its arguments without loading/storing any memory or other state.\n"
+"    ///\n"
+"    /// This is equivalent to the LLVM `readnone` function attribute.\n"
+"__attributeTarget(FunctionDeclBase)\n"
+"attribute_syntax [__readNone] : ReadNoneAttribute;\n"
+"\n"
+"enum _AttributeTargets\n"
+"{\n"
+"    Struct = "
+)
 SLANG_SPLICE( (int) UserDefinedAttributeTargets::Struct
 )
-SLANG_RAW(",\n")
-SLANG_RAW("    Var = ")
+SLANG_RAW(
+",\n"
+"    Var = "
+)
 SLANG_SPLICE( (int) UserDefinedAttributeTargets::Var
 )
-SLANG_RAW(",\n")
-SLANG_RAW("    Function = ")
+SLANG_RAW(
+",\n"
+"    Function = "
+)
 SLANG_SPLICE( (int) UserDefinedAttributeTargets::Function
 )
-SLANG_RAW(",\n")
-SLANG_RAW("};\n")
-SLANG_RAW("__attributeTarget(StructDecl)\n")
-SLANG_RAW("attribute_syntax [__AttributeUsage(target : _AttributeTargets)] : AttributeUsageAttribute;\n")
-SLANG_RAW("\n")
-SLANG_RAW("__attributeTarget(VarDeclBase)\n")
-SLANG_RAW("attribute_syntax [format(format : String)] : FormatAttribute;\n")
+SLANG_RAW(
+",\n"
+"};\n"
+"__attributeTarget(StructDecl)\n"
+"attribute_syntax [__AttributeUsage(target : _AttributeTargets)] : AttributeUsageAttribute;\n"
+"\n"
+"__attributeTarget(VarDeclBase)\n"
+"attribute_syntax [format(format : String)] : FormatAttribute;\n"
+)
@@ -0,0 +1,128 @@
+// slang-ast-arena.cpp
+#include "slang-ast-arena.h"
+
+#include <stdlib.h>
+#include <new>
+
+namespace Slang {
+
+namespace { // anonymous
+
+// Every node allocation is preceded by a header recording where it came from, so that
+// `deallocate` can tell arena and heap allocations apart. The header is kAlignment
+// bytes, so the node itself keeps the alignment.
+struct NodeHeader
+{
+    ASTArena* arena;            ///< The arena the node was allocated from, or nullptr for the heap
+    size_t sizeInBytes;         ///< The size of the node (not including the header)
+};
+
+static const size_t kNodeHeaderSize = ASTArena::kAlignment;
+SLANG_COMPILE_TIME_ASSERT(sizeof(NodeHeader) <= kNodeHeaderSize);
+
+// Arena memory is rarely freed before the end of a compile, so blocks are large
+static const size_t kArenaBlockSize = 64 * 1024;
+
+static thread_local ASTArena* t_currentArena = nullptr;
+static thread_local ASTAllocationStats t_stats;
+
+} // anonymous
+
+ASTArena::ASTArena():
+    m_memoryArena(kArenaBlockSize, kAlignment)
+{
+}
+
+void* ASTArena::allocate(size_t sizeInBytes)
+{
+    m_nodeCount++;
+    return m_memoryArena.allocateAligned(sizeInBytes, kAlignment);
+}
+
+/* static */ASTArena* ASTArena::getCurrent()
+{
+    return t_currentArena;
+}
+
+ASTArenaScope::ASTArenaScope(ASTArena* arena)
+{
+    m_previousArena = t_currentArena;
+    t_currentArena = arena;
+}
+
+ASTArenaScope::~ASTArenaScope()
+{
+    t_currentArena = m_previousArena;
+}
+
+/* static */const ASTAllocationStats& ASTAllocationStats::getForThread()
+{
+    return t_stats;
+}
+
+/* static */void* ASTNodeAllocator::allocate(size_t sizeInBytes)
+{
+    const size_t totalSize = kNodeHeaderSize + sizeInBytes;
+
+    ASTArena* arena = SLANG_ENABLE_AST_ARENA ? t_currentArena : nullptr;
+
+    void* mem;
+    if (arena)
+    {
+        mem = arena->allocate(totalSize);
+        // Released when the node is freed
+        arena->addReference();
+    }
+    else
+    {
+        mem = ::malloc(totalSize);
+    }
+    if (!mem)
+    {
+        throw std::bad_alloc();
+    }
+
+    NodeHeader* header = (NodeHeader*)mem;
+    header->arena = arena;
+    header->sizeInBytes = sizeInBytes;
+
+    ASTAllocationStats& stats = t_stats;
+    stats.nodeCount++;
+    stats.nodeBytes += Int(sizeInBytes);
+    stats.liveBytes += Int(sizeInBytes);
+    stats.peakLiveBytes = (stats.liveBytes > stats.peakLiveBytes) ? stats.liveBytes : stats.peakLiveBytes;
+
+    return (char*)mem + kNodeHeaderSize;
+}
+
+/* static */void ASTNodeAllocator::deallocate(void* ptr)
+{
+    if (!ptr)
+    {
+        return;
+    }
+
+    NodeHeader* header = (NodeHeader*)((char*)ptr - kNodeHeaderSize);
+
+    // A node may be freed on a different thread to the one that allocated it, in which
+    // case this thread's live count can go below zero. It's only used for reporting.
+    t_stats.liveBytes -= Int(header->sizeInBytes);
+
+    if (ASTArena* arena = header->arena)
+    {
+        // The memory itself is reclaimed when the arena is destroyed
+        arena->releaseReference();
+    }
+    else
+    {
+        ::free(header);
+    }
+}
+
+/* static */ASTArena* ASTNodeAllocator::getArena(const void* ptr)
+{
+    const NodeHeader* header = (const NodeHeader*)((const char*)ptr - kNodeHeaderSize);
+    return header->arena;
+}
+
+} // namespace Slang
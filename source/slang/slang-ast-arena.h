@@ -0,0 +1,86 @@
+// slang-ast-arena.h
+#ifndef SLANG_AST_ARENA_H_INCLUDED
+#define SLANG_AST_ARENA_H_INCLUDED
+
+#include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+
+// Set to 0 to allocate every AST node from the heap (for comparing against the arena)
+#ifndef SLANG_ENABLE_AST_ARENA
+#   define SLANG_ENABLE_AST_ARENA 1
+#endif
+
+namespace Slang {
+
+    /// Memory that AST nodes (all classes derived from `NodeBase`) are allocated from.
+    ///
+    /// Each `Module` owns an arena, and nodes created while parsing, checking or lowering
+    /// its translation unit are allocated from it (see `ASTArenaScope`). Nodes are still
+    /// reference counted, and every node allocated from an arena holds a reference to it.
+    /// The arena's memory is freed in bulk once the module and all of its nodes have been
+    /// released, so nodes that outlive the module (such as types cached by a session)
+    /// remain valid.
+class ASTArena : public RefObject
+{
+public:
+        /// Allocated memory is at least this aligned
+    static const size_t kAlignment = 16;
+
+        /// Allocate memory for a node. The memory is only freed when the arena is destroyed.
+    void* allocate(size_t sizeInBytes);
+
+        /// The number of nodes allocated from the arena
+    Index getNodeCount() const { return m_nodeCount; }
+        /// The number of bytes used by the arena (including unused space at the end of blocks)
+    size_t calcTotalMemoryUsed() const { return m_memoryArena.calcTotalMemoryUsed(); }
+
+        /// Get the arena nodes are allocated from on this thread, or nullptr if they are allocated from the heap
+    static ASTArena* getCurrent();
+
+        /// Ctor
+    ASTArena();
+
+protected:
+    friend struct ASTArenaScope;
+
+    MemoryArena m_memoryArena;
+    Index m_nodeCount = 0;
+};
+
+    /// Sets the arena AST nodes created on this thread are allocated from, for the lifetime of the scope.
+    /// Passing nullptr allocates nodes from the heap, for objects that must not keep an arena alive.
+struct ASTArenaScope
+{
+    ASTArenaScope(ASTArena* arena);
+    ~ASTArenaScope();
+
+protected:
+    ASTArena* m_previousArena;
+};
+
+    /// Counts of AST node allocations made on the current thread, from arenas and the heap.
+    /// Used to report the AST memory used by each phase of a compile (see `CompileProfileEvent`).
+struct ASTAllocationStats
+{
+    Int nodeCount = 0;              ///< The number of nodes allocated
+    Int nodeBytes = 0;              ///< The number of bytes allocated for nodes
+    Int liveBytes = 0;              ///< The number of bytes used by nodes allocated on this thread that have not been freed
+    Int peakLiveBytes = 0;          ///< The highest value of liveBytes
+
+        /// Get the stats for the current thread
+    static const ASTAllocationStats& getForThread();
+};
+
+    /// Implements the allocation of AST nodes (used by `NodeBase::operator new/delete`)
+struct ASTNodeAllocator
+{
+    static void* allocate(size_t sizeInBytes);
+    static void deallocate(void* ptr);
+
+        /// Get the arena the node at ptr was allocated from, or nullptr if it was allocated from the heap
+    static ASTArena* getArena(const void* ptr);
+};
+
+} // namespace Slang
+
+#endif
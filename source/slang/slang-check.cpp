@@ -4,6 +4,7 @@
 #include "slang-compiler.h"
 #include "slang-visitor.h"
 
+#include "../core/slang-io.h"
 #include "../core/slang-secure-crt.h"
 #include <assert.h>
 
@@ -99,6 +100,11 @@ namespace Slang
         //
         if(decl->HasModifier<HLSLGroupSharedModifier>()) return false;
 
+        // A specialization constant is set when the pipeline is created,
+        // rather than being bound like other parameters.
+        //
+        if(decl->HasModifier<SpecializationConstantAttribute>()) return false;
+
         return true;
     }
 
@@ -157,19 +163,6 @@ namespace Slang
         }
     };
 
-    struct BasicTypeKeyPair
-    {
-        BasicTypeKey type1, type2;
-        bool operator == (BasicTypeKeyPair p)
-        {
-            return type1.aggVal == p.type1.aggVal && type2.aggVal == p.type2.aggVal;
-        }
-        int GetHashCode()
-        {
-            return combineHash(type1.aggVal, type2.aggVal);
-        }
-    };
-
     struct OverloadCandidate
     {
         enum class Flavor
@@ -281,23 +274,212 @@ namespace Slang
         }
     };
 
+    // Identifies a type by its structure (rather than its address), so that
+    // structurally equal types can be found in `TypeCheckingCache::internedTypes`
+    struct InternedTypeKey
+    {
+        Type* type;
+        bool operator == (InternedTypeKey key)
+        {
+            return type == key.type || type->Equals(key.type);
+        }
+        int GetHashCode()
+        {
+            return type->GetHashCode();
+        }
+    };
+
+    // A pair of interned types, which can be compared by address
+    struct InternedTypePair
+    {
+        Type* toType;
+        Type* fromType;
+        bool operator == (InternedTypePair p)
+        {
+            return toType == p.toType && fromType == p.fromType;
+        }
+        int GetHashCode()
+        {
+            return combineHash(Slang::GetHashCode(toType), Slang::GetHashCode(fromType));
+        }
+    };
+
+    // Identifies a call to a (possibly overloaded) function by what the callee
+    // named and the interned types of the arguments (see `SemanticsVisitor::_makeOverloadCacheKey`)
+    struct OverloadResolutionCacheKey
+    {
+        struct Arg
+        {
+            Type* type;
+            bool isLeftValue;
+        };
+
+        List<DeclRef<Decl>> callees;
+        List<Arg> args;
+
+        bool operator == (const OverloadResolutionCacheKey& key)
+        {
+            if (callees.getCount() != key.callees.getCount() || args.getCount() != key.args.getCount())
+                return false;
+            for (Index i = 0; i < args.getCount(); ++i)
+            {
+                if (args[i].type != key.args[i].type || args[i].isLeftValue != key.args[i].isLeftValue)
+                    return false;
+            }
+            for (Index i = 0; i < callees.getCount(); ++i)
+            {
+                if (!callees[i].Equals(key.callees[i]))
+                    return false;
+            }
+            return true;
+        }
+        int GetHashCode()
+        {
+            int hash = 0;
+            for (auto& callee : callees)
+                hash = combineHash(hash, callee.GetHashCode());
+            for (auto& arg : args)
+                hash = combineHash(hash, combineHash(Slang::GetHashCode(arg.type), int(arg.isLeftValue)));
+            return hash;
+        }
+    };
+
+    struct CachedOverloadCandidate
+    {
+        OverloadCandidate candidate;
+            /// The `TypeCheckingCache::extensionEpoch` when the candidate was chosen
+        UInt extensionEpoch;
+    };
+
+    // Identifies the application of an extension to an interned type (see `SemanticsVisitor::ApplyExtensionToType`)
+    struct ExtensionApplicationKey
+    {
+        ExtensionDecl* extDecl;
+        Type* type;
+        bool operator == (ExtensionApplicationKey k)
+        {
+            return extDecl == k.extDecl && type == k.type;
+        }
+        int GetHashCode()
+        {
+            return combineHash(Slang::GetHashCode(extDecl), Slang::GetHashCode(type));
+        }
+    };
+
+    struct CachedExtensionApplication
+    {
+            /// The extension specialized for the type, or null if it doesn't apply
+        DeclRef<ExtensionDecl> extDeclRef;
+            /// The `TypeCheckingCache::extensionEpoch` when the extension didn't apply. An extension that
+            /// applies keeps applying, but one that doesn't may apply once the type has gained a conformance.
+        UInt extensionEpoch;
+    };
+
+    struct CachedDeclRefType
+    {
+        QualType type;
+            /// The type referred to, for a reference to a type declaration (see `SemanticsVisitor::typeResult`)
+        RefPtr<Type> typeResult;
+    };
+
+    struct CachedConversionCost
+    {
+        ConversionCost cost;
+            /// The `TypeCheckingCache::extensionEpoch` when the cost was found
+        UInt extensionEpoch;
+    };
+
+    struct CachedSubtypeWitness
+    {
+            /// The witness that the subtype is a subtype of the supertype, or null if it isn't
+        RefPtr<Val> witness;
+            /// The `TypeCheckingCache::extensionEpoch` when no witness was found. A type that conforms
+            /// keeps conforming, but one that doesn't may conform once an extension adds an inheritance declaration.
+        UInt extensionEpoch;
+    };
+
     struct TypeCheckingCache
     {
         Dictionary<OperatorOverloadCacheKey, OverloadCandidate> resolvedOperatorOverloadCache;
-        Dictionary<BasicTypeKeyPair, ConversionCost> conversionCostCache;
+        Dictionary<InternedTypePair, CachedConversionCost> conversionCostCache;
+
+            /// The witnesses found for a subtype (`fromType`) being a subtype of a supertype (`toType`),
+            /// as finding one means searching the inheritance and extension declarations of the subtype
+            /// (see `SemanticsVisitor::tryGetSubtypeWitness`)
+        Dictionary<InternedTypePair, CachedSubtypeWitness> subtypeWitnessCache;
+        Index subtypeWitnessCacheHitCount = 0;
+        Index subtypeWitnessCacheMissCount = 0;
+
+            /// The applicable candidate chosen for calls to functions (that aren't built-in operators
+            /// on basic types, see `resolvedOperatorOverloadCache`)
+        Dictionary<OverloadResolutionCacheKey, CachedOverloadCandidate> resolvedOverloadCache;
+        Index overloadCacheHitCount = 0;
+        Index overloadCacheMissCount = 0;
+
+            /// The types of references to members of specialized generics (such as a field of `Pair<float3>`),
+            /// which are found by substituting the generic arguments into the member's type (see
+            /// `SemanticsVisitor::GetTypeForDeclRef`). Keyed by the decl ref, which compares substitutions by value.
+        Dictionary<DeclRef<Decl>, CachedDeclRefType> declRefTypeCache;
+        Index declRefTypeCacheHitCount = 0;
+        Index declRefTypeCacheMissCount = 0;
+
+            /// Maps a canonical type to the single instance of all types structurally equal to it
+        Dictionary<InternedTypeKey, RefPtr<Type>> internedTypes;
+
+            /// The results of applying extensions to types, as every member lookup on a type
+            /// applies its candidate extensions (which means unifying and solving constraints)
+        Dictionary<ExtensionApplicationKey, CachedExtensionApplication> extensionApplicationCache;
+
+            /// Incremented whenever an extension is attached to a type. An extension can make
+            /// a conversion possible (by adding an inheritance declaration), so conversion costs
+            /// found before the extension was added can no longer be used.
+        UInt extensionEpoch = 0;
+
+            /// Get the interned instance of the canonical form of type.
+            /// Two types are equal if and only if their interned instances are the same object.
+        Type* internType(Type* type)
+        {
+            Type* canonicalType = type->GetCanonicalType();
+
+            InternedTypeKey key;
+            key.type = canonicalType;
+
+            RefPtr<Type> internedType;
+            if (internedTypes.TryGetValue(key, internedType))
+            {
+                return internedType;
+            }
+            internedTypes.Add(key, canonicalType);
+            return canonicalType;
+        }
     };
 
-    TypeCheckingCache* Session::getTypeCheckingCache()
+    TypeCheckingCache* Linkage::getTypeCheckingCache()
     {
-        if (!typeCheckingCache)
-            typeCheckingCache = new TypeCheckingCache();
-        return typeCheckingCache;
+        if (!m_typeCheckingCache)
+            m_typeCheckingCache = new TypeCheckingCache();
+        return m_typeCheckingCache;
     }
 
-    void Session::destroyTypeCheckingCache()
+    void Linkage::destroyTypeCheckingCache()
     {
-        delete typeCheckingCache;
-        typeCheckingCache = nullptr;
+        delete m_typeCheckingCache;
+        m_typeCheckingCache = nullptr;
+    }
+
+    size_t Linkage::_calcTypeCheckingCacheSize()
+    {
+        auto cache = m_typeCheckingCache;
+        if (!cache)
+            return 0;
+        return sizeof(TypeCheckingCache) +
+            cache->resolvedOperatorOverloadCache.calcMemoryUsed() +
+            cache->conversionCostCache.calcMemoryUsed() +
+            cache->subtypeWitnessCache.calcMemoryUsed() +
+            cache->resolvedOverloadCache.calcMemoryUsed() +
+            cache->declRefTypeCache.calcMemoryUsed() +
+            cache->internedTypes.calcMemoryUsed() +
+            cache->extensionApplicationCache.calcMemoryUsed();
     }
 
     namespace { // anonymous
@@ -325,14 +507,18 @@ namespace Slang
 
     ISlangSharedLibrary* Session::getOrLoadSharedLibrary(SharedLibraryType type, DiagnosticSink* sink)
     {
+        // If the library is being preloaded, this waits for it to be loaded
+        std::lock_guard<std::mutex> lock(m_sharedLibraryMutex);
+
         // If not loaded, try loading it
         if (!sharedLibraries[int(type)])
         {
             // Try to preload dxil first, if loading dxc
-            if (type == SharedLibraryType::Dxc)
+            if (type == SharedLibraryType::Dxc && !sharedLibraries[int(SharedLibraryType::Dxil)])
             {
-                // Pass nullptr as the sink, because if it fails we don't want to report as error
-                getOrLoadSharedLibrary(SharedLibraryType::Dxil, nullptr);
+                // If it fails we don't want to report as error
+                const char* dxilName = DefaultSharedLibraryLoader::getSharedLibraryNameFromType(SharedLibraryType::Dxil);
+                sharedLibraryLoader->loadSharedLibrary(dxilName, sharedLibraries[int(SharedLibraryType::Dxil)].writeRef());
             }
 
             const char* libName = DefaultSharedLibraryLoader::getSharedLibraryNameFromType(type);
@@ -348,6 +534,42 @@ namespace Slang
         return sharedLibraries[int(type)];
     }
 
+    void Session::preloadSharedLibraries(const SharedLibraryType* types, Index typeCount)
+    {
+        // Only one preload runs at a time
+        waitForSharedLibraryPreload();
+
+        List<SharedLibraryType> typesToLoad;
+        for (Index i = 0; i < typeCount; ++i)
+        {
+            if (types[i] != SharedLibraryType::Unknown && !getSharedLibrary(types[i]) && typesToLoad.indexOf(types[i]) < 0)
+            {
+                typesToLoad.add(types[i]);
+            }
+        }
+        if (typesToLoad.getCount() == 0)
+        {
+            return;
+        }
+
+        // Each library is loaded under the lock separately, so a compile that needs one library
+        // doesn't wait for the others to load
+        m_sharedLibraryPreloadThread = std::thread([this, typesToLoad]() {
+            for (SharedLibraryType type : typesToLoad)
+            {
+                getOrLoadSharedLibrary(type, nullptr);
+            }
+        });
+    }
+
+    void Session::waitForSharedLibraryPreload()
+    {
+        if (m_sharedLibraryPreloadThread.joinable())
+        {
+            m_sharedLibraryPreloadThread.join();
+        }
+    }
+
     SlangFuncPtr Session::getSharedLibraryFunc(SharedLibraryFuncType type, DiagnosticSink* sink)
     {
         if (sharedLibraryFunctions[int(type)])
@@ -381,6 +603,33 @@ namespace Slang
         return func;
     }
 
+    String Session::getSharedLibraryFuncIdentity(SharedLibraryFuncType type)
+    {
+        if (!sharedLibraryFunctionHasIdentity[int(type)])
+        {
+            // Hashing the whole file is only done once for the session, and is small next to a downstream compile
+            String identity;
+            String path;
+            SlangFuncPtr func = sharedLibraryFunctions[int(type)];
+            if (func && SLANG_SUCCEEDED(SharedLibrary::getPathForFunc(func, path)))
+            {
+                try
+                {
+                    const List<unsigned char> contents = File::readAllBytes(path);
+                    StringBuilder builder;
+                    builder << uint64_t(contents.getCount()) << " " << GetHashCode64((const char*)contents.getBuffer(), size_t(contents.getCount()));
+                    identity = builder;
+                }
+                catch (IOException&)
+                {
+                }
+            }
+            sharedLibraryFunctionIdentities[int(type)] = identity;
+            sharedLibraryFunctionHasIdentity[int(type)] = true;
+        }
+        return sharedLibraryFunctionIdentities[int(type)];
+    }
+
 
     enum class CheckingPhase
     {
@@ -404,6 +653,10 @@ namespace Slang
         Linkage* m_linkage = nullptr;
         DiagnosticSink* m_sink = nullptr;
 
+        // If set, the bodies of global functions are not checked with the rest of the module, only when
+        // they are referenced (see SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING)
+        bool m_deferGlobalFunctionBodies = false;
+
         DiagnosticSink* getSink()
         {
             return m_sink;
@@ -2203,27 +2456,28 @@ namespace Slang
             RefPtr<Type>    fromType,
             ConversionCost* outCost = 0)
         {
-            // As an optimization, we will maintain a cache of conversion results
-            // for basic types such as scalars and vectors.
+            // As an optimization, we will maintain a cache of conversion results,
+            // keyed on the interned forms of the two types (so that the key can be
+            // compared by address).
             //
-            BasicTypeKey key1, key2;
-            BasicTypeKeyPair cacheKey;
+            InternedTypePair cacheKey;
             bool shouldAddToCache = false;
             ConversionCost cost;
-            TypeCheckingCache* typeCheckingCache = getSession()->getTypeCheckingCache();
-            if( key1.fromType(toType.Ptr()) && key2.fromType(fromType.Ptr()) )
+            TypeCheckingCache* typeCheckingCache = m_linkage->getTypeCheckingCache();
+            if( toType && fromType )
             {
-                cacheKey.type1 = key1;
-                cacheKey.type2 = key2;
+                cacheKey.toType = typeCheckingCache->internType(toType);
+                cacheKey.fromType = typeCheckingCache->internType(fromType);
 
-                if (typeCheckingCache->conversionCostCache.TryGetValue(cacheKey, cost))
+                CachedConversionCost cached;
+                if (typeCheckingCache->conversionCostCache.TryGetValue(cacheKey, cached) &&
+                    cached.extensionEpoch == typeCheckingCache->extensionEpoch)
                 {
                     if (outCost)
-                        *outCost = cost;
-                    return cost != kConversionCost_Impossible;
+                        *outCost = cached.cost;
+                    return cached.cost != kConversionCost_Impossible;
                 }
-                else
-                    shouldAddToCache = true;
+                shouldAddToCache = true;
             }
 
             // If there was no suitable entry in the cache,
@@ -2247,9 +2501,10 @@ namespace Slang
 
             if (shouldAddToCache)
             {
-                if (!rs)
-                    cost = kConversionCost_Impossible;
-                typeCheckingCache->conversionCostCache[cacheKey] = cost;
+                CachedConversionCost cached;
+                cached.cost = rs ? cost : kConversionCost_Impossible;
+                cached.extensionEpoch = typeCheckingCache->extensionEpoch;
+                typeCheckingCache->conversionCostCache[cacheKey] = cached;
             }
 
             return rs;
@@ -2669,6 +2924,9 @@ namespace Slang
             // add the attribute class definition to the syntax tree, so it can be found
             structAttribDef->ParentDecl->Members.add(attribDecl.Ptr());
             structAttribDef->ParentDecl->memberDictionaryIsValid = false;
+            // The list of declarations with the same name was changed above, so the
+            // dictionary has to be rebuilt rather than just have the new member added
+            structAttribDef->ParentDecl->memberDictionaryMemberCount = 0;
             // do necessary checks on this newly constructed node
             checkDecl(attribDecl.Ptr());
             return attribDecl.Ptr();
@@ -2766,6 +3024,15 @@ namespace Slang
                     bindingAttr->binding = int32_t(binding->value);
                     bindingAttr->set = int32_t(set->value);
                 }
+                else if (auto specConstantAttr = as<SpecializationConstantAttribute>(attr))
+                {
+                    SLANG_ASSERT(attr->args.getCount() == 1);
+                    auto val = checkConstantIntVal(attr->args[0]);
+
+                    if(!val) return false;
+
+                    specConstantAttr->id = (int32_t)val->value;
+                }
                 else if (auto maxVertexCountAttr = as<MaxVertexCountAttribute>(attr))
                 {
                     SLANG_ASSERT(attr->args.getCount() == 1);
@@ -3242,10 +3509,16 @@ namespace Slang
                 {
                     checkDecl(s.Ptr());
                 }
+                // The bodies of global functions can be left until they are referenced. Checking the
+                // body of anything else will then check the bodies of the functions it references.
+                const bool deferFunctionBodies = m_deferGlobalFunctionBodies && checkingPhase == CheckingPhase::Body;
+
                 // HACK(tfoley): Visiting all generic declarations here,
                 // because otherwise they won't get visited.
                 for (auto & g : programNode->getMembersOfType<GenericDecl>())
                 {
+                    if (deferFunctionBodies && as<FuncDecl>(g->inner))
+                        continue;
                     checkDecl(g.Ptr());
                 }
 
@@ -3261,9 +3534,12 @@ namespace Slang
                         VisitFunctionDeclaration(func.Ptr());
                     }
                 }
-                for (auto & func : programNode->getMembersOfType<FuncDecl>())
+                if (!deferFunctionBodies)
                 {
-                    checkDecl(func);
+                    for (auto & func : programNode->getMembersOfType<FuncDecl>())
+                    {
+                        checkDecl(func);
+                    }
                 }
 
                 if (getSink()->GetErrorCount() != 0)
@@ -3274,6 +3550,8 @@ namespace Slang
                 // because we'd end up recursing into this very code path...
                 for (auto d : programNode->Members)
                 {
+                    if (deferFunctionBodies && getUncheckedGlobalFunction(d))
+                        continue;
                     EnusreAllDeclsRec(d);
                 }
 
@@ -4827,6 +5105,14 @@ namespace Slang
             //
             dispatchDecl(stmt->decl);
             checkModifiers(stmt->decl);
+
+            // The modifiers of a local weren't checked when its declaration was,
+            // so a local marked as a specialization constant is caught here.
+            if (auto varDecl = as<VarDecl>(stmt->decl))
+            {
+                if (auto specConstantAttr = varDecl->FindModifier<SpecializationConstantAttribute>())
+                    checkSpecializationConstant(varDecl, specConstantAttr);
+            }
         }
 
         void visitBlockStmt(BlockStmt* stmt)
@@ -5123,6 +5409,59 @@ namespace Slang
         void visitVarDecl(VarDecl* varDecl)
         {
             CheckVarDeclCommon(varDecl);
+
+            if (checkingPhase == CheckingPhase::Body)
+            {
+                if (auto specConstantAttr = varDecl->FindModifier<SpecializationConstantAttribute>())
+                    checkSpecializationConstant(varDecl, specConstantAttr);
+            }
+        }
+
+            /// Check that a variable marked `[[vk::constant_id(...)]]` can be a specialization
+            /// constant, and record the value of its initializer as the default value.
+        void checkSpecializationConstant(VarDecl* varDecl, SpecializationConstantAttribute* attr)
+        {
+            if (!as<ModuleDecl>(varDecl->ParentDecl) || !varDecl->HasModifier<ConstModifier>())
+            {
+                getSink()->diagnose(varDecl, Diagnostics::specializationConstantMustBeGlobalConst, varDecl->getName());
+                return;
+            }
+
+            auto basicType = as<BasicExpressionType>(varDecl->getType());
+            if (!basicType)
+            {
+                getSink()->diagnose(varDecl, Diagnostics::invalidSpecializationConstantType, varDecl->getName(), varDecl->getType());
+                return;
+            }
+            switch (basicType->baseType)
+            {
+                case BaseType::Bool:
+                case BaseType::Int:
+                case BaseType::UInt:
+                    break;
+                default:
+                    getSink()->diagnose(varDecl, Diagnostics::invalidSpecializationConstantType, varDecl->getName(), varDecl->getType());
+                    return;
+            }
+
+            // The initializer gives the value used when the application doesn't
+            // specialize the constant, so it has to be known now
+            RefPtr<IntVal> defaultVal;
+            Expr* initExpr = varDecl->initExpr;
+            while (auto castExpr = as<TypeCastExpr>(initExpr))
+                initExpr = castExpr->Arguments[0];
+            if (auto boolLitExpr = as<BoolLiteralExpr>(initExpr))
+                defaultVal = new ConstantIntVal(boolLitExpr->value ? 1 : 0);
+            else if (initExpr)
+                defaultVal = TryConstantFoldExpr(initExpr);
+
+            auto constantVal = as<ConstantIntVal>(defaultVal);
+            if (!constantVal)
+            {
+                getSink()->diagnose(varDecl, Diagnostics::specializationConstantNeedsConstantInitializer, varDecl->getName());
+                return;
+            }
+            attr->defaultValue = constantVal->value;
         }
 
         void visitWhileStmt(WhileStmt *stmt)
@@ -5345,6 +5684,11 @@ namespace Slang
                 {
                     auto varDecl = varRef.getDecl();
 
+                    // A specialization constant's value isn't known until the pipeline is
+                    // created, so it can't be folded here.
+                    if(varDecl->HasModifier<SpecializationConstantAttribute>())
+                        return nullptr;
+
                     // In HLSL, `static const` is used to mark compile-time constant expressions
                     if(auto staticAttr = varDecl->FindModifier<HLSLStaticModifier>())
                     {
@@ -5713,6 +6057,8 @@ namespace Slang
                     auto aggTypeDecl = aggTypeDeclRef.getDecl();
                     decl->nextCandidateExtension = aggTypeDecl->candidateExtensions;
                     aggTypeDecl->candidateExtensions = decl;
+
+                    m_linkage->getTypeCheckingCache()->extensionEpoch++;
                     return;
                 }
             }
@@ -7015,19 +7361,42 @@ namespace Slang
                 return createTypeEqualityWitness(sub);
             }
 
-            if(auto supDeclRefType = as<DeclRefType>(sup))
+            auto supDeclRefType = as<DeclRefType>(sup);
+            if(!supDeclRefType)
+                return nullptr;
+            auto supInterfaceDeclRef = supDeclRefType->declRef.as<InterfaceDecl>();
+            if(!supInterfaceDeclRef)
+                return nullptr;
+
+            // The conformance of an interface type to its bases can depend on its this-type
+            // substitution (as with applying extensions), so isn't cached
+            auto subDeclRefType = as<DeclRefType>(sub);
+            if(subDeclRefType && subDeclRefType->declRef.as<InterfaceDecl>())
+                return tryGetInterfaceConformanceWitness(sub, supInterfaceDeclRef);
+
+            // Searching for a conformance walks the inheritance and extension declarations
+            // of the subtype, so the result is cached on the interned forms of the two types
+            //
+            TypeCheckingCache* typeCheckingCache = m_linkage->getTypeCheckingCache();
+            InternedTypePair cacheKey;
+            cacheKey.toType = typeCheckingCache->internType(sup);
+            cacheKey.fromType = typeCheckingCache->internType(sub);
+
+            if(auto cached = typeCheckingCache->subtypeWitnessCache.TryGetValue(cacheKey))
             {
-                auto supDeclRef = supDeclRefType->declRef;
-                if(auto supInterfaceDeclRef = supDeclRef.as<InterfaceDecl>())
+                if(cached->witness || cached->extensionEpoch == typeCheckingCache->extensionEpoch)
                 {
-                    if(auto witness = tryGetInterfaceConformanceWitness(sub, supInterfaceDeclRef))
-                    {
-                        return witness;
-                    }
+                    typeCheckingCache->subtypeWitnessCacheHitCount++;
+                    return cached->witness;
                 }
             }
+            typeCheckingCache->subtypeWitnessCacheMissCount++;
 
-            return nullptr;
+            CachedSubtypeWitness cached;
+            cached.witness = tryGetInterfaceConformanceWitness(sub, supInterfaceDeclRef);
+            cached.extensionEpoch = typeCheckingCache->extensionEpoch;
+            typeCheckingCache->subtypeWitnessCache[cacheKey] = cached;
+            return cached.witness;
         }
 
         // In the case where we are explicitly applying a generic
@@ -7775,6 +8144,39 @@ namespace Slang
         DeclRef<ExtensionDecl> ApplyExtensionToType(
             ExtensionDecl*  extDecl,
             RefPtr<Type>    type)
+        {
+            // Applying an extension to an interface type can depend on its this-type substitution,
+            // which isn't part of the type's identity, so isn't cached
+            auto declRefType = as<DeclRefType>(type);
+            if (!declRefType || declRefType->declRef.as<InterfaceDecl>())
+            {
+                return _applyExtensionToType(extDecl, type);
+            }
+
+            auto typeCheckingCache = m_linkage->getTypeCheckingCache();
+
+            ExtensionApplicationKey key;
+            key.extDecl = extDecl;
+            key.type = typeCheckingCache->internType(type);
+
+            if (auto cached = typeCheckingCache->extensionApplicationCache.TryGetValue(key))
+            {
+                if (cached->extDeclRef || cached->extensionEpoch == typeCheckingCache->extensionEpoch)
+                {
+                    return cached->extDeclRef;
+                }
+            }
+
+            CachedExtensionApplication application;
+            application.extDeclRef = _applyExtensionToType(extDecl, type);
+            application.extensionEpoch = typeCheckingCache->extensionEpoch;
+            typeCheckingCache->extensionApplicationCache[key] = application;
+            return application.extDeclRef;
+        }
+
+        DeclRef<ExtensionDecl> _applyExtensionToType(
+            ExtensionDecl*  extDecl,
+            RefPtr<Type>    type)
         {
             DeclRef<ExtensionDecl> extDeclRef = makeDeclRef(extDecl);
 
@@ -8372,6 +8774,58 @@ namespace Slang
         }
 #endif
 
+            /// Make the key for a call in `TypeCheckingCache::resolvedOverloadCache`.
+            ///
+            /// Returns false if the result of resolving the call could depend on more than the
+            /// declarations the callee refers to and the argument types, such as a call to a
+            /// member, or with arguments that are themselves overloaded.
+        bool _makeOverloadCacheKey(
+            Expr*                       funcExpr,
+            OverloadResolveContext&     context,
+            TypeCheckingCache*          typeCheckingCache,
+            OverloadResolutionCacheKey& outKey)
+        {
+            if (context.baseExpr)
+                return false;
+
+            if (auto overloadedExpr = as<OverloadedExpr>(funcExpr))
+            {
+                if (overloadedExpr->base)
+                    return false;
+                for (auto item : overloadedExpr->lookupResult2)
+                {
+                    if (item.breadcrumbs)
+                        return false;
+                    outKey.callees.add(item.declRef);
+                }
+            }
+            else if (auto declRefExpr = as<DeclRefExpr>(funcExpr))
+            {
+                // Member expressions and the like have a base expression the call depends on
+                if (!as<VarExpr>(declRefExpr))
+                    return false;
+                outKey.callees.add(declRefExpr->declRef);
+            }
+            else
+            {
+                return false;
+            }
+
+            for (Index i = 0; i < context.getArgCount(); ++i)
+            {
+                auto arg = context.getArg(i);
+                Type* argType = arg->type.type;
+                if (!argType || as<OverloadGroupType>(argType) || as<InitializerListType>(argType) || as<ErrorType>(argType))
+                    return false;
+
+                OverloadResolutionCacheKey::Arg keyArg;
+                keyArg.type = typeCheckingCache->internType(argType);
+                keyArg.isLeftValue = arg->type.IsLeftValue;
+                outKey.args.add(keyArg);
+            }
+            return true;
+        }
+
         RefPtr<Expr> ResolveInvoke(InvokeExpr * expr)
         {
             OverloadResolveContext context;
@@ -8379,7 +8833,7 @@ namespace Slang
             // to speed up compilation
             bool shouldAddToCache = false;
             OperatorOverloadCacheKey key;
-            TypeCheckingCache* typeCheckingCache = getSession()->getTypeCheckingCache();
+            TypeCheckingCache* typeCheckingCache = m_linkage->getTypeCheckingCache();
             if (auto opExpr = as<OperatorExpr>(expr))
             {
                 if (key.fromOperatorExpr(opExpr))
@@ -8435,6 +8889,28 @@ namespace Slang
                 context.baseExpr = funcOverloadExpr2->base;
             }
 
+            // Calls that aren't covered by the operator cache can be looked up by the
+            // callee and argument types
+            bool shouldAddToOverloadCache = false;
+            OverloadResolutionCacheKey overloadKey;
+            if (!context.bestCandidate && !shouldAddToCache &&
+                _makeOverloadCacheKey(funcExpr, context, typeCheckingCache, overloadKey))
+            {
+                CachedOverloadCandidate cached;
+                if (typeCheckingCache->resolvedOverloadCache.TryGetValue(overloadKey, cached) &&
+                    cached.extensionEpoch == typeCheckingCache->extensionEpoch)
+                {
+                    context.bestCandidateStorage = cached.candidate;
+                    context.bestCandidate = &context.bestCandidateStorage;
+                    typeCheckingCache->overloadCacheHitCount++;
+                }
+                else
+                {
+                    shouldAddToOverloadCache = true;
+                    typeCheckingCache->overloadCacheMissCount++;
+                }
+            }
+
             if (!context.bestCandidate)
             {
                 AddOverloadCandidates(funcExpr, context);
@@ -8539,6 +9015,15 @@ namespace Slang
                 // the user the most help we can.
                 if (shouldAddToCache)
                     typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+                // Only applicable candidates are memoized, so that errors are always reported
+                // from a full resolution
+                if (shouldAddToOverloadCache && context.bestCandidate->status == OverloadCandidate::Status::Applicable)
+                {
+                    CachedOverloadCandidate cached;
+                    cached.candidate = *context.bestCandidate;
+                    cached.extensionEpoch = typeCheckingCache->extensionEpoch;
+                    typeCheckingCache->resolvedOverloadCache[overloadKey] = cached;
+                }
                 return CompleteOverloadCandidate(context, *context.bestCandidate);
             }
             else
@@ -8864,12 +9349,65 @@ namespace Slang
         // Get the type to use when referencing a declaration
         QualType GetTypeForDeclRef(DeclRef<Decl> declRef)
         {
-            return getTypeForDeclRef(
+            if (!_isSpecializedGenericMember(declRef))
+            {
+                return getTypeForDeclRef(
+                    getSession(),
+                    this,
+                    getSink(),
+                    declRef,
+                    &typeResult);
+            }
+
+            // Referencing a member of a specialized generic substitutes the generic
+            // arguments into the member's type, which creates new types every time,
+            // so the result is cached for each member and set of arguments.
+            auto typeCheckingCache = getLinkage()->getTypeCheckingCache();
+            if (auto cached = typeCheckingCache->declRefTypeCache.TryGetValue(declRef))
+            {
+                typeCheckingCache->declRefTypeCacheHitCount++;
+                typeResult = cached->typeResult;
+                return cached->type;
+            }
+            typeCheckingCache->declRefTypeCacheMissCount++;
+
+            CachedDeclRefType entry;
+            entry.type = getTypeForDeclRef(
                 getSession(),
                 this,
                 getSink(),
                 declRef,
-                &typeResult);
+                &entry.typeResult);
+
+            // A declaration that is still being checked (because it is referenced
+            // from its own declaration) may not have its type yet.
+            if (declRef.getDecl()->IsChecked(DeclCheckState::CheckedHeader))
+            {
+                typeCheckingCache->declRefTypeCache.Add(declRef, entry);
+            }
+            if (entry.typeResult)
+            {
+                typeResult = entry.typeResult;
+            }
+            return entry.type;
+        }
+
+            /// True if declRef is a field, function or type declared in a generic, specialized
+            /// only with generic arguments, so the type of a reference to it only depends on the
+            /// declaration and the arguments
+        static bool _isSpecializedGenericMember(DeclRef<Decl> const& declRef)
+        {
+            if (!declRef.substitutions)
+                return false;
+            for (auto subst = declRef.substitutions.substitutions; subst; subst = subst->outer)
+            {
+                // A `this` type substitution may be resolved through a witness table,
+                // which can be filled in later on
+                if (!subst.as<GenericSubstitution>())
+                    return false;
+            }
+            auto decl = declRef.getDecl();
+            return as<VarDeclBase>(decl) || as<CallableDecl>(decl) || as<AggTypeDecl>(decl) || as<TypeDefDecl>(decl);
         }
 
         //
@@ -10698,7 +11236,8 @@ static bool doesParameterMatch(
         Linkage*                    linkage,
         ExistentialTypeSlots&           ioSlots,
         List<RefPtr<Expr>> const&   args,
-        DiagnosticSink*             sink)
+        DiagnosticSink*             sink,
+        ExistentialWitnessCache*    witnessCache = nullptr)
     {
         Index slotCount = ioSlots.paramTypes.getCount();
         Index argCount = args.getCount();
@@ -10727,7 +11266,25 @@ static bool doesParameterMatch(
             }
 
 
-            auto witness = visitor.tryGetSubtypeWitness(argType, slotType);
+            // When many programs are being specialized for the same slots, the
+            // same argument type is usually given for a slot many times over, so
+            // the witness found the first time is reused.
+            //
+            RefPtr<Val> witness;
+            Dictionary<Type*, RefPtr<Val>>* slotWitnesses = nullptr;
+            if( witnessCache )
+            {
+                if( witnessCache->getCount() < slotCount )
+                    witnessCache->setCount(slotCount);
+                slotWitnesses = &(*witnessCache)[ii];
+                slotWitnesses->TryGetValue(argType, witness);
+            }
+            if( !witness )
+            {
+                witness = visitor.tryGetSubtypeWitness(argType, slotType);
+                if( witness && slotWitnesses )
+                    slotWitnesses->Add(argType, witness);
+            }
             if (!witness)
             {
                 // If no witness was found, then we will be unable to satisfy
@@ -10901,9 +11458,18 @@ static bool doesParameterMatch(
 
     void Program::_specializeExistentialTypeParams(
         List<RefPtr<Expr>> const&   args,
-        DiagnosticSink*             sink)
+        DiagnosticSink*             sink,
+        ExistentialWitnessCache*    witnessCache)
+    {
+        Slang::_specializeExistentialTypeParams(getLinkageImpl(), m_globalExistentialSlots, args, sink, witnessCache);
+    }
+
+    void Program::_copyShaderParams(Program* program)
     {
-        Slang::_specializeExistentialTypeParams(getLinkageImpl(), m_globalExistentialSlots, args, sink);
+        SLANG_ASSERT(m_shaderParams.getCount() == 0);
+
+        m_shaderParams = program->m_shaderParams;
+        m_globalExistentialSlots.paramTypes = program->m_globalExistentialSlots.paramTypes;
     }
 
     Type* Linkage::specializeType(
@@ -11230,6 +11796,132 @@ static bool doesParameterMatch(
         return SLANG_OK;
     }
 
+    SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::specializeProgramBatch(
+        slang::IProgram*                inUnspecializedProgram,
+        SlangInt                        specializationSetCount,
+        SlangInt                        specializationArgCount,
+        slang::SpecializationArg const* specializationArgs,
+        slang::SpecializeBatchFlags     flags,
+        slang::IProgram**               outSpecializedPrograms,
+        ISlangBlob**                    outDiagnostics)
+    {
+        auto unspecializedProgram = asInternal(inUnspecializedProgram);
+        if( specializationSetCount < 0 || specializationArgCount < 0 )
+            return SLANG_E_INVALID_ARG;
+
+        // The argument expressions are made once for each distinct type, rather
+        // than once for every argument of every set.
+        //
+        Dictionary<Type*, RefPtr<Expr>> argExprs;
+        List<RefPtr<Expr>> globalExistentialArgs;
+        for( Int ii = 0; ii < specializationSetCount * specializationArgCount; ++ii )
+        {
+            auto& specializationArg = specializationArgs[ii];
+            if( specializationArg.kind != slang::SpecializationArg::Kind::Type )
+                return SLANG_E_INVALID_ARG;
+
+            auto typeArg = asInternal(specializationArg.type);
+            RefPtr<Expr> argExpr;
+            if( !argExprs.TryGetValue(typeArg, argExpr) )
+            {
+                RefPtr<SharedTypeExpr> typeExpr = new SharedTypeExpr();
+                typeExpr->base = TypeExp(typeArg);
+                typeExpr->type = QualType(getTypeType(typeArg));
+                argExpr = typeExpr;
+                argExprs.Add(typeArg, argExpr);
+            }
+            globalExistentialArgs.add(argExpr);
+        }
+
+        DiagnosticSink sink(getSourceManager());
+        List<RefPtr<Program>> specializedPrograms;
+
+        if( specializationArgCount == 0 )
+        {
+            // As for `specializeProgram`, there is nothing to specialize
+            for( Int ii = 0; ii < specializationSetCount; ++ii )
+                specializedPrograms.add(unspecializedProgram);
+        }
+        else
+        {
+            List<RefPtr<Expr>> globalGenericArgs;
+            ExistentialWitnessCache witnessCache;
+
+            RefPtr<Program> firstProgram;
+            for( Int ii = 0; ii < specializationSetCount; ++ii )
+            {
+                List<RefPtr<Expr>> setArgs;
+                setArgs.addRange(globalExistentialArgs.getBuffer() + ii * specializationArgCount, specializationArgCount);
+
+                RefPtr<Program> specializedProgram;
+                if( !firstProgram )
+                {
+                    // The first program is specialized in the same way as by `specializeProgram`,
+                    // and the checking of global generic parameters, and the shader parameters it
+                    // finds, are reused for all of the programs after it.
+                    //
+                    specializedProgram = _createSpecializedProgramImpl(
+                        this,
+                        unspecializedProgram,
+                        globalGenericArgs,
+                        setArgs,
+                        &sink);
+                    if( !specializedProgram )
+                        break;
+
+                    for( auto entryPointGroup : unspecializedProgram->getEntryPointGroups() )
+                        specializedProgram->addEntryPointGroup(entryPointGroup);
+                    specializedProgram->_collectShaderParams(&sink);
+
+                    firstProgram = specializedProgram;
+                }
+                else
+                {
+                    specializedProgram = new Program(this);
+                    for( auto module : firstProgram->getModuleDependencies() )
+                        specializedProgram->addReferencedLeafModule(module);
+                    specializedProgram->setGlobalGenericSubsitution(firstProgram->getGlobalGenericSubstitution());
+
+                    for( auto entryPointGroup : unspecializedProgram->getEntryPointGroups() )
+                        specializedProgram->addEntryPointGroup(entryPointGroup);
+                    specializedProgram->_copyShaderParams(firstProgram);
+                }
+
+                specializedProgram->_specializeExistentialTypeParams(setArgs, &sink, &witnessCache);
+                specializedPrograms.add(specializedProgram);
+            }
+        }
+
+        if( sink.GetErrorCount() == 0 && specializedPrograms.getCount() == specializationSetCount )
+        {
+            if( flags & (slang::kSpecializeBatchFlag_Layout | slang::kSpecializeBatchFlag_GenerateCode) )
+            {
+                // The programs are all laid out before any code is generated, so the
+                // struct layouts they share are found in the layout cache by all but the first.
+                //
+                for( auto specializedProgram : specializedPrograms )
+                {
+                    for( auto target : targets )
+                        specializedProgram->getTargetProgram(target)->getOrCreateLayout(&sink);
+                }
+            }
+            if( (flags & slang::kSpecializeBatchFlag_GenerateCode) && sink.GetErrorCount() == 0 )
+            {
+                generateEntryPointCodeWithJobs(specializedPrograms, 0, &sink);
+            }
+        }
+
+        sink.getBlobIfNeeded(outDiagnostics);
+        if( sink.GetErrorCount() != 0 || specializedPrograms.getCount() != specializationSetCount )
+            return SLANG_FAIL;
+
+        for( Int ii = 0; ii < specializationSetCount; ++ii )
+        {
+            outSpecializedPrograms[ii] = ComPtr<slang::IProgram>(asExternal(specializedPrograms[ii])).detach();
+        }
+        return SLANG_OK;
+    }
+
         /// Specialize an entry point that was checked by the front-end, based on generic arguments.
         ///
         /// If the end-to-end compile request included generic argument strings
@@ -11371,14 +12063,96 @@ static bool doesParameterMatch(
     void checkTranslationUnit(
         TranslationUnitRequest* translationUnit)
     {
+        // Nodes created while checking (such as types and substitutions) are allocated from the module's arena
+        ASTArenaScope arenaScope(translationUnit->getModule()->getASTArena());
+
         SemanticsVisitor visitor(
             translationUnit->compileRequest->getLinkage(),
             translationUnit->compileRequest->getSink());
+        visitor.m_deferGlobalFunctionBodies = (translationUnit->compileRequest->compileFlags & SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING) != 0;
 
         // Apply the visitor to do the main semantic
         // checking that is required on all declarations
         // in the translation unit.
         visitor.checkDecl(translationUnit->getModuleDecl());
+
+        auto linkage = translationUnit->compileRequest->getLinkage();
+        if (auto profiler = linkage->getProfiler())
+        {
+            auto typeCheckingCache = linkage->getTypeCheckingCache();
+            profiler->addCounter("overload-cache-hits", typeCheckingCache->overloadCacheHitCount);
+            profiler->addCounter("overload-cache-misses", typeCheckingCache->overloadCacheMissCount);
+            profiler->addCounter("decl-ref-type-cache-hits", typeCheckingCache->declRefTypeCacheHitCount);
+            profiler->addCounter("decl-ref-type-cache-misses", typeCheckingCache->declRefTypeCacheMissCount);
+            profiler->addCounter("subtype-witness-cache-hits", typeCheckingCache->subtypeWitnessCacheHitCount);
+            profiler->addCounter("subtype-witness-cache-misses", typeCheckingCache->subtypeWitnessCacheMissCount);
+        }
+    }
+
+    FuncDecl* getUncheckedGlobalFunction(Decl* decl)
+    {
+        Decl* inner = decl;
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            inner = genericDecl->inner;
+        }
+        auto funcDecl = as<FuncDecl>(inner);
+        return (funcDecl && !funcDecl->IsChecked(DeclCheckState::Checked)) ? funcDecl : nullptr;
+    }
+
+    void checkReachableFunctionBodies(
+        TranslationUnitRequest* translationUnit)
+    {
+        ASTArenaScope arenaScope(translationUnit->getModule()->getASTArena());
+
+        SemanticsVisitor visitor(
+            translationUnit->compileRequest->getLinkage(),
+            translationUnit->compileRequest->getSink());
+        visitor.checkingPhase = CheckingPhase::Body;
+
+        auto moduleDecl = translationUnit->getModuleDecl();
+
+        // Without entry points the module is being compiled as a library (or just for
+        // its diagnostics), so every function can be reached
+        if (translationUnit->entryPoints.getCount() == 0)
+        {
+            for (auto decl : moduleDecl->Members)
+            {
+                if (getUncheckedGlobalFunction(decl))
+                    visitor.EnusreAllDeclsRec(decl);
+            }
+            return;
+        }
+
+        // Checking a body checks the bodies of the functions it references, so only the roots are needed
+        for (auto entryPoint : translationUnit->entryPoints)
+        {
+            auto funcDecl = entryPoint->getFuncDecl();
+            visitor.checkDecl(funcDecl);
+
+            // The patch constant function is referenced by name, not from the body
+            if (auto attr = funcDecl->FindModifier<PatchConstantFuncAttribute>())
+            {
+                if (attr->patchConstantFuncDecl)
+                    visitor.checkDecl(attr->patchConstantFuncDecl);
+            }
+        }
+        for (auto decl : moduleDecl->Members)
+        {
+            auto funcDecl = getUncheckedGlobalFunction(decl);
+            if (funcDecl && funcDecl->HasModifier<ExportedModifier>())
+                visitor.EnusreAllDeclsRec(decl);
+        }
+
+        if (auto profiler = translationUnit->compileRequest->getLinkage()->getProfiler())
+        {
+            Int uncheckedCount = 0;
+            for (auto decl : moduleDecl->Members)
+            {
+                uncheckedCount += getUncheckedGlobalFunction(decl) ? 1 : 0;
+            }
+            profiler->addCounter("unchecked-functions", uncheckedCount);
+        }
     }
 
 
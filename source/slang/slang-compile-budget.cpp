@@ -0,0 +1,71 @@
+// slang-compile-budget.cpp
+#include "slang-compile-budget.h"
+
+#include "../core/slang-process-util.h"
+
+#include "slang-ast-arena.h"
+#include "slang-ir.h"
+
+namespace Slang {
+
+void CompileBudget::start()
+{
+    m_startTick = ProcessUtil::getClockTick();
+    m_startThreadId = std::this_thread::get_id();
+    m_startASTLiveBytes = ASTAllocationStats::getForThread().liveBytes;
+}
+
+CompileBudget::Reason CompileBudget::calcReason(IRModule* module) const
+{
+    if (m_isCancelled)
+    {
+        return Reason::Cancelled;
+    }
+
+    if (m_timeLimit > 0.0)
+    {
+        const double seconds = double(ProcessUtil::getClockTick() - m_startTick) / double(ProcessUtil::getClockFrequency());
+        if (seconds > m_timeLimit)
+        {
+            return Reason::TimeLimit;
+        }
+    }
+
+    if (m_memoryLimit > 0)
+    {
+        Int bytes = module ? Int(module->memoryArena.calcTotalMemoryUsed()) : 0;
+        // AST allocations are only tracked per thread, so are only known on the thread that started the compile
+        if (std::this_thread::get_id() == m_startThreadId)
+        {
+            bytes += Math::Max(Int(0), ASTAllocationStats::getForThread().liveBytes - m_startASTLiveBytes);
+        }
+        if (bytes > m_memoryLimit)
+        {
+            return Reason::MemoryLimit;
+        }
+    }
+
+    return Reason::None;
+}
+
+void CompileBudget::check(IRModule* module)
+{
+    const Reason reason = calcReason(module);
+    if (reason != Reason::None)
+    {
+        throw CompileBudgetExceededException(reason);
+    }
+}
+
+/* static */const char* CompileBudget::getReasonText(Reason reason)
+{
+    switch (reason)
+    {
+        case Reason::Cancelled:     return "the compile was cancelled";
+        case Reason::TimeLimit:     return "the compile took longer than its time limit";
+        case Reason::MemoryLimit:   return "the compile used more memory than its memory limit";
+        default:                    return "none";
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,96 @@
+// slang-compile-budget.h
+#ifndef SLANG_COMPILE_BUDGET_H_INCLUDED
+#define SLANG_COMPILE_BUDGET_H_INCLUDED
+
+#include "../core/slang-basic.h"
+
+#include <atomic>
+#include <thread>
+
+namespace Slang {
+
+struct IRModule;
+
+    /// Limits on the time and memory a compile can use, and a way to cancel it from another thread.
+    ///
+    /// The budget is checked at the boundaries between phases of a compile, and periodically inside
+    /// long running IR passes (see `IRModule::checkBudget`). When the compile is over budget or has been
+    /// cancelled, a `CompileBudgetExceededException` is thrown, which ends the compile.
+class CompileBudget : public RefObject
+{
+public:
+    enum class Reason
+    {
+        None,
+        Cancelled,              ///< `cancel` was called
+        TimeLimit,              ///< The compile took longer than the time limit
+        MemoryLimit,            ///< The compile used more memory than the memory limit
+    };
+
+        /// Set the longest time (in seconds) a compile can take. 0 means no limit.
+    void setTimeLimit(double seconds) { m_timeLimit = seconds; }
+    double getTimeLimit() const { return m_timeLimit; }
+
+        /// Set the most memory (in bytes) a compile can use. 0 means no limit.
+        ///
+        /// The memory measured is that of the AST nodes allocated on the thread that started the
+        /// compile, plus the memory of the IR module being worked on at a check.
+    void setMemoryLimit(Int bytes) { m_memoryLimit = bytes; }
+    Int getMemoryLimit() const { return m_memoryLimit; }
+
+        /// Cancel the compile. Can be called from any thread. The compile stops at the next check.
+    void cancel() { m_isCancelled = true; }
+        /// True if `cancel` has been called
+    bool isCancelled() const { return m_isCancelled; }
+
+        /// Start timing a compile (on the thread that runs it)
+    void start();
+
+        /// Returns why the compile should stop, or `Reason::None` if it can continue.
+        /// module is the IR module being worked on, and can be null.
+    Reason calcReason(IRModule* module) const;
+
+        /// Throw a `CompileBudgetExceededException` if the compile should stop
+    void check(IRModule* module = nullptr);
+
+        /// Get a description of a reason, for use in diagnostics
+    static const char* getReasonText(Reason reason);
+
+protected:
+    double m_timeLimit = 0.0;
+    Int m_memoryLimit = 0;
+    std::atomic<bool> m_isCancelled = { false };
+
+    uint64_t m_startTick = 0;
+    std::thread::id m_startThreadId;
+    Int m_startASTLiveBytes = 0;
+};
+
+    /// Thrown when a compile is cancelled or goes over its `CompileBudget`.
+    ///
+    /// Derives from `AbortCompilationException`, so that code that passes an abort through
+    /// (rather than reporting it as an internal error) does the same for this.
+class CompileBudgetExceededException : public AbortCompilationException
+{
+public:
+    CompileBudgetExceededException(CompileBudget::Reason reason):
+        AbortCompilationException(CompileBudget::getReasonText(reason)),
+        m_reason(reason)
+    {}
+
+    CompileBudget::Reason m_reason;
+};
+
+    /// Check the budget, if there is one. Use at the boundaries between phases of a compile.
+    /// module is the IR module being worked on, and can be null.
+SLANG_FORCE_INLINE void checkCompileBudget(CompileBudget* budget, IRModule* module = nullptr)
+{
+    if (budget)
+    {
+        budget->check(module);
+    }
+}
+
+} // namespace Slang
+
+#endif
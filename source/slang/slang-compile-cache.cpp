@@ -0,0 +1,837 @@
+// slang-compile-cache.cpp
+#include "slang-compile-cache.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-platform.h"
+#include "../core/slang-process-util.h"
+#include "../core/slang-string-util.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <time.h>
+
+namespace Slang {
+
+// Bump when the key or the entry layout changes, so old entries are never used
+static const uint32_t kCompileCacheVersion = 2;
+
+// 'SLCC'
+static const uint32_t kEntryFourCc = uint32_t('S') | (uint32_t('L') << 8) | (uint32_t('C') << 16) | (uint32_t('C') << 24);
+// 'SLCD', for the output of a downstream compiler
+static const uint32_t kDownstreamEntryFourCc = uint32_t('S') | (uint32_t('L') << 8) | (uint32_t('C') << 16) | (uint32_t('D') << 24);
+
+static const char kEntryExtension[] = ".slang-cache";
+static const char kTempExtension[] = ".tmp";
+// Written by earlier versions, which kept the order entries were used in a shared index
+static const char kLegacyIndexFileName[] = "index.txt";
+
+// Temporary files older than this (in seconds) were left by a process that didn't finish writing them
+static const int64_t kStaleTempFileAge = 60 * 60;
+
+// Makes the names of temporary files unique within the process
+static std::atomic<uint32_t> s_tempFileCounter(0);
+
+namespace { // anonymous
+
+struct EntryWriter
+{
+    void writeUInt32(uint32_t value) { writeBytes(&value, sizeof(value)); }
+    void writeUInt64(uint64_t value) { writeBytes(&value, sizeof(value)); }
+    void writeBytes(const void* data, size_t size) { m_data.addRange((const uint8_t*)data, Index(size)); }
+    void writeString(const String& string)
+    {
+        writeUInt32(uint32_t(string.getLength()));
+        writeBytes(string.getBuffer(), string.getLength());
+    }
+
+    List<uint8_t> m_data;
+};
+
+struct EntryReader
+{
+    EntryReader(const uint8_t* data, size_t size):
+        m_cur(data),
+        m_end(data + size)
+    {}
+
+    SlangResult readBytes(void* dst, size_t size)
+    {
+        if (size_t(m_end - m_cur) < size)
+        {
+            return SLANG_FAIL;
+        }
+        ::memcpy(dst, m_cur, size);
+        m_cur += size;
+        return SLANG_OK;
+    }
+    SlangResult readUInt32(uint32_t& outValue) { return readBytes(&outValue, sizeof(outValue)); }
+    SlangResult readUInt64(uint64_t& outValue) { return readBytes(&outValue, sizeof(outValue)); }
+    SlangResult readString(String& outString)
+    {
+        uint32_t size;
+        SLANG_RETURN_ON_FAIL(readUInt32(size));
+        if (size_t(m_end - m_cur) < size)
+        {
+            return SLANG_FAIL;
+        }
+        outString = UnownedStringSlice((const char*)m_cur, (const char*)m_cur + size);
+        m_cur += size;
+        return SLANG_OK;
+    }
+
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+};
+
+    /// A file in the cache directory
+struct DirectoryItem
+{
+    String fileName;
+    uint64_t size;
+    int64_t modifiedTime;
+};
+
+} // anonymous
+
+static SlangResult _readFile(const String& path, List<uint8_t>& outData)
+{
+    FILE* file = fopen(path.getBuffer(), "rb");
+    if (!file)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    SlangResult res = SLANG_OK;
+    outData.setCount(Index(size < 0 ? 0 : size));
+    if (size < 0 || (size > 0 && fread(outData.getBuffer(), size_t(size), 1, file) != 1))
+    {
+        res = SLANG_FAIL;
+    }
+    fclose(file);
+    return res;
+}
+
+static SlangResult _writeFile(const String& path, const void* data, size_t size)
+{
+    // Write to a temporary file first and then move it into place, so that other
+    // processes using the cache never see a partially written file. The name is unique
+    // to the process and the write, so concurrent writes of the same entry don't interfere.
+    StringBuilder tempPath;
+    tempPath << path << "." << ProcessUtil::getProcessId() << "." << uint32_t(++s_tempFileCounter) << kTempExtension;
+
+    FILE* file = fopen(tempPath.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_FAIL;
+    }
+    const bool written = (size == 0 || fwrite(data, size, 1, file) == 1);
+    fclose(file);
+
+    if (!written)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+
+#ifdef _WIN32
+    // `rename` on Windows fails if the destination exists
+    File::remove(path);
+#endif
+    if (rename(tempPath.getBuffer(), path.getBuffer()) != 0)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static String _getEntryFileName(const String& key)
+{
+    StringBuilder builder;
+    builder << CompileCache::calcEntryName(key) << kEntryExtension;
+    return builder;
+}
+
+    /// Find the entry files (and temporary files) in directory, ordered from the least to the most recently used
+static void _findDirectoryItems(const String& directory, List<DirectoryItem>& outEntries, List<DirectoryItem>& outTempFiles)
+{
+    outEntries.clear();
+    outTempFiles.clear();
+
+    List<String> names;
+    if (SLANG_FAILED(Path::getDirectoryContents(directory, names)))
+    {
+        return;
+    }
+
+    for (const auto& name : names)
+    {
+        const bool isEntry = name.endsWith(kEntryExtension);
+        if (!isEntry && !name.endsWith(kTempExtension) && name != kLegacyIndexFileName)
+        {
+            continue;
+        }
+
+        int64_t size = 0;
+        int64_t modifiedTime = 0;
+        if (SLANG_FAILED(File::getSizeAndModifiedTime(Path::combine(directory, name), size, modifiedTime)))
+        {
+            // Removed by another process since the directory was read
+            continue;
+        }
+
+        DirectoryItem item;
+        item.fileName = name;
+        item.size = uint64_t(size);
+        item.modifiedTime = modifiedTime;
+        (isEntry ? outEntries : outTempFiles).add(item);
+    }
+
+    // Ties (the time only has a resolution of seconds) are ordered by name, so every process evicts in the same order
+    outEntries.sort([](const DirectoryItem& a, const DirectoryItem& b)
+    {
+        return a.modifiedTime < b.modifiedTime || (a.modifiedTime == b.modifiedTime && a.fileName < b.fileName);
+    });
+}
+
+    /// Calculate text identifying the build of Slang, from the size and a hash of the contents of the
+    /// library (or executable) this code is in. Empty if the file can't be read.
+static String _calcCompilerIdentity()
+{
+    String path;
+    if (SLANG_FAILED(SharedLibrary::getPathForFunc(SharedLibrary::FuncPtr(&_calcCompilerIdentity), path)))
+    {
+        return String();
+    }
+    try
+    {
+        const List<unsigned char> contents = File::readAllBytes(path);
+        StringBuilder builder;
+        builder << uint64_t(contents.getCount()) << " " << GetHashCode64((const char*)contents.getBuffer(), size_t(contents.getCount()));
+        return builder;
+    }
+    catch (const IOException&)
+    {
+        return String();
+    }
+}
+
+    /// Get the identity of the build of Slang, calculated once for the process
+static const String& _getCompilerIdentity()
+{
+    static const String identity = _calcCompilerIdentity();
+    return identity;
+}
+
+static void _appendSearchDirectories(SearchDirectoryList const* list, StringBuilder& out)
+{
+    for (; list; list = list->parent)
+    {
+        for (auto const& dir : list->searchDirectories)
+        {
+            out << "search-path: " << dir.path << "\n";
+        }
+    }
+}
+
+static void _appendDefines(const char* kind, Dictionary<String, String> const& defines, StringBuilder& out)
+{
+    // Dictionary iteration order isn't stable, so sort for a canonical key
+    List<String> lines;
+    for (auto const& pair : defines)
+    {
+        lines.add(pair.Key + "=" + pair.Value);
+    }
+    lines.sort();
+
+    for (auto const& line : lines)
+    {
+        out << kind << ": " << line << "\n";
+    }
+}
+
+/* static */bool CompileCache::canCache(EndToEndCompileRequest* request)
+{
+    auto frontEndReq = request->getFrontEndReq();
+    auto backEndReq = request->getBackEndReq();
+
+    // Without an identity for the build, outputs of a different build could be used
+    if (_getCompilerIdentity().getLength() == 0)
+    {
+        return false;
+    }
+
+    // Pass-through compiles don't track the files they depend on
+    if (request->passThrough != PassThroughMode::None)
+    {
+        return false;
+    }
+
+    // Requests that only run the front end, or that produce side effects for debugging, are not cached
+    if (request->shouldSkipCodegen ||
+        (frontEndReq->compileFlags & (SLANG_COMPILE_FLAG_NO_CODEGEN | SLANG_COMPILE_FLAG_REFLECTION_ONLY)) != 0 ||
+        request->containerFormat != ContainerFormat::None ||
+        frontEndReq->shouldDumpIR ||
+        backEndReq->shouldDumpIR ||
+        backEndReq->shouldDumpIntermediates)
+    {
+        return false;
+    }
+
+    // Source maps aren't held in the cache
+    if (backEndReq->lineDirectiveMode == LineDirectiveMode::SourceMap)
+    {
+        return false;
+    }
+
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        for (auto sourceFile : translationUnit->getSourceFiles())
+        {
+            if (!sourceFile->hasContent())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* static */uint64_t CompileCache::calcContentHash(const void* data, size_t size)
+{
+    return GetHashCode64((const char*)data, size);
+}
+
+    /// Hash more data, seeded with the hash of everything before it
+static uint64_t _continueHash(uint64_t hash, const void* data, size_t size)
+{
+    return getHashCode64(data, size, hash);
+}
+
+static uint64_t _calcTokenHash(TokenList const& tokens, SourceManager* sourceManager)
+{
+    // A token's position ends up in line directives and diagnostics, so the
+    // file and offset of each token is included as well as its text. Permutations
+    // of the same source have their tokens at the same positions, whatever parts
+    // the preprocessor skipped.
+    uint64_t hash = 0;
+    SourceView* view = nullptr;
+    for (auto const& token : tokens)
+    {
+        const uint32_t type = uint32_t(token.type);
+        hash = _continueHash(hash, &type, sizeof(type));
+        hash = _continueHash(hash, token.Content.begin(), token.Content.size());
+
+        if (!view || !view->getRange().contains(token.loc))
+        {
+            view = sourceManager->findSourceViewRecursively(token.loc);
+            if (view)
+            {
+                const String& path = view->getSourceFile()->getPathInfo().foundPath;
+                hash = _continueHash(hash, path.getBuffer(), path.getLength());
+            }
+        }
+
+        // If the token isn't in a known view its raw location is used, which at
+        // worst means permutations that could have matched don't.
+        const uint64_t offset = view ? uint64_t(view->getRange().getOffset(token.loc)) : uint64_t(token.loc.getRaw());
+        hash = _continueHash(hash, &offset, sizeof(offset));
+    }
+    return hash;
+}
+
+    /// Returns true if the tokens might contain an `import` declaration
+static bool _hasImport(TokenList const& tokens)
+{
+    for (auto const& token : tokens)
+    {
+        if (token.type == TokenType::Identifier &&
+            (token.Content == UnownedStringSlice::fromLiteral("import") || token.Content == UnownedStringSlice::fromLiteral("__import")))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+    /// Append the parts of the key that are the same whether the sources or the preprocessed tokens are used
+static void _appendCommonKey(EndToEndCompileRequest* request, StringBuilder& out)
+{
+    auto linkage = request->getLinkage();
+    auto frontEndReq = request->getFrontEndReq();
+    auto backEndReq = request->getBackEndReq();
+
+    out << "version: " << kCompileCacheVersion << "\n";
+    out << "compiler: " << _getCompilerIdentity() << "\n";
+
+    out << "compile-flags: " << uint32_t(frontEndReq->compileFlags) << "\n";
+    out << "matrix-layout: " << int(linkage->defaultMatrixLayoutMode) << "\n";
+    out << "debug-info: " << int(linkage->debugInfoLevel) << "\n";
+    out << "optimization: " << int(linkage->optimizationLevel) << "\n";
+    out << "falcor-shared-keyword: " << int(linkage->m_useFalcorCustomSharedKeywordSemantics) << "\n";
+    out << "line-directive-mode: " << int(backEndReq->lineDirectiveMode) << "\n";
+    out << "unknown-image-format: " << int(backEndReq->useUnknownImageFormatAsDefault) << "\n";
+
+    for (auto targetReq : linkage->targets)
+    {
+        out << "target: " << int(targetReq->target) << " " << uint32_t(targetReq->targetFlags) << " "
+            << uint32_t(targetReq->targetProfile.raw) << " " << int(targetReq->floatingPointMode) << "\n";
+    }
+
+    _appendSearchDirectories(&linkage->searchDirectories, out);
+    _appendSearchDirectories(&frontEndReq->searchDirectories, out);
+
+    for (auto entryPointReq : frontEndReq->getEntryPointReqs())
+    {
+        out << "entry-point: " << entryPointReq->getTranslationUnitIndex() << " " << getText(entryPointReq->getName())
+            << " " << uint32_t(entryPointReq->getProfile().raw) << "\n";
+    }
+    for (auto const& entryPointInfo : request->entryPoints)
+    {
+        for (auto const& arg : entryPointInfo.genericArgStrings)
+        {
+            out << "entry-point-generic-arg: " << arg << "\n";
+        }
+        for (auto const& arg : entryPointInfo.existentialArgStrings)
+        {
+            out << "entry-point-existential-arg: " << arg << "\n";
+        }
+    }
+
+    for (auto const& arg : request->globalGenericArgStrings)
+    {
+        out << "global-generic-arg: " << arg << "\n";
+    }
+    for (auto const& arg : request->globalExistentialSlotArgStrings)
+    {
+        out << "global-existential-arg: " << arg << "\n";
+    }
+}
+
+static void _appendTranslationUnitKey(TranslationUnitRequest* translationUnit, StringBuilder& out)
+{
+    out << "translation-unit: " << int(translationUnit->sourceLanguage);
+    if (translationUnit->moduleName)
+    {
+        out << " " << getText(translationUnit->moduleName);
+    }
+    out << "\n";
+}
+
+/* static */void CompileCache::calcKey(EndToEndCompileRequest* request, StringBuilder& out)
+{
+    auto frontEndReq = request->getFrontEndReq();
+
+    _appendCommonKey(request, out);
+    _appendDefines("define", request->getLinkage()->preprocessorDefinitions, out);
+    _appendDefines("request-define", frontEndReq->preprocessorDefinitions, out);
+
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        _appendTranslationUnitKey(translationUnit, out);
+
+        for (auto sourceFile : translationUnit->getSourceFiles())
+        {
+            const auto content = sourceFile->getContent();
+            out << "source: " << sourceFile->getPathInfo().foundPath << " " << uint64_t(content.size()) << " "
+                << calcContentHash(content.begin(), content.size()) << "\n";
+        }
+    }
+}
+
+/* static */void CompileCache::calcPermutationKey(EndToEndCompileRequest* request, StringBuilder& out)
+{
+    auto frontEndReq = request->getFrontEndReq();
+    auto sourceManager = request->getLinkage()->getSourceManager();
+
+    _appendCommonKey(request, out);
+
+    // The defines only change the code being compiled through the tokens, except that the
+    // linkage's defines are also used to preprocess `import`ed modules.
+    bool hasImport = false;
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        _appendTranslationUnitKey(translationUnit, out);
+
+        SLANG_ASSERT(translationUnit->preprocessedTokens.getCount() == translationUnit->getSourceFiles().getCount());
+        for (auto const& tokens : translationUnit->preprocessedTokens)
+        {
+            out << "preprocessed-source: " << tokens.mTokens.getCount() << " " << _calcTokenHash(tokens, sourceManager) << "\n";
+            hasImport = hasImport || _hasImport(tokens);
+        }
+    }
+    if (hasImport)
+    {
+        _appendDefines("define", request->getLinkage()->preprocessorDefinitions, out);
+    }
+}
+
+/* static */bool CompileCache::areDependenciesUnchanged(const CompileCacheEntry& entry, Linkage* linkage)
+{
+    for (auto const& dependency : entry.dependencies)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(linkage->loadFile(dependency.path, blob.writeRef())) ||
+            calcContentHash(blob->getBufferPointer(), blob->getBufferSize()) != dependency.contentHash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* static */String CompileCache::calcEntryName(const String& key)
+{
+    const uint64_t hash = calcContentHash(key.getBuffer(), key.getLength());
+
+    char digits[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        digits[i] = "0123456789abcdef"[(hash >> (60 - i * 4)) & 0xf];
+    }
+    digits[16] = 0;
+    return String(digits);
+}
+
+    /// Read the entry for key held in data
+static SlangResult _readEntry(const uint8_t* data, size_t size, const String& key, Linkage* linkage, CompileCacheEntry& outEntry)
+{
+    EntryReader reader(data, size);
+
+    uint32_t fourCc, version;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(fourCc));
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(version));
+    if (fourCc != kEntryFourCc || version != kCompileCacheVersion)
+    {
+        return SLANG_FAIL;
+    }
+
+    SLANG_RETURN_ON_FAIL(reader.readString(outEntry.key));
+    if (outEntry.key != key)
+    {
+        // Hash collision
+        return SLANG_E_NOT_FOUND;
+    }
+
+    uint32_t dependencyCount;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(dependencyCount));
+    outEntry.dependencies.setCount(dependencyCount);
+    for (auto& dependency : outEntry.dependencies)
+    {
+        SLANG_RETURN_ON_FAIL(reader.readString(dependency.path));
+        SLANG_RETURN_ON_FAIL(reader.readUInt64(dependency.contentHash));
+    }
+
+    // The entry can only be used if the dependencies are unchanged
+    if (!CompileCache::areDependenciesUnchanged(outEntry, linkage))
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    uint32_t entryPointCount;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(entryPointCount));
+    outEntry.entryPoints.setCount(entryPointCount);
+    for (auto& entryPoint : outEntry.entryPoints)
+    {
+        SLANG_RETURN_ON_FAIL(reader.readString(entryPoint.name));
+        SLANG_RETURN_ON_FAIL(reader.readUInt32(entryPoint.profile));
+    }
+
+    uint32_t resultCount;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(resultCount));
+    outEntry.results.setCount(resultCount);
+    for (auto& result : outEntry.results)
+    {
+        uint32_t format;
+        SLANG_RETURN_ON_FAIL(reader.readUInt32(format));
+        result.format = ResultFormat(format);
+
+        switch (result.format)
+        {
+            case ResultFormat::None:
+                break;
+            case ResultFormat::Text:
+                SLANG_RETURN_ON_FAIL(reader.readString(result.outputString));
+                break;
+            case ResultFormat::Binary:
+            {
+                uint32_t resultSize;
+                SLANG_RETURN_ON_FAIL(reader.readUInt32(resultSize));
+                List<uint8_t> data;
+                data.setCount(resultSize);
+                SLANG_RETURN_ON_FAIL(reader.readBytes(data.getBuffer(), resultSize));
+                result.blob = createListBlob(data);
+                break;
+            }
+            default: return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+    /// Write entry in the format read by `_readEntry`
+static SlangResult _writeEntry(const CompileCacheEntry& entry, EntryWriter& writer)
+{
+    writer.writeUInt32(kEntryFourCc);
+    writer.writeUInt32(kCompileCacheVersion);
+    writer.writeString(entry.key);
+
+    writer.writeUInt32(uint32_t(entry.dependencies.getCount()));
+    for (auto const& dependency : entry.dependencies)
+    {
+        writer.writeString(dependency.path);
+        writer.writeUInt64(dependency.contentHash);
+    }
+
+    writer.writeUInt32(uint32_t(entry.entryPoints.getCount()));
+    for (auto const& entryPoint : entry.entryPoints)
+    {
+        writer.writeString(entryPoint.name);
+        writer.writeUInt32(entryPoint.profile);
+    }
+
+    writer.writeUInt32(uint32_t(entry.results.getCount()));
+    for (auto const& result : entry.results)
+    {
+        writer.writeUInt32(uint32_t(result.format));
+        switch (result.format)
+        {
+            case ResultFormat::None:
+                break;
+            case ResultFormat::Text:
+                writer.writeString(result.outputString);
+                break;
+            case ResultFormat::Binary:
+            {
+                size_t size = 0;
+                const void* data = result.getData(size);
+                writer.writeUInt32(uint32_t(size));
+                writer.writeBytes(data, size);
+                break;
+            }
+            default: return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+    /// Mark the entry held in fileName as the most recently used
+static void _touchEntryFile(const String& directory, const String& fileName)
+{
+    // The modification time of an entry's file is when it was last used, so there is no index
+    // that processes sharing the directory could lose each other's updates to
+    File::setModifiedTimeToNow(Path::combine(directory, fileName));
+}
+
+    /// Evict the least recently used entries in directory until it is no larger than maxSize bytes,
+    /// never evicting the entry held in keepFileName
+static void _evictEntryFiles(const String& directory, uint64_t maxSize, const String& keepFileName)
+{
+    List<DirectoryItem> entries;
+    List<DirectoryItem> tempFiles;
+    _findDirectoryItems(directory, entries, tempFiles);
+
+    // Remove the index of earlier versions, and temporary files from processes that didn't finish writing them
+    const int64_t now = int64_t(time(nullptr));
+    for (const auto& tempFile : tempFiles)
+    {
+        if (tempFile.fileName == kLegacyIndexFileName || now - tempFile.modifiedTime > kStaleTempFileAge)
+        {
+            File::remove(Path::combine(directory, tempFile.fileName));
+        }
+    }
+
+    uint64_t totalSize = 0;
+    for (const auto& entry : entries)
+    {
+        totalSize += entry.size;
+    }
+
+    // Other processes may be evicting the same entries at the same time, which at worst removes more than needed
+    for (Index i = 0; i < entries.getCount() && totalSize > maxSize; ++i)
+    {
+        const auto& entry = entries[i];
+        if (entry.fileName != keepFileName)
+        {
+            File::remove(Path::combine(directory, entry.fileName));
+            totalSize -= entry.size;
+        }
+    }
+}
+
+    /// Write the entry for key held in writer to directory, and then evict the least recently used entries
+    /// until the cache is no larger than maxSize bytes
+static SlangResult _writeEntryFile(const String& directory, uint64_t maxSize, const String& key, const EntryWriter& writer)
+{
+    // Make sure the directory exists. Failure is fine here if it already does.
+    Path::createDirectory(directory);
+
+    const String fileName = _getEntryFileName(key);
+    SLANG_RETURN_ON_FAIL(_writeFile(Path::combine(directory, fileName), writer.m_data.getBuffer(), size_t(writer.m_data.getCount())));
+
+    if (maxSize > 0)
+    {
+        _evictEntryFiles(directory, maxSize, fileName);
+    }
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileCache::read(const String& directory, const String& key, Linkage* linkage, CompileCacheEntry& outEntry)
+{
+    const String fileName = _getEntryFileName(key);
+
+    List<uint8_t> data;
+    SLANG_RETURN_ON_FAIL(_readFile(Path::combine(directory, fileName), data));
+    SLANG_RETURN_ON_FAIL(_readEntry(data.getBuffer(), size_t(data.getCount()), key, linkage, outEntry));
+
+    _touchEntryFile(directory, fileName);
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileCache::write(const String& directory, uint64_t maxSize, const CompileCacheEntry& entry)
+{
+    EntryWriter writer;
+    SLANG_RETURN_ON_FAIL(_writeEntry(entry, writer));
+
+    return _writeEntryFile(directory, maxSize, entry.key, writer);
+}
+
+    /// Get the entry held in cache for the key text, or nullptr if there isn't one
+static ComPtr<ISlangBlob> _getCacheEntry(ISlangCompileCache* cache, const String& key)
+{
+    const String name = CompileCache::calcEntryName(key);
+    const char* names[] = { name.getBuffer() };
+
+    ComPtr<ISlangBlob> blob;
+    if (SLANG_FAILED(cache->getEntries(names, 1, blob.writeRef())))
+    {
+        return ComPtr<ISlangBlob>();
+    }
+    return blob;
+}
+
+/* static */SlangResult CompileCache::read(ISlangCompileCache* cache, const String& key, Linkage* linkage, CompileCacheEntry& outEntry)
+{
+    ComPtr<ISlangBlob> blob = _getCacheEntry(cache, key);
+    if (!blob)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    return _readEntry((const uint8_t*)blob->getBufferPointer(), blob->getBufferSize(), key, linkage, outEntry);
+}
+
+/* static */SlangResult CompileCache::write(ISlangCompileCache* cache, const CompileCacheEntry& entry)
+{
+    EntryWriter writer;
+    SLANG_RETURN_ON_FAIL(_writeEntry(entry, writer));
+
+    ComPtr<ISlangBlob> blob = createRawBlob(writer.m_data.getBuffer(), size_t(writer.m_data.getCount()));
+    return cache->putEntry(calcEntryName(entry.key).getBuffer(), blob);
+}
+
+/* static */void CompileCache::calcDownstreamKey(const char* compilerName, const UnownedStringSlice& compilerIdentity, const UnownedStringSlice& source, const UnownedStringSlice& options, StringBuilder& out)
+{
+    // Unlike other keys the build of Slang isn't part of the key, so that outputs are reused across Slang
+    // versions that emit the same source
+    out << "version: " << kCompileCacheVersion << "\n";
+    out << "downstream-compiler: " << compilerName << " " << compilerIdentity << "\n";
+    out << "source: " << uint64_t(source.size()) << " " << calcContentHash(source.begin(), source.size()) << "\n";
+    out << options;
+}
+
+    /// Read the output of the downstream compile with key held in data
+static SlangResult _readDownstreamEntry(const uint8_t* data, size_t size, const String& key, List<uint8_t>& outCode)
+{
+    EntryReader reader(data, size);
+
+    uint32_t fourCc, version;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(fourCc));
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(version));
+    if (fourCc != kDownstreamEntryFourCc || version != kCompileCacheVersion)
+    {
+        return SLANG_FAIL;
+    }
+
+    String entryKey;
+    SLANG_RETURN_ON_FAIL(reader.readString(entryKey));
+    if (entryKey != key)
+    {
+        // Hash collision
+        return SLANG_E_NOT_FOUND;
+    }
+
+    uint32_t codeSize;
+    SLANG_RETURN_ON_FAIL(reader.readUInt32(codeSize));
+    outCode.setCount(codeSize);
+    return reader.readBytes(outCode.getBuffer(), codeSize);
+}
+
+    /// Write the output of a downstream compile in the format read by `_readDownstreamEntry`
+static void _writeDownstreamEntry(const String& key, const void* code, size_t size, EntryWriter& writer)
+{
+    writer.writeUInt32(kDownstreamEntryFourCc);
+    writer.writeUInt32(kCompileCacheVersion);
+    writer.writeString(key);
+    writer.writeUInt32(uint32_t(size));
+    writer.writeBytes(code, size);
+}
+
+/* static */SlangResult CompileCache::readDownstream(const String& directory, const String& key, List<uint8_t>& outCode)
+{
+    const String fileName = _getEntryFileName(key);
+
+    List<uint8_t> data;
+    SLANG_RETURN_ON_FAIL(_readFile(Path::combine(directory, fileName), data));
+    SLANG_RETURN_ON_FAIL(_readDownstreamEntry(data.getBuffer(), size_t(data.getCount()), key, outCode));
+
+    _touchEntryFile(directory, fileName);
+    return SLANG_OK;
+}
+
+/* static */SlangResult CompileCache::writeDownstream(const String& directory, uint64_t maxSize, const String& key, const void* code, size_t size)
+{
+    EntryWriter writer;
+    _writeDownstreamEntry(key, code, size, writer);
+
+    return _writeEntryFile(directory, maxSize, key, writer);
+}
+
+/* static */SlangResult CompileCache::readDownstream(ISlangCompileCache* cache, const String& key, List<uint8_t>& outCode)
+{
+    ComPtr<ISlangBlob> blob = _getCacheEntry(cache, key);
+    if (!blob)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+    return _readDownstreamEntry((const uint8_t*)blob->getBufferPointer(), blob->getBufferSize(), key, outCode);
+}
+
+/* static */SlangResult CompileCache::writeDownstream(ISlangCompileCache* cache, const String& key, const void* code, size_t size)
+{
+    EntryWriter writer;
+    _writeDownstreamEntry(key, code, size, writer);
+
+    ComPtr<ISlangBlob> blob = createRawBlob(writer.m_data.getBuffer(), size_t(writer.m_data.getCount()));
+    return cache->putEntry(calcEntryName(key).getBuffer(), blob);
+}
+
+PermutationCache* Linkage::getPermutationCache()
+{
+    if (!m_permutationCache)
+    {
+        m_permutationCache = new PermutationCache();
+    }
+    return m_permutationCache;
+}
+
+void Linkage::destroyPermutationCache()
+{
+    delete m_permutationCache;
+    m_permutationCache = nullptr;
+}
+
+} // namespace Slang
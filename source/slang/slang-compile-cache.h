@@ -0,0 +1,119 @@
+// slang-compile-cache.h
+#ifndef SLANG_COMPILE_CACHE_H_INCLUDED
+#define SLANG_COMPILE_CACHE_H_INCLUDED
+
+#include "../core/slang-basic.h"
+
+// For EndToEndCompileRequest, CompileResult
+#include "slang-compiler.h"
+
+namespace Slang {
+
+/* A persistent, content addressed cache of the outputs of end-to-end compiles.
+
+The key for a compile is built from everything that is known before the front end runs: the compiler build
+(identified by a hash of the Slang library), the contents of the translation unit sources, entry points, targets,
+defines, search paths and options that affect code generation. Files pulled in by `#include` or `import` are only known after a compile, so each cache
+entry records the paths of every file the compile depended on along with a hash of their contents. On lookup
+an entry is only used if all of those files still hash to the same values.
+
+When permutations are deduplicated (see `EndToEndCompileRequest::shouldDeduplicatePermutations`) the key is built
+from the preprocessed tokens of the translation units instead of their source text and defines, so that requests
+whose defines don't change the code being compiled share an entry. Entries with these keys are also held in
+memory on the `Linkage`, so that later requests using the same linkage reuse them without the cache directory.
+
+Each entry is held in its own file in the cache directory, which can be shared by concurrent processes. Files are
+written under a name unique to the process and then renamed into place. The modification time of an entry's file
+records when it was last used, and when the total size goes over the size limit the directory is scanned to evict
+the least recently used entries.
+
+Entries can also be held in an `ISlangCompileCache` implemented by the application, such as one shared by the
+machines of a build farm. These are found by the name of the entry (a hash of the key text), and hold the full key
+text as the files do. The outputs of downstream compilers (such as fxc, dxc and glslang) are held in such a cache
+too, keyed by the source they are given and their options, so that a request that misses the cache only runs the
+downstream compilers for code that has changed.
+
+The outputs of downstream compilers are also held in the cache directory. Their keys identify the downstream
+compiler by the contents of its shared library, rather than including the build of Slang, so outputs are reused
+across Slang upgrades (and edits to imported modules) that leave the emitted source unchanged.
+*/
+
+    /// The outputs of an end-to-end compile, as held in the compile cache
+struct CompileCacheEntry
+{
+    struct Dependency
+    {
+        String path;                    ///< The path of the file, as reported by the compile
+        uint64_t contentHash;           ///< Hash of the file contents at the time of the compile
+    };
+
+    struct EntryPointInfo
+    {
+        String name;                    ///< The name of the entry point
+        Profile::RawVal profile;        ///< The profile the entry point was compiled with
+    };
+
+    String key;                         ///< The full key text (used to detect hash collisions)
+    List<Dependency> dependencies;      ///< Files the compile depended on
+    List<EntryPointInfo> entryPoints;   ///< The entry points of the specialized program
+    List<CompileResult> results;        ///< Indexed by 'targetIndex * entryPoints.getCount() + entryPointIndex'
+};
+
+struct CompileCache
+{
+        /// Returns true if the outputs of the request can be held in the cache
+    static bool canCache(EndToEndCompileRequest* request);
+
+        /// Calculate the key text for a request
+    static void calcKey(EndToEndCompileRequest* request, StringBuilder& outKey);
+
+        /// Calculate the key text for a request, using the preprocessed tokens of its translation units.
+        /// Every translation unit must have been preprocessed with `FrontEndCompileRequest::preprocessTranslationUnit`.
+    static void calcPermutationKey(EndToEndCompileRequest* request, StringBuilder& outKey);
+
+        /// Calculate the hash used to identify file contents in the cache
+    static uint64_t calcContentHash(const void* data, size_t size);
+
+        /// Read the entry for key from the cache held in directory.
+        /// Succeeds only if there is an entry for the key, and all of the files it depends on are unchanged.
+    static SlangResult read(const String& directory, const String& key, Linkage* linkage, CompileCacheEntry& outEntry);
+
+        /// Returns true if all of the files the entry depends on still have the contents they had when it was created
+    static bool areDependenciesUnchanged(const CompileCacheEntry& entry, Linkage* linkage);
+
+        /// Write entry to the cache held in directory, and then evict the least recently used entries
+        /// until the cache is no larger than maxSize bytes. A maxSize of 0 means there is no limit.
+    static SlangResult write(const String& directory, uint64_t maxSize, const CompileCacheEntry& entry);
+
+        /// Get the name an entry with the key text is held under (in the cache directory, and in an `ISlangCompileCache`)
+    static String calcEntryName(const String& key);
+
+        /// Read the entry for key from cache.
+        /// Succeeds only if there is an entry for the key, and all of the files it depends on are unchanged.
+    static SlangResult read(ISlangCompileCache* cache, const String& key, Linkage* linkage, CompileCacheEntry& outEntry);
+        /// Write entry to cache
+    static SlangResult write(ISlangCompileCache* cache, const CompileCacheEntry& entry);
+
+        /// Calculate the key text for the output of a downstream compiler given source. compilerIdentity identifies
+        /// the build of the compiler (see `Session::getSharedLibraryFuncIdentity`), and options should describe
+        /// everything else that the output depends on, one item per line.
+    static void calcDownstreamKey(const char* compilerName, const UnownedStringSlice& compilerIdentity, const UnownedStringSlice& source, const UnownedStringSlice& options, StringBuilder& outKey);
+        /// Read the output of the downstream compile with key from the cache held in directory
+    static SlangResult readDownstream(const String& directory, const String& key, List<uint8_t>& outCode);
+        /// Write the output of the downstream compile with key to the cache held in directory, evicting entries as `write` does
+    static SlangResult writeDownstream(const String& directory, uint64_t maxSize, const String& key, const void* code, size_t size);
+        /// Read the output of the downstream compile with key from cache
+    static SlangResult readDownstream(ISlangCompileCache* cache, const String& key, List<uint8_t>& outCode);
+        /// Write the output of the downstream compile with key to cache
+    static SlangResult writeDownstream(ISlangCompileCache* cache, const String& key, const void* code, size_t size);
+};
+
+    /// Outputs of compiles done with a linkage, keyed by `CompileCache::calcPermutationKey`
+struct PermutationCache
+{
+    Dictionary<String, CompileCacheEntry> entries;
+};
+
+} // namespace Slang
+
+#endif
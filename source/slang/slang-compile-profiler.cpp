@@ -0,0 +1,415 @@
+// slang-compile-profiler.cpp
+#include "slang-compile-profiler.h"
+
+#include "../core/slang-process-util.h"
+
+#include "slang-ast-arena.h"
+#include "slang-ir.h"
+
+namespace Slang {
+
+/* static */const char* CompileProfiler::kFrontEndCategory = "front-end";
+/* static */const char* CompileProfiler::kBackEndCategory = "back-end";
+/* static */const char* CompileProfiler::kIRPassCategory = "ir-pass";
+/* static */const char* CompileProfiler::kDownstreamCategory = "downstream";
+
+CompileProfiler::CompileProfiler()
+{
+    m_startTick = ProcessUtil::getClockTick();
+}
+
+Index CompileProfiler::_getThreadIndex()
+{
+    const std::thread::id threadId = std::this_thread::get_id();
+    Index index = m_threadIds.indexOf(threadId);
+    if (index < 0)
+    {
+        index = m_threadIds.getCount();
+        m_threadIds.add(threadId);
+    }
+    return index;
+}
+
+void CompileProfiler::addEvent(CompileProfileEvent& event)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.add(_Move(event));
+    m_events.getLast().threadIndex = _getThreadIndex();
+}
+
+void CompileProfiler::addCounter(const char* name, Int value)
+{
+    CompileProfileCounter counter;
+    counter.name = name;
+    counter.tick = ProcessUtil::getClockTick();
+    counter.value = value;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_counters.add(_Move(counter));
+}
+
+double CompileProfiler::calcSecondsSinceStart(uint64_t tick) const
+{
+    return double(int64_t(tick - m_startTick)) / double(ProcessUtil::getClockFrequency());
+}
+
+static void _appendJSONString(const String& text, StringBuilder& out)
+{
+    out << "\"";
+    for (char c : text.getUnownedSlice())
+    {
+        switch (c)
+        {
+            case '"':   out << "\\\""; break;
+            case '\\':  out << "\\\\"; break;
+            case '\n':  out << "\\n"; break;
+            case '\r':  out << "\\r"; break;
+            case '\t':  out << "\\t"; break;
+            default:
+            {
+                if ((unsigned char)c < 0x20)
+                {
+                    static const char hexDigits[] = "0123456789abcdef";
+                    out << "\\u00";
+                    out.append(hexDigits[(c >> 4) & 0xf]);
+                    out.append(hexDigits[c & 0xf]);
+                }
+                else
+                {
+                    out.append(c);
+                }
+                break;
+            }
+        }
+    }
+    out << "\"";
+}
+
+void CompileProfiler::writeChromeTrace(StringBuilder& out) const
+{
+    // Each event is written as a 'complete' event ("ph":"X"), with times in microseconds.
+    // Nesting of events (such as the passes within an entry point) is inferred by the
+    // viewer from the times.
+    out << "{\"traceEvents\":[\n";
+
+    const Index eventCount = m_events.getCount();
+    for (Index i = 0; i < eventCount; ++i)
+    {
+        const auto& event = m_events[i];
+
+        const uint64_t startMicroseconds = uint64_t(calcSecondsSinceStart(event.startTick) * 1000000.0);
+        const uint64_t durationMicroseconds = uint64_t(double(event.endTick - event.startTick) * 1000000.0 / double(ProcessUtil::getClockFrequency()));
+
+        out << "{\"name\":";
+        _appendJSONString(event.name, out);
+        out << ",\"cat\":";
+        _appendJSONString(event.category, out);
+        out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadIndex;
+        out << ",\"ts\":" << startMicroseconds << ",\"dur\":" << durationMicroseconds;
+
+        out << ",\"args\":{";
+        bool hasArg = false;
+        if (event.detail.getLength())
+        {
+            out << "\"detail\":";
+            _appendJSONString(event.detail, out);
+            hasArg = true;
+        }
+        if (event.instCountBefore >= 0)
+        {
+            out << (hasArg ? "," : "") << "\"instCountBefore\":" << event.instCountBefore << ",\"instCountAfter\":" << event.instCountAfter;
+            hasArg = true;
+        }
+        if (event.memoryBefore >= 0)
+        {
+            out << (hasArg ? "," : "") << "\"memoryBefore\":" << event.memoryBefore << ",\"memoryAfter\":" << event.memoryAfter;
+            hasArg = true;
+        }
+        if (event.astNodeCountBefore >= 0)
+        {
+            out << (hasArg ? "," : "") << "\"astNodeCountBefore\":" << event.astNodeCountBefore << ",\"astNodeCountAfter\":" << event.astNodeCountAfter;
+            out << ",\"astPeakBytesBefore\":" << event.astPeakBytesBefore << ",\"astPeakBytesAfter\":" << event.astPeakBytesAfter;
+            hasArg = true;
+        }
+        out << "}}";
+
+        out << ((i + 1 < eventCount || m_counters.getCount()) ? ",\n" : "\n");
+    }
+
+    // Counters are written as 'counter' events ("ph":"C"), which the viewer shows as a graph
+    const Index counterCount = m_counters.getCount();
+    for (Index i = 0; i < counterCount; ++i)
+    {
+        const auto& counter = m_counters[i];
+
+        out << "{\"name\":";
+        _appendJSONString(counter.name, out);
+        out << ",\"ph\":\"C\",\"pid\":1";
+        out << ",\"ts\":" << uint64_t(calcSecondsSinceStart(counter.tick) * 1000000.0);
+        out << ",\"args\":{\"value\":" << counter.value << "}}";
+
+        out << ((i + 1 < counterCount) ? ",\n" : "\n");
+    }
+
+    out << "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+static Int _calcInstCount(IRInst* inst)
+{
+    Int count = 1;
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        count += _calcInstCount(child);
+    }
+    return count;
+}
+
+/* static */Int CompileProfiler::calcInstCount(IRModule* module)
+{
+    return (module && module->getModuleInst()) ? _calcInstCount(module->getModuleInst()) : 0;
+}
+
+static void _countInstsByOp(IRInst* inst, Dictionary<int32_t, Index>& counts)
+{
+    Index count = 0;
+    counts.TryGetValue(int32_t(inst->op), count);
+    counts[int32_t(inst->op)] = count + 1;
+
+    for (auto child : inst->getDecorationsAndChildren())
+    {
+        _countInstsByOp(child, counts);
+    }
+}
+
+void EntryPointCodeReport::addStage(const char* stageName, IRModule* module)
+{
+    IRStageInstCounts stage;
+    stage.stageName = stageName;
+
+    Dictionary<int32_t, Index> counts;
+    if (module && module->getModuleInst())
+        _countInstsByOp(module->getModuleInst(), counts);
+
+    for (const auto& pair : counts)
+    {
+        IRInstOpCount opCount;
+        opCount.op = pair.Key;
+        opCount.count = pair.Value;
+        stage.opCounts.add(opCount);
+        stage.instCount += pair.Value;
+    }
+    stage.opCounts.sort([](const IRInstOpCount& a, const IRInstOpCount& b)
+    {
+        return a.count > b.count || (a.count == b.count && a.op < b.op);
+    });
+
+    stages.add(_Move(stage));
+}
+
+    /// True if inst is a value defined in func that has to be held somewhere while it is live
+static bool _isLiveValue(IRInst* inst, IRGlobalValueWithCode* func)
+{
+    auto block = as<IRBlock>(inst->getParent());
+    if (!block || block->getParent() != func)
+        return false;
+    auto type = inst->getDataType();
+    return type && !as<IRVoidType>(type);
+}
+
+    /// Remove the values defined in block from live, then add the values it uses, visiting
+    /// the instructions in reverse order. Returns the most values live at one point.
+static Index _calcBlockLiveness(IRGlobalValueWithCode* func, IRBlock* block, HashSet<IRInst*>& live)
+{
+    Index peakCount = live.Count();
+    for (auto inst = block->getLastChild(); inst; inst = inst->getPrevInst())
+    {
+        live.Remove(inst);
+
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            auto operand = inst->getOperand(i);
+            if (_isLiveValue(operand, func))
+                live.Add(operand);
+        }
+        peakCount = Math::Max(peakCount, Index(live.Count()));
+    }
+    return peakCount;
+}
+
+static Index _calcPeakLiveValueCount(IRGlobalValueWithCode* func)
+{
+    // A standard backwards dataflow analysis: the values live out of a block are
+    // those live into its successors (the arguments a block passes to the parameters
+    // of a successor are operands of its terminator, so are uses in the block itself).
+    //
+    List<IRBlock*> blocks;
+    Dictionary<IRBlock*, Index> blockIndices;
+    for (auto block : func->getBlocks())
+    {
+        blockIndices.Add(block, blocks.getCount());
+        blocks.add(block);
+    }
+    List<HashSet<IRInst*>> liveIns;
+    liveIns.setCount(blocks.getCount());
+
+    auto calcLiveOut = [&](IRBlock* block, HashSet<IRInst*>& outLive)
+    {
+        for (auto successor : block->getSuccessors())
+        {
+            for (auto inst : liveIns[blockIndices[successor].GetValue()])
+                outLive.Add(inst);
+        }
+    };
+
+    // The live sets only grow, so they have stopped changing once their sizes have
+    for (bool changed = true; changed; )
+    {
+        changed = false;
+        for (Index i = blocks.getCount() - 1; i >= 0; --i)
+        {
+            HashSet<IRInst*> live;
+            calcLiveOut(blocks[i], live);
+            _calcBlockLiveness(func, blocks[i], live);
+
+            if (live.Count() != liveIns[i].Count())
+            {
+                liveIns[i] = _Move(live);
+                changed = true;
+            }
+        }
+    }
+
+    Index peakCount = 0;
+    for (auto block : blocks)
+    {
+        HashSet<IRInst*> live;
+        calcLiveOut(block, live);
+        peakCount = Math::Max(peakCount, _calcBlockLiveness(func, block, live));
+    }
+    return peakCount;
+}
+
+/* static */Index EntryPointCodeReport::calcPeakLiveValueCount(IRModule* module)
+{
+    Index peakCount = 0;
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRGlobalValueWithCode>(inst);
+        if (func && func->getFirstBlock())
+            peakCount = Math::Max(peakCount, _calcPeakLiveValueCount(func));
+    }
+    return peakCount;
+}
+
+void CodeReport::addEntryPoint(EntryPointCodeReport& report)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entryPoints.add(_Move(report));
+}
+
+void CodeReport::writeJSON(StringBuilder& out) const
+{
+    out << "{\"entryPoints\":[\n";
+
+    const Index entryPointCount = m_entryPoints.getCount();
+    for (Index i = 0; i < entryPointCount; ++i)
+    {
+        const auto& report = m_entryPoints[i];
+
+        out << "{\"name\":";
+        _appendJSONString(report.entryPointName, out);
+        out << ",\"target\":";
+        _appendJSONString(report.targetName, out);
+        out << ",\"peakLiveValueCount\":" << report.peakLiveValueCount;
+        out << ",\"sourceByteCount\":" << report.sourceByteCount;
+        out << ",\"temporaryCount\":" << report.temporaryCount;
+
+        out << ",\"stages\":[";
+        for (Index j = 0; j < report.stages.getCount(); ++j)
+        {
+            const auto& stage = report.stages[j];
+
+            out << (j ? ",\n" : "\n") << "{\"name\":";
+            _appendJSONString(stage.stageName, out);
+            out << ",\"instCount\":" << stage.instCount << ",\"opCounts\":{";
+            for (Index k = 0; k < stage.opCounts.getCount(); ++k)
+            {
+                const auto& opCount = stage.opCounts[k];
+                out << (k ? "," : "") << "\"" << getIROpInfo(IROp(opCount.op)).name << "\":" << opCount.count;
+            }
+            out << "}}";
+        }
+        out << "]}";
+
+        out << ((i + 1 < entryPointCount) ? ",\n" : "\n");
+    }
+
+    out << "]}\n";
+}
+
+CompileProfileScope::CompileProfileScope(CompileProfiler* profiler, const char* category, const char* name, const String& detail):
+    m_profiler(profiler)
+{
+    if (profiler)
+    {
+        m_event.category = category;
+        m_event.name = name;
+        m_event.detail = detail;
+        _startASTStats();
+        m_event.startTick = ProcessUtil::getClockTick();
+    }
+}
+
+void CompileProfileScope::_startASTStats()
+{
+    if (m_event.category == CompileProfiler::kFrontEndCategory)
+    {
+        const auto& stats = ASTAllocationStats::getForThread();
+        m_event.astNodeCountBefore = stats.nodeCount;
+        m_event.astPeakBytesBefore = stats.peakLiveBytes;
+    }
+}
+
+IRPassProfileScope::IRPassProfileScope(CompileProfiler* profiler, const char* name, IRModule* module, const char* category):
+    CompileProfileScope(profiler)
+{
+    m_module = module;
+    if (profiler)
+    {
+        m_event.category = category;
+        m_event.name = name;
+        m_event.instCountBefore = CompileProfiler::calcInstCount(module);
+        m_event.memoryBefore = module ? Int(module->memoryArena.calcTotalMemoryUsed()) : 0;
+        _startASTStats();
+
+        // Start timing after the module has been measured, so that only the pass is timed
+        m_event.startTick = ProcessUtil::getClockTick();
+    }
+}
+
+CompileProfileScope::~CompileProfileScope()
+{
+    if (!m_profiler)
+    {
+        return;
+    }
+
+    m_event.endTick = ProcessUtil::getClockTick();
+
+    if (m_event.instCountBefore >= 0)
+    {
+        m_event.instCountAfter = CompileProfiler::calcInstCount(m_module);
+        m_event.memoryAfter = m_module ? Int(m_module->memoryArena.calcTotalMemoryUsed()) : 0;
+    }
+    if (m_event.astNodeCountBefore >= 0)
+    {
+        const auto& stats = ASTAllocationStats::getForThread();
+        m_event.astNodeCountAfter = stats.nodeCount;
+        m_event.astPeakBytesAfter = stats.peakLiveBytes;
+    }
+
+    m_profiler->addEvent(m_event);
+}
+
+} // namespace Slang
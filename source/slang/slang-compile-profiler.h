@@ -0,0 +1,193 @@
+// slang-compile-profiler.h
+#ifndef SLANG_COMPILE_PROFILER_H_INCLUDED
+#define SLANG_COMPILE_PROFILER_H_INCLUDED
+
+#include "../core/slang-basic.h"
+
+#include <mutex>
+#include <thread>
+
+namespace Slang {
+
+struct IRModule;
+
+    /// A single timed phase of a compile, such as a front-end phase or an IR pass
+struct CompileProfileEvent
+{
+    String name;                    ///< The name of the phase or pass
+    String category;                ///< One of the categories in `CompileProfiler`
+    String detail;                  ///< Extra information, such as the file or entry point being compiled
+
+    uint64_t startTick = 0;         ///< When the phase started, in ProcessUtil clock ticks
+    uint64_t endTick = 0;           ///< When the phase ended, in ProcessUtil clock ticks
+    Index threadIndex = 0;          ///< Index of the thread (in order of first use) that ran the phase
+
+    Int instCountBefore = -1;       ///< IR instructions in the module before an IR pass, or -1 if not known
+    Int instCountAfter = -1;        ///< IR instructions in the module after an IR pass, or -1 if not known
+    Int memoryBefore = -1;          ///< Bytes used by the module's memory arena before an IR pass, or -1 if not known
+    Int memoryAfter = -1;           ///< Bytes used by the module's memory arena after an IR pass, or -1 if not known
+
+    Int astNodeCountBefore = -1;    ///< AST nodes allocated on the thread before a front-end phase, or -1 if not known
+    Int astNodeCountAfter = -1;     ///< AST nodes allocated on the thread after a front-end phase, or -1 if not known
+    Int astPeakBytesBefore = -1;    ///< Peak bytes of AST nodes allocated on the thread before a front-end phase, or -1 if not known
+    Int astPeakBytesAfter = -1;     ///< Peak bytes of AST nodes allocated on the thread after a front-end phase, or -1 if not known
+};
+
+    /// The value of a counter (such as cache hits) at some point in a compile
+struct CompileProfileCounter
+{
+    String name;                    ///< The name of the counter
+    uint64_t tick = 0;              ///< When the value was recorded, in ProcessUtil clock ticks
+    Int value = 0;                  ///< The value
+};
+
+    /// Records how long each phase of a compile takes, along with the change in
+    /// size of the IR module for each IR pass, and AST allocations for each front-end phase.
+    ///
+    /// Events can be added from multiple threads (such as downstream compiles run on a pool).
+class CompileProfiler : public RefObject
+{
+public:
+    static const char* kFrontEndCategory;       ///< Preprocessing, parsing, checking and lowering to IR
+    static const char* kBackEndCategory;        ///< Code generation for an entry point as a whole
+    static const char* kIRPassCategory;         ///< A single pass over the IR of an entry point
+    static const char* kDownstreamCategory;     ///< An invocation of a downstream compiler
+
+        /// Add an event, moving it into the profiler. The thread index of the event is set from the calling thread.
+        ///
+        /// The event is moved (rather than copied) under the profiler's lock, so that no
+        /// strings are shared between the calling thread and the profiler.
+    void addEvent(CompileProfileEvent& event);
+
+        /// Record the value of a counter at the current time
+    void addCounter(const char* name, Int value);
+
+        /// Get the counter values, in the order they were recorded.
+        /// Must not be called while counters may be added from other threads.
+    const List<CompileProfileCounter>& getCounters() const { return m_counters; }
+
+        /// Get the events, in the order they completed.
+        /// Must not be called while events may be added from other threads.
+    const List<CompileProfileEvent>& getEvents() const { return m_events; }
+
+        /// Get the tick when the profiler was created. Event times are reported relative to this.
+    uint64_t getStartTick() const { return m_startTick; }
+
+        /// Convert a tick relative to the start of the profile into seconds
+    double calcSecondsSinceStart(uint64_t tick) const;
+
+        /// Write the events and counters in the Chrome trace event JSON format (as loaded by chrome://tracing)
+    void writeChromeTrace(StringBuilder& out) const;
+
+        /// Count all of the instructions in module
+    static Int calcInstCount(IRModule* module);
+
+        /// Ctor
+    CompileProfiler();
+
+protected:
+    Index _getThreadIndex();
+
+    std::mutex m_mutex;
+    uint64_t m_startTick;
+    List<CompileProfileEvent> m_events;
+    List<CompileProfileCounter> m_counters;
+    List<std::thread::id> m_threadIds;          ///< Maps a thread index to the thread
+};
+
+    /// The number of IR instructions with one opcode
+struct IRInstOpCount
+{
+    int32_t op = 0;                 ///< The `IROp`
+    Index count = 0;                ///< The number of instructions
+};
+
+    /// The IR instructions in an entry point's module after one of the major stages of code generation
+struct IRStageInstCounts
+{
+    String stageName;               ///< The stage, such as "link" or "optimize"
+    Index instCount = 0;            ///< The total number of instructions in the module
+    List<IRInstOpCount> opCounts;   ///< The number of instructions with each opcode, most frequent first
+};
+
+    /// The size of the code generated for an entry point (or for entry points emitted together) on a target
+struct EntryPointCodeReport
+{
+    String entryPointName;          ///< The name of the entry point (comma separated if there are several)
+    String targetName;              ///< The name of the target
+
+    List<IRStageInstCounts> stages; ///< The instructions after each major stage, in order
+
+    Index peakLiveValueCount = -1;  ///< The most SSA values live at once in any function of the final module, or -1 if not known
+    Index sourceByteCount = -1;     ///< Bytes of source code emitted, or -1 if not known
+    Index temporaryCount = -1;      ///< Temporaries declared by the emitter for instruction results, or -1 if not known
+
+        /// Record the instructions in module after the stage `stageName`
+    void addStage(const char* stageName, IRModule* module);
+
+        /// Get the number of instructions after the last stage, or 0 if none were recorded
+    Index getFinalInstCount() const { return stages.getCount() ? stages.getLast().instCount : 0; }
+
+        /// Calculate the most values (instruction results and block parameters) that are live
+        /// at the same point in a function, across all the functions of module. This is a
+        /// rough measure of the register pressure of the generated code.
+    static Index calcPeakLiveValueCount(IRModule* module);
+};
+
+    /// Collects a report of the size of the code generated for each entry point of a compile.
+    ///
+    /// Reports can be added from multiple threads.
+class CodeReport : public RefObject
+{
+public:
+        /// Add the report for an entry point, moving it into this report
+    void addEntryPoint(EntryPointCodeReport& report);
+
+        /// Get the entry point reports, in the order they were added.
+        /// Must not be called while reports may be added from other threads.
+    const List<EntryPointCodeReport>& getEntryPoints() const { return m_entryPoints; }
+
+        /// Write the report as JSON
+    void writeJSON(StringBuilder& out) const;
+
+protected:
+    std::mutex m_mutex;
+    List<EntryPointCodeReport> m_entryPoints;
+};
+
+    /// Adds an event to a profiler covering the lifetime of the scope.
+    ///
+    /// If the profiler is null nothing is recorded, so scopes can be left
+    /// in place at little cost when profiling is not enabled.
+struct CompileProfileScope
+{
+        /// Time a phase
+    CompileProfileScope(CompileProfiler* profiler, const char* category, const char* name, const String& detail = String());
+
+    ~CompileProfileScope();
+
+protected:
+    CompileProfileScope(CompileProfiler* profiler): m_profiler(profiler) {}
+
+        /// Record the AST allocations so far, if the event is in the front-end category
+    void _startASTStats();
+
+    CompileProfiler* m_profiler;
+    IRModule* m_module = nullptr;
+    CompileProfileEvent m_event;
+};
+
+    /// A CompileProfileScope for a pass over an IR module, that also records the
+    /// instruction count and memory used by the module before and after the pass.
+struct IRPassProfileScope : CompileProfileScope
+{
+        /// Time a pass over module. module can be null if the pass creates the module (see `setModule`).
+    IRPassProfileScope(CompileProfiler* profiler, const char* name, IRModule* module, const char* category = CompileProfiler::kIRPassCategory);
+
+        /// Set the module the pass produced. The state after the pass is taken from it.
+    void setModule(IRModule* module) { m_module = module; }
+};
+
+} // namespace Slang
+
+#endif
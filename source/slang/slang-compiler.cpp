@@ -3,18 +3,25 @@
 #include "../core/slang-basic.h"
 #include "../core/slang-platform.h"
 #include "../core/slang-io.h"
+#include "../core/slang-kernel-container.h"
 #include "../core/slang-string-util.h"
+#include "../core/slang-thread-pool.h"
+#include "../core/slang-writer.h"
 
 #include "slang-compiler.h"
+#include "slang-compile-cache.h"
 #include "slang-lexer.h"
 #include "slang-lower-to-ir.h"
 #include "slang-parameter-binding.h"
 #include "slang-parser.h"
+#include "slang-precompiled-module.h"
 #include "slang-preprocessor.h"
 #include "slang-syntax-visitors.h"
 #include "slang-type-layout.h"
 #include "slang-reflection.h"
 #include "slang-emit.h"
+#include "slang-emit-spirv.h"
+#include "slang-ir-serialize.h"
 
 // Enable calling through to `fxc` or `dxc` to
 // generate code on Windows.
@@ -51,6 +58,9 @@
 #include "../slang-glslang/slang-glslang.h"
 #endif
 
+#include <atomic>
+#include <mutex>
+
 // Includes to allow us to control console
 // output when writing assembly dumps.
 #include <fcntl.h>
@@ -142,32 +152,66 @@ namespace Slang
         {
             outputString.append(result.outputString.getBuffer());
         }
-        else if (appendTo == ResultFormat::Binary)
+        else if (appendTo == ResultFormat::Binary && result.blob)
+        {
+            List<uint8_t> data;
+            if (blob)
+            {
+                data.addRange((const uint8_t*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+            }
+            data.addRange((const uint8_t*)result.blob->getBufferPointer(), Index(result.blob->getBufferSize()));
+            blob = createListBlob(data);
+        }
+
+        // A text blob no longer matches the text
+        if (appendTo == ResultFormat::Text)
+        {
+            blob.setNull();
+        }
+    }
+
+    size_t CompileResult::calcOutputSize() const
+    {
+        switch (format)
         {
-            outputBinary.addRange(result.outputBinary.getBuffer(), result.outputBinary.getCount());
+            case ResultFormat::Text:    return size_t(outputString.getLength());
+            case ResultFormat::Binary:  return blob ? blob->getBufferSize() : 0;
+            default:                    return 0;
         }
     }
 
     ComPtr<ISlangBlob> CompileResult::getBlob()
     {
-        if(!blob)
+        // A string blob shares the string's buffer, so the text isn't copied
+        if (!blob && format == ResultFormat::Text)
         {
-            switch(format)
-            {
-            case ResultFormat::None:
-            default:
-                break;
+            blob = StringUtil::createStringBlob(outputString);
+        }
+        return blob;
+    }
 
+    void const* CompileResult::getData(size_t& outSize) const
+    {
+        switch (format)
+        {
             case ResultFormat::Text:
-                blob = StringUtil::createStringBlob(outputString);
-                break;
-
+            {
+                outSize = size_t(outputString.getLength());
+                return outputString.getBuffer();
+            }
             case ResultFormat::Binary:
-                blob = createRawBlob(outputBinary.getBuffer(), outputBinary.getCount());
+            {
+                if (blob)
+                {
+                    outSize = blob->getBufferSize();
+                    return blob->getBufferPointer();
+                }
                 break;
             }
+            default: break;
         }
-        return blob;
+        outSize = 0;
+        return nullptr;
     }
 
     //
@@ -405,7 +449,7 @@ namespace Slang
         return SLANG_E_NOT_IMPLEMENTED;
     }
 
-    static PassThroughMode _getExternalCompilerRequiredForTarget(CodeGenTarget target)
+    PassThroughMode getExternalCompilerRequiredForTarget(CodeGenTarget target)
     {
         switch (target)
         {
@@ -454,9 +498,26 @@ namespace Slang
         return PassThroughMode::None;
     }
 
+    SharedLibraryType getPassThroughSharedLibraryType(PassThroughMode passThrough)
+    {
+        switch (passThrough)
+        {
+#if SLANG_ENABLE_DXIL_SUPPORT
+            case PassThroughMode::dxc:      return SharedLibraryType::Dxc;
+#endif
+#if SLANG_ENABLE_DXBC_SUPPORT
+            case PassThroughMode::fxc:      return SharedLibraryType::Fxc;
+#endif
+#if SLANG_ENABLE_GLSLANG_SUPPORT
+            case PassThroughMode::glslang:  return SharedLibraryType::Glslang;
+#endif
+            default:                        return SharedLibraryType::Unknown;
+        }
+    }
+
     SlangResult checkCompileTargetSupport(Session* session, CodeGenTarget target)
     {
-        const PassThroughMode mode = _getExternalCompilerRequiredForTarget(target);
+        const PassThroughMode mode = getExternalCompilerRequiredForTarget(target);
         return (mode != PassThroughMode::None) ?
             checkExternalCompilerSupport(session, mode) :
             SLANG_OK;
@@ -485,12 +546,96 @@ namespace Slang
         return translationUnit;
     }
 
+    // Defined in slang-emit.cpp
+    EntryPointLayout* findEntryPointLayout(
+        ProgramLayout*          programLayout,
+        EntryPoint*             entryPoint,
+        EntryPointGroupLayout** outEntryPointGroupLayout);
+
+        /// Emit the HLSL for `entryPoint`, or reuse the HLSL another target of the request already emitted.
+        ///
+        /// The HLSL, DXBC and DXIL targets all link, optimize and emit the same HLSL for an entry point,
+        /// so a request with more than one of them only has to do that work once. The source is reused
+        /// when everything that affects it matches: the entry point, its effective profile, and the
+        /// target's flags, floating point mode and matrix layout.
+        ///
+    static String _emitSharedHLSLForEntryPoint(
+        BackEndCompileRequest*  compileRequest,
+        EntryPoint*             entryPoint,
+        Int                     entryPointIndex,
+        TargetRequest*          targetReq,
+        ISlangBlob**            outSourceMap)
+    {
+        auto cache = compileRequest->emittedSourceCache;
+
+        // Dumps and code reports are made per target, so they need the code to be emitted for each one
+        if (!cache || compileRequest->shouldDumpIR || compileRequest->getLinkage()->getCodeReport())
+        {
+            return emitEntryPoint(compileRequest, entryPoint, CodeGenTarget::HLSL, targetReq, outSourceMap);
+        }
+
+        auto profile = getEffectiveProfile(entryPoint, targetReq);
+
+        StringBuilder keyBuilder;
+        keyBuilder << entryPointIndex << ":" << getText(entryPoint->getName());
+        keyBuilder << ":" << UInt(profile.raw);
+        keyBuilder << ":" << UInt(targetReq->targetFlags);
+        keyBuilder << ":" << Int(targetReq->getFloatingPointMode());
+        keyBuilder << ":" << Int(targetReq->getDefaultMatrixLayoutMode());
+        keyBuilder << ":" << Int(compileRequest->getLineDirectiveMode());
+        String key = keyBuilder.ProduceString();
+
+        auto programLayout = compileRequest->getProgram()->getTargetProgram(targetReq)->getOrCreateLayout(compileRequest->getSink());
+        auto entryPointLayout = programLayout ? findEntryPointLayout(programLayout, entryPoint, nullptr) : nullptr;
+
+        if (auto entry = cache->entries.TryGetValue(key))
+        {
+            if (entryPointLayout)
+            {
+                entryPointLayout->usedGlobalParameters = entry->usedGlobalParameters;
+                entryPointLayout->hasUsedGlobalParameters = entry->hasUsedGlobalParameters;
+            }
+            if (outSourceMap)
+            {
+                *outSourceMap = ComPtr<ISlangBlob>(entry->sourceMap).detach();
+            }
+            return entry->code;
+        }
+
+        auto sink = compileRequest->getSink();
+        const auto errorCount = sink->GetErrorCount();
+
+        // The source map is kept with the code, for any target that reuses it
+        ComPtr<ISlangBlob> sourceMap;
+        String code = emitEntryPoint(compileRequest, entryPoint, CodeGenTarget::HLSL, targetReq, sourceMap.writeRef());
+        if (outSourceMap)
+        {
+            *outSourceMap = ComPtr<ISlangBlob>(sourceMap).detach();
+        }
+
+        // Failed emits are repeated, so that each target reports its errors
+        if (sink->GetErrorCount() == errorCount)
+        {
+            EmittedSourceCache::Entry entry;
+            entry.code = code;
+            entry.sourceMap = sourceMap;
+            if (entryPointLayout)
+            {
+                entry.usedGlobalParameters = entryPointLayout->usedGlobalParameters;
+                entry.hasUsedGlobalParameters = entryPointLayout->hasUsedGlobalParameters;
+            }
+            cache->entries.Add(key, entry);
+        }
+        return code;
+    }
+
     String emitHLSLForEntryPoint(
         BackEndCompileRequest*  compileRequest,
         EntryPoint*             entryPoint,
         Int                     entryPointIndex,
         TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        ISlangBlob**            outSourceMap = nullptr)
     {
         if(auto translationUnit = findPassThroughTranslationUnit(endToEndReq, entryPointIndex))
         {
@@ -529,11 +674,12 @@ namespace Slang
         }
         else
         {
-            return emitEntryPoint(
+            return _emitSharedHLSLForEntryPoint(
                 compileRequest,
                 entryPoint,
-                CodeGenTarget::HLSL,
-                targetReq);
+                entryPointIndex,
+                targetReq,
+                outSourceMap);
         }
     }
 
@@ -542,7 +688,8 @@ namespace Slang
         EntryPoint*             entryPoint,
         Int                     entryPointIndex,
         TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq)
+        EndToEndCompileRequest* endToEndReq,
+        ISlangBlob**            outSourceMap = nullptr)
     {
         if(auto translationUnit = findPassThroughTranslationUnit(endToEndReq, entryPointIndex))
         {
@@ -580,7 +727,8 @@ namespace Slang
                 compileRequest,
                 entryPoint,
                 CodeGenTarget::GLSL,
-                targetReq);
+                targetReq,
+                outSourceMap);
         }
     }
 
@@ -703,6 +851,105 @@ namespace Slang
         }
     }
 
+    DownstreamCompile::DownstreamCompile(BackEndCompileRequest* request, const char* compilerName, const String& source)
+        : sink(request->getSink()->sourceManager)
+        , m_compilerName(compilerName)
+        , m_source(source.getUnownedSlice())
+        , m_profiler(request->getLinkage()->getProfiler())
+    {
+        sink.copyOptions(*request->getSink());
+    }
+
+    void DownstreamCompile::setCacheKey(
+        BackEndCompileRequest*          request,
+        Session::SharedLibraryFuncType  compilerFunc,
+        const String&                   options)
+    {
+        m_cacheKey = String();
+
+        auto linkage = request->getLinkage();
+        if (linkage->compileCacheDirectory.getLength() == 0 && !linkage->compileCache)
+        {
+            return;
+        }
+
+        // Without knowing which build of the compiler is used, outputs can't be cached
+        const String compilerIdentity = request->getSession()->getSharedLibraryFuncIdentity(compilerFunc);
+        if (compilerIdentity.getLength() == 0)
+        {
+            return;
+        }
+
+        StringBuilder keyBuilder;
+        CompileCache::calcDownstreamKey(m_compilerName, compilerIdentity.getUnownedSlice(), m_source.getUnownedSlice(), options.getUnownedSlice(), keyBuilder);
+        m_cacheKey = keyBuilder.ProduceString();
+
+        m_cacheDirectory = String(linkage->compileCacheDirectory.getUnownedSlice());
+        m_cacheMaxSize = linkage->compileCacheMaxSize;
+        m_compileCache = linkage->compileCache;
+    }
+
+    void DownstreamCompile::execute()
+    {
+        code.setNull();
+
+        // A lookup can be a round trip to another machine, so like the compile it is
+        // made here rather than when the compile is set up
+        if (m_cacheKey.getLength())
+        {
+            CompileProfileScope profileScope(m_profiler, CompileProfiler::kDownstreamCategory, "compile-cache");
+
+            SlangResult res = SLANG_E_NOT_FOUND;
+            List<uint8_t> cachedCode;
+            if (m_cacheDirectory.getLength())
+            {
+                res = CompileCache::readDownstream(m_cacheDirectory, m_cacheKey, cachedCode);
+            }
+            if (SLANG_FAILED(res) && m_compileCache)
+            {
+                res = CompileCache::readDownstream(m_compileCache, m_cacheKey, cachedCode);
+
+                // Held locally, so later compiles don't need to go to the application's cache
+                if (SLANG_SUCCEEDED(res) && m_cacheDirectory.getLength())
+                {
+                    CompileCache::writeDownstream(m_cacheDirectory, m_cacheMaxSize, m_cacheKey, cachedCode.getBuffer(), size_t(cachedCode.getCount()));
+                }
+            }
+            if (SLANG_SUCCEEDED(res))
+            {
+                code = createListBlob(cachedCode);
+                result = SLANG_OK;
+                return;
+            }
+        }
+
+        {
+            CompileProfileScope profileScope(m_profiler, CompileProfiler::kDownstreamCategory, m_compilerName);
+            result = _compile(code);
+        }
+
+        // Failing to store doesn't fail the compile
+        if (SLANG_SUCCEEDED(result) && code && m_cacheKey.getLength())
+        {
+            if (m_cacheDirectory.getLength())
+            {
+                CompileCache::writeDownstream(m_cacheDirectory, m_cacheMaxSize, m_cacheKey, code->getBufferPointer(), code->getBufferSize());
+            }
+            if (m_compileCache)
+            {
+                CompileCache::writeDownstream(m_compileCache, m_cacheKey, code->getBufferPointer(), code->getBufferSize());
+            }
+        }
+    }
+
+    SlangResult runDownstreamCompile(BackEndCompileRequest* compileRequest, DownstreamCompile* compile, ComPtr<ISlangBlob>& outCode)
+    {
+        compile->execute();
+        compileRequest->getSink()->appendDiagnostics(compile->sink);
+        outCode = compile->code;
+        return compile->result;
+    }
+
     String calcSourcePathForEntryPoint(
         EndToEndCompileRequest* endToEndReq,
         UInt                    entryPointIndex)
@@ -748,16 +995,83 @@ namespace Slang
         return UnownedStringSlice();
     }
 
-    SlangResult emitDXBytecodeForEntryPoint(
-        BackEndCompileRequest*  compileRequest,
-        EntryPoint*             entryPoint,
-        Int                     entryPointIndex,
-        TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq,
-        List<uint8_t>&          byteCodeOut)
+        /// Compiles HLSL to DXBC with fxc
+    class FxcCompile : public DownstreamCompile
     {
-        byteCodeOut.clear();
+    public:
+        FxcCompile(BackEndCompileRequest* request, const String& source, pD3DCompile compileFunc)
+            : DownstreamCompile(request, "fxc", source)
+            , m_compileFunc(compileFunc)
+        {
+        }
+
+        // The strings are copies, that don't share their buffers with any others
+        String sourcePath;
+        String entryPointName;
+        String profileName;
+        List<KeyValuePair<String, String>> defines;
+        DWORD flags = 0;
+
+    protected:
+        virtual SlangResult _compile(ComPtr<ISlangBlob>& outCode) SLANG_OVERRIDE
+        {
+            List<D3D_SHADER_MACRO> dxMacrosStorage;
+            D3D_SHADER_MACRO const* dxMacros = nullptr;
+            if (defines.getCount())
+            {
+                for (auto& define : defines)
+                {
+                    D3D_SHADER_MACRO dxMacro;
+                    dxMacro.Name = define.Key.getBuffer();
+                    dxMacro.Definition = define.Value.getBuffer();
+                    dxMacrosStorage.add(dxMacro);
+                }
+                D3D_SHADER_MACRO nullTerminator = { 0, 0 };
+                dxMacrosStorage.add(nullTerminator);
+
+                dxMacros = dxMacrosStorage.getBuffer();
+            }
+
+            ComPtr<ID3DBlob> codeBlob;
+            ComPtr<ID3DBlob> diagnosticsBlob;
+            HRESULT hr = m_compileFunc(
+                m_source.begin(),
+                m_source.getLength(),
+                sourcePath.getBuffer(),
+                dxMacros,
+                nullptr,
+                entryPointName.getBuffer(),
+                profileName.getBuffer(),
+                flags,
+                0, // unused: effect flags
+                codeBlob.writeRef(),
+                diagnosticsBlob.writeRef());
+
+            if (codeBlob && SLANG_SUCCEEDED(hr))
+            {
+                // The output is held in fxc's blob rather than copied out of it
+                outCode = createOwnedDataBlob((ISlangUnknown*)codeBlob.get(), codeBlob->GetBufferPointer(), size_t(codeBlob->GetBufferSize()));
+            }
+
+            if (FAILED(hr))
+            {
+                reportExternalCompileError("fxc", hr, _getSlice(diagnosticsBlob), &sink);
+            }
+
+            return hr;
+        }
 
+        pD3DCompile m_compileFunc;
+    };
+
+    SlangResult createDXBytecodeCompileForEntryPoint(
+        BackEndCompileRequest*      compileRequest,
+        EntryPoint*                 entryPoint,
+        Int                         entryPointIndex,
+        TargetRequest*              targetReq,
+        EndToEndCompileRequest*     endToEndReq,
+        RefPtr<DownstreamCompile>&  outCompile)
+    {
         auto session = compileRequest->getSession();
         auto sink = compileRequest->getSink();
 
@@ -770,6 +1084,8 @@ namespace Slang
         auto hlslCode = emitHLSLForEntryPoint(compileRequest, entryPoint, entryPointIndex, targetReq, endToEndReq);
         maybeDumpIntermediate(compileRequest, hlslCode.getBuffer(), CodeGenTarget::HLSL);
 
+        RefPtr<FxcCompile> compile = new FxcCompile(compileRequest, hlslCode, compileFunc);
+
         auto profile = getEffectiveProfile(entryPoint, targetReq);
 
         // If we have been invoked in a pass-through mode, then we need to make sure
@@ -778,28 +1094,16 @@ namespace Slang
         //
         // TODO: more pieces of information should be added here as needed.
         //
-        List<D3D_SHADER_MACRO> dxMacrosStorage;
-        D3D_SHADER_MACRO const* dxMacros = nullptr;
         if(auto translationUnit = findPassThroughTranslationUnit(endToEndReq, entryPointIndex))
         {
             for( auto& define :  translationUnit->compileRequest->preprocessorDefinitions )
             {
-                D3D_SHADER_MACRO dxMacro;
-                dxMacro.Name = define.Key.getBuffer();
-                dxMacro.Definition = define.Value.getBuffer();
-                dxMacrosStorage.add(dxMacro);
+                compile->defines.add(KeyValuePair<String, String>(String(define.Key.getUnownedSlice()), String(define.Value.getUnownedSlice())));
             }
             for( auto& define : translationUnit->preprocessorDefinitions )
             {
-                D3D_SHADER_MACRO dxMacro;
-                dxMacro.Name = define.Key.getBuffer();
-                dxMacro.Definition = define.Value.getBuffer();
-                dxMacrosStorage.add(dxMacro);
+                compile->defines.add(KeyValuePair<String, String>(String(define.Key.getUnownedSlice()), String(define.Value.getUnownedSlice())));
             }
-            D3D_SHADER_MACRO nullTerminator = { 0, 0 };
-            dxMacrosStorage.add(nullTerminator);
-
-            dxMacros = dxMacrosStorage.getBuffer();
         }
 
         DWORD flags = 0;
@@ -833,7 +1137,7 @@ namespace Slang
         default:
             break;
 
-        case OptimizationLevel::None:       flags |= D3DCOMPILE_OPTIMIZATION_LEVEL0; break;
+        case OptimizationLevel::None:       flags |= D3DCOMPILE_SKIP_OPTIMIZATION; break;
         case OptimizationLevel::Default:    flags |= D3DCOMPILE_OPTIMIZATION_LEVEL1; break;
         case OptimizationLevel::High:       flags |= D3DCOMPILE_OPTIMIZATION_LEVEL2; break;
         case OptimizationLevel::Maximal:    flags |= D3DCOMPILE_OPTIMIZATION_LEVEL3; break;
@@ -849,34 +1153,24 @@ namespace Slang
             break;
         }
 
-        const String sourcePath = calcSourcePathForEntryPoint(endToEndReq, entryPointIndex);
-
-        ComPtr<ID3DBlob> codeBlob;
-        ComPtr<ID3DBlob> diagnosticsBlob;
-        HRESULT hr = compileFunc(
-            hlslCode.begin(),
-            hlslCode.getLength(),
-            sourcePath.getBuffer(),
-            dxMacros,
-            nullptr,
-            getText(entryPoint->getName()).begin(),
-            GetHLSLProfileName(profile).getBuffer(),
-            flags,
-            0, // unused: effect flags
-            codeBlob.writeRef(),
-            diagnosticsBlob.writeRef());
-
-        if (codeBlob && SLANG_SUCCEEDED(hr))
+        compile->flags = flags;
+        compile->sourcePath = String(calcSourcePathForEntryPoint(endToEndReq, entryPointIndex).getUnownedSlice());
+        compile->entryPointName = String(getText(entryPoint->getName()).getUnownedSlice());
+        compile->profileName = String(GetHLSLProfileName(profile).getUnownedSlice());
+
+        StringBuilder cacheOptions;
+        cacheOptions << "source-path: " << compile->sourcePath << "\n";
+        cacheOptions << "entry-point: " << compile->entryPointName << "\n";
+        cacheOptions << "profile: " << compile->profileName << "\n";
+        cacheOptions << "flags: " << uint32_t(flags) << "\n";
+        for (auto& define : compile->defines)
         {
-            byteCodeOut.addRange((uint8_t const*)codeBlob->GetBufferPointer(), (int)codeBlob->GetBufferSize());
+            cacheOptions << "define: " << define.Key << "=" << define.Value << "\n";
         }
+        compile->setCacheKey(compileRequest, Session::SharedLibraryFuncType::Fxc_D3DCompile, cacheOptions);
 
-        if (FAILED(hr))
-        {
-            reportExternalCompileError("fxc", hr, _getSlice(diagnosticsBlob), sink);
-        }
-                
-        return hr;
+        outCompile = compile;
+        return SLANG_OK;
     }
 
     SlangResult dissassembleDXBC(
@@ -916,43 +1210,25 @@ namespace Slang
 
         return res;
     }
-
-    SlangResult emitDXBytecodeAssemblyForEntryPoint(
-        BackEndCompileRequest*  compileRequest,
-        EntryPoint*             entryPoint,
-        Int                     entryPointIndex,
-        TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq,
-        String&                 assemOut)
-    {
-
-        List<uint8_t> dxbc;
-        SLANG_RETURN_ON_FAIL(emitDXBytecodeForEntryPoint(
-            compileRequest,
-            entryPoint,
-            entryPointIndex,
-            targetReq,
-            endToEndReq,
-            dxbc));
-        if (!dxbc.getCount())
-        {
-            return SLANG_FAIL;
-        }
-        return dissassembleDXBC(compileRequest, dxbc.getBuffer(), dxbc.getCount(), assemOut);
-    }
 #endif
 
 #if SLANG_ENABLE_DXIL_SUPPORT
 
 // Implementations in `dxc-support.cpp`
 
-SlangResult emitDXILForEntryPointUsingDXC(
-    BackEndCompileRequest*  compileRequest,
-    EntryPoint*             entryPoint,
-    Int                     entryPointIndex,
-    TargetRequest*          targetReq,
-    EndToEndCompileRequest* endToEndReq,
-    List<uint8_t>&          outCode);
+SlangResult createDXILCompileForEntryPoint(
+    BackEndCompileRequest*      compileRequest,
+    EntryPoint*                 entryPoint,
+    Int                         entryPointIndex,
+    TargetRequest*              targetReq,
+    EndToEndCompileRequest*     endToEndReq,
+    RefPtr<DownstreamCompile>&  outCompile);
+
+SlangResult emitDXILLibraryUsingDXC(
+    BackEndCompileRequest*      compileRequest,
+    const List<EntryPoint*>&    entryPoints,
+    TargetRequest*              targetReq,
+    ComPtr<ISlangBlob>&         outCode);
 
 SlangResult dissassembleDXILUsingDXC(
     BackEndCompileRequest*  compileRequest,
@@ -963,19 +1239,12 @@ SlangResult dissassembleDXILUsingDXC(
 #endif
 
 #if SLANG_ENABLE_GLSLANG_SUPPORT
-    SlangResult invokeGLSLCompiler(
-        BackEndCompileRequest*      slangCompileRequest,
-        glslang_CompileRequest&     request)
+        /// Run glslang_compile on request, reporting any errors to sink
+    static SlangResult _invokeGLSLCompiler(
+        glslang_CompileFunc         glslang_compile,
+        glslang_CompileRequest&     request,
+        DiagnosticSink*             sink)
     {
-        Session* session = slangCompileRequest->getSession();
-        auto sink = slangCompileRequest->getSink();
-
-        auto glslang_compile = (glslang_CompileFunc)session->getSharedLibraryFunc(Session::SharedLibraryFuncType::Glslang_Compile, sink);
-        if (!glslang_compile)
-        {
-            return SLANG_FAIL;
-        }
-
         StringBuilder diagnosticOutput;
         
         auto diagnosticOutputFunc = [](void const* data, size_t size, void* userData)
@@ -987,7 +1256,6 @@ SlangResult dissassembleDXILUsingDXC(
         request.diagnosticUserData = &diagnosticOutput;
 
         int err = glslang_compile(&request);
-
         if (err)
         {
             reportExternalCompileError("glslang", SLANG_FAIL, diagnosticOutput.getUnownedSlice(), sink);
@@ -997,6 +1265,23 @@ SlangResult dissassembleDXILUsingDXC(
         return SLANG_OK;
     }
 
+    SlangResult invokeGLSLCompiler(
+        BackEndCompileRequest*      slangCompileRequest,
+        glslang_CompileRequest&     request)
+    {
+        Session* session = slangCompileRequest->getSession();
+        auto sink = slangCompileRequest->getSink();
+
+        auto glslang_compile = (glslang_CompileFunc)session->getSharedLibraryFunc(Session::SharedLibraryFuncType::Glslang_Compile, sink);
+        if (!glslang_compile)
+        {
+            return SLANG_FAIL;
+        }
+
+        CompileProfileScope profileScope(slangCompileRequest->getLinkage()->getProfiler(), CompileProfiler::kDownstreamCategory, "glslang");
+        return _invokeGLSLCompiler(glslang_compile, request, sink);
+    }
+
     SlangResult dissassembleSPIRV(
         BackEndCompileRequest*  slangRequest,
         void const*             data,
@@ -1028,70 +1313,194 @@ SlangResult dissassembleDXILUsingDXC(
         return SLANG_OK;
     }
 
-    SlangResult emitSPIRVForEntryPoint(
-        BackEndCompileRequest*  slangRequest,
-        EntryPoint*             entryPoint,
-        Int                     entryPointIndex,
-        TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq,
-        List<uint8_t>&          spirvOut)
+        /// Compiles GLSL to SPIR-V with glslang
+    class GlslangCompile : public DownstreamCompile
     {
-        spirvOut.clear();
+    public:
+        GlslangCompile(BackEndCompileRequest* request, const String& source, glslang_CompileFunc compileFunc)
+            : DownstreamCompile(request, "glslang", source)
+            , m_compileFunc(compileFunc)
+        {
+        }
 
-        String rawGLSL = emitGLSLForEntryPoint(
-            slangRequest,
-            entryPoint,
-            entryPointIndex,
-            targetReq,
-            endToEndReq);
-        maybeDumpIntermediate(slangRequest, rawGLSL.getBuffer(), CodeGenTarget::GLSL);
+        String sourcePath;                  ///< A copy, that doesn't share its buffer with any other string
+        Stage stage = Stage::Unknown;
 
-        auto outputFunc = [](void const* data, size_t size, void* userData)
+    protected:
+        virtual SlangResult _compile(ComPtr<ISlangBlob>& outCode) SLANG_OVERRIDE
         {
-            ((List<uint8_t>*)userData)->addRange((uint8_t*)data, size);
-        };
+            // The output is built in a list, which the blob output takes without copying
+            List<uint8_t> spirv;
+
+            auto outputFunc = [](void const* data, size_t size, void* userData)
+            {
+                ((List<uint8_t>*)userData)->addRange((uint8_t*)data, size);
+            };
 
-        const String sourcePath = calcSourcePathForEntryPoint(endToEndReq, entryPointIndex);
+            glslang_CompileRequest request;
+            request.action = GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV;
+            request.sourcePath = sourcePath.getBuffer();
+            request.slangStage = (SlangStage)stage;
 
-        glslang_CompileRequest request;
-        request.action = GLSLANG_ACTION_COMPILE_GLSL_TO_SPIRV;
-        request.sourcePath = sourcePath.getBuffer();
-        request.slangStage = (SlangStage)entryPoint->getStage();
+            request.inputBegin  = m_source.begin();
+            request.inputEnd    = m_source.end();
 
-        request.inputBegin  = rawGLSL.begin();
-        request.inputEnd    = rawGLSL.end();
+            request.outputFunc = outputFunc;
+            request.outputUserData = &spirv;
 
-        request.outputFunc = outputFunc;
-        request.outputUserData = &spirvOut;
+            // glslang reference counts its process wide initialization internally,
+            // so compiles can run on several threads at once
+            SLANG_RETURN_ON_FAIL(_invokeGLSLCompiler(m_compileFunc, request, &sink));
+            outCode = createListBlob(spirv);
+            return SLANG_OK;
+        }
 
-        SLANG_RETURN_ON_FAIL(invokeGLSLCompiler(slangRequest, request));
-        return SLANG_OK;
-    }
+        glslang_CompileFunc m_compileFunc;
+    };
 
-    SlangResult emitSPIRVAssemblyForEntryPoint(
-        BackEndCompileRequest*  slangRequest,
-        EntryPoint*             entryPoint,
-        Int                     entryPointIndex,
-        TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq,
-        String&                 assemblyOut)
+        /// Generate SPIR-V for an entry point. If the SPIR-V is generated directly it is returned
+        /// in spirvOut, and otherwise a compile of GLSL by glslang is returned in outCompile.
+    SlangResult emitSPIRVForEntryPoint(
+        BackEndCompileRequest*      slangRequest,
+        EntryPoint*                 entryPoint,
+        Int                         entryPointIndex,
+        TargetRequest*              targetReq,
+        EndToEndCompileRequest*     endToEndReq,
+        ComPtr<ISlangBlob>&         spirvOut,
+        RefPtr<DownstreamCompile>&  outCompile)
     {
-        List<uint8_t> spirv;
-        SLANG_RETURN_ON_FAIL(emitSPIRVForEntryPoint(
+        spirvOut.setNull();
+
+        if ((targetReq->targetFlags & SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY) &&
+            !findPassThroughTranslationUnit(endToEndReq, entryPointIndex))
+        {
+            // The output is built in a list, which the blob output takes without copying
+            List<uint8_t> spirv;
+
+            // Entry points the direct path doesn't support are compiled through GLSL
+            SlangResult res = emitSPIRVFromIR(slangRequest, entryPoint, targetReq, spirv);
+            if (res != SLANG_E_NOT_IMPLEMENTED)
+            {
+                if (SLANG_SUCCEEDED(res))
+                {
+                    spirvOut = createListBlob(spirv);
+                }
+                return res;
+            }
+        }
+
+        String rawGLSL = emitGLSLForEntryPoint(
             slangRequest,
             entryPoint,
             entryPointIndex,
             targetReq,
-            endToEndReq,
-            spirv));
+            endToEndReq);
+        maybeDumpIntermediate(slangRequest, rawGLSL.getBuffer(), CodeGenTarget::GLSL);
 
-        if (spirv.getCount() == 0)
+        auto glslang_compile = (glslang_CompileFunc)slangRequest->getSession()->getSharedLibraryFunc(Session::SharedLibraryFuncType::Glslang_Compile, slangRequest->getSink());
+        if (!glslang_compile)
+        {
             return SLANG_FAIL;
+        }
+
+        RefPtr<GlslangCompile> compile = new GlslangCompile(slangRequest, rawGLSL, glslang_compile);
+        compile->sourcePath = String(calcSourcePathForEntryPoint(endToEndReq, entryPointIndex).getUnownedSlice());
+        compile->stage = entryPoint->getStage();
 
-        return dissassembleSPIRV(slangRequest, spirv.begin(), spirv.getCount(), assemblyOut);
+        StringBuilder cacheOptions;
+        cacheOptions << "source-path: " << compile->sourcePath << "\n";
+        cacheOptions << "stage: " << int(compile->stage) << "\n";
+        compile->setCacheKey(slangRequest, Session::SharedLibraryFuncType::Glslang_Compile, cacheOptions);
+
+        outCompile = compile;
+        return SLANG_OK;
     }
 #endif
 
+        /// Make the result for an entry point from the code a downstream compile produced (null if it failed).
+        /// For the assembly targets the code is disassembled.
+    static CompileResult _makeDownstreamCompileResult(
+        BackEndCompileRequest*  compileRequest,
+        CodeGenTarget           target,
+        ISlangBlob*             code)
+    {
+        if (!code)
+        {
+            return CompileResult();
+        }
+
+        switch (target)
+        {
+#if SLANG_ENABLE_DXBC_SUPPORT
+        case CodeGenTarget::DXBytecodeAssembly:
+            {
+                String assembly;
+                if (code->getBufferSize() == 0 ||
+                    SLANG_FAILED(dissassembleDXBC(compileRequest, code->getBufferPointer(), code->getBufferSize(), assembly)))
+                {
+                    return CompileResult();
+                }
+                maybeDumpIntermediate(compileRequest, assembly.getBuffer(), target);
+                return CompileResult(assembly);
+            }
+#endif
+
+#if SLANG_ENABLE_DXIL_SUPPORT
+        case CodeGenTarget::DXILAssembly:
+            {
+                String assembly;
+                dissassembleDXILUsingDXC(compileRequest, code->getBufferPointer(), code->getBufferSize(), assembly);
+                maybeDumpIntermediate(compileRequest, assembly.getBuffer(), target);
+                return CompileResult(assembly);
+            }
+#endif
+
+        case CodeGenTarget::SPIRVAssembly:
+            {
+                String assembly;
+                if (code->getBufferSize() == 0 ||
+                    SLANG_FAILED(dissassembleSPIRV(compileRequest, code->getBufferPointer(), code->getBufferSize(), assembly)))
+                {
+                    return CompileResult();
+                }
+                maybeDumpIntermediate(compileRequest, assembly.getBuffer(), target);
+                return CompileResult(assembly);
+            }
+
+        default:
+            maybeDumpIntermediate(compileRequest, code->getBufferPointer(), code->getBufferSize(), target);
+            return CompileResult(code);
+        }
+    }
+
+        /// Make the result for an entry point once compile has run
+    static CompileResult _finishDownstreamCompileResult(
+        BackEndCompileRequest*  compileRequest,
+        CodeGenTarget           target,
+        DownstreamCompile*      compile)
+    {
+        compileRequest->getSink()->appendDiagnostics(compile->sink);
+        return _makeDownstreamCompileResult(compileRequest, target, SLANG_SUCCEEDED(compile->result) ? compile->code.get() : nullptr);
+    }
+
+        /// Run compile, and make the result for the entry point from its output. If the request has a
+        /// `downstreamCompilePool` the compile is submitted to it instead, and the result is empty.
+    static CompileResult _runDownstreamCompileForEntryPoint(
+        BackEndCompileRequest*  compileRequest,
+        CodeGenTarget           target,
+        DownstreamCompile*      compile)
+    {
+        if (compileRequest->downstreamCompilePool)
+        {
+            compile->isOnPool = true;
+            compileRequest->queuedDownstreamCompile = compile;
+            compileRequest->downstreamCompilePool->submit(compile);
+            return CompileResult();
+        }
+        compile->execute();
+        return _finishDownstreamCompileResult(compileRequest, target, compile);
+    }
+
     // Do emit logic for a single entry point
     CompileResult emitEntryPoint(
         BackEndCompileRequest*  compileRequest,
@@ -1108,72 +1517,65 @@ SlangResult dissassembleDXILUsingDXC(
         {
         case CodeGenTarget::HLSL:
             {
+                ComPtr<ISlangBlob> sourceMap;
                 String code = emitHLSLForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
                     targetReq,
-                    endToEndReq);
+                    endToEndReq,
+                    sourceMap.writeRef());
                 maybeDumpIntermediate(compileRequest, code.getBuffer(), target);
                 result = CompileResult(code);
+                result.sourceMap = sourceMap;
             }
             break;
 
         case CodeGenTarget::GLSL:
             {
+                ComPtr<ISlangBlob> sourceMap;
                 String code = emitGLSLForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
                     targetReq,
-                    endToEndReq);
+                    endToEndReq,
+                    sourceMap.writeRef());
                 maybeDumpIntermediate(compileRequest, code.getBuffer(), target);
                 result = CompileResult(code);
+                result.sourceMap = sourceMap;
             }
             break;
 
         case CodeGenTarget::CPPSource:
         case CodeGenTarget::CSource:
             {
-                return emitEntryPoint(
+                ComPtr<ISlangBlob> sourceMap;
+                String code = emitEntryPoint(
                     compileRequest,
                     entryPoint,
-                    target, 
-                    targetReq);
+                    target,
+                    targetReq,
+                    sourceMap.writeRef());
+                result = CompileResult(code);
+                result.sourceMap = sourceMap;
             }
             break;
 
 #if SLANG_ENABLE_DXBC_SUPPORT
         case CodeGenTarget::DXBytecode:
-            {
-                List<uint8_t> code;
-                if (SLANG_SUCCEEDED(emitDXBytecodeForEntryPoint(
-                    compileRequest,
-                    entryPoint,
-                    entryPointIndex,
-                    targetReq,
-                    endToEndReq,
-                    code)))
-                {
-                    maybeDumpIntermediate(compileRequest, code.getBuffer(), code.getCount(), target);
-                    result = CompileResult(code);
-                }
-            }
-            break;
-
         case CodeGenTarget::DXBytecodeAssembly:
             {
-                String code;
-                if (SLANG_SUCCEEDED(emitDXBytecodeAssemblyForEntryPoint(
+                RefPtr<DownstreamCompile> compile;
+                if (SLANG_SUCCEEDED(createDXBytecodeCompileForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
                     targetReq,
                     endToEndReq,
-                    code)))
+                    compile)))
                 {
-                    maybeDumpIntermediate(compileRequest, code.getBuffer(), target);
-                    result = CompileResult(code);
+                    result = _runDownstreamCompileForEntryPoint(compileRequest, target, compile);
                 }
             }
             break;
@@ -1181,78 +1583,40 @@ SlangResult dissassembleDXILUsingDXC(
 
 #if SLANG_ENABLE_DXIL_SUPPORT
         case CodeGenTarget::DXIL:
-            {
-                List<uint8_t> code;
-                if (SLANG_SUCCEEDED(emitDXILForEntryPointUsingDXC(
-                    compileRequest,
-                    entryPoint,
-                    entryPointIndex,
-                    targetReq,
-                    endToEndReq,
-                    code)))
-                {
-                    maybeDumpIntermediate(compileRequest, code.getBuffer(), code.getCount(), target);
-                    result = CompileResult(code);
-                }
-            }
-            break;
-
         case CodeGenTarget::DXILAssembly:
             {
-                List<uint8_t> code;
-                if (SLANG_SUCCEEDED(emitDXILForEntryPointUsingDXC(
+                RefPtr<DownstreamCompile> compile;
+                if (SLANG_SUCCEEDED(createDXILCompileForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
                     targetReq,
                     endToEndReq,
-                    code)))
+                    compile)))
                 {
-                    String assembly; 
-                    dissassembleDXILUsingDXC(
-                        compileRequest,
-                        code.getBuffer(),
-                        code.getCount(), 
-                        assembly);
-
-                    maybeDumpIntermediate(compileRequest, assembly.getBuffer(), target);
-
-                    result = CompileResult(assembly);
+                    result = _runDownstreamCompileForEntryPoint(compileRequest, target, compile);
                 }
             }
             break;
 #endif
 
         case CodeGenTarget::SPIRV:
-            {
-                List<uint8_t> code;
-                if (SLANG_SUCCEEDED(emitSPIRVForEntryPoint(
-                    compileRequest,
-                    entryPoint,
-                    entryPointIndex,
-                    targetReq,
-                    endToEndReq,
-                    code)))
-                {
-                    maybeDumpIntermediate(compileRequest, code.getBuffer(), code.getCount(), target);
-                    result = CompileResult(code);
-                }
-            }
-            break;
-
         case CodeGenTarget::SPIRVAssembly:
             {
-                String code;
-                if (SLANG_SUCCEEDED(emitSPIRVAssemblyForEntryPoint(
+                ComPtr<ISlangBlob> code;
+                RefPtr<DownstreamCompile> compile;
+                if (SLANG_SUCCEEDED(emitSPIRVForEntryPoint(
                     compileRequest,
                     entryPoint,
                     entryPointIndex,
                     targetReq,
                     endToEndReq,
-                    code)))
+                    code,
+                    compile)))
                 {
-                    maybeDumpIntermediate(compileRequest, code.getBuffer(), target);
-                    result = CompileResult(code);
+                    result = compile ?
+                        _runDownstreamCompileForEntryPoint(compileRequest, target, compile) :
+                        _makeDownstreamCompileResult(compileRequest, target, code);
                 }
             }
             break;
@@ -1279,23 +1643,6 @@ SlangResult dissassembleDXILUsingDXC(
         Binary,
     };
 
-    static void writeOutputFile(
-        BackEndCompileRequest*  compileRequest,
-        FILE*                   file,
-        String const&           path,
-        void const*             data,
-        size_t                  size)
-    {
-        size_t count = fwrite(data, size, 1, file);
-        if (count != 1)
-        {
-            compileRequest->getSink()->diagnose(
-                SourceLoc(),
-                Diagnostics::cannotWriteOutputFile,
-                path);
-        }
-    }
-
     static void writeOutputFile(
         BackEndCompileRequest*  compileRequest,
         ISlangWriter*           writer,
@@ -1332,8 +1679,9 @@ SlangResult dissassembleDXILUsingDXC(
             return;
         }
 
-        writeOutputFile(compileRequest, file, path, data, size);
-        fclose(file);
+        // The file was just opened, so there is no need to check if it's a console. The writer closes it.
+        FileWriter writer(file, WriterFlag::IsStatic | WriterFlag::IsNotConsole);
+        writeOutputFile(compileRequest, &writer, path, data, size);
     }
 
     static void writeEntryPointResultToFile(
@@ -1359,11 +1707,12 @@ SlangResult dissassembleDXILUsingDXC(
 
         case ResultFormat::Binary:
             {
-                auto& data = result.outputBinary;
+                size_t size = 0;
+                const void* data = result.getData(size);
                 writeOutputFile(compileRequest,
                     outputPath,
-                    data.begin(),
-                    data.end() - data.begin(),
+                    data,
+                    size,
                     OutputFileKind::Binary);
             }
             break;
@@ -1401,7 +1750,8 @@ SlangResult dissassembleDXILUsingDXC(
 
         case ResultFormat::Binary:
             {
-                auto& data = result.outputBinary;
+                size_t size = 0;
+                const void* data = result.getData(size);
                 
                 if (writer->isConsole())
                 {
@@ -1414,8 +1764,8 @@ SlangResult dissassembleDXILUsingDXC(
                         {
                             String assembly;
                             dissassembleDXBC(backEndReq,
-                                data.begin(),
-                                data.end() - data.begin(), assembly);
+                                data,
+                                size, assembly);
                             writeOutputToConsole(writer, assembly);
                         }
                         break;
@@ -1426,8 +1776,8 @@ SlangResult dissassembleDXILUsingDXC(
                         {
                             String assembly; 
                             dissassembleDXILUsingDXC(backEndReq,
-                                data.begin(),
-                                data.end() - data.begin(), 
+                                data,
+                                size, 
                                 assembly);
                             writeOutputToConsole(writer, assembly);
                         }
@@ -1438,8 +1788,8 @@ SlangResult dissassembleDXILUsingDXC(
                         {
                             String assembly;
                             dissassembleSPIRV(backEndReq,
-                                data.begin(),
-                                data.end() - data.begin(), assembly);
+                                data,
+                                size, assembly);
                             writeOutputToConsole(writer, assembly);
                         }
                         break;
@@ -1458,8 +1808,8 @@ SlangResult dissassembleDXILUsingDXC(
                         backEndReq,
                         writer,
                         "stdout",
-                        data.begin(),
-                        data.end() - data.begin());
+                        data,
+                        size);
                 }
             }
             break;
@@ -1503,9 +1853,117 @@ SlangResult dissassembleDXILUsingDXC(
             }
         }
 
+        // Results without a path of their own are held in the container, if one is written
+        if (compileRequest->containerOutputPath.getLength())
+            return;
+
         writeEntryPointResultToStandardOutput(compileRequest, entryPoint, targetReq, result);
     }
 
+#if SLANG_ENABLE_DXIL_SUPPORT
+        /// Generate DXIL (or its assembly) for all of `entryPoints` as one library
+    static CompileResult emitDXILLibrary(
+        BackEndCompileRequest*      compileRequest,
+        const List<EntryPoint*>&    entryPoints,
+        TargetRequest*              targetReq)
+    {
+        ComPtr<ISlangBlob> code;
+        if (SLANG_FAILED(emitDXILLibraryUsingDXC(compileRequest, entryPoints, targetReq, code)))
+        {
+            return CompileResult();
+        }
+
+        const auto target = targetReq->target;
+        if (target == CodeGenTarget::DXILAssembly)
+        {
+            String assembly;
+            dissassembleDXILUsingDXC(
+                compileRequest,
+                code->getBufferPointer(),
+                code->getBufferSize(),
+                assembly);
+            maybeDumpIntermediate(compileRequest, assembly.getBuffer(), target);
+            return CompileResult(assembly);
+        }
+
+        maybeDumpIntermediate(compileRequest, code->getBufferPointer(), code->getBufferSize(), target);
+        return CompileResult(code);
+    }
+#endif
+
+    bool TargetProgram::_shouldGenerateLibrary(EndToEndCompileRequest* endToEndRequest)
+    {
+#if SLANG_ENABLE_DXIL_SUPPORT
+        if (!(m_targetReq->targetFlags & SLANG_TARGET_FLAG_DXIL_LIBRARY))
+            return false;
+
+        switch (m_targetReq->target)
+        {
+            case CodeGenTarget::DXIL:
+            case CodeGenTarget::DXILAssembly:
+                break;
+            default:
+                return false;
+        }
+
+        // Pass-through compiles don't have IR to combine
+        if (endToEndRequest && endToEndRequest->passThrough != PassThroughMode::None)
+            return false;
+
+        // The entry points are exported from the library by name, so the names must be distinct
+        HashSet<Name*> names;
+        const Index entryPointCount = m_program->getEntryPointCount();
+        for (Index ii = 0; ii < entryPointCount; ++ii)
+        {
+            auto name = m_program->getEntryPoint(ii)->getName();
+            if (names.Contains(name))
+                return false;
+            names.Add(name);
+        }
+        return entryPointCount > 0;
+#else
+        SLANG_UNUSED(endToEndRequest);
+        return false;
+#endif
+    }
+
+    void TargetProgram::_createLibraryResult(
+        BackEndCompileRequest*  backEndRequest,
+        EndToEndCompileRequest* endToEndRequest)
+    {
+        SLANG_UNUSED(endToEndRequest);
+
+        // The library is generated once, when the result for any of its entry
+        // points is first requested.
+        if (m_hasLibraryResult)
+            return;
+        m_hasLibraryResult = true;
+
+        _ensureEntryPointResultCount();
+
+        List<EntryPoint*> entryPoints;
+        const Index entryPointCount = m_program->getEntryPointCount();
+        for (Index ii = 0; ii < entryPointCount; ++ii)
+        {
+            entryPoints.add(m_program->getEntryPoint(ii));
+        }
+
+        CompileProfileScope profileScope(m_program->getLinkageImpl()->getProfiler(), CompileProfiler::kBackEndCategory, "emitLibrary", getCodeGenTargetName(m_targetReq->target));
+
+#if SLANG_ENABLE_DXIL_SUPPORT
+        CompileResult result = emitDXILLibrary(backEndRequest, entryPoints, m_targetReq);
+#else
+        SLANG_UNUSED(backEndRequest);
+        CompileResult result;
+#endif
+
+        // Every entry point's result is the whole library
+        for (Index ii = 0; ii < entryPointCount; ++ii)
+        {
+            m_entryPointResults[ii] = result;
+        }
+    }
+
     CompileResult& TargetProgram::_createEntryPointResult(
         Int                     entryPointIndex,
         BackEndCompileRequest*  backEndRequest,
@@ -1522,8 +1980,26 @@ SlangResult dissassembleDXILUsingDXC(
         if(entryPointIndex >= m_entryPointResults.getCount())
             m_entryPointResults.setCount(entryPointIndex+1);
 
+        if (_shouldGenerateLibrary(endToEndRequest))
+        {
+            _createLibraryResult(backEndRequest, endToEndRequest);
+            return m_entryPointResults[entryPointIndex];
+        }
+
         auto entryPoint = m_program->getEntryPoint(entryPointIndex);
 
+        checkCompileBudget(m_program->getLinkageImpl()->getBudget());
+
+        auto profiler = m_program->getLinkageImpl()->getProfiler();
+        String profileDetail;
+        if (profiler)
+        {
+            StringBuilder builder;
+            builder << getText(entryPoint->getName()) << " (" << getCodeGenTargetName(m_targetReq->target) << ")";
+            profileDetail = builder.ProduceString();
+        }
+        CompileProfileScope profileScope(profiler, CompileProfiler::kBackEndCategory, "emitEntryPoint", profileDetail);
+
         auto& result = m_entryPointResults[entryPointIndex];
         result = emitEntryPoint(
             backEndRequest,
@@ -1536,6 +2012,23 @@ SlangResult dissassembleDXILUsingDXC(
 
     }
 
+    void TargetProgram::_ensureEntryPointResultCount()
+    {
+        const Index entryPointCount = m_program->getEntryPointCount();
+        if(entryPointCount > m_entryPointResults.getCount())
+            m_entryPointResults.setCount(entryPointCount);
+    }
+
+    size_t TargetProgram::calcOutputSize()
+    {
+        size_t size = 0;
+        for (const auto& result : m_entryPointResults)
+        {
+            size += result.calcOutputSize();
+        }
+        return size;
+    }
+
     CompileResult& TargetProgram::getOrCreateEntryPointResult(
         Int entryPointIndex,
         DiagnosticSink* sink)
@@ -1580,10 +2073,200 @@ SlangResult dissassembleDXILUsingDXC(
 
 
 
+        /// The code generation for a single (target, entry point) pair, when downstream compiles run on a pool.
+        ///
+        /// Each pair has its own `BackEndCompileRequest` and `DiagnosticSink`, as its result and its
+        /// diagnostics are only complete once its downstream compile has run. The diagnostics are
+        /// then added to the parent sink in order, which gives the same output as generating the
+        /// code serially.
+        ///
+    class EntryPointCodeGen : public RefObject
+    {
+    public:
+            /// Generate the code for the entry point, submitting its downstream compile to pool
+        void generate(ThreadPool* pool)
+        {
+            m_backEndReq->downstreamCompilePool = pool;
+            m_targetProgram->_createEntryPointResult(m_entryPointIndex, m_backEndReq, m_endToEndReq);
+            m_backEndReq->downstreamCompilePool = nullptr;
+        }
+
+            /// Once the compiles submitted to the pool have completed, make the result
+            /// for the entry point, and add the diagnostics to the parent sink
+        void complete(DiagnosticSink* sink)
+        {
+            if (RefPtr<DownstreamCompile> compile = m_backEndReq->queuedDownstreamCompile)
+            {
+                m_backEndReq->queuedDownstreamCompile = nullptr;
+                m_targetProgram->getExistingEntryPointResult(m_entryPointIndex) =
+                    _finishDownstreamCompileResult(m_backEndReq, m_targetProgram->getTargetReq()->getTarget(), compile);
+            }
+            sink->appendDiagnostics(m_sink);
+        }
+
+        EntryPointCodeGen(
+            BackEndCompileRequest*  compileRequest,
+            TargetProgram*          targetProgram,
+            Index                   entryPointIndex,
+            EndToEndCompileRequest* endToEndReq)
+            : m_targetProgram(targetProgram)
+            , m_entryPointIndex(entryPointIndex)
+            , m_endToEndReq(endToEndReq)
+            , m_sink(compileRequest->getSink()->sourceManager)
+        {
+            m_sink.copyOptions(*compileRequest->getSink());
+
+            m_backEndReq = new BackEndCompileRequest(
+                compileRequest->getLinkage(),
+                &m_sink,
+                compileRequest->getProgram());
+
+            m_backEndReq->shouldDumpIR = compileRequest->shouldDumpIR;
+            m_backEndReq->irDumpOptions = compileRequest->irDumpOptions;
+            m_backEndReq->shouldValidateIR = compileRequest->shouldValidateIR;
+            m_backEndReq->shouldValidateIRIncrementally = compileRequest->shouldValidateIRIncrementally;
+            m_backEndReq->irValidationSamplePercent = compileRequest->irValidationSamplePercent;
+            m_backEndReq->shouldDumpIntermediates = compileRequest->shouldDumpIntermediates;
+            m_backEndReq->lineDirectiveMode = compileRequest->lineDirectiveMode;
+            m_backEndReq->useUnknownImageFormatAsDefault = compileRequest->useUnknownImageFormatAsDefault;
+            m_backEndReq->emittedSourceCache = compileRequest->emittedSourceCache;
+        }
+
+    protected:
+        TargetProgram* m_targetProgram;
+        Index m_entryPointIndex;
+        EndToEndCompileRequest* m_endToEndReq;
+
+        DiagnosticSink m_sink;
+        RefPtr<BackEndCompileRequest> m_backEndReq;
+    };
+
+        /// Returns true if code generation for any of targets runs a downstream compiler (such as fxc, dxc or glslang)
+    static bool _usesDownstreamCompiler(List<RefPtr<TargetRequest>> const& targets)
+    {
+        for (auto targetReq : targets)
+        {
+            if (getExternalCompilerRequiredForTarget(targetReq->getTarget()) != PassThroughMode::None)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+        /// Generate the code for codeGens in order on this thread, with their downstream compiles run on a pool of threadCount threads
+    static void _generateEntryPointCode(
+        List<RefPtr<EntryPointCodeGen>> const&  codeGens,
+        Index                                   threadCount,
+        DiagnosticSink*                         sink)
+    {
+        ThreadPool pool(threadCount);
+
+        // If code generation for an entry point throws, the entry points after it are
+        // dropped, just as they would not have been generated in a serial compile.
+        //
+        Index generatedCount = 0;
+        std::exception_ptr exception;
+        for (auto codeGen : codeGens)
+        {
+            generatedCount++;
+            try
+            {
+                codeGen->generate(&pool);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+                break;
+            }
+        }
+        pool.waitForAll();
+
+        for (Index ii = 0; ii < generatedCount; ++ii)
+        {
+            codeGens[ii]->complete(sink);
+        }
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    static Index _getDownstreamThreadCount(Index jobCount)
+    {
+        return jobCount ? jobCount : ThreadPool::getDefaultThreadCount();
+    }
+
+    static void _generateOutputWithJobs(
+        BackEndCompileRequest*  compileRequest,
+        EndToEndCompileRequest* endToEndReq)
+    {
+        auto linkage = compileRequest->getLinkage();
+        auto program = compileRequest->getProgram();
+        const Index entryPointCount = program->getEntryPointCount();
+
+        List<RefPtr<EntryPointCodeGen>> codeGens;
+        for (auto targetReq : linkage->targets)
+        {
+            auto targetProgram = program->getTargetProgram(targetReq);
+            targetProgram->_ensureEntryPointResultCount();
+
+            for (Index ii = 0; ii < entryPointCount; ++ii)
+            {
+                codeGens.add(new EntryPointCodeGen(compileRequest, targetProgram, ii, endToEndReq));
+            }
+        }
+
+        const Index downstreamJobCount = compileRequest->downstreamJobCount;
+        _generateEntryPointCode(codeGens, _getDownstreamThreadCount(downstreamJobCount ? downstreamJobCount : compileRequest->jobCount), compileRequest->getSink());
+    }
+
+    void generateEntryPointCodeWithJobs(
+        List<RefPtr<Program>> const&    programs,
+        Index                           jobCount,
+        DiagnosticSink*                 sink)
+    {
+        // The requests are only used to set up the code generation for each
+        // entry point, which takes its options from them.
+        //
+        List<RefPtr<BackEndCompileRequest>> compileRequests;
+        List<RefPtr<EntryPointCodeGen>> codeGens;
+        bool usesDownstreamCompiler = false;
+        for (auto program : programs)
+        {
+            auto linkage = program->getLinkageImpl();
+            usesDownstreamCompiler = usesDownstreamCompiler || _usesDownstreamCompiler(linkage->targets);
+            RefPtr<BackEndCompileRequest> compileRequest = new BackEndCompileRequest(linkage, sink, program);
+            compileRequests.add(compileRequest);
+
+            const Index entryPointCount = program->getEntryPointCount();
+            for (auto targetReq : linkage->targets)
+            {
+                auto targetProgram = program->getTargetProgram(targetReq);
+                targetProgram->_ensureEntryPointResultCount();
+
+                for (Index ii = 0; ii < entryPointCount; ++ii)
+                {
+                    codeGens.add(new EntryPointCodeGen(compileRequest, targetProgram, ii, nullptr));
+                }
+            }
+        }
+
+        // Without any downstream compiles there is nothing for a pool to run
+        _generateEntryPointCode(codeGens, usesDownstreamCompiler ? _getDownstreamThreadCount(jobCount) : 0, sink);
+    }
+
     static void _generateOutput(
         BackEndCompileRequest* compileRequest,
         EndToEndCompileRequest* endToEndReq)
     {
+        // Only downstream compiles run on other threads, so without any code is generated serially
+        if (compileRequest->jobCount != 1 && _usesDownstreamCompiler(compileRequest->getLinkage()->targets))
+        {
+            _generateOutputWithJobs(compileRequest, endToEndReq);
+            return;
+        }
+
         // Go through the code-generation targets that the user
         // has specified, and generate code for each of them.
         //
@@ -1604,12 +2287,147 @@ SlangResult dissassembleDXILUsingDXC(
         EndToEndCompileRequest* compileRequest)
     {
         _generateOutput(compileRequest->getBackEndReq(), compileRequest);
+        writeOutput(compileRequest);
+    }
+
+        /// Make a kernel container holding the result for every target and entry point of compileRequest
+    static SlangResult generateContainer(
+        EndToEndCompileRequest* compileRequest,
+        ComPtr<ISlangBlob>&     outBlob)
+    {
+        auto linkage = compileRequest->getLinkage();
+        auto program = compileRequest->getSpecializedProgram();
+
+        KernelContainerWriter writer;
+        List<ComPtr<ISlangBlob>> blobs;
+
+        const Index entryPointCount = program->getEntryPointCount();
+        for (auto targetReq : linkage->targets)
+        {
+            auto targetProgram = program->getTargetProgram(targetReq);
+            for (Index ee = 0; ee < entryPointCount; ++ee)
+            {
+                auto entryPoint = program->getEntryPoint(ee);
+                ComPtr<ISlangBlob> blob = targetProgram->getExistingEntryPointResult(ee).getBlob();
+                if (!blob)
+                {
+                    // The entry point failed to compile for this target
+                    continue;
+                }
+
+                KernelContainerWriter::Kernel kernel;
+                kernel.target = uint32_t(targetReq->target);
+                kernel.stage = uint32_t(entryPoint->getStage());
+                kernel.entryPointIndex = uint32_t(ee);
+                kernel.name = getText(entryPoint->getName());
+                kernel.profile = getEffectiveProfile(entryPoint, targetReq).getName();
+                kernel.data = blob->getBufferPointer();
+                kernel.size = blob->getBufferSize();
+                writer.addKernel(kernel);
+
+                // Keep the blob alive until the container is written
+                blobs.add(blob);
+            }
+        }
+
+        for (const auto& path : program->getFilePathDependencies())
+        {
+            writer.addDependency(path);
+        }
+
+        List<uint8_t> data;
+        SLANG_RETURN_ON_FAIL(writer.write(data));
+        outBlob = createRawBlob(data.getBuffer(), size_t(data.getCount()));
+        return SLANG_OK;
+    }
+
+        /// Make a precompiled module holding the interface and IR of every translation unit of compileRequest
+    static SlangResult generatePrecompiledModule(
+        EndToEndCompileRequest* compileRequest,
+        ComPtr<ISlangBlob>&     outBlob)
+    {
+        auto linkage = compileRequest->getLinkage();
+        auto fileSystemExt = linkage->getFileSystemExt();
+
+        List<PrecompiledModule> modules;
+        List<RefPtr<MemoryStream>> irStreams;
+        for (auto translationUnit : compileRequest->getFrontEndReq()->translationUnits)
+        {
+            auto module = translationUnit->getModule();
+            auto irModule = module->getIRModule();
+            if (!irModule)
+            {
+                return SLANG_FAIL;
+            }
+
+            PrecompiledModule precompiledModule;
+            precompiledModule.name = getText(translationUnit->moduleName);
+            precompiledModule.interfaceSource = translationUnit->moduleInterfaceSource.ProduceString();
+
+            // The files the module was compiled from, so that a module whose source has changed isn't used
+            for (const auto& path : module->getFilePathDependencyList())
+            {
+                ComPtr<ISlangBlob> contents;
+                SLANG_RETURN_ON_FAIL(fileSystemExt->loadFile(path.getBuffer(), contents.writeRef()));
+
+                PrecompiledModule::Dependency dependency;
+                dependency.path = path;
+                dependency.contentHash = getHashCode64(contents->getBufferPointer(), contents->getBufferSize());
+                precompiledModule.dependencies.add(dependency);
+            }
+
+            // Source locations can't be restored in another session, so aren't written
+            RefPtr<MemoryStream> irStream = new MemoryStream(FileAccess::ReadWrite);
+            IRSerialWriter writer;
+            SLANG_RETURN_ON_FAIL(writer.writeStream(irModule, linkage->getSourceManager(), 0, IRSerialWriter::StreamOptions(), irStream));
+            irStreams.add(irStream);
+
+            precompiledModule.irData = irStream->m_contents.getBuffer();
+            precompiledModule.irSize = size_t(irStream->m_contents.getCount());
+            modules.add(precompiledModule);
+        }
+
+        List<uint8_t> data;
+        writePrecompiledModules(modules, data);
+        outBlob = createListBlob(data);
+        return SLANG_OK;
+    }
+
+    void writeOutput(
+        EndToEndCompileRequest* compileRequest)
+    {
+        if (compileRequest->containerFormat == ContainerFormat::SlangModule)
+        {
+            compileRequest->containerBlob.setNull();
+            if (SLANG_FAILED(generateContainer(compileRequest, compileRequest->containerBlob)))
+            {
+                compileRequest->getSink()->diagnose(SourceLoc(), Diagnostics::unableToCreateContainer);
+            }
+        }
+        else if (compileRequest->containerFormat == ContainerFormat::PrecompiledModule)
+        {
+            compileRequest->containerBlob.setNull();
+            if (SLANG_FAILED(generatePrecompiledModule(compileRequest, compileRequest->containerBlob)))
+            {
+                compileRequest->getSink()->diagnose(SourceLoc(), Diagnostics::unableToCreatePrecompiledModule);
+            }
+        }
 
         // If we are in command-line mode, we might be expected to actually
         // write output to one or more files here.
 
         if (compileRequest->isCommandLineCompile)
         {
+            auto containerBlob = compileRequest->containerBlob;
+            if (containerBlob && compileRequest->containerOutputPath.getLength())
+            {
+                writeOutputFile(compileRequest->getBackEndReq(),
+                    compileRequest->containerOutputPath,
+                    containerBlob->getBufferPointer(),
+                    containerBlob->getBufferSize(),
+                    OutputFileKind::Binary);
+            }
+
             auto linkage = compileRequest->getLinkage();
             auto program = compileRequest->getSpecializedProgram();
             for (auto targetReq : linkage->targets)
@@ -1645,13 +2463,8 @@ SlangResult dissassembleDXILUsingDXC(
         // This is primarily a debugging aid, so we don't
         // really need/want to do anything too elaborate
 
-        static uint32_t counter = 0;
-#ifdef WIN32
-        uint32_t id = InterlockedIncrement(&counter);
-#else
-        // TODO: actually implement the case for other platforms
-        uint32_t id = counter++;
-#endif
+        static std::atomic<uint32_t> counter(0);
+        uint32_t id = ++counter;
 
         String path;
         path.append("slang-dump-");
@@ -1661,8 +2474,8 @@ SlangResult dissassembleDXILUsingDXC(
         FILE* file = fopen(path.getBuffer(), isBinary ? "wb" : "w");
         if (!file) return;
 
-        fwrite(data, size, 1, file);
-        fclose(file);
+        FileWriter writer(file, WriterFlag::IsStatic | WriterFlag::IsNotConsole);
+        writer.write((const char*)data, size);
     }
 
     void dumpIntermediateText(
@@ -2,17 +2,26 @@
 #define SLANG_COMPILER_H_INCLUDED
 
 #include "../core/slang-basic.h"
+#include "../core/slang-ref-object-pool.h"
 #include "../core/slang-shared-library.h"
+#include "../core/slang-thread-pool.h"
+#include "../core/slang-uint-set.h"
 
 #include "../../slang-com-ptr.h"
 
+#include "slang-compile-budget.h"
+#include "slang-compile-profiler.h"
 #include "slang-diagnostics.h"
 #include "slang-name.h"
+#include "slang-preprocessor.h"
 #include "slang-profile.h"
 #include "slang-syntax.h"
 
 #include "../../slang.h"
 
+#include <mutex>
+#include <thread>
+
 namespace Slang
 {
     struct PathInfo;
@@ -66,6 +75,7 @@ namespace Slang
     {
         None            = SLANG_CONTAINER_FORMAT_NONE,
         SlangModule     = SLANG_CONTAINER_FORMAT_SLANG_MODULE,
+        PrecompiledModule = SLANG_CONTAINER_FORMAT_PRECOMPILED_MODULE,
     };
 
     enum class LineDirectiveMode : SlangLineDirectiveMode
@@ -74,6 +84,7 @@ namespace Slang
         None        = SLANG_LINE_DIRECTIVE_MODE_NONE,
         Standard    = SLANG_LINE_DIRECTIVE_MODE_STANDARD,
         GLSL        = SLANG_LINE_DIRECTIVE_MODE_GLSL,
+        SourceMap   = SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP,
     };
 
     enum class ResultFormat
@@ -115,8 +126,10 @@ namespace Slang
     class Program;
     class FrontEndCompileRequest;
     class BackEndCompileRequest;
+    class DownstreamCompile;
     class EndToEndCompileRequest;
     class TranslationUnitRequest;
+    struct CompileCacheEntry;
 
     // Result of compiling an entry point.
     // Should only ever be string OR binary.
@@ -125,17 +138,42 @@ namespace Slang
     public:
         CompileResult() = default;
         CompileResult(String const& str) : format(ResultFormat::Text), outputString(str) {}
-        CompileResult(List<uint8_t> const& buffer) : format(ResultFormat::Binary), outputBinary(buffer) {}
+            /// Binary output is held in (rather than copied from) inBlob
+        CompileResult(ISlangBlob* inBlob) : format(ResultFormat::Binary), blob(inBlob) {}
 
         void append(CompileResult const& result);
 
+            /// Get the number of bytes of output held
+        size_t calcOutputSize() const;
+
+            /// Get the output as a blob. The blob is created once, and shares (rather than copies) the output,
+            /// so getting it again, or getting the data, doesn't allocate.
         ComPtr<ISlangBlob> getBlob();
 
+            /// Get the output data. Text output is followed by a terminating 0 (not included in outSize).
+        void const* getData(size_t& outSize) const;
+
         ResultFormat format = ResultFormat::None;
         String outputString;
-        List<uint8_t> outputBinary;
 
+            /// Holds the output for ResultFormat::Binary, and the blob for text output once created
         ComPtr<ISlangBlob> blob;
+
+            /// The source map for text output, in LineDirectiveMode::SourceMap (see `SourceMap`)
+        ComPtr<ISlangBlob> sourceMap;
+    };
+
+        /// Bytes of memory held, by what holds them (see `SlangMemoryStats`)
+    struct MemoryStats
+    {
+        size_t irBytes = 0;
+        size_t astBytes = 0;
+        size_t sourceBytes = 0;
+        size_t sourceLocBytes = 0;
+        size_t nameBytes = 0;
+        size_t tokenCacheBytes = 0;
+        size_t cacheBytes = 0;
+        size_t outputBytes = 0;
     };
 
         /// Information collected about global or entry-point shader parameters
@@ -180,6 +218,9 @@ namespace Slang
             /// Get the profile that the entry point is to be compiled for
         Profile getProfile() { return m_profile; }
 
+            /// Get the index of the translation unit that contains the entry point.
+        int getTranslationUnitIndex() { return m_translationUnitIndex; }
+
     private:
         // The parent compile request
         FrontEndCompileRequest* m_compileRequest;
@@ -438,6 +479,9 @@ namespace Slang
 
         ISlangUnknown* getInterface(const Guid& guid);
 
+        // IModule
+        SLANG_NO_THROW void SLANG_MCALL getMemoryStats(SlangModuleMemoryStats* outStats) SLANG_OVERRIDE;
+
             /// Create a module (initially empty).
         Module(Linkage* linkage);
 
@@ -447,6 +491,9 @@ namespace Slang
             /// Get the AST for the module (if it has been parsed)
         ModuleDecl* getModuleDecl() { return m_moduleDecl; }
 
+            /// Get the arena the module's AST nodes are allocated from
+        ASTArena* getASTArena() { return m_astArena; }
+
             /// The the IR for the module (if it has been generated)
         IRModule* getIRModule() { return m_irModule; }
 
@@ -462,6 +509,11 @@ namespace Slang
             /// Register a filesystem path that this module depends on
         void addFilePathDependency(String const& path);
 
+            /// Get the hashes of the contents of the files in `getFilePathDependencyList`, recorded when the module was loaded.
+            /// Only set when the linkage is incremental (see `Linkage::m_isIncremental`).
+        List<uint64_t> const& getFilePathDependencyHashes() { return m_filePathDependencyHashes; }
+        void setFilePathDependencyHashes(List<uint64_t> const& hashes) { m_filePathDependencyHashes = hashes; }
+
             /// Set the AST for this module.
             ///
             /// This should only be called once, during creation of the module.
@@ -474,10 +526,33 @@ namespace Slang
             ///
         void setIRModule(IRModule* irModule) { m_irModule = irModule; }
 
+            /// Get the source files the module was parsed from (including `#include`d files)
+        List<SourceFile*> const& getSourceFiles() { return m_sourceFiles; }
+
+            /// Register a source file the module is parsed from
+        void addSourceFile(SourceFile* sourceFile);
+
+            /// Release what is only needed to lower the module to IR (see `kSessionFlag_CompactModules`).
+            ///
+            /// The text of the tokens still held by the AST is copied to the module, the bodies of
+            /// functions are removed from the AST, and the contents of source files no other module
+            /// needs are released.
+            ///
+        void compact();
+
+            /// True if `compact` has been called
+        bool isCompact() const { return m_isCompact; }
+
+            /// Add the memory held by the module's AST and IR to ioStats
+        void accumulateMemoryStats(MemoryStats& ioStats);
+
     private:
         // The parent linkage
         Linkage* m_linkage = nullptr;
 
+        // The memory the AST for the module is allocated from
+        RefPtr<ASTArena> m_astArena;
+
         // The AST for the module
         RefPtr<ModuleDecl>  m_moduleDecl;
 
@@ -489,6 +564,17 @@ namespace Slang
 
         // List of filesystem paths this module depends on
         FilePathDependencyList m_filePathDependencyList;
+
+        // Hash of the contents of each path in m_filePathDependencyList
+        List<uint64_t> m_filePathDependencyHashes;
+
+        // The source files the module is parsed from
+        List<SourceFile*> m_sourceFiles;
+
+        // Holds the text of tokens in the AST once the module is compact
+        StringSlicePool m_tokenTextPool;
+
+        bool m_isCompact = false;
     };
     typedef Module LoadedModule;
 
@@ -524,6 +610,14 @@ namespace Slang
             /// The name that will be used for the module this translation unit produces.
         Name* moduleName = nullptr;
 
+            /// The tokens of each source file, if the translation unit was preprocessed ahead of
+            /// parsing (see `FrontEndCompileRequest::preprocessTranslationUnit`)
+        List<TokenList> preprocessedTokens;
+
+            /// The declarations of the module as source, for a precompiled module
+            /// (see `FrontEndCompileRequest::shouldGenerateModuleInterface`)
+        StringBuilder moduleInterfaceSource;
+
             /// Result of compiling this translation unit (a module)
         RefPtr<Module> module;
 
@@ -630,6 +724,24 @@ namespace Slang
     ///
     ComPtr<ISlangBlob> createRawBlob(void const* data, size_t size);
 
+    /// Create a blob that takes the contents of ioData without copying them. ioData is left empty.
+    ///
+    ComPtr<ISlangBlob> createListBlob(List<uint8_t>& ioData);
+
+    /// Create a blob whose contents are data, which is held by owner (such as an `ID3DBlob` returned
+    /// by a downstream compiler). The contents aren't copied, and owner is kept alive by the blob.
+    ///
+    ComPtr<ISlangBlob> createOwnedDataBlob(ISlangUnknown* owner, void const* data, size_t size);
+
+    struct TypeCheckingCache;
+    struct TypeLayoutCache;
+    struct PermutationCache;
+    class CacheFileSystem;
+    struct SharedModuleCache;
+    struct IRLinkCache;
+    struct IRSpecializationCache;
+    struct IRTypeLegalizationCache;
+
         /// A context for loading and re-using code modules.
     class Linkage : public RefObject, public slang::ISession
     {
@@ -663,6 +775,19 @@ namespace Slang
             ISlangBlob**    outDiagnostics = nullptr) override;
         SLANG_NO_THROW SlangResult SLANG_MCALL createCompileRequest(
             SlangCompileRequest**   outCompileRequest) override;
+        SLANG_NO_THROW SlangResult SLANG_MCALL specializeProgramBatch(
+            slang::IProgram*                program,
+            SlangInt                        specializationSetCount,
+            SlangInt                        specializationArgCount,
+            slang::SpecializationArg const* specializationArgs,
+            slang::SpecializeBatchFlags     flags,
+            slang::IProgram**               outSpecializedPrograms,
+            ISlangBlob**                    outDiagnostics = nullptr) override;
+        SLANG_NO_THROW void SLANG_MCALL invalidateFiles(
+            char const* const*  paths,
+            SlangInt            pathCount) override;
+        SLANG_NO_THROW void SLANG_MCALL getMemoryStats(
+            SlangMemoryStats*   outStats) override;
 
         void addTarget(
             slang::TargetDesc const& desc);
@@ -677,6 +802,8 @@ namespace Slang
             /// Create an initially-empty linkage
         Linkage(Session* session);
 
+        ~Linkage();
+
             /// Get the parent session for this linkage
         Session* getSessionImpl() { return m_session; }
 
@@ -727,8 +854,20 @@ namespace Slang
         /// or a wrapped impl that makes fileSystem operate as fileSystemExt
         ComPtr<ISlangFileSystemExt> fileSystemExt;
 
+        /// The cache wrapping the file system, if the linkage created one (held by fileSystemExt)
+        CacheFileSystem* m_cacheFileSystem = nullptr;
+
         ISlangFileSystemExt* getFileSystemExt() { return fileSystemExt; }
 
+        /// Directory holding the on-disk compile cache. If empty, the cache is not used.
+        String compileCacheDirectory;
+
+        /// The maximum size in bytes of the on-disk compile cache. 0 means there is no limit.
+        uint64_t compileCacheMaxSize = 0;
+
+        /// Cache of compile outputs implemented by the application (see `spSetCompileCache`), or null
+        ComPtr<ISlangCompileCache> compileCache;
+
         /// Load a file into memory using the configured file system.
         ///
         /// @param path The path to attempt to load from
@@ -750,17 +889,22 @@ namespace Slang
         UInt addTarget(
             CodeGenTarget   target);
 
+            /// Load the module `name` from the source in fileContentsBlob.
+            /// If precompiledIRModule is set, the source is just the module's interface (see
+            /// `PrecompiledModule`), and precompiledIRModule is used as the module's IR.
         RefPtr<Module> loadModule(
             Name*               name,
             const PathInfo&     filePathInfo,
             ISlangBlob*         fileContentsBlob,
             SourceLoc const&    loc,
-            DiagnosticSink*     sink);
+            DiagnosticSink*     sink,
+            IRModule*           precompiledIRModule = nullptr);
 
         void loadParsedModule(
             RefPtr<TranslationUnitRequest>  translationUnit,
             Name*                           name,
-            PathInfo const&                 pathInfo);
+            PathInfo const&                 pathInfo,
+            IRModule*                       precompiledIRModule = nullptr);
 
             /// Load a module of the given name.
         Module* loadModule(String const& name);
@@ -770,6 +914,25 @@ namespace Slang
             SourceLoc const&    loc,
             DiagnosticSink*     sink);
 
+            /// If the linkage is incremental, remove loaded modules whose file dependencies have changed
+            /// since they were loaded, so that they will be loaded again when next imported.
+        void removeChangedModules();
+
+            /// Discard what is cached about the files at paths, and the loaded modules that depend on them
+            /// (see `ISession::invalidateFiles`)
+        void invalidateFilePaths(const List<String>& paths);
+
+            /// Remove modules from the loaded modules, along with entries for modules that failed to load
+        void _removeLoadedModules(const HashSet<Module*>& modules);
+
+            /// Add the memory held by the linkage (its loaded modules, source files, names and caches) to ioStats
+        void accumulateMemoryStats(MemoryStats& ioStats);
+
+            /// Estimate the bytes held by the type checking cache, implemented in slang-check.cpp
+        size_t _calcTypeCheckingCacheSize();
+            /// Estimate the bytes held by the type layout cache, implemented in slang-type-layout.cpp
+        size_t _calcTypeLayoutCacheSize();
+
         SourceManager* getSourceManager()
         {
             return m_sourceManager;
@@ -800,9 +963,87 @@ namespace Slang
 
         bool m_useFalcorCustomSharedKeywordSemantics = false;
 
+            /// If set, loaded modules are only reused if their file dependencies are unchanged (see `removeChangedModules`)
+        bool m_isIncremental = false;
+            /// If set, the application reports changed files with `invalidateFiles`, so `removeChangedModules` does nothing
+        bool m_useFileChangeNotifications = false;
+            /// If set, loaded modules are compacted once they are lowered to IR (see `Module::compact`)
+        bool m_compactModules = false;
+
+            /// Set whether files from the OS file system are loaded through `SharedFileCache::getSingleton`
+        void setUseSharedFileCache(bool useSharedFileCache);
+        bool m_useSharedFileCache = false;
+
+            /// If set, imported modules are taken from (and added to) the session's `SharedModuleCache`,
+            /// so that linkages with the same options don't each load and check the same modules.
+        bool m_useSharedModuleCache = false;
+
+        // cache used by type checking, implemented in check.cpp
+        //
+        // The cache is held per-linkage (rather than on the `Session`) so that
+        // caching results never leak between linkages, and linkages do not
+        // share any mutable type checking state.
+        TypeCheckingCache* getTypeCheckingCache();
+        void destroyTypeCheckingCache();
+
+            /// Get the cache of `struct` type layouts, implemented in slang-type-layout.cpp.
+            ///
+            /// Layouts are shared by all targets, entry points and compile requests that use
+            /// this linkage, but only for types that don't depend on a request's translation units.
+        TypeLayoutCache* getTypeLayoutCache();
+        void destroyTypeLayoutCache();
+
+            /// Get the outputs of the compiles done with this linkage, keyed by their preprocessed
+            /// source, implemented in slang-compile-cache.cpp. See `EndToEndCompileRequest::shouldDeduplicatePermutations`.
+        PermutationCache* getPermutationCache();
+        void destroyPermutationCache();
+
+            /// Get the profiler that compiles using this linkage record their phases to.
+            /// Returns nullptr if profiling is not enabled.
+        CompileProfiler* getProfiler() { return m_profiler; }
+        void setProfiler(CompileProfiler* profiler) { m_profiler = profiler; }
+
+            /// Get the report that compiles using this linkage record the size of the code
+            /// generated for each entry point to. Returns nullptr if code reports are not enabled.
+        CodeReport* getCodeReport() { return m_codeReport; }
+        void setCodeReport(CodeReport* codeReport) { m_codeReport = codeReport; }
+
+            /// Get the budget that compiles using this linkage are checked against.
+            /// Returns nullptr if there is no budget.
+        CompileBudget* getBudget() { return m_budget; }
+        void setBudget(CompileBudget* budget) { m_budget = budget; }
+
+            /// Get the pool that pool allocated objects (such as the `TypeLayout`s and `VarLayout`s
+            /// made by parameter binding) created for this linkage's programs are allocated from.
+        RefObjectPool* getRefObjectPool();
+
     private:
         Session* m_session = nullptr;
 
+        TypeCheckingCache* m_typeCheckingCache = nullptr;
+        TypeLayoutCache* m_typeLayoutCache = nullptr;
+        PermutationCache* m_permutationCache = nullptr;
+
+        RefPtr<CompileProfiler> m_profiler;
+        RefPtr<CodeReport> m_codeReport;
+        RefPtr<CompileBudget> m_budget;
+        RefPtr<RefObjectPool> m_refObjectPool;
+
+            /// Get the key of the options that change how this linkage loads and checks modules
+        String _getSharedModuleCacheKey();
+            /// Find or load the module at the path through the session's shared module cache.
+            /// Returns nullptr if the module can't be used, in which case it should be loaded as normal.
+        RefPtr<Module> _findOrImportSharedModule(Name* name, PathInfo const& filePathInfo);
+            /// Load the module from the precompiled module file at filePathInfo.
+            /// Returns nullptr (without diagnosing) if the file doesn't hold a usable precompiled
+            /// module for name, such as when the source it was compiled from has since changed.
+        RefPtr<Module> _loadPrecompiledModule(Name* name, PathInfo const& filePathInfo, SourceLoc const& loc, DiagnosticSink* sink);
+            /// Add a module loaded into the cache linkage, along with the modules it imports, to this linkage.
+            /// Returns false (adding nothing) if a different module is already loaded with one of the names or paths.
+        bool _attachSharedModule(Linkage* cacheLinkage, Module* module);
+            /// Remove the modules that failed to load, so that they will be loaded again when next imported
+        void _removeFailedModules();
+
             /// Tracks state of modules currently being loaded.
             ///
             /// This information is used to diagnose cases where
@@ -841,6 +1082,20 @@ namespace Slang
         List<RefPtr<Type>> m_specializedTypes;
     };
 
+        /// Where IR is dumped to, and what is dumped, when `shouldDumpIR` is set (see `IRDumper`)
+    struct IRDumpOptions
+    {
+            /// If set, each dump is written to its own file in this directory, rather than to the diagnostics
+        String directory;
+            /// If non-empty, only the global values (e.g. functions) with these names are dumped
+        List<String> globalValNames;
+            /// If set, a dump is skipped if it is the same as the previous dump of the module
+        bool changesOnly = false;
+            /// If set, dumps to `directory` are serialized IR modules (see `IRSerialWriter`), rather than text.
+            /// These always hold the whole module.
+        bool binary = false;
+    };
+
         /// Shared functionality between front- and back-end compile requests.
         ///
         /// This is the base class for both `FrontEndCompileRequest` and
@@ -869,8 +1124,15 @@ namespace Slang
         SlangResult loadFile(String const& path, ISlangBlob** outBlob) { return getLinkage()->loadFile(path, outBlob); }
 
         bool shouldDumpIR = false;
+        IRDumpOptions irDumpOptions;
         bool shouldValidateIR = false;
 
+            /// If set, IR validation only checks the code touched since a module was last validated
+        bool shouldValidateIRIncrementally = false;
+            /// If non-zero, IR validation also checks this percentage of the (otherwise unchecked)
+            /// functions and other global values, picked at random each time a module is validated
+        Int irValidationSamplePercent = 0;
+
     protected:
         CompileRequestBase(
             Linkage*        linkage,
@@ -906,9 +1168,26 @@ namespace Slang
         // serialization a bottleneck or firewall between the front end and the backend
         bool useSerialIRBottleneck = false; 
 
+        // If set, the serial IR bottleneck also writes the IR to a stream, and reads it back, with
+        // this compression (see `IRSerialUtil::parseStreamOptions`)
+        String serialIRCompression;
+
+            /// The number of threads used to encode and decode the chunks of the serialized IR when
+            /// `serialIRCompression` is set. Follows the back-end job count: 1 is serial, 0 uses one per hardware thread.
+        Int serialIRJobCount = 1;
+
         // If true will serialize and de-serialize with debug information
         bool verifyDebugSerialization = false;
 
+        // If false then IR will not be generated for the translation units, and only
+        // the checked AST is produced. Used when loading the standard library, where
+        // the AST is retained by the session but any generated IR would be discarded.
+        bool shouldGenerateIR = true;
+
+            /// If true the source of the declarations of each translation unit is kept as it is
+            /// parsed (see `TranslationUnitRequest::moduleInterfaceSource`), to write a precompiled module
+        bool shouldGenerateModuleInterface = false;
+
         List<RefPtr<FrontEndEntryPointRequest>> m_entryPointReqs;
 
         List<RefPtr<FrontEndEntryPointRequest>> const& getEntryPointReqs() { return m_entryPointReqs; }
@@ -925,9 +1204,18 @@ namespace Slang
         // Definitions to provide during preprocessing
         Dictionary<String, String> preprocessorDefinitions;
 
+            /// Preprocess the source files of `translationUnit`, holding the tokens for `parseTranslationUnit`
+        void preprocessTranslationUnit(
+            TranslationUnitRequest* translationUnit);
+
         void parseTranslationUnit(
             TranslationUnitRequest* translationUnit);
 
+            /// Preprocess one of the source files of `translationUnit`
+        TokenList _preprocessSourceFile(
+            TranslationUnitRequest* translationUnit,
+            SourceFile*             sourceFile);
+
         // Perform primary semantic checking on all
         // of the translation units in the program
         void checkAllTranslationUnits();
@@ -974,10 +1262,19 @@ namespace Slang
 
         Program* getProgram() { return m_program; }
 
+            /// Remove the translation units, entry points and program, keeping the options
+        void reset();
+
     private:
         RefPtr<Program> m_program;
     };
 
+        /// Witnesses found for existential type arguments, kept while specializing many programs that share the same slots.
+        ///
+        /// Indexed by the slot, and then by the argument type.
+        ///
+    typedef List<Dictionary<Type*, RefPtr<Val>>> ExistentialWitnessCache;
+
         /// A collection of code modules and entry points that are intended to be used together.
         ///
         /// A `Program` establishes that certain pieces of code are intended
@@ -1037,6 +1334,9 @@ namespace Slang
             /// Get the full list of filesystem paths this program depends on
         List<String> getFilePathDependencies() { return m_filePathDependencyList.getFilePathList(); }
 
+            /// Add a file path that the program depends on
+        void addFilePathDependency(String const& path) { m_filePathDependencyList.addDependency(path); }
+
             /// Get the target-specific version of this program for the given `target`.
             ///
             /// The `target` must be a target on the `Linkage` that was used to create this program.
@@ -1079,6 +1379,20 @@ namespace Slang
             ///
         Type* getTypeFromString(String typeStr, DiagnosticSink* sink);
 
+            /// Get the name to emit in place of the long identifier `name`, for targets
+            /// with `SLANG_TARGET_FLAG_SHORT_NAMES`.
+            ///
+            /// The short name is made from a hash of `name`, so it is the same for every
+            /// target and entry point. Names with the same hash get distinct short names, in
+            /// the order they are first emitted. Code is always emitted one entry point at a
+            /// time, in order, whatever the job count (see `BackEndCompileRequest::jobCount`),
+            /// so which name gets which doesn't depend on it.
+            ///
+        String getShortName(String const& name);
+
+            /// Get the identifier that `shortName` replaced, or null if it isn't a short name.
+        String const* findOriginalName(String const& shortName) { return m_originalNames.TryGetValue(shortName); }
+
             /// Get the IR module that represents this program and its entry points.
             ///
             /// The IR module for a program tries to be minimal, and in the
@@ -1092,6 +1406,9 @@ namespace Slang
             ///
         RefPtr<IRModule> getOrCreateIRModule(DiagnosticSink* sink);
 
+            /// Add the memory held by the program's IR and compiled code to ioStats
+        void accumulateMemoryStats(MemoryStats& ioStats);
+
             /// Get the number of existential type parameters for the program.
         Index getExistentialTypeParamCount() { return m_globalExistentialSlots.paramTypes.getCount(); }
 
@@ -1114,9 +1431,14 @@ namespace Slang
         List<GlobalShaderParamInfo> const& getShaderParams() { return m_shaderParams; }
 
         void _collectShaderParams(DiagnosticSink* sink);
+            /// Use the shader parameters and existential slots that `_collectShaderParams` found for `program`.
+            ///
+            /// `program` must have the same module dependencies as this program.
+        void _copyShaderParams(Program* program);
         void _specializeExistentialTypeParams(
             List<RefPtr<Expr>> const&   args,
-            DiagnosticSink*             sink);
+            DiagnosticSink*             sink,
+            ExistentialWitnessCache*    witnessCache = nullptr);
 
     private:
 
@@ -1156,6 +1478,10 @@ namespace Slang
 
         // Any types looked up dynamically using `getTypeFromString`
         Dictionary<String, RefPtr<Type>> m_types;
+
+        // The names made by `getShortName`, and the identifiers they replace
+        Dictionary<String, String> m_shortNames;
+        Dictionary<String, String> m_originalNames;
     };
 
         /// A `Program` specialized for a particular `TargetRequest`
@@ -1209,6 +1535,9 @@ namespace Slang
             return m_entryPointResults[entryPointIndex];
         }
 
+            /// Get the number of bytes of compiled code held for the entry points
+        size_t calcOutputSize();
+
 
             /// Internal helper for `getOrCreateEntryPointResult`.
             ///
@@ -1222,6 +1551,40 @@ namespace Slang
             BackEndCompileRequest*  backEndRequest,
             EndToEndCompileRequest* endToEndRequest);
 
+            /// Make sure there is a result slot for every entry point in the program.
+            ///
+            /// Must be called before code is generated with downstream compiles on a pool,
+            /// whose results are set with `getExistingEntryPointResult`.
+            ///
+        void _ensureEntryPointResultCount();
+
+            /// True if the entry points are compiled together as one library, which is
+            /// requested with `SLANG_TARGET_FLAG_DXIL_LIBRARY` for DXIL targets.
+        bool _shouldGenerateLibrary(EndToEndCompileRequest* endToEndRequest);
+
+            /// Generate the library containing all of the entry points, if it hasn't been
+            /// already, and make it the result for each entry point.
+        void _createLibraryResult(
+            BackEndCompileRequest*  backEndRequest,
+            EndToEndCompileRequest* endToEndRequest);
+
+            /// Get the information `linkIR` shares between all entry points
+            /// of the program on this target (implemented in slang-ir-link.cpp)
+        IRLinkCache* getIRLinkCache();
+        void destroyIRLinkCache();
+
+            /// Get the specializations of generics shared between all entry points
+            /// of the program on this target (implemented in slang-ir-specialization-cache.cpp)
+        IRSpecializationCache* getIRSpecializationCache();
+        void destroyIRSpecializationCache();
+
+            /// Get the type legalization results shared between all entry points
+            /// of the program on this target (implemented in slang-legalize-types.cpp)
+        IRTypeLegalizationCache* getIRTypeLegalizationCache();
+        void destroyIRTypeLegalizationCache();
+
+        ~TargetProgram();
+
     private:
         // The program being compiled or laid out
         Program* m_program;
@@ -1236,6 +1599,36 @@ namespace Slang
         // in the parent `Program` (indexing matches
         // the order they are given in the `Program`)
         List<CompileResult> m_entryPointResults;
+
+        // True once generation of the library holding all the entry points has started
+        bool m_hasLibraryResult = false;
+
+        IRLinkCache* m_irLinkCache = nullptr;
+        IRSpecializationCache* m_irSpecializationCache = nullptr;
+        IRTypeLegalizationCache* m_irTypeLegalizationCache = nullptr;
+    };
+
+        /// HLSL source emitted for entry points, shared between the targets of a request
+        /// that compile the same HLSL (HLSL source, DXBC through fxc, and DXIL through dxc).
+        ///
+        /// Entries are keyed by the entry point and every target option that affects the
+        /// emitted code (see `emitHLSLForEntryPoint`). Entries are only used on the thread
+        /// generating code, never by downstream compiles.
+        ///
+    class EmittedSourceCache : public RefObject
+    {
+    public:
+        struct Entry
+        {
+            String code;
+                /// The source map for the code, in LineDirectiveMode::SourceMap
+            ComPtr<ISlangBlob> sourceMap;
+                /// The global parameters the code uses, copied to the layout of each entry point that reuses it
+            UIntSet usedGlobalParameters;
+            bool hasUsedGlobalParameters = false;
+        };
+
+        Dictionary<String, Entry> entries;
     };
 
         /// A request to generate code for a program
@@ -1256,7 +1649,12 @@ namespace Slang
         LineDirectiveMode getLineDirectiveMode() { return lineDirectiveMode; }
 
         Program* getProgram() { return m_program; }
-        void setProgram(Program* program) { m_program = program; }
+        void setProgram(Program* program)
+        {
+            m_program = program;
+            // Source emitted for the previous program can't be reused
+            emittedSourceCache = new EmittedSourceCache();
+        }
 
         // Should R/W images without explicit formats be assumed to have "unknown" format?
         //
@@ -1264,6 +1662,27 @@ namespace Slang
         //
         bool useUnknownImageFormatAsDefault = false;
 
+            /// The number of downstream compiles (fxc, dxc, glslang) to run at once. With more than one,
+            /// Slang generates code for the (target, entry point) pairs on the calling thread, and their
+            /// downstream compiles run as jobs on a pool of worker threads (see `DownstreamCompile`).
+            /// 1 generates code serially, 0 uses one job per hardware thread.
+        Int jobCount = 1;
+
+            /// The number of worker threads to run downstream compiles on when `jobCount` is not 1.
+            /// 0 means `jobCount` threads.
+        Int downstreamJobCount = 0;
+
+            /// Set for requests whose downstream compiles run on a pool. The compile for an entry point
+            /// is submitted to the pool and held in `queuedDownstreamCompile`, and the result for the
+            /// entry point is made once the compile has completed.
+        ThreadPool* downstreamCompilePool = nullptr;
+            /// The compile last submitted to `downstreamCompilePool`, if its result hasn't been made yet
+        RefPtr<DownstreamCompile> queuedDownstreamCompile;
+
+            /// HLSL source already emitted by this request. Shared with the requests made for each entry point when
+            /// downstream compiles run on a pool.
+        RefPtr<EmittedSourceCache> emittedSourceCache;
+
     private:
         RefPtr<Program> m_program;
     };
@@ -1287,19 +1706,19 @@ namespace Slang
 
         // What container format are we being asked to generate?
         //
-        // Note: This field is unused except by the options-parsing
-        // logic; it exists to support wriiting out binary modules
-        // once that feature is ready.
+        // `ContainerFormat::SlangModule` produces a kernel container
+        // (see `KernelContainerBinary`) holding the output for every
+        // target and entry point.
         //
         ContainerFormat containerFormat = ContainerFormat::None;
 
-        // Path to output container to
-        //
-        // Note: This field exists to support wriiting out binary modules
-        // once that feature is ready.
+        // Path to output container to. Only written by command-line compiles.
         //
         String containerOutputPath;
 
+            /// The container generated if `containerFormat` is not `None`, returned by `spGetCompileRequestCode`
+        ComPtr<ISlangBlob> containerBlob;
+
         // Should we just pass the input to another compiler?
         PassThroughMode passThrough = PassThroughMode::None;
 
@@ -1311,11 +1730,56 @@ namespace Slang
 
         bool shouldSkipCodegen = false;
 
+            /// If set, the request is keyed by its preprocessed tokens, and the outputs of an earlier
+            /// compile with the same key (with this linkage, or in the compile cache) are reused.
+        bool shouldDeduplicatePermutations = false;
+
+            /// If set, the shared libraries of the downstream compilers the targets need are loaded on a
+            /// background thread at the start of the compile, while the front end runs
+        bool shouldPreloadDownstreamLibraries = false;
+
+            /// If set, the time taken by each phase of the compile is recorded (see `Linkage::getProfiler`)
+        bool shouldProfile = false;
+
+            /// If set (and profiling), a Chrome trace of the phases of the compile is written to this path
+        String profileTracePath;
+
+            /// If set, the size of the code generated for each entry point is recorded (see `Linkage::getCodeReport`)
+        bool shouldReportCode = false;
+
+            /// If set (and reporting code), the code report is written to this path as JSON
+        String codeReportPath;
+
+            /// The time and memory limits of the compile, and cancellation. Set on the linkage for the
+            /// duration of the compile.
+        RefPtr<CompileBudget> budget;
+
+            /// If not `SLANG_PREPROCESS_ONLY_NONE`, compilation stops after the translation units are
+            /// preprocessed, and the preprocessed source or the dependencies are output (see `mPreprocessOutput`)
+        SlangPreprocessOnlyMode preprocessOnlyMode = SLANG_PREPROCESS_ONLY_NONE;
+
+            /// The target of the rule output for `SLANG_PREPROCESS_ONLY_DEPENDENCIES`. If empty, the path of the
+            /// first source file is used.
+        String dependencyRuleTarget;
+
+            /// For command line compiles, the path the preprocess-only output is written to. If empty, it's
+            /// written to standard output.
+        String preprocessOutputPath;
+
         // Are we being driven by the command-line `slangc`, and should act accordingly?
         bool isCommandLineCompile = false;
 
         String mDiagnosticOutput;
 
+            /// Holds the text returned by `spGetProfileChromeTrace`
+        String mProfileChromeTrace;
+        String mCodeReportJSON;
+
+            /// The output of a preprocess-only compile, returned by `spGetPreprocessOutput`
+        String mPreprocessOutput;
+            /// The files read by a preprocess-only compile (which has no program to hold them)
+        List<String> mPreprocessDependencies;
+
             /// A blob holding the diagnostic output
         ComPtr<ISlangBlob> diagnosticOutputBlob;
 
@@ -1356,6 +1820,14 @@ namespace Slang
         SlangResult executeActionsInner();
         SlangResult executeActions();
 
+            /// Start loading the shared libraries of the downstream compilers needed by the targets (and
+            /// pass through mode) set so far, on a background thread of the session
+        void preloadDownstreamLibraries();
+
+            /// Remove everything specific to a compile (translation units, entry points, diagnostics
+            /// and outputs), keeping the options and the linkage with any modules it has loaded.
+        void reset();
+
         Session* getSession() { return m_session; }
         DiagnosticSink* getSink() { return &m_sink; }
         NamePool* getNamePool() { return getLinkage()->getNamePool(); }
@@ -1365,9 +1837,39 @@ namespace Slang
         Program* getUnspecializedProgram() { return getFrontEndReq()->getProgram(); }
         Program* getSpecializedProgram() { return m_specializedProgram; }
 
+            /// Add the memory held by the request (its linkage, translation units and programs) to ioStats
+        void accumulateMemoryStats(MemoryStats& ioStats);
+
     private:
         void init();
 
+            /// Returns true if outputs are cached in a cache directory, or a cache set by the application
+        bool _hasCompileCache();
+            /// Read the entry for key from the cache directory, or failing that the application's cache
+            /// (in which case it's also written to the cache directory)
+        SlangResult _readCompileCacheEntry(String const& key, CompileCacheEntry& outEntry);
+            /// Write entry to the cache directory and the application's cache
+        void _writeCompileCacheEntry(CompileCacheEntry const& entry);
+            /// Try to satisfy the request from the compile cache. Returns SLANG_OK on a hit.
+        SlangResult _loadFromCompileCache(String const& key);
+            /// Try to satisfy the request from the outputs of a permutation with the same preprocessed
+            /// tokens, from the linkage or the compile cache. Returns SLANG_OK on a hit.
+        SlangResult _loadFromPermutationCache(String const& key);
+            /// Use the outputs held in `entry` as the outputs of the request
+        SlangResult _applyCompileCacheEntry(CompileCacheEntry const& entry);
+            /// Hold the outputs of the (successful) request in `outEntry`. Returns false if they can't be cached.
+        bool _createCompileCacheEntry(String const& key, CompileCacheEntry& outEntry);
+            /// Store the outputs of the (successful) request in the compile cache
+        void _storeToCompileCache(String const& key);
+            /// Store the outputs of the (successful) request for later permutations with the same key
+        void _storeToPermutationCache(String const& key);
+            /// Write the Chrome trace of the profile to `profileTracePath`
+        void _writeProfileTrace();
+            /// Write the code report to `codeReportPath`
+        void _writeCodeReport();
+            /// Preprocess the translation units, and produce the output for `preprocessOnlyMode`
+        SlangResult _executePreprocessOnly();
+
         Session*                        m_session = nullptr;
         RefPtr<Linkage>                 m_linkage;
         DiagnosticSink                  m_sink;
@@ -1386,6 +1888,20 @@ namespace Slang
     void generateOutput(
         EndToEndCompileRequest* compileRequest);
 
+        /// Generate the code for every entry point of each of `programs`, on every target.
+        ///
+        /// Slang generates the code for one entry point at a time, while up to `jobCount` downstream
+        /// compiles (0 means one per core) run on a pool of worker threads.
+        /// The results are held on each program's `TargetProgram`s.
+    void generateEntryPointCodeWithJobs(
+        List<RefPtr<Program>> const&    programs,
+        Index                           jobCount,
+        DiagnosticSink*                 sink);
+
+        /// Write the generated output to any files (or the console) requested by a command-line compile
+    void writeOutput(
+        EndToEndCompileRequest* compileRequest);
+
     // Helper to dump intermediate output when debugging
     void maybeDumpIntermediate(
         BackEndCompileRequest* compileRequest,
@@ -1402,6 +1918,11 @@ namespace Slang
     /* Returns SLANG_OK if pass through support is available */
     SlangResult checkExternalCompilerSupport(Session* session, PassThroughMode passThrough);
 
+        /// Get the downstream compiler needed to produce code for target, or None if Slang can produce it alone
+    PassThroughMode getExternalCompilerRequiredForTarget(CodeGenTarget target);
+        /// Get the shared library of a downstream compiler. Unknown if there isn't one (or support isn't enabled).
+    SharedLibraryType getPassThroughSharedLibraryType(PassThroughMode passThrough);
+
     /* Report an error appearing from external compiler to the diagnostic sink error to the diagnostic sink.
     @param compilerName The name of the compiler the error came for (or nullptr if not known)
     @param res Result associated with the error. The error code will be reported. (Can take HRESULT - and will expand to string if known)
@@ -1418,7 +1939,6 @@ namespace Slang
     @return the appropriate source filename */
     String calcSourcePathForEntryPoint(EndToEndCompileRequest* endToEndReq, UInt entryPointIndex);
 
-    struct TypeCheckingCache;
     //
 
     class Session : public RefObject, public slang::IGlobalSession
@@ -1461,11 +1981,29 @@ namespace Slang
 
         SourceManager* getBuiltinSourceManager() { return &builtinSourceManager; }
 
+            /// Source manager for the files of modules in the shared module cache. It is the parent of the
+            /// source manager of every linkage, and its locations start at `kModuleCacheStartLoc` so that they
+            /// don't overlap those of any linkage.
+        SourceManager m_moduleCacheSourceManager;
+        SourceManager* getModuleCacheSourceManager() { return &m_moduleCacheSourceManager; }
+        static const SourceLoc::RawValue kModuleCacheStartLoc = 0x80000000;
+
+            /// Get the modules shared between linkages that set `Linkage::m_useSharedModuleCache`, implemented in slang.cpp
+        SharedModuleCache* getSharedModuleCache();
+        void destroySharedModuleCache();
+
+            /// Add the memory held by the session (its builtin modules, shared modules, names and token cache) to ioStats
+        void accumulateMemoryStats(MemoryStats& ioStats);
+
         // Name pool stuff for unique-ing identifiers
 
         RootNamePool rootNamePool;
         NamePool namePool;
 
+            /// The tokens of files included by any compile in the session (the tokens' names are from namePool)
+        PreprocessorTokenCache m_preprocessorTokenCache;
+        PreprocessorTokenCache* getPreprocessorTokenCache() { return &m_preprocessorTokenCache; }
+
         RootNamePool* getRootNamePool() { return &rootNamePool; }
         NamePool* getNamePool() { return &namePool; }
         Name* getNameObj(String name) { return namePool.getName(name); }
@@ -1496,6 +2034,11 @@ namespace Slang
         ComPtr<ISlangSharedLibraryLoader> sharedLibraryLoader;                          ///< The shared library loader (never null)
         ComPtr<ISlangSharedLibrary> sharedLibraries[int(SharedLibraryType::CountOf)];   ///< The loaded shared libraries
         SlangFuncPtr sharedLibraryFunctions[int(SharedLibraryFuncType::CountOf)];
+        String sharedLibraryFunctionIdentities[int(SharedLibraryFuncType::CountOf)];   ///< Set by `getSharedLibraryFuncIdentity`
+        bool sharedLibraryFunctionHasIdentity[int(SharedLibraryFuncType::CountOf)] = {};    ///< True once the identity is calculated
+
+        mutable std::mutex m_sharedLibraryMutex;        ///< Guards sharedLibraries, which the preload thread may be loading
+        std::thread m_sharedLibraryPreloadThread;       ///< Loads libraries for preloadSharedLibraries, if joinable
 
         Dictionary<int, RefPtr<Type>> builtinTypes;
         Dictionary<String, Decl*> magicDecls;
@@ -1553,33 +2096,130 @@ namespace Slang
 
         Dictionary<Name*, SyntaxClass<RefObject> > mapNameToSyntaxClass;
 
-        // cache used by type checking, implemented in check.cpp
-        TypeCheckingCache* typeCheckingCache = nullptr;
-        TypeCheckingCache* getTypeCheckingCache();
-        void destroyTypeCheckingCache();
-        //
-
             /// Will try to load the library by specified name (using the set loader), if not one already available.
         ISlangSharedLibrary* getOrLoadSharedLibrary(SharedLibraryType type, DiagnosticSink* sink);
 
             /// Gets a shared library by type, or null if not loaded
-        ISlangSharedLibrary* getSharedLibrary(SharedLibraryType type) const { return sharedLibraries[int(type)]; }
+        ISlangSharedLibrary* getSharedLibrary(SharedLibraryType type) const
+        {
+            std::lock_guard<std::mutex> lock(m_sharedLibraryMutex);
+            return sharedLibraries[int(type)];
+        }
+
+            /// Start loading the shared libraries of types on a background thread, so they are loaded (or
+            /// being loaded) by the time a compile needs them. A compile that needs a library being loaded
+            /// waits for it, rather than loading it again. Failure to load isn't reported here, but when the
+            /// library is needed. The loader must allow loading from another thread.
+        void preloadSharedLibraries(const SharedLibraryType* types, Index typeCount);
+            /// Wait for any shared libraries being preloaded to have loaded
+        void waitForSharedLibraryPreload();
 
         SlangFuncPtr getSharedLibraryFunc(SharedLibraryFuncType type, DiagnosticSink* sink);
 
+            /// Get text identifying the build of the shared library the (already loaded) function of type is in,
+            /// from the size and a hash of the contents of its file. Outputs of downstream compilers are cached
+            /// with this, rather than a version, as not all of them have one. Empty if the file can't be read.
+        String getSharedLibraryFuncIdentity(SharedLibraryFuncType type);
+
         Session();
 
         void addBuiltinSource(
             RefPtr<Scope> const&    scope,
             String const&           path,
             String const&           source);
+
+            /// Load the stdlib modules for `scope` if they have not been loaded yet.
+            ///
+            /// Pending modules that `scope` depends on are loaded first. If `scope` is
+            /// nullptr, all pending modules are loaded. Does nothing if called while a
+            /// stdlib module is being loaded.
+        void loadPendingBuiltinModules(Scope* scope = nullptr);
+
+            /// True if there are stdlib modules that have not been loaded yet
+        bool hasPendingBuiltinModules() const { return m_pendingBuiltinModules.getCount() != 0; }
+
+            /// True if lookup of name in scope and its siblings can't find anything, because scope is a
+            /// language scope and no stdlib module declares name. This takes a single probe of a table of
+            /// the names the stdlib declares. False if it can't tell, in which case the scopes are searched.
+        bool isNameUndeclaredInBuiltinScope(Scope* scope, Name* name);
+
+            /// Get statistics about stdlib module loading
+        void getStdLibStats(SlangSessionStdLibStats& outStats);
+
         ~Session();
 
     private:
+            /// A stdlib module that will be loaded into `scope` on first use
+        struct PendingBuiltinModule
+        {
+            Scope* scope;                   ///< The scope the module is loaded into (owned by the session)
+            char const* path;               ///< The path name of the module
+            String (Session::*getSource)(); ///< Function producing the module source
+        };
+
             /// Linkage used for all built-in (stdlib) code.
         RefPtr<Linkage> m_builtinLinkage;
+
+            /// Stdlib modules not loaded yet, in the order they must be loaded
+        List<PendingBuiltinModule> m_pendingBuiltinModules;
+        bool m_isLoadingBuiltinModule = false;
+        UInt m_loadedBuiltinModuleCount = 0;
+        uint64_t m_builtinModuleLoadTicks = 0;
+
+            /// Build m_builtinNames from the containers of the language scopes
+        void _buildBuiltinNames();
+
+        HashSet<Name*> m_builtinNames;              ///< Every name declared by a container of the language scopes
+        bool m_builtinNamesIsValid = false;         ///< False if stdlib code was added since m_builtinNames was built
+        bool m_builtinNamesIsComplete = false;      ///< False if lookup in the language scopes can find names not in m_builtinNames
+
+        SharedModuleCache* m_sharedModuleCache = nullptr;
+    };
+
+        /// A compile by a downstream compiler (fxc, dxc or glslang) of the code Slang generated for an entry point.
+        ///
+        /// A compile is set up on the thread generating code. When the request it is set up for has a
+        /// `downstreamCompilePool` it then runs on the pool, while Slang generates the code for later entry
+        /// points, and otherwise it runs straight away. Slang's objects aren't thread safe (reference counting
+        /// in particular isn't atomic), so a compile only works on its own copies of its inputs, and reports
+        /// errors to its own `sink`.
+        ///
+    class DownstreamCompile : public RefObject, public ThreadPoolJob
+    {
+    public:
+            /// Get the compiled code from the compile cache, or run the compiler and store the code it produces.
+            /// Sets `result` and `code`.
+        virtual void execute() SLANG_OVERRIDE;
+
+            /// Set the key the compiled code is cached under. compilerFunc is the (loaded) function used to run the
+            /// compiler, which identifies its build. options describes everything other than the source that the
+            /// output depends on (see `CompileCache::calcDownstreamKey`). Without a key the cache isn't used.
+        void setCacheKey(BackEndCompileRequest* request, Session::SharedLibraryFuncType compilerFunc, const String& options);
+
+            /// Ctor. source is the code to compile, which is copied.
+        DownstreamCompile(BackEndCompileRequest* request, const char* compilerName, const String& source);
+
+        DiagnosticSink sink;                        ///< Errors reported by the compile
+        SlangResult result = SLANG_OK;              ///< The result of the compile, once it has run
+        ComPtr<ISlangBlob> code;                    ///< The compiled code, once it has run
+        bool isOnPool = false;                      ///< Set if the compile runs on a pool thread
+
+    protected:
+            /// Run the compiler on m_source, setting outCode to the code it produces
+        virtual SlangResult _compile(ComPtr<ISlangBlob>& outCode) = 0;
+
+        const char* m_compilerName;
+        String m_source;
+        CompileProfiler* m_profiler;
+
+        String m_cacheKey;                          ///< Empty if the output isn't cached
+        String m_cacheDirectory;
+        uint64_t m_cacheMaxSize = 0;
+        ISlangCompileCache* m_compileCache = nullptr;
     };
 
+        /// Run compile straight away, adding its diagnostics to the sink of compileRequest, and set outCode to the code it produces
+    SlangResult runDownstreamCompile(BackEndCompileRequest* compileRequest, DownstreamCompile* compile, ComPtr<ISlangBlob>& outCode);
 
 //
 // The following functions are utilties to convert between
@@ -27,6 +27,12 @@ ABSTRACT_SYNTAX_CLASS(ContainerDecl, Decl)
     // Should be set to `false` if any members get added/remoed.
     bool memberDictionaryIsValid = false;
 
+    // The number of `Members` that are in the `memberDictionary`.
+    // Members are only ever appended, so when the dictionary is
+    // invalidated only those after these need to be added.
+    // Set to zero to have the whole dictionary rebuilt.
+    Index memberDictionaryMemberCount = 0;
+
     // A list of transparent members, to be used in lookup
     // Note: this is only valid if `memberDictionaryIsValid` is true
     List<TransparentMemberInfo> transparentMembers;
@@ -80,6 +86,17 @@ ABSTRACT_SYNTAX_CLASS(AggTypeDecl, AggTypeDeclBase)
 RAW(
     // extensions that might apply to this declaration
     ExtensionDecl* candidateExtensions = nullptr;
+
+    // For each member name, the candidate extensions (in candidate order) that might provide a
+    // member with that name, so that lookup doesn't have to apply every extension to the type.
+    // Built on demand by lookup, and rebuilt when `candidateExtensions` changes.
+    Dictionary<Name*, List<ExtensionDecl*>> extensionsByMemberName;
+
+    // The candidate extensions that are searched whatever the name (those with transparent members)
+    List<ExtensionDecl*> extensionsForAnyMemberName;
+
+    // The `candidateExtensions` that the extension member table was built for
+    ExtensionDecl* extensionMemberTableHead = nullptr;
     FilteredMemberList<VarDecl> GetFields()
     {
         return getMembersOfType<VarDecl>();
@@ -61,6 +61,8 @@ DIAGNOSTIC(    7, Error, noOutputPathSpecifiedForEntryPoint,
 DIAGNOSTIC(    8, Error, outputPathsImplyDifferentFormats,
     "the output paths '$0' and '$1' require different code-generation targets")
 
+DIAGNOSTIC(    9, Error, compilationStopped, "compilation stopped: $0")
+
 DIAGNOSTIC(    10, Error, explicitOutputPathsAndMultipleTargets, "canot use both explicit output paths ('-o') and multiple targets ('-target')")
 DIAGNOSTIC(    11, Error, glslIsNotSupported, "the Slang compiler does not support GLSL as a source language");
 DIAGNOSTIC(    12, Error, cannotDeduceSourceLanguage, "can't deduce language for input file '$0'");
@@ -76,8 +78,17 @@ DIAGNOSTIC(    24, Error, unknownLineDirectiveMode, "unknown '#line' directive m
 DIAGNOSTIC(    25, Error, unknownFloatingPointMode, "unknown floating-point mode '$0'");
 DIAGNOSTIC(    26, Error, unknownOptimiziationLevel, "unknown optimization level '$0'");
 DIAGNOSTIC(    27, Error, unknownDebugInfoLevel, "unknown debug info level '$0'");
+DIAGNOSTIC(    29, Error, invalidCompileCacheSize, "invalid compile cache size '$0' (expected a size in megabytes)");
+DIAGNOSTIC(    44, Error, invalidCompileLimit, "invalid value '$1' for '$0' (expected a non-negative number)");
+DIAGNOSTIC(    36, Error, invalidJobCount, "invalid job count '$0' (expected a non-negative integer)");
+DIAGNOSTIC(    38, Error, invalidDiagnosticId, "invalid diagnostic id '$0' (expected an integer)");
+DIAGNOSTIC(    45, Error, invalidIRValidationSamplePercent, "invalid IR validation sample percentage '$0' (expected an integer from 1 to 100)");
+DIAGNOSTIC(    37, Error, unknownSerialIRCompression, "unknown serial IR compression '$0' (expected none, lite, lite-delta, lz4 or lz4-delta)");
 
 DIAGNOSTIC(    28, Error, unableToGenerateCodeForTarget, "unable to generate code for target '$0'");
+DIAGNOSTIC(    39, Error, unableToCreateContainer, "unable to create the output container (it would be larger than 4GB)");
+DIAGNOSTIC(    46, Error, unableToCreatePrecompiledModule, "unable to create the precompiled module (the IR or the files it was compiled from could not be read)");
+DIAGNOSTIC(    47, Error, precompiledModuleNeedsOneTranslationUnit, "a precompiled module ('.slang-precompiled' output) is compiled from a single translation unit");
 
 DIAGNOSTIC(    30, Warning, sameStageSpecifiedMoreThanOnce, "the stage '$0' was specified more than once for entry point '$1'")
 DIAGNOSTIC(    31, Error, conflictingStagesForEntryPoint, "conflicting stages have been specified for entry point '$0'")
@@ -270,6 +281,11 @@ DIAGNOSTIC(31006, Error, attributeFunctionNotFound, "Could not find function '$0
 DIAGNOSTIC(31100, Error, unknownStageName, "unknown stage name '$0'")
 DIAGNOSTIC(31101, Error, unknownImageFormatName, "unknown image format '$0'")
 
+DIAGNOSTIC(31110, Error, specializationConstantMustBeGlobalConst, "specialization constant '$0' must be a 'const' variable declared at global scope")
+DIAGNOSTIC(31111, Error, invalidSpecializationConstantType, "specialization constant '$0' must have type 'bool', 'int' or 'uint', not '$1'")
+DIAGNOSTIC(31112, Error, specializationConstantNeedsConstantInitializer, "specialization constant '$0' must be initialized with a compile-time constant")
+DIAGNOSTIC(31113, Error, duplicateSpecializationConstantID, "specialization constant '$0' uses constant id $1, which is already used by '$2'")
+
 DIAGNOSTIC(31120, Error, invalidAttributeTarget, "invalid syntax target for user defined attribute")
 
 // Enums
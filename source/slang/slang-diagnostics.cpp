@@ -145,9 +145,9 @@ SourceLoc const& getDiagnosticPos(TypeExp const& typeExp)
     return typeExp.exp->loc;
 }
 
-SourceLoc const& getDiagnosticPos(IRInst* inst)
+SourceLoc getDiagnosticPos(IRInst* inst)
 {
-    return inst->sourceLoc;
+    return inst->getSourceLoc();
 }
 
 
@@ -208,7 +208,7 @@ static void formatDiagnosticMessage(StringBuilder& sb, char const* format, int a
     }
 }
 
-static void formatDiagnostic(const HumaneSourceLoc& humaneLoc, Diagnostic const& diagnostic, StringBuilder& outBuilder)
+static void formatDiagnostic(const HumaneSourceLoc& humaneLoc, Diagnostic const& diagnostic, const UnownedStringSlice& message, StringBuilder& outBuilder)
 {
     outBuilder << humaneLoc.pathInfo.foundPath;
     outBuilder << "(";
@@ -224,13 +224,14 @@ static void formatDiagnostic(const HumaneSourceLoc& humaneLoc, Diagnostic const&
     }
 
     outBuilder << ": ";
-    outBuilder << diagnostic.Message;
+    outBuilder << message;
     outBuilder << "\n";
 }
 
 static void formatDiagnostic(
     DiagnosticSink*     sink,
     Diagnostic const&   diagnostic,
+    const UnownedStringSlice& message,
     StringBuilder&      sb)
 {
     auto sourceManager = sink->sourceManager;
@@ -244,7 +245,7 @@ static void formatDiagnostic(
         {
             humaneLoc = sourceView->getHumaneLoc(sourceLoc);
         }
-        formatDiagnostic(humaneLoc, diagnostic, sb);
+        formatDiagnostic(humaneLoc, diagnostic, message, sb);
     }
      
     if (sourceView && (sink->flags & DiagnosticSink::Flag::VerbosePath))
@@ -259,22 +260,30 @@ static void formatDiagnostic(
             actualHumaneLoc.line != humaneLoc.line ||
             actualHumaneLoc.column != humaneLoc.column)
         { 
-            formatDiagnostic(actualHumaneLoc, diagnostic, sb);
+            formatDiagnostic(actualHumaneLoc, diagnostic, message, sb);
         }
     }
 }
 
 void DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo const& info, int argCount, DiagnosticArg const* const* args)
 {
-    StringBuilder sb;
-    formatDiagnosticMessage(sb, info.messageFormat, argCount, args);
+    if (!isEnabled(info))
+    {
+        return;
+    }
 
+    // The message is only formatted once we know it's reported, and used from the builder without
+    // making a String for it
     Diagnostic diagnostic;
     diagnostic.ErrorID = info.id;
-    diagnostic.Message = sb.ProduceString();
     diagnostic.loc = pos;
     diagnostic.severity = info.severity;
 
+    StringBuilder messageBuilder;
+    formatDiagnosticMessage(messageBuilder, info.messageFormat, argCount, args);
+    const UnownedStringSlice message = messageBuilder.getUnownedSlice();
+
+    diagnosticCount++;
     if (diagnostic.severity >= Severity::Error)
     {
         errorCount++;
@@ -284,16 +293,16 @@ void DiagnosticSink::diagnoseImpl(SourceLoc const& pos, DiagnosticInfo const& in
     if( writer )
     {
         // If so, pass the error string along to them
-        StringBuilder messageBuilder;
-        formatDiagnostic(this, diagnostic, messageBuilder);
+        StringBuilder diagnosticBuilder;
+        formatDiagnostic(this, diagnostic, message, diagnosticBuilder);
 
-        writer->write(messageBuilder.getBuffer(), messageBuilder.getLength());
+        writer->write(diagnosticBuilder.getBuffer(), diagnosticBuilder.getLength());
     }
     else
     {
         // If the user doesn't have a callback, then just
         // collect our diagnostic messages into a buffer
-        formatDiagnostic(this, diagnostic, outputBuffer);
+        formatDiagnostic(this, diagnostic, message, outputBuffer);
     }
 
     if (diagnostic.severity >= Severity::Fatal)
@@ -314,6 +323,7 @@ void DiagnosticSink::diagnoseRaw(
     Severity    severity,
     const UnownedStringSlice& message)
 {
+    diagnosticCount++;
     if (severity >= Severity::Error)
     {
         errorCount++;
@@ -339,6 +349,28 @@ void DiagnosticSink::diagnoseRaw(
     }
 }
 
+void DiagnosticSink::appendDiagnostics(DiagnosticSink const& other)
+{
+    SLANG_ASSERT(other.writer == nullptr);
+
+    diagnosticCount += other.diagnosticCount;
+    errorCount += other.errorCount;
+
+    if (other.outputBuffer.getLength() == 0)
+    {
+        return;
+    }
+
+    if (writer)
+    {
+        writer->write(other.outputBuffer.getBuffer(), other.outputBuffer.getLength());
+    }
+    else
+    {
+        outputBuffer.append(other.outputBuffer);
+    }
+}
+
 
 namespace Diagnostics
 {
@@ -115,7 +115,7 @@ namespace Slang
     SourceLoc const& getDiagnosticPos(TypeExp const& typeExp);
 
     struct IRInst;
-    SourceLoc const& getDiagnosticPos(IRInst* inst);
+    SourceLoc getDiagnosticPos(IRInst* inst);
 
     template<typename T>
     SourceLoc getDiagnosticPos(RefPtr<T> const& ptr)
@@ -153,6 +153,7 @@ namespace Slang
             enum Enum: uint32_t
             {
                 VerbosePath = 0x1,              ///< Will display a more verbose path (if available) - such as a canonical or absolute path
+                DisableWarnings = 0x2,          ///< Warnings are not reported (or counted)
             };
         };
         typedef uint32_t Flags;
@@ -160,6 +161,7 @@ namespace Slang
         StringBuilder outputBuffer;
 //            List<Diagnostic> diagnostics;
         int errorCount = 0;
+        int diagnosticCount = 0;                    ///< Count of all diagnostics, of any severity
         int internalErrorLocsNoted = 0;
 
         ISlangWriter* writer                        = nullptr;
@@ -181,6 +183,42 @@ namespace Slang
         }
 */
         int GetErrorCount() { return errorCount; }
+        int getDiagnosticCount() { return diagnosticCount; }
+
+            /// Remove the diagnostics that have been output, and their counts
+        void reset()
+        {
+            outputBuffer.Clear();
+            errorCount = 0;
+            diagnosticCount = 0;
+            internalErrorLocsNoted = 0;
+        }
+
+            /// Stop diagnostics with the id being reported (or counted). Errors can't be disabled.
+        void disableDiagnostic(int id) { m_disabledIds.Add(id); }
+
+            /// Report the same diagnostics as other (its flags and disabled diagnostics). Used to set up
+            /// the sinks of jobs whose diagnostics are later added to other with `appendDiagnostics`.
+        void copyOptions(DiagnosticSink const& other)
+        {
+            flags = other.flags;
+            m_disabledIds = other.m_disabledIds;
+        }
+
+            /// True if a diagnostic would be reported. Checked before the diagnostic's position
+            /// or arguments are looked at, so disabled diagnostics cost almost nothing.
+        bool isEnabled(DiagnosticInfo const& info) const
+        {
+            if (info.severity >= Severity::Error)
+            {
+                return true;
+            }
+            if (info.severity == Severity::Warning && (flags & Flag::DisableWarnings))
+            {
+                return false;
+            }
+            return m_disabledIds.Count() == 0 || !m_disabledIds.Contains(info.id);
+        }
 
         void diagnoseDispatch(SourceLoc const& pos, DiagnosticInfo const& info)
         {
@@ -214,7 +252,10 @@ namespace Slang
         template<typename P, typename... Args>
         void diagnose(P const& pos, DiagnosticInfo const& info, Args const&... args )
         {
-            diagnoseDispatch(getDiagnosticPos(pos), info, args...);
+            if (isEnabled(info))
+            {
+                diagnoseDispatch(getDiagnosticPos(pos), info, args...);
+            }
         }
 
         void diagnoseImpl(SourceLoc const& pos, DiagnosticInfo const& info, int argCount, DiagnosticArg const* const* args);
@@ -228,11 +269,18 @@ namespace Slang
             Severity    severity,
             const UnownedStringSlice& message);
 
+            /// Add all of the diagnostics held in `other` to this sink, as if they had been reported here.
+            /// `other` must not have a writer, so that its diagnostics are held in its output buffer.
+        void appendDiagnostics(DiagnosticSink const& other);
+
             /// During propagation of an exception for an internal
             /// error, note that this source location was involved
         void noteInternalErrorLoc(SourceLoc const& loc);
 
         SlangResult getBlobIfNeeded(ISlangBlob** outBlob);
+
+    protected:
+        HashSet<int> m_disabledIds;                 ///< Ids of diagnostics that are not reported
     };
 
         /// An `ISlangWriter` that writes directly to a diagnostic sink.
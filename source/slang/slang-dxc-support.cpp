@@ -1,5 +1,6 @@
 // slang-dxc-support.cpp
 #include "slang-compiler.h"
+#include "slang-emit.h"
 
 // This file implements support for invoking the `dxcompiler`
 // library to translate HLSL to DXIL.
@@ -34,7 +35,8 @@ namespace Slang
         EntryPoint*             entryPoint,
         Int                     entryPointIndex,
         TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq);
+        EndToEndCompileRequest* endToEndReq,
+        ISlangBlob**            outSourceMap = nullptr);
 
     static UnownedStringSlice _getSlice(IDxcBlob* blob)
     {
@@ -48,21 +50,162 @@ namespace Slang
         return UnownedStringSlice();
     }
 
-    SlangResult emitDXILForEntryPointUsingDXC(
-        BackEndCompileRequest*  compileRequest,
-        EntryPoint*             entryPoint,
-        Int                     entryPointIndex,
-        TargetRequest*          targetReq,
-        EndToEndCompileRequest* endToEndReq,
-        List<uint8_t>&          outCode)
+        /// The dxc instances used by a thread that runs downstream compiles on a pool.
+        ///
+        /// Creating the dxc compiler is relatively expensive, so the threads of a pool keep
+        /// their instances for all of the entry points they compile. The instances are thread
+        /// local because an `IDxcCompiler` must not be used by more than one thread at a time.
+        /// Pool threads exit before the session that loaded `dxcompiler` can be destroyed.
+    struct DXCThreadInstances
+    {
+        DxcCreateInstanceProc createInstance = nullptr;     ///< The function the instances were created with
+        ComPtr<IDxcCompiler> compiler;
+        ComPtr<IDxcLibrary> library;
+    };
+    static thread_local DXCThreadInstances t_dxcThreadInstances;
+
+    static SlangResult _getDXCInstances(
+        DxcCreateInstanceProc   dxcCreateInstance,
+        bool                    reuseInstances,
+        ComPtr<IDxcCompiler>&   outCompiler,
+        ComPtr<IDxcLibrary>&    outLibrary)
+    {
+        DXCThreadInstances& instances = t_dxcThreadInstances;
+        if (reuseInstances && instances.createInstance == dxcCreateInstance && instances.compiler && instances.library)
+        {
+            outCompiler = instances.compiler;
+            outLibrary = instances.library;
+            return SLANG_OK;
+        }
+
+        SLANG_RETURN_ON_FAIL(dxcCreateInstance(
+            CLSID_DxcCompiler,
+            __uuidof(outCompiler),
+            (LPVOID*)outCompiler.writeRef()));
+
+        SLANG_RETURN_ON_FAIL(dxcCreateInstance(
+            CLSID_DxcLibrary,
+            __uuidof(outLibrary),
+            (LPVOID*)outLibrary.writeRef()));
+
+        if (reuseInstances)
+        {
+            instances.createInstance = dxcCreateInstance;
+            instances.compiler = outCompiler;
+            instances.library = outLibrary;
+        }
+        return SLANG_OK;
+    }
+
+        /// Compiles HLSL to DXIL with dxc
+    class DxcCompile : public DownstreamCompile
+    {
+    public:
+        DxcCompile(BackEndCompileRequest* request, const String& source, DxcCreateInstanceProc createInstance)
+            : DownstreamCompile(request, "dxc", source)
+            , m_createInstance(createInstance)
+        {
+        }
+
+        // The strings are copies, that don't share their buffers with any others
+        String sourcePath;
+        String entryPointName;              ///< Empty when compiling a library
+        String profileName;
+        List<WCHAR const*> args;            ///< Arguments for dxc, which are all literals
+
+    protected:
+        virtual SlangResult _compile(ComPtr<ISlangBlob>& outCode) SLANG_OVERRIDE
+        {
+            // Only pool threads reuse instances, as other threads
+            // may outlive the session that loaded the library.
+            ComPtr<IDxcCompiler> dxcCompiler;
+            ComPtr<IDxcLibrary> dxcLibrary;
+            SLANG_RETURN_ON_FAIL(_getDXCInstances(m_createInstance, isOnPool, dxcCompiler, dxcLibrary));
+
+            // The source is handed to dxc in memory. The blob refers to the
+            // generated text rather than copying it, and giving the code page
+            // up front means dxc doesn't have to detect the encoding itself.
+            ComPtr<IDxcBlobEncoding> dxcSourceBlob;
+            SLANG_RETURN_ON_FAIL(dxcLibrary->CreateBlobWithEncodingFromPinned(
+                (LPBYTE)m_source.getBuffer(),
+                (UINT32)m_source.getLength(),
+                CP_UTF8,
+                dxcSourceBlob.writeRef()));
+
+            OSString wideSourcePath = sourcePath.toWString();
+            OSString wideEntryPointName = entryPointName.toWString();
+            OSString wideProfileName = profileName.toWString();
+
+            ComPtr<IDxcOperationResult> dxcResult;
+            SLANG_RETURN_ON_FAIL(dxcCompiler->Compile(dxcSourceBlob,
+                wideSourcePath.begin(),
+                entryPointName.getLength() ? wideEntryPointName.begin() : L"",
+                wideProfileName.begin(),
+                args.getBuffer(),
+                UINT32(args.getCount()),
+                nullptr,        // `#define`s
+                0,              // `#define` count
+                nullptr,        // `#include` handler
+                dxcResult.writeRef()));
+
+            // Retrieve result.
+            HRESULT resultCode = S_OK;
+            SLANG_RETURN_ON_FAIL(dxcResult->GetStatus(&resultCode));
+        
+            // Note: it seems like the dxcompiler interface
+            // doesn't support querying diagnostic output
+            // *unless* the compile failed (no way to get
+            // warnings out!?).
+
+            // Verify compile result
+            if (SLANG_FAILED(resultCode))
+            {
+                // Compilation failed.
+                // Try to read any diagnostic output.
+                ComPtr<IDxcBlobEncoding> dxcErrorBlob; 
+                SLANG_RETURN_ON_FAIL(dxcResult->GetErrorBuffer(dxcErrorBlob.writeRef()));
+
+                // Note: the error blob returned by dxc doesn't always seem
+                // to be nul-terminated, so we should be careful and turn it
+                // into a string for safety.
+                //
+
+                reportExternalCompileError("dxc", resultCode, _getSlice(dxcErrorBlob), &sink);
+                return resultCode;
+            }
+
+            // Okay, the compile supposedly succeeded, so we
+            // just need to grab the buffer with the output DXIL.
+            ComPtr<IDxcBlob> dxcResultBlob;
+            SLANG_RETURN_ON_FAIL(dxcResult->GetResult(dxcResultBlob.writeRef()));
+        
+            // The output is held in dxc's blob rather than copied out of it
+            outCode = createOwnedDataBlob((ISlangUnknown*)dxcResultBlob.get(), dxcResultBlob->GetBufferPointer(), size_t(dxcResultBlob->GetBufferSize()));
+            return SLANG_OK;
+        }
+
+        DxcCreateInstanceProc m_createInstance;
+    };
+
+        /// Set up a compile of `hlslCode` to DXIL with dxc.
+        ///
+        /// `entryPointName` is ignored when `profile` has no stage, in which
+        /// case the code is compiled as a library (for a `lib_*` profile).
+    static SlangResult _createDXILCompile(
+        BackEndCompileRequest*      compileRequest,
+        TargetRequest*              targetReq,
+        const String&               hlslCode,
+        const String&               sourcePath,
+        const String&               entryPointName,
+        Profile                     profile,
+        RefPtr<DownstreamCompile>&  outCompile)
     {
         auto session = compileRequest->getSession();
         auto sink = compileRequest->getSink();
 
         // First deal with all the rigamarole of loading
-        // the `dxcompiler` library, and creating the
-        // top-level COM objects that will be used to
-        // compile things.
+        // the `dxcompiler` library. The COM objects used to
+        // compile are created by the compile.
 
         auto dxcCreateInstance = (DxcCreateInstanceProc)session->getSharedLibraryFunc(Session::SharedLibraryFuncType::Dxc_DxcCreateInstance, sink);
         if (!dxcCreateInstance)
@@ -70,8 +213,10 @@ namespace Slang
             return SLANG_FAIL;
         }
 
+        // Without dxil dxc can't sign its output, so whether it's found is part of the cache key
+        const bool hasDxil = session->getSharedLibrary(SharedLibraryType::Dxil) != nullptr;
         {
-            if (!session->getSharedLibrary(SharedLibraryType::Dxil))
+            if (!hasDxil)
             {
                 // If can't load dxil - dxc will not be able to sign output
                 // Output a suitable warning to the user
@@ -79,46 +224,14 @@ namespace Slang
             }
         }
 
-        ComPtr<IDxcCompiler> dxcCompiler;
-        SLANG_RETURN_ON_FAIL(dxcCreateInstance(
-            CLSID_DxcCompiler,
-            __uuidof(dxcCompiler),
-            (LPVOID*)dxcCompiler.writeRef()));
-
-        ComPtr<IDxcLibrary> dxcLibrary;
-        SLANG_RETURN_ON_FAIL(dxcCreateInstance(
-            CLSID_DxcLibrary,
-            __uuidof(dxcLibrary),
-            (LPVOID*)dxcLibrary.writeRef()));
-
-        // Now let's go ahead and generate HLSL for the entry
-        // point, since we'll need that to feed into dxc.
-        auto hlslCode = emitHLSLForEntryPoint(
-            compileRequest,
-            entryPoint,
-            entryPointIndex,
-            targetReq,
-            endToEndReq);
-        maybeDumpIntermediate(compileRequest, hlslCode.getBuffer(), CodeGenTarget::HLSL);
-
-        // Wrap the 
-
-        // Create blob from the string
-        ComPtr<IDxcBlobEncoding> dxcSourceBlob;
-        SLANG_RETURN_ON_FAIL(dxcLibrary->CreateBlobWithEncodingFromPinned(
-            (LPBYTE)hlslCode.getBuffer(),
-            (UINT32)hlslCode.getLength(),
-            0,
-            dxcSourceBlob.writeRef()));
-
-        WCHAR const* args[16];
-        UINT32 argCount = 0;
+        RefPtr<DxcCompile> compile = new DxcCompile(compileRequest, hlslCode, dxcCreateInstance);
+        auto& args = compile->args;
 
         // TODO: deal with
         bool treatWarningsAsErrors = false;
         if (treatWarningsAsErrors)
         {
-            args[argCount++] = L"-WX";
+            args.add(L"-WX");
         }
 
         switch( targetReq->getDefaultMatrixLayoutMode() )
@@ -127,7 +240,7 @@ namespace Slang
             break;
 
         case kMatrixLayoutMode_RowMajor:
-            args[argCount++] = L"-Zpr";
+            args.add(L"-Zpr");
             break;
         }
 
@@ -137,7 +250,7 @@ namespace Slang
             break;
 
         case FloatingPointMode::Precise:
-            args[argCount++] = L"-Gis"; // "force IEEE strictness"
+            args.add(L"-Gis"); // "force IEEE strictness"
             break;
         }
 
@@ -147,10 +260,10 @@ namespace Slang
         default:
             break;
 
-        case OptimizationLevel::None:       args[argCount++] = L"-Od"; break;
-        case OptimizationLevel::Default:    args[argCount++] = L"-O1"; break;
-        case OptimizationLevel::High:       args[argCount++] = L"-O2"; break;
-        case OptimizationLevel::Maximal:    args[argCount++] = L"-O3"; break;
+        case OptimizationLevel::None:       args.add(L"-Od"); break;
+        case OptimizationLevel::Default:    args.add(L"-O1"); break;
+        case OptimizationLevel::High:       args.add(L"-O2"); break;
+        case OptimizationLevel::Maximal:    args.add(L"-O3"); break;
         }
 
         switch( linkage->debugInfoLevel )
@@ -159,7 +272,7 @@ namespace Slang
             break;
 
         default:
-            args[argCount++] = L"-Zi";
+            args.add(L"-Zi");
             break;
         }
 
@@ -178,14 +291,7 @@ namespace Slang
         // work on mainline Clang. Thus the only option we have available
         // is the big hammer of turning off *all* warnings coming from dxc.
         //
-        args[argCount++] = L"-no-warnings";
-
-        String entryPointName = getText(entryPoint->getName());
-        OSString wideEntryPointName = entryPointName.toWString();
-
-        auto profile = getEffectiveProfile(entryPoint, targetReq);
-        String profileName = GetHLSLProfileName(profile);
-        OSString wideProfileName = profileName.toWString();
+        args.add(L"-no-warnings");
 
         // We will enable the flag to generate proper code for 16-bit types
         // by default, as long as the user is requesting a sufficiently
@@ -200,59 +306,107 @@ namespace Slang
         //
         if( profile.GetVersion() >= ProfileVersion::DX_6_2 )
         {
-            args[argCount++] = L"-enable-16bit-types";
+            args.add(L"-enable-16bit-types");
         }
 
-        const String sourcePath = calcSourcePathForEntryPoint(endToEndReq, entryPointIndex);
-
-        ComPtr<IDxcOperationResult> dxcResult;
-        SLANG_RETURN_ON_FAIL(dxcCompiler->Compile(dxcSourceBlob,
-            sourcePath.toWString().begin(),
-            profile.GetStage() == Stage::Unknown ? L"" : wideEntryPointName.begin(),
-            wideProfileName.begin(),
-            args,
-            argCount,
-            nullptr,        // `#define`s
-            0,              // `#define` count
-            nullptr,        // `#include` handler
-            dxcResult.writeRef()));
-
-        // Retrieve result.
-        HRESULT resultCode = S_OK;
-        SLANG_RETURN_ON_FAIL(dxcResult->GetStatus(&resultCode));
-        
-        // Note: it seems like the dxcompiler interface
-        // doesn't support querying diagnostic output
-        // *unless* the compile failed (no way to get
-        // warnings out!?).
+        compile->sourcePath = String(sourcePath.getUnownedSlice());
+        if (profile.GetStage() != Stage::Unknown)
+        {
+            compile->entryPointName = String(entryPointName.getUnownedSlice());
+        }
+        compile->profileName = String(GetHLSLProfileName(profile).getUnownedSlice());
+
+        StringBuilder cacheOptions;
+        cacheOptions << "source-path: " << compile->sourcePath << "\n";
+        cacheOptions << "entry-point: " << compile->entryPointName << "\n";
+        cacheOptions << "profile: " << compile->profileName << "\n";
+        cacheOptions << "signed: " << int(hasDxil) << "\n";
+        for (auto arg : args)
+        {
+            cacheOptions << "arg: " << String::fromWString(arg) << "\n";
+        }
+        compile->setCacheKey(compileRequest, Session::SharedLibraryFuncType::Dxc_DxcCreateInstance, cacheOptions);
+
+        outCompile = compile;
+        return SLANG_OK;
+    }
+
+    SlangResult createDXILCompileForEntryPoint(
+        BackEndCompileRequest*      compileRequest,
+        EntryPoint*                 entryPoint,
+        Int                         entryPointIndex,
+        TargetRequest*              targetReq,
+        EndToEndCompileRequest*     endToEndReq,
+        RefPtr<DownstreamCompile>&  outCompile)
+    {
+        // Now let's go ahead and generate HLSL for the entry
+        // point, since we'll need that to feed into dxc.
+        auto hlslCode = emitHLSLForEntryPoint(
+            compileRequest,
+            entryPoint,
+            entryPointIndex,
+            targetReq,
+            endToEndReq);
+        maybeDumpIntermediate(compileRequest, hlslCode.getBuffer(), CodeGenTarget::HLSL);
+
+        return _createDXILCompile(
+            compileRequest,
+            targetReq,
+            hlslCode,
+            calcSourcePathForEntryPoint(endToEndReq, entryPointIndex),
+            getText(entryPoint->getName()),
+            getEffectiveProfile(entryPoint, targetReq),
+            outCompile);
+    }
 
-        // Verify compile result
-        if (SLANG_FAILED(resultCode))
+    Profile getDXILLibraryProfile(
+        const List<EntryPoint*>&    entryPoints,
+        TargetRequest*              targetReq)
+    {
+        // Libraries that can be validated (and so used at runtime) need
+        // shader model 6.3 or later.
+        Profile profile;
+        profile.setVersion(ProfileVersion::DX_6_3);
+        for (auto entryPoint : entryPoints)
         {
-            // Compilation failed.
-            // Try to read any diagnostic output.
-            ComPtr<IDxcBlobEncoding> dxcErrorBlob; 
-            SLANG_RETURN_ON_FAIL(dxcResult->GetErrorBuffer(dxcErrorBlob.writeRef()));
-
-            // Note: the error blob returned by dxc doesn't always seem
-            // to be nul-terminated, so we should be careful and turn it
-            // into a string for safety.
-            //
-
-            reportExternalCompileError("dxc", resultCode, _getSlice(dxcErrorBlob), compileRequest->getSink());
-            return resultCode;
+            auto entryPointProfile = getEffectiveProfile(entryPoint, targetReq);
+            if (entryPointProfile.getFamily() == ProfileFamily::DX && entryPointProfile.GetVersion() > profile.GetVersion())
+            {
+                profile.setVersion(entryPointProfile.GetVersion());
+            }
         }
+        profile.setStage(Stage::Unknown);
+        return profile;
+    }
 
-        // Okay, the compile supposedly succeeded, so we
-        // just need to grab the buffer with the output DXIL.
-        ComPtr<IDxcBlob> dxcResultBlob;
-        SLANG_RETURN_ON_FAIL(dxcResult->GetResult(dxcResultBlob.writeRef()));
-        
-        outCode.addRange(
-            (uint8_t const*)dxcResultBlob->GetBufferPointer(),
-            (int)           dxcResultBlob->GetBufferSize());
+    SlangResult emitDXILLibraryUsingDXC(
+        BackEndCompileRequest*      compileRequest,
+        const List<EntryPoint*>&    entryPoints,
+        TargetRequest*              targetReq,
+        ComPtr<ISlangBlob>&         outCode)
+    {
+        auto profile = getDXILLibraryProfile(entryPoints, targetReq);
 
-        return SLANG_OK;
+        // All of the entry points are emitted into one HLSL module, each
+        // marked with its stage, so that dxc compiles them in one invocation.
+        auto hlslCode = emitEntryPoints(
+            compileRequest,
+            entryPoints,
+            profile,
+            CodeGenTarget::HLSL,
+            targetReq);
+        maybeDumpIntermediate(compileRequest, hlslCode.getBuffer(), CodeGenTarget::HLSL);
+
+        RefPtr<DownstreamCompile> compile;
+        SLANG_RETURN_ON_FAIL(_createDXILCompile(
+            compileRequest,
+            targetReq,
+            hlslCode,
+            "slang-generated",
+            String(),
+            profile,
+            compile));
+        return runDownstreamCompile(compileRequest, compile, outCode);
     }
 
     SlangResult dissassembleDXILUsingDXC(
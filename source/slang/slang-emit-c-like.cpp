@@ -29,6 +29,9 @@
 
 namespace Slang {
 
+// With `SLANG_TARGET_FLAG_SHORT_NAMES`, identifiers longer than this are replaced
+static const Index kMaxUnshortenedNameLength = 16;
+
 // represents a declarator for use in emitting types
 struct CLikeSourceEmitter::EDeclarator
 {
@@ -135,6 +138,7 @@ CLikeSourceEmitter::CLikeSourceEmitter(const Desc& desc)
     
     m_programLayout = desc.programLayout;
     m_globalStructLayout = desc.globalStructLayout;
+    m_useShortNames = desc.useShortNames;
 }
 
 //
@@ -672,6 +676,14 @@ String CLikeSourceEmitter::getName(IRInst* inst)
     if(!m_mapInstToName.TryGetValue(inst, name))
     {
         name = generateName(inst);
+
+        // Long names (typically of specialized generics) are replaced with hashes, but
+        // not names of target intrinsics, which have to be emitted as they are.
+        if (m_useShortNames && name.getLength() > kMaxUnshortenedNameLength && !findTargetIntrinsicDecoration(inst))
+        {
+            name = m_compileRequest->getProgram()->getShortName(name);
+        }
+
         m_mapInstToName.Add(inst, name);
     }
     return name;
@@ -729,6 +741,104 @@ void CLikeSourceEmitter::emitSimpleValue(IRInst* inst)
 
 }
 
+    /// True if `inst` is a value that can't change while the function runs, and
+    /// costs nothing to refer to, such as a literal or a parameter of the function.
+static bool _isImmutableLeafValue(IRInst* inst)
+{
+    if (as<IRConstant>(inst))
+        return true;
+
+    // The parameters of the entry block are the parameters of the function.
+    // (The parameters of other blocks are phis, which are assigned to.)
+    if (auto param = as<IRParam>(inst))
+    {
+        auto block = as<IRBlock>(param->getParent());
+        auto func = block ? as<IRGlobalValueWithCode>(block->getParent()) : nullptr;
+        return func && func->getFirstBlock() == block;
+    }
+    return false;
+}
+
+    /// True if `inst` is cheap to recompute at every use, and always computes the same
+    /// value, such as a literal cast to another type, or a component of a parameter.
+static bool _isCheapImmutableExpr(IRInst* inst)
+{
+    switch (inst->op)
+    {
+    case kIROp_Construct:
+        if (inst->getOperandCount() != 1)
+            return false;
+        break;
+    case kIROp_swizzle:
+    case kIROp_FieldExtract:
+    case kIROp_getElement:
+    case kIROp_constructVectorFromScalar:
+        break;
+    default:
+        return false;
+    }
+
+    // The other operands of these are the indices or field key
+    if (!_isImmutableLeafValue(inst->getOperand(0)))
+        return false;
+    const UInt operandCount = inst->getOperandCount();
+    for (UInt i = 1; i < operandCount; ++i)
+    {
+        auto operand = inst->getOperand(i);
+        if (!as<IRConstant>(operand) && !as<IRStructKey>(operand))
+            return false;
+    }
+    return true;
+}
+
+bool CLikeSourceEmitter::_isFoldedExprMemoryDependent(IRInst* inst, IREmitMode mode)
+{
+    switch (inst->op)
+    {
+    case kIROp_Load:
+    case kIROp_Call:
+        return true;
+    default:
+        break;
+    }
+    if (inst->mightHaveSideEffects())
+        return true;
+
+    const UInt operandCount = inst->getOperandCount();
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        auto operand = inst->getOperand(i);
+        if (!as<IRBlock>(operand->getParent()))
+            continue;
+        if (shouldFoldInstIntoUseSites(operand, mode) && _isFoldedExprMemoryDependent(operand, mode))
+            return true;
+    }
+    return false;
+}
+
+bool CLikeSourceEmitter::_doesFoldedExprUseParamOf(IRInst* inst, IRBlock* block, UInt paramCount, IREmitMode mode)
+{
+    const UInt operandCount = inst->getOperandCount();
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        auto operand = inst->getOperand(i);
+        if (operand->getParent() == block && operand->op == kIROp_Param)
+        {
+            UInt paramIndex = 0;
+            for (auto param = block->getFirstParam(); param && param != operand; param = param->getNextParam())
+                paramIndex++;
+            if (paramIndex < paramCount)
+                return true;
+            continue;
+        }
+        if (!as<IRBlock>(operand->getParent()))
+            continue;
+        if (shouldFoldInstIntoUseSites(operand, mode) && _doesFoldedExprUseParamOf(operand, block, paramCount, mode))
+            return true;
+    }
+    return false;
+}
+
 bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst, IREmitMode mode)
 {
     // Certain opcodes should never/always be folded in
@@ -881,10 +991,6 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst, IREmitMode mod
     if(!inst->hasUses())
         return false;
 
-    // Don't fold something that has multiple users:
-    if(inst->hasMoreThanOneUse())
-        return false;
-
     // Don't fold something that might have side effects:
     if(inst->mightHaveSideEffects())
         return false;
@@ -897,6 +1003,20 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst, IREmitMode mod
     if(inst->findDecoration<IRPreciseDecoration>())
         return false;
 
+    // Values that cost nothing to recompute, and that can't change,
+    // are folded into every use (even across blocks), rather than
+    // being given a temporary. This covers literals cast to another
+    // type (which are often shared after CSE) and components of
+    // function parameters (e.g., `tid.x`). Values the user gave a
+    // name to keep it, to make the output easier to follow.
+    //
+    if(_isCheapImmutableExpr(inst) && !inst->findDecoration<IRNameHintDecoration>())
+        return true;
+
+    // Don't fold something that has multiple users:
+    if(inst->hasMoreThanOneUse())
+        return false;
+
     // Okay, at this point we know our instruction must have a single use.
     auto use = inst->firstUse;
     SLANG_ASSERT(use);
@@ -910,9 +1030,31 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst, IREmitMode mod
     if(inst->getParent() != user->getParent())
         return false;
 
+    // The arguments of a branch are assigned to the parameters of the
+    // target block one at a time, in order (see `emitPhiVarAssignments`),
+    // so an argument expression mustn't read any of the parameters
+    // before its own, as they have already been assigned new values.
+    //
+    if(auto branch = as<IRUnconditionalBranch>(user))
+    {
+        const UInt argIndex = UInt(use - branch->getArgs());
+        if(argIndex < branch->getArgCount() &&
+            _doesFoldedExprUseParamOf(inst, branch->getTargetBlock(), argIndex, mode))
+        {
+            return false;
+        }
+    }
+
     // Now let's look at all the instructions between this instruction
-    // and the user. If any of them might have side effects, then lets
-    // bail out now.
+    // and the user. If any of them might have side effects, and the
+    // expression we would fold reads memory (a load or a call, including
+    // any that would be folded into it), then lets bail out now.
+    //
+    // An expression that is purely a function of SSA values can't be
+    // changed by a side effect, so can be moved past one.
+    //
+    bool isMemoryDependent = false;
+    bool hasCheckedMemoryDependence = false;
     for(auto ii = inst->getNextInst(); ii != user; ii = ii->getNextInst())
     {
         if(!ii)
@@ -924,12 +1066,21 @@ bool CLikeSourceEmitter::shouldFoldInstIntoUseSites(IRInst* inst, IREmitMode mod
         }
 
         if(ii->mightHaveSideEffects())
-            return false;
+        {
+            if(!hasCheckedMemoryDependence)
+            {
+                isMemoryDependent = _isFoldedExprMemoryDependent(inst, mode);
+                hasCheckedMemoryDependence = true;
+            }
+            if(isMemoryDependent)
+                return false;
+        }
     }
 
     // Okay, if we reach this point then the user comes later in
     // the same block, and there are no instructions with side
-    // effects in between, so it seems safe to fold things in.
+    // effects in between that could change its value, so it seems
+    // safe to fold things in.
     return true;
 }
 
@@ -981,6 +1132,8 @@ void CLikeSourceEmitter::emitInstResultDecl(IRInst* inst)
     if (as<IRVoidType>(type))
         return;
 
+    m_temporaryCount++;
+
     emitTempModifiers(inst);
 
     emitRateQualifiers(inst);
@@ -2001,7 +2154,7 @@ void CLikeSourceEmitter::emitInst(IRInst* inst, IREmitMode mode)
     catch(AbortCompilationException&) { throw; }
     catch(...)
     {
-        noteInternalErrorLoc(inst->sourceLoc);
+        noteInternalErrorLoc(inst->getSourceLoc());
         throw;
     }
 }
@@ -2013,7 +2166,7 @@ void CLikeSourceEmitter::_emitInst(IRInst* inst, IREmitMode mode)
         return;
     }
 
-    m_writer->advanceToSourceLocation(inst->sourceLoc);
+    m_writer->advanceToSourceLocation(inst->getSourceLoc());
 
     switch(inst->op)
     {
@@ -2224,7 +2377,7 @@ void CLikeSourceEmitter::emitRegion(Region* inRegion)
                 // of terminators are simple enough that we just fold
                 // them into the current block.
                 //
-                m_writer->advanceToSourceLocation(terminator->sourceLoc);
+                m_writer->advanceToSourceLocation(terminator->getSourceLoc());
                 switch(terminator->op)
                 {
                 default:
@@ -2481,6 +2634,7 @@ void CLikeSourceEmitter::emitPhiVarDecls(IRFunc* func)
     {
         for (auto pp = bb->getFirstParam(); pp; pp = pp->getNextParam())
         {
+            m_temporaryCount++;
             emitTempModifiers(pp);
             emitType(pp->getFullType(), getName(pp));
             m_writer->emit(";\n");
@@ -3100,6 +3254,8 @@ void CLikeSourceEmitter::emitGlobalConstant(IRGlobalConstant* valDecl)
 {
     auto valType = valDecl->getDataType();
 
+    emitVarDecorationsImpl(valDecl);
+
     if( getSourceStyle() != SourceStyle::GLSL )
     {
         m_writer->emit("static ");
@@ -3126,7 +3282,7 @@ void CLikeSourceEmitter::emitGlobalConstant(IRGlobalConstant* valDecl)
 
 void CLikeSourceEmitter::emitGlobalInst(IRInst* inst)
 {
-    m_writer->advanceToSourceLocation(inst->sourceLoc);
+    m_writer->advanceToSourceLocation(inst->getSourceLoc());
 
     switch(inst->op)
     {
@@ -3276,7 +3432,7 @@ void CLikeSourceEmitter::executeEmitActions(List<EmitAction> const& actions)
     }
 }
 
-void CLikeSourceEmitter::emitModule(IRModule* module)
+void CLikeSourceEmitter::emitModuleImpl(IRModule* module)
 {
     // The IR will usually come in an order that respects
     // dependencies between global declarations, but this
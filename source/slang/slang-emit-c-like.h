@@ -42,6 +42,8 @@ public:
             // TODO: This will probably change if we represent imports
             // explicitly in the layout data.
         StructTypeLayout* globalStructLayout = nullptr;
+            // Replace long identifiers with short ones (see `SLANG_TARGET_FLAG_SHORT_NAMES`)
+        bool useShortNames = false;
     };
     
         /// To simplify cases 
@@ -127,6 +129,10 @@ public:
 
     GLSLExtensionTracker* getGLSLExtensionTracker() { return &m_glslExtensionTracker;  }
 
+        /// Get the number of temporaries declared for instruction results (and phis) that
+        /// weren't folded into the expressions that use them
+    Index getTemporaryCount() const { return m_temporaryCount; }
+
     //
     // Types
     //
@@ -194,6 +200,13 @@ public:
     
     bool shouldFoldInstIntoUseSites(IRInst* inst, IREmitMode mode);
 
+        /// True if the expression emitted for `inst` (including the operands folded into it) reads
+        /// memory, or might have side effects, so can't be moved past instructions with side effects
+    bool _isFoldedExprMemoryDependent(IRInst* inst, IREmitMode mode);
+        /// True if the expression emitted for `inst` (including the operands folded into it) uses
+        /// one of the first `paramCount` parameters of `block`
+    bool _doesFoldedExprUseParamOf(IRInst* inst, IRBlock* block, UInt paramCount, IREmitMode mode);
+
     void emitOperand(IRInst* inst, IREmitMode mode, EmitOpInfo const& outerPrec);
 
     void emitArgs(IRInst* inst, IREmitMode mode);
@@ -324,7 +337,7 @@ public:
     void computeEmitActions(IRModule* module, List<EmitAction>& ioActions);
 
     void executeEmitActions(List<EmitAction> const& actions);
-    void emitModule(IRModule* module);
+    void emitModule(IRModule* module) { emitModuleImpl(module); }
 
     void emitPreprocessorDirectives() { emitPreprocessorDirectivesImpl(); }
     void emitSimpleType(IRType* type);
@@ -361,6 +374,8 @@ public:
 
     virtual void handleCallExprDecorationsImpl(IRInst* funcValue) { SLANG_UNUSED(funcValue); }
 
+    virtual void emitModuleImpl(IRModule* module);
+
     virtual bool tryEmitGlobalParamImpl(IRGlobalParam* varDecl, IRType* varType) { SLANG_UNUSED(varDecl); SLANG_UNUSED(varType); return false; }
     virtual bool tryEmitInstExprImpl(IRInst* inst, IREmitMode mode, const EmitOpInfo& inOuterPrec) { SLANG_UNUSED(inst); SLANG_UNUSED(mode); SLANG_UNUSED(inOuterPrec); return false; }
 
@@ -400,9 +415,12 @@ public:
 
     ModuleDecl* m_program;
 
+    bool m_useShortNames = false;
+
     GLSLExtensionTracker m_glslExtensionTracker;
 
     UInt m_uniqueIDCounter = 1;
+    Index m_temporaryCount = 0;
     Dictionary<IRInst*, UInt> m_mapIRValueToID;
     Dictionary<Decl*, UInt> m_mapDeclToID;
 
@@ -114,7 +114,7 @@ void CPPSourceEmitter::_emitCFunc(BuiltInCOp cop, IRType* type)
 
     switch (cop)
     {
-        case BuiltInCOp::Init:  m_writer->emit("init");
+        case BuiltInCOp::Init:  m_writer->emit("init"); break;
         case BuiltInCOp::Splat: m_writer->emit("splat"); break;
     }
 }
@@ -128,9 +128,157 @@ void CPPSourceEmitter::emitParameterGroupImpl(IRGlobalParam* varDecl, IRUniformP
 
 void CPPSourceEmitter::emitEntryPointAttributesImpl(IRFunc* irFunc, EntryPointLayout* entryPointLayout)
 {
-    SLANG_UNUSED(irFunc);
-    SLANG_UNUSED(entryPointLayout);
-    SLANG_ASSERT(!"Not implemented");
+    // C++ has no attributes for entry points. Compute entry points are recorded
+    // so that a function to run a whole thread group can be emitted after the module.
+    if (entryPointLayout->profile.GetStage() == Stage::Compute)
+    {
+        m_computeEntryPoints.add(irFunc);
+    }
+}
+
+static Index _getComputeSystemValueElementCount(IRType* type)
+{
+    if (auto vecType = as<IRVectorType>(type))
+    {
+        return Index(GetIntVal(vecType->getElementCount()));
+    }
+    return 1;
+}
+
+    /// True if the system value `semanticName` of type `type` can be produced by a compute group function
+static bool _canEmitComputeSystemValue(const String& semanticName, IRType* type)
+{
+    const Index elementCount = _getComputeSystemValueElementCount(type);
+    const String name = semanticName.toLower();
+    if (name == "sv_groupindex")
+    {
+        return elementCount == 1;
+    }
+    return (name == "sv_dispatchthreadid" || name == "sv_groupthreadid" || name == "sv_groupid") && elementCount <= 3;
+}
+
+void CPPSourceEmitter::_emitComputeSystemValue(const String& semanticName, IRType* type, const UInt groupSize[3])
+{
+    static const char* const kAxisNames[] = { "x", "y", "z" };
+
+    const String name = semanticName.toLower();
+    if (name == "sv_groupindex")
+    {
+        m_writer->emit("(threadID_z * ");
+        m_writer->emit(groupSize[0] * groupSize[1]);
+        m_writer->emit(" + threadID_y * ");
+        m_writer->emit(groupSize[0]);
+        m_writer->emit(" + threadID_x)");
+        return;
+    }
+
+    // The value is made one axis at a time. A vector takes as many axes as it has elements.
+    const Index elementCount = _getComputeSystemValueElementCount(type);
+    if (elementCount > 1)
+    {
+        _emitCFunc(BuiltInCOp::Init, type);
+        m_writer->emit("(");
+    }
+    for (Index ii = 0; ii < elementCount; ++ii)
+    {
+        if (ii > 0)
+        {
+            m_writer->emit(", ");
+        }
+        const char* axis = kAxisNames[ii];
+        if (name == "sv_dispatchthreadid")
+        {
+            m_writer->emit("groupID_");
+            m_writer->emit(axis);
+            m_writer->emit(" * ");
+            m_writer->emit(groupSize[ii]);
+            m_writer->emit(" + threadID_");
+            m_writer->emit(axis);
+        }
+        else
+        {
+            m_writer->emit(name == "sv_groupid" ? "groupID_" : "threadID_");
+            m_writer->emit(axis);
+        }
+    }
+    if (elementCount > 1)
+    {
+        m_writer->emit(")");
+    }
+}
+
+static VarLayout* _getParamVarLayout(IRParam* param)
+{
+    auto layoutDecoration = param->findDecoration<IRLayoutDecoration>();
+    return layoutDecoration ? as<VarLayout>(layoutDecoration->getLayout()) : nullptr;
+}
+
+void CPPSourceEmitter::_emitComputeGroupFunc(IRFunc* func, EntryPointLayout* entryPointLayout)
+{
+    // A group function can only be made if every parameter is one of the thread or group IDs
+    for (auto param = func->getFirstParam(); param; param = param->getNextParam())
+    {
+        auto varLayout = _getParamVarLayout(param);
+        if (!varLayout || !_canEmitComputeSystemValue(varLayout->systemValueSemantic, param->getDataType()))
+        {
+            return;
+        }
+    }
+
+    UInt groupSize[3];
+    spReflectionEntryPoint_getComputeThreadGroupSize((SlangReflectionEntryPoint*)entryPointLayout, 3, &groupSize[0]);
+
+    // The invocations of the group are run in order with x varying fastest, which
+    // keeps neighboring invocations together in the innermost loop where a C++
+    // compiler can vectorize across them once the entry point is inlined.
+    const String name = getFuncName(func);
+
+    m_writer->emit("void ");
+    m_writer->emit(name);
+    m_writer->emit("_Group(uint32_t groupID_x, uint32_t groupID_y, uint32_t groupID_z)\n{\n");
+    m_writer->indent();
+
+    static const char* const kAxisNames[] = { "x", "y", "z" };
+    for (int ii = 2; ii >= 0; --ii)
+    {
+        const char* axis = kAxisNames[ii];
+        m_writer->emit("for (uint32_t threadID_");
+        m_writer->emit(axis);
+        m_writer->emit(" = 0; threadID_");
+        m_writer->emit(axis);
+        m_writer->emit(" < ");
+        m_writer->emit(groupSize[ii]);
+        m_writer->emit("; ++threadID_");
+        m_writer->emit(axis);
+        m_writer->emit(")\n");
+    }
+    m_writer->emit("{\n");
+    m_writer->indent();
+
+    m_writer->emit(name);
+    m_writer->emit("(");
+    for (auto param = func->getFirstParam(); param; param = param->getNextParam())
+    {
+        if (param != func->getFirstParam())
+        {
+            m_writer->emit(", ");
+        }
+        _emitComputeSystemValue(_getParamVarLayout(param)->systemValueSemantic, param->getDataType(), groupSize);
+    }
+    m_writer->emit(");\n");
+
+    m_writer->dedent();
+    m_writer->emit("}\n");
+
+    m_writer->dedent();
+    m_writer->emit("}\n\n");
+}
+
+void CPPSourceEmitter::emitPreprocessorDirectivesImpl()
+{
+    // The vector and matrix types are defined in a prelude header that is the same for all
+    // generated code, so that it can be built once as a precompiled header.
+    m_writer->emit("#include \"slang-cpp-types.h\"\n\n");
 }
 
 void CPPSourceEmitter::emitVectorTypeNameImpl(IRType* elementType, IRIntegerValue elementCount)
@@ -201,6 +349,12 @@ bool CPPSourceEmitter::tryEmitInstExprImpl(IRInst* inst, IREmitMode mode, const
         case kIROp_Construct:
         case kIROp_makeVector:
         case kIROp_MakeMatrix:
+            // Scalars are constructed with a C++ functional cast, as on other targets
+            if (!as<IRVectorType>(inst->getDataType()) && !as<IRMatrixType>(inst->getDataType()))
+            {
+                return false;
+            }
+
             // Simple constructor call
             if (inst->getOperandCount() == 1)
             {
@@ -213,9 +367,26 @@ bool CPPSourceEmitter::tryEmitInstExprImpl(IRInst* inst, IREmitMode mode, const
                 emitArgs(inst, mode);
             }
             return true;
+        case kIROp_constructVectorFromScalar:
+            _emitCFunc(BuiltInCOp::Splat, inst->getDataType());
+            emitArgs(inst, mode);
+            return true;
         default:
             return false;
     }
 }
 
+void CPPSourceEmitter::emitModuleImpl(IRModule* module)
+{
+    Super::emitModuleImpl(module);
+
+    for (auto func : m_computeEntryPoints)
+    {
+        if (auto entryPointLayout = asEntryPoint(func))
+        {
+            _emitComputeGroupFunc(func, entryPointLayout);
+        }
+    }
+}
+
 } // namespace Slang
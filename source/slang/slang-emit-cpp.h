@@ -28,12 +28,22 @@ protected:
     void _emitCMatType(IROp op, IRIntegerValue rowCount, IRIntegerValue colCount);
     void _emitCFunc(BuiltInCOp cop, IRType* type);
 
+        /// Emit a function that runs every invocation of one thread group of the compute entry point `func`
+    void _emitComputeGroupFunc(IRFunc* func, EntryPointLayout* entryPointLayout);
+        /// Emit the value of the system value `semanticName` for the current invocation in a group function, as type `type`.
+        /// The value must be one that `_canEmitComputeSystemValue` accepts.
+    void _emitComputeSystemValue(const String& semanticName, IRType* type, const UInt groupSize[3]);
+
     virtual void emitParameterGroupImpl(IRGlobalParam* varDecl, IRUniformParameterGroupType* type) SLANG_OVERRIDE;
     virtual void emitEntryPointAttributesImpl(IRFunc* irFunc, EntryPointLayout* entryPointLayout) SLANG_OVERRIDE;
     virtual void emitSimpleTypeImpl(IRType* type) SLANG_OVERRIDE;
+    virtual void emitPreprocessorDirectivesImpl() SLANG_OVERRIDE;
     virtual void emitVectorTypeNameImpl(IRType* elementType, IRIntegerValue elementCount) SLANG_OVERRIDE;
 
     virtual bool tryEmitInstExprImpl(IRInst* inst, IREmitMode mode, const EmitOpInfo& inOuterPrec) SLANG_OVERRIDE;
+    virtual void emitModuleImpl(IRModule* module) SLANG_OVERRIDE;
+
+    List<IRFunc*> m_computeEntryPoints;     ///< Compute entry points emitted so far, which need group functions
 };
 
 }
@@ -1534,6 +1534,13 @@ void GLSLSourceEmitter::emitVarDecorationsImpl(IRInst* varDecl)
     {
         m_writer->emit("coherent\n");
     }
+
+    if (auto specConstantDecoration = varDecl->findDecoration<IRSpecializationConstantDecoration>())
+    {
+        m_writer->emit("layout(constant_id = ");
+        m_writer->emit(specConstantDecoration->getID());
+        m_writer->emit(")\n");
+    }
 }
 
 void GLSLSourceEmitter::emitMatrixLayoutModifiersImpl(VarLayout* layout)
@@ -16,6 +16,133 @@
 
 namespace Slang {
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! SourceTextBuffer !!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void SourceTextBuffer::_finishChunk()
+{
+    if (m_chunk.getLength() > 0)
+    {
+        m_segments.add(m_chunk);
+        // The segment now holds the chunk's storage, so start a new one
+        m_chunk.Clear();
+    }
+}
+
+void SourceTextBuffer::append(const char* text, Index length)
+{
+    if (length <= 0)
+    {
+        return;
+    }
+
+    if (m_chunk.getLength() + length > kChunkSize)
+    {
+        _finishChunk();
+
+        // Text that won't fit in a chunk is a segment of its own
+        if (length >= kChunkSize)
+        {
+            m_segments.add(String(text, text + length));
+            return;
+        }
+    }
+
+    if (m_chunk.getLength() == 0)
+    {
+        m_chunk.EnsureCapacity(kChunkSize);
+    }
+    m_chunk.Append(text, UInt(length));
+}
+
+void SourceTextBuffer::appendSegment(const String& text)
+{
+    if (text.getLength() > 0)
+    {
+        _finishChunk();
+        m_segments.add(text);
+    }
+}
+
+void SourceTextBuffer::appendBuffer(SourceTextBuffer& buffer)
+{
+    buffer._finishChunk();
+    if (buffer.m_segments.getCount() == 0)
+    {
+        return;
+    }
+
+    _finishChunk();
+    m_segments.addRange(buffer.m_segments);
+    buffer.m_segments.clear();
+}
+
+Index SourceTextBuffer::getLength() const
+{
+    Index length = m_chunk.getLength();
+    for (const auto& segment : m_segments)
+    {
+        length += segment.getLength();
+    }
+    return length;
+}
+
+static Index _countNewLines(const UnownedStringSlice& slice)
+{
+    Index count = 0;
+    for (const char c : slice)
+    {
+        count += Index(c == '\n');
+    }
+    return count;
+}
+
+Index SourceTextBuffer::countNewLines() const
+{
+    Index count = _countNewLines(m_chunk.getUnownedSlice());
+    for (const auto& segment : m_segments)
+    {
+        count += _countNewLines(segment.getUnownedSlice());
+    }
+    return count;
+}
+
+String SourceTextBuffer::produceString()
+{
+    _finishChunk();
+
+    switch (m_segments.getCount())
+    {
+        case 0:     return String();
+        case 1:     return m_segments[0];
+        default:    break;
+    }
+
+    StringBuilder builder(UInt(getLength() + 1));
+    for (const auto& segment : m_segments)
+    {
+        builder.Append(segment);
+    }
+
+    // Hold the result as the only segment, so producing it again doesn't copy
+    m_segments.clear();
+    m_segments.add(builder);
+    return builder.ProduceString();
+}
+
+void SourceTextBuffer::clear()
+{
+    m_segments.clear();
+    m_chunk.Clear();
+}
+
+void SourceTextBuffer::swapWith(SourceTextBuffer& rhs)
+{
+    m_segments.swapWith(rhs.m_segments);
+    Swap(m_chunk, rhs.m_chunk);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!! SourceWriter !!!!!!!!!!!!!!!!!!!!!!!!!! */
+
 SourceWriter::SourceWriter(SourceManager* sourceManager, LineDirectiveMode lineDirectiveMode)
 {
     m_lineDirectiveMode = lineDirectiveMode;
@@ -29,11 +156,37 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::takeContent(SourceTextBuffer& outBuffer)
+{
+    outBuffer.clear();
+    outBuffer.swapWith(m_buffer);
+
+    m_outputLine = 1;
+    m_outputColumn = 1;
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
-    m_builder.Append(textBegin, len);
+    m_buffer.append(textBegin, Index(len));
+
+    // The output position is only needed for the source map
+    if (m_lineDirectiveMode == LineDirectiveMode::SourceMap)
+    {
+        for (const char* cur = textBegin; cur < textEnd; ++cur)
+        {
+            if (*cur == '\n')
+            {
+                m_outputLine++;
+                m_outputColumn = 1;
+            }
+            else
+            {
+                m_outputColumn++;
+            }
+        }
+    }
 }
 
 void SourceWriter::emitRawText(char const* text)
@@ -147,13 +300,13 @@ void SourceWriter::emit(const UnownedStringSlice& text)
 
 void SourceWriter::emit(Name* name)
 {
-    emit(getText(name));
+    emit(getUnownedStringSliceText(name));
 }
 
 void SourceWriter::emit(const NameLoc& nameAndLoc)
 {
     advanceToSourceLocation(nameAndLoc.loc);
-    emit(getText(nameAndLoc.name));
+    emit(getUnownedStringSliceText(nameAndLoc.name));
 }
 
 void SourceWriter::emitName(Name* name, const SourceLoc& locIn)
@@ -274,6 +427,10 @@ void SourceWriter::_emitLineDirectiveIfNeeded(const HumaneSourceLoc& sourceLocat
         case LineDirectiveMode::None:
             return;
 
+        case LineDirectiveMode::SourceMap:
+            _addSourceMapEntryIfNeeded(sourceLocation);
+            return;
+
         case LineDirectiveMode::Default:
         default:
             break;
@@ -314,6 +471,33 @@ void SourceWriter::_emitLineDirectiveIfNeeded(const HumaneSourceLoc& sourceLocat
     }
 }
 
+void SourceWriter::_addSourceMapEntryIfNeeded(const HumaneSourceLoc& sourceLocation)
+{
+    // Ignore invalid source locations
+    if (sourceLocation.line <= 0)
+        return;
+
+    // As for `#line` directives, following lines are taken to come from the following
+    // source lines, so an entry is only needed when the tracked location is wrong.
+    // Unlike a directive no text is output, so small gaps aren't filled with newlines.
+    if (sourceLocation.pathInfo.foundPath == m_loc.pathInfo.foundPath
+        && sourceLocation.line == m_loc.line
+        && sourceLocation.column >= m_loc.column)
+    {
+        return;
+    }
+
+    SourceMap::Entry entry;
+    entry.generatedLine = m_outputLine;
+    entry.generatedColumn = m_outputColumn;
+    entry.fileIndex = m_sourceMap.addFile(sourceLocation.pathInfo.foundPath);
+    entry.line = uint32_t(sourceLocation.line);
+    entry.column = uint32_t(sourceLocation.column);
+    m_sourceMap.addEntry(entry);
+
+    m_loc = sourceLocation;
+}
+
 void SourceWriter::_emitLineDirective(const HumaneSourceLoc& sourceLocation)
 {
     emitRawText("\n#line ");
@@ -3,17 +3,57 @@
 #define SLANG_EMIT_SOURCE_WRITER_H
 
 #include "../core/slang-basic.h"
+#include "../core/slang-source-map.h"
 
 #include "slang-compiler.h"
 
 namespace Slang
 {
 
+    /// An append-only text buffer that holds its text as a list of segments.
+    ///
+    /// Text is written into fixed size chunks, so appending never reallocates or moves text
+    /// that has already been written. Buffers can be spliced together by moving their segments,
+    /// without copying any text. The text is only made contiguous once, by `produceString`.
+class SourceTextBuffer
+{
+public:
+        /// Append `length` chars starting at `text`
+    void append(const char* text, Index length);
+        /// Append `text` as a segment of its own, sharing the string's storage
+    void appendSegment(const String& text);
+        /// Move the segments of `buffer` onto the end of this buffer. `buffer` is left empty.
+    void appendBuffer(SourceTextBuffer& buffer);
+
+        /// Get the total length of the text
+    Index getLength() const;
+        /// Get the number of newlines in the text
+    Index countNewLines() const;
+        /// Get the text as a single string.
+        /// If the text is held in a single segment, that segment is returned without copying.
+    String produceString();
+
+        /// Remove all the text
+    void clear();
+        /// Swap contents with `rhs`
+    void swapWith(SourceTextBuffer& rhs);
+
+protected:
+    void _finishChunk();
+
+        /// Size of the chunks that text is appended into
+    static const Index kChunkSize = 64 * 1024;
+
+    List<String> m_segments;        ///< Completed segments, in order
+    StringBuilder m_chunk;          ///< The chunk being appended to, which follows the segments
+};
+
 /* Class that encapsulates a stream of source. Facilities provided...
 
 * Management of the buffer that holds the source content as it is constructed
 * output line directives
   + Supports GLSL as well as C/CPP/HLSL style directives
+  + Or, in LineDirectiveMode::SourceMap, recording the source locations in a source map rather than the output
 * Support for line indention */
 class SourceWriter
 {
@@ -51,9 +91,12 @@ public:
     void advanceToSourceLocation(const HumaneSourceLoc& sourceLocation);
 
         /// Get the content as a string
-    String getContent() { return m_builder.ProduceString(); }
+    String getContent() { return m_buffer.produceString(); }
         /// Clear the content
-    void clearContent() { m_builder.Clear(); }
+    void clearContent() { m_buffer.clear(); }
+        /// Move the content into `outBuffer` (replacing what it held) without copying, and clear the content.
+        /// Positions recorded in the source map after this are relative to the start of the new content.
+    void takeContent(SourceTextBuffer& outBuffer);
         /// Get the content as a string and clear the internal representation
     String getContentAndClear();
 
@@ -62,6 +105,10 @@ public:
         /// Get the source manager user
     SourceManager* getSourceManager() const { return m_sourceManager; }
 
+        /// Get the source map, which is only added to in LineDirectiveMode::SourceMap.
+        /// Generated positions are relative to the content at the time they were recorded.
+    SourceMap& getSourceMap() { return m_sourceMap; }
+
         /// Ctor
     SourceWriter(SourceManager* sourceManager, LineDirectiveMode lineDirectiveMode);
 
@@ -76,16 +123,17 @@ protected:
 
     void _emitLineDirectiveIfNeeded(const HumaneSourceLoc& sourceLocation);
 
+        // Add an entry to the source map for sourceLocation at the current output position,
+        // if the location differs from the one being tracked
+    void _addSourceMapEntryIfNeeded(const HumaneSourceLoc& sourceLocation);
+
         // Emit a `#line` directive to the output.
         // Doesn't update state of source-location tracking.
     void _emitLineDirective(const HumaneSourceLoc& sourceLocation);
 
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
-    StringBuilder m_builder;
+    // The code we've built so far. It is held in chunks, and only sewn together into
+    // one buffer when the content is requested.
+    SourceTextBuffer m_buffer;
 
     // Current source position for tracking purposes...
     HumaneSourceLoc m_loc;
@@ -109,6 +157,12 @@ protected:
     int m_glslSourceIDCount = 0;
 
     LineDirectiveMode m_lineDirectiveMode;
+
+    // For LineDirectiveMode::SourceMap, the map being built and the (1 based)
+    // position in the output that text is being written to
+    SourceMap m_sourceMap;
+    uint32_t m_outputLine = 1;
+    uint32_t m_outputColumn = 1;
 };
 
 }
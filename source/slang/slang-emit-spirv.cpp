@@ -0,0 +1,2863 @@
+// slang-emit-spirv.cpp
+#include "slang-emit-spirv.h"
+
+#include "slang-emit.h"
+#include "slang-emit-glsl-extension-tracker.h"
+#include "slang-ir-insts.h"
+#include "slang-mangled-lexer.h"
+#include "slang-type-layout.h"
+
+/*
+The SPIR-V emitter works from the IR that `linkAndOptimizeIR` produces for the GLSL target, so
+the IR has already been legalized the way the GLSL emitter expects: entry point parameters have
+been turned into global parameters for the GLSL built-ins, and resources are global parameters
+of the buffer types.
+
+It covers the subset of that IR that compute shaders commonly use:
+
+* scalars and vectors of `bool`, 32 and 64 bit integers, `float` and `double`, along with arrays
+  and structs of them
+* structured buffers, constant buffers, `groupshared` and `static` variables, and the compute
+  built-ins
+* arithmetic, comparisons, conversions, swizzles, calls, and the intrinsics that map onto core
+  SPIR-V instructions or the GLSL.std.450 extended instruction set
+* structured control flow: `if`, loops, and `switch` without fall-through
+
+Anything else (matrices, textures, other stages, control flow that doesn't map onto SPIR-V
+structured control flow, ...) makes the emitter give up, so that the caller can go through GLSL
+instead.
+*/
+
+namespace Slang {
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! SPIRVCapabilityTracker !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void SPIRVCapabilityTracker::requireCapability(uint32_t capability)
+{
+    if (m_capabilitySet.Contains(capability))
+        return;
+    m_capabilitySet.Add(capability);
+    m_capabilities.add(capability);
+}
+
+void SPIRVCapabilityTracker::requireExtension(const String& name)
+{
+    if (m_extensionSet.Contains(name))
+        return;
+    m_extensionSet.Add(name);
+    m_extensions.add(name);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! SPIR-V enumerations !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+// The subset of the SPIR-V and GLSL.std.450 enumerations that the emitter uses. The names match
+// the ones in the Khronos `spirv.h` and `GLSL.std.450.h` headers.
+
+static const uint32_t SpvMagicNumber = 0x07230203;
+static const uint32_t SpvVersion = 0x00010000;
+
+enum SpvOp : uint32_t
+{
+    SpvOpUndef = 1,
+    SpvOpName = 5,
+    SpvOpMemberName = 6,
+    SpvOpExtension = 10,
+    SpvOpExtInstImport = 11,
+    SpvOpExtInst = 12,
+    SpvOpMemoryModel = 14,
+    SpvOpEntryPoint = 15,
+    SpvOpExecutionMode = 16,
+    SpvOpCapability = 17,
+    SpvOpTypeVoid = 19,
+    SpvOpTypeBool = 20,
+    SpvOpTypeInt = 21,
+    SpvOpTypeFloat = 22,
+    SpvOpTypeVector = 23,
+    SpvOpTypeArray = 28,
+    SpvOpTypeRuntimeArray = 29,
+    SpvOpTypeStruct = 30,
+    SpvOpTypePointer = 32,
+    SpvOpTypeFunction = 33,
+    SpvOpConstantTrue = 41,
+    SpvOpConstantFalse = 42,
+    SpvOpConstant = 43,
+    SpvOpConstantComposite = 44,
+    SpvOpConstantNull = 46,
+    SpvOpSpecConstantTrue = 48,
+    SpvOpSpecConstantFalse = 49,
+    SpvOpSpecConstant = 50,
+    SpvOpFunction = 54,
+    SpvOpFunctionParameter = 55,
+    SpvOpFunctionEnd = 56,
+    SpvOpFunctionCall = 57,
+    SpvOpVariable = 59,
+    SpvOpLoad = 61,
+    SpvOpStore = 62,
+    SpvOpAccessChain = 65,
+    SpvOpDecorate = 71,
+    SpvOpMemberDecorate = 72,
+    SpvOpVectorExtractDynamic = 77,
+    SpvOpVectorShuffle = 79,
+    SpvOpCompositeConstruct = 80,
+    SpvOpCompositeExtract = 81,
+    SpvOpCompositeInsert = 82,
+    SpvOpCopyObject = 83,
+    SpvOpConvertFToU = 109,
+    SpvOpConvertFToS = 110,
+    SpvOpConvertSToF = 111,
+    SpvOpConvertUToF = 112,
+    SpvOpUConvert = 113,
+    SpvOpSConvert = 114,
+    SpvOpFConvert = 115,
+    SpvOpBitcast = 124,
+    SpvOpSNegate = 126,
+    SpvOpFNegate = 127,
+    SpvOpIAdd = 128,
+    SpvOpFAdd = 129,
+    SpvOpISub = 130,
+    SpvOpFSub = 131,
+    SpvOpIMul = 132,
+    SpvOpFMul = 133,
+    SpvOpUDiv = 134,
+    SpvOpSDiv = 135,
+    SpvOpFDiv = 136,
+    SpvOpUMod = 137,
+    SpvOpSRem = 138,
+    SpvOpFRem = 140,
+    SpvOpDot = 148,
+    SpvOpAny = 154,
+    SpvOpAll = 155,
+    SpvOpIsNan = 156,
+    SpvOpIsInf = 157,
+    SpvOpLogicalEqual = 164,
+    SpvOpLogicalNotEqual = 165,
+    SpvOpLogicalOr = 166,
+    SpvOpLogicalAnd = 167,
+    SpvOpLogicalNot = 168,
+    SpvOpSelect = 169,
+    SpvOpIEqual = 170,
+    SpvOpINotEqual = 171,
+    SpvOpUGreaterThan = 172,
+    SpvOpSGreaterThan = 173,
+    SpvOpUGreaterThanEqual = 174,
+    SpvOpSGreaterThanEqual = 175,
+    SpvOpULessThan = 176,
+    SpvOpSLessThan = 177,
+    SpvOpULessThanEqual = 178,
+    SpvOpSLessThanEqual = 179,
+    SpvOpFOrdEqual = 180,
+    SpvOpFUnordNotEqual = 183,
+    SpvOpFOrdLessThan = 184,
+    SpvOpFOrdGreaterThan = 186,
+    SpvOpFOrdLessThanEqual = 188,
+    SpvOpFOrdGreaterThanEqual = 190,
+    SpvOpShiftRightLogical = 194,
+    SpvOpShiftRightArithmetic = 195,
+    SpvOpShiftLeftLogical = 196,
+    SpvOpBitwiseOr = 197,
+    SpvOpBitwiseXor = 198,
+    SpvOpBitwiseAnd = 199,
+    SpvOpNot = 200,
+    SpvOpBitReverse = 204,
+    SpvOpBitCount = 205,
+    SpvOpControlBarrier = 224,
+    SpvOpMemoryBarrier = 225,
+    SpvOpPhi = 245,
+    SpvOpLoopMerge = 246,
+    SpvOpSelectionMerge = 247,
+    SpvOpLabel = 248,
+    SpvOpBranch = 249,
+    SpvOpBranchConditional = 250,
+    SpvOpSwitch = 251,
+    SpvOpReturn = 253,
+    SpvOpReturnValue = 254,
+    SpvOpUnreachable = 255,
+};
+
+enum SpvCapability : uint32_t
+{
+    SpvCapabilityShader = 1,
+    SpvCapabilityFloat64 = 10,
+    SpvCapabilityInt64 = 11,
+};
+
+enum SpvStorageClass : uint32_t
+{
+    SpvStorageClassInput = 1,
+    SpvStorageClassUniform = 2,
+    SpvStorageClassWorkgroup = 4,
+    SpvStorageClassPrivate = 6,
+    SpvStorageClassFunction = 7,
+};
+
+enum SpvDecoration : uint32_t
+{
+    SpvDecorationSpecId = 1,
+    SpvDecorationBlock = 2,
+    SpvDecorationBufferBlock = 3,
+    SpvDecorationArrayStride = 6,
+    SpvDecorationBuiltIn = 11,
+    SpvDecorationNonWritable = 24,
+    SpvDecorationBinding = 33,
+    SpvDecorationDescriptorSet = 34,
+    SpvDecorationOffset = 35,
+};
+
+enum SpvBuiltIn : uint32_t
+{
+    SpvBuiltInNumWorkgroups = 24,
+    SpvBuiltInWorkgroupId = 26,
+    SpvBuiltInLocalInvocationId = 27,
+    SpvBuiltInGlobalInvocationId = 28,
+    SpvBuiltInLocalInvocationIndex = 29,
+};
+
+static const uint32_t SpvAddressingModelLogical = 0;
+static const uint32_t SpvMemoryModelGLSL450 = 1;
+static const uint32_t SpvExecutionModelGLCompute = 5;
+static const uint32_t SpvExecutionModeLocalSize = 17;
+static const uint32_t SpvLoopControlUnrollMask = 0x1;
+
+static const uint32_t SpvScopeDevice = 1;
+static const uint32_t SpvScopeWorkgroup = 2;
+
+static const uint32_t SpvMemorySemanticsAcquireReleaseMask = 0x8;
+static const uint32_t SpvMemorySemanticsUniformMemoryMask = 0x40;
+static const uint32_t SpvMemorySemanticsWorkgroupMemoryMask = 0x100;
+static const uint32_t SpvMemorySemanticsImageMemoryMask = 0x800;
+
+enum GLSLstd450 : uint32_t
+{
+    GLSLstd450Bad = 0,
+    GLSLstd450Round = 1,
+    GLSLstd450Trunc = 3,
+    GLSLstd450FAbs = 4,
+    GLSLstd450SAbs = 5,
+    GLSLstd450FSign = 6,
+    GLSLstd450SSign = 7,
+    GLSLstd450Floor = 8,
+    GLSLstd450Ceil = 9,
+    GLSLstd450Fract = 10,
+    GLSLstd450Radians = 11,
+    GLSLstd450Degrees = 12,
+    GLSLstd450Sin = 13,
+    GLSLstd450Cos = 14,
+    GLSLstd450Tan = 15,
+    GLSLstd450Asin = 16,
+    GLSLstd450Acos = 17,
+    GLSLstd450Atan = 18,
+    GLSLstd450Sinh = 19,
+    GLSLstd450Cosh = 20,
+    GLSLstd450Tanh = 21,
+    GLSLstd450Atan2 = 25,
+    GLSLstd450Pow = 26,
+    GLSLstd450Exp = 27,
+    GLSLstd450Log = 28,
+    GLSLstd450Exp2 = 29,
+    GLSLstd450Log2 = 30,
+    GLSLstd450Sqrt = 31,
+    GLSLstd450InverseSqrt = 32,
+    GLSLstd450FMin = 37,
+    GLSLstd450UMin = 38,
+    GLSLstd450SMin = 39,
+    GLSLstd450FMax = 40,
+    GLSLstd450UMax = 41,
+    GLSLstd450SMax = 42,
+    GLSLstd450FClamp = 43,
+    GLSLstd450UClamp = 44,
+    GLSLstd450SClamp = 45,
+    GLSLstd450FMix = 46,
+    GLSLstd450Step = 48,
+    GLSLstd450SmoothStep = 49,
+    GLSLstd450Fma = 50,
+    GLSLstd450Length = 66,
+    GLSLstd450Distance = 67,
+    GLSLstd450Cross = 68,
+    GLSLstd450Normalize = 69,
+    GLSLstd450Reflect = 71,
+};
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Intrinsic tables !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+namespace { // anonymous
+
+// Intrinsics that map onto a GLSL.std.450 extended instruction, picked by the element type of
+// the operands. Both the HLSL names (found through the mangled name of a declaration without a
+// GLSL definition) and the GLSL names (from `__target_intrinsic(glsl, ...)`) are listed.
+struct ExtInstIntrinsic
+{
+    char const* name;
+    GLSLstd450 floatInst;
+    GLSLstd450 intInst;
+    GLSLstd450 uintInst;
+    bool isScalarResult;        ///< True if the result is a scalar even for vector operands
+};
+
+static const ExtInstIntrinsic kExtInstIntrinsics[] =
+{
+    { "abs",            GLSLstd450FAbs,         GLSLstd450SAbs,     GLSLstd450Bad,      false },
+    { "sign",           GLSLstd450FSign,        GLSLstd450SSign,    GLSLstd450Bad,      false },
+    { "floor",          GLSLstd450Floor,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "ceil",           GLSLstd450Ceil,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "trunc",          GLSLstd450Trunc,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "round",          GLSLstd450Round,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "frac",           GLSLstd450Fract,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "fract",          GLSLstd450Fract,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "radians",        GLSLstd450Radians,      GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "degrees",        GLSLstd450Degrees,      GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "sin",            GLSLstd450Sin,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "cos",            GLSLstd450Cos,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "tan",            GLSLstd450Tan,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "asin",           GLSLstd450Asin,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "acos",           GLSLstd450Acos,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "atan",           GLSLstd450Atan,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "atan2",          GLSLstd450Atan2,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "sinh",           GLSLstd450Sinh,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "cosh",           GLSLstd450Cosh,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "tanh",           GLSLstd450Tanh,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "pow",            GLSLstd450Pow,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "exp",            GLSLstd450Exp,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "exp2",           GLSLstd450Exp2,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "log",            GLSLstd450Log,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "log2",           GLSLstd450Log2,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "sqrt",           GLSLstd450Sqrt,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "rsqrt",          GLSLstd450InverseSqrt,  GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "inversesqrt",    GLSLstd450InverseSqrt,  GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "min",            GLSLstd450FMin,         GLSLstd450SMin,     GLSLstd450UMin,     false },
+    { "max",            GLSLstd450FMax,         GLSLstd450SMax,     GLSLstd450UMax,     false },
+    { "clamp",          GLSLstd450FClamp,       GLSLstd450SClamp,   GLSLstd450UClamp,   false },
+    { "lerp",           GLSLstd450FMix,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "mix",            GLSLstd450FMix,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "step",           GLSLstd450Step,         GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "smoothstep",     GLSLstd450SmoothStep,   GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "fma",            GLSLstd450Fma,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "mad",            GLSLstd450Fma,          GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "length",         GLSLstd450Length,       GLSLstd450Bad,      GLSLstd450Bad,      true },
+    { "distance",       GLSLstd450Distance,     GLSLstd450Bad,      GLSLstd450Bad,      true },
+    { "cross",          GLSLstd450Cross,        GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "normalize",      GLSLstd450Normalize,    GLSLstd450Bad,      GLSLstd450Bad,      false },
+    { "reflect",        GLSLstd450Reflect,      GLSLstd450Bad,      GLSLstd450Bad,      false },
+};
+
+// Barrier intrinsics, identified by their GLSL definition
+struct BarrierIntrinsic
+{
+    char const* definition;
+    bool isControlBarrier;      ///< True if the invocations of the work group are synchronized
+    uint32_t memoryScope;
+    uint32_t memorySemantics;
+};
+
+static const BarrierIntrinsic kBarrierIntrinsics[] =
+{
+    { "groupMemoryBarrier", false, SpvScopeWorkgroup,
+        SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsWorkgroupMemoryMask },
+    { "groupMemoryBarrier(), barrier()", true, SpvScopeWorkgroup,
+        SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsWorkgroupMemoryMask },
+    { "memoryBarrier(), memoryBarrierImage(), memoryBarrierBuffer()", false, SpvScopeDevice,
+        SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsUniformMemoryMask | SpvMemorySemanticsImageMemoryMask },
+    { "memoryBarrier(), memoryBarrierImage(), memoryBarrierBuffer(), barrier()", true, SpvScopeDevice,
+        SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsUniformMemoryMask | SpvMemorySemanticsImageMemoryMask },
+    { "memoryBarrier(), groupMemoryBarrier(), memoryBarrierImage(), memoryBarrierBuffer()", false, SpvScopeDevice,
+        SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsUniformMemoryMask | SpvMemorySemanticsWorkgroupMemoryMask | SpvMemorySemanticsImageMemoryMask },
+    { "memoryBarrier(), groupMemoryBarrier(), memoryBarrierImage(), memoryBarrierBuffer(), barrier()", true, SpvScopeDevice,
+        SpvMemorySemanticsAcquireReleaseMask | SpvMemorySemanticsUniformMemoryMask | SpvMemorySemanticsWorkgroupMemoryMask | SpvMemorySemanticsImageMemoryMask },
+};
+
+// The GLSL built-in variables that legalization produces for compute shaders
+struct BuiltInVariable
+{
+    char const* name;
+    SpvBuiltIn builtIn;
+};
+
+static const BuiltInVariable kBuiltInVariables[] =
+{
+    { "gl_NumWorkGroups",           SpvBuiltInNumWorkgroups },
+    { "gl_WorkGroupID",             SpvBuiltInWorkgroupId },
+    { "gl_LocalInvocationID",       SpvBuiltInLocalInvocationId },
+    { "gl_GlobalInvocationID",      SpvBuiltInGlobalInvocationId },
+    { "gl_LocalInvocationIndex",    SpvBuiltInLocalInvocationIndex },
+};
+
+static uint32_t _alignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static bool _isLiteral(IRInst* inst)
+{
+    switch (inst->op)
+    {
+        case kIROp_IntLit:
+        case kIROp_FloatLit:
+        case kIROp_BoolLit:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Parse an intrinsic definition that just calls a GLSL function with the arguments in order,
+// that is either `name` or `name($0, $1, ...)`.
+static bool _parseSimpleIntrinsicCall(const UnownedStringSlice& definition, Index argCount, UnownedStringSlice& outName)
+{
+    const char* cursor = definition.begin();
+    const char* end = definition.end();
+
+    const char* nameBegin = cursor;
+    while (cursor != end && ((*cursor >= 'a' && *cursor <= 'z') || (*cursor >= 'A' && *cursor <= 'Z') || (*cursor >= '0' && *cursor <= '9') || *cursor == '_'))
+        cursor++;
+    if (cursor == nameBegin)
+        return false;
+    outName = UnownedStringSlice(nameBegin, cursor);
+
+    if (cursor == end)
+        return true;
+    if (*cursor++ != '(')
+        return false;
+
+    Index argIndex = 0;
+    for (;;)
+    {
+        while (cursor != end && *cursor == ' ')
+            cursor++;
+        if (cursor == end)
+            return false;
+        if (*cursor == ')')
+            break;
+        if (argIndex != 0)
+        {
+            if (*cursor++ != ',')
+                return false;
+            while (cursor != end && *cursor == ' ')
+                cursor++;
+        }
+        if (end - cursor < 2 || cursor[0] != '$' || cursor[1] != char('0' + argIndex))
+            return false;
+        cursor += 2;
+        argIndex++;
+    }
+    return cursor + 1 == end && argIndex == argCount;
+}
+
+} // anonymous
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! SPIRVEmitter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+typedef uint32_t SpvId;
+
+class SPIRVEmitter
+{
+public:
+        /// Emit the SPIR-V module for `entryPoint`, which must be in `module`.
+        /// Returns SLANG_E_NOT_IMPLEMENTED if something the emitter doesn't support is used.
+    SlangResult emitModule(IRModule* module, IRFunc* entryPoint, List<uint8_t>& spirvOut);
+
+protected:
+    enum class ScalarKind
+    {
+        None,
+        Bool,
+        Int,
+        UInt,
+        Float,
+    };
+
+        /// A scalar or vector type
+    struct NumericType
+    {
+        bool operator==(const NumericType& rhs) const { return kind == rhs.kind && width == rhs.width && count == rhs.count; }
+        bool operator!=(const NumericType& rhs) const { return !(*this == rhs); }
+
+        NumericType getScalarType() const { NumericType type = *this; type.count = 1; return type; }
+        NumericType getWithCount(Index inCount) const { NumericType type = *this; type.count = inCount; return type; }
+
+        ScalarKind kind = ScalarKind::None;
+        uint32_t width = 32;        ///< Width in bits
+        Index count = 1;            ///< 1 for a scalar, otherwise the vector element count
+    };
+
+    enum class LayoutRule
+    {
+        Std140,
+        Std430,
+    };
+
+    struct LayoutInfo
+    {
+        uint32_t size = 0;
+        uint32_t alignment = 1;
+    };
+
+        /// A block that passes values to the parameters of a block that is branched to
+    struct PhiSource
+    {
+        SpvId label;                        ///< The label of the SPIR-V block the branch is in
+        IRUnconditionalBranch* branch;      ///< The branch, or nullptr if it is the synthesized continue block of a loop
+    };
+
+    struct LoopInfo
+    {
+        IRLoop* loopInst = nullptr;
+        SpvId bodyLabel = 0;                ///< Label of the part of the header block after the loop merge
+        SpvId continueLabel = 0;
+            /// True if the loop's continue block is its header. SPIR-V needs a separate continue target,
+            /// so a block is synthesized that all the back edges are redirected to.
+        bool hasSyntheticContinue = false;
+        List<SpvId> continueParamIds;       ///< Phis in the synthesized continue block for the header parameters
+        List<PhiSource> continueSources;    ///< The back edges to the synthesized continue block
+    };
+
+    // Emitting instructions
+    SpvId _allocId() { return m_nextId++; }
+    static void _emitInst(List<uint32_t>& out, SpvOp op, const uint32_t* operands, Index operandCount);
+    static void _emitInst(List<uint32_t>& out, SpvOp op) { _emitInst(out, op, nullptr, 0); }
+    static void _emitInst(List<uint32_t>& out, SpvOp op, uint32_t a) { _emitInst(out, op, &a, 1); }
+    static void _emitInst(List<uint32_t>& out, SpvOp op, uint32_t a, uint32_t b) { uint32_t operands[] = { a, b }; _emitInst(out, op, operands, 2); }
+    static void _emitInst(List<uint32_t>& out, SpvOp op, uint32_t a, uint32_t b, uint32_t c) { uint32_t operands[] = { a, b, c }; _emitInst(out, op, operands, 3); }
+    static void _emitInst(List<uint32_t>& out, SpvOp op, uint32_t a, uint32_t b, uint32_t c, uint32_t d) { uint32_t operands[] = { a, b, c, d }; _emitInst(out, op, operands, 4); }
+    static void _appendString(List<uint32_t>& out, const UnownedStringSlice& str);
+
+        /// Emit an instruction with a result into the body of the current function
+    SpvId _emitOp(SpvOp op, SpvId typeId, const uint32_t* operands, Index operandCount);
+    SpvId _emitOp(SpvOp op, SpvId typeId, uint32_t a) { return _emitOp(op, typeId, &a, 1); }
+    SpvId _emitOp(SpvOp op, SpvId typeId, uint32_t a, uint32_t b) { uint32_t operands[] = { a, b }; return _emitOp(op, typeId, operands, 2); }
+    SpvId _emitOp(SpvOp op, SpvId typeId, uint32_t a, uint32_t b, uint32_t c) { uint32_t operands[] = { a, b, c }; return _emitOp(op, typeId, operands, 3); }
+    SpvId _emitExtInst(SpvId typeId, GLSLstd450 inst, const List<SpvId>& args);
+
+        /// Get the id of a type or constant declared at global scope, declaring it if it hasn't been already.
+        /// `typeId` is 0 for a type.
+    SpvId _getGlobalInstId(SpvOp op, SpvId typeId, const uint32_t* operands, Index operandCount);
+
+    void _emitName(SpvId id, IRInst* inst);
+
+        /// Mark that `inst` can't be emitted. Returns an id that can stand in for its value.
+    SpvId _unsupported(IRInst* inst);
+
+    // Types
+    bool _getNumericType(IRType* type, NumericType& outType);
+    SpvId _getScalarTypeId(ScalarKind kind, uint32_t width);
+    SpvId _getNumericTypeId(const NumericType& type);
+    SpvId _getBoolTypeId(Index count);
+    SpvId _getPointerTypeId(SpvId valueTypeId, SpvStorageClass storageClass);
+    SpvId _getTypeId(IRType* type);
+    Index _getFieldIndex(IRStructType* structType, IRInst* key);
+
+    // Explicit layout of buffer contents
+    bool _getLayout(IRType* type, LayoutRule rule, LayoutInfo& outInfo);
+    bool _getStructLayout(IRStructType* structType, LayoutRule rule, List<uint32_t>& outOffsets, LayoutInfo& outInfo);
+    bool _claimLayout(SpvId typeId, LayoutRule rule, bool& outNeedsDecorations);
+
+    // Constants
+    SpvId _getIntConstantId(const NumericType& type, IRIntegerValue value);
+    SpvId _getFloatConstantId(const NumericType& type, IRFloatingPointValue value);
+    SpvId _getConstantId(const NumericType& type, IRInst* literal);
+    SpvId _getSplatConstantId(const NumericType& type, SpvId scalarId);
+    SpvId _getUIntConstantId(uint32_t value);
+
+    // Global values
+    SpvId _getValueId(IRInst* inst);
+    SpvId _getGlobalParamVarId(IRGlobalParam* param);
+    SpvId _getGlobalVarId(IRGlobalVar* var);
+    SpvId _getSpecConstantId(IRGlobalConstant* constant);
+    SpvId _getStructuredBufferVarId(IRGlobalParam* param, IRHLSLStructuredBufferTypeBase* bufferType);
+    SpvId _getConstantBufferVarId(IRGlobalParam* param, IRConstantBufferType* bufferType);
+    bool _emitBindingDecorations(SpvId varId, IRInst* param);
+    SpvId _getGLSLstd450Id();
+    SpvStorageClass _getStorageClass(SpvId pointerId);
+
+    // Values in functions
+    SpvId _getOperandAs(IRInst* operand, const NumericType& type);
+    bool _getCommonOperandType(IRInst* const* operands, Index operandCount, NumericType& outType);
+    SpvId _emitConversion(SpvId valueId, const NumericType& fromType, const NumericType& toType);
+    SpvId _emitSplat(SpvId scalarId, const NumericType& type);
+    SpvId _emitArithmetic(IRInst* inst);
+    SpvId _emitComparison(IRInst* inst);
+    SpvId _emitLogical(IRInst* inst);
+    SpvId _emitConstruct(IRInst* inst);
+    SpvId _emitCall(IRCall* inst);
+    SpvId _emitIntrinsicCall(IRCall* inst, const UnownedStringSlice& definition);
+    SpvId _emitNamedIntrinsicCall(IRCall* inst, const UnownedStringSlice& name, const List<IRInst*>& args);
+    SpvId _emitBarrier(const BarrierIntrinsic& barrier);
+    SpvId _emitInstValue(IRInst* inst);
+    void _emitOrdinaryInst(IRInst* inst);
+
+    // Functions and control flow
+    void _emitFunc(IRFunc* func);
+    void _prepareBlocks(IRFunc* func);
+    void _getSuccessors(IRBlock* block, List<IRBlock*>& outSuccessors);
+    SpvId _getBranchTargetLabel(IRBlock* target, IRInst* branch);
+    bool _isLoopExitEdge(IRBlock* block, IRBlock* target);
+    SpvId _getLabel(IRBlock* block) { return m_blockLabels[block].GetValue(); }
+    void _addPhiSource(IRBlock* target, const PhiSource& source);
+    void _emitPhis(IRBlock* block);
+    void _emitBlock(IRBlock* block);
+    void _emitTerminator(IRBlock* block, IRTerminatorInst* terminator);
+    void _emitConditionalBranch(IRBlock* block, IRConditionalBranch* branch);
+    void _emitSwitch(IRBlock* block, IRSwitch* switchInst);
+    void _emitSyntheticContinueBlock(IRBlock* header, LoopInfo& loopInfo);
+
+    SpvId m_nextId = 1;
+    bool m_failed = false;
+
+    SPIRVCapabilityTracker m_capabilityTracker;
+
+    // The sections of the module, in the order they are written
+    List<uint32_t> m_extInstImports;
+    List<uint32_t> m_debugNames;
+    List<uint32_t> m_annotations;
+    List<uint32_t> m_globals;           ///< Types, constants and global variables
+    List<uint32_t> m_functions;
+
+    Dictionary<String, SpvId> m_globalInstIds;
+    Dictionary<IRType*, SpvId> m_typeIds;
+    Dictionary<IRInst*, SpvId> m_valueIds;
+    Dictionary<IRInst*, SpvId> m_globalVarIds;
+    Dictionary<SpvId, SpvStorageClass> m_storageClasses;
+    Dictionary<SpvId, LayoutRule> m_layoutRules;
+    Dictionary<IRStructType*, SpvId> m_constantBufferBlockTypeIds;
+    List<SpvId> m_interfaceIds;
+    SpvId m_glslstd450Id = 0;
+
+    // State for the function being emitted
+    List<uint32_t> m_funcVars;          ///< The variables, which have to be at the start of the first block
+    List<uint32_t> m_funcBody;
+    IRBlock* m_firstBlock = nullptr;
+    List<IRBlock*> m_blockOrder;
+    Dictionary<IRBlock*, SpvId> m_blockLabels;
+    Dictionary<IRBlock*, SpvId> m_blockExitLabels;  ///< Label of the SPIR-V block that ends an IR block
+    Dictionary<IRBlock*, LoopInfo> m_loops;         ///< Keyed by loop header
+    Dictionary<IRBlock*, IRBlock*> m_innermostLoops;
+    Dictionary<IRBlock*, List<PhiSource>> m_phiSources;
+    HashSet<IRBlock*> m_mergeBlocks;
+};
+
+/* static */void SPIRVEmitter::_emitInst(List<uint32_t>& out, SpvOp op, const uint32_t* operands, Index operandCount)
+{
+    out.add(uint32_t(operandCount + 1) << 16 | uint32_t(op));
+    out.addRange(operands, operandCount);
+}
+
+/* static */void SPIRVEmitter::_appendString(List<uint32_t>& out, const UnownedStringSlice& str)
+{
+    // Strings are nul terminated, and padded with nuls to a whole number of words
+    const Index length = str.size();
+    for (Index i = 0; i <= length; i += 4)
+    {
+        uint32_t word = 0;
+        for (Index j = 0; j < 4 && i + j < length; ++j)
+        {
+            word |= uint32_t(uint8_t(str.begin()[i + j])) << (j * 8);
+        }
+        out.add(word);
+    }
+}
+
+SpvId SPIRVEmitter::_emitOp(SpvOp op, SpvId typeId, const uint32_t* operands, Index operandCount)
+{
+    SpvId id = _allocId();
+    m_funcBody.add(uint32_t(operandCount + 3) << 16 | uint32_t(op));
+    m_funcBody.add(typeId);
+    m_funcBody.add(id);
+    m_funcBody.addRange(operands, operandCount);
+    return id;
+}
+
+SpvId SPIRVEmitter::_emitExtInst(SpvId typeId, GLSLstd450 inst, const List<SpvId>& args)
+{
+    List<uint32_t> operands;
+    operands.add(_getGLSLstd450Id());
+    operands.add(inst);
+    operands.addRange(args);
+    return _emitOp(SpvOpExtInst, typeId, operands.getBuffer(), operands.getCount());
+}
+
+SpvId SPIRVEmitter::_getGlobalInstId(SpvOp op, SpvId typeId, const uint32_t* operands, Index operandCount)
+{
+    StringBuilder key;
+    key << uint32_t(op) << ":" << typeId;
+    for (Index i = 0; i < operandCount; ++i)
+    {
+        key << ":" << operands[i];
+    }
+
+    SpvId id;
+    if (m_globalInstIds.TryGetValue(key, id))
+        return id;
+
+    id = _allocId();
+    m_globalInstIds.Add(key, id);
+
+    List<uint32_t> allOperands;
+    if (typeId)
+        allOperands.add(typeId);
+    allOperands.add(id);
+    allOperands.addRange(operands, operandCount);
+    _emitInst(m_globals, op, allOperands.getBuffer(), allOperands.getCount());
+    return id;
+}
+
+void SPIRVEmitter::_emitName(SpvId id, IRInst* inst)
+{
+    if (auto nameHint = inst->findDecoration<IRNameHintDecoration>())
+    {
+        List<uint32_t> operands;
+        operands.add(id);
+        _appendString(operands, nameHint->getName());
+        _emitInst(m_debugNames, SpvOpName, operands.getBuffer(), operands.getCount());
+    }
+}
+
+SpvId SPIRVEmitter::_unsupported(IRInst* inst)
+{
+    SLANG_UNUSED(inst);
+    m_failed = true;
+    return _allocId();
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Types !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+bool SPIRVEmitter::_getNumericType(IRType* type, NumericType& outType)
+{
+    Index count = 1;
+    if (auto vectorType = as<IRVectorType>(type))
+    {
+        auto countLit = as<IRIntLit>(vectorType->getElementCount());
+        if (!countLit || countLit->getValue() < 2 || countLit->getValue() > 4)
+            return false;
+        count = Index(countLit->getValue());
+        type = vectorType->getElementType();
+    }
+
+    auto basicType = as<IRBasicType>(type);
+    if (!basicType)
+        return false;
+
+    switch (basicType->getBaseType())
+    {
+        case BaseType::Bool:    outType.kind = ScalarKind::Bool;    outType.width = 32; break;
+        case BaseType::Int:     outType.kind = ScalarKind::Int;     outType.width = 32; break;
+        case BaseType::UInt:    outType.kind = ScalarKind::UInt;    outType.width = 32; break;
+        case BaseType::Int64:   outType.kind = ScalarKind::Int;     outType.width = 64; break;
+        case BaseType::UInt64:  outType.kind = ScalarKind::UInt;    outType.width = 64; break;
+        case BaseType::Float:   outType.kind = ScalarKind::Float;   outType.width = 32; break;
+        case BaseType::Double:  outType.kind = ScalarKind::Float;   outType.width = 64; break;
+        default:                return false;
+    }
+    outType.count = count;
+    return true;
+}
+
+SpvId SPIRVEmitter::_getScalarTypeId(ScalarKind kind, uint32_t width)
+{
+    switch (kind)
+    {
+        case ScalarKind::Bool:
+        {
+            return _getGlobalInstId(SpvOpTypeBool, 0, nullptr, 0);
+        }
+        case ScalarKind::Int:
+        case ScalarKind::UInt:
+        {
+            if (width == 64)
+                m_capabilityTracker.requireCapability(SpvCapabilityInt64);
+            uint32_t operands[] = { width, kind == ScalarKind::Int ? 1u : 0u };
+            return _getGlobalInstId(SpvOpTypeInt, 0, operands, 2);
+        }
+        case ScalarKind::Float:
+        {
+            if (width == 64)
+                m_capabilityTracker.requireCapability(SpvCapabilityFloat64);
+            return _getGlobalInstId(SpvOpTypeFloat, 0, &width, 1);
+        }
+        default:
+            break;
+    }
+    return _unsupported(nullptr);
+}
+
+SpvId SPIRVEmitter::_getNumericTypeId(const NumericType& type)
+{
+    SpvId scalarTypeId = _getScalarTypeId(type.kind, type.width);
+    if (type.count == 1)
+        return scalarTypeId;
+
+    uint32_t operands[] = { scalarTypeId, uint32_t(type.count) };
+    return _getGlobalInstId(SpvOpTypeVector, 0, operands, 2);
+}
+
+SpvId SPIRVEmitter::_getBoolTypeId(Index count)
+{
+    NumericType type;
+    type.kind = ScalarKind::Bool;
+    type.count = count;
+    return _getNumericTypeId(type);
+}
+
+SpvId SPIRVEmitter::_getPointerTypeId(SpvId valueTypeId, SpvStorageClass storageClass)
+{
+    uint32_t operands[] = { storageClass, valueTypeId };
+    return _getGlobalInstId(SpvOpTypePointer, 0, operands, 2);
+}
+
+SpvId SPIRVEmitter::_getTypeId(IRType* type)
+{
+    SpvId id;
+    if (m_typeIds.TryGetValue(type, id))
+        return id;
+
+    NumericType numericType;
+    if (as<IRVoidType>(type))
+    {
+        id = _getGlobalInstId(SpvOpTypeVoid, 0, nullptr, 0);
+    }
+    else if (_getNumericType(type, numericType))
+    {
+        id = _getNumericTypeId(numericType);
+    }
+    else if (auto rateQualifiedType = as<IRRateQualifiedType>(type))
+    {
+        id = _getTypeId(rateQualifiedType->getValueType());
+    }
+    else if (auto ptrType = as<IRPtrTypeBase>(type))
+    {
+        // Pointers that are values in functions (parameters and local variables) are always
+        // to function storage; the types of pointers to other storage are made where they are needed.
+        id = _getPointerTypeId(_getTypeId(ptrType->getValueType()), SpvStorageClassFunction);
+    }
+    else if (auto arrayType = as<IRArrayType>(type))
+    {
+        auto countLit = as<IRIntLit>(arrayType->getElementCount());
+        if (!countLit || countLit->getValue() <= 0)
+            return _unsupported(type);
+
+        SpvId elementTypeId = _getTypeId(arrayType->getElementType());
+        SpvId lengthId = _getUIntConstantId(uint32_t(countLit->getValue()));
+
+        uint32_t operands[] = { elementTypeId, lengthId };
+        id = _getGlobalInstId(SpvOpTypeArray, 0, operands, 2);
+    }
+    else if (auto structType = as<IRStructType>(type))
+    {
+        List<uint32_t> operands;
+        for (auto field : structType->getFields())
+        {
+            operands.add(_getTypeId(field->getFieldType()));
+        }
+        id = _allocId();
+        operands.insert(0, id);
+        _emitInst(m_globals, SpvOpTypeStruct, operands.getBuffer(), operands.getCount());
+
+        _emitName(id, structType);
+        uint32_t memberIndex = 0;
+        for (auto field : structType->getFields())
+        {
+            if (auto nameHint = field->getKey()->findDecoration<IRNameHintDecoration>())
+            {
+                List<uint32_t> nameOperands;
+                nameOperands.add(id);
+                nameOperands.add(memberIndex);
+                _appendString(nameOperands, nameHint->getName());
+                _emitInst(m_debugNames, SpvOpMemberName, nameOperands.getBuffer(), nameOperands.getCount());
+            }
+            memberIndex++;
+        }
+    }
+    else if (auto funcType = as<IRFuncType>(type))
+    {
+        List<uint32_t> operands;
+        operands.add(_getTypeId(funcType->getResultType()));
+        for (UInt i = 0; i < funcType->getParamCount(); ++i)
+        {
+            operands.add(_getTypeId(funcType->getParamType(i)));
+        }
+        id = _getGlobalInstId(SpvOpTypeFunction, 0, operands.getBuffer(), operands.getCount());
+    }
+    else
+    {
+        return _unsupported(type);
+    }
+
+    m_typeIds.Add(type, id);
+    return id;
+}
+
+Index SPIRVEmitter::_getFieldIndex(IRStructType* structType, IRInst* key)
+{
+    Index index = 0;
+    for (auto field : structType->getFields())
+    {
+        if (field->getKey() == key)
+            return index;
+        index++;
+    }
+    return -1;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Buffer layout !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+bool SPIRVEmitter::_claimLayout(SpvId typeId, LayoutRule rule, bool& outNeedsDecorations)
+{
+    // The layout is given by decorations on the type, so a type can only be laid out by one rule
+    if (auto existingRule = m_layoutRules.TryGetValue(typeId))
+    {
+        outNeedsDecorations = false;
+        return *existingRule == rule;
+    }
+    m_layoutRules.Add(typeId, rule);
+    outNeedsDecorations = true;
+    return true;
+}
+
+bool SPIRVEmitter::_getStructLayout(IRStructType* structType, LayoutRule rule, List<uint32_t>& outOffsets, LayoutInfo& outInfo)
+{
+    uint32_t offset = 0;
+    uint32_t alignment = (rule == LayoutRule::Std140) ? 16 : 1;
+    for (auto field : structType->getFields())
+    {
+        LayoutInfo fieldInfo;
+        if (!_getLayout(field->getFieldType(), rule, fieldInfo))
+            return false;
+
+        offset = _alignUp(offset, fieldInfo.alignment);
+        outOffsets.add(offset);
+        offset += fieldInfo.size;
+        alignment = Math::Max(alignment, fieldInfo.alignment);
+    }
+    outInfo.alignment = alignment;
+    outInfo.size = _alignUp(offset, alignment);
+    return true;
+}
+
+bool SPIRVEmitter::_getLayout(IRType* type, LayoutRule rule, LayoutInfo& outInfo)
+{
+    NumericType numericType;
+    if (_getNumericType(type, numericType))
+    {
+        // There is no defined layout for `bool` in buffers
+        if (numericType.kind == ScalarKind::Bool)
+            return false;
+
+        const uint32_t scalarSize = numericType.width / 8;
+        outInfo.size = scalarSize * uint32_t(numericType.count);
+        outInfo.alignment = scalarSize * (numericType.count == 1 ? 1 : (numericType.count == 2 ? 2 : 4));
+        return true;
+    }
+    else if (auto arrayType = as<IRArrayType>(type))
+    {
+        auto countLit = as<IRIntLit>(arrayType->getElementCount());
+        if (!countLit)
+            return false;
+
+        LayoutInfo elementInfo;
+        if (!_getLayout(arrayType->getElementType(), rule, elementInfo))
+            return false;
+
+        uint32_t alignment = elementInfo.alignment;
+        if (rule == LayoutRule::Std140)
+            alignment = _alignUp(alignment, 16);
+        const uint32_t stride = _alignUp(elementInfo.size, alignment);
+
+        SpvId typeId = _getTypeId(type);
+        bool needsDecorations;
+        if (!_claimLayout(typeId, rule, needsDecorations))
+            return false;
+        if (needsDecorations)
+            _emitInst(m_annotations, SpvOpDecorate, typeId, SpvDecorationArrayStride, stride);
+
+        outInfo.alignment = alignment;
+        outInfo.size = stride * uint32_t(countLit->getValue());
+        return true;
+    }
+    else if (auto structType = as<IRStructType>(type))
+    {
+        List<uint32_t> offsets;
+        if (!_getStructLayout(structType, rule, offsets, outInfo))
+            return false;
+
+        SpvId typeId = _getTypeId(type);
+        bool needsDecorations;
+        if (!_claimLayout(typeId, rule, needsDecorations))
+            return false;
+        if (needsDecorations)
+        {
+            for (Index i = 0; i < offsets.getCount(); ++i)
+                _emitInst(m_annotations, SpvOpMemberDecorate, typeId, uint32_t(i), SpvDecorationOffset, offsets[i]);
+        }
+        return true;
+    }
+    return false;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Constants !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SpvId SPIRVEmitter::_getSplatConstantId(const NumericType& type, SpvId scalarId)
+{
+    if (type.count == 1)
+        return scalarId;
+
+    List<uint32_t> operands;
+    for (Index i = 0; i < type.count; ++i)
+        operands.add(scalarId);
+    return _getGlobalInstId(SpvOpConstantComposite, _getNumericTypeId(type), operands.getBuffer(), operands.getCount());
+}
+
+SpvId SPIRVEmitter::_getIntConstantId(const NumericType& type, IRIntegerValue value)
+{
+    const NumericType scalarType = type.getScalarType();
+    SpvId scalarId;
+    switch (type.kind)
+    {
+        case ScalarKind::Bool:
+        {
+            scalarId = _getGlobalInstId(value ? SpvOpConstantTrue : SpvOpConstantFalse, _getNumericTypeId(scalarType), nullptr, 0);
+            break;
+        }
+        case ScalarKind::Float:
+        {
+            return _getFloatConstantId(type, IRFloatingPointValue(value));
+        }
+        case ScalarKind::Int:
+        case ScalarKind::UInt:
+        {
+            // Wide literals are given low order word first
+            uint32_t words[] = { uint32_t(uint64_t(value)), uint32_t(uint64_t(value) >> 32) };
+            scalarId = _getGlobalInstId(SpvOpConstant, _getNumericTypeId(scalarType), words, scalarType.width / 32);
+            break;
+        }
+        default:
+            return _unsupported(nullptr);
+    }
+    return _getSplatConstantId(type, scalarId);
+}
+
+SpvId SPIRVEmitter::_getFloatConstantId(const NumericType& type, IRFloatingPointValue value)
+{
+    if (type.kind != ScalarKind::Float)
+    {
+        return _getIntConstantId(type, (type.kind == ScalarKind::Bool) ? IRIntegerValue(value != 0.0) : IRIntegerValue(value));
+    }
+
+    const NumericType scalarType = type.getScalarType();
+    uint32_t words[2];
+    if (scalarType.width == 64)
+    {
+        uint64_t bits;
+        ::memcpy(&bits, &value, sizeof(bits));
+        words[0] = uint32_t(bits);
+        words[1] = uint32_t(bits >> 32);
+    }
+    else
+    {
+        float floatValue = float(value);
+        ::memcpy(&words[0], &floatValue, sizeof(words[0]));
+    }
+    SpvId scalarId = _getGlobalInstId(SpvOpConstant, _getNumericTypeId(scalarType), words, scalarType.width / 32);
+    return _getSplatConstantId(type, scalarId);
+}
+
+SpvId SPIRVEmitter::_getConstantId(const NumericType& type, IRInst* literal)
+{
+    auto constant = static_cast<IRConstant*>(literal);
+    if (literal->op == kIROp_FloatLit)
+        return _getFloatConstantId(type, constant->value.floatVal);
+    return _getIntConstantId(type, constant->value.intVal);
+}
+
+SpvId SPIRVEmitter::_getUIntConstantId(uint32_t value)
+{
+    NumericType type;
+    type.kind = ScalarKind::UInt;
+    return _getIntConstantId(type, value);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Global values !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SpvId SPIRVEmitter::_getGLSLstd450Id()
+{
+    if (!m_glslstd450Id)
+    {
+        m_glslstd450Id = _allocId();
+        List<uint32_t> operands;
+        operands.add(m_glslstd450Id);
+        _appendString(operands, UnownedStringSlice::fromLiteral("GLSL.std.450"));
+        _emitInst(m_extInstImports, SpvOpExtInstImport, operands.getBuffer(), operands.getCount());
+    }
+    return m_glslstd450Id;
+}
+
+SpvStorageClass SPIRVEmitter::_getStorageClass(SpvId pointerId)
+{
+    if (auto storageClass = m_storageClasses.TryGetValue(pointerId))
+        return *storageClass;
+    return SpvStorageClassFunction;
+}
+
+SpvId SPIRVEmitter::_getValueId(IRInst* inst)
+{
+    SpvId id;
+    if (m_valueIds.TryGetValue(inst, id))
+        return id;
+
+    if (_isLiteral(inst))
+    {
+        NumericType type;
+        if (!_getNumericType(inst->getDataType(), type))
+            return _unsupported(inst);
+        return _getConstantId(type, inst);
+    }
+
+    switch (inst->op)
+    {
+        case kIROp_GlobalParam:
+        {
+            SpvId varId = _getGlobalParamVarId(static_cast<IRGlobalParam*>(inst));
+            if (m_failed)
+                return varId;
+
+            // Built-in inputs are values in the IR, so they are loaded where they are used
+            if (_getStorageClass(varId) == SpvStorageClassInput && !as<IRPtrTypeBase>(inst->getDataType()))
+                return _emitOp(SpvOpLoad, _getTypeId(inst->getDataType()), varId);
+            return varId;
+        }
+        case kIROp_GlobalVar:
+        {
+            return _getGlobalVarId(static_cast<IRGlobalVar*>(inst));
+        }
+        case kIROp_GlobalConstant:
+        {
+            return _getSpecConstantId(static_cast<IRGlobalConstant*>(inst));
+        }
+        case kIROp_undefined:
+        {
+            return _emitOp(SpvOpUndef, _getTypeId(inst->getDataType()), nullptr, 0);
+        }
+        case kIROp_Func:
+        {
+            break;
+        }
+        default:
+        {
+            // Only values in functions can be referenced before they are emitted (by phis)
+            if (!as<IRBlock>(inst->getParent()))
+                return _unsupported(inst);
+            break;
+        }
+    }
+
+    // Allocate the id, the value will be given it when it is emitted
+    id = _allocId();
+    m_valueIds.Add(inst, id);
+    return id;
+}
+
+bool SPIRVEmitter::_emitBindingDecorations(SpvId varId, IRInst* param)
+{
+    auto layoutDecoration = param->findDecoration<IRLayoutDecoration>();
+    auto varLayout = layoutDecoration ? as<VarLayout>(layoutDecoration->getLayout()) : nullptr;
+    if (!varLayout)
+        return false;
+
+    // The binding of a parameter group is the sum of the offsets of the variable and the container,
+    // as with the GLSL emitter
+    List<VarLayout*> chain;
+    chain.add(varLayout);
+    if (auto groupTypeLayout = as<ParameterGroupTypeLayout>(varLayout->getTypeLayout()))
+    {
+        if (groupTypeLayout->containerVarLayout)
+            chain.add(groupTypeLayout->containerVarLayout);
+    }
+
+    bool hasBinding = false;
+    UInt binding = 0;
+    UInt set = 0;
+    for (auto layout : chain)
+    {
+        if (auto resInfo = layout->FindResourceInfo(LayoutResourceKind::DescriptorTableSlot))
+        {
+            hasBinding = true;
+            binding += resInfo->index;
+            set += resInfo->space;
+        }
+        if (auto resInfo = layout->FindResourceInfo(LayoutResourceKind::RegisterSpace))
+        {
+            set += resInfo->index;
+        }
+    }
+    if (!hasBinding)
+        return false;
+
+    _emitInst(m_annotations, SpvOpDecorate, varId, SpvDecorationDescriptorSet, uint32_t(set));
+    _emitInst(m_annotations, SpvOpDecorate, varId, SpvDecorationBinding, uint32_t(binding));
+    return true;
+}
+
+SpvId SPIRVEmitter::_getGlobalParamVarId(IRGlobalParam* param)
+{
+    SpvId varId;
+    if (m_globalVarIds.TryGetValue(param, varId))
+        return varId;
+
+    IRType* type = param->getDataType();
+    if (auto importDecoration = param->findDecoration<IRImportDecoration>())
+    {
+        // A GLSL built-in variable
+        const BuiltInVariable* builtInVariable = nullptr;
+        for (const auto& variable : kBuiltInVariables)
+        {
+            if (importDecoration->getMangledName() == variable.name)
+                builtInVariable = &variable;
+        }
+        if (!builtInVariable)
+            return _unsupported(param);
+
+        IRType* valueType = type;
+        if (auto ptrType = as<IRPtrTypeBase>(type))
+            valueType = ptrType->getValueType();
+
+        varId = _allocId();
+        _emitInst(m_globals, SpvOpVariable, _getPointerTypeId(_getTypeId(valueType), SpvStorageClassInput), varId, SpvStorageClassInput);
+        _emitInst(m_annotations, SpvOpDecorate, varId, SpvDecorationBuiltIn, builtInVariable->builtIn);
+        m_storageClasses.Add(varId, SpvStorageClassInput);
+        m_interfaceIds.add(varId);
+    }
+    else if (auto structuredBufferType = as<IRHLSLStructuredBufferTypeBase>(type))
+    {
+        varId = _getStructuredBufferVarId(param, structuredBufferType);
+    }
+    else if (auto constantBufferType = as<IRConstantBufferType>(type))
+    {
+        varId = _getConstantBufferVarId(param, constantBufferType);
+    }
+    else
+    {
+        return _unsupported(param);
+    }
+
+    _emitName(varId, param);
+    m_globalVarIds.Add(param, varId);
+    return varId;
+}
+
+SpvId SPIRVEmitter::_getStructuredBufferVarId(IRGlobalParam* param, IRHLSLStructuredBufferTypeBase* bufferType)
+{
+    // Structured buffers are blocks holding a runtime array, in the same way as the GLSL emitter
+    // declares them, except that the block is laid out here
+    const bool isReadOnly = (bufferType->op == kIROp_HLSLStructuredBufferType);
+    if (!isReadOnly && bufferType->op != kIROp_HLSLRWStructuredBufferType)
+        return _unsupported(param);
+
+    IRType* elementType = bufferType->getElementType();
+    LayoutInfo elementInfo;
+    if (!_getLayout(elementType, LayoutRule::Std430, elementInfo))
+        return _unsupported(param);
+
+    SpvId elementTypeId = _getTypeId(elementType);
+    SpvId arrayTypeId = _getGlobalInstId(SpvOpTypeRuntimeArray, 0, &elementTypeId, 1);
+    bool needsDecorations;
+    if (!_claimLayout(arrayTypeId, LayoutRule::Std430, needsDecorations))
+        return _unsupported(param);
+    if (needsDecorations)
+        _emitInst(m_annotations, SpvOpDecorate, arrayTypeId, SpvDecorationArrayStride, _alignUp(elementInfo.size, elementInfo.alignment));
+
+    SpvId blockTypeId = _allocId();
+    _emitInst(m_globals, SpvOpTypeStruct, blockTypeId, arrayTypeId);
+    _emitInst(m_annotations, SpvOpDecorate, blockTypeId, SpvDecorationBufferBlock);
+    _emitInst(m_annotations, SpvOpMemberDecorate, blockTypeId, 0, SpvDecorationOffset, 0);
+    if (isReadOnly)
+        _emitInst(m_annotations, SpvOpMemberDecorate, blockTypeId, 0, SpvDecorationNonWritable);
+
+    SpvId varId = _allocId();
+    _emitInst(m_globals, SpvOpVariable, _getPointerTypeId(blockTypeId, SpvStorageClassUniform), varId, SpvStorageClassUniform);
+    m_storageClasses.Add(varId, SpvStorageClassUniform);
+
+    if (!_emitBindingDecorations(varId, param))
+        return _unsupported(param);
+    return varId;
+}
+
+SpvId SPIRVEmitter::_getConstantBufferVarId(IRGlobalParam* param, IRConstantBufferType* bufferType)
+{
+    auto structType = as<IRStructType>(bufferType->getElementType());
+    if (!structType)
+        return _unsupported(param);
+
+    // The block type has the same members as the struct type of the buffer, but is a separate type,
+    // because a type decorated as a block can't be used for values outside of buffers.
+    SpvId blockTypeId;
+    if (!m_constantBufferBlockTypeIds.TryGetValue(structType, blockTypeId))
+    {
+        List<uint32_t> offsets;
+        LayoutInfo info;
+        if (!_getStructLayout(structType, LayoutRule::Std140, offsets, info))
+            return _unsupported(param);
+
+        List<uint32_t> operands;
+        blockTypeId = _allocId();
+        operands.add(blockTypeId);
+        for (auto field : structType->getFields())
+            operands.add(_getTypeId(field->getFieldType()));
+        _emitInst(m_globals, SpvOpTypeStruct, operands.getBuffer(), operands.getCount());
+
+        _emitInst(m_annotations, SpvOpDecorate, blockTypeId, SpvDecorationBlock);
+        for (Index i = 0; i < offsets.getCount(); ++i)
+            _emitInst(m_annotations, SpvOpMemberDecorate, blockTypeId, uint32_t(i), SpvDecorationOffset, offsets[i]);
+
+        m_constantBufferBlockTypeIds.Add(structType, blockTypeId);
+    }
+
+    SpvId varId = _allocId();
+    _emitInst(m_globals, SpvOpVariable, _getPointerTypeId(blockTypeId, SpvStorageClassUniform), varId, SpvStorageClassUniform);
+    m_storageClasses.Add(varId, SpvStorageClassUniform);
+
+    if (!_emitBindingDecorations(varId, param))
+        return _unsupported(param);
+    return varId;
+}
+
+SpvId SPIRVEmitter::_getGlobalVarId(IRGlobalVar* var)
+{
+    SpvId varId;
+    if (m_globalVarIds.TryGetValue(var, varId))
+        return varId;
+
+    // Variables with initializers aren't supported
+    auto ptrType = as<IRPtrTypeBase>(var->getDataType());
+    if (!ptrType || var->getFirstBlock())
+        return _unsupported(var);
+
+    const SpvStorageClass storageClass = as<IRGroupSharedRate>(var->getRate()) ? SpvStorageClassWorkgroup : SpvStorageClassPrivate;
+
+    varId = _allocId();
+    _emitInst(m_globals, SpvOpVariable, _getPointerTypeId(_getTypeId(ptrType->getValueType()), storageClass), varId, storageClass);
+    m_storageClasses.Add(varId, storageClass);
+    _emitName(varId, var);
+
+    m_globalVarIds.Add(var, varId);
+    return varId;
+}
+
+SpvId SPIRVEmitter::_getSpecConstantId(IRGlobalConstant* constant)
+{
+    // Only specialization constants are supported, and their initializer must be a literal
+    auto decoration = constant->findDecoration<IRSpecializationConstantDecoration>();
+    auto block = constant->getFirstBlock();
+    auto returnInst = block ? as<IRReturnVal>(block->getTerminator()) : nullptr;
+    NumericType type;
+    if (!decoration || !returnInst || !_isLiteral(returnInst->getVal()) ||
+        !_getNumericType(constant->getDataType(), type) || type.count != 1)
+    {
+        return _unsupported(constant);
+    }
+
+    const IRIntegerValue value = static_cast<IRConstant*>(returnInst->getVal())->value.intVal;
+    const SpvId typeId = _getNumericTypeId(type);
+    const SpvId id = _allocId();
+    switch (type.kind)
+    {
+        case ScalarKind::Bool:
+            _emitInst(m_globals, value ? SpvOpSpecConstantTrue : SpvOpSpecConstantFalse, typeId, id);
+            break;
+        case ScalarKind::Int:
+        case ScalarKind::UInt:
+            if (type.width != 32)
+                return _unsupported(constant);
+            _emitInst(m_globals, SpvOpSpecConstant, typeId, id, uint32_t(value));
+            break;
+        default:
+            return _unsupported(constant);
+    }
+    _emitInst(m_annotations, SpvOpDecorate, id, SpvDecorationSpecId, uint32_t(decoration->getID()));
+    _emitName(id, constant);
+
+    m_valueIds.Add(constant, id);
+    return id;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Values in functions !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SpvId SPIRVEmitter::_getOperandAs(IRInst* operand, const NumericType& type)
+{
+    // Literals can be made with whatever type is needed
+    if (_isLiteral(operand))
+        return _getConstantId(type, operand);
+
+    NumericType operandType;
+    if (!_getNumericType(operand->getDataType(), operandType))
+        return _unsupported(operand);
+    return _emitConversion(_getValueId(operand), operandType, type);
+}
+
+bool SPIRVEmitter::_getCommonOperandType(IRInst* const* operands, Index operandCount, NumericType& outType)
+{
+    // The type is taken from the first operand that isn't a literal (whose type may not match), with
+    // the element count of the widest operand, so that scalars are made into vectors as needed.
+    bool found = false;
+    Index count = 1;
+    for (Index i = 0; i < operandCount; ++i)
+    {
+        NumericType operandType;
+        if (!_getNumericType(operands[i]->getDataType(), operandType))
+            return false;
+
+        count = Math::Max(count, operandType.count);
+        if (!found && !_isLiteral(operands[i]))
+        {
+            outType = operandType;
+            found = true;
+        }
+    }
+    if (!found && (operandCount == 0 || !_getNumericType(operands[0]->getDataType(), outType)))
+        return false;
+
+    outType.count = count;
+    return true;
+}
+
+SpvId SPIRVEmitter::_emitSplat(SpvId scalarId, const NumericType& type)
+{
+    if (type.count == 1)
+        return scalarId;
+
+    List<uint32_t> operands;
+    for (Index i = 0; i < type.count; ++i)
+        operands.add(scalarId);
+    return _emitOp(SpvOpCompositeConstruct, _getNumericTypeId(type), operands.getBuffer(), operands.getCount());
+}
+
+SpvId SPIRVEmitter::_emitConversion(SpvId valueId, const NumericType& fromType, const NumericType& toType)
+{
+    if (fromType == toType)
+        return valueId;
+
+    if (fromType.count != toType.count)
+    {
+        // Only a scalar can be made into a vector
+        if (fromType.count != 1)
+            return _unsupported(nullptr);
+        return _emitSplat(_emitConversion(valueId, fromType, toType.getScalarType()), toType);
+    }
+
+    const SpvId toTypeId = _getNumericTypeId(toType);
+    if (toType.kind == ScalarKind::Bool)
+    {
+        if (fromType.kind == ScalarKind::Float)
+            return _emitOp(SpvOpFUnordNotEqual, toTypeId, valueId, _getIntConstantId(fromType, 0));
+        return _emitOp(SpvOpINotEqual, toTypeId, valueId, _getIntConstantId(fromType, 0));
+    }
+
+    switch (fromType.kind)
+    {
+        case ScalarKind::Bool:
+        {
+            return _emitOp(SpvOpSelect, toTypeId, valueId, _getIntConstantId(toType, 1), _getIntConstantId(toType, 0));
+        }
+        case ScalarKind::Float:
+        {
+            switch (toType.kind)
+            {
+                case ScalarKind::Float:     return _emitOp(SpvOpFConvert, toTypeId, valueId);
+                case ScalarKind::Int:       return _emitOp(SpvOpConvertFToS, toTypeId, valueId);
+                case ScalarKind::UInt:      return _emitOp(SpvOpConvertFToU, toTypeId, valueId);
+                default:                    break;
+            }
+            break;
+        }
+        case ScalarKind::Int:
+        case ScalarKind::UInt:
+        {
+            if (toType.kind == ScalarKind::Float)
+                return _emitOp(fromType.kind == ScalarKind::Int ? SpvOpConvertSToF : SpvOpConvertUToF, toTypeId, valueId);
+
+            // Change the width keeping the signedness of the source, then reinterpret
+            NumericType resizedType = fromType;
+            if (fromType.width != toType.width)
+            {
+                resizedType.width = toType.width;
+                valueId = _emitOp(fromType.kind == ScalarKind::Int ? SpvOpSConvert : SpvOpUConvert, _getNumericTypeId(resizedType), valueId);
+            }
+            if (resizedType.kind != toType.kind)
+                valueId = _emitOp(SpvOpBitcast, toTypeId, valueId);
+            return valueId;
+        }
+        default:
+            break;
+    }
+    return _unsupported(nullptr);
+}
+
+SpvId SPIRVEmitter::_emitArithmetic(IRInst* inst)
+{
+    NumericType type;
+    if (!_getNumericType(inst->getDataType(), type) || type.kind == ScalarKind::Bool)
+        return _unsupported(inst);
+
+    const SpvId typeId = _getNumericTypeId(type);
+    const bool isFloat = (type.kind == ScalarKind::Float);
+    const bool isSigned = (type.kind == ScalarKind::Int);
+
+    if (inst->op == kIROp_Neg)
+        return _emitOp(isFloat ? SpvOpFNegate : SpvOpSNegate, typeId, _getOperandAs(inst->getOperand(0), type));
+    if (inst->op == kIROp_BitNot)
+    {
+        if (isFloat)
+            return _unsupported(inst);
+        return _emitOp(SpvOpNot, typeId, _getOperandAs(inst->getOperand(0), type));
+    }
+
+    SpvId a = _getOperandAs(inst->getOperand(0), type);
+    SpvId b;
+    if (inst->op == kIROp_Lsh || inst->op == kIROp_Rsh)
+    {
+        // The shift amount can have a different integer type to the value shifted
+        NumericType shiftType;
+        if (!_getNumericType(inst->getOperand(1)->getDataType(), shiftType))
+            return _unsupported(inst);
+        shiftType.count = type.count;
+        b = _getOperandAs(inst->getOperand(1), shiftType);
+    }
+    else
+    {
+        b = _getOperandAs(inst->getOperand(1), type);
+    }
+
+    SpvOp op;
+    switch (inst->op)
+    {
+        case kIROp_Add:     op = isFloat ? SpvOpFAdd : SpvOpIAdd; break;
+        case kIROp_Sub:     op = isFloat ? SpvOpFSub : SpvOpISub; break;
+        case kIROp_Mul:     op = isFloat ? SpvOpFMul : SpvOpIMul; break;
+        case kIROp_Div:     op = isFloat ? SpvOpFDiv : (isSigned ? SpvOpSDiv : SpvOpUDiv); break;
+        // HLSL `%` truncates, so the result has the sign of the dividend
+        case kIROp_Mod:     op = isFloat ? SpvOpFRem : (isSigned ? SpvOpSRem : SpvOpUMod); break;
+        case kIROp_Lsh:     op = SpvOpShiftLeftLogical; break;
+        case kIROp_Rsh:     op = isSigned ? SpvOpShiftRightArithmetic : SpvOpShiftRightLogical; break;
+        case kIROp_BitAnd:  op = SpvOpBitwiseAnd; break;
+        case kIROp_BitOr:   op = SpvOpBitwiseOr; break;
+        case kIROp_BitXor:  op = SpvOpBitwiseXor; break;
+        default:            return _unsupported(inst);
+    }
+    if (isFloat && (op == SpvOpShiftLeftLogical || op == SpvOpBitwiseAnd || op == SpvOpBitwiseOr || op == SpvOpBitwiseXor))
+        return _unsupported(inst);
+    return _emitOp(op, typeId, a, b);
+}
+
+SpvId SPIRVEmitter::_emitComparison(IRInst* inst)
+{
+    IRInst* operands[] = { inst->getOperand(0), inst->getOperand(1) };
+    NumericType type;
+    if (!_getCommonOperandType(operands, 2, type))
+        return _unsupported(inst);
+
+    SpvId a = _getOperandAs(operands[0], type);
+    SpvId b = _getOperandAs(operands[1], type);
+    const SpvId resultTypeId = _getBoolTypeId(type.count);
+
+    static const SpvOp kFloatOps[] = { SpvOpFOrdEqual, SpvOpFUnordNotEqual, SpvOpFOrdGreaterThan, SpvOpFOrdLessThan, SpvOpFOrdGreaterThanEqual, SpvOpFOrdLessThanEqual };
+    static const SpvOp kIntOps[] = { SpvOpIEqual, SpvOpINotEqual, SpvOpSGreaterThan, SpvOpSLessThan, SpvOpSGreaterThanEqual, SpvOpSLessThanEqual };
+    static const SpvOp kUIntOps[] = { SpvOpIEqual, SpvOpINotEqual, SpvOpUGreaterThan, SpvOpULessThan, SpvOpUGreaterThanEqual, SpvOpULessThanEqual };
+
+    Index opIndex;
+    switch (inst->op)
+    {
+        case kIROp_Eql:     opIndex = 0; break;
+        case kIROp_Neq:     opIndex = 1; break;
+        case kIROp_Greater: opIndex = 2; break;
+        case kIROp_Less:    opIndex = 3; break;
+        case kIROp_Geq:     opIndex = 4; break;
+        case kIROp_Leq:     opIndex = 5; break;
+        default:            return _unsupported(inst);
+    }
+
+    switch (type.kind)
+    {
+        case ScalarKind::Float: return _emitOp(kFloatOps[opIndex], resultTypeId, a, b);
+        case ScalarKind::Int:   return _emitOp(kIntOps[opIndex], resultTypeId, a, b);
+        case ScalarKind::UInt:  return _emitOp(kUIntOps[opIndex], resultTypeId, a, b);
+        case ScalarKind::Bool:
+        {
+            if (opIndex > 1)
+                break;
+            return _emitOp(opIndex == 0 ? SpvOpLogicalEqual : SpvOpLogicalNotEqual, resultTypeId, a, b);
+        }
+        default:
+            break;
+    }
+    return _unsupported(inst);
+}
+
+SpvId SPIRVEmitter::_emitLogical(IRInst* inst)
+{
+    // The operands of logical operations are converted to `bool` as needed
+    NumericType type;
+    if (!_getNumericType(inst->getDataType(), type))
+        return _unsupported(inst);
+    type.kind = ScalarKind::Bool;
+    type.width = 32;
+    const SpvId typeId = _getNumericTypeId(type);
+
+    switch (inst->op)
+    {
+        case kIROp_Not:
+            return _emitOp(SpvOpLogicalNot, typeId, _getOperandAs(inst->getOperand(0), type));
+        case kIROp_And:
+            return _emitOp(SpvOpLogicalAnd, typeId, _getOperandAs(inst->getOperand(0), type), _getOperandAs(inst->getOperand(1), type));
+        case kIROp_Or:
+            return _emitOp(SpvOpLogicalOr, typeId, _getOperandAs(inst->getOperand(0), type), _getOperandAs(inst->getOperand(1), type));
+        case kIROp_BitAnd:
+            return _emitOp(SpvOpLogicalAnd, typeId, _getOperandAs(inst->getOperand(0), type), _getOperandAs(inst->getOperand(1), type));
+        case kIROp_BitOr:
+            return _emitOp(SpvOpLogicalOr, typeId, _getOperandAs(inst->getOperand(0), type), _getOperandAs(inst->getOperand(1), type));
+        case kIROp_BitXor:
+            return _emitOp(SpvOpLogicalNotEqual, typeId, _getOperandAs(inst->getOperand(0), type), _getOperandAs(inst->getOperand(1), type));
+        case kIROp_BitNot:
+            return _emitOp(SpvOpLogicalNot, typeId, _getOperandAs(inst->getOperand(0), type));
+        default:
+            break;
+    }
+    return _unsupported(inst);
+}
+
+SpvId SPIRVEmitter::_emitConstruct(IRInst* inst)
+{
+    IRType* type = inst->getDataType();
+    const SpvId typeId = _getTypeId(type);
+    const UInt operandCount = inst->getOperandCount();
+
+    NumericType numericType;
+    if (!_getNumericType(type, numericType))
+    {
+        // Aggregates are made from values of exactly the element types
+        if (inst->op != kIROp_makeArray && inst->op != kIROp_makeStruct)
+            return _unsupported(inst);
+        List<uint32_t> operands;
+        for (UInt i = 0; i < operandCount; ++i)
+            operands.add(_getValueId(inst->getOperand(i)));
+        return _emitOp(SpvOpCompositeConstruct, typeId, operands.getBuffer(), operands.getCount());
+    }
+
+    if (operandCount == 0)
+        return _getGlobalInstId(SpvOpConstantNull, typeId, nullptr, 0);
+
+    if (operandCount == 1 || inst->op == kIROp_constructVectorFromScalar)
+    {
+        // A conversion, or a scalar made into a vector
+        IRInst* operand = inst->getOperand(0);
+        NumericType operandType;
+        if (!_getNumericType(operand->getDataType(), operandType))
+            return _unsupported(inst);
+        if (operandType.count != 1 && operandType.count != numericType.count)
+            return _unsupported(inst);
+        return _getOperandAs(operand, numericType.getWithCount(operandType.count == 1 ? numericType.count : operandType.count));
+    }
+
+    // A vector made from scalars and vectors
+    List<uint32_t> operands;
+    Index elementCount = 0;
+    for (UInt i = 0; i < operandCount; ++i)
+    {
+        IRInst* operand = inst->getOperand(i);
+        NumericType operandType;
+        if (!_getNumericType(operand->getDataType(), operandType))
+            return _unsupported(inst);
+        operands.add(_getOperandAs(operand, numericType.getWithCount(operandType.count)));
+        elementCount += operandType.count;
+    }
+    if (elementCount != numericType.count)
+        return _unsupported(inst);
+    return _emitOp(SpvOpCompositeConstruct, typeId, operands.getBuffer(), operands.getCount());
+}
+
+SpvId SPIRVEmitter::_emitBarrier(const BarrierIntrinsic& barrier)
+{
+    SpvId memoryScopeId = _getUIntConstantId(barrier.memoryScope);
+    SpvId semanticsId = _getUIntConstantId(barrier.memorySemantics);
+    if (barrier.isControlBarrier)
+        _emitInst(m_funcBody, SpvOpControlBarrier, _getUIntConstantId(SpvScopeWorkgroup), memoryScopeId, semanticsId);
+    else
+        _emitInst(m_funcBody, SpvOpMemoryBarrier, memoryScopeId, semanticsId);
+    return 0;
+}
+
+SpvId SPIRVEmitter::_emitCall(IRCall* inst)
+{
+    IRInst* callee = inst->getCallee();
+
+    // Arguments of `void` type are dropped, as they are by the source emitters
+    List<IRInst*> args;
+    for (UInt i = 0; i < inst->getArgCount(); ++i)
+    {
+        IRInst* arg = inst->getArg(i);
+        if (!as<IRVoidType>(arg->getDataType()))
+            args.add(arg);
+    }
+
+    auto func = as<IRFunc>(callee);
+    if (func && func->isDefinition() && !func->findDecoration<IRTargetIntrinsicDecoration>())
+    {
+        const SpvId resultTypeId = _getTypeId(inst->getDataType());
+
+        List<uint32_t> operands;
+        operands.add(_getValueId(func));
+        for (Index i = 0; i < args.getCount(); ++i)
+        {
+            IRInst* arg = args[i];
+            IRType* paramType = func->getParamType(UInt(i));
+
+            NumericType paramNumericType;
+            if (as<IRPtrTypeBase>(paramType))
+            {
+                // With logical addressing, pointer arguments have to be function variables
+                SpvId argId = _getValueId(arg);
+                if (!(as<IRVar>(arg) || as<IRParam>(arg)) || _getStorageClass(argId) != SpvStorageClassFunction)
+                    return _unsupported(inst);
+                operands.add(argId);
+            }
+            else if (_getNumericType(paramType, paramNumericType))
+            {
+                operands.add(_getOperandAs(arg, paramNumericType));
+            }
+            else
+            {
+                operands.add(_getValueId(arg));
+            }
+        }
+        return _emitOp(SpvOpFunctionCall, resultTypeId, operands.getBuffer(), operands.getCount());
+    }
+
+    // Otherwise the callee is a built-in, which is identified by its GLSL definition if it has one,
+    // and otherwise by its name
+    IRInst* resolvedCallee = getResolvedInstForDecorations(callee);
+    for (auto decoration : resolvedCallee->getDecorations())
+    {
+        auto intrinsicDecoration = as<IRTargetIntrinsicDecoration>(decoration);
+        if (intrinsicDecoration && intrinsicDecoration->getTargetName() == "glsl")
+            return _emitIntrinsicCall(inst, intrinsicDecoration->getDefinition());
+    }
+
+    // If the intrinsic is generic, the mangled name is on the outer-most generic
+    IRInst* valueForName = resolvedCallee;
+    for (;;)
+    {
+        auto parentBlock = as<IRBlock>(valueForName->getParent());
+        auto parentGeneric = parentBlock ? as<IRGeneric>(parentBlock->getParent()) : nullptr;
+        if (!parentGeneric)
+            break;
+        valueForName = parentGeneric;
+    }
+    auto linkageDecoration = valueForName->findDecoration<IRLinkageDecoration>();
+    if (!linkageDecoration)
+        return _unsupported(inst);
+
+    MangledLexer lexer(linkageDecoration->getMangledName());
+    return _emitNamedIntrinsicCall(inst, lexer.readSimpleName(), args);
+}
+
+SpvId SPIRVEmitter::_emitIntrinsicCall(IRCall* inst, const UnownedStringSlice& definition)
+{
+    List<IRInst*> args;
+    for (UInt i = 0; i < inst->getArgCount(); ++i)
+    {
+        IRInst* arg = inst->getArg(i);
+        if (!as<IRVoidType>(arg->getDataType()))
+            args.add(arg);
+    }
+
+    if (definition == "$0._data[$1]")
+    {
+        // Subscript of a structured buffer, which is the runtime array member of the block
+        if (args.getCount() != 2 || !as<IRGlobalParam>(args[0]))
+            return _unsupported(inst);
+        SpvId bufferId = _getValueId(args[0]);
+
+        IRType* resultType = inst->getDataType();
+        auto resultPtrType = as<IRPtrTypeBase>(resultType);
+        IRType* elementType = resultPtrType ? resultPtrType->getValueType() : resultType;
+        const SpvId elementTypeId = _getTypeId(elementType);
+
+        NumericType indexType;
+        indexType.kind = ScalarKind::Int;
+        SpvId elementPtrId = _emitOp(SpvOpAccessChain, _getPointerTypeId(elementTypeId, SpvStorageClassUniform),
+            bufferId, _getIntConstantId(indexType, 0), _getValueId(args[1]));
+        m_storageClasses.Add(elementPtrId, SpvStorageClassUniform);
+
+        if (resultPtrType)
+            return elementPtrId;
+        return _emitOp(SpvOpLoad, elementTypeId, elementPtrId);
+    }
+
+    for (const auto& barrier : kBarrierIntrinsics)
+    {
+        if (definition == barrier.definition)
+            return _emitBarrier(barrier);
+    }
+
+    if (definition == "clamp($0, 0, 1)")
+        return _emitNamedIntrinsicCall(inst, UnownedStringSlice::fromLiteral("saturate"), args);
+
+    UnownedStringSlice name;
+    if (!_parseSimpleIntrinsicCall(definition, args.getCount(), name))
+        return _unsupported(inst);
+    return _emitNamedIntrinsicCall(inst, name, args);
+}
+
+SpvId SPIRVEmitter::_emitNamedIntrinsicCall(IRCall* inst, const UnownedStringSlice& name, const List<IRInst*>& args)
+{
+    IRType* resultType = inst->getDataType();
+    if (as<IRVoidType>(resultType))
+    {
+        if (name == "GroupMemoryBarrierWithGroupSync")
+            return _emitBarrier(kBarrierIntrinsics[1]);
+        return _unsupported(inst);
+    }
+
+    NumericType type;
+    if (!_getNumericType(resultType, type) || args.getCount() == 0)
+        return _unsupported(inst);
+    const SpvId typeId = _getNumericTypeId(type);
+
+    NumericType operandType;
+    if (!_getCommonOperandType(args.getBuffer(), args.getCount(), operandType))
+        return _unsupported(inst);
+
+    List<SpvId> operands;
+    for (auto arg : args)
+        operands.add(_getOperandAs(arg, operandType));
+    const SpvId operandTypeId = _getNumericTypeId(operandType);
+    const bool isFloat = (operandType.kind == ScalarKind::Float);
+
+    // Conversions and reinterpretations
+    if (args.getCount() == 1)
+    {
+        if (name == "int" || name == "uint" || name == "bool" || name == "float")
+            return _emitConversion(operands[0], operandType, type);
+        if (name == "asfloat" || name == "asint" || name == "asuint" ||
+            name == "floatBitsToInt" || name == "floatBitsToUint" || name == "intBitsToFloat" || name == "uintBitsToFloat")
+        {
+            if (operandType.width != type.width || operandType.count != type.count)
+                return _unsupported(inst);
+            return _emitOp(SpvOpBitcast, typeId, operands[0]);
+        }
+    }
+
+    if (name == "dot" && args.getCount() == 2 && isFloat)
+    {
+        if (operandType.count == 1)
+            return _emitOp(SpvOpFMul, typeId, operands[0], operands[1]);
+        return _emitOp(SpvOpDot, typeId, operands[0], operands[1]);
+    }
+    if (name == "saturate" && args.getCount() == 1 && isFloat)
+    {
+        operands.add(_getIntConstantId(operandType, 0));
+        operands.add(_getIntConstantId(operandType, 1));
+        return _emitExtInst(typeId, GLSLstd450FClamp, operands);
+    }
+    if (name == "rcp" && args.getCount() == 1 && isFloat)
+        return _emitOp(SpvOpFDiv, typeId, _getIntConstantId(operandType, 1), operands[0]);
+    if ((name == "isnan" || name == "isinf") && args.getCount() == 1 && isFloat)
+        return _emitOp(name == "isnan" ? SpvOpIsNan : SpvOpIsInf, typeId, operands[0]);
+    if ((name == "any" || name == "all") && args.getCount() == 1)
+    {
+        NumericType boolType = operandType;
+        boolType.kind = ScalarKind::Bool;
+        boolType.width = 32;
+        SpvId boolId = _emitConversion(operands[0], operandType, boolType);
+        if (boolType.count == 1)
+            return boolId;
+        return _emitOp(name == "any" ? SpvOpAny : SpvOpAll, typeId, boolId);
+    }
+    if ((name == "countbits" || name == "bitCount") && args.getCount() == 1 && !isFloat)
+        return _emitOp(SpvOpBitCount, typeId, operands[0]);
+    if ((name == "reversebits" || name == "bitfieldReverse") && args.getCount() == 1 && !isFloat)
+        return _emitOp(SpvOpBitReverse, typeId, operands[0]);
+    if (name == "mad" && args.getCount() == 3 && !isFloat && operandType.kind != ScalarKind::Bool)
+        return _emitOp(SpvOpIAdd, typeId, _emitOp(SpvOpIMul, operandTypeId, operands[0], operands[1]), operands[2]);
+
+    // GLSL.std.450 instructions
+    for (const auto& intrinsic : kExtInstIntrinsics)
+    {
+        if (!(name == intrinsic.name))
+            continue;
+
+        GLSLstd450 extInst = GLSLstd450Bad;
+        switch (operandType.kind)
+        {
+            case ScalarKind::Float: extInst = intrinsic.floatInst; break;
+            case ScalarKind::Int:   extInst = intrinsic.intInst; break;
+            case ScalarKind::UInt:  extInst = intrinsic.uintInst; break;
+            default:                break;
+        }
+        // GLSL spells `atan2` as a two argument `atan`
+        if (extInst == GLSLstd450Atan && args.getCount() == 2)
+            extInst = GLSLstd450Atan2;
+        if (extInst == GLSLstd450Bad)
+            return _unsupported(inst);
+
+        NumericType extInstType = intrinsic.isScalarResult ? operandType.getScalarType() : operandType;
+        SpvId resultId = _emitExtInst(_getNumericTypeId(extInstType), extInst, operands);
+
+        // For example `sign` produces an integer in HLSL
+        return _emitConversion(resultId, extInstType, type);
+    }
+
+    return _unsupported(inst);
+}
+
+SpvId SPIRVEmitter::_emitInstValue(IRInst* inst)
+{
+    switch (inst->op)
+    {
+        case kIROp_Var:
+        {
+            auto ptrType = as<IRPtrTypeBase>(inst->getDataType());
+            if (!ptrType)
+                return _unsupported(inst);
+
+            SpvId varId = _allocId();
+            _emitInst(m_funcVars, SpvOpVariable, _getPointerTypeId(_getTypeId(ptrType->getValueType()), SpvStorageClassFunction), varId, SpvStorageClassFunction);
+            m_storageClasses.Add(varId, SpvStorageClassFunction);
+            _emitName(varId, inst);
+            return varId;
+        }
+        case kIROp_Load:
+        {
+            // A whole constant buffer can't be loaded, as its block type is not the struct type
+            IRInst* ptr = inst->getOperand(0);
+            if (as<IRConstantBufferType>(ptr->getDataType()))
+                return _unsupported(inst);
+            return _emitOp(SpvOpLoad, _getTypeId(inst->getDataType()), _getValueId(ptr));
+        }
+        case kIROp_Store:
+        {
+            IRInst* ptr = inst->getOperand(0);
+            IRInst* value = inst->getOperand(1);
+
+            SpvId valueId;
+            auto ptrType = as<IRPtrTypeBase>(ptr->getDataType());
+            NumericType valueType;
+            if (ptrType && _getNumericType(ptrType->getValueType(), valueType))
+                valueId = _getOperandAs(value, valueType);
+            else
+                valueId = _getValueId(value);
+
+            _emitInst(m_funcBody, SpvOpStore, _getValueId(ptr), valueId);
+            return 0;
+        }
+        case kIROp_FieldExtract:
+        {
+            auto fieldExtract = static_cast<IRFieldExtract*>(inst);
+            auto structType = as<IRStructType>(fieldExtract->getBase()->getDataType());
+            Index fieldIndex = structType ? _getFieldIndex(structType, fieldExtract->getField()) : -1;
+            if (fieldIndex < 0)
+                return _unsupported(inst);
+            return _emitOp(SpvOpCompositeExtract, _getTypeId(inst->getDataType()), _getValueId(fieldExtract->getBase()), uint32_t(fieldIndex));
+        }
+        case kIROp_FieldAddress:
+        {
+            auto fieldAddress = static_cast<IRFieldAddress*>(inst);
+            IRType* baseType = fieldAddress->getBase()->getDataType();
+            IRType* baseValueType = nullptr;
+            if (auto ptrType = as<IRPtrTypeBase>(baseType))
+                baseValueType = ptrType->getValueType();
+            else if (auto constantBufferType = as<IRConstantBufferType>(baseType))
+                baseValueType = constantBufferType->getElementType();
+
+            auto structType = as<IRStructType>(baseValueType);
+            Index fieldIndex = structType ? _getFieldIndex(structType, fieldAddress->getField()) : -1;
+            auto resultPtrType = as<IRPtrTypeBase>(inst->getDataType());
+            if (fieldIndex < 0 || !resultPtrType)
+                return _unsupported(inst);
+
+            SpvId baseId = _getValueId(fieldAddress->getBase());
+            const SpvStorageClass storageClass = _getStorageClass(baseId);
+
+            NumericType indexType;
+            indexType.kind = ScalarKind::Int;
+            SpvId resultId = _emitOp(SpvOpAccessChain, _getPointerTypeId(_getTypeId(resultPtrType->getValueType()), storageClass),
+                baseId, _getIntConstantId(indexType, fieldIndex));
+            m_storageClasses.Add(resultId, storageClass);
+            return resultId;
+        }
+        case kIROp_getElement:
+        {
+            IRInst* base = inst->getOperand(0);
+            IRInst* index = inst->getOperand(1);
+            const SpvId typeId = _getTypeId(inst->getDataType());
+            if (auto indexLit = as<IRIntLit>(index))
+                return _emitOp(SpvOpCompositeExtract, typeId, _getValueId(base), uint32_t(indexLit->getValue()));
+
+            // Dynamically indexing an array value would need it to be copied to a variable
+            if (!as<IRVectorType>(base->getDataType()))
+                return _unsupported(inst);
+            return _emitOp(SpvOpVectorExtractDynamic, typeId, _getValueId(base), _getValueId(index));
+        }
+        case kIROp_getElementPtr:
+        {
+            auto resultPtrType = as<IRPtrTypeBase>(inst->getDataType());
+            if (!resultPtrType)
+                return _unsupported(inst);
+
+            SpvId baseId = _getValueId(inst->getOperand(0));
+            const SpvStorageClass storageClass = _getStorageClass(baseId);
+            SpvId resultId = _emitOp(SpvOpAccessChain, _getPointerTypeId(_getTypeId(resultPtrType->getValueType()), storageClass),
+                baseId, _getValueId(inst->getOperand(1)));
+            m_storageClasses.Add(resultId, storageClass);
+            return resultId;
+        }
+        case kIROp_swizzle:
+        {
+            auto swizzle = static_cast<IRSwizzle*>(inst);
+            NumericType baseType;
+            if (!_getNumericType(swizzle->getBase()->getDataType(), baseType))
+                return _unsupported(inst);
+
+            const SpvId typeId = _getTypeId(inst->getDataType());
+            const SpvId baseId = _getValueId(swizzle->getBase());
+            const UInt elementCount = swizzle->getElementCount();
+
+            if (baseType.count == 1)
+                return (elementCount == 1) ? baseId : _emitSplat(baseId, baseType.getWithCount(Index(elementCount)));
+            if (elementCount == 1)
+                return _emitOp(SpvOpCompositeExtract, typeId, baseId, uint32_t(GetIntVal(swizzle->getElementIndex(0))));
+
+            List<uint32_t> operands;
+            operands.add(baseId);
+            operands.add(baseId);
+            for (UInt i = 0; i < elementCount; ++i)
+                operands.add(uint32_t(GetIntVal(swizzle->getElementIndex(i))));
+            return _emitOp(SpvOpVectorShuffle, typeId, operands.getBuffer(), operands.getCount());
+        }
+        case kIROp_swizzleSet:
+        {
+            auto swizzleSet = static_cast<IRSwizzleSet*>(inst);
+            NumericType type;
+            if (!_getNumericType(inst->getDataType(), type) || type.count == 1)
+                return _unsupported(inst);
+
+            const SpvId typeId = _getNumericTypeId(type);
+            const SpvId baseId = _getValueId(swizzleSet->getBase());
+            const UInt elementCount = swizzleSet->getElementCount();
+            SpvId sourceId = _getOperandAs(swizzleSet->getSource(), type.getWithCount(Index(elementCount)));
+
+            if (elementCount == 1)
+                return _emitOp(SpvOpCompositeInsert, typeId, sourceId, baseId, uint32_t(GetIntVal(swizzleSet->getElementIndex(0))));
+
+            // Components of the second vector of a shuffle come after those of the first
+            List<uint32_t> operands;
+            operands.add(baseId);
+            operands.add(sourceId);
+            for (Index i = 0; i < type.count; ++i)
+                operands.add(uint32_t(i));
+            for (UInt i = 0; i < elementCount; ++i)
+                operands[2 + Index(GetIntVal(swizzleSet->getElementIndex(i)))] = uint32_t(type.count + Index(i));
+            return _emitOp(SpvOpVectorShuffle, typeId, operands.getBuffer(), operands.getCount());
+        }
+        case kIROp_SwizzledStore:
+        {
+            // Each element is stored separately, so that the other elements in memory aren't written
+            auto swizzledStore = static_cast<IRSwizzledStore*>(inst);
+            auto destPtrType = as<IRPtrTypeBase>(swizzledStore->getDest()->getDataType());
+            auto vectorType = destPtrType ? as<IRVectorType>(destPtrType->getValueType()) : nullptr;
+            NumericType elementType;
+            if (!vectorType || !_getNumericType(vectorType->getElementType(), elementType))
+                return _unsupported(inst);
+
+            const SpvId destId = _getValueId(swizzledStore->getDest());
+            const SpvStorageClass storageClass = _getStorageClass(destId);
+            const SpvId elementTypeId = _getNumericTypeId(elementType);
+            const UInt elementCount = swizzledStore->getElementCount();
+            SpvId sourceId = _getOperandAs(swizzledStore->getSource(), elementType.getWithCount(Index(elementCount)));
+
+            for (UInt i = 0; i < elementCount; ++i)
+            {
+                SpvId elementPtrId = _emitOp(SpvOpAccessChain, _getPointerTypeId(elementTypeId, storageClass),
+                    destId, _getUIntConstantId(uint32_t(GetIntVal(swizzledStore->getElementIndex(i)))));
+                SpvId elementId = (elementCount == 1) ? sourceId : _emitOp(SpvOpCompositeExtract, elementTypeId, sourceId, uint32_t(i));
+                _emitInst(m_funcBody, SpvOpStore, elementPtrId, elementId);
+            }
+            return 0;
+        }
+        case kIROp_Construct:
+        case kIROp_makeVector:
+        case kIROp_constructVectorFromScalar:
+        case kIROp_makeArray:
+        case kIROp_makeStruct:
+        {
+            return _emitConstruct(inst);
+        }
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_Mod:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_Neg:
+        {
+            return _emitArithmetic(inst);
+        }
+        case kIROp_BitAnd:
+        case kIROp_BitOr:
+        case kIROp_BitXor:
+        case kIROp_BitNot:
+        {
+            NumericType type;
+            if (_getNumericType(inst->getDataType(), type) && type.kind == ScalarKind::Bool)
+                return _emitLogical(inst);
+            return _emitArithmetic(inst);
+        }
+        case kIROp_And:
+        case kIROp_Or:
+        case kIROp_Not:
+        {
+            return _emitLogical(inst);
+        }
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Greater:
+        case kIROp_Less:
+        case kIROp_Geq:
+        case kIROp_Leq:
+        {
+            return _emitComparison(inst);
+        }
+        case kIROp_Select:
+        {
+            NumericType type;
+            if (!_getNumericType(inst->getDataType(), type))
+                return _unsupported(inst);
+
+            NumericType conditionType;
+            conditionType.kind = ScalarKind::Bool;
+            conditionType.count = type.count;
+            return _emitOp(SpvOpSelect, _getNumericTypeId(type),
+                _getOperandAs(inst->getOperand(0), conditionType),
+                _getOperandAs(inst->getOperand(1), type),
+                _getOperandAs(inst->getOperand(2), type));
+        }
+        case kIROp_Dot:
+        {
+            IRInst* operands[] = { inst->getOperand(0), inst->getOperand(1) };
+            NumericType operandType;
+            if (!_getCommonOperandType(operands, 2, operandType) || operandType.kind != ScalarKind::Float)
+                return _unsupported(inst);
+            return _emitOp(operandType.count == 1 ? SpvOpFMul : SpvOpDot, _getTypeId(inst->getDataType()),
+                _getOperandAs(operands[0], operandType), _getOperandAs(operands[1], operandType));
+        }
+        case kIROp_BitCast:
+        {
+            return _emitOp(SpvOpBitcast, _getTypeId(inst->getDataType()), _getValueId(inst->getOperand(0)));
+        }
+        case kIROp_Call:
+        {
+            return _emitCall(static_cast<IRCall*>(inst));
+        }
+        case kIROp_GroupMemoryBarrierWithGroupSync:
+        {
+            return _emitBarrier(kBarrierIntrinsics[1]);
+        }
+        case kIROp_undefined:
+        {
+            return _emitOp(SpvOpUndef, _getTypeId(inst->getDataType()), nullptr, 0);
+        }
+        case kIROp_Specialize:
+        {
+            // Only specializations of intrinsics are left, and they are handled at the calls
+            return 0;
+        }
+        case kIROp_Nop:
+        {
+            return 0;
+        }
+        default:
+            break;
+    }
+    return _unsupported(inst);
+}
+
+void SPIRVEmitter::_emitOrdinaryInst(IRInst* inst)
+{
+    if (as<IRDecoration>(inst) || as<IRType>(inst))
+        return;
+
+    SpvId resultId = _emitInstValue(inst);
+    if (!resultId)
+        return;
+
+    // If the value has already been referenced (by a phi) it has an id that has to be defined
+    SpvId existingId;
+    if (m_valueIds.TryGetValue(inst, existingId))
+    {
+        if (existingId != resultId)
+        {
+            List<uint32_t>& out = m_funcBody;
+            _emitInst(out, SpvOpCopyObject, _getTypeId(inst->getDataType()), existingId, resultId);
+        }
+        return;
+    }
+    m_valueIds.Add(inst, resultId);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! Functions and control flow !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+void SPIRVEmitter::_getSuccessors(IRBlock* block, List<IRBlock*>& outSuccessors)
+{
+    outSuccessors.clear();
+    auto terminator = block->getTerminator();
+    if (!terminator)
+        return;
+
+    switch (terminator->op)
+    {
+        case kIROp_unconditionalBranch:
+        case kIROp_loop:
+        {
+            outSuccessors.add(static_cast<IRUnconditionalBranch*>(terminator)->getTargetBlock());
+            break;
+        }
+        case kIROp_conditionalBranch:
+        case kIROp_ifElse:
+        {
+            auto branch = static_cast<IRConditionalBranch*>(terminator);
+            outSuccessors.add(branch->getTrueBlock());
+            outSuccessors.add(branch->getFalseBlock());
+            break;
+        }
+        case kIROp_Switch:
+        {
+            auto switchInst = static_cast<IRSwitch*>(terminator);
+            for (UInt i = 0; i < switchInst->getCaseCount(); ++i)
+                outSuccessors.add(switchInst->getCaseLabel(i));
+            outSuccessors.add(switchInst->getDefaultLabel());
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+SpvId SPIRVEmitter::_getBranchTargetLabel(IRBlock* target, IRInst* branch)
+{
+    // Back edges to a loop header go through the synthesized continue block, if there is one
+    if (branch->op != kIROp_loop)
+    {
+        if (auto loopInfo = m_loops.TryGetValue(target))
+        {
+            if (loopInfo->hasSyntheticContinue)
+                return loopInfo->continueLabel;
+        }
+    }
+    return _getLabel(target);
+}
+
+bool SPIRVEmitter::_isLoopExitEdge(IRBlock* block, IRBlock* target)
+{
+    // A branch to the merge block or continue target of the innermost loop is a `break` or `continue`
+    auto header = m_innermostLoops.TryGetValue(block);
+    if (!header)
+        return false;
+    LoopInfo& loopInfo = m_loops[*header].GetValue();
+    if (target == loopInfo.loopInst->getBreakBlock())
+        return true;
+    if (loopInfo.hasSyntheticContinue)
+        return target == *header;
+    return target == loopInfo.loopInst->getContinueBlock();
+}
+
+void SPIRVEmitter::_addPhiSource(IRBlock* target, const PhiSource& source)
+{
+    if (auto sources = m_phiSources.TryGetValue(target))
+    {
+        sources->add(source);
+        return;
+    }
+    List<PhiSource> sources;
+    sources.add(source);
+    m_phiSources.Add(target, sources);
+}
+
+void SPIRVEmitter::_prepareBlocks(IRFunc* func)
+{
+    m_blockOrder.clear();
+    m_blockLabels.Clear();
+    m_blockExitLabels.Clear();
+    m_loops.Clear();
+    m_innermostLoops.Clear();
+    m_phiSources.Clear();
+    m_mergeBlocks.Clear();
+
+    m_firstBlock = func->getFirstBlock();
+    for (auto block : func->getBlocks())
+        m_blockLabels.Add(block, _allocId());
+
+    // Find the loops. The loop header block is split in two, with the loop merge instruction
+    // at the end of the first part.
+    for (auto block : func->getBlocks())
+    {
+        auto terminator = block->getTerminator();
+        if (!terminator || terminator->op != kIROp_loop)
+            continue;
+        auto loopInst = static_cast<IRLoop*>(terminator);
+
+        IRBlock* header = loopInst->getTargetBlock();
+        if (m_loops.ContainsKey(header) || header == m_firstBlock)
+        {
+            _unsupported(loopInst);
+            return;
+        }
+
+        LoopInfo loopInfo;
+        loopInfo.loopInst = loopInst;
+        loopInfo.bodyLabel = _allocId();
+        if (loopInst->getContinueBlock() == header)
+        {
+            loopInfo.hasSyntheticContinue = true;
+            loopInfo.continueLabel = _allocId();
+            for (auto param : header->getParams())
+            {
+                SLANG_UNUSED(param);
+                loopInfo.continueParamIds.add(_allocId());
+            }
+        }
+        else
+        {
+            loopInfo.continueLabel = _getLabel(loopInst->getContinueBlock());
+            if (m_mergeBlocks.Contains(loopInst->getContinueBlock()))
+            {
+                _unsupported(loopInst);
+                return;
+            }
+            m_mergeBlocks.Add(loopInst->getContinueBlock());
+        }
+        if (m_mergeBlocks.Contains(loopInst->getBreakBlock()))
+        {
+            _unsupported(loopInst);
+            return;
+        }
+        m_mergeBlocks.Add(loopInst->getBreakBlock());
+        m_mergeBlocks.Add(header);
+
+        m_loops.Add(header, loopInfo);
+    }
+
+    for (auto block : func->getBlocks())
+    {
+        auto loopInfo = m_loops.TryGetValue(block);
+        m_blockExitLabels.Add(block, loopInfo ? loopInfo->bodyLabel : _getLabel(block));
+    }
+
+    // Find the values passed to block parameters by each branch
+    for (auto block : func->getBlocks())
+    {
+        auto terminator = block->getTerminator();
+        if (auto branch = as<IRUnconditionalBranch>(terminator))
+        {
+            IRBlock* target = branch->getTargetBlock();
+            Index paramCount = 0;
+            for (auto param : target->getParams())
+            {
+                SLANG_UNUSED(param);
+                paramCount++;
+            }
+            if (Index(branch->getArgCount()) != paramCount)
+            {
+                _unsupported(branch);
+                return;
+            }
+
+            PhiSource source;
+            source.label = m_blockExitLabels[block];
+            source.branch = branch;
+
+            auto loopInfo = m_loops.TryGetValue(target);
+            if (loopInfo && loopInfo->hasSyntheticContinue && branch->op != kIROp_loop)
+                loopInfo->continueSources.add(source);
+            else
+                _addPhiSource(target, source);
+        }
+        else
+        {
+            // Other branches can't pass values
+            List<IRBlock*> successors;
+            _getSuccessors(block, successors);
+            for (auto successor : successors)
+            {
+                if (successor->getFirstParam())
+                {
+                    _unsupported(terminator);
+                    return;
+                }
+            }
+        }
+    }
+    for (auto& pair : m_loops)
+    {
+        if (pair.Value.hasSyntheticContinue)
+        {
+            PhiSource source;
+            source.label = pair.Value.continueLabel;
+            source.branch = nullptr;
+            _addPhiSource(pair.Key, source);
+        }
+    }
+
+    // Order the blocks so that each block comes before the blocks it dominates, as SPIR-V
+    // requires, using a reverse post-order walk.
+    {
+        struct Entry
+        {
+            IRBlock* block;
+            List<IRBlock*> successors;
+            Index nextSuccessor;
+        };
+        HashSet<IRBlock*> visited;
+        List<IRBlock*> postOrder;
+        List<Entry> stack;
+
+        visited.Add(m_firstBlock);
+        stack.add(Entry{ m_firstBlock, List<IRBlock*>(), 0 });
+        _getSuccessors(m_firstBlock, stack.getLast().successors);
+        while (stack.getCount())
+        {
+            Entry& entry = stack.getLast();
+            if (entry.nextSuccessor < entry.successors.getCount())
+            {
+                IRBlock* successor = entry.successors[entry.nextSuccessor++];
+                if (!visited.Contains(successor))
+                {
+                    visited.Add(successor);
+                    stack.add(Entry{ successor, List<IRBlock*>(), 0 });
+                    _getSuccessors(successor, stack.getLast().successors);
+                }
+            }
+            else
+            {
+                postOrder.add(entry.block);
+                stack.removeLast();
+            }
+        }
+        for (Index i = postOrder.getCount() - 1; i >= 0; --i)
+            m_blockOrder.add(postOrder[i]);
+
+        // Unreachable blocks can still be merge blocks or continue targets
+        for (auto block : func->getBlocks())
+        {
+            if (!visited.Contains(block))
+                m_blockOrder.add(block);
+        }
+    }
+
+    // Find the innermost loop of each block. Outer loop headers come first in the order, so
+    // the assignments for inner loops replace them.
+    for (auto header : m_blockOrder)
+    {
+        auto loopInfo = m_loops.TryGetValue(header);
+        if (!loopInfo)
+            continue;
+
+        IRBlock* breakBlock = loopInfo->loopInst->getBreakBlock();
+        List<IRBlock*> work;
+        HashSet<IRBlock*> visited;
+        work.add(header);
+        visited.Add(header);
+        while (work.getCount())
+        {
+            IRBlock* block = work.getLast();
+            work.removeLast();
+            m_innermostLoops[block] = header;
+
+            List<IRBlock*> successors;
+            _getSuccessors(block, successors);
+            for (auto successor : successors)
+            {
+                if (successor != breakBlock && !visited.Contains(successor))
+                {
+                    visited.Add(successor);
+                    work.add(successor);
+                }
+            }
+        }
+    }
+}
+
+void SPIRVEmitter::_emitPhis(IRBlock* block)
+{
+    auto sources = m_phiSources.TryGetValue(block);
+
+    Index paramIndex = 0;
+    for (auto param : block->getParams())
+    {
+        NumericType numericType;
+        const bool isNumeric = _getNumericType(param->getDataType(), numericType);
+        if (as<IRPtrTypeBase>(param->getDataType()) || !sources)
+        {
+            _unsupported(param);
+            return;
+        }
+
+        List<uint32_t> operands;
+        operands.add(_getTypeId(param->getDataType()));
+        operands.add(_getValueId(param));
+        for (const auto& source : *sources)
+        {
+            SpvId valueId;
+            if (source.branch)
+            {
+                IRInst* arg = source.branch->getArg(UInt(paramIndex));
+                // Built-in inputs would need a load in the predecessor block
+                if (as<IRGlobalParam>(arg))
+                {
+                    _unsupported(arg);
+                    return;
+                }
+                valueId = (isNumeric && _isLiteral(arg)) ? _getConstantId(numericType, arg) : _getValueId(arg);
+            }
+            else
+            {
+                valueId = m_loops[block].GetValue().continueParamIds[paramIndex];
+            }
+            operands.add(valueId);
+            operands.add(source.label);
+        }
+        _emitInst(m_funcBody, SpvOpPhi, operands.getBuffer(), operands.getCount());
+        paramIndex++;
+    }
+}
+
+void SPIRVEmitter::_emitSyntheticContinueBlock(IRBlock* header, LoopInfo& loopInfo)
+{
+    _emitInst(m_funcBody, SpvOpLabel, loopInfo.continueLabel);
+
+    Index paramIndex = 0;
+    for (auto param : header->getParams())
+    {
+        NumericType numericType;
+        const bool isNumeric = _getNumericType(param->getDataType(), numericType);
+
+        List<uint32_t> operands;
+        operands.add(_getTypeId(param->getDataType()));
+        operands.add(loopInfo.continueParamIds[paramIndex]);
+        for (const auto& source : loopInfo.continueSources)
+        {
+            IRInst* arg = source.branch->getArg(UInt(paramIndex));
+            if (as<IRGlobalParam>(arg))
+            {
+                _unsupported(arg);
+                return;
+            }
+            operands.add((isNumeric && _isLiteral(arg)) ? _getConstantId(numericType, arg) : _getValueId(arg));
+            operands.add(source.label);
+        }
+        _emitInst(m_funcBody, SpvOpPhi, operands.getBuffer(), operands.getCount());
+        paramIndex++;
+    }
+    _emitInst(m_funcBody, SpvOpBranch, _getLabel(header));
+}
+
+void SPIRVEmitter::_emitBlock(IRBlock* block)
+{
+    // The label of the first block is emitted along with the function variables
+    if (block != m_firstBlock)
+    {
+        _emitInst(m_funcBody, SpvOpLabel, _getLabel(block));
+        _emitPhis(block);
+    }
+
+    if (auto loopInfo = m_loops.TryGetValue(block))
+    {
+        uint32_t loopControl = 0;
+        if (auto loopControlDecoration = loopInfo->loopInst->findDecoration<IRLoopControlDecoration>())
+        {
+            if (loopControlDecoration->getMode() == kIRLoopControl_Unroll)
+                loopControl = SpvLoopControlUnrollMask;
+        }
+        _emitInst(m_funcBody, SpvOpLoopMerge, _getLabel(loopInfo->loopInst->getBreakBlock()), loopInfo->continueLabel, loopControl);
+        _emitInst(m_funcBody, SpvOpBranch, loopInfo->bodyLabel);
+        _emitInst(m_funcBody, SpvOpLabel, loopInfo->bodyLabel);
+    }
+
+    for (auto inst : block->getOrdinaryInsts())
+    {
+        if (auto terminator = as<IRTerminatorInst>(inst))
+        {
+            _emitTerminator(block, terminator);
+            break;
+        }
+        _emitOrdinaryInst(inst);
+        if (m_failed)
+            return;
+    }
+}
+
+void SPIRVEmitter::_emitTerminator(IRBlock* block, IRTerminatorInst* terminator)
+{
+    switch (terminator->op)
+    {
+        case kIROp_ReturnVoid:
+        {
+            _emitInst(m_funcBody, SpvOpReturn);
+            break;
+        }
+        case kIROp_ReturnVal:
+        {
+            IRInst* value = static_cast<IRReturnVal*>(terminator)->getVal();
+            NumericType type;
+            IRFunc* func = as<IRFunc>(block->getParent());
+            SpvId valueId = (func && _getNumericType(func->getResultType(), type)) ? _getOperandAs(value, type) : _getValueId(value);
+            _emitInst(m_funcBody, SpvOpReturnValue, valueId);
+            break;
+        }
+        case kIROp_unconditionalBranch:
+        case kIROp_loop:
+        {
+            auto branch = static_cast<IRUnconditionalBranch*>(terminator);
+            _emitInst(m_funcBody, SpvOpBranch, _getBranchTargetLabel(branch->getTargetBlock(), branch));
+            break;
+        }
+        case kIROp_conditionalBranch:
+        case kIROp_ifElse:
+        {
+            _emitConditionalBranch(block, static_cast<IRConditionalBranch*>(terminator));
+            break;
+        }
+        case kIROp_Switch:
+        {
+            _emitSwitch(block, static_cast<IRSwitch*>(terminator));
+            break;
+        }
+        case kIROp_Unreachable:
+        case kIROp_MissingReturn:
+        {
+            _emitInst(m_funcBody, SpvOpUnreachable);
+            break;
+        }
+        default:
+        {
+            _unsupported(terminator);
+            break;
+        }
+    }
+}
+
+void SPIRVEmitter::_emitConditionalBranch(IRBlock* block, IRConditionalBranch* branch)
+{
+    NumericType boolType;
+    boolType.kind = ScalarKind::Bool;
+    SpvId conditionId = _getOperandAs(branch->getCondition(), boolType);
+
+    IRBlock* trueBlock = branch->getTrueBlock();
+    IRBlock* falseBlock = branch->getFalseBlock();
+    IRBlock* mergeBlock = (branch->op == kIROp_ifElse) ? static_cast<IRIfElse*>(branch)->getAfterBlock() : nullptr;
+
+    // SPIR-V needs a merge block for the selection, unless the branch is a `break` or `continue`
+    // out of the innermost loop
+    const bool isLoopExit = _isLoopExitEdge(block, trueBlock) || _isLoopExitEdge(block, falseBlock);
+    if (mergeBlock && !m_mergeBlocks.Contains(mergeBlock))
+    {
+        m_mergeBlocks.Add(mergeBlock);
+        _emitInst(m_funcBody, SpvOpSelectionMerge, _getLabel(mergeBlock), 0);
+    }
+    else if (!isLoopExit)
+    {
+        _unsupported(branch);
+        return;
+    }
+
+    _emitInst(m_funcBody, SpvOpBranchConditional, conditionId,
+        _getBranchTargetLabel(trueBlock, branch), _getBranchTargetLabel(falseBlock, branch));
+}
+
+void SPIRVEmitter::_emitSwitch(IRBlock* block, IRSwitch* switchInst)
+{
+    IRBlock* breakBlock = switchInst->getBreakLabel();
+    if (m_mergeBlocks.Contains(breakBlock))
+    {
+        _unsupported(switchInst);
+        return;
+    }
+    m_mergeBlocks.Add(breakBlock);
+
+    NumericType selectorType;
+    if (!_getNumericType(switchInst->getCondition()->getDataType(), selectorType) ||
+        selectorType.count != 1 || selectorType.width != 32 ||
+        (selectorType.kind != ScalarKind::Int && selectorType.kind != ScalarKind::UInt))
+    {
+        _unsupported(switchInst);
+        return;
+    }
+
+    // Falling through from one case to another isn't supported, so each case block must only be
+    // branched to by the switch
+    List<IRBlock*> caseBlocks;
+    _getSuccessors(block, caseBlocks);
+    for (auto caseBlock : caseBlocks)
+    {
+        if (caseBlock == breakBlock)
+            continue;
+        for (auto predecessor : caseBlock->getPredecessors())
+        {
+            if (predecessor != block)
+            {
+                _unsupported(switchInst);
+                return;
+            }
+        }
+    }
+
+    List<uint32_t> operands;
+    operands.add(_getOperandAs(switchInst->getCondition(), selectorType));
+    operands.add(_getBranchTargetLabel(switchInst->getDefaultLabel(), switchInst));
+    for (UInt i = 0; i < switchInst->getCaseCount(); ++i)
+    {
+        operands.add(uint32_t(GetIntVal(switchInst->getCaseValue(i))));
+        operands.add(_getBranchTargetLabel(switchInst->getCaseLabel(i), switchInst));
+    }
+
+    _emitInst(m_funcBody, SpvOpSelectionMerge, _getLabel(breakBlock), 0);
+    _emitInst(m_funcBody, SpvOpSwitch, operands.getBuffer(), operands.getCount());
+}
+
+void SPIRVEmitter::_emitFunc(IRFunc* func)
+{
+    const SpvId funcId = _getValueId(func);
+    const SpvId resultTypeId = _getTypeId(func->getResultType());
+    const SpvId funcTypeId = _getTypeId(func->getDataType());
+    _emitName(funcId, func);
+
+    _emitInst(m_functions, SpvOpFunction, resultTypeId, funcId, 0, funcTypeId);
+    for (auto param : func->getParams())
+    {
+        SpvId paramId = _getValueId(param);
+        _emitInst(m_functions, SpvOpFunctionParameter, _getTypeId(param->getDataType()), paramId);
+        if (as<IRPtrTypeBase>(param->getDataType()))
+            m_storageClasses.Add(paramId, SpvStorageClassFunction);
+        _emitName(paramId, param);
+    }
+
+    m_funcVars.clear();
+    m_funcBody.clear();
+
+    _prepareBlocks(func);
+    if (m_failed)
+        return;
+
+    for (auto block : m_blockOrder)
+    {
+        _emitBlock(block);
+        if (m_failed)
+            return;
+    }
+    for (auto& pair : m_loops)
+    {
+        if (pair.Value.hasSyntheticContinue)
+            _emitSyntheticContinueBlock(pair.Key, pair.Value);
+    }
+
+    // Function variables have to come first in the first block
+    _emitInst(m_functions, SpvOpLabel, _getLabel(m_firstBlock));
+    m_functions.addRange(m_funcVars);
+    m_functions.addRange(m_funcBody);
+    _emitInst(m_functions, SpvOpFunctionEnd);
+}
+
+SlangResult SPIRVEmitter::emitModule(IRModule* module, IRFunc* entryPoint, List<uint8_t>& spirvOut)
+{
+    m_capabilityTracker.requireCapability(SpvCapabilityShader);
+
+    auto layoutDecoration = entryPoint->findDecoration<IRLayoutDecoration>();
+    auto entryPointLayout = layoutDecoration ? as<EntryPointLayout>(layoutDecoration->getLayout()) : nullptr;
+    if (!entryPointLayout || entryPointLayout->profile.GetStage() != Stage::Compute)
+        return SLANG_E_NOT_IMPLEMENTED;
+
+    for (auto inst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(inst);
+        if (!func || !func->isDefinition() || func->findDecoration<IRTargetIntrinsicDecoration>())
+            continue;
+
+        _emitFunc(func);
+        if (m_failed)
+            return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    const SpvId entryPointId = _getValueId(entryPoint);
+
+    UInt threadGroupSize[3];
+    spReflectionEntryPoint_getComputeThreadGroupSize((SlangReflectionEntryPoint*)entryPointLayout, 3, threadGroupSize);
+
+    // Assemble the module
+    List<uint32_t> words;
+    words.add(SpvMagicNumber);
+    words.add(SpvVersion);
+    words.add(0);               // Generator
+    words.add(m_nextId);        // Bound
+    words.add(0);               // Schema
+
+    for (auto capability : m_capabilityTracker.getCapabilities())
+        _emitInst(words, SpvOpCapability, capability);
+    for (const auto& extension : m_capabilityTracker.getExtensions())
+    {
+        List<uint32_t> operands;
+        _appendString(operands, extension.getUnownedSlice());
+        _emitInst(words, SpvOpExtension, operands.getBuffer(), operands.getCount());
+    }
+    words.addRange(m_extInstImports);
+    _emitInst(words, SpvOpMemoryModel, SpvAddressingModelLogical, SpvMemoryModelGLSL450);
+
+    {
+        List<uint32_t> operands;
+        operands.add(SpvExecutionModelGLCompute);
+        operands.add(entryPointId);
+        _appendString(operands, UnownedStringSlice::fromLiteral("main"));
+        operands.addRange(m_interfaceIds);
+        _emitInst(words, SpvOpEntryPoint, operands.getBuffer(), operands.getCount());
+    }
+    {
+        uint32_t operands[] = { entryPointId, SpvExecutionModeLocalSize,
+            uint32_t(threadGroupSize[0]), uint32_t(threadGroupSize[1]), uint32_t(threadGroupSize[2]) };
+        _emitInst(words, SpvOpExecutionMode, operands, SLANG_COUNT_OF(operands));
+    }
+
+    words.addRange(m_debugNames);
+    words.addRange(m_annotations);
+    words.addRange(m_globals);
+    words.addRange(m_functions);
+
+    spirvOut.clear();
+    spirvOut.addRange((const uint8_t*)words.getBuffer(), words.getCount() * Index(sizeof(uint32_t)));
+    return SLANG_OK;
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!! emitSPIRVFromIR !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+SlangResult emitSPIRVFromIR(
+    BackEndCompileRequest*  compileRequest,
+    EntryPoint*             entryPoint,
+    TargetRequest*          targetRequest,
+    List<uint8_t>&          spirvOut)
+{
+    spirvOut.clear();
+    if (entryPoint->getStage() != Stage::Compute)
+        return SLANG_E_NOT_IMPLEMENTED;
+
+    // The IR is prepared as it is for GLSL. The extensions GLSL legalization asks for aren't
+    // needed, as the SPIR-V capabilities are worked out from the IR.
+    GLSLExtensionTracker glslExtensionTracker;
+    LinkedIR linkedIR = linkAndOptimizeIR(
+        compileRequest,
+        entryPoint,
+        CodeGenTarget::GLSL,
+        targetRequest,
+        &glslExtensionTracker);
+
+    IRPassProfileScope profileScope(compileRequest->getLinkage()->getProfiler(), "emitSPIRV", linkedIR.module);
+
+    SPIRVEmitter emitter;
+    SlangResult res = emitter.emitModule(linkedIR.module, linkedIR.entryPoint, spirvOut);
+    if (SLANG_FAILED(res))
+        spirvOut.clear();
+    return res;
+}
+
+}
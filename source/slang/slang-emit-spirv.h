@@ -0,0 +1,49 @@
+// slang-emit-spirv.h
+#ifndef SLANG_EMIT_SPIRV_H
+#define SLANG_EMIT_SPIRV_H
+
+#include "../core/slang-basic.h"
+
+#include "slang-compiler.h"
+
+namespace Slang
+{
+
+    /// Records the SPIR-V capabilities and extensions that emitted code requires.
+    ///
+    /// This plays the role for SPIR-V that `GLSLExtensionTracker` plays for GLSL: the emitter
+    /// requires capabilities as it encounters the types and operations that need them, and
+    /// they are written out in the order they were first required.
+class SPIRVCapabilityTracker
+{
+public:
+
+    void requireCapability(uint32_t capability);
+    void requireExtension(const String& name);
+
+    const List<uint32_t>& getCapabilities() const { return m_capabilities; }
+    const List<String>& getExtensions() const { return m_extensions; }
+
+protected:
+    List<uint32_t> m_capabilities;
+    HashSet<uint32_t> m_capabilitySet;
+
+    List<String> m_extensions;
+    HashSet<String> m_extensionSet;
+};
+
+    /// Emit SPIR-V for `entryPoint` directly from the linked and legalized IR, without producing
+    /// GLSL and compiling it with glslang.
+    ///
+    /// Only compute entry points that use a subset of the IR are supported (see the notes at the
+    /// start of `slang-emit-spirv.cpp`). Returns SLANG_E_NOT_IMPLEMENTED, leaving `spirvOut` empty,
+    /// if the entry point uses anything outside that subset, so that the caller can fall back to
+    /// going through GLSL.
+SlangResult emitSPIRVFromIR(
+    BackEndCompileRequest*  compileRequest,
+    EntryPoint*             entryPoint,
+    TargetRequest*          targetRequest,
+    List<uint8_t>&          spirvOut);
+
+}
+#endif
@@ -2,18 +2,28 @@
 #include "slang-emit.h"
 
 #include "../core/slang-writer.h"
+#include "slang-compile-profiler.h"
 #include "slang-ir-bind-existentials.h"
+#include "slang-ir-cse.h"
 #include "slang-ir-dce.h"
+#include "slang-ir-dump.h"
+#include "slang-ir-deduplicate-funcs.h"
 #include "slang-ir-entry-point-uniforms.h"
 #include "slang-ir-glsl-legalize.h"
+#include "slang-ir-inline.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-link.h"
+#include "slang-ir-pass-manager.h"
 #include "slang-ir-restructure.h"
 #include "slang-ir-restructure-scoping.h"
+#include "slang-ir-sccp.h"
+#include "slang-ir-sroa.h"
+#include "slang-ir-specialization-cache.h"
 #include "slang-ir-specialize.h"
 #include "slang-ir-specialize-resources.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-union.h"
+#include "slang-ir-unroll-loops.h"
 #include "slang-ir-validate.h"
 #include "slang-legalize-types.h"
 #include "slang-lower-to-ir.h"
@@ -124,37 +134,566 @@ StructTypeLayout* getGlobalStructLayout(
     return getScopeStructLayout(programLayout);
 }
 
-static void dumpIR(
-    BackEndCompileRequest* compileRequest,
-    IRModule*       irModule,
-    char const*     label)
+LinkedIR linkAndOptimizeIR(
+    BackEndCompileRequest*  compileRequest,
+    EntryPoint*             entryPoint,
+    CodeGenTarget           target,
+    TargetRequest*          targetRequest,
+    GLSLExtensionTracker*   glslExtensionTracker)
 {
-    DiagnosticSinkWriter writerImpl(compileRequest->getSink());
-    WriterHelper writer(&writerImpl);
+    List<EntryPoint*> entryPoints;
+    entryPoints.add(entryPoint);
+    return linkAndOptimizeIR(compileRequest, entryPoints, target, targetRequest, glslExtensionTracker);
+}
+
+LinkedIR linkAndOptimizeIR(
+    BackEndCompileRequest*      compileRequest,
+    const List<EntryPoint*>&    entryPoints,
+    CodeGenTarget               target,
+    TargetRequest*              targetRequest,
+    GLSLExtensionTracker*       glslExtensionTracker,
+    EntryPointCodeReport*       codeReport)
+{
+    auto sink = compileRequest->getSink();
+    auto program = compileRequest->getProgram();
+    auto targetProgram = program->getTargetProgram(targetRequest);
+    auto programLayout = targetProgram->getOrCreateLayout(sink);
+
+    auto session = targetRequest->getSession();
+    auto profiler = compileRequest->getLinkage()->getProfiler();
+
+    // Dumps are named after the (first) entry point and the target, so that those of
+    // different entry points and targets don't overwrite each other
+    StringBuilder dumpName;
+    dumpName << getText(entryPoints[0]->getName()) << "-" << getCodeGenTargetName(target);
+    IRDumper irDumper(compileRequest, dumpName);
+
+    // We start out by performing "linking" at the level of the IR.
+    // This step will create a fresh IR module to be used for
+    // code generation, and will copy in any IR definitions that
+    // the desired entry point requires. Along the way it will
+    // resolve references to imported/exported symbols across
+    // modules, and also select between the definitions of
+    // any "profile-overloaded" symbols.
+    //
+    LinkedIR linkedIR;
+    {
+        IRPassProfileScope profileScope(profiler, "linkIR", nullptr);
+        linkedIR = linkIR(
+            compileRequest,
+            entryPoints,
+            programLayout,
+            target,
+            targetRequest);
+        profileScope.setModule(linkedIR.module);
+    }
+    auto irModule = linkedIR.module;
+    auto irEntryPoint = linkedIR.entryPoint;
+
+    irModule->budget = compileRequest->getLinkage()->getBudget();
+
+    if (codeReport)
+        codeReport->addStage("link", irModule);
+
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    // If the user specified the flag that they want us to dump
+    // IR, then do it here, for the target-specific, but
+    // un-specialized IR.
+    irDumper.dumpIfEnabled(irModule, nullptr);
+
+    // The remaining passes are run through a pass manager, so that
+    // analyses can be shared between passes, and passes that have
+    // nothing to work on in this module can be skipped.
+    //
+    IRPassManager passManager(irModule, profiler);
+
+    // When not optimizing, only the passes needed to make the code legal for
+    // the target are run, so that iterating on shaders is as fast as possible.
+    // Clean-up passes are skipped, and the downstream compiler is left to deal
+    // with local variables and duplicated code.
+    //
+    const bool optimize = compileRequest->getLinkage()->optimizationLevel != OptimizationLevel::None;
+
+    static const IROp kBindExistentialSlotsOps[] = { kIROp_BindGlobalExistentialSlots, kIROp_BindExistentialSlotsDecoration };
+    static const IROp kUnionOps[] = { kIROp_TaggedUnionType, kIROp_ExtractTaggedUnionTag, kIROp_ExtractTaggedUnionPayload };
+    static const IROp kExistentialBoxOps[] = { kIROp_ExistentialBoxType };
+
+    // When there are top-level existential-type parameters
+    // to the shader, we need to take the side-band information
+    // on how the existential "slots" were bound to concrete
+    // types, and use it to introduce additional explicit
+    // shader parameters for those slots, to be wired up to
+    // use sites.
+    //
+    passManager.runPass(IRPassDesc("bindExistentialSlots").setTriggerOps(kBindExistentialSlotsOps), [&]()
+    {
+        bindExistentialSlots(irModule, sink);
+    });
+    irDumper.dumpPassIfEnabled(irModule, "EXISTENTIALS BOUND");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+
+
+
+
+    // Now that we've linked the IR code, any layout/binding
+    // information has been attached to shader parameters
+    // and entry points. Now we are safe to make transformations
+    // that might move code without worrying about losing
+    // the connection between a parameter and its layout.
+    //
+    // An easy transformation of this kind is to take uniform
+    // parameters of a shader entry point and move them into
+    // the global scope instead.
+    //
+    passManager.runPass(IRPassDesc("moveEntryPointUniformParamsToGlobalScope"), [&]()
+    {
+        moveEntryPointUniformParamsToGlobalScope(irModule);
+    });
+    irDumper.dumpPassIfEnabled(irModule, "ENTRY POINT UNIFORMS MOVED");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    // Desguar any union types, since these will be illegal on
+    // various targets.
+    //
+    passManager.runPass(IRPassDesc("desugarUnionTypes").setTriggerOps(kUnionOps), [&]()
+    {
+        desugarUnionTypes(irModule);
+    });
+    irDumper.dumpPassIfEnabled(irModule, "UNIONS DESUGARED");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    // Next, we need to ensure that the code we emit for
+    // the target doesn't contain any operations that would
+    // be illegal on the target platform. For example,
+    // none of our target supports generics, or interfaces,
+    // so we need to specialize those away.
+    //
+    // Simplification of existential-based and generics-based
+    // code may each open up opportunities for the other, so
+    // the relevant specialization transformations are handled in a
+    // single pass that looks for all simplification opportunities.
+    //
+    // TODO: We also need to extend this pass so that it will "expose"
+    // existential values that are nested inside of other types,
+    // so that the simplifications can be applied.
+    //
+    // TODO: This pass is *also* likely to be the place where we
+    // perform specialization of functions based on parameter
+    // values that need to be compile-time constants.
+    //
+    passManager.runPass(IRPassDesc("specializeModule"), [&]()
+    {
+        specializeModule(irModule, targetProgram->getIRSpecializationCache());
+    });
+
+    // Debugging code for IR transformations...
+    irDumper.dumpPassIfEnabled(irModule, "SPECIALIZED");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+
+    // Specialization can introduce dead code that could trip
+    // up downstream passes like type legalization, so we
+    // will run a DCE pass to clean up after the specialization.
+    //
+    // TODO: Are there other cleanup optimizations we should
+    // apply at this point?
+    //
+    passManager.runPass(IRPassDesc("eliminateDeadCode"), [&]()
+    {
+        eliminateDeadCode(compileRequest, irModule);
+    });
+    irDumper.dumpPassIfEnabled(irModule, "AFTER DCE");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    if (codeReport)
+        codeReport->addStage("specialize", irModule);
+
+    // From here on the module only contains live code, so the
+    // clean-up DCE passes between legalization steps only need
+    // to look at what those steps created or stopped using.
+    //
+    irModule->beginTrackingDirtyInsts();
+
+    // The Slang language allows interfaces to be used like
+    // ordinary types (including placing them in constant
+    // buffers and entry-point parameter lists), but then
+    // getting them to lay out in a reasonable way requires
+    // us to treat fields/variables with interface type
+    // *as if* they were pointers to heap-allocated "objects."
+    //
+    // Specialization will have replaced fields/variables
+    // with interface types like `IFoo` with fields/variables
+    // with pointer-like types like `ExistentialBox<SomeType>`.
+    //
+    // We need to legalize these pointer-like types away,
+    // which involves two main changes:
+    //
+    //  1. Any `ExistentialBox<...>` fields need to be moved
+    //  out of their enclosing `struct` type, so that the layout
+    //  of the enclosing type is computed as if the field had
+    //  zero size.
+    //
+    //  2. Once an `ExistentialBox<X>` has been floated out
+    //  of its parent and landed somwhere permanent (e.g., either
+    //  a dedicated variable, or a field of constant buffer),
+    //  we need to replace it with just an `X`, after which we
+    //  will have (more) legal shader code.
+    //
+    passManager.runPass(IRPassDesc("legalizeExistentialTypeLayout").setTriggerOps(kExistentialBoxOps), [&]()
+    {
+        legalizeExistentialTypeLayout(
+            irModule,
+            sink,
+            targetProgram->getIRTypeLegalizationCache());
+    });
+    if (optimize)
+    {
+        passManager.runPass(IRPassDesc("eliminateDeadCodeIncremental"), [&]()
+        {
+            eliminateDeadCodeIncremental(compileRequest, irModule);
+        });
+    }
+
+    irDumper.dumpPassIfEnabled(irModule, "EXISTENTIALS LEGALIZED");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    // Many of our target languages and/or downstream compilers
+    // don't support `struct` types that have resource-type fields.
+    // In order to work around this limitation, we will rewrite the
+    // IR so that any structure types with resource-type fields get
+    // split into a "tuple" that comprises the ordinary fields (still
+    // bundles up as a `struct`) and one element for each resource-type
+    // field (recursively).
+    //
+    // What used to be individual variables/parameters/arguments/etc.
+    // then become multiple variables/parameters/arguments/etc.
+    //
+    passManager.runPass(IRPassDesc("legalizeResourceTypes"), [&]()
+    {
+        legalizeResourceTypes(
+            irModule,
+            sink,
+            targetProgram->getIRTypeLegalizationCache());
+    });
+    if (optimize)
+    {
+        passManager.runPass(IRPassDesc("eliminateDeadCodeIncremental"), [&]()
+        {
+            eliminateDeadCodeIncremental(compileRequest, irModule);
+        });
+    }
+
+    //  Debugging output of legalization
+    irDumper.dumpPassIfEnabled(irModule, "LEGALIZED");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    // Once specialization and type legalization have been performed,
+    // we should perform some of our basic optimization steps again,
+    // to see if we can clean up any temporaries created by legalization.
+    // (e.g., things that used to be aggregated might now be split up,
+    // so that we can work with the individual fields).
+    //
+    // Local `struct` and array variables that have individual fields
+    // or elements written can't be promoted as a whole, so we first
+    // split them into a variable per field/element, each of which
+    // can then be promoted on its own.
+    //
+    // When not optimizing, only variables of resource type (which
+    // targets don't allow) are promoted.
+    //
+    Index splitVarCount = 0;
+    if (optimize)
+    {
+        passManager.runPass(IRPassDesc("splitAggregateVars"), [&]()
+        {
+            splitVarCount = splitAggregateVars(irModule);
+        });
+    }
+    passManager.runPass(IRPassDesc("constructSSA"), [&]()
+    {
+        constructSSA(irModule, optimize ? SSAPromotion::All : SSAPromotion::Required);
+    });
+
+    irDumper.dumpPassIfEnabled(irModule, "AFTER SSA");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    if (codeReport)
+        codeReport->addStage("legalize", irModule);
+
+    // After type legalization and subsequent SSA cleanup we expect
+    // that any resource types passed to functions are exposed
+    // as their own top-level parameters (which might have
+    // resource or array-of-...-resource types).
+    //
+    // Many of our targets place restrictions on how certain
+    // resource types can be used, so that having them as
+    // function parameters is invalid. To clean this up,
+    // we will try to specialize called functions based
+    // on the actual resources that are being passed to them
+    // at specific call sites.
+    //
+    // Because the legalization may depend on what target
+    // we are compiling for (certain things might be okay
+    // for D3D targets that are not okay for Vulkan), we
+    // pass down the target request along with the IR.
+    //
+    passManager.runPass(IRPassDesc("specializeResourceParameters"), [&]()
+    {
+        specializeResourceParameters(compileRequest, targetRequest, irModule, targetProgram->getIRSpecializationCache());
+    });
 
-    if(label)
+    irDumper.dumpPassIfEnabled(irModule, "AFTER RESOURCE SPECIALIZATION");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+
+    // For GLSL only, we will need to perform "legalization" of
+    // the entry point and any entry-point parameters.
+    //
+    // TODO: We should consider moving this legalization work
+    // as late as possible, so that it doesn't affect how other
+    // optimization passes need to work.
+    //
+    switch (target)
+    {
+    case CodeGenTarget::GLSL:
+    {
+        // GLSL has a single entry point per module
+        SLANG_ASSERT(linkedIR.entryPoints.getCount() == 1);
+
+        passManager.runPass(IRPassDesc("legalizeEntryPointForGLSL"), [&]()
+        {
+            legalizeEntryPointForGLSL(
+                session,
+                irModule,
+                irEntryPoint,
+                compileRequest->getSink(),
+                glslExtensionTracker);
+        });
+
+            irDumper.dumpPassIfEnabled(irModule, "GLSL LEGALIZED");
+            validateIRModuleIfEnabled(compileRequest, irModule);
+    }
+    break;
+
+    default:
+        break;
+    }
+
+    // The resource-based specialization pass above
+    // may create specialized versions of functions, but
+    // it does not try to completely eliminate the original
+    // functions, so there might still be invalid code in
+    // our IR module.
+    //
+    // To clean up the code, we will apply a fairly general
+    // dead-code-elimination (DCE) pass that only retains
+    // whatever code is "live." This is a full pass, so that
+    // anything the incremental passes can't prove dead
+    // (such as cycles of unused code) is not emitted.
+    //
+    irModule->endTrackingDirtyInsts();
+    passManager.runPass(IRPassDesc("eliminateDeadCode"), [&]()
+    {
+        eliminateDeadCode(compileRequest, irModule);
+    });
+
+    // Now that only live functions are left, we inline calls to
+    // small functions, and functions that are only called once, so
+    // that deep chains of helpers don't reach the downstream compiler.
+    // How much is inlined depends on the optimization level.
+    //
+    // Inlining substitutes arguments into the callee bodies, which
+    // can make more values constant, and leaves the inlined functions
+    // unused, so we follow it with SCCP and DCE.
+    //
+    static const IROp kCallOps[] = { kIROp_Call };
+    const auto inliningOptions = IRInliningOptions::getForOptimizationLevel(
+        SlangOptimizationLevel(compileRequest->getLinkage()->optimizationLevel));
+    Index inlinedCallCount = 0;
+    if (inliningOptions.isEnabled())
+    {
+        passManager.runPass(IRPassDesc("inlineFunctionCalls").setTriggerOps(kCallOps), [&]()
+        {
+            inlinedCallCount = inlineFunctionCalls(irModule, inliningOptions);
+        });
+    }
+
+    // Loops with constant trip counts are unrolled next (after inlining, so
+    // that constant arguments have been substituted into loops in callees).
+    // How much is unrolled also depends on the optimization level: by
+    // default only loops marked `[unroll]` are unrolled. Unrolling makes
+    // the loop counter constant in each copy of the body, so it is also
+    // followed by SCCP and DCE. SCCP also runs first, so that loop bounds
+    // written with casts (e.g. `uint i = 0`) have been folded to literals.
+    //
+    static const IROp kLoopOps[] = { kIROp_loop };
+    const auto unrollOptions = IRLoopUnrollOptions::getForOptimizationLevel(
+        SlangOptimizationLevel(compileRequest->getLinkage()->optimizationLevel));
+    Index unrolledLoopCount = 0;
+    if (unrollOptions.mode != IRLoopUnrollMode::None)
+    {
+        passManager.runPass(IRPassDesc("applySparseConditionalConstantPropagation").setTriggerOps(kLoopOps), [&]()
+        {
+            applySparseConditionalConstantPropagation(irModule);
+        });
+        passManager.runPass(IRPassDesc("unrollLoops").setTriggerOps(kLoopOps), [&]()
+        {
+            unrolledLoopCount = unrollLoops(irModule, unrollOptions);
+        });
+    }
+    if (inlinedCallCount || unrolledLoopCount)
     {
-        writer.put("### ");
-        writer.put(label);
-        writer.put(":\n");
+        passManager.runPass(IRPassDesc("applySparseConditionalConstantPropagation"), [&]()
+        {
+            applySparseConditionalConstantPropagation(irModule);
+        });
+        passManager.runPass(IRPassDesc("eliminateDeadCode"), [&]()
+        {
+            eliminateDeadCode(compileRequest, irModule);
+        });
     }
 
-    dumpIR(irModule, writer.getWriter());
+    // Function bodies can compute the same values many times, especially
+    // once calls have been inlined, so we remove the redundant instructions
+    // (including repeated loads of uniform parameters).
+    //
+    Index eliminatedInstCount = 0;
+    if (optimize)
+    {
+        passManager.runPass(IRPassDesc("eliminateCommonSubexpressions", IRAnalysisFlag::DominatorTrees), [&]()
+        {
+            eliminatedInstCount = eliminateCommonSubexpressions(irModule, &passManager);
+        });
+    }
+    validateIRModuleIfEnabled(compileRequest, irModule);
+
+    // Specialization (of generics, and of functions on the resources
+    // passed to them) can leave us with functions that are identical
+    // apart from their names. Only the live ones are left after DCE,
+    // so we merge those, to avoid emitting the same code repeatedly.
+    //
+    Index deduplicatedFuncCount = 0;
+    if (optimize)
+    {
+        passManager.runPass(IRPassDesc("deduplicateFunctions"), [&]()
+        {
+            deduplicatedFuncCount = deduplicateFunctions(irModule);
+        });
+    }
+    if(profiler)
+    {
+        profiler->addCounter("ir-split-aggregate-vars", splitVarCount);
+        profiler->addCounter("ir-inlined-calls", inlinedCallCount);
+        profiler->addCounter("ir-unrolled-loops", unrolledLoopCount);
+        profiler->addCounter("ir-cse-eliminated-insts", eliminatedInstCount);
+        profiler->addCounter("ir-deduplicated-funcs", deduplicatedFuncCount);
+        profiler->addCounter("skipped-ir-passes", passManager.getSkippedPassCount());
+        profiler->addCounter("ir-gvn-hits", irModule->gvnHitCount);
+        profiler->addCounter("ir-gvn-misses", irModule->gvnMissCount);
+
+        // The specialization cache is shared by all entry points on the target,
+        // so these are running totals.
+        auto specializationCache = targetProgram->getIRSpecializationCache();
+        profiler->addCounter("ir-specialization-cache-hits", specializationCache->hitCount);
+        profiler->addCounter("ir-specialization-cache-misses", specializationCache->missCount);
+
+        auto typeLegalizationCache = targetProgram->getIRTypeLegalizationCache();
+        profiler->addCounter("ir-type-legalization-cache-hits", typeLegalizationCache->hitCount);
+        profiler->addCounter("ir-type-legalization-cache-misses", typeLegalizationCache->missCount);
+        profiler->addCounter("ir-wrapped-buffer-layout-cache-hits", typeLegalizationCache->wrappedBufferLayoutHitCount);
+        profiler->addCounter("ir-wrapped-buffer-layout-cache-misses", typeLegalizationCache->wrappedBufferLayoutMissCount);
+    }
+    irDumper.dumpPassIfEnabled(irModule, "AFTER DCE");
+    validateIRModuleIfEnabled(compileRequest, irModule);
+    endIRValidation(irModule);
 
-    if( label )
+    if (codeReport)
     {
-        writer.put("###\n");
+        codeReport->addStage("optimize", irModule);
+        codeReport->peakLiveValueCount = EntryPointCodeReport::calcPeakLiveValueCount(irModule);
     }
+
+    return linkedIR;
 }
 
-static void dumpIRIfEnabled(
-    BackEndCompileRequest* compileRequest,
-    IRModule*       irModule,
-    char const*     label = nullptr)
+    /// Record which global parameters of the program are used by the code for the entry points.
+    ///
+    /// Parameters may have been split apart by legalization, so a parameter is found to
+    /// be used if any of the bindings of a shader parameter left in the IR module overlap
+    /// the bindings of one of its leaves.
+    ///
+static void _recordUsedGlobalParameters(
+    ProgramLayout*                  programLayout,
+    IRModule*                       irModule,
+    const List<EntryPointLayout*>&  entryPointLayouts)
 {
-    if(compileRequest->shouldDumpIR)
+    struct UsedRange
+    {
+        LayoutResourceKind  kind;
+        UInt                space;
+        UInt                begin;
+        LayoutSize          count;
+    };
+    List<UsedRange> usedRanges;
+
+    for( auto inst : irModule->getGlobalInsts() )
+    {
+        auto param = as<IRGlobalParam>(inst);
+        if(!param)
+            continue;
+        auto layoutDecoration = param->findDecoration<IRLayoutDecoration>();
+        auto varLayout = layoutDecoration ? as<VarLayout>(layoutDecoration->getLayout()) : nullptr;
+        if(!varLayout)
+            continue;
+
+        UInt registerSpace = 0;
+        if( auto resInfo = varLayout->FindResourceInfo(LayoutResourceKind::RegisterSpace) )
+            registerSpace = resInfo->index;
+
+        for( auto& resInfo : varLayout->resourceInfos )
+        {
+            auto typeResInfo = varLayout->typeLayout->FindResourceInfo(resInfo.kind);
+            if(!typeResInfo)
+                continue;
+
+            UsedRange range;
+            range.kind = resInfo.kind;
+            range.space = resInfo.space + registerSpace;
+            range.begin = resInfo.index;
+            range.count = typeResInfo->count;
+            usedRanges.add(range);
+        }
+    }
+
+    UIntSet usedGlobalParameters;
+    for( auto& entry : programLayout->bindingTable )
+    {
+        if( entry.parameterIndex < 0 || entry.kind == LayoutResourceKind::Uniform )
+            continue;
+        if( usedGlobalParameters.contains(UInt(entry.parameterIndex)) )
+            continue;
+
+        for( auto& range : usedRanges )
+        {
+            if( range.kind != entry.kind || range.space != entry.space )
+                continue;
+
+            // The ranges overlap if each starts before the other ends
+            if( entry.count > range.begin - Math::Min(range.begin, entry.index) &&
+                range.count > entry.index - Math::Min(entry.index, range.begin) )
+            {
+                usedGlobalParameters.add(UInt(entry.parameterIndex));
+                break;
+            }
+        }
+    }
+
+    for( auto entryPointLayout : entryPointLayouts )
     {
-        dumpIR(compileRequest, irModule, label);
+        entryPointLayout->usedGlobalParameters = usedGlobalParameters;
+        entryPointLayout->hasUsedGlobalParameters = true;
     }
 }
 
@@ -162,8 +701,32 @@ String emitEntryPoint(
     BackEndCompileRequest*  compileRequest,
     EntryPoint*             entryPoint,
     CodeGenTarget           target,
-    TargetRequest*          targetRequest)
+    TargetRequest*          targetRequest,
+    ISlangBlob**            outSourceMap)
+{
+    List<EntryPoint*> entryPoints;
+    entryPoints.add(entryPoint);
+    return emitEntryPoints(
+        compileRequest,
+        entryPoints,
+        getEffectiveProfile(entryPoint, targetRequest),
+        target,
+        targetRequest,
+        outSourceMap);
+}
+
+String emitEntryPoints(
+    BackEndCompileRequest*      compileRequest,
+    const List<EntryPoint*>&    entryPoints,
+    Profile                     effectiveProfile,
+    CodeGenTarget               target,
+    TargetRequest*              targetRequest,
+    ISlangBlob**                outSourceMap)
 {
+    // Target-specific state that only applies to a single entry point (such as
+    // the GLSL ray tracing built-ins) is taken from the first one.
+    auto entryPoint = entryPoints[0];
+
     auto sink = compileRequest->getSink();
     auto program = compileRequest->getProgram();
     auto targetProgram = program->getTargetProgram(targetRequest);
@@ -190,8 +753,9 @@ String emitEntryPoint(
     desc.compileRequest = compileRequest;
     desc.target = target;
     desc.entryPoint = entryPoint;
-    desc.effectiveProfile = getEffectiveProfile(entryPoint, targetRequest);
+    desc.effectiveProfile = effectiveProfile;
     desc.sourceWriter = &sourceWriter;
+    desc.useShortNames = (targetRequest->targetFlags & SLANG_TARGET_FLAG_SHORT_NAMES) != 0;
 
     if (entryPoint && programLayout)
     {
@@ -207,6 +771,22 @@ String emitEntryPoint(
     StructTypeLayout* globalStructLayout = programLayout ? getGlobalStructLayout(programLayout) : nullptr;
     desc.globalStructLayout = globalStructLayout;
 
+    // If a code report is being collected, the size of the code is recorded
+    // at the major stages of linking and optimization, and once it is emitted.
+    //
+    auto codeReport = compileRequest->getLinkage()->getCodeReport();
+    EntryPointCodeReport entryPointCodeReport;
+    if (codeReport)
+    {
+        StringBuilder names;
+        for (auto ep : entryPoints)
+        {
+            names << (names.getLength() ? "," : "") << getText(ep->getName());
+        }
+        entryPointCodeReport.entryPointName = names.ProduceString();
+        entryPointCodeReport.targetName = getCodeGenTargetName(target);
+    }
+
     RefPtr<CLikeSourceEmitter> sourceEmitter;
 
     typedef CLikeSourceEmitter::SourceStyle SourceStyle;
@@ -238,265 +818,39 @@ String emitEntryPoint(
         return String();
     }
     {
-        auto session = targetRequest->getSession();
-
-        // We start out by performing "linking" at the level of the IR.
-        // This step will create a fresh IR module to be used for
-        // code generation, and will copy in any IR definitions that
-        // the desired entry point requires. Along the way it will
-        // resolve references to imported/exported symbols across
-        // modules, and also select between the definitions of
-        // any "profile-overloaded" symbols.
+        // We start out by linking the IR for the entry point and running
+        // the passes that make it legal for the target.
         //
-        auto linkedIR = linkIR(
+        LinkedIR linkedIR = linkAndOptimizeIR(
             compileRequest,
-            entryPoint,
-            programLayout,
+            entryPoints,
             target,
-            targetRequest);
+            targetRequest,
+            sourceEmitter->getGLSLExtensionTracker(),
+            codeReport ? &entryPointCodeReport : nullptr);
         auto irModule = linkedIR.module;
-        auto irEntryPoint = linkedIR.entryPoint;
-
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "LINKED");
-#endif
-
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // If the user specified the flag that they want us to dump
-        // IR, then do it here, for the target-specific, but
-        // un-specialized IR.
-        dumpIRIfEnabled(compileRequest, irModule);
-
-        // When there are top-level existential-type parameters
-        // to the shader, we need to take the side-band information
-        // on how the existential "slots" were bound to concrete
-        // types, and use it to introduce additional explicit
-        // shader parameters for those slots, to be wired up to
-        // use sites.
-        //
-        bindExistentialSlots(irModule, sink);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS BOUND");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-
-
-
-
-        // Now that we've linked the IR code, any layout/binding
-        // information has been attached to shader parameters
-        // and entry points. Now we are safe to make transformations
-        // that might move code without worrying about losing
-        // the connection between a parameter and its layout.
-        //
-        // An easy transformation of this kind is to take uniform
-        // parameters of a shader entry point and move them into
-        // the global scope instead.
-        //
-        moveEntryPointUniformParamsToGlobalScope(irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "ENTRY POINT UNIFORMS MOVED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // Desguar any union types, since these will be illegal on
-        // various targets.
-        //
-        desugarUnionTypes(irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "UNIONS DESUGARED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // Next, we need to ensure that the code we emit for
-        // the target doesn't contain any operations that would
-        // be illegal on the target platform. For example,
-        // none of our target supports generics, or interfaces,
-        // so we need to specialize those away.
-        //
-        // Simplification of existential-based and generics-based
-        // code may each open up opportunities for the other, so
-        // the relevant specialization transformations are handled in a
-        // single pass that looks for all simplification opportunities.
-        //
-        // TODO: We also need to extend this pass so that it will "expose"
-        // existential values that are nested inside of other types,
-        // so that the simplifications can be applied.
-        //
-        // TODO: This pass is *also* likely to be the place where we
-        // perform specialization of functions based on parameter
-        // values that need to be compile-time constants.
-        //
-        specializeModule(irModule);
-
-        // Debugging code for IR transformations...
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "SPECIALIZED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-
-        // Specialization can introduce dead code that could trip
-        // up downstream passes like type legalization, so we
-        // will run a DCE pass to clean up after the specialization.
-        //
-        // TODO: Are there other cleanup optimizations we should
-        // apply at this point?
-        //
-        eliminateDeadCode(compileRequest, irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // The Slang language allows interfaces to be used like
-        // ordinary types (including placing them in constant
-        // buffers and entry-point parameter lists), but then
-        // getting them to lay out in a reasonable way requires
-        // us to treat fields/variables with interface type
-        // *as if* they were pointers to heap-allocated "objects."
-        //
-        // Specialization will have replaced fields/variables
-        // with interface types like `IFoo` with fields/variables
-        // with pointer-like types like `ExistentialBox<SomeType>`.
-        //
-        // We need to legalize these pointer-like types away,
-        // which involves two main changes:
-        //
-        //  1. Any `ExistentialBox<...>` fields need to be moved
-        //  out of their enclosing `struct` type, so that the layout
-        //  of the enclosing type is computed as if the field had
-        //  zero size.
-        //
-        //  2. Once an `ExistentialBox<X>` has been floated out
-        //  of its parent and landed somwhere permanent (e.g., either
-        //  a dedicated variable, or a field of constant buffer),
-        //  we need to replace it with just an `X`, after which we
-        //  will have (more) legal shader code.
-        //
-        legalizeExistentialTypeLayout(
-            irModule,
-            sink);
-        eliminateDeadCode(compileRequest, irModule);
 
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "EXISTENTIALS LEGALIZED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // Many of our target languages and/or downstream compilers
-        // don't support `struct` types that have resource-type fields.
-        // In order to work around this limitation, we will rewrite the
-        // IR so that any structure types with resource-type fields get
-        // split into a "tuple" that comprises the ordinary fields (still
-        // bundles up as a `struct`) and one element for each resource-type
-        // field (recursively).
-        //
-        // What used to be individual variables/parameters/arguments/etc.
-        // then become multiple variables/parameters/arguments/etc.
-        //
-        legalizeResourceTypes(
-            irModule,
-            sink);
-        eliminateDeadCode(compileRequest, irModule);
-
-        //  Debugging output of legalization
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "LEGALIZED");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // Once specialization and type legalization have been performed,
-        // we should perform some of our basic optimization steps again,
-        // to see if we can clean up any temporaries created by legalization.
-        // (e.g., things that used to be aggregated might now be split up,
-        // so that we can work with the individual fields).
-        constructSSA(irModule);
-
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER SSA");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-        // After type legalization and subsequent SSA cleanup we expect
-        // that any resource types passed to functions are exposed
-        // as their own top-level parameters (which might have
-        // resource or array-of-...-resource types).
-        //
-        // Many of our targets place restrictions on how certain
-        // resource types can be used, so that having them as
-        // function parameters is invalid. To clean this up,
-        // we will try to specialize called functions based
-        // on the actual resources that are being passed to them
-        // at specific call sites.
-        //
-        // Because the legalization may depend on what target
-        // we are compiling for (certain things might be okay
-        // for D3D targets that are not okay for Vulkan), we
-        // pass down the target request along with the IR.
-        //
-        specializeResourceParameters(compileRequest, targetRequest, irModule);
-
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER RESOURCE SPECIALIZATION");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
-
-        // For GLSL only, we will need to perform "legalization" of
-        // the entry point and any entry-point parameters.
-        //
-        // TODO: We should consider moving this legalization work
-        // as late as possible, so that it doesn't affect how other
-        // optimization passes need to work.
-        //
-        switch (target)
-        {
-        case CodeGenTarget::GLSL:
+        if( programLayout )
         {
-            legalizeEntryPointForGLSL(
-                session,
-                irModule,
-                irEntryPoint,
-                compileRequest->getSink(),
-                sourceEmitter->getGLSLExtensionTracker());
-
-#if 0
-                dumpIRIfEnabled(compileRequest, irModule, "GLSL LEGALIZED");
-#endif
-                validateIRModuleIfEnabled(compileRequest, irModule);
-        }
-        break;
-
-        default:
-            break;
+            List<EntryPointLayout*> entryPointLayouts;
+            for( auto ep : entryPoints )
+            {
+                if( auto entryPointLayout = findEntryPointLayout(programLayout, ep) )
+                    entryPointLayouts.add(entryPointLayout);
+            }
+            _recordUsedGlobalParameters(programLayout, irModule, entryPointLayouts);
         }
 
-        // The resource-based specialization pass above
-        // may create specialized versions of functions, but
-        // it does not try to completely eliminate the original
-        // functions, so there might still be invalid code in
-        // our IR module.
-        //
-        // To clean up the code, we will apply a fairly general
-        // dead-code-elimination (DCE) pass that only retains
-        // whatever code is "live."
-        //
-        eliminateDeadCode(compileRequest, irModule);
-#if 0
-        dumpIRIfEnabled(compileRequest, irModule, "AFTER DCE");
-#endif
-        validateIRModuleIfEnabled(compileRequest, irModule);
-
         // After all of the required optimization and legalization
         // passes have been performed, we can emit target code from
         // the IR module.
         //
         // TODO: do we want to emit directly from IR, or translate the
         // IR back into AST for emission?
-        sourceEmitter->emitModule(irModule);
+        {
+            IRPassProfileScope profileScope(compileRequest->getLinkage()->getProfiler(), "emitModule", irModule);
+            sourceEmitter->emitModule(irModule);
+        }
     }
 
     // Deal with cases where a particular stage requires certain GLSL versions
@@ -520,8 +874,16 @@ String emitEntryPoint(
         break;
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    // Take the code emitted so far out of the writer. Its text isn't copied.
+    SourceTextBuffer code;
+    sourceWriter.takeContent(code);
+
+    // Keep the map for just the code (the prefix written below isn't mapped)
+    SourceMap sourceMap;
+    if (lineDirectiveMode == LineDirectiveMode::SourceMap && outSourceMap)
+    {
+        sourceMap = sourceWriter.getSourceMap();
+    }
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -531,16 +893,34 @@ String emitEntryPoint(
 
     sourceEmitter->emitLayoutDirectives(targetRequest);
 
-    String prefix = sourceWriter.getContent();
-    
-    StringBuilder finalResultBuilder;
-    finalResultBuilder << prefix;
+    // The prefix is followed by the extension lines and then the code. Splicing the
+    // buffers together only moves segments, so the text is copied just once, when
+    // the final string is produced.
+    SourceTextBuffer finalResultBuffer;
+    sourceWriter.takeContent(finalResultBuffer);
+
+    finalResultBuffer.appendSegment(sourceEmitter->getGLSLExtensionTracker()->getExtensionRequireLines());
 
-    finalResultBuilder << sourceEmitter->getGLSLExtensionTracker()->getExtensionRequireLines();
+    if (lineDirectiveMode == LineDirectiveMode::SourceMap && outSourceMap)
+    {
+        // The map was recorded relative to the start of the code, which follows the prefix
+        sourceMap.offsetGeneratedLines(uint32_t(finalResultBuffer.countNewLines()));
+
+        List<uint8_t> sourceMapData;
+        sourceMap.write(sourceMapData);
+        *outSourceMap = createListBlob(sourceMapData).detach();
+    }
 
-    finalResultBuilder << code;
+    finalResultBuffer.appendBuffer(code);
 
-    String finalResult = finalResultBuilder.ProduceString();
+    String finalResult = finalResultBuffer.produceString();
+
+    if (codeReport)
+    {
+        entryPointCodeReport.sourceByteCount = finalResult.getLength();
+        entryPointCodeReport.temporaryCount = sourceEmitter->getTemporaryCount();
+        codeReport->addEntryPoint(entryPointCodeReport);
+    }
 
     return finalResult;
 }
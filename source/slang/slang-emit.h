@@ -5,13 +5,41 @@
 #include "../core/slang-basic.h"
 
 #include "slang-compiler.h"
+#include "slang-ir-link.h"
 
 namespace Slang
 {
     class EntryPoint;
+    struct EntryPointCodeReport;
+    class GLSLExtensionTracker;
     class ProgramLayout;
     class TranslationUnitRequest;
 
+        /// Link the IR for `entryPoint` on `target`, and run the passes that specialize and
+        /// legalize it, so that code for the target can be emitted from the linked module.
+        ///
+        /// Extensions and versions that GLSL legalization requires are recorded in `glslExtensionTracker`.
+    LinkedIR linkAndOptimizeIR(
+        BackEndCompileRequest*  compileRequest,
+        EntryPoint*             entryPoint,
+        CodeGenTarget           target,
+        TargetRequest*          targetRequest,
+        GLSLExtensionTracker*   glslExtensionTracker);
+
+        /// Link the IR for all of `entryPoints` into one module, and run the same passes as
+        /// for a single entry point. Used when the entry points are compiled as one library.
+        /// GLSL is not supported, as a GLSL module can only have one entry point.
+        ///
+        /// If `codeReport` is set, the instructions in the module after each of the major
+        /// stages, and the peak number of live values in the result, are recorded in it.
+    LinkedIR linkAndOptimizeIR(
+        BackEndCompileRequest*      compileRequest,
+        const List<EntryPoint*>&    entryPoints,
+        CodeGenTarget               target,
+        TargetRequest*              targetRequest,
+        GLSLExtensionTracker*       glslExtensionTracker,
+        EntryPointCodeReport*       codeReport = nullptr);
+
     // Emit code for a single entry point, based on
     // the input translation unit.
     String emitEntryPoint(
@@ -22,6 +50,21 @@ namespace Slang
         CodeGenTarget           target,
 
         // The full target request
-        TargetRequest*          targetRequest);
+        TargetRequest*          targetRequest,
+
+        // If set, receives the source map in LineDirectiveMode::SourceMap (with a reference added)
+        ISlangBlob**            outSourceMap = nullptr);
+
+        /// Emit code for all of `entryPoints` in one module, for a target that
+        /// supports libraries of entry points (such as HLSL compiled to a `lib_*` profile).
+        /// `effectiveProfile` is the profile the module as a whole is compiled for.
+        /// With LineDirectiveMode::SourceMap, the source map for the code is written to `outSourceMap` (if set).
+    String emitEntryPoints(
+        BackEndCompileRequest*      compileRequest,
+        const List<EntryPoint*>&    entryPoints,
+        Profile                     effectiveProfile,
+        CodeGenTarget               target,
+        TargetRequest*              targetRequest,
+        ISlangBlob**                outSourceMap = nullptr);
 }
 #endif
@@ -2,10 +2,13 @@
 
 #include "../../slang-com-ptr.h"
 #include "../core/slang-io.h"
+#include "../core/slang-mapped-file-blob.h"
 #include "../core/slang-string-util.h"
 
 #include "slang-compiler.h"
 
+#include <atomic>
+
 namespace Slang
 {
 
@@ -13,6 +16,7 @@ namespace Slang
 static const Guid IID_ISlangUnknown = SLANG_UUID_ISlangUnknown;
 static const Guid IID_ISlangFileSystem = SLANG_UUID_ISlangFileSystem;
 static const Guid IID_ISlangFileSystemExt = SLANG_UUID_ISlangFileSystemExt;
+static const Guid IID_ISlangBlob = SLANG_UUID_ISlangBlob;
 
 // Cacluate a combined path, just using Path:: string processing
 static SlangResult _calcCombinedPath(SlangPathType fromPathType, const char* fromPath, const char* path, ISlangBlob** pathOut)
@@ -108,6 +112,17 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
         return SLANG_E_NOT_FOUND;
     }
 
+    // Large files are mapped rather than read, and the mapping is shared with any other
+    // file system (such as the CacheFileSystem of another Linkage) that loads the same file
+    {
+        ComPtr<ISlangBlob> mappedBlob;
+        if (SLANG_SUCCEEDED(MappedFileBlob::loadShared(path, mappedBlob)))
+        {
+            *outBlob = mappedBlob.detach();
+            return SLANG_OK;
+        }
+    }
+
     try
     {
         String sourceString = File::readAllText(path);
@@ -120,6 +135,152 @@ SlangResult OSFileSystem::loadFile(char const* pathIn, ISlangBlob** outBlob)
     return SLANG_E_CANNOT_OPEN;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SharedFileCache !!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+namespace { // anonymous
+
+// Blobs in the shared cache are used from many threads, but the ref counts of blobs
+// like StringBlob aren't thread safe. So they are wrapped in a blob with an atomic
+// ref count, which is the only thing that references the wrapped blob.
+class SharedFileBlob : public ISlangBlob
+{
+public:
+    // ISlangUnknown
+    SLANG_IUNKNOWN_QUERY_INTERFACE
+    SLANG_NO_THROW uint32_t SLANG_MCALL addRef() SLANG_OVERRIDE { return ++m_refCount; }
+    SLANG_NO_THROW uint32_t SLANG_MCALL release() SLANG_OVERRIDE
+    {
+        const uint32_t count = --m_refCount;
+        if (count == 0)
+        {
+            delete this;
+        }
+        return count;
+    }
+
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_blob->getBufferPointer(); }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_blob->getBufferSize(); }
+
+    explicit SharedFileBlob(ISlangBlob* blob): m_blob(blob) {}
+    virtual ~SharedFileBlob() {}
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid)
+    {
+        return (guid == IID_ISlangUnknown || guid == IID_ISlangBlob) ? static_cast<ISlangBlob*>(this) : nullptr;
+    }
+
+    std::atomic<uint32_t> m_refCount = { 0 };
+    ComPtr<ISlangBlob> m_blob;
+};
+
+} // anonymous
+
+/* static */SharedFileCache* SharedFileCache::getSingleton()
+{
+    static SharedFileCache s_singleton;
+    return &s_singleton;
+}
+
+SlangResult SharedFileCache::loadFile(ISlangFileSystem* fileSystem, const String& path, const String& uniqueIdentity, ComPtr<ISlangBlob>& outBlob)
+{
+    int64_t size, modifiedTime;
+    if (SLANG_FAILED(File::getSizeAndModifiedTime(path, size, modifiedTime)))
+    {
+        // Can't tell if the file has changed, so don't cache it
+        return fileSystem->loadFile(path.getBuffer(), outBlob.writeRef());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Entry* entry = m_entries.TryGetValue(uniqueIdentity);
+        if (entry && entry->size == size && entry->modifiedTime == modifiedTime)
+        {
+            entry->lastUse = ++m_useCount;
+            m_stats.hitCount++;
+            outBlob = entry->blob;
+            return SLANG_OK;
+        }
+    }
+
+    // Read without holding the lock, so other threads aren't held up
+    ComPtr<ISlangBlob> blob;
+    SLANG_RETURN_ON_FAIL(fileSystem->loadFile(path.getBuffer(), blob.writeRef()));
+    outBlob = new SharedFileBlob(blob);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.missCount++;
+
+    if (Entry* oldEntry = m_entries.TryGetValue(uniqueIdentity))
+    {
+        m_stats.byteCount -= oldEntry->blob->getBufferSize();
+        m_stats.fileCount--;
+        m_entries.Remove(uniqueIdentity);
+    }
+
+    // Files that could never fit aren't held
+    const size_t blobSize = outBlob->getBufferSize();
+    if (blobSize <= m_capacity)
+    {
+        Entry entry;
+        entry.size = size;
+        entry.modifiedTime = modifiedTime;
+        entry.lastUse = ++m_useCount;
+        entry.blob = outBlob;
+        m_entries.Add(uniqueIdentity, entry);
+
+        m_stats.byteCount += blobSize;
+        m_stats.fileCount++;
+        _evictToCapacity();
+    }
+    return SLANG_OK;
+}
+
+void SharedFileCache::_evictToCapacity()
+{
+    while (m_stats.byteCount > m_capacity && m_entries.Count() > 0)
+    {
+        // Find the least recently used. Evictions are rare, so a search is fine.
+        const String* oldestKey = nullptr;
+        uint64_t oldestUse = 0;
+        for (const auto& pair : m_entries)
+        {
+            if (!oldestKey || pair.Value.lastUse < oldestUse)
+            {
+                oldestKey = &pair.Key;
+                oldestUse = pair.Value.lastUse;
+            }
+        }
+
+        const String key = *oldestKey;
+        m_stats.byteCount -= m_entries.TryGetValue(key)->blob->getBufferSize();
+        m_stats.fileCount--;
+        m_entries.Remove(key);
+    }
+}
+
+void SharedFileCache::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    _evictToCapacity();
+}
+
+SharedFileCache::Stats SharedFileCache::getStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void SharedFileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.Clear();
+    m_stats.byteCount = 0;
+    m_stats.fileCount = 0;
+}
+
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! CacheFileSystem !!!!!!!!!!!!!!!!!!!!!!!!!!!
 
 /* static */ const Result CacheFileSystem::s_compressedResultToResult[] = 
@@ -183,6 +344,8 @@ CacheFileSystem::CacheFileSystem(ISlangFileSystem* fileSystem, UniqueIdentityMod
 
     // It can't be default
     SLANG_ASSERT(m_uniqueIdentityMode != UniqueIdentityMode::Default);
+
+    m_useDirectoryListings = (fileSystem == OSFileSystem::getSingleton());
 }
 
 CacheFileSystem::~CacheFileSystem()
@@ -202,9 +365,52 @@ void CacheFileSystem::clearCache()
 
     m_uniqueIdentityMap.Clear();
     m_pathMap.Clear();
+    m_directoryListingMap.Clear();
+
+    if (m_fileSystemExt)
+    {
+        m_fileSystemExt->clearCache();
+    }
+}
+
+void CacheFileSystem::invalidatePath(const String& path)
+{
+    PathInfo* info = nullptr;
+    if (!m_pathMap.TryGetValue(path, info) || !info)
+    {
+        // The file may have been reached through a different path
+        String uniqueIdentity;
+        ComPtr<ISlangBlob> fileContents;
+        if (SLANG_SUCCEEDED(_calcUniqueIdentity(path, uniqueIdentity, fileContents)))
+        {
+            m_uniqueIdentityMap.TryGetValue(uniqueIdentity, info);
+        }
+    }
+
+    // Any path could be another way of reaching the file, so entries for the file, and for paths
+    // that weren't found (which might have been created), are removed
+    Dictionary<String, PathInfo*> newPathMap;
+    for (const auto& pair : m_pathMap)
+    {
+        if (pair.Value && pair.Value != info)
+        {
+            newPathMap.Add(pair.Key, pair.Value);
+        }
+    }
+    m_pathMap = _Move(newPathMap);
+
+    if (info)
+    {
+        m_uniqueIdentityMap.Remove(info->getUniqueIdentity());
+        delete info;
+    }
+
+    // The directory holding the file may be listed under different paths too
+    m_directoryListingMap.Clear();
 
     if (m_fileSystemExt)
     {
+        // The underlying file system has no way to discard a single file
         m_fileSystemExt->clearCache();
     }
 }
@@ -333,6 +539,49 @@ CacheFileSystem::PathInfo* CacheFileSystem::_resolveSimplifiedPathCacheInfo(cons
     return  _resolveUniqueIdentityCacheInfo(path);
 }
 
+bool CacheFileSystem::_isKnownMissing(const String& pathIn)
+{
+    // Use the path as the OS file system sees it
+    const String path = _fixPathDelimiters(pathIn.getBuffer());
+
+    // Paths to a directory itself are left to the file system
+    const String name = Path::getFileName(path);
+    if (name.getLength() == 0 || name == "." || name == "..")
+    {
+        return false;
+    }
+
+    String directory = Path::getParentDirectory(path);
+    if (directory.getLength() == 0)
+    {
+        directory = ".";
+    }
+
+    DirectoryListing* listing = m_directoryListingMap.TryGetValue(directory);
+    if (!listing)
+    {
+        DirectoryListing newListing;
+        List<String> names;
+        newListing.m_result = toCompressedResult(Path::getDirectoryContents(directory, names));
+        // Names are compared in lower case, since file systems can be case insensitive. That can only make
+        // a path look like it exists when it doesn't, which is then found out by the file system.
+        for (const auto& entryName : names)
+        {
+            newListing.m_names.Add(entryName.toLower());
+        }
+        m_directoryListingMap.Add(directory, newListing);
+        listing = m_directoryListingMap.TryGetValue(directory);
+    }
+
+    switch (listing->m_result)
+    {
+        case CompressedResult::Ok:          return !listing->m_names.Contains(name.toLower());
+        case CompressedResult::NotFound:    return true;
+        // If the directory can't be listed (for example, it isn't readable), ask about the path itself
+        default:                            return false;
+    }
+}
+
 CacheFileSystem::PathInfo* CacheFileSystem::_resolvePathCacheInfo(const String& path)
 {
     // Lookup in path cache
@@ -343,6 +592,14 @@ CacheFileSystem::PathInfo* CacheFileSystem::_resolvePathCacheInfo(const String&
         return pathInfo;
     }
 
+    // A path missing from the listing of its directory doesn't exist. When searching for an include
+    // in many directories this replaces a failed call to the file system for each with a lookup.
+    if (m_useDirectoryListings && _isKnownMissing(path))
+    {
+        m_pathMap.Add(path, nullptr);
+        return nullptr;
+    }
+
     // Try getting or creating taking into account possible path simplification
     pathInfo = _resolveSimplifiedPathCacheInfo(path);
     // Always add the result to the path cache (even if null)
@@ -362,7 +619,14 @@ SlangResult CacheFileSystem::loadFile(char const* pathIn, ISlangBlob** blobOut)
     
     if (info->m_loadFileResult == CompressedResult::Uninitialized)
     {
-        info->m_loadFileResult = toCompressedResult(m_fileSystem->loadFile(path.getBuffer(), info->m_fileBlob.writeRef()));
+        if (m_sharedFileCache)
+        {
+            info->m_loadFileResult = toCompressedResult(m_sharedFileCache->loadFile(m_fileSystem, path, info->getUniqueIdentity(), info->m_fileBlob));
+        }
+        else
+        {
+            info->m_loadFileResult = toCompressedResult(m_fileSystem->loadFile(path.getBuffer(), info->m_fileBlob.writeRef()));
+        }
     }
 
     *blobOut = info->m_fileBlob;
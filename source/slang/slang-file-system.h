@@ -8,6 +8,8 @@
 #include "../core/slang-string-util.h"
 #include "../core/slang-dictionary.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -63,6 +65,63 @@ private:
     static OSFileSystem s_singleton;
 };
 
+/* A cache of file contents that is shared by every CacheFileSystem in the process that opts into it (see
+`CacheFileSystem::setSharedFileCache`), such as the file systems of Linkages created with `kSessionFlag_SharedFileCache`.
+
+Files are keyed by their unique identity, and an entry is only used if the file's size and modification time
+are unchanged since it was loaded. So it can only be used for files on the OS file system.
+
+The cache is thread safe. When the contents held exceed the capacity, the least recently used files are evicted. */
+class SharedFileCache
+{
+public:
+    struct Stats
+    {
+        Index hitCount = 0;                 ///< Loads that used contents already in the cache
+        Index missCount = 0;                ///< Loads that had to read the file
+        Index fileCount = 0;                ///< Files held
+        size_t byteCount = 0;               ///< Total size of the contents held
+    };
+
+    static const size_t kDefaultCapacity = 256 * 1024 * 1024;
+
+        /// Load the file at path (with the uniqueIdentity) through the cache, reading it with fileSystem if it isn't held
+    SlangResult loadFile(ISlangFileSystem* fileSystem, const String& path, const String& uniqueIdentity, ComPtr<ISlangBlob>& outBlob);
+
+        /// Set the maximum number of bytes of contents held. Evicts files if necessary.
+    void setCapacity(size_t capacity);
+
+        /// Get the stats
+    Stats getStats();
+
+        /// Evict all files
+    void clear();
+
+        /// Get the process wide cache
+    static SharedFileCache* getSingleton();
+
+    SharedFileCache() {}
+    ~SharedFileCache() { clear(); }
+
+protected:
+    struct Entry
+    {
+        int64_t size;
+        int64_t modifiedTime;
+        uint64_t lastUse;                   ///< Value of m_useCount when the entry was last used
+        ComPtr<ISlangBlob> blob;            ///< Always has a thread safe ref count
+    };
+
+        /// Evict least recently used entries until the contents fit in the capacity. Must hold m_mutex.
+    void _evictToCapacity();
+
+    std::mutex m_mutex;
+    Dictionary<String, Entry> m_entries;    ///< Maps a unique identity to the entry for it
+    size_t m_capacity = kDefaultCapacity;
+    uint64_t m_useCount = 0;
+    Stats m_stats;
+};
+
 /* Wraps an underlying ISlangFileSystem or ISlangFileSystemExt and provides caching, 
 as well as emulation of methods if only has ISlangFileSystem interface. Will query capabilities
 of the interface on the constructor.
@@ -136,6 +195,14 @@ class CacheFileSystem: public ISlangFileSystemExt, public RefObject
 
     virtual SLANG_NO_THROW void SLANG_MCALL clearCache() SLANG_OVERRIDE;
 
+        /// Discard what is cached about the file at path (which may have changed, been created or been deleted),
+        /// rather than everything as `clearCache` does
+    void invalidatePath(const String& path);
+
+        /// Load files through sharedFileCache (as well as caching them in this file system).
+        /// Should only be set if the underlying file system is the OS file system.
+    void setSharedFileCache(SharedFileCache* sharedFileCache) { m_sharedFileCache = sharedFileCache; }
+
         /// Ctor
     CacheFileSystem(ISlangFileSystem* fileSystem, UniqueIdentityMode uniqueIdentityMode = UniqueIdentityMode::Default, PathStyle pathStyle = PathStyle::Default);
         /// Dtor
@@ -177,6 +244,18 @@ protected:
         /// Given a path, works out a uniqueIdentity, based on the uniqueIdentityMode. outFileContents will be set if file had to be read to produce the uniqueIdentity (ie with Hash)
     SlangResult _calcUniqueIdentity(const String& path, String& outUniqueIdentity, ComPtr<ISlangBlob>& outFileContents);
 
+        /// The names of the entries in a directory, read once so that paths that don't exist in the directory
+        /// can be found without asking the file system about each one
+    struct DirectoryListing
+    {
+        CompressedResult m_result;                  ///< Ok if the names were read, NotFound if there is no directory
+        HashSet<String> m_names;                    ///< Names of the entries, in lower case
+    };
+
+        /// True if the listing of the directory holding path shows nothing exists at path.
+        /// Only used with the OS file system, which is what the listings are read from.
+    bool _isKnownMissing(const String& path);
+
         /// For a given path gets a PathInfo. Can return nullptr, if it is not possible to create the PathInfo for some reason
     PathInfo* _resolvePathCacheInfo(const String& path);
         /// Turns the path into a uniqueIdentity, and then tries to look up in the uniqueIdentityMap.
@@ -191,12 +270,16 @@ protected:
 
     Dictionary<String, PathInfo*> m_pathMap;            ///< Maps a path to a PathInfo (and unique identity)
     Dictionary<String, PathInfo*> m_uniqueIdentityMap;  ///< Maps a unique identity for a file to its contents. This OWNs the PathInfo.
+    Dictionary<String, DirectoryListing> m_directoryListingMap; ///< Maps a directory path to its listing
+    bool m_useDirectoryListings = false;                ///< True if the underlying file system is the OS file system
 
     UniqueIdentityMode m_uniqueIdentityMode;            ///< Determines how the 'uniqueIdentity' is produced. Cannot be Default in usage.
     PathStyle m_pathStyle;                              ///< Style of paths
 
     ComPtr<ISlangFileSystem> m_fileSystem;              ///< Must always be set
     ComPtr<ISlangFileSystemExt> m_fileSystemExt;        ///< Optionally set -> if nullptr will fall back on the m_fileSystem and emulate all the other methods of ISlangFileSystemExt
+
+    SharedFileCache* m_sharedFileCache = nullptr;       ///< If set, files are loaded through this cache
 };
 
 }
@@ -221,7 +221,7 @@ struct BindExistentialSlots
             // we should be detecting and diagnosing this problem before
             // we make it to back-end code generation.
             //
-            sink->diagnose(param->sourceLoc, Diagnostics::missingExistentialBindingsForParameter);
+            sink->diagnose(param->getSourceLoc(), Diagnostics::missingExistentialBindingsForParameter);
             return;
         }
 
@@ -235,7 +235,7 @@ struct BindExistentialSlots
         UInt bindOperandCount = bindSlotsInst->getOperandCount();
         if( 2*(firstSlot + slotCount) > bindOperandCount )
         {
-            sink->diagnose(param->sourceLoc, Diagnostics::missingExistentialBindingsForParameter);
+            sink->diagnose(param->getSourceLoc(), Diagnostics::missingExistentialBindingsForParameter);
             return;
         }
         //
@@ -7,12 +7,81 @@
 namespace Slang
 {
 
+void IRInstMap::add(IRInst* key, IRInst* value)
+{
+    reserve(m_count + 1);
+    Entry& entry = _getEntries()[_findSlot(key)];
+    SLANG_ASSERT(!entry.key);
+    entry.key = key;
+    entry.value = value;
+    m_count++;
+}
+
+void IRInstMap::set(IRInst* key, IRInst* value)
+{
+    reserve(m_count + 1);
+    Entry& entry = _getEntries()[_findSlot(key)];
+    if (!entry.key)
+    {
+        entry.key = key;
+        m_count++;
+    }
+    entry.value = value;
+}
+
+void IRInstMap::reserve(Index count)
+{
+    // Linear probing gets slow as the map fills up, so keep it at most 3/4 full
+    Index capacity = m_capacity;
+    while (count * 4 > capacity * 3)
+    {
+        capacity *= 2;
+    }
+    if (capacity != m_capacity)
+    {
+        _rehash(capacity);
+    }
+}
+
+void IRInstMap::_rehash(Index capacity)
+{
+    List<Entry> oldHeapEntries;
+    oldHeapEntries.swapWith(m_heapEntries);
+    Entry oldInlineEntries[kInlineCapacity];
+    ::memcpy(oldInlineEntries, m_inlineEntries, sizeof(m_inlineEntries));
+
+    const Entry* oldEntries = oldHeapEntries.getCount() ? oldHeapEntries.getBuffer() : oldInlineEntries;
+    const Index oldCapacity = m_capacity;
+
+    m_heapEntries.setCount(capacity);
+    Entry* entries = m_heapEntries.getBuffer();
+    for (Index i = 0; i < capacity; ++i)
+    {
+        entries[i] = Entry();
+    }
+    m_capacity = capacity;
+    m_hashShift = 64;
+    for (Index i = capacity; i > 1; i >>= 1)
+    {
+        m_hashShift--;
+    }
+
+    for (Index i = 0; i < oldCapacity; ++i)
+    {
+        const Entry& oldEntry = oldEntries[i];
+        if (oldEntry.key)
+        {
+            entries[_findSlot(oldEntry.key)] = oldEntry;
+        }
+    }
+}
+
 IRInst* lookUp(IRCloneEnv* env, IRInst* oldVal)
 {
     for( auto ee = env; ee; ee = ee->parent )
     {
         IRInst* newVal = nullptr;
-        if(ee->mapOldValToNew.TryGetValue(oldVal, newVal))
+        if(ee->mapOldValToNew.tryGetValue(oldVal, newVal))
             return newVal;
     }
     return nullptr;
@@ -150,8 +219,8 @@ static void _cloneInstDecorationsAndChildren(
         // As a very subtle special case, if one of the children
         // of our `oldInst` already has a registered replacement,
         // then we don't want to clone it (not least because
-        // the `Dictionary::Add` method would give us an error
-        // when we try to insert a new value for the same key).
+        // `IRInstMap::add` requires that the key isn't already
+        // in the map).
         //
         // This arises for entries in `mapOldValToNew` that were
         // seeded before cloning begain (e.g., function
@@ -165,7 +234,7 @@ static void _cloneInstDecorationsAndChildren(
         // old to new values.
         //
         auto newChild = cloneInstAndOperands(env, builder, oldChild);
-        env->mapOldValToNew.Add(oldChild, newChild);
+        env->mapOldValToNew.add(oldChild, newChild);
 
         // If and only if the old child had decorations
         // or children, we will register it into our
@@ -231,7 +300,7 @@ IRInst* cloneInst(
     auto newInst = cloneInstAndOperands(
         env, builder, oldInst);
 
-    env->mapOldValToNew.Add(oldInst, newInst);
+    env->mapOldValToNew.add(oldInst, newInst);
 
     cloneInstDecorationsAndChildren(
         env, builder->sharedBuilder, oldInst, newInst);
@@ -15,6 +15,74 @@ struct SharedIRBuilder;
 // correcting "cloning" IR code, whether individual
 // instructions, or whole functions.
 
+    /// A map from IR values to IR values, used to record the clones of values.
+    ///
+    /// Cloning makes a lot of short lived maps (one for every call to `cloneInst`), most of
+    /// which only hold a few entries, and looks up every operand of every cloned instruction.
+    /// The map uses open addressing with linear probing on the address of the key, with a
+    /// null key marking an empty slot. Up to `kInlineCapacity` slots are held inside the map
+    /// itself, so small maps don't allocate at all. Entries can't be removed.
+    ///
+struct IRInstMap
+{
+    enum
+    {
+        kInlineCapacity = 8,            ///< Must be a power of 2
+    };
+
+        /// Add a mapping for `key`, which must not already have one
+    void add(IRInst* key, IRInst* value);
+        /// Set the mapping for `key`, replacing any existing mapping
+    void set(IRInst* key, IRInst* value);
+
+        /// Returns true, and sets `outValue`, if `key` has a mapping
+    bool tryGetValue(IRInst* key, IRInst*& outValue) const
+    {
+        const Entry& entry = _getEntries()[_findSlot(key)];
+        if (!entry.key)
+            return false;
+        outValue = entry.value;
+        return true;
+    }
+    bool containsKey(IRInst* key) const { return _getEntries()[_findSlot(key)].key != nullptr; }
+
+        /// Make space for `count` entries in total, so adding them won't rehash
+    void reserve(Index count);
+
+    Index getCount() const { return m_count; }
+
+protected:
+    struct Entry
+    {
+        IRInst* key = nullptr;
+        IRInst* value = nullptr;
+    };
+
+    Entry* _getEntries() { return m_heapEntries.getCount() ? m_heapEntries.getBuffer() : m_inlineEntries; }
+    const Entry* _getEntries() const { return m_heapEntries.getCount() ? m_heapEntries.getBuffer() : m_inlineEntries; }
+
+        /// The slot holding `key`, or the empty slot where it would be added
+    Index _findSlot(IRInst* key) const
+    {
+        SLANG_ASSERT(key);
+        const Entry* entries = _getEntries();
+        // Fibonacci hashing, as the low bits of an address are mostly the same
+        Index slot = Index((uint64_t(PtrInt(key)) * 0x9E3779B97F4A7C15ull) >> m_hashShift);
+        while (entries[slot].key && entries[slot].key != key)
+        {
+            slot = (slot + 1) & (m_capacity - 1);
+        }
+        return slot;
+    }
+    void _rehash(Index capacity);
+
+    Index m_count = 0;
+    Index m_capacity = kInlineCapacity;
+    int m_hashShift = 61;               ///< 64 - log2(m_capacity)
+    Entry m_inlineEntries[kInlineCapacity];
+    List<Entry> m_heapEntries;          ///< Used instead of m_inlineEntries once there are more than kInlineCapacity slots
+};
+
     /// An environment for mapping existing values to their cloned replacements.
     ///
     /// This type serves two main roles in the process of IR cloning:
@@ -34,7 +102,7 @@ struct SharedIRBuilder;
 struct IRCloneEnv
 {
         /// A mapping from old values to their replacements.
-    Dictionary<IRInst*, IRInst*> mapOldValToNew;
+    IRInstMap mapOldValToNew;
 
         /// A parent environment to fall back to if `mapOldValToNew` doesn't contain a key.
     IRCloneEnv* parent = nullptr;
@@ -17,7 +17,12 @@ struct PropagateConstExprContext
     IRBuilder builder;
 
     List<IRInst*> workList;
-    HashSet<IRInst*> onWorkList;
+    IRInstSet onWorkList;
+
+    PropagateConstExprContext(IRModule* inModule)
+        : module(inModule)
+        , onWorkList(inModule)
+    {}
 
     IRBuilder* getBuilder() { return &builder; }
 
@@ -160,10 +165,9 @@ void maybeAddToWorkList(
     PropagateConstExprContext*  context,
     IRInst*                     gv)
 {
-    if( !context->onWorkList.Contains(gv) )
+    if( context->onWorkList.add(gv) )
     {
         context->workList.add(gv);
-        context->onWorkList.Add(gv);
     }
 }
 
@@ -439,7 +443,7 @@ void validateConstExpr(
                     {
                         // Diagnose the failure.
 
-                        context->getSink()->diagnose(ii->sourceLoc, Diagnostics::needCompileTimeConstant);
+                        context->getSink()->diagnose(ii->getSourceLoc(), Diagnostics::needCompileTimeConstant);
 
                         break;
                     }
@@ -455,8 +459,7 @@ void propagateConstExpr(
 {
     auto session = module->session;
 
-    PropagateConstExprContext context;
-    context.module = module;
+    PropagateConstExprContext context(module);
     context.sink = sink;
     context.sharedBuilder.module = module;
     context.sharedBuilder.session = session;
@@ -493,7 +496,7 @@ void propagateConstExpr(
     {
         auto gv = context.workList[0];
         context.workList.fastRemoveAt(0);
-        context.onWorkList.Remove(gv);
+        context.onWorkList.remove(gv);
 
         switch( gv->op )
         {
@@ -0,0 +1,219 @@
+// slang-ir-cse.cpp
+#include "slang-ir-cse.h"
+
+#include "slang-ir.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-pass-manager.h"
+
+namespace Slang
+{
+
+    /// Identifies the value computed by an instruction, for finding equivalent instructions.
+    ///
+    /// Like `IRInstKey`, except that constant operands are compared by value, because
+    /// different builders can create separate constants with the same value.
+struct IRValueKey
+{
+    IRInst* inst;
+    int hashCode;
+
+    static int _hashOperand(IRInst* operand)
+    {
+        if (auto constant = as<IRConstant>(operand))
+            return combineHash(int(constant->op), constant->getHashCode());
+        return Slang::GetHashCode(operand);
+    }
+
+    static bool _areOperandsEqual(IRInst* a, IRInst* b)
+    {
+        if (a == b)
+            return true;
+        auto constantA = as<IRConstant>(a);
+        auto constantB = as<IRConstant>(b);
+        return constantA && constantB && constantA->op == constantB->op &&
+            constantA->getFullType() == constantB->getFullType() && constantA->equal(constantB);
+    }
+
+    static IRValueKey make(IRInst* inst)
+    {
+        int hash = combineHash(int(inst->op), int(inst->getOperandCount()));
+        hash = combineHash(hash, Slang::GetHashCode(inst->getFullType()));
+
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            hash = combineHash(hash, _hashOperand(inst->getOperand(i)));
+        }
+
+        IRValueKey key = { inst, hash };
+        return key;
+    }
+
+    bool operator==(const IRValueKey& rhs) const
+    {
+        if (hashCode != rhs.hashCode ||
+            inst->op != rhs.inst->op ||
+            inst->getFullType() != rhs.inst->getFullType() ||
+            inst->getOperandCount() != rhs.inst->getOperandCount())
+        {
+            return false;
+        }
+
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (!_areOperandsEqual(inst->getOperand(i), rhs.inst->getOperand(i)))
+                return false;
+        }
+        return true;
+    }
+
+    int GetHashCode() const { return hashCode; }
+};
+
+struct CommonSubexpressionEliminationContext
+{
+    IRModule* module;
+    IRPassManager* passManager;
+
+    IRDominatorTree* dominatorTree = nullptr;
+
+        /// The instructions available in the block being visited, which are
+        /// those in the blocks that dominate it
+    Dictionary<IRValueKey, IRInst*> availableInsts;
+
+    Index removedCount = 0;
+
+        /// True if nothing can write to the memory that `ptr` points to while the shader runs
+    static bool _isImmutableAddress(IRInst* ptr)
+    {
+        for (;;)
+        {
+            switch (ptr->op)
+            {
+                case kIROp_FieldAddress:
+                case kIROp_getElementPtr:
+                    ptr = ptr->getOperand(0);
+                    break;
+                case kIROp_GlobalParam:
+                {
+                    switch (ptr->getDataType()->op)
+                    {
+                        case kIROp_ConstantBufferType:
+                        case kIROp_TextureBufferType:
+                        case kIROp_ParameterBlockType:
+                        case kIROp_GLSLInputParameterGroupType:
+                            return true;
+                        default:
+                            return false;
+                    }
+                }
+                default:
+                    return false;
+            }
+        }
+    }
+
+    static bool _hasOnlyIgnoredDecorations(IRInst* inst)
+    {
+        for (auto decoration : inst->getDecorations())
+        {
+            switch (decoration->op)
+            {
+                case kIROp_NameHintDecoration:
+                case kIROp_HighLevelDeclDecoration:
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static bool _canEliminate(IRInst* inst)
+    {
+        if (as<IRTerminatorInst>(inst) || inst->getFirstChild() || !_hasOnlyIgnoredDecorations(inst))
+            return false;
+
+        switch (inst->op)
+        {
+            case kIROp_Param:
+            case kIROp_Var:
+            case kIROp_Nop:
+                return false;
+            case kIROp_Load:
+                return _isImmutableAddress(inst->getOperand(0));
+            default:
+                return !inst->mightHaveSideEffects();
+        }
+    }
+
+    void _processBlock(IRBlock* block)
+    {
+        module->checkBudget();
+
+        // The instructions this block makes available, which are no longer
+        // available once the blocks it dominates have been visited
+        List<IRValueKey> addedKeys;
+
+        IRInst* nextInst = nullptr;
+        for (IRInst* inst = block->getFirstChild(); inst; inst = nextInst)
+        {
+            nextInst = inst->getNextInst();
+            if (!_canEliminate(inst))
+                continue;
+
+            const IRValueKey key = IRValueKey::make(inst);
+            if (IRInst* const* existingPtr = availableInsts.TryGetValue(key))
+            {
+                inst->replaceUsesWith(*existingPtr);
+                inst->removeAndDeallocate();
+                removedCount++;
+            }
+            else
+            {
+                availableInsts.Add(key, inst);
+                addedKeys.add(key);
+            }
+        }
+
+        for (auto child : dominatorTree->getImmediatelyDominatedBlocks(block))
+        {
+            _processBlock(child);
+        }
+
+        for (const auto& key : addedKeys)
+        {
+            availableInsts.Remove(key);
+        }
+    }
+
+    void processFunc(IRFunc* func)
+    {
+        dominatorTree = passManager->getDominatorTree(func);
+        availableInsts.Clear();
+        _processBlock(func->getFirstBlock());
+    }
+
+    Index processModule()
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(inst);
+            if (func && func->isDefinition())
+                processFunc(func);
+        }
+        return removedCount;
+    }
+};
+
+Index eliminateCommonSubexpressions(IRModule* module, IRPassManager* passManager)
+{
+    CommonSubexpressionEliminationContext context;
+    context.module = module;
+    context.passManager = passManager;
+    return context.processModule();
+}
+
+}
@@ -0,0 +1,30 @@
+// slang-ir-cse.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    class IRPassManager;
+    struct IRModule;
+
+        /// Eliminate common subexpressions in the bodies of the functions in `module`.
+        ///
+        /// The global value numbering done by `SharedIRBuilder` only deduplicates hoistable
+        /// instructions, so code in function bodies can compute the same value many times,
+        /// particularly after inlining. This pass walks the dominator tree of each function,
+        /// and replaces an instruction with an earlier equivalent instruction in a dominating
+        /// block, if there is one.
+        ///
+        /// Instructions are equivalent if they have the same opcode, type and operands, and
+        /// have no side effects (see `IRInst::mightHaveSideEffects`). Loads are also
+        /// equivalent if they load from the same address, and the address is in memory that
+        /// can't be written to, such as a constant buffer or parameter block. Redundant loads
+        /// of uniform parameters are removed this way.
+        ///
+        /// The CFG isn't changed, so the dominator trees of `passManager` stay valid.
+        ///
+        /// Returns the number of instructions that were removed.
+        ///
+    Index eliminateCommonSubexpressions(IRModule* module, IRPassManager* passManager);
+}
@@ -19,6 +19,11 @@ struct DeadCodeEliminationContext
     BackEndCompileRequest*  compileRequest;
     IRModule*               module;
 
+    // If set, every instruction at global scope is kept,
+    // and only the contents of global values are eliminated.
+    //
+    bool keepGlobalInsts = false;
+
     // Our overall process is going to be to determine
     // which instructions in the module are "live"
     // and then eliminate anything that wasn't found to
@@ -28,7 +33,13 @@ struct DeadCodeEliminationContext
     // a set of all instructions we have so far determined
     // to be live.
     //
-    HashSet<IRInst*> liveInsts;
+    IRInstSet liveInsts;
+
+    DeadCodeEliminationContext(BackEndCompileRequest* inCompileRequest, IRModule* inModule)
+        : compileRequest(inCompileRequest)
+        , module(inModule)
+        , liveInsts(inModule)
+    {}
 
     // Querying whether an instruction has been
     // determined to be live is easy.
@@ -42,7 +53,7 @@ struct DeadCodeEliminationContext
         //
         if(!inst) return false;
 
-        return liveInsts.Contains(inst);
+        return liveInsts.contains(inst);
     }
 
     // We are going to do an iterative analysis
@@ -71,9 +82,8 @@ struct DeadCodeEliminationContext
         //
         if(!inst) return;
 
-        if(liveInsts.Contains(inst))
+        if(!liveInsts.add(inst))
             return;
-        liveInsts.Add(inst);
         workList.add(inst);
     }
 
@@ -204,6 +214,81 @@ struct DeadCodeEliminationContext
         }
     }
 
+    // When the module is tracking dirty instructions we can do
+    // a cheaper, incremental, form of DCE. An instruction can
+    // only have become dead since the last time we looked if it
+    // was created, or lost a use, and the IR records both of
+    // those in the dirty set.
+    //
+    // Rather than find everything that is live, we look for
+    // instructions that are trivially dead: nothing uses them,
+    // and they aren't kept alive by their parent.
+    //
+    void processDirtyInsts(IRDirtyInstSet* dirtyInsts)
+    {
+        while( auto inst = dirtyInsts->takeNext() )
+        {
+            if(!isInstTriviallyDead(inst))
+                continue;
+
+            // Removing `inst` drops its uses of its operands and type
+            // (and those of its descendents). The IR marks the values
+            // it used as dirty, so they will be visited in turn if
+            // this was their last use.
+            //
+            inst->removeAndDeallocate();
+        }
+    }
+
+    bool isInstTriviallyDead(IRInst* inst)
+    {
+        // The module itself is always live, and decorations
+        // are live whenever their parent is.
+        //
+        if(as<IRModuleInst>(inst) || as<IRDecoration>(inst))
+            return false;
+
+        if(inst->hasUses())
+            return false;
+
+        // We don't know whether the parent of `inst` is live,
+        // but if it is then `inst` might need to be too.
+        //
+        if(shouldInstBeLiveIfParentIsLive(inst))
+            return false;
+
+        // Finally, a descendent of `inst` that is used from
+        // outside of it (e.g., a function nested in a generic)
+        // would keep `inst` alive.
+        //
+        return !isAnyDescendentUsedOutside(inst, inst);
+    }
+
+    bool isAnyDescendentUsedOutside(IRInst* root, IRInst* inst)
+    {
+        for( auto child : inst->getDecorationsAndChildren() )
+        {
+            for( auto use = child->firstUse; use; use = use->nextUse )
+            {
+                if(!isDescendentOf(use->getUser(), root))
+                    return true;
+            }
+            if(isAnyDescendentUsedOutside(root, child))
+                return true;
+        }
+        return false;
+    }
+
+    static bool isDescendentOf(IRInst* inst, IRInst* ancestor)
+    {
+        for( auto ii = inst; ii; ii = ii->getParent() )
+        {
+            if(ii == ancestor)
+                return true;
+        }
+        return false;
+    }
+
     // Now we come to the decision procedure we put off before:
     // should a given `inst` be live if its parent is?
     //
@@ -239,6 +324,8 @@ struct DeadCodeEliminationContext
         //
         if(inst->findDecorationImpl(kIROp_KeepAliveDecoration))
             return true;
+        if(keepGlobalInsts && as<IRModuleInst>(inst->getParent()))
+            return true;
         //
         // TODO: Eventually it would make sense to consider everything
         // with an `[export(...)]` decoration as live, but our current
@@ -315,11 +402,38 @@ void eliminateDeadCode(
     BackEndCompileRequest* compileRequest,
     IRModule*       module)
 {
-    DeadCodeEliminationContext context;
-    context.compileRequest = compileRequest;
-    context.module = module;
+    {
+        DeadCodeEliminationContext context(compileRequest, module);
+        context.processModule();
+    }
+
+    // Every instruction has just been visited, so this is a good time to
+    // remove the gaps left by removed instructions from the indices
+    module->compactInstIndices();
+}
+
+void eliminateDeadCodeIncremental(
+    BackEndCompileRequest* compileRequest,
+    IRModule*       module)
+{
+    DeadCodeEliminationContext context(compileRequest, module);
+
+    if( auto dirtyInsts = module->getDirtyInsts() )
+        context.processDirtyInsts(dirtyInsts);
+    else
+        context.processModule();
+}
+
+void eliminateDeadCodeInBodies(
+    IRModule*       module)
+{
+    {
+        DeadCodeEliminationContext context(nullptr, module);
+        context.keepGlobalInsts = true;
+        context.processModule();
+    }
 
-    context.processModule();
+    module->compactInstIndices();
 }
 
 }
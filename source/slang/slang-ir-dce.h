@@ -16,4 +16,29 @@ namespace Slang
     void eliminateDeadCode(
         BackEndCompileRequest*  compileRequest,
         IRModule*               module);
+
+        /// Eliminate dead code, visiting only the module's dirty instructions.
+        ///
+        /// This drains the dirty instruction set of `module` (see
+        /// `IRModule::beginTrackingDirtyInsts`), removing instructions that
+        /// are no longer used and need not be kept, and then anything that
+        /// becomes unused as a result. Unlike `eliminateDeadCode` it does not
+        /// find dead cycles, or code that was already dead when tracking began.
+        ///
+        /// If the module is not tracking dirty instructions this falls back
+        /// to `eliminateDeadCode`.
+        ///
+    void eliminateDeadCodeIncremental(
+        BackEndCompileRequest*  compileRequest,
+        IRModule*               module);
+
+        /// Eliminate dead code in the bodies of the functions (and other
+        /// code-bearing values) in `module`, keeping every global instruction.
+        ///
+        /// This is for modules that haven't been linked, where any global
+        /// value might be referenced from another module, so it can't be
+        /// told whether a function or type is unused.
+        ///
+    void eliminateDeadCodeInBodies(
+        IRModule*               module);
 }
@@ -0,0 +1,233 @@
+// slang-ir-deduplicate-funcs.cpp
+#include "slang-ir-deduplicate-funcs.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+struct FunctionDeduplicationContext
+{
+    IRModule* module;
+
+    // The instructions in the bodies of the two functions being compared
+    // (or the one being hashed), numbered in the order they appear.
+    //
+    Dictionary<IRInst*, Index> localIndices[2];
+
+    // Name hints only affect the names used in output, linkage on
+    // a function is just its mangled name, and the high-level declarations
+    // are only there for reference, so none of them should stop a merge.
+    //
+    static bool _isIgnoredDecoration(IRInst* inst)
+    {
+        switch (inst->op)
+        {
+            case kIROp_HighLevelDeclDecoration:
+            case kIROp_NameHintDecoration:
+            case kIROp_ImportDecoration:
+            case kIROp_ExportDecoration:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    static bool _canMerge(IRFunc* func)
+    {
+        return func->isDefinition() &&
+            !func->findDecorationImpl(kIROp_EntryPointDecoration) &&
+            !func->findDecorationImpl(kIROp_KeepAliveDecoration);
+    }
+
+    static void _numberLocals(IRInst* parent, Dictionary<IRInst*, Index>& ioIndices)
+    {
+        for (auto child : parent->getDecorationsAndChildren())
+        {
+            ioIndices.Add(child, ioIndices.Count());
+            _numberLocals(child, ioIndices);
+        }
+    }
+
+    int _hashOperand(IRInst* operand, Dictionary<IRInst*, Index>& indices)
+    {
+        if (!operand)
+            return 0;
+
+        Index index;
+        if (indices.TryGetValue(operand, index))
+            return combineHash(1, int(index));
+        if (auto constant = as<IRConstant>(operand))
+            return combineHash(2, constant->getHashCode());
+        return combineHash(3, GetHashCode(operand));
+    }
+
+    int _hashInst(IRInst* inst, Dictionary<IRInst*, Index>& indices)
+    {
+        int hash = combineHash(int(inst->op), int(inst->getOperandCount()));
+        hash = combineHash(hash, _hashOperand(inst->getFullType(), indices));
+
+        const UInt operandCount = inst->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            hash = combineHash(hash, _hashOperand(inst->getOperand(i), indices));
+        }
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (_isIgnoredDecoration(child))
+                continue;
+            hash = combineHash(hash, _hashInst(child, indices));
+        }
+        return hash;
+    }
+
+    int hashFunc(IRFunc* func)
+    {
+        auto& indices = localIndices[0];
+        indices.Clear();
+        _numberLocals(func, indices);
+        return _hashInst(func, indices);
+    }
+
+    bool _areOperandsEqual(IRInst* a, IRInst* b)
+    {
+        if (a == b)
+            return true;
+        if (!a || !b)
+            return false;
+
+        Index indexA, indexB;
+        const bool isLocalA = localIndices[0].TryGetValue(a, indexA);
+        const bool isLocalB = localIndices[1].TryGetValue(b, indexB);
+        if (isLocalA || isLocalB)
+            return isLocalA && isLocalB && indexA == indexB;
+
+        auto constantA = as<IRConstant>(a);
+        auto constantB = as<IRConstant>(b);
+        return constantA && constantB && constantA->equal(constantB);
+    }
+
+        /// Get the next child of a function being compared, skipping ignored decorations
+    static IRInst* _skipIgnored(IRInst* inst)
+    {
+        while (inst && _isIgnoredDecoration(inst))
+            inst = inst->getNextInst();
+        return inst;
+    }
+
+    bool _areInstsEqual(IRInst* a, IRInst* b)
+    {
+        if (a->op != b->op ||
+            a->getOperandCount() != b->getOperandCount() ||
+            !_areOperandsEqual(a->getFullType(), b->getFullType()))
+        {
+            return false;
+        }
+
+        const UInt operandCount = a->getOperandCount();
+        for (UInt i = 0; i < operandCount; ++i)
+        {
+            if (!_areOperandsEqual(a->getOperand(i), b->getOperand(i)))
+                return false;
+        }
+
+        IRInst* childA = _skipIgnored(a->getFirstDecorationOrChild());
+        IRInst* childB = _skipIgnored(b->getFirstDecorationOrChild());
+        while (childA && childB)
+        {
+            if (!_areInstsEqual(childA, childB))
+                return false;
+            childA = _skipIgnored(childA->getNextInst());
+            childB = _skipIgnored(childB->getNextInst());
+        }
+        return childA == nullptr && childB == nullptr;
+    }
+
+    bool areFuncsEqual(IRFunc* a, IRFunc* b)
+    {
+        localIndices[0].Clear();
+        localIndices[1].Clear();
+        _numberLocals(a, localIndices[0]);
+        _numberLocals(b, localIndices[1]);
+        return _areInstsEqual(a, b);
+    }
+
+        /// Merge the functions that are currently equivalent. Returns the number removed.
+    Index mergeOnce()
+    {
+        // Functions that might be equivalent have the same hash, so
+        // each is only compared against the earlier functions with its hash.
+        //
+        Dictionary<int, List<IRFunc*>> funcsByHash;
+        List<IRFunc*> duplicates;
+
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(inst);
+            if (!func || !_canMerge(func))
+                continue;
+
+            const int hash = hashFunc(func);
+
+            List<IRFunc*>* candidates = funcsByHash.TryGetValue(hash);
+            if (!candidates)
+            {
+                funcsByHash.Add(hash, List<IRFunc*>());
+                candidates = funcsByHash.TryGetValue(hash);
+            }
+
+            IRFunc* canonical = nullptr;
+            for (auto candidate : *candidates)
+            {
+                if (areFuncsEqual(candidate, func))
+                {
+                    canonical = candidate;
+                    break;
+                }
+            }
+
+            if (canonical)
+            {
+                // Uses are replaced straight away, so functions later in the
+                // module that call `func` see `canonical` when they are compared.
+                func->replaceUsesWith(canonical);
+                duplicates.add(func);
+            }
+            else
+            {
+                candidates->add(func);
+            }
+        }
+
+        for (auto duplicate : duplicates)
+        {
+            duplicate->removeAndDeallocate();
+        }
+        return duplicates.getCount();
+    }
+
+    Index processModule()
+    {
+        // Merging functions can make the functions that call them equivalent,
+        // so keep going until nothing changes.
+        Index removedCount = 0;
+        for (;;)
+        {
+            const Index count = mergeOnce();
+            if (count == 0)
+                break;
+            removedCount += count;
+        }
+        return removedCount;
+    }
+};
+
+Index deduplicateFunctions(IRModule* module)
+{
+    FunctionDeduplicationContext context;
+    context.module = module;
+    return context.processModule();
+}
+
+}
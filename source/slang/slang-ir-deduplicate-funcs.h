@@ -0,0 +1,30 @@
+// slang-ir-deduplicate-funcs.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Merge functions in `module` whose definitions are structurally identical.
+        ///
+        /// Specialization often produces functions that differ only in their
+        /// names, such as generic instantiations that become the same code once
+        /// types are legalized, or resource-specialized clones of a function
+        /// that are passed the same resources. Uses of each duplicate are replaced
+        /// with the first equivalent function in the module, and the duplicate
+        /// is removed.
+        ///
+        /// Two functions are equivalent if they have the same type and decorations
+        /// (ignoring name hints, linkage and high-level declarations), and their
+        /// bodies have the same instructions in the same order, with the same
+        /// operands. Operands
+        /// inside a body are compared by position, and anything else by identity,
+        /// so merging is repeated until no more functions become equivalent.
+        /// Entry points, and functions that are kept alive, are never merged.
+        ///
+        /// Returns the number of functions that were removed.
+        ///
+    Index deduplicateFunctions(IRModule* module);
+}
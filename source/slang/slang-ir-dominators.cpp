@@ -6,13 +6,9 @@
 // to enable queries on dominance relationships in a control-flow graph.
 //
 // It also implements computation of the dominator tree for a CFG using
-// the algorithm presented in "A Simple, Fast Dominance Algorithm" by
-// Keith D. Cooper, Timothy J. Harvey, and Ken Kennedy.
-//
-// The algorithm is *not* the most efficinet one, asymptotically, but
-// it is one that is easy to implement and explain, and so we favor it
-// in order to get something up and running with a reasonable level of
-// confidence that the results are correct.
+// the Semi-NCA algorithm, a simplification of Lengauer-Tarjan that runs
+// in near-linear time, and doesn't need to iterate to a fixed point the
+// way simpler algorithms do on large functions with many loops.
 //
 
 #include "slang-ir.h"
@@ -182,94 +178,35 @@ bool IRDominatorTree::DominatedList::Iterator::operator==(Iterator const& that)
 }
 
 //
-// The dominance computation algorithm we are using relies on being able to compute
-// a reverse postorder traversal of the nodes in the CFG, which is done using a depth-first
-// search (DFS). We don't currently have infrastructure for DFS in the compiler, so
-// we will implement it here for now, and plan to move it into its own file once
-// we have a second use case.
-//
-
-/// A base "visitor" class for use in depth-first search algorithms on an IR CFG.
-struct DepthFirstSearchContext
-{
-    /// The blocks in the CFG that we've already visited.
-    HashSet<IRBlock*> visited;
-
-    /// Walk a (previously unvisited) block.
-    ///
-    /// This will perform any pre-order actions on the block,
-    /// then recursively visit its (unvisited) successors, and
-    /// then perform any post-actions.
-    ///
-    void walk(IRBlock* block)
-    {
-        visited.Add(block);
-        preVisit(block);
-        for(auto succ : block->getSuccessors())
-        {
-            if(!visited.Contains(succ))
-            {
-                walk(succ);
-            }
-        }
-        postVisit(block);
-    }
-
-    /// Walk the blocks in a function (or other code-bearing value).
-    void walk(IRGlobalValueWithCode* code)
-    {
-        auto root = code->getFirstBlock();
-        if(!root)
-            return;
-        walk(root);
-    }
-
-    /// Overridable action to perform on first entering a CFG node.
-    virtual void preVisit(IRBlock* /*block*/) {}
-
-    /// Overridable action to perform on exiting a CFG node
-    virtual void postVisit(IRBlock* /*block*/) {}
-};
-
-//
-// With DFS traversal factored out, computing a post-order walk
-// of the CFG is a simple matter of defining a visitor that appends
-// to an order as a post-action:
+// The dominance computation algorithm we are using relies on a depth-first
+// search (DFS) of the CFG, which gives us both a preorder and a postorder
+// numbering of the (reachable) blocks.
 //
-
-/// A visitor that computes a postorder traversal for a CFG.
-struct PostorderComputationContext : public DepthFirstSearchContext
-{
-    /// List to append the computed order onto
-    List<IRBlock*>* order;
-
-    virtual void postVisit(IRBlock* block) SLANG_OVERRIDE
-    {
-        order->add(block);
-    }
-};
-
-/// Compute a postorder traversal of the blocks in `code`, writing the resulting order to `outOrder`.
-void computePostorder(IRGlobalValueWithCode* code, List<IRBlock*>& outOrder)
-{
-    PostorderComputationContext context;
-    context.order = &outOrder;
-    context.walk(code);
-}
-
+// The DFS is done with an explicit stack rather than recursion, so that
+// large functions with long chains of blocks can't overflow the native stack.
 //
 // With the preliminaries out of the way, we are ready to implement
-// the dominator tree construction algorithm as described by Cooper, Harvey, and Kennedy.
-// The actual code for the algorithm is given in Figure 3 of the paper.
+// the dominator tree construction using the "Semi-NCA" algorithm
+// described by Loukas Georgiadis in "Linear-Time Algorithms for Dominators
+// and Related Problems" (which is in turn a variation on Lengauer-Tarjan).
+//
+// The algorithm computes the *semidominator* of each block in the same way
+// as Lengauer-Tarjan, and then finds each immediate dominator as the nearest
+// common ancestor (NCA) in the DFS tree of the block's parent and its
+// semidominator. All of the intermediate state is kept in dense arrays
+// indexed by DFS preorder number, so that after the initial numbering
+// of the blocks there are no more hash table lookups.
 //
-// We will wrap the subroutines of their algorithm in a `struct` type
+// We will wrap the subroutines of the algorithm in a `struct` type
 // to allow the temporary structures to be shared.
 //
 struct DominatorTreeComputationContext
 {
     // We will use signed integers to represent the "name" of a block.
     // The integers will reflect the a postorder traversal, and this
-    // property will be exploited in the `intersect()` function.
+    // property will be exploited when laying out the tree below (an
+    // immediate dominator always comes after the blocks it dominates
+    // in postorder).
     //
     typedef Int BlockName;
     //
@@ -283,211 +220,235 @@ struct DominatorTreeComputationContext
     List<IRBlock*> postorder;
 
     //
-    // We need a way to map our actual IR blocks to their names for
-    // the purpose of this algorithm. This mapping step adds overhead,
-    // but it seems unavoidable unless we also translate the CFG itself
-    // to an index-based representation.
+    // The `doms` array will directly encode the immediate dominator
+    // for each node (by name), once it has been computed.
     //
-    Dictionary<IRBlock*, BlockName> mapBlockToName;
-    BlockName getBlockName(IRBlock* block)
-    {
-        return mapBlockToName[block];
-    }
+    List<BlockName> doms;
 
     //
-    // The algorithm iteratively builds up an array `doms` that upon
-    // completion will directly encode the immediate dominator for each
-    // node. During the iterative steps it is used to implicitly encode
-    // a representation of the set of dominators for each node.
+    // The Semi-NCA algorithm works in terms of the DFS preorder numbers
+    // of the blocks, which we will store separately from their names.
     //
-    List<BlockName> doms;
+    typedef Int PreorderIndex;
+
+    /// The blocks in DFS preorder
+    List<IRBlock*> preorder;
+    /// Map from a block to its index in `preorder`
+    Dictionary<IRBlock*, PreorderIndex> mapBlockToPreorderIndex;
+
+    /// The postorder name of the block at each preorder index
+    List<BlockName> preorderToName;
+    /// The parent of the block at each preorder index in the DFS tree
+    List<PreorderIndex> dfsParents;
 
+    /// The semidominator of the block at each preorder index
+    List<PreorderIndex> semis;
+    /// The preorder indices of the (reachable) predecessors of each block, which are
+    /// stored in `predecessorIndices` starting from `predecessorStarts[i]`
+    List<PreorderIndex> predecessorIndices;
+    List<Index> predecessorStarts;
 
     //
-    // Here we get to the meat of the algorithm presented in Cooper et al.
-    // Figure 3:
+    // The state of the "link-eval" forest used to compute semidominators.
     //
-    void iterativelyComputeImmediateDominators(IRGlobalValueWithCode* code)
+    List<PreorderIndex> ancestors;
+    List<PreorderIndex> labels;
+    List<PreorderIndex> compressPath;
+
+    /// Number the blocks of `code` that are reachable from its entry, in preorder and postorder
+    void numberBlocks(IRGlobalValueWithCode* code)
     {
-        // First we compute the postorder traversal order for the blocks in the CFG.
-        computePostorder(code, postorder);
+        auto root = code->getFirstBlock();
+        if(!root)
+            return;
 
-        // We will initialize our map from the block objects to their "name"
-        // (index in the traversal order), before moving on.
-        BlockName blockCount = BlockName(postorder.getCount());
-        for(BlockName bb = 0; bb < blockCount; ++bb)
+        // Each entry on the stack holds a block along with the
+        // range of its successors that are still to be walked.
+        //
+        struct StackEntry
         {
-            mapBlockToName[postorder[bb]] = bb;
-        }
+            IRBlock* block;
+            IRUse* nextSucc;
+            IRUse* endSucc;
+            UInt stride;
+        };
+        List<StackEntry> stack;
+
+        auto visit = [&](IRBlock* block, PreorderIndex parent)
+        {
+            mapBlockToPreorderIndex.Add(block, preorder.getCount());
+            preorder.add(block);
+            dfsParents.add(parent);
 
-        // Next we initialize the `doms` array that we will iteratively turn
-        // into an encoding of the dominator tree.
-        doms.setCount(blockCount);
-        for(BlockName bb = 0; bb < blockCount; ++bb)
+            auto succs = block->getSuccessors();
+            StackEntry entry = { block, succs.begin_, succs.end_, succs.stride };
+            stack.add(entry);
+        };
+
+        visit(root, kUndefined);
+        while(stack.getCount())
         {
-            doms[bb] = kUndefined;
+            StackEntry& entry = stack.getLast();
+            if(entry.nextSucc != entry.endSucc)
+            {
+                IRBlock* succ = (IRBlock*) entry.nextSucc->get();
+                entry.nextSucc += entry.stride;
+
+                if(!mapBlockToPreorderIndex.ContainsKey(succ))
+                {
+                    PreorderIndex parent = mapBlockToPreorderIndex[entry.block];
+                    visit(succ, parent);
+                }
+            }
+            else
+            {
+                postorder.add(entry.block);
+                stack.removeLast();
+            }
         }
 
-        // The start node is special, since it is the root of the dominator tree.
-        // Technically it doesn't have an immediate dominator, but we will set
-        // its entry in `doms` to refer to itself, to indicate that we are done
-        // processing the given node.
+        // Now that every block has been visited we can map from
+        // preorder indices over to postorder names.
         //
-        BlockName startNode = getBlockName(code->getFirstBlock());
-        doms[startNode] = startNode;
+        Index blockCount = preorder.getCount();
+        preorderToName.setCount(blockCount);
+        for(BlockName bb = 0; bb < BlockName(blockCount); ++bb)
+        {
+            preorderToName[mapBlockToPreorderIndex[postorder[bb]]] = bb;
+        }
 
-        // Given that we computed a postorder traversal of the graph, we know
-        // that the start node should be the last one in the computed order.
+        // We also flatten the predecessor lists into arrays of indices.
+        // Predecessors that aren't reachable from the entry block don't
+        // affect dominance, so they are left out.
         //
-        SLANG_ASSERT(startNode == blockCount - 1);
+        predecessorStarts.setCount(blockCount + 1);
+        for(PreorderIndex ii = 0; ii < PreorderIndex(blockCount); ++ii)
+        {
+            predecessorStarts[ii] = predecessorIndices.getCount();
+            for(auto pred : preorder[ii]->getPredecessors())
+            {
+                PreorderIndex predIndex = kUndefined;
+                if(mapBlockToPreorderIndex.TryGetValue(pred, predIndex))
+                    predecessorIndices.add(predIndex);
+            }
+        }
+        predecessorStarts[blockCount] = predecessorIndices.getCount();
+    }
 
-        // We are using an iterative algorithm, so we will detect that we
-        // have reached a fixed point when we hit an iteration where nothing
-        // changes.
-        //
-        bool changed = true;
-        while(changed)
+    //
+    // The `eval()` and `compress()` operations are the "simple" versions from
+    // Lengauer-Tarjan, which use path compression without balancing. This gives
+    // O(m log n) time, which is the variant that is fastest in practice.
+    //
+    // `compress()` is written iteratively, walking up to the root of the tree
+    // and then applying the updates on the way back down, in the same order
+    // as the usual recursive formulation.
+    //
+    void compress(PreorderIndex v)
+    {
+        compressPath.clear();
+        for(PreorderIndex u = v; ancestors[ancestors[u]] != kUndefined; u = ancestors[u])
         {
-            changed = false;
+            compressPath.add(u);
+        }
 
-            // The algorithm specifies that we should walk through the blocks
-            // in *reverse* postorder, since this speeds up convergence.
-            // Because we've numbered the blocks in postorder, walking them
-            // in reverse numerical order will do the trick.
-            //
-            // We don't want to include the start node in our iteration
-            // (since we already know its dominators), and because we know
-            // that the start node is always the last in the order (`blockCount - 1`)
-            // we can just start at the next node after it (`blockCount - 2`).
-            //
-            // Note: it is important that we are using signed integers for
-            // block numbers here, since we will drop below zero before exiting
-            // the loop, and if the CFG had only a single block, then our *starting*
-            // block index would be `-1`.
-            //
-            for(auto b = blockCount - 2; b >= 0; --b)
+        for(Index ii = compressPath.getCount() - 1; ii >= 0; --ii)
+        {
+            PreorderIndex u = compressPath[ii];
+            PreorderIndex ancestor = ancestors[u];
+            if(semis[labels[ancestor]] < semis[labels[u]])
             {
-                // We are walking through block indices, but the predecessor
-                // lists are encoded in the IR blocks themselves.
-                //
-                IRBlock* block = postorder[b];
-
-                // The algorithm description in the paper says to pick the
-                // initial value for the `new_idom` variable from the "first
-                // (processed) predecessor of b (pick one)".
-                // After that step, the algorithm walks over the remaining
-                // predecessors, and for the ones that have a valid entry
-                // in the `doms` array, performs an intersection of their
-                // implicitly-represented dominator sets.
-                //
-                // The paper doesn't precisely clarify what they mean by
-                // a "processed" predecessor, but it seems to mean one that
-                // has a valid value in the `doms` array, which is what
-                // the subsequent loop is already checking.
-                //
-                // We are going to fold this logic together into a single loop.
-                // We will start with an invalid/undefined value for
-                // `new_idom`, which represents our best guess at the
-                // immediate dominator for block `b`:
-                //
-                BlockName new_idom = kUndefined;
-
-                // Now we will loop over *all* of the predecessors, ...
-                for(auto pred : block->getPredecessors())
-                {
-                    // ... and skip those that haven't been "processed".
-                    BlockName p = getBlockName(pred);
-                    BlockName dominatorOfPredecessor = doms[p];
-                    if(dominatorOfPredecessor == kUndefined)
-                        continue;
-
-                    // When we encounter the first "processed" predecessor,
-                    // we can initialize the variable tracking our best
-                    // guess at the immediate dominator.
-                    //
-                    if(new_idom == kUndefined)
-                    {
-                        new_idom = p;
-                    }
-                    //
-                    // Otherwise, we need to merge information between
-                    // the predecessor `p` and our best-guess immediate
-                    // dominator `new_idom`. We need a node that dominates
-                    // both of them to be the immediate dominator of `b`.
-                    //
-                    else
-                    {
-                        new_idom = intersect(p, new_idom);
-                    }
-                }
-
-                // After we've computed a new best guess at the immediate
-                // dominator for `b`, we need to see if the computed
-                // value differs from what we'd previously stored in the
-                // `doms` array. If anything changed, then we haven't
-                // converged yet, and we need to keep going.
-                //
-                BlockName oldDominator = doms[b];
-                if(oldDominator != new_idom)
-                {
-                    doms[b] = new_idom;
-                    changed = true;
-                }
+                labels[u] = labels[ancestor];
             }
+            ancestors[u] = ancestors[ancestor];
         }
+    }
 
-        // Upon exiting the loop, things should have converged with
-        // the `doms` array being an explicit encoding of the immediate
-        // dominator for each node, with one small error: there is no
-        // immediate dominator for the start node:
-        doms[startNode] = kUndefined;
+    PreorderIndex eval(PreorderIndex v)
+    {
+        if(ancestors[v] == kUndefined)
+            return v;
+        compress(v);
+        return labels[v];
     }
 
     //
-    // The algorithm above relied on a utility routine `intersect()` that
-    // is implicitly used to compute intersections between sets of nodes,
-    // but explicitly takes the form of a routine that computes a common
-    // parent in the dominator tree for two nodes.
-    //
-    // We present that subroutine here, almost identical to how it
-    // is presented in Cooper et al. Figure 3:
+    // Here we get to the meat of the algorithm, which fills in `doms`.
     //
-    BlockName intersect(BlockName b1, BlockName b2)
+    void computeImmediateDominators(IRGlobalValueWithCode* code)
     {
-        // We need to find a common ancestor of both `b1` and `b2`,
-        // and will do this by tracking two "fingers," each initially
-        // pointing at one node, and then iteratively move the finger
-        // that is furthest to the "left" (earlier in the postorder
-        // traversal to the left until) to the "right" (by moving
-        // the immediate dominator of the node we are pointing at),
-        // until the two fingers are pointing at the same place.
-        //
-        // Termination is guaranteed because we are always moving the
-        // fingers from a node to its immediate dominator, and the
-        // entry node is guaranteed to be at the root of the dominator
-        // tree.
+        numberBlocks(code);
+
+        PreorderIndex blockCount = PreorderIndex(preorder.getCount());
+
+        semis.setCount(blockCount);
+        ancestors.setCount(blockCount);
+        labels.setCount(blockCount);
+        for(PreorderIndex ii = 0; ii < blockCount; ++ii)
+        {
+            semis[ii] = ii;
+            ancestors[ii] = kUndefined;
+            labels[ii] = ii;
+        }
+
+        // Semidominators are computed in reverse preorder, skipping
+        // the entry block (at index zero). The semidominator of `w` is the
+        // smallest-numbered block that can reach `w` along a path whose
+        // interior blocks all come after `w` in preorder.
         //
-        // The use of the postorder here relies on the (subtle) fact
-        // that the immediate dominator of a node must come later
-        // in a postorder traversal.
+        for(PreorderIndex w = blockCount - 1; w > 0; --w)
+        {
+            PreorderIndex semi = semis[w];
+            for(Index pp = predecessorStarts[w]; pp < predecessorStarts[w + 1]; ++pp)
+            {
+                PreorderIndex u = eval(predecessorIndices[pp]);
+                if(semis[u] < semi)
+                    semi = semis[u];
+            }
+            semis[w] = semi;
+
+            // Link `w` into the forest under its DFS parent, now
+            // that its semidominator is known.
+            //
+            ancestors[w] = dfsParents[w];
+        }
+
+        // The immediate dominator of `w` is the nearest ancestor of its
+        // DFS parent that isn't below its semidominator. Walking in
+        // preorder means the immediate dominators of all the ancestors
+        // of `w` are final by the time we get to it.
         //
-        BlockName finger1 = b1;
-        BlockName finger2 = b2;
+        List<PreorderIndex> idoms;
+        idoms.setCount(blockCount);
+        if(blockCount)
+            idoms[0] = kUndefined;
+        for(PreorderIndex w = 1; w < blockCount; ++w)
+        {
+            PreorderIndex idom = dfsParents[w];
+            while(idom > semis[w])
+                idom = idoms[idom];
+            idoms[w] = idom;
+        }
 
-        while(finger1 != finger2)
+        // Finally we translate the result over to postorder names.
+        //
+        doms.setCount(blockCount);
+        for(PreorderIndex w = 0; w < blockCount; ++w)
         {
-            while(finger1 < finger2)
-                finger1 = doms[finger1];
-            while(finger2 < finger1)
-                finger2 = doms[finger2];
+            PreorderIndex idom = idoms[w];
+            doms[preorderToName[w]] = idom == kUndefined ? kUndefined : preorderToName[idom];
         }
-        return finger1;
+    }
+
+    BlockName getBlockName(IRBlock* block)
+    {
+        return preorderToName[mapBlockToPreorderIndex[block]];
     }
 
     //
-    // Now that we've implemented Cooper et al. fairly close to how
-    // it was presented, we can build an array encoding the immediate
-    // dominator relationship. We still need to expand that array
+    // Now that we've computed the immediate dominators, we have
+    // an array encoding the immediate dominator relationship.
+    // We still need to expand that array
     // into an encoding that lets us efficiently answer queries
     // about dominance.
     //
@@ -517,10 +478,10 @@ struct DominatorTreeComputationContext
 
     RefPtr<IRDominatorTree> createDominatorTree(IRGlobalValueWithCode* code)
     {
-        // We first run the Cooper et al. algorithm to compute the `doms` array
+        // We first run the Semi-NCA algorithm to compute the `doms` array
         // which encodes immediate dominators.
         //
-        iterativelyComputeImmediateDominators(code);
+        computeImmediateDominators(code);
 
         // We will build some intermediate information on each
         // block to help us fill out the tree.
@@ -67,6 +67,7 @@ namespace Slang
                 IRBlock* operator*() const;
                 void operator++();
                 bool operator==(Iterator const& that) const;
+                bool operator!=(Iterator const& that) const { return !(*this == that); }
 
             private:
                 friend struct DominatedList;
@@ -0,0 +1,163 @@
+// slang-ir-dump.cpp
+#include "slang-ir-dump.h"
+
+#include "../core/slang-io.h"
+#include "../core/slang-writer.h"
+
+#include "slang-compiler.h"
+#include "slang-ir.h"
+#include "slang-ir-serialize.h"
+
+namespace Slang
+{
+
+namespace { // anonymous
+
+    /// A writer that only keeps a hash of what is written to it
+class HashWriter : public AppendBufferWriter
+{
+public:
+    typedef AppendBufferWriter Parent;
+    // ISlangWriter
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL write(const char* chars, size_t numChars) SLANG_OVERRIDE
+    {
+        m_hash = getHashCode64(chars, numChars, m_hash);
+        return SLANG_OK;
+    }
+
+    HashCode64 getHash() const { return m_hash; }
+
+    HashWriter() :
+        Parent(WriterFlag::IsStatic)
+    {}
+
+protected:
+    HashCode64 m_hash = 0;
+};
+
+} // anonymous
+
+    /// Turn a label such as "AFTER DCE" into a part of a file name, such as "after-dce"
+static String _getFileNameLabel(char const* label)
+{
+    StringBuilder builder;
+    for (char const* cursor = label; *cursor; ++cursor)
+    {
+        const char c = *cursor;
+        if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9'))
+            builder.append(c);
+        else if (c >= 'A' && c <= 'Z')
+            builder.append(char(c - 'A' + 'a'));
+        else
+            builder.append('-');
+    }
+    return builder;
+}
+
+IRDumper::IRDumper(CompileRequestBase* compileRequest, String const& name):
+    m_compileRequest(compileRequest),
+    m_name(name)
+{
+}
+
+HashCode64 IRDumper::_calcDumpHash(IRModule* module)
+{
+    HashWriter writer;
+    dumpIR(module, &writer, IRDumpMode::Simplified, m_compileRequest->irDumpOptions.globalValNames);
+    return writer.getHash();
+}
+
+void IRDumper::_dumpToSink(IRModule* module, char const* label)
+{
+    // Each global value is written separately, so buffer to give the sink a few large notes
+    DiagnosticSinkWriter sinkWriter(m_compileRequest->getSink());
+    BufferedWriter writerImpl(&sinkWriter, WriterFlag::IsStatic);
+    WriterHelper writer(&writerImpl);
+
+    if (label)
+    {
+        writer.put("### ");
+        writer.put(label);
+        writer.put(":\n");
+    }
+
+    dumpIR(module, writer.getWriter(), IRDumpMode::Simplified, m_compileRequest->irDumpOptions.globalValNames);
+
+    if (label)
+    {
+        writer.put("###\n");
+    }
+    writer.flush();
+}
+
+void IRDumper::_dumpToFile(IRModule* module, char const* label)
+{
+    const auto& options = m_compileRequest->irDumpOptions;
+
+    StringBuilder fileName;
+    fileName << m_name << "-";
+    // Pad the index, so the files sort in the order they were dumped
+    if (m_dumpCount < 10)
+        fileName << "0";
+    fileName << m_dumpCount << "-" << _getFileNameLabel(label ? label : "initial");
+    fileName << (options.binary ? ".slang-ir-bin" : ".slang-ir");
+    m_dumpCount++;
+
+    const String path = Path::combine(options.directory, fileName);
+
+    if (options.binary)
+    {
+        try
+        {
+            FileStream stream(path, FileMode::Create, FileAccess::Write, FileShare::None);
+
+            IRSerialWriter writer;
+            if (SLANG_SUCCEEDED(writer.writeStream(module, m_compileRequest->getSourceManager(), 0, IRSerialWriter::StreamOptions(), &stream)))
+                return;
+        }
+        catch (const IOException&)
+        {
+        }
+        m_compileRequest->getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, path);
+        return;
+    }
+
+    FILE* file = fopen(path.getBuffer(), "wb");
+    if (!file)
+    {
+        m_compileRequest->getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, path);
+        return;
+    }
+    FileWriter fileWriter(file, WriterFlag::IsStatic | WriterFlag::IsNotConsole);
+    BufferedWriter writer(&fileWriter, WriterFlag::IsStatic);
+    dumpIR(module, &writer, IRDumpMode::Simplified, options.globalValNames);
+}
+
+void IRDumper::dumpIfEnabled(IRModule* module, char const* label)
+{
+    if (!m_compileRequest->shouldDumpIR)
+        return;
+
+    const auto& options = m_compileRequest->irDumpOptions;
+    if (options.changesOnly)
+    {
+        const HashCode64 hash = _calcDumpHash(module);
+        if (m_hasPrevHash && hash == m_prevHash)
+            return;
+        m_hasPrevHash = true;
+        m_prevHash = hash;
+    }
+
+    if (options.directory.getLength())
+        _dumpToFile(module, label);
+    else
+        _dumpToSink(module, label);
+}
+
+void IRDumper::dumpPassIfEnabled(IRModule* module, char const* label)
+{
+    if (m_compileRequest->irDumpOptions.directory.getLength())
+        dumpIfEnabled(module, label);
+}
+
+}
@@ -0,0 +1,43 @@
+// slang-ir-dump.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+class CompileRequestBase;
+struct IRModule;
+
+    /// Dumps the IR of a module at successive points of its compilation (such as after each pass),
+    /// when IR dumping is enabled for a compile request, as set up by its `IRDumpOptions`.
+    ///
+    /// Dumps go to the diagnostics, unless a dump directory is set, in which case each dump is
+    /// streamed to its own file in the directory, named `<name>-<index>-<label>.slang-ir`
+    /// (or `.slang-ir-bin` for binary dumps).
+class IRDumper
+{
+public:
+        /// Dump `module`, if IR dumping is enabled. `label` describes the point in compilation, and can be null.
+    void dumpIfEnabled(IRModule* module, char const* label);
+        /// Dump `module` after the pass described by `label`, if IR dumping to a directory is enabled.
+        /// There are too many of these to be useful in the diagnostics.
+    void dumpPassIfEnabled(IRModule* module, char const* label);
+
+        /// `name` identifies the module in the names of dump files (e.g. the entry point and target)
+    IRDumper(CompileRequestBase* compileRequest, String const& name);
+
+protected:
+        /// Get a hash of the text dump of `module`, without holding the dump in memory
+    HashCode64 _calcDumpHash(IRModule* module);
+    void _dumpToSink(IRModule* module, char const* label);
+    void _dumpToFile(IRModule* module, char const* label);
+
+    CompileRequestBase* m_compileRequest;
+    String m_name;
+
+    Index m_dumpCount = 0;              ///< Used to number dump files, so they sort in the order they were dumped
+    bool m_hasPrevHash = false;
+    HashCode64 m_prevHash = 0;          ///< Hash of the previous dump, when only changes are dumped
+};
+
+}
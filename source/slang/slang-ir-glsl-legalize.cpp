@@ -13,21 +13,6 @@ namespace Slang
 // Legalization of entry points for GLSL:
 //
 
-IRGlobalParam* addGlobalParam(
-    IRModule*   module,
-    IRType*     valueType)
-{
-    auto session = module->session;
-
-    SharedIRBuilder shared;
-    shared.module = module;
-    shared.session = session;
-
-    IRBuilder builder;
-    builder.sharedBuilder = &shared;
-    return builder.createGlobalParam(valueType);
-}
-
 void moveValueBefore(
     IRInst*  valueToMove,
     IRInst*  placeBefore)
@@ -183,6 +168,10 @@ struct GLSLLegalizationContext
     DiagnosticSink*         sink;
     Stage                   stage;
 
+        /// The blocks of the entry point that end in a `return`, found on first use
+    List<IRBlock*>          returnBlocks;
+    bool                    hasFoundReturnBlocks = false;
+
     void requireGLSLExtension(String const& name)
     {
         glslExtensionTracker->requireExtension(name);
@@ -205,6 +194,26 @@ struct GLSLLegalizationContext
 
     IRBuilder* builder;
     IRBuilder* getBuilder() { return builder; }
+
+        /// Get the blocks of `func` (the entry point) that end in a `return`.
+        ///
+        /// Legalizing the result and each `out` parameter adds code before every
+        /// `return`, so they are only found once. Rewriting a `returnVal` into a
+        /// `return` keeps it at the end of the same block.
+    List<IRBlock*> const& getReturnBlocks(IRFunc* func)
+    {
+        if (!hasFoundReturnBlocks)
+        {
+            for (auto block : func->getBlocks())
+            {
+                auto terminator = block->getTerminator();
+                if (terminator && (terminator->op == kIROp_ReturnVal || terminator->op == kIROp_ReturnVoid))
+                    returnBlocks.add(block);
+            }
+            hasFoundReturnBlocks = true;
+        }
+        return returnBlocks;
+    }
 };
 
 GLSLSystemValueInfo* getGLSLSystemValueInfo(
@@ -637,7 +646,7 @@ ScalarizedVal createSimpleGLSLGlobalVarying(
     bool isOutput = kind == LayoutResourceKind::VaryingOutput;
     IRType* paramType = isOutput ? builder->getOutType(type) : type;
 
-    auto globalParam = addGlobalParam(builder->getModule(), paramType);
+    auto globalParam = builder->createGlobalParam(paramType);
     moveValueBefore(globalParam, builder->getFunc());
 
     ScalarizedVal val = isOutput ? ScalarizedVal::address(globalParam) : ScalarizedVal::value(globalParam);
@@ -1206,7 +1215,7 @@ void legalizeRayTracingEntryPointParameterForGLSL(
     // global shader parameter with exactly the type
     // of the original function parameter.
     //
-    auto globalParam = addGlobalParam(builder->getModule(), paramType);
+    auto globalParam = builder->createGlobalParam(paramType);
     builder->addLayoutDecoration(globalParam, paramLayout);
     moveValueBefore(globalParam, builder->getFunc());
     pp->replaceUsesWith(globalParam);
@@ -1453,23 +1462,11 @@ void legalizeEntryPointParameterForGLSL(
                 context,
                 builder, valueType, paramLayout, LayoutResourceKind::VaryingOutput, stage);
 
-        // Now we need to iterate over all the blocks in the function looking
-        // for any `return*` instructions, so that we can write to the output variable
-        for( auto bb = func->getFirstBlock(); bb; bb = bb->getNextBlock() )
+        // Now we need to visit all the `return*` instructions in the function,
+        // so that we can write to the output variable
+        for( auto bb : context->getReturnBlocks(func) )
         {
-            auto terminatorInst = bb->getLastInst();
-            if(!terminatorInst)
-                continue;
-
-            switch( terminatorInst->op )
-            {
-            default:
-                continue;
-
-            case kIROp_ReturnVal:
-            case kIROp_ReturnVoid:
-                break;
-            }
+            auto terminatorInst = bb->getTerminator();
 
             // We dont' re-use `builder` here because we don't want to
             // disrupt the source location it is using for inserting
@@ -1496,6 +1493,11 @@ void legalizeEntryPointParameterForGLSL(
             context,
             builder, paramType, paramLayout, LayoutResourceKind::VaryingInput, stage);
 
+        // An unused parameter still declares its inputs (so that the interface
+        // between stages is unchanged), but there is nothing to replace.
+        if(!pp->firstUse)
+            return;
+
         // Next we need to replace uses of the parameter with
         // references to the variable(s). We are going to do that
         // somewhat naively, by simply materializing the
@@ -1595,36 +1597,26 @@ void legalizeEntryPointForGLSL(
             LayoutResourceKind::VaryingOutput,
             stage);
 
-        for( auto bb = func->getFirstBlock(); bb; bb = bb->getNextBlock() )
+        // A `returnVal` can only appear as the terminator of a block
+        for( auto bb : context.getReturnBlocks(func) )
         {
-            // TODO: This is silly, because we are looking at every instruction,
-            // when we know that a `returnVal` should only ever appear as a
-            // terminator...
-            for( auto ii = bb->getFirstInst(); ii; ii = ii->getNextInst() )
-            {
-                if(ii->op != kIROp_ReturnVal)
-                    continue;
-
-                IRReturnVal* returnInst = (IRReturnVal*) ii;
-                IRInst* returnValue = returnInst->getVal();
+            auto returnInst = as<IRReturnVal>(bb->getTerminator());
+            if(!returnInst)
+                continue;
 
-                // Make sure we add these instructions to the right block
-                builder.setInsertInto(bb);
+            IRInst* returnValue = returnInst->getVal();
 
-                // Write to our global variable(s) from the value being returned.
-                assign(&builder, resultGlobal, ScalarizedVal::value(returnValue));
+            // Make sure we add these instructions to the right block
+            builder.setInsertInto(bb);
 
-                // Emit a `returnVoid` to end the block
-                auto returnVoid = builder.emitReturn();
+            // Write to our global variable(s) from the value being returned.
+            assign(&builder, resultGlobal, ScalarizedVal::value(returnValue));
 
-                // Remove the old `returnVal` instruction.
-                returnInst->removeAndDeallocate();
+            // Emit a `returnVoid` to end the block
+            builder.emitReturn();
 
-                // Make sure to resume our iteration at an
-                // appropriate instruciton, since we deleted
-                // the one we had been using.
-                ii = returnVoid;
-            }
+            // Remove the old `returnVal` instruction.
+            returnInst->removeAndDeallocate();
         }
     }
 
@@ -0,0 +1,335 @@
+// slang-ir-inline.cpp
+#include "slang-ir-inline.h"
+
+#include "slang-ir.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+/* static */IRInliningOptions IRInliningOptions::getForOptimizationLevel(SlangOptimizationLevel level)
+{
+    IRInliningOptions options;
+    switch (level)
+    {
+        case SLANG_OPTIMIZATION_LEVEL_NONE:
+            break;
+        default:
+        case SLANG_OPTIMIZATION_LEVEL_DEFAULT:
+            options.maxCost = 16;
+            options.maxSingleCallCost = 256;
+            break;
+        case SLANG_OPTIMIZATION_LEVEL_HIGH:
+            options.maxCost = 64;
+            options.maxSingleCallCost = 1024;
+            break;
+        case SLANG_OPTIMIZATION_LEVEL_MAXIMAL:
+            options.maxCost = 256;
+            options.maxSingleCallCost = 0x7fffffff;
+            break;
+    }
+    return options;
+}
+
+struct FunctionInliningContext
+{
+    IRModule* module;
+    IRInliningOptions options;
+
+    SharedIRBuilder sharedBuilder;
+
+        /// Functions that can be inlined by the current round
+    HashSet<IRFunc*> inlinableFuncs;
+
+    static Index _calcCost(IRFunc* func)
+    {
+        Index cost = 0;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                // Parameters and phis don't produce any code themselves
+                if (inst->op != kIROp_Param)
+                    cost++;
+            }
+        }
+        return cost;
+    }
+
+        /// Get the function called by `call`, if it is a function in this module
+    static IRFunc* _getCalledFunc(IRCall* call)
+    {
+        auto func = as<IRFunc>(call->getCallee());
+        return (func && func->getParent() == call->getModule()->getModuleInst()) ? func : nullptr;
+    }
+
+        /// Get the block with the `return` of `func`.
+        ///
+        /// Returns nullptr unless there is exactly one return, and it can be reached from the
+        /// entry block without entering any structured control flow. The code after an inlined
+        /// call can then simply follow the return, without changing the structure of the caller.
+        ///
+    static IRBlock* _findStructuredReturnBlock(IRFunc* func)
+    {
+        IRBlock* returnBlock = nullptr;
+        for (auto block : func->getBlocks())
+        {
+            auto terminator = block->getTerminator();
+            if (!terminator)
+                return nullptr;
+
+            switch (terminator->op)
+            {
+                case kIROp_ReturnVal:
+                case kIROp_ReturnVoid:
+                {
+                    if (returnBlock)
+                        return nullptr;
+                    returnBlock = block;
+                    break;
+                }
+                // Unstructured branches can't be restructured in the caller, and
+                // reaching the end of a function without a return can't be expressed there
+                case kIROp_conditionalBranch:
+                case kIROp_Unreachable:
+                case kIROp_MissingReturn:
+                    return nullptr;
+                default:
+                    break;
+            }
+        }
+
+        // Follow the outermost structured region from the entry block
+        HashSet<IRBlock*> visited;
+        IRBlock* block = func->getFirstBlock();
+        while (block && !visited.Contains(block))
+        {
+            if (block == returnBlock)
+                return block;
+            visited.Add(block);
+
+            auto terminator = block->getTerminator();
+            switch (terminator->op)
+            {
+                case kIROp_unconditionalBranch:
+                    block = as<IRUnconditionalBranch>(terminator)->getTargetBlock();
+                    break;
+                case kIROp_ifElse:
+                    block = as<IRIfElse>(terminator)->getAfterBlock();
+                    break;
+                case kIROp_loop:
+                    block = as<IRLoop>(terminator)->getBreakBlock();
+                    break;
+                case kIROp_Switch:
+                    block = as<IRSwitch>(terminator)->getBreakLabel();
+                    break;
+                default:
+                    return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+    static bool _isSingleCall(IRFunc* func)
+    {
+        auto use = func->firstUse;
+        if (!use || use->nextUse)
+            return false;
+        auto call = as<IRCall>(use->getUser());
+        return call && call->getCallee() == func;
+    }
+
+    bool _canInline(IRFunc* func)
+    {
+        if (!func->isDefinition() ||
+            func->findDecorationImpl(kIROp_EntryPointDecoration) ||
+            func->findDecorationImpl(kIROp_KeepAliveDecoration))
+        {
+            return false;
+        }
+        for (auto decoration : func->getDecorations())
+        {
+            // The body isn't the definition used for every target
+            if (as<IRTargetSpecificDecoration>(decoration))
+                return false;
+        }
+
+        // The parameters of the entry block are the parameters of the function, so
+        // nothing can branch to it
+        if (func->getFirstBlock()->firstUse)
+            return false;
+
+        const Index cost = _calcCost(func);
+        if (cost > options.maxCost && !(cost <= options.maxSingleCallCost && _isSingleCall(func)))
+            return false;
+
+        return _findStructuredReturnBlock(func) != nullptr;
+    }
+
+        /// True if `func` calls a function that can be inlined, so should have those
+        /// calls inlined before it is inlined itself
+    bool _callsInlinableFunc(IRFunc* func)
+    {
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto call = as<IRCall>(inst);
+                if (!call)
+                    continue;
+                auto callee = _getCalledFunc(call);
+                if (callee && inlinableFuncs.Contains(callee))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void _inlineCall(IRCall* call, IRFunc* callee)
+    {
+        auto callBlock = as<IRBlock>(call->getParent());
+        auto caller = as<IRFunc>(callBlock->getParent());
+
+        // Clone the callee with its parameters replaced by the arguments. The clone is
+        // a temporary function, which the blocks are then moved out of.
+        IRCloneEnv env;
+        {
+            UInt argIndex = 0;
+            for (auto param : callee->getFirstBlock()->getParams())
+            {
+                env.mapOldValToNew.add(param, call->getArg(argIndex++));
+            }
+        }
+
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+        builder.setInsertBefore(caller);
+        IRFunc* clonedFunc = as<IRFunc>(cloneInst(&env, &builder, callee));
+
+        // Blocks are cloned in order, so the return block is in the same position in the clone
+        IRBlock* returnBlock = _findStructuredReturnBlock(callee);
+        IRBlock* clonedReturnBlock = clonedFunc->getFirstBlock();
+        for (auto block = callee->getFirstBlock(); block != returnBlock; block = block->getNextBlock())
+        {
+            clonedReturnBlock = clonedReturnBlock->getNextBlock();
+        }
+
+        IRBlock* clonedEntryBlock = clonedFunc->getFirstBlock();
+        IRTerminatorInst* clonedReturn = clonedReturnBlock->getTerminator();
+        IRInst* returnVal = as<IRReturnVal>(clonedReturn) ? as<IRReturnVal>(clonedReturn)->getVal() : nullptr;
+
+        if (clonedEntryBlock == clonedReturnBlock)
+        {
+            // A single block, so the body can just be placed before the call
+            while (auto inst = clonedEntryBlock->getFirstChild())
+            {
+                if (inst == clonedReturn)
+                    break;
+                inst->removeFromParent();
+                inst->insertBefore(call);
+            }
+        }
+        else
+        {
+            // Split the block at the call, so that the body goes between the code
+            // before the call and the code after it
+            IRBlock* afterBlock = builder.createBlock();
+            afterBlock->insertAfter(callBlock);
+            while (auto inst = call->getNextInst())
+            {
+                inst->insertAtEnd(afterBlock);
+            }
+
+            IRBlock* insertAfterBlock = callBlock;
+            while (auto block = clonedFunc->getFirstBlock())
+            {
+                block->insertAfter(insertAfterBlock);
+                insertAfterBlock = block;
+            }
+
+            builder.setInsertInto(callBlock);
+            builder.emitBranch(clonedEntryBlock);
+
+            builder.setInsertBefore(clonedReturn);
+            builder.emitBranch(afterBlock);
+        }
+
+        if (returnVal)
+        {
+            call->replaceUsesWith(returnVal);
+        }
+        call->removeAndDeallocate();
+        clonedReturn->removeAndDeallocate();
+        clonedFunc->removeAndDeallocate();
+    }
+
+        /// Inline the calls that can be inlined in this round. Returns the number inlined.
+    Index inlineOnce()
+    {
+        inlinableFuncs.Clear();
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(inst);
+            if (func && _canInline(func))
+                inlinableFuncs.Add(func);
+        }
+
+        // Only functions with no calls left to inline are inlined in a round. Recursive
+        // functions never get there, so are never inlined.
+        List<IRCall*> calls;
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto caller = as<IRFunc>(inst);
+            if (!caller)
+                continue;
+            for (auto block : caller->getBlocks())
+            {
+                for (auto child : block->getChildren())
+                {
+                    auto call = as<IRCall>(child);
+                    if (!call)
+                        continue;
+                    auto callee = _getCalledFunc(call);
+                    if (callee && callee != caller && inlinableFuncs.Contains(callee) && !_callsInlinableFunc(callee))
+                        calls.add(call);
+                }
+            }
+        }
+
+        for (auto call : calls)
+        {
+            module->checkBudget();
+            _inlineCall(call, _getCalledFunc(call));
+        }
+        return calls.getCount();
+    }
+
+    Index processModule()
+    {
+        Index inlinedCount = 0;
+        if (!options.isEnabled())
+            return inlinedCount;
+
+        for (;;)
+        {
+            const Index count = inlineOnce();
+            if (count == 0)
+                break;
+            inlinedCount += count;
+        }
+        return inlinedCount;
+    }
+};
+
+Index inlineFunctionCalls(IRModule* module, const IRInliningOptions& options)
+{
+    FunctionInliningContext context;
+    context.module = module;
+    context.options = options;
+    context.sharedBuilder.module = module;
+    context.sharedBuilder.session = module->getSession();
+    return context.processModule();
+}
+
+}
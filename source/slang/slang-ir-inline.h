@@ -0,0 +1,46 @@
+// slang-ir-inline.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Controls which calls `inlineFunctionCalls` inlines.
+        ///
+        /// The cost of a function is the number of instructions in its body.
+        ///
+    struct IRInliningOptions
+    {
+            /// Functions costing at most this much are inlined at every call site. Negative means none are.
+        Index maxCost = -1;
+            /// Functions that are only used by a single call, and cost at most this much, are inlined.
+            /// Inlining these doesn't duplicate any code, so this is usually larger than `maxCost`.
+        Index maxSingleCallCost = -1;
+
+            /// True if any calls can be inlined with these options
+        bool isEnabled() const { return maxCost >= 0 || maxSingleCallCost >= 0; }
+
+            /// Get the options to use for an optimization level
+        static IRInliningOptions getForOptimizationLevel(SlangOptimizationLevel level);
+    };
+
+        /// Inline calls to small functions, and to functions that are only called once, in `module`.
+        ///
+        /// Without this every helper function becomes a function in the output code, and
+        /// the deep call chains that generic code produces reach the downstream compiler intact.
+        ///
+        /// A function can only be inlined if it is a definition, is not an entry point or
+        /// kept alive, has no target specific definitions, is not recursive, and has a single
+        /// `return` that is not nested inside of any structured control flow (so that the code
+        /// after the call can follow it). Calls are inlined bottom up, so that a callee has had
+        /// its own calls inlined before it is inlined into its callers.
+        ///
+        /// Inlining leaves functions that may no longer be called, and arguments that can
+        /// now be folded, so should be followed by SCCP and DCE.
+        ///
+        /// Returns the number of calls that were inlined.
+        ///
+    Index inlineFunctionCalls(IRModule* module, const IRInliningOptions& options);
+}
@@ -418,6 +418,10 @@ INST(HighLevelDeclDecoration,               highLevelDecl,          1, 0)
         /// A `[format(f)]` decoration specifies that the format of an image should be `f`
     INST(FormatDecoration, format, 1, 0)
 
+        /// A `[specializationConstant(id)]` decoration marks a global constant whose value can be
+        /// set when a pipeline is created, using the given constant id.
+    INST(SpecializationConstantDecoration, specializationConstant, 1, 0)
+
     /* LinkageDecoration */
         INST(ImportDecoration, import, 1, 0)
         INST(ExportDecoration, export, 1, 0)
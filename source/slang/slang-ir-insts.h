@@ -272,6 +272,16 @@ struct IRFormatDecoration : IRDecoration
     }
 };
 
+struct IRSpecializationConstantDecoration : IRDecoration
+{
+    enum { kOp = kIROp_SpecializationConstantDecoration };
+    IR_LEAF_ISA(SpecializationConstantDecoration)
+
+    IRIntLit* getIDOperand() { return cast<IRIntLit>(getOperand(0)); }
+
+    IRIntegerValue getID() { return getIDOperand()->getValue(); }
+};
+
 // An instruction that specializes another IR value
 // (representing a generic) to a particular set of generic arguments 
 // (instructions representing types, witness tables, etc.)
@@ -658,11 +668,20 @@ struct IRWrapExistential : IRInst
 
 
 // Description of an instruction to be used for global value numbering
+//
+// The structural hash of the instruction (its opcode, type and operands)
+// is computed once when the key is made and stored along with it, so that
+// the map doesn't need to rehash every operand when it grows, and most
+// mismatching keys are rejected without looking at the operands.
 struct IRInstKey
 {
     IRInst* inst;
+    int     hashCode;
 
-    int GetHashCode();
+    static IRInstKey make(IRInst* inst) { IRInstKey key = { inst, calcHashCode(inst) }; return key; }
+    static int calcHashCode(IRInst* inst);
+
+    int GetHashCode() const { return hashCode; }
 };
 
 bool operator==(IRInstKey const& left, IRInstKey const& right);
@@ -725,6 +744,10 @@ struct IRBuilder
 
     IRBuilderSourceLocRAII* sourceLocInfo = nullptr;
 
+        /// If set, instructions are created with space for a source location even if
+        /// they are created without one (so one can be set later, as is done when cloning)
+    bool reserveSourceLocSlot = false;
+
     void addInst(IRInst* inst);
 
     IRInst* getBoolValue(bool value);
@@ -1294,6 +1317,11 @@ struct IRBuilder
     {
         addDecoration(inst, kIROp_FormatDecoration, format);
     }
+
+    void addSpecializationConstantDecoration(IRInst* inst, IRIntegerValue id)
+    {
+        addDecoration(inst, kIROp_SpecializationConstantDecoration, getIntValue(getIntType(), id));
+    }
 };
 
 void addHoistableInst(
@@ -1326,6 +1354,28 @@ struct IRBuilderSourceLocRAII
     }
 };
 
+// Helper to make an IRBuilder reserve space for a source location
+// in the instructions it creates (see `IRBuilder::reserveSourceLocSlot`).
+struct IRBuilderReserveSourceLocSlotRAII
+{
+    IRBuilder*  builder;
+    bool        previous;
+
+    IRBuilderReserveSourceLocSlotRAII(
+        IRBuilder*  builder,
+        bool        reserve)
+        : builder(builder)
+        , previous(builder->reserveSourceLocSlot)
+    {
+        builder->reserveSourceLocSlot = reserve;
+    }
+
+    ~IRBuilderReserveSourceLocSlotRAII()
+    {
+        builder->reserveSourceLocSlot = previous;
+    }
+};
+
 //
 
 void markConstExpr(
@@ -10,6 +10,8 @@
 // fully specialized (no more generics/interfaces), so
 // that the concrete type of everything is known.
 
+#include "../core/slang-short-list.h"
+
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
@@ -193,8 +195,11 @@ static LegalVal legalizeOperand(
     return LegalVal::simple(irValue);
 }
 
+    /// The arguments of a call after legalization. Most calls have few enough not to allocate.
+typedef ShortList<IRInst*, 16> LegalArgList;
+
 static void getArgumentValues(
-    List<IRInst*> & instArgs,
+    LegalArgList&   instArgs,
     LegalVal val)
 {
     switch (val.flavor)
@@ -253,7 +258,7 @@ static LegalVal legalizeCall(
         SLANG_UNEXPECTED("unimplemented legalized return type for IRInstCall.");
     }
 
-    List<IRInst*> instArgs;
+    LegalArgList instArgs;
     for (auto i = 1u; i < callInst->getOperandCount(); i++)
         getArgumentValues(instArgs, legalizeOperand(context, callInst->getOperand(i)));
 
@@ -1483,7 +1488,10 @@ static LegalVal legalizeInst(
     return legalVal;
 }
 
-static void addParamType(List<IRType*>& ioParamTypes, LegalType t)
+    /// The parameter types of a function after legalization
+typedef ShortList<IRType*, 16> LegalParamTypeList;
+
+static void addParamType(LegalParamTypeList& ioParamTypes, LegalType t)
 {
     switch (t.flavor)
     {
@@ -1565,7 +1573,7 @@ static LegalVal legalizeFunc(
     default:
         SLANG_UNEXPECTED("unknown legalized function return type.");
     }
-    List<IRType*> newParamTypes;
+    LegalParamTypeList newParamTypes;
     for (UInt pp = 0; pp < oldParamCount; ++pp)
     {
         auto legalParamType = legalizeType(context, oldFuncType->getParamType(pp));
@@ -1891,6 +1899,46 @@ static void _addFieldsToWrappedBufferElementTypeLayout(
     }
 }
 
+    /// Collect the IR keys of the fields of a wrapped buffer's element type, in the
+    /// same order as `_addFieldsToWrappedBufferElementTypeLayout` adds their layouts.
+static void _collectWrappedBufferFieldKeys(
+    LegalElementWrapping const& elementInfo,
+    List<IRInst*>&              outKeys)
+{
+    switch( elementInfo.flavor )
+    {
+    case LegalElementWrapping::Flavor::none:
+        break;
+
+    case LegalElementWrapping::Flavor::simple:
+        outKeys.add(elementInfo.getSimple()->key);
+        break;
+
+    case LegalElementWrapping::Flavor::implicitDeref:
+        _collectWrappedBufferFieldKeys(elementInfo.getImplicitDeref()->field, outKeys);
+        break;
+
+    case LegalElementWrapping::Flavor::pair:
+        {
+            auto pairElementInfo = elementInfo.getPair();
+            _collectWrappedBufferFieldKeys(pairElementInfo->ordinary, outKeys);
+            _collectWrappedBufferFieldKeys(pairElementInfo->special, outKeys);
+        }
+        break;
+
+    case LegalElementWrapping::Flavor::tuple:
+        for( auto ee : elementInfo.getTuple()->elements )
+        {
+            _collectWrappedBufferFieldKeys(ee.field, outKeys);
+        }
+        break;
+
+    default:
+        SLANG_UNEXPECTED("unhandled element wrapping flavor");
+        break;
+    }
+}
+
     /// Add offset information for `kind` to `resultVarLayout`,
     /// if it doesn't already exist, and adjust the offset so
     /// that it will represent an offset relative to the
@@ -1986,6 +2034,61 @@ static void addOffsetResInfo(
     }
 }
 
+    /// Create layout information for a wrapped buffer type from the layout
+    /// `cachedTypeLayout` created for the same buffer (possibly in another module).
+    ///
+    /// The layouts of the fields don't depend on the module, but the layout of the
+    /// element type maps the IR keys of its fields to them, so it needs to be
+    /// re-created for a module with other keys.
+    ///
+static RefPtr<TypeLayout> _reuseWrappedBufferTypeLayout(
+    ParameterGroupTypeLayout*   cachedTypeLayout,
+    ParameterGroupTypeLayout*   oldParameterGroupTypeLayout,
+    LegalElementWrapping const& elementInfo)
+{
+    auto cachedElementTypeLayout = as<StructTypeLayout>(cachedTypeLayout->elementVarLayout->typeLayout);
+    auto const& fields = cachedElementTypeLayout->fields;
+
+    List<IRInst*> fieldKeys;
+    _collectWrappedBufferFieldKeys(elementInfo, fieldKeys);
+    SLANG_ASSERT(fieldKeys.getCount() == fields.getCount());
+
+    bool isSameKeys = true;
+    for( Index i = 0; i < fieldKeys.getCount() && isSameKeys; ++i )
+    {
+        auto fieldLayout = cachedElementTypeLayout->mapKeyToLayout.TryGetValue(fieldKeys[i]);
+        isSameKeys = fieldLayout && *fieldLayout == fields[i];
+    }
+    if( isSameKeys )
+        return cachedTypeLayout;
+
+    RefPtr<StructTypeLayout> newElementTypeLayout = new StructTypeLayout();
+    newElementTypeLayout->type = cachedElementTypeLayout->type;
+    newElementTypeLayout->fields = fields;
+    for( Index i = 0; i < fieldKeys.getCount(); ++i )
+    {
+        newElementTypeLayout->mapKeyToLayout.Add(fieldKeys[i], fields[i]);
+    }
+
+    RefPtr<ParameterGroupTypeLayout> newTypeLayout = new ParameterGroupTypeLayout();
+    newTypeLayout->type = cachedTypeLayout->type;
+    newTypeLayout->rules = cachedTypeLayout->rules;
+    newTypeLayout->uniformAlignment = cachedTypeLayout->uniformAlignment;
+    newTypeLayout->resourceInfos = cachedTypeLayout->resourceInfos;
+    newTypeLayout->containerVarLayout = cachedTypeLayout->containerVarLayout;
+
+    LegalVarChainLink elementVarChain(LegalVarChain(), oldParameterGroupTypeLayout->elementVarLayout);
+    newTypeLayout->elementVarLayout = createVarLayout(elementVarChain, newElementTypeLayout);
+
+    // The offset element type layout doesn't map the keys, unless it is the element type layout itself
+    if( cachedTypeLayout->offsetElementTypeLayout.Ptr() == cachedElementTypeLayout )
+        newTypeLayout->offsetElementTypeLayout = newElementTypeLayout;
+    else
+        newTypeLayout->offsetElementTypeLayout = cachedTypeLayout->offsetElementTypeLayout;
+
+    return newTypeLayout;
+}
+
     /// Create layout information for a wrapped buffer type.
     ///
     /// A wrapped buffer type encodes a buffer like `ConstantBuffer<Foo>`
@@ -2014,7 +2117,12 @@ static void addOffsetResInfo(
     /// of the surrounding context (e.g., the global shader parameter
     /// that has this type).
     ///
+    /// The layout only depends on `oldTypeLayout` and the offsets of
+    /// the pending data in `outerVarChain`, so if `cache` is set the
+    /// layout is shared with other buffers and modules that have the same.
+    ///
 static RefPtr<TypeLayout> _createWrappedBufferTypeLayout(
+    IRTypeLegalizationCache*    cache,
     TypeLayout*                 oldTypeLayout,
     WrappedBufferPseudoType*    wrappedBufferTypeInfo,
     LegalVarChain const&        outerVarChain)
@@ -2027,26 +2135,6 @@ static RefPtr<TypeLayout> _createWrappedBufferTypeLayout(
     if(!oldParameterGroupTypeLayout)
         return oldTypeLayout;
 
-    // The original type must have been split between the direct/primary
-    // data and some amount of "pending" data to deal with interface-type
-    // data in the element type of the parameter group.
-    //
-    // The legalization step will have already flattened the data inside of
-    // the group to a single `struct` type, which places the primary data first,
-    // and then any pending data into additional fields.
-    //
-    // Our job is to compute a type layout that we can apply to that new
-    // element type, and to a parameter group surrounding it, that will
-    // re-create the original intention of the split layout (both primary
-    // and pending data) for a type that now only has the "primary" data.
-    //
-    RefPtr<ParameterGroupTypeLayout> newTypeLayout = new ParameterGroupTypeLayout();
-    newTypeLayout->type = oldTypeLayout->type;
-    newTypeLayout->rules = oldTypeLayout->rules;
-    newTypeLayout->uniformAlignment = oldTypeLayout->uniformAlignment;
-    for(auto resInfo : oldTypeLayout->resourceInfos)
-        newTypeLayout->addResourceUsage(resInfo);
-
     // Any fields in the "pending" data will have offset information
     // that is relative to the pending data for their parent, and so on.
     // We need to compute layout information that only includes primary
@@ -2068,6 +2156,46 @@ static RefPtr<TypeLayout> _createWrappedBufferTypeLayout(
     auto offsetVarLayout = _createOffsetVarLayout(outerVarChain, oldTypeLayout->pendingDataTypeLayout);
     LegalVarChainLink offsetVarChain(LegalVarChain(), offsetVarLayout);
 
+    // The rest of the layout only depends on the old layout and the
+    // offsets, so we may have already created it.
+    //
+    IRTypeLegalizationCache::WrappedBufferLayoutKey cacheKey;
+    if( cache )
+    {
+        cacheKey.typeLayout = oldTypeLayout;
+        cacheKey.offsets = offsetVarLayout->resourceInfos;
+
+        if( auto cachedTypeLayout = cache->wrappedBufferLayouts.TryGetValue(cacheKey) )
+        {
+            cache->wrappedBufferLayoutHitCount++;
+            return _reuseWrappedBufferTypeLayout(
+                *cachedTypeLayout,
+                oldParameterGroupTypeLayout,
+                wrappedBufferTypeInfo->elementInfo);
+        }
+        cache->wrappedBufferLayoutMissCount++;
+    }
+
+    // The original type must have been split between the direct/primary
+    // data and some amount of "pending" data to deal with interface-type
+    // data in the element type of the parameter group.
+    //
+    // The legalization step will have already flattened the data inside of
+    // the group to a single `struct` type, which places the primary data first,
+    // and then any pending data into additional fields.
+    //
+    // Our job is to compute a type layout that we can apply to that new
+    // element type, and to a parameter group surrounding it, that will
+    // re-create the original intention of the split layout (both primary
+    // and pending data) for a type that now only has the "primary" data.
+    //
+    RefPtr<ParameterGroupTypeLayout> newTypeLayout = new ParameterGroupTypeLayout();
+    newTypeLayout->type = oldTypeLayout->type;
+    newTypeLayout->rules = oldTypeLayout->rules;
+    newTypeLayout->uniformAlignment = oldTypeLayout->uniformAlignment;
+    for(auto resInfo : oldTypeLayout->resourceInfos)
+        newTypeLayout->addResourceUsage(resInfo);
+
     // We will start our construction of the pieces of the output
     // type layout by looking at the "container" type/variable.
     //
@@ -2214,6 +2342,11 @@ static RefPtr<TypeLayout> _createWrappedBufferTypeLayout(
         newElementTypeLayout,
         newElementVarLayout);
 
+    if( cache )
+    {
+        cache->wrappedBufferLayouts.Add(cacheKey, newTypeLayout);
+    }
+
     return newTypeLayout;
 }
 
@@ -2344,7 +2477,7 @@ static LegalVal declareVars(
         {
             auto wrappedBuffer = type.getWrappedBuffer();
 
-            auto wrappedTypeLayout = _createWrappedBufferTypeLayout(typeLayout, wrappedBuffer, varChain);
+            auto wrappedTypeLayout = _createWrappedBufferTypeLayout(context->cache, typeLayout, wrappedBuffer, varChain);
 
             auto innerVal = declareSimpleVar(
                 context,
@@ -2509,6 +2642,11 @@ static LegalVal legalizeGlobalParam(
 static void legalizeTypes(
     IRTypeLegalizationContext*    context)
 {
+    // The pseudo-types and values made along the way are only used during the pass,
+    // so they are held in a pool of their own.
+    RefPtr<RefObjectPool> pool = new RefObjectPool();
+    RefObjectPoolScope poolScope(pool);
+
     // Legalize all the top-level instructions in the module
     auto module = context->module;
     legalizeInstsInParent(context, module->moduleInst);
@@ -2596,29 +2734,67 @@ struct IRExistentialTypeLegalizationContext : IRTypeLegalizationContext
     }
 };
 
+bool IRTypeLegalizationCache::WrappedBufferLayoutKey::operator==(WrappedBufferLayoutKey const& other) const
+{
+    if(typeLayout != other.typeLayout || offsets.getCount() != other.offsets.getCount())
+        return false;
+    for(Index i = 0; i < offsets.getCount(); ++i)
+    {
+        auto const& offset = offsets[i];
+        auto const& otherOffset = other.offsets[i];
+        if(offset.kind != otherOffset.kind || offset.index != otherOffset.index || offset.space != otherOffset.space)
+            return false;
+    }
+    return true;
+}
+
+int IRTypeLegalizationCache::WrappedBufferLayoutKey::GetHashCode() const
+{
+    int hash = Slang::GetHashCode(typeLayout.Ptr());
+    for(auto const& offset : offsets)
+    {
+        hash = combineHash(hash, Slang::GetHashCode(int(offset.kind)));
+        hash = combineHash(hash, Slang::GetHashCode(offset.index));
+        hash = combineHash(hash, Slang::GetHashCode(offset.space));
+    }
+    return hash;
+}
+
 // The main entry points that are used when transforming IR code
 // to get it ready for lower-level codegen are then simple
 // wrappers around `legalizeTypes()` that pick an appropriately
 // specialized context type to use to get the job done.
 
 void legalizeResourceTypes(
-    IRModule*       module,
-    DiagnosticSink* sink)
+    IRModule*                   module,
+    DiagnosticSink*             sink,
+    IRTypeLegalizationCache*    cache)
 {
     SLANG_UNUSED(sink);
 
     IRResourceTypeLegalizationContext context(module);
+    if(cache)
+    {
+        context.cache = cache;
+        context.cachedStructFlavors = &cache->resourceStructFlavors;
+    }
     legalizeTypes(&context);
 }
 
 void legalizeExistentialTypeLayout(
-    IRModule*       module,
-    DiagnosticSink* sink)
+    IRModule*                   module,
+    DiagnosticSink*             sink,
+    IRTypeLegalizationCache*    cache)
 {
     SLANG_UNUSED(module);
     SLANG_UNUSED(sink);
 
     IRExistentialTypeLegalizationContext context(module);
+    if(cache)
+    {
+        context.cache = cache;
+        context.cachedStructFlavors = &cache->existentialStructFlavors;
+    }
     legalizeTypes(&context);
 }
 
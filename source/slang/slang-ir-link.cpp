@@ -2,7 +2,11 @@
 #include "slang-ir-link.h"
 
 #include "slang-ir.h"
+#include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-serialize.h"
+#include "slang-ir-specialization-cache.h"
+#include "slang-legalize-types.h"
 #include "slang-mangle.h"
 
 namespace Slang
@@ -28,10 +32,127 @@ struct IRSpecEnv
     IRSpecEnv*  parent = nullptr;
 
     // A map from original values to their cloned equivalents.
-    typedef Dictionary<IRInst*, IRInst*> ClonedValueDictionary;
-    ClonedValueDictionary clonedValues;
+    IRInstMap clonedValues;
 };
 
+    /// The global values of an IR module by mangled name (see `IRModule::getLinkSymbols`).
+    ///
+    /// Only depends on the module, so it is built once and kept with the module, however
+    /// many programs and targets link against it.
+    ///
+struct IRModuleLinkSymbols
+{
+        /// The first global value with each mangled name. For a module that is read lazily, only the names that have been looked up.
+    Dictionary<String, IRInst*> values;
+        /// The next global value with the same mangled name, for the values that have one
+    Dictionary<IRInst*, IRInst*> nextValues;
+        /// The first global value with each mangled name that is a witness table, in module order
+    List<IRWitnessTable*> witnessTables;
+        /// The reader that creates the global values of the module as they are looked up, if the module is read lazily
+    IRSerialLazyReader* lazyReader = nullptr;
+};
+
+    /// Get the first global value with mangledName in the module, or nullptr if there is none.
+static IRInst* _findModuleLinkValue(IRModuleLinkSymbols* moduleSymbols, String const& mangledName)
+{
+    IRInst* value = nullptr;
+    if (moduleSymbols->values.TryGetValue(mangledName, value) || !moduleSymbols->lazyReader)
+        return value;
+
+    // Create the values with the name, and add them to the table so they are only created once
+    List<IRInst*> lazyValues;
+    moduleSymbols->lazyReader->findGlobalValues(mangledName.getUnownedSlice(), lazyValues);
+    if (lazyValues.getCount() == 0)
+        return nullptr;
+
+    moduleSymbols->values.Add(mangledName, lazyValues[0]);
+    for (Index i = 1; i < lazyValues.getCount(); ++i)
+        moduleSymbols->nextValues.Add(lazyValues[i - 1], lazyValues[i]);
+    return lazyValues[0];
+}
+
+    /// Returns true if the module has a global value with mangledName, without creating it if the module is read lazily
+static bool _hasModuleLinkValue(IRModuleLinkSymbols* moduleSymbols, String const& mangledName)
+{
+    return moduleSymbols->values.ContainsKey(mangledName) ||
+        (moduleSymbols->lazyReader && moduleSymbols->lazyReader->hasGlobalValue(mangledName.getUnownedSlice()));
+}
+
+    /// Information used when linking entry points for a target, that doesn't depend on the entry point.
+    ///
+    /// Each entry point needs its own clones of the global values it uses, because later
+    /// passes modify the linked module in place. The symbol table for all of the modules the
+    /// program depends on, the best declaration of each symbol for the target, and the layouts
+    /// of global-scope shader parameters are the same for every entry point though. A
+    /// `TargetProgram` holds this information (see `TargetProgram::getIRLinkCache`), so that it
+    /// is only computed once however many entry points are linked.
+    ///
+struct IRLinkCache
+{
+    // A map from mangled symbol names to zero or
+    // more global IR values that have that name,
+    // in the *original* modules.
+    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
+
+    // The inputs the cache was built from. The cache is rebuilt if they change.
+    CodeGenTarget       target = CodeGenTarget::Unknown;
+    IRModule*           programIRModule = nullptr;
+    ProgramLayout*      programLayout = nullptr;
+
+    // The symbol tables of the program's module and the modules it depends on, in lookup order.
+    // They are owned by the modules, so building the cache doesn't need to visit every global value.
+    List<IRModuleLinkSymbols*> moduleSymbols;
+
+    // The symbols that have been looked up so far (see `findLinkSymbol`), with the values
+    // from all of the modules. Names that weren't found map to null.
+    SymbolDictionary symbols;
+
+    // The witness tables that are the first value with their name, which are cloned for every entry point
+    List<IRWitnessTable*> witnessTables;
+
+    // The best value for the target, for each symbol that has been looked up so far
+    Dictionary<IRSpecSymbol*, IRInst*> bestValuesForTarget;
+
+    // A map from the mangled name of a global-scope shader parameter to its layout
+    Dictionary<String, VarLayout*> globalVarLayouts;
+};
+
+    /// Find the values with `mangledName` in the modules of the link cache, or nullptr if there are none.
+static IRSpecSymbol* findLinkSymbol(IRLinkCache* linkCache, String const& mangledName)
+{
+    if (auto found = linkCache->symbols.TryGetValue(mangledName))
+        return found->Ptr();
+
+    // Chain together the values with the name from each module, in lookup order,
+    // so that the first one found is the head of the chain
+    RefPtr<IRSpecSymbol> firstSym;
+    IRSpecSymbol* lastSym = nullptr;
+    for (auto moduleSymbols : linkCache->moduleSymbols)
+    {
+        IRInst* value = _findModuleLinkValue(moduleSymbols, mangledName);
+        if (!value)
+            continue;
+        for (;;)
+        {
+            RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
+            sym->irGlobalValue = value;
+            if (lastSym)
+                lastSym->nextWithSameName = sym;
+            else
+                firstSym = sym;
+            lastSym = sym;
+
+            auto nextValue = moduleSymbols->nextValues.TryGetValue(value);
+            if (!nextValue)
+                break;
+            value = *nextValue;
+        }
+    }
+
+    linkCache->symbols.Add(mangledName, firstSym);
+    return firstSym;
+}
+
 struct IRSharedSpecContext
 {
     // The code-generation target in use
@@ -40,11 +161,8 @@ struct IRSharedSpecContext
     // The specialized module we are building
     RefPtr<IRModule>   module;
 
-    // A map from mangled symbol names to zero or
-    // more global IR values that have that name,
-    // in the *original* module.
-    typedef Dictionary<String, RefPtr<IRSpecSymbol>> SymbolDictionary;
-    SymbolDictionary symbols;
+    // Holds the symbols of the original modules
+    IRLinkCache* linkCache = nullptr;
 
     SharedIRBuilder sharedBuilderStorage;
     IRBuilder builderStorage;
@@ -56,7 +174,8 @@ struct IRSharedSpecContext
 struct IRSpecContextBase
 {
     // A map from the mangled name of a global variable
-    // to the layout to use for it.
+    // to the layout to use for it, for variables that
+    // are not in `IRLinkCache::globalVarLayouts`.
     Dictionary<String, VarLayout*> globalVarLayouts;
 
     IRSharedSpecContext* shared;
@@ -65,7 +184,7 @@ struct IRSpecContextBase
 
     IRModule* getModule() { return getShared()->module; }
 
-    IRSharedSpecContext::SymbolDictionary& getSymbols() { return getShared()->symbols; }
+    IRLinkCache* getLinkCache() { return getShared()->linkCache; }
 
     // The current specialization environment to use.
     IRSpecEnv* env = nullptr;
@@ -106,7 +225,7 @@ void registerClonedValue(
     // the same key already exists. This should be changed to
     // an `Add()` call.
     //
-    context->getEnv()->clonedValues[originalValue] = clonedValue;
+    context->getEnv()->clonedValues.set(originalValue, clonedValue);
 }
 
 // Information on values to use when registering a cloned value
@@ -175,7 +294,8 @@ void cloneDecorations(
     }
 
     // We will also clone the location here, just because this is a convenient bottleneck
-    clonedValue->sourceLoc = originalValue->sourceLoc;
+    // (there is space for it, as clones reserve it, see `cloneInst`)
+    clonedValue->setSourceLoc(originalValue->getSourceLoc());
 }
 
     /// Clone any decorations and children from `originalValue` onto `clonedValue`
@@ -195,7 +315,8 @@ void cloneDecorationsAndChildren(
     }
 
     // We will also clone the location here, just because this is a convenient bottleneck
-    clonedValue->sourceLoc = originalValue->sourceLoc;
+    // (there is space for it, as clones reserve it, see `cloneInst`)
+    clonedValue->setSourceLoc(originalValue->getSourceLoc());
 }
 
 // We use an `IRSpecContext` for the case where we are cloning
@@ -276,6 +397,9 @@ IRInst* IRSpecContext::maybeCloneValue(IRInst* originalValue)
             // In the deafult case, assume that we have some sort of "hoistable"
             // instruction that requires us to create a clone of it.
 
+            // The original's location is copied by `cloneDecorations`, so there must be space for it
+            IRBuilderReserveSourceLocSlotRAII reserveSlotRAII(builder, originalValue->getSourceLoc().isValid());
+
             UInt argCount = originalValue->getOperandCount();
             IRInst* clonedValue = builder->createIntrinsicInst(
                 cloneType(this, originalValue->getFullType()),
@@ -310,7 +434,7 @@ IRInst* findClonedValue(
     IRInst* clonedValue = nullptr;
     for (auto env = context->getEnv(); env; env = env->parent)
     {
-        if (env->clonedValues.TryGetValue(originalValue, clonedValue))
+        if (env->clonedValues.tryGetValue(originalValue, clonedValue))
         {
             return clonedValue;
         }
@@ -444,7 +568,8 @@ IRGlobalParam* cloneGlobalParamImpl(
     {
         auto mangledName = String(linkage->getMangledName());
         VarLayout* layout = nullptr;
-        if (context->globalVarLayouts.TryGetValue(mangledName, layout))
+        if (context->getShared()->linkCache->globalVarLayouts.TryGetValue(mangledName, layout) ||
+            context->globalVarLayouts.TryGetValue(mangledName, layout))
         {
             builder->addLayoutDecoration(clonedVal, layout);
         }
@@ -678,8 +803,8 @@ IRFunc* specializeIRForEntryPoint(
     // not the same as the mangled name of the decl.
     //
     auto mangledName = getMangledName(entryPoint->getFuncDeclRef());
-    RefPtr<IRSpecSymbol> sym;
-    if (!context->getSymbols().TryGetValue(mangledName, sym))
+    IRSpecSymbol* sym = findLinkSymbol(context->getLinkCache(), mangledName);
+    if (!sym)
     {
         SLANG_UNEXPECTED("no matching IR symbol");
         return nullptr;
@@ -956,6 +1081,10 @@ IRInst* cloneInst(
     IRInst*                         originalInst,
     IROriginalValuesForClone const& originalValues)
 {
+    // Instructions are only created with space for a source location if they are
+    // created with one, but the original's location may be copied onto the clone.
+    IRBuilderReserveSourceLocSlotRAII reserveSlotRAII(builder, originalInst->getSourceLoc().isValid());
+
     switch (originalInst->op)
     {
         // We need to special-case any instruction that is not
@@ -1071,8 +1200,8 @@ IRInst* cloneGlobalValueWithLinkage(
     // to pick the "best" one for our target.
 
     auto mangledName = String(originalLinkage->getMangledName());
-    RefPtr<IRSpecSymbol> sym;
-    if( !context->getSymbols().TryGetValue(mangledName, sym) )
+    RefPtr<IRSpecSymbol> sym = findLinkSymbol(context->getLinkCache(), mangledName);
+    if( !sym )
     {
         if(!originalVal)
             return nullptr;
@@ -1088,12 +1217,21 @@ IRInst* cloneGlobalValueWithLinkage(
     // more specialized for the chosen target. Otherwise, we simply favor
     // definitions over declarations.
     //
-    IRInst* bestVal = sym->irGlobalValue;
-    for( auto ss = sym->nextWithSameName; ss; ss = ss->nextWithSameName )
+    // The choice only depends on the target, so it is shared between
+    // all of the entry points linked for the target.
+    //
+    auto& bestValuesForTarget = context->getShared()->linkCache->bestValuesForTarget;
+    IRInst* bestVal = nullptr;
+    if (!bestValuesForTarget.TryGetValue(sym.Ptr(), bestVal))
     {
-        IRInst* newVal = ss->irGlobalValue;
-        if(isBetterForTarget(context, newVal, bestVal))
-            bestVal = newVal;
+        bestVal = sym->irGlobalValue;
+        for( auto ss = sym->nextWithSameName; ss; ss = ss->nextWithSameName )
+        {
+            IRInst* newVal = ss->irGlobalValue;
+            if(isBetterForTarget(context, newVal, bestVal))
+                bestVal = newVal;
+        }
+        bestValuesForTarget.Add(sym.Ptr(), bestVal);
     }
 
     // Check if we've already cloned this value, for the case where
@@ -1124,46 +1262,151 @@ IRInst* cloneGlobalValue(IRSpecContext* context, IRInst* originalVal)
         originalVal->findDecoration<IRLinkageDecoration>());
 }
 
-void insertGlobalValueSymbol(
-    IRSharedSpecContext*    sharedContext,
-    IRInst*                 gv)
+IRModuleLinkSymbols* IRModule::getLinkSymbols()
 {
-    auto linkage = gv->findDecoration<IRLinkageDecoration>();
+    if (m_linkSymbols)
+        return m_linkSymbols;
 
-    // Don't try to register a symbol for global values
-    // that don't have linkage.
-    //
-    if (!linkage)
-        return;
+    auto linkSymbols = new IRModuleLinkSymbols();
 
-    auto mangledName = String(linkage->getMangledName());
+    // The values of a module that is read lazily are added as they are looked up. Witness tables
+    // are needed up front, as the first one with each name is cloned for every entry point.
+    if (m_lazyReader)
+    {
+        linkSymbols->lazyReader = m_lazyReader;
 
-    RefPtr<IRSpecSymbol> sym = new IRSpecSymbol();
-    sym->irGlobalValue = gv;
+        List<IRInst*> witnessTables;
+        m_lazyReader->findFirstGlobalValuesWithOp(kIROp_WitnessTable, witnessTables);
+        for (auto witnessTable : witnessTables)
+            linkSymbols->witnessTables.add(cast<IRWitnessTable>(witnessTable));
 
-    RefPtr<IRSpecSymbol> prev;
-    if (sharedContext->symbols.TryGetValue(mangledName, prev))
-    {
-        sym->nextWithSameName = prev->nextWithSameName;
-        prev->nextWithSameName = sym;
+        m_linkSymbols = linkSymbols;
+        return m_linkSymbols;
     }
-    else
+
+    for (auto gv : getGlobalInsts())
     {
-        sharedContext->symbols.Add(mangledName, sym);
+        // Don't try to register a symbol for global values
+        // that don't have linkage.
+        //
+        auto linkage = gv->findDecoration<IRLinkageDecoration>();
+        if (!linkage)
+            continue;
+
+        // Values with the same name are chained in module order
+        auto mangledName = String(linkage->getMangledName());
+        if (auto firstValue = linkSymbols->values.TryGetValueOrAdd(mangledName, gv))
+        {
+            IRInst* lastValue = *firstValue;
+            while (auto nextValue = linkSymbols->nextValues.TryGetValue(lastValue))
+                lastValue = *nextValue;
+            linkSymbols->nextValues.Add(lastValue, gv);
+        }
+        else if (auto witnessTable = as<IRWitnessTable>(gv))
+        {
+            linkSymbols->witnessTables.add(witnessTable);
+        }
     }
+
+    m_linkSymbols = linkSymbols;
+    return m_linkSymbols;
 }
 
-void insertGlobalValueSymbols(
-    IRSharedSpecContext*    sharedContext,
-    IRModule*               originalModule)
+void IRModule::_destroyLinkSymbols()
 {
-    if (!originalModule)
-        return;
+    delete m_linkSymbols;
+    m_linkSymbols = nullptr;
+}
+
+    /// Get the link cache for the program on the target, (re)building it if needed.
+static IRLinkCache* _getLinkCache(
+    Program*        program,
+    TargetRequest*  targetReq,
+    IRModule*       programIRModule,
+    ProgramLayout*  programLayout,
+    CodeGenTarget   target)
+{
+    auto linkCache = program->getTargetProgram(targetReq)->getIRLinkCache();
+    if (linkCache->target == target &&
+        linkCache->programIRModule == programIRModule &&
+        linkCache->programLayout == programLayout)
+    {
+        return linkCache;
+    }
+
+    // Specializations and type legalization results are made from the definitions the
+    // link cache picks, so any that were cached for the previous inputs can't be used
+    // any more.
+    //
+    auto targetProgram = program->getTargetProgram(targetReq);
+    targetProgram->getIRSpecializationCache()->clear();
+    targetProgram->getIRTypeLegalizationCache()->clear();
 
-    for(auto ii : originalModule->getGlobalInsts())
+    *linkCache = IRLinkCache();
+    linkCache->target = target;
+    linkCache->programIRModule = programIRModule;
+    linkCache->programLayout = programLayout;
+
+    // We need to be able to look up IR definitions for any symbols in
+    // modules that the program depends on (transitively). Each module
+    // keeps a table of its IR definitions by mangled name, so a module
+    // that is used by many programs only needs to build it once.
+    //
+    if (programIRModule)
+        linkCache->moduleSymbols.add(programIRModule->getLinkSymbols());
+    for (auto module : program->getModuleDependencies())
+    {
+        if (auto irModule = module->getIRModule())
+            linkCache->moduleSymbols.add(irModule->getLinkSymbols());
+    }
+
+    // A witness table is cloned if it is the first value with its name in any of the modules
+    for (Index i = 0; i < linkCache->moduleSymbols.getCount(); ++i)
     {
-        insertGlobalValueSymbol(sharedContext, ii);
+        for (auto witnessTable : linkCache->moduleSymbols[i]->witnessTables)
+        {
+            auto mangledName = String(witnessTable->findDecoration<IRLinkageDecoration>()->getMangledName());
+            bool isFirst = true;
+            for (Index j = 0; j < i && isFirst; ++j)
+                isFirst = !_hasModuleLinkValue(linkCache->moduleSymbols[j], mangledName);
+            if (isFirst)
+                linkCache->witnessTables.add(witnessTable);
+        }
     }
+
+    // Next, we want to optimize lookup for layout information
+    // associated with global declarations, so that we can
+    // look things up based on the IR values (using mangled names)
+    //
+    // Note: We are scanning over all the key-value pairs for
+    // entries in the global scope, to account for the fact
+    // that the "same" shader parameter could be declared in
+    // multiple translation units, and thus end up with
+    // multiple mangled names (when the unique translation
+    // unit name gets involved).
+    //
+    auto globalStructLayout = getScopeStructLayout(programLayout);
+    for(auto entry : globalStructLayout->mapVarToLayout)
+    {
+        auto mangledName = getMangledName(entry.Key);
+        auto globalVarLayout = entry.Value;
+        linkCache->globalVarLayouts.AddIfNotExists(mangledName, globalVarLayout);
+    }
+
+    return linkCache;
+}
+
+IRLinkCache* TargetProgram::getIRLinkCache()
+{
+    if (!m_irLinkCache)
+        m_irLinkCache = new IRLinkCache();
+    return m_irLinkCache;
+}
+
+void TargetProgram::destroyIRLinkCache()
+{
+    delete m_irLinkCache;
+    m_irLinkCache = nullptr;
 }
 
 void initializeSharedSpecContext(
@@ -1225,6 +1468,20 @@ LinkedIR linkIR(
     CodeGenTarget           target,
     TargetRequest*          targetReq)
 {
+    List<EntryPoint*> entryPoints;
+    entryPoints.add(entryPoint);
+    return linkIR(compileRequest, entryPoints, programLayout, target, targetReq);
+}
+
+LinkedIR linkIR(
+    BackEndCompileRequest*      compileRequest,
+    const List<EntryPoint*>&    entryPoints,
+    ProgramLayout*              programLayout,
+    CodeGenTarget               target,
+    TargetRequest*              targetReq)
+{
+    SLANG_ASSERT(entryPoints.getCount() > 0);
+
     auto sink = compileRequest->getSink();
 
     IRSpecializationState stateStorage;
@@ -1245,66 +1502,51 @@ LinkedIR linkIR(
 
     state->irModule = sharedContext->module;
 
-    // We need to be able to look up IR definitions for any symbols in
-    // modules that the program depends on (transitively). To
-    // accelerate lookup, we will create a symbol table for looking
-    // up IR definitions by their mangled name.
+    // The symbol table for the modules the program depends on, along with
+    // the layouts of global shader parameters, are shared by every entry
+    // point linked for the target.
     //
     auto originalProgramIRModule = program->getOrCreateIRModule(sink);
-    insertGlobalValueSymbols(sharedContext, originalProgramIRModule);
-    for (auto module : program->getModuleDependencies())
-    {
-        insertGlobalValueSymbols(sharedContext, module->getIRModule());
-    }
+    sharedContext->linkCache = _getLinkCache(program, targetReq, originalProgramIRModule, programLayout, target);
 
     auto context = state->getContext();
     context->shared = sharedContext;
     context->builder = &sharedContext->builderStorage;
 
-    // Next, we want to optimize lookup for layout information
-    // associated with global declarations, so that we can
-    // look things up based on the IR values (using mangled names)
-    //
-    // Note: We are scanning over all the key-value pairs for
-    // entries in the global scope, to account for the fact
-    // that the "same" shader parameter could be declared in
-    // multiple translation units, and thus end up with
-    // multiple mangled names (when the unique translation
-    // unit name gets involved).
-    //
-    auto globalStructLayout = getScopeStructLayout(programLayout);
-    for(auto entry : globalStructLayout->mapVarToLayout)
+    List<EntryPointLayout*> entryPointLayouts;
+    List<EntryPointLayout*> offsetEntryPointLayouts;
+    for (auto entryPoint : entryPoints)
     {
-        auto mangledName = getMangledName(entry.Key);
-        auto globalVarLayout = entry.Value;
-        context->globalVarLayouts.AddIfNotExists(mangledName, globalVarLayout);
-    }
-
-    EntryPointGroupLayout* entryPointGroupLayout = nullptr;
-    auto entryPointLayout = findEntryPointLayout(programLayout, entryPoint, &entryPointGroupLayout);
-
-    auto offsetEntryPointLayout = entryPointLayout->getAbsoluteLayout(entryPointGroupLayout);
+        EntryPointGroupLayout* entryPointGroupLayout = nullptr;
+        auto entryPointLayout = findEntryPointLayout(programLayout, entryPoint, &entryPointGroupLayout);
+
+        entryPointLayouts.add(entryPointLayout);
+        offsetEntryPointLayouts.add(entryPointLayout->getAbsoluteLayout(entryPointGroupLayout));
+
+        // Note: when we are doing the compatibility approach for Falcor, we
+        // can have global-scope symbols that are actually part of the
+        // local root signature (entry point group), so we need to make
+        // sure to apply those layouts appropriately.
+        auto entryPointGroupStructLayout = getScopeStructLayout(entryPointGroupLayout);
+        for(auto entry : entryPointGroupStructLayout->mapVarToLayout)
+        {
+            if(!entry.Key)
+                continue;
 
-    // Note: when we are doing the compatibility approach for Falcor, we
-    // can have global-scope symbols that are actually part of the
-    // local root signature (entry point group), so we need to make
-    // sure to apply those layouts appropriately.
-    auto entryPointGroupStructLayout = getScopeStructLayout(entryPointGroupLayout);
-    for(auto entry : entryPointGroupStructLayout->mapVarToLayout)
-    {
-        if(!entry.Key)
-            continue;
+            auto mangledName = getMangledName(entry.Key);
+            if (sharedContext->linkCache->globalVarLayouts.ContainsKey(mangledName))
+                continue;
 
-        auto mangledName = getMangledName(entry.Key);
-        auto groupVarLayout = entry.Value;
+            auto groupVarLayout = entry.Value;
 
-        // We need to "adjust" the layout that was computed for the parameter
-        // because it will be relative to the start of the entry-point group,
-        // rather than absolute.
-        //
-        auto absoluteVarLayout = groupVarLayout->getAbsoluteLayout(entryPointGroupLayout->parametersLayout);
+            // We need to "adjust" the layout that was computed for the parameter
+            // because it will be relative to the start of the entry-point group,
+            // rather than absolute.
+            //
+            auto absoluteVarLayout = groupVarLayout->getAbsoluteLayout(entryPointGroupLayout->parametersLayout);
 
-        context->globalVarLayouts.AddIfNotExists(mangledName, absoluteVarLayout);
+            context->globalVarLayouts.AddIfNotExists(mangledName, absoluteVarLayout);
+        }
     }
 
     context->builder->setInsertInto(context->getModule()->getModuleInst());
@@ -1314,18 +1556,21 @@ LinkedIR linkIR(
     // TODO: This step should *not* be needed with the current IR
     // specialization approach, so we should consider removing it.
     //
-    for (auto sym :context->getSymbols())
+    for (auto witnessTable : sharedContext->linkCache->witnessTables)
     {
-        if (sym.Value->irGlobalValue->op == kIROp_WitnessTable)
-            cloneGlobalValue(context, (IRWitnessTable*)sym.Value->irGlobalValue);
+        cloneGlobalValue(context, witnessTable);
     }
 
 
     // Next, we make sure to clone the global value for
-    // the entry point function itself, and rely on
+    // the entry point functions themselves, and rely on
     // this step to recursively copy over anything else
-    // it might reference.
-    auto irEntryPoint = specializeIRForEntryPoint(context, entryPoint, offsetEntryPointLayout);
+    // they might reference.
+    List<IRFunc*> irEntryPoints;
+    for (Index i = 0; i < entryPoints.getCount(); ++i)
+    {
+        irEntryPoints.add(specializeIRForEntryPoint(context, entryPoints[i], offsetEntryPointLayouts[i]));
+    }
 
     // HACK: right now the bindings for global generic parameters are coming in
     // as part of the original IR module, and we need to make sure these get
@@ -1355,17 +1600,29 @@ LinkedIR linkIR(
     // instructions, since we expected the tagged union type(s) to
     // be referenced by them.
     //
-    for( auto taggedUnionTypeLayout : entryPointLayout->taggedUnionTypeLayouts )
+    // Tagged unions used as global existential type arguments have their
+    // layouts on the program layout, rather than on an entry point.
+    //
+    List<TypeLayout*> taggedUnionTypeLayouts;
+    for (auto taggedUnionTypeLayout : programLayout->taggedUnionTypeLayouts)
+        taggedUnionTypeLayouts.add(taggedUnionTypeLayout);
+    for (auto entryPointLayout : entryPointLayouts)
+    {
+        for (auto taggedUnionTypeLayout : entryPointLayout->taggedUnionTypeLayouts)
+            taggedUnionTypeLayouts.add(taggedUnionTypeLayout);
+    }
+
+    for( auto taggedUnionTypeLayout : taggedUnionTypeLayouts )
     {
         auto taggedUnionType = taggedUnionTypeLayout->getType();
         auto mangledName = getMangledTypeName(taggedUnionType);
 
-        RefPtr<IRSpecSymbol> sym;
-        if(!context->getSymbols().TryGetValue(mangledName, sym))
+        IRSpecSymbol* sym = findLinkSymbol(context->getLinkCache(), mangledName);
+        if(!sym)
             continue;
 
         IRInst* clonedType = findClonedValue(context, sym->irGlobalValue);
-        if(!clonedType)
+        if(!clonedType || clonedType->findDecoration<IRLayoutDecoration>())
             continue;
 
         context->builder->addLayoutDecoration(clonedType, taggedUnionTypeLayout);
@@ -1382,7 +1639,8 @@ LinkedIR linkIR(
     //
     LinkedIR linkedIR;
     linkedIR.module = state->irModule;
-    linkedIR.entryPoint = irEntryPoint;
+    linkedIR.entryPoint = irEntryPoints[0];
+    linkedIR.entryPoints = irEntryPoints;
     return linkedIR;
 }
 
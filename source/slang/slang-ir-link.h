@@ -8,7 +8,8 @@ namespace Slang
     struct LinkedIR
     {
         RefPtr<IRModule>    module;
-        IRFunc*             entryPoint;
+        IRFunc*             entryPoint;     ///< The first entry point that was linked
+        List<IRFunc*>       entryPoints;    ///< All the entry points that were linked, in order
     };
 
 
@@ -24,4 +25,13 @@ namespace Slang
         ProgramLayout*          programLayout,
         CodeGenTarget           target,
         TargetRequest*          targetReq);
+
+        /// Link the IR for all of `entryPoints` into one module, as for a library
+        /// that contains all of them.
+    LinkedIR linkIR(
+        BackEndCompileRequest*      compileRequest,
+        const List<EntryPoint*>&    entryPoints,
+        ProgramLayout*              programLayout,
+        CodeGenTarget               target,
+        TargetRequest*              targetReq);
 }
@@ -0,0 +1,53 @@
+// slang-ir-pass-manager.cpp
+#include "slang-ir-pass-manager.h"
+
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+IRPassManager::IRPassManager(IRModule* module, CompileProfiler* profiler):
+    m_module(module),
+    m_profiler(profiler)
+{
+    m_module->enableOpcodeIndex();
+}
+
+IRPassManager::~IRPassManager()
+{
+    m_module->disableOpcodeIndex();
+}
+
+bool IRPassManager::shouldRunPass(const IRPassDesc& desc)
+{
+    if(desc.triggerOpCount == 0)
+        return true;
+
+    for(Index i = 0; i < desc.triggerOpCount; ++i)
+    {
+        if(containsOp(desc.triggerOps[i]))
+            return true;
+    }
+    return false;
+}
+
+IRDominatorTree* IRPassManager::getDominatorTree(IRGlobalValueWithCode* code)
+{
+    RefPtr<IRDominatorTree> dominatorTree;
+    if(!m_dominatorTrees.TryGetValue(code, dominatorTree))
+    {
+        dominatorTree = computeDominatorTree(code);
+        m_dominatorTrees.Add(code, dominatorTree);
+    }
+    return dominatorTree;
+}
+
+void IRPassManager::invalidate(IRAnalysisFlags flags)
+{
+    if(flags & IRAnalysisFlag::DominatorTrees)
+    {
+        m_dominatorTrees.Clear();
+    }
+}
+
+}
@@ -0,0 +1,117 @@
+// slang-ir-pass-manager.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include "slang-compile-budget.h"
+#include "slang-compile-profiler.h"
+#include "slang-ir.h"
+#include "slang-ir-dominators.h"
+
+namespace Slang
+{
+    struct IRGlobalValueWithCode;
+
+        /// Analyses of an IR module that an `IRPassManager` caches between passes.
+        ///
+        /// A pass declares which of these it preserves; all others are discarded
+        /// after the pass runs.
+    typedef uint32_t IRAnalysisFlags;
+    struct IRAnalysisFlag
+    {
+        enum Enum : IRAnalysisFlags
+        {
+            None            = 0,
+            DominatorTrees  = 0x1,      ///< The dominator tree of each function
+
+            All             = DominatorTrees,
+        };
+    };
+
+        /// Describes a pass run by an `IRPassManager`
+    struct IRPassDesc
+    {
+        IRPassDesc() {}
+        IRPassDesc(const char* inName, IRAnalysisFlags inPreserved = IRAnalysisFlag::None):
+            name(inName),
+            preserved(inPreserved)
+        {}
+
+            /// Only run the pass if the module contains at least one instruction with one of `ops`.
+            /// If no trigger ops are set the pass always runs.
+        template <size_t N>
+        IRPassDesc& setTriggerOps(const IROp (&ops)[N])
+        {
+            triggerOps = ops;
+            triggerOpCount = Index(N);
+            return *this;
+        }
+
+        const char* name = nullptr;                         ///< Name of the pass, used for profiling
+        IRAnalysisFlags preserved = IRAnalysisFlag::None;   ///< Analyses that are still valid after the pass
+        const IROp* triggerOps = nullptr;                   ///< Opcodes that the pass needs to be present to have any effect
+        Index triggerOpCount = 0;
+    };
+
+        /// Runs a sequence of passes over an IR module.
+        ///
+        /// Analyses such as dominator trees are computed on demand and cached
+        /// until a pass that doesn't preserve them runs. Passes that declare
+        /// trigger opcodes are skipped when none of those opcodes appear in
+        /// the module.
+        ///
+        /// The module's opcode index is enabled for the lifetime of the pass
+        /// manager, so passes can also use it to find the instructions they
+        /// work on.
+    class IRPassManager
+    {
+    public:
+            /// Run `func` as the pass described by `desc`, unless it can be skipped.
+            /// Returns true if the pass was run.
+        template <typename F>
+        bool runPass(const IRPassDesc& desc, const F& func)
+        {
+            if(!shouldRunPass(desc))
+            {
+                m_skippedPassCount++;
+                return false;
+            }
+            checkCompileBudget(m_module->budget, m_module);
+            {
+                IRPassProfileScope profileScope(m_profiler, desc.name, m_module);
+                func();
+            }
+            invalidate(IRAnalysisFlags(~desc.preserved));
+            return true;
+        }
+
+            /// Returns true if the pass described by `desc` would run on the module as it is now
+        bool shouldRunPass(const IRPassDesc& desc);
+
+            /// Get the dominator tree for `code`, computing it if it is not cached
+        IRDominatorTree* getDominatorTree(IRGlobalValueWithCode* code);
+
+            /// Returns true if an instruction with `op` is in the module
+        bool containsOp(IROp op) { return m_module->getOpcodeIndex()->contains(op); }
+
+            /// Discard the cached analyses in `flags`
+        void invalidate(IRAnalysisFlags flags);
+
+            /// Get the number of passes that were skipped because their trigger opcodes were absent
+        Index getSkippedPassCount() const { return m_skippedPassCount; }
+
+        IRModule* getModule() const { return m_module; }
+
+            /// Ctor. The profiler can be null.
+        IRPassManager(IRModule* module, CompileProfiler* profiler);
+        ~IRPassManager();
+
+    protected:
+        IRModule* m_module;
+        CompileProfiler* m_profiler;
+
+        Dictionary<IRGlobalValueWithCode*, RefPtr<IRDominatorTree>> m_dominatorTrees;
+
+        Index m_skippedPassCount = 0;
+    };
+}
@@ -208,10 +208,13 @@ void defaultInitializeVar(
 /// The `defRegion` should be the region that contains `def`, and `regionTree`
 /// should be the region tree for the function that contains `def`.
 ///
+/// The `builder` is used for any instructions that need to be inserted.
+///
 static void fixValueScopingForInst(
     IRInst*         def,
     SimpleRegion*   defRegion,
-    RegionTree*     regionTree)
+    RegionTree*     regionTree,
+    IRBuilder*      builder)
 {
     // This algorithm should not consider "phi nodes" for now,
     // because the emit logic will already create variables for them.
@@ -246,21 +249,6 @@ static void fixValueScopingForInst(
     SimpleRegion*   insertRegion    = defRegion;
     IRVar*          tmp             = nullptr;
 
-    // If we end up needing to insert code we'll need an IR builder,
-    // so we will go ahead and create one now.
-    //
-    // TODO: the logic to compute `module` here could be hoisted
-    // out earlier, rather than being done per-instruction.
-    //
-    IRModule* module = regionTree->irCode->getModule();
-
-    SharedIRBuilder sharedBuilder;
-    sharedBuilder.session = module->session;
-    sharedBuilder.module = module;
-
-    IRBuilder builder;
-    builder.sharedBuilder = &sharedBuilder;
-
     // Because we will be changing some of the uses of `def`
     // to use other values while we iterate the list, we
     // need to be a bit careful and extract the next use
@@ -325,9 +313,9 @@ static void fixValueScopingForInst(
             // placed into. We will move it to the correct
             // location when we are done.
             //
-            builder.setInsertBefore(def->getNextInst());
-            tmp = builder.emitVar(def->getDataType());
-            builder.emitStore(tmp, def);
+            builder->setInsertBefore(def->getNextInst());
+            tmp = builder->emitVar(def->getDataType());
+            builder->emitStore(tmp, def);
         }
 
         // In order to know where `tmp` should be defined
@@ -351,8 +339,8 @@ static void fixValueScopingForInst(
         // To fix up the use `u`, we will need to change
         // it from using `def` to using a load from `tmp`
         //
-        builder.setInsertBefore(user);
-        IRInst* tmpVal = builder.emitLoad(tmp);
+        builder->setInsertBefore(user);
+        IRInst* tmpVal = builder->emitLoad(tmp);
 
         // We are clobbering the value used by the `IRUse` `u`,
         // while will cut it out of the list of uses for `def`.
@@ -397,17 +385,37 @@ static void fixValueScopingForInst(
         // to emit logic to "default initialize" the `tmp`
         // variable if possible.
         //
-        builder.setInsertBefore(tmp->getNextInst());
-        defaultInitializeVar(&builder, tmp, def->getDataType());
+        builder->setInsertBefore(tmp->getNextInst());
+        defaultInitializeVar(builder, tmp, def->getDataType());
     }
 }
 
 void fixValueScoping(RegionTree* regionTree)
 {
+    // Values can only be used out of scope if they are used
+    // in a different block from the one that defines them,
+    // so a function with a single block (which covers most
+    // small helper functions) never needs any fixing.
+    //
+    auto code = regionTree->irCode;
+    auto firstBlock = code->getFirstBlock();
+    if(!firstBlock || !firstBlock->getNextBlock())
+        return;
+
+    // If we end up needing to insert code we'll need an IR builder.
+    //
+    IRModule* module = code->getModule();
+
+    SharedIRBuilder sharedBuilder;
+    sharedBuilder.session = module->session;
+    sharedBuilder.module = module;
+
+    IRBuilder builder;
+    builder.sharedBuilder = &sharedBuilder;
+
     // We are going to have to walk through every instruction
     // in the code of the function to detect an bad cases.
     //
-    auto code = regionTree->irCode;
     for(auto block : code->getBlocks())
     {
         // All of the instruction in `block` will have the same
@@ -426,7 +434,7 @@ void fixValueScoping(RegionTree* regionTree)
 
         for(auto inst : block->getDecorationsAndChildren())
         {
-            fixValueScopingForInst(inst, parentRegion, regionTree);
+            fixValueScopingForInst(inst, parentRegion, regionTree, &builder);
         }
     }
 }
@@ -647,6 +647,35 @@ namespace Slang
         RefPtr<RegionTree> regionTree = new RegionTree();
         regionTree->irCode = code;
 
+        // Most functions that come from structured source code
+        // are a single block that ends in a `return` (or similar),
+        // and their region tree is just a simple region for that
+        // block, which we can make without any of the label
+        // bookkeeping that the general case needs.
+        //
+        auto firstBlock = code->getFirstBlock();
+        if( firstBlock && !firstBlock->getNextBlock() )
+        {
+            auto terminator = firstBlock->getTerminator();
+            switch( terminator ? terminator->op : kIROp_Nop )
+            {
+            case kIROp_Unreachable:
+            case kIROp_MissingReturn:
+            case kIROp_ReturnVal:
+            case kIROp_ReturnVoid:
+            case kIROp_discard:
+                {
+                    RefPtr<SimpleRegion> simpleRegion = new SimpleRegion(nullptr, firstBlock);
+                    regionTree->mapBlockToRegion.Add(firstBlock, simpleRegion);
+                    regionTree->rootRegion = simpleRegion;
+                    return regionTree;
+                }
+
+            default:
+                break;
+            }
+        }
+
         ControlFlowRestructuringContext restructuringContext;
         restructuringContext.sink = sink;
         restructuringContext.regionTree = regionTree;
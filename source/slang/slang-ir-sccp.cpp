@@ -153,6 +153,18 @@ struct SCCPContext
         if(left.value == right.value)
             return left;
 
+        // Constants with the same value can still be distinct
+        // instructions, if they were created by different builders.
+        //
+        auto leftConstant = as<IRConstant>(left.value);
+        auto rightConstant = as<IRConstant>(right.value);
+        if(leftConstant && rightConstant
+            && leftConstant->getFullType() == rightConstant->getFullType()
+            && leftConstant->equal(rightConstant))
+        {
+            return left;
+        }
+
         // Otherwise, we have two distinct singleton sets, and their
         // union should be a set with two elements. We can't represent
         // that on the lattice for SCCP, so the proper lower bound
@@ -288,10 +300,40 @@ struct SCCPContext
         // `None` inputs as producing `Any` to make sure we don't
         // optimize the code based on non-obvious assumptions.
         //
-        // For now we aren't implementing *any* folding logic here,
-        // for simplicity. This is the right place to add folding
-        // optimizations if/when we need them.
+        // For now we only fold arithmetic, comparisons and casts on
+        // 32-bit integers and `bool`s. That is enough for values computed
+        // from loop counters (such as array indices) to become constants
+        // once a loop has been unrolled.
         //
+        switch( inst->op )
+        {
+        case kIROp_Add:
+        case kIROp_Sub:
+        case kIROp_Mul:
+        case kIROp_Div:
+        case kIROp_Mod:
+        case kIROp_Lsh:
+        case kIROp_Rsh:
+        case kIROp_BitAnd:
+        case kIROp_BitOr:
+        case kIROp_BitXor:
+        case kIROp_BitNot:
+        case kIROp_Neg:
+        case kIROp_Eql:
+        case kIROp_Neq:
+        case kIROp_Less:
+        case kIROp_Leq:
+        case kIROp_Greater:
+        case kIROp_Geq:
+        case kIROp_And:
+        case kIROp_Or:
+        case kIROp_Not:
+        case kIROp_Construct:
+            return foldScalarOp(inst);
+
+        default:
+            break;
+        }
 
         // A safe default is to assume that every instruction not
         // handled by one of the cases above could produce *any*
@@ -299,6 +341,123 @@ struct SCCPContext
         return LatticeVal::getAny();
     }
 
+    static bool isFoldableScalarType(IRType* type)
+    {
+        if(!type) return false;
+        switch( type->op )
+        {
+        case kIROp_IntType:
+        case kIROp_UIntType:
+        case kIROp_BoolType:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+        /// Wrap `value` to the range of the 32-bit integer (or `bool`) type `typeOp`
+    static IRIntegerValue normalizeScalarValue(IROp typeOp, IRIntegerValue value)
+    {
+        switch( typeOp )
+        {
+        case kIROp_UIntType:    return IRIntegerValue(uint32_t(value));
+        case kIROp_BoolType:    return value != 0;
+        default:                return IRIntegerValue(int32_t(uint32_t(value)));
+        }
+    }
+
+        /// Fold an operation on constant 32-bit integers or `bool`s
+    LatticeVal foldScalarOp(IRInst* inst)
+    {
+        auto resultType = inst->getDataType();
+        const UInt operandCount = inst->getOperandCount();
+        if(!isFoldableScalarType(resultType) || operandCount < 1 || operandCount > 2)
+            return LatticeVal::getAny();
+
+        // If any operand could have any value, so could the result. Otherwise
+        // if we haven't seen a value for an operand yet, we don't know the result yet.
+        //
+        bool hasNoneOperand = false;
+        IRIntegerValue values[2] = { 0, 0 };
+        IROp operandTypeOp = kIROp_IntType;
+        for( UInt ii = 0; ii < operandCount; ++ii )
+        {
+            auto operand = inst->getOperand(ii);
+            LatticeVal operandVal = getLatticeVal(operand);
+            if(operandVal.flavor == LatticeVal::Flavor::Any)
+                return LatticeVal::getAny();
+            if(operandVal.flavor == LatticeVal::Flavor::None)
+            {
+                hasNoneOperand = true;
+                continue;
+            }
+
+            auto constant = as<IRConstant>(operandVal.value);
+            if(!constant || !isFoldableScalarType(constant->getDataType()))
+                return LatticeVal::getAny();
+            if(constant->op != kIROp_IntLit && constant->op != kIROp_BoolLit)
+                return LatticeVal::getAny();
+
+            operandTypeOp = constant->getDataType()->op;
+            values[ii] = normalizeScalarValue(operandTypeOp, constant->value.intVal);
+        }
+        if(hasNoneOperand)
+            return LatticeVal::getNone();
+
+        const IRIntegerValue a = values[0];
+        const IRIntegerValue b = values[1];
+        const bool isUnsigned = operandTypeOp == kIROp_UIntType;
+        IRIntegerValue result = 0;
+        switch( inst->op )
+        {
+        case kIROp_Add:         result = a + b; break;
+        case kIROp_Sub:         result = a - b; break;
+        case kIROp_Mul:         result = a * b; break;
+        case kIROp_Div:
+        case kIROp_Mod:
+            {
+                // Division by zero, or overflow, is left for the target to deal with
+                if(b == 0 || (!isUnsigned && a == -0x80000000ll && b == -1))
+                    return LatticeVal::getAny();
+                result = (inst->op == kIROp_Div) ? a / b : a % b;
+            }
+            break;
+        case kIROp_Lsh:         result = a << (b & 31); break;
+        case kIROp_Rsh:         result = a >> (b & 31); break;
+        case kIROp_BitAnd:      result = a & b; break;
+        case kIROp_BitOr:       result = a | b; break;
+        case kIROp_BitXor:      result = a ^ b; break;
+        case kIROp_BitNot:      result = ~a; break;
+        case kIROp_Neg:         result = -a; break;
+        case kIROp_Eql:         result = a == b; break;
+        case kIROp_Neq:         result = a != b; break;
+        case kIROp_Less:        result = a < b; break;
+        case kIROp_Leq:         result = a <= b; break;
+        case kIROp_Greater:     result = a > b; break;
+        case kIROp_Geq:         result = a >= b; break;
+        case kIROp_And:         result = a && b; break;
+        case kIROp_Or:          result = a || b; break;
+        case kIROp_Not:         result = !a; break;
+        case kIROp_Construct:
+            {
+                // Only a conversion between scalar types
+                if(operandCount != 1)
+                    return LatticeVal::getAny();
+                result = a;
+            }
+            break;
+        default:
+            return LatticeVal::getAny();
+        }
+
+        auto builder = getBuilder();
+        const IROp resultTypeOp = resultType->op;
+        IRInst* constant = (resultTypeOp == kIROp_BoolType) ?
+            builder->getBoolValue(result != 0) :
+            builder->getIntValue(resultType, normalizeScalarValue(resultTypeOp, result));
+        return LatticeVal::getConstant(constant);
+    }
+
 
     // For basic blocks, we will do tracking very similar to what we do for
     // ordinary instructions, just with a simpler lattice: every block
@@ -599,6 +758,8 @@ struct SCCPContext
         //
         while(cfgWorkList.getCount() || ssaWorkList.getCount())
         {
+            shared->module->checkBudget();
+
             // Note: there is a design choice to be had here
             // around whether we do `if if` or `while while`
             // for these nested checks. The choice can affect
@@ -946,5 +1107,51 @@ void applySparseConditionalConstantPropagation(
     applySparseConditionalConstantPropagationRec(&shared, module->getModuleInst());
 }
 
+void applySparseConditionalConstantPropagationIncremental(
+    IRModule*       module)
+{
+    auto dirtyInsts = module->getDirtyInsts();
+    if( !dirtyInsts )
+    {
+        applySparseConditionalConstantPropagation(module);
+        return;
+    }
+
+    // Nothing outside of a function that was changed can affect
+    // the lattice values inside it, so we only need to revisit
+    // the functions that hold dirty instructions.
+    //
+    List<IRInst*> insts;
+    dirtyInsts->getAll(insts);
+
+    List<IRGlobalValueWithCode*> codeToVisit;
+    HashSet<IRGlobalValueWithCode*> seenCode;
+    for( auto inst : insts )
+    {
+        for( auto ii = inst; ii; ii = ii->getParent() )
+        {
+            auto code = as<IRGlobalValueWithCode>(ii);
+            if(!code)
+                continue;
+            if( code->getFirstBlock() && seenCode.Add(code) )
+                codeToVisit.add(code);
+            break;
+        }
+    }
+
+    SharedSCCPContext shared;
+    shared.module = module;
+    shared.sharedBuilder.module = module;
+    shared.sharedBuilder.session = module->getSession();
+
+    for( auto code : codeToVisit )
+    {
+        SCCPContext context;
+        context.shared = &shared;
+        context.code = code;
+        context.apply();
+    }
+}
+
 }
 
@@ -14,5 +14,14 @@ namespace Slang
         /// becoming dead code)
     void applySparseConditionalConstantPropagation(
         IRModule*       module);
+
+        /// Apply SCCP only to the functions that contain dirty instructions.
+        ///
+        /// The dirty instruction set of `module` (see `IRModule::beginTrackingDirtyInsts`)
+        /// is left in place, so that a following `eliminateDeadCodeIncremental` can
+        /// clean up after this pass. If the module is not tracking dirty instructions
+        /// this applies SCCP to the whole module.
+    void applySparseConditionalConstantPropagationIncremental(
+        IRModule*       module);
 }
 
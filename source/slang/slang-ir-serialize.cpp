@@ -3,6 +3,8 @@
 
 #include "../core/slang-text-io.h"
 #include "../core/slang-byte-encode-util.h"
+#include "../core/slang-lz4-util.h"
+#include "../core/slang-thread-pool.h"
 
 #include "slang-ir-insts.h"
 
@@ -290,12 +292,14 @@ size_t IRSerialData::calcSizeInBytes() const
         _calcArraySize(m_stringTable) +
         /* Raw source locs */
         _calcArraySize(m_rawSourceLocs) +
+        _calcArraySize(m_symbols) +
         /* Debug */
         _calcArraySize(m_debugStringTable) +
         _calcArraySize(m_debugLineInfos) +
         _calcArraySize(m_debugSourceInfos) +
         _calcArraySize(m_debugAdjustedLineInfos) +
-        _calcArraySize(m_debugSourceLocRuns);
+        _calcArraySize(m_debugSourceLocRuns) +
+        _calcArraySize(m_encodedDebugChunks);
 }
 
 IRSerialData::IRSerialData()
@@ -312,6 +316,7 @@ void IRSerialData::clear()
     m_childRuns.clear();
     m_externalOperands.clear();
     m_rawSourceLocs.clear();
+    m_symbols.clear();
 
     m_stringTable.clear();
     
@@ -321,6 +326,9 @@ void IRSerialData::clear()
     m_debugSourceInfos.clear();
     m_debugSourceLocRuns.clear();
     m_debugStringTable.clear();
+
+    m_encodedDebugChunks.clear();
+    m_encodedDebugCompressionType = 0;
 }
 
 template <typename T>
@@ -360,12 +368,14 @@ bool IRSerialData::operator==(const ThisType& rhs) const
         _isEqual(m_externalOperands, rhs.m_externalOperands) &&
         _isEqual(m_rawSourceLocs, rhs.m_rawSourceLocs) &&
         _isEqual(m_stringTable, rhs.m_stringTable) &&
+        _isEqual(m_symbols, rhs.m_symbols) &&
         /* Debug */
         _isEqual(m_debugStringTable, rhs.m_debugStringTable) &&
         _isEqual(m_debugLineInfos, rhs.m_debugLineInfos) &&
         _isEqual(m_debugAdjustedLineInfos, rhs.m_debugAdjustedLineInfos) &&
         _isEqual(m_debugSourceInfos, rhs.m_debugSourceInfos) &&
-        _isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns));
+        _isEqual(m_debugSourceLocRuns, rhs.m_debugSourceLocRuns) &&
+        _isEqual(m_encodedDebugChunks, rhs.m_encodedDebugChunks));
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialWriter !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -501,13 +511,13 @@ Result IRSerialWriter::_calcDebugInfo()
     for (Index i = 1; i < numInsts; i++)
     {
         IRInst* srcInst = m_insts[i];
-        if (!srcInst->sourceLoc.isValid())
+        if (!srcInst->getSourceLoc().isValid())
         {
             continue;
         }
         InstLoc instLoc;
         instLoc.instIndex = uint32_t(i);
-        instLoc.sourceLoc = uint32_t(srcInst->sourceLoc.getRaw());
+        instLoc.sourceLoc = uint32_t(srcInst->getSourceLoc().getRaw());
         instLocs.add(instLoc);
     }
 
@@ -576,15 +586,73 @@ Result IRSerialWriter::_calcDebugInfo()
     return SLANG_OK;
 }
 
-Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, OptionFlags options, IRSerialData* serialData)
+static int _compareStringSlices(const UnownedStringSlice& a, const UnownedStringSlice& b)
 {
-    typedef Ser::Inst::PayloadType PayloadType;
+    const Index minLength = Math::Min(a.size(), b.size());
+    const int cmp = (minLength > 0) ? ::memcmp(a.begin(), b.begin(), size_t(minLength)) : 0;
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    return (a.size() < b.size()) ? -1 : ((a.size() > b.size()) ? 1 : 0);
+}
 
-    m_sourceManager = sourceManager;
-    m_serialData = serialData;
+void IRSerialWriter::_calcSymbols(const List<GlobalValueRun>& globalValueRuns)
+{
+    struct Entry
+    {
+        UnownedStringSlice m_mangledName;
+        Ser::Symbol m_symbol;
+    };
 
-    serialData->clear();
+    List<Entry> entries;
+    for (const auto& globalValueRun : globalValueRuns)
+    {
+        IRInst* inst = globalValueRun.m_inst;
+        for (auto decoration : inst->getDecorations())
+        {
+            auto linkageDecoration = as<IRLinkageDecoration>(decoration);
+            if (!linkageDecoration)
+            {
+                continue;
+            }
+
+            Entry entry;
+            entry.m_mangledName = linkageDecoration->getMangledName();
+            entry.m_symbol.m_mangledNameIndex = getStringIndex(entry.m_mangledName);
+            entry.m_symbol.m_instIndex = getInstIndex(inst);
+            entry.m_symbol.m_startDescendantIndex = globalValueRun.m_startDescendantIndex;
+            entry.m_symbol.m_numDescendants = globalValueRun.m_numDescendants;
+            entries.add(entry);
+        }
+    }
+
+    // Sort by name, and values with the same name in module order. Every value with a name is kept, as the
+    // linker chooses between them (for example between target specific definitions, or a declaration and definition).
+    entries.sort([](const Entry& a, const Entry& b) -> bool
+    {
+        const int cmp = _compareStringSlices(a.m_mangledName, b.m_mangledName);
+        if (cmp != 0)
+        {
+            return cmp < 0;
+        }
+        return a.m_symbol.m_instIndex < b.m_symbol.m_instIndex;
+    });
+
+    List<Ser::Symbol>& symbols = m_serialData->m_symbols;
+    for (Index i = 0; i < entries.getCount(); ++i)
+    {
+        // A value with the same name on more than one linkage decoration is only added once
+        if (i > 0 && entries[i].m_symbol == entries[i - 1].m_symbol)
+        {
+            continue;
+        }
+        symbols.add(entries[i].m_symbol);
+    }
+}
 
+void IRSerialWriter::_calcInstList(IRModule* module, List<GlobalValueRun>& globalValueRuns)
+{
     // We reserve 0 for null
     m_insts.clear();
     m_insts.add(nullptr);
@@ -602,6 +670,10 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
     // Add to the map
     _addInstruction(moduleInst);
 
+    // The traversal is depth first, so all of the instructions nested in a global value are
+    // added in a single run, between the global value being popped and the next one being popped.
+    globalValueRuns.clear();
+
     // Traverse all of the instructions
     while (parentInstStack.getCount())
     {
@@ -610,6 +682,15 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
         parentInstStack.removeLast();
         SLANG_ASSERT(m_instMap.ContainsKey(parentInst));
 
+        if (parentInst->getParent() == moduleInst)
+        {
+            GlobalValueRun globalValueRun;
+            globalValueRun.m_inst = parentInst;
+            globalValueRun.m_startDescendantIndex = Ser::InstIndex(m_insts.getCount());
+            globalValueRun.m_numDescendants = 0;
+            globalValueRuns.add(globalValueRun);
+        }
+
         // Okay we go through each of the children in order. If they are IRInstParent derived, we add to stack to process later 
         // cos we want breadth first so the order of children is the same as their index order, meaning we don't need to store explicit indices
         const Ser::InstIndex startChildInstIndex = Ser::InstIndex(m_insts.getCount());
@@ -637,6 +718,13 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
         }
     }
 
+    // A global value's run ends where the next one starts
+    for (Index i = 0; i < globalValueRuns.getCount(); ++i)
+    {
+        const Index endIndex = (i + 1 < globalValueRuns.getCount()) ? Index(globalValueRuns[i + 1].m_startDescendantIndex) : m_insts.getCount();
+        globalValueRuns[i].m_numDescendants = Ser::SizeType(endIndex - Index(globalValueRuns[i].m_startDescendantIndex));
+    }
+
 #if 0
     {
         List<IRInst*> workInsts;
@@ -648,120 +736,140 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
         }
     }
 #endif
+}
 
-    // Set to the right size
-    m_serialData->m_insts.setCount(m_insts.getCount());
-    // Clear all instructions
-    memset(m_serialData->m_insts.begin(), 0, sizeof(Ser::Inst) * m_serialData->m_insts.getCount());
+Result IRSerialWriter::_calcInst(IRInst* srcInst, Ser::Inst& dstInst)
+{
+    typedef Ser::Inst::PayloadType PayloadType;
 
-    // Need to set up the actual instructions
-    {
-        const Index numInsts = m_insts.getCount();
+    memset(&dstInst, 0, sizeof(dstInst));
 
-        for (Index i = 1; i < numInsts; ++i)
-        {
-            IRInst* srcInst = m_insts[i];
-            Ser::Inst& dstInst = m_serialData->m_insts[i];
-            
-            // Can't be any pseudo ops
-            SLANG_ASSERT(!isPseudoOp(srcInst->op)); 
+    // Can't be any pseudo ops
+    SLANG_ASSERT(!isPseudoOp(srcInst->op)); 
 
-            dstInst.m_op = uint8_t(srcInst->op & kIROpMeta_OpMask);
-            dstInst.m_payloadType = PayloadType::Empty;
-            
-            dstInst.m_resultTypeIndex = getInstIndex(srcInst->getFullType());
+    dstInst.m_op = uint8_t(srcInst->op & kIROpMeta_OpMask);
+    dstInst.m_payloadType = PayloadType::Empty;
+    
+    dstInst.m_resultTypeIndex = getInstIndex(srcInst->getFullType());
 
-            IRConstant* irConst = as<IRConstant>(srcInst);
-            if (irConst)
+    IRConstant* irConst = as<IRConstant>(srcInst);
+    if (irConst)
+    {
+        switch (srcInst->op)
+        {
+            // Special handling for the ir const derived types
+            case kIROp_StringLit:
             {
-                switch (srcInst->op)
-                {
-                    // Special handling for the ir const derived types
-                    case kIROp_StringLit:
-                    {
-                        auto stringLit = static_cast<IRStringLit*>(srcInst);
-                        dstInst.m_payloadType = PayloadType::String_1;
-                        dstInst.m_payload.m_stringIndices[0] = getStringIndex(stringLit->getStringSlice());
-                        break;
-                    }
-                    case kIROp_IntLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Int64;
-                        dstInst.m_payload.m_int64 = irConst->value.intVal;
-                        break;
-                    }
-                    case kIROp_PtrLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Int64;
-                        dstInst.m_payload.m_int64 = (intptr_t) irConst->value.ptrVal;
-                        break;
-                    }
-                    case kIROp_FloatLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::Float64;
-                        dstInst.m_payload.m_float64 = irConst->value.floatVal; 
-                        break;
-                    }
-                    case kIROp_BoolLit:
-                    {
-                        dstInst.m_payloadType = PayloadType::UInt32;
-                        dstInst.m_payload.m_uint32 = irConst->value.intVal ? 1 : 0;
-                        break;
-                    }
-                    default:
-                    {
-                        SLANG_RELEASE_ASSERT(!"Unhandled constant type");
-                        return SLANG_FAIL;
-                    }
-                }
-                continue;
+                auto stringLit = static_cast<IRStringLit*>(srcInst);
+                dstInst.m_payloadType = PayloadType::String_1;
+                dstInst.m_payload.m_stringIndices[0] = getStringIndex(stringLit->getStringSlice());
+                break;
             }
-
-            IRTextureTypeBase* textureBase = as<IRTextureTypeBase>(srcInst);
-            if (textureBase)
+            case kIROp_IntLit:
             {
-                dstInst.m_payloadType = PayloadType::OperandAndUInt32;
-                dstInst.m_payload.m_operandAndUInt32.m_uint32 = uint32_t(srcInst->op) >> kIROpMeta_OtherShift;
-                dstInst.m_payload.m_operandAndUInt32.m_operand = getInstIndex(textureBase->getElementType());
-                continue;
+                dstInst.m_payloadType = PayloadType::Int64;
+                dstInst.m_payload.m_int64 = irConst->value.intVal;
+                break;
             }
-
-            // ModuleInst is different, in so far as it holds a pointer to IRModule, but we don't need 
-            // to save that off in a special way, so can just use regular path
-             
-            const int numOperands = int(srcInst->operandCount);
-            Ser::InstIndex* dstOperands = nullptr;
-
-            if (numOperands <= Ser::Inst::kMaxOperands)
+            case kIROp_PtrLit:
+            {
+                dstInst.m_payloadType = PayloadType::Int64;
+                dstInst.m_payload.m_int64 = (intptr_t) irConst->value.ptrVal;
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                dstInst.m_payloadType = PayloadType::Float64;
+                dstInst.m_payload.m_float64 = irConst->value.floatVal; 
+                break;
+            }
+            case kIROp_BoolLit:
             {
-                // Checks the compile below is valid
-                SLANG_COMPILE_TIME_ASSERT(PayloadType(0) == PayloadType::Empty && PayloadType(1) == PayloadType::Operand_1 && PayloadType(2) == PayloadType::Operand_2);
-                
-                dstInst.m_payloadType = PayloadType(numOperands);
-                dstOperands = dstInst.m_payload.m_operands;
+                dstInst.m_payloadType = PayloadType::UInt32;
+                dstInst.m_payload.m_uint32 = irConst->value.intVal ? 1 : 0;
+                break;
             }
-            else
+            default:
             {
-                dstInst.m_payloadType = PayloadType::OperandExternal;
+                SLANG_RELEASE_ASSERT(!"Unhandled constant type");
+                return SLANG_FAIL;
+            }
+        }
+        return SLANG_OK;
+    }
 
-                int operandArrayBaseIndex = int(m_serialData->m_externalOperands.getCount());
-                m_serialData->m_externalOperands.setCount(operandArrayBaseIndex + numOperands);
+    IRTextureTypeBase* textureBase = as<IRTextureTypeBase>(srcInst);
+    if (textureBase)
+    {
+        dstInst.m_payloadType = PayloadType::OperandAndUInt32;
+        dstInst.m_payload.m_operandAndUInt32.m_uint32 = uint32_t(srcInst->op) >> kIROpMeta_OtherShift;
+        dstInst.m_payload.m_operandAndUInt32.m_operand = getInstIndex(textureBase->getElementType());
+        return SLANG_OK;
+    }
 
-                dstOperands = m_serialData->m_externalOperands.begin() + operandArrayBaseIndex; 
+    // ModuleInst is different, in so far as it holds a pointer to IRModule, but we don't need 
+    // to save that off in a special way, so can just use regular path
+     
+    const int numOperands = int(srcInst->operandCount);
+    Ser::InstIndex* dstOperands = nullptr;
 
-                auto& externalOperands = dstInst.m_payload.m_externalOperand;
-                externalOperands.m_arrayIndex = Ser::ArrayIndex(operandArrayBaseIndex);
-                externalOperands.m_size = Ser::SizeType(numOperands);
-            }
+    if (numOperands <= Ser::Inst::kMaxOperands)
+    {
+        // Checks the compile below is valid
+        SLANG_COMPILE_TIME_ASSERT(PayloadType(0) == PayloadType::Empty && PayloadType(1) == PayloadType::Operand_1 && PayloadType(2) == PayloadType::Operand_2);
+        
+        dstInst.m_payloadType = PayloadType(numOperands);
+        dstOperands = dstInst.m_payload.m_operands;
+    }
+    else
+    {
+        dstInst.m_payloadType = PayloadType::OperandExternal;
 
-            for (int j = 0; j < numOperands; ++j)
-            {
-                const Ser::InstIndex dstInstIndex = getInstIndex(srcInst->getOperand(j));
-                dstOperands[j] = dstInstIndex;
-            }
+        int operandArrayBaseIndex = int(m_serialData->m_externalOperands.getCount());
+        m_serialData->m_externalOperands.setCount(operandArrayBaseIndex + numOperands);
+
+        dstOperands = m_serialData->m_externalOperands.begin() + operandArrayBaseIndex; 
+
+        auto& externalOperands = dstInst.m_payload.m_externalOperand;
+        externalOperands.m_arrayIndex = Ser::ArrayIndex(operandArrayBaseIndex);
+        externalOperands.m_size = Ser::SizeType(numOperands);
+    }
+
+    for (int j = 0; j < numOperands; ++j)
+    {
+        const Ser::InstIndex dstInstIndex = getInstIndex(srcInst->getOperand(j));
+        dstOperands[j] = dstInstIndex;
+    }
+    return SLANG_OK;
+}
+
+Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, OptionFlags options, IRSerialData* serialData)
+{
+    m_sourceManager = sourceManager;
+    m_serialData = serialData;
+
+    serialData->clear();
+
+    List<GlobalValueRun> globalValueRuns;
+    _calcInstList(module, globalValueRuns);
+
+    // Need to set up the actual instructions
+    {
+        const Index numInsts = m_insts.getCount();
+        m_serialData->m_insts.setCount(numInsts);
+        // 0 is null
+        memset(&m_serialData->m_insts[0], 0, sizeof(Ser::Inst));
+
+        for (Index i = 1; i < numInsts; ++i)
+        {
+            SLANG_RETURN_ON_FAIL(_calcInst(m_insts[i], m_serialData->m_insts[i]));
         }
     }
 
+    // The mangled names are already in the string pool (as the payloads of the linkage decorations
+    // string literals), so the symbols must be calculated before the string table is produced
+    _calcSymbols(globalValueRuns);
+
     // Convert strings into a string table
     {
         SerialStringTableUtil::encodeStringTable(m_stringSlicePool, serialData->m_stringTable);
@@ -779,7 +887,7 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
         for (Index i = 1; i < numInsts; ++i)
         {
             IRInst* srcInst = m_insts[i];
-            dstLocs[i] = Ser::RawSourceLoc(srcInst->sourceLoc.getRaw());
+            dstLocs[i] = Ser::RawSourceLoc(srcInst->getSourceLoc().getRaw());
         }
     }
 
@@ -792,92 +900,8 @@ Result IRSerialWriter::write(IRModule* module, SourceManager* sourceManager, Opt
     return SLANG_OK;
 }
 
-template <typename T>
-static size_t _calcChunkSize(IRSerialBinary::CompressionType compressionType, const List<T>& array)
-{
-    typedef IRSerialBinary Bin;
-
-    if (array.getCount())
-    {
-        switch (compressionType)
-        {
-            case Bin::CompressionType::None:
-            {
-                const size_t size = sizeof(Bin::ArrayHeader) + sizeof(T) * array.getCount();
-                return (size + 3) & ~size_t(3);
-            }
-            case Bin::CompressionType::VariableByteLite:
-            {
-                const size_t payloadSize = ByteEncodeUtil::calcEncodeLiteSizeUInt32((const uint32_t*)array.begin(), (array.getCount() * sizeof(T)) / sizeof(uint32_t));
-                const size_t size = sizeof(Bin::CompressedArrayHeader) + payloadSize;
-                return (size + 3) & ~size_t(3);
-            }
-            default:
-            {
-                SLANG_ASSERT(!"Unhandled compression type");
-                return 0;
-            }
-        }
-    }
-    else
-    {
-        return 0;
-    }
-}
-
-static Result _writeArrayChunk(IRSerialBinary::CompressionType compressionType, uint32_t chunkId, const void* data, size_t numEntries, size_t typeSize, Stream* stream)
+static void _writeChunkPadding(size_t payloadSize, Stream* stream)
 {
-    typedef IRSerialBinary Bin;
-
-    if (numEntries == 0)
-    {
-        return SLANG_OK;
-    }
-
-    size_t payloadSize;
-
-    switch (compressionType)
-    {
-        case Bin::CompressionType::None:
-        {
-            payloadSize = sizeof(Bin::ArrayHeader) - sizeof(Bin::Chunk) + typeSize * numEntries;
-
-            Bin::ArrayHeader header;
-            header.m_chunk.m_type = chunkId;
-            header.m_chunk.m_size = uint32_t(payloadSize);
-            header.m_numEntries = uint32_t(numEntries);
-
-            stream->Write(&header, sizeof(header));
-
-            stream->Write(data, typeSize * numEntries);
-            break;
-        }
-        case Bin::CompressionType::VariableByteLite:
-        {
-            List<uint8_t> compressedPayload;
-
-            size_t numCompressedEntries = (numEntries * typeSize) / sizeof(uint32_t);
-
-            ByteEncodeUtil::encodeLiteUInt32((const uint32_t*)data, numCompressedEntries, compressedPayload);
-
-            payloadSize = sizeof(Bin::CompressedArrayHeader) - sizeof(Bin::Chunk) + compressedPayload.getCount();
-
-            Bin::CompressedArrayHeader header;
-            header.m_chunk.m_type = SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId);
-            header.m_chunk.m_size = uint32_t(payloadSize);
-            header.m_numEntries = uint32_t(numEntries);
-            header.m_numCompressedEntries = uint32_t(numCompressedEntries);
-
-            stream->Write(&header, sizeof(header));
-
-            stream->Write(compressedPayload.begin(), compressedPayload.getCount());
-            break;
-        }
-        default:
-        {
-            return SLANG_FAIL;
-        }
-    }
     // All chunks have sizes rounded to dword size
     if (payloadSize & 3)
     {
@@ -886,17 +910,9 @@ static Result _writeArrayChunk(IRSerialBinary::CompressionType compressionType,
         int padSize = 4 - (payloadSize & 3);
         stream->Write(pad, padSize);
     }
-
-    return SLANG_OK;
-}
-
-template <typename T>
-Result _writeArrayChunk(IRSerialBinary::CompressionType compressionType, uint32_t chunkId, const List<T>& array, Stream* stream)
-{
-    return _writeArrayChunk(compressionType, chunkId, array.begin(), size_t(array.getCount()), sizeof(T), stream);
 }
 
-Result _encodeInsts(IRSerialBinary::CompressionType compressionType, const List<IRSerialData::Inst>& instsIn, List<uint8_t>& encodeArrayOut)
+static Result _encodeInsts(IRSerialBinary::CompressionType compressionType, const IRSerialData::Inst* insts, size_t numInsts, List<uint8_t>& encodeArrayOut)
 {
     typedef IRSerialBinary Bin;
     typedef IRSerialData::Inst::PayloadType PayloadType;
@@ -906,9 +922,6 @@ Result _encodeInsts(IRSerialBinary::CompressionType compressionType, const List<
         return SLANG_FAIL;
     }
     encodeArrayOut.clear();
-    
-    const size_t numInsts = size_t(instsIn.getCount());
-    const IRSerialData::Inst* insts = instsIn.begin();
         
     uint8_t* encodeOut = encodeArrayOut.begin();
     uint8_t* encodeEnd = encodeArrayOut.end();
@@ -986,175 +999,660 @@ Result _encodeInsts(IRSerialBinary::CompressionType compressionType, const List<
     return SLANG_OK;
 }
 
-Result _writeInstArrayChunk(IRSerialBinary::CompressionType compressionType, uint32_t chunkId, const List<IRSerialData::Inst>& array, Stream* stream)
+// Encodes a chunk, so the encoding can be done in parallel with other chunks.
+//
+// VariableByteLite encodes each value independently, so large arrays are split into blocks that
+// are encoded separately (and so can also be encoded in parallel). Concatenating the encoded blocks
+// produces the same bytes as encoding the whole array in one go.
+class IRSerialChunkEncoder
 {
+public:
     typedef IRSerialBinary Bin;
-    if (array.getCount() == 0)
+
+    enum
     {
-        return SLANG_OK;
-    }
+        kBlockSize = 16 * 1024,         ///< The number of entries in a VariableByteLite block
+    };
 
-    switch (compressionType)
+    void init(Bin::CompressionType compressionType, uint32_t chunkId, const void* data, size_t numEntries, size_t typeSize, bool isInsts)
     {
-        case Bin::CompressionType::None:
+        // VariableByteLite encodes uint32 values, so can only be used if the data is made up of them
+        if (compressionType == Bin::CompressionType::VariableByteLite && !isInsts && (typeSize & 3) != 0)
         {
-            return _writeArrayChunk(compressionType, chunkId, array, stream);
+            compressionType = Bin::CompressionType::None;
         }
-        case Bin::CompressionType::VariableByteLite:
+
+        m_compressionType = compressionType;
+        m_chunkId = chunkId;
+        m_data = (const uint8_t*)data;
+        m_numEntries = numEntries;
+        m_typeSize = typeSize;
+        m_isInsts = isInsts;
+
+        Index blockCount = 0;
+        if (numEntries && compressionType != Bin::CompressionType::None)
         {
-            List<uint8_t> compressedPayload;
-            SLANG_RETURN_ON_FAIL(_encodeInsts(compressionType, array, compressedPayload));
-            
-            size_t payloadSize = sizeof(Bin::CompressedArrayHeader) - sizeof(Bin::Chunk) + compressedPayload.getCount();
+            blockCount = (compressionType == Bin::CompressionType::VariableByteLite) ? Index((numEntries + kBlockSize - 1) / kBlockSize) : 1;
+        }
+        m_blockPayloads.setCount(blockCount);
+    }
 
-            Bin::CompressedArrayHeader header;
-            header.m_chunk.m_type = SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId);
-            header.m_chunk.m_size = uint32_t(payloadSize);
-            header.m_numEntries = uint32_t(array.getCount());
-            header.m_numCompressedEntries = 0;          
+    Index getBlockCount() const { return m_blockPayloads.getCount(); }
 
-            stream->Write(&header, sizeof(header));
-            stream->Write(compressedPayload.begin(), compressedPayload.getCount());
-    
-            // All chunks have sizes rounded to dword size
-            if (payloadSize & 3)
+        /// Encode a block. Blocks can be encoded in any order, and concurrently.
+    void encodeBlock(Index blockIndex)
+    {
+        List<uint8_t>& payload = m_blockPayloads[blockIndex];
+        switch (m_compressionType)
+        {
+            case Bin::CompressionType::VariableByteLite:
             {
-                const uint8_t pad[4] = { 0, 0, 0, 0 };
-                // Pad outs
-                int padSize = 4 - (payloadSize & 3);
-                stream->Write(pad, padSize);
+                const size_t startIndex = size_t(blockIndex) * kBlockSize;
+                const size_t count = Math::Min(size_t(kBlockSize), m_numEntries - startIndex);
+                if (m_isInsts)
+                {
+                    _encodeInsts(m_compressionType, ((const IRSerialData::Inst*)m_data) + startIndex, count, payload);
+                }
+                else
+                {
+                    ByteEncodeUtil::encodeLiteUInt32((const uint32_t*)(m_data + startIndex * m_typeSize), (count * m_typeSize) / sizeof(uint32_t), payload);
+                }
+                break;
             }
-            return SLANG_OK;
+            case Bin::CompressionType::LZ4:
+            {
+                LZ4Util::compress(m_data, m_numEntries * m_typeSize, payload);
+                break;
+            }
+            default: break;
         }
-        default: break;
     }
-    return SLANG_FAIL;
-}
-
-static size_t _calcInstChunkSize(IRSerialBinary::CompressionType compressionType, const List<IRSerialData::Inst>& instsIn)
-{
-    typedef IRSerialBinary Bin;
-    typedef IRSerialData::Inst::PayloadType PayloadType;
 
-    switch (compressionType)
+        /// Write the chunk, once all of its blocks are encoded
+    Result write(Stream* stream) const
     {
-        case Bin::CompressionType::None:
+        if (m_numEntries == 0)
         {
-            return _calcChunkSize(compressionType, instsIn);
+            return SLANG_OK;
         }
-        case Bin::CompressionType::VariableByteLite:
+
+        size_t encodedSize = 0;
+        for (const auto& payload : m_blockPayloads)
         {
-            size_t size = sizeof(Bin::CompressedArrayHeader);
+            encodedSize += size_t(payload.getCount());
+        }
 
-            size_t numInsts = size_t(instsIn.getCount());
-            size += numInsts * 2;           // op and payload
+        size_t payloadSize;
+        switch (m_compressionType)
+        {
+            case Bin::CompressionType::None:
+            {
+                payloadSize = sizeof(Bin::ArrayHeader) - sizeof(Bin::Chunk) + m_typeSize * m_numEntries;
 
-            IRSerialData::Inst* insts = instsIn.begin();
+                Bin::ArrayHeader header;
+                header.m_chunk.m_type = m_chunkId;
+                header.m_chunk.m_size = uint32_t(payloadSize);
+                header.m_numEntries = uint32_t(m_numEntries);
 
-            for (size_t i = 0; i < numInsts; ++i)
+                stream->Write(&header, sizeof(header));
+                stream->Write(m_data, m_typeSize * m_numEntries);
+                break;
+            }
+            case Bin::CompressionType::VariableByteLite:
             {
-                const auto& inst = insts[i];
+                payloadSize = sizeof(Bin::CompressedArrayHeader) - sizeof(Bin::Chunk) + encodedSize;
 
-                size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_resultTypeIndex);
+                Bin::CompressedArrayHeader header;
+                header.m_chunk.m_type = SLANG_MAKE_COMPRESSED_FOUR_CC(m_chunkId);
+                header.m_chunk.m_size = uint32_t(payloadSize);
+                header.m_numEntries = uint32_t(m_numEntries);
+                header.m_numCompressedEntries = m_isInsts ? 0 : uint32_t((m_numEntries * m_typeSize) / sizeof(uint32_t));
 
-                switch (inst.m_payloadType)
+                stream->Write(&header, sizeof(header));
+                for (const auto& payload : m_blockPayloads)
                 {
-                    case PayloadType::Empty:    
-                    {
-                        break;
-                    }
-                    case PayloadType::Operand_1:
-                    case PayloadType::String_1:
-                    case PayloadType::UInt32:
-                    {
-                        // 1 UInt32
-                        size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_payload.m_operands[0]);
-                        break;
-                    }
-                    case PayloadType::Operand_2:
-                    case PayloadType::OperandAndUInt32:
-                    case PayloadType::OperandExternal:
-                    case PayloadType::String_2:
-                    {
-                        // 2 UInt32
-                        size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_payload.m_operands[0]);
-                        size += ByteEncodeUtil::calcEncodeLiteSizeUInt32((uint32_t)inst.m_payload.m_operands[1]);
-                        break;
-                    }
-                    case PayloadType::Float64:
-                    {
-                        size += sizeof(inst.m_payload.m_float64);
-                        break;
-                    }
-                    case PayloadType::Int64:
-                    {
-                        size += sizeof(inst.m_payload.m_int64);
-                        break;
-                    }
+                    stream->Write(payload.begin(), payload.getCount());
                 }
+                break;
             }
+            case Bin::CompressionType::LZ4:
+            {
+                payloadSize = sizeof(Bin::LZ4ArrayHeader) - sizeof(Bin::Chunk) + encodedSize;
+
+                Bin::LZ4ArrayHeader header;
+                header.m_chunk.m_type = SLANG_MAKE_LZ4_FOUR_CC(m_chunkId);
+                header.m_chunk.m_size = uint32_t(payloadSize);
+                header.m_numEntries = uint32_t(m_numEntries);
+                header.m_decompressedSize = uint32_t(m_numEntries * m_typeSize);
 
-            return (size + 3) & ~size_t(3);
+                stream->Write(&header, sizeof(header));
+                stream->Write(m_blockPayloads[0].begin(), m_blockPayloads[0].getCount());
+                break;
+            }
+            default:
+            {
+                return SLANG_FAIL;
+            }
         }
-        default: break;
+
+        _writeChunkPadding(payloadSize, stream);
+        return SLANG_OK;
     }
 
-    SLANG_ASSERT(!"Unhandled compression type");
-    return 0;
+protected:
+    Bin::CompressionType m_compressionType = Bin::CompressionType::None;
+    uint32_t m_chunkId = 0;
+    const uint8_t* m_data = nullptr;
+    size_t m_numEntries = 0;
+    size_t m_typeSize = 0;
+    bool m_isInsts = false;
+    List<List<uint8_t>> m_blockPayloads;
+};
+
+class IRSerialEncodeBlockJob : public ThreadPoolJob
+{
+public:
+    virtual void execute() SLANG_OVERRIDE { m_encoder->encodeBlock(m_blockIndex); }
+
+    IRSerialChunkEncoder* m_encoder = nullptr;
+    Index m_blockIndex = 0;
+};
+
+template <typename T>
+static void _addChunkEncoder(IRSerialBinary::CompressionType compressionType, uint32_t chunkId, const List<T>& array, List<IRSerialChunkEncoder>& encodersOut)
+{
+    IRSerialChunkEncoder encoder;
+    encoder.init(compressionType, chunkId, array.begin(), size_t(array.getCount()), sizeof(T), false);
+    encodersOut.add(encoder);
+}
+
+static void _addInstChunkEncoder(IRSerialBinary::CompressionType compressionType, uint32_t chunkId, const List<IRSerialData::Inst>& array, List<IRSerialChunkEncoder>& encodersOut)
+{
+    IRSerialChunkEncoder encoder;
+    encoder.init(compressionType, chunkId, array.begin(), size_t(array.getCount()), sizeof(IRSerialData::Inst), true);
+    encodersOut.add(encoder);
 }
 
-/* static */Result IRSerialWriter::writeStream(const IRSerialData& data, Bin::CompressionType compressionType, Stream* stream)
+static void _addDebugChunkEncoders(const IRSerialData& data, const IRSerialWriter::StreamOptions& options, List<IRSerialChunkEncoder>& encodersOut)
 {
-    size_t totalSize = 0;
-    
-    totalSize += sizeof(Bin::SlangHeader) +
-        _calcInstChunkSize(compressionType, data.m_insts) +
-        _calcChunkSize(compressionType, data.m_childRuns) +
-        _calcChunkSize(compressionType, data.m_externalOperands) +
-        _calcChunkSize(Bin::CompressionType::None, data.m_stringTable) +
-        _calcChunkSize(Bin::CompressionType::None, data.m_rawSourceLocs);
+    typedef IRSerialBinary Bin;
 
     if (data.m_debugSourceInfos.getCount())
     {
-        totalSize += _calcChunkSize(Bin::CompressionType::None, data.m_debugStringTable) +
-            _calcChunkSize(Bin::CompressionType::None, data.m_debugLineInfos) +
-            _calcChunkSize(Bin::CompressionType::None, data.m_debugAdjustedLineInfos) +
-            _calcChunkSize(Bin::CompressionType::None, data.m_debugSourceInfos) +
-            _calcChunkSize(compressionType, data.m_debugSourceLocRuns);
+        // The debug string table can't be compressed, as its compressed four cc would be the same as that of the string table
+        _addChunkEncoder(Bin::CompressionType::None, Bin::kDebugStringFourCc, data.m_debugStringTable, encodersOut);
+        _addChunkEncoder(options.m_sourceLocCompressionType, Bin::kDebugLineInfoFourCc, data.m_debugLineInfos, encodersOut);
+        _addChunkEncoder(options.m_sourceLocCompressionType, Bin::kDebugAdjustedLineInfoFourCc, data.m_debugAdjustedLineInfos, encodersOut);
+        _addChunkEncoder(options.m_sourceLocCompressionType, Bin::kDebugSourceInfoFourCc, data.m_debugSourceInfos, encodersOut);
+        _addChunkEncoder(options.m_instCompressionType, Bin::kDebugSourceLocRunFourCc, data.m_debugSourceLocRuns, encodersOut);
     }
+}
 
+// Encode every block of every chunk (on threadPool if set), and then write the chunks in order
+static Result _encodeAndWriteChunks(List<IRSerialChunkEncoder>& encoders, ThreadPool* threadPool, Stream* stream)
+{
+    if (threadPool)
     {
-        Bin::Chunk riffHeader;
-        riffHeader.m_type = Bin::kRiffFourCc;
-        riffHeader.m_size = uint32_t(totalSize);
-        
-        stream->Write(&riffHeader, sizeof(riffHeader));
-    }
-    {
-        Bin::SlangHeader slangHeader;
+        List<IRSerialEncodeBlockJob> jobs;
+        for (auto& encoder : encoders)
+        {
+            for (Index i = 0; i < encoder.getBlockCount(); ++i)
+            {
+                IRSerialEncodeBlockJob job;
+                job.m_encoder = &encoder;
+                job.m_blockIndex = i;
+                jobs.add(job);
+            }
+        }
+        for (auto& job : jobs)
+        {
+            threadPool->submit(&job);
+        }
+        threadPool->waitForAll();
+    }
+    else
+    {
+        for (auto& encoder : encoders)
+        {
+            for (Index i = 0; i < encoder.getBlockCount(); ++i)
+            {
+                encoder.encodeBlock(i);
+            }
+        }
+    }
+
+    for (const auto& encoder : encoders)
+    {
+        SLANG_RETURN_ON_FAIL(encoder.write(stream));
+    }
+    return SLANG_OK;
+}
+
+// Writes a chunk a block at a time, so the whole array never needs to be held in memory. The header is
+// written when the chunk is begun, and written again with the final sizes when it is ended, so the
+// stream must be seekable. LZ4 compresses a chunk as a single block, so VariableByteLite is used instead.
+class IRSerialStreamChunkWriter
+{
+public:
+    typedef IRSerialBinary Bin;
+
+    enum
+    {
+        kBlockSize = 16 * 1024,         ///< A reasonable number of entries to pass to writeBlock
+    };
+
+    void begin(Bin::CompressionType compressionType, uint32_t chunkId, size_t typeSize, bool isInsts, Stream* stream)
+    {
+        if (compressionType == Bin::CompressionType::LZ4)
+        {
+            compressionType = Bin::CompressionType::VariableByteLite;
+        }
+        // VariableByteLite encodes uint32 values, so can only be used if the data is made up of them
+        if (compressionType == Bin::CompressionType::VariableByteLite && !isInsts && (typeSize & 3) != 0)
+        {
+            compressionType = Bin::CompressionType::None;
+        }
+
+        m_compressionType = compressionType;
+        m_chunkId = chunkId;
+        m_typeSize = typeSize;
+        m_isInsts = isInsts;
+        m_stream = stream;
+
+        m_numEntries = 0;
+        m_encodedSize = 0;
+
+        m_startPosition = stream->GetPosition();
+        _writeHeader();
+    }
+
+    Result writeBlock(const void* data, size_t numEntries)
+    {
+        switch (m_compressionType)
+        {
+            case Bin::CompressionType::None:
+            {
+                m_stream->Write(data, numEntries * m_typeSize);
+                m_encodedSize += numEntries * m_typeSize;
+                break;
+            }
+            case Bin::CompressionType::VariableByteLite:
+            {
+                if (m_isInsts)
+                {
+                    SLANG_RETURN_ON_FAIL(_encodeInsts(m_compressionType, (const IRSerialData::Inst*)data, numEntries, m_encodedBlock));
+                }
+                else
+                {
+                    ByteEncodeUtil::encodeLiteUInt32((const uint32_t*)data, (numEntries * m_typeSize) / sizeof(uint32_t), m_encodedBlock);
+                }
+                m_stream->Write(m_encodedBlock.begin(), m_encodedBlock.getCount());
+                m_encodedSize += size_t(m_encodedBlock.getCount());
+                break;
+            }
+            default: return SLANG_FAIL;
+        }
+
+        m_numEntries += numEntries;
+        return SLANG_OK;
+    }
+
+    Result end()
+    {
+        const Int64 endPosition = m_stream->GetPosition();
+        m_stream->Seek(SeekOrigin::Start, m_startPosition);
+        const size_t payloadSize = _writeHeader();
+        m_stream->Seek(SeekOrigin::Start, endPosition);
+
+        _writeChunkPadding(payloadSize, m_stream);
+        return SLANG_OK;
+    }
+
+protected:
+        /// Write the header for the data so far. Returns the payload size.
+    size_t _writeHeader()
+    {
+        if (m_compressionType == Bin::CompressionType::None)
+        {
+            const size_t payloadSize = sizeof(Bin::ArrayHeader) - sizeof(Bin::Chunk) + m_encodedSize;
+
+            Bin::ArrayHeader header;
+            header.m_chunk.m_type = m_chunkId;
+            header.m_chunk.m_size = uint32_t(payloadSize);
+            header.m_numEntries = uint32_t(m_numEntries);
+
+            m_stream->Write(&header, sizeof(header));
+            return payloadSize;
+        }
+        else
+        {
+            const size_t payloadSize = sizeof(Bin::CompressedArrayHeader) - sizeof(Bin::Chunk) + m_encodedSize;
+
+            Bin::CompressedArrayHeader header;
+            header.m_chunk.m_type = SLANG_MAKE_COMPRESSED_FOUR_CC(m_chunkId);
+            header.m_chunk.m_size = uint32_t(payloadSize);
+            header.m_numEntries = uint32_t(m_numEntries);
+            header.m_numCompressedEntries = m_isInsts ? 0 : uint32_t((m_numEntries * m_typeSize) / sizeof(uint32_t));
+
+            m_stream->Write(&header, sizeof(header));
+            return payloadSize;
+        }
+    }
+
+    Bin::CompressionType m_compressionType = Bin::CompressionType::None;
+    uint32_t m_chunkId = 0;
+    size_t m_typeSize = 0;
+    bool m_isInsts = false;
+    Stream* m_stream = nullptr;
+
+    Int64 m_startPosition = 0;
+    size_t m_numEntries = 0;
+    size_t m_encodedSize = 0;                   ///< The size of the data written after the header
+    List<uint8_t> m_encodedBlock;
+};
+
+static void _writeStreamHeaders(const IRSerialWriter::StreamOptions& options, Stream* stream)
+{
+    typedef IRSerialBinary Bin;
+    {
+        // The size is patched by _patchRiffSize once it is known
+        Bin::Chunk riffHeader;
+        riffHeader.m_type = Bin::kRiffFourCc;
+        riffHeader.m_size = 0;
+
+        stream->Write(&riffHeader, sizeof(riffHeader));
+    }
+    {
+        Bin::SlangHeader slangHeader;
         slangHeader.m_chunk.m_type = Bin::kSlangFourCc;
         slangHeader.m_chunk.m_size = uint32_t(sizeof(slangHeader) - sizeof(Bin::Chunk));
         slangHeader.m_compressionType = uint32_t(Bin::CompressionType::VariableByteLite);
+        slangHeader.m_flags = options.m_deltaEncodeInstIndices ? uint32_t(Bin::SlangHeaderFlag::DeltaInstIndices) : 0u;
 
         stream->Write(&slangHeader, sizeof(slangHeader));
     }
+}
+
+static void _patchRiffSize(Int64 startPosition, Stream* stream)
+{
+    typedef IRSerialBinary Bin;
 
-    SLANG_RETURN_ON_FAIL(_writeInstArrayChunk(compressionType, Bin::kInstFourCc, data.m_insts, stream));
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kChildRunFourCc, data.m_childRuns, stream));
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(compressionType, Bin::kExternalOperandsFourCc, data.m_externalOperands, stream));
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(Bin::CompressionType::None, Bin::kStringFourCc, data.m_stringTable, stream));
+    const Int64 endPosition = stream->GetPosition();
 
-    SLANG_RETURN_ON_FAIL(_writeArrayChunk(Bin::CompressionType::None, Bin::kUInt32SourceLocFourCc, data.m_rawSourceLocs, stream));
+    Bin::Chunk riffHeader;
+    riffHeader.m_type = Bin::kRiffFourCc;
+    riffHeader.m_size = uint32_t(endPosition - startPosition - sizeof(Bin::Chunk));
 
-    if (data.m_debugSourceInfos.getCount())
+    stream->Seek(SeekOrigin::Start, startPosition);
+    stream->Write(&riffHeader, sizeof(riffHeader));
+    stream->Seek(SeekOrigin::Start, endPosition);
+}
+
+// Zig zag encode the difference between instIndex and operandIndex, so operands near to the instruction (before or after) are small.
+// 0 is used for a null operand.
+static SLANG_FORCE_INLINE uint32_t _deltaEncodeInstIndex(uint32_t instIndex, IRSerialData::InstIndex operandIndex)
+{
+    if (operandIndex == IRSerialData::InstIndex(0))
+    {
+        return 0;
+    }
+    const int32_t delta = int32_t(instIndex - uint32_t(operandIndex));
+    return ((uint32_t(delta) << 1) ^ uint32_t(delta >> 31)) + 1;
+}
+
+static SLANG_FORCE_INLINE IRSerialData::InstIndex _deltaDecodeInstIndex(uint32_t instIndex, uint32_t value)
+{
+    if (value == 0)
+    {
+        return IRSerialData::InstIndex(0);
+    }
+    value--;
+    const uint32_t delta = (value >> 1) ^ (0u - (value & 1));
+    return IRSerialData::InstIndex(instIndex - delta);
+}
+
+// Apply func to every instruction index held by inst (which is at instIndex), including its external operands
+template <typename F>
+static void _forEachInstIndex(uint32_t instIndex, IRSerialData::Inst& inst, IRSerialData::InstIndex* externalOperands, const F& func)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    func(instIndex, inst.m_resultTypeIndex);
+    switch (inst.m_payloadType)
+    {
+        case PayloadType::Operand_1:
+        {
+            func(instIndex, inst.m_payload.m_operands[0]);
+            break;
+        }
+        case PayloadType::Operand_2:
+        {
+            func(instIndex, inst.m_payload.m_operands[0]);
+            func(instIndex, inst.m_payload.m_operands[1]);
+            break;
+        }
+        case PayloadType::OperandAndUInt32:
+        {
+            func(instIndex, inst.m_payload.m_operandAndUInt32.m_operand);
+            break;
+        }
+        case PayloadType::OperandExternal:
+        {
+            auto& externalOperand = inst.m_payload.m_externalOperand;
+            IRSerialData::InstIndex* operands = externalOperands + Index(externalOperand.m_arrayIndex);
+            for (Index j = 0; j < Index(externalOperand.m_size); ++j)
+            {
+                func(instIndex, operands[j]);
+            }
+            break;
+        }
+        default: break;
+    }
+}
+
+// Apply func to every instruction index held by the instructions in insts (and their external operands)
+template <typename F>
+static void _forEachInstIndex(List<IRSerialData::Inst>& insts, List<IRSerialData::InstIndex>& externalOperands, const F& func)
+{
+    const Index numInsts = insts.getCount();
+    for (Index i = 1; i < numInsts; ++i)
+    {
+        _forEachInstIndex(uint32_t(i), insts[i], externalOperands.begin(), func);
+    }
+}
+
+static void _deltaEncodeInstIndices(uint32_t instIndex, IRSerialData::Inst& inst, IRSerialData::InstIndex* externalOperands)
+{
+    _forEachInstIndex(instIndex, inst, externalOperands, [](uint32_t instIndex, IRSerialData::InstIndex& ioIndex)
+    {
+        ioIndex = IRSerialData::InstIndex(_deltaEncodeInstIndex(instIndex, ioIndex));
+    });
+}
+
+static void _deltaEncodeInstIndices(List<IRSerialData::Inst>& insts, List<IRSerialData::InstIndex>& externalOperands)
+{
+    _forEachInstIndex(insts, externalOperands, [](uint32_t instIndex, IRSerialData::InstIndex& ioIndex)
+    {
+        ioIndex = IRSerialData::InstIndex(_deltaEncodeInstIndex(instIndex, ioIndex));
+    });
+}
+
+static void _deltaDecodeInstIndices(List<IRSerialData::Inst>& insts, List<IRSerialData::InstIndex>& externalOperands)
+{
+    _forEachInstIndex(insts, externalOperands, [](uint32_t instIndex, IRSerialData::InstIndex& ioIndex)
+    {
+        ioIndex = _deltaDecodeInstIndex(instIndex, uint32_t(ioIndex));
+    });
+}
+
+// Many small writes are made (chunk headers, padding, blocks), so unless the stream is in memory they
+// are buffered, so a large module is written with few calls to the stream.
+static Stream* _bufferWritesIfNeeded(Stream* stream, RefPtr<BufferedStream>& bufferedStreamOut)
+{
+    if (stream->isInMemory())
+    {
+        return stream;
+    }
+    bufferedStreamOut = new BufferedStream(stream);
+    return bufferedStreamOut;
+}
+
+/* static */Result IRSerialWriter::writeStream(const IRSerialData& data, Bin::CompressionType compressionType, Stream* stream)
+{
+    StreamOptions options;
+    options.m_instCompressionType = compressionType;
+    return writeStream(data, options, stream);
+}
+
+/* static */Result IRSerialWriter::writeStream(const IRSerialData& data, const StreamOptions& options, Stream* stream, ThreadPool* threadPool)
+{
+    const Bin::CompressionType instCompressionType = options.m_instCompressionType;
+    const Bin::CompressionType stringCompressionType = options.m_stringCompressionType;
+    const Bin::CompressionType sourceLocCompressionType = options.m_sourceLocCompressionType;
+
+    // Delta encoding is done on copies, which must stay alive until the chunks are encoded
+    List<Ser::Inst> deltaInsts;
+    List<Ser::InstIndex> deltaExternalOperands;
+    if (options.m_deltaEncodeInstIndices)
+    {
+        deltaInsts = data.m_insts;
+        deltaExternalOperands = data.m_externalOperands;
+        _deltaEncodeInstIndices(deltaInsts, deltaExternalOperands);
+    }
+    const List<Ser::Inst>& insts = options.m_deltaEncodeInstIndices ? deltaInsts : data.m_insts;
+    const List<Ser::InstIndex>& externalOperands = options.m_deltaEncodeInstIndices ? deltaExternalOperands : data.m_externalOperands;
+
+    // Set up the chunks in the order they are written
+    List<IRSerialChunkEncoder> encoders;
+    _addInstChunkEncoder(instCompressionType, Bin::kInstFourCc, insts, encoders);
+    _addChunkEncoder(instCompressionType, Bin::kChildRunFourCc, data.m_childRuns, encoders);
+    _addChunkEncoder(instCompressionType, Bin::kExternalOperandsFourCc, externalOperands, encoders);
+    _addChunkEncoder(stringCompressionType, Bin::kStringFourCc, data.m_stringTable, encoders);
+    _addChunkEncoder(instCompressionType, Bin::kSymbolFourCc, data.m_symbols, encoders);
+
+    _addChunkEncoder(sourceLocCompressionType, Bin::kUInt32SourceLocFourCc, data.m_rawSourceLocs, encoders);
+
+    _addDebugChunkEncoders(data, options, encoders);
+
+    RefPtr<BufferedStream> bufferedStream;
+    stream = _bufferWritesIfNeeded(stream, bufferedStream);
+
+    const Int64 startPosition = stream->GetPosition();
+    _writeStreamHeaders(options, stream);
+
+    SLANG_RETURN_ON_FAIL(_encodeAndWriteChunks(encoders, threadPool, stream));
+
+    _patchRiffSize(startPosition, stream);
+    if (bufferedStream)
+    {
+        bufferedStream->flush();
+    }
+    return SLANG_OK;
+}
+
+Result IRSerialWriter::writeStream(IRModule* module, SourceManager* sourceManager, OptionFlags optionFlags, const StreamOptions& options, Stream* stream, ThreadPool* threadPool)
+{
+    // Everything apart from the instructions and raw source locations is held in memory as usual
+    IRSerialData data;
+
+    m_sourceManager = sourceManager;
+    m_serialData = &data;
+
+    List<GlobalValueRun> globalValueRuns;
+    _calcInstList(module, globalValueRuns);
+
+    RefPtr<BufferedStream> bufferedStream;
+    stream = _bufferWritesIfNeeded(stream, bufferedStream);
+
+    const Int64 startPosition = stream->GetPosition();
+    _writeStreamHeaders(options, stream);
+
+    const Index numInsts = m_insts.getCount();
+    List<Ser::Inst> instBlock;
+    instBlock.setCount(Math::Min(numInsts, Index(IRSerialStreamChunkWriter::kBlockSize)));
+
+    // Convert and write the instructions a block at a time. External operands and strings are added as
+    // instructions are converted, so are only complete once all the instructions have been written.
+    {
+        IRSerialStreamChunkWriter chunkWriter;
+        chunkWriter.begin(options.m_instCompressionType, Bin::kInstFourCc, sizeof(Ser::Inst), true, stream);
+
+        for (Index blockStart = 0; blockStart < numInsts; blockStart += instBlock.getCount())
+        {
+            const Index blockCount = Math::Min(instBlock.getCount(), numInsts - blockStart);
+            for (Index i = 0; i < blockCount; ++i)
+            {
+                const Index instIndex = blockStart + i;
+                Ser::Inst& dstInst = instBlock[i];
+                if (instIndex == 0)
+                {
+                    // 0 is null
+                    memset(&dstInst, 0, sizeof(dstInst));
+                    continue;
+                }
+
+                SLANG_RETURN_ON_FAIL(_calcInst(m_insts[instIndex], dstInst));
+                if (options.m_deltaEncodeInstIndices)
+                {
+                    _deltaEncodeInstIndices(uint32_t(instIndex), dstInst, data.m_externalOperands.begin());
+                }
+            }
+            SLANG_RETURN_ON_FAIL(chunkWriter.writeBlock(instBlock.begin(), size_t(blockCount)));
+        }
+        SLANG_RETURN_ON_FAIL(chunkWriter.end());
+    }
+    instBlock = List<Ser::Inst>();
+
+    _calcSymbols(globalValueRuns);
+    SerialStringTableUtil::encodeStringTable(m_stringSlicePool, data.m_stringTable);
+
+    {
+        List<IRSerialChunkEncoder> encoders;
+        _addChunkEncoder(options.m_instCompressionType, Bin::kChildRunFourCc, data.m_childRuns, encoders);
+        _addChunkEncoder(options.m_instCompressionType, Bin::kExternalOperandsFourCc, data.m_externalOperands, encoders);
+        _addChunkEncoder(options.m_stringCompressionType, Bin::kStringFourCc, data.m_stringTable, encoders);
+        _addChunkEncoder(options.m_instCompressionType, Bin::kSymbolFourCc, data.m_symbols, encoders);
+        SLANG_RETURN_ON_FAIL(_encodeAndWriteChunks(encoders, threadPool, stream));
+    }
+
+    if (optionFlags & OptionFlag::RawSourceLocation)
+    {
+        List<Ser::RawSourceLoc> locBlock;
+        locBlock.setCount(Math::Min(numInsts, Index(IRSerialStreamChunkWriter::kBlockSize)));
+
+        IRSerialStreamChunkWriter chunkWriter;
+        chunkWriter.begin(options.m_sourceLocCompressionType, Bin::kUInt32SourceLocFourCc, sizeof(Ser::RawSourceLoc), false, stream);
+
+        for (Index blockStart = 0; blockStart < numInsts; blockStart += locBlock.getCount())
+        {
+            const Index blockCount = Math::Min(locBlock.getCount(), numInsts - blockStart);
+            for (Index i = 0; i < blockCount; ++i)
+            {
+                const Index instIndex = blockStart + i;
+                // 0 is null, just mark as no location
+                locBlock[i] = (instIndex == 0) ? Ser::RawSourceLoc(0) : Ser::RawSourceLoc(m_insts[instIndex]->getSourceLoc().getRaw());
+            }
+            SLANG_RETURN_ON_FAIL(chunkWriter.writeBlock(locBlock.begin(), size_t(blockCount)));
+        }
+        SLANG_RETURN_ON_FAIL(chunkWriter.end());
+    }
+
+    if (optionFlags & OptionFlag::DebugInfo)
     {
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugStringFourCc, data.m_debugStringTable, stream);
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugLineInfoFourCc, data.m_debugLineInfos, stream);
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugAdjustedLineInfoFourCc, data.m_debugAdjustedLineInfos, stream);
-        _writeArrayChunk(Bin::CompressionType::None, Bin::kDebugSourceInfoFourCc, data.m_debugSourceInfos, stream);
-        _writeArrayChunk(compressionType, Bin::kDebugSourceLocRunFourCc, data.m_debugSourceLocRuns, stream);
+        _calcDebugInfo();
+
+        List<IRSerialChunkEncoder> encoders;
+        _addDebugChunkEncoders(data, options, encoders);
+        SLANG_RETURN_ON_FAIL(_encodeAndWriteChunks(encoders, threadPool, stream));
+    }
+
+    _patchRiffSize(startPosition, stream);
+    if (bufferedStream)
+    {
+        bufferedStream->flush();
     }
 
+    m_serialData = nullptr;
     return SLANG_OK;
 }
 
@@ -1192,6 +1690,19 @@ class ListResizerForType: public ListResizer
     List<T>& m_list;
 };
 
+// Returns the next size bytes of the stream. If the stream can't provide a view of its contents
+// (see `Stream::readView`), the bytes are read into storage.
+static const uint8_t* _readPayload(Stream* stream, size_t size, List<uint8_t>& storage)
+{
+    if (const void* view = stream->readView(Int64(size)))
+    {
+        return (const uint8_t*)view;
+    }
+    storage.setCount(Index(size));
+    stream->Read(storage.getBuffer(), Int64(size));
+    return storage.getBuffer();
+}
+
 static Result _readArrayChunk(IRSerialBinary::CompressionType compressionType, const IRSerialBinary::Chunk& chunk, Stream* stream, size_t* numReadInOut, ListResizer& listOut)
 {
     typedef IRSerialBinary Bin;
@@ -1200,6 +1711,29 @@ static Result _readArrayChunk(IRSerialBinary::CompressionType compressionType, c
 
     switch (compressionType)
     {
+        case Bin::CompressionType::LZ4:
+        {
+            Bin::LZ4ArrayHeader header;
+            header.m_chunk = chunk;
+
+            stream->Read(&header.m_chunk + 1, sizeof(header) - sizeof(Bin::Chunk));
+            *numReadInOut += sizeof(header) - sizeof(Bin::Chunk);
+
+            const size_t payloadSize = header.m_chunk.m_size - (sizeof(header) - sizeof(Bin::Chunk));
+
+            List<uint8_t> payloadStorage;
+            const uint8_t* compressedPayload = _readPayload(stream, payloadSize, payloadStorage);
+            *numReadInOut += payloadSize;
+
+            if (size_t(header.m_decompressedSize) != size_t(header.m_numEntries) * typeSize)
+            {
+                return SLANG_FAIL;
+            }
+
+            void* data = listOut.setSize(header.m_numEntries);
+            SLANG_RETURN_ON_FAIL(LZ4Util::decompress(compressedPayload, payloadSize, data, header.m_decompressedSize));
+            break;
+        }
         case Bin::CompressionType::VariableByteLite:
         {
             // We have a compressed header
@@ -1214,16 +1748,14 @@ static Result _readArrayChunk(IRSerialBinary::CompressionType compressionType, c
             // Need to read all the compressed data... 
             size_t payloadSize = header.m_chunk.m_size - (sizeof(header) - sizeof(Bin::Chunk));
 
-            List<uint8_t> compressedPayload;
-            compressedPayload.setCount(payloadSize);
-
-            stream->Read(compressedPayload.begin(), payloadSize);
+            List<uint8_t> payloadStorage;
+            const uint8_t* compressedPayload = _readPayload(stream, payloadSize, payloadStorage);
             *numReadInOut += payloadSize;
         
             SLANG_ASSERT(header.m_numCompressedEntries == uint32_t((header.m_numEntries * typeSize) / sizeof(uint32_t)));
 
             // Decode..
-            ByteEncodeUtil::decodeLiteUInt32(compressedPayload.begin(), header.m_numCompressedEntries, (uint32_t*)data);
+            ByteEncodeUtil::decodeLiteUInt32(compressedPayload, header.m_numCompressedEntries, (uint32_t*)data);
             break;
         }
         case Bin::CompressionType::None:
@@ -1243,6 +1775,10 @@ static Result _readArrayChunk(IRSerialBinary::CompressionType compressionType, c
             *numReadInOut += payloadSize;
             break;
         }
+        default:
+        {
+            return SLANG_FAIL;
+        }
     }
 
     // All chunks have sizes rounded to dword size
@@ -1259,32 +1795,31 @@ static Result _readArrayChunk(IRSerialBinary::CompressionType compressionType, c
     return SLANG_OK;
 }
 
-template <typename T>
-Result _readArrayChunk(const IRSerialBinary::SlangHeader& header, const IRSerialBinary::Chunk& chunk, Stream* stream, size_t* numReadInOut, List<T>& arrayOut)
+// The compression used on a chunk is identified by its four cc
+static IRSerialBinary::CompressionType _getChunkCompressionType(const IRSerialBinary::SlangHeader& header, const IRSerialBinary::Chunk& chunk)
 {
     typedef IRSerialBinary Bin;
 
-    Bin::CompressionType compressionType = Bin::CompressionType::None;
-
     if (chunk.m_type == SLANG_MAKE_COMPRESSED_FOUR_CC(chunk.m_type))
     {
         // If it has compression, use the compression type set in the header
-        compressionType = Bin::CompressionType(header.m_compressionType);
+        return Bin::CompressionType(header.m_compressionType);
     }
-    ListResizerForType<T> resizer(arrayOut);
-    return _readArrayChunk(compressionType, chunk, stream, numReadInOut, resizer);
-}  
+    if (chunk.m_type == SLANG_MAKE_LZ4_FOUR_CC(chunk.m_type))
+    {
+        return Bin::CompressionType::LZ4;
+    }
+    return Bin::CompressionType::None;
+}
 
 template <typename T>
-Result _readArrayUncompressedChunk(const IRSerialBinary::SlangHeader& header, const IRSerialBinary::Chunk& chunk, Stream* stream, size_t* numReadInOut, List<T>& arrayOut)
+Result _readArrayChunk(const IRSerialBinary::SlangHeader& header, const IRSerialBinary::Chunk& chunk, Stream* stream, size_t* numReadInOut, List<T>& arrayOut)
 {
-    typedef IRSerialBinary Bin;
-    SLANG_UNUSED(header);
     ListResizerForType<T> resizer(arrayOut);
-    return _readArrayChunk(Bin::CompressionType::None, chunk, stream, numReadInOut, resizer);
-}
+    return _readArrayChunk(_getChunkCompressionType(header, chunk), chunk, stream, numReadInOut, resizer);
+}  
 
-static Result _decodeInsts(IRSerialBinary::CompressionType compressionType, const List<uint8_t>& encodeIn, List<IRSerialData::Inst>& instsOut)
+static Result _decodeInsts(IRSerialBinary::CompressionType compressionType, const uint8_t* encodeIn, List<IRSerialData::Inst>& instsOut)
 {
     typedef IRSerialBinary Bin;
     typedef IRSerialData::Inst::PayloadType PayloadType;
@@ -1297,7 +1832,7 @@ static Result _decodeInsts(IRSerialBinary::CompressionType compressionType, cons
     const size_t numInsts = size_t(instsOut.getCount());
     IRSerialData::Inst* insts = instsOut.begin();
 
-    const uint8_t* encodeCur = encodeIn.begin();
+    const uint8_t* encodeCur = encodeIn;
 
     for (size_t i = 0; i < numInsts; ++i)
     {
@@ -1355,15 +1890,12 @@ Result _readInstArrayChunk(const IRSerialBinary::SlangHeader& slangHeader, const
 {
     typedef IRSerialBinary Bin;
 
-    Bin::CompressionType compressionType = Bin::CompressionType::None;
-    if (chunk.m_type == SLANG_MAKE_COMPRESSED_FOUR_CC(chunk.m_type))
-    {
-        compressionType = Bin::CompressionType(slangHeader.m_compressionType);
-    }
+    const Bin::CompressionType compressionType = _getChunkCompressionType(slangHeader, chunk);
 
     switch (compressionType)
     {
         case Bin::CompressionType::None:
+        case Bin::CompressionType::LZ4:
         {
             ListResizerForType<IRSerialData::Inst> resizer(arrayOut);
             return _readArrayChunk(compressionType, chunk, stream, numReadInOut, resizer);
@@ -1380,10 +1912,8 @@ Result _readInstArrayChunk(const IRSerialBinary::SlangHeader& slangHeader, const
             // Need to read all the compressed data... 
             size_t payloadSize = header.m_chunk.m_size - (sizeof(header) - sizeof(Bin::Chunk));
 
-            List<uint8_t> compressedPayload;
-            compressedPayload.setCount(payloadSize);
-
-            stream->Read(compressedPayload.begin(), payloadSize);
+            List<uint8_t> payloadStorage;
+            const uint8_t* compressedPayload = _readPayload(stream, payloadSize, payloadStorage);
             *numReadInOut += payloadSize;
 
             arrayOut.setCount(header.m_numEntries);
@@ -1429,12 +1959,285 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
     return SLANG_OK;
 }
 
-/* static */Result IRSerialReader::readStream(Stream* stream, IRSerialData* dataOut)
+// Append the chunk (whose Chunk header has already been read from stream) to encodedOut, as it was in the stream
+static Result _appendEncodedChunk(const IRSerialBinary::Chunk& chunk, Stream* stream, List<uint8_t>& encodedOut)
+{
+    const size_t totalSize = size_t(_calcChunkTotalSize(chunk));
+    const size_t payloadSize = totalSize - sizeof(chunk);
+
+    const Index startIndex = encodedOut.getCount();
+    encodedOut.setCount(startIndex + Index(totalSize));
+    uint8_t* dst = encodedOut.getBuffer() + startIndex;
+
+    ::memcpy(dst, &chunk, sizeof(chunk));
+    if (stream->Read(dst + sizeof(chunk), Int64(payloadSize)) != Int64(payloadSize))
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+// Which of the encoded debug chunks to decode
+struct DebugChunkFlag
+{
+    typedef uint32_t Flags;
+    enum Enum : Flags
+    {
+        SourceLocs = 0x1,           ///< The source infos, and the runs of instructions with a source loc
+        Lines = 0x2,                ///< The strings, and the line infos (only needed to construct the source views)
+        All = SourceLocs | Lines,
+    };
+};
+
+// Decode the chunks selected by flags, of the encoded debug chunks, into dataOut's debug data
+static Result _decodeDebugChunks(const List<uint8_t>& encoded, uint32_t compressionType, DebugChunkFlag::Flags flags, IRSerialData* dataOut)
+{
+    typedef IRSerialBinary Bin;
+
+    // Only the compression type of the header is used to decode chunks
+    Bin::SlangHeader slangHeader;
+    memset(&slangHeader, 0, sizeof(slangHeader));
+    slangHeader.m_compressionType = compressionType;
+
+    BlobStream stream(encoded.getBuffer(), size_t(encoded.getCount()));
+
+    const bool isSourceLocs = (flags & DebugChunkFlag::SourceLocs) != 0;
+    const bool isLines = (flags & DebugChunkFlag::Lines) != 0;
+
+    Index offset = 0;
+    while (offset < encoded.getCount())
+    {
+        Bin::Chunk chunk;
+        if (stream.Read(&chunk, sizeof(chunk)) != Int64(sizeof(chunk)))
+        {
+            return SLANG_FAIL;
+        }
+        size_t numRead = sizeof(chunk);
+
+        switch (chunk.m_type)
+        {
+            case Bin::kDebugStringFourCc:
+            {
+                if (isLines)
+                {
+                    SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, &stream, &numRead, dataOut->m_debugStringTable));
+                }
+                break;
+            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugLineInfoFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugLineInfoFourCc):
+            case Bin::kDebugLineInfoFourCc:
+            {
+                if (isLines)
+                {
+                    SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, &stream, &numRead, dataOut->m_debugLineInfos));
+                }
+                break;
+            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugAdjustedLineInfoFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugAdjustedLineInfoFourCc):
+            case Bin::kDebugAdjustedLineInfoFourCc:
+            {
+                if (isLines)
+                {
+                    SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, &stream, &numRead, dataOut->m_debugAdjustedLineInfos));
+                }
+                break;
+            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceInfoFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugSourceInfoFourCc):
+            case Bin::kDebugSourceInfoFourCc:
+            {
+                if (isSourceLocs)
+                {
+                    SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, &stream, &numRead, dataOut->m_debugSourceInfos));
+                }
+                break;
+            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceLocRunFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugSourceLocRunFourCc):
+            case Bin::kDebugSourceLocRunFourCc:
+            {
+                if (isSourceLocs)
+                {
+                    SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, &stream, &numRead, dataOut->m_debugSourceLocRuns));
+                }
+                break;
+            }
+            default:
+            {
+                break;
+            }
+        }
+
+        // Move to the next chunk, whether this one was decoded or not
+        offset += Index(_calcChunkTotalSize(chunk));
+        stream.Seek(SeekOrigin::Start, Int64(offset));
+    }
+    return SLANG_OK;
+}
+
+/* static */Result IRSerialReader::decodeDebugChunks(IRSerialData* data)
+{
+    SLANG_RETURN_ON_FAIL(_decodeDebugChunks(data->m_encodedDebugChunks, data->m_encodedDebugCompressionType, DebugChunkFlag::All, data));
+    data->m_encodedDebugChunks.clearAndDeallocate();
+    data->m_encodedDebugCompressionType = 0;
+    return SLANG_OK;
+}
+
+// Reads a chunk taken out of the stream, so it can be decoded on another thread
+class IRSerialChunkReadJob : public RefObject, public ThreadPoolJob
+{
+public:
+    IRSerialChunkReadJob(const IRSerialBinary::SlangHeader& slangHeader, const IRSerialBinary::Chunk& chunk):
+        m_slangHeader(slangHeader),
+        m_chunk(chunk)
+    {
+    }
+
+    IRSerialBinary::SlangHeader m_slangHeader;
+    IRSerialBinary::Chunk m_chunk;
+    RefPtr<BlobStream> m_payload;           ///< Everything in the chunk after the Chunk header
+    List<uint8_t> m_payloadCopy;            ///< Holds the payload if the stream couldn't provide a view of it
+    Result m_result = SLANG_OK;
+};
+
+template <typename T>
+class IRSerialArrayChunkReadJob : public IRSerialChunkReadJob
+{
+public:
+    typedef IRSerialChunkReadJob Super;
+
+    virtual void execute() SLANG_OVERRIDE
+    {
+        size_t numRead = sizeof(m_chunk);
+        m_result = _readArrayChunk(m_slangHeader, m_chunk, m_payload, &numRead, *m_arrayOut);
+    }
+
+    IRSerialArrayChunkReadJob(const IRSerialBinary::SlangHeader& slangHeader, const IRSerialBinary::Chunk& chunk, List<T>* arrayOut):
+        Super(slangHeader, chunk),
+        m_arrayOut(arrayOut)
+    {
+    }
+
+    List<T>* m_arrayOut;
+};
+
+class IRSerialInstChunkReadJob : public IRSerialChunkReadJob
+{
+public:
+    typedef IRSerialChunkReadJob Super;
+
+    virtual void execute() SLANG_OVERRIDE
+    {
+        size_t numRead = sizeof(m_chunk);
+        m_result = _readInstArrayChunk(m_slangHeader, m_chunk, m_payload, &numRead, *m_instsOut);
+    }
+
+    IRSerialInstChunkReadJob(const IRSerialBinary::SlangHeader& slangHeader, const IRSerialBinary::Chunk& chunk, List<IRSerialData::Inst>* instsOut):
+        Super(slangHeader, chunk),
+        m_instsOut(instsOut)
+    {
+    }
+
+    List<IRSerialData::Inst>* m_instsOut;
+};
+
+// Reads chunks either directly from the stream, or if there is a thread pool, by taking the chunk
+// (as a view if the stream is in memory, otherwise as a copy) and decoding it on the pool. The chunks all decode into different arrays, so can be decoded in any order.
+class IRSerialChunkReader
+{
+public:
+    typedef IRSerialBinary Bin;
+
+    template <typename T>
+    Result readArray(const Bin::SlangHeader& slangHeader, const Bin::Chunk& chunk, List<T>& arrayOut)
+    {
+        if (!m_threadPool)
+        {
+            size_t numRead = sizeof(chunk);
+            return _readArrayChunk(slangHeader, chunk, m_stream, &numRead, arrayOut);
+        }
+        return _submit(new IRSerialArrayChunkReadJob<T>(slangHeader, chunk, &arrayOut));
+    }
+
+    Result readInsts(const Bin::SlangHeader& slangHeader, const Bin::Chunk& chunk, List<IRSerialData::Inst>& instsOut)
+    {
+        if (!m_threadPool)
+        {
+            size_t numRead = sizeof(chunk);
+            return _readInstArrayChunk(slangHeader, chunk, m_stream, &numRead, instsOut);
+        }
+        return _submit(new IRSerialInstChunkReadJob(slangHeader, chunk, &instsOut));
+    }
+
+        /// Wait for all the chunks to be decoded. Must be called before the output arrays are used.
+    Result finish()
+    {
+        if (m_threadPool)
+        {
+            m_threadPool->waitForAll();
+            for (auto& job : m_jobs)
+            {
+                SLANG_RETURN_ON_FAIL(job->m_result);
+            }
+            m_jobs.clear();
+        }
+        return SLANG_OK;
+    }
+
+    IRSerialChunkReader(Stream* stream, ThreadPool* threadPool):
+        m_stream(stream),
+        m_threadPool(threadPool)
+    {
+    }
+    ~IRSerialChunkReader()
+    {
+        // Jobs reference the output arrays, so can't be left running
+        if (m_threadPool)
+        {
+            m_threadPool->waitForAll();
+        }
+    }
+
+protected:
+    Result _submit(IRSerialChunkReadJob* job)
+    {
+        RefPtr<IRSerialChunkReadJob> jobPtr(job);
+
+        // Take the chunk out of the stream (including padding), so the stream is left at the next chunk.
+        // The stream outlives the reader, so a view of its contents stays valid until the jobs finish.
+        const size_t payloadSize = size_t(_calcChunkTotalSize(job->m_chunk) - sizeof(Bin::Chunk));
+        const void* payload = m_stream->readView(Int64(payloadSize));
+        if (!payload)
+        {
+            job->m_payloadCopy.setCount(Index(payloadSize));
+            if (m_stream->Read(job->m_payloadCopy.getBuffer(), payloadSize) != Int64(payloadSize))
+            {
+                return SLANG_FAIL;
+            }
+            payload = job->m_payloadCopy.getBuffer();
+        }
+        job->m_payload = new BlobStream(payload, payloadSize);
+
+        m_jobs.add(jobPtr);
+        m_threadPool->submit(job);
+        return SLANG_OK;
+    }
+
+    Stream* m_stream;
+    ThreadPool* m_threadPool;
+    List<RefPtr<IRSerialChunkReadJob>> m_jobs;
+};
+
+/* static */Result IRSerialReader::readStream(Stream* stream, IRSerialData* dataOut, ThreadPool* threadPool)
 {
     typedef IRSerialBinary Bin;
 
     dataOut->clear();
 
+    IRSerialChunkReader chunkReader(stream, threadPool);
+
     int64_t remainingBytes = 0;
     {
         Bin::Chunk header;
@@ -1458,8 +2261,6 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
 
         stream->Read(&chunk, sizeof(chunk));
 
-        size_t bytesRead = sizeof(chunk);
-
         switch (chunk.m_type)
         {
             case Bin::kSlangFourCc:
@@ -1467,78 +2268,81 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
                 // Slang header
                 slangHeader.m_chunk = chunk;
 
-                // NOTE! Really we should only read what we know the size to be...
-                // and skip if it's larger
-
-                stream->Read(&slangHeader.m_chunk + 1, sizeof(slangHeader) - sizeof(chunk));
+                // Only read as much as we know about, and skip anything else
+                const size_t readSize = Math::Min(size_t(chunk.m_size), sizeof(slangHeader) - sizeof(chunk));
+                stream->Read(&slangHeader.m_chunk + 1, readSize);
+                stream->Seek(SeekOrigin::Current, _calcChunkTotalSize(chunk) - int64_t(sizeof(chunk) + readSize));
 
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kInstFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kInstFourCc):
             case Bin::kInstFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readInstArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_insts));
+                SLANG_RETURN_ON_FAIL(chunkReader.readInsts(slangHeader, chunk, dataOut->m_insts));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;    
             }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kChildRunFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kChildRunFourCc):
             case Bin::kChildRunFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_childRuns));
+                SLANG_RETURN_ON_FAIL(chunkReader.readArray(slangHeader, chunk, dataOut->m_childRuns));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kExternalOperandsFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kExternalOperandsFourCc):
             case Bin::kExternalOperandsFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_externalOperands));
+                SLANG_RETURN_ON_FAIL(chunkReader.readArray(slangHeader, chunk, dataOut->m_externalOperands));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kStringFourCc):
             case Bin::kStringFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_stringTable));
+                SLANG_RETURN_ON_FAIL(chunkReader.readArray(slangHeader, chunk, dataOut->m_stringTable));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
-            case Bin::kUInt32SourceLocFourCc:
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kSymbolFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kSymbolFourCc):
+            case Bin::kSymbolFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_rawSourceLocs));
+                SLANG_RETURN_ON_FAIL(chunkReader.readArray(slangHeader, chunk, dataOut->m_symbols));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
-            case Bin::kDebugStringFourCc:
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kUInt32SourceLocFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kUInt32SourceLocFourCc):
+            case Bin::kUInt32SourceLocFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugStringTable));
+                SLANG_RETURN_ON_FAIL(chunkReader.readArray(slangHeader, chunk, dataOut->m_rawSourceLocs));
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
             }
+            case Bin::kDebugStringFourCc:
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugLineInfoFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugLineInfoFourCc):
             case Bin::kDebugLineInfoFourCc:
-            {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugLineInfos));
-                remainingBytes -= _calcChunkTotalSize(chunk);
-                break;
-            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugAdjustedLineInfoFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugAdjustedLineInfoFourCc):
             case Bin::kDebugAdjustedLineInfoFourCc:
-            {
-                SLANG_RETURN_ON_FAIL(_readArrayUncompressedChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugAdjustedLineInfos));
-                remainingBytes -= _calcChunkTotalSize(chunk);
-                break;
-            }
+            case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceInfoFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugSourceInfoFourCc):
             case Bin::kDebugSourceInfoFourCc:
-            {
-                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugSourceInfos));
-                remainingBytes -= _calcChunkTotalSize(chunk);
-                break;
-            }
             case SLANG_MAKE_COMPRESSED_FOUR_CC(Bin::kDebugSourceLocRunFourCc):
+            case SLANG_MAKE_LZ4_FOUR_CC(Bin::kDebugSourceLocRunFourCc):
             case Bin::kDebugSourceLocRunFourCc:
             {
-                SLANG_RETURN_ON_FAIL(_readArrayChunk(slangHeader, chunk, stream, &bytesRead, dataOut->m_debugSourceLocRuns));
+                // Debug information is often never used, so is only decoded when it is (see decodeDebugChunks)
+                SLANG_RETURN_ON_FAIL(_appendEncodedChunk(chunk, stream, dataOut->m_encodedDebugChunks));
+                dataOut->m_encodedDebugCompressionType = slangHeader.m_compressionType;
                 remainingBytes -= _calcChunkTotalSize(chunk);
                 break;
-            } 
+            }
 
             default:
             {
@@ -1548,6 +2352,13 @@ int64_t _calcChunkTotalSize(const IRSerialBinary::Chunk& chunk)
         }
     }
 
+    SLANG_RETURN_ON_FAIL(chunkReader.finish());
+
+    if (slangHeader.m_flags & Bin::SlangHeaderFlag::DeltaInstIndices)
+    {
+        _deltaDecodeInstIndices(dataOut->m_insts, dataOut->m_externalOperands);
+    }
+
     return SLANG_OK;
 }
 
@@ -1573,10 +2384,334 @@ static int _findIndex(const List<IRSerialData::DebugSourceInfo>& infos, SourceLo
     return -1;
 }
 
-static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceView* sourceView, SourceRange& rangeOut)
+static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceLoc beginLoc, SourceRange& rangeOut)
 {
     rangeOut = _toSourceRange(info);
-    return int(sourceView->getRange().begin.getRaw()) - int(info.m_startSourceLoc);
+    return int(beginLoc.getRaw()) - int(info.m_startSourceLoc);
+}
+
+// The debug information of a serialized module. Instructions are given locations in a range allocated on a SourceManager
+// up front, but the source files and views the locations are in are only created when a location is first looked up.
+class IRSerialDeferredSourceViews : public DeferredSourceViews
+{
+public:
+    typedef IRSerialData Ser;
+
+        /// Take the debug information from data. Only what is needed to give instructions locations is decoded.
+    Result init(const IRSerialData& data);
+
+        /// True if there are any source locations
+    bool hasSourceLocs() const { return m_debugData.m_debugSourceInfos.getCount() > 0; }
+        /// Get the runs of instructions that have a source location
+    const List<Ser::SourceLocRun>& getSourceLocRuns() const { return m_debugData.m_debugSourceLocRuns; }
+
+        /// Allocate the locations of all the source files on sourceManager
+    void allocateSourceLocs(SourceManager* sourceManager);
+        /// Set the locations of the instructions in runs. insts holds the instructions by index.
+    void setSourceLocs(const List<IRInst*>& insts);
+
+    // DeferredSourceViews
+    virtual void createSourceViews(SourceManager* sourceManager, const SourceRange& range) SLANG_OVERRIDE;
+
+protected:
+    Ser m_debugData;                        ///< Just the debug information. The lines and strings are decoded when the views are created.
+    List<SourceLoc> m_sourceInfoLocs;       ///< The first location of each source info, in the range allocated on the SourceManager
+};
+
+Result IRSerialDeferredSourceViews::init(const IRSerialData& data)
+{
+    m_debugData.m_debugStringTable = data.m_debugStringTable;
+    m_debugData.m_debugLineInfos = data.m_debugLineInfos;
+    m_debugData.m_debugAdjustedLineInfos = data.m_debugAdjustedLineInfos;
+    m_debugData.m_debugSourceInfos = data.m_debugSourceInfos;
+    m_debugData.m_debugSourceLocRuns = data.m_debugSourceLocRuns;
+
+    // Keep the encoded chunks, but decode the source infos and runs now, as they are needed to set the instruction locations
+    m_debugData.m_encodedDebugChunks = data.m_encodedDebugChunks;
+    m_debugData.m_encodedDebugCompressionType = data.m_encodedDebugCompressionType;
+    return _decodeDebugChunks(m_debugData.m_encodedDebugChunks, m_debugData.m_encodedDebugCompressionType, DebugChunkFlag::SourceLocs, &m_debugData);
+}
+
+void IRSerialDeferredSourceViews::allocateSourceLocs(SourceManager* sourceManager)
+{
+    const List<Ser::DebugSourceInfo>& sourceInfos = m_debugData.m_debugSourceInfos;
+    const Index numSourceInfos = sourceInfos.getCount();
+
+    // Lay the files out as createSourceView would, with one location after the end of each file
+    UInt totalSize = 0;
+    for (const auto& sourceInfo : sourceInfos)
+    {
+        totalSize += UInt(sourceInfo.m_endSourceLoc - sourceInfo.m_startSourceLoc) + 1;
+    }
+
+    const SourceRange range = sourceManager->allocateDeferredSourceRange(totalSize - 1, this);
+
+    m_sourceInfoLocs.setCount(numSourceInfos);
+    SourceLoc loc = range.begin;
+    for (Index i = 0; i < numSourceInfos; ++i)
+    {
+        m_sourceInfoLocs[i] = loc;
+        loc = loc + UInt(sourceInfos[i].m_endSourceLoc - sourceInfos[i].m_startSourceLoc) + 1;
+    }
+}
+
+void IRSerialDeferredSourceViews::setSourceLocs(const List<IRInst*>& insts)
+{
+    const List<Ser::DebugSourceInfo>& sourceInfos = m_debugData.m_debugSourceInfos;
+
+    List<Ser::SourceLocRun> sourceRuns(m_debugData.m_debugSourceLocRuns);
+    // They are now in source location order
+    sourceRuns.sort();
+
+    // Just guess initially 0 for the source file that contains the initial run
+    SourceRange range;
+    int fixSourceLoc = _calcFixSourceLoc(sourceInfos[0], m_sourceInfoLocs[0], range);
+
+    const Index numRuns = sourceRuns.getCount();
+    for (Index i = 0; i < numRuns; ++i)
+    {
+        const auto& run = sourceRuns[i];
+        const SourceLoc srcSourceLoc = SourceLoc::fromRaw(run.m_sourceLoc);
+
+        if (!range.contains(srcSourceLoc))
+        {
+            int index = _findIndex(sourceInfos, srcSourceLoc);
+            if (index < 0)
+            {
+                // Didn't find the match
+                continue;
+            }
+            fixSourceLoc = _calcFixSourceLoc(sourceInfos[index], m_sourceInfoLocs[index], range);
+            SLANG_ASSERT(range.contains(srcSourceLoc));
+        }
+
+        // Work out the fixed source location
+        SourceLoc sourceLoc = SourceLoc::fromRaw(int(run.m_sourceLoc) + fixSourceLoc);
+
+        SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
+        IRInst*const* dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
+
+        const int runSize = int(run.m_numInst);
+        for (int j = 0; j < runSize; ++j)
+        {
+            dstInsts[j]->setSourceLoc(sourceLoc);
+        }
+    }
+}
+
+void IRSerialDeferredSourceViews::createSourceViews(SourceManager* sourceManager, const SourceRange& range)
+{
+    SLANG_UNUSED(range);
+
+    // If the lines can't be decoded, the locations just won't be found
+    if (SLANG_FAILED(_decodeDebugChunks(m_debugData.m_encodedDebugChunks, m_debugData.m_encodedDebugCompressionType, DebugChunkFlag::Lines, &m_debugData)))
+    {
+        return;
+    }
+    m_debugData.m_encodedDebugChunks.clearAndDeallocate();
+
+    List<UnownedStringSlice> debugStringSlices;
+    SerialStringTableUtil::decodeStringTable(m_debugData.m_debugStringTable, debugStringSlices);
+
+    // All of the strings are placed in the manager (and its StringSlicePool) where the SourceView and SourceFile are constructed from
+    List<StringSlicePool::Handle> stringMap;
+    SerialStringTableUtil::calcStringSlicePoolMap(debugStringSlices, sourceManager->getStringSlicePool(), stringMap);
+
+    const List<Ser::DebugSourceInfo>& sourceInfos = m_debugData.m_debugSourceInfos;
+
+    // Construct the source files (there is only one SourceFile per view)
+    const Index numSourceFiles = sourceInfos.getCount();
+    for (Index i = 0; i < numSourceFiles; ++i)
+    {
+        const Ser::DebugSourceInfo& srcSourceInfo = sourceInfos[i];
+
+        PathInfo pathInfo;
+        pathInfo.type = PathInfo::Type::FoundPath;
+        pathInfo.foundPath = debugStringSlices[UInt(srcSourceInfo.m_pathIndex)];
+
+        SourceFile* sourceFile = sourceManager->createSourceFileWithSize(pathInfo, srcSourceInfo.m_endSourceLoc - srcSourceInfo.m_startSourceLoc);
+        SourceView* sourceView = sourceManager->createSourceViewAt(sourceFile, m_sourceInfoLocs[i]);
+
+        // We need to accumulate all line numbers, for this source file, both adjusted and unadjusted
+        List<Ser::DebugLineInfo> lineInfos;
+        // Add the adjusted lines
+        {
+            lineInfos.setCount(srcSourceInfo.m_numAdjustedLineInfos);
+            const Ser::DebugAdjustedLineInfo* srcAdjustedLineInfos = m_debugData.m_debugAdjustedLineInfos.getBuffer() + srcSourceInfo.m_adjustedLineInfosStartIndex;
+            const int numAdjustedLines = int(srcSourceInfo.m_numAdjustedLineInfos);
+            for (int j = 0; j < numAdjustedLines; ++j)
+            {
+                lineInfos[j] = srcAdjustedLineInfos[j].m_lineInfo;
+            }
+        }
+        // Add regular lines
+        lineInfos.addRange(m_debugData.m_debugLineInfos.getBuffer() + srcSourceInfo.m_lineInfosStartIndex, srcSourceInfo.m_numLineInfos);
+        // Put in sourceloc order
+        lineInfos.sort();
+
+        List<uint32_t> lineBreakOffsets;
+
+        // We can now set up the line breaks array
+        const int numLines = int(srcSourceInfo.m_numLines);
+        lineBreakOffsets.setCount(numLines);
+
+        {
+            const Index numLineInfos = lineInfos.getCount();
+            Index lineIndex = 0;
+            
+            // Every line up and including should hold the same offset
+            for (Index lineInfoIndex = 0; lineInfoIndex < numLineInfos; ++lineInfoIndex)
+            {
+                const auto& lineInfo = lineInfos[lineInfoIndex];
+
+                const uint32_t offset = lineInfo.m_lineStartOffset;
+                SLANG_ASSERT(offset > 0);
+                const int finishIndex = int(lineInfo.m_lineIndex);
+
+                SLANG_ASSERT(finishIndex < numLines);
+
+                for (; lineIndex < finishIndex; ++lineIndex)
+                {
+                    lineBreakOffsets[lineIndex] = offset - 1;
+                }
+                lineBreakOffsets[lineIndex] = offset;
+                lineIndex++;
+            }
+
+            // Do the remaining lines
+            const uint32_t offset = uint32_t(srcSourceInfo.m_endSourceLoc - srcSourceInfo.m_startSourceLoc);
+            for (; lineIndex < numLines; ++lineIndex)
+            {
+                lineBreakOffsets[lineIndex] = offset;
+            }
+        }
+
+        sourceFile->setLineBreakOffsets(lineBreakOffsets.getBuffer(), lineBreakOffsets.getCount());
+
+        if (srcSourceInfo.m_numAdjustedLineInfos)
+        {
+            List<Ser::DebugAdjustedLineInfo> adjustedLineInfos;
+
+            int numEntries = int(srcSourceInfo.m_numAdjustedLineInfos);
+
+            adjustedLineInfos.addRange(m_debugData.m_debugAdjustedLineInfos.getBuffer() + srcSourceInfo.m_adjustedLineInfosStartIndex, numEntries);
+            adjustedLineInfos.sort();
+
+            // Work out the views adjustments, and place in dstEntries
+            List<SourceView::Entry> dstEntries;
+            dstEntries.setCount(numEntries);
+
+            const uint32_t sourceLocOffset = uint32_t(sourceView->getRange().begin.getRaw());
+
+            for (int j = 0; j < numEntries; ++j)
+            {
+                const auto& srcEntry = adjustedLineInfos[j];
+                auto& dstEntry = dstEntries[j];
+
+                dstEntry.m_pathHandle = stringMap[int(srcEntry.m_pathStringIndex)];
+                dstEntry.m_startLoc = SourceLoc::fromRaw(srcEntry.m_lineInfo.m_lineStartOffset + sourceLocOffset);
+                dstEntry.m_lineAdjust = int32_t(srcEntry.m_adjustedLineIndex) - int32_t(srcEntry.m_lineInfo.m_lineIndex);
+            }
+
+            // Set the adjustments on the view
+            sourceView->setEntries(dstEntries.getBuffer(), dstEntries.getCount());
+        }
+    }
+}
+
+// Create an instruction (other than the module instruction) from its serialized form, without
+// setting its type, operands or parent
+static IRInst* _createInst(IRModule* module, StringRepresentationCache& stringCache, const IRSerialData::Inst& srcInst, bool withSourceLoc)
+{
+    typedef IRSerialData Ser;
+    typedef Ser::Inst::PayloadType PayloadType;
+    typedef StringRepresentationCache::Handle StringHandle;
+
+    const IROp op((IROp)srcInst.m_op);
+
+    if (isConstant(op))
+    {
+        // Handling of constants
+
+        // Calculate the minimum object size (ie not including the payload of value)    
+        const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
+
+        IRConstant* irConst = nullptr;
+        switch (op)
+        {                    
+            case kIROp_BoolLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue), withSourceLoc));
+                irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
+                break;
+            }
+            case kIROp_IntLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue), withSourceLoc));
+                irConst->value.intVal = srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_PtrLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*), withSourceLoc));
+                irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
+                break;
+            }
+            case kIROp_FloatLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRFloatingPointValue), withSourceLoc));
+                irConst->value.floatVal = srcInst.m_payload.m_float64;
+                break;
+            }
+            case kIROp_StringLit:
+            {
+                SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
+
+                const UnownedStringSlice slice = stringCache.getStringSlice(StringHandle(srcInst.m_payload.m_stringIndices[0]));
+                    
+                const size_t sliceSize = slice.size();
+                const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
+
+                irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize, withSourceLoc));
+
+                IRConstant::StringValue& dstString = irConst->value.stringVal;
+
+                dstString.numChars = uint32_t(sliceSize);
+                // Turn into pointer to avoid warning of array overrun
+                char* dstChars = dstString.chars;
+                // Copy the chars
+                memcpy(dstChars, slice.begin(), sliceSize);
+                break;
+            }
+            default:
+            {
+                SLANG_ASSERT(!"Unknown constant type");
+                return nullptr;
+            }
+        }
+
+        return irConst;
+    }
+    else if (isTextureTypeBase(op))
+    {
+        IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1, withSourceLoc));
+        SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
+
+        // Reintroduce the texture type bits into the the
+        const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
+        inst->op = IROp(uint32_t(inst->op) | (other << kIROpMeta_OtherShift));
+
+        return inst;
+    }
+    else
+    {
+        int numOperands = srcInst.getNumOperands();
+        return createEmptyInst(module, op, numOperands, withSourceLoc);
+    }
 }
 
 /* static */Result IRSerialReader::read(const IRSerialData& data, Session* session, SourceManager* sourceManager, RefPtr<IRModule>& moduleOut)
@@ -1600,7 +2735,45 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
 
     const Index numInsts = data.m_insts.getCount();
 
-    SLANG_ASSERT(numInsts > 0);
+    SLANG_ASSERT(numInsts > 0);
+
+    // Instructions only have space for a source location if they are created with it, so work out
+    // which instructions will be given a location (either raw, or from the debug information below).
+    List<bool> instHasSourceLoc;
+    instHasSourceLoc.setCount(numInsts);
+    for (Index i = 0; i < numInsts; ++i)
+    {
+        instHasSourceLoc[i] = false;
+    }
+    if (data.m_rawSourceLocs.getCount() == numInsts)
+    {
+        for (Index i = 0; i < numInsts; ++i)
+        {
+            instHasSourceLoc[i] = data.m_rawSourceLocs[i] != Ser::RawSourceLoc(0);
+        }
+    }
+
+    // The debug information (if used) is only decoded as far as is needed to give the instructions locations
+    RefPtr<IRSerialDeferredSourceViews> deferredSourceViews;
+    if (sourceManager && (data.m_debugSourceInfos.getCount() || data.m_encodedDebugChunks.getCount()))
+    {
+        deferredSourceViews = new IRSerialDeferredSourceViews;
+        SLANG_RETURN_ON_FAIL(deferredSourceViews->init(data));
+        if (!deferredSourceViews->hasSourceLocs())
+        {
+            deferredSourceViews.setNull();
+        }
+    }
+    if (deferredSourceViews)
+    {
+        for (const auto& run : deferredSourceViews->getSourceLocRuns())
+        {
+            for (Index j = 0; j < Index(run.m_numInst) && Index(uint32_t(run.m_startInstIndex)) + j < numInsts; ++j)
+            {
+                instHasSourceLoc[Index(uint32_t(run.m_startInstIndex)) + j] = true;
+            }
+        }
+    }
 
     insts.setCount(numInsts);
     insts[0] = nullptr;
@@ -1614,7 +2787,7 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
         SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Empty);
 
         // Create the module inst
-        auto moduleInst = static_cast<IRModuleInst*>(createEmptyInstWithSize(module, kIROp_Module, sizeof(IRModuleInst)));
+        auto moduleInst = static_cast<IRModuleInst*>(createEmptyInstWithSize(module, kIROp_Module, sizeof(IRModuleInst), instHasSourceLoc[1]));
         module->moduleInst = moduleInst;
         moduleInst->module = module;
 
@@ -1624,92 +2797,10 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
 
     for (Index i = 2; i < numInsts; ++i)
     {
-        const Ser::Inst& srcInst = data.m_insts[i];
-
-        const IROp op((IROp)srcInst.m_op);
-
-        if (isConstant(op))
-        {
-            // Handling of constants
-
-            // Calculate the minimum object size (ie not including the payload of value)    
-            const size_t prefixSize = SLANG_OFFSET_OF(IRConstant, value);
-
-            IRConstant* irConst = nullptr;
-            switch (op)
-            {                    
-                case kIROp_BoolLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::UInt32);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_uint32 != 0;
-                    break;
-                }
-                case kIROp_IntLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(IRIntegerValue)));
-                    irConst->value.intVal = srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_PtrLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Int64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, prefixSize + sizeof(void*)));
-                    irConst->value.ptrVal = (void*) (intptr_t) srcInst.m_payload.m_int64; 
-                    break;
-                }
-                case kIROp_FloatLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::Float64);
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op,  prefixSize + sizeof(IRFloatingPointValue)));
-                    irConst->value.floatVal = srcInst.m_payload.m_float64;
-                    break;
-                }
-                case kIROp_StringLit:
-                {
-                    SLANG_ASSERT(srcInst.m_payloadType == PayloadType::String_1);
-
-                    const UnownedStringSlice slice = m_stringRepresentationCache.getStringSlice(StringHandle(srcInst.m_payload.m_stringIndices[0]));
-                        
-                    const size_t sliceSize = slice.size();
-                    const size_t instSize = prefixSize + SLANG_OFFSET_OF(IRConstant::StringValue, chars) + sliceSize;
-
-                    irConst = static_cast<IRConstant*>(createEmptyInstWithSize(module, op, instSize));
-
-                    IRConstant::StringValue& dstString = irConst->value.stringVal;
-
-                    dstString.numChars = uint32_t(sliceSize);
-                    // Turn into pointer to avoid warning of array overrun
-                    char* dstChars = dstString.chars;
-                    // Copy the chars
-                    memcpy(dstChars, slice.begin(), sliceSize);
-                    break;
-                }
-                default:
-                {
-                    SLANG_ASSERT(!"Unknown constant type");
-                    return SLANG_FAIL;
-                }
-            }
-
-            insts[i] = irConst;
-        }
-        else if (isTextureTypeBase(op))
-        {
-            IRTextureTypeBase* inst = static_cast<IRTextureTypeBase*>(createEmptyInst(module, op, 1));
-            SLANG_ASSERT(srcInst.m_payloadType == PayloadType::OperandAndUInt32);
-
-            // Reintroduce the texture type bits into the the
-            const uint32_t other = srcInst.m_payload.m_operandAndUInt32.m_uint32;
-            inst->op = IROp(uint32_t(inst->op) | (other << kIROpMeta_OtherShift));
-
-            insts[i] = inst;
-        }
-        else
+        insts[i] = _createInst(module, m_stringRepresentationCache, data.m_insts[i], instHasSourceLoc[i]);
+        if (!insts[i])
         {
-            int numOperands = srcInst.getNumOperands();
-            insts[i] = createEmptyInst(module, op, numOperands);
+            return SLANG_FAIL;
         }
     }
 
@@ -1770,171 +2861,342 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
         {
             IRInst* dstInst = insts[i];
             
-            dstInst->sourceLoc.setRaw(Slang::SourceLoc::RawValue(srcLocs[i]));
+            dstInst->setSourceLoc(SourceLoc::fromRaw(Slang::SourceLoc::RawValue(srcLocs[i])));
         }
     }
 
-    if (sourceManager && m_serialData->m_debugSourceInfos.getCount())
+    if (deferredSourceViews)
     {
-        List<UnownedStringSlice> debugStringSlices;
-        SerialStringTableUtil::decodeStringTable(m_serialData->m_debugStringTable, debugStringSlices);
+        deferredSourceViews->allocateSourceLocs(sourceManager);
+        deferredSourceViews->setSourceLocs(insts);
+    }
 
-        // All of the strings are placed in the manager (and its StringSlicePool) where the SourceView and SourceFile are constructed from
-        List<StringSlicePool::Handle> stringMap;
-        SerialStringTableUtil::calcStringSlicePoolMap(debugStringSlices, sourceManager->getStringSlicePool(), stringMap);
+    return SLANG_OK;
+}
 
-        const List<IRSerialData::DebugSourceInfo>& sourceInfos = m_serialData->m_debugSourceInfos;
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialLazyReader !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 
-        // Construct the source files
-        Index numSourceFiles = sourceInfos.getCount();
+Result IRSerialLazyReader::init(const IRSerialData& data, Session* session, RefPtr<IRModule>& moduleOut)
+{
+    m_serialData = &data;
 
-        // These hold the views (and SourceFile as there is only one SourceFile per view) in the same order as the sourceInfos
-        List<SourceView*> sourceViews;
-        sourceViews.setCount(numSourceFiles);
+    auto module = new IRModule();
+    moduleOut = module;
+    m_module = module;
+    module->session = session;
 
-        for (Index i = 0; i < numSourceFiles; ++i)
-        {
-            const IRSerialData::DebugSourceInfo& srcSourceInfo = sourceInfos[i];
+    m_stringRepresentationCache.init(&data.m_stringTable, session->getNamePool(), module->getObjectScopeManager());
 
-            PathInfo pathInfo;
-            pathInfo.type = PathInfo::Type::FoundPath;
-            pathInfo.foundPath = debugStringSlices[UInt(srcSourceInfo.m_pathIndex)];
+    const Index numInsts = data.m_insts.getCount();
+    if (numInsts < 2 || data.m_insts[1].m_op != kIROp_Module)
+    {
+        return SLANG_FAIL;
+    }
 
-            SourceFile* sourceFile = sourceManager->createSourceFileWithSize(pathInfo, srcSourceInfo.m_endSourceLoc - srcSourceInfo.m_startSourceLoc);
-            SourceView* sourceView = sourceManager->createSourceView(sourceFile, nullptr);
+    m_insts.setCount(numInsts);
+    m_parentIndices.setCount(numInsts);
+    for (Index i = 0; i < numInsts; ++i)
+    {
+        m_insts[i] = nullptr;
+        m_parentIndices[i] = Ser::InstIndex(0);
+    }
 
-            // We need to accumulate all line numbers, for this source file, both adjusted and unadjusted
-            List<IRSerialData::DebugLineInfo> lineInfos;
-            // Add the adjusted lines
-            {
-                lineInfos.setCount(srcSourceInfo.m_numAdjustedLineInfos);
-                const IRSerialData::DebugAdjustedLineInfo* srcAdjustedLineInfos = m_serialData->m_debugAdjustedLineInfos.getBuffer() + srcSourceInfo.m_adjustedLineInfosStartIndex;
-                const int numAdjustedLines = int(srcSourceInfo.m_numAdjustedLineInfos);
-                for (int j = 0; j < numAdjustedLines; ++j)
-                {
-                    lineInfos[j] = srcAdjustedLineInfos[j].m_lineInfo;
-                }
-            }
-            // Add regular lines
-            lineInfos.addRange(m_serialData->m_debugLineInfos.getBuffer() + srcSourceInfo.m_lineInfosStartIndex, srcSourceInfo.m_numLineInfos);
-            // Put in sourceloc order
-            lineInfos.sort();
+    // The parent of every instruction is needed to find the global value an operand belongs to,
+    // and the child runs of every instruction to create a global value.
+    const Index numChildRuns = data.m_childRuns.getCount();
+    m_firstChildRuns.setCount(numInsts);
+    m_nextChildRuns.setCount(numChildRuns);
+    for (Index i = 0; i < numInsts; ++i)
+    {
+        m_firstChildRuns[i] = -1;
+    }
+    // Build the per parent lists backwards, so each one is in the order of the runs
+    for (Index i = numChildRuns - 1; i >= 0; --i)
+    {
+        const auto& run = data.m_childRuns[i];
+        const Index parentIndex = Index(run.m_parentIndex);
 
-            List<uint32_t> lineBreakOffsets;
+        m_nextChildRuns[i] = m_firstChildRuns[parentIndex];
+        m_firstChildRuns[parentIndex] = i;
 
-            // We can now set up the line breaks array
-            const int numLines = int(srcSourceInfo.m_numLines);
-            lineBreakOffsets.setCount(numLines);
+        for (Index j = 0; j < Index(run.m_numChildren); ++j)
+        {
+            m_parentIndices[Index(run.m_startInstIndex) + j] = run.m_parentIndex;
+        }
+    }
 
-            {
-                const Index numLineInfos = lineInfos.getCount();
-                Index lineIndex = 0;
-                
-                // Every line up and including should hold the same offset
-                for (Index lineInfoIndex = 0; lineInfoIndex < numLineInfos; ++lineInfoIndex)
-                {
-                    const auto& lineInfo = lineInfos[lineInfoIndex];
+    const bool hasRawSourceLocs = data.m_rawSourceLocs.getCount() == numInsts;
+    const bool withSourceLoc = hasRawSourceLocs && data.m_rawSourceLocs[1] != Ser::RawSourceLoc(0);
 
-                    const uint32_t offset = lineInfo.m_lineStartOffset;
-                    SLANG_ASSERT(offset > 0);
-                    const int finishIndex = int(lineInfo.m_lineIndex);
+    auto moduleInst = static_cast<IRModuleInst*>(createEmptyInstWithSize(module, kIROp_Module, sizeof(IRModuleInst), withSourceLoc));
+    module->moduleInst = moduleInst;
+    moduleInst->module = module;
+    if (withSourceLoc)
+    {
+        moduleInst->setSourceLoc(SourceLoc::fromRaw(SourceLoc::RawValue(data.m_rawSourceLocs[1])));
+    }
 
-                    SLANG_ASSERT(finishIndex < numLines);
+    m_insts[1] = moduleInst;
+    m_materializedInstCount = 1;
+    return SLANG_OK;
+}
 
-                    for (; lineIndex < finishIndex; ++lineIndex)
-                    {
-                        lineBreakOffsets[lineIndex] = offset - 1;
-                    }
-                    lineBreakOffsets[lineIndex] = offset;
-                    lineIndex++;
-                }
+Result IRSerialLazyReader::init(Stream* stream, Session* session, RefPtr<IRModule>& moduleOut)
+{
+    SLANG_RETURN_ON_FAIL(IRSerialReader::readStream(stream, &m_ownedSerialData));
+    return init(m_ownedSerialData, session, moduleOut);
+}
 
-                // Do the remaining lines
-                const uint32_t offset = uint32_t(srcSourceInfo.m_endSourceLoc - srcSourceInfo.m_startSourceLoc);
-                for (; lineIndex < numLines; ++lineIndex)
-                {
-                    lineBreakOffsets[lineIndex] = offset;
-                }
-            }
+IRSerialData::InstIndex IRSerialLazyReader::_findGlobalAncestor(Ser::InstIndex instIndex) const
+{
+    const Ser::InstIndex moduleIndex = Ser::InstIndex(1);
+    while (_getParentIndex(instIndex) != moduleIndex)
+    {
+        instIndex = _getParentIndex(instIndex);
+        // An instruction that isn't in the module can't be materialized
+        SLANG_ASSERT(instIndex != Ser::InstIndex(0));
+    }
+    return instIndex;
+}
 
-            sourceFile->setLineBreakOffsets(lineBreakOffsets.getBuffer(), lineBreakOffsets.getCount());
+void IRSerialLazyReader::_createGlobalValue(Ser::InstIndex globalIndex)
+{
+    const IRSerialData& data = *m_serialData;
+    const bool hasRawSourceLocs = data.m_rawSourceLocs.getCount() == data.m_insts.getCount();
+
+    // Create the global value and all of its descendents. Their types and operands may
+    // reference instructions in other global values, so are set later from m_pendingIndices.
+    List<Index> stack;
+    stack.add(Index(globalIndex));
+    while (stack.getCount())
+    {
+        const Index instIndex = stack.getLast();
+        stack.removeLast();
+
+        const bool withSourceLoc = hasRawSourceLocs && data.m_rawSourceLocs[instIndex] != Ser::RawSourceLoc(0);
+        IRInst* inst = _createInst(m_module, m_stringRepresentationCache, data.m_insts[instIndex], withSourceLoc);
+        SLANG_ASSERT(inst);
+        if (withSourceLoc)
+        {
+            inst->setSourceLoc(SourceLoc::fromRaw(SourceLoc::RawValue(data.m_rawSourceLocs[instIndex])));
+        }
+
+        m_insts[instIndex] = inst;
+        m_pendingIndices.add(Ser::InstIndex(instIndex));
+        m_materializedInstCount++;
 
-            if (srcSourceInfo.m_numAdjustedLineInfos)
+        // The parent is always created before its children, so can be added to now
+        IRInst* parent = m_insts[Index(m_parentIndices[instIndex])];
+        inst->insertAtEnd(parent);
+
+        // Push the children in reverse, so they are created (and so added to the parent) in order
+        List<Index> childIndices;
+        for (Index runIndex = m_firstChildRuns[instIndex]; runIndex >= 0; runIndex = m_nextChildRuns[runIndex])
+        {
+            const auto& run = data.m_childRuns[runIndex];
+            for (Index j = 0; j < Index(run.m_numChildren); ++j)
             {
-                List<IRSerialData::DebugAdjustedLineInfo> adjustedLineInfos;
+                childIndices.add(Index(run.m_startInstIndex) + j);
+            }
+        }
+        for (Index j = childIndices.getCount() - 1; j >= 0; --j)
+        {
+            stack.add(childIndices[j]);
+        }
+    }
+}
 
-                int numEntries = int(srcSourceInfo.m_numAdjustedLineInfos);
+IRInst* IRSerialLazyReader::_getInst(Ser::InstIndex instIndex)
+{
+    if (instIndex == Ser::InstIndex(0))
+    {
+        return nullptr;
+    }
+    IRInst* inst = m_insts[Index(instIndex)];
+    if (!inst)
+    {
+        _createGlobalValue(_findGlobalAncestor(instIndex));
+        inst = m_insts[Index(instIndex)];
+    }
+    return inst;
+}
 
-                adjustedLineInfos.addRange(m_serialData->m_debugAdjustedLineInfos.getBuffer() + srcSourceInfo.m_adjustedLineInfosStartIndex, numEntries);
-                adjustedLineInfos.sort();
+IRInst* IRSerialLazyReader::materializeGlobalValue(Ser::InstIndex instIndex)
+{
+    IRInst* inst = _getInst(instIndex);
 
-                // Work out the views adjustments, and place in dstEntries
-                List<SourceView::Entry> dstEntries;
-                dstEntries.setCount(numEntries);
+    // Setting the types and operands of new instructions can create more global
+    // values, so keep going until there is nothing left to patch up
+    while (m_pendingIndices.getCount())
+    {
+        const Index pendingIndex = Index(m_pendingIndices.getLast());
+        m_pendingIndices.removeLast();
 
-                const uint32_t sourceLocOffset = uint32_t(sourceView->getRange().begin.getRaw());
+        const Ser::Inst& srcInst = m_serialData->m_insts[pendingIndex];
+        IRInst* dstInst = m_insts[pendingIndex];
 
-                for (int j = 0; j < numEntries; ++j)
-                {
-                    const auto& srcEntry = adjustedLineInfos[j];
-                    auto& dstEntry = dstEntries[j];
+        if (srcInst.m_resultTypeIndex != Ser::InstIndex(0))
+        {
+            dstInst->setFullType(static_cast<IRType*>(_getInst(srcInst.m_resultTypeIndex)));
+        }
 
-                    dstEntry.m_pathHandle = stringMap[int(srcEntry.m_pathStringIndex)];
-                    dstEntry.m_startLoc = SourceLoc::fromRaw(srcEntry.m_lineInfo.m_lineStartOffset + sourceLocOffset);
-                    dstEntry.m_lineAdjust = int32_t(srcEntry.m_adjustedLineIndex) - int32_t(srcEntry.m_lineInfo.m_lineIndex);
-                }
+        const Ser::InstIndex* srcOperandIndices;
+        const int numOperands = m_serialData->getOperands(srcInst, &srcOperandIndices);
+        for (int j = 0; j < numOperands; j++)
+        {
+            dstInst->setOperand(j, _getInst(srcOperandIndices[j]));
+        }
+    }
 
-                // Set the adjustments on the view
-                sourceView->setEntries(dstEntries.getBuffer(), dstEntries.getCount());
-            }
+    return inst;
+}
+
+const List<IRSerialData::Symbol>& IRSerialLazyReader::_getSymbols()
+{
+    if (m_serialData->m_symbols.getCount() || m_hasBuiltSymbols)
+    {
+        return m_serialData->m_symbols.getCount() ? m_serialData->m_symbols : m_builtSymbols;
+    }
+
+    // Older data has no symbol table, so build one from the linkage decorations. Only the
+    // name and global value of each symbol are used for lookup.
+    const List<Ser::Inst>& insts = m_serialData->m_insts;
+    const Index numInsts = insts.getCount();
+    for (Index i = 2; i < numInsts; ++i)
+    {
+        const Ser::Inst& srcInst = insts[i];
+        const IROp op = IROp(srcInst.m_op);
+        if (op != kIROp_ImportDecoration && op != kIROp_ExportDecoration)
+        {
+            continue;
+        }
 
-            sourceViews[i] = sourceView;
+        const Ser::InstIndex* srcOperandIndices;
+        if (m_serialData->getOperands(srcInst, &srcOperandIndices) < 1)
+        {
+            continue;
+        }
+        const Ser::Inst& nameInst = insts[Index(srcOperandIndices[0])];
+        if (IROp(nameInst.m_op) != kIROp_StringLit)
+        {
+            continue;
         }
 
-        // We now need to apply the runs
+        Ser::Symbol symbol;
+        symbol.m_mangledNameIndex = nameInst.m_payload.m_stringIndices[0];
+        symbol.m_instIndex = m_parentIndices[i];
+        symbol.m_startDescendantIndex = Ser::InstIndex(0);
+        symbol.m_numDescendants = 0;
+        m_builtSymbols.add(symbol);
+    }
+
+    // In the same order as a symbol table
+    StringRepresentationCache& stringCache = m_stringRepresentationCache;
+    m_builtSymbols.sort([&](const Ser::Symbol& a, const Ser::Symbol& b) -> bool
+    {
+        const int cmp = _compareStringSlices(
+            stringCache.getStringSlice(StringHandle(a.m_mangledNameIndex)),
+            stringCache.getStringSlice(StringHandle(b.m_mangledNameIndex)));
+        return (cmp != 0) ? (cmp < 0) : (a.m_instIndex < b.m_instIndex);
+    });
+
+    m_hasBuiltSymbols = true;
+    return m_builtSymbols;
+}
+
+Index IRSerialLazyReader::_findFirstSymbol(const UnownedStringSlice& mangledName)
+{
+    const List<Ser::Symbol>& symbols = _getSymbols();
+
+    // The symbols are sorted by mangled name, so find the first that isn't before it
+    Index lo = 0;
+    Index hi = symbols.getCount();
+    while (lo < hi)
+    {
+        const Index mid = (lo + hi) >> 1;
+        if (_compareStringSlices(m_stringRepresentationCache.getStringSlice(StringHandle(symbols[mid].m_mangledNameIndex)), mangledName) < 0)
+        {
+            lo = mid + 1;
+        }
+        else
         {
-            List<IRSerialData::SourceLocRun> sourceRuns(m_serialData->m_debugSourceLocRuns);
-            // They are now in source location order
-            sourceRuns.sort();
+            hi = mid;
+        }
+    }
+
+    if (lo < symbols.getCount() && m_stringRepresentationCache.getStringSlice(StringHandle(symbols[lo].m_mangledNameIndex)) == mangledName)
+    {
+        return lo;
+    }
+    return -1;
+}
 
-            // Just guess initially 0 for the source file that contains the initial run
-            SourceRange range;
-            int fixSourceLoc = _calcFixSourceLoc(sourceInfos[0], sourceViews[0], range);
+bool IRSerialLazyReader::hasGlobalValue(const UnownedStringSlice& mangledName)
+{
+    return _findFirstSymbol(mangledName) >= 0;
+}
 
-            const Index numRuns = sourceRuns.getCount();
-            for (Index i = 0; i < numRuns; ++i)
-            {
-                const auto& run = sourceRuns[i];
-                const SourceLoc srcSourceLoc = SourceLoc::fromRaw(run.m_sourceLoc);
+void IRSerialLazyReader::findGlobalValues(const UnownedStringSlice& mangledName, List<IRInst*>& outValues)
+{
+    outValues.clear();
 
-                if (!range.contains(srcSourceLoc))
-                {
-                    int index = _findIndex(sourceInfos, srcSourceLoc);
-                    if (index < 0)
-                    {
-                        // Didn't find the match
-                        continue;
-                    }
-                    fixSourceLoc = _calcFixSourceLoc(sourceInfos[index], sourceViews[index], range);
-                    SLANG_ASSERT(range.contains(srcSourceLoc));
-                }
+    Index symbolIndex = _findFirstSymbol(mangledName);
+    if (symbolIndex < 0)
+    {
+        return;
+    }
 
-                // Work out the fixed source location
-                SourceLoc sourceLoc = SourceLoc::fromRaw(int(run.m_sourceLoc) + fixSourceLoc); 
+    const List<Ser::Symbol>& symbols = _getSymbols();
+    for (; symbolIndex < symbols.getCount(); ++symbolIndex)
+    {
+        const Ser::Symbol& symbol = symbols[symbolIndex];
+        if (m_stringRepresentationCache.getStringSlice(StringHandle(symbol.m_mangledNameIndex)) != mangledName)
+        {
+            break;
+        }
+        outValues.add(materializeGlobalValue(symbol.m_instIndex));
+    }
+}
 
-                SLANG_ASSERT(Index(uint32_t(run.m_startInstIndex) + run.m_numInst) <= insts.getCount());
-                IRInst** dstInsts = insts.getBuffer() + int(run.m_startInstIndex);
+void IRSerialLazyReader::findFirstGlobalValuesWithOp(IROp op, List<IRInst*>& outValues)
+{
+    outValues.clear();
 
-                const int runSize = int(run.m_numInst);
-                for (int j = 0; j < runSize; ++j)
-                {
-                    dstInsts[j]->sourceLoc = sourceLoc;
-                }
-            }
+    // Find the global values by index first, so they are in module order
+    List<Ser::InstIndex> instIndices;
+    const List<Ser::Symbol>& symbols = _getSymbols();
+    for (Index i = 0; i < symbols.getCount(); ++i)
+    {
+        const Ser::Symbol& symbol = symbols[i];
+        if (i > 0 &&
+            m_stringRepresentationCache.getStringSlice(StringHandle(symbol.m_mangledNameIndex)) ==
+            m_stringRepresentationCache.getStringSlice(StringHandle(symbols[i - 1].m_mangledNameIndex)))
+        {
+            continue;
+        }
+        if (IROp(m_serialData->m_insts[Index(symbol.m_instIndex)].m_op) == op)
+        {
+            instIndices.add(symbol.m_instIndex);
         }
     }
+    instIndices.sort();
 
-    return SLANG_OK;
+    for (auto instIndex : instIndices)
+    {
+        outValues.add(materializeGlobalValue(instIndex));
+    }
+}
+
+void IRSerialLazyReader::materializeAll()
+{
+    const Index numInsts = m_insts.getCount();
+    for (Index i = 2; i < numInsts; ++i)
+    {
+        if (m_parentIndices[i] == Ser::InstIndex(1))
+        {
+            materializeGlobalValue(Ser::InstIndex(i));
+        }
+    }
 }
 
 // !!!!!!!!!!!!!!!!!!!!!!!!!!!! IRSerialUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
@@ -1970,6 +3232,36 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
     }
 }
 
+/* static */SlangResult IRSerialUtil::parseStreamOptions(const UnownedStringSlice& name, IRSerialWriter::StreamOptions& optionsOut)
+{
+    typedef IRSerialBinary Bin;
+
+    IRSerialWriter::StreamOptions options;
+    if (name == "none")
+    {
+        options.m_instCompressionType = Bin::CompressionType::None;
+    }
+    else if (name == "lite" || name == "lite-delta")
+    {
+        options.m_instCompressionType = Bin::CompressionType::VariableByteLite;
+        options.m_sourceLocCompressionType = Bin::CompressionType::VariableByteLite;
+        options.m_deltaEncodeInstIndices = (name == "lite-delta");
+    }
+    else if (name == "lz4" || name == "lz4-delta")
+    {
+        options.m_instCompressionType = Bin::CompressionType::LZ4;
+        options.m_stringCompressionType = Bin::CompressionType::LZ4;
+        options.m_sourceLocCompressionType = Bin::CompressionType::LZ4;
+        options.m_deltaEncodeInstIndices = (name == "lz4-delta");
+    }
+    else
+    {
+        return SLANG_FAIL;
+    }
+    optionsOut = options;
+    return SLANG_OK;
+}
+
 /* static */SlangResult IRSerialUtil::verifySerialize(IRModule* module, Session* session, SourceManager* sourceManager, IRSerialBinary::CompressionType compressionType, IRSerialWriter::OptionFlags optionFlags)
 {
     // Verify if we can stream out with debug information
@@ -1995,13 +3287,76 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
 
     SLANG_RETURN_ON_FAIL(IRSerialReader::readStream(&memoryStream, &readData));
 
-    // Check the stream read data is the same
-    if (readData != serialData)
+    // The debug chunks are left encoded by readStream, so decode a copy to check the stream read data is the same
+    // (readData is left encoded, so reading the module from it decodes the debug information lazily)
+    IRSerialData decodedReadData(readData);
+    SLANG_RETURN_ON_FAIL(IRSerialReader::decodeDebugChunks(&decodedReadData));
+    if (decodedReadData != serialData)
     {
         SLANG_ASSERT(!"Streamed in data doesn't match");
         return SLANG_FAIL;
     }
 
+    // Every chunk compressed with LZ4, and delta encoded inst indices, should round trip too
+    {
+        IRSerialWriter::StreamOptions streamOptions;
+        SLANG_RETURN_ON_FAIL(parseStreamOptions(UnownedStringSlice::fromLiteral("lz4-delta"), streamOptions));
+
+        MemoryStream lz4Stream(FileAccess::ReadWrite);
+        SLANG_RETURN_ON_FAIL(IRSerialWriter::writeStream(serialData, streamOptions, &lz4Stream));
+        lz4Stream.Seek(SeekOrigin::Start, 0);
+
+        IRSerialData lz4ReadData;
+        SLANG_RETURN_ON_FAIL(IRSerialReader::readStream(&lz4Stream, &lz4ReadData));
+        SLANG_RETURN_ON_FAIL(IRSerialReader::decodeDebugChunks(&lz4ReadData));
+        if (lz4ReadData != serialData)
+        {
+            SLANG_ASSERT(!"LZ4 streamed in data doesn't match");
+            return SLANG_FAIL;
+        }
+    }
+
+    // Encoding and decoding on a thread pool should produce the same stream, and the same data
+    {
+        ThreadPool threadPool(2);
+
+        IRSerialWriter::StreamOptions streamOptions;
+        streamOptions.m_instCompressionType = compressionType;
+
+        MemoryStream poolStream(FileAccess::ReadWrite);
+        SLANG_RETURN_ON_FAIL(IRSerialWriter::writeStream(serialData, streamOptions, &poolStream, &threadPool));
+        if (!_isEqual(poolStream.m_contents, memoryStream.m_contents))
+        {
+            SLANG_ASSERT(!"Stream written on thread pool doesn't match");
+            return SLANG_FAIL;
+        }
+        poolStream.Seek(SeekOrigin::Start, 0);
+
+        IRSerialData poolReadData;
+        SLANG_RETURN_ON_FAIL(IRSerialReader::readStream(&poolStream, &poolReadData, &threadPool));
+        SLANG_RETURN_ON_FAIL(IRSerialReader::decodeDebugChunks(&poolReadData));
+        if (poolReadData != serialData)
+        {
+            SLANG_ASSERT(!"Thread pool streamed in data doesn't match");
+            return SLANG_FAIL;
+        }
+    }
+
+    // Writing the module directly to a stream should produce the same stream
+    {
+        IRSerialWriter::StreamOptions streamOptions;
+        streamOptions.m_instCompressionType = compressionType;
+
+        MemoryStream directStream(FileAccess::ReadWrite);
+        IRSerialWriter writer;
+        SLANG_RETURN_ON_FAIL(writer.writeStream(module, sourceManager, optionFlags, streamOptions, &directStream));
+        if (!_isEqual(directStream.m_contents, memoryStream.m_contents))
+        {
+            SLANG_ASSERT(!"Stream written directly from module doesn't match");
+            return SLANG_FAIL;
+        }
+    }
+
     RefPtr<IRModule> irReadModule;
 
     SourceManager workSourceManager;
@@ -2009,7 +3364,7 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
 
     {
         IRSerialReader reader;
-        SLANG_RETURN_ON_FAIL(reader.read(serialData, session, &workSourceManager, irReadModule));
+        SLANG_RETURN_ON_FAIL(reader.read(readData, session, &workSourceManager, irReadModule));
     }
 
     List<IRInst*> readInsts;
@@ -2021,6 +3376,59 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
         return SLANG_FAIL;
     }
 
+    // Reading lazily and then asking for everything should produce the same instructions
+    {
+        RefPtr<IRModule> irLazyModule;
+        IRSerialLazyReader lazyReader;
+        SLANG_RETURN_ON_FAIL(lazyReader.init(serialData, session, irLazyModule));
+        lazyReader.materializeAll();
+
+        List<IRInst*> lazyInsts;
+        calcInstructionList(irLazyModule, lazyInsts);
+
+        if (lazyInsts.getCount() != originalInsts.getCount() ||
+            lazyReader.getMaterializedInstCount() + 1 != originalInsts.getCount())
+        {
+            SLANG_ASSERT(!"Lazily read instruction counts don't match");
+            return SLANG_FAIL;
+        }
+    }
+
+    // Every symbol should be found through the symbol table, as global values with a linkage decoration of that name
+    if (serialData.m_symbols.getCount())
+    {
+        RefPtr<IRModule> irLazyModule;
+        IRSerialLazyReader lazyReader;
+        SLANG_RETURN_ON_FAIL(lazyReader.init(serialData, session, irLazyModule));
+
+        StringRepresentationCache stringCache;
+        stringCache.init(&serialData.m_stringTable, session->getNamePool(), irLazyModule->getObjectScopeManager());
+
+        for (const auto& symbol : serialData.m_symbols)
+        {
+            const UnownedStringSlice mangledName = stringCache.getStringSlice(StringRepresentationCache::Handle(symbol.m_mangledNameIndex));
+
+            List<IRInst*> values;
+            lazyReader.findGlobalValues(mangledName, values);
+            bool hasName = values.getCount() > 0;
+            for (auto value : values)
+            {
+                bool valueHasName = false;
+                for (auto decoration : value->getDecorations())
+                {
+                    auto linkageDecoration = as<IRLinkageDecoration>(decoration);
+                    valueHasName = valueHasName || (linkageDecoration && linkageDecoration->getMangledName() == mangledName);
+                }
+                hasName = hasName && valueHasName;
+            }
+            if (!hasName)
+            {
+                SLANG_ASSERT(!"Symbol lookup failed");
+                return SLANG_FAIL;
+            }
+        }
+    }
+
     if (optionFlags & IRSerialWriter::OptionFlag::RawSourceLocation)
     {
         SLANG_ASSERT(readInsts[0] == originalInsts[0]);
@@ -2030,7 +3438,7 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
             IRInst* origInst = originalInsts[i];
             IRInst* readInst = readInsts[i];
 
-            if (origInst->sourceLoc.getRaw() != readInst->sourceLoc.getRaw())
+            if (origInst->getSourceLoc().getRaw() != readInst->getSourceLoc().getRaw())
             {
                 SLANG_ASSERT(!"Source locs don't match");
                 return SLANG_FAIL;
@@ -2045,14 +3453,14 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
             IRInst* origInst = originalInsts[i];
             IRInst* readInst = readInsts[i];
 
-            if (origInst->sourceLoc.getRaw() == readInst->sourceLoc.getRaw())
+            if (origInst->getSourceLoc().getRaw() == readInst->getSourceLoc().getRaw())
             {
                 continue;
             }
 
             // Work out the
-            SourceView* origSourceView = sourceManager->findSourceView(origInst->sourceLoc);
-            SourceView* readSourceView = workSourceManager.findSourceView(readInst->sourceLoc);
+            SourceView* origSourceView = sourceManager->findSourceView(origInst->getSourceLoc());
+            SourceView* readSourceView = workSourceManager.findSourceView(readInst->getSourceLoc());
 
             // if both are null we are done
             if (origSourceView == nullptr && origSourceView == readSourceView)
@@ -2062,8 +3470,8 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
             SLANG_ASSERT(origSourceView && readSourceView);
 
             {
-                auto origInfo = origSourceView->getHumaneLoc(origInst->sourceLoc, SourceLocType::Actual);
-                auto readInfo = readSourceView->getHumaneLoc(readInst->sourceLoc, SourceLocType::Actual);
+                auto origInfo = origSourceView->getHumaneLoc(origInst->getSourceLoc(), SourceLocType::Actual);
+                auto readInfo = readSourceView->getHumaneLoc(readInst->getSourceLoc(), SourceLocType::Actual);
 
                 if (!(origInfo.line == readInfo.line && origInfo.column == readInfo.column && origInfo.pathInfo.foundPath == readInfo.pathInfo.foundPath))
                 {
@@ -2077,8 +3485,8 @@ static int _calcFixSourceLoc(const IRSerialData::DebugSourceInfo& info, SourceVi
 
             if (false)
             {
-                auto origInfo = origSourceView->getHumaneLoc(origInst->sourceLoc, SourceLocType::Nominal);
-                auto readInfo = readSourceView->getHumaneLoc(readInst->sourceLoc, SourceLocType::Nominal);
+                auto origInfo = origSourceView->getHumaneLoc(origInst->getSourceLoc(), SourceLocType::Nominal);
+                auto readInfo = readSourceView->getHumaneLoc(readInst->getSourceLoc(), SourceLocType::Nominal);
 
                 if (!(origInfo.line == readInfo.line && origInfo.column == readInfo.column && origInfo.pathInfo.foundPath == readInfo.pathInfo.foundPath))
                 {
@@ -66,6 +66,7 @@ struct SerialStringTableUtil
 
 // Pre-declare
 class Name;
+class ThreadPool;
 
 struct IRSerialData
 {
@@ -113,6 +114,25 @@ struct IRSerialData
         SizeType m_numInst;                 ///< The number of children
     };
 
+        /// A global value that has a mangled name (from a linkage decoration)
+    struct Symbol
+    {
+        typedef Symbol ThisType;
+        bool operator==(const ThisType& rhs) const
+        {
+            return m_mangledNameIndex == rhs.m_mangledNameIndex &&
+                m_instIndex == rhs.m_instIndex &&
+                m_startDescendantIndex == rhs.m_startDescendantIndex &&
+                m_numDescendants == rhs.m_numDescendants;
+        }
+        bool operator!=(const ThisType& rhs) const { return !(*this == rhs); }
+
+        StringIndex m_mangledNameIndex;     ///< The mangled name in the string table
+        InstIndex m_instIndex;              ///< The global value
+        InstIndex m_startDescendantIndex;   ///< The index of the first instruction nested in the global value
+        SizeType m_numDescendants;          ///< All instructions nested in the global value are in a single run of this size
+    };
+
     struct PayloadInfo
     {
         uint8_t m_numOperands;
@@ -278,6 +298,8 @@ struct IRSerialData
 
     List<RawSourceLoc> m_rawSourceLocs;         ///< A source location per instruction (saved without modification from IRInst)s
 
+    List<Symbol> m_symbols;                     ///< Global values with a mangled name, sorted by mangled name (and values with the same name in module order)
+
     // Data only set if we have debug information
 
     List<char> m_debugStringTable;              ///< String table for debug use only
@@ -286,6 +308,12 @@ struct IRSerialData
     List<DebugSourceInfo> m_debugSourceInfos;    ///< Debug source information
     List<SourceLocRun> m_debugSourceLocRuns;    ///< Runs of instructions that use a source loc
 
+    // Debug chunks read from a stream are held as they were in the stream, and only decoded into the debug
+    // data above when it's needed (see IRSerialReader::decodeDebugChunks)
+
+    List<uint8_t> m_encodedDebugChunks;         ///< The debug chunks (each with its Chunk header, and padding)
+    uint32_t m_encodedDebugCompressionType;     ///< The compression type of the SlangHeader the chunks were read with
+
     static const PayloadInfo s_payloadInfos[int(Inst::PayloadType::CountOf)];
 };
 
@@ -352,6 +380,7 @@ SLANG_FORCE_INLINE int IRSerialData::getOperands(const Inst& inst, const InstInd
 #define SLANG_FOUR_CC(c0, c1, c2, c3) ((uint32_t(c0) << 0) | (uint32_t(c1) << 8) | (uint32_t(c2) << 16) | (uint32_t(c3) << 24)) 
 
 #define SLANG_MAKE_COMPRESSED_FOUR_CC(fourCc) (((fourCc) & 0xffff00ff) | (uint32_t('c') << 8))
+#define SLANG_MAKE_LZ4_FOUR_CC(fourCc) (((fourCc) & 0xffff00ff) | (uint32_t('z') << 8))
 
 struct IRSerialBinary
 {
@@ -364,10 +393,22 @@ struct IRSerialBinary
         uint32_t m_size;
     };
 
+        /// The compression used for a chunk is identified by the second character of its four cc
+        /// ('c' for VariableByteLite, 'z' for LZ4), so each chunk can be compressed differently.
     enum class CompressionType
     {
         None,
-        VariableByteLite,
+        VariableByteLite,               ///< Variable byte encoding of uint32 values. Only used on arrays of uint32 sized values.
+        LZ4,                            ///< LZ4 block compression. Decodes quickly, can be used on any chunk.
+    };
+
+    struct SlangHeaderFlag
+    {
+        typedef uint32_t Type;
+        enum Enum : Type
+        {
+            DeltaInstIndices = 0x01,        ///< Inst operands and types are held relative to the instruction (see IRSerialWriter::StreamOptions)
+        };
     };
 
     
@@ -383,6 +424,8 @@ struct IRSerialBinary
     static const uint32_t kCompressedExternalOperandsFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kExternalOperandsFourCc);
 
     static const uint32_t kStringFourCc = SLANG_FOUR_CC('S', 'L', 's', 't');
+    static const uint32_t kSymbolFourCc = SLANG_FOUR_CC('S', 'L', 's', 'y');
+    static const uint32_t kCompressedSymbolFourCc = SLANG_MAKE_COMPRESSED_FOUR_CC(kSymbolFourCc);
 
     static const uint32_t kUInt32SourceLocFourCc = SLANG_FOUR_CC('S', 'r', 's', '4');
 
@@ -395,7 +438,8 @@ struct IRSerialBinary
     struct SlangHeader
     {
         Chunk m_chunk;
-        uint32_t m_compressionType;         ///< Holds the compression type used (if used at all)
+        uint32_t m_compressionType;         ///< Holds the compression type used for chunks with a 'c' four cc
+        uint32_t m_flags;                   ///< SlangHeaderFlags
     };
     struct ArrayHeader
     {
@@ -408,6 +452,12 @@ struct IRSerialBinary
         uint32_t m_numEntries;              ///< The number of entries
         uint32_t m_numCompressedEntries;    ///< The amount of compressed entries
     };
+    struct LZ4ArrayHeader
+    {
+        Chunk m_chunk;
+        uint32_t m_numEntries;              ///< The number of entries
+        uint32_t m_decompressedSize;        ///< The size of the entries in bytes once decompressed
+    };
 };
 
 
@@ -427,10 +477,32 @@ struct IRSerialWriter
     };
     typedef OptionFlag::Type OptionFlags;
 
+        /// How the chunks are compressed by writeStream
+    struct StreamOptions
+    {
+        Bin::CompressionType m_instCompressionType = Bin::CompressionType::VariableByteLite;   ///< Instructions, child runs, external operands, symbols and debug source loc runs
+        Bin::CompressionType m_stringCompressionType = Bin::CompressionType::None;             ///< The string tables
+        Bin::CompressionType m_sourceLocCompressionType = Bin::CompressionType::None;          ///< Raw source locations and debug line information
+            /// Store the type and operands of an instruction relative to the instruction's index. Most operands
+            /// are nearby, so the values are small, which makes VariableByteLite and LZ4 more effective.
+        bool m_deltaEncodeInstIndices = false;
+    };
+
     Result write(IRModule* module, SourceManager* sourceManager, OptionFlags options, IRSerialData* serialData);
   
+        /// Write data to stream. The stream must be seekable, as the size of the data is written once it is known.
+        /// If threadPool is set, chunks (and blocks of large VariableByteLite chunks) are encoded on the pool.
+    static Result writeStream(const IRSerialData& data, const StreamOptions& options, Stream* stream, ThreadPool* threadPool = nullptr);
+        /// Write data to stream, with compressionType used on the instruction chunks
     static Result writeStream(const IRSerialData& data, Bin::CompressionType compressionType, Stream* stream);
 
+        /// Write module directly to stream, without building the instructions or raw source locations of an
+        /// IRSerialData in memory. They are converted, encoded and written a block at a time, and the chunk
+        /// sizes are patched at the end, so the stream must be seekable.
+        /// The output is the same as `write` followed by `writeStream`, except that LZ4 isn't used for those
+        /// chunks (as each is compressed as a single block) - VariableByteLite is used instead.
+    Result writeStream(IRModule* module, SourceManager* sourceManager, OptionFlags optionFlags, const StreamOptions& options, Stream* stream, ThreadPool* threadPool = nullptr);
+
     /// Get an instruction index from an instruction
     Ser::InstIndex getInstIndex(IRInst* inst) const { return inst ? Ser::InstIndex(m_instMap[inst]) : Ser::InstIndex(0); }
 
@@ -481,7 +553,19 @@ protected:
         List<IRSerialData::DebugAdjustedLineInfo> m_adjustedLineInfos;  ///< The adjusted line infos
     };
 
+    struct GlobalValueRun
+    {
+        IRInst* m_inst;
+        Ser::InstIndex m_startDescendantIndex;
+        Ser::SizeType m_numDescendants;
+    };
+
     void _addInstruction(IRInst* inst);
+        /// Add all the instructions in module to m_insts (in serialized order), and set up the child runs
+    void _calcInstList(IRModule* module, List<GlobalValueRun>& globalValueRuns);
+        /// Convert srcInst into its serialized form. Long operand lists are added to the external operands.
+    Result _calcInst(IRInst* srcInst, Ser::Inst& dstInst);
+    void _calcSymbols(const List<GlobalValueRun>& globalValueRuns);
     Result _calcDebugInfo();
         /// Returns the remapped sourceLoc, or 0 if sourceLoc couldn't be added
     void _addDebugSourceLocRun(SourceLoc sourceLoc, uint32_t startInstIndex, uint32_t numInst);
@@ -509,10 +593,18 @@ struct IRSerialReader
     typedef IRSerialData Ser;
     typedef StringRepresentationCache::Handle StringHandle;
 
-        /// Read a stream to fill in dataOut IRSerialData
-    static Result readStream(Stream* stream, IRSerialData* dataOut);
+        /// Read a stream to fill in dataOut IRSerialData.
+        /// If threadPool is set, chunks are copied out of the stream and decoded on the pool.
+    static Result readStream(Stream* stream, IRSerialData* dataOut, ThreadPool* threadPool = nullptr);
+        /// Decode the debug chunks that readStream left encoded in data, into its debug data.
+        /// Only needs to be called if the debug data is accessed directly (`read` decodes it if it's used).
+    static Result decodeDebugChunks(IRSerialData* data);
+
+        /// Read a module from serial data.
+        /// If sourceManager is set, the module's debug information is used to give its instructions source locations. The
+        /// locations are allocated up front, but the views (and files) they are in are only created on sourceManager when
+        /// one of them is first looked up.
 
-        /// Read a module from serial data
     Result read(const IRSerialData& data, Session* session, SourceManager* sourceManager, RefPtr<IRModule>& moduleOut);
 
         /// Get the representation cache
@@ -534,11 +626,82 @@ struct IRSerialReader
     IRModule* m_module;
 };
 
+    /// Reads a module from serial data lazily, a global value at a time.
+    ///
+    /// `IRSerialReader::read` creates every instruction up front. When only some of the
+    /// symbols in a module will be used (such as when linking against a large precompiled
+    /// module), `IRSerialLazyReader` instead creates an empty module, and only creates the
+    /// instructions of a global value (and everything it references) when it is asked for.
+    ///
+    /// The serial data must stay alive (and unchanged) for as long as the reader is used, unless
+    /// it is read from a stream by the reader. Only raw source locations are restored; debug
+    /// information is ignored.
+    ///
+    /// A module that is linked against lazily holds its reader (see `IRModule::setLazyReader`).
+struct IRSerialLazyReader : public RefObject
+{
+    typedef IRSerialData Ser;
+    typedef StringRepresentationCache::Handle StringHandle;
+
+        /// Create the (empty) module for data. Does not create any instructions other than the module instruction.
+    Result init(const IRSerialData& data, Session* session, RefPtr<IRModule>& moduleOut);
+        /// Read the serial data from stream, and create the (empty) module for it. The reader holds the data.
+    Result init(Stream* stream, Session* session, RefPtr<IRModule>& moduleOut);
+
+        /// Find the global values with a linkage decoration with mangledName, in module order, and make sure they (and their
+        /// dependencies) are in the module. outValues is empty if there are no such global values.
+        /// Uses the symbol table of the serial data if it has one, otherwise builds one from the linkage decorations.
+    void findGlobalValues(const UnownedStringSlice& mangledName, List<IRInst*>& outValues);
+        /// Returns true if there is a global value with a linkage decoration with mangledName. Doesn't add anything to the module.
+    bool hasGlobalValue(const UnownedStringSlice& mangledName);
+        /// Find the first global value with each mangled name that has op, in module order, and make sure they (and
+        /// their dependencies) are in the module.
+    void findFirstGlobalValuesWithOp(IROp op, List<IRInst*>& outValues);
+
+        /// Make sure the global value at instIndex (and its dependencies) are in the module, and return it
+    IRInst* materializeGlobalValue(Ser::InstIndex instIndex);
+
+        /// Make sure all global values are in the module
+    void materializeAll();
+
+        /// Get the number of instructions created so far (including the module instruction)
+    Index getMaterializedInstCount() const { return m_materializedInstCount; }
+
+    protected:
+    Ser::InstIndex _getParentIndex(Ser::InstIndex instIndex) const { return m_parentIndices[Index(instIndex)]; }
+    Ser::InstIndex _findGlobalAncestor(Ser::InstIndex instIndex) const;
+    void _createGlobalValue(Ser::InstIndex globalIndex);
+    IRInst* _getInst(Ser::InstIndex instIndex);
+        /// Get the symbol table of the serial data, or the one built from its linkage decorations if it doesn't have one
+    const List<Ser::Symbol>& _getSymbols();
+        /// Get the index of the first symbol with mangledName, or -1 if there is none
+    Index _findFirstSymbol(const UnownedStringSlice& mangledName);
+
+    StringRepresentationCache m_stringRepresentationCache;
+
+    IRSerialData m_ownedSerialData;                         ///< The data, if it was read from a stream by the reader
+    const IRSerialData* m_serialData = nullptr;
+    IRModule* m_module = nullptr;
+
+    List<IRInst*> m_insts;                                  ///< Created instructions, by index. nullptr if not created yet
+    List<Ser::InstIndex> m_parentIndices;                   ///< Parent of each instruction, by index. 0 if it has no parent
+    List<Index> m_firstChildRuns;                           ///< First child run of each instruction, by index. -1 if it has no children
+    List<Index> m_nextChildRuns;                            ///< Next child run with the same parent, by run index. -1 if it is the last
+    List<Ser::InstIndex> m_pendingIndices;                  ///< Created instructions whose type and operands still need to be set
+    Index m_materializedInstCount = 0;
+
+    bool m_hasBuiltSymbols = false;
+    List<Ser::Symbol> m_builtSymbols;                       ///< Symbols built from the linkage decorations, for data without a symbol table
+};
+
 struct IRSerialUtil
 {
         /// Produces an instruction list which is in same order as written through IRSerialWriter
     static void calcInstructionList(IRModule* module, List<IRInst*>& instsOut);
 
+        /// Get the stream options named name (one of "none", "lite", "lite-delta", "lz4" or "lz4-delta")
+    static SlangResult parseStreamOptions(const UnownedStringSlice& name, IRSerialWriter::StreamOptions& optionsOut);
+
         /// Verify serialization
     static SlangResult verifySerialize(IRModule* module, Session* session, SourceManager* sourceManager, IRSerialBinary::CompressionType compressionType, IRSerialWriter::OptionFlags optionFlags);
 };
@@ -0,0 +1,514 @@
+// slang-ir-specialization-cache.cpp
+#include "slang-ir-specialization-cache.h"
+
+#include "slang-compiler.h"
+#include "slang-ir-clone.h"
+
+namespace Slang
+{
+
+// Specializations are copied between modules (into the cache when they are
+// made, and out of it into the modules for later entry points), so
+// everything a specialization references outside of itself needs to be
+// found or made again in the destination module. There are four kinds of
+// value we know how to do that for:
+//
+// * Other specializations of generics, which are found by their key, or
+//   copied along with the specialization that references them.
+//
+// * Global values with linkage, which are found by their mangled name.
+//   The cache module holds a declaration with the same name in their place.
+//
+// * Constants, which are made again in the destination module. Pointer
+//   constants refer to AST nodes, which all the modules share.
+//
+// * Types such as `vector<float,3>` that are identified by their opcode
+//   and operands, where the operands are of one of these kinds. They are
+//   made again too.
+//
+// A specialization that references anything else isn't cached.
+
+    /// Returns true if `inst` is a type that is identified by its opcode and operands
+static bool _isHoistable(IRInst* inst)
+{
+    if (!as<IRType>(inst) || inst->getFullType() || inst->getFirstDecorationOrChild())
+        return false;
+
+    switch (inst->op)
+    {
+        // These types are identified by the instruction itself, not by their operands
+        case kIROp_StructType:
+        case kIROp_InterfaceType:
+            return false;
+        default:
+            break;
+    }
+
+    auto parent = inst->getParent();
+    return parent && as<IRModuleInst>(parent);
+}
+
+static bool _isDescendantOf(IRInst* inst, IRInst* ancestor)
+{
+    for (auto ii = inst; ii; ii = ii->getParent())
+    {
+        if (ii == ancestor)
+            return true;
+    }
+    return false;
+}
+
+void IRSpecializedValues::init(IRModule* module)
+{
+    m_module = module;
+    m_sharedBuilder.module = module;
+    m_sharedBuilder.session = module->getSession();
+}
+
+void IRSpecializedValues::add(Index key, IRInst* val)
+{
+    m_valsByKey[key] = val;
+    m_keysByVal[val] = key;
+}
+
+IRInst* IRSpecializedValues::findVal(Index key)
+{
+    IRInst* val = nullptr;
+    m_valsByKey.TryGetValue(key, val);
+    return val;
+}
+
+Index IRSpecializedValues::findKey(IRInst* val)
+{
+    Index key = -1;
+    m_keysByVal.TryGetValue(val, key);
+    return key;
+}
+
+IRInst* IRSpecializedValues::findSymbol(const UnownedStringSlice& mangledName)
+{
+    if (!m_hasSymbols)
+    {
+        // The symbols are only needed once something is copied into the module, so
+        // they are found then. At the same time the builder is set up to reuse the
+        // constants and hoistable instructions that are already in the module.
+        //
+        m_hasSymbols = true;
+        for (auto inst : m_module->getGlobalInsts())
+        {
+            if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+            {
+                m_symbols.AddIfNotExists(String(linkage->getMangledName()), inst);
+            }
+            else if (auto constant = as<IRConstant>(inst))
+            {
+                IRConstantKey key = { constant };
+                m_sharedBuilder.constantMap.AddIfNotExists(key, constant);
+            }
+            else if (_isHoistable(inst))
+            {
+                m_sharedBuilder.globalValueNumberingMap.AddIfNotExists(IRInstKey::make(inst), inst);
+            }
+        }
+    }
+
+    IRInst* val = nullptr;
+    m_symbols.TryGetValue(String(mangledName), val);
+    return val;
+}
+
+void IRSpecializedValues::addSymbol(const UnownedStringSlice& mangledName, IRInst* val)
+{
+    m_symbols.AddIfNotExists(String(mangledName), val);
+}
+
+    /// Copies specializations from the module of one `IRSpecializedValues` to another
+struct IRSpecializationCopier
+{
+    IRSpecializationCopier(
+        IRSpecializedValues*    src,
+        IRSpecializedValues*    dst,
+        bool                    addSymbols,
+        List<IRInst*>*          newInsts,
+        IRInst*                 insertBefore = nullptr):
+        m_src(src),
+        m_dst(dst),
+        m_addSymbols(addSymbols),
+        m_newInsts(newInsts)
+    {
+        m_builder.sharedBuilder = dst->getSharedBuilder();
+        if (insertBefore)
+            m_builder.setInsertBefore(insertBefore);
+        else
+            m_builder.setInsertInto(dst->getModule()->getModuleInst());
+    }
+
+        /// Returns true if `inst` (a global value in the source module) can be copied
+    bool canCopy(IRInst* inst)
+    {
+        if (!inst)
+            return true;
+
+        bool result = false;
+        if (m_canCopy.TryGetValue(inst, result))
+            return result;
+
+        // Until we know, assume that `inst` can't be copied, so that
+        // a specialization that references itself indirectly isn't.
+        m_canCopy[inst] = false;
+        result = _canCopyValue(inst);
+        m_canCopy[inst] = result;
+        return result;
+    }
+
+        /// Copy `inst` (a global value in the source module) into the destination module.
+        /// `canCopy` must have returned true for `inst`.
+    IRInst* copy(IRInst* inst)
+    {
+        if (!inst)
+            return nullptr;
+
+        IRInst* result = nullptr;
+        if (m_copies.TryGetValue(inst, result))
+            return result;
+
+        result = _copyValue(inst);
+        SLANG_ASSERT(result);
+
+        m_copies.Add(inst, result);
+        return result;
+    }
+
+protected:
+    bool _canCopyValue(IRInst* inst)
+    {
+        Index key = m_src->findKey(inst);
+        if (key >= 0)
+            return m_dst->findVal(key) || _canCopyBody(inst, inst);
+
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            return m_dst->findSymbol(linkage->getMangledName()) ||
+                (m_addSymbols && canCopy(inst->getFullType()));
+        }
+
+        if (auto constant = as<IRConstant>(inst))
+            return canCopy(constant->getFullType());
+
+        if (_isHoistable(inst))
+        {
+            for (UInt i = 0; i < inst->getOperandCount(); ++i)
+            {
+                if (!canCopy(inst->getOperand(i)))
+                    return false;
+            }
+            return true;
+        }
+
+        return false;
+    }
+
+        /// Returns true if everything `inst` (within the specialization `root`) references can be copied
+    bool _canCopyBody(IRInst* root, IRInst* inst)
+    {
+        if (!_canCopyOperand(root, inst->getFullType()))
+            return false;
+        for (UInt i = 0; i < inst->getOperandCount(); ++i)
+        {
+            if (!_canCopyOperand(root, inst->getOperand(i)))
+                return false;
+        }
+
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            if (!_canCopyBody(root, child))
+                return false;
+        }
+        return true;
+    }
+
+    bool _canCopyOperand(IRInst* root, IRInst* operand)
+    {
+        if (!operand || _isDescendantOf(operand, root))
+            return true;
+
+        // Anything outside of the specialization has to be a global value
+        auto parent = operand->getParent();
+        return parent && as<IRModuleInst>(parent) && canCopy(operand);
+    }
+
+    IRInst* _copyValue(IRInst* inst)
+    {
+        Index key = m_src->findKey(inst);
+        if (key >= 0)
+        {
+            if (auto existing = m_dst->findVal(key))
+                return existing;
+
+            auto copied = _copyBody(inst);
+            m_dst->add(key, copied);
+            return copied;
+        }
+
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+        {
+            auto mangledName = linkage->getMangledName();
+            if (auto existing = m_dst->findSymbol(mangledName))
+                return existing;
+
+            // Add a declaration in place of the value, which is found by name when copying out of the cache
+            auto type = (IRType*)copy(inst->getFullType());
+            auto decl = m_builder.emitIntrinsicInst(type, inst->op, 0, nullptr);
+            m_builder.addImportDecoration(decl, mangledName);
+            m_dst->addSymbol(mangledName, decl);
+            return decl;
+        }
+
+        if (auto constant = as<IRConstant>(inst))
+        {
+            switch (constant->op)
+            {
+                case kIROp_BoolLit:
+                    return m_builder.getBoolValue(constant->value.intVal != 0);
+                case kIROp_IntLit:
+                    return m_builder.getIntValue((IRType*)copy(constant->getFullType()), constant->value.intVal);
+                case kIROp_FloatLit:
+                    return m_builder.getFloatValue((IRType*)copy(constant->getFullType()), constant->value.floatVal);
+                case kIROp_StringLit:
+                    return m_builder.getStringValue(constant->getStringSlice());
+                case kIROp_PtrLit:
+                    return m_builder.getPtrValue(constant->value.ptrVal);
+                default:
+                    SLANG_UNEXPECTED("constant can't be copied");
+                    UNREACHABLE_RETURN(nullptr);
+            }
+        }
+
+        List<IRInst*> operands;
+        for (UInt i = 0; i < inst->getOperandCount(); ++i)
+        {
+            operands.add(copy(inst->getOperand(i)));
+        }
+        auto copied = m_builder.getType(inst->op, operands.getCount(), operands.getBuffer());
+        m_newInsts->add(copied);
+        return copied;
+    }
+
+    IRInst* _copyBody(IRInst* inst)
+    {
+        // The values referenced from outside of the specialization are copied first, so
+        // that the clone can use them in place of the originals.
+        //
+        IRCloneEnv env;
+        _copyOperands(&env, inst, inst);
+
+        auto copied = cloneInst(&env, &m_builder, inst);
+        m_newInsts->add(copied);
+        return copied;
+    }
+
+    void _copyOperands(IRCloneEnv* env, IRInst* root, IRInst* inst)
+    {
+        _copyOperand(env, root, inst->getFullType());
+        for (UInt i = 0; i < inst->getOperandCount(); ++i)
+        {
+            _copyOperand(env, root, inst->getOperand(i));
+        }
+
+        for (auto child : inst->getDecorationsAndChildren())
+        {
+            _copyOperands(env, root, child);
+        }
+    }
+
+    void _copyOperand(IRCloneEnv* env, IRInst* root, IRInst* operand)
+    {
+        if (!operand || _isDescendantOf(operand, root) || env->mapOldValToNew.containsKey(operand))
+            return;
+        env->mapOldValToNew.add(operand, copy(operand));
+    }
+
+    IRSpecializedValues* m_src;
+    IRSpecializedValues* m_dst;
+    bool m_addSymbols;                      ///< If set declarations are added for symbols the destination doesn't have
+    List<IRInst*>* m_newInsts;
+
+    IRBuilder m_builder;
+
+    Dictionary<IRInst*, bool> m_canCopy;
+    Dictionary<IRInst*, IRInst*> m_copies;
+};
+
+bool IRSpecializationCache::_appendKey(IRSpecializedValues& values, IRInst* inst, StringBuilder& out)
+{
+    if (!inst)
+    {
+        out << "_";
+        return true;
+    }
+
+    Index key = values.findKey(inst);
+    if (key >= 0)
+    {
+        out << "@" << Int64(key);
+        return true;
+    }
+
+    if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+    {
+        auto mangledName = linkage->getMangledName();
+        out << "N" << Int64(mangledName.size()) << ":" << mangledName;
+        return true;
+    }
+
+    if (auto constant = as<IRConstant>(inst))
+    {
+        switch (constant->op)
+        {
+            case kIROp_BoolLit:
+                out << "B" << Int32(constant->value.intVal != 0);
+                return true;
+            case kIROp_IntLit:
+                out << "I";
+                _appendKey(values, constant->getFullType(), out);
+                out << ":" << Int64(constant->value.intVal);
+                return true;
+            case kIROp_FloatLit:
+            {
+                // Use the bits, so that the key doesn't depend on how the value is formatted
+                uint64_t bits;
+                memcpy(&bits, &constant->value.floatVal, sizeof(bits));
+                out << "F";
+                _appendKey(values, constant->getFullType(), out);
+                out << ":" << UInt64(bits);
+                return true;
+            }
+            case kIROp_StringLit:
+            {
+                auto slice = constant->getStringSlice();
+                out << "S" << Int64(slice.size()) << ":" << slice;
+                return true;
+            }
+            case kIROp_PtrLit:
+                // Pointers (to AST nodes) outlive the IR modules, so are the same in all of them
+                out << "P" << UInt64(size_t(constant->value.ptrVal));
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    if (_isHoistable(inst))
+    {
+        out << "(" << Int32(inst->op);
+        for (UInt i = 0; i < inst->getOperandCount(); ++i)
+        {
+            out << ",";
+            if (!_appendKey(values, inst->getOperand(i), out))
+                return false;
+        }
+        out << ")";
+        return true;
+    }
+
+    return false;
+}
+
+Index IRSpecializationCache::getKey(IRSpecializedValues& values, IRSpecialize* specializeInst)
+{
+    StringBuilder buf;
+    buf << "G";
+    if (!_appendKey(values, specializeInst->getBase(), buf))
+        return -1;
+    for (UInt i = 0; i < specializeInst->getArgCount(); ++i)
+    {
+        buf << ",";
+        if (!_appendKey(values, specializeInst->getArg(i), buf))
+            return -1;
+    }
+    return StringSlicePool::asIndex(m_keyPool.add(buf));
+}
+
+Index IRSpecializationCache::getFuncKey(IRSpecializedValues& values, IRFunc* func, IRInst* const* args, Index argCount)
+{
+    StringBuilder buf;
+    buf << "R";
+    if (!_appendKey(values, func, buf))
+        return -1;
+    for (Index i = 0; i < argCount; ++i)
+    {
+        buf << ",";
+        if (!_appendKey(values, args[i], buf))
+            return -1;
+    }
+    return StringSlicePool::asIndex(m_keyPool.add(buf));
+}
+
+IRInst* IRSpecializationCache::copyOut(Index key, IRSpecializedValues& values, IRInst* insertBefore, List<IRInst*>& outNewInsts)
+{
+    if (!m_module)
+        return nullptr;
+
+    IRInst* cachedVal = m_values.findVal(key);
+    if (!cachedVal)
+        return nullptr;
+
+    IRSpecializationCopier copier(&m_values, &values, false, &outNewInsts, insertBefore);
+    if (!copier.canCopy(cachedVal))
+        return nullptr;
+    return copier.copy(cachedVal);
+}
+
+void IRSpecializationCache::add(IRSpecializedValues& values, const List<Index>& keys)
+{
+    if (!m_module)
+    {
+        SharedIRBuilder sharedBuilder;
+        sharedBuilder.module = nullptr;
+        sharedBuilder.session = values.getModule()->getSession();
+
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+
+        m_module = builder.createModule();
+        m_values.init(m_module);
+    }
+
+    List<IRInst*> newInsts;
+    IRSpecializationCopier copier(&values, &m_values, true, &newInsts);
+    for (auto key : keys)
+    {
+        if (m_values.findVal(key))
+            continue;
+
+        // The specialization may have been removed by later steps
+        IRInst* val = values.findVal(key);
+        if (!val || !val->getParent())
+            continue;
+
+        if (copier.canCopy(val))
+            copier.copy(val);
+    }
+}
+
+void IRSpecializationCache::clear()
+{
+    m_values = IRSpecializedValues();
+    m_module = nullptr;
+    m_keyPool.clear();
+}
+
+IRSpecializationCache* TargetProgram::getIRSpecializationCache()
+{
+    if (!m_irSpecializationCache)
+        m_irSpecializationCache = new IRSpecializationCache();
+    return m_irSpecializationCache;
+}
+
+void TargetProgram::destroyIRSpecializationCache()
+{
+    delete m_irSpecializationCache;
+    m_irSpecializationCache = nullptr;
+}
+
+}
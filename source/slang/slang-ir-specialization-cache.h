@@ -0,0 +1,101 @@
+// slang-ir-specialization-cache.h
+#pragma once
+
+#include "../core/slang-basic.h"
+#include "../core/slang-string-slice-pool.h"
+
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+    /// The specializations of generics made in one IR module, indexed by their specialization cache key.
+    ///
+    /// A key is an index into the key pool of an `IRSpecializationCache`. Keys identify the generic
+    /// and its arguments without reference to any particular module, so the same specialization
+    /// has the same key in every module linked for a target.
+struct IRSpecializedValues
+{
+        /// Set up for specializations in `module`.
+    void init(IRModule* module);
+
+        /// Add `val` as the specialization with `key`
+    void add(Index key, IRInst* val);
+
+        /// Get the specialization with `key`, or nullptr if there isn't one
+    IRInst* findVal(Index key);
+        /// Get the key of the specialization `val`, or -1 if it isn't one
+    Index findKey(IRInst* val);
+
+        /// Find the global value with linkage `mangledName` in the module, or nullptr if there isn't one
+    IRInst* findSymbol(const UnownedStringSlice& mangledName);
+        /// Add `val` as the global value with linkage `mangledName`
+    void addSymbol(const UnownedStringSlice& mangledName, IRInst* val);
+
+    IRModule* getModule() const { return m_module; }
+        /// Get the builder used for instructions copied into the module.
+        /// Hoistable instructions and constants it makes are shared with those already at global scope.
+    SharedIRBuilder* getSharedBuilder() { return &m_sharedBuilder; }
+
+protected:
+    IRModule* m_module = nullptr;
+
+    Dictionary<Index, IRInst*> m_valsByKey;
+    Dictionary<IRInst*, Index> m_keysByVal;
+
+    bool m_hasSymbols = false;
+    Dictionary<String, IRInst*> m_symbols;
+
+    SharedIRBuilder m_sharedBuilder;
+};
+
+    /// Caches the specializations of generics made for the entry points of a `TargetProgram`, along
+    /// with the functions specialized for the resources passed to them (see `specializeResourceParameters`).
+    ///
+    /// Each entry point is linked into its own IR module, so without the cache the same generic
+    /// is specialized with the same arguments once per entry point. The cache holds a copy of each
+    /// specialization in a module of its own, with the global values it references replaced by
+    /// declarations that are resolved by mangled name when the specialization is copied out.
+    ///
+    /// Specializations that reference values that are neither found by name nor other cached
+    /// specializations (such as functions made by existential specialization) aren't cached.
+    ///
+    /// The cache assumes that the global generic arguments and the code the generics reference are the
+    /// same for all the entry points, which holds for the modules `linkIR` produces for one target.
+    ///
+struct IRSpecializationCache
+{
+        /// Get the key for the specialization made by `specializeInst` in the module of `values`.
+        /// Returns -1 if the specialization can't be identified independently of the module.
+    Index getKey(IRSpecializedValues& values, IRSpecialize* specializeInst);
+
+        /// Get the key for the specialization of the function `func` for the values `args`
+        /// (such as the global shader parameters passed to it) in the module of `values`.
+        /// Returns -1 if the specialization can't be identified independently of the module.
+    Index getFuncKey(IRSpecializedValues& values, IRFunc* func, IRInst* const* args, Index argCount);
+
+        /// Copy the specialization with `key` into the module of `values`, before the global `insertBefore`.
+        /// Returns nullptr if the specialization isn't in the cache or can't be copied.
+        /// The specialization and any other instructions that were created are added to `outNewInsts`.
+    IRInst* copyOut(Index key, IRSpecializedValues& values, IRInst* insertBefore, List<IRInst*>& outNewInsts);
+
+        /// Copy the specializations with `keys` in the module of `values` into the cache.
+        /// Specializations that are already cached, or can't be copied, are skipped.
+    void add(IRSpecializedValues& values, const List<Index>& keys);
+
+        /// Remove all the cached specializations
+    void clear();
+
+    Index hitCount = 0;         ///< The number of specializations that were copied out of the cache
+    Index missCount = 0;        ///< The number of specializations that had to be made
+
+protected:
+    bool _appendKey(IRSpecializedValues& values, IRInst* inst, StringBuilder& out);
+
+    StringSlicePool m_keyPool;
+
+    RefPtr<IRModule> m_module;
+    IRSpecializedValues m_values;
+};
+
+}
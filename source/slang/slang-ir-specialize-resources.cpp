@@ -4,6 +4,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-specialization-cache.h"
 
 namespace Slang
 {
@@ -22,6 +23,18 @@ struct ResourceParameterSpecializationContext
     TargetRequest*  targetRequest;
     IRModule*       module;
 
+    // The same function is often called with the same resources from
+    // many entry points, each of which is linked into its own module.
+    // The specialized functions are kept in a cache shared by all the
+    // entry points for the target, so that for every entry point after
+    // the first they can be copied instead of made again. The
+    // specializations made in this module are tracked with their
+    // cache keys, and added to the cache once the pass is done.
+    //
+    IRSpecializationCache* specializationCache = nullptr;
+    IRSpecializedValues specializedValues;
+    List<Index> specializationCacheMisses;
+
     // Our general approach will be to think in terms
     // of specializing call sites, which amount to
     // `IRCall` instructions. We will keep a work list
@@ -52,6 +65,15 @@ struct ResourceParameterSpecializationContext
         // Next we will populate our initial work list by
         // recursively finding every single call site in the module.
         //
+        // If the module keeps an opcode index, we can first check
+        // that there are any call sites at all, and skip the walk
+        // when there are none.
+        //
+        if( auto opcodeIndex = module->getOpcodeIndex() )
+        {
+            if( !opcodeIndex->contains(kIROp_Call) )
+                return;
+        }
         addCallsToWorkListRec(module->getModuleInst());
 
         // We will process the work list until it goes dry,
@@ -74,6 +96,11 @@ struct ResourceParameterSpecializationContext
                 specializeCall(call);
             }
         }
+
+        if( specializationCache )
+        {
+            specializationCache->add(specializedValues, specializationCacheMisses);
+        }
     }
 
     // Setting up the work list is a simple recursive procedure.
@@ -367,7 +394,28 @@ struct ResourceParameterSpecializationContext
         // that is suitable to this call site.
         //
         IRFunc* newFunc = nullptr;
+        Index cacheKey = -1;
         if( !specializedFuncs.TryGetValue(callInfo.key, newFunc) )
+        {
+            // Another entry point may have needed the same
+            // specialization, in which case it can be copied
+            // out of the cache.
+            //
+            if( specializationCache )
+            {
+                cacheKey = specializationCache->getFuncKey(
+                    specializedValues,
+                    oldFunc,
+                    callInfo.key.vals.getBuffer() + 1,
+                    callInfo.key.vals.getCount() - 1);
+                newFunc = findCachedSpecializedFunc(cacheKey, oldFunc);
+            }
+            if( newFunc )
+            {
+                specializedFuncs.Add(callInfo.key, newFunc);
+            }
+        }
+        if( !newFunc )
         {
             // If we didn't find a pre-existing specialized
             // function, then we will go ahead and create one.
@@ -386,6 +434,16 @@ struct ResourceParameterSpecializationContext
             //
             newFunc = generateSpecializedFunc(oldFunc, funcInfo);
             specializedFuncs.Add(callInfo.key, newFunc);
+
+            if( specializationCache )
+            {
+                specializationCache->missCount++;
+                if( cacheKey >= 0 )
+                {
+                    specializedValues.add(cacheKey, newFunc);
+                    specializationCacheMisses.add(cacheKey);
+                }
+            }
         }
 
         // Once we've other found or generated a specialized function
@@ -403,6 +461,35 @@ struct ResourceParameterSpecializationContext
         oldCall->removeAndDeallocate();
     }
 
+    // Looking up a specialization in the cache needs a little care,
+    // because it may already have been copied into this module
+    // along with another specialization that calls it.
+    //
+    IRFunc* findCachedSpecializedFunc(Index cacheKey, IRFunc* oldFunc)
+    {
+        if( cacheKey < 0 )
+            return nullptr;
+
+        if( auto existing = specializedValues.findVal(cacheKey) )
+            return as<IRFunc>(existing);
+
+        List<IRInst*> newInsts;
+        auto cachedFunc = as<IRFunc>(specializationCache->copyOut(
+            cacheKey,
+            specializedValues,
+            oldFunc,
+            newInsts));
+        if( !cachedFunc )
+            return nullptr;
+
+        // The calls in the copied function were already
+        // specialized when it was made, so there is no need
+        // to add them to the work list.
+        //
+        specializationCache->hitCount++;
+        return cachedFunc;
+    }
+
     // Before diving into the details on how we gather information
     // and specialize callees, lets stop to think about what we'd
     // like to do in terms of individual parameters and arguments.
@@ -758,7 +845,7 @@ struct ResourceParameterSpecializationContext
         {
             UInt paramIndex = paramCounter++;
             auto newVal = funcInfo.replacementsForOldParameters[paramIndex];
-            cloneEnv.mapOldValToNew.Add(oldParam, newVal);
+            cloneEnv.mapOldValToNew.add(oldParam, newVal);
         }
 
         // Next we will create the skeleton of the new
@@ -852,12 +939,15 @@ struct ResourceParameterSpecializationContext
 void specializeResourceParameters(
     BackEndCompileRequest* compileRequest,
     TargetRequest*  targetRequest,
-    IRModule*       module)
+    IRModule*       module,
+    IRSpecializationCache* cache)
 {
     ResourceParameterSpecializationContext context;
     context.compileRequest = compileRequest;
     context.targetRequest = targetRequest;
     context.module = module;
+    context.specializationCache = cache;
+    context.specializedValues.init(module);
 
     context.processModule();
 }
@@ -6,6 +6,7 @@ namespace Slang
     class BackEndCompileRequest;
     class TargetRequest;
     struct IRModule;
+    struct IRSpecializationCache;
 
         /// Specialize calls to functions with resource-type parameters.
         ///
@@ -17,8 +18,14 @@ namespace Slang
         /// those resource parameters (and instead, e.g, refers to the
         /// global shader parameters directly).
         ///
+        /// If `cache` is set, specialized functions are looked up in it
+        /// (by the mangled names of the function and of the global shader
+        /// parameters it is specialized for) before they are made, and
+        /// those that are made are added to it.
+        ///
     void specializeResourceParameters(
         BackEndCompileRequest* compileRequest,
         TargetRequest*  targetRequest,
-        IRModule*       module);
+        IRModule*       module,
+        IRSpecializationCache* cache = nullptr);
 }
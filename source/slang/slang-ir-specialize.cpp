@@ -4,6 +4,7 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-specialization-cache.h"
 
 namespace Slang
 {
@@ -50,10 +51,10 @@ struct SpecializationContext
     // specialized-ness of an instruction depends on the
     // fully-specialized-ness of its operands.
     //
-    // We will build an explicit hash set to encode those
+    // We will build an explicit set to encode those
     // instructions that are fully specialized.
     //
-    HashSet<IRInst*> fullySpecializedInsts;
+    IRInstSet fullySpecializedInsts;
 
     // An instruction is then fully specialized if and only
     // if it is in our set.
@@ -69,7 +70,7 @@ struct SpecializationContext
         //
         if(!inst) return true;
 
-        return fullySpecializedInsts.Contains(inst);
+        return fullySpecializedInsts.contains(inst);
     }
 
     // When an instruction isn't fully specialized, but its operands *are*
@@ -98,9 +99,16 @@ struct SpecializationContext
     // whether generic, existential, etc.
     //
     List<IRInst*> workList;
-    HashSet<IRInst*> workListSet;
+    IRInstSet workListSet;
 
-    HashSet<IRInst*> cleanInsts;
+    IRInstSet cleanInsts;
+
+    SpecializationContext(IRModule* inModule)
+        : module(inModule)
+        , fullySpecializedInsts(inModule)
+        , workListSet(inModule)
+        , cleanInsts(inModule)
+    {}
 
     void addToWorkList(
         IRInst* inst)
@@ -115,12 +123,11 @@ struct SpecializationContext
                 return;
         }
 
-        if(workListSet.Contains(inst))
+        if(!workListSet.add(inst))
             return;
 
         workList.add(inst);
-        workListSet.Add(inst);
-        cleanInsts.Remove(inst);
+        cleanInsts.remove(inst);
 
         addUsersToWorkList(inst);
     }
@@ -146,9 +153,8 @@ struct SpecializationContext
     void markInstAsFullySpecialized(
         IRInst* inst)
     {
-        if(fullySpecializedInsts.Contains(inst))
+        if(!fullySpecializedInsts.add(inst))
             return;
-        fullySpecializedInsts.Add(inst);
 
         // If we know that an instruction is fully specialized,
         // then we should start to consider its uses and children
@@ -174,6 +180,18 @@ struct SpecializationContext
     typedef IRSimpleSpecializationKey Key;
     Dictionary<Key, IRInst*> genericSpecializations;
 
+    // The same specializations are often needed in the modules for other
+    // entry points. When a cache is provided we look for specializations
+    // there first, and add the ones we make to it once we are done.
+    //
+    // The cache identifies specializations with keys that don't depend
+    // on the module, which `specializedValues` maps to the specializations
+    // in this module.
+    //
+    IRSpecializationCache* specializationCache = nullptr;
+    IRSpecializedValues specializedValues;
+    List<Index> specializationCacheMisses;
+
     // We will also use some shared IR building state across
     // all of our specialization/cloning steps.
     //
@@ -219,6 +237,44 @@ struct SpecializationContext
                 return specializedVal;
         }
 
+        Index cacheKey = -1;
+        if( specializationCache )
+        {
+            cacheKey = specializationCache->getKey(specializedValues, specializeInst);
+            if( cacheKey >= 0 )
+            {
+                // The specialization may already have been copied into
+                // the module, along with another one that references it.
+                //
+                IRInst* specializedVal = specializedValues.findVal(cacheKey);
+                if( !specializedVal )
+                {
+                    List<IRInst*> newInsts;
+                    specializedVal = specializationCache->copyOut(
+                        cacheKey,
+                        specializedValues,
+                        genericVal,
+                        newInsts);
+                    if( specializedVal )
+                    {
+                        specializationCache->hitCount++;
+
+                        // The copied instructions need to be processed just
+                        // like those cloned out of a generic.
+                        //
+                        for( auto newInst : newInsts )
+                            addToWorkList(newInst);
+                    }
+                }
+                if( specializedVal )
+                {
+                    genericSpecializations.Add(key, specializedVal);
+                    return specializedVal;
+                }
+            }
+            specializationCache->missCount++;
+        }
+
         // If no existing specialization is found, we need
         // to create the specialization instead.
         // This mostly amounts to evaluating the generic as
@@ -240,6 +296,12 @@ struct SpecializationContext
         //
         genericSpecializations.Add(key, specializedVal);
 
+        if( cacheKey >= 0 )
+        {
+            specializedValues.add(cacheKey, specializedVal);
+            specializationCacheMisses.add(cacheKey);
+        }
+
         return specializedVal;
     }
 
@@ -591,11 +653,14 @@ struct SpecializationContext
         //
         while(workList.getCount() != 0)
         {
+            // Deeply recursive generics can specialize for a long time
+            module->checkBudget();
+
             IRInst* inst = workList.getLast();
 
             workList.removeLast();
-            workListSet.Remove(inst);
-            cleanInsts.Add(inst);
+            workListSet.remove(inst);
+            cleanInsts.add(inst);
 
             // For each instruction we process, we want to perform
             // a few steps.
@@ -643,11 +708,19 @@ struct SpecializationContext
         // functions that in turn reference a generic type/function, *except*
         // in the case where that generic is for a builtin type/function, in
         // which case we wouldn't want to specialize it anyway.
+
+        // The specializations we made are only added to the cache now
+        // that they are fully specialized themselves.
+        //
+        if( specializationCache )
+        {
+            specializationCache->add(specializedValues, specializationCacheMisses);
+        }
     }
 
     void addDirtyInstsToWorkListRec(IRInst* inst)
     {
-        if( !cleanInsts.Contains(inst) )
+        if( !cleanInsts.contains(inst) )
         {
             addToWorkList(inst);
         }
@@ -1044,7 +1117,7 @@ struct SpecializationContext
             // Whatever replacement value was constructed, we need to
             // register it as the replacement for the original parameter.
             //
-            cloneEnv.mapOldValToNew.Add(oldParam, replacementVal);
+            cloneEnv.mapOldValToNew.add(oldParam, replacementVal);
         }
 
         // Next we will create the skeleton of the new
@@ -1069,7 +1142,7 @@ struct SpecializationContext
         // "fully specialized" by the rules used for doing
         // generic specialization elsewhere in this pass.
         //
-        fullySpecializedInsts.Add(newFuncType);
+        fullySpecializedInsts.add(newFuncType);
 
         // The above steps have accomplished the "first phase"
         // of cloning the function (since `IRFunc`s have no
@@ -1727,10 +1800,15 @@ struct SpecializationContext
 };
 
 void specializeModule(
-    IRModule*   module)
+    IRModule*               module,
+    IRSpecializationCache*  cache)
 {
-    SpecializationContext context;
-    context.module = module;
+    SpecializationContext context(module);
+    if( cache )
+    {
+        context.specializationCache = cache;
+        context.specializedValues.init(module);
+    }
     context.processModule();
 }
 
@@ -1773,7 +1851,7 @@ IRInst* specializeGenericImpl(
 
         IRInst* arg = specializeInst->getArg(argIndex);
 
-        env.mapOldValToNew.Add(param, arg);
+        env.mapOldValToNew.add(param, arg);
     }
 
     // We will set up an IR builder for insertion
@@ -4,9 +4,14 @@
 namespace Slang
 {
 struct IRModule;
+struct IRSpecializationCache;
 
     /// Specialize generic and interface-based code to use concrete types.
+    ///
+    /// If `cache` is set, specializations of generics are looked up in it before they
+    /// are made, and those that are made are added to it.
 void specializeModule(
-    IRModule*   module);
+    IRModule*               module,
+    IRSpecializationCache*  cache = nullptr);
 
 }
@@ -0,0 +1,291 @@
+// slang-ir-sroa.cpp
+#include "slang-ir-sroa.h"
+
+#include "slang-ir.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+static const IRIntegerValue kMaxSplitArraySize = 16;
+
+struct AggregateVarSplittingContext
+{
+    IRModule* module;
+
+    SharedIRBuilder sharedBuilder;
+
+        /// Variables to consider splitting, including the variables created by splitting
+    List<IRVar*> workList;
+
+    Index splitCount = 0;
+
+        /// A field or element of an aggregate variable
+    struct Element
+    {
+        IRType* type;
+            /// The struct key, or the index of an array element
+        IRInst* key;
+            /// Appended to the name of the variable to name the new variable
+        String nameSuffix;
+    };
+
+        /// Get the elements of `type`, if it is an aggregate that can be split
+    static bool _getElements(IRBuilder* builder, IRType* type, List<Element>& outElements)
+    {
+        if (auto structType = as<IRStructType>(type))
+        {
+            for (auto field : structType->getFields())
+            {
+                Element element;
+                element.type = field->getFieldType();
+                element.key = field->getKey();
+                if (auto nameHint = field->getKey()->findDecoration<IRNameHintDecoration>())
+                    element.nameSuffix = nameHint->getName();
+                else
+                    element.nameSuffix = String(outElements.getCount());
+                outElements.add(element);
+            }
+            return outElements.getCount() != 0;
+        }
+        if (auto arrayType = as<IRArrayType>(type))
+        {
+            auto count = as<IRIntLit>(arrayType->getElementCount());
+            if (!count || count->getValue() <= 0 || count->getValue() > kMaxSplitArraySize)
+                return false;
+            for (IRIntegerValue i = 0; i < count->getValue(); ++i)
+            {
+                Element element;
+                element.type = arrayType->getElementType();
+                element.key = builder->getIntValue(builder->getIntType(), i);
+                element.nameSuffix = String(Int(i));
+                outElements.add(element);
+            }
+            return true;
+        }
+        return false;
+    }
+
+        /// Find the element of an aggregate accessed by the field or element access `inst`
+        /// (an address or an extract). Returns -1 if the element isn't known.
+    static Index _findElement(IRInst* inst, const List<Element>& elements)
+    {
+        auto key = inst->getOperand(1);
+        if (inst->op == kIROp_FieldAddress || inst->op == kIROp_FieldExtract)
+        {
+            for (Index i = 0; i < elements.getCount(); ++i)
+            {
+                if (elements[i].key == key)
+                    return i;
+            }
+            return -1;
+        }
+
+        auto index = as<IRIntLit>(key);
+        if (!index || index->getValue() < 0 || index->getValue() >= elements.getCount())
+            return -1;
+        return Index(index->getValue());
+    }
+
+    static bool _hasOnlyIgnoredDecorations(IRInst* inst)
+    {
+        for (auto decoration : inst->getDecorations())
+        {
+            switch (decoration->op)
+            {
+                case kIROp_NameHintDecoration:
+                case kIROp_HighLevelDeclDecoration:
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    static bool _canSplit(IRVar* var, const List<Element>& elements)
+    {
+        if (!_hasOnlyIgnoredDecorations(var))
+            return false;
+
+        bool hasElementAccess = false;
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            switch (user->op)
+            {
+                case kIROp_Load:
+                    break;
+                case kIROp_Store:
+                    // The variable must be stored to, not stored somewhere
+                    if (use != &static_cast<IRStore*>(user)->ptr)
+                        return false;
+                    break;
+                case kIROp_FieldAddress:
+                case kIROp_getElementPtr:
+                    if (use != user->getOperands() || _findElement(user, elements) < 0)
+                        return false;
+                    hasElementAccess = true;
+                    break;
+                default:
+                    return false;
+            }
+        }
+        return hasElementAccess;
+    }
+
+        /// Get the value of element `index` of the aggregate `value`
+    static IRInst* _extractElement(IRBuilder* builder, IRInst* value, IRType* aggregateType, const Element& element, Index index)
+    {
+        // Stores of values built in place (such as from an initializer list)
+        // can use the operands directly
+        switch (value->op)
+        {
+            case kIROp_makeStruct:
+            case kIROp_makeArray:
+                if (UInt(index) < value->getOperandCount())
+                    return value->getOperand(index);
+                break;
+            default:
+                break;
+        }
+
+        if (as<IRStructType>(aggregateType))
+            return builder->emitFieldExtract(element.type, value, element.key);
+        return builder->emitElementExtract(element.type, value, element.key);
+    }
+
+    void _splitVar(IRVar* var, IRType* valueType, const List<Element>& elements)
+    {
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+        builder.setInsertBefore(var);
+
+        auto nameHint = var->findDecoration<IRNameHintDecoration>();
+
+        List<IRVar*> elementVars;
+        for (const auto& element : elements)
+        {
+            IRVar* elementVar = builder.emitVar(element.type);
+            if (nameHint)
+            {
+                StringBuilder name;
+                name << nameHint->getName() << "_" << element.nameSuffix;
+                builder.addNameHintDecoration(elementVar, name.getUnownedSlice());
+            }
+            elementVars.add(elementVar);
+            workList.add(elementVar);
+        }
+
+        while (auto use = var->firstUse)
+        {
+            auto user = use->getUser();
+            builder.setInsertBefore(user);
+            switch (user->op)
+            {
+                case kIROp_Load:
+                {
+                    List<IRInst*> elementVals;
+                    for (auto elementVar : elementVars)
+                    {
+                        elementVals.add(builder.emitLoad(elementVar));
+                    }
+                    IRInst* value = as<IRStructType>(valueType) ?
+                        builder.emitMakeStruct(valueType, elementVals) :
+                        builder.emitMakeArray(valueType, elementVals.getCount(), elementVals.getBuffer());
+
+                    // Reading a single element of the loaded value can use the
+                    // element directly, instead of a copy of the whole aggregate
+                    IRUse* nextUse = nullptr;
+                    for (auto valueUse = user->firstUse; valueUse; valueUse = nextUse)
+                    {
+                        nextUse = valueUse->nextUse;
+                        auto valueUser = valueUse->getUser();
+                        if (valueUse != valueUser->getOperands())
+                            continue;
+                        if (valueUser->op != kIROp_FieldExtract && valueUser->op != kIROp_getElement)
+                            continue;
+                        const Index elementIndex = _findElement(valueUser, elements);
+                        if (elementIndex < 0)
+                            continue;
+                        valueUser->replaceUsesWith(elementVals[elementIndex]);
+                        valueUser->removeAndDeallocate();
+                    }
+
+                    user->replaceUsesWith(value);
+                    break;
+                }
+                case kIROp_Store:
+                {
+                    auto value = static_cast<IRStore*>(user)->val.get();
+                    for (Index i = 0; i < elements.getCount(); ++i)
+                    {
+                        auto elementVal = _extractElement(&builder, value, valueType, elements[i], i);
+                        builder.emitStore(elementVars[i], elementVal);
+                    }
+                    break;
+                }
+                default:
+                    user->replaceUsesWith(elementVars[_findElement(user, elements)]);
+                    break;
+            }
+            user->removeAndDeallocate();
+        }
+
+        var->removeAndDeallocate();
+        splitCount++;
+    }
+
+    void processFunc(IRGlobalValueWithCode* func)
+    {
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (auto var = as<IRVar>(inst))
+                    workList.add(var);
+            }
+        }
+
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+        builder.setInsertInto(module->getModuleInst());
+
+        while (workList.getCount())
+        {
+            module->checkBudget();
+
+            IRVar* var = workList.getLast();
+            workList.removeLast();
+
+            IRType* valueType = var->getDataType()->getValueType();
+            List<Element> elements;
+            if (!_getElements(&builder, valueType, elements) || !_canSplit(var, elements))
+                continue;
+
+            _splitVar(var, valueType, elements);
+        }
+    }
+
+    Index processModule()
+    {
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto code = as<IRGlobalValueWithCode>(inst);
+            if (code && code->getFirstBlock())
+                processFunc(code);
+        }
+        return splitCount;
+    }
+};
+
+Index splitAggregateVars(IRModule* module)
+{
+    AggregateVarSplittingContext context;
+    context.module = module;
+    context.sharedBuilder.module = module;
+    context.sharedBuilder.session = module->getSession();
+    return context.processModule();
+}
+
+}
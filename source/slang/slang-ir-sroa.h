@@ -0,0 +1,31 @@
+// slang-ir-sroa.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Split local `struct` and array variables into a variable per field or element
+        /// (scalar replacement of aggregates).
+        ///
+        /// SSA construction can only promote an aggregate variable if it is only ever
+        /// stored to as a whole, so a variable that has a single field written stays in
+        /// memory, and is emitted as copies of the whole aggregate. Once it is split, each
+        /// field or element is its own variable, and can be promoted on its own.
+        ///
+        /// A variable is split if it has at least one field or element address taken, and
+        /// every use is one of
+        /// * A load or store of the whole variable
+        /// * The address of a field, or of an element at a constant index
+        ///
+        /// Arrays are only split if they have a constant size of at most 16 elements.
+        /// The new variables are split in turn, so nested aggregates are split all the way down.
+        ///
+        /// Should be followed by `constructSSA`.
+        ///
+        /// Returns the number of variables that were split.
+        ///
+    Index splitAggregateVars(IRModule* module);
+}
@@ -4,12 +4,13 @@
 #include "slang-ir.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-insts.h"
+#include "slang-legalize-types.h"
 
 namespace Slang {
 
 // Track information on a phi node we are in
 // the process of constructing.
-struct PhiInfo : RefObject
+struct PhiInfo
 {
     // The phi node will be represented as a parameter
     // to a (non-entry) basic block.
@@ -36,7 +37,7 @@ struct PhiInfo : RefObject
 
 // Information about a basic block that we generate/use
 // during SSA construction.
-struct SSABlockInfo : RefObject
+struct SSABlockInfo
 {
     // Map a promotable variable to the value to
     // use for that variable
@@ -78,9 +79,28 @@ struct ConstructSSAContext
     // Variables that we've identified for promotion
     // to SSA values.
     List<IRVar*> promotableVars;
+    IRInstSet promotableVarSet;
+
+    // Which variables are promoted
+    SSAPromotion promotion = SSAPromotion::All;
+
+    ConstructSSAContext(IRModule* module)
+        : promotableVarSet(module)
+    {}
+
+    // The arena the `PhiInfo`s and `SSABlockInfo`s are allocated from. They
+    // are destroyed with the context, while the memory is reclaimed by the
+    // caller rewinding the arena.
+    MemoryArena* arena = nullptr;
+
+    template<typename T>
+    T* allocateInfo()
+    {
+        return new(arena->allocate<T>()) T();
+    }
 
     // Information about each basic block
-    Dictionary<IRBlock*, RefPtr<SSABlockInfo>> blockInfos;
+    Dictionary<IRBlock*, SSABlockInfo*> blockInfos;
 
     // IR building state to use during the operation
     SharedIRBuilder sharedBuilder;
@@ -92,7 +112,7 @@ struct ConstructSSAContext
     IRBuilder* getBuilder() { return &builder; }
 
 
-    Dictionary<IRParam*, RefPtr<PhiInfo>> phiInfos;
+    Dictionary<IRParam*, PhiInfo*> phiInfos;
 
     PhiInfo* getPhiInfo(IRParam* phi)
     {
@@ -100,6 +120,14 @@ struct ConstructSSAContext
             return *found;
         return nullptr;
     }
+
+    ~ConstructSSAContext()
+    {
+        for (const auto& pair : phiInfos)
+            pair.Value->~PhiInfo();
+        for (const auto& pair : blockInfos)
+            pair.Value->~SSABlockInfo();
+    }
 };
 
 /// Do all uses of this instruction lead to a `load`?
@@ -144,9 +172,14 @@ bool allUsesLeadToLoads(IRInst* inst)
 
 // Is the given variable one that we can promote to SSA form?
 bool isPromotableVar(
-    ConstructSSAContext*    /*context*/,
+    ConstructSSAContext*    context,
     IRVar*                  var)
 {
+    // When only the promotions targets require are made, other
+    // variables are left for the downstream compiler
+    if (context->promotion == SSAPromotion::Required && !isResourceType(var->getDataType()->getValueType()))
+        return false;
+
     // We want to identify variables such that we can always
     // determine what they will contain at a point in the
     // program by directly inspecting their uses.
@@ -248,6 +281,7 @@ void identifyPromotableVars(
             if (isPromotableVar(context, var))
             {
                 context->promotableVars.add(var);
+                context->promotableVarSet.add(var);
             }
         }
     }
@@ -262,7 +296,7 @@ IRVar* asPromotableVar(
         return nullptr;
 
     IRVar* var = (IRVar*)value;
-    if (!context->promotableVars.contains(var))
+    if (!context->promotableVarSet.contains(var))
         return nullptr;
 
     return var;
@@ -401,7 +435,7 @@ PhiInfo* addPhi(
     IRParam* phi = builder->createParam(valueType);
     cloneRelevantDecorations(var, phi);
 
-    RefPtr<PhiInfo> phiInfo = new PhiInfo();
+    PhiInfo* phiInfo = context->allocateInfo<PhiInfo>();
     context->phiInfos.Add(phi, phiInfo);
 
     phiInfo->phi = phi;
@@ -608,7 +642,7 @@ IRInst* maybeGetPhiReplacement(
     {
         // The value is a parameter, but is it a phi?
         IRParam* maybePhi = (IRParam*) val;
-        RefPtr<PhiInfo> phiInfo = nullptr;
+        PhiInfo* phiInfo = nullptr;
         if(!context->phiInfos.TryGetValue(maybePhi, phiInfo))
             break;
 
@@ -994,7 +1028,7 @@ void constructSSA(ConstructSSAContext* context)
     auto globalVal = context->globalVal;
     for(auto bb : globalVal->getBlocks())
     {
-        auto blockInfo = new SSABlockInfo();
+        auto blockInfo = context->allocateInfo<SSABlockInfo>();
         blockInfo->block = bb;
 
         blockInfo->builder.sharedBuilder = &context->sharedBuilder;
@@ -1004,6 +1038,8 @@ void constructSSA(ConstructSSAContext* context)
     }
     for(auto bb : globalVal->getBlocks())
     {
+        context->sharedBuilder.module->checkBudget();
+
         auto blockInfo = * context->blockInfos.TryGetValue(bb);
         processBlock(context, bb, blockInfo);
     }
@@ -1120,10 +1156,16 @@ void constructSSA(ConstructSSAContext* context)
 }
 
 // Construct SSA form for a global value with code
-void constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
+void constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal, SSAPromotion promotion)
 {
-    ConstructSSAContext context;
+    // The scope is declared first, so that the arena is rewound after the context is destroyed
+    MemoryArena& arena = MemoryArena::getThreadTemporaryArena();
+    MemoryArena::RewindScope arenaScope(arena);
+
+    ConstructSSAContext context(module);
+    context.arena = &arena;
     context.globalVal = globalVal;
+    context.promotion = promotion;
 
     context.sharedBuilder.module = module;
     context.sharedBuilder.session = module->session;
@@ -1134,25 +1176,26 @@ void constructSSA(IRModule* module, IRGlobalValueWithCode* globalVal)
     constructSSA(&context);
 }
 
-void constructSSA(IRModule* module, IRInst* globalVal)
+void constructSSA(IRModule* module, IRInst* globalVal, SSAPromotion promotion)
 {
     switch (globalVal->op)
     {
     case kIROp_Func:
     case kIROp_GlobalVar:
     case kIROp_GlobalConstant:
-        constructSSA(module, (IRGlobalValueWithCode*)globalVal);
+        constructSSA(module, (IRGlobalValueWithCode*)globalVal, promotion);
 
     default:
         break;
     }
 }
 
-void constructSSA(IRModule* module)
+void constructSSA(IRModule* module, SSAPromotion promotion)
 {
     for(auto ii : module->getGlobalInsts())
     {
-        constructSSA(module, ii);
+        module->checkBudget();
+        constructSSA(module, ii, promotion);
     }
 }
 
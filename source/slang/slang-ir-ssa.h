@@ -5,5 +5,12 @@ namespace Slang
 {
     struct IRModule;
 
-    void constructSSA(IRModule* module);
+        /// Which local variables `constructSSA` promotes to SSA temporaries
+    enum class SSAPromotion
+    {
+        All,                ///< Every variable that can be promoted
+        Required,           ///< Only variables of resource type, which targets don't allow (enough when not optimizing)
+    };
+
+    void constructSSA(IRModule* module, SSAPromotion promotion = SSAPromotion::All);
 }
@@ -47,7 +47,34 @@ struct DesugarUnionTypesContext
         // union types, and process them accordingingly (usually by
         // constructing a new instruction to replace them).
         //
-        processInstRec(module->getModuleInst());
+        // When the module keeps an opcode index we can visit just those
+        // instructions, rather than walking the whole module. The types
+        // come first, just as they would in a walk of the module.
+        //
+        if( auto opcodeIndex = module->getOpcodeIndex() )
+        {
+            List<IRInst*> unionInsts;
+            opcodeIndex->getInsts(kIROp_TaggedUnionType, unionInsts);
+            opcodeIndex->getInsts(kIROp_ExtractTaggedUnionTag, unionInsts);
+            opcodeIndex->getInsts(kIROp_ExtractTaggedUnionPayload, unionInsts);
+            for( auto inst : unionInsts )
+            {
+                processInst(inst);
+            }
+        }
+        else
+        {
+            processInstRec(module->getModuleInst());
+        }
+
+        // The payload extractions found by the walk above are replaced here, once
+        // we know how many times each case of each union is extracted (see
+        // `processPayloadExtract`).
+        //
+        for( auto inst : payloadExtracts )
+        {
+            processPayloadExtract(inst);
+        }
 
         // Along the way we will build up a list of the tagged union
         // types that we encountered, but we will refrain from replacing
@@ -147,8 +174,30 @@ struct DesugarUnionTypesContext
         // by having this field be null.
         //
         IRInst* tagFieldKey;
+
+        // For each case of the union, we track how many times it is extracted,
+        // and the function that extracts it (if it is extracted more than once).
+        //
+        struct CaseInfo
+        {
+            Index   extractCount = 0;
+            IRFunc* extractFunc = nullptr;
+        };
+        List<CaseInfo> cases;
+
+        CaseInfo& getCase(UInt caseTagIndex)
+        {
+            if( caseTagIndex >= UInt(cases.getCount()) )
+                cases.setCount(Index(caseTagIndex) + 1);
+            return cases[Index(caseTagIndex)];
+        }
     };
 
+    // The instructions that extract a payload from a union, which are replaced
+    // once all of them have been found.
+    //
+    List<IRInst*> payloadExtracts;
+
     // We will build up a list of all the tagged union types we encounter,
     // so that we can replace them with the synthesized types when we are done.
     //
@@ -241,90 +290,167 @@ struct DesugarUnionTypesContext
                 // one or more fields from the data stored in the union's replacement
                 // type (the bulk/rest fields), and we may also have to convert them
                 // to the type expected via bit-casts.
-
-                // We can start things off easily enough by extracting the tagged union
-                // value being operated on, as well as the information for its type.
                 //
-                auto taggedUnionVal = inst->getOperand(0);
-                auto taggedUnionInfo = getTaggedUnionInfo(taggedUnionVal->getDataType());
-
-                // Next we need to figure out which case is being extracted from the union.
-                // The operand for the case tag should be a literal by construction.
+                // The same case is often extracted in many places (e.g., once in
+                // every function that dispatches on the union), so rather than
+                // replacing the instruction right away, we count the extractions
+                // of each case, and replace them all after the walk.
                 //
-                auto caseTagVal = inst->getOperand(1);
-                auto caseTagConst = as<IRIntLit>(caseTagVal);
-                SLANG_ASSERT(caseTagConst);
+                auto taggedUnionInfo = getTaggedUnionInfo(inst->getOperand(0)->getDataType());
+                taggedUnionInfo->getCase(getCaseTagIndex(inst)).extractCount++;
 
-                // The case type we are extracting will be the result type of the instruciton.
-                //
-                auto caseType = inst->getDataType();
-                //
-                // The tag value itself will be the index of the case type in the union
-                // type (and its layout).
-                //
-                auto caseTagIndex = UInt(caseTagConst->getValue());
+                payloadExtracts.add(inst);
+            }
+            break;
+        }
+    }
 
-                // We can use the case tag value to look up the layout for the particular
-                // case type we are extracting (this will allow us to resolve byte offsets
-                // for fields, etc.).
-                //
-                auto taggedUnionTypeLayout = taggedUnionInfo->taggedUnionTypeLayout;
-                SLANG_ASSERT(caseTagIndex < UInt(taggedUnionTypeLayout->caseTypeLayouts.getCount()));
-                auto caseTypeLayout = taggedUnionTypeLayout->caseTypeLayouts[caseTagIndex];
-
-                // At this point we know the type we are trying to extract, as well
-                // as its layout. We will defer the actual implementation of extraction
-                // to a (recursive) subroutine that can extract a (sub-)field from the
-                // union at a given byte offset. Since we are extracting a full case
-                // right now, the byte offset will be zero.
-                //
-                auto payloadVal = extractPayload(
-                    taggedUnionInfo,
-                    taggedUnionVal,
-                    caseType,
-                    caseTypeLayout,
-                    0);
+    // The case being extracted from a union is given by a literal operand.
+    //
+    static UInt getCaseTagIndex(IRInst* extractInst)
+    {
+        auto caseTagConst = as<IRIntLit>(extractInst->getOperand(1));
+        SLANG_ASSERT(caseTagConst);
+        return UInt(caseTagConst->getValue());
+    }
 
-                // TODO: There is a significant flaw in the above approach when
-                // the case type might be (or contain) an array. If we have a setup
-                // like the following:
-                //
-                //      union SomeUnion { float someCase[100]; ... }
-                //      ...
-                //      float result = someUnion.someCase[someIndex];
-                //
-                // The current logic would desugar this into something like:
-                //
-                //      struct SomeUnion { uint4 bulk[100]; ... }
-                //      ...
-                //      float[] tmp = { asfloat(someUnion.bulk[0].x), asfloat(someUnion.bulk[1].x), ... }
-                //      float result = tmp[someIndex];
-                //
-                // The result is that we copy an entire 100-element array into local memory
-                // just to fetch a single element, when it would be much nicer to just do:
-                //
-                //      float result = asfloat(someUnion.bulk[someIndex].x);
-                //
-                // Achieving the latter code requires that rather than blindly translate
-                // the `extractTaggedUnionPayload` instruction into a semantically equiavlent
-                // value (which might lead to a big copy in the end), we should transitively
-                // chase down any "access chains" off of `inst` and see what leaf values are
-                // actually needed, and generated more tailored extraction logic for just
-                // the elements/fields that actually get referenced.
-                //
-                // The more refined approach can be built on top of many of the same primitives,
-                // so for now we will resign ourselves to the simpler but potentially less
-                // efficient approach.
+    // Once all the extractions have been counted, each one is replaced with
+    // either the code to extract the payload from the fields of the replacement
+    // `struct` type, or (if the same case is extracted more than once) a call to
+    // a function holding that code.
+    //
+    void processPayloadExtract(IRInst* inst)
+    {
+        // We can start things off easily enough by extracting the tagged union
+        // value being operated on, as well as the information for its type.
+        //
+        auto taggedUnionVal = inst->getOperand(0);
+        auto taggedUnionInfo = getTaggedUnionInfo(taggedUnionVal->getDataType());
 
-                // Now that we've extracted the value for the payload from the fields of
-                // the replacement struct, we can use that extracted value to replace
-                // this instruction, and schedule the original instruction for removal.
-                //
-                inst->replaceUsesWith(payloadVal);
-                instsToRemove.add(inst);
-            }
-            break;
+        // The case type we are extracting will be the result type of the instruciton.
+        //
+        auto caseType = inst->getDataType();
+        //
+        // The tag value itself will be the index of the case type in the union
+        // type (and its layout).
+        //
+        auto caseTagIndex = getCaseTagIndex(inst);
+        auto& caseInfo = taggedUnionInfo->getCase(caseTagIndex);
+
+        IRInst* payloadVal = nullptr;
+        if( caseInfo.extractCount > 1 )
+        {
+            auto extractFunc = getPayloadExtractFunc(taggedUnionInfo, caseTagIndex, caseType);
+
+            auto builder = getBuilder();
+            builder->setInsertBefore(inst);
+            payloadVal = builder->emitCallInst(caseType, extractFunc, 1, &taggedUnionVal);
+        }
+        else
+        {
+            getBuilder()->setInsertBefore(inst);
+            payloadVal = extractCasePayload(taggedUnionInfo, taggedUnionVal, caseType, caseTagIndex);
         }
+
+        // TODO: There is a significant flaw in the above approach when
+        // the case type might be (or contain) an array. If we have a setup
+        // like the following:
+        //
+        //      union SomeUnion { float someCase[100]; ... }
+        //      ...
+        //      float result = someUnion.someCase[someIndex];
+        //
+        // The current logic would desugar this into something like:
+        //
+        //      struct SomeUnion { uint4 bulk[100]; ... }
+        //      ...
+        //      float[] tmp = { asfloat(someUnion.bulk[0].x), asfloat(someUnion.bulk[1].x), ... }
+        //      float result = tmp[someIndex];
+        //
+        // The result is that we copy an entire 100-element array into local memory
+        // just to fetch a single element, when it would be much nicer to just do:
+        //
+        //      float result = asfloat(someUnion.bulk[someIndex].x);
+        //
+        // Achieving the latter code requires that rather than blindly translate
+        // the `extractTaggedUnionPayload` instruction into a semantically equiavlent
+        // value (which might lead to a big copy in the end), we should transitively
+        // chase down any "access chains" off of `inst` and see what leaf values are
+        // actually needed, and generated more tailored extraction logic for just
+        // the elements/fields that actually get referenced.
+        //
+        // The more refined approach can be built on top of many of the same primitives,
+        // so for now we will resign ourselves to the simpler but potentially less
+        // efficient approach.
+
+        // Now that we've extracted the value for the payload from the fields of
+        // the replacement struct, we can use that extracted value to replace
+        // this instruction, and schedule the original instruction for removal.
+        //
+        inst->replaceUsesWith(payloadVal);
+        instsToRemove.add(inst);
+    }
+
+    // Extracting a whole case from a union value, at the builder's current location.
+    //
+    IRInst* extractCasePayload(
+        TaggedUnionInfo*    taggedUnionInfo,
+        IRInst*             taggedUnionVal,
+        IRType*             caseType,
+        UInt                caseTagIndex)
+    {
+        // We can use the case tag value to look up the layout for the particular
+        // case type we are extracting (this will allow us to resolve byte offsets
+        // for fields, etc.).
+        //
+        auto taggedUnionTypeLayout = taggedUnionInfo->taggedUnionTypeLayout;
+        SLANG_ASSERT(caseTagIndex < UInt(taggedUnionTypeLayout->caseTypeLayouts.getCount()));
+        auto caseTypeLayout = taggedUnionTypeLayout->caseTypeLayouts[caseTagIndex];
+
+        // At this point we know the type we are trying to extract, as well
+        // as its layout. We will defer the actual implementation of extraction
+        // to a (recursive) subroutine that can extract a (sub-)field from the
+        // union at a given byte offset. Since we are extracting a full case
+        // right now, the byte offset will be zero.
+        //
+        return extractPayload(
+            taggedUnionInfo,
+            taggedUnionVal,
+            caseType,
+            caseTypeLayout,
+            0);
+    }
+
+    // A case that is extracted in more than one place gets a function that
+    // performs the extraction, which is created the first time it is needed.
+    //
+    IRFunc* getPayloadExtractFunc(
+        TaggedUnionInfo*    taggedUnionInfo,
+        UInt                caseTagIndex,
+        IRType*             caseType)
+    {
+        auto& caseInfo = taggedUnionInfo->getCase(caseTagIndex);
+        if( caseInfo.extractFunc )
+            return caseInfo.extractFunc;
+
+        auto builder = getBuilder();
+        builder->setInsertBefore(taggedUnionInfo->taggedUnionType);
+
+        // The parameter is of the original union type, which will be replaced
+        // along with every other use of it at the end of the pass.
+        //
+        IRType* paramType = taggedUnionInfo->taggedUnionType;
+        auto func = builder->createFunc();
+        func->setFullType(builder->getFuncType(1, &paramType, caseType));
+        builder->addNameHintDecoration(func, UnownedTerminatedStringSlice("extractTaggedUnionPayload"));
+
+        builder->setInsertInto(func);
+        builder->emitBlock();
+        auto param = builder->emitParam(paramType);
+        builder->emitReturn(extractCasePayload(taggedUnionInfo, param, caseType, caseTagIndex));
+
+        caseInfo.extractFunc = func;
+        return func;
     }
 
     // The `extractPayload` operation is the most important bit of translation we
@@ -0,0 +1,504 @@
+// slang-ir-unroll-loops.cpp
+#include "slang-ir-unroll-loops.h"
+
+#include "slang-ir.h"
+#include "slang-ir-clone.h"
+#include "slang-ir-insts.h"
+
+namespace Slang
+{
+
+/* static */IRLoopUnrollOptions IRLoopUnrollOptions::getForOptimizationLevel(SlangOptimizationLevel level)
+{
+    IRLoopUnrollOptions options;
+    switch (level)
+    {
+        case SLANG_OPTIMIZATION_LEVEL_NONE:
+            break;
+        default:
+        case SLANG_OPTIMIZATION_LEVEL_DEFAULT:
+            options.mode = IRLoopUnrollMode::Explicit;
+            options.maxExplicitCost = 4096;
+            break;
+        case SLANG_OPTIMIZATION_LEVEL_HIGH:
+            options.mode = IRLoopUnrollMode::All;
+            options.maxCost = 256;
+            options.maxExplicitCost = 4096;
+            break;
+        case SLANG_OPTIMIZATION_LEVEL_MAXIMAL:
+            options.mode = IRLoopUnrollMode::All;
+            options.maxCost = 1024;
+            options.maxExplicitCost = 16384;
+            break;
+    }
+    return options;
+}
+
+struct LoopUnrollingContext
+{
+        /// The most iterations that are simulated to find a trip count
+    static const Index kMaxTripCount = 4096;
+
+        /// The parts of a loop that can be unrolled
+    struct LoopInfo
+    {
+        IRLoop* loopInst = nullptr;
+        IRBlock* headerBlock = nullptr;
+        IRBlock* bodyBlock = nullptr;
+        IRBlock* breakBlock = nullptr;
+            /// The branch at the end of the body, back to the header
+        IRUnconditionalBranch* backEdge = nullptr;
+            /// The header, and the blocks of the body, in the order they appear in the function
+        List<IRBlock*> blocks;
+        Index tripCount = 0;
+    };
+
+    IRModule* module;
+    IRLoopUnrollOptions options;
+
+    SharedIRBuilder sharedBuilder;
+
+    static Index _calcCost(const List<IRBlock*>& blocks)
+    {
+        Index cost = 0;
+        for (auto block : blocks)
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (inst->op != kIROp_Param)
+                    cost++;
+            }
+        }
+        return cost;
+    }
+
+        /// Find the branch back to the header, following the outermost structured region of the body.
+        /// Returns nullptr if the body doesn't end that way, such as when it can `continue` from
+        /// inside nested control flow.
+    static IRUnconditionalBranch* _findBackEdge(const LoopInfo& info)
+    {
+        HashSet<IRBlock*> visited;
+        IRBlock* block = info.bodyBlock;
+        while (block && block != info.breakBlock && !visited.Contains(block))
+        {
+            visited.Add(block);
+
+            auto terminator = block->getTerminator();
+            switch (terminator->op)
+            {
+                case kIROp_unconditionalBranch:
+                {
+                    auto branch = as<IRUnconditionalBranch>(terminator);
+                    if (branch->getTargetBlock() == info.headerBlock)
+                        return branch;
+                    block = branch->getTargetBlock();
+                    break;
+                }
+                case kIROp_ifElse:
+                    block = as<IRIfElse>(terminator)->getAfterBlock();
+                    break;
+                case kIROp_loop:
+                    block = as<IRLoop>(terminator)->getBreakBlock();
+                    break;
+                case kIROp_Switch:
+                    block = as<IRSwitch>(terminator)->getBreakLabel();
+                    break;
+                default:
+                    return nullptr;
+            }
+        }
+        return nullptr;
+    }
+
+        /// Find the blocks of the body. Fails if the body can leave the loop other
+        /// than through the back edge (or a return).
+    static bool _findBodyBlocks(LoopInfo& info)
+    {
+        HashSet<IRBlock*> bodyBlocks;
+        List<IRBlock*> workList;
+        bodyBlocks.Add(info.bodyBlock);
+        workList.add(info.bodyBlock);
+        while (workList.getCount())
+        {
+            IRBlock* block = workList.getLast();
+            workList.removeLast();
+
+            auto terminator = block->getTerminator();
+            const UInt operandCount = terminator->getOperandCount();
+            for (UInt i = 0; i < operandCount; ++i)
+            {
+                auto successor = as<IRBlock>(terminator->getOperand(i));
+                if (!successor || bodyBlocks.Contains(successor))
+                    continue;
+                // A `break`, or a `continue` other than the back edge
+                if (successor == info.breakBlock || (successor == info.headerBlock && terminator != info.backEdge))
+                    return false;
+                if (successor == info.headerBlock)
+                    continue;
+                bodyBlocks.Add(successor);
+                workList.add(successor);
+            }
+        }
+
+        auto func = as<IRGlobalValueWithCode>(info.headerBlock->getParent());
+        for (auto block : func->getBlocks())
+        {
+            if (block == info.headerBlock || bodyBlocks.Contains(block))
+                info.blocks.add(block);
+        }
+
+        // Nothing outside of the loop can branch into it, other than the loop instruction itself
+        for (auto block : info.blocks)
+        {
+            for (auto use = block->firstUse; use; use = use->nextUse)
+            {
+                auto user = use->getUser();
+                if (user == info.loopInst)
+                    continue;
+                if (block == info.headerBlock)
+                {
+                    if (user != info.backEdge)
+                        return false;
+                }
+                else if (!bodyBlocks.Contains(as<IRBlock>(user->getParent())) && user->getParent() != info.headerBlock)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    static bool _evalCompare(IROp op, IRIntegerValue a, IRIntegerValue b, bool& outResult)
+    {
+        switch (op)
+        {
+            case kIROp_Less:        outResult = a < b; return true;
+            case kIROp_Leq:         outResult = a <= b; return true;
+            case kIROp_Greater:     outResult = a > b; return true;
+            case kIROp_Geq:         outResult = a >= b; return true;
+            case kIROp_Neq:         outResult = a != b; return true;
+            default:                return false;
+        }
+    }
+
+        /// Work out the number of times the loop body runs. Fails if it isn't a
+        /// constant, or is more than maxTripCount.
+    static bool _calcTripCount(LoopInfo& info, Index maxTripCount)
+    {
+        auto test = as<IRIfElse>(info.headerBlock->getTerminator());
+        auto condition = test->getCondition();
+        if (condition->getParent() != info.headerBlock || condition->getOperandCount() != 2)
+            return false;
+
+        // The condition compares a parameter of the header (the counter) with a constant
+        IRParam* counter = as<IRParam>(condition->getOperand(0));
+        IRIntLit* limit = as<IRIntLit>(condition->getOperand(1));
+        const bool isCounterFirst = counter != nullptr;
+        if (!counter)
+        {
+            counter = as<IRParam>(condition->getOperand(1));
+            limit = as<IRIntLit>(condition->getOperand(0));
+        }
+        if (!counter || !limit || counter->getParent() != info.headerBlock)
+            return false;
+
+        const IROp counterTypeOp = counter->getDataType()->op;
+        if (counterTypeOp != kIROp_IntType && counterTypeOp != kIROp_UIntType)
+            return false;
+
+        Index counterIndex = 0;
+        for (auto param : info.headerBlock->getParams())
+        {
+            if (param == counter)
+                break;
+            counterIndex++;
+        }
+
+        // The counter starts at a constant, and is stepped by a constant
+        auto start = as<IRIntLit>(info.loopInst->getArg(counterIndex));
+        auto next = info.backEdge->getArg(counterIndex);
+        if (!start || next->getOperandCount() != 2)
+            return false;
+
+        IRIntegerValue step = 0;
+        if (next->op == kIROp_Add || next->op == kIROp_Sub)
+        {
+            IRIntLit* stepLit = nullptr;
+            if (next->getOperand(0) == counter)
+                stepLit = as<IRIntLit>(next->getOperand(1));
+            else if (next->op == kIROp_Add && next->getOperand(1) == counter)
+                stepLit = as<IRIntLit>(next->getOperand(0));
+            if (!stepLit)
+                return false;
+            step = (next->op == kIROp_Add) ? stepLit->getValue() : -stepLit->getValue();
+        }
+        else
+        {
+            return false;
+        }
+
+        // Run the loop on the counter, to find the trip count
+        const IRIntegerValue minValue = (counterTypeOp == kIROp_UIntType) ? 0 : -0x80000000ll;
+        const IRIntegerValue maxValue = (counterTypeOp == kIROp_UIntType) ? 0xffffffffll : 0x7fffffffll;
+
+        IRIntegerValue value = start->getValue();
+        for (Index tripCount = 0; tripCount <= maxTripCount; ++tripCount)
+        {
+            if (value < minValue || value > maxValue)
+                return false;
+
+            bool isTrue = false;
+            if (!_evalCompare(condition->op, isCounterFirst ? value : limit->getValue(), isCounterFirst ? limit->getValue() : value, isTrue))
+                return false;
+            if (!isTrue)
+            {
+                info.tripCount = tripCount;
+                return true;
+            }
+            value += step;
+        }
+        return false;
+    }
+
+    bool _analyzeLoop(IRLoop* loopInst, LoopInfo& outInfo)
+    {
+        LoopInfo info;
+        info.loopInst = loopInst;
+        info.headerBlock = loopInst->getTargetBlock();
+        info.breakBlock = loopInst->getBreakBlock();
+
+        // The header must be a loop test
+        auto test = as<IRIfElse>(info.headerBlock->getTerminator());
+        if (!test || test->getTrueBlock() != test->getAfterBlock() || test->getFalseBlock() != info.breakBlock)
+            return false;
+        info.bodyBlock = test->getTrueBlock();
+        if (info.bodyBlock == info.headerBlock || info.bodyBlock == info.breakBlock)
+            return false;
+
+        info.backEdge = _findBackEdge(info);
+        if (!info.backEdge || !_findBodyBlocks(info))
+            return false;
+
+        const bool isExplicit = loopInst->findDecoration<IRLoopControlDecoration>() != nullptr;
+        Index maxCost = 0;
+        if (isExplicit)
+            maxCost = options.maxExplicitCost;
+        else if (options.mode == IRLoopUnrollMode::All)
+            maxCost = options.maxCost;
+        else
+            return false;
+
+        const Index bodyCost = Math::Max(Index(1), _calcCost(info.blocks));
+        if (!_calcTripCount(info, Math::Min(kMaxTripCount, maxCost / bodyCost)))
+            return false;
+
+        outInfo = info;
+        return true;
+    }
+
+        /// Replace the terminator `oldTerminator` with a branch to `target`, passing `args`
+    void _replaceWithBranch(IRInst* oldTerminator, IRBlock* target, const List<IRInst*>& args)
+    {
+        List<IRInst*> operands;
+        operands.add(target);
+        operands.addRange(args);
+
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+        builder.setInsertBefore(oldTerminator);
+        builder.emitIntrinsicInst(nullptr, kIROp_unconditionalBranch, UInt(operands.getCount()), operands.getBuffer());
+
+        oldTerminator->removeAndDeallocate();
+    }
+
+    void _unrollLoop(const LoopInfo& info)
+    {
+        auto loopBlock = as<IRBlock>(info.loopInst->getParent());
+
+        List<IRInst*> args;
+        for (UInt i = 0; i < info.loopInst->getArgCount(); ++i)
+        {
+            args.add(info.loopInst->getArg(i));
+        }
+        const List<IRInst*> noArgs;
+
+        IRBuilder builder;
+        builder.sharedBuilder = &sharedBuilder;
+
+        // Each iteration is a copy of the header and body, where the header's
+        // parameters are replaced by the values from the previous iteration,
+        // and the header just branches to the body
+        IRBlock* insertAfterBlock = loopBlock;
+        IRBlock* firstBlock = info.headerBlock;
+        IRUnconditionalBranch* prevBackEdge = nullptr;
+
+        // Every block and instruction of the loop is added to the environment for every
+        // iteration, so the space for them can be reserved up front
+        Index instCount = 0;
+        for (auto block : info.blocks)
+        {
+            instCount++;
+            for (auto inst : block->getChildren())
+            {
+                SLANG_UNUSED(inst);
+                instCount++;
+            }
+        }
+
+        for (Index iteration = 0; iteration < info.tripCount; ++iteration)
+        {
+            module->checkBudget();
+
+            IRCloneEnv env;
+            env.mapOldValToNew.reserve(instCount);
+            {
+                Index paramIndex = 0;
+                for (auto param : info.headerBlock->getParams())
+                {
+                    env.mapOldValToNew.add(param, args[paramIndex++]);
+                }
+            }
+
+            for (auto block : info.blocks)
+            {
+                IRBlock* clonedBlock = builder.createBlock();
+                clonedBlock->insertAfter(insertAfterBlock);
+                insertAfterBlock = clonedBlock;
+                env.mapOldValToNew.add(block, clonedBlock);
+            }
+
+            List<IRInst*> clonedInsts;
+            for (auto block : info.blocks)
+            {
+                builder.setInsertInto(lookUp(&env, block));
+                for (auto inst : block->getChildren())
+                {
+                    if (lookUp(&env, inst))
+                        continue;
+                    clonedInsts.add(cloneInst(&env, &builder, inst));
+                }
+            }
+            // An instruction can be used by a block earlier in the function than
+            // the one it is in, in which case the use was cloned before the instruction
+            for (auto clonedInst : clonedInsts)
+            {
+                const UInt operandCount = clonedInst->getOperandCount();
+                for (UInt i = 0; i < operandCount; ++i)
+                {
+                    auto operand = clonedInst->getOperand(i);
+                    if (IRInst* newOperand = operand ? lookUp(&env, operand) : nullptr)
+                        clonedInst->setOperand(i, newOperand);
+                }
+            }
+
+            auto clonedHeader = as<IRBlock>(lookUp(&env, info.headerBlock));
+            _replaceWithBranch(clonedHeader->getTerminator(), as<IRBlock>(lookUp(&env, info.bodyBlock)), noArgs);
+
+            if (prevBackEdge)
+                _replaceWithBranch(prevBackEdge, clonedHeader, noArgs);
+            else
+                firstBlock = clonedHeader;
+
+            auto backEdge = as<IRUnconditionalBranch>(lookUp(&env, info.backEdge));
+            args.clear();
+            for (UInt i = 0; i < backEdge->getArgCount(); ++i)
+            {
+                args.add(backEdge->getArg(i));
+            }
+            prevBackEdge = backEdge;
+        }
+
+        // The original header follows the last iteration, and leaves the loop. Its parameters
+        // get the values from the last iteration, so any uses after the loop still work.
+        if (prevBackEdge)
+        {
+            _replaceWithBranch(prevBackEdge, info.headerBlock, args);
+            info.headerBlock->insertAfter(insertAfterBlock);
+            _replaceWithBranch(info.loopInst, firstBlock, noArgs);
+        }
+        else
+        {
+            _replaceWithBranch(info.loopInst, info.headerBlock, args);
+        }
+        _replaceWithBranch(info.headerBlock->getTerminator(), info.breakBlock, noArgs);
+
+        // The original body can't be reached any more
+        for (auto block : info.blocks)
+        {
+            if (block == info.headerBlock)
+                continue;
+            for (auto inst : block->getChildren())
+            {
+                inst->removeArguments();
+            }
+        }
+        for (auto block : info.blocks)
+        {
+            if (block != info.headerBlock)
+                block->removeAndDeallocate();
+        }
+    }
+
+    Index processFunc(IRFunc* func)
+    {
+        Index unrolledCount = 0;
+        HashSet<IRLoop*> rejectedLoops;
+        for (;;)
+        {
+            // Inner loops come after outer loops, so searching backwards unrolls inner
+            // loops first, and the cost of an outer loop includes its unrolled inner loops
+            IRLoop* loopInst = nullptr;
+            for (auto block = func->getLastBlock(); block && !loopInst; block = block->getPrevBlock())
+            {
+                auto candidate = as<IRLoop>(block->getTerminator());
+                if (candidate && !rejectedLoops.Contains(candidate))
+                    loopInst = candidate;
+            }
+            if (!loopInst)
+                break;
+
+            LoopInfo info;
+            if (_analyzeLoop(loopInst, info))
+            {
+                _unrollLoop(info);
+                unrolledCount++;
+            }
+            else
+            {
+                rejectedLoops.Add(loopInst);
+            }
+        }
+        return unrolledCount;
+    }
+
+    Index processModule()
+    {
+        Index unrolledCount = 0;
+        if (options.mode == IRLoopUnrollMode::None)
+            return unrolledCount;
+
+        for (auto inst : module->getGlobalInsts())
+        {
+            auto func = as<IRFunc>(inst);
+            if (func && func->isDefinition())
+                unrolledCount += processFunc(func);
+        }
+        return unrolledCount;
+    }
+};
+
+// Math::Min takes its arguments by reference, so the constant needs a definition
+const Index LoopUnrollingContext::kMaxTripCount;
+
+Index unrollLoops(IRModule* module, const IRLoopUnrollOptions& options)
+{
+    LoopUnrollingContext context;
+    context.module = module;
+    context.options = options;
+    context.sharedBuilder.module = module;
+    context.sharedBuilder.session = module->getSession();
+    return context.processModule();
+}
+
+}
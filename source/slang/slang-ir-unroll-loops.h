@@ -0,0 +1,52 @@
+// slang-ir-unroll-loops.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+namespace Slang
+{
+    struct IRModule;
+
+        /// Which loops `unrollLoops` unrolls
+    enum class IRLoopUnrollMode
+    {
+        None,                   ///< Don't unroll any loops
+        Explicit,               ///< Only unroll loops marked `[unroll]`
+        All,                    ///< Unroll loops marked `[unroll]`, and other loops that are small enough
+    };
+
+        /// Controls which loops `unrollLoops` unrolls.
+        ///
+        /// The cost of an unrolled loop is the number of instructions in its body times its trip count.
+        ///
+    struct IRLoopUnrollOptions
+    {
+        IRLoopUnrollMode mode = IRLoopUnrollMode::None;
+            /// Loops that aren't marked `[unroll]` are unrolled if they cost at most this much
+        Index maxCost = 0;
+            /// Loops marked `[unroll]` are unrolled if they cost at most this much
+        Index maxExplicitCost = 0;
+
+            /// Get the options to use for an optimization level
+        static IRLoopUnrollOptions getForOptimizationLevel(SlangOptimizationLevel level);
+    };
+
+        /// Fully unroll loops with constant trip counts in `module`.
+        ///
+        /// Unrolling replaces a loop with a copy of its body for each iteration, so that the
+        /// loop counter is a constant in each copy, and values that depend on it can be folded.
+        /// It also means targets that have no way to express `[unroll]` (such as GLSL) get the
+        /// unrolled code.
+        ///
+        /// A loop can be unrolled when
+        /// * Its header tests a comparison between an integer loop counter and a constant
+        /// * The counter starts at a constant, and is stepped by adding or subtracting a constant
+        /// * It has no `break`, and no `continue` other than at the end of the body
+        /// * The unrolled loop doesn't cost more than the options allow
+        ///
+        /// Should be followed by SCCP and DCE, to fold the values that become constant.
+        ///
+        /// Returns the number of loops that were unrolled.
+        ///
+    Index unrollLoops(IRModule* module, const IRLoopUnrollOptions& options);
+}
@@ -4,6 +4,8 @@
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
 
+#include "../core/slang-random-generator.h"
+
 namespace Slang
 {
     struct IRValidateContext
@@ -177,7 +179,19 @@ namespace Slang
         validateIRInstChildren(context, inst);
     }
 
-    void validateIRModule(IRModule* module, DiagnosticSink* sink)
+        /// Find the global value (a child of the module instruction) that `inst` is part of,
+        /// or nullptr if it isn't part of one
+    static IRInst* _findGlobalValue(IRModuleInst* moduleInst, IRInst* inst)
+    {
+        for (; inst; inst = inst->getParent())
+        {
+            if (inst->getParent() == moduleInst)
+                return inst;
+        }
+        return nullptr;
+    }
+
+    void validateIRModule(IRModule* module, DiagnosticSink* sink, IRValidationOptions const& options)
     {
         IRValidateContext contextStorage;
         IRValidateContext* context = &contextStorage;
@@ -191,7 +205,59 @@ namespace Slang
         validate(context, moduleInst->prev == nullptr,      moduleInst, "module instruction prev");
         validate(context, moduleInst->next == nullptr,      moduleInst, "module instruction next");
 
-        validateIRInst(context, module->moduleInst);
+        // With incremental validation, the global values that were touched since the last
+        // validation are validated. The first time around, everything is.
+        //
+        bool validateAll = options.samplePercent >= 100;
+        HashSet<IRInst*> touchedGlobalValues;
+        if (options.incremental)
+        {
+            if (auto instsToValidate = module->getInstsToValidate())
+            {
+                while (auto inst = instsToValidate->takeNext())
+                {
+                    if (auto globalValue = _findGlobalValue(moduleInst, inst))
+                        touchedGlobalValues.Add(globalValue);
+                }
+            }
+            else
+            {
+                validateAll = true;
+                module->beginTrackingInstsToValidate();
+            }
+        }
+
+        // The sample of the other global values is picked with a generator seeded by the
+        // number of times the module has been validated, so it is the same on every run
+        //
+        Mt19937RandomGenerator random(int32_t(module->validationCount++));
+
+        // The links of every global value are checked, as checking a global value itself
+        // only covers the instructions it contains
+        //
+        IRInst* prevChild = nullptr;
+        for (auto child : moduleInst->getDecorationsAndChildren())
+        {
+            validate(context, child->parent == moduleInst,  child, "parent link");
+            validate(context, child->prev == prevChild,     child, "next/prev link");
+            validate(context, !as<IRTerminatorInst>(child), child, "terminator must be last instruction in a block");
+            prevChild = child;
+
+            if (validateAll || touchedGlobalValues.Contains(child) || random.nextInt32UpTo(100) < options.samplePercent)
+            {
+                // Uses of an instruction from the same block are only found in the same global
+                // value, so the instructions seen in other global values aren't needed
+                context->seenInsts.Clear();
+                validateIRInst(context, child);
+            }
+        }
+        validate(context, moduleInst->getLastDecorationOrChild() == prevChild, moduleInst, "last child link");
+    }
+
+    void endIRValidation(IRModule* module)
+    {
+        if (module->getInstsToValidate())
+            module->endTrackingInstsToValidate();
     }
 
     void validateIRModuleIfEnabled(
@@ -201,7 +267,14 @@ namespace Slang
         if (!compileRequest->shouldValidateIR)
             return;
 
+        IRValidationOptions options;
+        options.incremental = compileRequest->shouldValidateIRIncrementally;
+        if (compileRequest->irValidationSamplePercent)
+            options.samplePercent = compileRequest->irValidationSamplePercent;
+        else if (options.incremental)
+            options.samplePercent = 0;
+
         auto sink = compileRequest->getSink();
-        validateIRModule(module, sink);
+        validateIRModule(module, sink, options);
     }
 }
@@ -1,12 +1,28 @@
 // slang-ir-validate.h
 #pragma once
 
+#include "../core/slang-basic.h"
+
 namespace Slang
 {
     class CompileRequestBase;
     class DiagnosticSink;
     struct IRModule;
 
+        /// Options to make IR validation cheaper, by only validating some of the
+        /// global values (functions, types, etc.) in a module
+    struct IRValidationOptions
+    {
+            /// Only validate the global values touched since the module was last validated.
+            /// The first validation of a module validates everything, and starts tracking
+            /// the changes made to the module (until `endIRValidation`).
+        bool incremental = false;
+
+            /// The percentage of the global values that would otherwise be skipped to validate
+            /// anyway. They are picked at random, but the same ones are picked on every run.
+        Int samplePercent = 100;
+    };
+
 
     // Validate that an IR module obeys the invariants we need to enforce.
     // For example:
@@ -25,10 +41,17 @@ namespace Slang
     //   elsewhere in a block.
     //
     // * Confirm that all the parameters of a block come before any "ordinary" instructions.
-    void validateIRModule(IRModule* module, DiagnosticSink* sink);
+    //
+    // The links between the global values of the module are always checked, but
+    // `options` can restrict which global values are themselves validated.
+    void validateIRModule(IRModule* module, DiagnosticSink* sink, IRValidationOptions const& options = IRValidationOptions());
+
+    // Stop tracking the changes made to `module` for incremental validation, once
+    // it will not be validated again. Does nothing if they aren't being tracked.
+    void endIRValidation(IRModule* module);
 
     // A wrapper that calls `validateIRModule` only when IR validation is enabled
-    // for the given compile request.
+    // for the given compile request, with the validation options of the request.
     void validateIRModuleIfEnabled(
         CompileRequestBase* compileRequest,
         IRModule*           module);
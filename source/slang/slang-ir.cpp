@@ -1,9 +1,11 @@
 // slang-ir.cpp
 #include "slang-ir.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-serialize.h"
 
 #include "../core/slang-basic.h"
 
+#include "slang-compile-budget.h"
 #include "slang-mangle.h"
 
 namespace Slang
@@ -111,12 +113,202 @@ namespace Slang
 #endif
     }
 
+    // The number of modules on this thread that observe changes to their
+    // instructions, by tracking dirty instructions or keeping an opcode index.
+    // While it is zero, the hooks below do not need to look up the module.
+    static thread_local int t_observedModuleCount = 0;
+
+    static IRModule* _findObservedModule(IRInst* inst)
+    {
+        if(!t_observedModuleCount || !inst)
+            return nullptr;
+        auto module = inst->getModule();
+        return (module && module->isObserved()) ? module : nullptr;
+    }
+
+    void markIRInstDirty(IRInst* inst)
+    {
+        if(auto module = _findObservedModule(inst))
+        {
+            if(auto dirtyInsts = module->getDirtyInsts())
+                dirtyInsts->add(inst);
+            if(auto instsToValidate = module->getInstsToValidate())
+                instsToValidate->add(inst);
+        }
+    }
+
+    // Only instructions that are in a module are held in the dirty set and the
+    // opcode index, so an instruction (and its descendents) leave both when it
+    // is removed from its parent. This also makes sure a deallocated instruction
+    // is never left in either.
+    static void _removeFromObserversRec(IRDirtyInstSet* dirtyInsts, IROpcodeIndex* opcodeIndex, IRDirtyInstSet* instsToValidate, IRInst* inst)
+    {
+        if(dirtyInsts)
+            dirtyInsts->remove(inst);
+        if(opcodeIndex)
+            opcodeIndex->remove(inst);
+        if(instsToValidate)
+            instsToValidate->remove(inst);
+        for(auto child : inst->getDecorationsAndChildren())
+            _removeFromObserversRec(dirtyInsts, opcodeIndex, instsToValidate, child);
+    }
+
+    static void _addToOpcodeIndexRec(IROpcodeIndex* opcodeIndex, IRInst* inst)
+    {
+        opcodeIndex->add(inst);
+        for(auto child : inst->getDecorationsAndChildren())
+            _addToOpcodeIndexRec(opcodeIndex, child);
+    }
+
+    IRModule::~IRModule()
+    {
+        _destroyLinkSymbols();
+    }
+
+    void IRModule::setLazyReader(IRSerialLazyReader* reader)
+    {
+        SLANG_ASSERT(m_linkSymbols == nullptr);
+        m_lazyReader = reader;
+    }
+
+    static void _numberInstsRec(IRInst* inst, uint32_t& ioIndex)
+    {
+        inst->_setIndexInModule(ioIndex++);
+        for(auto child : inst->getDecorationsAndChildren())
+            _numberInstsRec(child, ioIndex);
+    }
+
+    bool IRModule::compactInstIndices()
+    {
+        if(m_instSetCount)
+            return false;
+
+        uint32_t index = 0;
+        _numberInstsRec(moduleInst, index);
+        m_instIndexCount = index;
+        return true;
+    }
+
+    void IRModule::beginTrackingDirtyInsts()
+    {
+        SLANG_ASSERT(!m_isTrackingDirtyInsts);
+        m_isTrackingDirtyInsts = true;
+        t_observedModuleCount++;
+    }
+
+    void IRModule::endTrackingDirtyInsts()
+    {
+        SLANG_ASSERT(m_isTrackingDirtyInsts);
+        m_isTrackingDirtyInsts = false;
+        t_observedModuleCount--;
+        m_dirtyInsts.clear();
+    }
+
+    void IRModule::beginTrackingInstsToValidate()
+    {
+        SLANG_ASSERT(!m_isTrackingInstsToValidate);
+        m_isTrackingInstsToValidate = true;
+        t_observedModuleCount++;
+    }
+
+    void IRModule::endTrackingInstsToValidate()
+    {
+        SLANG_ASSERT(m_isTrackingInstsToValidate);
+        m_isTrackingInstsToValidate = false;
+        t_observedModuleCount--;
+        m_instsToValidate.clear();
+    }
+
+    void IRModule::_checkBudget()
+    {
+        budget->check(this);
+    }
+
+    void IRModule::enableOpcodeIndex()
+    {
+        if(m_hasOpcodeIndex)
+            return;
+        m_hasOpcodeIndex = true;
+        t_observedModuleCount++;
+        _addToOpcodeIndexRec(&m_opcodeIndex, moduleInst);
+    }
+
+    void IRModule::disableOpcodeIndex()
+    {
+        if(!m_hasOpcodeIndex)
+            return;
+        m_hasOpcodeIndex = false;
+        t_observedModuleCount--;
+        m_opcodeIndex.clear();
+    }
+
+    //
+    // IROpcodeIndex
+    //
+
+    void IROpcodeIndex::add(IRInst* inst)
+    {
+        auto& entry = _getEntry(inst->op);
+        if(entry.insts.Add(inst))
+            entry.order.add(inst);
+    }
+
+    void IROpcodeIndex::remove(IRInst* inst)
+    {
+        UInt opIndex = UInt(inst->op & kIROpMeta_OpMask);
+        if(opIndex >= UInt(m_entries.getCount()))
+            return;
+        m_entries[opIndex].insts.Remove(inst);
+    }
+
+    Index IROpcodeIndex::getCount(IROp op) const
+    {
+        UInt opIndex = UInt(op & kIROpMeta_OpMask);
+        if(opIndex >= UInt(m_entries.getCount()))
+            return 0;
+        return m_entries[opIndex].insts.Count();
+    }
+
+    void IROpcodeIndex::getInsts(IROp op, List<IRInst*>& outInsts)
+    {
+        UInt opIndex = UInt(op & kIROpMeta_OpMask);
+        if(opIndex >= UInt(m_entries.getCount()))
+            return;
+        auto& entry = m_entries[opIndex];
+
+        // Drop entries for instructions that have been removed since
+        // the last time we looked, keeping the order of the rest.
+        Index writeIndex = 0;
+        for(auto inst : entry.order)
+        {
+            if(!entry.insts.Contains(inst))
+                continue;
+            entry.order[writeIndex++] = inst;
+            outInsts.add(inst);
+        }
+        entry.order.setCount(writeIndex);
+    }
+
+    void IROpcodeIndex::clear()
+    {
+        m_entries.clear();
+    }
+
+    IROpcodeIndex::Entry& IROpcodeIndex::_getEntry(IROp op)
+    {
+        UInt opIndex = UInt(op & kIROpMeta_OpMask);
+        if(opIndex >= UInt(m_entries.getCount()))
+            m_entries.setCount(Index(kIROpCount));
+        return m_entries[opIndex];
+    }
+
     void IRUse::init(IRInst* u, IRInst* v)
     {
         clear();
 
         user = u;
         usedValue = v;
+        markIRInstDirty(u);
         if(v)
         {
             nextUse = v->firstUse;
@@ -149,6 +341,11 @@ namespace Slang
         {
             auto uv = usedValue;
 
+            // Both the value (which may now be dead) and its user
+            // (which has a different operand) are affected.
+            markIRInstDirty(uv);
+            markIRInstDirty(user);
+
             *prevLink = nextUse;
             if(nextUse)
             {
@@ -886,17 +1083,32 @@ namespace Slang
         return parent;
     }
 
+    // Allocate zeroed memory for an instruction of sizeInBytes, with its prefix in front of it
+    // (see `IRInst::Prefix`), and give it the next index in the module. The caller must set
+    // `m_hasSourceLocSlot` once the instruction is constructed.
+    static IRInst* _allocateInstMemory(
+        IRModule*       module,
+        size_t          sizeInBytes)
+    {
+        char* mem = (char*)module->memoryArena.allocateAndZero(IRInst::kPrefixSize + sizeInBytes);
+        IRInst* inst = (IRInst*)(mem + IRInst::kPrefixSize);
+        inst->_setIndexInModule(module->allocateInstIndex());
+        return inst;
+    }
+
     IRInst* createEmptyInst(
         IRModule*   module,
         IROp        op,
-        int         totalArgCount)
+        int         totalArgCount,
+        bool        withSourceLocSlot)
     {
         size_t size = sizeof(IRInst) + (totalArgCount) * sizeof(IRUse);
 
         SLANG_ASSERT(module);
-        IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(size);
+        IRInst* inst = _allocateInstMemory(module, size);
 
         inst->operandCount = uint32_t(totalArgCount);
+        inst->m_hasSourceLocSlot = withSourceLocSlot;
         inst->op = op;
 
         return inst;
@@ -905,14 +1117,16 @@ namespace Slang
     IRInst* createEmptyInstWithSize(
         IRModule*   module,
         IROp        op,
-        size_t      totalSizeInBytes)
+        size_t      totalSizeInBytes,
+        bool        withSourceLocSlot)
     {
         SLANG_ASSERT(totalSizeInBytes >= sizeof(IRInst));
 
         SLANG_ASSERT(module);
-        IRInst* inst = (IRInst*)module->memoryArena.allocateAndZero(totalSizeInBytes);
+        IRInst* inst = _allocateInstMemory(module, totalSizeInBytes);
 
         inst->operandCount = 0;
+        inst->m_hasSourceLocSlot = withSourceLocSlot;
         inst->op = op;
 
         return inst;
@@ -968,16 +1182,16 @@ namespace Slang
         inst->insertAtEnd(parent);
     }
 
-    static void maybeSetSourceLoc(
-        IRBuilder*  builder,
-        IRInst*     value)
+    // Get the source location for instructions created by builder
+    static SourceLoc getBuilderSourceLoc(
+        IRBuilder*  builder)
     {
         if(!builder)
-            return;
+            return SourceLoc();
 
         auto sourceLocInfo = builder->sourceLocInfo;
         if(!sourceLocInfo)
-            return;
+            return SourceLoc();
 
         // Try to find something with usable location info
         for(;;)
@@ -991,7 +1205,15 @@ namespace Slang
             sourceLocInfo = sourceLocInfo->next;
         }
 
-        value->sourceLoc = sourceLocInfo->sourceLoc;
+        return sourceLocInfo->sourceLoc;
+    }
+
+    // True if an instruction created by builder with sourceLoc needs space to hold a location
+    static bool needsSourceLocSlot(
+        IRBuilder*  builder,
+        SourceLoc   sourceLoc)
+    {
+        return sourceLoc.isValid() || (builder && builder->reserveSourceLocSlot);
     }
 
     // Create an IR instruction/value and initialize it.
@@ -1023,13 +1245,18 @@ namespace Slang
             size = sizeof(T);
         }
 
+        // Only allocate space for a source location if there is one
+        const SourceLoc sourceLoc = getBuilderSourceLoc(builder);
+
         SLANG_ASSERT(module);
-        T* inst = (T*)module->memoryArena.allocateAndZero(size);
+        const bool withSourceLocSlot = needsSourceLocSlot(builder, sourceLoc);
+        T* inst = (T*)_allocateInstMemory(module, size);
 
         // TODO: Do we need to run ctor after zeroing?
         new(inst)T();
 
         inst->operandCount = (uint32_t)(fixedArgCount + varArgCount);
+        inst->m_hasSourceLocSlot = withSourceLocSlot;
 
         inst->op = op;
 
@@ -1038,7 +1265,7 @@ namespace Slang
             inst->typeUse.init(inst, type);
         }
 
-        maybeSetSourceLoc(builder, inst);
+        inst->setSourceLoc(sourceLoc);
 
         auto operand = inst->getOperands();
 
@@ -1077,18 +1304,22 @@ namespace Slang
         size_t          sizeInBytes)
     {
         auto module = builder->getModule();
-        IRInst* inst = (IRInst*)module->memoryArena.allocate(sizeInBytes);
-        // Zero only the 'type'
-        memset(inst, 0, sizeof(IRInst));
+        const SourceLoc sourceLoc = getBuilderSourceLoc(builder);
+        const bool withSourceLocSlot = needsSourceLocSlot(builder, sourceLoc);
+        IRInst* inst = (IRInst*)((char*)module->memoryArena.allocate(IRInst::kPrefixSize + sizeInBytes) + IRInst::kPrefixSize);
+        // Zero only the prefix and the 'type'
+        memset((char*)inst - IRInst::kPrefixSize, 0, IRInst::kPrefixSize + sizeof(IRInst));
         // TODO: Do we need to run ctor after zeroing?
         new (inst) IRInst;
 
+        inst->m_hasSourceLocSlot = withSourceLocSlot;
+        inst->_setIndexInModule(module->allocateInstIndex());
         inst->op = op;
         if (type)
         {
             inst->typeUse.init(inst, type);
         }
-        maybeSetSourceLoc(builder, inst);
+        inst->setSourceLoc(sourceLoc);
         return inst; 
     }
 
@@ -1260,6 +1491,7 @@ namespace Slang
 
     bool operator==(IRInstKey const& left, IRInstKey const& right)
     {
+        if(left.hashCode != right.hashCode) return false;
         if(left.inst->op != right.inst->op) return false;
         if(left.inst->getFullType() != right.inst->getFullType()) return false;
         if(left.inst->operandCount != right.inst->operandCount) return false;
@@ -1276,19 +1508,19 @@ namespace Slang
         return true;
     }
 
-    int IRInstKey::GetHashCode()
+    /* static */int IRInstKey::calcHashCode(IRInst* inst)
     {
-        auto code = Slang::GetHashCode(inst->op);
-        code = combineHash(code, Slang::GetHashCode(inst->getFullType()));
-        code = combineHash(code, Slang::GetHashCode(inst->getOperandCount()));
-
+        // Combined in 64 bits, so the full operand pointers contribute
         auto argCount = inst->getOperandCount();
+        HashCode64 code = combineHash64(uint64_t(inst->op), uint64_t(argCount));
+        code = combineHash64(code, uint64_t(inst->getFullType()));
+
         auto args = inst->getOperands();
         for( UInt aa = 0; aa < argCount; ++aa )
         {
-            code = combineHash(code, Slang::GetHashCode(args[aa].get()));
+            code = combineHash64(code, uint64_t(args[aa].get()));
         }
-        return code;
+        return foldHashCode64(code);
     }
 
     UnownedStringSlice IRConstant::getStringSlice()
@@ -1550,14 +1782,19 @@ namespace Slang
         // We are going to create a 'dummy' instruction on the memoryArena
         // which can be used as a key for lookup, so see if we
         // already have an equivalent instruction available to use.
+        // (It is allocated as the instruction would be, so that it can become the instruction.)
+        const SourceLoc sourceLoc = getBuilderSourceLoc(builder);
         size_t keySize = sizeof(IRInst) + operandCount * sizeof(IRUse);
-        IRInst* inst = (IRInst*) memoryArena.allocateAndZero(keySize);
+        const bool withSourceLocSlot = needsSourceLocSlot(builder, sourceLoc);
+        // (Its index is only allocated if it becomes the instruction.)
+        IRInst* inst = (IRInst*)((char*)memoryArena.allocateAndZero(IRInst::kPrefixSize + keySize) + IRInst::kPrefixSize);
         
         void* endCursor = memoryArena.getCursor();
         // Mark as 'unused' cos it is unused on release builds. 
         SLANG_UNUSED(endCursor);
 
         new(inst) IRInst();
+        inst->m_hasSourceLocSlot = withSourceLocSlot;
         inst->op = op;
         inst->typeUse.usedValue = type;
         inst->operandCount = (uint32_t) operandCount;
@@ -1578,7 +1815,7 @@ namespace Slang
 
         // Find or add the key/inst
         {
-            IRInstKey key = { inst };
+            IRInstKey key = IRInstKey::make(inst);
 
             // Ideally we would add if not found, else return if was found instead of testing & then adding.
             IRInst** found = builder->sharedBuilder->globalValueNumberingMap.TryGetValueOrAdd(key, inst);
@@ -1586,21 +1823,25 @@ namespace Slang
             // If it's found, just return, and throw away the instruction
             if (found)
             {
+                builder->getModule()->gvnHitCount++;
                 memoryArena.rewindToCursor(cursor);
                 return *found;
             }
+            builder->getModule()->gvnMissCount++;
         }
 
         // Make the lookup 'inst' instruction into 'proper' instruction. Equivalent to
         // IRInst* inst = createInstImpl<IRInst>(builder, op, type, 0, nullptr, operandListCount, listOperandCounts, listOperands);
         {
+            inst->_setIndexInModule(builder->getModule()->allocateInstIndex());
+
             if (type)
             {
                 inst->typeUse.usedValue = nullptr;
                 inst->typeUse.init(inst, type);
             }
 
-            maybeSetSourceLoc(builder, inst);
+            inst->setSourceLoc(sourceLoc);
 
             IRUse*const operands = inst->getOperands();
             for (UInt i = 0; i < operandCount; ++i)
@@ -2249,7 +2490,6 @@ namespace Slang
             this,
             kIROp_Func,
             nullptr);
-        maybeSetSourceLoc(this, rsFunc);
         addGlobalValue(this, rsFunc);
         return rsFunc;
     }
@@ -2262,7 +2502,6 @@ namespace Slang
             this,
             kIROp_GlobalVar,
             ptrType);
-        maybeSetSourceLoc(this, globalVar);
         addGlobalValue(this, globalVar);
         return globalVar;
     }
@@ -2274,7 +2513,6 @@ namespace Slang
             this,
             kIROp_GlobalConstant,
             valueType);
-        maybeSetSourceLoc(this, globalConstant);
         addGlobalValue(this, globalConstant);
         return globalConstant;
     }
@@ -2286,7 +2524,6 @@ namespace Slang
             this,
             kIROp_GlobalParam,
             valueType);
-        maybeSetSourceLoc(this, inst);
         addGlobalValue(this, inst);
         return inst;
     }
@@ -3821,8 +4058,51 @@ namespace Slang
 
     void dumpIR(IRModule* module, ISlangWriter* writer, IRDumpMode mode)
     {
-        String ir = getSlangIRAssembly(module, mode);
-        writer->write(ir.getBuffer(), ir.getLength());
+        dumpIR(module, writer, mode, List<String>());
+    }
+
+    static bool _hasAnyName(IRInst* inst, List<String> const& names)
+    {
+        UnownedStringSlice instNames[2];
+        Index instNameCount = 0;
+        if (auto nameHint = inst->findDecoration<IRNameHintDecoration>())
+            instNames[instNameCount++] = nameHint->getName();
+        if (auto linkage = inst->findDecoration<IRLinkageDecoration>())
+            instNames[instNameCount++] = linkage->getMangledName();
+
+        for (auto& name : names)
+        {
+            for (Index i = 0; i < instNameCount; ++i)
+            {
+                if (name.getUnownedSlice() == instNames[i])
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    void dumpIR(IRModule* module, ISlangWriter* writer, IRDumpMode mode, List<String> const& globalValNames)
+    {
+        StringBuilder sb;
+
+        IRDumpContext context;
+        context.builder = &sb;
+        context.indent = 0;
+        context.mode = mode;
+
+        for (auto ii : module->getGlobalInsts())
+        {
+            if (globalValNames.getCount() && !_hasAnyName(ii, globalValNames))
+                continue;
+
+            dumpInst(&context, ii);
+
+            if (sb.getLength())
+            {
+                writer->write(sb.getBuffer(), sb.getLength());
+                sb.Clear();
+            }
+        }
         writer->flush();
     }
 
@@ -4060,6 +4340,7 @@ namespace Slang
 
             // Swap this use over to use the other value.
             uu->usedValue = other;
+            markIRInstDirty(uu->getUser());
 
             // Try to move to the next use, but bail
             // out if we are at the last one.
@@ -4097,6 +4378,7 @@ namespace Slang
 
         // And `this` will have no uses any more.
         this->firstUse = nullptr;
+        markIRInstDirty(this);
 
         ff->debugValidate();
     }
@@ -4152,6 +4434,16 @@ namespace Slang
         this->prev = inPrev;
         this->next = inNext;
         this->parent = inParent;
+
+        if(auto module = _findObservedModule(this))
+        {
+            if(auto dirtyInsts = module->getDirtyInsts())
+                dirtyInsts->add(this);
+            if(auto instsToValidate = module->getInstsToValidate())
+                instsToValidate->add(this);
+            if(auto opcodeIndex = module->getOpcodeIndex())
+                _addToOpcodeIndexRec(opcodeIndex, this);
+        }
     }
 
     void IRInst::insertAfter(IRInst* other)
@@ -4186,6 +4478,15 @@ namespace Slang
         if(!oldParent)
             return;
 
+        if(auto module = _findObservedModule(this))
+        {
+            _removeFromObserversRec(module->getDirtyInsts(), module->getOpcodeIndex(), module->getInstsToValidate(), this);
+
+            // The links of the children of the old parent have changed
+            if(auto instsToValidate = module->getInstsToValidate())
+                instsToValidate->add(oldParent);
+        }
+
         auto pp = getPrevInst();
         auto nn = getNextInst();
 
@@ -4367,6 +4668,14 @@ namespace Slang
         }
     }
 
+    void IRInst::setSourceLoc(SourceLoc loc)
+    {
+        if (m_hasSourceLocSlot)
+        {
+            _getPrefix()->sourceLoc = loc;
+        }
+    }
+
     IRModule* IRInst::getModule()
     {
         IRInst* ii = this;
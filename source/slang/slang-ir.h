@@ -13,6 +13,7 @@
 
 #include "../core/slang-memory-arena.h"
 #include "../core/slang-object-scope-manager.h"
+#include "../core/slang-uint-set.h"
 
 #include "slang-type-system-shared.h"
 
@@ -24,9 +25,12 @@ class   FuncType;
 class   Layout;
 class   Type;
 class   Session;
+class   CompileBudget;
 class   Name;
 struct  IRBuilder;
 struct  IRFunc;
+struct  IRModuleLinkSymbols;
+struct  IRSerialLazyReader;
 struct  IRGlobalValueWithCode;
 struct  IRInst;
 struct  IRModule;
@@ -236,15 +240,49 @@ struct IRInst
     // instructions that need "vararg" support to
     // allocate this field ahead of the `this`
     // pointer.
-    uint32_t operandCount = 0;
+    uint32_t operandCount : 31;
+
+        /// True if the instruction holds a source location (see `getSourceLoc`).
+        ///
+        /// Only about half of all instructions have a location. Every instruction has space for
+        /// one in front of it though (see `Prefix`), which it shares with the instruction's index.
+    uint32_t m_hasSourceLocSlot : 1;
 
     UInt getOperandCount()
     {
         return operandCount;
     }
 
-    // Source location information for this value, if any
-    SourceLoc sourceLoc;
+        /// The space allocated in front of every instruction, for information that most
+        /// passes don't need. Holding it in front of the instruction, rather than in it,
+        /// keeps the fields of the instruction free of padding.
+    struct Prefix
+    {
+            /// The index of the instruction (see `getIndexInModule`)
+        uint32_t indexInModule;
+            /// The source location, only valid if `m_hasSourceLocSlot` is set
+        SourceLoc sourceLoc;
+    };
+    static const size_t kPrefixSize = sizeof(Prefix);
+    Prefix* _getPrefix() const { return (Prefix*)((char*)this - kPrefixSize); }
+
+        /// The index of the instruction in the module it was created in, so that a set of
+        /// instructions can be held as a bit per index (see `IRInstSet`).
+        ///
+        /// Indices are allocated when instructions are created, and are unique within the module.
+        /// Removed instructions leave gaps, until the module's indices are compacted (see
+        /// `IRModule::compactInstIndices`).
+    UInt getIndexInModule() const { return _getPrefix()->indexInModule; }
+    void _setIndexInModule(UInt index) { _getPrefix()->indexInModule = uint32_t(index); }
+
+        /// Source location information for this value, if any
+    SourceLoc getSourceLoc() const { return m_hasSourceLocSlot ? _getPrefix()->sourceLoc : SourceLoc(); }
+        /// Set the source location. An instruction created without a location (see `createInstImpl`)
+        /// doesn't hold one, so setting a valid location on it has no effect.
+    void setSourceLoc(SourceLoc loc);
+        /// True if the instruction can hold a source location
+    bool hasSourceLocSlot() const { return m_hasSourceLocSlot != 0; }
+
 
     // Each instruction can have zero or more "decorations"
     // attached to it. A decoration is a specialized kind
@@ -1125,11 +1163,108 @@ struct IRModuleInst : IRInst
     IR_LEAF_ISA(Module)
 };
 
+    /// A set of "dirty" instructions in a module: instructions that were created,
+    /// or whose operands or uses changed, since the set was last drained.
+    ///
+    /// Clean-up passes such as DCE and SCCP can visit just these instructions
+    /// rather than traversing the whole module again.
+    ///
+    /// Instructions are handed out in LIFO order, and each instruction is in the
+    /// set at most once. Only instructions that are part of the module are held:
+    /// removing an instruction from its parent also removes it (and its
+    /// descendents) from the set.
+struct IRDirtyInstSet
+{
+        /// Add `inst` to the set, if it isn't already present
+    void add(IRInst* inst)
+    {
+        if(m_set.Add(inst))
+            m_order.add(inst);
+    }
+        /// Remove `inst` from the set, if present
+    void remove(IRInst* inst) { m_set.Remove(inst); }
+
+    bool contains(IRInst* inst) const { return m_set.Contains(inst); }
+    bool isEmpty() const { return m_set.Count() == 0; }
+
+        /// Remove and return an instruction from the set, or nullptr if the set is empty
+    IRInst* takeNext()
+    {
+        while(m_order.getCount())
+        {
+            IRInst* inst = m_order.getLast();
+            m_order.removeLast();
+            if(m_set.Contains(inst))
+            {
+                m_set.Remove(inst);
+                return inst;
+            }
+        }
+        return nullptr;
+    }
+
+        /// Get all instructions in the set, without removing them
+    void getAll(List<IRInst*>& outInsts) const
+    {
+        for(auto inst : m_order)
+        {
+            if(m_set.Contains(inst))
+                outInsts.add(inst);
+        }
+    }
+
+    void clear()
+    {
+        m_set.Clear();
+        m_order.clear();
+    }
+
+protected:
+    HashSet<IRInst*> m_set;
+    List<IRInst*> m_order;          ///< Insertion order. May hold entries that have since been removed from m_set
+};
+
+    /// An index from opcode to the instructions with that opcode in a module.
+    ///
+    /// Lets a pass visit just the instructions it is interested in, or skip a
+    /// module entirely when they are absent.
+struct IROpcodeIndex
+{
+    void add(IRInst* inst);
+    void remove(IRInst* inst);
+
+        /// Get the number of instructions with `op`
+    Index getCount(IROp op) const;
+    bool contains(IROp op) const { return getCount(op) != 0; }
+
+        /// Append the instructions with `op` to `outInsts`, in the order they were added to the module.
+        /// The instructions are copied out, so the pass can modify the module while visiting them.
+    void getInsts(IROp op, List<IRInst*>& outInsts);
+
+    void clear();
+
+protected:
+    struct Entry
+    {
+        HashSet<IRInst*> insts;
+        List<IRInst*> order;        ///< Insertion order. May hold entries that have since been removed from insts
+    };
+
+    Entry& _getEntry(IROp op);
+
+    List<Entry> m_entries;          ///< Indexed by opcode (without the 'other' bits). Empty until something is added.
+};
+
+    /// Record that `inst` is dirty, if its module is tracking dirty instructions.
+    /// Cheap when no module on the current thread is tracking.
+void markIRInstDirty(IRInst* inst);
+
 struct IRModule : RefObject
 {
     enum 
     {
         kMemoryArenaBlockSize = 16 * 1024,           ///< Use 16k block size for memory arena
+        kBudgetCheckInterval = 256,                  ///< Calls to checkBudget between checks. Must be a power of 2.
     };
 
     SLANG_FORCE_INLINE Session* getSession() const { return session; }
@@ -1145,16 +1280,166 @@ struct IRModule : RefObject
         memoryArena(kMemoryArenaBlockSize)
     {
     }
+    ~IRModule();
+
+        /// Start recording created and modified instructions in the dirty instruction set.
+        ///
+        /// Must be paired with `endTrackingDirtyInsts` on the same thread.
+    void beginTrackingDirtyInsts();
+        /// Stop recording dirty instructions and clear the set
+    void endTrackingDirtyInsts();
+
+        /// Get the dirty instruction set, or nullptr if the module is not tracking dirty instructions
+    IRDirtyInstSet* getDirtyInsts() { return m_isTrackingDirtyInsts ? &m_dirtyInsts : nullptr; }
+
+        /// Start recording the instructions touched (created, moved, or with changed operands
+        /// or uses) since the module was last validated, so that validation can skip the
+        /// code that is unchanged (see `validateIRModule`).
+        ///
+        /// Must be paired with `endTrackingInstsToValidate` on the same thread.
+    void beginTrackingInstsToValidate();
+        /// Stop recording touched instructions and clear the set
+    void endTrackingInstsToValidate();
+
+        /// Get the instructions touched since the module was last validated, or nullptr if they are not tracked.
+        /// Unlike the dirty instruction set, this set is only drained by validation.
+    IRDirtyInstSet* getInstsToValidate() { return m_isTrackingInstsToValidate ? &m_instsToValidate : nullptr; }
+
+        /// Build an index from opcode to instructions, and keep it up to date as
+        /// instructions are inserted and removed. Must be disabled on the same thread.
+    void enableOpcodeIndex();
+    void disableOpcodeIndex();
+
+        /// Get the opcode index, or nullptr if it is not enabled
+    IROpcodeIndex* getOpcodeIndex() { return m_hasOpcodeIndex ? &m_opcodeIndex : nullptr; }
+
+        /// True if changes to instructions need to be recorded (by the dirty set, opcode index or validation)
+    bool isObserved() const { return m_isTrackingDirtyInsts || m_hasOpcodeIndex || m_isTrackingInstsToValidate; }
+
+        /// Allocate the index of a new instruction of the module (see `IRInst::getIndexInModule`)
+    uint32_t allocateInstIndex() { return m_instIndexCount++; }
+        /// Get one more than the largest index of an instruction of the module
+    UInt getInstIndexCount() const { return m_instIndexCount; }
+
+        /// Give the instructions of the module consecutive indices again, removing the gaps
+        /// left by removed instructions. Returns false (and does nothing) if any `IRInstSet`
+        /// of the module exists, as it would be invalidated.
+    bool compactInstIndices();
+
+        /// Get the table of the global values of the module by mangled name, used to link
+        /// against it, building it the first time it is needed (implemented in slang-ir-link.cpp).
+        ///
+        /// The table is kept for as long as the module, so a module that is imported by many
+        /// programs (such as one in the session's shared module cache) only builds it once.
+        /// The global values of the module must not change once the table has been built, other
+        /// than by the module's lazy reader (if it has one) creating the values that are looked up.
+    IRModuleLinkSymbols* getLinkSymbols();
+
+        /// Set the reader that creates the global values of the module when they are linked against,
+        /// if the module is read lazily from serial data (see `IRSerialLazyReader`). The module keeps
+        /// the reader alive. Must be set before the link table is built.
+    void setLazyReader(IRSerialLazyReader* reader);
+        /// Get the module's lazy reader, or nullptr if all of its global values have been created
+    IRSerialLazyReader* getLazyReader() const { return m_lazyReader; }
+
+        /// Check the budget of the compile the module is part of, if it has one (see `CompileBudget`).
+        ///
+        /// Cheap enough to call from the inner loops of passes, as the budget is only
+        /// checked every `kBudgetCheckInterval` calls.
+    SLANG_FORCE_INLINE void checkBudget()
+    {
+        if (budget && (++m_budgetCheckCount & (kBudgetCheckInterval - 1)) == 0)
+        {
+            _checkBudget();
+        }
+    }
 
     MemoryArena memoryArena;
 
+        /// The budget of the compile the module is part of. Can be null.
+    CompileBudget* budget = nullptr;
+
+    Index validationCount = 0;  ///< The number of times the module has been validated
+    Int gvnHitCount = 0;        ///< Lookups of hoistable instructions that found an existing instruction
+    Int gvnMissCount = 0;       ///< Lookups of hoistable instructions that created a new instruction
+
     // The compilation session in use.
     Session*    session;
     IRModuleInst* moduleInst;
 
     protected:
+    void _checkBudget();
 
     ObjectScopeManager m_objectScopeManager;
+
+    uint32_t m_budgetCheckCount = 0;
+
+    bool m_isTrackingDirtyInsts = false;
+    IRDirtyInstSet m_dirtyInsts;
+
+    bool m_hasOpcodeIndex = false;
+    IROpcodeIndex m_opcodeIndex;
+    bool m_isTrackingInstsToValidate = false;
+    IRDirtyInstSet m_instsToValidate;
+
+    IRModuleLinkSymbols* m_linkSymbols = nullptr;
+    void _destroyLinkSymbols();
+
+    RefPtr<IRSerialLazyReader> m_lazyReader;
+
+    uint32_t m_instIndexCount = 0;
+    Index m_instSetCount = 0;       ///< The number of `IRInstSet`s of the module that exist
+
+    friend struct IRInstSet;
+};
+
+    /// A set of instructions of a single module, held as a bit per instruction index
+    /// (see `IRInst::getIndexInModule`).
+    ///
+    /// Much smaller and quicker to query than a `HashSet<IRInst*>`, for the sets of visited
+    /// or live instructions of a pass. Instructions created while the set exists can be added.
+    /// Removing an instruction from the module doesn't remove it from the set, but as its index
+    /// isn't reused while the set exists, no other instruction will be found in its place.
+    ///
+struct IRInstSet
+{
+    explicit IRInstSet(IRModule* module):
+        m_module(module)
+    {
+        m_module->m_instSetCount++;
+    }
+    ~IRInstSet()
+    {
+        m_module->m_instSetCount--;
+    }
+
+        /// Add `inst` to the set. Returns true if it wasn't already in the set.
+    bool add(IRInst* inst)
+    {
+        const UInt index = inst->getIndexInModule();
+        if (m_bits.contains(index))
+            return false;
+        if (Int(index) >= m_bits.getCount())
+        {
+            // The bits are allocated as they are needed, so a set that is only used for
+            // a few instructions (such as those of one function) doesn't cost much
+            m_bits.resize(Math::Max(index + 1, UInt(m_bits.getCount()) * 2));
+        }
+        m_bits.add(index);
+        return true;
+    }
+    void remove(IRInst* inst) { m_bits.remove(inst->getIndexInModule()); }
+    bool contains(IRInst* inst) const { return m_bits.contains(inst->getIndexInModule()); }
+
+        /// Remove all of the instructions
+    void clear() { m_bits.clear(); }
+
+protected:
+    IRInstSet(IRInstSet const&) = delete;
+    void operator=(IRInstSet const&) = delete;
+
+    IRModule* m_module;
+    UIntSet m_bits;
 };
 
     /// How much detail to include in dumped IR.
@@ -1186,17 +1471,26 @@ void printSlangIRAssembly(StringBuilder& builder, IRModule* module, IRDumpMode m
 String getSlangIRAssembly(IRModule* module, IRDumpMode mode = IRDumpMode::Simplified);
 
 void dumpIR(IRModule* module, ISlangWriter* writer, IRDumpMode mode = IRDumpMode::Simplified);
+    /// Dump the global values of `module` with one of `globalValNames` (a name hint or exported
+    /// name), or all of them if `globalValNames` is empty.
+    ///
+    /// Each global value is written to `writer` as soon as it is dumped, so the dump of the
+    /// whole module is never held in memory.
+void dumpIR(IRModule* module, ISlangWriter* writer, IRDumpMode mode, List<String> const& globalValNames);
 void dumpIR(IRInst* globalVal, ISlangWriter* writer, IRDumpMode mode = IRDumpMode::Simplified);
 
+    /// Create an instruction with zeroed operands. If withSourceLocSlot is set the instruction can hold a source location.
 IRInst* createEmptyInst(
     IRModule*   module,
     IROp        op,
-    int         totalArgCount);
+    int         totalArgCount,
+    bool        withSourceLocSlot = false);
 
 IRInst* createEmptyInstWithSize(
     IRModule*   module,
     IROp        op,
-    size_t      totalSizeInBytes);
+    size_t      totalSizeInBytes,
+    bool        withSourceLocSlot = false);
 }
 
 #endif
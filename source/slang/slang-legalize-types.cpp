@@ -433,8 +433,13 @@ struct TupleTypeBuilder
             // referenced in the output anyway.
             //
             IRBuilder* builder = context->getBuilder();
-            IRStructType* ordinaryStructType = builder->createStructType();
-            ordinaryStructType->sourceLoc = originalStructType->sourceLoc;
+            IRStructType* ordinaryStructType = nullptr;
+            {
+                // Create the type with the original's location (instructions only have space for one if created with it)
+                IRBuilderSourceLocRAII sourceLocRAII(builder, originalStructType->getSourceLoc());
+                ordinaryStructType = builder->createStructType();
+            }
+            ordinaryStructType->setSourceLoc(originalStructType->getSourceLoc());
 
             if(auto nameHintDecoration = originalStructType->findDecoration<IRNameHintDecoration>())
             {
@@ -1242,6 +1247,25 @@ LegalType legalizeTypeImpl(
         // to construct some kind of proxy type to help resolve
         // the problem.
 
+        // If another module has found that a `struct` with the same
+        // mangled name doesn't need legalizing, we can skip the fields.
+        //
+        IRLinkageDecoration* linkage = nullptr;
+        if(context->cache)
+        {
+            linkage = structType->findDecoration<IRLinkageDecoration>();
+        }
+        if(linkage)
+        {
+            LegalFlavor flavor;
+            if(context->cachedStructFlavors->TryGetValue(String(linkage->getMangledName()), flavor))
+            {
+                context->cache->hitCount++;
+                return flavor == LegalFlavor::simple ? LegalType::simple(type) : LegalType();
+            }
+            context->cache->missCount++;
+        }
+
         TupleTypeBuilder builder;
         builder.context = context;
         builder.type = type;
@@ -1252,7 +1276,16 @@ LegalType legalizeTypeImpl(
             builder.addField(ff);
         }
 
-        return builder.getResult();
+        LegalType legalType = builder.getResult();
+        if(linkage)
+        {
+            // Only the results that don't refer to new instructions
+            // in this module can be shared.
+            //
+            if(legalType.flavor == LegalFlavor::simple || legalType.flavor == LegalFlavor::none)
+                context->cachedStructFlavors->AddIfNotExists(String(linkage->getMangledName()), legalType.flavor);
+        }
+        return legalType;
     }
     else if(auto arrayType = as<IRArrayTypeBase>(type))
     {
@@ -1273,6 +1306,19 @@ LegalType legalizeTypeImpl(
     return LegalType::simple(type);
 }
 
+IRTypeLegalizationCache* TargetProgram::getIRTypeLegalizationCache()
+{
+    if (!m_irTypeLegalizationCache)
+        m_irTypeLegalizationCache = new IRTypeLegalizationCache();
+    return m_irTypeLegalizationCache;
+}
+
+void TargetProgram::destroyIRTypeLegalizationCache()
+{
+    delete m_irTypeLegalizationCache;
+    m_irTypeLegalizationCache = nullptr;
+}
+
 LegalType legalizeType(
     TypeLegalizationContext*    context,
     IRType*                     type)
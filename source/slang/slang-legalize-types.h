@@ -36,6 +36,7 @@ struct IRBuilder;
 
 struct LegalTypeImpl : RefObject
 {
+    SLANG_REF_OBJECT_POOL_ALLOCATED
 };
 struct ImplicitDerefType;
 struct TuplePseudoType;
@@ -133,6 +134,7 @@ struct LegalType
 
 struct LegalElementWrappingObj : RefObject
 {
+    SLANG_REF_OBJECT_POOL_ALLOCATED
 };
 
 struct SimpleLegalElementWrappingObj;
@@ -243,6 +245,8 @@ struct IRStructKey;
 
 struct PairInfo : RefObject
 {
+    SLANG_REF_OBJECT_POOL_ALLOCATED
+
     typedef unsigned int Flags;
     enum
     {
@@ -479,6 +483,7 @@ RefPtr<VarLayout> createSimpleVarLayout(
 
 struct LegalValImpl : RefObject
 {
+    SLANG_REF_OBJECT_POOL_ALLOCATED
 };
 struct TuplePseudoVal;
 struct PairPseudoVal;
@@ -574,6 +579,55 @@ struct WrappedBufferPseudoVal : LegalValImpl
 
 //
 
+    /// Type legalization results shared between the modules for the entry points of a target.
+    ///
+    /// The legalized form of a type is made of instructions in the module being legalized,
+    /// so it can't be reused in another module. Most `struct` types don't need legalizing
+    /// though, and whether a `struct` with linkage does is the same in every module linked
+    /// for the target. Remembering the ones that don't lets later modules skip legalizing
+    /// their fields (recursively).
+    ///
+struct IRTypeLegalizationCache
+{
+        /// Map from the mangled name of a `struct` type to the flavor it legalizes to,
+        /// for the types that legalize to themselves (`simple`) or nothing (`none`).
+    typedef Dictionary<String, LegalFlavor> StructFlavors;
+
+        /// The passes treat different types as special, so each has its own map
+    StructFlavors resourceStructFlavors;        ///< Used by `legalizeResourceTypes`
+    StructFlavors existentialStructFlavors;     ///< Used by `legalizeExistentialTypeLayout`
+
+        /// Identifies the layout of a wrapped buffer: the layout of the original buffer type,
+        /// and the offsets of its pending data relative to its primary data.
+    struct WrappedBufferLayoutKey
+    {
+        RefPtr<TypeLayout> typeLayout;
+        List<VarLayout::ResourceInfo> offsets;
+
+        bool operator==(WrappedBufferLayoutKey const& other) const;
+        int GetHashCode() const;
+    };
+
+        /// Map to the layouts created for wrapped buffers (see `_createWrappedBufferTypeLayout`).
+        ///
+        /// The layout of the element type maps the IR keys of its fields to their layouts,
+        /// so only the layouts of the fields are shared with a module that has other keys.
+    Dictionary<WrappedBufferLayoutKey, RefPtr<ParameterGroupTypeLayout>> wrappedBufferLayouts;
+
+        /// Forget all the results (but not the counts)
+    void clear()
+    {
+        resourceStructFlavors.Clear();
+        existentialStructFlavors.Clear();
+        wrappedBufferLayouts.Clear();
+    }
+
+    Index hitCount = 0;                         ///< The number of `struct` types found in the cache
+    Index missCount = 0;                        ///< The number of `struct` types with linkage that had to be legalized
+    Index wrappedBufferLayoutHitCount = 0;      ///< The number of wrapped buffer layouts found in the cache
+    Index wrappedBufferLayoutMissCount = 0;     ///< The number of wrapped buffer layouts that had to be created
+};
+
     /// Context that drives type legalization
     ///
     /// This type is an abstract base class, and there are
@@ -607,6 +661,10 @@ struct IRTypeLegalizationContext
 
     Dictionary<IRType*, LegalType> mapTypeToLegalType;
 
+        /// If set, the results for `struct` types with linkage that are shared with other modules
+    IRTypeLegalizationCache* cache = nullptr;
+    IRTypeLegalizationCache::StructFlavors* cachedStructFlavors = nullptr;
+
     IRBuilder* getBuilder() { return builder; }
 
         /// Customization point to decide what types are "special."
@@ -662,13 +720,17 @@ LegalType createLegalUniformBufferTypeForExistentials(
 
 
 
+    /// Legalize existential box types. If `cache` is set it is used to share results with other modules.
 void legalizeExistentialTypeLayout(
-    IRModule*       module,
-    DiagnosticSink* sink);
+    IRModule*                   module,
+    DiagnosticSink*             sink,
+    IRTypeLegalizationCache*    cache = nullptr);
 
+    /// Legalize resource types. If `cache` is set it is used to share results with other modules.
 void legalizeResourceTypes(
-    IRModule*       module,
-    DiagnosticSink* sink);
+    IRModule*                   module,
+    DiagnosticSink*             sink,
+    IRTypeLegalizationCache*    cache = nullptr);
 
 bool isResourceType(IRType* type);
 
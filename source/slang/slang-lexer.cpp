@@ -5,6 +5,8 @@
 // input bytes and turning it into semantically useful tokens.
 //
 
+#include "../core/slang-char-scan.h"
+
 #include "slang-compiler.h"
 #include "slang-source-loc.h"
 
@@ -245,6 +247,9 @@ namespace Slang
     {
         for(;;)
         {
+            // Skip over everything that can't end the comment (a backslash may be an escaped newline)
+            lexer->cursor = CharScanUtil::findFirstOf(lexer->cursor, lexer->end, '\n', '\r', '\\');
+
             switch(peek(lexer))
             {
             case '\n': case '\r': case kEOF:
@@ -261,6 +266,10 @@ namespace Slang
     {
         for(;;)
         {
+            // Only a `*` can start the end of the comment (a backslash may be an escaped newline before the `/`).
+            // Line breaks need no handling here, as they are just skipped over.
+            lexer->cursor = CharScanUtil::findFirstOf(lexer->cursor, lexer->end, '*', '\\');
+
             switch(peek(lexer))
             {
             case kEOF:
@@ -294,6 +303,8 @@ namespace Slang
     {
         for(;;)
         {
+            lexer->cursor = CharScanUtil::skipHorizontalSpace(lexer->cursor, lexer->end);
+
             switch(peek(lexer))
             {
             case ' ': case '\t':
@@ -310,6 +321,8 @@ namespace Slang
     {
         for(;;)
         {
+            lexer->cursor = CharScanUtil::findIdentifierEnd(lexer->cursor, lexer->end);
+
             int c = peek(lexer);
             if(('a' <= c ) && (c <= 'z')
                 || ('A' <= c) && (c <= 'Z')
@@ -664,6 +677,9 @@ namespace Slang
     {
         for(;;)
         {
+            // Skip over characters that need no special handling
+            lexer->cursor = CharScanUtil::findFirstOf(lexer->cursor, lexer->end, quote, '\\', '\n', '\r');
+
             int c = peek(lexer);
             if(c == quote)
             {
@@ -1,5 +1,6 @@
 // slang-lookup.cpp
 #include "slang-lookup.h"
+#include "slang-compiler.h"
 #include "slang-name.h"
 
 namespace Slang {
@@ -41,14 +42,28 @@ void buildMemberDictionary(ContainerDecl* decl)
     if (decl->memberDictionaryIsValid)
         return;
 
-    decl->memberDictionary.Clear();
-    decl->transparentMembers.clear();
+    // Members are only ever appended to a container, so we only need
+    // to add the ones that came after the last time the dictionary was
+    // built. (Rebuilding it from scratch as each member is added makes
+    // parsing a module with many global declarations quadratic.)
+    //
+    // If `memberDictionaryMemberCount` has been reset to zero the
+    // dictionary is rebuilt from scratch.
+    //
+    const Index memberCount = decl->Members.getCount();
+    if (decl->memberDictionaryMemberCount == 0 || decl->memberDictionaryMemberCount > memberCount)
+    {
+        decl->memberDictionary.Clear();
+        decl->transparentMembers.clear();
+        decl->memberDictionaryMemberCount = 0;
+    }
 
     // are we a generic?
     GenericDecl* genericDecl = as<GenericDecl>(decl);
 
-    for (auto m : decl->Members)
+    for (Index i = decl->memberDictionaryMemberCount; i < memberCount; ++i)
     {
+        auto m = decl->Members[i];
         auto name = m->getName();
 
         // Add any transparent members to a separate list for lookup
@@ -77,10 +92,63 @@ void buildMemberDictionary(ContainerDecl* decl)
         decl->memberDictionary[name] = m.Ptr();
 
     }
+    decl->memberDictionaryMemberCount = memberCount;
     decl->memberDictionaryIsValid = true;
 }
 
 
+    /// Get the candidate extensions of aggTypeDecl that lookup of name needs to search,
+    /// (re)building the extension member table of aggTypeDecl if it is out of date.
+static List<ExtensionDecl*> const& _getExtensionsForMemberName(AggTypeDecl* aggTypeDecl, Name* name)
+{
+    if (aggTypeDecl->extensionMemberTableHead != aggTypeDecl->candidateExtensions)
+    {
+        aggTypeDecl->extensionsByMemberName.Clear();
+        aggTypeDecl->extensionsForAnyMemberName.clear();
+
+        // Find all of the names first, so the extensions searched for any name can be added
+        // to the list of every name in candidate order
+        for (auto ext = aggTypeDecl->candidateExtensions; ext; ext = ext->nextCandidateExtension)
+        {
+            buildMemberDictionary(ext);
+            for (auto& pair : ext->memberDictionary)
+            {
+                if (!aggTypeDecl->extensionsByMemberName.ContainsKey(pair.Key))
+                {
+                    aggTypeDecl->extensionsByMemberName.Add(pair.Key, List<ExtensionDecl*>());
+                }
+            }
+        }
+
+        for (auto ext = aggTypeDecl->candidateExtensions; ext; ext = ext->nextCandidateExtension)
+        {
+            if (ext->transparentMembers.getCount())
+            {
+                aggTypeDecl->extensionsForAnyMemberName.add(ext);
+                for (auto& pair : aggTypeDecl->extensionsByMemberName)
+                {
+                    pair.Value.add(ext);
+                }
+            }
+            else
+            {
+                for (auto& pair : ext->memberDictionary)
+                {
+                    aggTypeDecl->extensionsByMemberName.TryGetValue(pair.Key)->add(ext);
+                }
+            }
+        }
+
+        aggTypeDecl->extensionMemberTableHead = aggTypeDecl->candidateExtensions;
+    }
+
+    if (auto exts = aggTypeDecl->extensionsByMemberName.TryGetValue(name))
+    {
+        return *exts;
+    }
+    return aggTypeDecl->extensionsForAnyMemberName;
+}
+
 bool DeclPassesLookupMask(Decl* decl, LookupMask mask)
 {
     // type declarations
@@ -358,12 +426,35 @@ void DoLocalLookupImpl(
     // Consider lookup via extension
     if( auto aggTypeDeclRef = containerDeclRef.as<AggTypeDecl>() )
     {
-        RefPtr<Type> type = DeclRefType::Create(
-            session,
-            aggTypeDeclRef);
+        auto aggTypeDecl = aggTypeDeclRef.getDecl();
 
-        for (auto ext = GetCandidateExtensions(aggTypeDeclRef); ext; ext = ext->nextCandidateExtension)
+        // Lookup in an interface also searches the bases of its extensions, so the
+        // extensions that can contribute a member can't be found from their members alone
+        List<ExtensionDecl*> allExts;
+        List<ExtensionDecl*> const* exts = &allExts;
+        if (as<InterfaceDecl>(aggTypeDecl))
+        {
+            for (auto ext = GetCandidateExtensions(aggTypeDeclRef); ext; ext = ext->nextCandidateExtension)
+            {
+                allExts.add(ext);
+            }
+        }
+        else if (aggTypeDecl->candidateExtensions)
         {
+            // Only the extensions with a member with the name are applied, which avoids
+            // unifying with the target type of every extension (types such as `vector`
+            // have a great many)
+            exts = &_getExtensionsForMemberName(aggTypeDecl, name);
+        }
+
+        RefPtr<Type> type;
+        for (auto ext : *exts)
+        {
+            if (!type)
+            {
+                type = DeclRefType::Create(session, aggTypeDeclRef);
+            }
+
             auto extDeclRef = ApplyExtensionToType(request.semantics, ext, type);
             if (!extDeclRef)
                 continue;
@@ -445,11 +536,23 @@ void DoLookupImpl(
     auto endScope   = request.endScope;
     for (;scope != endScope; scope = scope->parent)
     {
+        // Most names looked up from a module aren't declared by the stdlib (locals, and names that
+        // aren't declared at all), so rather than searching each of the stdlib scopes the name is
+        // checked against a table of all the names they declare
+        if (session->isNameUndeclaredInBuiltinScope(scope, name))
+            continue;
+
         // Note that we consider all "peer" scopes together,
         // so that a hit in one of them does not preclude
         // also finding a hit in another
         for(auto link = scope; link; link = link->nextSibling)
         {
+            // Stdlib scopes are populated on first lookup
+            if (session->hasPendingBuiltinModules())
+            {
+                session->loadPendingBuiltinModules(link);
+            }
+
             auto containerDecl = link->containerDecl;
 
             if(!containerDecl)
@@ -6,12 +6,18 @@
 #include "slang-check.h"
 #include "slang-ir.h"
 #include "slang-ir-constexpr.h"
+#include "slang-ir-cse.h"
+#include "slang-ir-dce.h"
+#include "slang-ir-dump.h"
 #include "slang-ir-insts.h"
 #include "slang-ir-missing-return.h"
+#include "slang-ir-pass-manager.h"
 #include "slang-ir-sccp.h"
+#include "slang-ir-sroa.h"
 #include "slang-ir-ssa.h"
 #include "slang-ir-validate.h"
 #include "slang-mangle.h"
+#include "slang-syntax-visitors.h"
 #include "slang-type-layout.h"
 #include "slang-visitor.h"
 
@@ -1706,6 +1712,10 @@ void addVarDecorations(
         {
             builder->addFormatDecoration(inst, formatAttr->format);
         }
+        else if(auto specConstantAttr = as<SpecializationConstantAttribute>(mod))
+        {
+            builder->addSpecializationConstantDecoration(inst, specConstantAttr->id);
+        }
 
         // TODO: what are other modifiers we need to propagate through?
     }
@@ -4475,8 +4485,10 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
         IRGlobalValueWithCode* irGlobal = nullptr;
         LoweredValInfo globalVal;
 
-        // a `static const` global is actually a compile-time constant
-        if (decl->HasModifier<HLSLStaticModifier>() && decl->HasModifier<ConstModifier>())
+        // a `static const` global is actually a compile-time constant, and so
+        // is a specialization constant (which targets can make overridable)
+        if ((decl->HasModifier<HLSLStaticModifier>() && decl->HasModifier<ConstModifier>()) ||
+            decl->HasModifier<SpecializationConstantAttribute>())
         {
             irGlobal = builder->createGlobalConstant(varType);
             globalVal = LoweredValInfo::simple(irGlobal);
@@ -6287,11 +6299,66 @@ static void ensureAllDeclsRec(
     }
 }
 
+    /// Is `decl` a global function that lazy lowering only lowers when it is referenced?
+static bool _isLazilyLoweredFunc(Decl* decl)
+{
+    Decl* inner = decl;
+    if (auto genericDecl = as<GenericDecl>(decl))
+    {
+        inner = genericDecl->inner;
+    }
+    auto funcDecl = as<FuncDecl>(inner);
+    return funcDecl &&
+        !funcDecl->HasModifier<ExportedModifier>() &&
+        !funcDecl->FindModifier<EntryPointAttribute>();
+}
+
+    /// Apply target-independent optimizations to a newly generated `module`.
+    ///
+    /// Each entry point (for each target) is linked into its own module, and the
+    /// code it uses is copied from the modules it references, so the optimizations
+    /// done here aren't repeated on every copy. The passes only change the bodies of
+    /// functions, since other modules may reference any of the global values.
+    ///
+static void _optimizeModuleEarly(
+    FrontEndCompileRequest* compileRequest,
+    IRModule*               module)
+{
+    IRPassManager passManager(module, compileRequest->getLinkage()->getProfiler());
+
+    // Local aggregates are split and promoted, as in `emitEntryPoint`,
+    // and then values that have become constant are folded.
+    //
+    passManager.runPass(IRPassDesc("splitAggregateVars"), [&]()
+    {
+        splitAggregateVars(module);
+    });
+    passManager.runPass(IRPassDesc("constructSSA"), [&]()
+    {
+        constructSSA(module);
+    });
+    passManager.runPass(IRPassDesc("applySparseConditionalConstantPropagation"), [&]()
+    {
+        applySparseConditionalConstantPropagation(module);
+    });
+    passManager.runPass(IRPassDesc("eliminateCommonSubexpressions", IRAnalysisFlag::DominatorTrees), [&]()
+    {
+        eliminateCommonSubexpressions(module, &passManager);
+    });
+    passManager.runPass(IRPassDesc("eliminateDeadCodeInBodies"), [&]()
+    {
+        eliminateDeadCodeInBodies(module);
+    });
+}
+
 IRModule* generateIRForTranslationUnit(
     TranslationUnitRequest* translationUnit)
 {
     auto compileRequest = translationUnit->compileRequest;
 
+    // Any AST nodes created during lowering (such as specialized types) are allocated from the module's arena
+    ASTArenaScope arenaScope(translationUnit->getModule()->getASTArena());
+
     SharedIRGenContext sharedContextStorage(
         translationUnit->getSession(),
         translationUnit->compileRequest->getSink(),
@@ -6313,6 +6380,9 @@ IRModule* generateIRForTranslationUnit(
     IRModule* module = builder->createModule();
     sharedBuilder->module = module;
 
+    // The module can outlive the compile (in a module cache), so the budget is only set while it is generated
+    module->budget = compileRequest->getLinkage()->getBudget();
+
     context->irBuilder = builder;
 
     // We need to emit IR for all public/exported symbols
@@ -6328,14 +6398,41 @@ IRModule* generateIRForTranslationUnit(
         lowerFrontEndEntryPointToIR(context, entryPoint);
     }
 
+    // With lazy lowering, functions are only lowered when they are referenced,
+    // starting from the entry points. Lowering a function lowers everything it
+    // references, so functions that can't be reached are never visited.
+    //
+    const bool lowerReachableFuncsOnly =
+        (compileRequest->compileFlags & SLANG_COMPILE_FLAG_LAZY_LOWERING) &&
+        translationUnit->entryPoints.getCount() != 0;
+
     //
     // Next, ensure that all other global declarations have
     // been emitted.
     for (auto decl : translationUnit->getModuleDecl()->Members)
     {
+        // Functions left unchecked by lazy function checking can't be reached, so are skipped
+        if (getUncheckedGlobalFunction(decl))
+            continue;
+        if (lowerReachableFuncsOnly && _isLazilyLoweredFunc(decl))
+            continue;
         ensureAllDeclsRec(context, decl);
     }
 
+    if (lowerReachableFuncsOnly)
+    {
+        if (auto profiler = compileRequest->getLinkage()->getProfiler())
+        {
+            Int unloweredFuncCount = 0;
+            for (auto decl : translationUnit->getModuleDecl()->Members)
+            {
+                if (_isLazilyLoweredFunc(decl) && !sharedContext->globalEnv.mapDeclToValue.ContainsKey(decl))
+                    unloweredFuncCount++;
+            }
+            profiler->addCounter("unlowered-functions", unloweredFuncCount);
+        }
+    }
+
 #if 0
     fprintf(stderr, "### GENERATED\n");
     dumpIR(module);
@@ -6380,6 +6477,17 @@ IRModule* generateIRForTranslationUnit(
 
     checkForMissingReturns(module, compileRequest->getSink());
 
+    // Once the checks that need dataflow information have been
+    // done, we can optimize the module (unless optimization has
+    // been turned off). The code for the entry points then starts
+    // out from the optimized IR, rather than every entry point
+    // repeating the same work on its own copy.
+    //
+    if (compileRequest->getLinkage()->optimizationLevel != OptimizationLevel::None)
+    {
+        _optimizeModuleEarly(compileRequest, module);
+    }
+
     // TODO: consider doing some more aggressive optimizations
     // (in particular specialization of generics) here, so
     // that we can avoid doing them downstream.
@@ -6390,15 +6498,23 @@ IRModule* generateIRForTranslationUnit(
     // a module we depend on changes.
 
     validateIRModuleIfEnabled(compileRequest, module);
+    endIRValidation(module);
 
     // If we are being sked to dump IR during compilation,
     // then we can dump the initial IR for the module here.
     if(compileRequest->shouldDumpIR)
     {
-        DiagnosticSinkWriter writer(compileRequest->getSink());
-        dumpIR(module, &writer);
+        IRDumper dumper(compileRequest, getText(translationUnit->moduleName));
+        dumper.dumpIfEnabled(module, nullptr);
+    }
+
+    if(auto profiler = compileRequest->getLinkage()->getProfiler())
+    {
+        profiler->addCounter("ir-gvn-hits", module->gvnHitCount);
+        profiler->addCounter("ir-gvn-misses", module->gvnMissCount);
     }
 
+    module->budget = nullptr;
     return module;
 }
 
@@ -35,7 +35,7 @@ namespace Slang
         ManglingContext*    context,
         Name*               name)
     {
-        String str = getText(name);
+        const UnownedStringSlice str = getUnownedStringSliceText(name);
 
         // If the name consists of only traditional "identifer characters"
         // (`[a-zA-Z_]`), then we wnat to emit it more or less directly.
@@ -46,8 +46,7 @@ namespace Slang
 
         // We prefix the string with its byte length, so that
         // decoding doesn't have to worry about finding a terminator.
-        Index length = str.getLength();
-        emit(context, length);
+        emit(context, UInt(str.size()));
         context->sb.append(str);
     }
 
@@ -408,9 +407,19 @@ namespace Slang
 
     String getMangledName(DeclRef<Decl> const& declRef)
     {
+        // The name of a reference to a declaration without substitutions
+        // only depends on the declaration, so it is only worked out once
+        auto decl = declRef.getDecl();
+        if(!declRef.substitutions && decl->mangledName.getLength())
+            return decl->mangledName;
+
         ManglingContext context;
         mangleName(&context, declRef);
-        return context.sb.ProduceString();
+        String mangledName = context.sb.ProduceString();
+
+        if(!declRef.substitutions)
+            decl->mangledName = mangledName;
+        return mangledName;
     }
 
     String getMangledName(DeclRefBase const & declRef)
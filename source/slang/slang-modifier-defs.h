@@ -349,6 +349,17 @@ SYNTAX_CLASS(GLSLBindingAttribute, Attribute)
     FIELD(int32_t, set = 0)
 END_SYNTAX_CLASS()
 
+// [[vk_constant_id]]
+//
+// Marks a global `const` of type `bool`, `int` or `uint` as a specialization
+// constant, whose value can be set when a pipeline is created, instead of
+// being fixed when the code is compiled.
+SYNTAX_CLASS(SpecializationConstantAttribute, Attribute)
+    FIELD(int32_t, id = 0)
+    // The value of the initializer, used when the application doesn't set one
+    FIELD(IntegerLiteralValue, defaultValue = 0)
+END_SYNTAX_CLASS()
+
 // TODO: for attributes that take arguments, the syntax node
 // classes should provide accessors for the values of those arguments.
 
@@ -14,24 +14,41 @@ UnownedStringSlice getUnownedStringSliceText(Name* name)
     return name ? name->text.getUnownedSlice() : UnownedStringSlice();
 }
 
-Name* NamePool::getName(String const& text)
+Name* NamePool::getName(UnownedStringSlice const& text)
 {
     RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
-
-    name = new Name();
-    name->text = text;
-    rootPool->names.Add(text, name);
+    if (!rootPool->names.TryGetValue(text, name))
+    {
+        name = new Name();
+        name->text = text;
+        // The key refers to the text held by the name
+        rootPool->names.Add(name->text.getUnownedSlice(), name);
+        rootPool->textSize += text.size();
+    }
+    _addUse(name);
     return name;
 }
 
-Name* NamePool::tryGetName(String const& text)
+Name* NamePool::tryGetName(UnownedStringSlice const& text)
 {
     RefPtr<Name> name;
-    if (rootPool->names.TryGetValue(text, name))
-        return name;
-    return nullptr;
+    if (!rootPool->names.TryGetValue(text, name))
+        return nullptr;
+    _addUse(name);
+    return name;
+}
+
+NamePool::~NamePool()
+{
+    for (auto name : usedNames)
+    {
+        if (--name->poolUseCount == 0)
+        {
+            // Removing the entry releases the name
+            rootPool->textSize -= size_t(name->text.getLength());
+            rootPool->names.Remove(name->text.getUnownedSlice());
+        }
+    }
 }
 
 } // namespace Slang
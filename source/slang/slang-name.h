@@ -30,6 +30,15 @@ public:
     // of name than "simple" names, and so this might change to a structured
     // ADT instead of a simple string.
     String text;
+
+    // The number of `NamePool`s that have used the name. When it drops
+    // to zero the name is removed from its `RootNamePool`.
+    UInt poolUseCount = 0;
+
+    // Set once a `SyntaxDecl` (a keyword) has been declared with the name.
+    // Most identifiers the parser sees aren't keywords, and this lets it
+    // skip looking them up to find out.
+    bool isSyntaxName = false;
 };
 
 // Get the textual string representation of a name
@@ -46,39 +55,83 @@ UnownedStringSlice getUnownedStringSliceText(Name* name);
 //
 struct RootNamePool
 {
-    // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name> > names;
+    // The mapping from text to the corresponding name.
+    //
+    // The keys are slices of the text of the names themselves, so
+    // that a name can be looked up from a slice (such as the content
+    // of a token) without allocating a `String`.
+    Dictionary<UnownedStringSlice, RefPtr<Name> > names;
+
+    // The number of bytes of text held by `names`
+    size_t textSize = 0;
+
+    // Estimate the bytes held by the names
+    size_t calcMemoryUsed() const { return textSize + size_t(names.Count()) * kNameOverhead; }
+
+    // The bytes held by a name besides its text (the `Name`, its string and its entry in `names`)
+    static const size_t kNameOverhead = sizeof(Name) + sizeof(StringRepresentation) + sizeof(KeyValuePair<UnownedStringSlice, RefPtr<Name>>);
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
 // names that have been created through a `RootNamePool`.
 //
-// The intention is that eventually we will add the ability to clean
-// up a `NamePool`, and remove the names it created from the corresponding
-// `RootNamePool` *if* those names are no longer in use.
+// Each pool records the names it has used, and when the pool is
+// destroyed the names that no other pool has used are removed from
+// the `RootNamePool`. This ensures that the memory usage of a `Session`
+// can't bloat over time just because of multiple `CompileRequest`s
+// being created, used, and then destroyed (each time adding just a
+// few more strings to the name mapping).
 //
-// The goal of such an approach would be to ensure that the memory
-// usage of a `Session` can't bloat over time just because of multiple
-// `CompileRequest`s being created, used, and then destroyed (each time
-// adding just a few more strings to the name mapping).
+// Anything that outlives the pool (such as a cache held by a `Session`)
+// must therefore get its names from a pool that lives at least as long.
 //
 struct NamePool
 {
     // Find or create the `Name` that represents the given `text`.
-    Name* getName(String const& text);
+    Name* getName(UnownedStringSlice const& text);
+    Name* getName(String const& text) { return getName(text.getUnownedSlice()); }
     // Try find the `Name` that represents the given `text`.
     // If the name does not exist, return nullptr
-    Name* tryGetName(String const& text);
+    Name* tryGetName(UnownedStringSlice const& text);
+    Name* tryGetName(String const& text) { return tryGetName(text.getUnownedSlice()); }
     // Set the parent name pool to use for lookup
     void setRootNamePool(RootNamePool* rootNamePool)
     {
+        SLANG_ASSERT(usedNames.Count() == 0);
         this->rootPool = rootNamePool;
     }
 
+    NamePool() = default;
+    ~NamePool();
+
     //
 
     // The root name pool to use for storage/lookup
     RootNamePool* rootPool = nullptr;
+
+    // The names this pool has used
+    HashSet<Name*> usedNames;
+
+    // The number of bytes of text of `usedNames`
+    size_t usedTextSize = 0;
+
+    // Estimate the bytes held by the names this pool has used
+    size_t calcMemoryUsed() const { return usedTextSize + size_t(usedNames.Count()) * RootNamePool::kNameOverhead; }
+
+private:
+    // Record that the pool uses the name
+    void _addUse(Name* name)
+    {
+        if (usedNames.Add(name))
+        {
+            name->poolUseCount++;
+            usedTextSize += size_t(name->text.getLength());
+        }
+    }
+
+    // A pool can't be copied, as each copy would release the names it used
+    NamePool(NamePool const&) = delete;
+    void operator=(NamePool const&) = delete;
 };
 
 } // namespace Slang
@@ -7,8 +7,12 @@
 
 #include "slang-compiler.h"
 #include "slang-profile.h"
+#include "slang-ir-serialize.h"
+#include "../core/slang-io.h"
+#include "../core/slang-string-util.h"
 
 #include <assert.h>
+#include <stdlib.h>
 
 namespace Slang {
 
@@ -370,6 +374,11 @@ struct OptionsParser
             spSetOutputContainerFormat(compileRequest, SLANG_CONTAINER_FORMAT_SLANG_MODULE);
             requestImpl->containerOutputPath = path;
         }
+        else if (path.endsWith(".slang-precompiled"))
+        {
+            spSetOutputContainerFormat(compileRequest, SLANG_CONTAINER_FORMAT_PRECOMPILED_MODULE);
+            requestImpl->containerOutputPath = path;
+        }
         else
         {
             // Allow an unknown-format `-o`, assuming we get a target format
@@ -451,19 +460,214 @@ struct OptionsParser
                 {
                     flags |= SLANG_COMPILE_FLAG_NO_CODEGEN;
                 }
+                else if (argStr == "-reflection-only")
+                {
+                    flags |= SLANG_COMPILE_FLAG_REFLECTION_ONLY;
+                }
+                else if (argStr == "-lazy-function-checking")
+                {
+                    flags |= SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING;
+                }
+                else if (argStr == "-lazy-lowering")
+                {
+                    flags |= SLANG_COMPILE_FLAG_LAZY_LOWERING;
+                }
                 else if(argStr == "-dump-ir" )
                 {
                     requestImpl->getFrontEndReq()->shouldDumpIR = true;
                     requestImpl->getBackEndReq()->shouldDumpIR = true;
                 }
+                else if (argStr == "-dump-ir-dir")
+                {
+                    String path;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, path));
+
+                    requestImpl->getFrontEndReq()->shouldDumpIR = true;
+                    requestImpl->getBackEndReq()->shouldDumpIR = true;
+                    requestImpl->getFrontEndReq()->irDumpOptions.directory = path;
+                    requestImpl->getBackEndReq()->irDumpOptions.directory = path;
+                }
+                else if (argStr == "-dump-ir-func")
+                {
+                    String name;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, name));
+
+                    requestImpl->getFrontEndReq()->shouldDumpIR = true;
+                    requestImpl->getBackEndReq()->shouldDumpIR = true;
+                    requestImpl->getFrontEndReq()->irDumpOptions.globalValNames.add(name);
+                    requestImpl->getBackEndReq()->irDumpOptions.globalValNames.add(name);
+                }
+                else if (argStr == "-dump-ir-changes-only")
+                {
+                    requestImpl->getFrontEndReq()->irDumpOptions.changesOnly = true;
+                    requestImpl->getBackEndReq()->irDumpOptions.changesOnly = true;
+                }
+                else if (argStr == "-dump-ir-binary")
+                {
+                    requestImpl->getFrontEndReq()->irDumpOptions.binary = true;
+                    requestImpl->getBackEndReq()->irDumpOptions.binary = true;
+                }
                 else if (argStr == "-serial-ir")
                 {
                     requestImpl->getFrontEndReq()->useSerialIRBottleneck = true;
                 }
+                else if (argStr == "-serial-ir-compression")
+                {
+                    String name;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, name));
+
+                    IRSerialWriter::StreamOptions streamOptions;
+                    if (SLANG_FAILED(IRSerialUtil::parseStreamOptions(name.getUnownedSlice(), streamOptions)))
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::unknownSerialIRCompression, name);
+                        return SLANG_FAIL;
+                    }
+                    requestImpl->getFrontEndReq()->useSerialIRBottleneck = true;
+                    requestImpl->getFrontEndReq()->serialIRCompression = name;
+                }
+                else if (argStr == "-cache-dir")
+                {
+                    String path;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, path));
+
+                    spSetCompileCacheDirectory(compileRequest, path.getBuffer());
+                }
+                else if (argStr == "-cache-max-size")
+                {
+                    String sizeText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, sizeText));
+
+                    Int sizeInMegabytes = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(sizeText.getUnownedSlice(), sizeInMegabytes)) || sizeInMegabytes < 0)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidCompileCacheSize, sizeText);
+                        return SLANG_FAIL;
+                    }
+
+                    spSetCompileCacheMaxSize(compileRequest, uint64_t(sizeInMegabytes) * 1024 * 1024);
+                }
+                else if (argStr == "-time-limit")
+                {
+                    String secondsText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, secondsText));
+
+                    char* end = nullptr;
+                    const double seconds = strtod(secondsText.getBuffer(), &end);
+                    if (secondsText.getLength() == 0 || *end != 0 || !(seconds >= 0.0))
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidCompileLimit, argStr, secondsText);
+                        return SLANG_FAIL;
+                    }
+
+                    spSetCompileTimeLimit(compileRequest, seconds);
+                }
+                else if (argStr == "-memory-limit")
+                {
+                    String sizeText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, sizeText));
+
+                    Int sizeInMegabytes = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(sizeText.getUnownedSlice(), sizeInMegabytes)) || sizeInMegabytes < 0)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidCompileLimit, argStr, sizeText);
+                        return SLANG_FAIL;
+                    }
+
+                    spSetCompileMemoryLimit(compileRequest, uint64_t(sizeInMegabytes) * 1024 * 1024);
+                }
+                else if (argStr == "-deduplicate-permutations")
+                {
+                    spSetPermutationDeduplicationEnabled(compileRequest, true);
+                }
+                else if (argStr == "-j")
+                {
+                    String countText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, countText));
+
+                    Int jobCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(countText.getUnownedSlice(), jobCount)) || jobCount < 0)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidJobCount, countText);
+                        return SLANG_FAIL;
+                    }
+
+                    spSetBackEndJobCount(compileRequest, int(jobCount));
+                }
+                else if (argStr == "-downstream-jobs")
+                {
+                    String countText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, countText));
+
+                    Int jobCount = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(countText.getUnownedSlice(), jobCount)) || jobCount < 0)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidJobCount, countText);
+                        return SLANG_FAIL;
+                    }
+
+                    spSetDownstreamCompileJobCount(compileRequest, int(jobCount));
+                }
+                else if (argStr == "-preload-downstream")
+                {
+                    requestImpl->shouldPreloadDownstreamLibraries = true;
+                }
+                else if (argStr == "-E")
+                {
+                    spSetPreprocessOnlyMode(compileRequest, SLANG_PREPROCESS_ONLY_SOURCE);
+                }
+                else if (argStr == "-M")
+                {
+                    spSetPreprocessOnlyMode(compileRequest, SLANG_PREPROCESS_ONLY_DEPENDENCIES);
+                }
+                else if (argStr == "-MT")
+                {
+                    String target;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, target));
+
+                    spSetDependencyRuleTarget(compileRequest, target.getBuffer());
+                }
+                else if (argStr == "-time-trace")
+                {
+                    String tracePath;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, tracePath));
+
+                    spSetProfilingEnabled(compileRequest, 1);
+                    requestImpl->profileTracePath = tracePath;
+                }
+                else if (argStr == "-code-report")
+                {
+                    String reportPath;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, reportPath));
+
+                    spSetCodeReportEnabled(compileRequest, 1);
+                    requestImpl->codeReportPath = reportPath;
+                }
                 else if (argStr == "-verbose-paths")
                 {
                     requestImpl->getSink()->flags |= DiagnosticSink::Flag::VerbosePath;
                 }
+                else if (argStr == "-no-warnings")
+                {
+                    requestImpl->getSink()->flags |= DiagnosticSink::Flag::DisableWarnings;
+                }
+                else if (argStr == "-warnings-disable")
+                {
+                    String idsText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, idsText));
+
+                    List<UnownedStringSlice> idTexts;
+                    StringUtil::split(idsText.getUnownedSlice(), ',', idTexts);
+                    for (const auto& idText : idTexts)
+                    {
+                        Int id = 0;
+                        if (SLANG_FAILED(StringUtil::parseInt(idText.trim(), id)))
+                        {
+                            sink->diagnose(SourceLoc(), Diagnostics::invalidDiagnosticId, idText);
+                            return SLANG_FAIL;
+                        }
+                        requestImpl->getSink()->disableDiagnostic(int(id));
+                    }
+                }
                 else if (argStr == "-verify-debug-serial-ir")
                 {
                     requestImpl->getFrontEndReq()->verifyDebugSerialization = true;
@@ -473,6 +677,30 @@ struct OptionsParser
                     requestImpl->getFrontEndReq()->shouldValidateIR = true;
                     requestImpl->getBackEndReq()->shouldValidateIR = true;
                 }
+                else if(argStr == "-validate-ir-incremental" )
+                {
+                    requestImpl->getFrontEndReq()->shouldValidateIR = true;
+                    requestImpl->getBackEndReq()->shouldValidateIR = true;
+                    requestImpl->getFrontEndReq()->shouldValidateIRIncrementally = true;
+                    requestImpl->getBackEndReq()->shouldValidateIRIncrementally = true;
+                }
+                else if(argStr == "-validate-ir-sample" )
+                {
+                    String percentText;
+                    SLANG_RETURN_ON_FAIL(tryReadCommandLineArgument(sink, arg, &argCursor, argEnd, percentText));
+
+                    Int percent = 0;
+                    if (SLANG_FAILED(StringUtil::parseInt(percentText.getUnownedSlice(), percent)) || percent < 1 || percent > 100)
+                    {
+                        sink->diagnose(SourceLoc(), Diagnostics::invalidIRValidationSamplePercent, percentText);
+                        return SLANG_FAIL;
+                    }
+
+                    requestImpl->getFrontEndReq()->shouldValidateIR = true;
+                    requestImpl->getBackEndReq()->shouldValidateIR = true;
+                    requestImpl->getFrontEndReq()->irValidationSamplePercent = percent;
+                    requestImpl->getBackEndReq()->irValidationSamplePercent = percent;
+                }
                 else if(argStr == "-skip-codegen" )
                 {
                     requestImpl->shouldSkipCodegen = true;
@@ -481,6 +709,18 @@ struct OptionsParser
                 {
                     getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_PARAMETER_BLOCKS_USE_REGISTER_SPACES;
                 }
+                else if(argStr == "-emit-spirv-directly" )
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY;
+                }
+                else if(argStr == "-dxil-library" )
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_DXIL_LIBRARY;
+                }
+                else if(argStr == "-short-names" )
+                {
+                    getCurrentTarget()->targetFlags |= SLANG_TARGET_FLAG_SHORT_NAMES;
+                }
                 else if (argStr == "-target")
                 {
                     String name;
@@ -684,6 +924,10 @@ struct OptionsParser
                     {
                         mode = SLANG_LINE_DIRECTIVE_MODE_NONE;
                     }
+                    else if(name == "source-map")
+                    {
+                        mode = SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP;
+                    }
                     else
                     {
                         sink->diagnose(SourceLoc(), Diagnostics::unknownLineDirectiveMode, name);
@@ -789,6 +1033,31 @@ struct OptionsParser
 
         spSetCompileFlags(compileRequest, flags);
 
+        // When only preprocessing, `-o` is where the output is written, rather than
+        // the output of an entry point
+        if (requestImpl->preprocessOnlyMode != SLANG_PREPROCESS_ONLY_NONE && rawOutputs.getCount())
+        {
+            requestImpl->preprocessOutputPath = rawOutputs.getLast().path;
+            rawOutputs.clear();
+        }
+
+        // A precompiled module is imported by the name of its file (`import foo_bar` uses
+        // `foo-bar.slang-precompiled`), and the module has to be compiled with that name
+        if (requestImpl->containerFormat == ContainerFormat::PrecompiledModule)
+        {
+            if (rawTranslationUnits.getCount() != 1)
+            {
+                sink->diagnose(SourceLoc(), Diagnostics::precompiledModuleNeedsOneTranslationUnit);
+                return SLANG_FAIL;
+            }
+
+            String moduleName = Path::getFileNameWithoutExt(requestImpl->containerOutputPath);
+            moduleName = StringUtil::calcCharReplaced(moduleName, '-', '_');
+
+            auto translationUnit = requestImpl->getFrontEndReq()->translationUnits[rawTranslationUnits[0].translationUnitID];
+            translationUnit->moduleName = requestImpl->getNamePool()->getName(moduleName);
+        }
+
         // As a compatability feature, if the user didn't list any explicit entry
         // point names, *and* they are compiling a single translation unit, *and* they
         // have either specified a stage, or we can assume one from the naming
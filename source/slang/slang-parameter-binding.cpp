@@ -21,15 +21,6 @@ struct UsedRange
     UInt begin;
     UInt end;
 };
-bool operator<(UsedRange left, UsedRange right)
-{
-    if (left.begin != right.begin)
-        return left.begin < right.begin;
-    if (left.end != right.end)
-        return left.end < right.end;
-    return false;
-}
-
 static bool rangesOverlap(UsedRange const& x, UsedRange const& y)
 {
     SLANG_ASSERT(x.begin <= x.end);
@@ -48,18 +39,201 @@ static bool rangesOverlap(UsedRange const& x, UsedRange const& y)
 
 struct UsedRanges
 {
-    // The `ranges` array maintains a sorted list of `UsedRange`
-    // objects such that the `end` of a range is <= the `begin`
-    // of any range that comes after it.
+    // The ranges are held in a treap (a binary search tree
+    // that is kept balanced, with high probability, by also
+    // keeping it a heap on a per-node priority) ordered by
+    // `begin`. No two ranges in the tree intersect, so they
+    // are ordered by `end` as well.
     //
     // The values covered by each `[begin,end)` range are marked
     // as used, and anything not in such an interval is implicitly
     // free.
     //
-    // TODO: if it ever starts to matter for performance, we
-    // could encode this information as a tree instead of an array.
+    // Bindless-style code can bind tens of thousands of parameters
+    // in one space, so each node also records the largest free gap
+    // between the ranges in its subtree. That lets us find free space
+    // in `Allocate`, as well as find overlaps in `Add`, in time
+    // logarithmic in the number of ranges.
+    //
+    // Nodes are held in a list and refer to each other by index,
+    // so that a `UsedRanges` can be copied by value (the binding
+    // state is saved and restored around each entry-point group).
+    //
+    struct Node
+    {
+        UsedRange   range;
+
+        // The smallest `begin` and largest `end` in the subtree
+        UInt        minBegin;
+        UInt        maxEnd;
+
+        // The largest gap between two consecutive ranges in the subtree
+        UInt        maxGap;
+
+        Index       left = -1;
+        Index       right = -1;
+        uint32_t    priority;
+    };
+
+    List<Node>  nodes;
+    Index       root = -1;
+
+    Index _createNode(UsedRange const& range)
+    {
+        Index nodeIndex = nodes.getCount();
+
+        Node node;
+        node.range = range;
+        node.minBegin = range.begin;
+        node.maxEnd = range.end;
+        node.maxGap = 0;
+
+        // The priorities only need to look random with respect to the
+        // keys, and deriving them from the index keeps layout deterministic.
+        //
+        uint32_t hash = uint32_t(nodeIndex) * 0x9E3779B1u;
+        hash ^= hash >> 16;
+        node.priority = hash * 0x85EBCA6Bu;
+
+        nodes.add(node);
+        return nodeIndex;
+    }
+
+    // Recompute the summary for the subtree rooted at `nodeIndex`
+    // from its own range and those of its children.
+    //
+    void _update(Index nodeIndex)
+    {
+        Node& node = nodes[nodeIndex];
+        node.minBegin = node.range.begin;
+        node.maxEnd = node.range.end;
+        node.maxGap = 0;
+
+        if (node.left >= 0)
+        {
+            const Node& left = nodes[node.left];
+            node.minBegin = left.minBegin;
+            node.maxGap = Math::Max(left.maxGap, node.range.begin - left.maxEnd);
+        }
+        if (node.right >= 0)
+        {
+            const Node& right = nodes[node.right];
+            node.maxEnd = right.maxEnd;
+            node.maxGap = Math::Max(node.maxGap, Math::Max(right.maxGap, right.minBegin - node.range.end));
+        }
+    }
+
+    // Split the tree rooted at `nodeIndex` into the ranges
+    // that begin before `key`, and those that don't.
+    //
+    void _split(Index nodeIndex, UInt key, Index& outLeft, Index& outRight)
+    {
+        if (nodeIndex < 0)
+        {
+            outLeft = -1;
+            outRight = -1;
+            return;
+        }
+
+        if (nodes[nodeIndex].range.begin < key)
+        {
+            Index right = -1;
+            _split(nodes[nodeIndex].right, key, nodes[nodeIndex].right, right);
+            _update(nodeIndex);
+            outLeft = nodeIndex;
+            outRight = right;
+        }
+        else
+        {
+            Index left = -1;
+            _split(nodes[nodeIndex].left, key, left, nodes[nodeIndex].left);
+            _update(nodeIndex);
+            outLeft = left;
+            outRight = nodeIndex;
+        }
+    }
+
+    // Join two trees, where all of the ranges in `left`
+    // come before all of those in `right`.
+    //
+    Index _merge(Index left, Index right)
+    {
+        if (left < 0) return right;
+        if (right < 0) return left;
+
+        if (nodes[left].priority > nodes[right].priority)
+        {
+            Index merged = _merge(nodes[left].right, right);
+            nodes[left].right = merged;
+            _update(left);
+            return left;
+        }
+        else
+        {
+            Index merged = _merge(left, nodes[right].left);
+            nodes[right].left = merged;
+            _update(right);
+            return right;
+        }
+    }
+
+    // Append the ranges in the tree rooted at `nodeIndex` to `outNodes`, in order.
+    //
+    void _getNodesInOrder(Index nodeIndex, List<Index>& outNodes)
+    {
+        if (nodeIndex < 0)
+            return;
+        _getNodesInOrder(nodes[nodeIndex].left, outNodes);
+        outNodes.add(nodeIndex);
+        _getNodesInOrder(nodes[nodeIndex].right, outNodes);
+    }
+
+    // Find the node for the last range that begins before `key`, or -1 if there isn't one.
+    //
+    Index _findLastBefore(UInt key)
+    {
+        Index found = -1;
+        Index nodeIndex = root;
+        while (nodeIndex >= 0)
+        {
+            if (nodes[nodeIndex].range.begin < key)
+            {
+                found = nodeIndex;
+                nodeIndex = nodes[nodeIndex].right;
+            }
+            else
+            {
+                nodeIndex = nodes[nodeIndex].left;
+            }
+        }
+        return found;
+    }
+
+    // Find the start of the first gap of at least `count` in the subtree
+    // rooted at `nodeIndex`, including the gap between `prevEnd` (the
+    // end of the range before the subtree) and the first range in it.
     //
-    List<UsedRange> ranges;
+    bool _findGap(Index nodeIndex, UInt prevEnd, UInt count, UInt& outBegin)
+    {
+        if (nodeIndex < 0)
+            return false;
+
+        const Node& node = nodes[nodeIndex];
+        if (node.minBegin - prevEnd < count && node.maxGap < count)
+            return false;
+
+        if (_findGap(node.left, prevEnd, count, outBegin))
+            return true;
+
+        UInt begin = node.left >= 0 ? nodes[node.left].maxEnd : prevEnd;
+        if (node.range.begin - begin >= count)
+        {
+            outBegin = begin;
+            return true;
+        }
+
+        return _findGap(node.right, node.range.end, count, outBegin);
+    }
 
     // Add a range to the set, either by extending
     // existing range(s), or by adding a new one.
@@ -72,9 +246,8 @@ struct UsedRanges
     VarLayout* Add(UsedRange range)
     {
         // The invariant on entry to this
-        // function is that the `ranges` array
-        // is sorted and no two entries in the
-        // array intersect. We must preserve
+        // function is that no two ranges in
+        // the tree intersect. We must preserve
         // that property as a postcondition.
         //
         // The other postcondition is that the
@@ -89,71 +262,67 @@ struct UsedRanges
         VarLayout* newParam = range.parameter;
         VarLayout* existingParam = nullptr;
 
-        // A clever algorithm might use a binary
-        // search to identify the first entry in `ranges`
-        // that might overlap `range`, but we are going
-        // to settle for being less clever for now, in
-        // the hopes that we can at least be correct.
+        // The ranges that could overlap `range` are those that
+        // begin inside it, along with the last range that begins
+        // before it (if that range extends into it). Because the
+        // ranges don't intersect, these are consecutive in the
+        // tree, and we split them out as `middle`.
         //
-        // Note: we are going to iterate over `ranges`
-        // using indices, because we may actually modify
-        // the array as we go.
+        UInt splitKey = range.begin;
+        {
+            Index prevIndex = _findLastBefore(range.begin);
+            if (prevIndex >= 0 && nodes[prevIndex].range.end > range.begin)
+            {
+                splitKey = nodes[prevIndex].range.begin;
+            }
+        }
+
+        Index before, rest, middle, after;
+        _split(root, splitKey, before, rest);
+        _split(rest, range.end, middle, after);
+
+        List<Index> middleNodes;
+        _getNodesInOrder(middle, middleNodes);
+
+        // We will rebuild `middle` from the existing ranges
+        // along with any new ones that fill the gaps between
+        // them, in order.
         //
-        Int rangeCount = ranges.getCount();
-        for(Int rr = 0; rr < rangeCount; ++rr)
+        List<Index> newNodes;
+        for (auto existingIndex : middleNodes)
         {
-            auto existingRange = ranges[rr];
+            auto existingRange = nodes[existingIndex].range;
+            newNodes.add(existingIndex);
 
             // The invariant on entry to each loop
             // iteration will be that `range` does
-            // *not* intersect any preceding entry
-            // in the array.
+            // *not* intersect any preceding range.
             //
             // Note that this invariant might be
             // true only because we modified
             // `range` along the way.
             //
-            // If `range` does not intertsect `existingRange`
-            // then our invariant will be trivially
-            // true for the next iteration.
-            //
-            if(!rangesOverlap(existingRange, range))
+            if (range.begin >= range.end || !rangesOverlap(existingRange, range))
             {
                 continue;
             }
 
             // We now know that `range` and `existingRange`
-            // intersect. The first thing to do
-            // is to check if we have a parameter
-            // associated with `existingRange`, so
-            // that we can use it for emitting diagnostics
-            // about the overlap:
+            // intersect, so we check if we have a parameter
+            // associated with `existingRange` that we can
+            // use for emitting diagnostics about the overlap.
             //
             if( existingRange.parameter
                 && existingRange.parameter != newParam)
             {
-                // There was an overlap with a range that
-                // had a parameter specified, so we will
-                // use that parameter in any subsequent
-                // diagnostics.
-                //
                 existingParam = existingRange.parameter;
             }
 
-            // Before we can move on in our iteration,
-            // we need to re-establish our invariant by modifying
-            // `range` so that it doesn't overlap with `existingRange`.
-            // Of course we also want to end up with a correct
-            // result for the overall operation, so we can't just
-            // throw away intervals.
-            //
-            // We first note that if `range` starts before `existingRange`,
+            // If `range` starts before `existingRange`,
             // then the interval from `range.begin` to `existingRange.begin`
-            // needs to be accounted for in the final result. Furthermore,
-            // the interval `[range.begin, existingRange.begin)` could not
-            // intersect with any range already in the `ranges` array,
-            // because it comes strictly before `existingRange`, and our
-            // invariant says there is no intersection with preceding ranges.
+            // needs to be accounted for in the final result. It can't
+            // intersect any other range, because it comes strictly
+            // before `existingRange`, and after any preceding range.
             //
             if(range.begin < existingRange.begin)
             {
@@ -161,48 +330,36 @@ struct UsedRanges
                 prefix.begin = range.begin;
                 prefix.end = existingRange.begin;
                 prefix.parameter = range.parameter;
-                ranges.add(prefix);
+
+                // The prefix goes before `existingRange`
+                newNodes.insert(newNodes.getCount() - 1, _createNode(prefix));
             }
-            //
-            // Now we know that the interval `[range.begin, existingRange.begin)`
-            // is claimed, if it exists, and clearly the interval
-            // `[existingRange.begin, existingRange.end)` is already claimed,
-            // so the only interval left to consider would be
+
+            // The only interval left to consider would then be
             // `[existingRange.end, range.end)`, if it is non-empty.
-            // That range might intersect with others in the array, so
-            // we will need to continue iterating to deal with that
-            // possibility.
             //
             range.begin = existingRange.end;
-
-            // If the range would be empty, then of course we have nothing
-            // left to do.
-            //
-            if(range.begin >= range.end)
-                break;
-
-            // Otherwise, have can be sure that `range` now comes
-            // strictly *after* `existingRange`, and thus our invariant
-            // is preserved.
         }
 
-        // If we manage to exit the loop, then we have resolved
-        // an intersection with existing entries - possibly by
-        // adding some new entries.
-        //
         // If the `range` we are left with is still non-empty,
-        // then we should go ahead and add it.
+        // then it comes after every existing range that it
+        // could overlap, and we should go ahead and add it.
         //
         if(range.begin < range.end)
         {
-            ranges.add(range);
+            newNodes.add(_createNode(range));
         }
 
-        // Any ranges that got added along the way might not
-        // be in the proper sorted order, so we'll need to
-        // sort the array to restore our global invariant.
-        //
-        ranges.sort();
+        middle = -1;
+        for (auto nodeIndex : newNodes)
+        {
+            nodes[nodeIndex].left = -1;
+            nodes[nodeIndex].right = -1;
+            _update(nodeIndex);
+            middle = _merge(middle, nodeIndex);
+        }
+
+        root = _merge(_merge(before, middle), after);
 
         // We end by returning an overlapping parameter that
         // we found along the way, if any.
@@ -230,48 +387,52 @@ struct UsedRanges
 
     bool contains(UInt index)
     {
-        for (auto rr : ranges)
+        // The ranges don't intersect, so we can search
+        // for one containing `index` directly.
+        //
+        Index nodeIndex = root;
+        while (nodeIndex >= 0)
         {
-            if (index < rr.begin)
-                return false;
-
-            if (index >= rr.end)
-                continue;
-
-            return true;
+            auto const& range = nodes[nodeIndex].range;
+            if (index < range.begin)
+            {
+                nodeIndex = nodes[nodeIndex].left;
+            }
+            else if (index >= range.end)
+            {
+                nodeIndex = nodes[nodeIndex].right;
+            }
+            else
+            {
+                return true;
+            }
         }
-
         return false;
     }
 
+    // Get the total number of entries covered by ranges
+    UInt calcUsedCount()
+    {
+        UInt usedCount = 0;
+        for (auto const& node : nodes)
+        {
+            usedCount += node.range.end - node.range.begin;
+        }
+        return usedCount;
+    }
 
     // Try to find space for `count` entries
     UInt Allocate(VarLayout* param, UInt count)
     {
+        // We use the first gap that is large enough, and if
+        // there isn't one we can safely go after the last range.
+        //
         UInt begin = 0;
-
-        UInt rangeCount = ranges.getCount();
-        for (UInt rr = 0; rr < rangeCount; ++rr)
+        if (root >= 0 && !_findGap(root, 0, count, begin))
         {
-            // try to fit in before this range...
-
-            UInt end = ranges[rr].begin;
-
-            // If there is enough space...
-            if (end >= begin + count)
-            {
-                // ... then claim it and be done
-                Add(param, begin, begin + count);
-                return begin;
-            }
-
-            // ... otherwise, we need to look at the
-            // space between this range and the next
-            begin = ranges[rr].end;
+            begin = nodes[root].maxEnd;
         }
 
-        // We've run out of ranges to check, so we
-        // can safely go after the last one!
         Add(param, begin, begin + count);
         return begin;
     }
@@ -686,6 +847,31 @@ static void collectGlobalGenericParameter(
     context->shared->programLayout->globalGenericParamsMap[layout->decl->getName()->text] = layout.Ptr();
 }
 
+// Collect a global constant marked `[[vk::constant_id(...)]]` into the
+// list of specialization constants, which aren't given bindings like
+// other parameters.
+static void collectSpecializationConstant(
+    ParameterBindingContext*    context,
+    VarDecl*                    varDecl,
+    SpecializationConstantAttribute* attr)
+{
+    auto& specializationConstants = context->shared->programLayout->specializationConstants;
+    for( auto const& existing : specializationConstants )
+    {
+        if( existing.id == attr->id )
+        {
+            getSink(context)->diagnose(varDecl, Diagnostics::duplicateSpecializationConstantID, varDecl->getName(), attr->id, existing.varDecl->getName());
+            return;
+        }
+    }
+
+    ProgramLayout::SpecializationConstant specializationConstant;
+    specializationConstant.varDecl = varDecl;
+    specializationConstant.id = attr->id;
+    specializationConstant.defaultValue = attr->defaultValue;
+    specializationConstants.add(specializationConstant);
+}
+
 // Collect a single declaration into our set of parameters
 static void collectGlobalScopeParameter(
     ParameterBindingContext*        context,
@@ -2054,6 +2240,27 @@ static ParameterBindingAndKindInfo maybeAllocateConstantBufferBinding(
     return info;
 }
 
+    /// Compute layouts for any tagged union types among existential type arguments.
+    ///
+    /// A `__TaggedUnion(A, B, ...)` argument binds an existential slot to a closed
+    /// set of types, so that calls through it dispatch on a tag at runtime instead
+    /// of requiring a specialized compile for every concrete type.
+    ///
+static void _collectTaggedUnionTypeLayouts(
+    ParameterBindingContext*            context,
+    Index                               argCount,
+    ExistentialTypeSlots::Arg const*    args,
+    List<RefPtr<TypeLayout>>&           outTypeLayouts)
+{
+    for( Index ii = 0; ii < argCount; ++ii )
+    {
+        auto taggedUnionType = as<TaggedUnionType>(args[ii].type);
+        if( !taggedUnionType )
+            continue;
+        outTypeLayouts.add(createTypeLayout(context->layoutContext, taggedUnionType));
+    }
+}
+
     /// Iterate over the parameters of an entry point to compute its requirements.
     ///
 static RefPtr<EntryPointLayout> collectEntryPointParameters(
@@ -2092,6 +2299,11 @@ static RefPtr<EntryPointLayout> collectEntryPointParameters(
         auto typeLayout = createTypeLayout(context->layoutContext, substType);
         entryPointLayout->taggedUnionTypeLayouts.add(typeLayout);
     }
+    _collectTaggedUnionTypeLayouts(
+        context,
+        entryPoint->getExistentialTypeArgCount(),
+        entryPoint->getExistentialTypeArgs(),
+        entryPointLayout->taggedUnionTypeLayouts);
 
     // We are going to iterate over the entry-point parameters,
     // and while we do so we will go ahead and perform layout/binding
@@ -2257,6 +2469,18 @@ static void collectParameters(
         }
     }
 
+    // Specialization constants aren't shader parameters, but they are
+    // reflected alongside them.
+
+    for(RefPtr<Module> module : program->getModuleDependencies())
+    {
+        for( auto varDecl : module->getModuleDecl()->getMembersOfType<VarDecl>() )
+        {
+            if( auto attr = varDecl->FindModifier<SpecializationConstantAttribute>() )
+                collectSpecializationConstant(context, varDecl, attr);
+        }
+    }
+
     // Once we have enumerated global generic type parameters, we can
     // begin enumerating shader parameters, starting at the global scope.
     //
@@ -2281,6 +2505,16 @@ static void collectParameters(
         collectGlobalScopeParameter(context, globalParamInfo, globalGenericSubst);
     }
 
+    // A tagged union argument for a global existential type parameter
+    // is dispatched on at runtime, and needs a layout just like one
+    // used as a generic argument for an entry point.
+    //
+    _collectTaggedUnionTypeLayouts(
+        context,
+        program->getExistentialTypeArgCount(),
+        program->getExistentialTypeArgs(),
+        context->shared->programLayout->taggedUnionTypeLayouts);
+
     // Next consider parameters for entry points
     for( auto entryPointGroup : program->getEntryPointGroups() )
     {
@@ -2375,13 +2609,252 @@ static int _calcTotalNumUsedRegistersForLayoutResourceKind(ParameterBindingConte
     for (auto& pair : bindingContext->shared->globalSpaceUsedRangeSets)
     {
         UsedRangeSet* rangeSet = pair.Value;
-        const auto& usedRanges = rangeSet->usedResourceRanges[kind];
-        for (const auto& usedRange : usedRanges.ranges)
+        numUsed += int(rangeSet->usedResourceRanges[kind].calcUsedCount());
+    }
+    return numUsed;
+}
+
+    /// Flattens the parameters of a scope into its `bindingTable`.
+    ///
+    /// Offsets are accumulated along the chain of variable layouts from the
+    /// scope down to each leaf, in the same way as when emitting code. Uniform
+    /// offsets start again at zero inside each constant buffer.
+    ///
+struct BindingTableBuilder
+{
+    struct Chain
+    {
+        VarLayout*  varLayout;
+        Chain*      next;
+    };
+
+    List<BindingTableEntry>* m_entries = nullptr;
+
+        /// Names for variable layouts without a declaration, such as the parameters of an entry point
+    Dictionary<VarLayout*, String> m_names;
+
+        /// The struct holding the parameters of the scope being built, and the parameter being walked
+    StructTypeLayout* m_scopeStructLayout = nullptr;
+    Index m_parameterIndex = -1;
+
+    static bool _isBindingKind(LayoutResourceKind kind)
+    {
+        switch( kind )
+        {
+        case LayoutResourceKind::ConstantBuffer:
+        case LayoutResourceKind::ShaderResource:
+        case LayoutResourceKind::UnorderedAccess:
+        case LayoutResourceKind::SamplerState:
+        case LayoutResourceKind::DescriptorTableSlot:
+        case LayoutResourceKind::SpecializationConstant:
+        case LayoutResourceKind::PushConstantBuffer:
+        case LayoutResourceKind::ShaderRecord:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static UInt _getIndex(Chain* chain, LayoutResourceKind kind)
+    {
+        UInt index = 0;
+        for( auto cc = chain; cc; cc = cc->next )
         {
-            numUsed += int(usedRange.end - usedRange.begin);
+            if( auto resInfo = cc->varLayout->FindResourceInfo(kind) )
+                index += resInfo->index;
         }
+        return index;
+    }
+
+    static UInt _getSpace(Chain* chain, LayoutResourceKind kind)
+    {
+        UInt space = 0;
+        for( auto cc = chain; cc; cc = cc->next )
+        {
+            if( auto resInfo = cc->varLayout->FindResourceInfo(kind) )
+                space += resInfo->space;
+            if( auto resInfo = cc->varLayout->FindResourceInfo(LayoutResourceKind::RegisterSpace) )
+                space += resInfo->index;
+        }
+        return space;
+    }
+
+    String _getPath(String const& parentPath, VarLayout* varLayout)
+    {
+        String name;
+        if( varLayout->varDecl )
+            name = getText(varLayout->getName());
+        else
+            m_names.TryGetValue(varLayout, name);
+
+        if( name.getLength() == 0 )
+            return parentPath;
+        if( parentPath.getLength() == 0 )
+            return name;
+        return parentPath + "." + name;
+    }
+
+    void _addVar(
+        VarLayout*      varLayout,
+        Chain*          parentChain,
+        String const&   parentPath,
+        UInt            uniformOffset,
+        LayoutSize      arrayCount,
+        Index           bufferIndex,
+        bool            includeUniform)
+    {
+        Chain chain = { varLayout, parentChain };
+        if( auto resInfo = varLayout->FindResourceInfo(LayoutResourceKind::Uniform) )
+            uniformOffset += resInfo->index;
+
+        _addType(varLayout->typeLayout, &chain, _getPath(parentPath, varLayout), uniformOffset, arrayCount, bufferIndex, includeUniform);
+    }
+
+    void _addLeaf(
+        TypeLayout*     typeLayout,
+        Chain*          chain,
+        String const&   path,
+        UInt            uniformOffset,
+        LayoutSize      arrayCount,
+        Index           bufferIndex,
+        bool            includeUniform)
+    {
+        for( auto& resInfo : typeLayout->resourceInfos )
+        {
+            BindingTableEntry entry;
+            entry.path = path;
+            entry.kind = resInfo.kind;
+            entry.typeLayout = typeLayout;
+            entry.parameterIndex = m_parameterIndex;
+
+            if( resInfo.kind == LayoutResourceKind::Uniform )
+            {
+                if( !includeUniform )
+                    continue;
+                entry.index = uniformOffset;
+                entry.count = resInfo.count;
+                entry.bufferIndex = bufferIndex;
+            }
+            else if( _isBindingKind(resInfo.kind) )
+            {
+                entry.index = _getIndex(chain, resInfo.kind);
+                entry.space = _getSpace(chain, resInfo.kind);
+                entry.count = resInfo.count;
+                entry.count *= arrayCount;
+            }
+            else
+            {
+                continue;
+            }
+            m_entries->add(entry);
+        }
+    }
+
+    void _addType(
+        TypeLayout*     typeLayout,
+        Chain*          chain,
+        String const&   path,
+        UInt            uniformOffset,
+        LayoutSize      arrayCount,
+        Index           bufferIndex,
+        bool            includeUniform)
+    {
+        if( auto parameterGroupTypeLayout = as<ParameterGroupTypeLayout>(typeLayout) )
+        {
+            // The container is a leaf, and holds the uniform data of the element
+            auto containerVarLayout = parameterGroupTypeLayout->containerVarLayout;
+            Chain containerChain = { containerVarLayout, chain };
+
+            const Index containerIndex = m_entries->getCount();
+            _addLeaf(containerVarLayout->typeLayout, &containerChain, path, uniformOffset, arrayCount, bufferIndex, includeUniform);
+            for( Index i = containerIndex; i < m_entries->getCount(); ++i )
+            {
+                (*m_entries)[i].typeLayout = typeLayout;
+                if( (*m_entries)[i].kind != LayoutResourceKind::Uniform )
+                {
+                    bufferIndex = i;
+                    break;
+                }
+            }
+
+            // The uniform data is at the same offsets in every buffer of an array
+            _addVar(parameterGroupTypeLayout->elementVarLayout, chain, path, 0, arrayCount, bufferIndex, true);
+        }
+        else if( auto structTypeLayout = as<StructTypeLayout>(typeLayout) )
+        {
+            for( Index i = 0; i < structTypeLayout->fields.getCount(); ++i )
+            {
+                if( structTypeLayout == m_scopeStructLayout )
+                    m_parameterIndex = i;
+                _addVar(structTypeLayout->fields[i], chain, path, uniformOffset, arrayCount, bufferIndex, includeUniform);
+            }
+            if( structTypeLayout == m_scopeStructLayout )
+                m_parameterIndex = -1;
+        }
+        else if( auto arrayTypeLayout = as<ArrayTypeLayout>(typeLayout) )
+        {
+            auto elementTypeLayout = arrayTypeLayout->elementTypeLayout;
+            if( !as<StructTypeLayout>(elementTypeLayout) && !as<ParameterGroupTypeLayout>(elementTypeLayout) )
+            {
+                _addLeaf(typeLayout, chain, path, uniformOffset, arrayCount, bufferIndex, includeUniform);
+                return;
+            }
+
+            // The uniform data of the whole array is a single leaf, as the elements
+            // of their fields aren't contiguous. The resources of each field are
+            // contiguous across the elements though, so they are found through the element.
+            if( includeUniform )
+            {
+                if( auto resInfo = typeLayout->FindResourceInfo(LayoutResourceKind::Uniform) )
+                {
+                    BindingTableEntry entry;
+                    entry.path = path;
+                    entry.kind = LayoutResourceKind::Uniform;
+                    entry.typeLayout = typeLayout;
+                    entry.index = uniformOffset;
+                    entry.count = resInfo->count;
+                    entry.bufferIndex = bufferIndex;
+                    entry.parameterIndex = m_parameterIndex;
+                    m_entries->add(entry);
+                }
+            }
+
+            auto arrayType = as<ArrayExpressionType>(typeLayout->getType());
+            LayoutSize elementCount = (arrayType && arrayType->ArrayLength)
+                ? LayoutSize(LayoutSize::RawValue(GetIntVal(arrayType->ArrayLength)))
+                : LayoutSize::infinite();
+            elementCount *= arrayCount;
+
+            _addType(elementTypeLayout, chain, path + "[]", uniformOffset, elementCount, bufferIndex, false);
+        }
+        else
+        {
+            _addLeaf(typeLayout, chain, path, uniformOffset, arrayCount, bufferIndex, includeUniform);
+        }
+    }
+
+    void build(ScopeLayout* scopeLayout)
+    {
+        m_entries = &scopeLayout->bindingTable;
+        m_entries->clear();
+        m_scopeStructLayout = getScopeStructLayout(scopeLayout);
+        m_parameterIndex = -1;
+        _addVar(scopeLayout->parametersLayout, nullptr, String(), 0, 1, -1, true);
+    }
+};
+
+static void _buildBindingTables(ProgramLayout* programLayout)
+{
+    BindingTableBuilder builder;
+    builder.build(programLayout);
+
+    // The parameters of each entry point in a group are found under the name of the entry point
+    for( auto entryPointGroup : programLayout->entryPointGroups )
+    {
+        for( auto entryPoint : entryPointGroup->entryPoints )
+            builder.m_names[entryPoint->parametersLayout] = getText(entryPoint->entryPoint->getName());
+        builder.build(entryPointGroup);
     }
-    return numUsed;
 }
 
 RefPtr<ProgramLayout> generateParameterBindings(
@@ -2391,6 +2864,10 @@ RefPtr<ProgramLayout> generateParameterBindings(
     auto program = targetProgram->getProgram();
     auto targetReq = targetProgram->getTargetReq();
 
+    // Many small layouts are made (and many are thrown away as parameters are combined),
+    // so they are allocated from the linkage's pool
+    RefObjectPoolScope poolScope(program->getLinkageImpl()->getRefObjectPool());
+
     RefPtr<ProgramLayout> programLayout = new ProgramLayout();
     programLayout->targetProgram = targetProgram;
 
@@ -2668,6 +3145,9 @@ RefPtr<ProgramLayout> generateParameterBindings(
 
     programLayout->parametersLayout = globalScopeVarLayout;
 
+    // Engines get the flattened bindings of each scope without walking the layouts themselves
+    _buildBindingTables(programLayout);
+
     {
         const int numShaderRecordRegs = _calcTotalNumUsedRegistersForLayoutResourceKind(&context, LayoutResourceKind::ShaderRecord);
         if (numShaderRecordRegs > 1)
@@ -779,6 +779,11 @@ namespace Slang
         Parser* parser,
         Name*   name)
     {
+        // If there has never been syntax declared with this name, then
+        // there's no need to look it up.
+        if (!name || !name->isSyntaxName)
+            return nullptr;
+
         // Let's look up the name and see what we find.
 
         auto lookupResult = lookUp(
@@ -2706,6 +2711,9 @@ namespace Slang
         // TODO: skip creating the declaration if anything failed, just to not screw things
         // up for downstream code?
 
+        if (nameAndLoc.name)
+            nameAndLoc.name->isSyntaxName = true;
+
         RefPtr<SyntaxDecl> syntaxDecl = new SyntaxDecl();
         syntaxDecl->nameAndLoc = nameAndLoc;
         syntaxDecl->loc = nameAndLoc.loc;
@@ -4308,6 +4316,7 @@ namespace Slang
         SyntaxClass<RefObject>      syntaxClass)
     {
         Name* name = session->getNamePool()->getName(nameText);
+        name->isSyntaxName = true;
 
         RefPtr<SyntaxDecl> syntaxDecl = new SyntaxDecl();
         syntaxDecl->nameAndLoc = NameLoc(name);
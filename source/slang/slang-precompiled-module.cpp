@@ -0,0 +1,232 @@
+// slang-precompiled-module.cpp
+#include "slang-precompiled-module.h"
+
+#include "slang-syntax.h"
+
+namespace Slang
+{
+
+typedef PrecompiledModuleBinary Bin;
+
+static void _writeBytes(const void* data, size_t size, List<uint8_t>& out)
+{
+    out.addRange((const uint8_t*)data, Index(size));
+}
+
+static void _writeUInt32(uint32_t value, List<uint8_t>& out)
+{
+    _writeBytes(&value, sizeof(value), out);
+}
+
+static void _writeString(const String& value, List<uint8_t>& out)
+{
+    _writeUInt32(uint32_t(value.getLength()), out);
+    _writeBytes(value.getBuffer(), size_t(value.getLength()), out);
+}
+
+void writePrecompiledModules(const List<PrecompiledModule>& modules, List<uint8_t>& out)
+{
+    out.clear();
+
+    Bin::Header header;
+    header.m_fourCc = Bin::kFourCc;
+    header.m_version = Bin::kVersion;
+    header.m_moduleCount = uint32_t(modules.getCount());
+    header.m_flags = 0;
+    _writeBytes(&header, sizeof(header), out);
+
+    for (const auto& module : modules)
+    {
+        _writeString(module.name, out);
+        _writeString(module.interfaceSource, out);
+
+        _writeUInt32(uint32_t(module.dependencies.getCount()), out);
+        for (const auto& dependency : module.dependencies)
+        {
+            _writeString(dependency.path, out);
+            _writeBytes(&dependency.contentHash, sizeof(dependency.contentHash), out);
+        }
+
+        // The IR is aligned, so that it can be read in place
+        _writeUInt32(uint32_t(module.irSize), out);
+        while (out.getCount() % Bin::kIRAlignment)
+        {
+            out.add(0);
+        }
+        _writeBytes(module.irData, module.irSize, out);
+    }
+}
+
+namespace { // anonymous
+
+struct BinaryReader
+{
+    bool read(void* out, size_t size)
+    {
+        if (size_t(m_end - m_cur) < size)
+        {
+            return false;
+        }
+        ::memcpy(out, m_cur, size);
+        m_cur += size;
+        return true;
+    }
+    bool readString(String& out)
+    {
+        uint32_t size;
+        if (!read(&size, sizeof(size)) || size_t(m_end - m_cur) < size)
+        {
+            return false;
+        }
+        out = String((const char*)m_cur, (const char*)m_cur + size);
+        m_cur += size;
+        return true;
+    }
+    bool skipTo(size_t alignment)
+    {
+        while (size_t(m_cur - m_start) % alignment)
+        {
+            if (m_cur >= m_end)
+            {
+                return false;
+            }
+            m_cur++;
+        }
+        return true;
+    }
+
+    const uint8_t* m_start;
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+};
+
+} // anonymous
+
+SlangResult readPrecompiledModules(const void* data, size_t size, List<PrecompiledModule>& outModules)
+{
+    outModules.clear();
+
+    BinaryReader reader;
+    reader.m_start = (const uint8_t*)data;
+    reader.m_cur = reader.m_start;
+    reader.m_end = reader.m_start + size;
+
+    Bin::Header header;
+    if (!reader.read(&header, sizeof(header)) ||
+        header.m_fourCc != Bin::kFourCc ||
+        header.m_version != Bin::kVersion)
+    {
+        return SLANG_FAIL;
+    }
+
+    for (uint32_t i = 0; i < header.m_moduleCount; ++i)
+    {
+        PrecompiledModule module;
+        uint32_t dependencyCount;
+        if (!reader.readString(module.name) ||
+            !reader.readString(module.interfaceSource) ||
+            !reader.read(&dependencyCount, sizeof(dependencyCount)))
+        {
+            return SLANG_FAIL;
+        }
+        for (uint32_t j = 0; j < dependencyCount; ++j)
+        {
+            PrecompiledModule::Dependency dependency;
+            if (!reader.readString(dependency.path) ||
+                !reader.read(&dependency.contentHash, sizeof(dependency.contentHash)))
+            {
+                return SLANG_FAIL;
+            }
+            module.dependencies.add(dependency);
+        }
+
+        uint32_t irSize;
+        if (!reader.read(&irSize, sizeof(irSize)) ||
+            !reader.skipTo(Bin::kIRAlignment) ||
+            size_t(reader.m_end - reader.m_cur) < irSize)
+        {
+            return SLANG_FAIL;
+        }
+        module.irData = reader.m_cur;
+        module.irSize = irSize;
+        reader.m_cur += irSize;
+
+        outModules.add(module);
+    }
+    return SLANG_OK;
+}
+
+    /// Add the location of the start of the body of every function in decl (including decl) to ioLocs.
+    /// The location of a body is that of the first token after its `{`.
+static void _addBodyLocs(Decl* decl, HashSet<SourceLoc::RawValue>& ioLocs)
+{
+    if (auto funcDecl = as<FunctionDeclBase>(decl))
+    {
+        if (funcDecl->Body && funcDecl->Body->loc.isValid())
+        {
+            ioLocs.Add(funcDecl->Body->loc.getRaw());
+        }
+    }
+    if (auto genericDecl = as<GenericDecl>(decl))
+    {
+        if (genericDecl->inner)
+            _addBodyLocs(genericDecl->inner, ioLocs);
+    }
+    if (auto containerDecl = as<ContainerDecl>(decl))
+    {
+        for (auto member : containerDecl->Members)
+        {
+            _addBodyLocs(member, ioLocs);
+        }
+    }
+}
+
+void appendModuleInterfaceSource(ModuleDecl* moduleDecl, TokenSpan const& tokens, StringBuilder& ioBuilder)
+{
+    HashSet<SourceLoc::RawValue> bodyLocs;
+    _addBodyLocs(moduleDecl, bodyLocs);
+
+    const Token* end = tokens.end();
+    for (const Token* cur = tokens.begin(); cur < end && cur->type != TokenType::EndOfFile; ++cur)
+    {
+        if (cur->type == TokenType::LBrace && cur + 1 < end && bodyLocs.Contains((cur + 1)->loc.getRaw()))
+        {
+            // Skip the body, up to its matching `}`
+            Index depth = 0;
+            for (; cur < end; ++cur)
+            {
+                if (cur->type == TokenType::LBrace)
+                {
+                    depth++;
+                }
+                else if (cur->type == TokenType::RBrace && --depth == 0)
+                {
+                    break;
+                }
+            }
+            if (cur == end)
+            {
+                break;
+            }
+            ioBuilder << ";\n";
+            continue;
+        }
+
+        ioBuilder << cur->Content;
+
+        // Keep the text readable, without changing how it lexes
+        switch (cur->type)
+        {
+            case TokenType::Semicolon:
+            case TokenType::LBrace:
+            case TokenType::RBrace:
+                ioBuilder << "\n";
+                break;
+            default:
+                ioBuilder << " ";
+                break;
+        }
+    }
+}
+
+} // namespace Slang
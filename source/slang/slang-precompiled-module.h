@@ -0,0 +1,76 @@
+// slang-precompiled-module.h
+#ifndef SLANG_PRECOMPILED_MODULE_H
+#define SLANG_PRECOMPILED_MODULE_H
+
+#include "../core/slang-basic.h"
+
+#include "slang-lexer.h"
+
+#ifndef SLANG_FOUR_CC
+#define SLANG_FOUR_CC(c0, c1, c2, c3) ((uint32_t(c0) << 0) | (uint32_t(c1) << 8) | (uint32_t(c2) << 16) | (uint32_t(c3) << 24))
+#endif
+
+namespace Slang
+{
+class ModuleDecl;
+
+    /// The layout of a precompiled module file (`.slang-precompiled`).
+    ///
+    /// A precompiled module holds what `import` needs to use a module without its source. The interface is
+    /// Slang source holding just the declarations of the module (function bodies are removed), which is quick
+    /// to parse and check, and the IR is the module's IR in the serialized IR format, which is used for the
+    /// module as is (rather than being generated from the interface).
+    ///
+    /// The layout (little endian) is
+    /// * Header
+    /// * For each module
+    ///   * The module name, the interface source - each a uint32_t byte count followed by the (UTF-8) text
+    ///   * uint32_t dependency count, then for each dependency the path (as for the name) and a uint64_t hash of its contents
+    ///   * uint32_t byte count of the IR, then padding to a multiple of 8 bytes from the start of the file, then the IR
+struct PrecompiledModuleBinary
+{
+    struct Header
+    {
+        uint32_t m_fourCc;
+        uint32_t m_version;
+        uint32_t m_moduleCount;
+        uint32_t m_flags;           ///< Currently always 0
+    };
+
+    static const uint32_t kFourCc = SLANG_FOUR_CC('S', 'L', 'p', 'm');
+        /// Increment if the layout (or the serialized IR format) changes
+    static const uint32_t kVersion = 2;
+        /// Alignment of the IR from the start of the file
+    static const uint32_t kIRAlignment = 8;
+};
+
+    /// A module in a precompiled module file
+struct PrecompiledModule
+{
+    struct Dependency
+    {
+        String path;
+        uint64_t contentHash;       ///< `getHashCode64` of the contents of the file when the module was compiled
+    };
+
+    String name;
+    String interfaceSource;
+    List<Dependency> dependencies;
+
+    const void* irData = nullptr;   ///< The serialized IR. When read, points into the data that was read.
+    size_t irSize = 0;
+};
+
+    /// Write modules in the precompiled module layout, replacing the contents of out
+void writePrecompiledModules(const List<PrecompiledModule>& modules, List<uint8_t>& out);
+    /// Read the modules of a precompiled module file. The IR of the modules is not copied, so data must stay
+    /// in scope while it is used. Fails if data isn't a valid precompiled module file.
+SlangResult readPrecompiledModules(const void* data, size_t size, List<PrecompiledModule>& outModules);
+
+    /// Append the interface source for tokens, which were parsed into moduleDecl, to ioBuilder.
+    /// The interface is the tokens (after preprocessing) with the bodies of functions replaced by `;`.
+void appendModuleInterfaceSource(ModuleDecl* moduleDecl, TokenSpan const& tokens, StringBuilder& ioBuilder);
+
+} // namespace Slang
+
+#endif
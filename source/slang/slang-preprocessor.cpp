@@ -50,9 +50,69 @@ struct PreprocessorEnvironment
     // The "outer" environment, to be used if lookup in this env fails
     PreprocessorEnvironment*                parent = NULL;
 
-    // Macros defined in this environment
+    // Macros defined in this environment. Add with `addMacro`, so the name filter is kept up to date.
     Dictionary<Name*, PreprocessorMacro*>  macros;
 
+    // A one bit per name bloom filter over the names of `macros`, so that most identifiers that
+    // aren't macros (which is most identifiers) don't need a dictionary lookup. Only used once there
+    // are enough macros for it to be worthwhile. Bits aren't cleared by `#undef`, which just means
+    // some more dictionary lookups.
+    List<uint64_t>                          nameFilter;
+
+    static const Index kMinFilteredMacroCount = 16;
+
+    static uint64_t _getNameFilterHash(Name* name) { return uint64_t(size_t(name)) * 0x9e3779b97f4a7c15ull; }
+
+    void _addToNameFilter(Name* name)
+    {
+        const uint64_t hash = _getNameFilterHash(name) >> 32;
+        const Index bit = Index(hash & uint64_t(nameFilter.getCount() * 64 - 1));
+        nameFilter[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+
+        /// True if there may be a macro called name. False means there definitely isn't.
+    bool mayHaveMacro(Name* name) const
+    {
+        const Index wordCount = nameFilter.getCount();
+        if (wordCount == 0)
+        {
+            return macros.Count() != 0;
+        }
+        const uint64_t hash = _getNameFilterHash(name) >> 32;
+        const Index bit = Index(hash & uint64_t(wordCount * 64 - 1));
+        return (nameFilter[bit >> 6] & (uint64_t(1) << (bit & 63))) != 0;
+    }
+
+    void addMacro(Name* name, PreprocessorMacro* macro)
+    {
+        macros[name] = macro;
+
+        const Index macroCount = Index(macros.Count());
+        if (macroCount < kMinFilteredMacroCount)
+        {
+            return;
+        }
+        // Keep at least 16 bits per macro, so few names that aren't macros pass
+        if (nameFilter.getCount() * 64 < macroCount * 16)
+        {
+            Index wordCount = 4;
+            while (wordCount * 64 < macroCount * 32)
+            {
+                wordCount *= 2;
+            }
+            nameFilter.setCount(wordCount);
+            ::memset(nameFilter.getBuffer(), 0, sizeof(uint64_t) * wordCount);
+            for (auto& pair : macros)
+            {
+                _addToNameFilter(pair.Key);
+            }
+        }
+        else
+        {
+            _addToNameFilter(name);
+        }
+    }
+
     ~PreprocessorEnvironment();
 };
 
@@ -75,6 +135,9 @@ struct PreprocessorInputStream
     // Environment to use when looking up macros
     PreprocessorEnvironment*        environment;
 
+    // Set if the stream is a `MacroExpansion`, which are reused (see `Preprocessor::freeMacroExpansions`)
+    bool                            isMacroExpansion = false;
+
     // Destructor is virtual so that we can clean up
     // after concrete subtypes.
     virtual ~PreprocessorInputStream() = default;
@@ -93,6 +156,23 @@ struct PrimaryInputStream : PreprocessorInputStream
     // The lexer state that will provide input
     Lexer lexer;
 
+    // If set, tokens are read from here instead of being lexed (see `PreprocessorTokenCache`)
+    PreprocessorTokenCache::Entry* cachedTokens = nullptr;
+    Index cachedTokenIndex = 0;
+    // Added to the location of each cached token, to make it a location in the SourceView
+    SourceLoc::RawValue cachedTokenLocBase = 0;
+
+    // The number of tokens read from this stream
+    Index consumedTokenCount = 0;
+
+    // Include guard detection (see `Preprocessor::includeGuards`).
+    // The `#ifndef` conditional that starts the file, if it could be an include guard
+    PreprocessorConditional* includeGuardConditional = nullptr;
+    // The macro tested by the include guard
+    Name* includeGuardName = nullptr;
+    // The value of consumedTokenCount after the `#endif` of the include guard, or -1 if it hasn't been seen
+    Index includeGuardEndTokenCount = -1;
+
     // One token of lookahead
     Token token;
 };
@@ -116,8 +196,13 @@ struct SimpleTokenInputStream : PretokenizedInputStream
 
 struct MacroExpansion : PretokenizedInputStream
 {
+    MacroExpansion() { isMacroExpansion = true; }
+
     // The macro we will expand
     PreprocessorMacro*  macro;
+
+    // Set if this is a `FunctionLikeMacroExpansion`
+    bool                isFunctionLike = false;
 };
 
 struct ObjectLikeMacroExpansion : MacroExpansion
@@ -126,6 +211,8 @@ struct ObjectLikeMacroExpansion : MacroExpansion
 
 struct FunctionLikeMacroExpansion : MacroExpansion
 {
+    FunctionLikeMacroExpansion() { isFunctionLike = true; }
+
     // Environment for macro arguments
     PreprocessorEnvironment     argumentEnvironment;
 };
@@ -190,6 +277,12 @@ struct Preprocessor
     // Currently-defined macros
     PreprocessorEnvironment                 globalEnv;
 
+    // A stream is created for every use of a macro, and a macro for each of its arguments,
+    // so they are kept for reuse once done with, rather than being freed and reallocated
+    List<ObjectLikeMacroExpansion*>         freeObjectLikeExpansions;
+    List<FunctionLikeMacroExpansion*>       freeFunctionLikeExpansions;
+    List<PreprocessorMacro*>                freeArgMacros;
+
     // A pre-allocated token that can be returned to
     // represent end-of-input situations.
     Token                                   endOfFileToken;
@@ -204,6 +297,11 @@ struct Preprocessor
     // stop them from being included again.
     HashSet<String>                         pragmaOnceUniqueIdentities;
 
+    // The unique identities of files that are entirely enclosed in an include guard
+    // (`#ifndef X` ... `#endif`), and the guard macro of each. Including such a file
+    // while the macro is defined has no effect, so the file isn't read again.
+    Dictionary<String, Name*>               includeGuards;
+
     NamePool* getNamePool() { return linkage->getNamePool(); }
     SourceManager* getSourceManager() { return linkage->getSourceManager(); }
 };
@@ -241,16 +339,60 @@ static void initializePrimaryInputStream(Preprocessor* preprocessor, PrimaryInpu
 }
 
 // Destroy an input stream
-static void destroyInputStream(Preprocessor* /*preprocessor*/, PreprocessorInputStream* inputStream)
+static void destroyInputStream(Preprocessor* preprocessor, PreprocessorInputStream* inputStream)
+{
+    if (!inputStream->isMacroExpansion)
+    {
+        delete inputStream;
+        return;
+    }
+
+    // Keep expansions (and the macros for their arguments) for reuse
+    auto expansion = static_cast<MacroExpansion*>(inputStream);
+    if (expansion->isFunctionLike)
+    {
+        auto functionLikeExpansion = static_cast<FunctionLikeMacroExpansion*>(expansion);
+        auto& argEnv = functionLikeExpansion->argumentEnvironment;
+        for (auto& pair : argEnv.macros)
+        {
+            pair.Value->tokens.mTokens.clear();
+            preprocessor->freeArgMacros.add(pair.Value);
+        }
+        argEnv.macros.Clear();
+        preprocessor->freeFunctionLikeExpansions.add(functionLikeExpansion);
+    }
+    else
+    {
+        preprocessor->freeObjectLikeExpansions.add(static_cast<ObjectLikeMacroExpansion*>(expansion));
+    }
+}
+
+// Read the next token from the cached tokens of a primary input stream
+static Token readCachedToken(PrimaryInputStream* inputStream)
 {
-    delete inputStream;
+    const auto& tokens = inputStream->cachedTokens->tokens;
+
+    // Keep returning the end-of-file token once it is reached, as the lexer does
+    Index index = inputStream->cachedTokenIndex;
+    if (index < tokens.getCount() - 1)
+    {
+        inputStream->cachedTokenIndex = index + 1;
+    }
+
+    Token token = tokens[index];
+    token.loc = SourceLoc::fromRaw(token.loc.getRaw() + inputStream->cachedTokenLocBase);
+    return token;
 }
 
 // Create an input stream to represent a pre-tokenized input file.
 // TODO(tfoley): pre-tokenizing files isn't going to work in the long run.
+//
+// If useTokenCache is set, the tokens for the file are taken from the session's
+// `PreprocessorTokenCache` when possible.
 static PreprocessorInputStream* CreateInputStreamForSource(
     Preprocessor*   preprocessor,
-    SourceView*     sourceView)
+    SourceView*     sourceView,
+    bool            useTokenCache = false)
 {
     MemoryArena* memoryArena = sourceView->getSourceManager()->getMemoryArena();
 
@@ -258,7 +400,23 @@ static PreprocessorInputStream* CreateInputStreamForSource(
     initializePrimaryInputStream(preprocessor, inputStream);
 
     // initialize the embedded lexer so that it can generate a token stream
+    // (the lexer's sourceView is also used for directives such as #line, even when tokens are cached)
     inputStream->lexer.initialize(sourceView, GetSink(preprocessor), preprocessor->getNamePool(), memoryArena);
+
+    if (useTokenCache)
+    {
+        // The names of cached tokens are used by later linkages, so they come from the session's pool
+        auto session = preprocessor->linkage->getSessionImpl();
+        auto entry = session->getPreprocessorTokenCache()->getEntry(sourceView, session->getNamePool());
+        if (entry && entry->isReplayable)
+        {
+            inputStream->cachedTokens = entry;
+            inputStream->cachedTokenLocBase = sourceView->getRange().begin.getRaw();
+            inputStream->token = readCachedToken(inputStream);
+            return inputStream;
+        }
+    }
+
     inputStream->token = inputStream->lexer.lexToken();
 
     return inputStream;
@@ -287,6 +445,17 @@ static void EndInputStream(Preprocessor* preprocessor, PreprocessorInputStream*
 {
     if(auto primaryStream = asPrimaryInputStream(inputStream))
     {
+        // If nothing but the end of the `#endif` directive followed the include guard, the file is guarded
+        if (primaryStream->includeGuardEndTokenCount >= 0 &&
+            primaryStream->consumedTokenCount - primaryStream->includeGuardEndTokenCount <= 1)
+        {
+            const String& uniqueIdentity = primaryStream->lexer.sourceView->getSourceFile()->getPathInfo().uniqueIdentity;
+            if (uniqueIdentity.getLength())
+            {
+                preprocessor->includeGuards[uniqueIdentity] = primaryStream->includeGuardName;
+            }
+        }
+
         // If there are any conditionals that weren't completed, then it is an error
         if (primaryStream->conditional)
         {
@@ -312,7 +481,16 @@ static Token AdvanceRawToken(PreprocessorInputStream* inputStream, LexerFlags le
     if( auto primaryStream = asPrimaryInputStream(inputStream) )
     {
         auto result = primaryStream->token;
-        primaryStream->token = primaryStream->lexer.lexToken(lexerFlags);
+        primaryStream->consumedTokenCount++;
+        if (primaryStream->cachedTokens)
+        {
+            // Cached files never need lexerFlags (see `PreprocessorTokenCache::Entry::isReplayable`)
+            primaryStream->token = readCachedToken(primaryStream);
+        }
+        else
+        {
+            primaryStream->token = primaryStream->lexer.lexToken(lexerFlags);
+        }
         return result;
     }
     else
@@ -384,35 +562,26 @@ static Token AdvanceRawToken(Preprocessor* preprocessor, LexerFlags lexerFlags =
     }
 }
 
-// Return the next token in "raw" mode, but don't advance the
-// current token state.
-static Token PeekRawToken(Preprocessor* preprocessor)
+// Find the stream that `AdvanceRawToken` would read from, or nullptr if there is no input left
+static PreprocessorInputStream* findReadInputStream(Preprocessor* preprocessor)
 {
-    // We need to find the stream that `advanceRawToken` would read from.
     PreprocessorInputStream* inputStream = preprocessor->inputStream;
-    for (;;)
+    // The top-most input stream may be at its end, so
+    // look one entry up the stack (don't actually pop
+    // here, since we are just peeking)
+    while (inputStream && inputStream->parent && PeekRawTokenType(inputStream) == TokenType::EndOfFile)
     {
-        if (!inputStream)
-        {
-            // No more input streams left to read
-            return preprocessor->endOfFileToken;
-        }
-
-        // The top-most input stream may be at its end, so
-        // look one entry up the stack (don't actually pop
-        // here, since we are just peeking)
-        if (PeekRawTokenType(inputStream) == TokenType::EndOfFile)
-        {
-            if (inputStream->parent)
-            {
-                inputStream = inputStream->parent;
-                continue;
-            }
-        }
-
-        // Everything worked, so the token we just peeked is fine.
-        return PeekRawToken(inputStream);
+        inputStream = inputStream->parent;
     }
+    return inputStream;
+}
+
+// Return the next token in "raw" mode, but don't advance the
+// current token state.
+static Token PeekRawToken(Preprocessor* preprocessor)
+{
+    PreprocessorInputStream* inputStream = findReadInputStream(preprocessor);
+    return inputStream ? PeekRawToken(inputStream) : preprocessor->endOfFileToken;
 }
 
 // Get the location of the current (raw) token
@@ -421,10 +590,11 @@ static SourceLoc PeekLoc(Preprocessor* preprocessor)
     return PeekRawToken(preprocessor).loc;
 }
 
-// Get the `TokenType` of the current (raw) token
+// Get the `TokenType` of the current (raw) token. Doesn't copy the token, as this is called for every token.
 static TokenType PeekRawTokenType(Preprocessor* preprocessor)
 {
-    return PeekRawToken(preprocessor).type;
+    PreprocessorInputStream* inputStream = findReadInputStream(preprocessor);
+    return inputStream ? PeekRawTokenType(inputStream) : preprocessor->endOfFileToken.type;
 }
 
 //
@@ -455,6 +625,9 @@ static PreprocessorMacro* LookupMacro(PreprocessorEnvironment* environment, Name
 {
     for(PreprocessorEnvironment* e = environment; e; e = e->parent)
     {
+        if (!e->mayHaveMacro(name))
+            continue;
+
         PreprocessorMacro* macro = NULL;
         if (e->macros.TryGetValue(name, macro))
             return macro;
@@ -597,13 +770,13 @@ static void MaybeBeginMacroExpansion(
     // macro may be another macro invocation.
     for (;;)
     {
-        // Look at the next token ahead of us
-        Token token = PeekRawToken(preprocessor);
-
         // Not an identifier? Can't be a macro.
-        if (token.type != TokenType::Identifier)
+        if (PeekRawTokenType(preprocessor) != TokenType::Identifier)
             return;
 
+        // Look at the next token ahead of us
+        Token token = PeekRawToken(preprocessor);
+
         // Look for a macro with the given name.
         Name* name = token.getName();
         PreprocessorMacro* macro = LookupMacro(preprocessor, name);
@@ -653,7 +826,16 @@ static void MaybeBeginMacroExpansion(
             // Consume the opening `(`
             Token leftParen = AdvanceRawToken(preprocessor);
 
-            FunctionLikeMacroExpansion* expansion = new FunctionLikeMacroExpansion();
+            FunctionLikeMacroExpansion* expansion;
+            if (preprocessor->freeFunctionLikeExpansions.getCount())
+            {
+                expansion = preprocessor->freeFunctionLikeExpansions.getLast();
+                preprocessor->freeFunctionLikeExpansions.removeLast();
+            }
+            else
+            {
+                expansion = new FunctionLikeMacroExpansion();
+            }
             InitializeMacroExpansion(preprocessor, expansion, macro);
             expansion->argumentEnvironment.parent = &preprocessor->globalEnv;
             expansion->environment = &expansion->argumentEnvironment;
@@ -676,7 +858,16 @@ static void MaybeBeginMacroExpansion(
                     // Read an argument
 
                     // Create the argument, represented as a special flavor of macro
-                    PreprocessorMacro* arg = CreateMacro(preprocessor);
+                    PreprocessorMacro* arg;
+                    if (preprocessor->freeArgMacros.getCount())
+                    {
+                        arg = preprocessor->freeArgMacros.getLast();
+                        preprocessor->freeArgMacros.removeLast();
+                    }
+                    else
+                    {
+                        arg = CreateMacro(preprocessor);
+                    }
                     arg->flavor = PreprocessorMacroFlavor::FunctionArg;
                     arg->environment = GetCurrentEnvironment(preprocessor);
 
@@ -684,7 +875,7 @@ static void MaybeBeginMacroExpansion(
                     NameLoc paramNameAndLoc = macro->params[argIndex];
                     Name* paramName = paramNameAndLoc.name;
                     arg->nameAndLoc = paramNameAndLoc;
-                    expansion->argumentEnvironment.macros[paramName] = arg;
+                    expansion->argumentEnvironment.addMacro(paramName, arg);
                     argIndex++;
 
                     // Read tokens for the argument
@@ -776,7 +967,16 @@ static void MaybeBeginMacroExpansion(
             AdvanceRawToken(preprocessor);
 
             // Object-like macros are the easy case.
-            ObjectLikeMacroExpansion* expansion = new ObjectLikeMacroExpansion();
+            ObjectLikeMacroExpansion* expansion;
+            if (preprocessor->freeObjectLikeExpansions.getCount())
+            {
+                expansion = preprocessor->freeObjectLikeExpansions.getLast();
+                preprocessor->freeObjectLikeExpansions.removeLast();
+            }
+            else
+            {
+                expansion = new ObjectLikeMacroExpansion();
+            }
             InitializeMacroExpansion(preprocessor, expansion, macro);
             PushMacroExpansion(preprocessor, expansion);
         }
@@ -902,6 +1102,9 @@ struct PreprocessorDirectiveContext
     // Have we done the necessary checks at the end
     // of the directive already?
     bool            haveDoneEndOfDirectiveChecks;
+
+    // Is the `#` of the directive the first token of its file?
+    bool            isAtStartOfFile = false;
 };
 
 // Get the token for  the preprocessor directive being parsed.
@@ -1434,6 +1637,14 @@ static void HandleIfNDefDirective(PreprocessorDirectiveContext* context)
 
     // Check if the name is defined.
     beginConditional(context, LookupMacro(context, name) == NULL);
+
+    // A file that starts with `#ifndef` may be wrapped in an include guard
+    if (context->isAtStartOfFile)
+    {
+        PrimaryInputStream* primaryStream = context->preprocessor->inputStream->primaryStream;
+        primaryStream->includeGuardConditional = primaryStream->conditional;
+        primaryStream->includeGuardName = name;
+    }
 }
 
 // Handle a `#else` directive
@@ -1459,6 +1670,12 @@ static void HandleElseDirective(PreprocessorDirectiveContext* context)
     }
     conditional->elseToken = context->directiveToken;
 
+    // The file is not skipped if the guard macro is defined, so it isn't an include guard
+    if (conditional == inputStream->primaryStream->includeGuardConditional)
+    {
+        inputStream->primaryStream->includeGuardConditional = nullptr;
+    }
+
     switch (conditional->state)
     {
     case PreprocessorConditionalState::Before:
@@ -1512,6 +1729,11 @@ static void HandleElifDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    if (conditional == inputStream->primaryStream->includeGuardConditional)
+    {
+        inputStream->primaryStream->includeGuardConditional = nullptr;
+    }
+
     switch (conditional->state)
     {
     case PreprocessorConditionalState::Before:
@@ -1542,7 +1764,15 @@ static void HandleEndIfDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
-    inputStream->primaryStream->conditional = conditional->parent;
+    PrimaryInputStream* primaryStream = inputStream->primaryStream;
+    if (conditional == primaryStream->includeGuardConditional)
+    {
+        // Only the end of this directive may follow for the file to be guarded (see `EndInputStream`)
+        primaryStream->includeGuardConditional = nullptr;
+        primaryStream->includeGuardEndTokenCount = primaryStream->consumedTokenCount;
+    }
+
+    primaryStream->conditional = conditional->parent;
     DestroyConditional(conditional);
 }
 
@@ -1650,6 +1880,14 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         return;
     }
 
+    // If the file is wrapped in an include guard whose macro is defined, including it does nothing
+    Name* includeGuardName = nullptr;
+    if (context->preprocessor->includeGuards.TryGetValue(filePathInfo.uniqueIdentity, includeGuardName) &&
+        LookupMacro(&context->preprocessor->globalEnv, includeGuardName))
+    {
+        return;
+    }
+
     // Simplify the path
     filePathInfo.foundPath = includeHandler->simplifyPath(filePathInfo.foundPath);
 
@@ -1673,11 +1911,38 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         sourceFile = sourceManager->createSourceFileWithBlob(filePathInfo, foundSourceBlob);
         sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
     }
+    else if (!sourceFile->hasContent())
+    {
+        // The contents were released when the modules that included the file were
+        // compacted (see `Module::compact`), so are read again
+        ComPtr<ISlangBlob> foundSourceBlob;
+        if (SLANG_FAILED(readFile(context, filePathInfo.foundPath, foundSourceBlob.writeRef())))
+        {
+            GetSink(context)->diagnose(pathToken.loc, Diagnostics::includeFailed, path);
+            return;
+        }
+
+        // The file may have changed, so the released file is kept for the locations that
+        // use its line breaks, and is replaced by a new file for this include
+        SourceFile* releasedSourceFile = sourceFile;
+        sourceFile = sourceManager->createSourceFileWithBlob(filePathInfo, foundSourceBlob);
+        if (sourceManager->findSourceFile(filePathInfo.uniqueIdentity) == releasedSourceFile)
+        {
+            sourceManager->removeSourceFile(filePathInfo.uniqueIdentity);
+            sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
+        }
+    }
+
+    if (auto module = context->preprocessor->parentModule)
+    {
+        module->addSourceFile(sourceFile);
+    }
 
     // This is a new parse (even if it's a pre-existing source file), so create a new SourceUnit
     SourceView* sourceView = sourceManager->createSourceView(sourceFile, &filePathInfo);
 
-    PreprocessorInputStream* inputStream = CreateInputStreamForSource(context->preprocessor, sourceView);
+    // Included files are often included again (by other translation units), so use the token cache
+    PreprocessorInputStream* inputStream = CreateInputStreamForSource(context->preprocessor, sourceView, true);
     inputStream->parent = context->preprocessor->inputStream;
     context->preprocessor->inputStream = inputStream;
 }
@@ -1701,7 +1966,7 @@ static void HandleDefineDirective(PreprocessorDirectiveContext* context)
 
         DestroyMacro(context->preprocessor, oldMacro);
     }
-    context->preprocessor->globalEnv.macros[name] = macro;
+    context->preprocessor->globalEnv.addMacro(name, macro);
 
     // If macro name is immediately followed (with no space) by `(`,
     // then we have a function-like macro
@@ -2130,6 +2395,9 @@ static Token ReadToken(Preprocessor* preprocessor)
             directiveContext.parseError = false;
             directiveContext.haveDoneEndOfDirectiveChecks = false;
 
+            auto primaryStream = asPrimaryInputStream(preprocessor->inputStream);
+            directiveContext.isAtStartOfFile = primaryStream && primaryStream->consumedTokenCount == 1;
+
             // Parse and handle the directive
             HandleDirective(&directiveContext);
             continue;
@@ -2180,6 +2448,13 @@ static void FinalizePreprocessor(
         input = parent;
     }
 
+    for (auto expansion : preprocessor->freeObjectLikeExpansions)
+        delete expansion;
+    for (auto expansion : preprocessor->freeFunctionLikeExpansions)
+        delete expansion;
+    for (auto macro : preprocessor->freeArgMacros)
+        DestroyMacro(preprocessor, macro);
+
 #if 0
     // clean up any macros that were allocated
     for (auto pair : preprocessor->globalEnv.macros)
@@ -2224,7 +2499,7 @@ static void DefineMacro(
         DestroyMacro(preprocessor, oldMacro);
     }
 
-    preprocessor->globalEnv.macros[keyName] = macro;
+    preprocessor->globalEnv.addMacro(keyName, macro);
 }
 
 // read the entire input into tokens
@@ -2246,6 +2521,93 @@ static TokenList ReadAllTokens(
     return tokens;
 }
 
+// True if lexing tokens without any `LexerFlags` produced the same tokens as the
+// preprocessor would lex. The only difference is the message of `#error` and
+// `#warning` directives, which is lexed as a single `DirectiveMessage`.
+static bool _canReplayTokens(const List<Token>& tokens)
+{
+    const Index count = tokens.getCount();
+    for (Index i = 0; i + 1 < count; ++i)
+    {
+        const Token& token = tokens[i];
+        if (token.type == TokenType::Pound && (token.flags & TokenFlag::AtStartOfLine))
+        {
+            const Token& nameToken = tokens[i + 1];
+            if (nameToken.type == TokenType::Identifier &&
+                (nameToken.Content == "error" || nameToken.Content == "warning"))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t PreprocessorTokenCache::calcMemoryUsed() const
+{
+    size_t size = 0;
+    for (const auto& pair : m_entries)
+    {
+        const Entry* entry = pair.Value;
+        size += sizeof(Entry) + entry->content.size() + entry->memoryArena.calcTotalMemoryUsed() +
+            size_t(entry->tokens.getCapacity()) * sizeof(Token);
+    }
+    return size;
+}
+
+PreprocessorTokenCache::Entry* PreprocessorTokenCache::getEntry(SourceView* sourceView, NamePool* namePool)
+{
+    SourceFile* sourceFile = sourceView->getSourceFile();
+    const UnownedStringSlice content = sourceFile->getContent();
+    ISlangBlob* contentBlob = sourceFile->getContentBlob();
+    if (!contentBlob)
+    {
+        return nullptr;
+    }
+
+    const uint64_t hash = GetHashCode64(content.begin(), content.size());
+
+    RefPtr<Entry> entry;
+    if (m_entries.TryGetValue(hash, entry))
+    {
+        // Make sure it really is the same contents
+        if (entry->content.size() != content.size() ||
+            ::memcmp(entry->content.begin(), content.begin(), content.size()) != 0)
+        {
+            return nullptr;
+        }
+        m_hitCount++;
+        return entry;
+    }
+
+    m_missCount++;
+
+    entry = new Entry;
+    entry->contentBlob = contentBlob;
+    entry->content = content;
+
+    // Diagnostics from this lexing are discarded. If there are any the file is lexed
+    // again when it is preprocessed, which will report them.
+    DiagnosticSink sink(sourceView->getSourceManager());
+
+    Lexer lexer;
+    lexer.initialize(sourceView, &sink, namePool, &entry->memoryArena);
+    TokenList tokenList = lexer.lexAllTokens();
+    entry->tokens.swapWith(tokenList.mTokens);
+
+    entry->isReplayable = sink.diagnosticCount == 0 && _canReplayTokens(entry->tokens);
+
+    // Make the locations relative to the start of the file
+    const SourceLoc::RawValue locBase = sourceView->getRange().begin.getRaw();
+    for (auto& token : entry->tokens)
+    {
+        token.loc = SourceLoc::fromRaw(token.loc.getRaw() - locBase);
+    }
+
+    m_entries.Add(hash, entry);
+    return entry;
+}
+
 TokenList preprocessSource(
     SourceFile*                 file,
     DiagnosticSink*             sink,
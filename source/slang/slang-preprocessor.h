@@ -3,8 +3,11 @@
 #define SLANG_PREPROCESSOR_H_INCLUDED
 
 #include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
 #include "../slang/slang-lexer.h"
 
+#include "../../slang-com-ptr.h"
+
 namespace Slang {
 
 class DiagnosticSink;
@@ -24,6 +27,46 @@ struct IncludeHandler
     virtual String simplifyPath(const String& path) = 0;
 };
 
+    /// Holds the tokens lexed from the contents of included files, so that a file
+    /// included again (by any translation unit in the session) doesn't need to be lexed again.
+    ///
+    /// Files are identified by their contents, so the same tokens are used for any file
+    /// with the same contents. The locations of the tokens are held relative to the start
+    /// of the file, and are made relative to the `SourceView` of each inclusion as they are read.
+class PreprocessorTokenCache : public RefObject
+{
+public:
+    struct Entry : public RefObject
+    {
+            /// True if the tokens can be used in place of lexing the file. Lexing some
+            /// files depends on how the preprocessor handles them (such as the message of
+            /// `#error`), or produces diagnostics, in which case they are lexed each time.
+        bool isReplayable = false;
+
+        ComPtr<ISlangBlob> contentBlob;     ///< Keeps the content the tokens refer to alive
+        UnownedStringSlice content;
+        MemoryArena memoryArena;            ///< Holds the contents of tokens that had to be changed (see `TokenFlag::ScrubbingNeeded`)
+        List<Token> tokens;                 ///< Ends with an EndOfFile token. Locations are offsets from the start of the file.
+
+        Entry(): memoryArena(4096) {}
+    };
+
+        /// Get the entry for the file sourceView views, lexing it if it has not been seen before.
+        /// The names of the tokens are from namePool, which must live as long as the cache.
+    Entry* getEntry(SourceView* sourceView, NamePool* namePool);
+
+    Index getHitCount() const { return m_hitCount; }
+    Index getMissCount() const { return m_missCount; }
+
+        /// Calculate the bytes held by the cache's tokens and the contents they refer to
+    size_t calcMemoryUsed() const;
+
+protected:
+    Dictionary<uint64_t, RefPtr<Entry>> m_entries;  ///< Keyed by the hash of the contents of the file
+    Index m_hitCount = 0;
+    Index m_missCount = 0;
+};
+
 // Take a string of source code and preprocess it into a list of tokens.
 TokenList preprocessSource(
     SourceFile*                 file,
@@ -0,0 +1,267 @@
+// slang-reflection-blob.cpp
+#include "../../slang-reflection-blob.h"
+
+#include "../core/slang-basic.h"
+
+#include "slang-compiler.h"
+
+// Writes the reflection blob described in slang-reflection-blob.h.
+//
+// The contents are found through the public reflection API, rather than from the
+// layout objects directly, so that the reader's queries give the same answers.
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct ReflectionBlobWriter
+{
+    typedef slang::ReflectionBlobRange Range;
+
+    List<char> m_strings;
+    List<uint32_t> m_indices;
+    List<slang::ReflectionBlobSize> m_sizes;
+    List<slang::ReflectionBlobOffset> m_offsets;
+    List<slang::ReflectionBlobTypeLayout> m_typeLayouts;
+    List<slang::ReflectionBlobVarLayout> m_varLayouts;
+    List<slang::ReflectionBlobEntryPoint> m_entryPoints;
+
+    Dictionary<String, uint32_t> m_stringOffsets;
+    Dictionary<SlangReflectionTypeLayout*, uint32_t> m_typeLayoutIndices;
+    Dictionary<SlangReflectionVariableLayout*, uint32_t> m_varLayoutIndices;
+
+    uint32_t addString(char const* chars)
+    {
+        if (!chars)
+            return slang::kReflectionBlobNull;
+
+        String string(chars);
+        uint32_t offset;
+        if (m_stringOffsets.TryGetValue(string, offset))
+            return offset;
+
+        offset = uint32_t(m_strings.getCount());
+        m_strings.addRange(chars, string.getLength() + 1);
+        m_stringOffsets.Add(string, offset);
+        return offset;
+    }
+
+    static uint64_t getSize(size_t size)
+    {
+        return size == SLANG_UNBOUNDED_SIZE ? ~uint64_t(0) : uint64_t(size);
+    }
+
+        /// Add the sizes for categories where getSizeFunc isn't 0
+    template <typename GetSizeFunc>
+    Range addSizes(const GetSizeFunc& getSizeFunc)
+    {
+        Range range = { uint32_t(m_sizes.getCount()), 0 };
+        for (SlangParameterCategory category = SLANG_PARAMETER_CATEGORY_NONE + 1; category < SLANG_PARAMETER_CATEGORY_COUNT; ++category)
+        {
+            const size_t size = getSizeFunc(category);
+            if (size == 0)
+                continue;
+
+            slang::ReflectionBlobSize entry = {};
+            entry.category = category;
+            entry.size = getSize(size);
+            m_sizes.add(entry);
+        }
+        range.count = uint32_t(m_sizes.getCount()) - range.start;
+        return range;
+    }
+
+    uint32_t addTypeLayout(SlangReflectionTypeLayout* typeLayout)
+    {
+        if (!typeLayout)
+            return slang::kReflectionBlobNull;
+
+        uint32_t index;
+        if (m_typeLayoutIndices.TryGetValue(typeLayout, index))
+            return index;
+
+        // The index is reserved first, as type layouts can refer back to themselves
+        // through their fields (for example through a pending data layout).
+        index = uint32_t(m_typeLayouts.getCount());
+        m_typeLayoutIndices.Add(typeLayout, index);
+        m_typeLayouts.add(slang::ReflectionBlobTypeLayout());
+
+        slang::ReflectionBlobTypeLayout entry = {};
+
+        SlangReflectionType* type = spReflectionTypeLayout_GetType(typeLayout);
+        entry.kind = spReflectionType_GetKind(type);
+        entry.name = addString(spReflectionType_GetName(type));
+        entry.scalarType = spReflectionType_GetScalarType(type);
+        entry.rowCount = spReflectionType_GetRowCount(type);
+        entry.columnCount = spReflectionType_GetColumnCount(type);
+        entry.resourceShape = spReflectionType_GetResourceShape(type);
+        entry.resourceAccess = spReflectionType_GetResourceAccess(type);
+        entry.elementCount = getSize(spReflectionType_GetElementCount(type));
+
+        entry.parameterCategory = spReflectionTypeLayout_GetParameterCategory(typeLayout);
+        entry.matrixLayoutMode = spReflectionTypeLayout_GetMatrixLayoutMode(typeLayout);
+        entry.genericParamIndex = spReflectionTypeLayout_getGenericParamIndex(typeLayout);
+        entry.elementTypeLayout = addTypeLayout(spReflectionTypeLayout_GetElementTypeLayout(typeLayout));
+        entry.elementVarLayout = addVarLayout(spReflectionTypeLayout_GetElementVarLayout(typeLayout));
+
+        // Fields are only held on struct layouts, so the count of the type can't always be used
+        List<uint32_t> fields;
+        if (entry.kind == SLANG_TYPE_KIND_STRUCT)
+        {
+            const unsigned fieldCount = spReflectionType_GetFieldCount(type);
+            for (unsigned i = 0; i < fieldCount; ++i)
+                fields.add(addVarLayout(spReflectionTypeLayout_GetFieldByIndex(typeLayout, i)));
+        }
+        entry.fields = addIndices(fields);
+
+        List<uint32_t> categories;
+        const unsigned categoryCount = spReflectionTypeLayout_GetCategoryCount(typeLayout);
+        for (unsigned i = 0; i < categoryCount; ++i)
+            categories.add(spReflectionTypeLayout_GetCategoryByIndex(typeLayout, i));
+        entry.categories = addIndices(categories);
+
+        entry.sizes = addSizes([&](SlangParameterCategory category) { return spReflectionTypeLayout_GetSize(typeLayout, category); });
+        entry.strides = addSizes([&](SlangParameterCategory category) { return spReflectionTypeLayout_GetElementStride(typeLayout, category); });
+
+        m_typeLayouts[index] = entry;
+        return index;
+    }
+
+    uint32_t addVarLayout(SlangReflectionVariableLayout* varLayout)
+    {
+        if (!varLayout)
+            return slang::kReflectionBlobNull;
+
+        uint32_t index;
+        if (m_varLayoutIndices.TryGetValue(varLayout, index))
+            return index;
+
+        index = uint32_t(m_varLayouts.getCount());
+        m_varLayoutIndices.Add(varLayout, index);
+        m_varLayouts.add(slang::ReflectionBlobVarLayout());
+
+        slang::ReflectionBlobVarLayout entry = {};
+
+        SlangReflectionVariable* var = spReflectionVariableLayout_GetVariable(varLayout);
+        entry.name = addString(var ? spReflectionVariable_GetName(var) : nullptr);
+        entry.typeLayout = addTypeLayout(spReflectionVariableLayout_GetTypeLayout(varLayout));
+        entry.semanticName = addString(spReflectionVariableLayout_GetSemanticName(varLayout));
+        entry.semanticIndex = uint32_t(spReflectionVariableLayout_GetSemanticIndex(varLayout));
+        entry.stage = spReflectionVariableLayout_getStage(varLayout);
+        entry.bindingIndex = spReflectionParameter_GetBindingIndex((SlangReflectionParameter*)varLayout);
+        entry.bindingSpace = spReflectionParameter_GetBindingSpace((SlangReflectionParameter*)varLayout);
+
+        // The offset queries fall back to a related category when there isn't an offset for the one
+        // asked for, so the results are recorded for every category rather than just those present.
+        entry.offsets.start = uint32_t(m_offsets.getCount());
+        for (SlangParameterCategory category = SLANG_PARAMETER_CATEGORY_NONE + 1; category < SLANG_PARAMETER_CATEGORY_COUNT; ++category)
+        {
+            slang::ReflectionBlobOffset offset = {};
+            offset.category = category;
+            offset.offset = uint32_t(spReflectionVariableLayout_GetOffset(varLayout, category));
+            offset.space = uint32_t(spReflectionVariableLayout_GetSpace(varLayout, category));
+            if (offset.offset || offset.space)
+                m_offsets.add(offset);
+        }
+        entry.offsets.count = uint32_t(m_offsets.getCount()) - entry.offsets.start;
+
+        m_varLayouts[index] = entry;
+        return index;
+    }
+
+    Range addIndices(const List<uint32_t>& indices)
+    {
+        Range range = { uint32_t(m_indices.getCount()), uint32_t(indices.getCount()) };
+        m_indices.addRange(indices);
+        return range;
+    }
+
+    void addEntryPoint(SlangReflectionEntryPoint* entryPoint)
+    {
+        slang::ReflectionBlobEntryPoint entry = {};
+        entry.name = addString(spReflectionEntryPoint_getName(entryPoint));
+        entry.stage = spReflectionEntryPoint_getStage(entryPoint);
+        entry.usesAnySampleRateInput = spReflectionEntryPoint_usesAnySampleRateInput(entryPoint) ? 1 : 0;
+
+        SlangUInt threadGroupSize[3] = { 0, 0, 0 };
+        spReflectionEntryPoint_getComputeThreadGroupSize(entryPoint, 3, threadGroupSize);
+        for (Index i = 0; i < 3; ++i)
+            entry.threadGroupSize[i] = uint32_t(threadGroupSize[i]);
+
+        List<uint32_t> parameters;
+        const unsigned parameterCount = spReflectionEntryPoint_getParameterCount(entryPoint);
+        for (unsigned i = 0; i < parameterCount; ++i)
+            parameters.add(addVarLayout(spReflectionEntryPoint_getParameterByIndex(entryPoint, i)));
+        entry.parameters = addIndices(parameters);
+
+        m_entryPoints.add(entry);
+    }
+
+    template <typename T>
+    static void _writeSection(const List<T>& items, slang::ReflectionBlobRange& outRange, List<uint8_t>& ioData)
+    {
+        // Every section is 8 byte aligned, so that the 64 bit values in it are
+        while (ioData.getCount() & 7)
+            ioData.add(0);
+
+        outRange.start = uint32_t(ioData.getCount());
+        outRange.count = uint32_t(items.getCount());
+        ioData.addRange((const uint8_t*)items.getBuffer(), items.getCount() * sizeof(T));
+    }
+
+    SlangResult write(SlangReflection* reflection, List<uint8_t>& outData)
+    {
+        slang::ReflectionBlobHeader header = {};
+        header.magic = slang::kReflectionBlobMagic;
+        header.version = slang::kReflectionBlobVersion;
+        header.globalConstantBufferBinding = uint32_t(spReflection_getGlobalConstantBufferBinding(reflection));
+        header.globalConstantBufferSize = getSize(spReflection_getGlobalConstantBufferSize(reflection));
+
+        List<uint32_t> parameters;
+        const unsigned parameterCount = spReflection_GetParameterCount(reflection);
+        for (unsigned i = 0; i < parameterCount; ++i)
+            parameters.add(addVarLayout((SlangReflectionVariableLayout*)spReflection_GetParameterByIndex(reflection, i)));
+        header.parameters = addIndices(parameters);
+
+        const SlangUInt entryPointCount = spReflection_getEntryPointCount(reflection);
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+            addEntryPoint(spReflection_getEntryPointByIndex(reflection, i));
+        header.entryPoints.start = 0;
+        header.entryPoints.count = uint32_t(entryPointCount);
+
+        outData.clear();
+        outData.addRange((const uint8_t*)&header, sizeof(header));
+
+        typedef slang::ReflectionBlobSection Section;
+        _writeSection(m_strings, header.sections[Index(Section::Strings)], outData);
+        _writeSection(m_indices, header.sections[Index(Section::Indices)], outData);
+        _writeSection(m_sizes, header.sections[Index(Section::Sizes)], outData);
+        _writeSection(m_offsets, header.sections[Index(Section::Offsets)], outData);
+        _writeSection(m_typeLayouts, header.sections[Index(Section::TypeLayouts)], outData);
+        _writeSection(m_varLayouts, header.sections[Index(Section::VarLayouts)], outData);
+        _writeSection(m_entryPoints, header.sections[Index(Section::EntryPoints)], outData);
+
+        // Offsets are 32 bit
+        if (uint64_t(outData.getCount()) > 0xffffffff)
+            return SLANG_FAIL;
+
+        header.size = uint32_t(outData.getCount());
+        ::memcpy(outData.getBuffer(), &header, sizeof(header));
+        return SLANG_OK;
+    }
+};
+
+} // anonymous
+
+SLANG_API SlangResult spReflection_writeBlob(SlangReflection* reflection, ISlangBlob** outBlob)
+{
+    if (!reflection || !outBlob)
+        return SLANG_E_INVALID_ARG;
+
+    ReflectionBlobWriter writer;
+    List<uint8_t> data;
+    SLANG_RETURN_ON_FAIL(writer.write(reflection, data));
+
+    *outBlob = createRawBlob(data.getBuffer(), data.getCount()).detach();
+    return SLANG_OK;
+}
@@ -1323,6 +1323,48 @@ SLANG_API int spReflectionEntryPoint_usesAnySampleRateInput(
     return (entryPointLayout->flags & EntryPointLayout::Flag::usesAnySampleRateInput) != 0;
 }
 
+SLANG_API SlangResult spReflectionEntryPoint_getUsedGlobalParameterMask(
+    SlangReflectionEntryPoint*  inEntryPoint,
+    SlangUInt                   maskWordCount,
+    uint32_t*                   outMask)
+{
+    auto entryPointLayout = convert(inEntryPoint);
+    if(!entryPointLayout || (maskWordCount && !outMask))
+        return SLANG_E_INVALID_ARG;
+
+    if(!entryPointLayout->hasUsedGlobalParameters)
+        return SLANG_E_NOT_AVAILABLE;
+
+    auto& usedGlobalParameters = entryPointLayout->usedGlobalParameters;
+    for(SlangUInt i = 0; i < maskWordCount; ++i)
+    {
+        uint32_t word = 0;
+        for(UInt j = 0; j < 32; ++j)
+        {
+            if(usedGlobalParameters.contains(UInt(i * 32 + j)))
+                word |= uint32_t(1) << j;
+        }
+        outMask[i] = word;
+    }
+    return SLANG_OK;
+}
+
+SLANG_API SlangResult spReflectionEntryPoint_isGlobalParameterUsed(
+    SlangReflectionEntryPoint*  inEntryPoint,
+    SlangUInt                   parameterIndex,
+    int*                        outUsed)
+{
+    auto entryPointLayout = convert(inEntryPoint);
+    if(!entryPointLayout || !outUsed)
+        return SLANG_E_INVALID_ARG;
+
+    if(!entryPointLayout->hasUsedGlobalParameters)
+        return SLANG_E_NOT_AVAILABLE;
+
+    *outUsed = entryPointLayout->usedGlobalParameters.contains(UInt(parameterIndex)) ? 1 : 0;
+    return SLANG_OK;
+}
+
 // SlangReflectionTypeParameter
 SLANG_API char const* spReflectionTypeParameter_GetName(SlangReflectionTypeParameter * inTypeParam)
 {
@@ -1499,6 +1541,51 @@ SLANG_API SlangReflectionVariableLayout* spEntryPointGroupLayout_getParameterByI
 }
 
 
+static SlangResult _getBindingTableEntry(ScopeLayout* scopeLayout, SlangInt index, SlangBindingTableEntry* outEntry)
+{
+    if(!scopeLayout || !outEntry) return SLANG_E_INVALID_ARG;
+
+    auto& bindingTable = scopeLayout->bindingTable;
+    if(index < 0 || index >= bindingTable.getCount()) return SLANG_E_INVALID_ARG;
+
+    auto& entry = bindingTable[Index(index)];
+    outEntry->path = entry.path.getBuffer();
+    outEntry->category = SlangParameterCategory(entry.kind);
+    outEntry->typeLayout = convert(entry.typeLayout.Ptr());
+    outEntry->index = entry.index;
+    outEntry->space = entry.space;
+    outEntry->count = getReflectionSize(entry.count);
+    outEntry->bufferIndex = entry.bufferIndex;
+    outEntry->parameterIndex = entry.parameterIndex;
+    return SLANG_OK;
+}
+
+SLANG_API SlangInt spReflection_getBindingTableEntryCount(SlangReflection* inProgram)
+{
+    auto program = convert(inProgram);
+    if(!program) return 0;
+
+    return program->bindingTable.getCount();
+}
+
+SLANG_API SlangResult spReflection_getBindingTableEntry(SlangReflection* inProgram, SlangInt index, SlangBindingTableEntry* outEntry)
+{
+    return _getBindingTableEntry(convert(inProgram), index, outEntry);
+}
+
+SLANG_API SlangInt spEntryPointGroupLayout_getBindingTableEntryCount(SlangEntryPointGroupLayout* inGroup)
+{
+    auto group = convert(inGroup);
+    if(!group) return 0;
+
+    return group->bindingTable.getCount();
+}
+
+SLANG_API SlangResult spEntryPointGroupLayout_getBindingTableEntry(SlangEntryPointGroupLayout* inGroup, SlangInt index, SlangBindingTableEntry* outEntry)
+{
+    return _getBindingTableEntry(convert(inGroup), index, outEntry);
+}
+
 SLANG_API SlangUInt spReflection_getGlobalConstantBufferBinding(SlangReflection* inProgram)
 {
     auto program = convert(inProgram);
@@ -1518,6 +1605,37 @@ SLANG_API size_t spReflection_getGlobalConstantBufferSize(SlangReflection* inPro
     return getReflectionSize(uniform->count);
 }
 
+SLANG_API SlangInt spReflection_getSpecializationConstantCount(SlangReflection* inProgram)
+{
+    auto program = convert(inProgram);
+    if (!program) return 0;
+    return program->specializationConstants.getCount();
+}
+
+SLANG_API SlangReflectionVariable* spReflection_getSpecializationConstantByIndex(SlangReflection* inProgram, SlangInt index)
+{
+    auto program = convert(inProgram);
+    if (!program) return nullptr;
+    if (index < 0 || index >= program->specializationConstants.getCount()) return nullptr;
+    return convert(program->specializationConstants[index].varDecl);
+}
+
+SLANG_API SlangInt spReflection_getSpecializationConstantID(SlangReflection* inProgram, SlangInt index)
+{
+    auto program = convert(inProgram);
+    if (!program) return -1;
+    if (index < 0 || index >= program->specializationConstants.getCount()) return -1;
+    return program->specializationConstants[index].id;
+}
+
+SLANG_API int64_t spReflection_getSpecializationConstantDefaultValue(SlangReflection* inProgram, SlangInt index)
+{
+    auto program = convert(inProgram);
+    if (!program) return 0;
+    if (index < 0 || index >= program->specializationConstants.getCount()) return 0;
+    return program->specializationConstants[index].defaultValue;
+}
+
 SLANG_API  SlangReflectionType* spReflection_specializeType(
     SlangReflection*            inProgramLayout,
     SlangReflectionType*        inType,
@@ -3,6 +3,7 @@
 
 #include "slang-compiler.h"
 
+#include "../core/slang-char-scan.h"
 #include "../core/slang-string-util.h"
 
 namespace Slang {
@@ -200,6 +201,7 @@ PathInfo SourceView::getPathInfo(SourceLoc loc, SourceLocType type)
 
 void SourceFile::setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets)
 {
+    m_lastLineIndex = 0;
     m_lineBreakOffsets.clear();
     m_lineBreakOffsets.addRange(offsets, numOffsets);
 }
@@ -209,13 +211,23 @@ const List<uint32_t>& SourceFile::getLineBreakOffsets()
     // We now have a raw input file that we can search for line breaks.
     // We obviously don't want to do a linear scan over and over, so we will
     // cache an array of line break locations in the file.
-    if (m_lineBreakOffsets.getCount() == 0)
+    if (m_lineBreakOffsets.getCount() == 0 && getContent().begin())
     {
-        UnownedStringSlice content(getContent()), line;
-        char const* contentBegin = content.begin();
-        while (StringUtil::extractLine(content, line))
+        // The offsets are the start of each line, where a line break is any of "\n", "\r", "\r\n" or "\n\r"
+        // (as in `StringUtil::extractLine`).
+        const UnownedStringSlice content(getContent());
+        char const* const contentBegin = content.begin();
+        char const* const contentEnd = content.end();
+
+        m_lineBreakOffsets.add(0);
+        for (char const* cursor = CharScanUtil::findLineBreak(contentBegin, contentEnd); cursor < contentEnd; cursor = CharScanUtil::findLineBreak(cursor, contentEnd))
         {
-            m_lineBreakOffsets.add(uint32_t(line.begin() - contentBegin));
+            const char c = *cursor++;
+            if (cursor < contentEnd && (c ^ *cursor) == ('\r' ^ '\n'))
+            {
+                cursor++;
+            }
+            m_lineBreakOffsets.add(uint32_t(cursor - contentBegin));
         }
         // Note that we do *not* treat the end of the file as a line
         // break, because otherwise we would report errors like
@@ -235,9 +247,32 @@ int SourceFile::calcLineIndexFromOffset(int offset)
 
     // At this point we can assume the `lineBreakOffsets` array has been filled in.
     // We will use a binary search to find the line index that contains our
-    // chosen offset.
+    // chosen offset. The search is over [lo, hi), where the offset is at or after line lo,
+    // and before line hi (if there is one).
+    const Index count = lineBreakOffsets.getCount();
     Index lo = 0;
-    Index hi = lineBreakOffsets.getCount();
+    Index hi = count;
+
+    // Locations are often looked up in order (for example when emitting or serializing), so
+    // start from the line found last time, and search forward in steps that double in size.
+    // That makes looking up the same or the next line constant time.
+    if (m_lastLineIndex < count && lineBreakOffsets[m_lastLineIndex] <= uint32_t(offset))
+    {
+        lo = m_lastLineIndex;
+        Index step = 1;
+        hi = lo + 1;
+        while (hi < count && lineBreakOffsets[hi] <= uint32_t(offset))
+        {
+            lo = hi;
+            step += step;
+            hi = lo + step;
+        }
+        hi = (hi < count) ? hi : count;
+    }
+    else if (m_lastLineIndex < count)
+    {
+        hi = m_lastLineIndex;
+    }
 
     while (lo + 1 < hi)
     {
@@ -253,6 +288,7 @@ int SourceFile::calcLineIndexFromOffset(int offset)
         }
     }
 
+    m_lastLineIndex = lo;
     return int(lo);
 }
 
@@ -283,6 +319,15 @@ void SourceFile::setContents(const String& content)
     setContents(contentBlob);
 }
 
+void SourceFile::releaseContents()
+{
+    // Line breaks can only be found while there is content
+    getLineBreakOffsets();
+
+    m_contentBlob.setNull();
+    m_content = UnownedStringSlice();
+}
+
 SourceFile::SourceFile(SourceManager* sourceManager, const PathInfo& pathInfo, size_t contentSize) :
     m_sourceManager(sourceManager),
     m_pathInfo(pathInfo),
@@ -319,13 +364,18 @@ String SourceFile::calcVerbosePath() const
 
 void SourceManager::initialize(
     SourceManager*  p,
-    ISlangFileSystemExt* fileSystemExt)
+    ISlangFileSystemExt* fileSystemExt,
+    SourceLoc startLoc)
 {
     m_fileSystemExt = fileSystemExt;
 
     m_parent = p;
 
-    if( p )
+    if( startLoc.isValid() )
+    {
+        m_startLoc = startLoc;
+    }
+    else if( p )
     {
         // If we have a parent source manager, then we assume that all code at that level
         // has already been loaded, and it is safe to start our own source locations
@@ -384,6 +434,34 @@ SourceRange SourceManager::allocateSourceRange(UInt size)
     return SourceRange(beginLoc, endLoc);
 }
 
+SourceRange SourceManager::allocateDeferredSourceRange(UInt size, DeferredSourceViews* deferred)
+{
+    DeferredRange deferredRange;
+    deferredRange.range = allocateSourceRange(size);
+    deferredRange.deferred = deferred;
+    m_deferredRanges.add(deferredRange);
+    return deferredRange.range;
+}
+
+bool SourceManager::_createDeferredSourceViews(SourceLoc loc) const
+{
+    for (Index i = 0; i < m_deferredRanges.getCount(); ++i)
+    {
+        if (m_deferredRanges[i].range.contains(loc))
+        {
+            // Remove before creating, so lookups made while creating don't try again. The views are
+            // a cache of what the deferred range describes, so creating them doesn't change the manager logically.
+            // (removeAt doesn't destroy the element, so release it first - the deferred views can hold a lot of data)
+            DeferredRange deferredRange = m_deferredRanges[i];
+            m_deferredRanges[i].deferred.setNull();
+            m_deferredRanges.removeAt(i);
+            deferredRange.deferred->createSourceViews(const_cast<SourceManager*>(this), deferredRange.range);
+            return true;
+        }
+    }
+    return false;
+}
+
 SourceFile* SourceManager::createSourceFileWithSize(const PathInfo& pathInfo, size_t contentSize)
 {
     SourceFile* sourceFile = new SourceFile(this, pathInfo, contentSize);
@@ -427,15 +505,49 @@ SourceView* SourceManager::createSourceView(SourceFile* sourceFile, const PathIn
     return sourceView;
 }
 
+SourceView* SourceManager::createSourceViewAt(SourceFile* sourceFile, SourceLoc beginLoc)
+{
+    const SourceRange range(beginLoc, beginLoc + sourceFile->getContentSize());
+    SLANG_ASSERT(getSourceRange().contains(range.begin) && getSourceRange().contains(range.end));
+
+    SourceView* sourceView = new SourceView(sourceFile, range, nullptr);
+
+    // Keep the views in order of range
+    Index index = m_sourceViews.getCount();
+    while (index > 0 && m_sourceViews[index - 1]->getRange().begin.getRaw() > beginLoc.getRaw())
+    {
+        index--;
+    }
+    m_sourceViews.insert(index, sourceView);
+
+    return sourceView;
+}
+
 SourceView* SourceManager::findSourceView(SourceLoc loc) const
 {
+    // It must be in the range of this manager for it to possibly be a hit
+    if (!getSourceRange().contains(loc))
+    {
+        return nullptr;
+    }
+    if (m_deferredRanges.getCount() && _createDeferredSourceViews(loc))
+    {
+        return findSourceView(loc);
+    }
+
     Index hi = m_sourceViews.getCount();
-    // It must be in the range of this manager and have associated views for it to possibly be a hit
-    if (!getSourceRange().contains(loc) || hi == 0)
+    // There must be associated views for it to possibly be a hit
+    if (hi == 0)
     {
         return nullptr;
     }
 
+    // Most lookups are in the same view as the last one
+    if (m_lastSourceView && m_lastSourceView->getRange().contains(loc))
+    {
+        return m_lastSourceView;
+    }
+
     // If we don't have very many, we may as well just linearly search
     if (hi <= 8)
     {
@@ -444,6 +556,7 @@ SourceView* SourceManager::findSourceView(SourceLoc loc) const
             SourceView* view = m_sourceViews[i];
             if (view->getRange().contains(loc))
             {
+                m_lastSourceView = view;
                 return view;
             }
         }
@@ -461,6 +574,7 @@ SourceView* SourceManager::findSourceView(SourceLoc loc) const
         SourceView* midView = m_sourceViews[mid];
         if (midView->getRange().contains(loc))
         {
+            m_lastSourceView = midView;
             return midView;
         }
 
@@ -479,7 +593,12 @@ SourceView* SourceManager::findSourceView(SourceLoc loc) const
 
     // Check if low is actually a hit
     SourceView* view = m_sourceViews[lo];
-    return (view->getRange().contains(loc)) ? view : nullptr;
+    if (view->getRange().contains(loc))
+    {
+        m_lastSourceView = view;
+        return view;
+    }
+    return nullptr;
 }
 
 SourceView* SourceManager::findSourceViewRecursively(SourceLoc loc) const
@@ -502,6 +621,26 @@ SourceView* SourceManager::findSourceViewRecursively(SourceLoc loc) const
     return nullptr;
 }
 
+void SourceManager::calcMemoryUsed(size_t& outContentBytes, size_t& outLocBytes) const
+{
+    size_t contentBytes = 0;
+    size_t locBytes = m_memoryArena.calcTotalMemoryUsed();
+    for (auto sourceFile : m_sourceFiles)
+    {
+        if (sourceFile->hasContent())
+        {
+            contentBytes += sourceFile->getContentSize();
+        }
+        locBytes += sizeof(SourceFile) + sourceFile->calcLineBreakOffsetsSize();
+    }
+    for (auto sourceView : m_sourceViews)
+    {
+        locBytes += sizeof(SourceView) + size_t(sourceView->getEntries().getCount()) * sizeof(SourceView::Entry);
+    }
+    outContentBytes = contentBytes;
+    outLocBytes = locBytes;
+}
+
 SourceFile* SourceManager::findSourceFile(const String& uniqueIdentity) const
 {
     SourceFile*const* filePtr = m_sourceFileMap.TryGetValue(uniqueIdentity);
@@ -542,6 +681,22 @@ HumaneSourceLoc SourceManager::getHumaneLoc(SourceLoc loc, SourceLocType type)
     }
 }
 
+void SourceManager::getHumaneLocs(const SourceLoc* locs, Index count, HumaneSourceLoc* outHumaneLocs, SourceLocType type)
+{
+    // Only look for a view when a location isn't in the view of the previous one. The line lookup in the
+    // view's SourceFile starts from the previous line, so sorted locations are found in one pass.
+    SourceView* sourceView = nullptr;
+    for (Index i = 0; i < count; ++i)
+    {
+        const SourceLoc loc = locs[i];
+        if (!sourceView || !sourceView->getRange().contains(loc))
+        {
+            sourceView = findSourceViewRecursively(loc);
+        }
+        outHumaneLocs[i] = sourceView ? sourceView->getHumaneLoc(loc, type) : HumaneSourceLoc();
+    }
+}
+
 PathInfo SourceManager::getPathInfo(SourceLoc loc, SourceLocType type)
 {
     SourceView* sourceView = findSourceViewRecursively(loc);
@@ -159,7 +159,8 @@ public:
         /// Set the line break offsets
     void setLineBreakOffsets(const uint32_t* offsets, UInt numOffsets);
 
-        /// Calculate the line based on the offset 
+        /// Calculate the line based on the offset.
+        /// The search starts from the line found by the previous call, so is fastest when offsets are in increasing order.
     int calcLineIndexFromOffset(int offset);
 
         /// Calculate the offset for a line
@@ -185,6 +186,18 @@ public:
         /// Set the content as a string
     void setContents(const String& content);
 
+        /// Release the content, keeping the line break offsets so locations in the file can still be reported.
+        /// The content can be set again with `setContents` (with content of the same size).
+    void releaseContents();
+
+        /// Get the number of bytes used by the line break offsets (which are only calculated when first needed)
+    size_t calcLineBreakOffsetsSize() const { return size_t(m_lineBreakOffsets.getCount()) * sizeof(uint32_t); }
+
+        /// Record that a module holds on to the content (see `Module::compact`)
+    void addContentUser() { m_contentUserCount++; }
+        /// Record that a module no longer needs the content. Returns true if no module needs it.
+    bool removeContentUser() { return --m_contentUserCount <= 0; }
+
         /// Calculate a display path -> can canonicalize if necessary
     String calcVerbosePath() const;
 
@@ -208,6 +221,9 @@ public:
     // we will cache the starting offset of each line break in
     // the input file:
     List<uint32_t> m_lineBreakOffsets;
+
+    Index m_lastLineIndex = 0;          ///< The line index found by the last calcLineIndexFromOffset
+    Index m_contentUserCount = 0;       ///< The number of modules that may need the content
 };
 
 enum class SourceLocType
@@ -309,14 +325,28 @@ class SourceView
     List<Entry> m_entries;              ///< An array entries describing how we should interpret a range, starting from the start location. 
 };
 
+    /// Creates the SourceViews for a range of locations allocated with `SourceManager::allocateDeferredSourceRange`.
+    /// The views are only created when a location in the range is first looked up, so locations can be handed
+    /// out without the cost of building the views (and the files they are of) if they are never reported.
+class DeferredSourceViews : public RefObject
+{
+public:
+        /// Create the views for locations in range on sourceManager (with `createSourceViewAt`)
+    virtual void createSourceViews(SourceManager* sourceManager, const SourceRange& range) = 0;
+};
+
 struct SourceManager
 {
-        // Initialize a source manager, with an optional parent
-    void initialize(SourceManager* parent, ISlangFileSystemExt* fileSystemExt);
+        // Initialize a source manager, with an optional parent.
+        // If startLoc is valid locations are allocated from it, otherwise they follow on from the parent's.
+    void initialize(SourceManager* parent, ISlangFileSystemExt* fileSystemExt, SourceLoc startLoc = SourceLoc());
 
         /// Allocate a range of SourceLoc locations, these can be used to identify a specific location in the source
     SourceRange allocateSourceRange(UInt size);
 
+        /// Allocate a range of locations, whose views are only created (by deferred) when a location in the range is first looked up
+    SourceRange allocateDeferredSourceRange(UInt size, DeferredSourceViews* deferred);
+
         /// Create a SourceFile defined with the specified path, and content held within a blob
     SourceFile* createSourceFileWithSize(const PathInfo& pathInfo, size_t contentSize);
     SourceFile* createSourceFileWithString(const PathInfo& pathInfo, const String& contents);
@@ -324,6 +354,9 @@ struct SourceManager
 
         /// Get the humane source location
     HumaneSourceLoc getHumaneLoc(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
+        /// Get the humane source locations of count locations.
+        /// Locations can be in any order, but sorted locations are found in a single pass over the views and lines.
+    void getHumaneLocs(const SourceLoc* locs, Index count, HumaneSourceLoc* outHumaneLocs, SourceLocType type = SourceLocType::Nominal);
 
         /// Get the path associated with a location 
     PathInfo getPathInfo(SourceLoc loc, SourceLocType type = SourceLocType::Nominal);
@@ -332,6 +365,9 @@ struct SourceManager
         /// @param sourceFile is the source file that contains the source
         /// @param pathInfo is path used to read the file from
     SourceView* createSourceView(SourceFile* sourceFile, const PathInfo* pathInfo);
+        /// Create a new source view from a file, with locations starting at beginLoc. The locations must be in a
+        /// range allocated by `allocateDeferredSourceRange` that doesn't have a view yet.
+    SourceView* createSourceViewAt(SourceFile* sourceFile, SourceLoc beginLoc);
 
         /// Find a view by a source file location. 
         /// If not found in this manager will look in the parent SourceManager
@@ -355,10 +391,17 @@ struct SourceManager
 
         /// Add a source file, uniqueIdentity must be unique for this manager AND any parents
     void addSourceFile(const String& uniqueIdentity, SourceFile* sourceFile);
+        /// Stop finding the source file with uniqueIdentity (on this manager), so that it is loaded again
+        /// when next needed. The SourceFile is kept, as locations may still refer to it.
+    void removeSourceFile(const String& uniqueIdentity) { m_sourceFileMap.Remove(uniqueIdentity); }
 
         /// Get the slice pool
     StringSlicePool& getStringSlicePool() { return m_slicePool; }
 
+        /// Calculate the bytes held by this manager (not including its parent) for the contents of
+        /// source files, and for finding locations (line break tables, views and paths)
+    void calcMemoryUsed(size_t& outContentBytes, size_t& outLocBytes) const;
+
         /// Get the source range for just this manager
         /// Caution - the range will change if allocations are made to this manager.
     SourceRange getSourceRange() const { return SourceRange(m_startLoc, m_nextLoc); } 
@@ -379,6 +422,15 @@ struct SourceManager
 
     protected:
 
+    struct DeferredRange
+    {
+        SourceRange range;
+        RefPtr<DeferredSourceViews> deferred;
+    };
+
+        /// If loc is in a deferred range, create the views of the range. Returns true if views were created.
+    bool _createDeferredSourceViews(SourceLoc loc) const;
+
     // The first location available to this source manager
     // (may not be the first location of all, because we might
     // have a parent source manager)
@@ -392,6 +444,10 @@ struct SourceManager
 
     // All of the SourceViews constructed on this SourceManager. These are held in increasing order of range, so can find by doing a binary chop.
     List<SourceView*> m_sourceViews;
+    // The view returned by the last findSourceView. Consecutive lookups are usually in the same view.
+    mutable SourceView* m_lastSourceView = nullptr;
+    // Ranges allocated with allocateDeferredSourceRange, whose views haven't been created yet
+    mutable List<DeferredRange> m_deferredRanges;
     // All of the SourceFiles constructed on this SourceManager. This owns the SourceFile.
     List<SourceFile*> m_sourceFiles;
 
@@ -8,6 +8,11 @@ ABSTRACT_SYNTAX_CLASS(NodeBase, RefObject)
     // A helper to access the corresponding class on a concrete instance
     RAW(
     virtual SyntaxClass<NodeBase> getClass() = 0;
+    ASTClassId getClassId() { return getClass().classInfo->classId; }
+
+    // Nodes are allocated from the current `ASTArena` (if there is one)
+    static void* operator new(size_t size) { return ASTNodeAllocator::allocate(size); }
+    static void operator delete(void* ptr) { ASTNodeAllocator::deallocate(ptr); }
     )
 END_SYNTAX_CLASS()
 
@@ -81,8 +86,10 @@ public:
     void setSession(Session* s) { this->session = s; }
 
     bool Equals(Type* type);
-    
-    Type* GetCanonicalType();
+
+        /// Get the canonical type. It is created on first use, and then cached on the type,
+        /// so this is inline for the (very common) case of it having been created already.
+    Type* GetCanonicalType() { return canonicalType ? canonicalType : _createCanonicalType(); }
 
     virtual RefPtr<Val> SubstituteImpl(SubstitutionSet subst, int* ioDiff) override;
 
@@ -94,6 +101,7 @@ protected:
     virtual bool EqualsImpl(Type* type) = 0;
 
     virtual RefPtr<Type> CreateCanonicalType() = 0;
+    Type* _createCanonicalType();
     Type* canonicalType = nullptr;
     
     Session* session = nullptr;
@@ -280,6 +288,10 @@ ABSTRACT_SYNTAX_CLASS(Decl, DeclBase)
     // The next declaration defined in the same container with the same name
     DECL_FIELD(Decl*, nextInContainerWithSameName RAW(= nullptr))
 
+    // The mangled name of the declaration without any substitutions, cached
+    // by `getMangledName`, since it is asked for repeatedly by lowering and linking
+    RAW(String mangledName;)
+
     RAW(
     bool IsChecked(DeclCheckState state) { return checkState >= state; }
     void SetCheckState(DeclCheckState state)
@@ -19,6 +19,16 @@ namespace Slang
     void checkTranslationUnit(
         TranslationUnitRequest* translationUnit);
 
+        /// With SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING, `checkTranslationUnit` leaves the bodies of global
+        /// functions unchecked unless they are referenced. Check the bodies that can be reached from the
+        /// translation unit's entry points (and exported functions). Must be called once the entry points are known.
+    void checkReachableFunctionBodies(
+        TranslationUnitRequest* translationUnit);
+
+        /// If decl is a global function (or generic function) whose body was left unchecked by lazy function
+        /// checking, returns the function. Such functions can't be referenced by checked code, so are not lowered.
+    FuncDecl* getUncheckedGlobalFunction(Decl* decl);
+
     // Look for a module that matches the given name:
     // either one we've loaded already, or one we
     // can find vai the search paths available to us.
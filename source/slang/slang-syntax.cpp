@@ -32,7 +32,7 @@ namespace Slang
 
 #define ABSTRACT_SYNTAX_CLASS(NAME, BASE)   \
     template<>                              \
-    SyntaxClassBase::ClassInfo const SyntaxClassBase::Impl<NAME>::kClassInfo = { #NAME, &SyntaxClassBase::Impl<BASE>::kClassInfo, nullptr };
+    SyntaxClassBase::ClassInfo const SyntaxClassBase::Impl<NAME>::kClassInfo = { #NAME, &SyntaxClassBase::Impl<BASE>::kClassInfo, nullptr, ASTClassIdOf<NAME>::kValue };
 
 #define SYNTAX_CLASS(NAME, BASE)                                                \
     void NAME::accept(NAME::Visitor* visitor, void* extra)                      \
@@ -41,10 +41,10 @@ namespace Slang
     void* SyntaxClassBase::Impl<NAME>::createFunc() { return new NAME(); }      \
     SyntaxClass<NodeBase> NAME::getClass() { return Slang::getClass<NAME>(); }  \
     template<>                                                                  \
-    SyntaxClassBase::ClassInfo const SyntaxClassBase::Impl<NAME>::kClassInfo = { #NAME, &SyntaxClassBase::Impl<BASE>::kClassInfo, &SyntaxClassBase::Impl<NAME>::createFunc };
+    SyntaxClassBase::ClassInfo const SyntaxClassBase::Impl<NAME>::kClassInfo = { #NAME, &SyntaxClassBase::Impl<BASE>::kClassInfo, &SyntaxClassBase::Impl<NAME>::createFunc, ASTClassIdOf<NAME>::kValue };
 
 template<>
-SyntaxClassBase::ClassInfo const SyntaxClassBase::Impl<RefObject>::kClassInfo = { "RefObject", nullptr, nullptr };
+SyntaxClassBase::ClassInfo const SyntaxClassBase::Impl<RefObject>::kClassInfo = { "RefObject", nullptr, nullptr, ASTClassId::CountOf };
 
 ABSTRACT_SYNTAX_CLASS(NodeBase, RefObject);
 ABSTRACT_SYNTAX_CLASS(SyntaxNodeBase, NodeBase);
@@ -71,6 +71,49 @@ ABSTRACT_SYNTAX_CLASS(GlobalGenericParamSubstitution, Substitutions);
 #include "slang-val-defs.h"
 #include "slang-object-meta-end.h"
 
+// The root classes (those derived directly from `RefObject`) have a base id of `ASTClassId::CountOf`
+template <>
+struct ASTClassIdOf<RefObject> { static const ASTClassId kValue = ASTClassId::CountOf; };
+
+ASTClassRange g_astClassRanges[size_t(ASTClassId::CountOf)];
+
+static uint32_t _numberASTClass(const List<List<uint32_t>>& derivedClasses, uint32_t classIndex, uint32_t nextIndex)
+{
+    ASTClassRange& range = g_astClassRanges[classIndex];
+    range.first = nextIndex++;
+    for (uint32_t derivedIndex : derivedClasses[classIndex])
+    {
+        nextIndex = _numberASTClass(derivedClasses, derivedIndex, nextIndex);
+    }
+    range.last = nextIndex - 1;
+    return nextIndex;
+}
+
+    /// Finds the class ranges when the library is loaded, so they are ready before any AST is built
+static struct ASTClassRangeInitializer
+{
+    ASTClassRangeInitializer()
+    {
+        const uint32_t classCount = uint32_t(ASTClassId::CountOf);
+
+        // The derived classes of each class, plus a list of the root classes at the end
+        List<List<uint32_t>> derivedClasses;
+        derivedClasses.setCount(classCount + 1);
+#define SYNTAX_CLASS(NAME, BASE, ...) \
+        derivedClasses[uint32_t(ASTClassIdOf<BASE>::kValue)].add(uint32_t(ASTClassIdOf<NAME>::kValue));
+#include "slang-object-meta-begin.h"
+#include "slang-syntax-defs.h"
+#include "slang-object-meta-end.h"
+
+        uint32_t nextIndex = 0;
+        for (uint32_t rootIndex : derivedClasses[classCount])
+        {
+            nextIndex = _numberASTClass(derivedClasses, rootIndex, nextIndex);
+        }
+        SLANG_ASSERT(nextIndex == classCount);
+    }
+} s_astClassRangeInitializer;
+
 bool SyntaxClassBase::isSubClassOfImpl(SyntaxClassBase const& super) const
 {
     SyntaxClassBase::ClassInfo const* info = classInfo;
@@ -148,24 +191,22 @@ void Type::accept(IValVisitor* visitor, void* extra)
         return canSubst;
     }
 
-    Type* Type::GetCanonicalType()
+    Type* Type::_createCanonicalType()
     {
-        Type* et = const_cast<Type*>(this);
-        if (!et->canonicalType)
-        {
-            // TODO(tfoley): worry about thread safety here?
-            auto canType = et->CreateCanonicalType();
-            et->canonicalType = canType;
-
-            // TODO(js): That this detachs when canType == this is a little surprising. It would seem
-            // as if this would create a circular reference on the object, but in practice there are
-            // no leaks so appears correct.
-            // That the dtor only releases if != this, also makes it surprising.
-            canType.detach();
-            
-            SLANG_ASSERT(et->canonicalType);
-        }
-        return et->canonicalType;
+        SLANG_ASSERT(!canonicalType);
+
+        // TODO(tfoley): worry about thread safety here?
+        auto canType = CreateCanonicalType();
+        canonicalType = canType;
+
+        // TODO(js): That this detachs when canType == this is a little surprising. It would seem
+        // as if this would create a circular reference on the object, but in practice there are
+        // no leaks so appears correct.
+        // That the dtor only releases if != this, also makes it surprising.
+        canType.detach();
+
+        SLANG_ASSERT(canonicalType);
+        return canonicalType;
     }
 
     void Session::initializeTypes()
@@ -227,7 +268,16 @@ void Type::accept(IValVisitor* visitor, void* extra)
 
     Type* Session::getBuiltinType(BaseType flavor)
     {
-        return RefPtr<Type>(builtinTypes[(int)flavor]);
+        // Builtin types are registered as the stdlib is checked
+        if (hasPendingBuiltinModules())
+        {
+            loadPendingBuiltinModules();
+        }
+        // Note that this lookup must not modify `builtinTypes`, so that
+        // the session's builtin state is not written to after the stdlib is loaded.
+        RefPtr<Type> type;
+        builtinTypes.TryGetValue(int(flavor), type);
+        return type;
     }
 
     Type* Session::getInitializerListType()
@@ -249,6 +299,8 @@ void Type::accept(IValVisitor* visitor, void* extra)
     {
         if (stringType == nullptr)
         {
+            // The type is held by the session, so shouldn't keep the arena of the module being checked alive
+            ASTArenaScope arenaScope(nullptr);
             auto stringTypeDecl = findMagicDecl(this, "StringType");
             stringType = DeclRefType::Create(this, makeDeclRef<Decl>(stringTypeDecl));
         }
@@ -259,6 +311,8 @@ void Type::accept(IValVisitor* visitor, void* extra)
     {
         if (enumTypeType == nullptr)
         {
+            // The type is held by the session, so shouldn't keep the arena of the module being checked alive
+            ASTArenaScope arenaScope(nullptr);
             auto enumTypeTypeDecl = findMagicDecl(this, "EnumTypeType");
             enumTypeType = DeclRefType::Create(this, makeDeclRef<Decl>(enumTypeTypeDecl));
         }
@@ -2028,7 +2082,13 @@ void Type::accept(IValVisitor* visitor, void* extra)
         Session*        session,
         String const&   name)
     {
-        return session->magicDecls[name].GetValue();
+        if (session->hasPendingBuiltinModules())
+        {
+            session->loadPendingBuiltinModules();
+        }
+        Decl* decl = nullptr;
+        session->magicDecls.TryGetValue(name, decl);
+        return decl;
     }
 
     //
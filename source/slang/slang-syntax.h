@@ -2,6 +2,7 @@
 #define SLANG_SYNTAX_H
 
 #include "../core/slang-basic.h"
+#include "slang-ast-arena.h"
 #include "slang-ir.h"
 #include "slang-lexer.h"
 #include "slang-profile.h"
@@ -110,6 +111,56 @@ namespace Slang
 #include "slang-syntax-defs.h"
 #include "slang-object-meta-end.h"
 
+    // Every syntax class has a byte in this struct, so the offset of the byte is an id for the
+    // class, in the order the classes are declared. (A struct is used rather than an enum as the
+    // class definitions can hold stray semicolons.)
+    struct ASTClassIdSlots
+    {
+#define SYNTAX_CLASS(NAME, BASE, ...) char NAME;
+#include "slang-object-meta-begin.h"
+#include "slang-syntax-defs.h"
+#include "slang-object-meta-end.h"
+    };
+
+    enum class ASTClassId : uint32_t
+    {
+        CountOf = sizeof(ASTClassIdSlots),
+    };
+
+        /// Gets the id of a syntax class at compile time
+    template <typename T>
+    struct ASTClassIdOf;
+    template <typename T>
+    struct ASTClassIdOf<const T> : ASTClassIdOf<T> {};
+#define SYNTAX_CLASS(NAME, BASE, ...) \
+    template <> struct ASTClassIdOf<NAME> { static const ASTClassId kValue = ASTClassId(offsetof(ASTClassIdSlots, NAME)); };
+#include "slang-object-meta-begin.h"
+#include "slang-syntax-defs.h"
+#include "slang-object-meta-end.h"
+
+        /// The classes derived from a syntax class (including itself) are numbered contiguously in a
+        /// preorder walk of the class hierarchy, so whether an object is an instance of a class is
+        /// a check that the object's class is in the class's range. The declaration order of the
+        /// classes isn't a preorder (derived classes are declared in other files from their
+        /// bases), so the ranges are found once, when the library is loaded.
+    struct ASTClassRange
+    {
+        uint32_t first;                 ///< The index of the class in the preorder
+        uint32_t last;                  ///< The index of the class's last descendant in the preorder
+    };
+    extern ASTClassRange g_astClassRanges[size_t(ASTClassId::CountOf)];
+
+    // Casts between AST node classes use the class ranges rather than `dynamic_cast`
+    // (they are defined after the classes, see `dynamicCast(NodeBase*)` below)
+    template <typename T>
+    T* dynamicCast(NodeBase* node);
+    template <typename T>
+    const T* dynamicCast(const NodeBase* node);
+    template <typename T>
+    T* as(NodeBase* node);
+    template <typename T>
+    const T* as(const NodeBase* node);
+
     // Helper type for pairing up a name and the location where it appeared
     struct NameLoc
     {
@@ -336,6 +387,9 @@ namespace Slang
 
             // Callback to use when creating instances
             CreateFunc createFunc;
+
+            // The id of the class (`ASTClassId::CountOf` for `RefObject`)
+            ASTClassId classId;
         };
 
         SyntaxClassBase()
@@ -1160,6 +1214,23 @@ namespace Slang
 
 #include "slang-object-meta-end.h"
 
+    template <typename T>
+    SLANG_FORCE_INLINE T* dynamicCast(NodeBase* node)
+    {
+        if (!node)
+            return nullptr;
+        // Unsigned wrap around makes this a single comparison
+        const ASTClassRange& range = g_astClassRanges[size_t(ASTClassIdOf<T>::kValue)];
+        const uint32_t index = g_astClassRanges[size_t(node->getClassId())].first;
+        return (index - range.first <= range.last - range.first) ? static_cast<T*>(node) : nullptr;
+    }
+    template <typename T>
+    SLANG_FORCE_INLINE const T* dynamicCast(const NodeBase* node) { return dynamicCast<T>(const_cast<NodeBase*>(node)); }
+    template <typename T>
+    SLANG_FORCE_INLINE T* as(NodeBase* node) { return dynamicCast<T>(node); }
+    template <typename T>
+    SLANG_FORCE_INLINE const T* as(const NodeBase* node) { return dynamicCast<T>(node); }
+
     inline RefPtr<Type> GetSub(DeclRef<GenericTypeConstraintDecl> const& declRef)
     {
         return declRef.Substitute(declRef.getDecl()->sub.Ptr());
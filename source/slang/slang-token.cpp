@@ -5,6 +5,9 @@
 
 namespace Slang {
 
+// Tokens are held in large numbers (a list for every preprocessed file, and the cached lexing of
+// every included file), so the type and flags are a byte each, and a token is 32 bytes on 64 bit targets
+SLANG_COMPILE_TIME_ASSERT(sizeof(Token) <= 8 + sizeof(void*) + sizeof(UnownedStringSlice));
 
 Name* Token::getName() const
 {
@@ -10,7 +10,7 @@ namespace Slang {
 
 class Name;
 
-enum class TokenType
+enum class TokenType : uint8_t
 {
 #define TOKEN(NAME, DESC) NAME,
 #include "slang-token-defs.h"
@@ -25,7 +25,7 @@ enum TokenFlag : unsigned int
     SuppressMacroExpansion  = 1 << 2,
     ScrubbingNeeded         = 1 << 3,
 };
-typedef unsigned int TokenFlags;
+typedef uint8_t TokenFlags;
 
 class Token
 {
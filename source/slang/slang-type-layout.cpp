@@ -241,17 +241,21 @@ struct GLSLBaseLayoutRulesImpl : DefaultLayoutRulesImpl
 };
 
     /// The GLSL `std430` layout rules.
-struct Std430LayoutRulesImpl : GLSLBaseLayoutRulesImpl
+struct Std430LayoutRulesImpl final : GLSLBaseLayoutRulesImpl
 {
+    Std430LayoutRulesImpl() { kind = SimpleLayoutRulesKind::Std430; }
+
     // These rules don't actually need any differences from our
     // base/common GLSL layout rules.
 };
 
-    /// The GLSL `std430` layout rules.
-struct Std140LayoutRulesImpl : GLSLBaseLayoutRulesImpl
+    /// The GLSL `std140` layout rules.
+struct Std140LayoutRulesImpl final : GLSLBaseLayoutRulesImpl
 {
     typedef GLSLBaseLayoutRulesImpl Super;
 
+    Std140LayoutRulesImpl() { kind = SimpleLayoutRulesKind::Std140; }
+
     SimpleArrayLayoutInfo GetArrayLayout(SimpleLayoutInfo elementInfo, LayoutSize elementCount) override
     {
         // The `std140` rules require that array elements
@@ -274,10 +278,12 @@ struct Std140LayoutRulesImpl : GLSLBaseLayoutRulesImpl
     }
 };
 
-struct HLSLConstantBufferLayoutRulesImpl : DefaultLayoutRulesImpl
+struct HLSLConstantBufferLayoutRulesImpl final : DefaultLayoutRulesImpl
 {
     typedef DefaultLayoutRulesImpl Super;
 
+    HLSLConstantBufferLayoutRulesImpl() { kind = SimpleLayoutRulesKind::HLSLConstantBuffer; }
+
     // Similar to GLSL `std140` rules, an HLSL constant buffer requires that
     // `struct` and array types have 16-byte alignement.
     //
@@ -346,14 +352,62 @@ struct HLSLConstantBufferLayoutRulesImpl : DefaultLayoutRulesImpl
     }
 };
 
-struct HLSLStructuredBufferLayoutRulesImpl : DefaultLayoutRulesImpl
+struct HLSLStructuredBufferLayoutRulesImpl final : DefaultLayoutRulesImpl
 {
+    HLSLStructuredBufferLayoutRulesImpl() { kind = SimpleLayoutRulesKind::HLSLStructuredBuffer; }
+
     // HLSL structured buffers drop the restrictions added for constant buffers,
     // but retain the rules around not adjusting the size of an array or
     // structure to its alignment. In this way they should match our
     // default layout rules.
 };
 
+    /// Layout of uniform data on the CPU (C and C++) targets. This matches the layout a host C++
+    /// compiler gives the types that generated code uses (see `prelude/slang-cpp-types.h`), so that
+    /// reflection describes the data as the host sees it.
+    ///
+    /// Vectors are aligned to the power of two at or above their size, as a SIMD register is, and
+    /// padded up to it, so a `float3` takes 16 bytes and can be loaded as a whole register. As in C,
+    /// the sizes of arrays and `struct` types are rounded up to their alignment.
+struct CPULayoutRulesImpl final : DefaultLayoutRulesImpl
+{
+    typedef DefaultLayoutRulesImpl Super;
+
+    CPULayoutRulesImpl() { kind = SimpleLayoutRulesKind::CPU; }
+
+    SimpleLayoutInfo GetScalarLayout(BaseType baseType) override
+    {
+        switch (baseType)
+        {
+            // The C++ target uses the C++ `bool`, and emits `half` as `float`
+            case BaseType::Bool:    return SimpleLayoutInfo(LayoutResourceKind::Uniform, 1, 1);
+            case BaseType::Half:    return SimpleLayoutInfo(LayoutResourceKind::Uniform, 4, 4);
+            default:                return Super::GetScalarLayout(baseType);
+        }
+    }
+
+    SimpleLayoutInfo GetVectorLayout(SimpleLayoutInfo elementInfo, size_t elementCount) override
+    {
+        SLANG_RELEASE_ASSERT(elementInfo.kind == LayoutResourceKind::Uniform);
+        SLANG_RELEASE_ASSERT(elementInfo.size.isFinite());
+
+        const size_t alignment = RoundUpToPowerOfTwo(elementInfo.size.getFiniteValue() * elementCount);
+        return SimpleLayoutInfo(LayoutResourceKind::Uniform, alignment, alignment);
+    }
+
+    SimpleArrayLayoutInfo GetArrayLayout(SimpleLayoutInfo elementInfo, LayoutSize elementCount) override
+    {
+        auto info = Super::GetArrayLayout(elementInfo, elementCount);
+        info.size = RoundToAlignment(info.size, info.alignment);
+        return info;
+    }
+
+    void EndStructLayout(UniformLayoutInfo* ioStructInfo) override
+    {
+        ioStructInfo->size = RoundToAlignment(ioStructInfo->size, ioStructInfo->alignment);
+    }
+};
+
 struct DefaultVaryingLayoutRulesImpl : DefaultLayoutRulesImpl
 {
     LayoutResourceKind kind;
@@ -525,6 +579,7 @@ Std140LayoutRulesImpl kStd140LayoutRulesImpl;
 Std430LayoutRulesImpl kStd430LayoutRulesImpl;
 HLSLConstantBufferLayoutRulesImpl kHLSLConstantBufferLayoutRulesImpl;
 HLSLStructuredBufferLayoutRulesImpl kHLSLStructuredBufferLayoutRulesImpl;
+CPULayoutRulesImpl kCPULayoutRulesImpl;
 
 GLSLVaryingLayoutRulesImpl kGLSLVaryingInputLayoutRulesImpl(LayoutResourceKind::VertexInput);
 GLSLVaryingLayoutRulesImpl kGLSLVaryingOutputLayoutRulesImpl(LayoutResourceKind::FragmentOutput);
@@ -540,6 +595,57 @@ HLSLRayTracingLayoutRulesImpl kHLSLRayPayloadParameterLayoutRulesImpl(LayoutReso
 HLSLRayTracingLayoutRulesImpl kHLSLCallablePayloadParameterLayoutRulesImpl(LayoutResourceKind::CallablePayload);
 HLSLRayTracingLayoutRulesImpl kHLSLHitAttributesParameterLayoutRulesImpl(LayoutResourceKind::HitAttributes);
 
+// The `LayoutRulesImpl` forwarding functions switch on the kind of the simple rules, and make
+// qualified calls on the `final` rule sets, so each case is a direct (typically inlined) call.
+// Any other rules are called through the virtual interface.
+#define SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(CALL) \
+    switch (simpleRules->kind) \
+    { \
+        case SimpleLayoutRulesKind::Std140:                 return static_cast<Std140LayoutRulesImpl*>(simpleRules)->Std140LayoutRulesImpl::CALL; \
+        case SimpleLayoutRulesKind::Std430:                 return static_cast<Std430LayoutRulesImpl*>(simpleRules)->Std430LayoutRulesImpl::CALL; \
+        case SimpleLayoutRulesKind::HLSLConstantBuffer:     return static_cast<HLSLConstantBufferLayoutRulesImpl*>(simpleRules)->HLSLConstantBufferLayoutRulesImpl::CALL; \
+        case SimpleLayoutRulesKind::HLSLStructuredBuffer:   return static_cast<HLSLStructuredBufferLayoutRulesImpl*>(simpleRules)->HLSLStructuredBufferLayoutRulesImpl::CALL; \
+        case SimpleLayoutRulesKind::CPU:                    return static_cast<CPULayoutRulesImpl*>(simpleRules)->CPULayoutRulesImpl::CALL; \
+        default:                                            return simpleRules->CALL; \
+    }
+
+SimpleLayoutInfo LayoutRulesImpl::GetScalarLayout(BaseType baseType)
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(GetScalarLayout(baseType))
+}
+
+SimpleArrayLayoutInfo LayoutRulesImpl::GetArrayLayout(SimpleLayoutInfo elementInfo, LayoutSize elementCount)
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(GetArrayLayout(elementInfo, elementCount))
+}
+
+SimpleLayoutInfo LayoutRulesImpl::GetVectorLayout(SimpleLayoutInfo elementInfo, size_t elementCount)
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(GetVectorLayout(elementInfo, elementCount))
+}
+
+SimpleArrayLayoutInfo LayoutRulesImpl::GetMatrixLayout(SimpleLayoutInfo elementInfo, size_t rowCount, size_t columnCount)
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(GetMatrixLayout(elementInfo, rowCount, columnCount))
+}
+
+UniformLayoutInfo LayoutRulesImpl::BeginStructLayout()
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(BeginStructLayout())
+}
+
+LayoutSize LayoutRulesImpl::AddStructField(UniformLayoutInfo* ioStructInfo, UniformLayoutInfo fieldInfo)
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(AddStructField(ioStructInfo, fieldInfo))
+}
+
+void LayoutRulesImpl::EndStructLayout(UniformLayoutInfo* ioStructInfo)
+{
+    SLANG_SIMPLE_LAYOUT_RULES_DISPATCH(EndStructLayout(ioStructInfo))
+}
+
+#undef SLANG_SIMPLE_LAYOUT_RULES_DISPATCH
+
 //
 
 struct GLSLLayoutRulesFamilyImpl : LayoutRulesFamilyImpl
@@ -558,6 +664,7 @@ struct GLSLLayoutRulesFamilyImpl : LayoutRulesFamilyImpl
     LayoutRulesImpl* getHitAttributesParameterRules()   override;
 
     LayoutRulesImpl* getShaderRecordConstantBufferRules() override;
+    LayoutRulesImpl* getStructuredBufferRules() override;
 };
 
 struct HLSLLayoutRulesFamilyImpl : LayoutRulesFamilyImpl
@@ -576,10 +683,32 @@ struct HLSLLayoutRulesFamilyImpl : LayoutRulesFamilyImpl
     LayoutRulesImpl* getHitAttributesParameterRules()   override;
 
     LayoutRulesImpl* getShaderRecordConstantBufferRules() override;
+    LayoutRulesImpl* getStructuredBufferRules() override;
+};
+
+    /// The C and C++ targets. Uniform data uses the CPU layout, and resources are bound as in HLSL.
+struct CPULayoutRulesFamilyImpl : LayoutRulesFamilyImpl
+{
+    virtual LayoutRulesImpl* getConstantBufferRules() override;
+    virtual LayoutRulesImpl* getPushConstantBufferRules() override;
+    virtual LayoutRulesImpl* getTextureBufferRules() override;
+    virtual LayoutRulesImpl* getVaryingInputRules() override;
+    virtual LayoutRulesImpl* getVaryingOutputRules() override;
+    virtual LayoutRulesImpl* getSpecializationConstantRules() override;
+    virtual LayoutRulesImpl* getShaderStorageBufferRules() override;
+    virtual LayoutRulesImpl* getParameterBlockRules() override;
+
+    LayoutRulesImpl* getRayPayloadParameterRules()      override;
+    LayoutRulesImpl* getCallablePayloadParameterRules() override;
+    LayoutRulesImpl* getHitAttributesParameterRules()   override;
+
+    LayoutRulesImpl* getShaderRecordConstantBufferRules() override;
+    LayoutRulesImpl* getStructuredBufferRules() override;
 };
 
 GLSLLayoutRulesFamilyImpl kGLSLLayoutRulesFamilyImpl;
 HLSLLayoutRulesFamilyImpl kHLSLLayoutRulesFamilyImpl;
+CPULayoutRulesFamilyImpl kCPULayoutRulesFamilyImpl;
 
 
 // GLSL cases
@@ -654,6 +783,32 @@ LayoutRulesImpl kHLSLHitAttributesParameterLayoutRulesImpl_ = {
     &kHLSLLayoutRulesFamilyImpl, &kHLSLHitAttributesParameterLayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
 };
 
+// CPU Family
+
+LayoutRulesImpl kCPULayoutRulesImpl_ = {
+    &kCPULayoutRulesFamilyImpl, &kCPULayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
+};
+
+LayoutRulesImpl kCPUVaryingInputLayoutRulesImpl_ = {
+    &kCPULayoutRulesFamilyImpl, &kHLSLVaryingInputLayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
+};
+
+LayoutRulesImpl kCPUVaryingOutputLayoutRulesImpl_ = {
+    &kCPULayoutRulesFamilyImpl, &kHLSLVaryingOutputLayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
+};
+
+LayoutRulesImpl kCPURayPayloadParameterLayoutRulesImpl_ = {
+    &kCPULayoutRulesFamilyImpl, &kHLSLRayPayloadParameterLayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
+};
+
+LayoutRulesImpl kCPUCallablePayloadParameterLayoutRulesImpl_ = {
+    &kCPULayoutRulesFamilyImpl, &kHLSLCallablePayloadParameterLayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
+};
+
+LayoutRulesImpl kCPUHitAttributesParameterLayoutRulesImpl_ = {
+    &kCPULayoutRulesFamilyImpl, &kHLSLHitAttributesParameterLayoutRulesImpl, &kHLSLObjectLayoutRulesImpl,
+};
+
 //
 
 LayoutRulesImpl* GLSLLayoutRulesFamilyImpl::getConstantBufferRules()
@@ -717,6 +872,11 @@ LayoutRulesImpl* GLSLLayoutRulesFamilyImpl::getHitAttributesParameterRules()
     return &kGLSLHitAttributesParameterLayoutRulesImpl_;
 }
 
+LayoutRulesImpl* GLSLLayoutRulesFamilyImpl::getStructuredBufferRules()
+{
+    return &kHLSLStructuredBufferLayoutRulesImpl_;
+}
+
 //
 
 LayoutRulesImpl* HLSLLayoutRulesFamilyImpl::getConstantBufferRules()
@@ -781,6 +941,78 @@ LayoutRulesImpl* HLSLLayoutRulesFamilyImpl::getHitAttributesParameterRules()
     return &kHLSLHitAttributesParameterLayoutRulesImpl_;
 }
 
+LayoutRulesImpl* HLSLLayoutRulesFamilyImpl::getStructuredBufferRules()
+{
+    return &kHLSLStructuredBufferLayoutRulesImpl_;
+}
+
+//
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getConstantBufferRules()
+{
+    return &kCPULayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getParameterBlockRules()
+{
+    return &kCPULayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getPushConstantBufferRules()
+{
+    return &kCPULayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getShaderRecordConstantBufferRules()
+{
+    return &kCPULayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getTextureBufferRules()
+{
+    return nullptr;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getVaryingInputRules()
+{
+    return &kCPUVaryingInputLayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getVaryingOutputRules()
+{
+    return &kCPUVaryingOutputLayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getSpecializationConstantRules()
+{
+    return nullptr;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getShaderStorageBufferRules()
+{
+    return &kCPULayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getRayPayloadParameterRules()
+{
+    return &kCPURayPayloadParameterLayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getCallablePayloadParameterRules()
+{
+    return &kCPUCallablePayloadParameterLayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getHitAttributesParameterRules()
+{
+    return &kCPUHitAttributesParameterLayoutRulesImpl_;
+}
+
+LayoutRulesImpl* CPULayoutRulesFamilyImpl::getStructuredBufferRules()
+{
+    return &kCPULayoutRulesImpl_;
+}
+
 
 
 //
@@ -818,13 +1050,11 @@ LayoutRulesFamilyImpl* getDefaultLayoutRulesFamilyForTarget(TargetRequest* targe
     case CodeGenTarget::CPPSource:
     case CodeGenTarget::CSource:
     {
-        // We just need to decide here what style of layout is appropriate, in terms of memory
-        // and binding. That in terms of the actual binding that will be injected into functions
-        // in the form of a BindContext. For now we'll go with HLSL layout -
-        // that we may want to rethink that with the use of arrays and binding VK style binding might be
+        // Uniform data is laid out as the host compiler lays out the types of the generated code.
+        // Binding is as in HLSL for now - with the use of arrays VK style binding might be
         // more appropriate in some ways.
 
-        return &kHLSLLayoutRulesFamilyImpl;
+        return &kCPULayoutRulesFamilyImpl;
     }
 
     default:
@@ -1865,10 +2095,9 @@ createStructuredBufferTypeLayout(
     RefPtr<Type>                structuredBufferType,
     RefPtr<Type>                elementType)
 {
-    // TODO(tfoley): we should be looking up the appropriate rules
-    // via the `LayoutRulesFamily` in use here...
-    auto structuredBufferLayoutRules = GetLayoutRulesImpl(
-        LayoutRule::HLSLStructuredBuffer);
+    auto structuredBufferLayoutRules = context.rules ?
+        context.getRulesFamily()->getStructuredBufferRules() :
+        GetLayoutRulesImpl(LayoutRule::HLSLStructuredBuffer);
 
     // Create and save type layout for the buffer contents.
     auto elementTypeLayout = createTypeLayout(
@@ -1887,7 +2116,8 @@ createStructuredBufferTypeLayout(
     ///
     /// This internal routine returns both the constructed type
     /// layout object and the simple layout info, encapsulated
-    /// together as a `TypeLayoutResult`.
+    /// together as a `TypeLayoutResult`. Layouts of `struct` types
+    /// may be reused from the linkage's `TypeLayoutCache`.
     ///
 static TypeLayoutResult _createTypeLayout(
     TypeLayoutContext const&    context,
@@ -2391,7 +2621,7 @@ TypeLayoutResult StructTypeLayoutBuilder::getTypeLayoutResult()
     return TypeLayoutResult(m_typeLayout, m_info);
 }
 
-static TypeLayoutResult _createTypeLayout(
+static TypeLayoutResult _createTypeLayoutUncached(
     TypeLayoutContext const&    context,
     Type*                       type)
 {
@@ -3250,6 +3480,176 @@ RefPtr<TypeLayout> getSimpleVaryingParameterTypeLayout(
         rules).layout;
 }
 
+    /// Key for a layout in `TypeLayoutCache::layouts`.
+    ///
+    /// Besides the type, this holds everything the layout of a `struct`
+    /// can depend on through the `TypeLayoutContext`.
+struct TypeLayoutCacheKey
+{
+    Type*               type;
+    LayoutRulesImpl*    rules;
+    MatrixLayoutMode    matrixLayoutMode;
+    MatrixLayoutMode    defaultMatrixLayoutMode;
+    CodeGenTarget       target;
+    Profile::RawVal     profile;
+
+    bool operator==(TypeLayoutCacheKey const& key) const
+    {
+        return rules == key.rules &&
+            matrixLayoutMode == key.matrixLayoutMode &&
+            defaultMatrixLayoutMode == key.defaultMatrixLayoutMode &&
+            target == key.target &&
+            profile == key.profile &&
+            (type == key.type || type->Equals(key.type));
+    }
+
+    int GetHashCode() const
+    {
+        int hash = type->GetHashCode();
+        hash = combineHash(hash, Slang::GetHashCode(rules));
+        hash = combineHash(hash, int(matrixLayoutMode));
+        hash = combineHash(hash, int(defaultMatrixLayoutMode));
+        hash = combineHash(hash, int(target));
+        hash = combineHash(hash, int(profile));
+        return hash;
+    }
+};
+
+    /// Layouts of `struct` types, held by a `Linkage` so that they are reused
+    /// across the compile requests, targets and entry points it is used for.
+struct TypeLayoutCache
+{
+    Dictionary<TypeLayoutCacheKey, TypeLayoutResult> layouts;
+
+        /// Declarations of these modules live as long as the linkage (or session), so
+        /// layouts of types that only reference them can be kept in the cache.
+    HashSet<ModuleDecl*> retainedModuleDecls;
+        /// The number of `Linkage::loadedModulesList` entries added to `retainedModuleDecls`
+    Index retainedLoadedModuleCount = 0;
+
+    Index hitCount = 0;
+    Index missCount = 0;
+};
+
+TypeLayoutCache* Linkage::getTypeLayoutCache()
+{
+    if (!m_typeLayoutCache)
+    {
+        m_typeLayoutCache = new TypeLayoutCache();
+        for (auto moduleDecl : getSessionImpl()->loadedModuleCode)
+            m_typeLayoutCache->retainedModuleDecls.Add(moduleDecl);
+    }
+
+    // Modules are only ever added to the list (the cache is destroyed
+    // when they are removed), so only the new ones need adding.
+    auto cache = m_typeLayoutCache;
+    for (Index i = cache->retainedLoadedModuleCount; i < loadedModulesList.getCount(); ++i)
+        cache->retainedModuleDecls.Add(loadedModulesList[i]->getModuleDecl());
+    cache->retainedLoadedModuleCount = loadedModulesList.getCount();
+
+    return cache;
+}
+
+void Linkage::destroyTypeLayoutCache()
+{
+    delete m_typeLayoutCache;
+    m_typeLayoutCache = nullptr;
+}
+
+size_t Linkage::_calcTypeLayoutCacheSize()
+{
+    auto cache = m_typeLayoutCache;
+    if (!cache)
+        return 0;
+    return sizeof(TypeLayoutCache) + cache->layouts.calcMemoryUsed() +
+        size_t(cache->retainedModuleDecls.Count()) * sizeof(ModuleDecl*);
+}
+
+static bool _isRetained(TypeLayoutCache* cache, Val* val);
+
+static bool _isRetained(TypeLayoutCache* cache, DeclRef<Decl> const& declRef)
+{
+    ModuleDecl* moduleDecl = nullptr;
+    for (auto decl = declRef.getDecl(); decl && !moduleDecl; decl = decl->ParentDecl)
+        moduleDecl = as<ModuleDecl>(decl);
+    if (!moduleDecl || !cache->retainedModuleDecls.Contains(moduleDecl))
+        return false;
+
+    for (auto subst = declRef.substitutions.substitutions; subst; subst = subst->outer)
+    {
+        auto genericSubst = as<GenericSubstitution>(subst);
+        if (!genericSubst)
+            return false;
+        for (auto arg : genericSubst->args)
+        {
+            if (!_isRetained(cache, arg))
+                return false;
+        }
+    }
+    return true;
+}
+
+    /// True if everything `val` references outlives the current compile request
+static bool _isRetained(TypeLayoutCache* cache, Val* val)
+{
+    if (as<ConstantIntVal>(val))
+        return true;
+    if (auto declRefType = as<DeclRefType>(val))
+        return _isRetained(cache, declRefType->declRef);
+    if (auto arrayType = as<ArrayExpressionType>(val))
+    {
+        return _isRetained(cache, arrayType->baseType) &&
+            (!arrayType->ArrayLength || _isRetained(cache, arrayType->ArrayLength));
+    }
+    return false;
+}
+
+static TypeLayoutResult _createTypeLayout(
+    TypeLayoutContext const&    context,
+    Type*                       type)
+{
+    // Only `struct` layouts are cached: they are the ones that can be expensive
+    // to recompute, and they can't depend on the program being laid out unless
+    // there are existential or global generic arguments.
+    //
+    auto declRefType = as<DeclRefType>(type);
+    if (!declRefType || !declRefType->declRef.as<StructDecl>() ||
+        context.existentialTypeArgCount != 0 ||
+        (context.programLayout && context.programLayout->globalGenericParams.getCount() != 0))
+    {
+        return _createTypeLayoutUncached(context, type);
+    }
+
+    auto targetReq = context.targetReq;
+    auto cache = targetReq->getLinkage()->getTypeLayoutCache();
+
+    // Types declared in a translation unit are freed with its compile
+    // request, so their layouts can't outlive it.
+    if (!_isRetained(cache, type))
+        return _createTypeLayoutUncached(context, type);
+
+    TypeLayoutCacheKey key;
+    key.type = type;
+    key.rules = context.rules;
+    key.matrixLayoutMode = context.matrixLayoutMode;
+    key.defaultMatrixLayoutMode = targetReq->getDefaultMatrixLayoutMode();
+    key.target = targetReq->getTarget();
+    key.profile = targetReq->getTargetProfile().raw;
+
+    if (auto result = cache->layouts.TryGetValue(key))
+    {
+        cache->hitCount++;
+        return *result;
+    }
+
+    cache->missCount++;
+    TypeLayoutResult result = _createTypeLayoutUncached(context, type);
+    // The key keeps a pointer to the type, so make sure it lives as long as the layout
+    SLANG_ASSERT(result.layout->type.Ptr() == type);
+    cache->layouts.Add(key, result);
+    return result;
+}
+
 RefPtr<TypeLayout> createTypeLayout(
     TypeLayoutContext const&    context,
     Type*                       type)
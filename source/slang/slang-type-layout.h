@@ -2,6 +2,7 @@
 #define SLANG_TYPE_LAYOUT_H
 
 #include "../core/slang-basic.h"
+#include "../core/slang-uint-set.h"
 #include "slang-compiler.h"
 #include "slang-profile.h"
 #include "slang-syntax.h"
@@ -296,6 +297,8 @@ struct LayoutRulesImpl;
 // Base class for things that store layout info
 class Layout : public RefObject
 {
+public:
+    SLANG_REF_OBJECT_POOL_ALLOCATED
 };
 
 // A reified representation of a particular laid-out type
@@ -656,12 +659,38 @@ public:
 };
 
     /// Layout for a scoped entity like a program, module, or entry point
+    /// A leaf of the parameters of a scope, with the absolute location it was bound to.
+    ///
+    /// There is one entry for each kind of resource a leaf uses. For uniform data
+    /// `index` is the byte offset within the buffer given by `bufferIndex`, and
+    /// `count` is the size in bytes.
+    ///
+struct BindingTableEntry
+{
+    String              path;
+    LayoutResourceKind  kind = LayoutResourceKind::None;
+    RefPtr<TypeLayout>  typeLayout;
+    UInt                index = 0;
+    UInt                space = 0;
+    LayoutSize          count;
+
+        /// Index of the entry for the buffer holding uniform data, or -1 if there isn't one
+    Index               bufferIndex = -1;
+
+        /// Index of the parameter of the scope the leaf is in, or -1 if it isn't in one
+        /// (such as the implicit constant buffer for global uniforms)
+    Index               parameterIndex = -1;
+};
+
 class ScopeLayout : public Layout
 {
 public:
     // The layout for the parameters of this entity.
     //
     RefPtr<VarLayout> parametersLayout;
+
+        /// The parameters flattened to their leaves, filled in by `generateParameterBindings`
+    List<BindingTableEntry> bindingTable;
 };
 
 StructTypeLayout* getScopeStructLayout(
@@ -699,9 +728,18 @@ public:
         /// Layouts for all tagged union types required by this entry point.
         ///
         /// These are any tagged union types used by the generic
-        /// arguments that this entry point is being compiled with.
+        /// arguments, or the existential type arguments, that this
+        /// entry point is being compiled with.
     List<RefPtr<TypeLayout>> taggedUnionTypeLayouts;
 
+        /// The global parameters (by index in the parameters of the program) used
+        /// by the code generated for the entry point, once there is any.
+        ///
+        /// Parameters whose uses are removed as dead code are not included.
+        ///
+    UIntSet usedGlobalParameters;
+    bool hasUsedGlobalParameters = false;
+
     EntryPointLayout* getAbsoluteLayout(VarLayout* parentLayout);
     EntryPointLayout* getAbsoluteLayout(EntryPointGroupLayout* parentGroup);
 
@@ -762,6 +800,27 @@ public:
 
     List<RefPtr<GenericParamLayout>> globalGenericParams;
     Dictionary<String, GenericParamLayout*> globalGenericParamsMap;
+
+        /// A global constant marked `[[vk::constant_id(...)]]`, whose value can be set
+        /// when a pipeline is created instead of compiling a variant for each value.
+    struct SpecializationConstant
+    {
+        VarDeclBase* varDecl = nullptr;
+        Int id = 0;
+            /// The value of the constant's initializer
+        IntegerLiteralValue defaultValue = 0;
+    };
+
+        /// The specialization constants declared in the program, whether or not
+        /// the target supports them (targets that don't use the default values)
+    List<SpecializationConstant> specializationConstants;
+
+        /// Layouts for all tagged union types used as arguments for the
+        /// global existential type parameters of the program.
+        ///
+        /// A `__TaggedUnion(A, B, ...)` argument lets a single kernel serve
+        /// any of the listed types, by dispatching on a tag at runtime.
+    List<RefPtr<TypeLayout>> taggedUnionTypeLayouts;
 };
 
 StructTypeLayout* getGlobalStructLayout(
@@ -807,8 +866,23 @@ enum class ShaderParameterKind
     RegisterSpace,
 };
 
+    /// Identifies the rule sets for uniform data that `LayoutRulesImpl` calls directly,
+    /// so that the per field/element steps of layout can be inlined. `Other` rules are
+    /// only called through the virtual interface.
+enum class SimpleLayoutRulesKind : uint8_t
+{
+    Other,
+    Std140,
+    Std430,
+    HLSLConstantBuffer,
+    HLSLStructuredBuffer,
+    CPU,
+};
+
 struct SimpleLayoutRulesImpl
 {
+    SimpleLayoutRulesKind kind = SimpleLayoutRulesKind::Other;
+
     // Get size and alignment for a single value of base type.
     virtual SimpleLayoutInfo GetScalarLayout(BaseType baseType) = 0;
 
@@ -842,41 +916,17 @@ struct LayoutRulesImpl
     ObjectLayoutRulesImpl*  objectRules;
 
     // Forward `SimpleLayoutRulesImpl` interface
+    //
+    // These are defined alongside the rule sets, and dispatch on `simpleRules->kind`
+    // to call the known rule sets without a virtual call.
 
-    SimpleLayoutInfo GetScalarLayout(BaseType baseType)
-    {
-        return simpleRules->GetScalarLayout(baseType);
-    }
-
-    SimpleArrayLayoutInfo GetArrayLayout(SimpleLayoutInfo elementInfo, LayoutSize elementCount)
-    {
-        return simpleRules->GetArrayLayout(elementInfo, elementCount);
-    }
-
-    SimpleLayoutInfo GetVectorLayout(SimpleLayoutInfo elementInfo, size_t elementCount)
-    {
-        return simpleRules->GetVectorLayout(elementInfo, elementCount);
-    }
-
-    SimpleArrayLayoutInfo GetMatrixLayout(SimpleLayoutInfo elementInfo, size_t rowCount, size_t columnCount)
-    {
-        return simpleRules->GetMatrixLayout(elementInfo, rowCount, columnCount);
-    }
-
-    UniformLayoutInfo BeginStructLayout()
-    {
-        return simpleRules->BeginStructLayout();
-    }
-
-    LayoutSize AddStructField(UniformLayoutInfo* ioStructInfo, UniformLayoutInfo fieldInfo)
-    {
-        return simpleRules->AddStructField(ioStructInfo, fieldInfo);
-    }
-
-    void EndStructLayout(UniformLayoutInfo* ioStructInfo)
-    {
-        return simpleRules->EndStructLayout(ioStructInfo);
-    }
+    SimpleLayoutInfo GetScalarLayout(BaseType baseType);
+    SimpleArrayLayoutInfo GetArrayLayout(SimpleLayoutInfo elementInfo, LayoutSize elementCount);
+    SimpleLayoutInfo GetVectorLayout(SimpleLayoutInfo elementInfo, size_t elementCount);
+    SimpleArrayLayoutInfo GetMatrixLayout(SimpleLayoutInfo elementInfo, size_t rowCount, size_t columnCount);
+    UniformLayoutInfo BeginStructLayout();
+    LayoutSize AddStructField(UniformLayoutInfo* ioStructInfo, UniformLayoutInfo fieldInfo);
+    void EndStructLayout(UniformLayoutInfo* ioStructInfo);
 
     // Forward `ObjectLayoutRulesImpl` interface
 
@@ -906,6 +956,9 @@ struct LayoutRulesFamilyImpl
     virtual LayoutRulesImpl* getHitAttributesParameterRules()= 0;
 
     virtual LayoutRulesImpl* getShaderRecordConstantBufferRules() = 0;
+
+        /// Rules for the elements of a structured buffer
+    virtual LayoutRulesImpl* getStructuredBufferRules() = 0;
 };
 
 typedef List<RefPtr<GenericParamLayout>> GenericParamLayouts;
@@ -3,10 +3,15 @@
 #include "../core/slang-io.h"
 #include "../core/slang-string-util.h"
 #include "../core/slang-shared-library.h"
+#include "../core/slang-process-util.h"
+#include "../core/slang-thread-pool.h"
 
+#include "slang-compile-cache.h"
 #include "slang-parameter-binding.h"
 #include "slang-lower-to-ir.h"
+#include "slang-lookup.h"
 #include "slang-parser.h"
+#include "slang-precompiled-module.h"
 #include "slang-preprocessor.h"
 #include "slang-reflection.h"
 #include "slang-syntax-visitors.h"
@@ -66,6 +71,7 @@ Session::Session()
 
     // Make sure our source manager is initialized
     builtinSourceManager.initialize(nullptr, nullptr);
+    m_moduleCacheSourceManager.initialize(&builtinSourceManager, nullptr, SourceLoc::fromRaw(kModuleCacheStartLoc));
 
     m_builtinLinkage = new Linkage(this);
 
@@ -74,8 +80,11 @@ Session::Session()
 
     // Create scopes for various language builtins.
     //
-    // TODO: load these on-demand to avoid parsing
-    // stdlib code for languages the user won't use.
+    // The stdlib code for the core and hlsl scopes is
+    // loaded on demand (see `loadPendingBuiltinModules`),
+    // so that requests that never look anything up in
+    // them (e.g., pass-through compiles) don't pay to
+    // parse and check it.
 
     baseLanguageScope = new Scope();
 
@@ -93,8 +102,99 @@ Session::Session()
     slangLanguageScope = new Scope();
     slangLanguageScope->nextSibling = hlslLanguageScope;
 
-    addBuiltinSource(coreLanguageScope, "core", getCoreLibraryCode());
-    addBuiltinSource(hlslLanguageScope, "hlsl", getHLSLLibraryCode());
+    m_pendingBuiltinModules.add(PendingBuiltinModule{ coreLanguageScope, "core", &Session::getCoreLibraryCode });
+    m_pendingBuiltinModules.add(PendingBuiltinModule{ hlslLanguageScope, "hlsl", &Session::getHLSLLibraryCode });
+}
+
+void Session::loadPendingBuiltinModules(Scope* scope)
+{
+    // Lookups made while checking a stdlib module must not trigger loading
+    // of later modules: they see the same (empty) scopes they would have
+    // seen if all modules were loaded eagerly, in order.
+    if (m_isLoadingBuiltinModule)
+        return;
+
+    // Find the last pending module that is loaded into `scope`. It and every
+    // pending module before it need to be loaded.
+    Index loadCount = 0;
+    for (Index i = 0; i < m_pendingBuiltinModules.getCount(); ++i)
+    {
+        if (!scope || m_pendingBuiltinModules[i].scope == scope)
+        {
+            loadCount = i + 1;
+        }
+    }
+    if (loadCount == 0)
+        return;
+
+    List<PendingBuiltinModule> modules;
+    modules.addRange(m_pendingBuiltinModules.getBuffer(), loadCount);
+    m_pendingBuiltinModules.removeRange(0, loadCount);
+
+    const uint64_t startTick = ProcessUtil::getClockTick();
+
+    m_isLoadingBuiltinModule = true;
+    for (auto const& module : modules)
+    {
+        addBuiltinSource(module.scope, module.path, (this->*module.getSource)());
+        m_loadedBuiltinModuleCount++;
+    }
+    m_isLoadingBuiltinModule = false;
+
+    m_builtinModuleLoadTicks += ProcessUtil::getClockTick() - startTick;
+}
+
+bool Session::isNameUndeclaredInBuiltinScope(Scope* scope, Name* name)
+{
+    // Only the scopes modules are parented to are answered for. Lookup starting at the core or base scope
+    // only happens while the stdlib is loading.
+    if (scope != slangLanguageScope && scope != hlslLanguageScope)
+        return false;
+
+    // Until the stdlib is loaded the containers of the scopes are still changing
+    if (hasPendingBuiltinModules() || m_isLoadingBuiltinModule)
+        return false;
+
+    if (!m_builtinNamesIsValid)
+    {
+        _buildBuiltinNames();
+    }
+    return m_builtinNamesIsComplete && !m_builtinNames.Contains(name);
+}
+
+void Session::_buildBuiltinNames()
+{
+    m_builtinNames = HashSet<Name*>();
+    m_builtinNamesIsComplete = true;
+
+    // The siblings of the hlsl scope are a subset of those of the slang scope, so the names of the slang
+    // scope are a superset of both. That is fine for telling a name is *not* declared.
+    for (Scope* link = slangLanguageScope; link; link = link->nextSibling)
+    {
+        auto containerDecl = link->containerDecl;
+        if (!containerDecl)
+            continue;
+
+        buildMemberDictionary(containerDecl);
+
+        // Lookup also searches transparent members, whose names aren't in the dictionary
+        if (containerDecl->transparentMembers.getCount())
+        {
+            m_builtinNamesIsComplete = false;
+        }
+        for (const auto& pair : containerDecl->memberDictionary)
+        {
+            m_builtinNames.Add(pair.Key);
+        }
+    }
+    m_builtinNamesIsValid = true;
+}
+
+void Session::getStdLibStats(SlangSessionStdLibStats& outStats)
+{
+    outStats.loadedModuleCount = SlangUInt(m_loadedBuiltinModuleCount);
+    outStats.pendingModuleCount = SlangUInt(m_pendingBuiltinModules.getCount());
+    outStats.loadTimeInSeconds = double(m_builtinModuleLoadTicks) / double(ProcessUtil::getClockFrequency());
 }
 
 ISlangUnknown* Session::getInterface(const Guid& guid)
@@ -121,6 +221,31 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Session::createSession(
         linkage->m_useFalcorCustomSharedKeywordSemantics = true;
     }
 
+    if(desc.flags & slang::kSessionFlag_IncrementalCompilation)
+    {
+        linkage->m_isIncremental = true;
+    }
+
+    if(desc.flags & slang::kSessionFlag_FileChangeNotifications)
+    {
+        linkage->m_useFileChangeNotifications = true;
+    }
+
+    if(desc.flags & slang::kSessionFlag_CompactModules)
+    {
+        linkage->m_compactModules = true;
+    }
+
+    if(desc.flags & slang::kSessionFlag_SharedFileCache)
+    {
+        linkage->setUseSharedFileCache(true);
+    }
+
+    if(desc.flags & slang::kSessionFlag_SharedModuleCache)
+    {
+        linkage->m_useSharedModuleCache = true;
+    }
+
     linkage->setMatrixLayoutMode(desc.defaultMatrixLayoutMode);
 
     Int searchPathCount = desc.searchPathCount;
@@ -380,11 +505,23 @@ Linkage::Linkage(Session* session)
 {
     getNamePool()->setRootNamePool(session->getRootNamePool());
 
-    m_defaultSourceManager.initialize(session->getBuiltinSourceManager(), nullptr);
+    // Locations in modules from the shared module cache are found through the module cache source manager,
+    // while the locations of the linkage follow on from those of the builtin source manager.
+    m_defaultSourceManager.initialize(
+        session->getModuleCacheSourceManager(),
+        nullptr,
+        session->getBuiltinSourceManager()->getSourceRange().end);
 
     setFileSystem(nullptr);
 }
 
+Linkage::~Linkage()
+{
+    destroyPermutationCache();
+    destroyTypeLayoutCache();
+    destroyTypeCheckingCache();
+}
+
 ISlangUnknown* Linkage::getInterface(const Guid& guid)
 {
     if(guid == IID_ISlangUnknown || guid == IID_ISession)
@@ -429,6 +566,8 @@ SLANG_NO_THROW slang::IModule* SLANG_MCALL Linkage::loadModule(
 {
     auto name = getNamePool()->getName(moduleName);
 
+    removeChangedModules();
+
     DiagnosticSink sink(getSourceManager());
     auto module = findOrImportModule(name, SourceLoc(), &sink);
     sink.getBlobIfNeeded(outDiagnostics);
@@ -536,6 +675,8 @@ SLANG_NO_THROW slang::TypeLayoutReflection* SLANG_MCALL Linkage::getTypeLayout(
 SLANG_NO_THROW SlangResult SLANG_MCALL Linkage::createCompileRequest(
     SlangCompileRequest**   outCompileRequest)
 {
+    removeChangedModules();
+
     auto compileRequest = new EndToEndCompileRequest(this);
     *outCompileRequest = asExternal(compileRequest);
     return SLANG_OK;
@@ -609,6 +750,54 @@ ComPtr<ISlangBlob> createRawBlob(void const* inData, size_t size)
     return ComPtr<ISlangBlob>(new RawBlob(inData, size));
 }
 
+/** A blob that holds the contents of a list, taken without copying them.
+*/
+class ListBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data.getBuffer(); }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return size_t(m_data.getCount()); }
+
+    // Ctor
+    explicit ListBlob(List<uint8_t>& ioData) { m_data.swapWith(ioData); }
+
+protected:
+    List<uint8_t> m_data;
+};
+
+ComPtr<ISlangBlob> createListBlob(List<uint8_t>& ioData)
+{
+    return ComPtr<ISlangBlob>(new ListBlob(ioData));
+}
+
+/** A blob whose contents are held by another object.
+*/
+class OwnedDataBlob : public BlobBase
+{
+public:
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE { return m_data; }
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_size; }
+
+    // Ctor
+    OwnedDataBlob(ISlangUnknown* owner, void const* data, size_t size):
+        m_owner(owner),
+        m_data(data),
+        m_size(size)
+    {}
+
+protected:
+    ComPtr<ISlangUnknown> m_owner;
+    void const* m_data;
+    size_t m_size;
+};
+
+ComPtr<ISlangBlob> createOwnedDataBlob(ISlangUnknown* owner, void const* data, size_t size)
+{
+    return ComPtr<ISlangBlob>(new OwnedDataBlob(owner, data, size));
+}
+
 //
 // TargetRequest
 //
@@ -676,6 +865,7 @@ SourceManager* TranslationUnitRequest::getSourceManager()
 void TranslationUnitRequest::addSourceFile(SourceFile* sourceFile)
 {
     m_sourceFiles.add(sourceFile);
+    getModule()->addSourceFile(sourceFile);
 
     // We want to record that the compiled module has a dependency
     // on the path of the source file, but we also need to account
@@ -819,6 +1009,37 @@ Type* Program::getTypeFromString(String typeStr, DiagnosticSink* sink)
     return type;
 }
 
+String Program::getShortName(String const& name)
+{
+    String shortName;
+    if (m_shortNames.TryGetValue(name, shortName))
+        return shortName;
+
+    // The short name is `_h` and the hash in hex. Names from name hints always end
+    // in `_` and a number, and mangled names start with `_S`, so they can't clash
+    // with it. Another name with the same hash gets the next hash value instead.
+    // The hash is the stable one, so the output is the same on every platform.
+    uint32_t hash = getStableHashCode32(name.getBuffer(), size_t(name.getLength()));
+    for (;;)
+    {
+        StringBuilder sb;
+        sb << "_h";
+        const String hex = String(hash, 16);
+        for (Index i = hex.getLength(); i < 8; ++i)
+            sb << "0";
+        sb << hex;
+        shortName = sb.ProduceString();
+
+        if (!m_originalNames.ContainsKey(shortName))
+            break;
+        hash++;
+    }
+
+    m_shortNames.Add(name, shortName);
+    m_originalNames.Add(shortName, name);
+    return shortName;
+}
+
 
 
 
@@ -837,8 +1058,16 @@ FrontEndCompileRequest::FrontEndCompileRequest(
 {
 }
 
-void FrontEndCompileRequest::parseTranslationUnit(
-    TranslationUnitRequest* translationUnit)
+void FrontEndCompileRequest::reset()
+{
+    translationUnits.clear();
+    m_entryPointReqs.clear();
+    m_program = nullptr;
+}
+
+TokenList FrontEndCompileRequest::_preprocessSourceFile(
+    TranslationUnitRequest* translationUnit,
+    SourceFile*             sourceFile)
 {
     IncludeHandlerImpl includeHandler;
 
@@ -854,6 +1083,42 @@ void FrontEndCompileRequest::parseTranslationUnit(
     includeHandler.linkage = linkage;
     includeHandler.searchDirectories = &linkage->searchDirectories;
 
+    Dictionary<String, String> combinedPreprocessorDefinitions;
+    for(auto& def : getLinkage()->preprocessorDefinitions)
+        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
+    for(auto& def : preprocessorDefinitions)
+        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
+    for(auto& def : translationUnit->preprocessorDefinitions)
+        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
+
+    auto profiler = linkage->getProfiler();
+    const String path = profiler ? sourceFile->getPathInfo().foundPath : String();
+
+    CompileProfileScope profileScope(profiler, CompileProfiler::kFrontEndCategory, "preprocess", path);
+    return preprocessSource(
+        sourceFile,
+        getSink(),
+        &includeHandler,
+        combinedPreprocessorDefinitions,
+        getLinkage(),
+        translationUnit->getModule());
+}
+
+void FrontEndCompileRequest::preprocessTranslationUnit(
+    TranslationUnitRequest* translationUnit)
+{
+    translationUnit->preprocessedTokens.clear();
+    for (auto sourceFile : translationUnit->getSourceFiles())
+    {
+        translationUnit->preprocessedTokens.add(_preprocessSourceFile(translationUnit, sourceFile));
+    }
+}
+
+void FrontEndCompileRequest::parseTranslationUnit(
+    TranslationUnitRequest* translationUnit)
+{
+    auto linkage = getLinkage();
+
     RefPtr<Scope> languageScope;
     switch (translationUnit->sourceLanguage)
     {
@@ -867,36 +1132,46 @@ void FrontEndCompileRequest::parseTranslationUnit(
         break;
     }
 
-    Dictionary<String, String> combinedPreprocessorDefinitions;
-    for(auto& def : getLinkage()->preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-    for(auto& def : preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-    for(auto& def : translationUnit->preprocessorDefinitions)
-        combinedPreprocessorDefinitions.Add(def.Key, def.Value);
-
     auto module = translationUnit->getModule();
+
+    // The AST for the translation unit is allocated from the module's arena
+    ASTArenaScope arenaScope(module->getASTArena());
+
     RefPtr<ModuleDecl> translationUnitSyntax = new ModuleDecl();
     translationUnitSyntax->nameAndLoc.name = translationUnit->moduleName;
     translationUnitSyntax->module = module;
     module->setModuleDecl(translationUnitSyntax);
 
-    for (auto sourceFile : translationUnit->getSourceFiles())
+    // The translation unit may already have been preprocessed (to deduplicate permutations),
+    // in which case the tokens are used rather than preprocessing again.
+    const bool isPreprocessed = translationUnit->preprocessedTokens.getCount() == translationUnit->getSourceFiles().getCount();
+
+    auto profiler = linkage->getProfiler();
+    const Index sourceFileCount = translationUnit->getSourceFiles().getCount();
+    for (Index ii = 0; ii < sourceFileCount; ++ii)
     {
-        auto tokens = preprocessSource(
-            sourceFile,
-            getSink(),
-            &includeHandler,
-            combinedPreprocessorDefinitions,
-            getLinkage(),
-            module);
+        auto sourceFile = translationUnit->getSourceFiles()[ii];
+
+        TokenList tokens;
+        if (isPreprocessed)
+            tokens = _Move(translationUnit->preprocessedTokens[ii]);
+        else
+            tokens = _preprocessSourceFile(translationUnit, sourceFile);
 
+        const String path = profiler ? sourceFile->getPathInfo().foundPath : String();
+        CompileProfileScope profileScope(profiler, CompileProfiler::kFrontEndCategory, "parse", path);
         parseSourceFile(
             translationUnit,
             tokens,
             getSink(),
             languageScope);
+
+        if (shouldGenerateModuleInterface)
+        {
+            appendModuleInterfaceSource(translationUnitSyntax, tokens, translationUnit->moduleInterfaceSource);
+        }
     }
+    translationUnit->preprocessedTokens = List<TokenList>();
 }
 
 RefPtr<Program> createUnspecializedProgram(
@@ -911,6 +1186,7 @@ void FrontEndCompileRequest::checkAllTranslationUnits()
     // apply the semantic checking logic.
     for( auto& translationUnit : translationUnits )
     {
+        checkCompileBudget(getLinkage()->getBudget());
         checkTranslationUnit(translationUnit.Ptr());
     }
 }
@@ -932,15 +1208,22 @@ void FrontEndCompileRequest::generateIR()
         // * it can dump ir 
         // * it can generate diagnostics
 
+        checkCompileBudget(getLinkage()->getBudget());
+
         /// Generate IR for translation unit
-        RefPtr<IRModule> irModule(generateIRForTranslationUnit(translationUnit));
+        RefPtr<IRModule> irModule;
+        {
+            IRPassProfileScope profileScope(getLinkage()->getProfiler(), "lower-to-ir", nullptr, CompileProfiler::kFrontEndCategory);
+            irModule = generateIRForTranslationUnit(translationUnit);
+            profileScope.setModule(irModule);
+        }
 
         if (verifyDebugSerialization)
         {
             // Verify debug information
             if (SLANG_FAILED(IRSerialUtil::verifySerialize(irModule, getSession(), getSourceManager(), IRSerialBinary::CompressionType::None, IRSerialWriter::OptionFlag::DebugInfo)))
             {
-                getSink()->diagnose(irModule->moduleInst->sourceLoc, Diagnostics::serialDebugVerificationFailed);
+                getSink()->diagnose(irModule->moduleInst->getSourceLoc(), Diagnostics::serialDebugVerificationFailed);
             }
         }
 
@@ -955,6 +1238,36 @@ void FrontEndCompileRequest::generateIR()
                 // Destroy irModule such that memory can be used for newly constructed read irReadModule  
                 irModule = nullptr;
             }
+            if (serialIRCompression.getLength())
+            {
+                // Go through the binary format too. The size is recorded in the profile events, so
+                // the compression options can be compared with slang-bench.
+                IRSerialWriter::StreamOptions streamOptions;
+                IRSerialUtil::parseStreamOptions(serialIRCompression.getUnownedSlice(), streamOptions);
+
+                // Chunks can be encoded and decoded independently, so can use a pool if there are multiple jobs
+                Index threadCount = serialIRJobCount;
+                if (threadCount == 0)
+                    threadCount = ThreadPool::getDefaultThreadCount();
+
+                ThreadPool pool(threadCount > 1 ? threadCount : 0);
+                ThreadPool* threadPool = (threadCount > 1) ? &pool : nullptr;
+
+                auto profiler = getLinkage()->getProfiler();
+                MemoryStream stream(FileAccess::ReadWrite);
+                {
+                    CompileProfileScope profileScope(profiler, CompileProfiler::kFrontEndCategory, "serialize-ir", serialIRCompression);
+                    IRSerialWriter::writeStream(serialData, streamOptions, &stream, threadPool);
+                }
+                const Int64 streamSize = stream.GetPosition();
+                stream.Seek(SeekOrigin::Start, 0);
+                {
+                    StringBuilder detail;
+                    detail << serialIRCompression << ", " << streamSize << " bytes";
+                    CompileProfileScope profileScope(profiler, CompileProfiler::kFrontEndCategory, "deserialize-ir", detail);
+                    IRSerialReader::readStream(&stream, &serialData, threadPool);
+                }
+            }
             RefPtr<IRModule> irReadModule;
             {
                 // Read IR back from serialData
@@ -1018,13 +1331,17 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     // Parse everything from the input files requested
     for (auto& translationUnit : translationUnits)
     {
+        checkCompileBudget(getLinkage()->getBudget());
         parseTranslationUnit(translationUnit.Ptr());
     }
     if (getSink()->GetErrorCount() != 0)
         return SLANG_FAIL;
 
     // Perform semantic checking on the whole collection
-    checkAllTranslationUnits();
+    {
+        CompileProfileScope profileScope(getLinkage()->getProfiler(), CompileProfiler::kFrontEndCategory, "check");
+        checkAllTranslationUnits();
+    }
     if (getSink()->GetErrorCount() != 0)
         return SLANG_FAIL;
 
@@ -1036,22 +1353,52 @@ SlangResult FrontEndCompileRequest::executeActionsInner()
     if (getSink()->GetErrorCount() != 0)
         return SLANG_FAIL;
 
-    // We always generate IR for all the translation units.
+    // With lazy function checking, only the function bodies that can be reached from
+    // the entry points (which are now known) are checked
+    if (compileFlags & SLANG_COMPILE_FLAG_LAZY_FUNCTION_CHECKING)
+    {
+        for (auto& translationUnit : translationUnits)
+        {
+            checkCompileBudget(getLinkage()->getBudget());
+            checkReachableFunctionBodies(translationUnit);
+        }
+        if (getSink()->GetErrorCount() != 0)
+            return SLANG_FAIL;
+    }
+
+    // We generate IR for all the translation units, unless
+    // the request only wants an AST.
     //
-    // TODO: We may eventually have a mode where we skip
-    // IR codegen and only produce an AST (e.g., for use when
-    // debugging problems in the parser or semantic checking),
-    // but for now there are no cases where not having IR
-    // makes sense.
+    // The standard library is the one case where IR is not
+    // wanted: the session only retains the checked AST for the
+    // builtin modules, and any IR generated for them would be
+    // thrown away.
     //
-    generateIR();
-    if (getSink()->GetErrorCount() != 0)
-        return SLANG_FAIL;
+    if (!shouldGenerateIR)
+        return SLANG_OK;
+
+    // Parameter binding only needs the checked AST, so a request
+    // that is only made for reflection can skip lowering to IR,
+    // which is usually the most expensive step in the front end.
+    //
+    if (compileFlags & SLANG_COMPILE_FLAG_REFLECTION_ONLY)
+    {
+        if (auto profiler = getLinkage()->getProfiler())
+            profiler->addCounter("lower-to-ir-skipped-translation-units", translationUnits.getCount());
+    }
+    else
+    {
+        generateIR();
+        if (getSink()->GetErrorCount() != 0)
+            return SLANG_FAIL;
+    }
 
     // Do parameter binding generation, for each compilation target.
     //
     for(auto targetReq : getLinkage()->targets)
     {
+        checkCompileBudget(getLinkage()->getBudget());
+        CompileProfileScope profileScope(getLinkage()->getProfiler(), CompileProfiler::kFrontEndCategory, "layout");
         auto targetProgram = m_program->getTargetProgram(targetReq);
         targetProgram->getOrCreateLayout(getSink());
     }
@@ -1066,6 +1413,7 @@ BackEndCompileRequest::BackEndCompileRequest(
     DiagnosticSink* sink,
     Program*        program)
     : CompileRequestBase(linkage, sink)
+    , emittedSourceCache(new EmittedSourceCache())
     , m_program(program)
 {}
 
@@ -1099,11 +1447,44 @@ void EndToEndCompileRequest::init()
 
     m_frontEndReq = new FrontEndCompileRequest(getLinkage(), getSink());
 
+    // Made up front (rather than when a limit is set), so that `spCancelCompile` never races with its creation
+    budget = new CompileBudget;
+
     m_backEndReq = new BackEndCompileRequest(getLinkage(), getSink());
 }
 
+void EndToEndCompileRequest::reset()
+{
+    m_frontEndReq->reset();
+    m_backEndReq->setProgram(nullptr);
+
+    m_unspecializedProgram = nullptr;
+    m_specializedProgram = nullptr;
+
+    entryPoints.clear();
+    globalGenericArgStrings.clear();
+    globalExistentialSlotArgStrings.clear();
+    for (auto& pair : targetInfos)
+    {
+        pair.Value->entryPointOutputPaths.Clear();
+    }
+
+    m_sink.reset();
+    mDiagnosticOutput = String();
+    mProfileChromeTrace = String();
+    mPreprocessOutput = String();
+    mPreprocessDependencies.clear();
+    diagnosticOutputBlob.setNull();
+}
+
 SlangResult EndToEndCompileRequest::executeActionsInner()
 {
+    // A preprocess-only compile stops before anything else is done
+    if (preprocessOnlyMode != SLANG_PREPROCESS_ONLY_NONE)
+    {
+        return _executePreprocessOnly();
+    }
+
     // If no code-generation target was specified, then try to infer one from the source language,
     // just to make sure we can do something reasonable when invoked from the command line.
     //
@@ -1128,6 +1509,55 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
         }
     }
 
+    // If a compile cache is set up, a previous compile with the same inputs
+    // may allow us to skip compilation entirely.
+    //
+    String compileCacheKey;
+    if (_hasCompileCache() && CompileCache::canCache(this))
+    {
+        StringBuilder keyBuilder;
+        CompileCache::calcKey(this, keyBuilder);
+        compileCacheKey = keyBuilder.ProduceString();
+
+        if (SLANG_SUCCEEDED(_loadFromCompileCache(compileCacheKey)))
+        {
+            return SLANG_OK;
+        }
+    }
+
+    // The downstream compilers are loaded in the background while the front end runs,
+    // rather than when the first entry point needs them
+    //
+    if (shouldPreloadDownstreamLibraries && !shouldSkipCodegen)
+    {
+        preloadDownstreamLibraries();
+    }
+
+    // If permutations are deduplicated, the translation units are preprocessed
+    // up front, and an earlier compile with the same preprocessed tokens allows us
+    // to skip the rest of compilation. On a miss the tokens are used for parsing.
+    //
+    String permutationKey;
+    if (shouldDeduplicatePermutations && CompileCache::canCache(this))
+    {
+        for (auto translationUnit : getFrontEndReq()->translationUnits)
+        {
+            getFrontEndReq()->preprocessTranslationUnit(translationUnit);
+        }
+
+        if (getSink()->GetErrorCount() == 0)
+        {
+            StringBuilder keyBuilder;
+            CompileCache::calcPermutationKey(this, keyBuilder);
+            permutationKey = keyBuilder.ProduceString();
+
+            if (SLANG_SUCCEEDED(_loadFromPermutationCache(permutationKey)))
+            {
+                return SLANG_OK;
+            }
+        }
+    }
+
     // We only do parsing and semantic checking if we *aren't* doing
     // a pass-through compilation.
     //
@@ -1140,7 +1570,7 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     // Note: this is a debugging option.
     //
     if (shouldSkipCodegen ||
-        ((getFrontEndReq()->compileFlags & SLANG_COMPILE_FLAG_NO_CODEGEN) != 0))
+        ((getFrontEndReq()->compileFlags & (SLANG_COMPILE_FLAG_NO_CODEGEN | SLANG_COMPILE_FLAG_REFLECTION_ONLY)) != 0))
     {
         // We will use the program (and matching layout information)
         // that was computed in the front-end for all subsequent
@@ -1196,47 +1626,486 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     if (getSink()->GetErrorCount() != 0)
         return SLANG_FAIL;
 
+    if (compileCacheKey.getLength())
+    {
+        _storeToCompileCache(compileCacheKey);
+    }
+    if (permutationKey.getLength())
+    {
+        _storeToPermutationCache(permutationKey);
+    }
+
     return SLANG_OK;
 }
 
-// Act as expected of the API-based compiler
-SlangResult EndToEndCompileRequest::executeActions()
+bool EndToEndCompileRequest::_hasCompileCache()
 {
-    SlangResult res = executeActionsInner();
-    mDiagnosticOutput = getSink()->outputBuffer.ProduceString();
-    return res;
+    auto linkage = getLinkage();
+    return linkage->compileCacheDirectory.getLength() || linkage->compileCache;
 }
 
-int FrontEndCompileRequest::addTranslationUnit(SourceLanguage language, Name* moduleName)
+SlangResult EndToEndCompileRequest::_readCompileCacheEntry(String const& key, CompileCacheEntry& outEntry)
 {
-    Index result = translationUnits.getCount();
-
-    RefPtr<TranslationUnitRequest> translationUnit = new TranslationUnitRequest(this);
-    translationUnit->compileRequest = this;
-    translationUnit->sourceLanguage = SourceLanguage(language);
+    auto linkage = getLinkage();
+    const String& directory = linkage->compileCacheDirectory;
+    if (directory.getLength() && SLANG_SUCCEEDED(CompileCache::read(directory, key, linkage, outEntry)))
+    {
+        return SLANG_OK;
+    }
 
-    translationUnit->moduleName = moduleName;
+    ISlangCompileCache* compileCache = linkage->compileCache;
+    if (!compileCache)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
 
-    translationUnits.add(translationUnit);
+    outEntry = CompileCacheEntry();
+    SLANG_RETURN_ON_FAIL(CompileCache::read(compileCache, key, linkage, outEntry));
 
-    return (int) result;
+    // Held locally, so later compiles don't need to go to the application's cache
+    if (directory.getLength())
+    {
+        CompileCache::write(directory, linkage->compileCacheMaxSize, outEntry);
+    }
+    return SLANG_OK;
 }
 
-int FrontEndCompileRequest::addTranslationUnit(SourceLanguage language)
+void EndToEndCompileRequest::_writeCompileCacheEntry(CompileCacheEntry const& entry)
 {
-    // We want to ensure that symbols defined in different translation
-    // units get unique mangled names, so that we can, e.g., tell apart
-    // a `main()` function in `vertex.slang` and a `main()` in `fragment.slang`,
-    // even when they are being compiled together.
-    //
-    String generatedName = "tu";
-    generatedName.append(translationUnits.getCount());
-    return addTranslationUnit(language,  getNamePool()->getName(generatedName));
-}
+    auto linkage = getLinkage();
 
-void FrontEndCompileRequest::addTranslationUnitSourceFile(
-    int             translationUnitIndex,
-    SourceFile*     sourceFile)
+    // Failing to write to a cache doesn't fail the compile
+    if (linkage->compileCacheDirectory.getLength())
+    {
+        CompileCache::write(linkage->compileCacheDirectory, linkage->compileCacheMaxSize, entry);
+    }
+    if (ISlangCompileCache* compileCache = linkage->compileCache)
+    {
+        CompileCache::write(compileCache, entry);
+    }
+}
+
+SlangResult EndToEndCompileRequest::_loadFromCompileCache(String const& key)
+{
+    CompileCacheEntry entry;
+    SLANG_RETURN_ON_FAIL(_readCompileCacheEntry(key, entry));
+    return _applyCompileCacheEntry(entry);
+}
+
+SlangResult EndToEndCompileRequest::_loadFromPermutationCache(String const& key)
+{
+    auto linkage = getLinkage();
+    auto permutationCache = linkage->getPermutationCache();
+
+    CompileCacheEntry* entry = permutationCache->entries.TryGetValue(key);
+    if (entry && !CompileCache::areDependenciesUnchanged(*entry, linkage))
+    {
+        permutationCache->entries.Remove(key);
+        entry = nullptr;
+    }
+
+    // The permutation may have been compiled by another linkage (or process)
+    // that stored it in the compile cache.
+    //
+    CompileCacheEntry readEntry;
+    if (!entry && _hasCompileCache() && SLANG_SUCCEEDED(_readCompileCacheEntry(key, readEntry)))
+    {
+        permutationCache->entries[key] = readEntry;
+        entry = permutationCache->entries.TryGetValue(key);
+    }
+
+    if (!entry)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    SLANG_RETURN_ON_FAIL(_applyCompileCacheEntry(*entry));
+
+    if (auto profiler = linkage->getProfiler())
+    {
+        profiler->addCounter("deduplicated-permutations", 1);
+    }
+    return SLANG_OK;
+}
+
+SlangResult EndToEndCompileRequest::_applyCompileCacheEntry(CompileCacheEntry const& entry)
+{
+    auto linkage = getLinkage();
+
+    const Index entryPointCount = entry.entryPoints.getCount();
+    if (entry.results.getCount() != entryPointCount * linkage->targets.getCount())
+    {
+        return SLANG_FAIL;
+    }
+
+    // As with pass-through compiles, the program on a cache hit only holds
+    // 'dummy' entry points, which have the code that was generated for them
+    // installed directly.
+    //
+    RefPtr<Program> program = new Program(linkage);
+    for (auto const& entryPointInfo : entry.entryPoints)
+    {
+        RefPtr<EntryPoint> entryPoint = EntryPoint::createDummyForPassThrough(
+            getNamePool()->getName(entryPointInfo.name),
+            Profile(entryPointInfo.profile));
+        program->addEntryPoint(entryPoint, getSink());
+    }
+    for (auto const& dependency : entry.dependencies)
+    {
+        program->addFilePathDependency(dependency.path);
+    }
+
+    for (Index targetIndex = 0; targetIndex < linkage->targets.getCount(); ++targetIndex)
+    {
+        auto targetProgram = program->getTargetProgram(linkage->targets[targetIndex]);
+        for (Index entryPointIndex = 0; entryPointIndex < entryPointCount; ++entryPointIndex)
+        {
+            targetProgram->getExistingEntryPointResult(entryPointIndex) =
+                entry.results[targetIndex * entryPointCount + entryPointIndex];
+        }
+    }
+
+    m_specializedProgram = program;
+    getBackEndReq()->setProgram(program);
+
+    writeOutput(this);
+    if (getSink()->GetErrorCount() != 0)
+        return SLANG_FAIL;
+
+    return SLANG_OK;
+}
+
+bool EndToEndCompileRequest::_createCompileCacheEntry(String const& key, CompileCacheEntry& outEntry)
+{
+    // Only compiles without any diagnostics are stored, because a hit
+    // does not reproduce the diagnostic output.
+    if (getSink()->getDiagnosticCount() != 0)
+        return false;
+
+    auto linkage = getLinkage();
+    auto program = getSpecializedProgram();
+
+    outEntry.key = key;
+
+    for (auto const& path : getUnspecializedProgram()->getFilePathDependencies())
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(linkage->loadFile(path, blob.writeRef())))
+        {
+            // We can't detect changes to a file we can't read
+            return false;
+        }
+
+        CompileCacheEntry::Dependency dependency;
+        dependency.path = path;
+        dependency.contentHash = CompileCache::calcContentHash(blob->getBufferPointer(), blob->getBufferSize());
+        outEntry.dependencies.add(dependency);
+    }
+
+    for (auto entryPoint : program->getEntryPoints())
+    {
+        CompileCacheEntry::EntryPointInfo entryPointInfo;
+        entryPointInfo.name = getText(entryPoint->getName());
+        entryPointInfo.profile = entryPoint->getProfile().raw;
+        outEntry.entryPoints.add(entryPointInfo);
+    }
+
+    for (auto targetReq : linkage->targets)
+    {
+        auto targetProgram = program->getTargetProgram(targetReq);
+        for (Index ii = 0; ii < program->getEntryPointCount(); ++ii)
+        {
+            outEntry.results.add(targetProgram->getExistingEntryPointResult(ii));
+        }
+    }
+    return true;
+}
+
+void EndToEndCompileRequest::_storeToCompileCache(String const& key)
+{
+    CompileCacheEntry entry;
+    if (!_createCompileCacheEntry(key, entry))
+        return;
+
+    _writeCompileCacheEntry(entry);
+}
+
+void EndToEndCompileRequest::_storeToPermutationCache(String const& key)
+{
+    CompileCacheEntry entry;
+    if (!_createCompileCacheEntry(key, entry))
+        return;
+
+    _writeCompileCacheEntry(entry);
+    getLinkage()->getPermutationCache()->entries[key] = entry;
+}
+
+static void _appendPreprocessedTokens(TokenList const& tokens, StringBuilder& out)
+{
+    // Tokens are written with a space where there was whitespace before them, and on a new line where
+    // they were at the start of a line. Tokens that would lex as one if written next to each other
+    // (which can happen with macro expansions) always get a space.
+    TokenType prevType = TokenType::EndOfFile;
+    for (auto const& token : tokens)
+    {
+        if (token.type == TokenType::EndOfFile)
+            break;
+
+        if (prevType != TokenType::EndOfFile)
+        {
+            const bool isWord = token.type == TokenType::Identifier || token.type == TokenType::IntegerLiteral || token.type == TokenType::FloatingPointLiteral;
+            const bool isPrevWord = prevType == TokenType::Identifier || prevType == TokenType::IntegerLiteral || prevType == TokenType::FloatingPointLiteral;
+
+            if (token.flags & TokenFlag::AtStartOfLine)
+                out << "\n";
+            else if ((token.flags & TokenFlag::AfterWhitespace) || (isWord && isPrevWord))
+                out << " ";
+        }
+        out << token.Content;
+        prevType = token.type;
+    }
+    if (prevType != TokenType::EndOfFile)
+    {
+        out << "\n";
+    }
+}
+
+// Append path to out, escaped as Make requires for a path in a rule
+static void _appendMakePath(String const& path, StringBuilder& out)
+{
+    for (char c : path)
+    {
+        switch (c)
+        {
+            case ' ':
+            case '#':
+                out << "\\";
+                break;
+            case '$':
+                out << "$";
+                break;
+            default:
+                break;
+        }
+        out.append(c);
+    }
+}
+
+SlangResult EndToEndCompileRequest::_executePreprocessOnly()
+{
+    auto frontEndReq = getFrontEndReq();
+
+    mPreprocessOutput = String();
+    mPreprocessDependencies.clear();
+
+    // Files read by the preprocessor (the source files and the files they include) are recorded
+    // as dependencies of the translation unit's module
+    FilePathDependencyList dependencies;
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        frontEndReq->preprocessTranslationUnit(translationUnit);
+        dependencies.addDependency(translationUnit->getModule());
+    }
+    mPreprocessDependencies = dependencies.getFilePathList();
+
+    if (getSink()->GetErrorCount() != 0)
+    {
+        return SLANG_FAIL;
+    }
+
+    StringBuilder out;
+    if (preprocessOnlyMode == SLANG_PREPROCESS_ONLY_DEPENDENCIES)
+    {
+        String target = dependencyRuleTarget;
+        if (target.getLength() == 0 && mPreprocessDependencies.getCount())
+        {
+            target = mPreprocessDependencies[0];
+        }
+
+        _appendMakePath(target, out);
+        out << ":";
+        for (auto const& path : mPreprocessDependencies)
+        {
+            out << " \\\n  ";
+            _appendMakePath(path, out);
+        }
+        out << "\n";
+    }
+    else
+    {
+        for (auto translationUnit : frontEndReq->translationUnits)
+        {
+            for (auto const& tokens : translationUnit->preprocessedTokens)
+            {
+                _appendPreprocessedTokens(tokens, out);
+            }
+        }
+    }
+
+    // The tokens aren't going to be parsed
+    for (auto translationUnit : frontEndReq->translationUnits)
+    {
+        translationUnit->preprocessedTokens = List<TokenList>();
+    }
+
+    mPreprocessOutput = out.ProduceString();
+
+    if (!isCommandLineCompile)
+    {
+        return SLANG_OK;
+    }
+
+    if (preprocessOutputPath.getLength() == 0)
+    {
+        getWriter(WriterChannel::StdOutput)->write(mPreprocessOutput.getBuffer(), mPreprocessOutput.getLength());
+        return SLANG_OK;
+    }
+
+    FILE* file = fopen(preprocessOutputPath.getBuffer(), "w");
+    if (!file)
+    {
+        getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, preprocessOutputPath);
+        return SLANG_FAIL;
+    }
+    const size_t count = fwrite(mPreprocessOutput.getBuffer(), mPreprocessOutput.getLength(), 1, file);
+    fclose(file);
+    if (count != 1 && mPreprocessOutput.getLength() != 0)
+    {
+        getSink()->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, preprocessOutputPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+void EndToEndCompileRequest::accumulateMemoryStats(MemoryStats& ioStats)
+{
+    getLinkage()->accumulateMemoryStats(ioStats);
+
+    // The modules of the translation units aren't loaded into the linkage
+    for (const auto& translationUnit : getFrontEndReq()->translationUnits)
+    {
+        translationUnit->getModule()->accumulateMemoryStats(ioStats);
+    }
+
+    auto unspecializedProgram = getUnspecializedProgram();
+    if (unspecializedProgram)
+        unspecializedProgram->accumulateMemoryStats(ioStats);
+    auto specializedProgram = getSpecializedProgram();
+    if (specializedProgram && specializedProgram != unspecializedProgram)
+        specializedProgram->accumulateMemoryStats(ioStats);
+
+    if (containerBlob)
+        ioStats.outputBytes += containerBlob->getBufferSize();
+}
+
+// Act as expected of the API-based compiler
+SlangResult EndToEndCompileRequest::executeActions()
+{
+    // Start a new profile for each compile, so that events from a previous compile are not included
+    getLinkage()->setProfiler(shouldProfile ? new CompileProfiler() : nullptr);
+    getLinkage()->setCodeReport(shouldReportCode ? new CodeReport() : nullptr);
+
+    // The budget is only set on the linkage while the request is compiling, as the linkage
+    // may be shared with other requests
+    struct BudgetScope
+    {
+        BudgetScope(Linkage* linkage, CompileBudget* budget): m_linkage(linkage)
+        {
+            budget->start();
+            linkage->setBudget(budget);
+        }
+        ~BudgetScope() { m_linkage->setBudget(nullptr); }
+        Linkage* m_linkage;
+    };
+    BudgetScope budgetScope(getLinkage(), budget);
+
+    SlangResult res = executeActionsInner();
+
+    if (shouldProfile && profileTracePath.getLength())
+    {
+        _writeProfileTrace();
+    }
+    if (shouldReportCode && codeReportPath.getLength())
+    {
+        _writeCodeReport();
+    }
+
+    mDiagnosticOutput = getSink()->outputBuffer.ProduceString();
+    return res;
+}
+
+    /// Write text to the file at path, diagnosing any failure to sink
+static void _writeReportFile(DiagnosticSink* sink, String const& path, StringBuilder const& text)
+{
+    FILE* file = fopen(path.getBuffer(), "wb");
+    if (!file)
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, path);
+        return;
+    }
+    const size_t count = fwrite(text.getBuffer(), text.getLength(), 1, file);
+    fclose(file);
+    if (count != 1 && text.getLength() != 0)
+    {
+        sink->diagnose(SourceLoc(), Diagnostics::cannotWriteOutputFile, path);
+    }
+}
+
+void EndToEndCompileRequest::preloadDownstreamLibraries()
+{
+    List<SharedLibraryType> types;
+    types.add(getPassThroughSharedLibraryType(passThrough));
+    for (auto targetReq : getLinkage()->targets)
+    {
+        types.add(getPassThroughSharedLibraryType(getExternalCompilerRequiredForTarget(targetReq->getTarget())));
+    }
+    getSession()->preloadSharedLibraries(types.getBuffer(), types.getCount());
+}
+
+void EndToEndCompileRequest::_writeProfileTrace()
+{
+    StringBuilder trace;
+    getLinkage()->getProfiler()->writeChromeTrace(trace);
+    _writeReportFile(getSink(), profileTracePath, trace);
+}
+
+void EndToEndCompileRequest::_writeCodeReport()
+{
+    StringBuilder report;
+    getLinkage()->getCodeReport()->writeJSON(report);
+    _writeReportFile(getSink(), codeReportPath, report);
+}
+
+int FrontEndCompileRequest::addTranslationUnit(SourceLanguage language, Name* moduleName)
+{
+    Index result = translationUnits.getCount();
+
+    RefPtr<TranslationUnitRequest> translationUnit = new TranslationUnitRequest(this);
+    translationUnit->compileRequest = this;
+    translationUnit->sourceLanguage = SourceLanguage(language);
+
+    translationUnit->moduleName = moduleName;
+
+    translationUnits.add(translationUnit);
+
+    return (int) result;
+}
+
+int FrontEndCompileRequest::addTranslationUnit(SourceLanguage language)
+{
+    // We want to ensure that symbols defined in different translation
+    // units get unique mangled names, so that we can, e.g., tell apart
+    // a `main()` function in `vertex.slang` and a `main()` in `fragment.slang`,
+    // even when they are being compiled together.
+    //
+    String generatedName = "tu";
+    generatedName.append(translationUnits.getCount());
+    return addTranslationUnit(language,  getNamePool()->getName(generatedName));
+}
+
+void FrontEndCompileRequest::addTranslationUnitSourceFile(
+    int             translationUnitIndex,
+    SourceFile*     sourceFile)
 {
     translationUnits[translationUnitIndex]->addSourceFile(sourceFile);
 }
@@ -1343,10 +2212,38 @@ UInt Linkage::addTarget(
     return (int) result;
 }
 
+    /// Get a hash of the contents of the file at path, or 0 if it can't be loaded.
+    /// Files are identified by their unique identity, so the contents of a file
+    /// reached by different paths are only loaded once.
+static uint64_t _calcFileContentHash(ISlangFileSystemExt* fileSystemExt, const String& path, Dictionary<String, uint64_t>& ioHashCache)
+{
+    String uniqueIdentity = path;
+    ComPtr<ISlangBlob> uniqueIdentityBlob;
+    if (SLANG_SUCCEEDED(fileSystemExt->getFileUniqueIdentity(path.getBuffer(), uniqueIdentityBlob.writeRef())))
+    {
+        uniqueIdentity = StringUtil::getString(uniqueIdentityBlob);
+    }
+
+    uint64_t hash = 0;
+    if (ioHashCache.TryGetValue(uniqueIdentity, hash))
+    {
+        return hash;
+    }
+
+    ComPtr<ISlangBlob> contents;
+    if (SLANG_SUCCEEDED(fileSystemExt->loadFile(path.getBuffer(), contents.writeRef())))
+    {
+        hash = GetHashCode64((const char*)contents->getBufferPointer(), contents->getBufferSize());
+    }
+    ioHashCache.Add(uniqueIdentity, hash);
+    return hash;
+}
+
 void Linkage::loadParsedModule(
     RefPtr<TranslationUnitRequest>  translationUnit,
     Name*                           name,
-    const PathInfo&                 pathInfo)
+    const PathInfo&                 pathInfo,
+    IRModule*                       precompiledIRModule)
 {
     // Note: we add the loaded module to our name->module listing
     // before doing semantic checking, so that if it tries to
@@ -1376,16 +2273,249 @@ void Linkage::loadParsedModule(
         // If we didn't run into any errors, then try to generate
         // IR code for the imported module.
         SLANG_ASSERT(errorCountAfter == 0);
-        loadedModule->setIRModule(generateIRForTranslationUnit(translationUnit));
+        if (precompiledIRModule)
+        {
+            loadedModule->setIRModule(precompiledIRModule);
+        }
+        else
+        {
+            loadedModule->setIRModule(generateIRForTranslationUnit(translationUnit));
+        }
+
+        if (m_compactModules)
+        {
+            loadedModule->compact();
+        }
     }
     loadedModulesList.add(loadedModule);
+
+    if (m_isIncremental)
+    {
+        // Record the contents of the files the module depends on, so that
+        // `removeChangedModules` can tell if it is out of date.
+        Dictionary<String, uint64_t> hashCache;
+        List<uint64_t> hashes;
+        for (const auto& path : loadedModule->getFilePathDependencyList())
+        {
+            hashes.add(_calcFileContentHash(getFileSystemExt(), path, hashCache));
+        }
+        loadedModule->setFilePathDependencyHashes(hashes);
+    }
 }
 
-Module* Linkage::loadModule(String const& name)
+void Linkage::removeChangedModules()
 {
-    // TODO: We either need to have a diagnostics sink
-    // get passed into this operation, or associate
-    // one with the linkage.
+    // With file change notifications, modules are removed by `invalidateFilePaths` instead
+    if (!m_isIncremental || m_useFileChangeNotifications)
+    {
+        return;
+    }
+
+    // The file system may be caching the contents of files, which would
+    // hide any changes
+    getFileSystemExt()->clearCache();
+
+    // The file paths a module depends on include the paths of all of the
+    // modules it (transitively) imports, so if the file of an imported module
+    // changes, modules that import it are found to be changed too.
+    Dictionary<String, uint64_t> hashCache;
+    HashSet<Module*> changedModules;
+    for (const auto& loadedModule : loadedModulesList)
+    {
+        const auto& paths = loadedModule->getFilePathDependencyList();
+        const auto& hashes = loadedModule->getFilePathDependencyHashes();
+
+        bool isChanged = (paths.getCount() != hashes.getCount());
+        for (Index i = 0; i < paths.getCount() && !isChanged; ++i)
+        {
+            isChanged = (_calcFileContentHash(getFileSystemExt(), paths[i], hashCache) != hashes[i]);
+        }
+
+        if (isChanged)
+        {
+            changedModules.Add(loadedModule);
+        }
+    }
+
+    _removeLoadedModules(changedModules);
+}
+
+void Linkage::_removeLoadedModules(const HashSet<Module*>& modules)
+{
+    // Entries for modules that failed to load (which hold null) are also removed,
+    // as the files they were looking for may now be present.
+    Dictionary<String, RefPtr<LoadedModule>> newMapPathToLoadedModule;
+    for (const auto& pair : mapPathToLoadedModule)
+    {
+        if (pair.Value && !modules.Contains(pair.Value))
+        {
+            newMapPathToLoadedModule.Add(pair.Key, pair.Value);
+        }
+    }
+    Dictionary<Name*, RefPtr<LoadedModule>> newMapNameToLoadedModules;
+    for (const auto& pair : mapNameToLoadedModules)
+    {
+        if (pair.Value && !modules.Contains(pair.Value))
+        {
+            newMapNameToLoadedModules.Add(pair.Key, pair.Value);
+        }
+    }
+    List<RefPtr<LoadedModule>> newLoadedModulesList;
+    for (const auto& loadedModule : loadedModulesList)
+    {
+        if (!modules.Contains(loadedModule))
+        {
+            newLoadedModulesList.add(loadedModule);
+        }
+    }
+
+    mapPathToLoadedModule = _Move(newMapPathToLoadedModule);
+    mapNameToLoadedModules = _Move(newMapNameToLoadedModules);
+    loadedModulesList = _Move(newLoadedModulesList);
+
+    if (modules.Count())
+    {
+        // The caches may hold results for declarations of the removed modules
+        destroyTypeCheckingCache();
+        destroyTypeLayoutCache();
+    }
+}
+
+    /// Get the unique identity of the file at path, or the path itself if it has none
+static String _getFileUniqueIdentity(ISlangFileSystemExt* fileSystem, const String& path)
+{
+    ComPtr<ISlangBlob> uniqueIdentity;
+    if (SLANG_SUCCEEDED(fileSystem->getFileUniqueIdentity(path.getBuffer(), uniqueIdentity.writeRef())) && uniqueIdentity)
+    {
+        return StringUtil::getString(uniqueIdentity);
+    }
+    return path;
+}
+
+void Linkage::invalidateFilePaths(const List<String>& paths)
+{
+    // The identities are found before the file system forgets about the files
+    HashSet<String> changedIdentities;
+    for (const auto& path : paths)
+    {
+        const String uniqueIdentity = _getFileUniqueIdentity(getFileSystemExt(), path);
+        changedIdentities.Add(uniqueIdentity);
+        changedIdentities.Add(path);
+
+        getSourceManager()->removeSourceFile(uniqueIdentity);
+        if (m_cacheFileSystem)
+        {
+            m_cacheFileSystem->invalidatePath(path);
+        }
+    }
+    if (!m_cacheFileSystem)
+    {
+        // A file system supplied by the application can only be cleared as a whole
+        getFileSystemExt()->clearCache();
+    }
+
+    // The file paths a module depends on include those of the modules it (transitively)
+    // imports, so this also finds the modules that depend on a changed module.
+    HashSet<Module*> changedModules;
+    for (const auto& loadedModule : loadedModulesList)
+    {
+        for (const auto& dependencyPath : loadedModule->getFilePathDependencyList())
+        {
+            if (changedIdentities.Contains(dependencyPath) ||
+                changedIdentities.Contains(_getFileUniqueIdentity(getFileSystemExt(), dependencyPath)))
+            {
+                changedModules.Add(loadedModule);
+                break;
+            }
+        }
+    }
+
+    _removeLoadedModules(changedModules);
+}
+
+SLANG_NO_THROW void SLANG_MCALL Linkage::invalidateFiles(
+    char const* const*  paths,
+    SlangInt            pathCount)
+{
+    List<String> pathList;
+    for (SlangInt i = 0; i < pathCount; ++i)
+    {
+        pathList.add(paths[i]);
+    }
+    invalidateFilePaths(pathList);
+}
+
+static void _getExternalMemoryStats(const MemoryStats& stats, SlangMemoryStats* outStats)
+{
+    outStats->irBytes = SlangInt(stats.irBytes);
+    outStats->astBytes = SlangInt(stats.astBytes);
+    outStats->sourceBytes = SlangInt(stats.sourceBytes);
+    outStats->sourceLocBytes = SlangInt(stats.sourceLocBytes);
+    outStats->nameBytes = SlangInt(stats.nameBytes);
+    outStats->tokenCacheBytes = SlangInt(stats.tokenCacheBytes);
+    outStats->cacheBytes = SlangInt(stats.cacheBytes);
+    outStats->outputBytes = SlangInt(stats.outputBytes);
+}
+
+SLANG_NO_THROW void SLANG_MCALL Linkage::getMemoryStats(
+    SlangMemoryStats*   outStats)
+{
+    if (!outStats)
+        return;
+    MemoryStats stats;
+    accumulateMemoryStats(stats);
+    _getExternalMemoryStats(stats, outStats);
+}
+
+    /// Add the bytes held by a source manager to ioStats
+static void _accumulateMemoryStats(SourceManager* sourceManager, MemoryStats& ioStats)
+{
+    size_t contentBytes = 0;
+    size_t locBytes = 0;
+    sourceManager->calcMemoryUsed(contentBytes, locBytes);
+    ioStats.sourceBytes += contentBytes;
+    ioStats.sourceLocBytes += locBytes;
+}
+
+void Linkage::accumulateMemoryStats(MemoryStats& ioStats)
+{
+    for (const auto& loadedModule : loadedModulesList)
+    {
+        loadedModule->accumulateMemoryStats(ioStats);
+    }
+    for (const auto& irModule : compiledModules)
+    {
+        ioStats.irBytes += irModule->memoryArena.calcTotalMemoryUsed();
+    }
+
+    // A source manager that has been set is owned by something else (such as the session)
+    if (m_sourceManager == &m_defaultSourceManager)
+    {
+        _accumulateMemoryStats(m_sourceManager, ioStats);
+    }
+
+    ioStats.nameBytes += namePool.calcMemoryUsed();
+
+    ioStats.cacheBytes += _calcTypeCheckingCacheSize() + _calcTypeLayoutCacheSize();
+    if (m_permutationCache)
+    {
+        ioStats.cacheBytes += m_permutationCache->entries.calcMemoryUsed();
+        for (const auto& pair : m_permutationCache->entries)
+        {
+            ioStats.cacheBytes += size_t(pair.Key.getLength()) + size_t(pair.Value.key.getLength());
+            for (const auto& result : pair.Value.results)
+            {
+                ioStats.outputBytes += result.calcOutputSize();
+            }
+        }
+    }
+}
+
+Module* Linkage::loadModule(String const& name)
+{
+    // TODO: We either need to have a diagnostics sink
+    // get passed into this operation, or associate
+    // one with the linkage.
     //
     DiagnosticSink* sink = nullptr;
     return findOrImportModule(
@@ -1400,7 +2530,8 @@ RefPtr<Module> Linkage::loadModule(
     const PathInfo&     filePathInfo,
     ISlangBlob*         sourceBlob, 
     SourceLoc const&    srcLoc,
-    DiagnosticSink*     sink)
+    DiagnosticSink*     sink,
+    IRModule*           precompiledIRModule)
 {
     RefPtr<FrontEndCompileRequest> frontEndReq = new FrontEndCompileRequest(this, sink);
 
@@ -1436,7 +2567,8 @@ RefPtr<Module> Linkage::loadModule(
     loadParsedModule(
         translationUnit,
         name,
-        filePathInfo);
+        filePathInfo,
+        precompiledIRModule);
 
     errorCountAfter = sink->GetErrorCount();
 
@@ -1520,6 +2652,22 @@ RefPtr<Module> Linkage::findOrImportModule(
     PathInfo pathIncludedFromInfo = getSourceManager()->getPathInfo(loc, SourceLocType::Actual);
     PathInfo filePathInfo;
 
+    // A precompiled module (`foo-bar.slang-precompiled`) is used in preference to the source,
+    // as long as it is up to date
+    PathInfo precompiledPathInfo;
+    if (SLANG_SUCCEEDED(includeHandler.findFile(fileName + "-precompiled", pathIncludedFromInfo.foundPath, precompiledPathInfo)))
+    {
+        if (mapPathToLoadedModule.TryGetValue(precompiledPathInfo.getMostUniqueIdentity(), loadedModule))
+            return loadedModule;
+
+        if (auto precompiledModule = _loadPrecompiledModule(name, precompiledPathInfo, loc, sink))
+            return precompiledModule;
+
+        // If the module was loaded, but had errors, they have already been reported
+        if (mapNameToLoadedModules.ContainsKey(name))
+            return nullptr;
+    }
+
     // We have to load via the found path - as that is how file was originally loaded 
     if (SLANG_FAILED(includeHandler.findFile(fileName, pathIncludedFromInfo.foundPath, filePathInfo)))
     {
@@ -1532,6 +2680,13 @@ RefPtr<Module> Linkage::findOrImportModule(
     if (mapPathToLoadedModule.TryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
         return loadedModule;
 
+    // Maybe another linkage with the same options has loaded it?
+    if (m_useSharedModuleCache)
+    {
+        if (auto sharedModule = _findOrImportSharedModule(name, filePathInfo))
+            return sharedModule;
+    }
+
     // Try to load it
     ComPtr<ISlangBlob> fileContents;
     if(SLANG_FAILED(getFileSystemExt()->loadFile(filePathInfo.foundPath.getBuffer(), fileContents.writeRef())))
@@ -1551,6 +2706,345 @@ RefPtr<Module> Linkage::findOrImportModule(
         sink);
 }
 
+RefPtr<Module> Linkage::_loadPrecompiledModule(
+    Name*               name,
+    PathInfo const&     filePathInfo,
+    SourceLoc const&    loc,
+    DiagnosticSink*     sink)
+{
+    // The OS file system reads (small) files as text, so when it's used the file is read directly
+    ComPtr<ISlangBlob> fileContents;
+    if (fileSystem)
+    {
+        if (SLANG_FAILED(getFileSystemExt()->loadFile(filePathInfo.foundPath.getBuffer(), fileContents.writeRef())))
+            return nullptr;
+    }
+    else
+    {
+        try
+        {
+            List<uint8_t> bytes = File::readAllBytes(filePathInfo.foundPath);
+            fileContents = createListBlob(bytes);
+        }
+        catch (const IOException&)
+        {
+            return nullptr;
+        }
+    }
+
+    List<PrecompiledModule> precompiledModules;
+    if (SLANG_FAILED(readPrecompiledModules(fileContents->getBufferPointer(), fileContents->getBufferSize(), precompiledModules)))
+        return nullptr;
+
+    // The IR refers to the declarations by names that include the module name, so only
+    // a module that was compiled with the name it is imported by can be used
+    const PrecompiledModule* precompiledModule = nullptr;
+    for (const auto& module : precompiledModules)
+    {
+        if (module.name == getText(name))
+        {
+            precompiledModule = &module;
+            break;
+        }
+    }
+    if (!precompiledModule)
+        return nullptr;
+
+    // If the source of the module can be read, it must be unchanged. Sources that
+    // can't be read (such as when the module is distributed without them) are ignored.
+    for (const auto& dependency : precompiledModule->dependencies)
+    {
+        ComPtr<ISlangBlob> dependencyContents;
+        if (SLANG_SUCCEEDED(getFileSystemExt()->loadFile(dependency.path.getBuffer(), dependencyContents.writeRef())) &&
+            getHashCode64(dependencyContents->getBufferPointer(), dependencyContents->getBufferSize()) != dependency.contentHash)
+        {
+            return nullptr;
+        }
+    }
+
+    // The IR is read lazily, so that only the global values that are linked against are created
+    RefPtr<IRModule> irModule;
+    {
+        BlobStream stream(precompiledModule->irData, precompiledModule->irSize);
+        RefPtr<IRSerialLazyReader> reader = new IRSerialLazyReader();
+        if (SLANG_FAILED(reader->init(&stream, getSessionImpl(), irModule)))
+            return nullptr;
+        irModule->setLazyReader(reader);
+    }
+
+    // Only the interface is parsed and checked. The file's path is used for it, so
+    // that diagnostics refer to the file, and it is a dependency of modules that import it.
+    ComPtr<ISlangBlob> interfaceBlob = StringUtil::createStringBlob(precompiledModule->interfaceSource);
+    return loadModule(
+        name,
+        filePathInfo,
+        interfaceBlob,
+        loc,
+        sink,
+        irModule);
+}
+
+//
+// SharedModuleCache
+//
+
+/// Checked modules shared between the linkages of a session (see `Linkage::m_useSharedModuleCache`).
+///
+/// Modules are loaded into a private linkage for each set of options that change how a module is
+/// loaded and checked, so that a module is only shared by linkages that would have loaded the same
+/// one. The private linkages are incremental, and a module is only shared while the contents of the
+/// files it depends on are unchanged.
+struct SharedModuleCache
+{
+    Dictionary<String, RefPtr<Linkage>> linkages;
+};
+
+SharedModuleCache* Session::getSharedModuleCache()
+{
+    if (!m_sharedModuleCache)
+        m_sharedModuleCache = new SharedModuleCache();
+    return m_sharedModuleCache;
+}
+
+void Session::destroySharedModuleCache()
+{
+    delete m_sharedModuleCache;
+    m_sharedModuleCache = nullptr;
+}
+
+void Session::accumulateMemoryStats(MemoryStats& ioStats)
+{
+    // The builtin modules only retain their AST. The `Module`s they were checked in have
+    // been released, so the arena each was allocated from is found from its declaration.
+    for (const auto& moduleDecl : loadedModuleCode)
+    {
+        if (auto arena = ASTNodeAllocator::getArena(moduleDecl.Ptr()))
+            ioStats.astBytes += arena->calcTotalMemoryUsed();
+    }
+    _accumulateMemoryStats(&builtinSourceManager, ioStats);
+    m_builtinLinkage->accumulateMemoryStats(ioStats);
+
+    // The cache linkages all use the module cache source manager
+    _accumulateMemoryStats(&m_moduleCacheSourceManager, ioStats);
+    if (m_sharedModuleCache)
+    {
+        for (const auto& pair : m_sharedModuleCache->linkages)
+        {
+            pair.Value->accumulateMemoryStats(ioStats);
+        }
+    }
+
+    // The names of every pool are held by the root pool
+    ioStats.nameBytes += rootNamePool.calcMemoryUsed();
+    ioStats.tokenCacheBytes += m_preprocessorTokenCache.calcMemoryUsed();
+}
+
+String Linkage::_getSharedModuleCacheKey()
+{
+    StringBuilder sb;
+    sb << "fileSystem:" << UInt(size_t(fileSystem.get())) << "\n";
+    sb << "falcorShared:" << Int(m_useFalcorCustomSharedKeywordSemantics) << "\n";
+    sb << "debugInfo:" << Int(debugInfoLevel) << "\n";
+    sb << "compact:" << Int(m_compactModules) << "\n";
+
+    for (auto list = &searchDirectories; list; list = list->parent)
+    {
+        for (const auto& searchDirectory : list->searchDirectories)
+        {
+            sb << "searchPath:" << searchDirectory.path << "\n";
+        }
+    }
+
+    // The order definitions were added in doesn't matter
+    List<String> defineNames;
+    for (const auto& pair : preprocessorDefinitions)
+    {
+        defineNames.add(pair.Key);
+    }
+    defineNames.sort();
+    for (const auto& defineName : defineNames)
+    {
+        sb << "define:" << defineName << "=" << preprocessorDefinitions[defineName] << "\n";
+    }
+
+    return sb.ProduceString();
+}
+
+bool Linkage::_attachSharedModule(Linkage* cacheLinkage, Module* module)
+{
+    // The modules that are needed, with each after the modules it imports
+    List<Module*> modules;
+    HashSet<Module*> moduleSet;
+    for (const auto& dependency : module->getModuleDependencyList())
+    {
+        if (moduleSet.Add(dependency))
+            modules.add(dependency);
+    }
+    if (moduleSet.Add(module))
+        modules.add(module);
+
+    // If a different module is already loaded with any of the names or paths, declarations
+    // from the two would be mixed up, so the module can't be shared with this linkage
+    for (const auto& pair : cacheLinkage->mapNameToLoadedModules)
+    {
+        RefPtr<LoadedModule> existing;
+        if (pair.Value && moduleSet.Contains(pair.Value) &&
+            mapNameToLoadedModules.TryGetValue(pair.Key, existing) && existing != pair.Value)
+        {
+            return false;
+        }
+    }
+    for (const auto& pair : cacheLinkage->mapPathToLoadedModule)
+    {
+        RefPtr<LoadedModule> existing;
+        if (pair.Value && moduleSet.Contains(pair.Value) &&
+            mapPathToLoadedModule.TryGetValue(pair.Key, existing) && existing != pair.Value)
+        {
+            return false;
+        }
+    }
+
+    for (const auto& pair : cacheLinkage->mapNameToLoadedModules)
+    {
+        if (pair.Value && moduleSet.Contains(pair.Value))
+            mapNameToLoadedModules[pair.Key] = pair.Value;
+    }
+    for (const auto& pair : cacheLinkage->mapPathToLoadedModule)
+    {
+        if (pair.Value && moduleSet.Contains(pair.Value))
+            mapPathToLoadedModule[pair.Key] = pair.Value;
+    }
+    for (auto sharedModule : modules)
+    {
+        if (loadedModulesList.indexOf(RefPtr<Module>(sharedModule)) < 0)
+            loadedModulesList.add(sharedModule);
+    }
+    return true;
+}
+
+void Linkage::_removeFailedModules()
+{
+    // A module that failed to load is either recorded as null, or has no IR
+    Dictionary<String, RefPtr<LoadedModule>> newMapPathToLoadedModule;
+    for (const auto& pair : mapPathToLoadedModule)
+    {
+        if (pair.Value && pair.Value->getIRModule())
+            newMapPathToLoadedModule.Add(pair.Key, pair.Value);
+    }
+    Dictionary<Name*, RefPtr<LoadedModule>> newMapNameToLoadedModules;
+    for (const auto& pair : mapNameToLoadedModules)
+    {
+        if (pair.Value && pair.Value->getIRModule())
+            newMapNameToLoadedModules.Add(pair.Key, pair.Value);
+    }
+    List<RefPtr<LoadedModule>> loadedModules;
+    for (const auto& loadedModule : loadedModulesList)
+    {
+        if (loadedModule->getIRModule())
+            loadedModules.add(loadedModule);
+    }
+
+    mapPathToLoadedModule = _Move(newMapPathToLoadedModule);
+    mapNameToLoadedModules = _Move(newMapNameToLoadedModules);
+    loadedModulesList = _Move(loadedModules);
+}
+
+RefPtr<Module> Linkage::_findOrImportSharedModule(Name* name, PathInfo const& filePathInfo)
+{
+    SharedModuleCache* cache = m_session->getSharedModuleCache();
+
+    const String key = _getSharedModuleCacheKey();
+    RefPtr<Linkage> cacheLinkage;
+    if (!cache->linkages.TryGetValue(key, cacheLinkage))
+    {
+        cacheLinkage = new Linkage(m_session);
+        cacheLinkage->m_isIncremental = true;
+        cacheLinkage->m_useFalcorCustomSharedKeywordSemantics = m_useFalcorCustomSharedKeywordSemantics;
+        cacheLinkage->m_compactModules = m_compactModules;
+        cacheLinkage->debugInfoLevel = debugInfoLevel;
+        for (auto list = &searchDirectories; list; list = list->parent)
+        {
+            cacheLinkage->searchDirectories.searchDirectories.addRange(list->searchDirectories);
+        }
+        cacheLinkage->preprocessorDefinitions = preprocessorDefinitions;
+        cacheLinkage->setUseSharedFileCache(m_useSharedFileCache);
+        cacheLinkage->setFileSystem(fileSystem);
+        cacheLinkage->setSourceManager(m_session->getModuleCacheSourceManager());
+
+        cache->linkages.Add(key, cacheLinkage);
+    }
+
+    // The cache linkage outlives this one, so it needs its own use of the name (see `NamePool`)
+    name = cacheLinkage->getNamePool()->getName(getText(name));
+
+    const String identity = filePathInfo.getMostUniqueIdentity();
+
+    RefPtr<LoadedModule> module;
+    if (cacheLinkage->mapPathToLoadedModule.TryGetValue(identity, module) && module)
+    {
+        // Check the files the module depends on with the file system of this linkage, as the
+        // cache linkage's may be holding onto old contents
+        Dictionary<String, uint64_t> hashCache;
+        const auto& paths = module->getFilePathDependencyList();
+        const auto& hashes = module->getFilePathDependencyHashes();
+
+        bool isChanged = (paths.getCount() != hashes.getCount());
+        for (Index i = 0; i < paths.getCount() && !isChanged; ++i)
+        {
+            isChanged = (_calcFileContentHash(getFileSystemExt(), paths[i], hashCache) != hashes[i]);
+        }
+        if (isChanged)
+        {
+            module = nullptr;
+        }
+    }
+    else
+    {
+        module = nullptr;
+    }
+
+    if (!module)
+    {
+        // Make sure the files are read again (and that the modules depending on any that
+        // have changed are replaced) before loading the module
+        cacheLinkage->removeChangedModules();
+
+        // If the name is taken by a module from another path, loading this one would replace it
+        if (cacheLinkage->mapNameToLoadedModules.ContainsKey(name))
+            return nullptr;
+
+        ComPtr<ISlangBlob> fileContents;
+        if (SLANG_FAILED(cacheLinkage->getFileSystemExt()->loadFile(filePathInfo.foundPath.getBuffer(), fileContents.writeRef())))
+            return nullptr;
+
+        // The module is loaded with a sink of its own, so that if it fails the diagnostics
+        // are only output once when it is loaded into this linkage.
+        DiagnosticSink sink(cacheLinkage->getSourceManager());
+        cacheLinkage->setProfiler(m_profiler);
+        try
+        {
+            module = cacheLinkage->loadModule(name, filePathInfo, fileContents, SourceLoc(), &sink);
+        }
+        catch (AbortCompilationException&)
+        {
+            module = nullptr;
+        }
+        cacheLinkage->setProfiler(nullptr);
+
+        if (!module)
+        {
+            // Remove the modules that failed (and so have no IR), so that they are loaded
+            // again (with their errors) next time
+            cacheLinkage->_removeFailedModules();
+            return nullptr;
+        }
+    }
+
+    if (!_attachSharedModule(cacheLinkage, module))
+        return nullptr;
+    return module;
+}
+
 //
 // ModuleDependencyList
 //
@@ -1593,49 +3087,207 @@ void ModuleDependencyList::_addDependency(Module* module)
 // FilePathDependencyList
 //
 
-void FilePathDependencyList::addDependency(String const& path)
+void FilePathDependencyList::addDependency(String const& path)
+{
+    if(m_filePathSet.Contains(path))
+        return;
+
+    m_filePathList.add(path);
+    m_filePathSet.Add(path);
+}
+
+void FilePathDependencyList::addDependency(Module* module)
+{
+    for(auto& path : module->getFilePathDependencyList())
+    {
+        addDependency(path);
+    }
+}
+
+
+
+//
+// Module
+//
+
+Module::Module(Linkage* linkage)
+    : m_linkage(linkage)
+{
+    m_astArena = new ASTArena();
+}
+
+ISlangUnknown* Module::getInterface(const Guid& guid)
+{
+    if(guid == IID_ISlangUnknown || guid == IID_IModule)
+        return asExternal(this);
+    return nullptr;
+}
+
+void Module::addModuleDependency(Module* module)
+{
+    m_moduleDependencyList.addDependency(module);
+    m_filePathDependencyList.addDependency(module);
+}
+
+void Module::addFilePathDependency(String const& path)
+{
+    m_filePathDependencyList.addDependency(path);
+}
+
+void Module::addSourceFile(SourceFile* sourceFile)
+{
+    if (m_sourceFiles.indexOf(sourceFile) >= 0)
+        return;
+    m_sourceFiles.add(sourceFile);
+    if (!m_isCompact)
+        sourceFile->addContentUser();
+}
+
+SLANG_NO_THROW void SLANG_MCALL Module::getMemoryStats(SlangModuleMemoryStats* outStats)
+{
+    if (!outStats)
+        return;
+
+    SlangInt sourceBytes = 0;
+    SlangInt lineTableBytes = 0;
+    for (auto sourceFile : m_sourceFiles)
+    {
+        if (sourceFile->hasContent())
+            sourceBytes += SlangInt(sourceFile->getContentSize());
+        lineTableBytes += SlangInt(sourceFile->calcLineBreakOffsetsSize());
+    }
+
+    outStats->sourceBytes = sourceBytes;
+    outStats->lineTableBytes = lineTableBytes;
+    outStats->astBytes = m_astArena ? SlangInt(m_astArena->calcTotalMemoryUsed()) : 0;
+    outStats->irBytes = m_irModule ? SlangInt(m_irModule->memoryArena.calcTotalMemoryUsed()) : 0;
+}
+
+    /// Copies the text of the tokens held by an AST to a pool, so that the source they
+    /// point into can be released, and removes the bodies of functions.
+struct ModuleCompactor
+{
+    StringSlicePool* tokenTextPool;
+
+    void compactToken(Token& token)
+    {
+        if (token.Content.size())
+            token.Content = tokenTextPool->getSlice(tokenTextPool->add(token.Content));
+    }
+
+    void compactModifier(Modifier* modifier)
+    {
+        if (auto intrinsicOp = as<IntrinsicOpModifier>(modifier))
+        {
+            compactToken(intrinsicOp->opToken);
+        }
+        else if (auto targetIntrinsic = as<TargetIntrinsicModifier>(modifier))
+        {
+            compactToken(targetIntrinsic->targetToken);
+            compactToken(targetIntrinsic->definitionToken);
+        }
+        else if (auto specializedForTarget = as<SpecializedForTargetModifier>(modifier))
+        {
+            compactToken(specializedForTarget->targetToken);
+        }
+        else if (auto requiredExtension = as<RequiredGLSLExtensionModifier>(modifier))
+        {
+            compactToken(requiredExtension->extensionNameToken);
+        }
+        else if (auto requiredVersion = as<RequiredGLSLVersionModifier>(modifier))
+        {
+            compactToken(requiredVersion->versionNumberToken);
+        }
+        else if (auto layoutModifier = as<GLSLLayoutModifier>(modifier))
+        {
+            compactToken(layoutModifier->valToken);
+        }
+        else if (auto semantic = as<HLSLSemantic>(modifier))
+        {
+            compactToken(semantic->name);
+            if (auto layoutSemantic = as<HLSLLayoutSemantic>(semantic))
+            {
+                compactToken(layoutSemantic->registerName);
+                compactToken(layoutSemantic->componentMask);
+            }
+            if (auto registerSemantic = as<HLSLRegisterSemantic>(semantic))
+            {
+                compactToken(registerSemantic->spaceName);
+            }
+        }
+        else if (auto versionDirective = as<GLSLVersionDirective>(modifier))
+        {
+            compactToken(versionDirective->versionNumberToken);
+            compactToken(versionDirective->glslProfileToken);
+        }
+        else if (auto extensionDirective = as<GLSLExtensionDirective>(modifier))
+        {
+            compactToken(extensionDirective->extensionNameToken);
+            compactToken(extensionDirective->dispositionToken);
+        }
+        else if (auto attribute = as<AttributeBase>(modifier))
+        {
+            // The text of string arguments is available through reflection
+            for (auto arg : attribute->args)
+            {
+                if (auto literal = as<LiteralExpr>(arg))
+                    compactToken(literal->token);
+            }
+        }
+    }
+
+    void compactDecl(Decl* decl)
+    {
+        for (auto modifier : decl->modifiers)
+        {
+            compactModifier(modifier);
+        }
+
+        if (auto funcDecl = as<FunctionDeclBase>(decl))
+        {
+            funcDecl->Body = nullptr;
+        }
+        if (auto genericDecl = as<GenericDecl>(decl))
+        {
+            if (genericDecl->inner)
+                compactDecl(genericDecl->inner);
+        }
+        if (auto containerDecl = as<ContainerDecl>(decl))
+        {
+            for (auto member : containerDecl->Members)
+            {
+                compactDecl(member);
+            }
+        }
+    }
+};
+
+void Module::compact()
 {
-    if(m_filePathSet.Contains(path))
+    if (m_isCompact)
         return;
+    m_isCompact = true;
 
-    m_filePathList.add(path);
-    m_filePathSet.Add(path);
-}
-
-void FilePathDependencyList::addDependency(Module* module)
-{
-    for(auto& path : module->getFilePathDependencyList())
+    if (m_moduleDecl)
     {
-        addDependency(path);
+        ModuleCompactor compactor;
+        compactor.tokenTextPool = &m_tokenTextPool;
+        compactor.compactDecl(m_moduleDecl);
     }
-}
-
-
 
-//
-// Module
-//
-
-Module::Module(Linkage* linkage)
-    : m_linkage(linkage)
-{}
-
-ISlangUnknown* Module::getInterface(const Guid& guid)
-{
-    if(guid == IID_ISlangUnknown || guid == IID_IModule)
-        return asExternal(this);
-    return nullptr;
-}
-
-void Module::addModuleDependency(Module* module)
-{
-    m_moduleDependencyList.addDependency(module);
-    m_filePathDependencyList.addDependency(module);
+    for (auto sourceFile : m_sourceFiles)
+    {
+        if (sourceFile->removeContentUser())
+            sourceFile->releaseContents();
+    }
 }
 
-void Module::addFilePathDependency(String const& path)
+void Module::accumulateMemoryStats(MemoryStats& ioStats)
 {
-    m_filePathDependencyList.addDependency(path);
+    if (m_astArena)
+        ioStats.astBytes += m_astArena->calcTotalMemoryUsed();
+    if (m_irModule)
+        ioStats.irBytes += m_irModule->memoryArena.calcTotalMemoryUsed();
 }
 
 // Program
@@ -1751,6 +3403,16 @@ RefPtr<IRModule> Program::getOrCreateIRModule(DiagnosticSink* sink)
     return m_irModule;
 }
 
+void Program::accumulateMemoryStats(MemoryStats& ioStats)
+{
+    if (m_irModule)
+        ioStats.irBytes += m_irModule->memoryArena.calcTotalMemoryUsed();
+    for (const auto& pair : m_targetPrograms)
+    {
+        ioStats.outputBytes += pair.Value->calcOutputSize();
+    }
+}
+
 
 TargetProgram* Program::getTargetProgram(TargetRequest* target)
 {
@@ -1776,6 +3438,13 @@ TargetProgram::TargetProgram(
     m_entryPointResults.setCount(program->getEntryPoints().getCount());
 }
 
+TargetProgram::~TargetProgram()
+{
+    destroyIRLinkCache();
+    destroyIRSpecializationCache();
+    destroyIRTypeLegalizationCache();
+}
+
 //
 
 void DiagnosticSink::noteInternalErrorLoc(SourceLoc const& loc)
@@ -1825,10 +3494,18 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
     // Set up fileSystemExt appropriately
     if (inFileSystem == nullptr)
     {
-        fileSystemExt = new Slang::CacheFileSystem(Slang::OSFileSystem::getSingleton());
+        RefPtr<Slang::CacheFileSystem> cacheFileSystem = new Slang::CacheFileSystem(Slang::OSFileSystem::getSingleton());
+        if (m_useSharedFileCache)
+        {
+            cacheFileSystem->setSharedFileCache(Slang::SharedFileCache::getSingleton());
+        }
+        fileSystemExt = cacheFileSystem.Ptr();
+        m_cacheFileSystem = cacheFileSystem;
     }
     else
     {
+        m_cacheFileSystem = nullptr;
+
         // See if we have the interface 
         inFileSystem->queryInterface(IID_ISlangFileSystemExt, (void**)fileSystemExt.writeRef());
 
@@ -1836,7 +3513,9 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
         if (!fileSystemExt)
         {
             // Construct a wrapper to emulate the extended interface behavior
-            fileSystemExt = new Slang::CacheFileSystem(fileSystem);
+            RefPtr<Slang::CacheFileSystem> cacheFileSystem = new Slang::CacheFileSystem(fileSystem);
+            fileSystemExt = cacheFileSystem.Ptr();
+            m_cacheFileSystem = cacheFileSystem;
         }
     }
 
@@ -1844,6 +3523,25 @@ void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
     getSourceManager()->setFileSystemExt(fileSystemExt);
 }
 
+void Linkage::setUseSharedFileCache(bool useSharedFileCache)
+{
+    if (m_useSharedFileCache != useSharedFileCache)
+    {
+        m_useSharedFileCache = useSharedFileCache;
+        // Recreate the file system, so the cache is (or isn't) used
+        setFileSystem(fileSystem);
+    }
+}
+
+RefObjectPool* Linkage::getRefObjectPool()
+{
+    if (!m_refObjectPool)
+    {
+        m_refObjectPool = new RefObjectPool();
+    }
+    return m_refObjectPool;
+}
+
 RefPtr<Module> findOrImportModule(
     Linkage*            linkage,
     Name*               name,
@@ -1858,6 +3556,9 @@ void Session::addBuiltinSource(
     String const&           path,
     String const&           source)
 {
+    // The code adds names to the language scopes
+    m_builtinNamesIsValid = false;
+
     SourceManager* sourceManager = getBuiltinSourceManager();
 
     DiagnosticSink sink(sourceManager);
@@ -1880,6 +3581,16 @@ void Session::addBuiltinSource(
         path,
         source);
 
+    // Only the AST of builtin code is retained (see `loadedModuleCode` below),
+    // so there is no need to generate IR or layouts for it.
+    //
+    // The code is still preprocessed, parsed and checked for every session.
+    // Loading it precompiled would need the checked AST to be serialized, which
+    // isn't supported. A precompiled module (see `slang-precompiled-module.h`)
+    // can't be used either, as its interface drops function bodies, and the
+    // bodies of builtin functions are lowered into the modules that call them.
+    compileRequest->shouldGenerateIR = false;
+
     SlangResult res = compileRequest->executeActionsInner();
     if (SLANG_FAILED(res))
     {
@@ -1921,6 +3632,9 @@ void Session::addBuiltinSource(
         scope->nextSibling = subScope;
     }
 
+    // The module is released with the compile request, so mustn't be referenced from the AST
+    syntax->module = nullptr;
+
     // We need to retain this AST so that we can use it in other code
     // (Note that the `Scope` type does not retain the AST it points to)
     loadedModuleCode.add(syntax);
@@ -1928,6 +3642,12 @@ void Session::addBuiltinSource(
 
 Session::~Session()
 {
+    // The preload thread uses the loader and libraries of the session
+    waitForSharedLibraryPreload();
+
+    // The cache linkages use the types and scopes of the session
+    destroySharedModuleCache();
+
     // free all built-in types first
     errorType = nullptr;
     initializerListType = nullptr;
@@ -1935,8 +3655,6 @@ Session::~Session()
     irBasicBlockType = nullptr;
     constExprRate = nullptr;
 
-    destroyTypeCheckingCache();
-
     builtinTypes = decltype(builtinTypes)();
     // destroy modules next
     loadedModuleCode = decltype(loadedModuleCode)();
@@ -1944,143 +3662,454 @@ Session::~Session()
 
 }
 
-// implementation of C interface
+// implementation of C interface
+
+static SlangSession* convert(Slang::Session* session)
+{ return reinterpret_cast<SlangSession*>(session); }
+
+static Slang::Session* convert(SlangSession* session)
+{ return reinterpret_cast<Slang::Session*>(session); }
+
+static SlangCompileRequest* convert(Slang::EndToEndCompileRequest* request)
+{ return reinterpret_cast<SlangCompileRequest*>(request); }
+
+static Slang::EndToEndCompileRequest* convert(SlangCompileRequest* request)
+{ return reinterpret_cast<Slang::EndToEndCompileRequest*>(request); }
+
+SLANG_API SlangSession* spCreateSession(const char*)
+{
+    return convert(new Slang::Session());
+}
+
+SLANG_API SlangResult slang_createGlobalSession(
+    SlangInt                apiVersion,
+    slang::IGlobalSession** outGlobalSession)
+{
+    if(apiVersion != 0)
+        return SLANG_E_NOT_IMPLEMENTED;
+
+    Slang::Session* globalSession = new Slang::Session();
+    Slang::ComPtr<slang::IGlobalSession> result(Slang::asExternal(globalSession));
+    *outGlobalSession = result.detach();
+    return SLANG_OK;
+}
+
+SLANG_API void spDestroySession(
+    SlangSession*   session)
+{
+    if(!session) return;
+    delete convert(session);
+}
+
+SLANG_API void spAddBuiltins(
+    SlangSession*   session,
+    char const*     sourcePath,
+    char const*     sourceString)
+{
+    auto s = convert(session);
+
+    // User builtins are checked against the full stdlib, as if it had been loaded eagerly
+    s->loadPendingBuiltinModules();
+
+    s->addBuiltinSource(
+
+        // TODO(tfoley): Add ability to directly new builtins to the approriate scope
+        s->coreLanguageScope,
+
+        sourcePath,
+        sourceString);
+}
+
+SLANG_API void spSessionSetSharedLibraryLoader(
+    SlangSession*               session,
+    ISlangSharedLibraryLoader* loader)
+{
+    auto s = convert(session);
+
+    if (!loader)
+    {
+        // If null set the default
+        loader = Slang::DefaultSharedLibraryLoader::getSingleton();
+    }
+
+    if (s->sharedLibraryLoader != loader)
+    {
+        // Libraries being loaded with the previous loader would be cleared
+        s->waitForSharedLibraryPreload();
+
+        // Need to clear all of the libraries
+        for (int i = 0; i < SLANG_COUNT_OF(s->sharedLibraries); ++i)
+        {
+            s->sharedLibraries[i].setNull();
+        }
+
+        // Clear all of the functions, and their identities
+        ::memset(s->sharedLibraryFunctions, 0, sizeof(s->sharedLibraryFunctions));
+        ::memset(s->sharedLibraryFunctionHasIdentity, 0, sizeof(s->sharedLibraryFunctionHasIdentity));
+
+        // Set the loader
+        s->sharedLibraryLoader = loader;
+    }
+}
+
+SLANG_API ISlangSharedLibraryLoader* spSessionGetSharedLibraryLoader(
+    SlangSession*               session)
+{
+    auto s = convert(session);
+    return (s->sharedLibraryLoader == Slang::DefaultSharedLibraryLoader::getSingleton()) ? nullptr : s->sharedLibraryLoader.get();
+}
+
+SLANG_API SlangResult spSessionCheckCompileTargetSupport(
+    SlangSession*                session,
+    SlangCompileTarget           target)
+{
+    auto s = convert(session);
+    return Slang::checkCompileTargetSupport(s, Slang::CodeGenTarget(target));
+}
+
+SLANG_API SlangResult spSessionCheckPassThroughSupport(
+    SlangSession*       session,
+    SlangPassThrough    passThrough)
+{
+    auto s = convert(session);
+    return Slang::checkExternalCompilerSupport(s, Slang::PassThroughMode(passThrough));
+}
+
+SLANG_API void spSessionGetStdLibStats(
+    SlangSession*               session,
+    SlangSessionStdLibStats*    outStats)
+{
+    auto s = convert(session);
+    s->getStdLibStats(*outStats);
+}
+
+SLANG_API void spSessionLoadStdLib(
+    SlangSession*               session)
+{
+    auto s = convert(session);
+    s->loadPendingBuiltinModules();
+}
+
+SLANG_API SlangCompileRequest* spCreateCompileRequest(
+    SlangSession* session)
+{
+    auto s = convert(session);
+    auto req = new Slang::EndToEndCompileRequest(s);
+    return convert(req);
+}
+
+/*!
+@brief Destroy a compile request.
+*/
+SLANG_API void spDestroyCompileRequest(
+    SlangCompileRequest*    request)
+{
+    if(!request) return;
+    auto req = convert(request);
+    delete req;
+}
+
+SLANG_API void spResetCompileRequest(
+    SlangCompileRequest*    request)
+{
+    if(!request) return;
+    convert(request)->reset();
+}
+
+SLANG_API void spSetFileSystem(
+    SlangCompileRequest*    request,
+    ISlangFileSystem*       fileSystem)
+{
+    if(!request) return;
+    convert(request)->getLinkage()->setFileSystem(fileSystem);
+}
+
+SLANG_API void spSetCompileFlags(
+    SlangCompileRequest*    request,
+    SlangCompileFlags       flags)
+{
+    convert(request)->getFrontEndReq()->compileFlags = flags;
+}
+
+SLANG_API void spSetCompileCacheDirectory(
+    SlangCompileRequest*    request,
+    char const*             path)
+{
+    convert(request)->getLinkage()->compileCacheDirectory = path ? path : "";
+}
+
+SLANG_API void spSetCompileCacheMaxSize(
+    SlangCompileRequest*    request,
+    uint64_t                maxSizeInBytes)
+{
+    convert(request)->getLinkage()->compileCacheMaxSize = maxSizeInBytes;
+}
+
+SLANG_API void spSetCompileCache(
+    SlangCompileRequest*    request,
+    ISlangCompileCache*     cache)
+{
+    convert(request)->getLinkage()->compileCache = cache;
+}
+
+SLANG_API void spSetBackEndJobCount(
+    SlangCompileRequest*    request,
+    int                     jobCount)
+{
+    convert(request)->getBackEndReq()->jobCount = jobCount < 0 ? 1 : jobCount;
+    convert(request)->getFrontEndReq()->serialIRJobCount = jobCount < 0 ? 1 : jobCount;
+}
+
+SLANG_API void spPreloadDownstreamLibraries(
+    SlangCompileRequest*    request)
+{
+    convert(request)->preloadDownstreamLibraries();
+}
+
+SLANG_API void spSetDownstreamCompileJobCount(
+    SlangCompileRequest*    request,
+    int                     jobCount)
+{
+    convert(request)->getBackEndReq()->downstreamJobCount = jobCount < 0 ? 0 : jobCount;
+}
+
+SLANG_API void spSetPermutationDeduplicationEnabled(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    if(!request) return;
+    convert(request)->shouldDeduplicatePermutations = (enable != 0);
+}
+
+SLANG_API void spSetSharedFileCacheEnabled(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    if(!request) return;
+    convert(request)->getLinkage()->setUseSharedFileCache(enable != 0);
+}
+
+SLANG_API void spSetSharedModuleCacheEnabled(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    if(!request) return;
+    convert(request)->getLinkage()->m_useSharedModuleCache = (enable != 0);
+}
 
-static SlangSession* convert(Slang::Session* session)
-{ return reinterpret_cast<SlangSession*>(session); }
+SLANG_API void spSetCompactModulesEnabled(
+    SlangCompileRequest*    request,
+    int                     enable)
+{
+    if(!request) return;
+    convert(request)->getLinkage()->m_compactModules = (enable != 0);
+}
 
-static Slang::Session* convert(SlangSession* session)
-{ return reinterpret_cast<Slang::Session*>(session); }
+SLANG_API SlangResult spGetModuleMemoryStats(
+    SlangCompileRequest*    request,
+    char const*             moduleName,
+    SlangModuleMemoryStats* outStats)
+{
+    if(!request || !moduleName || !outStats) return SLANG_E_INVALID_ARG;
+    auto linkage = convert(request)->getLinkage();
 
-static SlangCompileRequest* convert(Slang::EndToEndCompileRequest* request)
-{ return reinterpret_cast<SlangCompileRequest*>(request); }
+    Slang::RefPtr<Slang::LoadedModule> module;
+    if (!linkage->mapNameToLoadedModules.TryGetValue(linkage->getNamePool()->getName(moduleName), module) || !module)
+        return SLANG_E_NOT_FOUND;
 
-static Slang::EndToEndCompileRequest* convert(SlangCompileRequest* request)
-{ return reinterpret_cast<Slang::EndToEndCompileRequest*>(request); }
+    module->getMemoryStats(outStats);
+    return SLANG_OK;
+}
 
-SLANG_API SlangSession* spCreateSession(const char*)
+SLANG_API void spSetSharedFileCacheCapacity(
+    size_t                  capacity)
 {
-    return convert(new Slang::Session());
+    Slang::SharedFileCache::getSingleton()->setCapacity(capacity);
 }
 
-SLANG_API SlangResult slang_createGlobalSession(
-    SlangInt                apiVersion,
-    slang::IGlobalSession** outGlobalSession)
+SLANG_API void spGetSessionMemoryStats(
+    SlangSession*           session,
+    SlangMemoryStats*       outStats)
 {
-    if(apiVersion != 0)
-        return SLANG_E_NOT_IMPLEMENTED;
+    if(!session || !outStats) return;
+    Slang::MemoryStats stats;
+    convert(session)->accumulateMemoryStats(stats);
+    Slang::_getExternalMemoryStats(stats, outStats);
+}
 
-    Slang::Session* globalSession = new Slang::Session();
-    Slang::ComPtr<slang::IGlobalSession> result(Slang::asExternal(globalSession));
-    *outGlobalSession = result.detach();
-    return SLANG_OK;
+SLANG_API void spGetCompileRequestMemoryStats(
+    SlangCompileRequest*    request,
+    SlangMemoryStats*       outStats)
+{
+    if(!request || !outStats) return;
+    Slang::MemoryStats stats;
+    convert(request)->accumulateMemoryStats(stats);
+    Slang::_getExternalMemoryStats(stats, outStats);
 }
 
-SLANG_API void spDestroySession(
-    SlangSession*   session)
+SLANG_API void spGetSharedFileCacheStats(
+    SlangSharedFileCacheStats*  outStats)
 {
-    if(!session) return;
-    delete convert(session);
+    if(!outStats) return;
+    const auto stats = Slang::SharedFileCache::getSingleton()->getStats();
+    outStats->hitCount = stats.hitCount;
+    outStats->missCount = stats.missCount;
+    outStats->fileCount = stats.fileCount;
+    outStats->byteCount = SlangInt(stats.byteCount);
 }
 
-SLANG_API void spAddBuiltins(
-    SlangSession*   session,
-    char const*     sourcePath,
-    char const*     sourceString)
+SLANG_API void spSetProfilingEnabled(
+    SlangCompileRequest*    request,
+    int                     enable)
 {
-    auto s = convert(session);
-    s->addBuiltinSource(
+    convert(request)->shouldProfile = enable != 0;
+}
 
-        // TODO(tfoley): Add ability to directly new builtins to the approriate scope
-        s->coreLanguageScope,
+SLANG_API void spSetCompileTimeLimit(
+    SlangCompileRequest*    request,
+    double                  seconds)
+{
+    convert(request)->budget->setTimeLimit(seconds < 0.0 ? 0.0 : seconds);
+}
 
-        sourcePath,
-        sourceString);
+SLANG_API void spSetCompileMemoryLimit(
+    SlangCompileRequest*    request,
+    uint64_t                maxSizeInBytes)
+{
+    convert(request)->budget->setMemoryLimit(Slang::Int(maxSizeInBytes));
 }
 
-SLANG_API void spSessionSetSharedLibraryLoader(
-    SlangSession*               session,
-    ISlangSharedLibraryLoader* loader)
+SLANG_API void spCancelCompile(
+    SlangCompileRequest*    request)
 {
-    auto s = convert(session);
+    if(!request) return;
+    convert(request)->budget->cancel();
+}
 
-    if (!loader)
-    {
-        // If null set the default
-        loader = Slang::DefaultSharedLibraryLoader::getSingleton();
-    }
+SLANG_API SlangInt spGetProfileEventCount(
+    SlangCompileRequest*    request)
+{
+    auto profiler = convert(request)->getLinkage()->getProfiler();
+    return profiler ? profiler->getEvents().getCount() : 0;
+}
 
-    if (s->sharedLibraryLoader != loader)
-    {
-        // Need to clear all of the libraries
-        for (int i = 0; i < SLANG_COUNT_OF(s->sharedLibraries); ++i)
-        {
-            s->sharedLibraries[i].setNull();
-        }
+SLANG_API SlangResult spGetProfileEvent(
+    SlangCompileRequest*    request,
+    SlangInt                eventIndex,
+    SlangProfileEvent*      outEvent)
+{
+    auto profiler = convert(request)->getLinkage()->getProfiler();
+    if (!profiler || !outEvent)
+        return SLANG_E_INVALID_ARG;
 
-        // Clear all of the functions
-        ::memset(s->sharedLibraryFunctions, 0, sizeof(s->sharedLibraryFunctions));
+    const auto& events = profiler->getEvents();
+    if (eventIndex < 0 || eventIndex >= events.getCount())
+        return SLANG_E_INVALID_ARG;
 
-        // Set the loader
-        s->sharedLibraryLoader = loader;
-    }
+    const auto& event = events[Slang::Index(eventIndex)];
+    outEvent->name = event.name.getBuffer();
+    outEvent->category = event.category.getBuffer();
+    outEvent->detail = event.detail.getBuffer();
+    outEvent->startTimeInSeconds = profiler->calcSecondsSinceStart(event.startTick);
+    outEvent->durationInSeconds = profiler->calcSecondsSinceStart(event.endTick) - outEvent->startTimeInSeconds;
+    outEvent->threadIndex = SlangUInt(event.threadIndex);
+    outEvent->instCountBefore = event.instCountBefore;
+    outEvent->instCountAfter = event.instCountAfter;
+    outEvent->memoryBefore = event.memoryBefore;
+    outEvent->memoryAfter = event.memoryAfter;
+    outEvent->astNodeCountBefore = event.astNodeCountBefore;
+    outEvent->astNodeCountAfter = event.astNodeCountAfter;
+    outEvent->astPeakBytesBefore = event.astPeakBytesBefore;
+    outEvent->astPeakBytesAfter = event.astPeakBytesAfter;
+    return SLANG_OK;
 }
 
-SLANG_API ISlangSharedLibraryLoader* spSessionGetSharedLibraryLoader(
-    SlangSession*               session)
+SLANG_API char const* spGetProfileChromeTrace(
+    SlangCompileRequest*    request)
 {
-    auto s = convert(session);
-    return (s->sharedLibraryLoader == Slang::DefaultSharedLibraryLoader::getSingleton()) ? nullptr : s->sharedLibraryLoader.get();
+    auto req = convert(request);
+    auto profiler = req->getLinkage()->getProfiler();
+    if (!profiler)
+        return nullptr;
+
+    Slang::StringBuilder trace;
+    profiler->writeChromeTrace(trace);
+    req->mProfileChromeTrace = trace.ProduceString();
+    return req->mProfileChromeTrace.getBuffer();
 }
 
-SLANG_API SlangResult spSessionCheckCompileTargetSupport(
-    SlangSession*                session,
-    SlangCompileTarget           target)
+SLANG_API void spSetCodeReportEnabled(
+    SlangCompileRequest*    request,
+    int                     enable)
 {
-    auto s = convert(session);
-    return Slang::checkCompileTargetSupport(s, Slang::CodeGenTarget(target));
+    convert(request)->shouldReportCode = enable != 0;
 }
 
-SLANG_API SlangResult spSessionCheckPassThroughSupport(
-    SlangSession*       session,
-    SlangPassThrough    passThrough)
+SLANG_API SlangInt spGetCodeReportEntryPointCount(
+    SlangCompileRequest*    request)
 {
-    auto s = convert(session);
-    return Slang::checkExternalCompilerSupport(s, Slang::PassThroughMode(passThrough));
+    auto codeReport = convert(request)->getLinkage()->getCodeReport();
+    return codeReport ? codeReport->getEntryPoints().getCount() : 0;
 }
 
-SLANG_API SlangCompileRequest* spCreateCompileRequest(
-    SlangSession* session)
+SLANG_API SlangResult spGetCodeReportEntryPoint(
+    SlangCompileRequest*        request,
+    SlangInt                    index,
+    SlangEntryPointCodeStats*   outStats)
 {
-    auto s = convert(session);
-    auto req = new Slang::EndToEndCompileRequest(s);
-    return convert(req);
+    auto codeReport = convert(request)->getLinkage()->getCodeReport();
+    if (!codeReport || !outStats)
+        return SLANG_E_INVALID_ARG;
+
+    const auto& entryPoints = codeReport->getEntryPoints();
+    if (index < 0 || index >= entryPoints.getCount())
+        return SLANG_E_INVALID_ARG;
+
+    const auto& report = entryPoints[Slang::Index(index)];
+    outStats->entryPointName = report.entryPointName.getBuffer();
+    outStats->targetName = report.targetName.getBuffer();
+    outStats->instCount = report.getFinalInstCount();
+    outStats->peakLiveValueCount = report.peakLiveValueCount;
+    outStats->sourceByteCount = report.sourceByteCount;
+    outStats->temporaryCount = report.temporaryCount;
+    return SLANG_OK;
 }
 
-/*!
-@brief Destroy a compile request.
-*/
-SLANG_API void spDestroyCompileRequest(
+SLANG_API char const* spGetCodeReportJSON(
     SlangCompileRequest*    request)
 {
-    if(!request) return;
     auto req = convert(request);
-    delete req;
+    auto codeReport = req->getLinkage()->getCodeReport();
+    if (!codeReport)
+        return nullptr;
+
+    Slang::StringBuilder json;
+    codeReport->writeJSON(json);
+    req->mCodeReportJSON = json.ProduceString();
+    return req->mCodeReportJSON.getBuffer();
 }
 
-SLANG_API void spSetFileSystem(
+SLANG_API void spSetPreprocessOnlyMode(
     SlangCompileRequest*    request,
-    ISlangFileSystem*       fileSystem)
+    SlangPreprocessOnlyMode mode)
 {
-    if(!request) return;
-    convert(request)->getLinkage()->setFileSystem(fileSystem);
+    convert(request)->preprocessOnlyMode = mode;
 }
 
-SLANG_API void spSetCompileFlags(
+SLANG_API void spSetDependencyRuleTarget(
     SlangCompileRequest*    request,
-    SlangCompileFlags       flags)
+    char const*             target)
 {
-    convert(request)->getFrontEndReq()->compileFlags = flags;
+    convert(request)->dependencyRuleTarget = target ? target : "";
+}
+
+SLANG_API char const* spGetPreprocessOutput(
+    SlangCompileRequest*    request)
+{
+    auto req = convert(request);
+    if (req->preprocessOnlyMode == SLANG_PREPROCESS_ONLY_NONE)
+        return nullptr;
+    return req->mPreprocessOutput.getBuffer();
 }
 
 SLANG_API void spSetDumpIntermediates(
@@ -2204,6 +4233,9 @@ SLANG_API void spSetOutputContainerFormat(
 {
     auto req = convert(request);
     req->containerFormat = Slang::ContainerFormat(format);
+
+    // A precompiled module needs the source of the declarations of each translation unit
+    req->getFrontEndReq()->shouldGenerateModuleInterface = (req->containerFormat == Slang::ContainerFormat::PrecompiledModule);
 }
 
 
@@ -2301,11 +4333,26 @@ SLANG_API int spAddTranslationUnit(
     SlangSourceLanguage     language,
     char const*             name)
 {
-    SLANG_UNUSED(name);
-
+    using namespace Slang;
     auto req = convert(request);
     auto frontEndReq = req->getFrontEndReq();
 
+    // A name gives the module its name, unless another translation unit already has it,
+    // as modules need distinct names to keep their symbols apart
+    if (name && name[0])
+    {
+        Name* moduleName = frontEndReq->getNamePool()->getName(name);
+        bool isUsed = false;
+        for (auto translationUnit : frontEndReq->translationUnits)
+        {
+            isUsed = isUsed || (translationUnit->moduleName == moduleName);
+        }
+        if (!isUsed)
+        {
+            return frontEndReq->addTranslationUnit(SourceLanguage(language), moduleName);
+        }
+    }
+
     return frontEndReq->addTranslationUnit(
         Slang::SourceLanguage(language));
 }
@@ -2529,6 +4576,17 @@ SLANG_API SlangResult spCompile(
     {
         res = req->executeActions();
     }
+    catch (Slang::CompileBudgetExceededException& e)
+    {
+        // The compile was cancelled, or went over its time or memory limit
+        req->getSink()->diagnose(Slang::SourceLoc(), Slang::Diagnostics::compilationStopped, e.Message);
+        switch (e.m_reason)
+        {
+            case Slang::CompileBudget::Reason::TimeLimit:   res = SLANG_E_TIME_LIMIT; break;
+            case Slang::CompileBudget::Reason::MemoryLimit: res = SLANG_E_MEMORY_LIMIT; break;
+            default:                                        res = SLANG_E_ABORT; break;
+        }
+    }
     catch (Slang::AbortCompilationException&)
     {
         // This situation indicates a fatal (but not necessarily internal) error
@@ -2568,8 +4626,17 @@ spGetDependencyFileCount(
 {
     if(!request) return 0;
     auto req = convert(request);
-    auto frontEndReq = req->getFrontEndReq();
-    auto program = frontEndReq->getProgram();
+    auto program = req->getUnspecializedProgram();
+    if(!program)
+    {
+        // A request satisified from the compile cache has no front-end program
+        program = req->getSpecializedProgram();
+    }
+    if(!program)
+    {
+        // A preprocess-only compile has no program at all
+        return (int) req->mPreprocessDependencies.getCount();
+    }
     return (int) program->getFilePathDependencies().getCount();
 }
 
@@ -2582,8 +4649,15 @@ spGetDependencyFilePath(
 {
     if(!request) return 0;
     auto req = convert(request);
-    auto frontEndReq = req->getFrontEndReq();
-    auto program = frontEndReq->getProgram();
+    auto program = req->getUnspecializedProgram();
+    if(!program)
+    {
+        program = req->getSpecializedProgram();
+    }
+    if(!program)
+    {
+        return req->mPreprocessDependencies[index].begin();
+    }
     return program->getFilePathDependencies()[index].begin();
 }
 
@@ -2632,25 +4706,8 @@ SLANG_API void const* spGetEntryPointCode(
         return nullptr;
     CompileResult& result = targetProgram->getExistingEntryPointResult(entryPointIndex);
 
-    void const* data = nullptr;
     size_t size = 0;
-
-    switch (result.format)
-    {
-    case ResultFormat::None:
-    default:
-        break;
-
-    case ResultFormat::Binary:
-        data = result.outputBinary.getBuffer();
-        size = result.outputBinary.getCount();
-        break;
-
-    case ResultFormat::Text:
-        data = result.outputString.getBuffer();
-        size = result.outputString.getLength();
-        break;
-    }
+    void const* data = result.getData(size);
 
     if(outSize) *outSize = size;
     return data;
@@ -2695,6 +4752,75 @@ SLANG_API SlangResult spGetEntryPointCodeBlob(
     return SLANG_OK;
 }
 
+SLANG_API SlangResult spWriteEntryPointCode(
+        SlangCompileRequest*    request,
+        int                     entryPointIndex,
+        int                     targetIndex,
+        ISlangWriter*           writer)
+{
+    using namespace Slang;
+    if(!request) return SLANG_ERROR_INVALID_PARAMETER;
+    if(!writer) return SLANG_ERROR_INVALID_PARAMETER;
+
+    auto req = convert(request);
+    auto linkage = req->getLinkage();
+    auto program = req->getSpecializedProgram();
+
+    if((targetIndex < 0) || (targetIndex >= linkage->targets.getCount()))
+    {
+        return SLANG_ERROR_INVALID_PARAMETER;
+    }
+    if((entryPointIndex < 0) || (entryPointIndex >= req->entryPoints.getCount()))
+    {
+        return SLANG_ERROR_INVALID_PARAMETER;
+    }
+
+    auto targetProgram = program->getTargetProgram(linkage->targets[targetIndex]);
+    if(!targetProgram)
+        return SLANG_FAIL;
+    CompileResult& result = targetProgram->getExistingEntryPointResult(entryPointIndex);
+
+    size_t size = 0;
+    void const* data = result.getData(size);
+    if(!data)
+        return SLANG_FAIL;
+    return writer->write((const char*)data, size);
+}
+
+SLANG_API SlangResult spGetEntryPointSourceMap(
+        SlangCompileRequest*    request,
+        int                     entryPointIndex,
+        int                     targetIndex,
+        ISlangBlob**            outBlob)
+{
+    using namespace Slang;
+    if(!request) return SLANG_ERROR_INVALID_PARAMETER;
+    if(!outBlob) return SLANG_ERROR_INVALID_PARAMETER;
+
+    auto req = convert(request);
+    auto linkage = req->getLinkage();
+    auto program = req->getSpecializedProgram();
+
+    if((targetIndex < 0) || (targetIndex >= linkage->targets.getCount()))
+    {
+        return SLANG_ERROR_INVALID_PARAMETER;
+    }
+    if((entryPointIndex < 0) || (entryPointIndex >= req->entryPoints.getCount()))
+    {
+        return SLANG_ERROR_INVALID_PARAMETER;
+    }
+
+    auto targetProgram = program->getTargetProgram(linkage->targets[targetIndex]);
+    if(!targetProgram)
+        return SLANG_FAIL;
+    CompileResult& result = targetProgram->getExistingEntryPointResult(entryPointIndex);
+    if(!result.sourceMap)
+        return SLANG_E_NOT_FOUND;
+
+    *outBlob = ComPtr<ISlangBlob>(result.sourceMap).detach();
+    return SLANG_OK;
+}
+
 SLANG_API char const* spGetEntryPointSource(
     SlangCompileRequest*    request,
     int                     entryPointIndex)
@@ -2702,13 +4828,46 @@ SLANG_API char const* spGetEntryPointSource(
     return (char const*) spGetEntryPointCode(request, entryPointIndex, nullptr);
 }
 
+SLANG_API void spInvalidateFiles(
+    SlangCompileRequest*    request,
+    char const* const*      paths,
+    SlangInt                pathCount)
+{
+    using namespace Slang;
+    if(!request) return;
+    auto req = convert(request);
+    req->getLinkage()->invalidateFiles(paths, pathCount);
+}
+
+SLANG_API char const* spGetOriginalName(
+    SlangCompileRequest*    request,
+    char const*             shortName)
+{
+    using namespace Slang;
+    if(!request || !shortName) return nullptr;
+    auto req = convert(request);
+
+    auto program = req->getSpecializedProgram();
+    if(!program) return nullptr;
+
+    String const* originalName = program->findOriginalName(shortName);
+    return originalName ? originalName->getBuffer() : nullptr;
+}
+
 SLANG_API void const* spGetCompileRequestCode(
     SlangCompileRequest*    request,
     size_t*                 outSize)
 {
-    SLANG_UNUSED(request);
-    SLANG_UNUSED(outSize);
-    return nullptr;
+    using namespace Slang;
+    if(!request) return nullptr;
+    auto req = convert(request);
+
+    // Only generated if a container format was set
+    ISlangBlob* blob = req->containerBlob;
+    if(!blob) return nullptr;
+
+    if(outSize) *outSize = blob->getBufferSize();
+    return blob->getBufferPointer();
 }
 
 // Reflection API
@@ -6,10 +6,20 @@ SLANG_API void spSetCommandLineCompilerMode(SlangCompileRequest* request);
 
 #include "../core/slang-io.h"
 #include "../core/slang-test-tool-util.h"
+#include "../core/slang-thread-pool.h"
+#include "../core/slang-writer.h"
+#include "../core/slang-process-util.h"
+#include "../core/slang-string-util.h"
 
 using namespace Slang;
 
 #include <assert.h>
+#include <stdio.h>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
 
 static void diagnosticCallback(
     char const* message,
@@ -26,10 +36,531 @@ static void diagnosticCallback(
 #define MAIN main
 #endif
 
+/* Batch mode (slangc -batch <manifest> ...) runs a compile for each line of a manifest, in one process. Each line
+holds the options for a compile, as they would be passed to slangc (so the files, entry points, defines, target and
+outputs). Compiles share a session, so the standard library is only loaded once - or with -batch-jobs, there is a
+session for each worker, as a session can only be used by one thread at a time. */
+
+    /// A compile in a batch
+class BatchJob : public RefObject, public ThreadPoolJob
+{
+public:
+    virtual void execute() SLANG_OVERRIDE;
+
+    void run(SlangSession* session);
+
+    BatchJob(Index lineNumber, const String& line, const List<String>& args, bool isConsole):
+        m_lineNumber(lineNumber),
+        m_line(line),
+        m_args(args),
+        m_isConsole(isConsole)
+    {}
+
+    Index m_lineNumber;                     ///< The line of the manifest the job is from
+    String m_line;                          ///< The text of the line
+    List<String> m_args;                    ///< The options for the compile
+
+    bool m_isConsole;                       ///< True if the output is to a console
+    StringBuilder m_output;                 ///< Output to standard output
+    StringBuilder m_diagnostics;            ///< Diagnostics and output to standard error
+    SlangResult m_result = SLANG_OK;
+    double m_time = 0.0;                    ///< Time in seconds taken by the compile
+
+    class BatchRunner* m_runner = nullptr;
+};
+
+    /// Runs the jobs of a batch, with a session for each worker
+class BatchRunner
+{
+public:
+    SlangSession* acquireSession()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // There is a session for each worker, so one must be free
+        SLANG_ASSERT(m_freeSessions.getCount() > 0);
+        SlangSession* session = m_freeSessions.getLast();
+        m_freeSessions.removeLast();
+        return session;
+    }
+    void releaseSession(SlangSession* session)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_freeSessions.add(session);
+    }
+
+        /// Run the jobs using up to jobCount threads. session is used by the first worker.
+    void run(SlangSession* session, List<RefPtr<BatchJob>>& jobs, Index jobCount)
+    {
+        jobCount = Math::Min(jobCount, jobs.getCount());
+        if (jobCount <= 1)
+        {
+            for (auto& job : jobs)
+            {
+                job->run(session);
+            }
+            return;
+        }
+
+        m_freeSessions.add(session);
+        for (Index i = 1; i < jobCount; ++i)
+        {
+            SlangSession* workerSession = spCreateSession(nullptr);
+            m_createdSessions.add(workerSession);
+            m_freeSessions.add(workerSession);
+        }
+
+        ThreadPool pool(jobCount);
+        for (auto& job : jobs)
+        {
+            job->m_runner = this;
+            pool.submit(job);
+        }
+        pool.waitForAll();
+    }
+
+    ~BatchRunner()
+    {
+        for (auto workerSession : m_createdSessions)
+        {
+            spDestroySession(workerSession);
+        }
+    }
+
+protected:
+    std::mutex m_mutex;
+    List<SlangSession*> m_freeSessions;             ///< Sessions not in use by a job
+    List<SlangSession*> m_createdSessions;          ///< Sessions created for workers (and so destroyed by the runner)
+};
+
+void BatchJob::execute()
+{
+    SlangSession* session = m_runner->acquireSession();
+    run(session);
+    m_runner->releaseSession(session);
+}
+
+void BatchJob::run(SlangSession* session)
+{
+    const uint64_t startTick = ProcessUtil::getClockTick();
+
+    SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
+
+    // Output is held, so that the output of jobs isn't interleaved
+    ComPtr<ISlangWriter> outputWriter(new StringWriter(&m_output, m_isConsole ? WriterFlags(WriterFlag::IsConsole) : 0));
+    ComPtr<ISlangWriter> diagnosticWriter(new StringWriter(&m_diagnostics, 0));
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_OUTPUT, outputWriter);
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_ERROR, diagnosticWriter);
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_DIAGNOSTIC, diagnosticWriter);
+
+    spSetCommandLineCompilerMode(compileRequest);
+
+    List<const char*> argPtrs;
+    for (const auto& arg : m_args)
+    {
+        argPtrs.add(arg.getBuffer());
+    }
+
+    m_result = spProcessCommandLineArguments(compileRequest, argPtrs.getBuffer(), int(argPtrs.getCount()));
+    if (SLANG_SUCCEEDED(m_result))
+    {
+#ifndef _DEBUG
+        try
+#endif
+        {
+            m_result = spCompile(compileRequest);
+            m_result = SLANG_FAILED(m_result) ? SLANG_E_INTERNAL_FAIL : m_result;
+        }
+#ifndef _DEBUG
+        catch (Exception & e)
+        {
+            m_output << "internal compiler error: " << e.Message << "\n";
+            m_result = SLANG_FAIL;
+        }
+#endif
+    }
+
+    spDestroyCompileRequest(compileRequest);
+
+    m_time = double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+}
+
+    /// Split a line of a manifest into arguments. Arguments are separated by whitespace, and can be quoted with ".
+static SlangResult _parseManifestLine(const UnownedStringSlice& line, List<String>& outArgs)
+{
+    const char* cur = line.begin();
+    const char* end = line.end();
+    while (true)
+    {
+        while (cur < end && (*cur == ' ' || *cur == '\t'))
+        {
+            cur++;
+        }
+        if (cur >= end)
+        {
+            return SLANG_OK;
+        }
+
+        StringBuilder arg;
+        while (cur < end && *cur != ' ' && *cur != '\t')
+        {
+            if (*cur == '"')
+            {
+                const char* quoteEnd = cur + 1;
+                while (quoteEnd < end && *quoteEnd != '"')
+                {
+                    quoteEnd++;
+                }
+                if (quoteEnd >= end)
+                {
+                    return SLANG_FAIL;
+                }
+                arg.Append(cur + 1, quoteEnd - (cur + 1));
+                cur = quoteEnd + 1;
+            }
+            else
+            {
+                arg.Append(*cur++);
+            }
+        }
+        outArgs.add(arg);
+    }
+}
+
+    /// Run slangc in batch mode. argv[0] is the manifest path, and is followed by options that apply to all of
+    /// the compiles (and -batch-jobs).
+static SlangResult _innerMainBatch(StdWriters* stdWriters, SlangSession* session, int argc, const char*const* argv)
+{
+    auto stdError = stdWriters->getError();
+    auto stdOut = stdWriters->getOut();
+
+    if (argc < 1)
+    {
+        stdError.print("error: expected a manifest path for '-batch'\n");
+        return SLANG_FAIL;
+    }
+    const String manifestPath = argv[0];
+
+    Index jobCount = 1;
+    List<String> commonArgs;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (UnownedStringSlice(argv[i]) == "-batch-jobs")
+        {
+            Int count = 0;
+            if (i + 1 >= argc || SLANG_FAILED(StringUtil::parseInt(UnownedStringSlice(argv[i + 1]), count)) || count < 0)
+            {
+                stdError.print("error: expected a job count for '-batch-jobs'\n");
+                return SLANG_FAIL;
+            }
+            // 0 means a job per hardware thread, as for -j
+            jobCount = (count == 0) ? ThreadPool::getDefaultThreadCount() : Index(count);
+            i++;
+            continue;
+        }
+        commonArgs.add(argv[i]);
+    }
+
+    String manifest;
+    try
+    {
+        manifest = File::readAllText(manifestPath);
+    }
+    catch (const IOException&)
+    {
+        stdError.print("error: unable to read batch manifest '%s'\n", manifestPath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    const bool isConsole = stdOut.getWriter()->isConsole();
+
+    List<RefPtr<BatchJob>> jobs;
+    Index lineNumber = 0;
+    for (auto line : LineParser(manifest.getUnownedSlice()))
+    {
+        lineNumber++;
+        line = line.trim();
+        if (line.size() == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        List<String> args(commonArgs);
+        if (SLANG_FAILED(_parseManifestLine(line, args)))
+        {
+            stdError.print("%s(%d): error: unterminated quote\n", manifestPath.getBuffer(), int(lineNumber));
+            return SLANG_FAIL;
+        }
+        jobs.add(new BatchJob(lineNumber, line, args, isConsole));
+    }
+
+    const uint64_t startTick = ProcessUtil::getClockTick();
+    {
+        BatchRunner runner;
+        runner.run(session, jobs, jobCount);
+    }
+    const double totalTime = double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+
+    // The standard writers flush on every write, so buffer the output of the jobs and the summary. Each job's
+    // diagnostics are flushed before its output, so they are in the same order if both go to the same console.
+    BufferedWriter bufferedError(stdError.getWriter(), WriterFlag::IsStatic);
+    BufferedWriter bufferedOut(stdOut.getWriter(), WriterFlag::IsStatic);
+
+    // Output in manifest order, whatever order the jobs ran in
+    SlangResult res = SLANG_OK;
+    Index failedCount = 0;
+    for (const auto& job : jobs)
+    {
+        if (job->m_diagnostics.getLength())
+        {
+            bufferedOut.flush();
+            bufferedError.write(job->m_diagnostics.getBuffer(), job->m_diagnostics.getLength());
+            bufferedError.flush();
+        }
+        if (job->m_output.getLength())
+        {
+            bufferedOut.write(job->m_output.getBuffer(), job->m_output.getLength());
+        }
+        if (SLANG_FAILED(job->m_result))
+        {
+            failedCount++;
+            // Keep the result of the first failure
+            res = SLANG_FAILED(res) ? res : job->m_result;
+        }
+    }
+
+    // Summary of the time taken by each job
+    WriterHelper summaryOut(&bufferedOut);
+    summaryOut.print("batch: %d compiles, %d failed, %.1fms\n", int(jobs.getCount()), int(failedCount), totalTime * 1000.0);
+    for (const auto& job : jobs)
+    {
+        summaryOut.print("  %s(%d): %s %.1fms: %s\n", manifestPath.getBuffer(), int(job->m_lineNumber),
+            SLANG_SUCCEEDED(job->m_result) ? "ok" : "FAILED", job->m_time * 1000.0, job->m_line.getBuffer());
+    }
+    bufferedOut.flush();
+
+    return res;
+}
+
+/* Server mode (slangc -server [<options>]) keeps a session, and the shared file and module caches, for the life of the
+process, and runs compiles sent to it over standard input - so a tool that compiles again after a small edit doesn't pay
+for starting the compiler, loading the standard library or loading unchanged imported modules. Any options after
+-server are added to the start of every compile's options.
+
+Messages are a sequence of little endian uint32 values, with strings and blobs as a uint32 byte count followed by the
+bytes. A request is
+
+    'SLRQ' (kServerRequestFourCC), argument count, arguments...
+
+and each request gets a response written to standard output
+
+    'SLRS' (kServerResponseFourCC), SlangResult of the compile, diagnostics, standard output text,
+    output count, outputs...
+
+where each output is the target index, entry point index and the code blob. Outputs are returned rather than written to
+files (so -o options are ignored). The server exits when standard input is closed. */
+
+static const uint32_t kServerRequestFourCC = uint32_t('S') | (uint32_t('L') << 8) | (uint32_t('R') << 16) | (uint32_t('Q') << 24);
+static const uint32_t kServerResponseFourCC = uint32_t('S') | (uint32_t('L') << 8) | (uint32_t('R') << 16) | (uint32_t('S') << 24);
+
+    /// Reads a request from a file
+struct ServerReader
+{
+    SlangResult read(void* out, size_t size) { return (size == 0 || fread(out, size, 1, m_file) == 1) ? SLANG_OK : SLANG_FAIL; }
+    SlangResult readUInt32(uint32_t& outValue) { return read(&outValue, sizeof(outValue)); }
+    SlangResult readString(String& outValue)
+    {
+        uint32_t length;
+        SLANG_RETURN_ON_FAIL(readUInt32(length));
+        List<char> chars;
+        chars.setCount(Index(length));
+        SLANG_RETURN_ON_FAIL(read(chars.getBuffer(), length));
+        outValue = UnownedStringSlice(chars.getBuffer(), chars.getBuffer() + length);
+        return SLANG_OK;
+    }
+
+    ServerReader(FILE* file) : m_file(file) {}
+
+    FILE* m_file;
+};
+
+    /// Builds a response, to be written in one go
+struct ServerWriter
+{
+    void write(const void* data, size_t size)
+    {
+        const Index start = m_data.getCount();
+        m_data.setCount(start + Index(size));
+        if (size)
+        {
+            ::memcpy(m_data.getBuffer() + start, data, size);
+        }
+    }
+    void writeUInt32(uint32_t value) { write(&value, sizeof(value)); }
+    void writeBlob(const void* data, size_t size)
+    {
+        writeUInt32(uint32_t(size));
+        write(data, size);
+    }
+    void writeString(const StringBuilder& value) { writeBlob(value.getBuffer(), size_t(value.getLength())); }
+
+    List<uint8_t> m_data;
+};
+
+    /// Run the compile for a request, writing the response to writer
+static void _runServerCompile(SlangSession* session, const List<String>& args, ServerWriter& writer)
+{
+    StringBuilder output;
+    StringBuilder diagnostics;
+
+    SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
+
+    ComPtr<ISlangWriter> outputWriter(new StringWriter(&output, 0));
+    ComPtr<ISlangWriter> diagnosticWriter(new StringWriter(&diagnostics, 0));
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_OUTPUT, outputWriter);
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_STD_ERROR, diagnosticWriter);
+    spSetWriter(compileRequest, SLANG_WRITER_CHANNEL_DIAGNOSTIC, diagnosticWriter);
+
+    // Files, and imported modules, are only loaded again if they have changed since an earlier compile used them
+    spSetSharedFileCacheEnabled(compileRequest, 1);
+    spSetSharedModuleCacheEnabled(compileRequest, 1);
+
+    List<const char*> argPtrs;
+    for (const auto& arg : args)
+    {
+        argPtrs.add(arg.getBuffer());
+    }
+
+    SlangResult res = spProcessCommandLineArguments(compileRequest, argPtrs.getBuffer(), int(argPtrs.getCount()));
+    if (SLANG_SUCCEEDED(res))
+    {
+#ifndef _DEBUG
+        try
+#endif
+        {
+            res = spCompile(compileRequest);
+        }
+#ifndef _DEBUG
+        catch (Exception & e)
+        {
+            diagnostics << "internal compiler error: " << e.Message << "\n";
+            res = SLANG_FAIL;
+        }
+#endif
+    }
+
+    // The code for each (target, entry point)
+    List<ComPtr<ISlangBlob>> blobs;
+    List<uint32_t> blobTargetIndices;
+    List<uint32_t> blobEntryPointIndices;
+    if (SLANG_SUCCEEDED(res))
+    {
+        const int entryPointCount = int(spReflection_getEntryPointCount(spGetReflection(compileRequest)));
+        for (int targetIndex = 0; entryPointCount > 0; ++targetIndex)
+        {
+            ComPtr<ISlangBlob> blob;
+            if (spGetEntryPointCodeBlob(compileRequest, 0, targetIndex, blob.writeRef()) == SLANG_ERROR_INVALID_PARAMETER)
+            {
+                // No more targets
+                break;
+            }
+            for (int entryPointIndex = 0; entryPointIndex < entryPointCount; ++entryPointIndex)
+            {
+                blob.setNull();
+                if (SLANG_SUCCEEDED(spGetEntryPointCodeBlob(compileRequest, entryPointIndex, targetIndex, blob.writeRef())) && blob)
+                {
+                    blobs.add(blob);
+                    blobTargetIndices.add(uint32_t(targetIndex));
+                    blobEntryPointIndices.add(uint32_t(entryPointIndex));
+                }
+            }
+        }
+    }
+
+    spDestroyCompileRequest(compileRequest);
+
+    writer.writeUInt32(kServerResponseFourCC);
+    writer.writeUInt32(uint32_t(res));
+    writer.writeString(diagnostics);
+    writer.writeString(output);
+    writer.writeUInt32(uint32_t(blobs.getCount()));
+    for (Index i = 0; i < blobs.getCount(); ++i)
+    {
+        writer.writeUInt32(blobTargetIndices[i]);
+        writer.writeUInt32(blobEntryPointIndices[i]);
+        writer.writeBlob(blobs[i]->getBufferPointer(), blobs[i]->getBufferSize());
+    }
+}
+
+    /// Run slangc as a server. argv holds options that apply to all of the compiles.
+static SlangResult _innerMainServer(StdWriters* stdWriters, SlangSession* session, int argc, const char*const* argv)
+{
+    List<String> commonArgs;
+    for (int i = 0; i < argc; ++i)
+    {
+        commonArgs.add(argv[i]);
+    }
+
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    // Load the standard library now, rather than as part of the first compile
+    spSessionLoadStdLib(session);
+
+    ServerReader reader(stdin);
+    while (true)
+    {
+        uint32_t fourCC;
+        if (SLANG_FAILED(reader.readUInt32(fourCC)))
+        {
+            // Standard input was closed
+            return SLANG_OK;
+        }
+
+        uint32_t argCount = 0;
+        if (fourCC != kServerRequestFourCC || SLANG_FAILED(reader.readUInt32(argCount)))
+        {
+            stdWriters->getError().print("error: invalid server request\n");
+            return SLANG_FAIL;
+        }
+
+        List<String> args(commonArgs);
+        for (uint32_t i = 0; i < argCount; ++i)
+        {
+            String arg;
+            if (SLANG_FAILED(reader.readString(arg)))
+            {
+                stdWriters->getError().print("error: invalid server request\n");
+                return SLANG_FAIL;
+            }
+            args.add(arg);
+        }
+
+        ServerWriter writer;
+        _runServerCompile(session, args, writer);
+
+        if (fwrite(writer.m_data.getBuffer(), size_t(writer.m_data.getCount()), 1, stdout) != 1 || fflush(stdout) != 0)
+        {
+            // Standard output was closed, so there is no one to respond to
+            return SLANG_OK;
+        }
+    }
+}
+
 SLANG_TEST_TOOL_API SlangResult innerMain(StdWriters* stdWriters, SlangSession* session, int argc, const char*const* argv)
 {
     StdWriters::setSingleton(stdWriters);
 
+    if (argc > 1 && UnownedStringSlice(argv[1]) == "-batch")
+    {
+        return _innerMainBatch(stdWriters, session, argc - 2, argv + 2);
+    }
+    if (argc > 1 && UnownedStringSlice(argv[1]) == "-server")
+    {
+        return _innerMainServer(stdWriters, session, argc - 2, argv + 2);
+    }
+
     SlangCompileRequest* compileRequest = spCreateCompileRequest(session);
 
     spSetDiagnosticCallback(
@@ -0,0 +1,70 @@
+//TEST(smoke):CPP_COMPILER_EXECUTE: 
+
+#include "../../prelude/slang-cpp-compute.h"
+
+#include <atomic>
+#include <iostream>
+using namespace std;
+
+static const uint32_t kGroupSize = 8;
+
+int main(int argc, char** argv)
+{
+    SlangCompute::ThreadPool pool(4);
+
+    // Every group of the grid is run exactly once
+    {
+        const uint32_t groupCount[3] = { 5, 3, 2 };
+        std::atomic<uint32_t> runCounts[30];
+        for (auto& runCount : runCounts)
+        {
+            runCount = 0;
+        }
+
+        pool.dispatch(groupCount, 0, [&](const SlangCompute::GroupContext& context)
+        {
+            runCounts[(context.groupID[2] * 3 + context.groupID[1]) * 5 + context.groupID[0]]++;
+        });
+
+        bool isRunOnce = true;
+        for (auto& runCount : runCounts)
+        {
+            isRunOnce = isRunOnce && runCount == 1;
+        }
+        cout << "groups run once: " << (isRunOnce ? "yes" : "no") << endl;
+    }
+
+    // Groups reduce their invocations' values through group shared memory and a barrier
+    {
+        const uint32_t groupCount[3] = { 4, 1, 1 };
+        const uint32_t groupSize[3] = { kGroupSize, 1, 1 };
+        uint32_t sums[4] = { 0, 0, 0, 0 };
+
+        pool.dispatch(groupCount, sizeof(uint32_t) * kGroupSize, [&](const SlangCompute::GroupContext& context)
+        {
+            uint32_t* shared = (uint32_t*)context.groupShared;
+            SlangCompute::runGroupInvocations(groupSize, [&](const uint32_t threadID[3], SlangCompute::Barrier& barrier)
+            {
+                shared[threadID[0]] = context.groupID[0] * kGroupSize + threadID[0];
+                barrier.wait();
+                if (threadID[0] == 0)
+                {
+                    uint32_t sum = 0;
+                    for (uint32_t i = 0; i < kGroupSize; ++i)
+                    {
+                        sum += shared[i];
+                    }
+                    sums[context.groupID[0]] = sum;
+                }
+            });
+        });
+
+        cout << "group sums:";
+        for (auto sum : sums)
+        {
+            cout << " " << sum;
+        }
+        cout << endl;
+    }
+    return 0;
+}
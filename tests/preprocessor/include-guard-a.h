@@ -0,0 +1,9 @@
+// include-guard-a.h
+#ifndef INCLUDE_GUARD_A_H
+#define INCLUDE_GUARD_A_H
+
+float foo(float x) { return x; }
+
+#define COUNT_A (COUNT_A_BASE + 1)
+
+#endif // INCLUDE_GUARD_A_H
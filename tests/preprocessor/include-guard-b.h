@@ -0,0 +1,12 @@
+// include-guard-b.h
+// Looks like an include guard, but has an `#else`, so it must be read each time
+#ifndef INCLUDE_GUARD_B_H
+#define INCLUDE_GUARD_B_H
+
+float bar(float x) { return x; }
+
+#else
+
+#define INCLUDED_B_AGAIN 1
+
+#endif
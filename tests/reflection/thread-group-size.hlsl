@@ -1,4 +1,5 @@
 //TEST:REFLECTION:-profile cs_5_0 -target hlsl
+//TEST:REFLECTION:-profile cs_5_0 -target hlsl -reflection-only
 
 // Confirm that we provide reflection data for the `numthreads` attribute
 
@@ -39,6 +39,14 @@ using namespace Slang;
         case Format::D_Float32:             return DXGI_FORMAT_D32_FLOAT;
         case Format::D_Unorm24_S8:          return DXGI_FORMAT_D24_UNORM_S8_UINT;
 
+        case Format::BC1_Unorm:             return DXGI_FORMAT_BC1_UNORM;
+        case Format::BC2_Unorm:             return DXGI_FORMAT_BC2_UNORM;
+        case Format::BC3_Unorm:             return DXGI_FORMAT_BC3_UNORM;
+        case Format::BC4_Unorm:             return DXGI_FORMAT_BC4_UNORM;
+        case Format::BC5_Unorm:             return DXGI_FORMAT_BC5_UNORM;
+        case Format::BC6H_UFloat16:         return DXGI_FORMAT_BC6H_UF16;
+        case Format::BC7_Unorm:             return DXGI_FORMAT_BC7_UNORM;
+
         default:                            return DXGI_FORMAT_UNKNOWN;
     }
 }
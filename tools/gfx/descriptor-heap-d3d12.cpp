@@ -43,5 +43,131 @@ Result D3D12DescriptorHeap::init(ID3D12Device* device, const D3D12_CPU_DESCRIPTO
     return SLANG_OK;
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! D3D12FreeListDescriptorHeap !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+D3D12FreeListDescriptorHeap::D3D12FreeListDescriptorHeap()
+{
+    for (auto& head : m_freeHeads)
+    {
+        head = -1;
+    }
+}
+
+Result D3D12FreeListDescriptorHeap::init(ID3D12Device* device, int size, D3D12_DESCRIPTOR_HEAP_TYPE type, D3D12_DESCRIPTOR_HEAP_FLAGS flags)
+{
+    SLANG_RETURN_ON_FAIL(m_heap.init(device, size, type, flags));
+    m_nextFree.setCount(size);
+    return SLANG_OK;
+}
+
+/* static */int D3D12FreeListDescriptorHeap::_getSizeClass(int numDescriptors)
+{
+    int sizeClass = 0;
+    while ((1 << sizeClass) < numDescriptors)
+    {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+int D3D12FreeListDescriptorHeap::allocate(int numDescriptors)
+{
+    const int sizeClass = _getSizeClass(numDescriptors);
+    SLANG_ASSERT(sizeClass < kSizeClassCount);
+
+    const int index = m_freeHeads[sizeClass];
+    if (index >= 0)
+    {
+        m_freeHeads[sizeClass] = m_nextFree[index];
+        return index;
+    }
+
+    // Nothing free of this size, so take from the unused part of the heap
+    const int size = 1 << sizeClass;
+    if (m_heap.getUsedSize() + size > m_heap.getTotalSize())
+    {
+        return -1;
+    }
+    return m_heap.allocate(size);
+}
+
+void D3D12FreeListDescriptorHeap::free(int index, int numDescriptors)
+{
+    SLANG_ASSERT(index >= 0 && index < m_heap.getUsedSize());
+    const int sizeClass = _getSizeClass(numDescriptors);
+
+    m_nextFree[index] = m_freeHeads[sizeClass];
+    m_freeHeads[sizeClass] = index;
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! D3D12RingDescriptorHeap !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+Result D3D12RingDescriptorHeap::init(ID3D12Device* device, int size, D3D12_DESCRIPTOR_HEAP_TYPE type, D3D12_DESCRIPTOR_HEAP_FLAGS flags, D3D12CounterFence* fence)
+{
+    SLANG_RETURN_ON_FAIL(m_heap.init(device, size, type, flags));
+    m_fence = fence;
+    m_pendingQueue.clear();
+    m_front = 0;
+    m_back = 0;
+    return SLANG_OK;
+}
+
+int D3D12RingDescriptorHeap::allocate(int numDescriptors)
+{
+    const uint64_t totalSize = uint64_t(m_heap.getTotalSize());
+    if (uint64_t(numDescriptors) > totalSize)
+    {
+        return -1;
+    }
+
+    for (int i = 0; i < 2; ++i)
+    {
+        uint64_t front = m_front;
+        uint64_t index = front % totalSize;
+        if (index + numDescriptors > totalSize)
+        {
+            // Doesn't fit before the end, so skip to the start
+            front += totalSize - index;
+            index = 0;
+        }
+
+        if (front + numDescriptors - m_back <= totalSize)
+        {
+            m_front = front + numDescriptors;
+            return int(index);
+        }
+
+        // Full. See if the GPU has finished with anything, and try again
+        updateCompleted();
+    }
+    return -1;
+}
+
+void D3D12RingDescriptorHeap::addSync(uint64_t signalValue)
+{
+    PendingEntry entry;
+    entry.m_completedValue = signalValue;
+    entry.m_front = m_front;
+    m_pendingQueue.add(entry);
+}
+
+void D3D12RingDescriptorHeap::updateCompleted()
+{
+    const uint64_t completedValue = m_fence->getCompletedValue();
+
+    const Index size = m_pendingQueue.getCount();
+    Index end = 0;
+    while (end < size && m_pendingQueue[end].m_completedValue <= completedValue)
+    {
+        end++;
+    }
+
+    if (end > 0)
+    {
+        m_back = m_pendingQueue[end - 1].m_front;
+        m_pendingQueue.removeRange(0, end);
+    }
+}
+
 } // namespace gfx
 
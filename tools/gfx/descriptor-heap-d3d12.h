@@ -7,6 +7,8 @@
 #include "../../slang-com-ptr.h"
 #include "../../source/core/slang-list.h"
 
+#include "resource-d3d12.h"
+
 namespace gfx {
 
 /*! \brief A simple class to manage an underlying Dx12 Descriptor Heap. Allocations are made linearly in order. It is not possible to free
@@ -63,6 +65,94 @@ protected:
     int m_descriptorSize;                    ///< The size of each descriptor
 };
 
+/*! \brief A descriptor heap where allocations can be freed individually, for descriptors that live as long as the object
+that uses them (such as the tables of a descriptor set).
+
+Allocations are rounded up to a power of 2 number of descriptors. Freed allocations are held in a free list for each size,
+so allocating and freeing are O(1). Free allocations are never merged, so this works best when the same sizes are allocated
+and freed repeatedly, which is the usual case for descriptor sets with the same layout. */
+class D3D12FreeListDescriptorHeap
+{
+    public:
+    typedef D3D12FreeListDescriptorHeap ThisType;
+
+        /// The number of allocation sizes, each size being a power of 2
+    static const int kSizeClassCount = 31;
+
+        /// Initialize
+    Slang::Result init(ID3D12Device* device, int size, D3D12_DESCRIPTOR_HEAP_TYPE type, D3D12_DESCRIPTOR_HEAP_FLAGS flags);
+
+        /// Allocate a number of contiguous descriptors. Returns the start index, or -1 if there isn't space.
+    int allocate(int numDescriptors);
+        /// Free an allocation. numDescriptors must be the number the allocation was made with.
+    void free(int index, int numDescriptors);
+
+        /// Get the GPU handle at the specified index
+    SLANG_FORCE_INLINE D3D12_GPU_DESCRIPTOR_HANDLE getGpuHandle(int index) const { return m_heap.getGpuHandle(index); }
+        /// Get the CPU handle at the specified index
+    SLANG_FORCE_INLINE D3D12_CPU_DESCRIPTOR_HANDLE getCpuHandle(int index) const { return m_heap.getCpuHandle(index); }
+        /// Get the underlying heap
+    SLANG_FORCE_INLINE ID3D12DescriptorHeap* getHeap() const { return m_heap.getHeap(); }
+
+        /// Ctor
+    D3D12FreeListDescriptorHeap();
+
+protected:
+        /// Get the index of the smallest size class that can hold numDescriptors
+    static int _getSizeClass(int numDescriptors);
+
+    D3D12DescriptorHeap m_heap;                     ///< Allocations not in a free list are made linearly from here
+    Slang::List<int> m_nextFree;                    ///< For the start of a free allocation, the start of the next free allocation of the same size (or -1)
+    int m_freeHeads[kSizeClassCount];               ///< The first free allocation of each size (or -1)
+};
+
+/*! \brief A descriptor heap used as a ring buffer, for descriptors that are only used by the commands submitted in
+a frame (such as the shader visible copies of descriptor tables).
+
+As with D3D12CircularResourceHeap, the addSync/updateCompleted idiom tracks when the GPU has finished with allocations.
+Allocations are made from the front, and once the GPU has completed the commands submitted before a sync point,
+everything allocated before it is freed from the back. Allocations are contiguous, so if one doesn't fit before the end
+of the heap the remaining space is skipped. If the heap is full, allocate checks where the GPU has got to before failing. */
+class D3D12RingDescriptorHeap
+{
+    public:
+    typedef D3D12RingDescriptorHeap ThisType;
+
+        /// Initialize. The fence is used to find out which sync points have been completed.
+    Slang::Result init(ID3D12Device* device, int size, D3D12_DESCRIPTOR_HEAP_TYPE type, D3D12_DESCRIPTOR_HEAP_FLAGS flags, D3D12CounterFence* fence);
+
+        /// Allocate a number of contiguous descriptors. Returns the start index, or -1 if there isn't space.
+    int allocate(int numDescriptors);
+
+        /// Add a sync point - when the fence reaches signalValue everything allocated so far is no longer used
+    void addSync(uint64_t signalValue);
+        /// Look where the GPU has got to and free the allocations it no longer uses
+    void updateCompleted();
+
+        /// Get the GPU handle at the specified index
+    SLANG_FORCE_INLINE D3D12_GPU_DESCRIPTOR_HANDLE getGpuHandle(int index) const { return m_heap.getGpuHandle(index); }
+        /// Get the CPU handle at the specified index
+    SLANG_FORCE_INLINE D3D12_CPU_DESCRIPTOR_HANDLE getCpuHandle(int index) const { return m_heap.getCpuHandle(index); }
+        /// Get the underlying heap
+    SLANG_FORCE_INLINE ID3D12DescriptorHeap* getHeap() const { return m_heap.getHeap(); }
+
+protected:
+    struct PendingEntry
+    {
+        uint64_t m_completedValue;                  ///< The fence value when this is completed
+        uint64_t m_front;                           ///< The front at that point
+    };
+
+    D3D12DescriptorHeap m_heap;
+    D3D12CounterFence* m_fence = nullptr;
+    Slang::List<PendingEntry> m_pendingQueue;       ///< Sync points, in order of fence value
+
+    // Positions are the total number of descriptors allocated (or skipped) since init, so the index in the heap
+    // is the position modulo the heap size, and front - back is the number of descriptors in use.
+    uint64_t m_front = 0;
+    uint64_t m_back = 0;
+};
+
 /// A host-visible descriptor, used as "backing storage" for a view.
 ///
 /// This type is intended to be used to represent descriptors that
@@ -0,0 +1,211 @@
+// heap-allocator-d3d12.cpp
+#include "heap-allocator-d3d12.h"
+
+#include <assert.h>
+
+namespace gfx {
+using namespace Slang;
+
+    /// Get the index of a heap type in the pools, or -1 if it's not one that resources are placed in
+static int _getHeapTypeIndex(D3D12_HEAP_TYPE heapType)
+{
+    switch (heapType)
+    {
+        case D3D12_HEAP_TYPE_DEFAULT:   return 0;
+        case D3D12_HEAP_TYPE_UPLOAD:    return 1;
+        case D3D12_HEAP_TYPE_READBACK:  return 2;
+        default:                        return -1;
+    }
+}
+
+void D3D12HeapAllocator::init(ID3D12Device* device, D3D12_RESOURCE_HEAP_TIER tier, UINT64 heapSize)
+{
+    assert(m_device == nullptr);
+    m_device = device;
+    m_tier = tier;
+    m_heapSize = heapSize;
+
+    const D3D12_HEAP_TYPE heapTypes[kHeapTypeCount] = { D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_TYPE_READBACK };
+    const D3D12_HEAP_FLAGS heapFlags[int(ResourceKind::CountOf)] =
+    {
+        D3D12_HEAP_FLAG_ALLOW_ALL_BUFFERS_AND_TEXTURES,     // All
+        D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS,                 // Buffer
+        D3D12_HEAP_FLAG_ALLOW_ONLY_RT_DS_TEXTURES,          // RenderTargetTexture
+        D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES,      // Texture
+    };
+
+    for (int i = 0; i < kHeapTypeCount; ++i)
+    {
+        for (int j = 0; j < int(ResourceKind::CountOf); ++j)
+        {
+            m_pools[i][j].m_heapType = heapTypes[i];
+            m_pools[i][j].m_heapFlags = heapFlags[j];
+        }
+    }
+}
+
+D3D12HeapAllocator::~D3D12HeapAllocator()
+{
+    for (auto& pools : m_pools)
+    {
+        for (auto& pool : pools)
+        {
+            for (Heap* heap : pool.m_heaps)
+            {
+                delete heap;
+            }
+        }
+    }
+}
+
+D3D12HeapAllocator::ResourceKind D3D12HeapAllocator::_getResourceKind(const D3D12_RESOURCE_DESC& resourceDesc) const
+{
+    if (m_tier != D3D12_RESOURCE_HEAP_TIER_1)
+    {
+        return ResourceKind::All;
+    }
+    if (resourceDesc.Dimension == D3D12_RESOURCE_DIMENSION_BUFFER)
+    {
+        return ResourceKind::Buffer;
+    }
+    if (resourceDesc.Flags & (D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET | D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL))
+    {
+        return ResourceKind::RenderTargetTexture;
+    }
+    return ResourceKind::Texture;
+}
+
+Result D3D12HeapAllocator::createResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& resourceDesc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue, D3D12Resource& outResource, D3D12HeapAllocation& outAllocation)
+{
+    assert(outAllocation.m_heap == nullptr);
+
+    const D3D12_RESOURCE_ALLOCATION_INFO allocationInfo = m_device->GetResourceAllocationInfo(0, 1, &resourceDesc);
+    const int heapTypeIndex = _getHeapTypeIndex(heapType);
+
+    if (heapTypeIndex < 0 ||
+        allocationInfo.SizeInBytes == ~UINT64(0) ||
+        allocationInfo.Alignment > D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT ||
+        allocationInfo.SizeInBytes > m_heapSize / 2)
+    {
+        // Can't be placed in (or would waste much of) a heap, so is committed
+        D3D12_HEAP_PROPERTIES heapProps = {};
+        heapProps.Type = heapType;
+        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapProps.CreationNodeMask = 1;
+        heapProps.VisibleNodeMask = 1;
+        return outResource.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, resourceDesc, initialState, clearValue);
+    }
+
+    const ResourceKind kind = _getResourceKind(resourceDesc);
+    Pool& pool = m_pools[heapTypeIndex][int(kind)];
+
+    // Rounding up to the placement alignment keeps every range a multiple of it
+    const UINT64 alignment = D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT;
+    const UINT64 size = (allocationInfo.SizeInBytes + alignment - 1) & ~(alignment - 1);
+
+    TLSFAllocator::Allocation heapAllocation;
+    Index heapIndex = -1;
+    Index freeHeapIndex = -1;
+    for (Index i = 0; i < pool.m_heaps.getCount(); ++i)
+    {
+        Heap* heap = pool.m_heaps[i];
+        if (!heap)
+        {
+            freeHeapIndex = i;
+        }
+        else if (heap->m_allocator.allocate(size, alignment, heapAllocation))
+        {
+            heapIndex = i;
+            break;
+        }
+    }
+
+    if (heapIndex < 0)
+    {
+        // All the heaps are full, so add one
+        D3D12_HEAP_DESC heapDesc = {};
+        heapDesc.SizeInBytes = m_heapSize;
+        heapDesc.Properties.Type = heapType;
+        heapDesc.Properties.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapDesc.Properties.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapDesc.Properties.CreationNodeMask = 1;
+        heapDesc.Properties.VisibleNodeMask = 1;
+        heapDesc.Alignment = alignment;
+        heapDesc.Flags = pool.m_heapFlags;
+
+        ComPtr<ID3D12Heap> d3dHeap;
+        SLANG_RETURN_ON_FAIL(m_device->CreateHeap(&heapDesc, IID_PPV_ARGS(d3dHeap.writeRef())));
+
+        Heap* heap = new Heap;
+        heap->m_heap = d3dHeap;
+        heap->m_allocator.init(m_heapSize);
+        m_heapCount++;
+
+        if (freeHeapIndex >= 0)
+        {
+            heapIndex = freeHeapIndex;
+            pool.m_heaps[heapIndex] = heap;
+        }
+        else
+        {
+            heapIndex = pool.m_heaps.getCount();
+            pool.m_heaps.add(heap);
+        }
+
+        const bool isAllocated = heap->m_allocator.allocate(size, alignment, heapAllocation);
+        SLANG_UNUSED(isAllocated);
+        assert(isAllocated);
+    }
+
+    Heap* heap = pool.m_heaps[heapIndex];
+
+    ComPtr<ID3D12Resource> resource;
+    const Result res = m_device->CreatePlacedResource(heap->m_heap, heapAllocation.m_offset, &resourceDesc, initialState, clearValue, IID_PPV_ARGS(resource.writeRef()));
+    if (SLANG_FAILED(res))
+    {
+        heap->m_allocator.free(heapAllocation.m_node);
+        return res;
+    }
+    outResource.setResource(resource, initialState);
+
+    outAllocation.m_heap = heap->m_heap;
+    outAllocation.m_offset = heapAllocation.m_offset;
+    outAllocation.m_poolIndex = heapTypeIndex * int(ResourceKind::CountOf) + int(kind);
+    outAllocation.m_heapIndex = int(heapIndex);
+    outAllocation.m_node = heapAllocation.m_node;
+    return SLANG_OK;
+}
+
+void D3D12HeapAllocator::free(D3D12HeapAllocation& ioAllocation)
+{
+    if (ioAllocation.m_heap == nullptr)
+    {
+        return;
+    }
+
+    Pool& pool = m_pools[ioAllocation.m_poolIndex / int(ResourceKind::CountOf)][ioAllocation.m_poolIndex % int(ResourceKind::CountOf)];
+    Heap* heap = pool.m_heaps[ioAllocation.m_heapIndex];
+    heap->m_allocator.free(ioAllocation.m_node);
+
+    // An empty heap is released, unless it's the only one in the pool (so creating and destroying one resource
+    // doesn't create and release a heap each time)
+    if (heap->m_allocator.isEmpty())
+    {
+        Index heapCount = 0;
+        for (Heap* other : pool.m_heaps)
+        {
+            heapCount += Index(other != nullptr);
+        }
+        if (heapCount > 1)
+        {
+            delete heap;
+            pool.m_heaps[ioAllocation.m_heapIndex] = nullptr;
+            m_heapCount--;
+        }
+    }
+
+    ioAllocation = D3D12HeapAllocation();
+}
+
+} // namespace gfx
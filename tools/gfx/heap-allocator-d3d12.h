@@ -0,0 +1,97 @@
+// heap-allocator-d3d12.h
+#pragma once
+
+#include <dxgi.h>
+#include <d3d12.h>
+
+#include "../../slang-com-ptr.h"
+#include "../../source/core/slang-list.h"
+
+#include "resource-d3d12.h"
+#include "tlsf-allocator.h"
+
+namespace gfx {
+
+    /// The heap memory a placed resource is in, allocated by D3D12HeapAllocator
+struct D3D12HeapAllocation
+{
+    ID3D12Heap* m_heap = nullptr;               ///< Null if the resource is committed
+    UINT64 m_offset = 0;
+
+    int m_poolIndex = -1;                       ///< The pool of heaps the heap is in
+    int m_heapIndex = -1;                       ///< The heap in the pool
+    uint32_t m_node = TLSFAllocator::kInvalidNode;  ///< Identifies the allocation within the heap
+};
+
+/*! \brief D3D12HeapAllocator creates resources placed in large ID3D12Heaps, rather than as committed resources with a
+heap each.
+
+There is a pool of heaps for each heap type (default, upload and readback) and kind of resource. On resource heap tier 2
+hardware buffers and all textures can share heaps, so there is one kind. On tier 1 buffers, render target and depth
+stencil textures, and other textures must be in different heaps, so there is a pool for each. A heap is added to a pool
+when the others are full, and each heap's ranges are managed with a TLSFAllocator, whose size classes let a freed range
+be reused (and merged with free neighbors) without ever moving resources. All allocation sizes are multiples of the
+64KB placement alignment, so ranges are never split into unusably small pieces.
+
+Resources needing more than 64KB alignment (multisampled textures), or larger than half a heap, are created as committed
+resources.
+*/
+class D3D12HeapAllocator
+{
+public:
+    typedef D3D12HeapAllocator ThisType;
+
+    enum class ResourceKind
+    {
+        All,                                    ///< Any resource, on tier 2
+        Buffer,
+        RenderTargetTexture,                    ///< Render target and depth stencil textures
+        Texture,                                ///< All other textures
+        CountOf,
+    };
+
+        /// Initialize. Heaps are heapSize bytes.
+    void init(ID3D12Device* device, D3D12_RESOURCE_HEAP_TIER tier, UINT64 heapSize = kDefaultHeapSize);
+
+        /// Create a resource placed in a heap of heapType, or a committed resource if it can't be placed
+    Slang::Result createResource(D3D12_HEAP_TYPE heapType, const D3D12_RESOURCE_DESC& resourceDesc, D3D12_RESOURCE_STATES initialState, const D3D12_CLEAR_VALUE* clearValue, D3D12Resource& outResource, D3D12HeapAllocation& outAllocation);
+        /// Free the memory of a resource (if it was placed), resetting the allocation. The resource must have been released.
+    void free(D3D12HeapAllocation& ioAllocation);
+
+        /// Get the number of heaps currently held
+    int getHeapCount() const { return m_heapCount; }
+
+        /// Releases all of the heaps. Nothing allocated can be used after this.
+    ~D3D12HeapAllocator();
+
+    static const UINT64 kDefaultHeapSize = 64 * 1024 * 1024;
+
+protected:
+    enum
+    {
+        kHeapTypeCount = 3,                     ///< Default, upload and readback
+    };
+
+    struct Heap
+    {
+        Slang::ComPtr<ID3D12Heap> m_heap;
+        TLSFAllocator m_allocator;
+    };
+
+    struct Pool
+    {
+        D3D12_HEAP_TYPE m_heapType = D3D12_HEAP_TYPE_DEFAULT;
+        D3D12_HEAP_FLAGS m_heapFlags = D3D12_HEAP_FLAG_NONE;
+        Slang::List<Heap*> m_heaps;             ///< Null where a heap has been freed
+    };
+
+    ResourceKind _getResourceKind(const D3D12_RESOURCE_DESC& resourceDesc) const;
+
+    ID3D12Device* m_device = nullptr;
+    D3D12_RESOURCE_HEAP_TIER m_tier = D3D12_RESOURCE_HEAP_TIER_1;
+    UINT64 m_heapSize = kDefaultHeapSize;
+    Pool m_pools[kHeapTypeCount][int(ResourceKind::CountOf)];
+    int m_heapCount = 0;
+};
+
+} // namespace gfx
@@ -0,0 +1,206 @@
+// mip-generator.cpp
+#include "mip-generator.h"
+
+#include "../../slang-com-ptr.h"
+
+#include <stdio.h>
+
+namespace gfx {
+using namespace Slang;
+
+// The texels are sRGB encoded, so are converted to linear to be averaged, and back to be written
+static const char kMipGeneratorShader[] =
+    "Texture2D<float4> src;\n"
+    "[format(\"rgba8\")]\n"
+    "RWTexture2D<float4> dst;\n"
+    "\n"
+    "float3 toLinear(float3 c) { return c <= 0.04045f ? c / 12.92f : pow((c + 0.055f) / 1.055f, 2.4f); }\n"
+    "float3 toSrgb(float3 c) { return c <= 0.0031308f ? c * 12.92f : 1.055f * pow(c, 1.0f / 2.4f) - 0.055f; }\n"
+    "\n"
+    "float4 loadLinear(int2 coord, int2 maxCoord)\n"
+    "{\n"
+    "    float4 texel = src.Load(int3(min(coord, maxCoord), 0));\n"
+    "    return float4(toLinear(texel.rgb), texel.a);\n"
+    "}\n"
+    "\n"
+    "[numthreads(8, 8, 1)]\n"
+    "void computeMain(uint3 dispatchThreadID : SV_DispatchThreadID)\n"
+    "{\n"
+    "    uint dstWidth, dstHeight;\n"
+    "    dst.GetDimensions(dstWidth, dstHeight);\n"
+    "    if (dispatchThreadID.x >= dstWidth || dispatchThreadID.y >= dstHeight)\n"
+    "        return;\n"
+    "\n"
+    "    uint srcWidth, srcHeight;\n"
+    "    src.GetDimensions(srcWidth, srcHeight);\n"
+    "\n"
+    "    // Where the mip above has an odd size, its last row or column is used twice\n"
+    "    int2 maxCoord = int2(srcWidth, srcHeight) - 1;\n"
+    "    int2 coord = int2(dispatchThreadID.xy) * 2;\n"
+    "    float4 sum = loadLinear(coord, maxCoord) +\n"
+    "        loadLinear(coord + int2(1, 0), maxCoord) +\n"
+    "        loadLinear(coord + int2(0, 1), maxCoord) +\n"
+    "        loadLinear(coord + int2(1, 1), maxCoord);\n"
+    "    float4 average = sum * 0.25f;\n"
+    "    dst[dispatchThreadID.xy] = float4(toSrgb(average.rgb), average.a);\n"
+    "}\n";
+
+static const int kThreadGroupSize = 8;
+
+/* static */bool MipGenerator::isSupported(Renderer* renderer)
+{
+    return renderer->getRendererType() == RendererType::DirectX11;
+}
+
+Result MipGenerator::init(Renderer* renderer)
+{
+    if (!isSupported(renderer))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    m_renderer = renderer;
+
+    SlangSession* slangSession = spCreateSession(nullptr);
+    SlangCompileRequest* slangRequest = spCreateCompileRequest(slangSession);
+
+    int targetIndex = spAddCodeGenTarget(slangRequest, SLANG_DXBC);
+    spSetTargetProfile(slangRequest, targetIndex, spFindProfile(slangSession, "sm_5_0"));
+
+    int translationUnitIndex = spAddTranslationUnit(slangRequest, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(slangRequest, translationUnitIndex, "mip-generator.cpp.slang", kMipGeneratorShader);
+    int entryPointIndex = spAddEntryPoint(slangRequest, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const SlangResult compileRes = spCompile(slangRequest);
+    if (auto diagnostics = spGetDiagnosticOutput(slangRequest))
+    {
+        fprintf(stderr, "%s", diagnostics);
+    }
+
+    ComPtr<ISlangBlob> computeShaderBlob;
+    if (SLANG_SUCCEEDED(compileRes))
+    {
+        spGetEntryPointCodeBlob(slangRequest, entryPointIndex, 0, computeShaderBlob.writeRef());
+    }
+
+    spDestroyCompileRequest(slangRequest);
+    spDestroySession(slangSession);
+
+    if (!computeShaderBlob)
+    {
+        return SLANG_FAIL;
+    }
+
+    char const* computeCode = (char const*)computeShaderBlob->getBufferPointer();
+    char const* computeCodeEnd = computeCode + computeShaderBlob->getBufferSize();
+
+    ShaderProgram::KernelDesc kernelDesc = { StageType::Compute, computeCode, computeCodeEnd };
+
+    ShaderProgram::Desc programDesc;
+    programDesc.pipelineType = PipelineType::Compute;
+    programDesc.kernels = &kernelDesc;
+    programDesc.kernelCount = 1;
+
+    RefPtr<ShaderProgram> program = renderer->createProgram(programDesc);
+    if (!program)
+    {
+        return SLANG_FAIL;
+    }
+
+    const DescriptorSetLayout::SlotRangeDesc slotRanges[] =
+    {
+        DescriptorSetLayout::SlotRangeDesc(DescriptorSlotType::SampledImage),
+        DescriptorSetLayout::SlotRangeDesc(DescriptorSlotType::StorageImage),
+    };
+
+    DescriptorSetLayout::Desc descriptorSetLayoutDesc;
+    descriptorSetLayoutDesc.slotRangeCount = SLANG_COUNT_OF(slotRanges);
+    descriptorSetLayoutDesc.slotRanges = slotRanges;
+    m_descriptorSetLayout = renderer->createDescriptorSetLayout(descriptorSetLayoutDesc);
+    if (!m_descriptorSetLayout)
+    {
+        return SLANG_FAIL;
+    }
+
+    PipelineLayout::DescriptorSetDesc descriptorSetDesc(m_descriptorSetLayout);
+
+    PipelineLayout::Desc pipelineLayoutDesc;
+    pipelineLayoutDesc.descriptorSetCount = 1;
+    pipelineLayoutDesc.descriptorSets = &descriptorSetDesc;
+    m_pipelineLayout = renderer->createPipelineLayout(pipelineLayoutDesc);
+    if (!m_pipelineLayout)
+    {
+        return SLANG_FAIL;
+    }
+
+    ComputePipelineStateDesc pipelineStateDesc;
+    pipelineStateDesc.program = program;
+    pipelineStateDesc.pipelineLayout = m_pipelineLayout;
+    m_pipelineState = renderer->createComputePipelineState(pipelineStateDesc);
+    if (!m_pipelineState)
+    {
+        return SLANG_FAIL;
+    }
+
+    m_emptyDescriptorSet = renderer->createDescriptorSet(m_descriptorSetLayout);
+    return m_emptyDescriptorSet ? SLANG_OK : SLANG_FAIL;
+}
+
+Result MipGenerator::generateMips(TextureResource* texture)
+{
+    const TextureResource::Desc& desc = texture->getDesc();
+    if (!m_pipelineState ||
+        texture->getType() != Resource::Type::Texture2D ||
+        desc.arraySize > 1 ||
+        desc.format != Format::RGBA_Unorm_UInt8 ||
+        !texture->canBind(Resource::BindFlag::UnorderedAccess))
+    {
+        return SLANG_FAIL;
+    }
+
+    m_renderer->setPipelineState(PipelineType::Compute, m_pipelineState);
+
+    Result res = SLANG_OK;
+    for (int mipLevel = 1; mipLevel < desc.numMipLevels; ++mipLevel)
+    {
+        ResourceView::Desc srcViewDesc;
+        srcViewDesc.type = ResourceView::Type::ShaderResource;
+        srcViewDesc.format = desc.format;
+        srcViewDesc.mipLevel = mipLevel - 1;
+        srcViewDesc.mipLevelCount = 1;
+
+        ResourceView::Desc dstViewDesc;
+        dstViewDesc.type = ResourceView::Type::UnorderedAccess;
+        dstViewDesc.format = desc.format;
+        dstViewDesc.mipLevel = mipLevel;
+
+        RefPtr<ResourceView> srcView;
+        RefPtr<ResourceView> dstView;
+        RefPtr<DescriptorSet> descriptorSet;
+        res = m_renderer->createTextureView(texture, srcViewDesc, srcView.writeRef());
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = m_renderer->createTextureView(texture, dstViewDesc, dstView.writeRef());
+        }
+        if (SLANG_SUCCEEDED(res))
+        {
+            res = m_renderer->createDescriptorSet(m_descriptorSetLayout, descriptorSet.writeRef());
+        }
+        if (SLANG_FAILED(res))
+        {
+            break;
+        }
+
+        descriptorSet->setResource(0, 0, srcView);
+        descriptorSet->setResource(1, 0, dstView);
+        m_renderer->setDescriptorSet(PipelineType::Compute, m_pipelineLayout, 0, descriptorSet);
+
+        const int width = TextureResource::calcMipSize(desc.size.width, mipLevel);
+        const int height = TextureResource::calcMipSize(desc.size.height, mipLevel);
+        m_renderer->dispatchCompute((width + kThreadGroupSize - 1) / kThreadGroupSize, (height + kThreadGroupSize - 1) / kThreadGroupSize, 1);
+    }
+
+    m_renderer->setDescriptorSet(PipelineType::Compute, m_pipelineLayout, 0, m_emptyDescriptorSet);
+    return res;
+}
+
+} // namespace gfx
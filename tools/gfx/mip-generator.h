@@ -0,0 +1,43 @@
+// mip-generator.h
+#pragma once
+
+#include "render.h"
+
+namespace gfx {
+
+/*! \brief MipGenerator fills in the mips of a texture on the GPU, from its most detailed mip, with a compute shader
+written in Slang.
+
+Each mip is a 2x2 box filter of the mip above, averaged in linear space as the texels are sRGB encoded (as textures
+loaded from images are). There is a dispatch per mip, reading the mip above through a shader resource view of just that
+mip and writing through an unordered access view of the mip being generated.
+
+This needs views of single mips, and the work of one dispatch to be visible to the next, so is currently only supported
+by the D3D11 renderer. The Vulkan renderer can't create texture views, the GL renderer ignores the view desc, and the D3D12
+renderer doesn't transition resources between dispatches.
+*/
+class MipGenerator : public Slang::RefObject
+{
+public:
+    typedef MipGenerator ThisType;
+
+        /// True if mips can be generated for textures of renderer
+    static bool isSupported(Renderer* renderer);
+
+        /// Compile the shader, and create what it's run with. The renderer must outlive the generator.
+    Slang::Result init(Renderer* renderer);
+
+        /// Generate all of the mips of texture after the first, from the first. The texture must be a non array
+        /// Texture2D of Format::RGBA_Unorm_UInt8, with the UnorderedAccess and a shader resource bind flag.
+        /// The work is recorded on the renderer, and runs before anything recorded after it.
+    Slang::Result generateMips(TextureResource* texture);
+
+protected:
+    Renderer* m_renderer = nullptr;
+    RefPtr<DescriptorSetLayout> m_descriptorSetLayout;
+    RefPtr<PipelineLayout> m_pipelineLayout;
+    RefPtr<PipelineState> m_pipelineState;
+    RefPtr<DescriptorSet> m_emptyDescriptorSet;     ///< Bound after generating, so the texture isn't left bound for writing
+};
+
+} // namespace gfx
@@ -1,6 +1,8 @@
 // model.cpp
 #include "model.h"
 
+#include "mip-generator.h"
+
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "../../external/tinyobjloader/tiny_obj_loader.h"
 
@@ -14,6 +16,13 @@
 #include "../../external/glm/glm/gtc/matrix_transform.hpp"
 #include "../../external/glm/glm/gtc/constants.hpp"
 
+#include "../../source/core/slang-hash.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-thread-pool.h"
+
+#include <stdio.h>
+#include <string.h>
+
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
@@ -95,14 +104,29 @@ namespace std
 namespace gfx
 {
 
-RefPtr<TextureResource> loadTextureImage(
-    Renderer*   renderer,
-    char const* path)
+// An image decoded to RGBA8, with all of its mips, in one block of memory (so it can be written to and read from
+// the cache as is).
+//
+struct DecodedTextureImage
+{
+    int extentX = 0;
+    int extentY = 0;
+    std::vector<size_t> mipOffsets;     // Offset of each mip in `data`, the first being the image itself
+    std::vector<unsigned char> data;
+};
+
+static const int kTextureChannelCount = 4;
+
+// Decodes just the image - the first mip.
+//
+static bool decodeTextureImage(
+    char const*             path,
+    DecodedTextureImage&    outImage)
 {
     int extentX = 0;
     int extentY = 0;
     int originalChannelCount = 0;
-    int requestedChannelCount = 4; // force to 4-component result
+    int requestedChannelCount = kTextureChannelCount; // force to 4-component result
     stbi_uc* data = stbi_load(
         path,
         &extentX,
@@ -110,112 +134,557 @@ RefPtr<TextureResource> loadTextureImage(
         &originalChannelCount,
         requestedChannelCount);
     if(!data)
-        return nullptr;
+        return false;
 
-    int channelCount = requestedChannelCount ? requestedChannelCount : originalChannelCount;
+    // TODO: handle other formats here if/when we stop forcing 4-component
+    // results when loading the image with stb_image.
+    const int channelCount = kTextureChannelCount;
 
-    Format format;
-    switch(channelCount)
-    {
-    default:
-        return nullptr;
+    const size_t size = size_t(extentX) * extentY * channelCount * sizeof(stbi_uc);
 
-    case 4: format = Format::RGBA_Unorm_UInt8;
+    outImage.extentX = extentX;
+    outImage.extentY = extentY;
+    outImage.mipOffsets.assign(1, 0);
+    outImage.data.assign(data, data + size);
+    stbi_image_free(data);
+    return true;
+}
 
-    // TODO: handle other cases here if/when we stop forcing 4-component
-    // results when loading the image with stb_image.
-    }
+// Adds the rest of the mips, down to 1x1, to an image that only has its first.
+//
+static void generateTextureMips(
+    DecodedTextureImage&    ioImage)
+{
+    const int channelCount = kTextureChannelCount;
 
-    std::vector<void*> subresourceInitData;
-    std::vector<ptrdiff_t> mipRowStrides;
+    // Work out the size of every mip up front, so they can all be written in place
+    size_t totalSize = 0;
+    ioImage.mipOffsets.clear();
+    {
+        int mipExtentX = ioImage.extentX;
+        int mipExtentY = ioImage.extentY;
+        for(;;)
+        {
+            ioImage.mipOffsets.push_back(totalSize);
+            totalSize += size_t(mipExtentX) * mipExtentY * channelCount * sizeof(stbi_uc);
 
-    ptrdiff_t stride = extentX * channelCount * sizeof(stbi_uc);
+            if(mipExtentX == 1 && mipExtentY == 1)
+                break;
 
-    subresourceInitData.push_back(data);
-    mipRowStrides.push_back(stride);
+            mipExtentX = mipExtentX / 2 ? mipExtentX / 2 : 1;
+            mipExtentY = mipExtentY / 2 ? mipExtentY / 2 : 1;
+        }
+    }
+    ioImage.data.resize(totalSize);
 
     // create down-sampled images for the different mip levels
-    bool generateMips = true;
-    if(generateMips)
+    int prevExtentX = ioImage.extentX;
+    int prevExtentY = ioImage.extentY;
+    for(size_t mip = 1; mip < ioImage.mipOffsets.size(); ++mip)
     {
-        int prevExtentX = extentX;
-        int prevExtentY = extentY;
-        stbi_uc* prevData = data;
-        int prevStride = int(stride);
+        int newExtentX = prevExtentX / 2;
+        int newExtentY = prevExtentY / 2;
 
-        for(;;)
-        {
-            if(prevExtentX == 1 && prevExtentY == 1)
-                break;
+        if(!newExtentX) newExtentX = 1;
+        if(!newExtentY) newExtentY = 1;
 
-            int newExtentX = prevExtentX / 2;
-            int newExtentY = prevExtentY / 2;
+        stbir_resize_uint8_srgb(
+            ioImage.data.data() + ioImage.mipOffsets[mip - 1], prevExtentX, prevExtentY, int(prevExtentX * channelCount * sizeof(stbi_uc)),
+            ioImage.data.data() + ioImage.mipOffsets[mip],     newExtentX,  newExtentY,  int(newExtentX * channelCount * sizeof(stbi_uc)),
+            channelCount,
+            STBIR_ALPHA_CHANNEL_NONE,
+            STBIR_FLAG_ALPHA_PREMULTIPLIED);
 
-            if(!newExtentX) newExtentX = 1;
-            if(!newExtentY) newExtentY = 1;
+        prevExtentX = newExtentX;
+        prevExtentY = newExtentY;
+    }
+}
 
-            stbi_uc* newData = (stbi_uc*) malloc(newExtentX * newExtentY * channelCount * sizeof(stbi_uc));
-            int newStride = int(newExtentX * channelCount * sizeof(stbi_uc));
+// Creates a texture from an image. If the image only has its first mip, and there is
+// a mip generator, the rest are generated on the GPU.
+//
+static RefPtr<TextureResource> createTexture(
+    Renderer*                   renderer,
+    DecodedTextureImage const&  image,
+    MipGenerator*               mipGenerator)
+{
+    const bool isGeneratingMips = mipGenerator && image.mipOffsets.size() == 1;
 
-            stbir_resize_uint8_srgb(
-                prevData, prevExtentX, prevExtentY, prevStride,
-                 newData,  newExtentX,  newExtentY,  newStride,
-                channelCount,
-                STBIR_ALPHA_CHANNEL_NONE,
-                STBIR_FLAG_ALPHA_PREMULTIPLIED);
+    TextureResource::Desc desc;
+    desc.init2D(Resource::Type::Texture2D, Format::RGBA_Unorm_UInt8, image.extentX, image.extentY, int(image.mipOffsets.size()));
 
-            subresourceInitData.push_back(newData);
-            mipRowStrides.push_back(newStride);
+    std::vector<void*> subresourceInitData;
+    std::vector<ptrdiff_t> mipRowStrides;
+    if(isGeneratingMips)
+    {
+        // Every mip has to have initial data, so they all start with (as much of) the first
+        // mip (as fits), and are overwritten when generated
+        desc.numMipLevels = desc.calcNumMipLevels();
+        desc.bindFlags = Resource::BindFlag::PixelShaderResource | Resource::BindFlag::NonPixelShaderResource | Resource::BindFlag::UnorderedAccess;
 
-            prevExtentX = newExtentX;
-            prevExtentY = newExtentY;
-            prevData = newData;
-            prevStride = newStride;
+        subresourceInitData.assign(desc.numMipLevels, (void*)image.data.data());
+        mipRowStrides.assign(desc.numMipLevels, image.extentX * kTextureChannelCount * sizeof(stbi_uc));
+    }
+    else
+    {
+        int mipExtentX = image.extentX;
+        for(auto mipOffset : image.mipOffsets)
+        {
+            subresourceInitData.push_back((void*)(image.data.data() + mipOffset));
+            mipRowStrides.push_back(mipExtentX * kTextureChannelCount * sizeof(stbi_uc));
+            mipExtentX = mipExtentX / 2 ? mipExtentX / 2 : 1;
         }
     }
 
     int mipCount = (int) mipRowStrides.size();
 
-    TextureResource::Desc desc;
-    desc.init2D(Resource::Type::Texture2D, format, extentX, extentY, mipCount);
-
     TextureResource::Data initData;
     initData.numSubResources = mipCount;
     initData.numMips = mipCount;
     initData.subResources = &subresourceInitData[0];
     initData.mipRowStrides = &mipRowStrides[0];
 
-    auto texture = renderer->createTextureResource(
+    RefPtr<TextureResource> texture = renderer->createTextureResource(
         Resource::Usage::PixelShaderResource,
         desc,
         &initData);
 
-    free(data);
-
+    if(texture && isGeneratingMips && SLANG_FAILED(mipGenerator->generateMips(texture)))
+    {
+        log("failed to generate texture mips\n");
+        return nullptr;
+    }
     return texture;
 }
 
+RefPtr<TextureResource> loadTextureImage(
+    Renderer*   renderer,
+    char const* path)
+{
+    DecodedTextureImage image;
+    if(!decodeTextureImage(path, image))
+        return nullptr;
+    generateTextureMips(image);
+    return createTexture(renderer, image, nullptr);
+}
+
 static std::string makeString(const char* start, const char* end)
 {
     return std::string(start, size_t(end - start));
 }
 
-Result ModelLoader::load(
-    char const* inputPath,
-    void**      outModel)
+static bool readFile(const char* path, std::vector<unsigned char>& outData)
 {
-    // TODO: need to actually allocate/load the data
+    FILE* file = fopen(path, "rb");
+    if(!file)
+        return false;
+
+    bool success = fseek(file, 0, SEEK_END) == 0;
+    long size = success ? ftell(file) : -1;
+    success = success && size >= 0 && fseek(file, 0, SEEK_SET) == 0;
+    if(success)
+    {
+        outData.resize(size_t(size));
+        success = fread(outData.data(), 1, outData.size(), file) == outData.size();
+    }
+    fclose(file);
+    return success;
+}
 
-    tinyobj::attrib_t objVertexAttributes;
-    std::vector<tinyobj::shape_t> objShapes;
-    std::vector<tinyobj::material_t> objMaterials;
+static void writeFile(const std::string& path, const std::vector<unsigned char>& data)
+{
+    // Write to a temporary file that is then renamed, so that a partly written
+    // file is never read (for example, if two processes fill the cache at once).
+    std::string tempPath = path + ".tmp";
+    FILE* file = fopen(tempPath.c_str(), "wb");
+    if(!file)
+        return;
+
+    bool success = fwrite(data.data(), 1, data.size(), file) == data.size();
+    success = (fclose(file) == 0) && success;
+
+    remove(path.c_str());
+    if(!success || rename(tempPath.c_str(), path.c_str()) != 0)
+    {
+        remove(tempPath.c_str());
+    }
+}
 
-    std::string baseDir;
-    if( auto lastSlash = strrchr(inputPath, '/') )
+// The binary cache
+// ================
+//
+// Meshes and decoded textures are cached in files named by a hash of the
+// files they were made from, so editing a source file just leads to a new
+// cache entry. Each cache file is a header followed by flat arrays at offsets
+// that are multiples of 8 bytes, so it can be used where it is loaded (or
+// memory mapped) without any parsing. A file whose header doesn't match (for
+// example, one written by a different version) is ignored, and rewritten.
+//
+enum : uint32_t
+{
+    kMeshCacheFourCC    = 'G' | ('M' << 8) | ('S' << 16) | ('H' << 24),
+    kTextureCacheFourCC = 'G' | ('T' << 8) | ('E' << 16) | ('X' << 24),
+    kCacheVersion       = 1,
+};
+
+struct CacheHeader
+{
+    uint32_t    fourCC;
+    uint32_t    version;
+    uint64_t    key;                // The hash of the source files, as in the file name
+};
+
+// A model as loaded from an OBJ file, before any renderer objects are made for it.
+// This is the contents of a mesh cache file.
+//
+struct LoadedModel
+{
+    struct Material
     {
-        baseDir = makeString(inputPath, lastSlash);
+        glm::vec3   diffuseColor;
+        glm::vec3   specularColor;
+        float       specularity;
+        std::string diffuseMapPath;     // Empty if there is no diffuse map
+    };
+
+    struct Mesh
+    {
+        int32_t firstIndex;
+        int32_t indexCount;
+        int32_t materialIndex;          // -1 for the default material
+    };
+
+    std::vector<Material>               materials;
+    std::vector<Mesh>                   meshes;
+    std::vector<ModelLoader::Vertex>    vertices;
+    std::vector<ModelLoader::Index>     indices;
+};
+
+struct MeshCacheHeader
+{
+    CacheHeader header;
+    uint32_t    vertexCount;
+    uint32_t    indexCount;
+    uint32_t    meshCount;
+    uint32_t    materialCount;
+};
+
+// A material in a mesh cache file
+struct MeshCacheMaterial
+{
+    float       diffuseColor[3];
+    float       specularColor[3];
+    float       specularity;
+    uint32_t    diffuseMapPathLength;   // The paths follow the materials, each padded to a multiple of 8 bytes
+};
+
+struct TextureCacheHeader
+{
+    CacheHeader header;
+    int32_t     extentX;
+    int32_t     extentY;
+    uint32_t    mipCount;               // The offset of each mip (as uint64_t) follows, then the data
+    uint32_t    padding;
+    uint64_t    dataSize;
+};
+
+static size_t alignCacheSize(size_t size)
+{
+    return (size + 7) & ~size_t(7);
+}
+
+template<typename T>
+static void appendToCache(std::vector<unsigned char>& ioData, const T* values, size_t count)
+{
+    const size_t offset = ioData.size();
+    ioData.resize(alignCacheSize(offset + sizeof(T) * count));
+    if(count)
+        memcpy(ioData.data() + offset, values, sizeof(T) * count);
+}
+
+// Reads arrays from a cache file, checking that they are in bounds
+//
+struct CacheReader
+{
+    template<typename T>
+    const T* read(size_t count)
+    {
+        const size_t size = sizeof(T) * count;
+        if(size / sizeof(T) != count || size > end - offset)
+            return nullptr;
+
+        const T* values = (const T*)(data + offset);
+        offset = alignCacheSize(offset + size);
+        offset = offset < end ? offset : end;
+        return values;
+    }
+
+    const unsigned char*    data;
+    size_t                  offset;
+    size_t                  end;
+};
+
+static std::string getCachePath(char const* cacheDirectory, uint64_t key, char const* extension)
+{
+    char fileName[64];
+    snprintf(fileName, sizeof(fileName), "%016llx.%s", (unsigned long long)key, extension);
+    return std::string(cacheDirectory) + "/" + fileName;
+}
+
+static bool readMeshCache(const std::vector<unsigned char>& data, uint64_t key, LoadedModel& outModel)
+{
+    CacheReader reader = { data.data(), 0, data.size() };
+
+    auto header = reader.read<MeshCacheHeader>(1);
+    if(!header || header->header.fourCC != kMeshCacheFourCC || header->header.version != kCacheVersion || header->header.key != key)
+        return false;
+
+    auto vertices = reader.read<ModelLoader::Vertex>(header->vertexCount);
+    auto indices = reader.read<ModelLoader::Index>(header->indexCount);
+    auto meshes = reader.read<LoadedModel::Mesh>(header->meshCount);
+    auto materials = reader.read<MeshCacheMaterial>(header->materialCount);
+    if(!vertices || !indices || !meshes || !materials)
+        return false;
+
+    outModel.vertices.assign(vertices, vertices + header->vertexCount);
+    outModel.indices.assign(indices, indices + header->indexCount);
+    outModel.meshes.assign(meshes, meshes + header->meshCount);
+
+    outModel.materials.resize(header->materialCount);
+    for(uint32_t ii = 0; ii < header->materialCount; ++ii)
+    {
+        auto& cachedMaterial = materials[ii];
+        auto& material = outModel.materials[ii];
+
+        material.diffuseColor = glm::vec3(cachedMaterial.diffuseColor[0], cachedMaterial.diffuseColor[1], cachedMaterial.diffuseColor[2]);
+        material.specularColor = glm::vec3(cachedMaterial.specularColor[0], cachedMaterial.specularColor[1], cachedMaterial.specularColor[2]);
+        material.specularity = cachedMaterial.specularity;
+
+        auto path = reader.read<char>(cachedMaterial.diffuseMapPathLength);
+        if(!path)
+            return false;
+        material.diffuseMapPath.assign(path, cachedMaterial.diffuseMapPathLength);
     }
 
+    // The meshes index into the other arrays, so check them now, rather than trusting the file
+    for(auto& mesh : outModel.meshes)
+    {
+        if(mesh.firstIndex < 0 || mesh.indexCount < 0 || size_t(mesh.firstIndex) + mesh.indexCount > outModel.indices.size() ||
+            mesh.materialIndex < -1 || mesh.materialIndex >= int32_t(outModel.materials.size()))
+            return false;
+    }
+    for(auto index : outModel.indices)
+    {
+        if(index >= outModel.vertices.size())
+            return false;
+    }
+    return true;
+}
+
+static void writeMeshCache(const std::string& path, uint64_t key, const LoadedModel& model)
+{
+    MeshCacheHeader header = {};
+    header.header.fourCC = kMeshCacheFourCC;
+    header.header.version = kCacheVersion;
+    header.header.key = key;
+    header.vertexCount = uint32_t(model.vertices.size());
+    header.indexCount = uint32_t(model.indices.size());
+    header.meshCount = uint32_t(model.meshes.size());
+    header.materialCount = uint32_t(model.materials.size());
+
+    std::vector<MeshCacheMaterial> materials;
+    for(auto& material : model.materials)
+    {
+        MeshCacheMaterial cachedMaterial;
+        memcpy(cachedMaterial.diffuseColor, &material.diffuseColor[0], sizeof(cachedMaterial.diffuseColor));
+        memcpy(cachedMaterial.specularColor, &material.specularColor[0], sizeof(cachedMaterial.specularColor));
+        cachedMaterial.specularity = material.specularity;
+        cachedMaterial.diffuseMapPathLength = uint32_t(material.diffuseMapPath.size());
+        materials.push_back(cachedMaterial);
+    }
+
+    std::vector<unsigned char> data;
+    appendToCache(data, &header, 1);
+    appendToCache(data, model.vertices.data(), model.vertices.size());
+    appendToCache(data, model.indices.data(), model.indices.size());
+    appendToCache(data, model.meshes.data(), model.meshes.size());
+    appendToCache(data, materials.data(), materials.size());
+    for(auto& material : model.materials)
+    {
+        appendToCache(data, material.diffuseMapPath.data(), material.diffuseMapPath.size());
+    }
+
+    writeFile(path, data);
+}
+
+static bool readTextureCache(const std::vector<unsigned char>& data, uint64_t key, DecodedTextureImage& outImage)
+{
+    CacheReader reader = { data.data(), 0, data.size() };
+
+    auto header = reader.read<TextureCacheHeader>(1);
+    if(!header || header->header.fourCC != kTextureCacheFourCC || header->header.version != kCacheVersion || header->header.key != key)
+        return false;
+
+    auto mipOffsets = reader.read<uint64_t>(header->mipCount);
+    auto texels = reader.read<unsigned char>(size_t(header->dataSize));
+    if(!mipOffsets || !texels || header->mipCount == 0 || header->extentX <= 0 || header->extentY <= 0)
+        return false;
+
+    // Check the mips fit in the data
+    int mipExtentX = header->extentX;
+    int mipExtentY = header->extentY;
+    for(uint32_t ii = 0; ii < header->mipCount; ++ii)
+    {
+        const uint64_t mipSize = uint64_t(mipExtentX) * mipExtentY * kTextureChannelCount;
+        if(mipOffsets[ii] > header->dataSize || mipSize > header->dataSize - mipOffsets[ii])
+            return false;
+        mipExtentX = mipExtentX / 2 ? mipExtentX / 2 : 1;
+        mipExtentY = mipExtentY / 2 ? mipExtentY / 2 : 1;
+    }
+
+    outImage.extentX = header->extentX;
+    outImage.extentY = header->extentY;
+    outImage.mipOffsets.assign(mipOffsets, mipOffsets + header->mipCount);
+    outImage.data.assign(texels, texels + header->dataSize);
+    return true;
+}
+
+static void writeTextureCache(const std::string& path, uint64_t key, const DecodedTextureImage& image)
+{
+    TextureCacheHeader header = {};
+    header.header.fourCC = kTextureCacheFourCC;
+    header.header.version = kCacheVersion;
+    header.header.key = key;
+    header.extentX = image.extentX;
+    header.extentY = image.extentY;
+    header.mipCount = uint32_t(image.mipOffsets.size());
+    header.dataSize = image.data.size();
+
+    std::vector<uint64_t> mipOffsets(image.mipOffsets.begin(), image.mipOffsets.end());
+
+    std::vector<unsigned char> data;
+    appendToCache(data, &header, 1);
+    appendToCache(data, mipOffsets.data(), mipOffsets.size());
+    appendToCache(data, image.data.data(), image.data.size());
+
+    writeFile(path, data);
+}
+
+// Hash the contents of the OBJ file, and of the material libraries it references,
+// along with the options that change what is loaded from them.
+//
+static uint64_t calcMeshCacheKey(
+    const std::vector<unsigned char>&   objData,
+    const std::string&                  baseDir,
+    ModelLoader::LoadFlags              loadFlags,
+    float                               scale)
+{
+    uint64_t key = Slang::getHashCode64(objData.data(), objData.size());
+    key = Slang::combineHash64(key, loadFlags);
+
+    uint32_t scaleBits;
+    memcpy(&scaleBits, &scale, sizeof(scaleBits));
+    key = Slang::combineHash64(key, scaleBits);
+
+    // Material libraries are named on `mtllib` lines, relative to the OBJ file
+    const char* cursor = (const char*)objData.data();
+    const char* end = cursor + objData.size();
+    while(cursor < end)
+    {
+        const char* lineEnd = (const char*)memchr(cursor, '\n', size_t(end - cursor));
+        if(!lineEnd)
+            lineEnd = end;
+
+        static const char kMtlLib[] = "mtllib ";
+        const size_t mtlLibLength = sizeof(kMtlLib) - 1;
+        if(size_t(lineEnd - cursor) > mtlLibLength && memcmp(cursor, kMtlLib, mtlLibLength) == 0)
+        {
+            std::string name = makeString(cursor + mtlLibLength, lineEnd);
+            while(name.size() && (name.back() == '\r' || name.back() == ' ' || name.back() == '\t'))
+                name.pop_back();
+
+            std::vector<unsigned char> mtlData;
+            std::string mtlPath = baseDir.size() ? baseDir + "/" + name : name;
+            if(readFile(mtlPath.c_str(), mtlData))
+            {
+                key = Slang::combineHash64(key, Slang::getHashCode64(mtlData.data(), mtlData.size()));
+            }
+        }
+        cursor = lineEnd + 1;
+    }
+    return key;
+}
+
+// Loads a texture for a material, from the cache if it's there, otherwise decoding
+// it (and adding it to the cache). These are run on a thread pool.
+//
+struct TextureLoadJob : Slang::ThreadPoolJob
+{
+    void execute() override
+    {
+        std::vector<unsigned char> fileData;
+        if(!readFile(path.c_str(), fileData))
+        {
+            log("failed to load texture '%s'\n", path.c_str());
+            return;
+        }
+
+        uint64_t key = 0;
+        std::string cachePath;
+        if(cacheDirectory)
+        {
+            key = Slang::getHashCode64(fileData.data(), fileData.size());
+            cachePath = getCachePath(cacheDirectory, key, "tex");
+
+            // The cached image only has its first mip if the mips were generated on the GPU
+            std::vector<unsigned char> cacheData;
+            if(readFile(cachePath.c_str(), cacheData) && readTextureCache(cacheData, key, image))
+            {
+                if(generateMips && image.mipOffsets.size() == 1)
+                {
+                    generateTextureMips(image);
+                }
+                isLoaded = true;
+                return;
+            }
+        }
+
+        isLoaded = decodeTextureImage(path.c_str(), image);
+        if(!isLoaded)
+            return;
+
+        if(generateMips)
+        {
+            generateTextureMips(image);
+        }
+        if(cacheDirectory)
+        {
+            writeTextureCache(cachePath, key, image);
+        }
+    }
+
+    std::string             path;
+    char const*             cacheDirectory = nullptr;
+    bool                    generateMips = true;    // False if they are generated on the GPU
+    DecodedTextureImage     image;
+    bool                    isLoaded = false;
+};
+
+static Result loadObj(
+    char const*             inputPath,
+    std::string const&      baseDir,
+    ModelLoader::LoadFlags  loadFlags,
+    float                   scale,
+    LoadedModel&            outModel)
+{
+    typedef ModelLoader::LoadFlag LoadFlag;
+    typedef ModelLoader::Vertex Vertex;
+    typedef ModelLoader::Index Index;
+
+    tinyobj::attrib_t objVertexAttributes;
+    std::vector<tinyobj::shape_t> objShapes;
+    std::vector<tinyobj::material_t> objMaterials;
+
     std::string diagnostics;
     bool shouldTriangulate = true;
     bool success = tinyobj::LoadObj(
@@ -239,33 +708,26 @@ Result ModelLoader::load(
     // Translate each material imported by TinyObj into a format that
     // we can actually use for rendering.
     //
-    std::vector<void*> materials;
     for(auto& objMaterial : objMaterials)
     {
-        MaterialData materialData;
+        LoadedModel::Material material;
 
-        materialData.diffuseColor = glm::vec3(
+        material.diffuseColor = glm::vec3(
             objMaterial.diffuse[0],
             objMaterial.diffuse[1],
             objMaterial.diffuse[2]);
 
-        materialData.specularColor = glm::vec3(
+        material.specularColor = glm::vec3(
             objMaterial.specular[0],
             objMaterial.specular[1],
             objMaterial.specular[2]);
 
-        materialData.specularity = objMaterial.shininess;
+        material.specularity = objMaterial.shininess;
 
-        // load any referenced textures here
-        if(objMaterial.diffuse_texname.length())
-        {
-            materialData.diffuseMap = loadTextureImage(
-                renderer,
-                objMaterial.diffuse_texname.c_str());
-        }
+        // Any referenced textures are loaded once all the materials are known
+        material.diffuseMapPath = objMaterial.diffuse_texname;
 
-        auto material = callbacks->createMaterial(materialData);
-        materials.push_back(material);
+        outModel.materials.push_back(material);
     }
 
     // Flip the winding order on all faces if we are asked to...
@@ -426,15 +888,10 @@ Result ModelLoader::load(
     // standard position/normal/etc. data in a single flat array
 
     std::unordered_map<ObjIndexKey, Index> mapObjIndexToFlatIndex;
-    std::vector<Vertex> flatVertices;
-    std::vector<Index> flatIndices;
+    std::vector<Vertex>& flatVertices = outModel.vertices;
+    std::vector<Index>& flatIndices = outModel.indices;
 
-    MeshData* currentMesh = nullptr;
-    MeshData currentMeshStorage;
-
-    std::vector<void*> meshes;
-
-    void* defaultMaterial = nullptr;
+    LoadedModel::Mesh* currentMesh = nullptr;
 
     for(auto& objShape : objShapes)
     {
@@ -444,35 +901,20 @@ Result ModelLoader::load(
         {
             size_t objFaceIndex = objFaceCounter++;
             int faceMaterialID = objShape.mesh.material_ids[objFaceIndex];
-            void* faceMaterial = nullptr;
             if( faceMaterialID < 0 )
             {
-                if( !defaultMaterial )
-                {
-                    MaterialData defaultMaterialData;
-                    defaultMaterialData.diffuseColor = glm::vec3(0.5, 0.5, 0.5);
-                    defaultMaterial = callbacks->createMaterial(defaultMaterialData);
-                }
-                faceMaterial = defaultMaterial;
-            }
-            else
-            {
-                faceMaterial = materials[faceMaterialID];
+                faceMaterialID = -1;
             }
 
-            if(!currentMesh || (faceMaterial != currentMesh->material))
+            if(!currentMesh || (faceMaterialID != currentMesh->materialIndex))
             {
-                // finish old mesh.
-                if(currentMesh)
-                {
-                    meshes.push_back(callbacks->createMesh(*currentMesh));
-                }
-
                 // Need to start a new mesh.
-                currentMesh = &currentMeshStorage;
-                currentMesh->material = faceMaterial;
-                currentMesh->firstIndex = (int)flatIndices.size();
-                currentMesh->indexCount = 0;
+                LoadedModel::Mesh mesh;
+                mesh.materialIndex = faceMaterialID;
+                mesh.firstIndex = (int)flatIndices.size();
+                mesh.indexCount = 0;
+                outModel.meshes.push_back(mesh);
+                currentMesh = &outModel.meshes.back();
             }
 
             for(size_t objFaceVertex = 0; objFaceVertex < objFaceVertexCount; ++objFaceVertex)
@@ -522,11 +964,162 @@ Result ModelLoader::load(
         }
     }
 
-    // finish last mesh.
-    if(currentMesh)
+    return SLANG_OK;
+}
+
+Result ModelLoader::load(
+    char const* inputPath,
+    void**      outModel)
+{
+    std::string baseDir;
+    if( auto lastSlash = strrchr(inputPath, '/') )
+    {
+        baseDir = makeString(inputPath, lastSlash);
+    }
+
+    // Use the cached copy of the mesh if there is one, rather than parsing the OBJ file.
+    //
+    LoadedModel loadedModel;
+    {
+        bool isCached = false;
+        uint64_t key = 0;
+        std::string cachePath;
+        if(cacheDirectory)
+        {
+            std::vector<unsigned char> objData;
+            if(!readFile(inputPath, objData))
+            {
+                log("failed to read '%s'\n", inputPath);
+                return SLANG_FAIL;
+            }
+
+            key = calcMeshCacheKey(objData, baseDir, loadFlags, scale);
+            cachePath = getCachePath(cacheDirectory, key, "mesh");
+
+            std::vector<unsigned char> cacheData;
+            isCached = readFile(cachePath.c_str(), cacheData) && readMeshCache(cacheData, key, loadedModel);
+            if(!isCached)
+            {
+                // Anything partly read is discarded
+                loadedModel = LoadedModel();
+            }
+        }
+
+        if(!isCached)
+        {
+            SLANG_RETURN_ON_FAIL(loadObj(inputPath, baseDir, loadFlags, scale, loadedModel));
+            if(cacheDirectory)
+            {
+                Slang::Path::createDirectory(cacheDirectory);
+                writeMeshCache(cachePath, key, loadedModel);
+            }
+        }
+    }
+
+    // Load the textures the materials reference, each only once. Reading a texture from
+    // the cache, or decoding it and generating its mips, is done on a thread pool, but the
+    // textures are created here, as the renderer is only used on this thread. If the
+    // renderer can, the mips are generated on the GPU instead.
+    //
+    std::unordered_map<std::string, size_t> mapPathToTextureJob;
+    std::vector<TextureLoadJob> textureJobs;
+    for(auto& material : loadedModel.materials)
     {
-        meshes.push_back(callbacks->createMesh(*currentMesh));
+        if(material.diffuseMapPath.length() && mapPathToTextureJob.find(material.diffuseMapPath) == mapPathToTextureJob.end())
+        {
+            mapPathToTextureJob.insert(std::make_pair(material.diffuseMapPath, textureJobs.size()));
+            textureJobs.emplace_back();
+            textureJobs.back().path = material.diffuseMapPath;
+            textureJobs.back().cacheDirectory = cacheDirectory;
+        }
     }
+    RefPtr<MipGenerator> mipGenerator;
+    if(textureJobs.size())
+    {
+        if(MipGenerator::isSupported(renderer))
+        {
+            mipGenerator = new MipGenerator;
+            if(SLANG_FAILED(mipGenerator->init(renderer)))
+            {
+                mipGenerator = nullptr;
+            }
+        }
+        for(auto& job : textureJobs)
+        {
+            job.generateMips = !mipGenerator;
+        }
+
+        if(cacheDirectory)
+        {
+            Slang::Path::createDirectory(cacheDirectory);
+        }
+
+        // There is no point having more threads than textures
+        Slang::Index jobThreadCount = threadCount > 0 ? threadCount : Slang::ThreadPool::getDefaultThreadCount();
+        jobThreadCount = Slang::Math::Min(jobThreadCount, Slang::Index(textureJobs.size()));
+
+        Slang::ThreadPool threadPool(jobThreadCount);
+        for(auto& job : textureJobs)
+        {
+            threadPool.submit(&job);
+        }
+        threadPool.waitForAll();
+    }
+
+    std::vector<RefPtr<TextureResource>> textures;
+    for(auto& job : textureJobs)
+    {
+        textures.push_back(job.isLoaded ? createTexture(renderer, job.image, mipGenerator) : nullptr);
+
+        // The decoded image isn't needed once the texture has been made
+        job.image = DecodedTextureImage();
+    }
+
+    // Now all the renderer objects can be created, in the order they were loaded.
+    //
+    std::vector<void*> materials;
+    for(auto& material : loadedModel.materials)
+    {
+        MaterialData materialData;
+        materialData.diffuseColor = material.diffuseColor;
+        materialData.specularColor = material.specularColor;
+        materialData.specularity = material.specularity;
+        if(material.diffuseMapPath.length())
+        {
+            materialData.diffuseMap = textures[mapPathToTextureJob[material.diffuseMapPath]];
+        }
+
+        materials.push_back(callbacks->createMaterial(materialData));
+    }
+
+    void* defaultMaterial = nullptr;
+    std::vector<void*> meshes;
+    for(auto& loadedMesh : loadedModel.meshes)
+    {
+        MeshData meshData;
+        meshData.firstIndex = loadedMesh.firstIndex;
+        meshData.indexCount = loadedMesh.indexCount;
+
+        if(loadedMesh.materialIndex < 0)
+        {
+            if( !defaultMaterial )
+            {
+                MaterialData defaultMaterialData;
+                defaultMaterialData.diffuseColor = glm::vec3(0.5, 0.5, 0.5);
+                defaultMaterial = callbacks->createMaterial(defaultMaterialData);
+            }
+            meshData.material = defaultMaterial;
+        }
+        else
+        {
+            meshData.material = materials[loadedMesh.materialIndex];
+        }
+
+        meshes.push_back(callbacks->createMesh(meshData));
+    }
+
+    std::vector<Vertex>& flatVertices = loadedModel.vertices;
+    std::vector<Index>& flatIndices = loadedModel.indices;
 
     ModelData modelData;
 
@@ -70,6 +70,12 @@ struct ModelLoader
     LoadFlags           loadFlags = 0;
     float               scale = 1.0f;
 
+        /// Directory for binary copies of loaded meshes and decoded textures, named by a hash of the files they
+        /// were made from, so later loads don't have to parse or decode them. Null to not cache.
+    char const*         cacheDirectory = nullptr;
+        /// Number of threads textures are decoded on. 0 for the default for the machine.
+    int                 threadCount = 0;
+
     Result load(char const* inputPath, void** outModel);
 };
 
@@ -6,6 +6,7 @@
 
 //WORKING: #include "options.h"
 #include "render.h"
+#include "render-object-cache.h"
 #include "d3d-util.h"
 
 #include "surface.h"
@@ -50,6 +51,9 @@ public:
     {
         kMaxUAVs = 64,
         kMaxRTVs = 8,
+        kMaxConstantBuffers = D3D11_COMMONSHADER_CONSTANT_BUFFER_API_SLOT_COUNT,
+        kConstantRingSize = 4 * 1024 * 1024,                ///< Size of the ring constant buffers are written to with WriteDiscard maps
+        kConstantRingAlignment = 256,                       ///< Offsets must be a multiple of 16 constants (of 16 bytes)
     };
 
     // Renderer    implementation
@@ -93,9 +97,15 @@ public:
     virtual void setPipelineState(PipelineType pipelineType, PipelineState* state) override;
     virtual void draw(UInt vertexCount, UInt startVertex) override;
     virtual void drawIndexed(UInt indexCount, UInt startIndex, UInt baseVertex) override;
+    virtual void drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance) override;
     virtual void dispatchCompute(int x, int y, int z) override;
     virtual void submitGpuWork() override {}
     virtual void waitForGpu() override {}
+    virtual Result writeTimestamp(UInt index) override;
+    virtual Result getTimestamps(UInt index, UInt count, uint64_t* outTimestamps) override;
+    virtual uint64_t getTimestampFrequency() override { return m_timestampFrequency; }
+    virtual Result createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer) override;
+    virtual void submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers) override;
     virtual RendererType getRendererType() const override { return RendererType::DirectX11; }
 
     ~D3D11Renderer() {}
@@ -163,6 +173,29 @@ public:
         UINT                        m_uavCount;
     };
 
+    class BufferResourceImpl: public BufferResource
+    {
+		public:
+        typedef BufferResource Parent;
+
+        BufferResourceImpl(const Desc& desc, Usage initialUsage):
+            Parent(desc),
+            m_initialUsage(initialUsage)
+        {
+        }
+
+        MapFlavor m_mapFlavor;
+        Usage m_initialUsage;
+        ComPtr<ID3D11Buffer> m_buffer;
+        ComPtr<ID3D11Buffer> m_staging;
+        ID3D11Buffer* m_mappedBuffer = nullptr;     ///< The buffer map mapped, for unmap
+
+        // After a WriteDiscard map of a constant buffer when the renderer has a constant ring, the contents are in the
+        // ring rather than m_buffer, and are bound at an offset
+        UINT m_ringFirstConstant = 0;
+        UINT m_ringConstantCount = 0;               ///< 0 if the contents are in m_buffer
+    };
+
     class DescriptorSetImpl : public DescriptorSet
     {
     public:
@@ -177,7 +210,7 @@ public:
 
         RefPtr<DescriptorSetLayoutImpl>         m_layout;
 
-        List<ComPtr<ID3D11Buffer>>              m_cbs;
+        List<RefPtr<BufferResourceImpl>>        m_cbs;
         List<ComPtr<ID3D11ShaderResourceView>>  m_srvs;
         List<ComPtr<ID3D11UnorderedAccessView>> m_uavs;
         List<ComPtr<ID3D11SamplerState>>        m_samplers;
@@ -191,22 +224,6 @@ public:
         ComPtr<ID3D11ComputeShader> m_computeShader;
     };
 
-    class BufferResourceImpl: public BufferResource
-    {
-		public:
-        typedef BufferResource Parent;
-
-        BufferResourceImpl(const Desc& desc, Usage initialUsage):
-            Parent(desc),
-            m_initialUsage(initialUsage)
-        {
-        }
-
-        MapFlavor m_mapFlavor;
-        Usage m_initialUsage;
-        ComPtr<ID3D11Buffer> m_buffer;
-        ComPtr<ID3D11Buffer> m_staging;
-    };
     class TextureResourceImpl : public TextureResource
     {
     public:
@@ -300,12 +317,54 @@ public:
     public:
     };
 
+        /// Records compute work on a deferred context, so command buffers can be recorded on different threads. The
+        /// command list it makes is executed on the immediate context by submitCommandBuffers.
+        ///
+        /// Constant buffers written with WriteDiscard maps are bound at their place in the constant ring when recorded, so
+        /// a command buffer must be submitted before the buffers it uses are mapped again.
+    class CommandBufferImpl : public CommandBuffer
+    {
+    public:
+        virtual Result begin() override;
+        virtual void setPipelineState(PipelineState* state) override;
+        virtual void setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet) override;
+        virtual void dispatchCompute(int x, int y, int z) override;
+        virtual void writeTimestamp(UInt index) override;
+        virtual Result end() override;
+
+        D3D11Renderer* m_renderer = nullptr;                ///< Weak pointer - the renderer must outlive the command buffer
+        ComPtr<ID3D11DeviceContext> m_context;              ///< Deferred
+        ComPtr<ID3D11DeviceContext1> m_context1;            ///< Set if the renderer binds constant buffers at offsets
+        ComPtr<ID3D11CommandList> m_commandList;            ///< Set by end
+
+        RefPtr<ComputePipelineStateImpl> m_pipelineState;
+        RefPtr<BufferResourceImpl> m_constantBufferBindings[kMaxConstantBuffers];
+        UInt m_constantBufferBindingCount = 0;
+        ComPtr<ID3D11UnorderedAccessView> m_uavBindings[kMaxUAVs];
+
+        ComPtr<ID3D11Query> m_timestampQueries[kMaxTimestampCount];     ///< Created the first time each index is written
+        List<UInt> m_timestampIndices;                      ///< The indices written by the recorded commands
+        Result m_result = SLANG_OK;                         ///< The first failure while recording
+    };
+
         /// Capture a texture to a file
     static HRESULT captureTextureToSurface(ID3D11Device* device, ID3D11DeviceContext* context, ID3D11Texture2D* texture, Surface& surfaceOut);
 
     void _flushGraphicsState();
     void _flushComputeState();
 
+        /// Set the shader resource views and samplers of a descriptor set on context, and copy its constant buffers and
+        /// UAVs to the bindings, which are set just before a draw or dispatch. For compute the UAVs are also set first.
+    static void _setDescriptorSet(ID3D11DeviceContext* context, PipelineType pipelineType, PipelineLayoutImpl* pipelineLayout, UInt index, DescriptorSetImpl* descriptorSet,
+        RefPtr<BufferResourceImpl>* ioConstantBufferBindings, UInt& ioConstantBufferBindingCount, ComPtr<ID3D11UnorderedAccessView>* ioUavBindings);
+        /// Set the constant buffers of the stages of pipelineType on context, from wherever each buffer's contents are
+    void _setConstantBuffers(ID3D11DeviceContext* context, ID3D11DeviceContext1* context1, PipelineType pipelineType, UInt count, const RefPtr<BufferResourceImpl>* buffers) const;
+        /// Map the constant ring, for a WriteDiscard map of buffer. Returns nullptr if buffer can't be placed in the ring.
+    void* _mapConstantRing(BufferResourceImpl* buffer);
+
+        /// Wait for the result of the disjoint query, which has to have been ended
+    Result _getTimestampDisjointData(D3D11_QUERY_DATA_TIMESTAMP_DISJOINT& outData);
+
     ComPtr<IDXGISwapChain> m_swapChain;
     ComPtr<ID3D11Device> m_device;
     ComPtr<ID3D11DeviceContext> m_immediateContext;
@@ -327,11 +386,32 @@ public:
     ComPtr<ID3D11UnorderedAccessView>   m_uavBindings[int(PipelineType::CountOf)][kMaxUAVs];
     bool m_targetBindingsDirty[int(PipelineType::CountOf)];
 
+    // Constant buffers are set just before a draw or dispatch, as a WriteDiscard map can move their contents in the ring
+    RefPtr<BufferResourceImpl>  m_constantBufferBindings[int(PipelineType::CountOf)][kMaxConstantBuffers];
+    UInt                        m_constantBufferBindingCounts[int(PipelineType::CountOf)] = {};
+    bool                        m_constantBufferBindingsDirty[int(PipelineType::CountOf)] = {};
+
+    // Where constant buffers can be bound at offsets (D3D11.1), WriteDiscard maps write to successive ranges of one large
+    // dynamic buffer mapped with NO_OVERWRITE, rather than renaming the whole of each constant buffer. The ring is only
+    // mapped with DISCARD when it wraps.
+    ComPtr<ID3D11DeviceContext1>    m_immediateContext1;
+    ComPtr<ID3D11Buffer>            m_constantRing;             ///< Null if constant buffers can't be bound at offsets
+    UINT                            m_constantRingOffset = kConstantRingSize;   ///< Next free byte. Starts full, so the first map discards.
+
+    // Timestamps are only meaningful between the Begin and End of a disjoint query, which also gives their frequency.
+    // The disjoint query is begun by the first timestamp written after results were last read.
+    ComPtr<ID3D11Query>     m_timestampDisjointQuery;
+    ComPtr<ID3D11Query>     m_timestampQueries[kMaxTimestampCount];    ///< Created the first time each index is written
+    bool                    m_timestampDisjointActive = false;
+    uint64_t                m_timestampFrequency = 0;               ///< 0 if timestamps aren't supported
+
     Desc m_desc;
 
     float m_clearColor[4] = { 0, 0, 0, 0 };
 
     List<String> m_features;
+
+    RenderObjectCache m_objectCache;                ///< Sampler states and layouts, shared by the creates with the same desc
 };
 
 Renderer* createD3D11Renderer()
@@ -526,6 +606,42 @@ SlangResult D3D11Renderer::initialize(const Desc& desc, void* inWindowHandle)
         SLANG_ASSERT(m_immediateContext && m_swapChain && m_device);
     }
 
+    // The timestamp frequency is only available from a disjoint query, so get it now, as it's needed before any timestamps are written
+    {
+        D3D11_QUERY_DESC queryDesc = {};
+        queryDesc.Query = D3D11_QUERY_TIMESTAMP_DISJOINT;
+        if (SLANG_SUCCEEDED(m_device->CreateQuery(&queryDesc, m_timestampDisjointQuery.writeRef())))
+        {
+            m_immediateContext->Begin(m_timestampDisjointQuery);
+            m_immediateContext->End(m_timestampDisjointQuery);
+
+            D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+            if (SLANG_SUCCEEDED(_getTimestampDisjointData(disjointData)))
+            {
+                m_timestampFrequency = disjointData.Frequency;
+            }
+        }
+    }
+
+    // Use a constant ring if constant buffers can be bound at offsets, and the ring mapped with NO_OVERWRITE
+    {
+        D3D11_FEATURE_DATA_D3D11_OPTIONS options = {};
+        if (SLANG_SUCCEEDED(m_immediateContext->QueryInterface(IID_PPV_ARGS(m_immediateContext1.writeRef()))) &&
+            SLANG_SUCCEEDED(m_device->CheckFeatureSupport(D3D11_FEATURE_D3D11_OPTIONS, &options, sizeof(options))) &&
+            options.ConstantBufferOffsetting && options.MapNoOverwriteOnDynamicConstantBuffer)
+        {
+            D3D11_BUFFER_DESC ringDesc = {};
+            ringDesc.ByteWidth = kConstantRingSize;
+            ringDesc.Usage = D3D11_USAGE_DYNAMIC;
+            ringDesc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+            ringDesc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+            if (SLANG_FAILED(m_device->CreateBuffer(&ringDesc, nullptr, m_constantRing.writeRef())))
+            {
+                m_constantRing.setNull();
+            }
+        }
+    }
+
     // TODO: Add support for debugging to help detect leaks:
     //
     //      ComPtr<ID3D11Debug> gDebug;
@@ -708,8 +824,9 @@ Result D3D11Renderer::createTextureResource(Resource::Usage initialUsage, const
 
                     data.pSysMem = initData->subResources[subResourceIndex];
 
+                    // A row of a block compressed format is a row of blocks
                     data.SysMemPitch = UINT(initData->mipRowStrides[j]);
-                    data.SysMemSlicePitch = UINT(initData->mipRowStrides[j] * mipHeight);
+                    data.SysMemSlicePitch = UINT(initData->mipRowStrides[j] * Surface::calcNumRows(srcDesc.format, mipHeight));
 
                     subResourceIndex++;
                 }
@@ -962,6 +1079,12 @@ static D3D11_COMPARISON_FUNC translateComparisonFunc(ComparisonFunc func)
 
 Result D3D11Renderer::createSamplerState(SamplerState::Desc const& desc, SamplerState** outSampler)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getSamplerStateKey(desc);
+    if (m_objectCache.find(key, outSampler))
+    {
+        return SLANG_OK;
+    }
+
     D3D11_FILTER_REDUCTION_TYPE dxReduction = translateFilterReduction(desc.reductionOp);
     D3D11_FILTER dxFilter;
     if (desc.maxAnisotropy > 1)
@@ -997,6 +1120,7 @@ Result D3D11Renderer::createSamplerState(SamplerState::Desc const& desc, Sampler
 
     RefPtr<SamplerStateImpl> samplerImpl = new SamplerStateImpl();
     samplerImpl->m_sampler = sampler;
+    m_objectCache.add(key, samplerImpl);
     *outSampler = samplerImpl.detach();
     return SLANG_OK;
 }
@@ -1005,6 +1129,17 @@ Result D3D11Renderer::createTextureView(TextureResource* texture, ResourceView::
 {
     auto resourceImpl = (TextureResourceImpl*) texture;
 
+    // A view of all of the mips is created without a view desc. Only non array 2D textures can have a view of some of them.
+    const bool isMipRange = desc.mipLevel != 0 || desc.mipLevelCount != 0;
+    if (isMipRange)
+    {
+        const TextureResource::Desc& textureDesc = resourceImpl->getDesc();
+        if (resourceImpl->getType() != Resource::Type::Texture2D || textureDesc.arraySize > 1 || textureDesc.sampleDesc.numSamples > 1)
+        {
+            return SLANG_E_NOT_IMPLEMENTED;
+        }
+    }
+
     switch (desc.type)
     {
     default:
@@ -1038,8 +1173,13 @@ Result D3D11Renderer::createTextureView(TextureResource* texture, ResourceView::
 
     case ResourceView::Type::UnorderedAccess:
         {
+            D3D11_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+            uavDesc.Format = D3DUtil::getMapFormat(resourceImpl->getDesc().format);
+            uavDesc.ViewDimension = D3D11_UAV_DIMENSION_TEXTURE2D;
+            uavDesc.Texture2D.MipSlice = UINT(desc.mipLevel);
+
             ComPtr<ID3D11UnorderedAccessView> uav;
-            SLANG_RETURN_ON_FAIL(m_device->CreateUnorderedAccessView(resourceImpl->m_resource, nullptr, uav.writeRef()));
+            SLANG_RETURN_ON_FAIL(m_device->CreateUnorderedAccessView(resourceImpl->m_resource, isMipRange ? &uavDesc : nullptr, uav.writeRef()));
 
             RefPtr<UnorderedAccessViewImpl> viewImpl = new UnorderedAccessViewImpl();
             viewImpl->m_type = ResourceViewImpl::Type::UAV;
@@ -1051,8 +1191,14 @@ Result D3D11Renderer::createTextureView(TextureResource* texture, ResourceView::
 
     case ResourceView::Type::ShaderResource:
         {
+            D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+            srvDesc.Format = D3DUtil::calcFormat(D3DUtil::USAGE_SRV, D3DUtil::getMapFormat(resourceImpl->getDesc().format));
+            srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
+            srvDesc.Texture2D.MostDetailedMip = UINT(desc.mipLevel);
+            srvDesc.Texture2D.MipLevels = desc.mipLevelCount ? UINT(desc.mipLevelCount) : UINT(-1);
+
             ComPtr<ID3D11ShaderResourceView> srv;
-            SLANG_RETURN_ON_FAIL(m_device->CreateShaderResourceView(resourceImpl->m_resource, nullptr, srv.writeRef()));
+            SLANG_RETURN_ON_FAIL(m_device->CreateShaderResourceView(resourceImpl->m_resource, isMipRange ? &srvDesc : nullptr, srv.writeRef()));
 
             RefPtr<ShaderResourceViewImpl> viewImpl = new ShaderResourceViewImpl();
             viewImpl->m_type = ResourceViewImpl::Type::SRV;
@@ -1156,6 +1302,12 @@ Result D3D11Renderer::createBufferView(BufferResource* buffer, ResourceView::Des
 
 Result D3D11Renderer::createInputLayout(const InputElementDesc* inputElementsIn, UInt inputElementCount, InputLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getInputLayoutKey(inputElementsIn, inputElementCount);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     D3D11_INPUT_ELEMENT_DESC inputElements[16] = {};
 
     char hlslBuffer[1024];
@@ -1217,14 +1369,59 @@ Result D3D11Renderer::createInputLayout(const InputElementDesc* inputElementsIn,
     RefPtr<InputLayoutImpl> impl = new InputLayoutImpl;
     impl->m_layout.swap(inputLayout);
 
+    m_objectCache.add(key, impl);
+
     *outLayout = impl.detach();
     return SLANG_OK;
 }
 
+void* D3D11Renderer::_mapConstantRing(BufferResourceImpl* buffer)
+{
+    const UINT size = UINT(D3DUtil::calcAligned(buffer->getDesc().sizeInBytes, kConstantRingAlignment));
+    if (size > D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT * 16)
+    {
+        // Too large to bind at an offset
+        return nullptr;
+    }
+
+    // Ranges written since the last discard may still be in use by the GPU, so are never overwritten
+    D3D11_MAP mapType = D3D11_MAP_WRITE_NO_OVERWRITE;
+    if (m_constantRingOffset + size > kConstantRingSize)
+    {
+        mapType = D3D11_MAP_WRITE_DISCARD;
+        m_constantRingOffset = 0;
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mappedSub;
+    SLANG_RETURN_NULL_ON_FAIL(m_immediateContext->Map(m_constantRing, 0, mapType, 0, &mappedSub));
+
+    buffer->m_ringFirstConstant = m_constantRingOffset / 16;
+    buffer->m_ringConstantCount = size / 16;
+    buffer->m_mappedBuffer = m_constantRing;
+    m_constantRingOffset += size;
+
+    // The buffer may be bound, at its old place
+    for (auto& isDirty : m_constantBufferBindingsDirty)
+    {
+        isDirty = true;
+    }
+
+    return (uint8_t*)mappedSub.pData + buffer->m_ringFirstConstant * 16;
+}
+
 void* D3D11Renderer::map(BufferResource* bufferIn, MapFlavor flavor)
 {
     BufferResourceImpl* bufferResource = static_cast<BufferResourceImpl*>(bufferIn);
 
+    if (flavor == MapFlavor::WriteDiscard && m_constantRing && (bufferResource->getDesc().bindFlags & Resource::BindFlag::ConstantBuffer))
+    {
+        if (void* data = _mapConstantRing(bufferResource))
+        {
+            bufferResource->m_mapFlavor = flavor;
+            return data;
+        }
+    }
+
     D3D11_MAP mapType;
     ID3D11Buffer* buffer = bufferResource->m_buffer;
 
@@ -1260,6 +1457,17 @@ void* D3D11Renderer::map(BufferResource* bufferIn, MapFlavor flavor)
     SLANG_RETURN_NULL_ON_FAIL(m_immediateContext->Map(buffer, 0, mapType, 0, &mappedSub));
 
     bufferResource->m_mapFlavor = flavor;
+    bufferResource->m_mappedBuffer = buffer;
+
+    if (flavor != MapFlavor::HostRead && bufferResource->m_ringConstantCount)
+    {
+        // The contents are back in the buffer itself
+        bufferResource->m_ringConstantCount = 0;
+        for (auto& isDirty : m_constantBufferBindingsDirty)
+        {
+            isDirty = true;
+        }
+    }
 
     return mappedSub.pData;
 }
@@ -1267,8 +1475,8 @@ void* D3D11Renderer::map(BufferResource* bufferIn, MapFlavor flavor)
 void D3D11Renderer::unmap(BufferResource* bufferIn)
 {
     BufferResourceImpl* bufferResource = static_cast<BufferResourceImpl*>(bufferIn);
-    ID3D11Buffer* buffer = (bufferResource->m_mapFlavor == MapFlavor::HostRead) ? bufferResource->m_staging : bufferResource->m_buffer;
-    m_immediateContext->Unmap(buffer, 0);
+    m_immediateContext->Unmap(bufferResource->m_mappedBuffer, 0);
+    bufferResource->m_mappedBuffer = nullptr;
 }
 
 #if 0
@@ -1439,6 +1647,12 @@ void D3D11Renderer::drawIndexed(UInt indexCount, UInt startIndex, UInt baseVerte
     m_immediateContext->DrawIndexed((UINT)indexCount, (UINT)startIndex, (INT)baseVertex);
 }
 
+void D3D11Renderer::drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance)
+{
+    _flushGraphicsState();
+    m_immediateContext->DrawIndexedInstanced((UINT)indexCount, (UINT)instanceCount, (UINT)startIndex, (INT)baseVertex, (UINT)startInstance);
+}
+
 Result D3D11Renderer::createProgram(const ShaderProgram::Desc& desc, ShaderProgram** outProgram)
 {
     if (desc.pipelineType == PipelineType::Compute)
@@ -1749,8 +1963,155 @@ void D3D11Renderer::dispatchCompute(int x, int y, int z)
     m_immediateContext->Dispatch(x, y, z);
 }
 
+Result D3D11Renderer::createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer)
+{
+    // There is only the immediate context to submit to, so all queue types are the same
+    SLANG_UNUSED(queueType);
+
+    RefPtr<CommandBufferImpl> commandBuffer = new CommandBufferImpl();
+    commandBuffer->m_renderer = this;
+
+    SLANG_RETURN_ON_FAIL(m_device->CreateDeferredContext(0, commandBuffer->m_context.writeRef()));
+    if (m_constantRing)
+    {
+        SLANG_RETURN_ON_FAIL(commandBuffer->m_context->QueryInterface(IID_PPV_ARGS(commandBuffer->m_context1.writeRef())));
+    }
+
+    *outCommandBuffer = commandBuffer.detach();
+    return SLANG_OK;
+}
+
+void D3D11Renderer::submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers)
+{
+    for (UInt i = 0; i < count; ++i)
+    {
+        auto commandBuffer = static_cast<CommandBufferImpl*>(commandBuffers[i]);
+        if (!commandBuffer->m_commandList)
+        {
+            continue;
+        }
+
+        if (commandBuffer->m_timestampIndices.getCount() && !m_timestampDisjointActive)
+        {
+            m_immediateContext->Begin(m_timestampDisjointQuery);
+            m_timestampDisjointActive = true;
+        }
+
+        // Keep the immediate context state, as the renderer's bindings are only set when they change
+        m_immediateContext->ExecuteCommandList(commandBuffer->m_commandList, TRUE);
+
+        // getTimestamps reads the queries last written to each index
+        for (UInt index : commandBuffer->m_timestampIndices)
+        {
+            m_timestampQueries[index] = commandBuffer->m_timestampQueries[index];
+        }
+    }
+}
+
+Result D3D11Renderer::_getTimestampDisjointData(D3D11_QUERY_DATA_TIMESTAMP_DISJOINT& outData)
+{
+    for (;;)
+    {
+        const HRESULT res = m_immediateContext->GetData(m_timestampDisjointQuery, &outData, sizeof(outData), 0);
+        if (res == S_OK)
+        {
+            return SLANG_OK;
+        }
+        if (res != S_FALSE)
+        {
+            return res;
+        }
+    }
+}
+
+Result D3D11Renderer::writeTimestamp(UInt index)
+{
+    if (m_timestampFrequency == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (index >= kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    ComPtr<ID3D11Query>& query = m_timestampQueries[index];
+    if (!query)
+    {
+        D3D11_QUERY_DESC queryDesc = {};
+        queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+        SLANG_RETURN_ON_FAIL(m_device->CreateQuery(&queryDesc, query.writeRef()));
+    }
+
+    if (!m_timestampDisjointActive)
+    {
+        m_immediateContext->Begin(m_timestampDisjointQuery);
+        m_timestampDisjointActive = true;
+    }
+    // Timestamp queries only have an End
+    m_immediateContext->End(query);
+    return SLANG_OK;
+}
+
+Result D3D11Renderer::getTimestamps(UInt index, UInt count, uint64_t* outTimestamps)
+{
+    if (m_timestampFrequency == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (index + count > kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    if (m_timestampDisjointActive)
+    {
+        m_immediateContext->End(m_timestampDisjointQuery);
+        m_timestampDisjointActive = false;
+    }
+
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjointData;
+    SLANG_RETURN_ON_FAIL(_getTimestampDisjointData(disjointData));
+    if (disjointData.Disjoint)
+    {
+        // Something (such as a change in clock speed) made the timestamps unreliable
+        return SLANG_FAIL;
+    }
+    m_timestampFrequency = disjointData.Frequency;
+
+    for (UInt i = 0; i < count; ++i)
+    {
+        ID3D11Query* query = m_timestampQueries[index + i];
+        if (!query)
+        {
+            // Never written, so there is nothing to wait for
+            return SLANG_E_INVALID_ARG;
+        }
+
+        for (;;)
+        {
+            const HRESULT res = m_immediateContext->GetData(query, &outTimestamps[i], sizeof(uint64_t), 0);
+            if (res == S_OK)
+            {
+                break;
+            }
+            if (res != S_FALSE)
+            {
+                return res;
+            }
+        }
+    }
+    return SLANG_OK;
+}
+
 Result D3D11Renderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& desc, DescriptorSetLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getDescriptorSetLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<DescriptorSetLayoutImpl> descriptorSetLayoutImpl = new DescriptorSetLayoutImpl();
 
     UInt counts[int(D3D11DescriptorSlotType::CountOf)] = { 0, };
@@ -1821,12 +2182,20 @@ Result D3D11Renderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc&
         descriptorSetLayoutImpl->m_counts[ii] = counts[ii];
     }
 
+    m_objectCache.add(key, descriptorSetLayoutImpl);
+
     *outLayout = descriptorSetLayoutImpl.detach();
     return SLANG_OK;
 }
 
 Result D3D11Renderer::createPipelineLayout(const PipelineLayout::Desc& desc, PipelineLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getPipelineLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<PipelineLayoutImpl> pipelineLayoutImpl = new PipelineLayoutImpl();
 
     UInt counts[int(D3D11DescriptorSlotType::CountOf)] = { 0, };
@@ -1850,6 +2219,8 @@ Result D3D11Renderer::createPipelineLayout(const PipelineLayout::Desc& desc, Pip
 
     pipelineLayoutImpl->m_uavCount = UINT(counts[int(D3D11DescriptorSlotType::UnorderedAccessView)]);
 
+    m_objectCache.add(key, pipelineLayoutImpl);
+
     *outLayout = pipelineLayoutImpl.detach();
     return SLANG_OK;
 }
@@ -2185,6 +2556,11 @@ void D3D11Renderer::_flushGraphicsState()
             m_uavBindings[pipelineType][0].readRef(),
             nullptr);
     }
+    if (m_constantBufferBindingsDirty[pipelineType])
+    {
+        m_constantBufferBindingsDirty[pipelineType] = false;
+        _setConstantBuffers(m_immediateContext, m_immediateContext1, PipelineType::Graphics, m_constantBufferBindingCounts[pipelineType], m_constantBufferBindings[pipelineType]);
+    }
 }
 
 void D3D11Renderer::_flushComputeState()
@@ -2204,6 +2580,64 @@ void D3D11Renderer::_flushComputeState()
             m_uavBindings[pipelineType][0].readRef(),
             nullptr);
     }
+    if (m_constantBufferBindingsDirty[pipelineType])
+    {
+        m_constantBufferBindingsDirty[pipelineType] = false;
+        _setConstantBuffers(m_immediateContext, m_immediateContext1, PipelineType::Compute, m_constantBufferBindingCounts[pipelineType], m_constantBufferBindings[pipelineType]);
+    }
+}
+
+void D3D11Renderer::_setConstantBuffers(ID3D11DeviceContext* context, ID3D11DeviceContext1* context1, PipelineType pipelineType, UInt count, const RefPtr<BufferResourceImpl>* buffers) const
+{
+    ID3D11Buffer* d3dBuffers[kMaxConstantBuffers];
+    UINT firstConstants[kMaxConstantBuffers];
+    UINT constantCounts[kMaxConstantBuffers];
+    bool hasRingBuffers = false;
+
+    for (UInt i = 0; i < count; ++i)
+    {
+        BufferResourceImpl* buffer = buffers[i];
+        if (buffer && buffer->m_ringConstantCount)
+        {
+            d3dBuffers[i] = m_constantRing;
+            firstConstants[i] = buffer->m_ringFirstConstant;
+            constantCounts[i] = buffer->m_ringConstantCount;
+            hasRingBuffers = true;
+        }
+        else
+        {
+            // The whole buffer. Its size was rounded up to a multiple of 16 constants when it was created.
+            const UInt size = buffer ? D3DUtil::calcAligned(buffer->getDesc().sizeInBytes, kConstantRingAlignment) : 0;
+            d3dBuffers[i] = buffer ? buffer->m_buffer.get() : nullptr;
+            firstConstants[i] = 0;
+            constantCounts[i] = UINT(Math::Min(size / 16, UInt(D3D11_REQ_CONSTANT_BUFFER_ELEMENT_COUNT)));
+        }
+    }
+
+    if (hasRingBuffers)
+    {
+        if (pipelineType == PipelineType::Compute)
+        {
+            context1->CSSetConstantBuffers1(0, UINT(count), d3dBuffers, firstConstants, constantCounts);
+        }
+        else
+        {
+            context1->VSSetConstantBuffers1(0, UINT(count), d3dBuffers, firstConstants, constantCounts);
+            context1->PSSetConstantBuffers1(0, UINT(count), d3dBuffers, firstConstants, constantCounts);
+        }
+    }
+    else
+    {
+        if (pipelineType == PipelineType::Compute)
+        {
+            context->CSSetConstantBuffers(0, UINT(count), d3dBuffers);
+        }
+        else
+        {
+            context->VSSetConstantBuffers(0, UINT(count), d3dBuffers);
+            context->PSSetConstantBuffers(0, UINT(count), d3dBuffers);
+        }
+    }
 }
 
 void D3D11Renderer::DescriptorSetImpl::setConstantBuffer(UInt range, UInt index, BufferResource* buffer)
@@ -2213,7 +2647,7 @@ void D3D11Renderer::DescriptorSetImpl::setConstantBuffer(UInt range, UInt index,
 
     assert(rangeInfo.type == D3D11DescriptorSlotType::ConstantBuffer);
 
-    m_cbs[rangeInfo.arrayIndex + index] = bufferImpl->m_buffer;
+    m_cbs[rangeInfo.arrayIndex + index] = bufferImpl;
 }
 
 void D3D11Renderer::DescriptorSetImpl::setResource(UInt range, UInt index, ResourceView* view)
@@ -2280,8 +2714,24 @@ void D3D11Renderer::DescriptorSetImpl::setCombinedTextureSampler(
 void D3D11Renderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet)
 {
     auto pipelineLayoutImpl = (PipelineLayoutImpl*)layout;
-    auto descriptorSetImpl = (DescriptorSetImpl*) descriptorSet;
+    const int pipelineTypeIndex = int(pipelineType);
+    _setDescriptorSet(m_immediateContext, pipelineType, pipelineLayoutImpl, index, (DescriptorSetImpl*)descriptorSet,
+        m_constantBufferBindings[pipelineTypeIndex], m_constantBufferBindingCounts[pipelineTypeIndex], m_uavBindings[pipelineTypeIndex]);
+
+    auto setLayout = pipelineLayoutImpl->m_descriptorSets[index].layout;
+    if (setLayout->m_counts[int(D3D11DescriptorSlotType::ConstantBuffer)])
+    {
+        m_constantBufferBindingsDirty[pipelineTypeIndex] = true;
+    }
+    if (setLayout->m_counts[int(D3D11DescriptorSlotType::UnorderedAccessView)])
+    {
+        m_targetBindingsDirty[pipelineTypeIndex] = true;
+    }
+}
 
+/* static */void D3D11Renderer::_setDescriptorSet(ID3D11DeviceContext* context, PipelineType pipelineType, PipelineLayoutImpl* pipelineLayoutImpl, UInt index, DescriptorSetImpl* descriptorSetImpl,
+    RefPtr<BufferResourceImpl>* ioConstantBufferBindings, UInt& ioConstantBufferBindingCount, ComPtr<ID3D11UnorderedAccessView>* ioUavBindings)
+{
     auto descriptorSetLayoutImpl = descriptorSetImpl->m_layout;
     auto& setInfo = pipelineLayoutImpl->m_descriptorSets[index];
 
@@ -2292,19 +2742,34 @@ void D3D11Renderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout*
     // for each stage.
 
     {
+        // Note: Constant buffers are shadowed, and flushed right before a draw/dispatch,
+        // because a `WriteDiscard` map can move the contents of a buffer in the constant
+        // ring after it is bound.
+        //
         const int slotType = int(D3D11DescriptorSlotType::ConstantBuffer);
-        const UINT slotCount = UINT(setInfo.layout->m_counts[slotType]);
+        const UInt slotCount = setInfo.layout->m_counts[slotType];
         if(slotCount)
         {
-            const UINT startSlot = UINT(setInfo.baseIndices[slotType]);
-
-            auto cbs = descriptorSetImpl->m_cbs[0].readRef();
+            const UInt startSlot = setInfo.baseIndices[slotType];
 
-            m_immediateContext->VSSetConstantBuffers(startSlot, slotCount, cbs);
-            // ...
-            m_immediateContext->PSSetConstantBuffers(startSlot, slotCount, cbs);
+            for(UInt ii = 0; ii < slotCount; ++ii)
+            {
+                ioConstantBufferBindings[startSlot + ii] = descriptorSetImpl->m_cbs[ii];
+            }
+            ioConstantBufferBindingCount = Math::Max(ioConstantBufferBindingCount, startSlot + slotCount);
+        }
+    }
 
-            m_immediateContext->CSSetConstantBuffers(startSlot, slotCount, cbs);
+    if (pipelineType == PipelineType::Compute)
+    {
+        // Compute UAVs can be set a range at a time. Setting them before the SRVs means an SRV of a subresource that
+        // the last dispatch wrote (such as the mip above the one being generated) isn't unbound as a hazard.
+        const int slotType = int(D3D11DescriptorSlotType::UnorderedAccessView);
+        const UINT slotCount = UINT(setInfo.layout->m_counts[slotType]);
+        if(slotCount)
+        {
+            const UINT startSlot = UINT(setInfo.baseIndices[slotType]);
+            context->CSSetUnorderedAccessViews(startSlot, slotCount, descriptorSetImpl->m_uavs[0].readRef(), nullptr);
         }
     }
 
@@ -2317,11 +2782,11 @@ void D3D11Renderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout*
 
             auto srvs = descriptorSetImpl->m_srvs[0].readRef();
 
-            m_immediateContext->VSSetShaderResources(startSlot, slotCount, srvs);
+            context->VSSetShaderResources(startSlot, slotCount, srvs);
             // ...
-            m_immediateContext->PSSetShaderResources(startSlot, slotCount, srvs);
+            context->PSSetShaderResources(startSlot, slotCount, srvs);
 
-            m_immediateContext->CSSetShaderResources(startSlot, slotCount, srvs);
+            context->CSSetShaderResources(startSlot, slotCount, srvs);
         }
     }
 
@@ -2334,11 +2799,11 @@ void D3D11Renderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout*
 
             auto samplers = descriptorSetImpl->m_samplers[0].readRef();
 
-            m_immediateContext->VSSetSamplers(startSlot, slotCount, samplers);
+            context->VSSetSamplers(startSlot, slotCount, samplers);
             // ...
-            m_immediateContext->PSSetSamplers(startSlot, slotCount, samplers);
+            context->PSSetSamplers(startSlot, slotCount, samplers);
 
-            m_immediateContext->CSSetSamplers(startSlot, slotCount, samplers);
+            context->CSSetSamplers(startSlot, slotCount, samplers);
         }
     }
 
@@ -2346,8 +2811,8 @@ void D3D11Renderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout*
         // Note: UAVs are handled differently from other bindings, because
         // D3D11 requires all UAVs to be set with a single call, rather
         // than allowing incremental updates. We will therefore shadow
-        // the UAV bindings with `m_uavBindings` and then flush them
-        // as needed right before a draw/dispatch.
+        // the UAV bindings and then flush them as needed right before
+        // a draw/dispatch.
         //
         const int slotType = int(D3D11DescriptorSlotType::UnorderedAccessView);
         const UInt slotCount = setInfo.layout->m_counts[slotType];
@@ -2359,13 +2824,97 @@ void D3D11Renderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout*
 
             for(UINT ii = 0; ii < slotCount; ++ii)
             {
-                m_uavBindings[int(pipelineType)][startSlot + ii] = uavs[ii];
+                ioUavBindings[startSlot + ii] = uavs[ii];
             }
-            m_targetBindingsDirty[int(pipelineType)] = true;
+        }
+    }
+}
+
+Result D3D11Renderer::CommandBufferImpl::begin()
+{
+    m_pipelineState.setNull();
+    for (auto& buffer : m_constantBufferBindings)
+    {
+        buffer.setNull();
+    }
+    m_constantBufferBindingCount = 0;
+    for (auto& uav : m_uavBindings)
+    {
+        uav.setNull();
+    }
+    m_timestampIndices.clear();
+    m_commandList.setNull();
+    m_result = SLANG_OK;
+
+    m_context->ClearState();
+    return SLANG_OK;
+}
+
+void D3D11Renderer::CommandBufferImpl::setPipelineState(PipelineState* state)
+{
+    m_pipelineState = static_cast<ComputePipelineStateImpl*>(state);
+    m_context->CSSetShader(m_pipelineState->m_program->m_computeShader, nullptr, 0);
+}
+
+void D3D11Renderer::CommandBufferImpl::setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet)
+{
+    _setDescriptorSet(m_context, PipelineType::Compute, (PipelineLayoutImpl*)layout, index, (DescriptorSetImpl*)descriptorSet,
+        m_constantBufferBindings, m_constantBufferBindingCount, m_uavBindings);
+}
+
+void D3D11Renderer::CommandBufferImpl::dispatchCompute(int x, int y, int z)
+{
+    if (!m_pipelineState || !m_pipelineState->m_program->m_computeShader)
+    {
+        assert(!"No compute pipeline state set");
+        m_result = SLANG_FAIL;
+        return;
+    }
+
+    m_renderer->_setConstantBuffers(m_context, m_context1, PipelineType::Compute, m_constantBufferBindingCount, m_constantBufferBindings);
+    m_context->CSSetUnorderedAccessViews(0, m_pipelineState->m_pipelineLayout->m_uavCount, m_uavBindings[0].readRef(), nullptr);
+    m_context->Dispatch(x, y, z);
+}
+
+void D3D11Renderer::CommandBufferImpl::writeTimestamp(UInt index)
+{
+    Result res = SLANG_OK;
+    if (m_renderer->m_timestampFrequency == 0)
+    {
+        res = SLANG_E_NOT_AVAILABLE;
+    }
+    else if (index >= kMaxTimestampCount)
+    {
+        res = SLANG_E_INVALID_ARG;
+    }
+    else
+    {
+        // The query is the command buffer's own, as the renderer's may be in use on another thread. The renderer uses it
+        // for the index once the command buffer is submitted.
+        ComPtr<ID3D11Query>& query = m_timestampQueries[index];
+        if (!query)
+        {
+            D3D11_QUERY_DESC queryDesc = {};
+            queryDesc.Query = D3D11_QUERY_TIMESTAMP;
+            res = m_renderer->m_device->CreateQuery(&queryDesc, query.writeRef());
+        }
+        if (SLANG_SUCCEEDED(res))
+        {
+            m_context->End(query);
+            m_timestampIndices.add(index);
         }
     }
 
+    if (SLANG_FAILED(res) && SLANG_SUCCEEDED(m_result))
+    {
+        m_result = res;
+    }
+}
 
+Result D3D11Renderer::CommandBufferImpl::end()
+{
+    SLANG_RETURN_ON_FAIL(m_context->FinishCommandList(FALSE, m_commandList.writeRef()));
+    return m_result;
 }
 
 } // renderer_test
@@ -5,6 +5,7 @@
 
 //WORKING:#include "options.h"
 #include "render.h"
+#include "render-object-cache.h"
 
 #include "surface.h"
 
@@ -30,10 +31,14 @@
 
 #include "resource-d3d12.h"
 #include "descriptor-heap-d3d12.h"
+#include "heap-allocator-d3d12.h"
 #include "circular-resource-heap-d3d12.h"
+#include "upload-ring.h"
 
 #include "d3d-util.h"
 
+#include "../../source/core/slang-hash.h"
+
 // We will use the C standard library just for printing error messages.
 #include <stdio.h>
 
@@ -95,14 +100,30 @@ public:
     virtual void setPipelineState(PipelineType pipelineType, PipelineState* state) override;
     virtual void draw(UInt vertexCount, UInt startVertex) override;
     virtual void drawIndexed(UInt indexCount, UInt startIndex, UInt baseVertex) override;
+    virtual void drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance) override;
     virtual void dispatchCompute(int x, int y, int z) override;
     virtual void submitGpuWork() override;
     virtual void waitForGpu() override;
+    virtual Result createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer) override;
+    virtual void submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers) override;
+    virtual void waitForQueue(QueueType queue, QueueType waitQueue) override;
+    virtual Result writeTimestamp(UInt index) override;
+    virtual Result getTimestamps(UInt index, UInt count, uint64_t* outTimestamps) override;
+    virtual uint64_t getTimestampFrequency() override;
+    virtual Result readBuffers(UInt count, BufferResource*const* buffers, BufferReadback** outReadback) override;
     virtual RendererType getRendererType() const override { return RendererType::DirectX12; }
 
     ~D3D12Renderer();
 
 protected:
+
+        /// Create m_pipelineLibrary from the file at m_desc.pipelineCachePath (if it's from the same device and driver)
+    void _initPipelineLibrary();
+        /// Write m_pipelineLibrary to the file at m_desc.pipelineCachePath
+    SlangResult _savePipelineLibrary();
+        /// Load the pipeline state stored as key in m_pipelineLibrary, or create it (and add it to the library). Exactly
+        /// one of graphicsDesc and computeDesc must be set.
+    Result _createPipelineState(HashCode64 key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC* graphicsDesc, const D3D12_COMPUTE_PIPELINE_STATE_DESC* computeDesc, ComPtr<ID3D12PipelineState>& outPipelineState);
     
     static const Int kMaxNumRenderFrames = 4;
     static const Int kMaxNumRenderTargets = 3;
@@ -110,6 +131,10 @@ protected:
     static const Int kMaxRTVCount = 8;
     static const Int kMaxDescriptorSetCount = 16;
 
+    static const size_t kUploadRingSize = 16 * 1024 * 1024;
+        /// Alignment of buffer uploads. Copies need none, but it makes the memcpy into the ring faster.
+    static const size_t kBufferUploadAlignment = 16;
+
     struct DeviceInfo
     {
         void clear()
@@ -192,11 +217,19 @@ protected:
             }
         }
 
-        BufferResourceImpl(Resource::Usage initialUsage, const Desc& desc):
+        BufferResourceImpl(Resource::Usage initialUsage, const Desc& desc, D3D12HeapAllocator* heapAllocator):
             Parent(desc),
             m_mapFlavor(MapFlavor::HostRead),
-            m_initialUsage(initialUsage)
+            m_initialUsage(initialUsage),
+            m_heapAllocator(heapAllocator)
+        {
+        }
+
+        ~BufferResourceImpl()
         {
+            // The resource has to be released before the heap memory it's placed in can be reused
+            m_resource.setResourceNull();
+            m_heapAllocator->free(m_allocation);
         }
 
         static BackingStyle _calcResourceBackingStyle(Usage usage)
@@ -227,12 +260,16 @@ protected:
 
         BackingStyle m_backingStyle;        ///< How the resource is 'backed' - either as a resource or cpu memory. Cpu memory is typically used for constant buffers.
         D3D12Resource m_resource;           ///< The resource typically in gpu memory
-        D3D12Resource m_uploadResource;     ///< If the resource can be written to, and is in gpu memory (ie not Memory backed), will have upload resource
+        D3D12HeapAllocation m_allocation;   ///< The heap memory m_resource is placed in (if it's not committed)
+        D3D12Resource m_uploadResource;     ///< Created on the first HostWrite map of a resource backed buffer
+        size_t m_mapUploadOffset = 0;       ///< For a WriteDiscard map, the offset of the contents in the upload ring
 
         Usage m_initialUsage;
 
         List<uint8_t> m_memory;             ///< Cpu memory buffer, used if the m_backingStyle is MemoryBacked
         MapFlavor m_mapFlavor;              ///< If the resource is mapped holds the current mapping flavor
+
+        D3D12HeapAllocator* m_heapAllocator;
     };
 
     class TextureResourceImpl: public TextureResource
@@ -240,18 +277,34 @@ protected:
         public:
         typedef TextureResource Parent;
 
-        TextureResourceImpl(const Desc& desc):
-            Parent(desc)
+        TextureResourceImpl(const Desc& desc, D3D12HeapAllocator* heapAllocator):
+            Parent(desc),
+            m_heapAllocator(heapAllocator)
+        {
+        }
+
+        ~TextureResourceImpl()
         {
+            m_resource.setResourceNull();
+            m_heapAllocator->free(m_allocation);
         }
 
         D3D12Resource m_resource;
+        D3D12HeapAllocation m_allocation;   ///< The heap memory m_resource is placed in (if it's not committed)
+        D3D12HeapAllocator* m_heapAllocator;
     };
 
     class SamplerStateImpl : public SamplerState
     {
     public:
+        ~SamplerStateImpl()
+        {
+            m_heap->free(m_indexInHeap, 1);
+        }
+
         D3D12_CPU_DESCRIPTOR_HANDLE m_cpuHandle;
+        D3D12FreeListDescriptorHeap* m_heap = nullptr;      ///< The heap the descriptor is allocated from
+        int m_indexInHeap = -1;
     };
 
     class ResourceViewImpl : public ResourceView
@@ -321,12 +374,25 @@ protected:
     {
     public:
         ComPtr<ID3D12RootSignature> m_rootSignature;
+        HashCode64                  m_rootSignatureHash;        ///< Hash of the serialized root signature
         UInt                        m_descriptorSetCount;
     };
 
     class DescriptorSetImpl : public DescriptorSet
     {
     public:
+        ~DescriptorSetImpl()
+        {
+            if (m_resourceHeap)
+            {
+                m_resourceHeap->free(int(m_resourceTable), int(m_layout->m_resourceCount));
+            }
+            if (m_samplerHeap)
+            {
+                m_samplerHeap->free(int(m_samplerTable), int(m_layout->m_samplerCount));
+            }
+        }
+
         virtual void setConstantBuffer(UInt range, UInt index, BufferResource* buffer) override;
         virtual void setResource(UInt range, UInt index, ResourceView* view) override;
         virtual void setSampler(UInt range, UInt index, SamplerState* sampler) override;
@@ -339,8 +405,9 @@ protected:
         D3D12Renderer*           m_renderer = nullptr;          ///< Weak pointer - must be because if set on Renderer, will have a circular reference
         RefPtr<DescriptorSetLayoutImpl> m_layout;
 
-        D3D12DescriptorHeap*        m_resourceHeap = nullptr;
-        D3D12DescriptorHeap*        m_samplerHeap = nullptr;
+        D3D12FreeListDescriptorHeap*    m_resourceHeap = nullptr;
+        D3D12FreeListDescriptorHeap*    m_samplerHeap = nullptr;
+        bool                            m_isShaderVisible = false;  ///< True if the tables are in the bindless heaps, and can be bound in place
 
         Int                         m_resourceTable = 0;
         Int                         m_samplerTable = 0;
@@ -362,13 +429,16 @@ protected:
     // used to come from a single heap (for each descriptor heap type).
     //
     // We will thus keep a single heap of each type that we hope will hold
-    // all the descriptors that actually get needed in a frame.
+    // all the descriptors that actually get needed in a frame. The tables
+    // are only used by the commands that are being built, so each heap is
+    // used as a ring buffer, and space is reused once the GPU has finished
+    // with the commands.
     //
     // TODO: we need an allocation policy to reallocate and resize these
     // if/when we run out of space during a frame.
     //
-    D3D12DescriptorHeap m_viewHeap;             ///< Cbv, Srv, Uav
-    D3D12DescriptorHeap m_samplerHeap;          ///< Heap for samplers
+    D3D12RingDescriptorHeap m_viewHeap;         ///< Cbv, Srv, Uav
+    D3D12RingDescriptorHeap m_samplerHeap;      ///< Heap for samplers
 
     D3D12HostVisibleDescriptorAllocator m_rtvAllocator;
     D3D12HostVisibleDescriptorAllocator m_dsvAllocator;
@@ -379,9 +449,20 @@ protected:
     // Space in the GPU-visible heaps is precious, so we will also keep
     // around CPU-visible heaps for storing descriptors in a format
     // that is ready for copying into the GPU-visible heaps as needed.
+    // Descriptor sets and samplers free their descriptors when they
+    // are destroyed.
     //
-    D3D12DescriptorHeap m_cpuViewHeap;          ///< Cbv, Srv, Uav
-    D3D12DescriptorHeap m_cpuSamplerHeap;       ///< Heap for samplers
+    D3D12FreeListDescriptorHeap m_cpuViewHeap;      ///< Cbv, Srv, Uav
+    D3D12FreeListDescriptorHeap m_cpuSamplerHeap;   ///< Heap for samplers
+
+    // In bindless mode (see Renderer::Desc::bindless) descriptor sets are instead
+    // allocated from large shader visible heaps, which are bound for all commands.
+    // Binding a descriptor set then just sets the GPU handles of its tables, with
+    // nothing copied. As with Vulkan, a descriptor set must not be changed while
+    // commands that use it may be executing.
+    //
+    D3D12FreeListDescriptorHeap m_bindlessViewHeap;     ///< Cbv, Srv, Uav
+    D3D12FreeListDescriptorHeap m_bindlessSamplerHeap;  ///< Heap for samplers
 
     class PipelineStateImpl : public PipelineState
     {
@@ -468,18 +549,88 @@ protected:
         ID3D12GraphicsCommandList* m_commandList;
     };
 
+    class CommandBufferImpl : public CommandBuffer
+    {
+    public:
+        virtual Result begin() override;
+        virtual void setPipelineState(PipelineState* state) override;
+        virtual void setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet) override;
+        virtual void dispatchCompute(int x, int y, int z) override;
+        virtual void writeTimestamp(UInt index) override;
+        virtual Result end() override;
+
+        D3D12Renderer* m_renderer = nullptr;                ///< Weak pointer - the renderer must outlive the command buffer
+        QueueType m_queueType = QueueType::Graphics;
+        ComPtr<ID3D12CommandAllocator> m_commandAllocator;
+        ComPtr<ID3D12GraphicsCommandList> m_commandList;
+
+        // Shader visible copies of the descriptor tables used by the commands. Each command buffer has its own, so
+        // recording doesn't need to lock. Not used in bindless mode.
+        D3D12RingDescriptorHeap m_viewHeap;
+        D3D12RingDescriptorHeap m_samplerHeap;
+
+        RefPtr<PipelineStateImpl> m_pipelineState;
+        RefPtr<DescriptorSetImpl> m_descriptorSets[kMaxDescriptorSetCount];
+        Result m_result = SLANG_OK;                         ///< The first failure while recording
+    };
+
+        /// A buffer in a readback heap, used by one BufferReadback at a time
+    class ReadbackHeap : public RefObject
+    {
+    public:
+        ComPtr<ID3D12Resource> m_resource;
+        size_t m_size = 0;
+    };
+
+    class BufferReadbackImpl : public BufferReadback
+    {
+    public:
+        virtual bool isComplete() override;
+        virtual const void* getData(UInt index) override;
+
+        ~BufferReadbackImpl();
+
+        struct Entry
+        {
+            size_t m_offset;                                ///< Offset of the contents in the readback heap
+            RefPtr<BufferResourceImpl> m_memoryBuffer;      ///< Set if the buffer is memory backed, in which case there is no copy
+        };
+
+        D3D12Renderer* m_renderer = nullptr;                ///< Weak pointer - the renderer must outlive the readback
+        RefPtr<ReadbackHeap> m_heap;                        ///< Returned to the renderer's pool when the readback is destroyed
+        List<Entry> m_entries;
+        UInt64 m_fenceValue = 0;                            ///< The copies are complete when m_fence reaches this value
+        uint8_t* m_data = nullptr;                          ///< m_heap, mapped once the copies are complete
+    };
+
     static PROC loadProc(HMODULE module, char const* name);
     Result createFrameResources();
         /// Blocks until gpu has completed all work
     void releaseFrameResources();
 
-    Result createBuffer(const D3D12_RESOURCE_DESC& resourceDesc, const void* srcData, size_t srcDataSize, D3D12Resource& uploadResource, D3D12_RESOURCE_STATES finalState, D3D12Resource& resourceOut);
+    Result createBuffer(const D3D12_RESOURCE_DESC& resourceDesc, const void* srcData, size_t srcDataSize, D3D12_RESOURCE_STATES finalState, D3D12Resource& resourceOut, D3D12HeapAllocation& allocationOut);
+
+        /// Get a readback heap buffer of at least size bytes, from the pool if there is one large enough
+    Result _allocateReadbackHeap(size_t size, RefPtr<ReadbackHeap>& outHeap);
+
+        /// Upload memory that a copy to the GPU reads from
+    struct UploadAllocation
+    {
+        ID3D12Resource* m_resource;
+        size_t m_offset;
+        uint8_t* m_data;
+    };
+        /// Allocate upload memory from the upload ring, submitting and waiting for the GPU if the ring is full. If size is larger
+        /// than the ring, a resource is created in outFallback, which has to be kept alive until the GPU has done the copy.
+    Result _allocateUpload(size_t size, size_t alignment, D3D12Resource& outFallback, UploadAllocation& outAllocation);
 
     void beginRender();
 
     void endRender();
 
     void submitGpuWorkAndWait();
+        /// Add a sync point to the shader visible descriptor heaps and the upload heaps, after commands have been submitted
+    void _addHeapSync();
     void _resetCommandList();
 
     Result captureTextureToSurface(D3D12Resource& resource, Surface& surfaceOut);
@@ -495,15 +646,23 @@ protected:
 //    Result calcGraphicsPipelineState(ComPtr<ID3D12RootSignature>& sigOut, ComPtr<ID3D12PipelineState>& pipelineStateOut);
 //    Result calcComputePipelineState(ComPtr<ID3D12RootSignature>& signatureOut, ComPtr<ID3D12PipelineState>& pipelineStateOut);
 
-    Result _bindRenderState(PipelineStateImpl* pipelineStateImpl, ID3D12GraphicsCommandList* commandList, Submitter* submitter);
+        /// Set the pipeline state and descriptor sets, copying the descriptor tables into viewHeap and samplerHeap as needed
+    Result _bindRenderState(PipelineStateImpl* pipelineStateImpl, const RefPtr<DescriptorSetImpl>* descriptorSets, D3D12RingDescriptorHeap& viewHeap, D3D12RingDescriptorHeap& samplerHeap, ID3D12GraphicsCommandList* commandList, Submitter* submitter);
 
 //    Result _calcBindParameters(BindParameters& params);
 //    RenderState* findRenderState(PipelineType pipelineType);
 
     Result _createDevice(DeviceCheckFlags deviceCheckFlags, const UnownedStringSlice& nameMatch, D3D_FEATURE_LEVEL featureLevel, DeviceInfo& outDeviceInfo);
     
+    D3D12HeapAllocator m_heapAllocator;         ///< Declared before any resources, so it's destroyed after them
+
     D3D12CircularResourceHeap m_circularResourceHeap;
 
+    D3D12Resource m_uploadRingResource;         ///< Upload heap buffer the upload ring allocates from. Mapped for its lifetime.
+    UploadRing m_uploadRing;
+
+    List<RefPtr<ReadbackHeap>> m_freeReadbackHeaps;     ///< Readback heap buffers not used by a readback, for reuse
+
     int m_commandListOpenCount = 0;            ///< If >0 the command list should be open
 
     List<BoundVertexBuffer> m_boundVertexBuffers;
@@ -547,6 +706,11 @@ protected:
 
     ComPtr<IDXGISwapChain3> m_swapChain;
     ComPtr<ID3D12CommandQueue> m_commandQueue;
+    ComPtr<ID3D12CommandQueue> m_computeQueue;          ///< For QueueType::Compute command buffers
+    D3D12CounterFence m_computeFence;                   ///< Signaled after each submission to m_computeQueue
+
+    ComPtr<ID3D12QueryHeap> m_timestampQueryHeap;       ///< kMaxTimestampCount timestamp queries
+    D3D12Resource m_timestampReadback;                  ///< The query values are resolved into here
 //    ComPtr<ID3D12DescriptorHeap> m_rtvHeap;
     ComPtr<ID3D12GraphicsCommandList> m_commandList;
 
@@ -593,7 +757,12 @@ protected:
 
     HWND m_hwnd = nullptr;
 
+    List<uint8_t> m_pipelineLibraryData;                ///< The data m_pipelineLibrary was created from, which must outlive it
+    ComPtr<ID3D12PipelineLibrary> m_pipelineLibrary;    ///< Holds compiled pipelines, keyed by a hash of their desc. Null if not used.
+
     List<String> m_features;
+
+    RenderObjectCache m_objectCache;                ///< Sampler states and layouts, shared by the creates with the same desc
 };
 
 Renderer* createD3D12Renderer()
@@ -635,6 +804,10 @@ void D3D12Renderer::releaseFrameResources()
 void D3D12Renderer::waitForGpu()
 {
     m_fence.nextSignalAndWait(m_commandQueue);
+    if (m_computeFence.getCurrentValue())
+    {
+        m_computeFence.nextSignalAndWait(m_computeQueue);
+    }
 }
 
 D3D12Renderer::~D3D12Renderer()
@@ -645,6 +818,110 @@ D3D12Renderer::~D3D12Renderer()
         // cleaned up by the destructor.
         waitForGpu();
     }
+
+    if (m_pipelineLibrary)
+    {
+        _savePipelineLibrary();
+    }
+}
+
+void D3D12Renderer::_initPipelineLibrary()
+{
+    if (m_desc.pipelineCachePath.getLength() == 0)
+    {
+        return;
+    }
+
+    // Pipeline libraries need a newer runtime. Without one, pipelines are just compiled each time.
+    ComPtr<ID3D12Device1> device1;
+    if (SLANG_FAILED(m_device->QueryInterface(device1.writeRef())))
+    {
+        return;
+    }
+
+    if (FILE* file = fopen(m_desc.pipelineCachePath.getBuffer(), "rb"))
+    {
+        fseek(file, 0, SEEK_END);
+        const long size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+
+        if (size > 0)
+        {
+            m_pipelineLibraryData.setCount(Index(size));
+            if (fread(m_pipelineLibraryData.getBuffer(), 1, size_t(size), file) != size_t(size))
+            {
+                m_pipelineLibraryData.clear();
+            }
+        }
+        fclose(file);
+    }
+
+    // The runtime checks the data is for this device and driver, and fails if not
+    if (m_pipelineLibraryData.getCount() &&
+        SLANG_FAILED(device1->CreatePipelineLibrary(m_pipelineLibraryData.getBuffer(), SIZE_T(m_pipelineLibraryData.getCount()), IID_PPV_ARGS(m_pipelineLibrary.writeRef()))))
+    {
+        m_pipelineLibrary.setNull();
+        m_pipelineLibraryData = List<uint8_t>();
+    }
+
+    if (!m_pipelineLibrary)
+    {
+        // If this fails (for example if the driver doesn't support libraries) m_pipelineLibrary stays null
+        device1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(m_pipelineLibrary.writeRef()));
+    }
+}
+
+SlangResult D3D12Renderer::_savePipelineLibrary()
+{
+    const SIZE_T size = m_pipelineLibrary->GetSerializedSize();
+    List<uint8_t> data;
+    data.setCount(Index(size));
+    SLANG_RETURN_ON_FAIL(m_pipelineLibrary->Serialize(data.getBuffer(), size));
+
+    FILE* file = fopen(m_desc.pipelineCachePath.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    const bool written = fwrite(data.getBuffer(), 1, size_t(size), file) == size_t(size);
+    fclose(file);
+    return written ? SLANG_OK : SLANG_FAIL;
+}
+
+Result D3D12Renderer::_createPipelineState(HashCode64 key, const D3D12_GRAPHICS_PIPELINE_STATE_DESC* graphicsDesc, const D3D12_COMPUTE_PIPELINE_STATE_DESC* computeDesc, ComPtr<ID3D12PipelineState>& outPipelineState)
+{
+    SLANG_ASSERT((graphicsDesc == nullptr) != (computeDesc == nullptr));
+
+    wchar_t name[32];
+    if (m_pipelineLibrary)
+    {
+        swprintf(name, SLANG_COUNT_OF(name), L"%016llx", (unsigned long long)key);
+
+        // Fails if the pipeline isn't in the library
+        const HRESULT res = graphicsDesc ?
+            m_pipelineLibrary->LoadGraphicsPipeline(name, graphicsDesc, IID_PPV_ARGS(outPipelineState.writeRef())) :
+            m_pipelineLibrary->LoadComputePipeline(name, computeDesc, IID_PPV_ARGS(outPipelineState.writeRef()));
+        if (SUCCEEDED(res))
+        {
+            return SLANG_OK;
+        }
+    }
+
+    if (graphicsDesc)
+    {
+        SLANG_RETURN_ON_FAIL(m_device->CreateGraphicsPipelineState(graphicsDesc, IID_PPV_ARGS(outPipelineState.writeRef())));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(m_device->CreateComputePipelineState(computeDesc, IID_PPV_ARGS(outPipelineState.writeRef())));
+    }
+
+    if (m_pipelineLibrary)
+    {
+        // Can fail if a different pipeline was stored with the same name, in which case it just isn't cached
+        m_pipelineLibrary->StorePipeline(name, outPipelineState);
+    }
+    return SLANG_OK;
 }
 
 static void _initSrvDesc(Resource::Type resourceType, const TextureResource::Desc& textureDesc, const D3D12_RESOURCE_DESC& desc, DXGI_FORMAT pixelFormat, D3D12_SHADER_RESOURCE_VIEW_DESC& descOut)
@@ -729,51 +1006,24 @@ static void _initBufferResourceDesc(size_t bufferSize, D3D12_RESOURCE_DESC& out)
     out.Flags = D3D12_RESOURCE_FLAG_NONE;
 }
 
-Result D3D12Renderer::createBuffer(const D3D12_RESOURCE_DESC& resourceDesc, const void* srcData, size_t srcDataSize, D3D12Resource& uploadResource, D3D12_RESOURCE_STATES finalState, D3D12Resource& resourceOut)
+Result D3D12Renderer::createBuffer(const D3D12_RESOURCE_DESC& resourceDesc, const void* srcData, size_t srcDataSize, D3D12_RESOURCE_STATES finalState, D3D12Resource& resourceOut, D3D12HeapAllocation& allocationOut)
 {
-   const  size_t bufferSize = size_t(resourceDesc.Width);
-
     {
-        D3D12_HEAP_PROPERTIES heapProps;
-        heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
-        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-        heapProps.CreationNodeMask = 1;
-        heapProps.VisibleNodeMask = 1;
-
         const D3D12_RESOURCE_STATES initialState = srcData ? D3D12_RESOURCE_STATE_COPY_DEST : finalState;
 
-        SLANG_RETURN_ON_FAIL(resourceOut.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, resourceDesc, initialState, nullptr));
-    }
-
-    {
-        D3D12_HEAP_PROPERTIES heapProps;
-        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-        heapProps.CreationNodeMask = 1;
-        heapProps.VisibleNodeMask = 1;
-
-        D3D12_RESOURCE_DESC uploadResourceDesc(resourceDesc);
-        uploadResourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
-
-        SLANG_RETURN_ON_FAIL(uploadResource.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, uploadResourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr));
+        SLANG_RETURN_ON_FAIL(m_heapAllocator.createResource(D3D12_HEAP_TYPE_DEFAULT, resourceDesc, initialState, nullptr, resourceOut, allocationOut));
     }
 
     if (srcData)
     {
-        // Copy data to the intermediate upload heap and then schedule a copy
-        // from the upload heap to the vertex buffer.
-        UINT8* dstData;
-        D3D12_RANGE readRange = {};         // We do not intend to read from this resource on the CPU.
+        // Copy data to upload memory and then schedule a copy from there to the buffer.
+        D3D12Resource fallbackResource;
+        UploadAllocation upload;
+        SLANG_RETURN_ON_FAIL(_allocateUpload(srcDataSize, kBufferUploadAlignment, fallbackResource, upload));
 
-        ID3D12Resource* dxUploadResource = uploadResource.getResource();
+        ::memcpy(upload.m_data, srcData, srcDataSize);
 
-        SLANG_RETURN_ON_FAIL(dxUploadResource->Map(0, &readRange, reinterpret_cast<void**>(&dstData)));
-        ::memcpy(dstData, srcData, srcDataSize);
-        dxUploadResource->Unmap(0, nullptr);
-
-        m_commandList->CopyBufferRegion(resourceOut, 0, uploadResource, 0, bufferSize);
+        m_commandList->CopyBufferRegion(resourceOut, 0, upload.m_resource, upload.m_offset, srcDataSize);
 
         // Make sure it's in the right state
         {
@@ -781,12 +1031,62 @@ Result D3D12Renderer::createBuffer(const D3D12_RESOURCE_DESC& resourceDesc, cons
             resourceOut.transition(finalState, submitter);
         }
 
-        submitGpuWorkAndWait();
+        // The upload ring keeps the data until the copy is done, but a fallback resource only lives until we return
+        if (fallbackResource.isSet())
+        {
+            submitGpuWorkAndWait();
+        }
     }
 
     return SLANG_OK;
 }
 
+Result D3D12Renderer::_allocateUpload(size_t size, size_t alignment, D3D12Resource& outFallback, UploadAllocation& outAllocation)
+{
+    if (size <= m_uploadRing.getSize())
+    {
+        m_uploadRing.updateCompleted(m_fence.getCompletedValue());
+        ptrdiff_t offset = m_uploadRing.allocate(size, alignment);
+        if (offset < 0)
+        {
+            // The ring is full of data for copies that haven't been done yet, so do them
+            submitGpuWorkAndWait();
+            m_uploadRing.updateCompleted(m_fence.getCompletedValue());
+            offset = m_uploadRing.allocate(size, alignment);
+        }
+
+        if (offset >= 0)
+        {
+            outAllocation.m_resource = m_uploadRingResource;
+            outAllocation.m_offset = size_t(offset);
+            outAllocation.m_data = m_uploadRing.getMappedData(size_t(offset));
+            return SLANG_OK;
+        }
+    }
+
+    // Too large for the ring, so it needs a resource of its own
+    D3D12_HEAP_PROPERTIES heapProps;
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapProps.CreationNodeMask = 1;
+    heapProps.VisibleNodeMask = 1;
+
+    D3D12_RESOURCE_DESC uploadDesc;
+    _initBufferResourceDesc(size, uploadDesc);
+
+    SLANG_RETURN_ON_FAIL(outFallback.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, uploadDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr));
+
+    const D3D12_RANGE readRange = {};
+    uint8_t* data = nullptr;
+    SLANG_RETURN_ON_FAIL(outFallback.getResource()->Map(0, &readRange, reinterpret_cast<void**>(&data)));
+
+    outAllocation.m_resource = outFallback;
+    outAllocation.m_offset = 0;
+    outAllocation.m_data = data;
+    return SLANG_OK;
+}
+
 void D3D12Renderer::_resetCommandList()
 {
     const FrameInfo& frame = getFrame();
@@ -812,6 +1112,7 @@ void D3D12Renderer::beginRender()
     assert(m_commandListOpenCount == 0);
 
     m_circularResourceHeap.updateCompleted();
+    m_uploadRing.updateCompleted(m_fence.getCompletedValue());
 
     getFrame().m_commandAllocator->Reset();
 
@@ -830,11 +1131,6 @@ void D3D12Renderer::endRender()
 {
     assert(m_commandListOpenCount == 1);
 
-    {
-        const UInt64 signalValue = m_fence.nextSignal(m_commandQueue);
-        m_circularResourceHeap.addSync(signalValue);
-    }
-
     D3D12Resource& backBuffer = *m_backBuffers[m_renderTargetIndex];
     if (m_isMultiSampled)
     {
@@ -865,12 +1161,24 @@ void D3D12Renderer::endRender()
         ID3D12CommandList* commandLists[] = { m_commandList };
         m_commandQueue->ExecuteCommandLists(SLANG_COUNT_OF(commandLists), commandLists);
     }
+    _addHeapSync();
 
     assert(m_commandListOpenCount == 1);
     // Must be 0
     m_commandListOpenCount = 0;
 }
 
+void D3D12Renderer::_addHeapSync()
+{
+    // The descriptor tables copied into the shader visible heaps, and the upload memory copied from, can be reused
+    // once the commands just submitted complete
+    const UInt64 signalValue = m_fence.nextSignal(m_commandQueue);
+    m_viewHeap.addSync(signalValue);
+    m_samplerHeap.addSync(signalValue);
+    m_circularResourceHeap.addSync(signalValue);
+    m_uploadRing.addSync(signalValue);
+}
+
 void D3D12Renderer::submitGpuWork()
 {
     assert(m_commandListOpenCount);
@@ -882,6 +1190,7 @@ void D3D12Renderer::submitGpuWork()
         ID3D12CommandList* commandLists[] = { commandList };
         m_commandQueue->ExecuteCommandLists(SLANG_COUNT_OF(commandLists), commandLists);
     }
+    _addHeapSync();
 
     // Reset the render target
     _resetCommandList();
@@ -1237,11 +1546,10 @@ Result D3D12Renderer::_calcBindParameters(BindParameters& params)
 }
 #endif
 
-Result D3D12Renderer::_bindRenderState(PipelineStateImpl* pipelineStateImpl, ID3D12GraphicsCommandList* commandList, Submitter* submitter)
+Result D3D12Renderer::_bindRenderState(PipelineStateImpl* pipelineStateImpl, const RefPtr<DescriptorSetImpl>* descriptorSets, D3D12RingDescriptorHeap& viewHeap, D3D12RingDescriptorHeap& samplerHeap, ID3D12GraphicsCommandList* commandList, Submitter* submitter)
 {
     // TODO: we should only set some of this state as needed...
 
-    auto pipelineTypeIndex = (int) pipelineStateImpl->m_pipelineType;
     auto pipelineLayout = pipelineStateImpl->m_pipelineLayout;
 
     submitter->setRootSignature(pipelineLayout->m_rootSignature);
@@ -1249,8 +1557,8 @@ Result D3D12Renderer::_bindRenderState(PipelineStateImpl* pipelineStateImpl, ID3
 
     ID3D12DescriptorHeap* heaps[] =
     {
-        m_viewHeap.getHeap(),
-        m_samplerHeap.getHeap(),
+        m_desc.bindless ? m_bindlessViewHeap.getHeap() : viewHeap.getHeap(),
+        m_desc.bindless ? m_bindlessSamplerHeap.getHeap() : samplerHeap.getHeap(),
     };
     commandList->SetDescriptorHeaps(SLANG_COUNT_OF(heaps), heaps);
 
@@ -1262,17 +1570,35 @@ Result D3D12Renderer::_bindRenderState(PipelineStateImpl* pipelineStateImpl, ID3
     Int rootParameterIndex = 0;
     for(Int dd = 0; dd < descriptorSetCount; ++dd)
     {
-        auto descriptorSet = m_boundDescriptorSets[pipelineTypeIndex][dd];
+        auto descriptorSet = descriptorSets[dd];
         auto descriptorSetLayout = descriptorSet->m_layout;
 
         // TODO: require that `descriptorSetLayout` is compatible with
         // `pipelineLayout->descriptorSetlayouts[dd]`.
 
+        if (descriptorSet->m_isShaderVisible)
+        {
+            // The tables are already in the bound heaps
+            if (descriptorSetLayout->m_resourceCount)
+            {
+                submitter->setRootDescriptorTable(int(rootParameterIndex++), descriptorSet->m_resourceHeap->getGpuHandle(int(descriptorSet->m_resourceTable)));
+            }
+            if (descriptorSetLayout->m_samplerCount)
+            {
+                submitter->setRootDescriptorTable(int(rootParameterIndex++), descriptorSet->m_samplerHeap->getGpuHandle(int(descriptorSet->m_samplerTable)));
+            }
+            continue;
+        }
+
         {
             if(auto descriptorCount = descriptorSetLayout->m_resourceCount)
             {
-                auto& gpuHeap = m_viewHeap;
+                auto& gpuHeap = viewHeap;
                 auto gpuDescriptorTable = gpuHeap.allocate(int(descriptorCount));
+                if (gpuDescriptorTable < 0)
+                {
+                    return SLANG_E_OUT_OF_MEMORY;
+                }
 
                 auto& cpuHeap = *descriptorSet->m_resourceHeap;
                 auto cpuDescriptorTable = descriptorSet->m_resourceTable;
@@ -1289,8 +1615,12 @@ Result D3D12Renderer::_bindRenderState(PipelineStateImpl* pipelineStateImpl, ID3
         {
             if(auto descriptorCount = descriptorSetLayout->m_samplerCount)
             {
-                auto& gpuHeap = m_samplerHeap;
+                auto& gpuHeap = samplerHeap;
                 auto gpuDescriptorTable = gpuHeap.allocate(int(descriptorCount));
+                if (gpuDescriptorTable < 0)
+                {
+                    return SLANG_E_OUT_OF_MEMORY;
+                }
 
                 auto& cpuHeap = *descriptorSet->m_samplerHeap;
                 auto cpuDescriptorTable = descriptorSet->m_samplerTable;
@@ -1510,6 +1840,12 @@ Result D3D12Renderer::initialize(const Desc& desc, void* inWindowHandle)
             if (SLANG_SUCCEEDED(m_device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &options, sizeof(options))))
             {
                 auto minPrecisionSupport = options.MinPrecisionSupport;
+                // Tier 1 needs buffers and the kinds of texture placed in different heaps
+                m_heapAllocator.init(m_device, options.ResourceHeapTier);
+            }
+            else
+            {
+                m_heapAllocator.init(m_device, D3D12_RESOURCE_HEAP_TIER_1);
             }
         }
     }
@@ -1519,6 +1855,8 @@ Result D3D12Renderer::initialize(const Desc& desc, void* inWindowHandle)
 
     m_desc = desc;
 
+    _initPipelineLibrary();
+
     // set viewport
     {
         m_viewport.Width = float(m_desc.width);
@@ -1543,6 +1881,15 @@ Result D3D12Renderer::initialize(const Desc& desc, void* inWindowHandle)
 
     SLANG_RETURN_ON_FAIL(m_device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(m_commandQueue.writeRef())));
 
+    {
+        D3D12_COMMAND_QUEUE_DESC computeQueueDesc = {};
+        computeQueueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+        computeQueueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+
+        SLANG_RETURN_ON_FAIL(m_device->CreateCommandQueue(&computeQueueDesc, IID_PPV_ARGS(m_computeQueue.writeRef())));
+        SLANG_RETURN_ON_FAIL(m_computeFence.init(m_device));
+    }
+
     // Describe the swap chain.
     DXGI_SWAP_CHAIN_DESC swapChainDesc = {};
     swapChainDesc.BufferCount = m_numRenderTargets;
@@ -1591,12 +1938,19 @@ Result D3D12Renderer::initialize(const Desc& desc, void* inWindowHandle)
 
     // Create descriptor heaps.
 
-    SLANG_RETURN_ON_FAIL(m_viewHeap.init   (m_device, 256, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
-    SLANG_RETURN_ON_FAIL(m_samplerHeap.init(m_device, 16,  D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
+    SLANG_RETURN_ON_FAIL(m_viewHeap.init   (m_device, 256, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, &m_fence));
+    SLANG_RETURN_ON_FAIL(m_samplerHeap.init(m_device, 16,  D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, &m_fence));
 
     SLANG_RETURN_ON_FAIL(m_cpuViewHeap.init   (m_device, 1024, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_NONE));
     SLANG_RETURN_ON_FAIL(m_cpuSamplerHeap.init(m_device, 64,   D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_NONE));
 
+    if (m_desc.bindless)
+    {
+        // 2048 is the most samplers a shader visible heap can hold
+        SLANG_RETURN_ON_FAIL(m_bindlessViewHeap.init   (m_device, 64 * 1024, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
+        SLANG_RETURN_ON_FAIL(m_bindlessSamplerHeap.init(m_device, 2048,      D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE));
+    }
+
     SLANG_RETURN_ON_FAIL(m_rtvAllocator.init    (m_device, 16, D3D12_DESCRIPTOR_HEAP_TYPE_RTV));
     SLANG_RETURN_ON_FAIL(m_dsvAllocator.init    (m_device, 16, D3D12_DESCRIPTOR_HEAP_TYPE_DSV));
     SLANG_RETURN_ON_FAIL(m_viewAllocator.init   (m_device, 64, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV));
@@ -1625,6 +1979,47 @@ Result D3D12Renderer::initialize(const Desc& desc, void* inWindowHandle)
         m_circularResourceHeap.init(m_device, desc, &m_fence);
     }
 
+    {
+        // The upload ring is mapped once, and stays mapped
+        D3D12_HEAP_PROPERTIES heapProps;
+        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapProps.CreationNodeMask = 1;
+        heapProps.VisibleNodeMask = 1;
+
+        D3D12_RESOURCE_DESC ringDesc;
+        _initBufferResourceDesc(kUploadRingSize, ringDesc);
+
+        SLANG_RETURN_ON_FAIL(m_uploadRingResource.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, ringDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr));
+        m_uploadRingResource.setDebugName(L"UploadRing");
+
+        const D3D12_RANGE readRange = {};
+        uint8_t* ringData = nullptr;
+        SLANG_RETURN_ON_FAIL(m_uploadRingResource.getResource()->Map(0, &readRange, reinterpret_cast<void**>(&ringData)));
+        m_uploadRing.init(ringData, kUploadRingSize);
+    }
+
+    {
+        D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+        queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+        queryHeapDesc.Count = UINT(kMaxTimestampCount);
+        SLANG_RETURN_ON_FAIL(m_device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(m_timestampQueryHeap.writeRef())));
+
+        D3D12_HEAP_PROPERTIES heapProps;
+        heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+        heapProps.CreationNodeMask = 1;
+        heapProps.VisibleNodeMask = 1;
+
+        D3D12_RESOURCE_DESC readbackDesc;
+        _initBufferResourceDesc(sizeof(uint64_t) * kMaxTimestampCount, readbackDesc);
+
+        SLANG_RETURN_ON_FAIL(m_timestampReadback.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, readbackDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr));
+        m_timestampReadback.setDebugName(L"TimestampReadback");
+    }
+
     // Setup for rendering
     beginRender();
 
@@ -1946,19 +2341,11 @@ Result D3D12Renderer::createTextureResource(Resource::Usage initialUsage, const
     resourceDesc.Layout = D3D12_TEXTURE_LAYOUT_UNKNOWN;
     resourceDesc.Alignment = 0;
 
-    RefPtr<TextureResourceImpl> texture(new TextureResourceImpl(srcDesc));
+    RefPtr<TextureResourceImpl> texture(new TextureResourceImpl(srcDesc, &m_heapAllocator));
 
     // Create the target resource
     {
-        D3D12_HEAP_PROPERTIES heapProps;
-
-        heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
-        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-        heapProps.CreationNodeMask = 1;
-        heapProps.VisibleNodeMask = 1;
-
-        SLANG_RETURN_ON_FAIL(texture->m_resource.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, resourceDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr));
+        SLANG_RETURN_ON_FAIL(m_heapAllocator.createResource(D3D12_HEAP_TYPE_DEFAULT, resourceDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, texture->m_resource, texture->m_allocation));
 
         texture->m_resource.setDebugName(L"Texture");
     }
@@ -1980,47 +2367,22 @@ Result D3D12Renderer::createTextureResource(Resource::Usage initialUsage, const
     UInt64 requiredSize = 0;
     m_device->GetCopyableFootprints(&resourceDesc, 0, numMipMaps, 0, layouts.begin(), mipNumRows.begin(), mipRowSizeInBytes.begin(), &requiredSize);
 
+    // Each array slice starts at a placement aligned offset in the upload memory
+    const size_t arraySliceSize = D3DUtil::calcAligned(size_t(requiredSize), D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
     // Sub resource indexing
     // https://msdn.microsoft.com/en-us/library/windows/desktop/dn705766(v=vs.85).aspx#subresource_indexing
     {
-        // Create the upload texture
-        D3D12Resource uploadTexture;
-       
-        {
-            D3D12_HEAP_PROPERTIES heapProps;
-
-            heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
-            heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-            heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-            heapProps.CreationNodeMask = 1;
-            heapProps.VisibleNodeMask = 1;
-
-            D3D12_RESOURCE_DESC uploadResourceDesc;
-
-            uploadResourceDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
-            uploadResourceDesc.Format = DXGI_FORMAT_UNKNOWN;
-            uploadResourceDesc.Width = requiredSize;
-            uploadResourceDesc.Height = 1;
-            uploadResourceDesc.DepthOrArraySize = 1;
-            uploadResourceDesc.MipLevels = 1;
-            uploadResourceDesc.SampleDesc.Count = 1;
-            uploadResourceDesc.SampleDesc.Quality = 0;
-            uploadResourceDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
-            uploadResourceDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
-            uploadResourceDesc.Alignment = 0;
-
-            SLANG_RETURN_ON_FAIL(uploadTexture.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, uploadResourceDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr));
-
-            uploadTexture.setDebugName(L"TextureUpload");
-        }
-        // Get the pointer to the upload resource
-        ID3D12Resource* uploadResource = uploadTexture;
+        // Copy all of the array slices into upload memory
+        D3D12Resource fallbackResource;
+        UploadAllocation upload;
+        SLANG_RETURN_ON_FAIL(_allocateUpload(arraySliceSize * arraySize, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT, fallbackResource, upload));
 
         int subResourceIndex = 0;
         for (int arrayIndex = 0; arrayIndex < arraySize; arrayIndex++)
         {
-            uint8_t* p;
-            uploadResource->Map(0, nullptr, reinterpret_cast<void**>(&p));
+            const size_t arraySliceOffset = upload.m_offset + arraySliceSize * arrayIndex;
+            uint8_t* p = upload.m_data + arraySliceSize * arrayIndex;
 
             for (int j = 0; j < numMipMaps; ++j)
             {
@@ -2029,21 +2391,23 @@ Result D3D12Renderer::createTextureResource(Resource::Usage initialUsage, const
 
                 const TextureResource::Size mipSize = srcDesc.size.calcMipSize(j);
 
-                assert(footprint.Width == mipSize.width && footprint.Height == mipSize.height && footprint.Depth == mipSize.depth);
+                // A block compressed footprint is rounded up to a whole number of blocks
+                assert(footprint.Width >= UINT(mipSize.width) && footprint.Height >= UINT(mipSize.height) && footprint.Depth == UINT(mipSize.depth));
 
                 const ptrdiff_t dstMipRowPitch = ptrdiff_t(layouts[j].Footprint.RowPitch);
                 const ptrdiff_t srcMipRowPitch = ptrdiff_t(initData->mipRowStrides[j]);
 
                 assert(dstMipRowPitch >= srcMipRowPitch);
 
-                const uint8_t* srcRow = (const uint8_t*)initData->subResources[subResourceIndex];
+                const uint8_t* srcRow = (const uint8_t*)initData->subResources[subResourceIndex + j];
                 uint8_t* dstRow = p + layouts[j].Offset;
 
                 // Copy the depth each mip
                 for (int l = 0; l < mipSize.depth; l++)
                 {
-                    // Copy rows
-                    for (int k = 0; k < mipSize.height; ++k)
+                    // Copy rows (of blocks, for a block compressed format)
+                    const int numRows = int(mipNumRows[j]);
+                    for (int k = 0; k < numRows; ++k)
                     {
                         ::memcpy(dstRow, srcRow, srcMipRowPitch);
 
@@ -2054,16 +2418,16 @@ Result D3D12Renderer::createTextureResource(Resource::Usage initialUsage, const
 
                 //assert(srcRow == (const uint8_t*)(srcMip.getBuffer() + srcMip.getCount()));
             }
-            uploadResource->Unmap(0, nullptr);
 
             for (int mipIndex = 0; mipIndex < numMipMaps; ++mipIndex)
             {
                 // https://msdn.microsoft.com/en-us/library/windows/desktop/dn903862(v=vs.85).aspx
 
                 D3D12_TEXTURE_COPY_LOCATION src;
-                src.pResource = uploadTexture;
+                src.pResource = upload.m_resource;
                 src.Type = D3D12_TEXTURE_COPY_TYPE_PLACED_FOOTPRINT;
                 src.PlacedFootprint = layouts[mipIndex];
+                src.PlacedFootprint.Offset += arraySliceOffset;
 
                 D3D12_TEXTURE_COPY_LOCATION dst;
                 dst.pResource = texture->m_resource;
@@ -2073,8 +2437,11 @@ Result D3D12Renderer::createTextureResource(Resource::Usage initialUsage, const
 
                 subResourceIndex++;
             }
+        }
 
-            // Block - waiting for copy to complete (so can drop upload texture)
+        // The upload ring keeps the data until the copies are done, but a fallback resource only lives until the end of scope
+        if (fallbackResource.isSet())
+        {
             submitGpuWorkAndWait();
         }
     }
@@ -2103,7 +2470,7 @@ Result D3D12Renderer::createBufferResource(Resource::Usage initialUsage, const B
     //
     const size_t alignedSizeInBytes = D3DUtil::calcAligned(srcDesc.sizeInBytes, 256);
 
-    RefPtr<BufferResourceImpl> buffer(new BufferResourceImpl(initialUsage, srcDesc));
+    RefPtr<BufferResourceImpl> buffer(new BufferResourceImpl(initialUsage, srcDesc, &m_heapAllocator));
 
     // Save the style
     buffer->m_backingStyle = BufferResourceImpl::_calcResourceBackingStyle(initialUsage);
@@ -2130,7 +2497,7 @@ Result D3D12Renderer::createBufferResource(Resource::Usage initialUsage, const B
         case Style::ResourceBacked:
         {
             const D3D12_RESOURCE_STATES initialState = _calcResourceState(initialUsage);
-            SLANG_RETURN_ON_FAIL(createBuffer(bufferDesc, initData, srcDesc.sizeInBytes, buffer->m_uploadResource, initialState, buffer->m_resource));
+            SLANG_RETURN_ON_FAIL(createBuffer(bufferDesc, initData, srcDesc.sizeInBytes, initialState, buffer->m_resource, buffer->m_allocation));
             break;
         }
         default:
@@ -2222,6 +2589,12 @@ static D3D12_COMPARISON_FUNC translateComparisonFunc(ComparisonFunc func)
 
 Result D3D12Renderer::createSamplerState(SamplerState::Desc const& desc, SamplerState** outSampler)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getSamplerStateKey(desc);
+    if (m_objectCache.find(key, outSampler))
+    {
+        return SLANG_OK;
+    }
+
     D3D12_FILTER_REDUCTION_TYPE dxReduction = translateFilterReduction(desc.reductionOp);
     D3D12_FILTER dxFilter;
     if (desc.maxAnisotropy > 1)
@@ -2252,7 +2625,7 @@ Result D3D12Renderer::createSamplerState(SamplerState::Desc const& desc, Sampler
 
     auto samplerHeap = &m_cpuSamplerHeap;
 
-    int indexInSamplerHeap = samplerHeap->allocate();
+    int indexInSamplerHeap = samplerHeap->allocate(1);
     if(indexInSamplerHeap < 0)
     {
         // We ran out of room in our CPU sampler heap.
@@ -2267,12 +2640,11 @@ Result D3D12Renderer::createSamplerState(SamplerState::Desc const& desc, Sampler
 
     m_device->CreateSampler(&dxDesc, cpuDescriptorHandle);
 
-    // TODO: We really ought to have a free-list of sampler-heap
-    // entries that we check before we go to the heap, and then
-    // when we are done with a sampler we simply add it to the free list.
-    //
     RefPtr<SamplerStateImpl> samplerImpl = new SamplerStateImpl();
     samplerImpl->m_cpuHandle = cpuDescriptorHandle;
+    samplerImpl->m_heap = samplerHeap;
+    samplerImpl->m_indexInHeap = indexInSamplerHeap;
+    m_objectCache.add(key, samplerImpl);
     *outSampler = samplerImpl.detach();
     return SLANG_OK;
 }
@@ -2281,6 +2653,17 @@ Result D3D12Renderer::createTextureView(TextureResource* texture, ResourceView::
 {
     auto resourceImpl = (TextureResourceImpl*) texture;
 
+    // Only non array 2D textures can have a view of some of their mips
+    const bool isMipRange = desc.mipLevel != 0 || desc.mipLevelCount != 0;
+    if (isMipRange)
+    {
+        const TextureResource::Desc& textureDesc = resourceImpl->getDesc();
+        if (resourceImpl->getType() != Resource::Type::Texture2D || textureDesc.arraySize > 1 || textureDesc.sampleDesc.numSamples > 1)
+        {
+            return SLANG_E_NOT_IMPLEMENTED;
+        }
+    }
+
     RefPtr<ResourceViewImpl> viewImpl = new ResourceViewImpl();
     viewImpl->m_resource = resourceImpl;
 
@@ -2308,8 +2691,13 @@ Result D3D12Renderer::createTextureView(TextureResource* texture, ResourceView::
             // TODO: need to support the separate "counter resource" for the case
             // of append/consume buffers with attached counters.
 
+            D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+            uavDesc.Format = resourceImpl->m_resource.getResource()->GetDesc().Format;
+            uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+            uavDesc.Texture2D.MipSlice = UINT(desc.mipLevel);
+
             SLANG_RETURN_ON_FAIL(m_viewAllocator.allocate(&viewImpl->m_descriptor));
-            m_device->CreateUnorderedAccessView(resourceImpl->m_resource, nullptr, nullptr, viewImpl->m_descriptor.cpuHandle);
+            m_device->CreateUnorderedAccessView(resourceImpl->m_resource, nullptr, isMipRange ? &uavDesc : nullptr, viewImpl->m_descriptor.cpuHandle);
         }
         break;
 
@@ -2324,6 +2712,11 @@ Result D3D12Renderer::createTextureView(TextureResource* texture, ResourceView::
 
             D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc;
             _initSrvDesc(resourceImpl->getType(), resourceImpl->getDesc(), resourceDesc, pixelFormat, srvDesc);
+            if (isMipRange)
+            {
+                srvDesc.Texture2D.MostDetailedMip = UINT(desc.mipLevel);
+                srvDesc.Texture2D.MipLevels = desc.mipLevelCount ? UINT(desc.mipLevelCount) : UINT(-1);
+            }
 
             m_device->CreateShaderResourceView(resourceImpl->m_resource, &srvDesc, viewImpl->m_descriptor.cpuHandle);
         }
@@ -2415,6 +2808,12 @@ Result D3D12Renderer::createBufferView(BufferResource* buffer, ResourceView::Des
 
 Result D3D12Renderer::createInputLayout(const InputElementDesc* inputElements, UInt inputElementCount, InputLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getInputLayoutKey(inputElements, inputElementCount);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<InputLayoutImpl> layout(new InputLayoutImpl);
 
     // Work out a buffer size to hold all text
@@ -2456,6 +2855,8 @@ Result D3D12Renderer::createInputLayout(const InputElementDesc* inputElements, U
         dstEle.InstanceDataStepRate = 0;
     }
 
+    m_objectCache.add(key, layout);
+
     *outLayout = layout.detach();
     return SLANG_OK;
 }
@@ -2476,9 +2877,40 @@ void* D3D12Renderer::map(BufferResource* bufferIn, MapFlavor flavor)
             // We need this in a state so we can upload
             switch (flavor)
             {
-                case MapFlavor::HostWrite:
                 case MapFlavor::WriteDiscard:
                 {
+                    // The contents are written to the upload ring, and copied into the buffer on unmap. Buffers too
+                    // large for the ring are handled like HostWrite.
+                    if (bufferSize <= m_uploadRing.getSize())
+                    {
+                        D3D12Resource fallbackResource;
+                        UploadAllocation upload;
+                        SLANG_RETURN_NULL_ON_FAIL(_allocateUpload(bufferSize, kBufferUploadAlignment, fallbackResource, upload));
+                        assert(!fallbackResource.isSet());
+
+                        buffer->m_mapUploadOffset = upload.m_offset;
+                        return upload.m_data;
+                    }
+                    buffer->m_mapFlavor = MapFlavor::HostWrite;
+                    // Fall through
+                }
+                case MapFlavor::HostWrite:
+                {
+                    if (!buffer->m_uploadResource.isSet())
+                    {
+                        D3D12_HEAP_PROPERTIES heapProps;
+                        heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+                        heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+                        heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+                        heapProps.CreationNodeMask = 1;
+                        heapProps.VisibleNodeMask = 1;
+
+                        D3D12_RESOURCE_DESC uploadDesc(buffer->m_resource.getResource()->GetDesc());
+                        uploadDesc.Flags = D3D12_RESOURCE_FLAG_NONE;
+
+                        SLANG_RETURN_NULL_ON_FAIL(buffer->m_uploadResource.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, uploadDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr));
+                    }
+
                     D3D12BarrierSubmitter submitter(m_commandList);
                     buffer->m_uploadResource.transition(D3D12_RESOURCE_STATE_GENERIC_READ, submitter);
                     buffer->m_resource.transition(D3D12_RESOURCE_STATE_COPY_DEST, submitter);
@@ -2493,55 +2925,20 @@ void* D3D12Renderer::map(BufferResource* bufferIn, MapFlavor flavor)
                 }
                 case MapFlavor::HostRead:
                 {
-                    // This will be slow!!! - it blocks CPU on GPU completion
-                    D3D12Resource& resource = buffer->m_resource;
-
-                    // Readback heap
-                    D3D12_HEAP_PROPERTIES heapProps;
-                    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
-                    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
-                    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
-                    heapProps.CreationNodeMask = 1;
-                    heapProps.VisibleNodeMask = 1;
-
-                    // Resource to readback to
-                    D3D12_RESOURCE_DESC stagingDesc;
-                    _initBufferResourceDesc(bufferSize, stagingDesc);
-
-                    D3D12Resource stageBuf;
-                    SLANG_RETURN_NULL_ON_FAIL(stageBuf.initCommitted(m_device, heapProps, D3D12_HEAP_FLAG_NONE, stagingDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr));
-
-                    const D3D12_RESOURCE_STATES initialState = resource.getState();
-
-                    // Make it a source
+                    // This will be slow!!! - it blocks CPU on GPU completion. readBuffers can read many buffers
+                    // without blocking.
+                    BufferResource* buffers[] = { buffer };
+                    RefPtr<BufferReadback> readback;
+                    SLANG_RETURN_NULL_ON_FAIL(readBuffers(SLANG_COUNT_OF(buffers), buffers, readback.writeRef()));
+                    const void* data = readback->getData(0);
+                    if (!data)
                     {
-                        D3D12BarrierSubmitter submitter(m_commandList);
-                        resource.transition(D3D12_RESOURCE_STATE_COPY_SOURCE, submitter);
-                    }
-                    // Do the copy
-                    m_commandList->CopyBufferRegion(stageBuf, 0, resource, 0, bufferSize);
-                    // Switch it back
-                    {
-                        D3D12BarrierSubmitter submitter(m_commandList);
-                        resource.transition(initialState, submitter);
+                        return nullptr;
                     }
 
-                    // Wait until complete
-                    submitGpuWorkAndWait();
-
-                    // Map and copy
-                    {
-                        UINT8* data;
-                        D3D12_RANGE readRange = { 0, bufferSize };
-
-                        SLANG_RETURN_NULL_ON_FAIL(stageBuf.getResource()->Map(0, &readRange, reinterpret_cast<void**>(&data)));
-
-                        // Copy to memory buffer
-                        buffer->m_memory.setCount(bufferSize);
-                        ::memcpy(buffer->m_memory.getBuffer(), data, bufferSize);
-
-                        stageBuf.getResource()->Unmap(0, nullptr);
-                    }
+                    // Copy to memory buffer, so the readback heap can be reused
+                    buffer->m_memory.setCount(bufferSize);
+                    ::memcpy(buffer->m_memory.getBuffer(), data, bufferSize);
 
                     return buffer->m_memory.getBuffer();
                 }
@@ -2575,8 +2972,24 @@ void D3D12Renderer::unmap(BufferResource* bufferIn)
             // We need this in a state so we can upload
             switch (buffer->m_mapFlavor)
             {
-                case MapFlavor::HostWrite:
                 case MapFlavor::WriteDiscard:
+                {
+                    const D3D12_RESOURCE_STATES initialState = buffer->m_resource.getState();
+
+                    {
+                        D3D12BarrierSubmitter submitter(m_commandList);
+                        buffer->m_resource.transition(D3D12_RESOURCE_STATE_COPY_DEST, submitter);
+                    }
+
+                    m_commandList->CopyBufferRegion(buffer->m_resource, 0, m_uploadRingResource, buffer->m_mapUploadOffset, buffer->getDesc().sizeInBytes);
+
+                    {
+                        D3D12BarrierSubmitter submitter(m_commandList);
+                        buffer->m_resource.transition(initialState, submitter);
+                    }
+                    break;
+                }
+                case MapFlavor::HostWrite:
                 {
                     // Unmap
                     ID3D12Resource* uploadResource = buffer->m_uploadResource;
@@ -2730,7 +3143,7 @@ void D3D12Renderer::draw(UInt vertexCount, UInt startVertex)
     // Submit - setting for graphics
     {
         GraphicsSubmitter submitter(commandList);
-        _bindRenderState(pipelineState, commandList, &submitter);
+        _bindRenderState(pipelineState, m_boundDescriptorSets[int(PipelineType::Graphics)], m_viewHeap, m_samplerHeap, commandList, &submitter);
     }
 
     commandList->IASetPrimitiveTopology(m_primitiveTopology);
@@ -2774,6 +3187,10 @@ void D3D12Renderer::drawIndexed(UInt indexCount, UInt startIndex, UInt baseVerte
 {
 }
 
+void D3D12Renderer::drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance)
+{
+}
+
 void D3D12Renderer::dispatchCompute(int x, int y, int z)
 {
     ID3D12GraphicsCommandList* commandList = m_commandList;
@@ -2782,12 +3199,396 @@ void D3D12Renderer::dispatchCompute(int x, int y, int z)
     // Submit binding for compute
     {
         ComputeSubmitter submitter(commandList);
-        _bindRenderState(pipelineStateImpl, commandList, &submitter);
+        _bindRenderState(pipelineStateImpl, m_boundDescriptorSets[int(PipelineType::Compute)], m_viewHeap, m_samplerHeap, commandList, &submitter);
     }
 
     commandList->Dispatch(x, y, z);
 }
 
+Result D3D12Renderer::createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer)
+{
+    RefPtr<CommandBufferImpl> commandBuffer = new CommandBufferImpl();
+    commandBuffer->m_renderer = this;
+    commandBuffer->m_queueType = queueType;
+
+    const D3D12_COMMAND_LIST_TYPE listType = (queueType == QueueType::Compute) ? D3D12_COMMAND_LIST_TYPE_COMPUTE : D3D12_COMMAND_LIST_TYPE_DIRECT;
+    // The descriptor tables are used until the queue the command buffer is submitted to has done the work
+    D3D12CounterFence* fence = (queueType == QueueType::Compute) ? &m_computeFence : &m_fence;
+
+    SLANG_RETURN_ON_FAIL(m_device->CreateCommandAllocator(listType, IID_PPV_ARGS(commandBuffer->m_commandAllocator.writeRef())));
+    SLANG_RETURN_ON_FAIL(m_device->CreateCommandList(0, listType, commandBuffer->m_commandAllocator, nullptr, IID_PPV_ARGS(commandBuffer->m_commandList.writeRef())));
+    // Command lists are created open, but are opened with begin
+    SLANG_RETURN_ON_FAIL(commandBuffer->m_commandList->Close());
+
+    if (!m_desc.bindless)
+    {
+        SLANG_RETURN_ON_FAIL(commandBuffer->m_viewHeap.init   (m_device, 256, D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, fence));
+        SLANG_RETURN_ON_FAIL(commandBuffer->m_samplerHeap.init(m_device, 16,  D3D12_DESCRIPTOR_HEAP_TYPE_SAMPLER,     D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE, fence));
+    }
+
+    *outCommandBuffer = commandBuffer.detach();
+    return SLANG_OK;
+}
+
+void D3D12Renderer::submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Keep the order the work was recorded in
+    submitGpuWork();
+
+    List<ID3D12CommandList*> commandLists;
+    commandLists.setCount(Index(count));
+
+    // Submit each run of command buffers for the same queue together
+    UInt start = 0;
+    while (start < count)
+    {
+        const QueueType queueType = static_cast<CommandBufferImpl*>(commandBuffers[start])->m_queueType;
+        UInt end = start + 1;
+        while (end < count && static_cast<CommandBufferImpl*>(commandBuffers[end])->m_queueType == queueType)
+        {
+            end++;
+        }
+
+        ID3D12CommandQueue* queue = (queueType == QueueType::Compute) ? m_computeQueue : m_commandQueue;
+        D3D12CounterFence& fence = (queueType == QueueType::Compute) ? m_computeFence : m_fence;
+
+        // Work on the compute queue waits for everything submitted before it. In a single submit a run of graphics
+        // work also waits for the compute work before it, to keep the order.
+        if (queueType == QueueType::Compute)
+        {
+            waitForQueue(QueueType::Compute, QueueType::Graphics);
+        }
+        else if (start > 0)
+        {
+            waitForQueue(QueueType::Graphics, QueueType::Compute);
+        }
+
+        for (UInt i = start; i < end; ++i)
+        {
+            commandLists[Index(i - start)] = static_cast<CommandBufferImpl*>(commandBuffers[i])->m_commandList;
+        }
+        queue->ExecuteCommandLists(UINT(end - start), commandLists.getBuffer());
+
+        const UInt64 signalValue = fence.nextSignal(queue);
+        if (!m_desc.bindless)
+        {
+            for (UInt i = start; i < end; ++i)
+            {
+                auto commandBuffer = static_cast<CommandBufferImpl*>(commandBuffers[i]);
+                commandBuffer->m_viewHeap.addSync(signalValue);
+                commandBuffer->m_samplerHeap.addSync(signalValue);
+            }
+        }
+
+        start = end;
+    }
+}
+
+void D3D12Renderer::waitForQueue(QueueType queue, QueueType waitQueue)
+{
+    if (queue == waitQueue)
+    {
+        return;
+    }
+
+    if (waitQueue == QueueType::Compute)
+    {
+        // The compute fence is signaled after every submission, so just wait for the last one
+        const UInt64 computeValue = m_computeFence.getCurrentValue();
+        if (computeValue)
+        {
+            m_commandQueue->Wait(m_computeFence.getFence(), computeValue);
+        }
+    }
+    else
+    {
+        const UInt64 graphicsValue = m_fence.nextSignal(m_commandQueue);
+        m_computeQueue->Wait(m_fence.getFence(), graphicsValue);
+    }
+}
+
+Result D3D12Renderer::writeTimestamp(UInt index)
+{
+    if (index >= kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    m_commandList->EndQuery(m_timestampQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, UINT(index));
+    return SLANG_OK;
+}
+
+Result D3D12Renderer::getTimestamps(UInt index, UInt count, uint64_t* outTimestamps)
+{
+    if (index + count > kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    if (count == 0)
+    {
+        return SLANG_OK;
+    }
+
+    // Timestamps may have been written on the compute queue, so those have to be done before the resolve
+    waitForQueue(QueueType::Graphics, QueueType::Compute);
+
+    const UInt64 offset = sizeof(uint64_t) * index;
+    m_commandList->ResolveQueryData(m_timestampQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, UINT(index), UINT(count), m_timestampReadback, offset);
+
+    submitGpuWorkAndWait();
+
+    const D3D12_RANGE readRange = { SIZE_T(offset), SIZE_T(offset + sizeof(uint64_t) * count) };
+    uint8_t* data = nullptr;
+    SLANG_RETURN_ON_FAIL(m_timestampReadback.getResource()->Map(0, &readRange, reinterpret_cast<void**>(&data)));
+    ::memcpy(outTimestamps, data + offset, sizeof(uint64_t) * count);
+
+    const D3D12_RANGE writtenRange = {};
+    m_timestampReadback.getResource()->Unmap(0, &writtenRange);
+    return SLANG_OK;
+}
+
+Result D3D12Renderer::_allocateReadbackHeap(size_t size, RefPtr<ReadbackHeap>& outHeap)
+{
+    // Use the smallest free heap that is large enough
+    Index bestIndex = -1;
+    for (Index i = 0; i < m_freeReadbackHeaps.getCount(); ++i)
+    {
+        const size_t heapSize = m_freeReadbackHeaps[i]->m_size;
+        if (heapSize >= size && (bestIndex < 0 || heapSize < m_freeReadbackHeaps[bestIndex]->m_size))
+        {
+            bestIndex = i;
+        }
+    }
+    if (bestIndex >= 0)
+    {
+        outHeap = m_freeReadbackHeaps[bestIndex];
+        m_freeReadbackHeaps.fastRemoveAt(bestIndex);
+        return SLANG_OK;
+    }
+
+    // Round up to a power of 2, so heaps can be reused for readbacks of similar sizes
+    size_t heapSize = 64 * 1024;
+    while (heapSize < size)
+    {
+        heapSize *= 2;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps;
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+    heapProps.CreationNodeMask = 1;
+    heapProps.VisibleNodeMask = 1;
+
+    D3D12_RESOURCE_DESC resourceDesc;
+    _initBufferResourceDesc(heapSize, resourceDesc);
+
+    RefPtr<ReadbackHeap> heap = new ReadbackHeap;
+    heap->m_size = heapSize;
+    // Buffers in a readback heap are always in the copy dest state
+    SLANG_RETURN_ON_FAIL(m_device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE, &resourceDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(heap->m_resource.writeRef())));
+
+    outHeap = heap;
+    return SLANG_OK;
+}
+
+Result D3D12Renderer::readBuffers(UInt count, BufferResource*const* buffers, BufferReadback** outReadback)
+{
+    RefPtr<BufferReadbackImpl> readback = new BufferReadbackImpl;
+    readback->m_renderer = this;
+
+    // Place the contents one after another
+    size_t totalSize = 0;
+    for (UInt i = 0; i < count; ++i)
+    {
+        BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[i]);
+
+        BufferReadbackImpl::Entry entry;
+        entry.m_offset = totalSize;
+        if (buffer->m_backingStyle == BufferResourceImpl::BackingStyle::MemoryBacked)
+        {
+            entry.m_memoryBuffer = buffer;
+        }
+        else
+        {
+            totalSize += (buffer->getDesc().sizeInBytes + kBufferUploadAlignment - 1) & ~(kBufferUploadAlignment - 1);
+        }
+        readback->m_entries.add(entry);
+    }
+
+    if (totalSize == 0)
+    {
+        // Nothing to copy
+        *outReadback = readback.detach();
+        return SLANG_OK;
+    }
+
+    SLANG_RETURN_ON_FAIL(_allocateReadbackHeap(totalSize, readback->m_heap));
+    ID3D12Resource* heapResource = readback->m_heap->m_resource;
+
+    // Transition all of the buffers, copy, and transition back, so there are only two sets of barriers
+    List<D3D12_RESOURCE_STATES> initialStates;
+    initialStates.setCount(Index(count));
+    {
+        D3D12BarrierSubmitter submitter(m_commandList);
+        for (UInt i = 0; i < count; ++i)
+        {
+            BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[i]);
+            if (!readback->m_entries[Index(i)].m_memoryBuffer)
+            {
+                initialStates[Index(i)] = buffer->m_resource.getState();
+                buffer->m_resource.transition(D3D12_RESOURCE_STATE_COPY_SOURCE, submitter);
+            }
+        }
+    }
+    for (UInt i = 0; i < count; ++i)
+    {
+        BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[i]);
+        const BufferReadbackImpl::Entry& entry = readback->m_entries[Index(i)];
+        if (!entry.m_memoryBuffer)
+        {
+            m_commandList->CopyBufferRegion(heapResource, entry.m_offset, buffer->m_resource, 0, buffer->getDesc().sizeInBytes);
+        }
+    }
+    {
+        D3D12BarrierSubmitter submitter(m_commandList);
+        for (UInt i = 0; i < count; ++i)
+        {
+            BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[i]);
+            if (!readback->m_entries[Index(i)].m_memoryBuffer)
+            {
+                buffer->m_resource.transition(initialStates[Index(i)], submitter);
+            }
+        }
+    }
+
+    // Submit, so the copies are done without anything having to wait. The signal made after submitting is reached
+    // when they are complete.
+    submitGpuWork();
+    readback->m_fenceValue = m_fence.getCurrentValue();
+
+    *outReadback = readback.detach();
+    return SLANG_OK;
+}
+
+bool D3D12Renderer::BufferReadbackImpl::isComplete()
+{
+    return m_data || m_renderer->m_fence.getCompletedValue() >= m_fenceValue;
+}
+
+const void* D3D12Renderer::BufferReadbackImpl::getData(UInt index)
+{
+    const Entry& entry = m_entries[Index(index)];
+    if (entry.m_memoryBuffer)
+    {
+        return entry.m_memoryBuffer->m_memory.getBuffer();
+    }
+
+    if (!m_data)
+    {
+        m_renderer->m_fence.waitUntilCompleted(m_fenceValue);
+
+        const D3D12_RANGE readRange = { 0, SIZE_T(m_heap->m_size) };
+        SLANG_RETURN_NULL_ON_FAIL(m_heap->m_resource->Map(0, &readRange, reinterpret_cast<void**>(&m_data)));
+    }
+    return m_data + entry.m_offset;
+}
+
+D3D12Renderer::BufferReadbackImpl::~BufferReadbackImpl()
+{
+    if (m_data)
+    {
+        const D3D12_RANGE writtenRange = {};
+        m_heap->m_resource->Unmap(0, &writtenRange);
+    }
+    if (m_heap)
+    {
+        // The GPU may still be copying into the heap, but it's only reused for copies submitted after
+        m_renderer->m_freeReadbackHeaps.add(m_heap);
+    }
+}
+
+uint64_t D3D12Renderer::getTimestampFrequency()
+{
+    UINT64 frequency = 0;
+    if (SLANG_FAILED(m_commandQueue->GetTimestampFrequency(&frequency)))
+    {
+        return 0;
+    }
+    return frequency;
+}
+
+Result D3D12Renderer::CommandBufferImpl::begin()
+{
+    m_pipelineState.setNull();
+    for (auto& descriptorSet : m_descriptorSets)
+    {
+        descriptorSet.setNull();
+    }
+    m_result = SLANG_OK;
+
+    SLANG_RETURN_ON_FAIL(m_commandAllocator->Reset());
+    SLANG_RETURN_ON_FAIL(m_commandList->Reset(m_commandAllocator, nullptr));
+    return SLANG_OK;
+}
+
+void D3D12Renderer::CommandBufferImpl::setPipelineState(PipelineState* state)
+{
+    m_pipelineState = static_cast<PipelineStateImpl*>(state);
+}
+
+void D3D12Renderer::CommandBufferImpl::setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet)
+{
+    SLANG_UNUSED(layout);
+    m_descriptorSets[index] = static_cast<DescriptorSetImpl*>(descriptorSet);
+}
+
+void D3D12Renderer::CommandBufferImpl::dispatchCompute(int x, int y, int z)
+{
+    if (!m_pipelineState || m_pipelineState->m_pipelineType != PipelineType::Compute)
+    {
+        assert(!"No compute pipeline state set");
+        m_result = SLANG_FAIL;
+        return;
+    }
+
+    ComputeSubmitter submitter(m_commandList);
+    const Result res = m_renderer->_bindRenderState(m_pipelineState, m_descriptorSets, m_viewHeap, m_samplerHeap, m_commandList, &submitter);
+    if (SLANG_FAILED(res))
+    {
+        if (SLANG_SUCCEEDED(m_result))
+        {
+            m_result = res;
+        }
+        return;
+    }
+
+    m_commandList->Dispatch(x, y, z);
+}
+
+void D3D12Renderer::CommandBufferImpl::writeTimestamp(UInt index)
+{
+    if (index >= kMaxTimestampCount)
+    {
+        if (SLANG_SUCCEEDED(m_result))
+        {
+            m_result = SLANG_E_INVALID_ARG;
+        }
+        return;
+    }
+    m_commandList->EndQuery(m_renderer->m_timestampQueryHeap, D3D12_QUERY_TYPE_TIMESTAMP, UINT(index));
+}
+
+Result D3D12Renderer::CommandBufferImpl::end()
+{
+    SLANG_RETURN_ON_FAIL(m_commandList->Close());
+    return m_result;
+}
+
 #if 0
 BindingState* D3D12Renderer::createBindingState(const BindingState::Desc& bindingStateDesc)
 {
@@ -3038,7 +3839,7 @@ void D3D12Renderer::DescriptorSetImpl::setSampler(UInt range, UInt index, Sample
 #endif
 
     auto arrayIndex = rangeInfo.arrayIndex + index;
-    auto descriptorIndex = m_resourceTable + arrayIndex;
+    auto descriptorIndex = m_samplerTable + arrayIndex;
 
     m_samplerObjects[arrayIndex] = samplerImpl;
     dxDevice->CopyDescriptorsSimple(
@@ -3133,6 +3934,12 @@ Result D3D12Renderer::createProgram(const ShaderProgram::Desc& desc, ShaderProgr
 
 Result D3D12Renderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& desc, DescriptorSetLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getDescriptorSetLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     Int rangeCount = desc.slotRangeCount;
 
     // For our purposes, there are three main cases of descriptor ranges to consider:
@@ -3429,12 +4236,20 @@ Result D3D12Renderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc&
         }
     }
 
+    m_objectCache.add(key, descriptorSetLayoutImpl);
+
     *outLayout = descriptorSetLayoutImpl.detach();
     return SLANG_OK;
 }
 
 Result D3D12Renderer::createPipelineLayout(const PipelineLayout::Desc& desc, PipelineLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getPipelineLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     static const UInt kMaxRanges = 16;
     static const UInt kMaxRootParameters = 32;
 
@@ -3559,7 +4374,9 @@ Result D3D12Renderer::createPipelineLayout(const PipelineLayout::Desc& desc, Pip
 
     RefPtr<PipelineLayoutImpl> pipelineLayoutImpl = new PipelineLayoutImpl();
     pipelineLayoutImpl->m_rootSignature = rootSignature;
+    pipelineLayoutImpl->m_rootSignatureHash = getHashCode64(signature->GetBufferPointer(), signature->GetBufferSize());
     pipelineLayoutImpl->m_descriptorSetCount = descriptorSetCount;
+    m_objectCache.add(key, pipelineLayoutImpl);
     *outLayout = pipelineLayoutImpl.detach();
     return SLANG_OK;
 }
@@ -3571,6 +4388,7 @@ Result D3D12Renderer::createDescriptorSet(DescriptorSetLayout* layout, Descripto
     RefPtr<DescriptorSetImpl> descriptorSetImpl = new DescriptorSetImpl();
     descriptorSetImpl->m_renderer = this;
     descriptorSetImpl->m_layout = layoutImpl;
+    descriptorSetImpl->m_isShaderVisible = m_desc.bindless;
 
     // We allocate CPU-visible descriptor tables to providing the
     // backing storage for each descriptor set. GPU-visible storage
@@ -3581,18 +4399,28 @@ Result D3D12Renderer::createDescriptorSet(DescriptorSetLayout* layout, Descripto
     Int resourceCount = layoutImpl->m_resourceCount;
     if( resourceCount )
     {
-        auto resourceHeap = &m_cpuViewHeap;
+        auto resourceHeap = m_desc.bindless ? &m_bindlessViewHeap : &m_cpuViewHeap;
+        const int resourceTable = resourceHeap->allocate(int(resourceCount));
+        if (resourceTable < 0)
+        {
+            return SLANG_E_OUT_OF_MEMORY;
+        }
         descriptorSetImpl->m_resourceHeap = resourceHeap;
-        descriptorSetImpl->m_resourceTable = resourceHeap->allocate(int(resourceCount));
+        descriptorSetImpl->m_resourceTable = resourceTable;
         descriptorSetImpl->m_resourceObjects.setCount(resourceCount);
     }
 
     Int samplerCount = layoutImpl->m_samplerCount;
     if( samplerCount )
     {
-        auto samplerHeap = &m_cpuSamplerHeap;
+        auto samplerHeap = m_desc.bindless ? &m_bindlessSamplerHeap : &m_cpuSamplerHeap;
+        const int samplerTable = samplerHeap->allocate(int(samplerCount));
+        if (samplerTable < 0)
+        {
+            return SLANG_E_OUT_OF_MEMORY;
+        }
         descriptorSetImpl->m_samplerHeap = samplerHeap;
-        descriptorSetImpl->m_samplerTable = samplerHeap->allocate(int(samplerCount));
+        descriptorSetImpl->m_samplerTable = samplerTable;
         descriptorSetImpl->m_samplerObjects.setCount(samplerCount);
     }
 
@@ -3687,8 +4515,24 @@ Result D3D12Renderer::createGraphicsPipelineState(const GraphicsPipelineStateDes
 
     psoDesc.PrimitiveTopologyType = m_primitiveTopologyType;
 
+    // The key for the pipeline library. The rasterizer, blend and depth stencil states are always the same, so
+    // only the parts of the desc that can vary are hashed.
+    HashCode64 key = pipelineLayoutImpl->m_rootSignatureHash;
+    key = getHashCode64(programImpl->m_vertexShader.getBuffer(), size_t(programImpl->m_vertexShader.getCount()), key);
+    key = getHashCode64(programImpl->m_pixelShader.getBuffer(), size_t(programImpl->m_pixelShader.getCount()), key);
+    for (const auto& element : inputLayoutImpl->m_elements)
+    {
+        key = getHashCode64(element.SemanticName, strlen(element.SemanticName), key);
+        const uint32_t values[] = { element.SemanticIndex, uint32_t(element.Format), element.InputSlot, element.AlignedByteOffset, uint32_t(element.InputSlotClass), element.InstanceDataStepRate };
+        key = getHashCode64(values, sizeof(values), key);
+    }
+    {
+        const uint32_t values[] = { uint32_t(psoDesc.PrimitiveTopologyType), psoDesc.NumRenderTargets, uint32_t(m_targetFormat), uint32_t(psoDesc.DSVFormat) };
+        key = getHashCode64(values, sizeof(values), key);
+    }
+
     ComPtr<ID3D12PipelineState> pipelineState;
-    SLANG_RETURN_ON_FAIL(m_device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(pipelineState.writeRef())));
+    SLANG_RETURN_ON_FAIL(_createPipelineState(key, &psoDesc, nullptr, pipelineState));
 
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl();
     pipelineStateImpl->m_pipelineType = PipelineType::Graphics;
@@ -3708,8 +4552,11 @@ Result D3D12Renderer::createComputePipelineState(const ComputePipelineStateDesc&
     computeDesc.pRootSignature = pipelineLayoutImpl->m_rootSignature;
     computeDesc.CS = { programImpl->m_computeShader.getBuffer(), SIZE_T(programImpl->m_computeShader.getCount()) };
 
+    HashCode64 key = pipelineLayoutImpl->m_rootSignatureHash;
+    key = getHashCode64(programImpl->m_computeShader.getBuffer(), size_t(programImpl->m_computeShader.getCount()), key);
+
     ComPtr<ID3D12PipelineState> pipelineState;
-    SLANG_RETURN_ON_FAIL(m_device->CreateComputePipelineState(&computeDesc, IID_PPV_ARGS(pipelineState.writeRef())));
+    SLANG_RETURN_ON_FAIL(_createPipelineState(key, nullptr, &computeDesc, pipelineState));
 
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl();
     pipelineStateImpl->m_pipelineType = PipelineType::Compute;
@@ -3,9 +3,11 @@
 
 //WORKING:#include "options.h"
 #include "render.h"
+#include "render-object-cache.h"
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "core/slang-basic.h"
 #include "core/slang-secure-crt.h"
 #include "external/stb/stb_image_write.h"
@@ -68,6 +70,16 @@
     F(glBindSampler,                PFNGLBINDSAMPLERPROC) \
     F(glTexImage3D,                 PFNGLTEXIMAGE3DPROC) \
     F(glSamplerParameteri,          PFNGLSAMPLERPARAMETERIPROC) \
+    F(glGenQueries,                 PFNGLGENQUERIESPROC) \
+    F(glQueryCounter,               PFNGLQUERYCOUNTERPROC) \
+    F(glGetQueryObjectui64v,        PFNGLGETQUERYOBJECTUI64VPROC) \
+    F(glBindBufferRange,            PFNGLBINDBUFFERRANGEPROC) \
+    F(glBufferStorage,              PFNGLBUFFERSTORAGEPROC) \
+    F(glMapBufferRange,             PFNGLMAPBUFFERRANGEPROC) \
+    F(glFenceSync,                  PFNGLFENCESYNCPROC) \
+    F(glClientWaitSync,             PFNGLCLIENTWAITSYNCPROC) \
+    F(glDeleteSync,                 PFNGLDELETESYNCPROC) \
+    F(glCompressedTexImage2D,       PFNGLCOMPRESSEDTEXIMAGE2DPROC) \
     /* end */
 
 using namespace Slang;
@@ -119,9 +131,13 @@ public:
     virtual void setPipelineState(PipelineType pipelineType, PipelineState* state) override;
     virtual void draw(UInt vertexCount, UInt startVertex) override;
     virtual void drawIndexed(UInt indexCount, UInt startIndex, UInt baseVertex) override;
+    virtual void drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance) override;
     virtual void dispatchCompute(int x, int y, int z) override;
     virtual void submitGpuWork() override {}
     virtual void waitForGpu() override {}
+    virtual Result writeTimestamp(UInt index) override;
+    virtual Result getTimestamps(UInt index, UInt count, uint64_t* outTimestamps) override;
+    virtual uint64_t getTimestampFrequency() override { return glQueryCounter ? 1000000000 : 0; }
     virtual RendererType getRendererType() const override { return RendererType::OpenGl; }
 
     protected:
@@ -129,6 +145,7 @@ public:
     {
         kMaxVertexStreams = 16,
         kMaxDescriptorSetCount = 8,
+        kDynamicBufferRegionCount = 3,          ///< Regions in a persistently mapped buffer, so the host can be 2 maps ahead of the GPU
     };
 
     struct VertexAttributeFormat
@@ -168,14 +185,32 @@ public:
 		{
 			if (m_renderer)
 			{
+                for (GLsync fence : m_regionFences)
+                {
+                    if (fence)
+                    {
+                        m_renderer->glDeleteSync(fence);
+                    }
+                }
 				m_renderer->glDeleteBuffers(1, &m_handle);
 			}
 		}
 
+            /// The offset of the region in use (always 0 if the buffer isn't persistently mapped)
+        GLintptr getCurrentOffset() const { return GLintptr(m_regionIndex * m_regionSize); }
+
         Usage m_initialUsage;
 		GLRenderer* m_renderer;
 		GLuint m_handle;
         GLenum m_target;
+
+        // A dynamic buffer created with glBufferStorage holds kDynamicBufferRegionCount copies of its contents, and
+        // is mapped for its lifetime. Each WriteDiscard map moves on to the next region, so the host never writes
+        // to a region the GPU may still be reading from without waiting on the fence recorded when it was left.
+        uint8_t* m_mappedData = nullptr;            ///< Start of all the regions, or null if not persistently mapped
+        size_t m_regionSize = 0;                    ///< Size of each region, aligned for binding as a uniform buffer
+        int m_regionIndex = 0;
+        GLsync m_regionFences[kDynamicBufferRegionCount] = {};  ///< Signaled when the GPU has finished with a region
 	};
 
     class TextureResourceImpl: public TextureResource
@@ -312,6 +347,13 @@ public:
     {
         Unknown,
         RGBA_Unorm_UInt8,
+        BC1_Unorm,
+        BC2_Unorm,
+        BC3_Unorm,
+        BC4_Unorm,
+        BC5_Unorm,
+        BC6H_UFloat16,
+        BC7_Unorm,
         CountOf,
     };
 
@@ -325,6 +367,10 @@ public:
 //	void destroyBindingEntries(const BindingState::Desc& desc, const BindingDetail* details);
 
     void bindBufferImpl(int target, UInt startSlot, UInt slotCount, BufferResource*const* buffers, const UInt* offsets);
+        /// Bind the region of buffer in use to an indexed target (or unbind if buffer is null)
+    void _bindBufferBase(GLenum target, GLuint index, BufferResourceImpl* buffer);
+        /// Wait until the GPU has signaled fence, then delete it
+    void _waitForFence(GLsync fence);
     void flushStateForDraw();
     GLuint loadShader(GLenum stage, char const* source);
     void debugCallback(GLenum source, GLenum type, GLuint id, GLenum severity, GLsizei length, const GLchar* message);
@@ -348,14 +394,21 @@ public:
     RefPtr<DescriptorSetImpl>   m_boundDescriptorSets[kMaxDescriptorSetCount];
 
     GLenum m_boundPrimitiveTopology = GL_TRIANGLES;
-    GLuint  m_boundVertexStreamBuffers[kMaxVertexStreams];
+    BufferResourceImpl* m_boundVertexStreamBuffers[kMaxVertexStreams] = {};
     UInt    m_boundVertexStreamStrides[kMaxVertexStreams];
     UInt    m_boundVertexStreamOffsets[kMaxVertexStreams];
 
+    GLuint  m_timestampQueries[kMaxTimestampCount] = {};    ///< Created the first time each index is written
+
+    bool    m_hasBufferStorage = false;             ///< True if dynamic buffers are created with glBufferStorage and persistently mapped
+    GLint   m_uniformBufferOffsetAlignment = 256;
+
     Desc m_desc;
 
     List<String> m_features;
 
+    RenderObjectCache m_objectCache;                ///< Sampler states and layouts, shared by the creates with the same desc
+
     // Declare a function pointer for each OpenGL
     // extension function we need to load
 #define DECLARE_GL_EXTENSION_FUNC(NAME, TYPE) TYPE NAME;
@@ -370,6 +423,13 @@ public:
     switch (format)
     {
         case Format::RGBA_Unorm_UInt8:      return GlPixelFormat::RGBA_Unorm_UInt8;
+        case Format::BC1_Unorm:             return GlPixelFormat::BC1_Unorm;
+        case Format::BC2_Unorm:             return GlPixelFormat::BC2_Unorm;
+        case Format::BC3_Unorm:             return GlPixelFormat::BC3_Unorm;
+        case Format::BC4_Unorm:             return GlPixelFormat::BC4_Unorm;
+        case Format::BC5_Unorm:             return GlPixelFormat::BC5_Unorm;
+        case Format::BC6H_UFloat16:         return GlPixelFormat::BC6H_UFloat16;
+        case Format::BC7_Unorm:             return GlPixelFormat::BC7_Unorm;
         default:                            return GlPixelFormat::Unknown;
     }
 }
@@ -379,6 +439,14 @@ public:
     // internalType, format, formatType
     { 0,                0,          0},                         // GlPixelFormat::Unknown
     { GL_RGBA8,         GL_RGBA,    GL_UNSIGNED_BYTE },         // GlPixelFormat::RGBA_Unorm_UInt8
+    // Compressed data has no format and type
+    { GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,         0,  0 },        // GlPixelFormat::BC1_Unorm
+    { GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,         0,  0 },        // GlPixelFormat::BC2_Unorm
+    { GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,         0,  0 },        // GlPixelFormat::BC3_Unorm
+    { GL_COMPRESSED_RED_RGTC1,                  0,  0 },        // GlPixelFormat::BC4_Unorm
+    { GL_COMPRESSED_RG_RGTC2,                   0,  0 },        // GlPixelFormat::BC5_Unorm
+    { GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT,    0,  0 },        // GlPixelFormat::BC6H_UFloat16
+    { GL_COMPRESSED_RGBA_BPTC_UNORM,            0,  0 },        // GlPixelFormat::BC7_Unorm
 };
 
 /* static */void GLRenderer::compileTimeAsserts()
@@ -435,12 +503,34 @@ void GLRenderer::bindBufferImpl(int target, UInt startSlot, UInt slotCount, Buff
         UInt slot = startSlot + ii;
 
         BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[ii]);
-        GLuint bufferID = buffer ? buffer->m_handle : 0;
 
         assert(!offsets || !offsets[ii]);
 
-        glBindBufferBase(target, (GLuint)slot, bufferID);
+        _bindBufferBase(GLenum(target), (GLuint)slot, buffer);
+    }
+}
+
+void GLRenderer::_bindBufferBase(GLenum target, GLuint index, BufferResourceImpl* buffer)
+{
+    if (buffer && buffer->m_mappedData)
+    {
+        glBindBufferRange(target, index, buffer->m_handle, buffer->getCurrentOffset(), GLsizeiptr(buffer->getDesc().sizeInBytes));
+    }
+    else
+    {
+        glBindBufferBase(target, index, buffer ? buffer->m_handle : 0);
+    }
+}
+
+void GLRenderer::_waitForFence(GLsync fence)
+{
+    // Flush on the first wait, so the fence is sure to be signaled eventually
+    GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+    while (glClientWaitSync(fence, flags, 1000 * 1000 * 1000) == GL_TIMEOUT_EXPIRED)
+    {
+        flags = 0;
     }
+    glDeleteSync(fence);
 }
 
 void GLRenderer::flushStateForDraw()
@@ -452,8 +542,10 @@ void GLRenderer::flushStateForDraw()
         auto& attr = inputLayout->m_attributes[ii];
 
         auto streamIndex = attr.streamIndex;
+        BufferResourceImpl* buffer = m_boundVertexStreamBuffers[streamIndex];
+        const GLintptr bufferOffset = buffer ? buffer->getCurrentOffset() : 0;
 
-        glBindBuffer(GL_ARRAY_BUFFER, m_boundVertexStreamBuffers[streamIndex]);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer ? buffer->m_handle : 0);
 
         glVertexAttribPointer(
             (GLuint)ii,
@@ -461,7 +553,7 @@ void GLRenderer::flushStateForDraw()
             attr.format.componentType,
             attr.format.normalized,
             (GLsizei)m_boundVertexStreamStrides[streamIndex],
-            (GLvoid*)(attr.offset + m_boundVertexStreamOffsets[streamIndex]));
+            (GLvoid*)(attr.offset + m_boundVertexStreamOffsets[streamIndex] + bufferOffset));
 
         glEnableVertexAttribArray((GLuint)ii);
     }
@@ -492,7 +584,7 @@ void GLRenderer::flushStateForDraw()
             for(Int ii = 0; ii < count; ++ii)
             {
                 auto bufferImpl = descriptorSet->m_constantBuffers[ii];
-                glBindBufferBase(GL_UNIFORM_BUFFER, GLuint(ii), bufferImpl->m_handle);
+                _bindBufferBase(GL_UNIFORM_BUFFER, GLuint(ii), bufferImpl);
             }
         }
 
@@ -697,6 +789,14 @@ SlangResult GLRenderer::initialize(const Desc& desc, void* inWindowHandle)
     MAP_GL_EXTENSION_FUNCS(LOAD_GL_EXTENSION_FUNC)
 #undef LOAD_GL_EXTENSION_FUNC
 
+    // Dynamic buffers are persistently mapped if buffer storage (core in GL 4.4) and sync objects are available
+    m_hasBufferStorage = extensions && ::strstr((const char*)extensions, "GL_ARB_buffer_storage") &&
+        glBufferStorage && glBindBufferRange && glFenceSync && glClientWaitSync && glDeleteSync;
+    if (m_hasBufferStorage)
+    {
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &m_uniformBufferOffsetAlignment);
+    }
+
     glDisable(GL_DEPTH_TEST);
     glDisable(GL_CULL_FACE);
 
@@ -759,6 +859,13 @@ Result GLRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
     const GLenum format = info.format;
     const GLenum formatType = info.formatType;
 
+    // Block compressed data can only be uploaded to a (non array) 2D texture
+    const bool isBlockCompressed = RendererUtil::isBlockCompressed(srcDesc.format);
+    if (isBlockCompressed && (srcDesc.type != Resource::Type::Texture2D || srcDesc.arraySize > 0))
+    {
+        return SLANG_FAIL;
+    }
+
     RefPtr<TextureResourceImpl> texture(new TextureResourceImpl(initialUsage, srcDesc, this));
 
     GLenum target = 0;
@@ -850,7 +957,18 @@ Result GLRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
                     glBindTexture(target, handle);
                     for (int i = 0; i < srcDesc.numMipLevels; i++)
                     {
-                        glTexImage2D(target, i, internalFormat, srcDesc.size.width, srcDesc.size.height, 0, format, formatType, data[i]);
+                        if (isBlockCompressed)
+                        {
+                            // The data must be tightly packed rows of blocks
+                            const int mipWidth = TextureResource::calcMipSize(srcDesc.size.width, i);
+                            const int mipHeight = TextureResource::calcMipSize(srcDesc.size.height, i);
+                            const int mipSize = Surface::calcRowSize(srcDesc.format, mipWidth) * Surface::calcNumRows(srcDesc.format, mipHeight);
+                            glCompressedTexImage2D(target, i, internalFormat, mipWidth, mipHeight, 0, mipSize, data[i]);
+                        }
+                        else
+                        {
+                            glTexImage2D(target, i, internalFormat, srcDesc.size.width, srcDesc.size.height, 0, format, formatType, data[i]);
+                        }
                     }
                 }
             }
@@ -918,20 +1036,52 @@ Result GLRenderer::createBufferResource(Resource::Usage initialUsage, const Buff
     glGenBuffers(1, &bufferID);
     glBindBuffer(target, bufferID);
 
-    glBufferData(target, descIn.sizeInBytes, initData, usage);
-
     RefPtr<BufferResourceImpl> resourceImpl = new BufferResourceImpl(initialUsage, desc, this, bufferID, target);
+
+    if (m_hasBufferStorage && desc.cpuAccessFlags == Resource::AccessFlag::Write)
+    {
+        // Only written by the host, so use immutable storage for all the regions, mapped once
+        const size_t alignment = size_t(m_uniformBufferOffsetAlignment);
+        const size_t regionSize = (desc.sizeInBytes + alignment - 1) / alignment * alignment;
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glBufferStorage(target, GLsizeiptr(regionSize * kDynamicBufferRegionCount), nullptr, flags);
+        void* mappedData = glMapBufferRange(target, 0, GLsizeiptr(regionSize * kDynamicBufferRegionCount), flags);
+        if (!mappedData)
+        {
+            return SLANG_FAIL;
+        }
+
+        resourceImpl->m_mappedData = (uint8_t*)mappedData;
+        resourceImpl->m_regionSize = regionSize;
+        if (initData)
+        {
+            ::memcpy(mappedData, initData, desc.sizeInBytes);
+        }
+    }
+    else
+    {
+        glBufferData(target, descIn.sizeInBytes, initData, usage);
+    }
+
     *outResource = resourceImpl.detach();
     return SLANG_OK;
 }
 
 Result GLRenderer::createSamplerState(SamplerState::Desc const& desc, SamplerState** outSampler)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getSamplerStateKey(desc);
+    if (m_objectCache.find(key, outSampler))
+    {
+        return SLANG_OK;
+    }
+
     GLuint samplerID;
     glCreateSamplers(1, &samplerID);
 
     RefPtr<SamplerStateImpl> samplerImpl = new SamplerStateImpl();
     samplerImpl->m_samplerID = samplerID;
+    m_objectCache.add(key, samplerImpl);
     *outSampler = samplerImpl.detach();
     return SLANG_OK;
 }
@@ -964,6 +1114,12 @@ Result GLRenderer::createBufferView(BufferResource* buffer, ResourceView::Desc c
 
 Result GLRenderer::createInputLayout(const InputElementDesc* inputElements, UInt inputElementCount, InputLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getInputLayoutKey(inputElements, inputElementCount);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<InputLayoutImpl> inputLayout = new InputLayoutImpl;
 
     inputLayout->m_attributeCount = inputElementCount;
@@ -977,6 +1133,8 @@ Result GLRenderer::createInputLayout(const InputElementDesc* inputElements, UInt
         glAttr.offset = (GLsizei)inputAttr.offset;
     }
 
+    m_objectCache.add(key, inputLayout);
+
     *outLayout = inputLayout.detach();
     return SLANG_OK;
 }
@@ -985,6 +1143,32 @@ void* GLRenderer::map(BufferResource* bufferIn, MapFlavor flavor)
 {
     BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(bufferIn);
 
+    if (buffer->m_mappedData)
+    {
+        // Fence the GPU's use of the current region
+        GLsync& fence = buffer->m_regionFences[buffer->m_regionIndex];
+        if (fence)
+        {
+            glDeleteSync(fence);
+        }
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+        if (flavor == MapFlavor::WriteDiscard)
+        {
+            // Move on to the next region, which will usually have been finished with long ago
+            buffer->m_regionIndex = (buffer->m_regionIndex + 1) % kDynamicBufferRegionCount;
+        }
+
+        // Writing over the contents in use (HostWrite) has to wait for the GPU, as glMapBuffer would
+        GLsync& regionFence = buffer->m_regionFences[buffer->m_regionIndex];
+        if (regionFence)
+        {
+            _waitForFence(regionFence);
+            regionFence = nullptr;
+        }
+        return buffer->m_mappedData + buffer->getCurrentOffset();
+    }
+
     //GLenum target = GL_UNIFORM_BUFFER;
 
     GLuint access = 0;
@@ -1007,6 +1191,11 @@ void* GLRenderer::map(BufferResource* bufferIn, MapFlavor flavor)
 void GLRenderer::unmap(BufferResource* bufferIn)
 {
     BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(bufferIn);
+    if (buffer->m_mappedData)
+    {
+        // Stays mapped, and coherent mapping makes the writes visible to the GPU
+        return;
+    }
     glUnmapBuffer(buffer->m_target);
 }
 
@@ -1031,9 +1220,8 @@ void GLRenderer::setVertexBuffers(UInt startSlot, UInt slotCount, BufferResource
         UInt slot = startSlot + ii;
 
         BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[ii]);
-        GLuint bufferID = buffer ? buffer->m_handle : 0;
 
-        m_boundVertexStreamBuffers[slot] = bufferID;
+        m_boundVertexStreamBuffers[slot] = buffer;
         m_boundVertexStreamStrides[slot] = strides[ii];
         m_boundVertexStreamOffsets[slot] = offsets[ii];
     }
@@ -1110,11 +1298,63 @@ void GLRenderer::drawIndexed(UInt indexCount, UInt startIndex, UInt baseVertex)
     assert(!"unimplemented");
 }
 
+void GLRenderer::drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance)
+{
+    assert(!"unimplemented");
+}
+
 void GLRenderer::dispatchCompute(int x, int y, int z)
 {
     glDispatchCompute(x, y, z);
 }
 
+Result GLRenderer::writeTimestamp(UInt index)
+{
+    if (!glQueryCounter)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (index >= kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    GLuint& query = m_timestampQueries[index];
+    if (!query)
+    {
+        glGenQueries(1, &query);
+    }
+    glQueryCounter(query, GL_TIMESTAMP);
+    return SLANG_OK;
+}
+
+Result GLRenderer::getTimestamps(UInt index, UInt count, uint64_t* outTimestamps)
+{
+    if (!glQueryCounter)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (index + count > kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    for (UInt i = 0; i < count; ++i)
+    {
+        const GLuint query = m_timestampQueries[index + i];
+        if (!query)
+        {
+            // Never written, so there is nothing to wait for
+            return SLANG_E_INVALID_ARG;
+        }
+        // Blocks until the result is available. Timestamps are in nanoseconds.
+        GLuint64 value = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &value);
+        outTimestamps[i] = uint64_t(value);
+    }
+    return SLANG_OK;
+}
+
 #if 0
 BindingState* GLRenderer::createBindingState(const BindingState::Desc& bindingStateDesc)
 {
@@ -1212,7 +1452,7 @@ void GLRenderer::setBindingState(BindingState* stateIn)
                 const int bindingIndex = binding.registerRange.getSingleIndex();
 
                 BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(binding.resource.Ptr());
-                glBindBufferBase(buffer->m_target, bindingIndex, buffer->m_handle);
+                _bindBufferBase(buffer->m_target, bindingIndex, buffer);
                 break;
             }
             case BindingType::Sampler:
@@ -1294,6 +1534,12 @@ void GLRenderer::setDescriptorSet(PipelineType pipelineType, PipelineLayout* lay
 
 Result GLRenderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& desc, DescriptorSetLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getDescriptorSetLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<DescriptorSetLayoutImpl> layoutImpl = new DescriptorSetLayoutImpl();
 
     Int counts[int(GLDescriptorSlotType::CountOf)] = { 0, };
@@ -1336,12 +1582,20 @@ Result GLRenderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& de
         layoutImpl->m_counts[ii] = counts[ii];
     }
 
+    m_objectCache.add(key, layoutImpl);
+
     *outLayout = layoutImpl.detach();
     return SLANG_OK;
 }
 
 Result GLRenderer::createPipelineLayout(const PipelineLayout::Desc& desc, PipelineLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getPipelineLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<PipelineLayoutImpl> layoutImpl = new PipelineLayoutImpl();
 
     static const int kSlotTypeCount = int(GLDescriptorSlotType::CountOf);
@@ -1364,6 +1618,8 @@ Result GLRenderer::createPipelineLayout(const PipelineLayout::Desc& desc, Pipeli
         layoutImpl->m_sets.add(setInfo);
     }
 
+    m_objectCache.add(key, layoutImpl);
+
     *outLayout = layoutImpl.detach();
     return SLANG_OK;
 }
@@ -0,0 +1,113 @@
+// render-object-cache.cpp
+#include "render-object-cache.h"
+
+#include <string.h>
+
+namespace gfx {
+using namespace Slang;
+
+bool RenderObjectCache::Key::operator==(const Key& rhs) const
+{
+    return m_hashCode == rhs.m_hashCode &&
+        m_words.getCount() == rhs.m_words.getCount() &&
+        ::memcmp(m_words.getBuffer(), rhs.m_words.getBuffer(), sizeof(uint32_t) * m_words.getCount()) == 0;
+}
+
+void RenderObjectCache::Key::addValue(uint32_t value)
+{
+    m_words.add(value);
+    m_hashCode = combineHash(m_hashCode, int(value));
+}
+
+void RenderObjectCache::Key::addFloat(float value)
+{
+    uint32_t bits;
+    ::memcpy(&bits, &value, sizeof(bits));
+    addValue(bits);
+}
+
+void RenderObjectCache::Key::addString(const char* text)
+{
+    const size_t length = text ? ::strlen(text) : 0;
+    addValue(uint32_t(length));
+
+    // Pack 4 chars to a word
+    for (size_t i = 0; i < length; i += 4)
+    {
+        uint32_t word = 0;
+        ::memcpy(&word, text + i, (length - i < 4) ? (length - i) : 4);
+        addValue(word);
+    }
+}
+
+void RenderObjectCache::Key::addObject(RefObject* object)
+{
+    const uint64_t bits = uint64_t(PtrInt(object));
+    addValue(uint32_t(bits));
+    addValue(uint32_t(bits >> 32));
+    m_objects.add(object);
+}
+
+/* static */RenderObjectCache::Key RenderObjectCache::getSamplerStateKey(const SamplerState::Desc& desc)
+{
+    Key key;
+    key.addValue(uint32_t(desc.minFilter));
+    key.addValue(uint32_t(desc.magFilter));
+    key.addValue(uint32_t(desc.mipFilter));
+    key.addValue(uint32_t(desc.reductionOp));
+    key.addValue(uint32_t(desc.addressU));
+    key.addValue(uint32_t(desc.addressV));
+    key.addValue(uint32_t(desc.addressW));
+    key.addFloat(desc.mipLODBias);
+    key.addValue(desc.maxAnisotropy);
+    key.addValue(uint32_t(desc.comparisonFunc));
+    for (auto component : desc.borderColor)
+    {
+        key.addFloat(component);
+    }
+    key.addFloat(desc.minLOD);
+    key.addFloat(desc.maxLOD);
+    return key;
+}
+
+/* static */RenderObjectCache::Key RenderObjectCache::getInputLayoutKey(const InputElementDesc* inputElements, UInt inputElementCount)
+{
+    Key key;
+    key.addValue(uint32_t(inputElementCount));
+    for (UInt i = 0; i < inputElementCount; ++i)
+    {
+        const InputElementDesc& element = inputElements[i];
+        key.addString(element.semanticName);
+        key.addValue(uint32_t(element.semanticIndex));
+        key.addValue(uint32_t(element.format));
+        key.addValue(uint32_t(element.offset));
+    }
+    return key;
+}
+
+/* static */RenderObjectCache::Key RenderObjectCache::getDescriptorSetLayoutKey(const DescriptorSetLayout::Desc& desc)
+{
+    Key key;
+    key.addValue(uint32_t(desc.slotRangeCount));
+    for (UInt i = 0; i < desc.slotRangeCount; ++i)
+    {
+        key.addValue(uint32_t(desc.slotRanges[i].type));
+        key.addValue(uint32_t(desc.slotRanges[i].count));
+    }
+    return key;
+}
+
+/* static */RenderObjectCache::Key RenderObjectCache::getPipelineLayoutKey(const PipelineLayout::Desc& desc)
+{
+    // The descriptor set layouts are cached too, so the same descriptions give the same layout objects
+    Key key;
+    key.addValue(uint32_t(desc.renderTargetCount));
+    key.addValue(uint32_t(desc.descriptorSetCount));
+    for (UInt i = 0; i < desc.descriptorSetCount; ++i)
+    {
+        key.addObject(desc.descriptorSets[i].layout);
+    }
+    return key;
+}
+
+} // namespace gfx
@@ -0,0 +1,73 @@
+// render-object-cache.h
+#pragma once
+
+#include "render.h"
+
+#include "../../source/core/slang-dictionary.h"
+
+namespace gfx {
+
+/*! \brief RenderObjectCache shares immutable API objects - sampler states, input layouts, descriptor set layouts and
+pipeline layouts - between the calls that create them with the same description.
+
+A back end makes a key from the description passed to its create function, and only creates a new object if find
+doesn't return one, adding the new object to the cache. The key is a flattened copy of the description (so it doesn't
+point into memory owned by the caller), and any objects the description references - such as the descriptor set layouts
+of a pipeline layout - are held by the key, so their addresses can't be reused by other objects while the key exists.
+
+The cache holds a reference to every object in it, so they all live as long as the renderer does. These objects are
+small, and an application typically only creates a few distinct ones, many times over.
+*/
+class RenderObjectCache
+{
+public:
+    typedef RenderObjectCache ThisType;
+
+    class Key
+    {
+    public:
+        int GetHashCode() const { return m_hashCode; }
+        bool operator==(const Key& rhs) const;
+        bool operator!=(const Key& rhs) const { return !(*this == rhs); }
+
+        void addValue(uint32_t value);
+        void addFloat(float value);
+        void addString(const char* text);
+        void addObject(Slang::RefObject* object);
+
+    protected:
+        Slang::List<uint32_t> m_words;
+        Slang::List<Slang::RefPtr<Slang::RefObject>> m_objects;     ///< Referenced objects, kept alive while the key is
+        int m_hashCode = 0;
+    };
+
+    static Key getSamplerStateKey(const SamplerState::Desc& desc);
+    static Key getInputLayoutKey(const InputElementDesc* inputElements, UInt inputElementCount);
+    static Key getDescriptorSetLayoutKey(const DescriptorSetLayout::Desc& desc);
+    static Key getPipelineLayoutKey(const PipelineLayout::Desc& desc);
+
+        /// Find the object for key. If found outputs it (with a reference for the caller) and returns true.
+    template <typename T>
+    bool find(const Key& key, T** outObject) const
+    {
+        Slang::RefPtr<Slang::RefObject>* object = m_objects.TryGetValue(key);
+        if (!object)
+        {
+            return false;
+        }
+        T* typedObject = static_cast<T*>(object->Ptr());
+        typedObject->addReference();
+        *outObject = typedObject;
+        return true;
+    }
+        /// Add the object created for key
+    void add(const Key& key, Slang::RefObject* object) { m_objects.Add(key, object); }
+
+        /// Remove all of the objects
+    void clear() { m_objects.Clear(); }
+
+protected:
+    Slang::Dictionary<Key, Slang::RefPtr<Slang::RefObject>> m_objects;
+};
+
+} // namespace gfx
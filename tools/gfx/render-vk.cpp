@@ -3,6 +3,7 @@
 
 //WORKING:#include "options.h"
 #include "render.h"
+#include "render-object-cache.h"
 
 #include "../../source/core/slang-smart-pointer.h"
 
@@ -10,6 +11,9 @@
 #include "vk-util.h"
 #include "vk-device-queue.h"
 #include "vk-swap-chain.h"
+#include "upload-ring.h"
+#include "vk-memory-allocator.h"
+#include "vk-descriptor-set-allocator.h"
 
 #include "surface.h"
 
@@ -60,6 +64,7 @@ public:
     Result createDescriptorSetLayout(const DescriptorSetLayout::Desc& desc, DescriptorSetLayout** outLayout) override;
     Result createPipelineLayout(const PipelineLayout::Desc& desc, PipelineLayout** outLayout) override;
     Result createDescriptorSet(DescriptorSetLayout* layout, DescriptorSet** outDescriptorSet) override;
+    Result createTransientDescriptorSet(DescriptorSetLayout* layout, DescriptorSet** outDescriptorSet) override;
 
     Result createProgram(const ShaderProgram::Desc& desc, ShaderProgram** outProgram) override;
     Result createGraphicsPipelineState(const GraphicsPipelineStateDesc& desc, PipelineState** outState) override;
@@ -81,9 +86,17 @@ public:
     virtual void setPipelineState(PipelineType pipelineType, PipelineState* state) override;
     virtual void draw(UInt vertexCount, UInt startVertex) override;
     virtual void drawIndexed(UInt indexCount, UInt startIndex, UInt baseVertex) override;
+    virtual void drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance) override;
     virtual void dispatchCompute(int x, int y, int z) override;
     virtual void submitGpuWork() override;
     virtual void waitForGpu() override;
+    virtual Result createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer) override;
+    virtual void submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers) override;
+    virtual void waitForQueue(QueueType queue, QueueType waitQueue) override;
+    virtual Result writeTimestamp(UInt index) override;
+    virtual Result getTimestamps(UInt index, UInt count, uint64_t* outTimestamps) override;
+    virtual uint64_t getTimestampFrequency() override { return m_timestampFrequency; }
+    virtual Result readBuffers(UInt count, BufferResource*const* buffers, BufferReadback** outReadback) override;
     virtual RendererType getRendererType() const override { return RendererType::Vulkan; }
 
         /// Dtor
@@ -91,33 +104,45 @@ public:
 
     protected:
 
+        /// Header of a pipeline cache file. The cache data is only used by the same device with the same driver.
+    struct PipelineCacheFileHeader
+    {
+        static const uint32_t kMagic = 0x43505653;     ///< 'SVPC'
+
+        uint32_t magic;
+        uint32_t vendorID;
+        uint32_t deviceID;
+        uint32_t driverVersion;
+        uint8_t pipelineCacheUUID[VK_UUID_SIZE];
+        uint64_t dataSize;                              ///< Size of the data following the header
+    };
+
     class Buffer
     {
         public:
-            /// Initialize a buffer with specified size, and memory props
-        Result init(const VulkanApi& api, size_t bufferSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags reqMemoryProperties);
+            /// Initialize a buffer with specified size, and memory props, with memory from allocator
+        Result init(VulkanMemoryAllocator& allocator, size_t bufferSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags reqMemoryProperties);
 
             /// Returns true if has been initialized
-        bool isInitialized() const { return m_api != nullptr; }
-
-            // Default Ctor
-        Buffer():
-            m_api(nullptr)
-        {}
+        bool isInitialized() const { return m_allocator != nullptr; }
 
             /// Dtor
         ~Buffer()
         {
-            if (m_api)
+            if (m_allocator)
             {
-                m_api->vkDestroyBuffer(m_api->m_device, m_buffer, nullptr);
-                m_api->vkFreeMemory(m_api->m_device, m_memory, nullptr);
+                const VulkanApi* api = m_allocator->getApi();
+                if (m_buffer != VK_NULL_HANDLE)
+                {
+                    api->vkDestroyBuffer(api->m_device, m_buffer, nullptr);
+                }
+                m_allocator->free(m_allocation);
             }
         }
 
-        VkBuffer m_buffer;
-        VkDeviceMemory m_memory;
-        const VulkanApi* m_api;
+        VkBuffer m_buffer = VK_NULL_HANDLE;
+        VulkanMemoryAllocation m_allocation;        ///< The memory. If it's host visible, it's mapped for the buffer's lifetime.
+        VulkanMemoryAllocator* m_allocator = nullptr;
     };
 
     class InputLayoutImpl : public InputLayout
@@ -143,7 +168,9 @@ public:
         Resource::Usage m_initialUsage;
 		VKRenderer* m_renderer;
         Buffer m_buffer;
-        Buffer m_uploadBuffer;
+        Buffer m_uploadBuffer;                              ///< Only if the buffer can be mapped with HostWrite
+        uint8_t* m_uploadData = nullptr;                    ///< m_uploadBuffer, mapped for its lifetime
+        size_t m_mapUploadOffset = 0;                       ///< For a WriteDiscard map, the offset of the contents in the upload ring
         List<uint8_t> m_readBuffer;                         ///< Stores the contents when a map read is performed
 
         MapFlavor m_mapFlavor = MapFlavor::Unknown;         ///< If resource is mapped, records what kind of mapping else Unknown (if not mapped)
@@ -154,32 +181,31 @@ public:
     public:
         typedef TextureResource Parent;
 
-        TextureResourceImpl(const Desc& desc, Usage initialUsage, const VulkanApi* api) :
+        TextureResourceImpl(const Desc& desc, Usage initialUsage, VulkanMemoryAllocator* allocator) :
             Parent(desc),
             m_initialUsage(initialUsage),
-            m_api(api)
+            m_allocator(allocator),
+            m_api(allocator->getApi())
         {
         }
         ~TextureResourceImpl()
         {
             if (m_api)
             {
-                if (m_imageMemory != VK_NULL_HANDLE)
-                {
-                    m_api->vkFreeMemory(m_api->m_device, m_imageMemory, nullptr);
-                }
                 if (m_image != VK_NULL_HANDLE)
                 {
                     m_api->vkDestroyImage(m_api->m_device, m_image, nullptr);
                 }
+                m_allocator->free(m_imageAllocation);
             }
         }
 
         Usage m_initialUsage;
 
         VkImage m_image = VK_NULL_HANDLE;
-        VkDeviceMemory m_imageMemory = VK_NULL_HANDLE;
+        VulkanMemoryAllocation m_imageAllocation;
 
+        VulkanMemoryAllocator* m_allocator;
         const VulkanApi* m_api;
     };
 
@@ -270,15 +296,11 @@ public:
             {
                 m_api->vkDestroyDescriptorSetLayout(m_api->m_device, m_descriptorSetLayout, nullptr);
             }
-            if (m_descriptorPool != VK_NULL_HANDLE)
-            {
-                m_api->vkDestroyDescriptorPool(m_api->m_device, m_descriptorPool, nullptr);
-            }
         }
 
         VulkanApi const* m_api;
         VkDescriptorSetLayout m_descriptorSetLayout = VK_NULL_HANDLE;
-        VkDescriptorPool m_descriptorPool = VK_NULL_HANDLE;
+        int m_sizeClass = -1;                               ///< Size class of the sets in the VulkanDescriptorSetAllocator
 
         struct RangeInfo
         {
@@ -335,6 +357,7 @@ public:
 
         ~DescriptorSetImpl()
         {
+            m_renderer->m_descriptorSetAllocator.free(m_allocation);
         }
 
         virtual void setConstantBuffer(UInt range, UInt index, BufferResource* buffer) override;
@@ -352,6 +375,7 @@ public:
         VKRenderer*                         m_renderer = nullptr;   ///< Weak pointer, can't be strong, because if set will become circular reference
         RefPtr<DescriptorSetLayoutImpl>     m_layout;
         VkDescriptorSet                     m_descriptorSet = VK_NULL_HANDLE;
+        VulkanDescriptorSetAllocation       m_allocation;
 
         List<Binding>                       m_bindings;             ///< Records entities are bound to this descriptor set, and keeps the associated resources/views/state in scope
     };
@@ -433,6 +457,90 @@ public:
         VkPipeline m_pipeline = VK_NULL_HANDLE;
     };
 
+    class CommandBufferImpl : public CommandBuffer
+    {
+    public:
+        virtual Result begin() override;
+        virtual void setPipelineState(PipelineState* state) override;
+        virtual void setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet) override;
+        virtual void dispatchCompute(int x, int y, int z) override;
+        virtual void writeTimestamp(UInt index) override;
+        virtual Result end() override;
+
+        CommandBufferImpl(const VulkanApi& api):
+            m_api(&api)
+        {
+        }
+        ~CommandBufferImpl()
+        {
+            if (m_commandPool != VK_NULL_HANDLE)
+            {
+                // Frees m_commandBuffer too
+                m_api->vkDestroyCommandPool(m_api->m_device, m_commandPool, nullptr);
+            }
+        }
+
+        const VulkanApi* m_api;
+
+            /// Each command buffer has its own pool, as a pool can only be used by one thread at a time
+        VkCommandPool m_commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer m_commandBuffer = VK_NULL_HANDLE;
+        QueueType m_queueType = QueueType::Graphics;
+        VkQueryPool m_timestampQueryPool = VK_NULL_HANDLE;
+
+        RefPtr<PipelineStateImpl> m_pipelineState;
+        RefPtr<DescriptorSetImpl> m_descriptorSetImpls[kMaxDescriptorSets];
+        VkDescriptorSet m_descriptorSets[kMaxDescriptorSets] = {};
+        Result m_result = SLANG_OK;                         ///< The first failure while recording
+    };
+
+        /// A host visible buffer that copies are read back into, used by one BufferReadback at a time
+    class ReadbackBuffer : public RefObject
+    {
+    public:
+        Buffer m_buffer;
+        size_t m_size = 0;
+        const uint8_t* m_data = nullptr;                    ///< m_buffer, mapped for its lifetime
+    };
+
+    class BufferReadbackImpl : public BufferReadback
+    {
+    public:
+        virtual bool isComplete() override;
+        virtual const void* getData(UInt index) override;
+
+        ~BufferReadbackImpl();
+
+        VKRenderer* m_renderer = nullptr;                   ///< Weak pointer - the renderer must outlive the readback
+        RefPtr<ReadbackBuffer> m_readbackBuffer;            ///< Returned to the renderer's pool when the readback is destroyed
+        List<size_t> m_offsets;                             ///< Offset of the contents of each buffer in m_readbackBuffer
+        uint64_t m_fenceValue = 0;                          ///< The copies are complete when the device queue reaches this value
+        bool m_isComplete = false;
+    };
+
+        /// Get a readback buffer of at least size bytes, from the pool if there is one large enough
+    Result _allocateReadbackBuffer(size_t size, RefPtr<ReadbackBuffer>& outBuffer);
+
+        /// Upload memory that a copy to the GPU reads from
+    struct UploadAllocation
+    {
+        VkBuffer m_buffer;
+        size_t m_offset;
+        uint8_t* m_data;
+    };
+        /// Allocate upload memory from the upload ring, flushing and waiting for the GPU if the ring is full. If size is larger
+        /// than the ring, a buffer is created in outFallback, which has to be kept alive until the GPU has done the copy.
+    Result _allocateUpload(size_t size, size_t alignment, Buffer& outFallback, UploadAllocation& outAllocation);
+
+        /// Get a semaphore that is unsignaled, with no pending operations
+    VkSemaphore _getSemaphore();
+
+        /// Create m_pipelineCache, with the contents of the file at m_desc.pipelineCachePath if it's for this device
+    SlangResult _initPipelineCache();
+        /// Write the contents of m_pipelineCache to the file at m_desc.pipelineCachePath
+    SlangResult _savePipelineCache();
+    void _initPipelineCacheFileHeader(PipelineCacheFileHeader& outHeader);
+
     VkBool32 handleDebugMessage(VkDebugReportFlagsEXT flags, VkDebugReportObjectTypeEXT objType, uint64_t srcObject,
         size_t location, int32_t msgCode, const char* pLayerPrefix, const char* pMsg);
 
@@ -478,29 +586,49 @@ public:
 
     VulkanModule m_module;
     VulkanApi m_api;
+    VulkanMemoryAllocator m_memoryAllocator;        ///< Declared after m_api and before any resources, so it's destroyed after them
+    VulkanDescriptorSetAllocator m_descriptorSetAllocator;
 
     VulkanDeviceQueue m_deviceQueue;
     VulkanSwapChain m_swapChain;
 
+    VkQueue m_computeQueue = VK_NULL_HANDLE;            ///< For QueueType::Compute command buffers. If the device has no compute only queue family, they go to the device queue.
+    int m_computeQueueFamilyIndex = -1;
+    VkSemaphore m_computeSemaphore = VK_NULL_HANDLE;    ///< Signaled by the last submission to m_computeQueue, if nothing has waited on it yet
+    List<VkSemaphore> m_freeSemaphores;                 ///< Unsignaled, with no pending operations
+    List<VkSemaphore> m_waitedSemaphores;               ///< Waited on by submitted work. Free once the GPU is idle.
+
+    VkQueryPool m_timestampQueryPool = VK_NULL_HANDLE;  ///< kMaxTimestampCount timestamp queries, if the device supports them
+    uint64_t m_timestampFrequency = 0;
+
     VkRenderPass m_renderPass = VK_NULL_HANDLE;
 
+    VkPipelineCache m_pipelineCache = VK_NULL_HANDLE;
+
+    static const size_t kUploadRingSize = 16 * 1024 * 1024;
+    Buffer m_uploadRingBuffer;                  ///< Host visible buffer the upload ring allocates from. Mapped for its lifetime.
+    UploadRing m_uploadRing;
+
+    List<RefPtr<ReadbackBuffer>> m_freeReadbackBuffers;     ///< Readback buffers not used by a readback, for reuse
+
     int m_swapChainImageIndex = -1;
 
     float m_clearColor[4] = { 0, 0, 0, 0 };
 
     Desc m_desc;
     List<String> m_features;
+
+    RenderObjectCache m_objectCache;                ///< Sampler states and layouts, shared by the creates with the same desc
 };
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! VkRenderer::Buffer !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
-Result VKRenderer::Buffer::init(const VulkanApi& api, size_t bufferSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags reqMemoryProperties)
+Result VKRenderer::Buffer::init(VulkanMemoryAllocator& allocator, size_t bufferSize, VkBufferUsageFlags usage, VkMemoryPropertyFlags reqMemoryProperties)
 {
     assert(!isInitialized());
 
-    m_api = &api;
-    m_memory = VK_NULL_HANDLE;
-    m_buffer = VK_NULL_HANDLE;
+    const VulkanApi& api = *allocator.getApi();
+    m_allocator = &allocator;
 
     VkBufferCreateInfo bufferCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
     bufferCreateInfo.size = bufferSize;
@@ -511,17 +639,8 @@ Result VKRenderer::Buffer::init(const VulkanApi& api, size_t bufferSize, VkBuffe
     VkMemoryRequirements memoryReqs = {};
     api.vkGetBufferMemoryRequirements(api.m_device, m_buffer, &memoryReqs);
 
-    int memoryTypeIndex = api.findMemoryTypeIndex(memoryReqs.memoryTypeBits, reqMemoryProperties);
-    assert(memoryTypeIndex >= 0);
-
-    VkMemoryPropertyFlags actualMemoryProperites = api.m_deviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
-
-    VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
-    allocateInfo.allocationSize = memoryReqs.size;
-    allocateInfo.memoryTypeIndex = memoryTypeIndex;
-
-    SLANG_VK_CHECK(api.vkAllocateMemory(api.m_device, &allocateInfo, nullptr, &m_memory));
-    SLANG_VK_CHECK(api.vkBindBufferMemory(api.m_device, m_buffer, m_memory, 0));
+    SLANG_VK_CHECK(allocator.allocate(memoryReqs, reqMemoryProperties, VulkanMemoryAllocator::ResourceKind::Linear, m_allocation));
+    SLANG_VK_CHECK(api.vkBindBufferMemory(api.m_device, m_buffer, m_allocation.m_memory, m_allocation.m_offset));
 
     return SLANG_OK;
 }
@@ -804,11 +923,130 @@ Renderer* createVKRenderer()
 
 VKRenderer::~VKRenderer()
 {
+    if (m_freeReadbackBuffers.getCount() || m_descriptorSetAllocator.hasPools())
+    {
+        // The last copies into a readback buffer may not have completed, and descriptor sets may still be in use
+        m_deviceQueue.flushAndWait();
+    }
+
+    if (m_freeSemaphores.getCount() || m_waitedSemaphores.getCount() || m_computeSemaphore != VK_NULL_HANDLE)
+    {
+        // Make sure nothing is waiting on or signaling the semaphores
+        waitForGpu();
+        if (m_computeSemaphore != VK_NULL_HANDLE)
+        {
+            m_freeSemaphores.add(m_computeSemaphore);
+            m_computeSemaphore = VK_NULL_HANDLE;
+        }
+        for (auto semaphore : m_freeSemaphores)
+        {
+            m_api.vkDestroySemaphore(m_device, semaphore, nullptr);
+        }
+        m_freeSemaphores.clear();
+    }
+
+    if (m_timestampQueryPool != VK_NULL_HANDLE)
+    {
+        m_api.vkDestroyQueryPool(m_device, m_timestampQueryPool, nullptr);
+        m_timestampQueryPool = VK_NULL_HANDLE;
+    }
+
     if (m_renderPass != VK_NULL_HANDLE)
     {
         m_api.vkDestroyRenderPass(m_device, m_renderPass, nullptr);
         m_renderPass = VK_NULL_HANDLE;
     }
+
+    if (m_pipelineCache != VK_NULL_HANDLE)
+    {
+        _savePipelineCache();
+        m_api.vkDestroyPipelineCache(m_device, m_pipelineCache, nullptr);
+        m_pipelineCache = VK_NULL_HANDLE;
+    }
+
+    // Release the resources and sets still bound, as members declared before the allocators are destroyed after them
+    m_boundVertexBuffers.clear();
+    for (auto& descriptorSetImpl : m_currentDescriptorSetImpls)
+    {
+        descriptorSetImpl.setNull();
+    }
+    m_currentPipeline.setNull();
+}
+
+void VKRenderer::_initPipelineCacheFileHeader(PipelineCacheFileHeader& outHeader)
+{
+    VkPhysicalDeviceProperties props = {};
+    m_api.vkGetPhysicalDeviceProperties(m_api.m_physicalDevice, &props);
+
+    memset(&outHeader, 0, sizeof(outHeader));
+    outHeader.magic = PipelineCacheFileHeader::kMagic;
+    outHeader.vendorID = props.vendorID;
+    outHeader.deviceID = props.deviceID;
+    outHeader.driverVersion = props.driverVersion;
+    memcpy(outHeader.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+SlangResult VKRenderer::_initPipelineCache()
+{
+    // The data to start the cache with. Left empty if there is no file, or it's from a different device or driver
+    List<uint8_t> initialData;
+
+    if (m_desc.pipelineCachePath.getLength())
+    {
+        FILE* file = fopen(m_desc.pipelineCachePath.getBuffer(), "rb");
+        if (file)
+        {
+            PipelineCacheFileHeader expectedHeader;
+            _initPipelineCacheFileHeader(expectedHeader);
+
+            PipelineCacheFileHeader header;
+            if (fread(&header, sizeof(header), 1, file) == 1 &&
+                memcmp(&header, &expectedHeader, offsetof(PipelineCacheFileHeader, dataSize)) == 0)
+            {
+                initialData.setCount(Index(header.dataSize));
+                if (fread(initialData.getBuffer(), 1, size_t(header.dataSize), file) != size_t(header.dataSize))
+                {
+                    initialData.clear();
+                }
+            }
+            fclose(file);
+        }
+    }
+
+    VkPipelineCacheCreateInfo createInfo = { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    createInfo.initialDataSize = size_t(initialData.getCount());
+    createInfo.pInitialData = initialData.getBuffer();
+
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkCreatePipelineCache(m_device, &createInfo, nullptr, &m_pipelineCache));
+    return SLANG_OK;
+}
+
+SlangResult VKRenderer::_savePipelineCache()
+{
+    if (m_desc.pipelineCachePath.getLength() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    size_t dataSize = 0;
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, nullptr));
+    List<uint8_t> data;
+    data.setCount(Index(dataSize));
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data.getBuffer()));
+
+    PipelineCacheFileHeader header;
+    _initPipelineCacheFileHeader(header);
+    header.dataSize = uint64_t(dataSize);
+
+    FILE* file = fopen(m_desc.pipelineCachePath.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_E_CANNOT_OPEN;
+    }
+    const bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(data.getBuffer(), 1, dataSize, file) == dataSize;
+    fclose(file);
+    return written ? SLANG_OK : SLANG_FAIL;
 }
 
 
@@ -1048,13 +1286,22 @@ SlangResult VKRenderer::initialize(const Desc& desc, void* inWindowHandle)
     int queueFamilyIndex = m_api.findQueue(VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT);
     assert(queueFamilyIndex >= 0);
 
+    // A compute only queue family, for work that can run at the same time as work on the device queue
+    m_computeQueueFamilyIndex = m_api.findQueue(VK_QUEUE_COMPUTE_BIT, VK_QUEUE_GRAPHICS_BIT);
+
     float queuePriority = 0.0f;
-    VkDeviceQueueCreateInfo queueCreateInfo = { VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO };
-    queueCreateInfo.queueFamilyIndex = queueFamilyIndex;
-    queueCreateInfo.queueCount = 1;
-    queueCreateInfo.pQueuePriorities = &queuePriority;
+    VkDeviceQueueCreateInfo queueCreateInfos[2] = {};
+    for (auto& queueCreateInfo : queueCreateInfos)
+    {
+        queueCreateInfo.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+        queueCreateInfo.queueCount = 1;
+        queueCreateInfo.pQueuePriorities = &queuePriority;
+    }
+    queueCreateInfos[0].queueFamilyIndex = queueFamilyIndex;
+    queueCreateInfos[1].queueFamilyIndex = m_computeQueueFamilyIndex;
 
-    deviceCreateInfo.pQueueCreateInfos = &queueCreateInfo;
+    deviceCreateInfo.queueCreateInfoCount = (m_computeQueueFamilyIndex >= 0) ? 2 : 1;
+    deviceCreateInfo.pQueueCreateInfos = queueCreateInfos;
 
     deviceCreateInfo.enabledExtensionCount = uint32_t(deviceExtensions.getCount());
     deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.getBuffer();
@@ -1062,12 +1309,45 @@ SlangResult VKRenderer::initialize(const Desc& desc, void* inWindowHandle)
     SLANG_VK_RETURN_ON_FAIL(m_api.vkCreateDevice(m_api.m_physicalDevice, &deviceCreateInfo, nullptr, &m_device));
     SLANG_RETURN_ON_FAIL(m_api.initDeviceProcs(m_device));
 
+    m_memoryAllocator.init(&m_api);
+    m_descriptorSetAllocator.init(&m_api);
+
+    SLANG_RETURN_ON_FAIL(_initPipelineCache());
+
     {
         VkQueue queue;
         m_api.vkGetDeviceQueue(m_device, queueFamilyIndex, 0, &queue);
         SLANG_RETURN_ON_FAIL(m_deviceQueue.init(m_api, queue, queueFamilyIndex));
     }
 
+    if (m_computeQueueFamilyIndex >= 0)
+    {
+        m_api.vkGetDeviceQueue(m_device, m_computeQueueFamilyIndex, 0, &m_computeQueue);
+    }
+
+    {
+        VkPhysicalDeviceProperties props = {};
+        m_api.vkGetPhysicalDeviceProperties(m_api.m_physicalDevice, &props);
+
+        // Timestamps are only used if they can be written on all graphics and compute queues
+        if (props.limits.timestampComputeAndGraphics && props.limits.timestampPeriod > 0.0f)
+        {
+            VkQueryPoolCreateInfo queryPoolCreateInfo = { VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO };
+            queryPoolCreateInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+            queryPoolCreateInfo.queryCount = uint32_t(kMaxTimestampCount);
+            SLANG_VK_RETURN_ON_FAIL(m_api.vkCreateQueryPool(m_device, &queryPoolCreateInfo, nullptr, &m_timestampQueryPool));
+
+            // The period is in nanoseconds per tick
+            m_timestampFrequency = uint64_t(1e9 / double(props.limits.timestampPeriod));
+        }
+    }
+
+    {
+        // The upload ring is mapped once, and stays mapped
+        SLANG_RETURN_ON_FAIL(m_uploadRingBuffer.init(m_memoryAllocator, kUploadRingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+        m_uploadRing.init(m_uploadRingBuffer.m_allocation.m_mappedData, kUploadRingSize);
+    }
+
     // set up swap chain
 
     {
@@ -1182,6 +1462,414 @@ void VKRenderer::submitGpuWork()
 void VKRenderer::waitForGpu()
 {
     m_deviceQueue.flushAndWait();
+    if (m_computeQueue != VK_NULL_HANDLE)
+    {
+        m_api.vkQueueWaitIdle(m_computeQueue);
+    }
+
+    // Nothing is pending, so semaphores that have been waited on can be used again
+    m_freeSemaphores.addRange(m_waitedSemaphores);
+    m_waitedSemaphores.clear();
+}
+
+VkSemaphore VKRenderer::_getSemaphore()
+{
+    if (m_freeSemaphores.getCount() == 0 && m_waitedSemaphores.getCount() >= 32)
+    {
+        // Rather than tracking when each wait has completed, wait for the GPU once in a while
+        waitForGpu();
+    }
+
+    if (m_freeSemaphores.getCount())
+    {
+        const VkSemaphore semaphore = m_freeSemaphores.getLast();
+        m_freeSemaphores.removeLast();
+        return semaphore;
+    }
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo = { VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO };
+    VkSemaphore semaphore = VK_NULL_HANDLE;
+    SLANG_VK_CHECK(m_api.vkCreateSemaphore(m_device, &semaphoreCreateInfo, nullptr, &semaphore));
+    return semaphore;
+}
+
+Result VKRenderer::createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer)
+{
+    RefPtr<CommandBufferImpl> commandBuffer = new CommandBufferImpl(m_api);
+    commandBuffer->m_queueType = queueType;
+    commandBuffer->m_timestampQueryPool = m_timestampQueryPool;
+
+    const bool useComputeQueue = (queueType == QueueType::Compute && m_computeQueue != VK_NULL_HANDLE);
+
+    VkCommandPoolCreateInfo poolCreateInfo = { VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO };
+    poolCreateInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolCreateInfo.queueFamilyIndex = useComputeQueue ? m_computeQueueFamilyIndex : m_deviceQueue.getQueueIndex();
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkCreateCommandPool(m_device, &poolCreateInfo, nullptr, &commandBuffer->m_commandPool));
+
+    VkCommandBufferAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO };
+    allocateInfo.commandPool = commandBuffer->m_commandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkAllocateCommandBuffers(m_device, &allocateInfo, &commandBuffer->m_commandBuffer));
+
+    *outCommandBuffer = commandBuffer.detach();
+    return SLANG_OK;
+}
+
+void VKRenderer::submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    // Keep the order the work was recorded in
+    m_deviceQueue.flush();
+
+    List<VkCommandBuffer> vkCommandBuffers;
+    vkCommandBuffers.setCount(Index(count));
+
+    // Submit each run of command buffers for the same queue together
+    UInt start = 0;
+    while (start < count)
+    {
+        const QueueType queueType = static_cast<CommandBufferImpl*>(commandBuffers[start])->m_queueType;
+        UInt end = start + 1;
+        while (end < count && static_cast<CommandBufferImpl*>(commandBuffers[end])->m_queueType == queueType)
+        {
+            end++;
+        }
+
+        for (UInt i = start; i < end; ++i)
+        {
+            vkCommandBuffers[Index(i - start)] = static_cast<CommandBufferImpl*>(commandBuffers[i])->m_commandBuffer;
+        }
+
+        VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+        submitInfo.commandBufferCount = uint32_t(end - start);
+        submitInfo.pCommandBuffers = vkCommandBuffers.getBuffer();
+
+        if (queueType == QueueType::Compute && m_computeQueue != VK_NULL_HANDLE)
+        {
+            // Work on the compute queue waits for everything submitted before it
+            waitForQueue(QueueType::Compute, QueueType::Graphics);
+
+            // Wait on the semaphore of the previous compute submission (if nothing else has), so it can be used again,
+            // and signal a new one that the device queue can wait on
+            const VkSemaphore prevSemaphore = m_computeSemaphore;
+            const VkSemaphore semaphore = _getSemaphore();
+            const VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            if (prevSemaphore != VK_NULL_HANDLE)
+            {
+                submitInfo.waitSemaphoreCount = 1;
+                submitInfo.pWaitSemaphores = &prevSemaphore;
+                submitInfo.pWaitDstStageMask = &waitStages;
+                m_waitedSemaphores.add(prevSemaphore);
+            }
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &semaphore;
+            m_computeSemaphore = semaphore;
+
+            SLANG_VK_CHECK(m_api.vkQueueSubmit(m_computeQueue, 1, &submitInfo, VK_NULL_HANDLE));
+        }
+        else
+        {
+            // In a single submit, a run of graphics work waits for the compute work before it, to keep the order
+            if (start > 0)
+            {
+                waitForQueue(QueueType::Graphics, QueueType::Compute);
+            }
+            SLANG_VK_CHECK(m_api.vkQueueSubmit(m_deviceQueue.getQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+        }
+
+        start = end;
+    }
+}
+
+void VKRenderer::waitForQueue(QueueType queue, QueueType waitQueue)
+{
+    // With only the device queue, work is already in order
+    if (queue == waitQueue || m_computeQueue == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    const VkPipelineStageFlags waitStages = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+    if (waitQueue == QueueType::Compute)
+    {
+        // Nothing to do if there has been no compute work since the last wait
+        if (m_computeSemaphore == VK_NULL_HANDLE)
+        {
+            return;
+        }
+
+        // A wait applies to everything later in submission order, including the work recorded on the device queue
+        VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+        submitInfo.waitSemaphoreCount = 1;
+        submitInfo.pWaitSemaphores = &m_computeSemaphore;
+        submitInfo.pWaitDstStageMask = &waitStages;
+        SLANG_VK_CHECK(m_api.vkQueueSubmit(m_deviceQueue.getQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+
+        m_waitedSemaphores.add(m_computeSemaphore);
+        m_computeSemaphore = VK_NULL_HANDLE;
+    }
+    else
+    {
+        // Submit the work recorded so far, and signal once it's done
+        m_deviceQueue.flush();
+
+        const VkSemaphore semaphore = _getSemaphore();
+        {
+            VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+            submitInfo.signalSemaphoreCount = 1;
+            submitInfo.pSignalSemaphores = &semaphore;
+            SLANG_VK_CHECK(m_api.vkQueueSubmit(m_deviceQueue.getQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+        }
+        {
+            VkSubmitInfo submitInfo = { VK_STRUCTURE_TYPE_SUBMIT_INFO };
+            submitInfo.waitSemaphoreCount = 1;
+            submitInfo.pWaitSemaphores = &semaphore;
+            submitInfo.pWaitDstStageMask = &waitStages;
+            SLANG_VK_CHECK(m_api.vkQueueSubmit(m_computeQueue, 1, &submitInfo, VK_NULL_HANDLE));
+        }
+        m_waitedSemaphores.add(semaphore);
+    }
+}
+
+Result VKRenderer::writeTimestamp(UInt index)
+{
+    if (m_timestampQueryPool == VK_NULL_HANDLE)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (index >= kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+
+    VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
+    m_api.vkCmdResetQueryPool(commandBuffer, m_timestampQueryPool, uint32_t(index), 1);
+    m_api.vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampQueryPool, uint32_t(index));
+    return SLANG_OK;
+}
+
+Result VKRenderer::getTimestamps(UInt index, UInt count, uint64_t* outTimestamps)
+{
+    if (m_timestampQueryPool == VK_NULL_HANDLE)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+    if (index + count > kMaxTimestampCount)
+    {
+        return SLANG_E_INVALID_ARG;
+    }
+    if (count == 0)
+    {
+        return SLANG_OK;
+    }
+
+    waitForGpu();
+
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkGetQueryPoolResults(m_device, m_timestampQueryPool, uint32_t(index), uint32_t(count),
+        sizeof(uint64_t) * count, outTimestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WAIT_BIT));
+    return SLANG_OK;
+}
+
+Result VKRenderer::_allocateReadbackBuffer(size_t size, RefPtr<ReadbackBuffer>& outBuffer)
+{
+    // Use the smallest free buffer that is large enough
+    Index bestIndex = -1;
+    for (Index i = 0; i < m_freeReadbackBuffers.getCount(); ++i)
+    {
+        const size_t bufferSize = m_freeReadbackBuffers[i]->m_size;
+        if (bufferSize >= size && (bestIndex < 0 || bufferSize < m_freeReadbackBuffers[bestIndex]->m_size))
+        {
+            bestIndex = i;
+        }
+    }
+    if (bestIndex >= 0)
+    {
+        outBuffer = m_freeReadbackBuffers[bestIndex];
+        m_freeReadbackBuffers.fastRemoveAt(bestIndex);
+        return SLANG_OK;
+    }
+
+    // Round up to a power of 2, so buffers can be reused for readbacks of similar sizes
+    size_t bufferSize = 64 * 1024;
+    while (bufferSize < size)
+    {
+        bufferSize *= 2;
+    }
+
+    RefPtr<ReadbackBuffer> readbackBuffer = new ReadbackBuffer;
+    readbackBuffer->m_size = bufferSize;
+    SLANG_RETURN_ON_FAIL(readbackBuffer->m_buffer.init(m_memoryAllocator, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+    readbackBuffer->m_data = readbackBuffer->m_buffer.m_allocation.m_mappedData;
+
+    outBuffer = readbackBuffer;
+    return SLANG_OK;
+}
+
+Result VKRenderer::readBuffers(UInt count, BufferResource*const* buffers, BufferReadback** outReadback)
+{
+    RefPtr<BufferReadbackImpl> readback = new BufferReadbackImpl;
+    readback->m_renderer = this;
+
+    // Place the contents one after another
+    size_t totalSize = 0;
+    for (UInt i = 0; i < count; ++i)
+    {
+        readback->m_offsets.add(totalSize);
+        totalSize += (buffers[i]->getDesc().sizeInBytes + 15) & ~size_t(15);
+    }
+
+    if (totalSize == 0)
+    {
+        // Nothing to copy
+        readback->m_isComplete = true;
+        *outReadback = readback.detach();
+        return SLANG_OK;
+    }
+
+    SLANG_RETURN_ON_FAIL(_allocateReadbackBuffer(totalSize, readback->m_readbackBuffer));
+
+    VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
+
+    // Make writes by earlier work visible to the copies
+    {
+        VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+        m_api.vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    for (UInt i = 0; i < count; ++i)
+    {
+        BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(buffers[i]);
+
+        VkBufferCopy copyInfo = {};
+        copyInfo.dstOffset = readback->m_offsets[Index(i)];
+        copyInfo.size = buffer->getDesc().sizeInBytes;
+        m_api.vkCmdCopyBuffer(commandBuffer, buffer->m_buffer.m_buffer, readback->m_readbackBuffer->m_buffer.m_buffer, 1, &copyInfo);
+    }
+
+    // Make the copies visible to the host
+    {
+        VkMemoryBarrier barrier = { VK_STRUCTURE_TYPE_MEMORY_BARRIER };
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_HOST_READ_BIT;
+        m_api.vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    // Submit, so the copies are done without anything having to wait
+    readback->m_fenceValue = m_deviceQueue.getNextFenceValue();
+    m_deviceQueue.flush();
+
+    *outReadback = readback.detach();
+    return SLANG_OK;
+}
+
+bool VKRenderer::BufferReadbackImpl::isComplete()
+{
+    if (!m_isComplete)
+    {
+        m_isComplete = m_renderer->m_deviceQueue.updateCompletedFenceValue() >= m_fenceValue;
+    }
+    return m_isComplete;
+}
+
+const void* VKRenderer::BufferReadbackImpl::getData(UInt index)
+{
+    if (!m_isComplete)
+    {
+        m_renderer->m_deviceQueue.waitForFenceValue(m_fenceValue);
+        m_isComplete = true;
+    }
+    // The memory is host coherent, so there is nothing to invalidate
+    return m_readbackBuffer ? m_readbackBuffer->m_data + m_offsets[Index(index)] : nullptr;
+}
+
+VKRenderer::BufferReadbackImpl::~BufferReadbackImpl()
+{
+    if (m_readbackBuffer)
+    {
+        // The GPU may still be copying into the buffer, but it's only reused for copies submitted after
+        m_renderer->m_freeReadbackBuffers.add(m_readbackBuffer);
+    }
+}
+
+Result VKRenderer::CommandBufferImpl::begin()
+{
+    m_pipelineState.setNull();
+    for (Index i = 0; i < kMaxDescriptorSets; ++i)
+    {
+        m_descriptorSetImpls[i].setNull();
+        m_descriptorSets[i] = VK_NULL_HANDLE;
+    }
+    m_result = SLANG_OK;
+
+    SLANG_VK_RETURN_ON_FAIL(m_api->vkResetCommandBuffer(m_commandBuffer, 0));
+
+    VkCommandBufferBeginInfo beginInfo = { VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO };
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    SLANG_VK_RETURN_ON_FAIL(m_api->vkBeginCommandBuffer(m_commandBuffer, &beginInfo));
+    return SLANG_OK;
+}
+
+void VKRenderer::CommandBufferImpl::setPipelineState(PipelineState* state)
+{
+    m_pipelineState = static_cast<PipelineStateImpl*>(state);
+}
+
+void VKRenderer::CommandBufferImpl::setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet)
+{
+    SLANG_UNUSED(layout);
+    auto descriptorSetImpl = static_cast<DescriptorSetImpl*>(descriptorSet);
+    m_descriptorSetImpls[index] = descriptorSetImpl;
+    m_descriptorSets[index] = descriptorSetImpl->m_descriptorSet;
+}
+
+void VKRenderer::CommandBufferImpl::dispatchCompute(int x, int y, int z)
+{
+    auto pipeline = m_pipelineState;
+    if (!pipeline || pipeline->m_shaderProgram->m_pipelineType != PipelineType::Compute)
+    {
+        assert(!"Invalid compute pipeline");
+        m_result = SLANG_FAIL;
+        return;
+    }
+
+    m_api->vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline->m_pipeline);
+
+    auto pipelineLayoutImpl = pipeline->m_pipelineLayout.Ptr();
+    m_api->vkCmdBindDescriptorSets(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayoutImpl->m_pipelineLayout,
+        0, uint32_t(pipelineLayoutImpl->m_descriptorSetCount),
+        &m_descriptorSets[0],
+        0, nullptr);
+
+    m_api->vkCmdDispatch(m_commandBuffer, x, y, z);
+}
+
+void VKRenderer::CommandBufferImpl::writeTimestamp(UInt index)
+{
+    if (m_timestampQueryPool == VK_NULL_HANDLE || index >= kMaxTimestampCount)
+    {
+        if (SLANG_SUCCEEDED(m_result))
+        {
+            m_result = (m_timestampQueryPool == VK_NULL_HANDLE) ? SLANG_E_NOT_AVAILABLE : SLANG_E_INVALID_ARG;
+        }
+        return;
+    }
+
+    m_api->vkCmdResetQueryPool(m_commandBuffer, m_timestampQueryPool, uint32_t(index), 1);
+    m_api->vkCmdWriteTimestamp(m_commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_timestampQueryPool, uint32_t(index));
+}
+
+Result VKRenderer::CommandBufferImpl::end()
+{
+    SLANG_VK_RETURN_ON_FAIL(m_api->vkEndCommandBuffer(m_commandBuffer));
+    return m_result;
 }
 
 void VKRenderer::setClearColor(const float color[4])
@@ -1196,8 +1884,13 @@ void VKRenderer::clearFrame()
 
 void VKRenderer::presentFrame()
 {
+    // The frame is complete once the device queue (after waiting for any compute work) reaches fenceValue
+    waitForQueue(QueueType::Graphics, QueueType::Compute);
+    const uint64_t fenceValue = m_deviceQueue.getNextFenceValue();
     _endRender();
 
+    m_descriptorSetAllocator.endFrame(fenceValue, m_deviceQueue.updateCompletedFenceValue());
+
     const bool vsync = true;
     m_swapChain.present(vsync);
 
@@ -1380,7 +2073,7 @@ Result VKRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
 
     const int arraySize = desc.calcEffectiveArraySize();
 
-    RefPtr<TextureResourceImpl> texture(new TextureResourceImpl(desc, initialUsage, &m_api));
+    RefPtr<TextureResourceImpl> texture(new TextureResourceImpl(desc, initialUsage, &m_memoryAllocator));
 
     // Create the image
     {
@@ -1440,25 +2133,9 @@ Result VKRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
     VkMemoryRequirements memRequirements;
     m_api.vkGetImageMemoryRequirements(m_device, texture->m_image, &memRequirements);
 
-    // Allocate the memory
-    {
-        VkMemoryPropertyFlags reqMemoryProperties = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
-
-        VkMemoryAllocateInfo allocInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
-
-        int memoryTypeIndex = m_api.findMemoryTypeIndex(memRequirements.memoryTypeBits, reqMemoryProperties);
-        assert(memoryTypeIndex >= 0);
-
-        VkMemoryPropertyFlags actualMemoryProperites = m_api.m_deviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags;
-
-        allocInfo.allocationSize = memRequirements.size;
-        allocInfo.memoryTypeIndex = memoryTypeIndex;
-
-        SLANG_VK_RETURN_ON_FAIL(m_api.vkAllocateMemory(m_device, &allocInfo, nullptr, &texture->m_imageMemory));
-    }
-
-    // Bind the memory to the image
-    m_api.vkBindImageMemory(m_device, texture->m_image, texture->m_imageMemory, 0);
+    // Allocate the memory, and bind it to the image
+    SLANG_VK_RETURN_ON_FAIL(m_memoryAllocator.allocate(memRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VulkanMemoryAllocator::ResourceKind::Optimal, texture->m_imageAllocation));
+    SLANG_VK_RETURN_ON_FAIL(m_api.vkBindImageMemory(m_device, texture->m_image, texture->m_imageAllocation.m_memory, texture->m_imageAllocation.m_offset));
 
     if (initData)
     {
@@ -1488,17 +2165,20 @@ Result VKRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
         // Calculate the total size taking into account the array
         bufferSize *= arraySize;
 
-        Buffer uploadBuffer;
-        SLANG_RETURN_ON_FAIL(uploadBuffer.init(m_api, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+        // The buffer offset of a copy has to be a multiple of 4 and of the texel size
+        const size_t uploadAlignment = RendererUtil::getFormatSize(desc.format) * 4;
+
+        Buffer fallbackBuffer;
+        UploadAllocation upload;
+        SLANG_RETURN_ON_FAIL(_allocateUpload(bufferSize, uploadAlignment ? uploadAlignment : 16, fallbackBuffer, upload));
 
         assert(mipSizes.getCount() == numMipMaps);
 
-        // Copy into upload buffer
+        // Copy into upload memory
         {
             int subResourceIndex = 0;
 
-            uint8_t* dstData;
-            m_api.vkMapMemory(m_device, uploadBuffer.m_memory, 0, bufferSize, 0, (void**)&dstData);
+            uint8_t* dstData = upload.m_data;
 
             for (int i = 0; i < arraySize; ++i)
             {
@@ -1526,14 +2206,12 @@ Result VKRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
                     }
                 }
             }
-
-            m_api.vkUnmapMemory(m_device, uploadBuffer.m_memory);
         }
 
         _transitionImageLayout(texture->m_image, format, texture->getDesc(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
         {
-            size_t srcOffset = 0;
+            size_t srcOffset = upload.m_offset;
             for (int i = 0; i < arraySize; ++i)
             {
                 for (Index j = 0; j < mipSizes.getCount(); ++j)
@@ -1562,7 +2240,7 @@ Result VKRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
                     region.imageExtent = { uint32_t(mipSize.width), uint32_t(mipSize.height), uint32_t(mipSize.depth) };
 
                     // Do the copy (do all depths in a single go)
-                    m_api.vkCmdCopyBufferToImage(commandBuffer, uploadBuffer.m_buffer, texture->m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+                    m_api.vkCmdCopyBufferToImage(commandBuffer, upload.m_buffer, texture->m_image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 
                     // Next
                     srcOffset += rowSizeInBytes * numRows * mipSize.depth;
@@ -1572,13 +2250,52 @@ Result VKRenderer::createTextureResource(Resource::Usage initialUsage, const Tex
 
         _transitionImageLayout(texture->m_image, format, texture->getDesc(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
-        m_deviceQueue.flushAndWait();
+        // The upload ring keeps the data until the copies are done, but a fallback buffer only lives until we return
+        if (fallbackBuffer.isInitialized())
+        {
+            m_deviceQueue.flushAndWait();
+        }
     }
 
     *outResource = texture.detach();
     return SLANG_OK;
 }
 
+Result VKRenderer::_allocateUpload(size_t size, size_t alignment, Buffer& outFallback, UploadAllocation& outAllocation)
+{
+    if (size <= m_uploadRing.getSize())
+    {
+        m_uploadRing.updateCompleted(m_deviceQueue.getCompletedFenceValue());
+        ptrdiff_t offset = m_uploadRing.allocate(size, alignment);
+        if (offset < 0)
+        {
+            // The ring is full of data for copies that haven't been done yet, so do them
+            m_deviceQueue.flushAndWait();
+            m_uploadRing.updateCompleted(m_deviceQueue.getCompletedFenceValue());
+            offset = m_uploadRing.allocate(size, alignment);
+        }
+
+        if (offset >= 0)
+        {
+            // The copies are recorded in the current command buffer, so the memory is used until it's done
+            m_uploadRing.addSync(m_deviceQueue.getNextFenceValue());
+
+            outAllocation.m_buffer = m_uploadRingBuffer.m_buffer;
+            outAllocation.m_offset = size_t(offset);
+            outAllocation.m_data = m_uploadRing.getMappedData(size_t(offset));
+            return SLANG_OK;
+        }
+    }
+
+    // Too large for the ring, so it needs a buffer of its own
+    SLANG_RETURN_ON_FAIL(outFallback.init(m_memoryAllocator, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+
+    outAllocation.m_buffer = outFallback.m_buffer;
+    outAllocation.m_offset = 0;
+    outAllocation.m_data = outFallback.m_allocation.m_mappedData;
+    return SLANG_OK;
+}
+
 Result VKRenderer::createBufferResource(Resource::Usage initialUsage, const BufferResource::Desc& descIn, const void* initData, BufferResource** outResource)
 {
     BufferResource::Desc desc(descIn);
@@ -1601,32 +2318,37 @@ Result VKRenderer::createBufferResource(Resource::Usage initialUsage, const Buff
     }
 
     RefPtr<BufferResourceImpl> buffer(new BufferResourceImpl(initialUsage, desc, this));
-    SLANG_RETURN_ON_FAIL(buffer->m_buffer.init(m_api, desc.sizeInBytes, usage, reqMemoryProperties));
+    SLANG_RETURN_ON_FAIL(buffer->m_buffer.init(m_memoryAllocator, desc.sizeInBytes, usage, reqMemoryProperties));
 
-    if ((desc.cpuAccessFlags & Resource::AccessFlag::Write) || initData)
+    if (desc.cpuAccessFlags & Resource::AccessFlag::Write)
     {
-        SLANG_RETURN_ON_FAIL(buffer->m_uploadBuffer.init(m_api, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+        SLANG_RETURN_ON_FAIL(buffer->m_uploadBuffer.init(m_memoryAllocator, bufferSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
+        buffer->m_uploadData = buffer->m_uploadBuffer.m_allocation.m_mappedData;
     }
 
     if (initData)
     {
-        // TODO: only create staging buffer if the memory type
+        // TODO: only copy through upload memory if the memory type
         // used for the buffer doesn't let us fill things in
         // directly.
-        // Copy into staging buffer
-        void* mappedData = nullptr;
-        SLANG_VK_CHECK(m_api.vkMapMemory(m_device, buffer->m_uploadBuffer.m_memory, 0, bufferSize, 0, &mappedData));
-        ::memcpy(mappedData, initData, bufferSize);
-        m_api.vkUnmapMemory(m_device, buffer->m_uploadBuffer.m_memory);
+        Buffer fallbackBuffer;
+        UploadAllocation upload;
+        SLANG_RETURN_ON_FAIL(_allocateUpload(bufferSize, 16, fallbackBuffer, upload));
+        ::memcpy(upload.m_data, initData, bufferSize);
 
-        // Copy from staging buffer to real buffer
+        // Copy from upload memory to real buffer
         VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
 
         VkBufferCopy copyInfo = {};
+        copyInfo.srcOffset = upload.m_offset;
         copyInfo.size = bufferSize;
-        m_api.vkCmdCopyBuffer(commandBuffer, buffer->m_uploadBuffer.m_buffer, buffer->m_buffer.m_buffer, 1, &copyInfo);
+        m_api.vkCmdCopyBuffer(commandBuffer, upload.m_buffer, buffer->m_buffer.m_buffer, 1, &copyInfo);
 
-        //flushCommandBuffer(commandBuffer);
+        // The upload ring keeps the data until the copy is done, but a fallback buffer only lives until we return
+        if (fallbackBuffer.isInitialized())
+        {
+            m_deviceQueue.flushAndWait();
+        }
     }
 
     *outResource = buffer.detach();
@@ -1713,6 +2435,12 @@ static VkCompareOp translateComparisonFunc(ComparisonFunc func)
 
 Result VKRenderer::createSamplerState(SamplerState::Desc const& desc, SamplerState** outSampler)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getSamplerStateKey(desc);
+    if (m_objectCache.find(key, outSampler))
+    {
+        return SLANG_OK;
+    }
+
     VkSamplerCreateInfo samplerInfo = { VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO };
 
     samplerInfo.magFilter = translateFilterMode(desc.minFilter);
@@ -1738,6 +2466,7 @@ Result VKRenderer::createSamplerState(SamplerState::Desc const& desc, SamplerSta
 
     RefPtr<SamplerStateImpl> samplerImpl = new SamplerStateImpl();
     samplerImpl->m_sampler = sampler;
+    m_objectCache.add(key, samplerImpl);
     *outSampler = samplerImpl.detach();
     return SLANG_OK;
 }
@@ -1824,6 +2553,12 @@ Result VKRenderer::createBufferView(BufferResource* buffer, ResourceView::Desc c
 
 Result VKRenderer::createInputLayout(const InputElementDesc* elements, UInt numElements, InputLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getInputLayoutKey(elements, numElements);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<InputLayoutImpl> layout(new InputLayoutImpl);
 
     List<VkVertexInputAttributeDescription>& dstVertexDescs = layout->m_vertexDescs;
@@ -1855,6 +2590,7 @@ Result VKRenderer::createInputLayout(const InputElementDesc* elements, UInt numE
 
     // Work out the overall size
     layout->m_vertexSize = int(vertexSize);
+    m_objectCache.add(key, layout);
     *outLayout = layout.detach();
     return SLANG_OK;
 }
@@ -1864,51 +2600,56 @@ void* VKRenderer::map(BufferResource* bufferIn, MapFlavor flavor)
     BufferResourceImpl* buffer = static_cast<BufferResourceImpl*>(bufferIn);
     assert(buffer->m_mapFlavor == MapFlavor::Unknown);
 
-    // Make sure everything has completed before reading...
-    m_deviceQueue.flushAndWait();
-
     const size_t bufferSize = buffer->getDesc().sizeInBytes;
 
     switch (flavor)
     {
         case MapFlavor::WriteDiscard:
+        {
+            // The contents are written to the upload ring, and copied into the buffer on unmap, so there is nothing
+            // to wait for. Buffers too large for the ring are handled like HostWrite.
+            if (bufferSize <= m_uploadRing.getSize())
+            {
+                Buffer fallbackBuffer;
+                UploadAllocation upload;
+                SLANG_RETURN_NULL_ON_FAIL(_allocateUpload(bufferSize, 16, fallbackBuffer, upload));
+                assert(!fallbackBuffer.isInitialized());
+
+                buffer->m_mapUploadOffset = upload.m_offset;
+                buffer->m_mapFlavor = flavor;
+                return upload.m_data;
+            }
+            flavor = MapFlavor::HostWrite;
+            // Fall through
+        }
         case MapFlavor::HostWrite:
         {
-            if (!buffer->m_uploadBuffer.isInitialized())
+            if (!buffer->m_uploadData)
             {
                 return nullptr;
             }
 
-            void* mappedData = nullptr;
-            SLANG_VK_CHECK(m_api.vkMapMemory(m_device, buffer->m_uploadBuffer.m_memory, 0, bufferSize, 0, &mappedData));
+            // Make sure a previous copy from the upload buffer has completed before writing...
+            m_deviceQueue.flushAndWait();
+
             buffer->m_mapFlavor = flavor;
-            return mappedData;
+            return buffer->m_uploadData;
         }
         case MapFlavor::HostRead:
         {
-            // Make sure there is space in the read buffer
-            buffer->m_readBuffer.setCount(bufferSize);
-
-            // create staging buffer
-            Buffer staging;
-
-            SLANG_RETURN_NULL_ON_FAIL(staging.init(m_api, bufferSize, VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT));
-
-            // Copy from real buffer to staging buffer
-            VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
-
-            VkBufferCopy copyInfo = {};
-            copyInfo.size = bufferSize;
-            m_api.vkCmdCopyBuffer(commandBuffer, buffer->m_buffer.m_buffer, staging.m_buffer, 1, &copyInfo);
-
-            m_deviceQueue.flushAndWait();
-
-            // Write out the data from the buffer
-            void* mappedData = nullptr;
-            SLANG_VK_CHECK(m_api.vkMapMemory(m_device, staging.m_memory, 0, bufferSize, 0, &mappedData));
+            // Blocks until the copy has completed. readBuffers can read many buffers without blocking.
+            BufferResource* buffers[] = { buffer };
+            RefPtr<BufferReadback> readback;
+            SLANG_RETURN_NULL_ON_FAIL(readBuffers(SLANG_COUNT_OF(buffers), buffers, readback.writeRef()));
+            const void* data = readback->getData(0);
+            if (!data)
+            {
+                return nullptr;
+            }
 
-            ::memcpy(buffer->m_readBuffer.getBuffer(), mappedData, bufferSize);
-            m_api.vkUnmapMemory(m_device, staging.m_memory);
+            // Copy to the read buffer, so the readback buffer can be reused
+            buffer->m_readBuffer.setCount(bufferSize);
+            ::memcpy(buffer->m_readBuffer.getBuffer(), data, bufferSize);
 
             buffer->m_mapFlavor = flavor;
 
@@ -1929,10 +2670,18 @@ void VKRenderer::unmap(BufferResource* bufferIn)
     switch (buffer->m_mapFlavor)
     {
         case MapFlavor::WriteDiscard:
-        case MapFlavor::HostWrite:
         {
-            m_api.vkUnmapMemory(m_device, buffer->m_uploadBuffer.m_memory);
+            // Copy from the upload ring to real buffer
+            VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
 
+            VkBufferCopy copyInfo = {};
+            copyInfo.srcOffset = buffer->m_mapUploadOffset;
+            copyInfo.size = bufferSize;
+            m_api.vkCmdCopyBuffer(commandBuffer, m_uploadRingBuffer.m_buffer, buffer->m_buffer.m_buffer, 1, &copyInfo);
+            break;
+        }
+        case MapFlavor::HostWrite:
+        {
             // Copy from staging buffer to real buffer
             VkCommandBuffer commandBuffer = m_deviceQueue.getCommandBuffer();
 
@@ -2080,6 +2829,10 @@ void VKRenderer::drawIndexed(UInt indexCount, UInt startIndex, UInt baseVertex)
 {
 }
 
+void VKRenderer::drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex, UInt baseVertex, UInt startInstance)
+{
+}
+
 void VKRenderer::dispatchCompute(int x, int y, int z)
 {
     auto pipeline = m_currentPipeline;
@@ -2292,6 +3045,12 @@ static VkDescriptorType translateDescriptorType(DescriptorSlotType type)
 
 Result VKRenderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& desc, DescriptorSetLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getDescriptorSetLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     RefPtr<DescriptorSetLayoutImpl> descriptorSetLayoutImpl = new DescriptorSetLayoutImpl(m_api);
 
     Slang::List<VkDescriptorSetLayoutBinding> dstBindings;
@@ -2328,31 +3087,11 @@ Result VKRenderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& de
     VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
     SLANG_VK_CHECK(m_api.vkCreateDescriptorSetLayout(m_device, &descriptorSetLayoutInfo, nullptr, &descriptorSetLayout));
 
-    // Create a pool while we are at it, to allocate descriptor sets of this type.
-
-    VkDescriptorPoolSize poolSizes[VK_DESCRIPTOR_TYPE_RANGE_SIZE];
-    uint32_t poolSizeCount = 0;
-    for (int ii = 0; ii < SLANG_COUNT_OF(descriptorCountForTypes); ++ii)
-    {
-        auto descriptorCount = descriptorCountForTypes[ii];
-        if (descriptorCount > 0)
-        {
-            poolSizes[poolSizeCount].type = VkDescriptorType(ii);
-            poolSizes[poolSizeCount].descriptorCount = descriptorCount;
-            poolSizeCount++;
-        }
-    }
-
-    VkDescriptorPoolCreateInfo descriptorPoolInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
-    descriptorPoolInfo.maxSets = 128; // TODO: actually pick a size.
-    descriptorPoolInfo.poolSizeCount = poolSizeCount;
-    descriptorPoolInfo.pPoolSizes = &poolSizes[0];
-
-    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
-    SLANG_VK_CHECK(m_api.vkCreateDescriptorPool(m_device, &descriptorPoolInfo, nullptr, &descriptorPool));
-
     descriptorSetLayoutImpl->m_descriptorSetLayout = descriptorSetLayout;
-    descriptorSetLayoutImpl->m_descriptorPool = descriptorPool;
+    // Sets of this layout are allocated from pools shared with other layouts of the same size
+    descriptorSetLayoutImpl->m_sizeClass = m_descriptorSetAllocator.getSizeClass(descriptorCountForTypes);
+
+    m_objectCache.add(key, descriptorSetLayoutImpl);
 
     *outLayout = descriptorSetLayoutImpl.detach();
     return SLANG_OK;
@@ -2360,6 +3099,12 @@ Result VKRenderer::createDescriptorSetLayout(const DescriptorSetLayout::Desc& de
 
 Result VKRenderer::createPipelineLayout(const PipelineLayout::Desc& desc, PipelineLayout** outLayout)
 {
+    const RenderObjectCache::Key key = RenderObjectCache::getPipelineLayoutKey(desc);
+    if (m_objectCache.find(key, outLayout))
+    {
+        return SLANG_OK;
+    }
+
     UInt descriptorSetCount = desc.descriptorSetCount;
 
     VkDescriptorSetLayout descriptorSetLayouts[kMaxDescriptorSets];
@@ -2379,6 +3124,8 @@ Result VKRenderer::createPipelineLayout(const PipelineLayout::Desc& desc, Pipeli
     pipelineLayoutImpl->m_pipelineLayout = pipelineLayout;
     pipelineLayoutImpl->m_descriptorSetCount = descriptorSetCount;
 
+    m_objectCache.add(key, pipelineLayoutImpl);
+
     *outLayout = pipelineLayoutImpl.detach();
     return SLANG_OK;
 }
@@ -2387,17 +3134,24 @@ Result VKRenderer::createDescriptorSet(DescriptorSetLayout* layout, DescriptorSe
 {
     auto layoutImpl = (DescriptorSetLayoutImpl*)layout;
 
-    VkDescriptorSetAllocateInfo descriptorSetAllocInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
-    descriptorSetAllocInfo.descriptorPool = layoutImpl->m_descriptorPool;
-    descriptorSetAllocInfo.descriptorSetCount = 1;
-    descriptorSetAllocInfo.pSetLayouts = &layoutImpl->m_descriptorSetLayout;
+    RefPtr<DescriptorSetImpl> descriptorSetImpl = new DescriptorSetImpl(this);
+    SLANG_VK_RETURN_ON_FAIL(m_descriptorSetAllocator.allocate(layoutImpl->m_descriptorSetLayout, layoutImpl->m_sizeClass, descriptorSetImpl->m_allocation));
 
-    VkDescriptorSet descriptorSet;
-    SLANG_VK_CHECK(m_api.vkAllocateDescriptorSets(m_device, &descriptorSetAllocInfo, &descriptorSet));
+    descriptorSetImpl->m_layout = layoutImpl;
+    descriptorSetImpl->m_descriptorSet = descriptorSetImpl->m_allocation.m_descriptorSet;
+    *outDescriptorSet = descriptorSetImpl.detach();
+    return SLANG_OK;
+}
+
+Result VKRenderer::createTransientDescriptorSet(DescriptorSetLayout* layout, DescriptorSet** outDescriptorSet)
+{
+    auto layoutImpl = (DescriptorSetLayoutImpl*)layout;
 
     RefPtr<DescriptorSetImpl> descriptorSetImpl = new DescriptorSetImpl(this);
+    SLANG_VK_RETURN_ON_FAIL(m_descriptorSetAllocator.allocateTransient(layoutImpl->m_descriptorSetLayout, layoutImpl->m_sizeClass, descriptorSetImpl->m_allocation));
+
     descriptorSetImpl->m_layout = layoutImpl;
-    descriptorSetImpl->m_descriptorSet = descriptorSet;
+    descriptorSetImpl->m_descriptorSet = descriptorSetImpl->m_allocation.m_descriptorSet;
     *outDescriptorSet = descriptorSetImpl.detach();
     return SLANG_OK;
 }
@@ -2613,8 +3367,6 @@ Result VKRenderer::createProgram(const ShaderProgram::Desc& desc, ShaderProgram*
 
 Result VKRenderer::createGraphicsPipelineState(const GraphicsPipelineStateDesc& desc, PipelineState** outState)
 {
-    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-
     auto programImpl = (ShaderProgramImpl*) desc.program;
     auto pipelineLayoutImpl = (PipelineLayoutImpl*) desc.pipelineLayout;
     auto inputLayoutImpl = (InputLayoutImpl*) desc.inputLayout;
@@ -2729,7 +3481,7 @@ Result VKRenderer::createGraphicsPipelineState(const GraphicsPipelineStateDesc&
     pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    SLANG_VK_CHECK(m_api.vkCreateGraphicsPipelines(m_device, pipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
+    SLANG_VK_CHECK(m_api.vkCreateGraphicsPipelines(m_device, m_pipelineCache, 1, &pipelineInfo, nullptr, &pipeline));
 
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl(m_api);
     pipelineStateImpl->m_pipeline = pipeline;
@@ -2741,8 +3493,6 @@ Result VKRenderer::createGraphicsPipelineState(const GraphicsPipelineStateDesc&
 
 Result VKRenderer::createComputePipelineState(const ComputePipelineStateDesc& desc, PipelineState** outState)
 {
-    VkPipelineCache pipelineCache = VK_NULL_HANDLE;
-
     auto programImpl = (ShaderProgramImpl*) desc.program;
     auto pipelineLayoutImpl = (PipelineLayoutImpl*) desc.pipelineLayout;
 
@@ -2751,7 +3501,7 @@ Result VKRenderer::createComputePipelineState(const ComputePipelineStateDesc& de
     computePipelineInfo.layout = pipelineLayoutImpl->m_pipelineLayout;
 
     VkPipeline pipeline = VK_NULL_HANDLE;
-    SLANG_VK_CHECK(m_api.vkCreateComputePipelines(m_device, pipelineCache, 1, &computePipelineInfo, nullptr, &pipeline));
+    SLANG_VK_CHECK(m_api.vkCreateComputePipelines(m_device, m_pipelineCache, 1, &computePipelineInfo, nullptr, &pipeline));
 
     RefPtr<PipelineStateImpl> pipelineStateImpl = new PipelineStateImpl(m_api);
     pipelineStateImpl->m_pipeline = pipeline;
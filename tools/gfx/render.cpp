@@ -27,6 +27,43 @@ using namespace Slang;
     SLANG_COMPILE_TIME_ASSERT(SLANG_COUNT_OF(s_requiredBinding) == int(Usage::CountOf));
 }
 
+namespace { // anonymous
+
+    /// A readback that holds copies of the buffers made with map
+class MappedBufferReadback : public BufferReadback
+{
+public:
+    virtual bool isComplete() SLANG_OVERRIDE { return true; }
+    virtual const void* getData(UInt index) SLANG_OVERRIDE { return m_contents[Index(index)].getBuffer(); }
+
+    List<List<uint8_t>> m_contents;
+};
+
+} // anonymous
+
+Result Renderer::readBuffers(UInt count, BufferResource*const* buffers, BufferReadback** outReadback)
+{
+    RefPtr<MappedBufferReadback> readback = new MappedBufferReadback;
+    readback->m_contents.setCount(Index(count));
+
+    for (UInt i = 0; i < count; ++i)
+    {
+        BufferResource* buffer = buffers[i];
+        const size_t bufferSize = buffer->getDesc().sizeInBytes;
+
+        const uint8_t* data = (const uint8_t*)map(buffer, MapFlavor::HostRead);
+        if (!data)
+        {
+            return SLANG_FAIL;
+        }
+        readback->m_contents[Index(i)].addRange(data, Index(bufferSize));
+        unmap(buffer);
+    }
+
+    *outReadback = readback.detach();
+    return SLANG_OK;
+}
+
 static const Resource::DescBase s_emptyDescBase = {};
 
 const Resource::DescBase& Resource::getDescBase() const
@@ -60,6 +97,14 @@ const Resource::DescBase& Resource::getDescBase() const
 
     uint8_t(sizeof(float)),          // D_Float32,
     uint8_t(sizeof(uint32_t)),       // D_Unorm24_S8,
+
+    8,                               // BC1_Unorm,
+    16,                              // BC2_Unorm,
+    16,                              // BC3_Unorm,
+    8,                               // BC4_Unorm,
+    16,                              // BC5_Unorm,
+    16,                              // BC6H_UFloat16,
+    16,                              // BC7_Unorm,
 };
 
 /* static */const BindingStyle RendererUtil::s_rendererTypeToBindingStyle[] =
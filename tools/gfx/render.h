@@ -168,6 +168,15 @@ enum class Format
     D_Float32,
     D_Unorm24_S8,
 
+    // Block compressed formats. Each 4x4 block of pixels is encoded in 8 or 16 bytes, and a row of data is a row of blocks.
+    BC1_Unorm,
+    BC2_Unorm,
+    BC3_Unorm,
+    BC4_Unorm,
+    BC5_Unorm,
+    BC6H_UFloat16,
+    BC7_Unorm,
+
     CountOf,
 };
 
@@ -575,6 +584,12 @@ public:
     {
         Type    type;
         Format  format;
+
+            /// The mip levels of a 2D texture that a shader resource view can access - mipLevelCount levels starting at
+            /// mipLevel, or all of them from mipLevel if mipLevelCount is 0. An unordered access view only accesses mipLevel.
+            /// Only the D3D11 and D3D12 renderers take this into account.
+        int     mipLevel = 0;
+        int     mipLevelCount = 0;
     };
 };
 
@@ -757,6 +772,48 @@ class PipelineState : public Slang::RefObject
 public:
 };
 
+    /// A GPU queue that work is submitted to
+enum class QueueType
+{
+    Graphics,               ///< The queue the renderer submits the work recorded on it to
+    Compute,                ///< A queue for compute work, that can run at the same time as work on the graphics queue
+    CountOf,
+};
+
+    /// A list of commands that is recorded separately from the renderer, so that many can be recorded at the same time
+    /// on different threads, and then submitted together with Renderer::submitCommandBuffers.
+    ///
+    /// Currently only compute work can be recorded. A command buffer must only be used by one thread at a time, and
+    /// must not be recorded again (with begin) until the GPU has completed the work it was last submitted with.
+class CommandBuffer : public Slang::RefObject
+{
+public:
+        /// Start recording, discarding any previous commands
+    virtual Result begin() = 0;
+
+    virtual void setPipelineState(PipelineState* state) = 0;
+    virtual void setDescriptorSet(PipelineLayout* layout, UInt index, DescriptorSet* descriptorSet) = 0;
+    virtual void dispatchCompute(int x, int y, int z) = 0;
+
+        /// Write a GPU timestamp to a query, as for Renderer::writeTimestamp
+    virtual void writeTimestamp(UInt index) = 0;
+
+        /// Finish recording, so the buffer can be submitted. Returns the first failure while recording, if any.
+    virtual Result end() = 0;
+};
+
+    /// Copies of the contents of buffers, made on the GPU for the CPU to read, as returned by Renderer::readBuffers.
+    /// The renderer must outlive the readback.
+class BufferReadback : public Slang::RefObject
+{
+public:
+        /// True if the GPU has completed the copies, so getData won't block
+    virtual bool isComplete() = 0;
+        /// Get the contents of the buffer at index in the list passed to readBuffers, blocking until the copies have
+        /// completed. The data stays valid for the life of the readback. Returns nullptr on failure.
+    virtual const void* getData(UInt index) = 0;
+};
+
 struct ScissorRect
 {
     Int minX;
@@ -784,6 +841,8 @@ public:
         int width;                  ///< Width in pixels
         int height;                 ///< height in pixels
         Slang::String adapter;      ///< Name to identify the adapter to use
+        Slang::String pipelineCachePath;    ///< If set, pipelines compiled by the driver are loaded from and saved to this file (currently only used by Vulkan and D3D12)
+        bool bindless = false;              ///< If set, descriptor sets are held where shaders can access them, so binding a set doesn't copy its descriptors (currently only used by D3D12)
     };
 
     virtual SlangResult initialize(const Desc& desc, void* inWindowHandle) = 0;
@@ -882,6 +941,17 @@ public:
         return descriptorSet;
     }
 
+        /// Create a descriptor set that is only used in the current frame - it can't be bound or written to after the next
+        /// presentFrame. Renderers can allocate these in bulk and recycle them together. By default it's a regular descriptor set.
+    virtual Result createTransientDescriptorSet(DescriptorSetLayout* layout, DescriptorSet** outDescriptorSet) { return createDescriptorSet(layout, outDescriptorSet); }
+
+    inline RefPtr<DescriptorSet> createTransientDescriptorSet(DescriptorSetLayout* layout)
+    {
+        RefPtr<DescriptorSet> descriptorSet;
+        SLANG_RETURN_NULL_ON_FAIL(createTransientDescriptorSet(layout, descriptorSet.writeRef()));
+        return descriptorSet;
+    }
+
     virtual Result createProgram(const ShaderProgram::Desc& desc, ShaderProgram** outProgram) = 0;
 
     inline RefPtr<ShaderProgram> createProgram(const ShaderProgram::Desc& desc)
@@ -948,6 +1018,9 @@ public:
 
     virtual void draw(UInt vertexCount, UInt startVertex = 0) = 0;
     virtual void drawIndexed(UInt indexCount, UInt startIndex = 0, UInt baseVertex = 0) = 0;
+        /// Draw instanceCount instances of the indexed primitives. The shader sees SV_InstanceID from
+        /// startInstance to startInstance + instanceCount - 1.
+    virtual void drawIndexedInstanced(UInt indexCount, UInt instanceCount, UInt startIndex = 0, UInt baseVertex = 0, UInt startInstance = 0) = 0;
 
     virtual void dispatchCompute(int x, int y, int z) = 0;
 
@@ -957,6 +1030,49 @@ public:
         /// Blocks until Gpu work is complete
     virtual void waitForGpu() = 0;
 
+        /// Create a command buffer, for recording work on another thread that is submitted to queueType. Not all renderers
+        /// support command buffers. If the renderer has no separate compute queue, compute work is submitted to the graphics queue.
+    virtual Result createCommandBuffer(QueueType queueType, CommandBuffer** outCommandBuffer) { SLANG_UNUSED(queueType); SLANG_UNUSED(outCommandBuffer); return SLANG_E_NOT_IMPLEMENTED; }
+
+    inline RefPtr<CommandBuffer> createCommandBuffer(QueueType queueType = QueueType::Graphics)
+    {
+        RefPtr<CommandBuffer> commandBuffer;
+        SLANG_RETURN_NULL_ON_FAIL(createCommandBuffer(queueType, commandBuffer.writeRef()));
+        return commandBuffer;
+    }
+
+        /// Submit command buffers (that have been ended) in order, each to the queue it was created for. Work recorded on
+        /// the renderer itself is submitted first. Compute queue work waits (on the GPU) for all work submitted before it,
+        /// but later graphics queue work only waits for it if waitForQueue is used, so the two can run at the same time.
+        /// Must be called on the thread the renderer is used on.
+    virtual void submitCommandBuffers(UInt count, CommandBuffer* const* commandBuffers) { SLANG_UNUSED(count); SLANG_UNUSED(commandBuffers); }
+        /// Make work submitted to queue from now on (including work recorded on the renderer that hasn't been submitted yet)
+        /// wait on the GPU, without blocking the CPU, for the work submitted to waitQueue so far.
+    virtual void waitForQueue(QueueType queue, QueueType waitQueue) { SLANG_UNUSED(queue); SLANG_UNUSED(waitQueue); }
+
+        /// The number of timestamp queries a renderer has
+    static const UInt kMaxTimestampCount = 64;
+
+        /// Write a GPU timestamp to query index (< kMaxTimestampCount) once the work before it has completed. Returns
+        /// SLANG_E_NOT_AVAILABLE if the renderer doesn't support timestamps.
+    virtual Result writeTimestamp(UInt index) { SLANG_UNUSED(index); return SLANG_E_NOT_AVAILABLE; }
+        /// Get the values, in ticks, of count timestamp queries starting at index. Waits for all submitted work to complete.
+    virtual Result getTimestamps(UInt index, UInt count, uint64_t* outTimestamps) { SLANG_UNUSED(index); SLANG_UNUSED(count); SLANG_UNUSED(outTimestamps); return SLANG_E_NOT_AVAILABLE; }
+        /// Get the number of timestamp ticks per second, or 0 if timestamps aren't supported
+    virtual uint64_t getTimestampFrequency() { return 0; }
+
+        /// Copy the contents of count buffers into memory the CPU can read, once the work recorded before has completed.
+        /// The copies are submitted together, and nothing waits for them - the readback says when they are complete, and
+        /// holds the data. Back ends without a native implementation map each buffer with MapFlavor::HostRead, so the
+        /// readback is complete when returned.
+    virtual Result readBuffers(UInt count, BufferResource*const* buffers, BufferReadback** outReadback);
+    inline RefPtr<BufferReadback> readBuffers(UInt count, BufferResource*const* buffers)
+    {
+        RefPtr<BufferReadback> readback;
+        SLANG_RETURN_NULL_ON_FAIL(readBuffers(count, buffers, readback.writeRef()));
+        return readback;
+    }
+
         /// Get the type of this renderer
     virtual RendererType getRendererType() const = 0;
 };
@@ -970,8 +1086,13 @@ inline void Renderer::setVertexBuffer(UInt slot, BufferResource* buffer, UInt st
 /// Functions that are around Renderer and it's types
 struct RendererUtil
 {
-        /// Gets the size in bytes of a Format type. Returns 0 if a size is not defined/invalid
+        /// Gets the size in bytes of a Format type. Returns 0 if a size is not defined/invalid.
+        /// For a block compressed format it's the size of a block.
     SLANG_FORCE_INLINE static size_t getFormatSize(Format format) { return s_formatSize[int(format)]; }
+        /// True if the format is block compressed
+    SLANG_FORCE_INLINE static bool isBlockCompressed(Format format) { return format >= Format::BC1_Unorm && format <= Format::BC7_Unorm; }
+        /// Gets the width and height in pixels of a block of the format (1 if it isn't block compressed)
+    SLANG_FORCE_INLINE static int getFormatBlockSize(Format format) { return isBlockCompressed(format) ? 4 : 1; }
         /// Given a renderer type, gets a projection style
     static ProjectionStyle getProjectionStyle(RendererType type);
 
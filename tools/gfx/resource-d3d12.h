@@ -78,6 +78,8 @@ public:
 	SLANG_FORCE_INLINE uint64_t getCurrentValue() const { return m_currentValue; }
 		/// Get the completed value
 	SLANG_FORCE_INLINE uint64_t getCompletedValue() const { return m_fence->GetCompletedValue(); }
+		/// Get the fence, for example to make another queue wait on it
+	SLANG_FORCE_INLINE ID3D12Fence* getFence() const { return m_fence; }
 
 		/// Waits for the the specified value
 	void waitUntilCompleted(uint64_t completedValue);
@@ -72,18 +72,20 @@ void MallocSurfaceAllocator::deallocate(Surface& surface)
 
 /* static */int Surface::calcRowSize(Format format, int width)
 {
+    // For a compressed format the size is of a block, and a row is a row of blocks
     size_t pixelSize = RendererUtil::getFormatSize(format);
     if (pixelSize == 0)
     {
         return 0;
     }
-    return int(pixelSize * width);
+    const int blockSize = RendererUtil::getFormatBlockSize(format);
+    return int(pixelSize * ((width + blockSize - 1) / blockSize));
 }
 
 /* static */int Surface::calcNumRows(Format format, int height)
 {
-    // Don't have any compressed types, so number of rows is same as the height
-    return height;
+    const int blockSize = RendererUtil::getFormatBlockSize(format);
+    return (height + blockSize - 1) / blockSize;
 }
 
 void Surface::init()
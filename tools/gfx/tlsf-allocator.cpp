@@ -0,0 +1,313 @@
+// tlsf-allocator.cpp
+#include "tlsf-allocator.h"
+
+#include <assert.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#   include <intrin.h>
+#endif
+
+namespace gfx {
+using namespace Slang;
+
+    /// Get the index of the lowest set bit of a non zero mask
+static int _getLowestBitIndex(uint64_t mask)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    const uint32_t low = uint32_t(mask);
+    if (low)
+    {
+        _BitScanForward(&index, low);
+        return int(index);
+    }
+    _BitScanForward(&index, uint32_t(mask >> 32));
+    return int(index) + 32;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+    /// Get the index of the highest set bit of a non zero value
+static int _getHighestBitIndex(uint64_t value)
+{
+#if defined(_MSC_VER)
+    unsigned long index;
+    const uint32_t high = uint32_t(value >> 32);
+    if (high)
+    {
+        _BitScanReverse(&index, high);
+        return int(index) + 32;
+    }
+    _BitScanReverse(&index, uint32_t(value));
+    return int(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+void TLSFAllocator::init(uint64_t size)
+{
+    m_nodes.clear();
+    m_unusedNodes = kInvalidNode;
+    m_firstLevelMask = 0;
+    ::memset(m_secondLevelMasks, 0, sizeof(m_secondLevelMasks));
+
+    m_size = size;
+    m_freeSize = size;
+
+    if (size)
+    {
+        _addFree(_newNode(0, size));
+    }
+}
+
+/* static */void TLSFAllocator::_calcBin(uint64_t size, int& outFirstLevel, int& outSecondLevel)
+{
+    if (size < (uint64_t(1) << kSmallShift))
+    {
+        outFirstLevel = 0;
+        outSecondLevel = int(size >> (kSmallShift - kSecondLevelShift));
+        return;
+    }
+    const int highBit = _getHighestBitIndex(size);
+    outFirstLevel = highBit - kSmallShift + 1;
+    outSecondLevel = int(size >> (highBit - kSecondLevelShift)) - kSecondLevelCount;
+}
+
+bool TLSFAllocator::_findBin(uint64_t size, int& outFirstLevel, int& outSecondLevel) const
+{
+    // Round up to the start of the next bin, so any range in the bin found is large enough
+    if (size < (uint64_t(1) << kSmallShift))
+    {
+        size += (uint64_t(1) << (kSmallShift - kSecondLevelShift)) - 1;
+    }
+    else
+    {
+        const uint64_t round = (uint64_t(1) << (_getHighestBitIndex(size) - kSecondLevelShift)) - 1;
+        if (size > ~uint64_t(0) - round)
+        {
+            return false;
+        }
+        size += round;
+    }
+
+    int firstLevel, secondLevel;
+    _calcBin(size, firstLevel, secondLevel);
+
+    // A larger bin in the same first level bin
+    uint32_t secondLevelMask = m_secondLevelMasks[firstLevel] & (~uint32_t(0) << secondLevel);
+    if (!secondLevelMask)
+    {
+        // Else any bin in a larger first level bin
+        if (firstLevel + 1 >= kFirstLevelCount)
+        {
+            return false;
+        }
+        const uint64_t firstLevelMask = m_firstLevelMask & (~uint64_t(0) << (firstLevel + 1));
+        if (!firstLevelMask)
+        {
+            return false;
+        }
+        firstLevel = _getLowestBitIndex(firstLevelMask);
+        secondLevelMask = m_secondLevelMasks[firstLevel];
+    }
+
+    outFirstLevel = firstLevel;
+    outSecondLevel = _getLowestBitIndex(secondLevelMask);
+    return true;
+}
+
+uint32_t TLSFAllocator::_newNode(uint64_t offset, uint64_t size)
+{
+    uint32_t index = m_unusedNodes;
+    if (index != kInvalidNode)
+    {
+        m_unusedNodes = m_nodes[index].m_nextFree;
+    }
+    else
+    {
+        index = uint32_t(m_nodes.getCount());
+        m_nodes.add(Node());
+    }
+
+    Node& node = m_nodes[index];
+    node.m_offset = offset;
+    node.m_size = size;
+    node.m_prevRange = kInvalidNode;
+    node.m_nextRange = kInvalidNode;
+    node.m_prevFree = kInvalidNode;
+    node.m_nextFree = kInvalidNode;
+    node.m_isFree = false;
+    return index;
+}
+
+void TLSFAllocator::_addFree(uint32_t index)
+{
+    Node& node = m_nodes[index];
+    int firstLevel, secondLevel;
+    _calcBin(node.m_size, firstLevel, secondLevel);
+
+    const uint32_t head = m_bins[firstLevel][secondLevel];
+    const bool isBinEmpty = (m_secondLevelMasks[firstLevel] & (uint32_t(1) << secondLevel)) == 0;
+
+    node.m_isFree = true;
+    node.m_prevFree = kInvalidNode;
+    node.m_nextFree = isBinEmpty ? kInvalidNode : head;
+    if (!isBinEmpty)
+    {
+        m_nodes[head].m_prevFree = index;
+    }
+
+    m_bins[firstLevel][secondLevel] = index;
+    m_secondLevelMasks[firstLevel] |= uint32_t(1) << secondLevel;
+    m_firstLevelMask |= uint64_t(1) << firstLevel;
+}
+
+void TLSFAllocator::_removeFree(uint32_t index)
+{
+    Node& node = m_nodes[index];
+    assert(node.m_isFree);
+
+    if (node.m_prevFree != kInvalidNode)
+    {
+        m_nodes[node.m_prevFree].m_nextFree = node.m_nextFree;
+    }
+    if (node.m_nextFree != kInvalidNode)
+    {
+        m_nodes[node.m_nextFree].m_prevFree = node.m_prevFree;
+    }
+
+    int firstLevel, secondLevel;
+    _calcBin(node.m_size, firstLevel, secondLevel);
+    if (m_bins[firstLevel][secondLevel] == index)
+    {
+        m_bins[firstLevel][secondLevel] = node.m_nextFree;
+        if (node.m_nextFree == kInvalidNode)
+        {
+            m_secondLevelMasks[firstLevel] &= ~(uint32_t(1) << secondLevel);
+            if (!m_secondLevelMasks[firstLevel])
+            {
+                m_firstLevelMask &= ~(uint64_t(1) << firstLevel);
+            }
+        }
+    }
+
+    node.m_isFree = false;
+    node.m_prevFree = kInvalidNode;
+    node.m_nextFree = kInvalidNode;
+}
+
+void TLSFAllocator::_splitFree(uint32_t index, uint64_t offset)
+{
+    const uint64_t end = m_nodes[index].m_offset + m_nodes[index].m_size;
+    assert(offset > m_nodes[index].m_offset && offset < end);
+
+    // Adding a node can move the nodes, so no references are held over it
+    const uint32_t splitIndex = _newNode(offset, end - offset);
+    Node& node = m_nodes[index];
+    Node& split = m_nodes[splitIndex];
+
+    split.m_prevRange = index;
+    split.m_nextRange = node.m_nextRange;
+    if (node.m_nextRange != kInvalidNode)
+    {
+        m_nodes[node.m_nextRange].m_prevRange = splitIndex;
+    }
+    node.m_nextRange = splitIndex;
+    node.m_size = offset - node.m_offset;
+
+    _addFree(splitIndex);
+}
+
+bool TLSFAllocator::allocate(uint64_t size, uint64_t alignment, Allocation& outAllocation)
+{
+    assert(alignment && (alignment & (alignment - 1)) == 0);
+    size = size ? size : 1;
+
+    // Any range this large can hold size bytes at an aligned offset
+    const uint64_t searchSize = size + (alignment - 1);
+    if (searchSize < size)
+    {
+        return false;
+    }
+
+    int firstLevel, secondLevel;
+    if (!_findBin(searchSize, firstLevel, secondLevel))
+    {
+        return false;
+    }
+
+    uint32_t index = m_bins[firstLevel][secondLevel];
+    _removeFree(index);
+
+    // Any space before the aligned offset stays free
+    const uint64_t offset = m_nodes[index].m_offset;
+    const uint64_t alignedOffset = (offset + alignment - 1) & ~(alignment - 1);
+    if (alignedOffset != offset)
+    {
+        _splitFree(index, alignedOffset);
+        const uint32_t alignedIndex = m_nodes[index].m_nextRange;
+        _removeFree(alignedIndex);
+        _addFree(index);
+        index = alignedIndex;
+    }
+
+    // As does any space after it
+    if (m_nodes[index].m_size > size)
+    {
+        _splitFree(index, alignedOffset + size);
+    }
+
+    m_freeSize -= size;
+
+    outAllocation.m_offset = alignedOffset;
+    outAllocation.m_node = index;
+    return true;
+}
+
+void TLSFAllocator::free(uint32_t index)
+{
+    assert(index < uint32_t(m_nodes.getCount()) && !m_nodes[index].m_isFree);
+    m_freeSize += m_nodes[index].m_size;
+
+    // Merge with the following range if it's free
+    const uint32_t nextIndex = m_nodes[index].m_nextRange;
+    if (nextIndex != kInvalidNode && m_nodes[nextIndex].m_isFree)
+    {
+        _removeFree(nextIndex);
+        Node& node = m_nodes[index];
+        Node& next = m_nodes[nextIndex];
+        node.m_size += next.m_size;
+        node.m_nextRange = next.m_nextRange;
+        if (next.m_nextRange != kInvalidNode)
+        {
+            m_nodes[next.m_nextRange].m_prevRange = index;
+        }
+        next.m_nextFree = m_unusedNodes;
+        m_unusedNodes = nextIndex;
+    }
+
+    // And with the preceding range
+    const uint32_t prevIndex = m_nodes[index].m_prevRange;
+    if (prevIndex != kInvalidNode && m_nodes[prevIndex].m_isFree)
+    {
+        _removeFree(prevIndex);
+        Node& node = m_nodes[index];
+        Node& prev = m_nodes[prevIndex];
+        prev.m_size += node.m_size;
+        prev.m_nextRange = node.m_nextRange;
+        if (node.m_nextRange != kInvalidNode)
+        {
+            m_nodes[node.m_nextRange].m_prevRange = prevIndex;
+        }
+        node.m_nextFree = m_unusedNodes;
+        m_unusedNodes = index;
+        index = prevIndex;
+    }
+
+    _addFree(index);
+}
+
+} // namespace gfx
@@ -0,0 +1,89 @@
+// tlsf-allocator.h
+#pragma once
+
+#include "../../source/core/slang-list.h"
+
+namespace gfx {
+
+/*! \brief TLSFAllocator sub-allocates ranges of a fixed size space, such as a block of device memory, with a two level
+segregated fit allocator.
+
+Free ranges are kept in bins by size - the first level is the power of 2 of the size, and the second level splits that
+into kSecondLevelCount linear steps. Bitmasks of the non empty bins find a free range large enough for an allocation in
+constant time, and freeing merges a range with its free neighbors in constant time.
+
+The allocator doesn't know about the memory it manages, only offsets into it, so back ends can use it for any kind of
+heap. Each allocated or free range is a node, and an allocation is identified by its node index, which is passed to free.
+*/
+class TLSFAllocator
+{
+public:
+    typedef TLSFAllocator ThisType;
+
+    enum
+    {
+        kSecondLevelShift = 4,
+        kSecondLevelCount = 1 << kSecondLevelShift,         ///< Number of second level bins in each first level bin
+        kSmallShift = 8,                                    ///< Sizes below 1 << kSmallShift are in the first first level bin
+        kFirstLevelCount = 64 - kSmallShift + 1,
+    };
+
+    static const uint32_t kInvalidNode = ~uint32_t(0);
+
+    struct Allocation
+    {
+        uint64_t m_offset = 0;
+        uint32_t m_node = kInvalidNode;                     ///< Identifies the allocation when it's freed
+    };
+
+        /// Initialize to manage the offsets [0, size)
+    void init(uint64_t size);
+
+        /// Allocate size bytes, with the offset a multiple of alignment (which must be a power of 2).
+        /// Returns false if there isn't a large enough free range.
+    bool allocate(uint64_t size, uint64_t alignment, Allocation& outAllocation);
+        /// Free an allocation
+    void free(uint32_t node);
+
+        /// True if nothing is allocated
+    bool isEmpty() const { return m_freeSize == m_size; }
+        /// Get the size of the space
+    uint64_t getSize() const { return m_size; }
+        /// Get the total size of the free ranges
+    uint64_t getFreeSize() const { return m_freeSize; }
+
+protected:
+    struct Node
+    {
+        uint64_t m_offset;
+        uint64_t m_size;
+        uint32_t m_prevRange;                               ///< The node before this in the space, or kInvalidNode
+        uint32_t m_nextRange;                               ///< The node after this in the space, or kInvalidNode
+        uint32_t m_prevFree;                                ///< Previous node in the same bin (if free)
+        uint32_t m_nextFree;                                ///< Next node in the same bin (if free), or in the unused node list
+        bool m_isFree;
+    };
+
+        /// Get the bin that a free range of size is kept in
+    static void _calcBin(uint64_t size, int& outFirstLevel, int& outSecondLevel);
+        /// Find the first non empty bin where every range is at least size. Returns false if there isn't one.
+    bool _findBin(uint64_t size, int& outFirstLevel, int& outSecondLevel) const;
+
+    uint32_t _newNode(uint64_t offset, uint64_t size);
+    void _addFree(uint32_t node);
+    void _removeFree(uint32_t node);
+        /// Split the range of node at offset, adding the part from offset on as a new free node after it
+    void _splitFree(uint32_t node, uint64_t offset);
+
+    Slang::List<Node> m_nodes;
+    uint32_t m_unusedNodes = kInvalidNode;                  ///< Nodes that can be reused, linked by m_nextFree
+
+    uint64_t m_firstLevelMask = 0;                          ///< Bit per first level bin, set if any of its second level bins are non empty
+    uint32_t m_secondLevelMasks[kFirstLevelCount] = {};     ///< Bit per non empty second level bin
+    uint32_t m_bins[kFirstLevelCount][kSecondLevelCount];   ///< First free node in each bin
+
+    uint64_t m_size = 0;
+    uint64_t m_freeSize = 0;
+};
+
+} // namespace gfx
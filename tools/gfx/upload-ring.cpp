@@ -0,0 +1,76 @@
+// upload-ring.cpp
+#include "upload-ring.h"
+
+namespace gfx {
+using namespace Slang;
+
+void UploadRing::init(uint8_t* mappedData, size_t size)
+{
+    m_mappedData = mappedData;
+    m_size = size;
+    m_pendingQueue.clear();
+    m_front = 0;
+    m_back = 0;
+}
+
+ptrdiff_t UploadRing::allocate(size_t size, size_t alignment)
+{
+    if (size > m_size || alignment == 0)
+    {
+        return -1;
+    }
+
+    // Align the offset in the buffer, rather than the position, as the size needn't be a multiple of alignment
+    const size_t offset = size_t(m_front % m_size);
+    size_t alignedOffset = ((offset + alignment - 1) / alignment) * alignment;
+    uint64_t front = m_front + (alignedOffset - offset);
+
+    if (alignedOffset + size > m_size)
+    {
+        // Doesn't fit before the end, so skip to the start
+        front = m_front + (m_size - offset);
+        alignedOffset = 0;
+    }
+
+    if (front + size - m_back > m_size)
+    {
+        return -1;
+    }
+
+    m_front = front + size;
+    return ptrdiff_t(alignedOffset);
+}
+
+void UploadRing::addSync(uint64_t signalValue)
+{
+    const Index count = m_pendingQueue.getCount();
+    if (count > 0 && m_pendingQueue[count - 1].m_completedValue == signalValue)
+    {
+        // Extend the last sync point, rather than adding one per allocation
+        m_pendingQueue[count - 1].m_front = m_front;
+        return;
+    }
+
+    PendingEntry entry;
+    entry.m_completedValue = signalValue;
+    entry.m_front = m_front;
+    m_pendingQueue.add(entry);
+}
+
+void UploadRing::updateCompleted(uint64_t completedValue)
+{
+    const Index size = m_pendingQueue.getCount();
+    Index end = 0;
+    while (end < size && m_pendingQueue[end].m_completedValue <= completedValue)
+    {
+        end++;
+    }
+
+    if (end > 0)
+    {
+        m_back = m_pendingQueue[end - 1].m_front;
+        m_pendingQueue.removeRange(0, end);
+    }
+}
+
+} // namespace gfx
@@ -0,0 +1,64 @@
+// upload-ring.h
+#pragma once
+
+#include "../../source/core/slang-list.h"
+
+namespace gfx {
+
+/*! \brief UploadRing sub-allocates CPU written memory that the GPU reads from once, such as the initial contents of
+buffers and textures, or the contents of a buffer mapped with MapFlavor::WriteDiscard.
+
+The memory is a single buffer that is created and mapped by the back end (an upload heap resource on D3D12, a host
+visible and coherent buffer on Vulkan), and stays mapped for as long as the ring exists. So an upload is a copy into
+the ring, and a copy command on the GPU, without creating or mapping anything.
+
+The ring doesn't know about the API, and tracks when memory can be reused through fence values with the same
+addSync/updateCompleted idiom as D3D12CircularResourceHeap. A sync point made with addSync(value) says that everything
+allocated so far is no longer used once the fence has reached value. Unlike D3D12CircularResourceHeap the ring doesn't
+grow - if an allocation doesn't fit, allocate fails, and the caller can wait for the GPU, call updateCompleted and try
+again, or use some other memory.
+*/
+class UploadRing
+{
+public:
+    typedef UploadRing ThisType;
+
+        /// Initialize with the mapped memory of the buffer the back end created
+    void init(uint8_t* mappedData, size_t size);
+
+        /// Allocate size bytes, with the offset into the buffer a multiple of alignment (which doesn't have to be a power of 2).
+        /// Returns the offset, or -1 if there isn't space.
+    ptrdiff_t allocate(size_t size, size_t alignment);
+
+        /// Add a sync point - when the fence reaches signalValue everything allocated so far is no longer used.
+        /// Sync points must be added in increasing order of value, but the same value can be added more than once.
+    void addSync(uint64_t signalValue);
+        /// Free everything used by sync points with a value of at most completedValue
+    void updateCompleted(uint64_t completedValue);
+
+        /// True if nothing is allocated that the GPU may still use
+    bool isEmpty() const { return m_front == m_back; }
+
+        /// Get the mapped memory at offset
+    SLANG_FORCE_INLINE uint8_t* getMappedData(size_t offset) const { return m_mappedData + offset; }
+        /// Get the size of the buffer
+    SLANG_FORCE_INLINE size_t getSize() const { return m_size; }
+
+protected:
+    struct PendingEntry
+    {
+        uint64_t m_completedValue;                  ///< The fence value when this is completed
+        uint64_t m_front;                           ///< The front at that point
+    };
+
+    uint8_t* m_mappedData = nullptr;
+    size_t m_size = 0;
+    Slang::List<PendingEntry> m_pendingQueue;       ///< Sync points, in order of fence value
+
+    // Positions are the total number of bytes allocated (or skipped) since init, so the offset in the buffer
+    // is the position modulo the size, and front - back is the number of bytes in use.
+    uint64_t m_front = 0;
+    uint64_t m_back = 0;
+};
+
+} // namespace gfx
@@ -113,7 +113,7 @@ int VulkanApi::findMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags prop
     return -1;
 }
 
-int VulkanApi::findQueue(VkQueueFlags reqFlags) const
+int VulkanApi::findQueue(VkQueueFlags reqFlags, VkQueueFlags excludeFlags) const
 {
     assert(m_physicalDevice != VK_NULL_HANDLE);
 
@@ -130,7 +130,7 @@ int VulkanApi::findQueue(VkQueueFlags reqFlags) const
     int queueFamilyIndex = -1;
     for (int i = 0; i < int(numQueueFamilies); ++i)
     {
-        if ((queueFamilies[i].queueFlags & reqFlags) == reqFlags)
+        if ((queueFamilies[i].queueFlags & reqFlags) == reqFlags && (queueFamilies[i].queueFlags & excludeFlags) == 0)
         {
             return i;
         }
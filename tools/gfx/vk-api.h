@@ -32,6 +32,7 @@ namespace gfx {
 #define VK_API_DEVICE_PROCS(x) \
     x(vkCreateDescriptorPool) \
     x(vkDestroyDescriptorPool) \
+    x(vkResetDescriptorPool) \
     x(vkGetDeviceQueue) \
     x(vkQueueSubmit) \
     x(vkQueueWaitIdle) \
@@ -45,12 +46,16 @@ namespace gfx {
     x(vkCreateDescriptorSetLayout) \
     x(vkDestroyDescriptorSetLayout) \
     x(vkAllocateDescriptorSets) \
+    x(vkFreeDescriptorSets) \
     x(vkUpdateDescriptorSets) \
     x(vkCreatePipelineLayout) \
     x(vkDestroyPipelineLayout) \
     x(vkCreateComputePipelines) \
     x(vkCreateGraphicsPipelines) \
     x(vkDestroyPipeline) \
+    x(vkCreatePipelineCache) \
+    x(vkDestroyPipelineCache) \
+    x(vkGetPipelineCacheData) \
     x(vkCreateShaderModule) \
     x(vkDestroyShaderModule) \
     x(vkCreateFramebuffer) \
@@ -83,6 +88,12 @@ namespace gfx {
     x(vkCmdEndRenderPass) \
     x(vkCmdPipelineBarrier) \
     x(vkCmdCopyBufferToImage)\
+    x(vkCmdResetQueryPool) \
+    x(vkCmdWriteTimestamp) \
+    \
+    x(vkCreateQueryPool) \
+    x(vkDestroyQueryPool) \
+    x(vkGetQueryPoolResults) \
     \
     x(vkCreateFence) \
     x(vkDestroyFence) \
@@ -187,8 +198,9 @@ struct VulkanApi
         /// Returns -1 if couldn't find an appropriate memory type index
     int findMemoryTypeIndex(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
 
-        /// Given queue required flags, finds a queue
-    int findQueue(VkQueueFlags reqFlags) const;
+        /// Given queue required flags, finds a queue family that has them, and none of excludeFlags.
+        /// Returns -1 if there isn't one.
+    int findQueue(VkQueueFlags reqFlags, VkQueueFlags excludeFlags = 0) const;
 
     const VulkanModule* m_module = nullptr;               ///< Module this was all loaded from
     VkInstance m_instance = VK_NULL_HANDLE;
@@ -0,0 +1,258 @@
+// vk-descriptor-set-allocator.cpp
+#include "vk-descriptor-set-allocator.h"
+
+#include <assert.h>
+#include <string.h>
+
+namespace gfx {
+using namespace Slang;
+
+void VulkanDescriptorSetAllocator::init(const VulkanApi* api)
+{
+    assert(m_api == nullptr);
+    m_api = api;
+}
+
+VulkanDescriptorSetAllocator::~VulkanDescriptorSetAllocator()
+{
+    // Destroying a pool frees all of the sets allocated from it
+    for (auto& sizeClass : m_sizeClasses)
+    {
+        for (const auto& pool : sizeClass.m_pools)
+        {
+            m_api->vkDestroyDescriptorPool(m_api->m_device, pool.m_pool, nullptr);
+        }
+        for (auto pool : sizeClass.m_frameTransientPools)
+        {
+            m_api->vkDestroyDescriptorPool(m_api->m_device, pool, nullptr);
+        }
+        for (const auto& retired : sizeClass.m_retiredTransientPools)
+        {
+            m_api->vkDestroyDescriptorPool(m_api->m_device, retired.m_pool, nullptr);
+        }
+        for (auto pool : sizeClass.m_freeTransientPools)
+        {
+            m_api->vkDestroyDescriptorPool(m_api->m_device, pool, nullptr);
+        }
+    }
+}
+
+int VulkanDescriptorSetAllocator::getSizeClass(const uint32_t descriptorCounts[kDescriptorTypeCount])
+{
+    uint32_t roundedCounts[kDescriptorTypeCount];
+    for (int i = 0; i < kDescriptorTypeCount; ++i)
+    {
+        uint32_t count = descriptorCounts[i];
+        if (count)
+        {
+            // Round up to a power of 2
+            count--;
+            count |= count >> 1;
+            count |= count >> 2;
+            count |= count >> 4;
+            count |= count >> 8;
+            count |= count >> 16;
+            count++;
+        }
+        roundedCounts[i] = count;
+    }
+
+    // There are only ever a handful of size classes, so a linear search is fine
+    for (Index i = 0; i < m_sizeClasses.getCount(); ++i)
+    {
+        if (::memcmp(m_sizeClasses[i].m_descriptorCounts, roundedCounts, sizeof(roundedCounts)) == 0)
+        {
+            return int(i);
+        }
+    }
+
+    SizeClass sizeClass;
+    ::memcpy(sizeClass.m_descriptorCounts, roundedCounts, sizeof(roundedCounts));
+    m_sizeClasses.add(sizeClass);
+    return int(m_sizeClasses.getCount() - 1);
+}
+
+VkResult VulkanDescriptorSetAllocator::_createPool(const SizeClass& sizeClass, uint32_t setCount, VkDescriptorPoolCreateFlags flags, VkDescriptorPool& outPool)
+{
+    VkDescriptorPoolSize poolSizes[kDescriptorTypeCount];
+    uint32_t poolSizeCount = 0;
+    for (int i = 0; i < kDescriptorTypeCount; ++i)
+    {
+        const uint32_t descriptorCount = sizeClass.m_descriptorCounts[i];
+        if (descriptorCount > 0)
+        {
+            poolSizes[poolSizeCount].type = VkDescriptorType(i);
+            poolSizes[poolSizeCount].descriptorCount = descriptorCount * setCount;
+            poolSizeCount++;
+        }
+    }
+
+    VkDescriptorPoolCreateInfo poolInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.flags = flags;
+    poolInfo.maxSets = setCount;
+    poolInfo.poolSizeCount = poolSizeCount;
+    poolInfo.pPoolSizes = poolSizes;
+
+    const VkResult res = m_api->vkCreateDescriptorPool(m_api->m_device, &poolInfo, nullptr, &outPool);
+    if (res == VK_SUCCESS)
+    {
+        m_poolCount++;
+    }
+    return res;
+}
+
+VkResult VulkanDescriptorSetAllocator::_allocateSet(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& outDescriptorSet)
+{
+    VkDescriptorSetAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocateInfo.descriptorPool = pool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &layout;
+    return m_api->vkAllocateDescriptorSets(m_api->m_device, &allocateInfo, &outDescriptorSet);
+}
+
+VkResult VulkanDescriptorSetAllocator::allocate(VkDescriptorSetLayout layout, int sizeClassIndex, VulkanDescriptorSetAllocation& outAllocation)
+{
+    assert(outAllocation.m_descriptorSet == VK_NULL_HANDLE);
+    SizeClass& sizeClass = m_sizeClasses[sizeClassIndex];
+
+    // Newer pools are larger, so are the most likely to have space
+    for (Index i = sizeClass.m_pools.getCount() - 1; i >= 0; --i)
+    {
+        Pool& pool = sizeClass.m_pools[i];
+        // A pool can fail to allocate even with sets free if it's fragmented, so try the next one
+        if (pool.m_freeSetCount && _allocateSet(pool.m_pool, layout, outAllocation.m_descriptorSet) == VK_SUCCESS)
+        {
+            pool.m_freeSetCount--;
+            outAllocation.m_sizeClass = sizeClassIndex;
+            outAllocation.m_poolIndex = int(i);
+            return VK_SUCCESS;
+        }
+    }
+
+    // All the pools are full, so add one
+    Pool pool;
+    pool.m_freeSetCount = sizeClass.m_nextPoolSetCount;
+    VkResult res = _createPool(sizeClass, pool.m_freeSetCount, VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT, pool.m_pool);
+    if (res != VK_SUCCESS)
+    {
+        return res;
+    }
+    sizeClass.m_nextPoolSetCount = Math::Min(sizeClass.m_nextPoolSetCount * 2, uint32_t(kMaxPoolSetCount));
+    sizeClass.m_pools.add(pool);
+
+    res = _allocateSet(pool.m_pool, layout, outAllocation.m_descriptorSet);
+    if (res != VK_SUCCESS)
+    {
+        return res;
+    }
+    sizeClass.m_pools.getLast().m_freeSetCount--;
+    outAllocation.m_sizeClass = sizeClassIndex;
+    outAllocation.m_poolIndex = int(sizeClass.m_pools.getCount() - 1);
+    return VK_SUCCESS;
+}
+
+VkResult VulkanDescriptorSetAllocator::allocateTransient(VkDescriptorSetLayout layout, int sizeClassIndex, VulkanDescriptorSetAllocation& outAllocation)
+{
+    assert(outAllocation.m_descriptorSet == VK_NULL_HANDLE);
+    SizeClass& sizeClass = m_sizeClasses[sizeClassIndex];
+
+    outAllocation.m_sizeClass = sizeClassIndex;
+    outAllocation.m_poolIndex = -1;
+
+    if (sizeClass.m_frameTransientPools.getCount() &&
+        _allocateSet(sizeClass.m_frameTransientPools.getLast(), layout, outAllocation.m_descriptorSet) == VK_SUCCESS)
+    {
+        return VK_SUCCESS;
+    }
+
+    // The frame's pool is full, so use a recycled pool, or else add one
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (sizeClass.m_freeTransientPools.getCount())
+    {
+        pool = sizeClass.m_freeTransientPools.getLast();
+        sizeClass.m_freeTransientPools.removeLast();
+    }
+    else
+    {
+        const VkResult res = _createPool(sizeClass, kTransientPoolSetCount, 0, pool);
+        if (res != VK_SUCCESS)
+        {
+            return res;
+        }
+    }
+    sizeClass.m_frameTransientPools.add(pool);
+
+    return _allocateSet(pool, layout, outAllocation.m_descriptorSet);
+}
+
+void VulkanDescriptorSetAllocator::free(VulkanDescriptorSetAllocation& ioAllocation)
+{
+    if (ioAllocation.m_descriptorSet != VK_NULL_HANDLE && ioAllocation.m_poolIndex >= 0)
+    {
+        FreedSet freedSet;
+        freedSet.m_descriptorSet = ioAllocation.m_descriptorSet;
+        freedSet.m_sizeClass = ioAllocation.m_sizeClass;
+        freedSet.m_poolIndex = ioAllocation.m_poolIndex;
+        freedSet.m_fenceValue = 0;
+        m_freedSets.add(freedSet);
+    }
+    ioAllocation = VulkanDescriptorSetAllocation();
+}
+
+void VulkanDescriptorSetAllocator::endFrame(uint64_t fenceValue, uint64_t completedFenceValue)
+{
+    for (auto& sizeClass : m_sizeClasses)
+    {
+        // Retire the transient pools used in this frame
+        for (auto pool : sizeClass.m_frameTransientPools)
+        {
+            RetiredPool retired;
+            retired.m_pool = pool;
+            retired.m_fenceValue = fenceValue;
+            sizeClass.m_retiredTransientPools.add(retired);
+        }
+        sizeClass.m_frameTransientPools.clear();
+
+        // Reset the ones whose frame has completed
+        Index resetCount = 0;
+        for (const auto& retired : sizeClass.m_retiredTransientPools)
+        {
+            if (retired.m_fenceValue > completedFenceValue)
+            {
+                break;
+            }
+            m_api->vkResetDescriptorPool(m_api->m_device, retired.m_pool, 0);
+            sizeClass.m_freeTransientPools.add(retired.m_pool);
+            resetCount++;
+        }
+        if (resetCount)
+        {
+            sizeClass.m_retiredTransientPools.removeRange(0, resetCount);
+        }
+    }
+
+    // Free the sets whose frame has completed, keeping the rest in order
+    Index keepCount = 0;
+    for (Index i = 0; i < m_freedSets.getCount(); ++i)
+    {
+        FreedSet freedSet = m_freedSets[i];
+        if (freedSet.m_fenceValue == 0)
+        {
+            freedSet.m_fenceValue = fenceValue;
+        }
+
+        if (freedSet.m_fenceValue <= completedFenceValue)
+        {
+            Pool& pool = m_sizeClasses[freedSet.m_sizeClass].m_pools[freedSet.m_poolIndex];
+            m_api->vkFreeDescriptorSets(m_api->m_device, pool.m_pool, 1, &freedSet.m_descriptorSet);
+            pool.m_freeSetCount++;
+        }
+        else
+        {
+            m_freedSets[keepCount++] = freedSet;
+        }
+    }
+    m_freedSets.setCount(keepCount);
+}
+
+} // namespace gfx
@@ -0,0 +1,109 @@
+// vk-descriptor-set-allocator.h
+#pragma once
+
+#include "vk-api.h"
+
+#include "../../source/core/slang-list.h"
+
+namespace gfx {
+
+    /// A descriptor set allocated by VulkanDescriptorSetAllocator
+struct VulkanDescriptorSetAllocation
+{
+    VkDescriptorSet m_descriptorSet = VK_NULL_HANDLE;
+    int m_sizeClass = -1;
+    int m_poolIndex = -1;                       ///< The pool in the size class, or -1 if the set is transient
+};
+
+/*! \brief VulkanDescriptorSetAllocator allocates descriptor sets from pools shared by all layouts of the same size class.
+
+A layout's size class is the number of descriptors of each type it holds, each rounded up to a power of 2, so layouts
+with similar bindings share pools. Each size class has
+
+* Persistent pools that sets are individually freed back to. A new pool is added when the others are full, and holds
+twice as many sets as the last one (up to kMaxPoolSetCount), so creating a set very rarely creates a pool.
+* Transient pools, for sets only used in the frame they are allocated in. The pools used in a frame are retired at the end
+of it, and once the GPU has completed the frame each one is reset in bulk (rather than freeing its sets) and used again.
+
+Sets can still be in use by the GPU when they are freed, so frees are deferred until the end of the frame and happen once
+the frame's fence value has completed.
+*/
+class VulkanDescriptorSetAllocator
+{
+public:
+    typedef VulkanDescriptorSetAllocator ThisType;
+
+    enum
+    {
+        kDescriptorTypeCount = VK_DESCRIPTOR_TYPE_RANGE_SIZE,
+        kMinPoolSetCount = 16,                  ///< The number of sets in the first persistent pool of a size class
+        kMaxPoolSetCount = 1024,
+        kTransientPoolSetCount = 64,            ///< The number of sets in each transient pool
+    };
+
+        /// Initialize
+    void init(const VulkanApi* api);
+
+        /// Get the size class for a layout holding descriptorCounts descriptors of each type
+    int getSizeClass(const uint32_t descriptorCounts[kDescriptorTypeCount]);
+
+        /// Allocate a set that is freed with free
+    VkResult allocate(VkDescriptorSetLayout layout, int sizeClass, VulkanDescriptorSetAllocation& outAllocation);
+        /// Allocate a set that can only be used until endFrame. It's recycled with the other sets allocated in the frame.
+    VkResult allocateTransient(VkDescriptorSetLayout layout, int sizeClass, VulkanDescriptorSetAllocation& outAllocation);
+        /// Free an allocation (if it's allocated and not transient), resetting it. It's only reused after the current frame has completed.
+    void free(VulkanDescriptorSetAllocation& ioAllocation);
+
+        /// End the frame. The sets freed and the transient sets allocated in it are recycled once fenceValue has completed.
+        /// completedFenceValue is used to recycle the sets of earlier frames.
+    void endFrame(uint64_t fenceValue, uint64_t completedFenceValue);
+
+        /// True if any descriptor pools have been created
+    bool hasPools() const { return m_poolCount > 0; }
+
+        /// Destroys all of the pools. No set allocated can be used after this.
+    ~VulkanDescriptorSetAllocator();
+
+protected:
+    struct Pool
+    {
+        VkDescriptorPool m_pool;
+        uint32_t m_freeSetCount;
+    };
+
+    struct RetiredPool
+    {
+        VkDescriptorPool m_pool;
+        uint64_t m_fenceValue;
+    };
+
+    struct SizeClass
+    {
+        uint32_t m_descriptorCounts[kDescriptorTypeCount];  ///< Per set
+        uint32_t m_nextPoolSetCount = kMinPoolSetCount;
+
+        Slang::List<Pool> m_pools;
+
+        Slang::List<VkDescriptorPool> m_frameTransientPools;    ///< Used in the current frame. Sets are allocated from the last one.
+        Slang::List<RetiredPool> m_retiredTransientPools;       ///< Used in earlier frames, in fence value order
+        Slang::List<VkDescriptorPool> m_freeTransientPools;     ///< Reset, and ready to use
+    };
+
+    struct FreedSet
+    {
+        VkDescriptorSet m_descriptorSet;
+        int m_sizeClass;
+        int m_poolIndex;
+        uint64_t m_fenceValue;
+    };
+
+    VkResult _createPool(const SizeClass& sizeClass, uint32_t setCount, VkDescriptorPoolCreateFlags flags, VkDescriptorPool& outPool);
+    VkResult _allocateSet(VkDescriptorPool pool, VkDescriptorSetLayout layout, VkDescriptorSet& outDescriptorSet);
+
+    const VulkanApi* m_api = nullptr;
+    Slang::List<SizeClass> m_sizeClasses;
+    Slang::List<FreedSet> m_freedSets;      ///< Sets waiting to be freed. Those freed in the current frame are at the end, with a fence value of 0.
+    Slang::Index m_poolCount = 0;
+};
+
+} // namespace gfx
@@ -181,6 +181,36 @@ void VulkanDeviceQueue::flushAndWait()
 {
     flush();
     waitForIdle();
+
+    // Everything has completed, so this won't block
+    for (int i = 0; i < m_numCommandBuffers; ++i)
+    {
+        _updateFenceAtIndex(i, false);
+    }
+}
+
+uint64_t VulkanDeviceQueue::updateCompletedFenceValue()
+{
+    for (int i = 0; i < m_numCommandBuffers; ++i)
+    {
+        _updateFenceAtIndex(i, false);
+    }
+    return m_lastFenceCompleted;
+}
+
+void VulkanDeviceQueue::waitForFenceValue(uint64_t value)
+{
+    assert(value < m_nextFenceValue);
+
+    // Command buffers complete in order, so waiting for all of those up to value is only waiting for the last one
+    for (int i = 0; i < m_numCommandBuffers && m_lastFenceCompleted < value; ++i)
+    {
+        const Fence& fence = m_fences[i];
+        if (fence.active && fence.value <= value)
+        {
+            _updateFenceAtIndex(i, true);
+        }
+    }
 }
 
 VkSemaphore VulkanDeviceQueue::makeCurrent(EventType eventType)
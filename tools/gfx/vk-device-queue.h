@@ -49,6 +49,15 @@ struct VulkanDeviceQueue
         /// Get the API
     const VulkanApi* getApi() const { return m_api; }
 
+        /// Get the fence value that the commands in the current command buffer will signal when they complete
+    uint64_t getNextFenceValue() const { return m_nextFenceValue; }
+        /// Get the value of the last fence known to have completed. Updated by flush and flushAndWait.
+    uint64_t getCompletedFenceValue() const { return m_lastFenceCompleted; }
+        /// Check (without blocking) which submitted command buffers have completed, and return the completed fence value
+    uint64_t updateCompletedFenceValue();
+        /// Block until the commands that signal fence value have completed. They must have been submitted.
+    void waitForFenceValue(uint64_t value);
+
         /// Flushes the current command list
     void flushStepA();
         /// Steps to next command buffer and opens. May block if command buffer is still in use
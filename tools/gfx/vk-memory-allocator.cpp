@@ -0,0 +1,205 @@
+// vk-memory-allocator.cpp
+#include "vk-memory-allocator.h"
+
+#include <assert.h>
+
+namespace gfx {
+using namespace Slang;
+
+void VulkanMemoryAllocator::init(const VulkanApi* api, VkDeviceSize blockSize)
+{
+    assert(m_api == nullptr);
+    m_api = api;
+    m_blockSize = blockSize;
+
+    const VkPhysicalDeviceMemoryProperties& memoryProperties = api->m_deviceMemoryProperties;
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; ++i)
+    {
+        // Small device heaps (such as a 256MB host visible window into device memory) get smaller blocks
+        const VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[i].heapIndex].size;
+        VkDeviceSize heapBlockSize = blockSize;
+        while (heapBlockSize > 1024 * 1024 && heapBlockSize > heapSize / 8)
+        {
+            heapBlockSize /= 2;
+        }
+
+        for (auto& heap : m_heaps[i])
+        {
+            heap.m_memoryTypeIndex = i;
+            heap.m_blockSize = heapBlockSize;
+        }
+    }
+}
+
+VulkanMemoryAllocator::~VulkanMemoryAllocator()
+{
+    for (auto& heaps : m_heaps)
+    {
+        for (auto& heap : heaps)
+        {
+            for (Block* block : heap.m_blocks)
+            {
+                if (block)
+                {
+                    _freeDeviceMemory(block->m_memory, block->m_mappedData);
+                    delete block;
+                }
+            }
+        }
+    }
+}
+
+VkResult VulkanMemoryAllocator::_allocateDeviceMemory(uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceMemory& outMemory, uint8_t*& outMappedData)
+{
+    VkMemoryAllocateInfo allocateInfo = { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+    allocateInfo.allocationSize = size;
+    allocateInfo.memoryTypeIndex = memoryTypeIndex;
+
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkResult res = m_api->vkAllocateMemory(m_api->m_device, &allocateInfo, nullptr, &memory);
+    if (res != VK_SUCCESS)
+    {
+        return res;
+    }
+
+    void* mappedData = nullptr;
+    if (m_api->m_deviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+    {
+        res = m_api->vkMapMemory(m_api->m_device, memory, 0, VK_WHOLE_SIZE, 0, &mappedData);
+        if (res != VK_SUCCESS)
+        {
+            m_api->vkFreeMemory(m_api->m_device, memory, nullptr);
+            return res;
+        }
+    }
+
+    m_deviceAllocationCount++;
+    outMemory = memory;
+    outMappedData = (uint8_t*)mappedData;
+    return VK_SUCCESS;
+}
+
+void VulkanMemoryAllocator::_freeDeviceMemory(VkDeviceMemory memory, uint8_t* mappedData)
+{
+    if (mappedData)
+    {
+        m_api->vkUnmapMemory(m_api->m_device, memory);
+    }
+    m_api->vkFreeMemory(m_api->m_device, memory, nullptr);
+    m_deviceAllocationCount--;
+}
+
+VkResult VulkanMemoryAllocator::allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, ResourceKind kind, VulkanMemoryAllocation& outAllocation)
+{
+    assert(outAllocation.m_memory == VK_NULL_HANDLE);
+
+    const int memoryTypeIndex = m_api->findMemoryTypeIndex(requirements.memoryTypeBits, properties);
+    if (memoryTypeIndex < 0)
+    {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    Heap& heap = m_heaps[memoryTypeIndex][int(kind)];
+
+    // Large resources would waste much of a block, so get memory of their own
+    if (requirements.size > heap.m_blockSize / 2)
+    {
+        outAllocation.m_heapIndex = -1;
+        outAllocation.m_offset = 0;
+        return _allocateDeviceMemory(uint32_t(memoryTypeIndex), requirements.size, outAllocation.m_memory, outAllocation.m_mappedData);
+    }
+
+    TLSFAllocator::Allocation blockAllocation;
+    Index blockIndex = -1;
+    Index freeBlockIndex = -1;
+    for (Index i = 0; i < heap.m_blocks.getCount(); ++i)
+    {
+        Block* block = heap.m_blocks[i];
+        if (!block)
+        {
+            freeBlockIndex = i;
+        }
+        else if (block->m_allocator.allocate(requirements.size, requirements.alignment, blockAllocation))
+        {
+            blockIndex = i;
+            break;
+        }
+    }
+
+    if (blockIndex < 0)
+    {
+        // All the blocks are full, so add one
+        Block* block = new Block;
+        const VkResult res = _allocateDeviceMemory(heap.m_memoryTypeIndex, heap.m_blockSize, block->m_memory, block->m_mappedData);
+        if (res != VK_SUCCESS)
+        {
+            delete block;
+            return res;
+        }
+        block->m_allocator.init(heap.m_blockSize);
+
+        if (freeBlockIndex >= 0)
+        {
+            blockIndex = freeBlockIndex;
+            heap.m_blocks[blockIndex] = block;
+        }
+        else
+        {
+            blockIndex = heap.m_blocks.getCount();
+            heap.m_blocks.add(block);
+        }
+
+        const bool isAllocated = block->m_allocator.allocate(requirements.size, requirements.alignment, blockAllocation);
+        SLANG_UNUSED(isAllocated);
+        assert(isAllocated);
+    }
+
+    Block* block = heap.m_blocks[blockIndex];
+    outAllocation.m_memory = block->m_memory;
+    outAllocation.m_offset = blockAllocation.m_offset;
+    outAllocation.m_mappedData = block->m_mappedData ? block->m_mappedData + blockAllocation.m_offset : nullptr;
+    outAllocation.m_heapIndex = memoryTypeIndex * int(ResourceKind::CountOf) + int(kind);
+    outAllocation.m_blockIndex = int(blockIndex);
+    outAllocation.m_node = blockAllocation.m_node;
+    return VK_SUCCESS;
+}
+
+void VulkanMemoryAllocator::free(VulkanMemoryAllocation& ioAllocation)
+{
+    if (ioAllocation.m_memory == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    if (ioAllocation.m_heapIndex < 0)
+    {
+        _freeDeviceMemory(ioAllocation.m_memory, ioAllocation.m_mappedData);
+    }
+    else
+    {
+        Heap& heap = m_heaps[ioAllocation.m_heapIndex / int(ResourceKind::CountOf)][ioAllocation.m_heapIndex % int(ResourceKind::CountOf)];
+        Block* block = heap.m_blocks[ioAllocation.m_blockIndex];
+        block->m_allocator.free(ioAllocation.m_node);
+
+        // An empty block is freed, unless it's the only one in the heap (so creating and destroying one resource
+        // doesn't allocate and free a block each time)
+        if (block->m_allocator.isEmpty())
+        {
+            Index blockCount = 0;
+            for (Block* other : heap.m_blocks)
+            {
+                blockCount += Index(other != nullptr);
+            }
+            if (blockCount > 1)
+            {
+                _freeDeviceMemory(block->m_memory, block->m_mappedData);
+                delete block;
+                heap.m_blocks[ioAllocation.m_blockIndex] = nullptr;
+            }
+        }
+    }
+
+    ioAllocation = VulkanMemoryAllocation();
+}
+
+} // namespace gfx
@@ -0,0 +1,85 @@
+// vk-memory-allocator.h
+#pragma once
+
+#include "vk-api.h"
+#include "tlsf-allocator.h"
+
+namespace gfx {
+
+    /// Memory that a buffer or image is bound to, allocated by VulkanMemoryAllocator
+struct VulkanMemoryAllocation
+{
+    VkDeviceMemory m_memory = VK_NULL_HANDLE;
+    VkDeviceSize m_offset = 0;                  ///< Offset in m_memory to bind at
+    uint8_t* m_mappedData = nullptr;            ///< The mapped memory at m_offset, if the memory type is host visible
+
+    int m_heapIndex = -1;                       ///< The heap the memory is part of, or -1 if it's a dedicated allocation
+    int m_blockIndex = -1;                      ///< The block in the heap
+    uint32_t m_node = TLSFAllocator::kInvalidNode;  ///< Identifies the allocation within the block
+};
+
+/*! \brief VulkanMemoryAllocator sub-allocates buffers and images from large blocks of device memory.
+
+Each memory type has two heaps of blocks - one for buffers (and other linear resources) and one for optimally tiled
+images, so resources in the same block never need padding for bufferImageGranularity. Blocks are allocated with
+vkAllocateMemory when the existing ones are full, and each block's ranges are managed with a TLSFAllocator, so creating a
+resource is usually only CPU work. Resources larger than half a block get a dedicated allocation of their own.
+
+Host visible memory is mapped when it is allocated and stays mapped, as a VkDeviceMemory shared by several resources can
+only be mapped once.
+*/
+class VulkanMemoryAllocator
+{
+public:
+    typedef VulkanMemoryAllocator ThisType;
+
+    enum class ResourceKind
+    {
+        Linear,                                 ///< Buffers, and linearly tiled images
+        Optimal,                                ///< Optimally tiled images
+        CountOf,
+    };
+
+        /// Initialize. Blocks are blockSize bytes (but no more than an eighth of the size of their device heap).
+    void init(const VulkanApi* api, VkDeviceSize blockSize = kDefaultBlockSize);
+
+        /// Allocate memory meeting requirements, of a memory type with all of the properties
+    VkResult allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, ResourceKind kind, VulkanMemoryAllocation& outAllocation);
+        /// Free an allocation (if it was allocated), resetting it
+    void free(VulkanMemoryAllocation& ioAllocation);
+
+        /// Get the number of vkAllocateMemory allocations currently held
+    int getDeviceAllocationCount() const { return m_deviceAllocationCount; }
+
+    const VulkanApi* getApi() const { return m_api; }
+
+        /// Frees all of the blocks. Nothing allocated can be used after this.
+    ~VulkanMemoryAllocator();
+
+    static const VkDeviceSize kDefaultBlockSize = 64 * 1024 * 1024;
+
+protected:
+    struct Block
+    {
+        VkDeviceMemory m_memory = VK_NULL_HANDLE;
+        uint8_t* m_mappedData = nullptr;
+        TLSFAllocator m_allocator;
+    };
+
+    struct Heap
+    {
+        uint32_t m_memoryTypeIndex = 0;
+        VkDeviceSize m_blockSize = 0;
+        Slang::List<Block*> m_blocks;           ///< Null where a block has been freed
+    };
+
+    VkResult _allocateDeviceMemory(uint32_t memoryTypeIndex, VkDeviceSize size, VkDeviceMemory& outMemory, uint8_t*& outMappedData);
+    void _freeDeviceMemory(VkDeviceMemory memory, uint8_t* mappedData);
+
+    const VulkanApi* m_api = nullptr;
+    VkDeviceSize m_blockSize = kDefaultBlockSize;
+    Heap m_heaps[VK_MAX_MEMORY_TYPES][int(ResourceKind::CountOf)];
+    int m_deviceAllocationCount = 0;
+};
+
+} // namespace gfx
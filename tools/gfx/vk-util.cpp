@@ -20,6 +20,14 @@ namespace gfx {
         case Format::D_Float32:         return VK_FORMAT_D32_SFLOAT;
         case Format::D_Unorm24_S8:      return VK_FORMAT_D24_UNORM_S8_UINT;
 
+        case Format::BC1_Unorm:         return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case Format::BC2_Unorm:         return VK_FORMAT_BC2_UNORM_BLOCK;
+        case Format::BC3_Unorm:         return VK_FORMAT_BC3_UNORM_BLOCK;
+        case Format::BC4_Unorm:         return VK_FORMAT_BC4_UNORM_BLOCK;
+        case Format::BC5_Unorm:         return VK_FORMAT_BC5_UNORM_BLOCK;
+        case Format::BC6H_UFloat16:     return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+        case Format::BC7_Unorm:         return VK_FORMAT_BC7_UNORM_BLOCK;
+
         default:                        return VK_FORMAT_UNDEFINED;
     }
 }
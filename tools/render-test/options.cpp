@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 #include "../../source/core/slang-writer.h"
 #include "../../source/core/slang-render-api-util.h"
@@ -32,6 +33,27 @@ static gfx::RendererType _toRenderType(Slang::RenderApiType apiType)
     }
 }
 
+static SlangResult _parseCount(const char* arg, const char*const*& ioArgCursor, const char*const* argEnd, int minValue, Slang::WriterHelper stdError, int& outValue)
+{
+    if (ioArgCursor == argEnd)
+    {
+        stdError.print("expected argument for '%s' option\n", arg);
+        return SLANG_FAIL;
+    }
+
+    const char* text = *ioArgCursor++;
+    char* end = nullptr;
+    const long value = strtol(text, &end, 10);
+    if (end == text || *end != 0 || value < minValue || value > INT_MAX)
+    {
+        stdError.print("invalid count '%s' for '%s' option\n", text, arg);
+        return SLANG_FAIL;
+    }
+
+    outValue = int(value);
+    return SLANG_OK;
+}
+
 static SlangResult _setRendererType(RendererType type, const char* arg, Slang::WriterHelper stdError)
 {
     if (gOptions.rendererType != RendererType::Unknown)
@@ -155,6 +177,34 @@ SlangResult parseOptions(int argc, const char*const* argv, Slang::WriterHelper s
         {
             gOptions.onlyStartup = true;
         }
+        else if (strcmp(arg, "-bindless") == 0)
+        {
+            gOptions.bindless = true;
+        }
+        else if (strcmp(arg, "-async-compute") == 0)
+        {
+            gOptions.asyncCompute = true;
+        }
+        else if (strcmp(arg, "-gpu-time") == 0)
+        {
+            gOptions.gpuTime = true;
+        }
+        else if (strcmp(arg, "-bench") == 0)
+        {
+            gOptions.bench = true;
+        }
+        else if (strcmp(arg, "-bench-warmup") == 0)
+        {
+            SLANG_RETURN_ON_FAIL(_parseCount(arg, argCursor, argEnd, 0, stdError, gOptions.benchWarmupCount));
+        }
+        else if (strcmp(arg, "-bench-iterations") == 0)
+        {
+            SLANG_RETURN_ON_FAIL(_parseCount(arg, argCursor, argEnd, 1, stdError, gOptions.benchIterationCount));
+        }
+        else if (strcmp(arg, "-input-scale") == 0)
+        {
+            SLANG_RETURN_ON_FAIL(_parseCount(arg, argCursor, argEnd, 1, stdError, gOptions.inputScale));
+        }
         else if (strcmp(arg, "-adapter") == 0)
         {
             if (argCursor == argEnd)
@@ -165,6 +215,26 @@ SlangResult parseOptions(int argc, const char*const* argv, Slang::WriterHelper s
 
             gOptions.adapter = *argCursor++;
         }
+        else if (strcmp(arg, "-pipeline-cache") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("expected argument for '%s' option\n", arg);
+                return SLANG_FAIL;
+            }
+
+            gOptions.pipelineCachePath = *argCursor++;
+        }
+        else if (strcmp(arg, "-shader-cache") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("expected argument for '%s' option\n", arg);
+                return SLANG_FAIL;
+            }
+
+            gOptions.shaderCachePath = *argCursor++;
+        }
         else
         {
             // Lookup
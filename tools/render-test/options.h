@@ -56,10 +56,22 @@ struct Options
 
     bool useDXIL = false;
     bool onlyStartup = false;
+    bool bindless = false;                              ///< Hold descriptor sets where shaders can access them (see Renderer::Desc::bindless)
+    bool asyncCompute = false;                          ///< Run compute shaders on the renderer's compute queue
+    bool gpuTime = false;                               ///< Print the GPU time taken by the compute dispatch
+
+    bool bench = false;                                 ///< Time the dispatch or draw over many iterations, and print the results as JSON
+    int benchWarmupCount = 10;                          ///< Iterations run before timing starts
+    int benchIterationCount = 100;                      ///< Iterations that are timed
+    int inputScale = 1;                                 ///< Multiplies the size of generated TEST_INPUT buffers, and the x dispatch size
 
     Slang::List<Slang::String> renderFeatures;          /// Required render features for this test to run
 
     Slang::String adapter;                              ///< The adapter to use either name or index
+
+    Slang::String pipelineCachePath;                    ///< If set, the renderer loads and saves compiled pipelines in this file
+
+    Slang::String shaderCachePath;                      ///< If set, compiled shaders are written to and found in this directory (see ShaderCompileCache)
 };
 
 extern Options gOptions;
@@ -192,6 +192,8 @@ static const Vertex kVertexData[] =
 };
 static const int kVertexCount = SLANG_COUNT_OF(kVertexData);
 
+static const float kClearColor[] = { 0.25, 0.25, 0.25, 1.0 };
+
 using namespace Slang;
 
 class RenderTestApp
@@ -205,6 +207,9 @@ class RenderTestApp
 	void renderFrame();
 	void finalize();
 
+        /// Run the dispatch or draw the warm up and timed number of iterations, and write the GPU time statistics as JSON to stdout
+    Result runBenchmark();
+
 	BindingStateImpl* getBindingState() const { return m_bindingState; }
 
     Result writeBindingOutput(const char* fileName);
@@ -226,6 +231,8 @@ class RenderTestApp
 	RefPtr<ShaderProgram>   m_shaderProgram;
     RefPtr<PipelineState>   m_pipelineState;
 	RefPtr<BindingStateImpl>    m_bindingState;
+    RefPtr<CommandBuffer>   m_computeCommandBuffer;     ///< Used with -async-compute
+    bool m_writeTimestamps = false;                     ///< If set, timestamps 0 and 1 are written before and after the dispatch or draw
 
 	ShaderInputLayout m_shaderInputLayout;              ///< The binding layout
     int m_numAddedConstantBuffers;                      ///< Constant buffers can be added to the binding directly. Will be added at the end.
@@ -242,6 +249,7 @@ SlangResult RenderTestApp::initialize(Renderer* renderer, ShaderCompiler* shader
 
     m_numAddedConstantBuffers = 0;
 	m_renderer = renderer;
+    m_writeTimestamps = (gOptions.gpuTime || gOptions.bench) && renderer->getTimestampFrequency() != 0;
 
     // TODO(tfoley): use each API's reflection interface to query the constant-buffer size needed
     {
@@ -366,7 +374,7 @@ Result RenderTestApp::initializeShaders(ShaderCompiler* shaderCompiler)
         m_shaderInputLayout.numRenderTargets = 0;
         break;
     }
-	m_shaderInputLayout.Parse(sourceText.getBuffer());
+	m_shaderInputLayout.Parse(sourceText.getBuffer(), gOptions.inputScale);
 
 	ShaderCompileRequest::SourceInfo sourceInfo;
 	sourceInfo.path = sourcePath;
@@ -416,15 +424,193 @@ void RenderTestApp::renderFrame()
 
     m_bindingState->apply(m_renderer, pipelineType);
 
+    if (m_writeTimestamps)
+    {
+        m_renderer->writeTimestamp(0);
+    }
 	m_renderer->draw(3);
+    if (m_writeTimestamps)
+    {
+        m_renderer->writeTimestamp(1);
+    }
 }
 
 void RenderTestApp::runCompute()
 {
-    auto pipelineType = PipelineType::Compute;
-    m_renderer->setPipelineState(pipelineType, m_pipelineState);
-    m_bindingState->apply(m_renderer, pipelineType);
-	m_renderer->dispatchCompute(1, 1, 1);
+    if (gOptions.asyncCompute)
+    {
+        // Record the dispatch in a command buffer for the compute queue. It can only be recorded again once the GPU is done with it.
+        if (m_computeCommandBuffer)
+        {
+            m_renderer->waitForGpu();
+        }
+        else
+        {
+            m_computeCommandBuffer = m_renderer->createCommandBuffer(QueueType::Compute);
+        }
+        CommandBuffer* commandBuffer = m_computeCommandBuffer;
+        if (!commandBuffer || SLANG_FAILED(commandBuffer->begin()))
+        {
+            fprintf(stderr, "ERROR: unable to create a compute queue command buffer\n");
+            return;
+        }
+        if (m_writeTimestamps)
+        {
+            commandBuffer->writeTimestamp(0);
+        }
+        commandBuffer->setPipelineState(m_pipelineState);
+        commandBuffer->setDescriptorSet(m_bindingState->pipelineLayout, 0, m_bindingState->descriptorSet);
+        commandBuffer->dispatchCompute(m_shaderInputLayout.dispatchSize[0], m_shaderInputLayout.dispatchSize[1], m_shaderInputLayout.dispatchSize[2]);
+        if (m_writeTimestamps)
+        {
+            commandBuffer->writeTimestamp(1);
+        }
+        if (SLANG_FAILED(commandBuffer->end()))
+        {
+            fprintf(stderr, "ERROR: unable to record compute queue command buffer\n");
+            return;
+        }
+
+        CommandBuffer* commandBuffers[] = { commandBuffer };
+        m_renderer->submitCommandBuffers(SLANG_COUNT_OF(commandBuffers), commandBuffers);
+        // Reading back the results happens on the graphics queue
+        m_renderer->waitForQueue(QueueType::Graphics, QueueType::Compute);
+    }
+    else
+    {
+        auto pipelineType = PipelineType::Compute;
+        m_renderer->setPipelineState(pipelineType, m_pipelineState);
+        m_bindingState->apply(m_renderer, pipelineType);
+        if (m_writeTimestamps)
+        {
+            m_renderer->writeTimestamp(0);
+        }
+        m_renderer->dispatchCompute(m_shaderInputLayout.dispatchSize[0], m_shaderInputLayout.dispatchSize[1], m_shaderInputLayout.dispatchSize[2]);
+        if (m_writeTimestamps)
+        {
+            m_renderer->writeTimestamp(1);
+        }
+    }
+
+    // When benchmarking the times are written by runBenchmark
+    if (m_writeTimestamps && gOptions.gpuTime && !gOptions.bench)
+    {
+        uint64_t timestamps[2];
+        if (SLANG_SUCCEEDED(m_renderer->getTimestamps(0, 2, timestamps)))
+        {
+            const double ms = double(timestamps[1] - timestamps[0]) * 1000.0 / double(m_renderer->getTimestampFrequency());
+            fprintf(stdout, "gpu time: %f ms\n", ms);
+        }
+    }
+}
+
+static const char* _getApiName(RendererType type)
+{
+    // The names of the options that select the renderer
+    switch (type)
+    {
+        case RendererType::DirectX11:   return "dx11";
+        case RendererType::DirectX12:   return "dx12";
+        case RendererType::OpenGl:      return "gl";
+        case RendererType::Vulkan:      return "vk";
+        default:                        return "unknown";
+    }
+}
+
+static void _writeJsonString(FILE* file, const char* text)
+{
+    fputc('"', file);
+    for (const char* cur = text; *cur; ++cur)
+    {
+        const char c = *cur;
+        if (c == '"' || c == '\\')
+        {
+            fprintf(file, "\\%c", c);
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            fprintf(file, "\\u%04x", (unsigned int)(unsigned char)c);
+        }
+        else
+        {
+            fputc(c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+Result RenderTestApp::runBenchmark()
+{
+    if (!m_writeTimestamps)
+    {
+        fprintf(stderr, "ERROR: renderer doesn't support GPU timestamps, which are needed for -bench\n");
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    const bool isCompute = gOptions.shaderType == Options::ShaderProgramType::Compute;
+    const int warmupCount = gOptions.benchWarmupCount;
+    const int iterationCount = gOptions.benchIterationCount;
+
+    List<double> times;
+    times.reserve(iterationCount);
+
+    m_renderer->setClearColor(kClearColor);
+    for (int i = 0; i < warmupCount + iterationCount; ++i)
+    {
+        if (isCompute)
+        {
+            runCompute();
+        }
+        else
+        {
+            m_renderer->clearFrame();
+            renderFrame();
+        }
+
+        // Waits for the iteration to complete, so iterations don't overlap on the GPU
+        uint64_t timestamps[2];
+        if (SLANG_FAILED(m_renderer->getTimestamps(0, 2, timestamps)))
+        {
+            fprintf(stderr, "ERROR: unable to read GPU timestamps\n");
+            return SLANG_FAIL;
+        }
+
+        if (!isCompute)
+        {
+            m_renderer->presentFrame();
+        }
+
+        if (i >= warmupCount)
+        {
+            // The frequency is read each time, as it can be updated when timestamps are read
+            times.add(double(timestamps[1] - timestamps[0]) * 1000.0 / double(m_renderer->getTimestampFrequency()));
+        }
+    }
+
+    times.sort();
+
+    const Index count = times.getCount();
+    const double minTime = times[0];
+    const double medianTime = (count & 1) ? times[count / 2] : (times[count / 2 - 1] + times[count / 2]) * 0.5;
+    // Nearest rank
+    const Index p99Rank = (count * 99 + 99) / 100;
+    const double p99Time = times[p99Rank - 1];
+
+    FILE* file = stdout;
+    fprintf(file, "{\n");
+    fprintf(file, "    \"api\": \"%s\",\n", _getApiName(m_renderer->getRendererType()));
+    fprintf(file, "    \"source\": ");
+    _writeJsonString(file, gOptions.sourcePath ? gOptions.sourcePath : "");
+    fprintf(file, ",\n");
+    fprintf(file, "    \"warmup\": %d,\n", warmupCount);
+    fprintf(file, "    \"iterations\": %d,\n", iterationCount);
+    fprintf(file, "    \"minMs\": %.6f,\n", minTime);
+    fprintf(file, "    \"medianMs\": %.6f,\n", medianTime);
+    fprintf(file, "    \"p99Ms\": %.6f\n", p99Time);
+    fprintf(file, "}\n");
+    fflush(file);
+
+    return SLANG_OK;
 }
 
 void RenderTestApp::finalize()
@@ -433,10 +619,20 @@ void RenderTestApp::finalize()
 
 Result RenderTestApp::writeBindingOutput(const char* fileName)
 {
-    // Submit the work
-    m_renderer->submitGpuWork();
-    // Wait until everything is complete
-    m_renderer->waitForGpu();
+    // Read back all of the output buffers in one batch. This submits the work, and only waits for it when the data is used.
+    List<BufferResource*> buffers;
+    for (const auto& binding : m_bindingState->outputBindings)
+    {
+        if (binding.resource && binding.resource->isBuffer())
+        {
+            buffers.add(static_cast<BufferResource*>(binding.resource.Ptr()));
+        }
+    }
+    RefPtr<BufferReadback> readback = m_renderer->readBuffers(UInt(buffers.getCount()), buffers.getBuffer());
+    if (!readback)
+    {
+        return SLANG_FAIL;
+    }
 
     FILE * f = fopen(fileName, "wb");
     if (!f)
@@ -444,6 +640,7 @@ Result RenderTestApp::writeBindingOutput(const char* fileName)
         return SLANG_FAIL;
     }
 
+    Index bufferIndex = 0;
     for(auto binding : m_bindingState->outputBindings)
     {
         auto i = binding.entryIndex;
@@ -453,10 +650,11 @@ Result RenderTestApp::writeBindingOutput(const char* fileName)
         {
             if (binding.resource && binding.resource->isBuffer())
             {
-                BufferResource* bufferResource = static_cast<BufferResource*>(binding.resource.Ptr());
+                BufferResource* bufferResource = buffers[bufferIndex];
                 const size_t bufferSize = bufferResource->getDesc().sizeInBytes;
 
-                unsigned int* ptr = (unsigned int*)m_renderer->map(bufferResource, MapFlavor::HostRead);
+                const unsigned int* ptr = (const unsigned int*)readback->getData(UInt(bufferIndex));
+                bufferIndex++;
                 if (!ptr)
                 {
                     fclose(f);
@@ -464,11 +662,18 @@ Result RenderTestApp::writeBindingOutput(const char* fileName)
                 }
 
                 const int size = int(bufferSize / sizeof(unsigned int));
-                for (int i = 0; i < size; ++i)
+                if (layoutBinding.isChecksumOutput)
                 {
-                    fprintf(f, "%X\n", ptr[i]);
+                    // Large buffers are compared by a hash of their contents, rather than value by value
+                    fprintf(f, "checksum %d %016llX\n", size, (unsigned long long)getHashCode64(ptr, size * sizeof(unsigned int)));
+                }
+                else
+                {
+                    for (int i = 0; i < size; ++i)
+                    {
+                        fprintf(f, "%X\n", ptr[i]);
+                    }
                 }
-                m_renderer->unmap(bufferResource);
             }
             else
             {
@@ -577,6 +782,8 @@ SLANG_TEST_TOOL_API SlangResult innerMain(Slang::StdWriters* stdWriters, SlangSe
     desc.width = gWindowWidth;
     desc.height = gWindowHeight;
     desc.adapter = gOptions.adapter;
+    desc.pipelineCachePath = gOptions.pipelineCachePath;
+    desc.bindless = gOptions.bindless;
 
     {
         SlangResult res = renderer->initialize(desc, (HWND)window->getHandle());
@@ -614,7 +821,10 @@ SLANG_TEST_TOOL_API SlangResult innerMain(Slang::StdWriters* stdWriters, SlangSe
     shaderCompiler.renderer = renderer;
     shaderCompiler.target = slangTarget;
     shaderCompiler.profile = profileName;
+    // The session is the one slang-test passes to each test when render-test is run as a shared library, so it's shared
+    // by the runs for each API, as is the cache of compiled shaders.
     shaderCompiler.slangSession = session;
+    ShaderCompileCache::getSingleton()->setDirectory(gOptions.shaderCachePath);
 
 	switch (gOptions.inputLanguageID)
 	{
@@ -658,13 +868,17 @@ SLANG_TEST_TOOL_API SlangResult innerMain(Slang::StdWriters* stdWriters, SlangSe
 			else
 			{
 				// Whenever we don't have Windows events to process, we render a frame.
+				if (gOptions.bench)
+				{
+					// All of the iterations are run at once, and nothing is written to the output
+					return app.runBenchmark();
+				}
 				if (gOptions.shaderType == Options::ShaderProgramType::Compute)
 				{
 					app.runCompute();
 				}
 				else
 				{
-					static const float kClearColor[] = { 0.25, 0.25, 0.25, 1.0 };
 					renderer->setClearColor(kClearColor);
 					renderer->clearFrame();
 
@@ -673,17 +887,18 @@ SLANG_TEST_TOOL_API SlangResult innerMain(Slang::StdWriters* stdWriters, SlangSe
 				// If we are in a mode where output is requested, we need to snapshot the back buffer here
 				if (gOptions.outputPath)
 				{
-                    // Submit the work
-                    renderer->submitGpuWork();
-                    // Wait until everything is complete
-                    renderer->waitForGpu();
-
 					if (gOptions.shaderType == Options::ShaderProgramType::Compute || gOptions.shaderType == Options::ShaderProgramType::GraphicsCompute)
                     {
+                        // Submits the work, and waits for only the copies of the outputs
                         SLANG_RETURN_ON_FAIL(app.writeBindingOutput(gOptions.outputPath));
                     }
 					else
                     {
+                        // Submit the work
+                        renderer->submitGpuWork();
+                        // Wait until everything is complete
+                        renderer->waitForGpu();
+
 						SlangResult res = app.writeScreen(gOptions.outputPath);
 
                         if (SLANG_FAILED(res))
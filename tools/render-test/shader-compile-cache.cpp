@@ -0,0 +1,349 @@
+// shader-compile-cache.cpp
+
+#define _CRT_SECURE_NO_WARNINGS 1
+
+#include "shader-compile-cache.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-platform.h"
+
+#include <stdio.h>
+
+namespace renderer_test {
+using namespace Slang;
+
+// Increment if the layout of entry files changes
+static const uint32_t kShaderCompileCacheVersion = 1;
+// 'SCCE' as a four CC, at the start of each entry file
+static const uint32_t kEntryFourCC = uint32_t('S') | (uint32_t('C') << 8) | (uint32_t('C') << 16) | (uint32_t('E') << 24);
+
+static SlangResult _readFile(const String& path, List<uint8_t>& outData)
+{
+    FILE* file = fopen(path.getBuffer(), "rb");
+    if (!file)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    SlangResult res = SLANG_OK;
+    outData.setCount(Index(size < 0 ? 0 : size));
+    if (size < 0 || (size > 0 && fread(outData.getBuffer(), size_t(size), 1, file) != 1))
+    {
+        res = SLANG_FAIL;
+    }
+    fclose(file);
+    return res;
+}
+
+static SlangResult _writeFile(const String& path, const void* data, size_t size)
+{
+    // Write to a temporary file first and then move it into place, so that other
+    // processes never see a partially written file.
+    StringBuilder tempPath;
+    tempPath << path << ".tmp";
+
+    FILE* file = fopen(tempPath.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_FAIL;
+    }
+    const bool written = (size == 0 || fwrite(data, size, 1, file) == 1);
+    fclose(file);
+
+    if (!written)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+
+#ifdef _WIN32
+    // `rename` on Windows fails if the destination exists
+    File::remove(path);
+#endif
+    if (rename(tempPath.getBuffer(), path.getBuffer()) != 0)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+namespace { // anonymous
+
+struct EntryWriter
+{
+    void write(const void* data, size_t size)
+    {
+        const Index start = m_data.getCount();
+        m_data.setCount(start + Index(size));
+        if (size)
+        {
+            ::memcpy(m_data.getBuffer() + start, data, size);
+        }
+    }
+    void writeUInt32(uint32_t value) { write(&value, sizeof(value)); }
+    void writeUInt64(uint64_t value) { write(&value, sizeof(value)); }
+    void writeString(const String& value)
+    {
+        writeUInt32(uint32_t(value.getLength()));
+        write(value.getBuffer(), size_t(value.getLength()));
+    }
+
+    List<uint8_t> m_data;
+};
+
+struct EntryReader
+{
+    SlangResult read(void* out, size_t size)
+    {
+        if (size > size_t(m_end - m_cur))
+        {
+            return SLANG_FAIL;
+        }
+        if (size)
+        {
+            ::memcpy(out, m_cur, size);
+        }
+        m_cur += size;
+        return SLANG_OK;
+    }
+    SlangResult readUInt32(uint32_t& outValue) { return read(&outValue, sizeof(outValue)); }
+    SlangResult readUInt64(uint64_t& outValue) { return read(&outValue, sizeof(outValue)); }
+    SlangResult readString(String& outValue)
+    {
+        uint32_t length;
+        SLANG_RETURN_ON_FAIL(readUInt32(length));
+        if (length > size_t(m_end - m_cur))
+        {
+            return SLANG_FAIL;
+        }
+        outValue = UnownedStringSlice((const char*)m_cur, (const char*)m_cur + length);
+        m_cur += length;
+        return SLANG_OK;
+    }
+
+    EntryReader(const List<uint8_t>& data) : m_cur(data.getBuffer()), m_end(data.getBuffer() + data.getCount()) {}
+
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+};
+
+} // anonymous
+
+/* static */ShaderCompileCache* ShaderCompileCache::getSingleton()
+{
+    static ShaderCompileCache s_cache;
+    return &s_cache;
+}
+
+const String& ShaderCompileCache::getCompilerIdentity()
+{
+    if (!m_hasCompilerIdentity)
+    {
+        // The compiler is loaded from the same directory as the executable
+        const String directory = Path::getParentDirectory(Path::getExecutablePath());
+        const String libraryPath = SharedLibrary::calcPlatformPath(Path::combine(directory, "slang").getUnownedSlice());
+
+        StringBuilder builder;
+        int64_t size = 0;
+        int64_t modifiedTime = 0;
+        if (SLANG_SUCCEEDED(File::getSizeAndModifiedTime(libraryPath, size, modifiedTime)))
+        {
+            builder << "slang " << size << " " << modifiedTime;
+        }
+        m_compilerIdentity = builder;
+        m_hasCompilerIdentity = true;
+    }
+    return m_compilerIdentity;
+}
+
+bool ShaderCompileCache::_useDirectory()
+{
+    // Without knowing which compiler made an entry, entries from an old build could be used
+    return m_directory.getLength() > 0 && getCompilerIdentity().getLength() > 0;
+}
+
+/* static */void ShaderCompileCache::_calcDependency(const String& path, Dependency& outDependency)
+{
+    outDependency.path = path;
+
+    List<uint8_t> contents;
+    outDependency.exists = SLANG_SUCCEEDED(_readFile(path, contents));
+    outDependency.hash = outDependency.exists ? getHashCode64(contents.getBuffer(), size_t(contents.getCount())) : 0;
+}
+
+/* static */bool ShaderCompileCache::_isCurrent(const Entry* entry)
+{
+    for (const auto& dependency : entry->dependencies)
+    {
+        Dependency current;
+        _calcDependency(dependency.path, current);
+        if (current.exists != dependency.exists || current.hash != dependency.hash)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+String ShaderCompileCache::_getEntryPath(const String& key) const
+{
+    const uint64_t hash = getHashCode64(key.getBuffer(), size_t(key.getLength()));
+
+    char name[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        name[i] = "0123456789abcdef"[(hash >> (60 - i * 4)) & 0xf];
+    }
+    name[16] = 0;
+
+    StringBuilder builder;
+    builder << name << ".shader";
+    return Path::combine(m_directory, builder);
+}
+
+RefPtr<ShaderCompileCache::Entry> ShaderCompileCache::_readEntry(const String& key)
+{
+    List<uint8_t> data;
+    if (SLANG_FAILED(_readFile(_getEntryPath(key), data)))
+    {
+        return nullptr;
+    }
+
+    EntryReader reader(data);
+    RefPtr<Entry> entry = new Entry;
+
+    uint32_t fourCC, version;
+    String entryKey;
+    if (SLANG_FAILED(reader.readUInt32(fourCC)) || fourCC != kEntryFourCC ||
+        SLANG_FAILED(reader.readUInt32(version)) || version != kShaderCompileCacheVersion ||
+        SLANG_FAILED(reader.readString(entryKey)) || entryKey != key)
+    {
+        // Not an entry, or an entry for a different key with the same hash
+        return nullptr;
+    }
+
+    uint32_t dependencyCount, kernelCount;
+    if (SLANG_FAILED(reader.readString(entry->diagnostics)) ||
+        SLANG_FAILED(reader.readUInt32(dependencyCount)))
+    {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < dependencyCount; ++i)
+    {
+        Dependency dependency;
+        uint32_t exists;
+        if (SLANG_FAILED(reader.readString(dependency.path)) ||
+            SLANG_FAILED(reader.readUInt32(exists)) ||
+            SLANG_FAILED(reader.readUInt64(dependency.hash)))
+        {
+            return nullptr;
+        }
+        dependency.exists = (exists != 0);
+        entry->dependencies.add(dependency);
+    }
+
+    if (SLANG_FAILED(reader.readUInt32(kernelCount)))
+    {
+        return nullptr;
+    }
+    for (uint32_t i = 0; i < kernelCount; ++i)
+    {
+        Kernel kernel;
+        uint32_t stage, codeSize;
+        if (SLANG_FAILED(reader.readUInt32(stage)) || stage >= uint32_t(StageType::CountOf) ||
+            SLANG_FAILED(reader.readUInt32(codeSize)))
+        {
+            return nullptr;
+        }
+        kernel.stage = StageType(stage);
+        kernel.code.setCount(Index(codeSize));
+        if (SLANG_FAILED(reader.read(kernel.code.getBuffer(), codeSize)))
+        {
+            return nullptr;
+        }
+        entry->kernels.add(kernel);
+    }
+
+    return entry;
+}
+
+SlangResult ShaderCompileCache::_writeEntry(const String& key, const Entry* entry)
+{
+    EntryWriter writer;
+    writer.writeUInt32(kEntryFourCC);
+    writer.writeUInt32(kShaderCompileCacheVersion);
+    writer.writeString(key);
+    writer.writeString(entry->diagnostics);
+
+    writer.writeUInt32(uint32_t(entry->dependencies.getCount()));
+    for (const auto& dependency : entry->dependencies)
+    {
+        writer.writeString(dependency.path);
+        writer.writeUInt32(dependency.exists ? 1 : 0);
+        writer.writeUInt64(dependency.hash);
+    }
+
+    writer.writeUInt32(uint32_t(entry->kernels.getCount()));
+    for (const auto& kernel : entry->kernels)
+    {
+        writer.writeUInt32(uint32_t(kernel.stage));
+        writer.writeUInt32(uint32_t(kernel.code.getCount()));
+        writer.write(kernel.code.getBuffer(), size_t(kernel.code.getCount()));
+    }
+
+    Path::createDirectory(m_directory);
+    return _writeFile(_getEntryPath(key), writer.m_data.getBuffer(), size_t(writer.m_data.getCount()));
+}
+
+ShaderCompileCache::Entry* ShaderCompileCache::find(const String& key)
+{
+    if (RefPtr<Entry>* entryPtr = m_entries.TryGetValue(key))
+    {
+        if (_isCurrent(*entryPtr))
+        {
+            m_hitCount++;
+            return *entryPtr;
+        }
+        m_entries.Remove(key);
+    }
+
+    if (_useDirectory())
+    {
+        RefPtr<Entry> entry = _readEntry(key);
+        if (entry && _isCurrent(entry))
+        {
+            m_entries[key] = entry;
+            m_hitCount++;
+            return entry;
+        }
+    }
+
+    m_missCount++;
+    return nullptr;
+}
+
+void ShaderCompileCache::add(const String& key, Entry* entry, const List<String>& dependencyPaths)
+{
+    entry->dependencies.clear();
+    for (const auto& path : dependencyPaths)
+    {
+        Dependency dependency;
+        _calcDependency(path, dependency);
+        entry->dependencies.add(dependency);
+    }
+
+    m_entries[key] = entry;
+
+    if (_useDirectory())
+    {
+        // Failing to write only means a later process doesn't find it
+        _writeEntry(key, entry);
+    }
+}
+
+} // renderer_test
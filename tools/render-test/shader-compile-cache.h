@@ -0,0 +1,93 @@
+// shader-compile-cache.h
+#pragma once
+
+#include "render.h"
+
+#include "../../source/core/slang-dictionary.h"
+
+namespace renderer_test {
+
+using namespace gfx;
+
+/*! \brief ShaderCompileCache holds the kernels produced by compiling test shaders, so that compiling a shader again,
+for the same target with the same options, doesn't run the compiler.
+
+The key for a compile is text made by ShaderCompiler, covering the source, target, profile and anything else that
+changes the output. As shaders can include or import other files, an entry also records the files the compile read
+(and a hash of their contents), and is only used if they haven't changed.
+
+Entries are held in memory for the life of the process - when render-test is run as a shared library by slang-test, that
+is across tests, so for example the DXBC compiled for D3D11 is used for D3D12. If a directory is set entries are also
+written to it, and found there by later processes. The compiler itself is identified by the size and modification time of
+the slang shared library, so a rebuilt compiler doesn't use entries from a previous build.
+
+Only successful compiles are held. The diagnostics of the compile are held with the entry, so warnings are output on
+every use. */
+class ShaderCompileCache
+{
+public:
+    typedef ShaderCompileCache ThisType;
+
+    struct Kernel
+    {
+        StageType stage;
+        Slang::List<uint8_t> code;
+    };
+
+    struct Dependency
+    {
+        Slang::String path;
+        bool exists;                                    ///< False if the file couldn't be read
+        uint64_t hash;                                  ///< Hash of the contents
+    };
+
+    class Entry : public Slang::RefObject
+    {
+    public:
+        Slang::String diagnostics;                      ///< Output of the compile
+        Slang::List<Kernel> kernels;                    ///< In the order of the entry points
+        Slang::List<Dependency> dependencies;           ///< Files read by the compile
+    };
+
+        /// Find the entry for key, looking in memory and then in the directory (if set). Returns nullptr if not found,
+        /// or if a file it depends on has changed.
+    Entry* find(const Slang::String& key);
+        /// Add an entry for key. Dependencies are set from dependencyPaths.
+    void add(const Slang::String& key, Entry* entry, const Slang::List<Slang::String>& dependencyPaths);
+
+        /// Set the directory entries are written to and read from. If empty, entries are only held in memory.
+    void setDirectory(const Slang::String& directory) { m_directory = directory; }
+        /// Get the directory
+    const Slang::String& getDirectory() const { return m_directory; }
+
+        /// Get text identifying the compiler, to be part of keys. Empty if the compiler couldn't be found, in which case
+        /// the directory isn't used.
+    const Slang::String& getCompilerIdentity();
+
+        /// The number of compiles found in the cache
+    Slang::Index getHitCount() const { return m_hitCount; }
+        /// The number of compiles not found
+    Slang::Index getMissCount() const { return m_missCount; }
+
+        /// Get the cache used by ShaderCompiler
+    static ShaderCompileCache* getSingleton();
+
+protected:
+    bool _useDirectory();
+    static bool _isCurrent(const Entry* entry);
+    static void _calcDependency(const Slang::String& path, Dependency& outDependency);
+
+    Slang::String _getEntryPath(const Slang::String& key) const;
+    Slang::RefPtr<Entry> _readEntry(const Slang::String& key);
+    SlangResult _writeEntry(const Slang::String& key, const Entry* entry);
+
+    Slang::Dictionary<Slang::String, Slang::RefPtr<Entry>> m_entries;
+    Slang::String m_directory;
+    Slang::String m_compilerIdentity;
+    bool m_hasCompilerIdentity = false;
+
+    Slang::Index m_hitCount = 0;
+    Slang::Index m_missCount = 0;
+};
+
+} // renderer_test
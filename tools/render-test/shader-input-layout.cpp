@@ -1,13 +1,15 @@
 #include "shader-input-layout.h"
 #include "core/slang-token-reader.h"
+#include "core/slang-random-generator.h"
 
 #include "render.h"
 
 namespace renderer_test
 {
     using namespace Slang;
-    void ShaderInputLayout::Parse(const char * source)
+    void ShaderInputLayout::Parse(const char * source, int inputScale)
     {
+        dispatchSize[0] = dispatchSize[1] = dispatchSize[2] = 1;
         entries.clear();
         globalGenericTypeArguments.clear();
         entryPointGenericTypeArguments.clear();
@@ -54,6 +56,19 @@ namespace renderer_test
                             typeExp << parser.ReadToken().Content;
                         entryPointExistentialTypeArguments.add(typeExp);
                     }
+                    else if (parser.LookAhead("dispatch"))
+                    {
+                        parser.ReadToken();
+                        parser.Read("(");
+                        for (int i = 0; i < 3 && !parser.LookAhead(")"); i++)
+                        {
+                            dispatchSize[i] = parser.ReadInt();
+                            if (parser.LookAhead(","))
+                                parser.Read(",");
+                        }
+                        parser.Read(")");
+                        dispatchSize[0] *= inputScale;
+                    }
                     else
                     {
                         ShaderInputLayoutEntry entry;
@@ -175,6 +190,20 @@ namespace renderer_test
                                     parser.Read("=");
                                     entry.textureDesc.size = parser.ReadInt();
                                 }
+                                else if (word == "count")
+                                {
+                                    parser.Read("=");
+                                    entry.bufferDesc.count = parser.ReadInt();
+                                }
+                                else if (word == "seed")
+                                {
+                                    parser.Read("=");
+                                    entry.bufferDesc.seed = parser.ReadInt();
+                                }
+                                else if (word == "checksum")
+                                {
+                                    entry.isChecksumOutput = true;
+                                }
                                 else if (word == "data")
                                 {
                                     parser.Read("=");
@@ -197,7 +226,20 @@ namespace renderer_test
                                 {
                                     parser.Read("=");
                                     auto contentWord = parser.ReadWord();
-                                    if (contentWord == "zero")
+                                    if (entry.type == ShaderInputType::Buffer)
+                                    {
+                                        if (contentWord == "zero")
+                                            entry.bufferDesc.content = InputBufferContent::Zero;
+                                        else if (contentWord == "index")
+                                            entry.bufferDesc.content = InputBufferContent::Index;
+                                        else if (contentWord == "random")
+                                            entry.bufferDesc.content = InputBufferContent::Random;
+                                        else if (contentWord == "randomFloat")
+                                            entry.bufferDesc.content = InputBufferContent::RandomFloat;
+                                        else
+                                            throw TextFormatException("Unknown buffer content " + contentWord);
+                                    }
+                                    else if (contentWord == "zero")
                                         entry.textureDesc.content = InputTextureContent::Zero;
                                     else if (contentWord == "one")
                                         entry.textureDesc.content = InputTextureContent::One;
@@ -235,6 +277,11 @@ namespace renderer_test
                             }
                             parser.Read(")");
                         }
+                        // generate the contents of buffers that aren't listed in the test
+                        if (entry.type == ShaderInputType::Buffer && entry.bufferDesc.content != InputBufferContent::Data)
+                        {
+                            generateBufferData(entry.bufferDesc, entry.bufferDesc.count * inputScale, entry.bufferData);
+                        }
                         // parse bindings
                         if (parser.LookAhead(":"))
                         {
@@ -282,6 +329,45 @@ namespace renderer_test
         }
     }
 
+    void generateBufferData(const InputBufferDesc& desc, int elementCount, List<unsigned int>& output)
+    {
+        // An element of a structured buffer is stride bytes, and of any other buffer a single 32 bit value
+        const Index valuesPerElement = (desc.stride > 0) ? (desc.stride + 3) / 4 : 1;
+        const Index count = Index(elementCount) * valuesPerElement;
+
+        output.setCount(count);
+        unsigned int* dst = output.getBuffer();
+
+        DefaultRandomGenerator randGen(desc.seed);
+        for (Index i = 0; i < count; i++)
+        {
+            switch (desc.content)
+            {
+                case InputBufferContent::Index:
+                {
+                    dst[i] = (unsigned int)i;
+                    break;
+                }
+                case InputBufferContent::Random:
+                {
+                    dst[i] = (unsigned int)randGen.nextInt32();
+                    break;
+                }
+                case InputBufferContent::RandomFloat:
+                {
+                    const float value = randGen.nextUnitFloat32();
+                    dst[i] = *(const unsigned int*)&value;
+                    break;
+                }
+                default:
+                {
+                    dst[i] = 0;
+                    break;
+                }
+            }
+        }
+    }
+
     void generateTextureData(TextureData& output, const InputTextureDesc& desc)
     {
         switch (desc.format)
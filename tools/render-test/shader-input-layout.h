@@ -38,11 +38,24 @@ enum class InputBufferType
     ConstantBuffer, StorageBuffer
 };
 
+enum class InputBufferContent
+{
+    Data,               ///< The values listed with `data`
+    Zero,               ///< All zero
+    Index,              ///< Each 32 bit value is its index in the buffer
+    Random,             ///< Random 32 bit values
+    RandomFloat,        ///< Random floats in the range [0, 1]
+};
+
 struct InputBufferDesc
 {
     InputBufferType type = InputBufferType::ConstantBuffer;
     int stride = 0; // stride == 0 indicates an unstructured buffer.
     Format format = Format::Unknown;
+
+    InputBufferContent content = InputBufferContent::Data;
+    int count = 0;                      ///< The number of elements generated, if the content isn't Data
+    int32_t seed = 0;                   ///< The seed of the random contents
 };
 
 struct InputSamplerDesc
@@ -59,6 +72,7 @@ public:
     InputBufferDesc bufferDesc;
     InputSamplerDesc samplerDesc;
     bool isOutput = false;
+    bool isChecksumOutput = false;      ///< The output is the size and a hash of the buffer, rather than all of its values
     int hlslBinding = -1;
     Slang::List<int> glslBinding;
 };
@@ -80,10 +94,17 @@ public:
     Slang::List<Slang::String> globalExistentialTypeArguments;
     Slang::List<Slang::String> entryPointExistentialTypeArguments;
     int numRenderTargets = 1;
-    void Parse(const char * source);
+    int dispatchSize[3] = { 1, 1, 1 };      ///< The number of thread groups a compute test dispatches
+
+        /// Parse the TEST_INPUT lines of source. The element count of generated buffers, and the
+        /// x dispatch size, are multiplied by inputScale, so a test can be run at larger sizes.
+    void Parse(const char * source, int inputScale = 1);
 };
 
 void generateTextureDataRGB8(TextureData& output, const InputTextureDesc& desc);
+
+    /// Generate the contents of a buffer whose content isn't Data, with elementCount elements
+void generateBufferData(const InputBufferDesc& desc, int elementCount, Slang::List<unsigned int>& output);
 void generateTextureData(TextureData& output, const InputTextureDesc& desc);
 
 
@@ -11,8 +11,106 @@
 
 namespace renderer_test {
 
+static void _addKernel(SlangCompileRequest* slangRequest, int entryPoint, StageType stage, ShaderCompileCache::Entry& ioEntry)
+{
+    size_t codeSize = 0;
+    const uint8_t* code = (const uint8_t*)spGetEntryPointCode(slangRequest, entryPoint, &codeSize);
+
+    ShaderCompileCache::Kernel kernel;
+    kernel.stage = stage;
+    kernel.code.addRange(code, Slang::Index(codeSize));
+    ioEntry.kernels.add(kernel);
+}
+
+void ShaderCompiler::calcCacheKey(ShaderCompileRequest const& request, Slang::StringBuilder& out)
+{
+    using namespace Slang;
+
+    out << "compiler: " << ShaderCompileCache::getSingleton()->getCompilerIdentity() << "\n";
+    out << "target: " << int(target) << "\n";
+    out << "source-language: " << int(sourceLanguage) << "\n";
+    out << "pass-through: " << int(passThrough) << "\n";
+    out << "profile: " << (profile ? profile : "") << "\n";
+    for (int i = 0; i < gOptions.slangArgCount; ++i)
+    {
+        out << "slang-arg: " << gOptions.slangArgs[i] << "\n";
+    }
+
+    // The path is used in diagnostics and for finding included files
+    const size_t sourceSize = size_t(request.source.dataEnd - request.source.dataBegin);
+    out << "source: " << (request.source.path ? request.source.path : "") << " " << getHashCode64(request.source.dataBegin, sourceSize) << " " << UInt(sourceSize) << "\n";
+
+    out << "compute: " << (request.computeShader.name ? request.computeShader.name : "") << "\n";
+    out << "vertex: " << (request.vertexShader.name ? request.vertexShader.name : "") << "\n";
+    out << "fragment: " << (request.fragmentShader.name ? request.fragmentShader.name : "") << "\n";
+
+    for (const auto& typeName : request.globalGenericTypeArguments)
+    {
+        out << "global-generic: " << typeName << "\n";
+    }
+    for (const auto& typeName : request.entryPointGenericTypeArguments)
+    {
+        out << "entry-point-generic: " << typeName << "\n";
+    }
+    for (const auto& typeName : request.globalExistentialTypeArguments)
+    {
+        out << "global-existential: " << typeName << "\n";
+    }
+    for (const auto& typeName : request.entryPointExistentialTypeArguments)
+    {
+        out << "entry-point-existential: " << typeName << "\n";
+    }
+}
+
 RefPtr<ShaderProgram> ShaderCompiler::compileProgram(
     ShaderCompileRequest const& request)
+{
+    ShaderCompileCache* cache = ShaderCompileCache::getSingleton();
+
+    Slang::StringBuilder key;
+    calcCacheKey(request, key);
+
+    RefPtr<ShaderCompileCache::Entry> entry = cache->find(key);
+    if (entry)
+    {
+        // Output the diagnostics as if it had been compiled
+        if (entry->diagnostics.getLength())
+        {
+            fprintf(stderr, "%s", entry->diagnostics.getBuffer());
+        }
+    }
+    else
+    {
+        entry = new ShaderCompileCache::Entry;
+        Slang::List<Slang::String> dependencyPaths;
+        if (SLANG_FAILED(_compileKernels(request, *entry, dependencyPaths)))
+        {
+            return nullptr;
+        }
+        cache->add(key, entry, dependencyPaths);
+    }
+
+    const Slang::Index kernelCount = entry->kernels.getCount();
+    Slang::List<ShaderProgram::KernelDesc> kernelDescs;
+    kernelDescs.setCount(kernelCount);
+    for (Slang::Index i = 0; i < kernelCount; ++i)
+    {
+        const auto& kernel = entry->kernels[i];
+        ShaderProgram::KernelDesc& kernelDesc = kernelDescs[i];
+        kernelDesc.stage = kernel.stage;
+        kernelDesc.codeBegin = kernel.code.getBuffer();
+        kernelDesc.codeEnd = kernel.code.getBuffer() + kernel.code.getCount();
+    }
+
+    ShaderProgram::Desc desc;
+    desc.pipelineType = request.computeShader.name ? PipelineType::Compute : PipelineType::Graphics;
+    desc.kernels = kernelDescs.getBuffer();
+    desc.kernelCount = UInt(kernelCount);
+
+    return renderer->createProgram(desc);
+}
+
+SlangResult ShaderCompiler::_compileKernels(ShaderCompileRequest const& request, ShaderCompileCache::Entry& outEntry, Slang::List<Slang::String>& outDependencyPaths)
 {
     SlangCompileRequest* slangRequest = spCreateCompileRequest(slangSession);
 
@@ -48,7 +146,14 @@ RefPtr<ShaderProgram> ShaderCompiler::compileProgram(
 
     // Process any additional command-line options specified for Slang using
     // the `-xslang <arg>` option to `render-test`.
-    SLANG_RETURN_NULL_ON_FAIL(spProcessCommandLineArguments(slangRequest, &gOptions.slangArgs[0], gOptions.slangArgCount));
+    {
+        const SlangResult res = spProcessCommandLineArguments(slangRequest, &gOptions.slangArgs[0], gOptions.slangArgCount);
+        if (SLANG_FAILED(res))
+        {
+            spDestroyCompileRequest(slangRequest);
+            return res;
+        }
+    }
 
     int computeTranslationUnit = 0;
     int vertexTranslationUnit = 0;
@@ -91,7 +196,7 @@ RefPtr<ShaderProgram> ShaderCompiler::compileProgram(
     }
 
 
-    RefPtr<ShaderProgram> shaderProgram;
+    SlangResult res = SLANG_OK;
 
     Slang::List<const char*> rawGlobalTypeNames;
     for (auto typeName : request.globalGenericTypeArguments)
@@ -131,27 +236,15 @@ RefPtr<ShaderProgram> ShaderCompiler::compileProgram(
         setEntryPointExistentialTypeArgs(computeEntryPoint);
 
         spSetLineDirectiveMode(slangRequest, SLANG_LINE_DIRECTIVE_MODE_NONE);
-        const SlangResult res = spCompile(slangRequest);
+        res = spCompile(slangRequest);
         if (auto diagnostics = spGetDiagnosticOutput(slangRequest))
         {
             fprintf(stderr, "%s", diagnostics);
+            outEntry.diagnostics = diagnostics;
         }
         if (SLANG_SUCCEEDED(res))
         {
-            size_t codeSize = 0;
-            char const* code = (char const*) spGetEntryPointCode(slangRequest, computeEntryPoint, &codeSize);
-
-            ShaderProgram::KernelDesc kernelDesc;
-            kernelDesc.stage = StageType::Compute;
-            kernelDesc.codeBegin = code;
-            kernelDesc.codeEnd = code + codeSize;
-
-            ShaderProgram::Desc desc;
-            desc.pipelineType = PipelineType::Compute;
-            desc.kernels = &kernelDesc;
-            desc.kernelCount = 1;
-
-            shaderProgram = renderer->createProgram(desc);
+            _addKernel(slangRequest, computeEntryPoint, StageType::Compute, outEntry);
         }
     }
     else
@@ -162,48 +255,35 @@ RefPtr<ShaderProgram> ShaderCompiler::compileProgram(
         setEntryPointExistentialTypeArgs(vertexEntryPoint);
         setEntryPointExistentialTypeArgs(fragmentEntryPoint);
 
-        const SlangResult res = spCompile(slangRequest);
+        res = spCompile(slangRequest);
         if (auto diagnostics = spGetDiagnosticOutput(slangRequest))
         {
             // TODO(tfoley): re-enable when I get a logging solution in place
 //            OutputDebugStringA(diagnostics);
             fprintf(stderr, "%s", diagnostics);
+            outEntry.diagnostics = diagnostics;
         }
         if (SLANG_SUCCEEDED(res))
         {
-            size_t vertexCodeSize = 0;
-            char const* vertexCode = (char const*) spGetEntryPointCode(slangRequest, vertexEntryPoint, &vertexCodeSize);
-
-            size_t fragmentCodeSize = 0;
-            char const* fragmentCode = (char const*) spGetEntryPointCode(slangRequest, fragmentEntryPoint, &fragmentCodeSize);
-
-            static const int kDescCount = 2;
-
-            ShaderProgram::KernelDesc kernelDescs[kDescCount];
-
-            kernelDescs[0].stage = StageType::Vertex;
-            kernelDescs[0].codeBegin = vertexCode;
-            kernelDescs[0].codeEnd = vertexCode + vertexCodeSize;
-
-            kernelDescs[1].stage = StageType::Fragment;
-            kernelDescs[1].codeBegin = fragmentCode;
-            kernelDescs[1].codeEnd = fragmentCode + fragmentCodeSize;
-
-            ShaderProgram::Desc desc;
-            desc.pipelineType = PipelineType::Graphics;
-            desc.kernels = &kernelDescs[0];
-            desc.kernelCount = kDescCount;
+            _addKernel(slangRequest, vertexEntryPoint, StageType::Vertex, outEntry);
+            _addKernel(slangRequest, fragmentEntryPoint, StageType::Fragment, outEntry);
+        }
+    }
 
-            shaderProgram = renderer->createProgram(desc);
+    if (SLANG_SUCCEEDED(res))
+    {
+        const int dependencyCount = spGetDependencyFileCount(slangRequest);
+        for (int i = 0; i < dependencyCount; ++i)
+        {
+            outDependencyPaths.add(spGetDependencyFilePath(slangRequest, i));
         }
     }
-    // We clean up the Slang compilation context and result *after*
-    // we have run the downstream compiler, because Slang
-    // owns the memory allocation for the generated text, and will
-    // free it when we destroy the compilation result.
+
+    // The kernels are copied, as Slang owns the memory for the generated code, and
+    // frees it when the compile request is destroyed.
     spDestroyCompileRequest(slangRequest);
-    
-    return shaderProgram;
+
+    return res;
 }
 
 } // renderer_test
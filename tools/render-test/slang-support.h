@@ -6,6 +6,7 @@
 #include <slang.h>
 
 #include "shader-input-layout.h"
+#include "shader-compile-cache.h"
 
 namespace renderer_test {
 
@@ -18,8 +19,16 @@ struct ShaderCompiler
     char const*             profile;
     SlangSession*           slangSession;
     
+        /// Compile the program, using the ShaderCompileCache if it has been compiled before
     RefPtr<ShaderProgram> compileProgram(    
         ShaderCompileRequest const& request);
+
+        /// Calculate the key text used for the request in the ShaderCompileCache
+    void calcCacheKey(ShaderCompileRequest const& request, Slang::StringBuilder& outKey);
+
+protected:
+        /// Compile with Slang, setting the kernels and diagnostics of outEntry, and the files that were read
+    SlangResult _compileKernels(ShaderCompileRequest const& request, ShaderCompileCache::Entry& outEntry, Slang::List<Slang::String>& outDependencyPaths);
 };
 
 
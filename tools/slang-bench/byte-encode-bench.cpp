@@ -0,0 +1,121 @@
+// byte-encode-bench.cpp
+#include "byte-encode-bench.h"
+
+#include "../../source/core/slang-byte-encode-util.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace SlangBench
+{
+using namespace Slang;
+
+namespace { // anonymous
+
+// Prevents the optimizer from removing work whose result is otherwise unused
+static volatile size_t g_sink;
+
+static double _calcSeconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+}
+
+    /// Time func over iterationCount runs, returning the best time
+template <typename F>
+static double _timeBest(Int iterationCount, const F& func)
+{
+    double best = 0.0;
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        const uint64_t startTick = ProcessUtil::getClockTick();
+        g_sink = func();
+        const double seconds = _calcSeconds(startTick);
+        best = (best == 0.0 || seconds < best) ? seconds : best;
+    }
+    return best;
+}
+
+static void _printRow(const char* name, double seconds, size_t valueCount, size_t encodedSize)
+{
+    // Throughput is in terms of the decoded size
+    const double mbPerSecond = double(valueCount * sizeof(uint32_t)) / (seconds * 1024.0 * 1024.0);
+    printf("    %-24s %10.1f MB/s %10.2f ns/value %10d bytes\n", name, mbPerSecond, seconds * 1e9 / double(valueCount), int(encodedSize));
+}
+
+static void _bench(const char* name, const List<uint32_t>& values, Int iterationCount)
+{
+    const size_t count = size_t(values.getCount());
+
+    List<uint8_t> lite;
+    lite.setCount(Index(count * ByteEncodeUtil::kMaxLiteEncodeUInt32));
+    List<uint8_t> streamVByte;
+    streamVByte.setCount(Index(ByteEncodeUtil::calcEncodeStreamVByteSizeUInt32(values.getBuffer(), count)));
+
+    List<uint32_t> decoded;
+    decoded.setCount(values.getCount());
+
+    size_t liteSize = 0;
+    const double liteEncode = _timeBest(iterationCount, [&]() {
+        return liteSize = ByteEncodeUtil::encodeLiteUInt32(values.getBuffer(), count, lite.getBuffer()); });
+    const double liteDecode = _timeBest(iterationCount, [&]() {
+        return ByteEncodeUtil::decodeLiteUInt32(lite.getBuffer(), count, decoded.getBuffer()); });
+
+    size_t streamVByteSize = 0;
+    const double streamVByteEncode = _timeBest(iterationCount, [&]() {
+        return streamVByteSize = ByteEncodeUtil::encodeStreamVByteUInt32(values.getBuffer(), count, streamVByte.getBuffer()); });
+    const double streamVByteScalarDecode = _timeBest(iterationCount, [&]() {
+        return ByteEncodeUtil::decodeStreamVByteUInt32Scalar(streamVByte.getBuffer(), count, decoded.getBuffer()); });
+    const double streamVByteDecode = _timeBest(iterationCount, [&]() {
+        return ByteEncodeUtil::decodeStreamVByteUInt32(streamVByte.getBuffer(), count, decoded.getBuffer()); });
+
+    if (memcmp(decoded.getBuffer(), values.getBuffer(), count * sizeof(uint32_t)) != 0)
+    {
+        printf("%s: decoded values don't match\n", name);
+    }
+
+    printf("%s (%d values)\n", name, int(count));
+    _printRow("lite encode", liteEncode, count, liteSize);
+    _printRow("lite decode", liteDecode, count, liteSize);
+    _printRow("stream vbyte encode", streamVByteEncode, count, streamVByteSize);
+    _printRow("stream vbyte decode", streamVByteScalarDecode, count, streamVByteSize);
+    if (ByteEncodeUtil::isStreamVByteSimdAvailable())
+    {
+        _printRow("stream vbyte SIMD decode", streamVByteDecode, count, streamVByteSize);
+    }
+}
+
+} // anonymous
+
+SlangResult runByteEncodeBench(Int iterationCount)
+{
+    const Index valueCount = 1000000;
+
+    DefaultRandomGenerator randGen(0x5123);
+
+    // Mostly small values, like the delta encoded operands of serialized IR
+    {
+        List<uint32_t> values;
+        for (Index i = 0; i < valueCount; ++i)
+        {
+            const int shift = (randGen.nextInt32UpTo(8) == 0) ? 16 : 24;
+            values.add(uint32_t(randGen.nextInt32()) >> shift);
+        }
+        _bench("small", values, iterationCount);
+    }
+
+    // Every byte length equally likely
+    {
+        List<uint32_t> values;
+        for (Index i = 0; i < valueCount; ++i)
+        {
+            values.add(uint32_t(randGen.nextInt32()) >> (randGen.nextInt32UpTo(4) * 8));
+        }
+        _bench("mixed", values, iterationCount);
+    }
+
+    return SLANG_OK;
+}
+
+}
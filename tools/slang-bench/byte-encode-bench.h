@@ -0,0 +1,18 @@
+// byte-encode-bench.h
+#ifndef SLANG_BENCH_BYTE_ENCODE_BENCH_H
+#define SLANG_BENCH_BYTE_ENCODE_BENCH_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-common.h"
+
+namespace SlangBench
+{
+
+    /// Time encoding and decoding arrays of uint32_t with the `ByteEncodeUtil` 'lite' and 'stream vbyte'
+    /// encodings (decoding stream vbyte with and without SIMD), and print the throughput and encoded size.
+    /// The best time over iterationCount runs is reported.
+SlangResult runByteEncodeBench(Slang::Int iterationCount);
+
+}
+
+#endif
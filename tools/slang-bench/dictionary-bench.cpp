@@ -0,0 +1,167 @@
+// dictionary-bench.cpp
+#include "dictionary-bench.h"
+
+#include "legacy-dictionary.h"
+
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-string.h"
+
+#include <stdio.h>
+
+namespace SlangBench
+{
+using namespace Slang;
+
+namespace { // anonymous
+
+// Prevents the optimizer from removing work whose result is otherwise unused
+static volatile Int g_sink;
+
+struct BenchTimes
+{
+    double insertSeconds = 0.0;
+    double hitSeconds = 0.0;
+    double missSeconds = 0.0;
+    double removeSeconds = 0.0;
+};
+
+static double _calcSeconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+}
+
+static void _keepBest(double seconds, double& ioBest)
+{
+    if (ioBest == 0.0 || seconds < ioBest)
+    {
+        ioBest = seconds;
+    }
+}
+
+    /// Time one run of each operation on DictionaryType, keeping the best time in ioTimes.
+    /// keys holds keys to add, and missingKeys keys that are never added.
+template <typename DictionaryType, typename TKey>
+static void _benchOnce(const List<TKey>& keys, const List<TKey>& missingKeys, BenchTimes& ioTimes)
+{
+    DictionaryType dict;
+    Int total = 0;
+
+    uint64_t startTick = ProcessUtil::getClockTick();
+    for (Index i = 0; i < keys.getCount(); ++i)
+    {
+        dict.AddIfNotExists(keys[i], Int(i));
+    }
+    _keepBest(_calcSeconds(startTick), ioTimes.insertSeconds);
+
+    startTick = ProcessUtil::getClockTick();
+    for (const auto& key : keys)
+    {
+        Int value;
+        if (dict.TryGetValue(key, value))
+        {
+            total += value;
+        }
+    }
+    _keepBest(_calcSeconds(startTick), ioTimes.hitSeconds);
+
+    startTick = ProcessUtil::getClockTick();
+    for (const auto& key : missingKeys)
+    {
+        total += Int(dict.ContainsKey(key));
+    }
+    _keepBest(_calcSeconds(startTick), ioTimes.missSeconds);
+
+    startTick = ProcessUtil::getClockTick();
+    for (const auto& key : keys)
+    {
+        dict.Remove(key);
+    }
+    _keepBest(_calcSeconds(startTick), ioTimes.removeSeconds);
+
+    g_sink = total + dict.Count();
+}
+
+static void _printRow(const char* name, double legacySeconds, double seconds, Index opCount)
+{
+    const double legacyNs = legacySeconds * 1e9 / double(opCount);
+    const double ns = seconds * 1e9 / double(opCount);
+    printf("    %-10s %10.2f ns %10.2f ns %8.2fx\n", name, legacyNs, ns, (ns > 0.0) ? legacyNs / ns : 0.0);
+}
+
+template <typename TKey>
+static void _bench(const char* name, const List<TKey>& keys, const List<TKey>& missingKeys, Int iterationCount)
+{
+    BenchTimes legacyTimes;
+    BenchTimes times;
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        _benchOnce<LegacyDictionary<TKey, Int>>(keys, missingKeys, legacyTimes);
+        _benchOnce<Dictionary<TKey, Int>>(keys, missingKeys, times);
+    }
+
+    printf("%s (%d keys)\n", name, int(keys.getCount()));
+    printf("    %-10s %13s %13s %9s\n", "", "legacy", "current", "speedup");
+    _printRow("insert", legacyTimes.insertSeconds, times.insertSeconds, keys.getCount());
+    _printRow("hit", legacyTimes.hitSeconds, times.hitSeconds, keys.getCount());
+    _printRow("miss", legacyTimes.missSeconds, times.missSeconds, missingKeys.getCount());
+    _printRow("remove", legacyTimes.removeSeconds, times.removeSeconds, keys.getCount());
+}
+
+} // anonymous
+
+SlangResult runDictionaryBench(Int iterationCount)
+{
+    const Index keyCount = 100000;
+
+    DefaultRandomGenerator randGen(0x5123);
+
+    // Integers spread over a wide range
+    {
+        List<int> keys, missingKeys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            keys.add(int(i) * 2);
+            missingKeys.add(int(i) * 2 + 1);
+        }
+        // Shuffle, so that keys aren't visited in insertion order
+        for (Index i = keyCount - 1; i > 0; --i)
+        {
+            const Index j = randGen.nextInt32UpTo(int(i + 1));
+            Swap(keys[i], keys[j]);
+        }
+        _bench("int", keys, missingKeys, iterationCount);
+    }
+
+    // Pointers, like the IR and AST maps keyed on instruction or declaration pointers
+    {
+        // (`const char*` keys are hashed as strings, so use `int*`)
+        List<int> storage;
+        storage.setCount(keyCount * 2 * 4);
+        List<int*> keys, missingKeys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            keys.add(storage.getBuffer() + i * 8);
+            missingKeys.add(storage.getBuffer() + i * 8 + 4);
+        }
+        _bench("pointer", keys, missingKeys, iterationCount);
+    }
+
+    // Strings, like the symbol and name maps
+    {
+        List<String> keys, missingKeys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            StringBuilder builder;
+            builder << "symbol_" << i;
+            keys.add(builder);
+            builder << "_missing";
+            missingKeys.add(builder);
+        }
+        _bench("String", keys, missingKeys, iterationCount);
+    }
+
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,18 @@
+// dictionary-bench.h
+#ifndef SLANG_BENCH_DICTIONARY_BENCH_H
+#define SLANG_BENCH_DICTIONARY_BENCH_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-common.h"
+
+namespace SlangBench
+{
+
+    /// Time `Slang::Dictionary` against `LegacyDictionary` (the implementation it replaced),
+    /// for insertion, lookup and removal with several key types, and print the results.
+    /// The best time over iterationCount runs is reported for each operation.
+SlangResult runDictionaryBench(Slang::Int iterationCount);
+
+}
+
+#endif
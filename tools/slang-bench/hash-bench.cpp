@@ -0,0 +1,199 @@
+// hash-bench.cpp
+#include "hash-bench.h"
+
+#include "../../source/core/slang-hash.h"
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-string.h"
+
+#include <stdio.h>
+
+namespace SlangBench
+{
+using namespace Slang;
+
+namespace { // anonymous
+
+// Prevents the optimizer from removing work whose result is otherwise unused
+static volatile uint64_t g_sink;
+
+    /// The hash used for strings before `getHashCode64`
+static int _legacyHash(const char* buffer, size_t numChars)
+{
+    int hash = 0;
+    for (size_t i = 0; i < numChars; ++i)
+    {
+        hash = int(buffer[i]) + (hash << 6) + (hash << 16) - hash;
+    }
+    return hash;
+}
+
+static int _newHash(const char* buffer, size_t numChars)
+{
+    return GetHashCode(buffer, numChars);
+}
+
+static double _calcSeconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+}
+
+    /// Time func over iterationCount runs, returning the best time
+template <typename F>
+static double _timeBest(Int iterationCount, const F& func)
+{
+    double best = 0.0;
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        const uint64_t startTick = ProcessUtil::getClockTick();
+        g_sink = func();
+        const double seconds = _calcSeconds(startTick);
+        best = (best == 0.0 || seconds < best) ? seconds : best;
+    }
+    return best;
+}
+
+static void _benchSpeed(Int iterationCount)
+{
+    // Hash the same total number of bytes for each size
+    const size_t totalSize = 64 * 1024 * 1024;
+    List<char> data;
+    data.setCount(Index(totalSize));
+    DefaultRandomGenerator randGen(0x5123);
+    for (auto& c : data)
+    {
+        c = char(randGen.nextInt32());
+    }
+
+    printf("speed\n");
+    printf("    %-10s %16s %16s %9s\n", "size", "legacy", "new", "speedup");
+
+    const size_t sizes[] = { 8, 16, 32, 64, 256, 4096, 1024 * 1024 };
+    for (auto size : sizes)
+    {
+        const auto hashAll = [&](int (*hash)(const char*, size_t)) -> uint64_t
+        {
+            uint64_t total = 0;
+            for (size_t offset = 0; offset + size <= totalSize; offset += size)
+            {
+                total += uint32_t(hash(data.getBuffer() + offset, size));
+            }
+            return total;
+        };
+
+        const double legacySeconds = _timeBest(iterationCount, [&]() { return hashAll(_legacyHash); });
+        const double newSeconds = _timeBest(iterationCount, [&]() { return hashAll(_newHash); });
+
+        const double mb = double(totalSize) / (1024.0 * 1024.0);
+        printf("    %-10d %11.1f MB/s %11.1f MB/s %8.2fx\n", int(size), mb / legacySeconds, mb / newSeconds, legacySeconds / newSeconds);
+    }
+}
+
+    /// Print how well hash distributes keys. A table of twice the number of keys is used, indexed by the low bits
+    /// of the hash (as a simple hash table would), and by the top bits after `Dictionary`s multiplicative mix.
+static void _printQuality(const char* name, const List<String>& keys, int (*hash)(const char*, size_t))
+{
+    Index tableSize = 1;
+    int tableBits = 0;
+    while (tableSize < keys.getCount() * 2)
+    {
+        tableSize *= 2;
+        tableBits++;
+    }
+
+    List<int> lowBitsCounts, mixedCounts;
+    lowBitsCounts.setCount(tableSize);
+    mixedCounts.setCount(tableSize);
+    for (Index i = 0; i < tableSize; ++i)
+    {
+        lowBitsCounts[i] = 0;
+        mixedCounts[i] = 0;
+    }
+
+    List<uint32_t> hashes;
+    for (const auto& key : keys)
+    {
+        const uint32_t value = uint32_t(hash(key.getBuffer(), size_t(key.getLength())));
+        hashes.add(value);
+        lowBitsCounts[Index(value & uint32_t(tableSize - 1))]++;
+        mixedCounts[Index((uint64_t(value) * 0x9E3779B97F4A7C15ull) >> (64 - tableBits))]++;
+    }
+
+    // Keys with the same 32 bit hash can never be told apart without comparing them
+    hashes.sort();
+    Index fullCollisionCount = 0;
+    for (Index i = 1; i < hashes.getCount(); ++i)
+    {
+        fullCollisionCount += (hashes[i] == hashes[i - 1]) ? 1 : 0;
+    }
+
+    // The number of key pairs that share a slot, compared with the expected number for a random hash
+    const auto calcPairs = [](const List<int>& counts) -> double
+    {
+        double pairs = 0;
+        for (auto count : counts)
+        {
+            pairs += double(count) * double(count - 1) / 2.0;
+        }
+        return pairs;
+    };
+    const double keyCount = double(keys.getCount());
+    const double expectedPairs = keyCount * (keyCount - 1) / (2.0 * double(tableSize));
+
+    printf("    %-8s %18d %16.2f %16.2f\n", name, int(fullCollisionCount), calcPairs(lowBitsCounts) / expectedPairs, calcPairs(mixedCounts) / expectedPairs);
+}
+
+static void _benchQuality(const char* name, const List<String>& keys)
+{
+    printf("%s (%d keys)\n", name, int(keys.getCount()));
+    printf("    %-8s %18s %16s %16s\n", "", "32 bit collisions", "low bits", "mixed");
+    _printQuality("legacy", keys, _legacyHash);
+    _printQuality("new", keys, _newHash);
+}
+
+} // anonymous
+
+SlangResult runHashBench(Int iterationCount)
+{
+    _benchSpeed(iterationCount);
+
+    printf("\nquality (slot collisions as a multiple of those expected of a random hash, so 1 is ideal)\n");
+
+    const Index keyCount = 200000;
+    StringBuilder buf;
+
+    // Like mangled names, which share long prefixes and suffixes
+    {
+        List<String> keys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            buf.Clear();
+            buf << "_ST" << (i % 97) << "Texture2D" << "R" << i << "main" << "p1pi_f";
+            keys.add(buf.ProduceString());
+        }
+        _benchQuality("mangled names", keys);
+    }
+
+    // Short identifiers, like the names in a string pool
+    {
+        List<String> keys;
+        for (Index i = 0; i < keyCount; ++i)
+        {
+            buf.Clear();
+            Index value = i;
+            do
+            {
+                buf.Append(char('a' + value % 26));
+                value /= 26;
+            }
+            while (value);
+            keys.add(buf.ProduceString());
+        }
+        _benchQuality("identifiers", keys);
+    }
+
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,18 @@
+// hash-bench.h
+#ifndef SLANG_BENCH_HASH_BENCH_H
+#define SLANG_BENCH_HASH_BENCH_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-common.h"
+
+namespace SlangBench
+{
+
+    /// Time hashing strings of a range of sizes with `getHashCode64` against the character at a time hash
+    /// it replaced, and for sets of names like those hashed during a compile, report how well each hash
+    /// distributes. The best time over iterationCount runs is reported.
+SlangResult runHashBench(Slang::Int iterationCount);
+
+}
+
+#endif
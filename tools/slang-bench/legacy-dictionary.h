@@ -0,0 +1,450 @@
+// legacy-dictionary.h
+#ifndef SLANG_BENCH_LEGACY_DICTIONARY_H
+#define SLANG_BENCH_LEGACY_DICTIONARY_H
+
+// A copy of the `Dictionary` implementation that was replaced by the open addressing
+// implementation in `source/core/slang-dictionary.h`, kept so that `slang-bench -dictionary`
+// can compare the two. It stores occupancy in a separate `UIntSet`, and uses linear probing.
+
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-uint-set.h"
+
+namespace SlangBench
+{
+using namespace Slang;
+
+	const float LegacyMaxLoadFactor = 0.7f;
+
+	template<typename TKey, typename TValue>
+	class LegacyDictionary
+	{
+		friend class Iterator;
+		friend class ItemProxy;
+	private:
+		inline int GetProbeOffset(int /*probeId*/) const
+		{
+			// quadratic probing
+			return 1;
+		}
+	private:
+		int bucketSizeMinusOne;
+		int _count;
+		UIntSet marks;
+		KeyValuePair<TKey, TValue>* hashMap;
+		void Free()
+		{
+			if (hashMap)
+				delete[] hashMap;
+			hashMap = 0;
+		}
+		inline bool IsDeleted(int pos) const
+		{
+			return marks.contains((pos << 1) + 1);
+		}
+		inline bool IsEmpty(int pos) const
+		{
+			return !marks.contains((pos << 1));
+		}
+		inline void SetDeleted(int pos, bool val)
+		{
+			if (val)
+				marks.add((pos << 1) + 1);
+			else
+				marks.remove((pos << 1) + 1);
+		}
+		inline void SetEmpty(int pos, bool val)
+		{
+			if (val)
+				marks.remove((pos << 1));
+			else
+				marks.add((pos << 1));
+		}
+		struct FindPositionResult
+		{
+			int ObjectPosition;
+			int InsertionPosition;
+			FindPositionResult()
+			{
+				ObjectPosition = -1;
+				InsertionPosition = -1;
+			}
+			FindPositionResult(int objPos, int insertPos)
+			{
+				ObjectPosition = objPos;
+				InsertionPosition = insertPos;
+			}
+
+		};
+		inline int GetHashPos(TKey& key) const
+		{
+			return ((unsigned int)(GetHashCode(key) * 2654435761)) % bucketSizeMinusOne;
+		}
+		FindPositionResult FindPosition(const TKey& key) const
+		{
+			int hashPos = GetHashPos(const_cast<TKey&>(key));
+			int insertPos = -1;
+			int numProbes = 0;
+			while (numProbes <= bucketSizeMinusOne)
+			{
+				if (IsEmpty(hashPos))
+				{
+					if (insertPos == -1)
+						return FindPositionResult(-1, hashPos);
+					else
+						return FindPositionResult(-1, insertPos);
+				}
+				else if (IsDeleted(hashPos))
+				{
+					if (insertPos == -1)
+						insertPos = hashPos;
+				}
+				else if (hashMap[hashPos].Key == key)
+				{
+					return FindPositionResult(hashPos, -1);
+				}
+				numProbes++;
+				hashPos = (hashPos + GetProbeOffset(numProbes)) & bucketSizeMinusOne;
+			}
+			if (insertPos != -1)
+				return FindPositionResult(-1, insertPos);
+			throw InvalidOperationException("Hash map is full. This indicates an error in Key::Equal or Key::GetHashCode.");
+		}
+		TValue & _Insert(KeyValuePair<TKey, TValue>&& kvPair, int pos)
+		{
+			hashMap[pos] = _Move(kvPair);
+			SetEmpty(pos, false);
+			SetDeleted(pos, false);
+			return hashMap[pos].Value;
+		}
+		void Rehash()
+		{
+			if (bucketSizeMinusOne == -1 || _count >= int(LegacyMaxLoadFactor * bucketSizeMinusOne))
+			{
+				int newSize = (bucketSizeMinusOne + 1) * 2;
+				if (newSize == 0)
+				{
+					newSize = 16;
+				}
+				LegacyDictionary<TKey, TValue> newDict;
+				newDict.bucketSizeMinusOne = newSize - 1;
+				newDict.hashMap = new KeyValuePair<TKey, TValue>[newSize];
+				newDict.marks.resizeAndClear(newSize * 2);
+				if (hashMap)
+				{
+					for (auto & kvPair : *this)
+					{
+						newDict.Add(_Move(kvPair));
+					}
+				}
+				*this = _Move(newDict);
+			}
+		}
+
+		bool AddIfNotExists(KeyValuePair<TKey, TValue>&& kvPair)
+		{
+			Rehash();
+			auto pos = FindPosition(kvPair.Key);
+			if (pos.ObjectPosition != -1)
+				return false;
+			else if (pos.InsertionPosition != -1)
+			{
+				_count++;
+				_Insert(_Move(kvPair), pos.InsertionPosition);
+				return true;
+			}
+			else
+				throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+		}
+		void Add(KeyValuePair<TKey, TValue>&& kvPair)
+		{
+			if (!AddIfNotExists(_Move(kvPair)))
+				throw KeyExistsException("The key already exists in Dictionary.");
+		}
+		TValue& Set(KeyValuePair<TKey, TValue>&& kvPair)
+		{
+			Rehash();
+			auto pos = FindPosition(kvPair.Key);
+			if (pos.ObjectPosition != -1)
+				return _Insert(_Move(kvPair), pos.ObjectPosition);
+			else if (pos.InsertionPosition != -1)
+			{
+				_count++;
+				return _Insert(_Move(kvPair), pos.InsertionPosition);
+			}
+			else
+				throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+		}
+	public:
+		class Iterator
+		{
+		private:
+			const LegacyDictionary<TKey, TValue> * dict;
+			int pos;
+		public:
+			KeyValuePair<TKey, TValue> & operator *() const
+			{
+				return dict->hashMap[pos];
+			}
+			KeyValuePair<TKey, TValue> * operator ->() const
+			{
+				return dict->hashMap + pos;
+			}
+			Iterator & operator ++()
+			{
+				if (pos > dict->bucketSizeMinusOne)
+					return *this;
+				pos++;
+				while (pos <= dict->bucketSizeMinusOne && (dict->IsDeleted(pos) || dict->IsEmpty(pos)))
+				{
+					pos++;
+				}
+				return *this;
+			}
+			Iterator operator ++(int)
+			{
+				Iterator rs = *this;
+				operator++();
+				return rs;
+			}
+			bool operator != (const Iterator & _that) const
+			{
+				return pos != _that.pos || dict != _that.dict;
+			}
+			bool operator == (const Iterator & _that) const
+			{
+				return pos == _that.pos && dict == _that.dict;
+			}
+			Iterator(const LegacyDictionary<TKey, TValue> * _dict, int _pos)
+			{
+				this->dict = _dict;
+				this->pos = _pos;
+			}
+			Iterator()
+			{
+				this->dict = 0;
+				this->pos = 0;
+			}
+		};
+
+		Iterator begin() const
+		{
+			int pos = 0;
+			while (pos < bucketSizeMinusOne + 1)
+			{
+				if (IsEmpty(pos) || IsDeleted(pos))
+					pos++;
+				else
+					break;
+			}
+			return Iterator(this, pos);
+		}
+		Iterator end() const
+		{
+			return Iterator(this, bucketSizeMinusOne + 1);
+		}
+	public:
+		void Add(const TKey & key, const TValue & value)
+		{
+			Add(KeyValuePair<TKey, TValue>(key, value));
+		}
+		void Add(TKey && key, TValue && value)
+		{
+			Add(KeyValuePair<TKey, TValue>(_Move(key), _Move(value)));
+		}
+		bool AddIfNotExists(const TKey & key, const TValue & value)
+		{
+			return AddIfNotExists(KeyValuePair<TKey, TValue>(key, value));
+		}
+		bool AddIfNotExists(TKey && key, TValue && value)
+		{
+			return AddIfNotExists(KeyValuePair<TKey, TValue>(_Move(key), _Move(value)));
+		}
+		void Remove(const TKey & key)
+		{
+			if (_count == 0)
+				return;
+			auto pos = FindPosition(key);
+			if (pos.ObjectPosition != -1)
+			{
+				SetDeleted(pos.ObjectPosition, true);
+				_count--;
+			}
+		}
+		void Clear()
+		{
+			_count = 0;
+
+			marks.clear();
+		}
+
+        TValue* TryGetValueOrAdd(const TKey& key, const TValue& value)
+        {
+            Rehash();
+            auto pos = FindPosition(key);
+            if (pos.ObjectPosition != -1)
+            {
+                return &hashMap[pos.ObjectPosition].Value;
+            }
+            else if (pos.InsertionPosition != -1)
+            {
+                // Make pair
+                KeyValuePair<TKey, TValue> kvPair(_Move(key), _Move(value));
+                _count++;
+                _Insert(_Move(kvPair), pos.InsertionPosition);
+                return nullptr;
+            }
+            else
+                throw InvalidOperationException("Inconsistent find result returned. This is a bug in Dictionary implementation.");
+        }
+
+		bool ContainsKey(const TKey& key) const
+		{
+			if (bucketSizeMinusOne == -1)
+				return false;
+			auto pos = FindPosition(key);
+			return pos.ObjectPosition != -1;
+		}
+		bool TryGetValue(const TKey& key, TValue& value) const
+		{
+			if (bucketSizeMinusOne == -1)
+				return false;
+			auto pos = FindPosition(key);
+			if (pos.ObjectPosition != -1)
+			{
+				value = hashMap[pos.ObjectPosition].Value;
+				return true;
+			}
+			return false;
+		}
+		TValue* TryGetValue(const TKey& key) const
+		{
+			if (bucketSizeMinusOne == -1)
+				return nullptr;
+			auto pos = FindPosition(key);
+			if (pos.ObjectPosition != -1)
+			{
+				return &hashMap[pos.ObjectPosition].Value;
+			}
+			return nullptr;
+		}
+
+		class ItemProxy
+		{
+		private:
+			const LegacyDictionary<TKey, TValue> * dict;
+			TKey key;
+		public:
+			ItemProxy(const TKey& _key, const LegacyDictionary<TKey, TValue>* _dict)
+			{
+				this->dict = _dict;
+				this->key = _key;
+			}
+			ItemProxy(TKey&& _key, const LegacyDictionary<TKey, TValue>* _dict)
+			{
+				this->dict = _dict;
+				this->key = _Move(_key);
+			}
+			TValue & GetValue() const
+			{
+				auto pos = dict->FindPosition(key);
+				if (pos.ObjectPosition != -1)
+				{
+					return dict->hashMap[pos.ObjectPosition].Value;
+				}
+				else
+					throw KeyNotFoundException("The key does not exists in dictionary.");
+			}
+			inline TValue & operator()() const
+			{
+				return GetValue();
+			}
+			operator TValue&() const
+			{
+				return GetValue();
+			}
+			TValue & operator = (const TValue & val) const
+			{
+				return ((LegacyDictionary<TKey, TValue>*)dict)->Set(KeyValuePair<TKey, TValue>(_Move(key), val));
+			}
+			TValue & operator = (TValue && val) const
+			{
+				return ((LegacyDictionary<TKey, TValue>*)dict)->Set(KeyValuePair<TKey, TValue>(_Move(key), _Move(val)));
+			}
+		};
+		ItemProxy operator [](const TKey & key) const
+		{
+			return ItemProxy(key, this);
+		}
+		ItemProxy operator [](TKey && key) const
+		{
+			return ItemProxy(_Move(key), this);
+		}
+		int Count() const
+		{
+			return _count;
+		}
+	private:
+		template<typename... Args>
+		void Init(const KeyValuePair<TKey, TValue> & kvPair, Args... args)
+		{
+			Add(kvPair);
+			Init(args...);
+		}
+	public:
+		LegacyDictionary()
+		{
+			bucketSizeMinusOne = -1;
+			_count = 0;
+			hashMap = nullptr;
+		}
+		template<typename Arg, typename... Args>
+		LegacyDictionary(Arg arg, Args... args)
+		{
+			Init(arg, args...);
+		}
+		LegacyDictionary(const LegacyDictionary<TKey, TValue>& other)
+			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+		{
+			*this = other;
+		}
+		LegacyDictionary(LegacyDictionary<TKey, TValue>&& other)
+			: bucketSizeMinusOne(-1), _count(0), hashMap(nullptr)
+		{
+			*this = (_Move(other));
+		}
+		LegacyDictionary<TKey, TValue>& operator = (const LegacyDictionary<TKey, TValue>& other)
+		{
+			if (this == &other)
+				return *this;
+			Free();
+			bucketSizeMinusOne = other.bucketSizeMinusOne;
+			_count = other._count;
+			hashMap = new KeyValuePair<TKey, TValue>[other.bucketSizeMinusOne + 1];
+			marks = other.marks;
+			for (int i = 0; i <= bucketSizeMinusOne; i++)
+				hashMap[i] = other.hashMap[i];
+			return *this;
+		}
+		LegacyDictionary<TKey, TValue> & operator = (LegacyDictionary<TKey, TValue>&& other)
+		{
+			if (this == &other)
+				return *this;
+			Free();
+			bucketSizeMinusOne = other.bucketSizeMinusOne;
+			_count = other._count;
+			hashMap = other.hashMap;
+			marks = _Move(other.marks);
+			other.hashMap = 0;
+			other._count = 0;
+			other.bucketSizeMinusOne = -1;
+			return *this;
+		}
+		~LegacyDictionary()
+		{
+			Free();
+		}
+	};
+
+}
+
+#endif
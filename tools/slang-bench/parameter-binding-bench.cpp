@@ -0,0 +1,120 @@
+// parameter-binding-bench.cpp
+#include "parameter-binding-bench.h"
+
+#include "../../slang-com-helper.h"
+
+#include "../../source/core/slang-math.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-string.h"
+
+#include <stdio.h>
+
+namespace SlangBench
+{
+using namespace Slang;
+
+namespace { // anonymous
+
+static const Index kSpaceCount = 8;
+
+    /// Generate a module with parameterCount texture parameters, and a compute entry point.
+    /// Half the parameters have explicit registers, using every other register in each space
+    /// so that automatically bound parameters fill the gaps.
+static void _generateSource(Index parameterCount, StringBuilder& out)
+{
+    const Index explicitCount = parameterCount / 2;
+    const Index perSpaceCount = (explicitCount + kSpaceCount - 1) / kSpaceCount;
+
+    List<Index> order;
+    for (Index i = 0; i < explicitCount; ++i)
+    {
+        order.add(i);
+    }
+    // Shuffle, so that registers aren't bound in increasing order
+    DefaultRandomGenerator randGen(0x5123);
+    for (Index i = explicitCount - 1; i > 0; --i)
+    {
+        const Index j = randGen.nextInt32UpTo(int(i + 1));
+        Swap(order[i], order[j]);
+    }
+
+    for (auto i : order)
+    {
+        out << "Texture2D gExplicit" << i << " : register(t" << (i % perSpaceCount) * 2 << ", space" << (i / perSpaceCount) << ");\n";
+    }
+    for (Index i = explicitCount; i < parameterCount; ++i)
+    {
+        out << "Texture2D gImplicit" << i << ";\n";
+    }
+
+    out << "[numthreads(1, 1, 1)]\nvoid computeMain() {}\n";
+}
+
+    /// Compile source once, and get the time for the layout phase and the whole compile
+static SlangResult _compileOnce(SlangSession* session, const String& source, double& outLayoutSeconds, double& outTotalSeconds)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "sm_5_1"));
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "parameter-binding-bench.slang", source.getBuffer());
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    spSetProfilingEnabled(request, 1);
+
+    const uint64_t startTick = ProcessUtil::getClockTick();
+    const SlangResult res = spCompile(request);
+    outTotalSeconds = double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+
+    if (SLANG_FAILED(res))
+    {
+        const char* diagnostics = spGetDiagnosticOutput(request);
+        fprintf(stderr, "error: parameter binding benchmark compile failed\n%s\n", diagnostics ? diagnostics : "");
+        spDestroyCompileRequest(request);
+        return res;
+    }
+
+    outLayoutSeconds = 0.0;
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_SUCCEEDED(spGetProfileEvent(request, i, &event)) && UnownedStringSlice(event.name) == "layout")
+        {
+            outLayoutSeconds += event.durationInSeconds;
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return SLANG_OK;
+}
+
+} // anonymous
+
+SlangResult runParameterBindingBench(SlangSession* session, Int iterationCount, Index parameterCount)
+{
+    StringBuilder source;
+    _generateSource(parameterCount, source);
+
+    double bestLayoutSeconds = -1.0;
+    double bestTotalSeconds = -1.0;
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        double layoutSeconds, totalSeconds;
+        SLANG_RETURN_ON_FAIL(_compileOnce(session, source, layoutSeconds, totalSeconds));
+
+        bestLayoutSeconds = (bestLayoutSeconds < 0.0) ? layoutSeconds : Math::Min(bestLayoutSeconds, layoutSeconds);
+        bestTotalSeconds = (bestTotalSeconds < 0.0) ? totalSeconds : Math::Min(bestTotalSeconds, totalSeconds);
+    }
+
+    printf("parameter binding (%d parameters, %d spaces)\n", int(parameterCount), int(kSpaceCount));
+    printf("    %-10s %10.3f ms %14.1f parameters/sec\n", "layout", bestLayoutSeconds * 1000.0,
+        bestLayoutSeconds > 0.0 ? double(parameterCount) / bestLayoutSeconds : 0.0);
+    printf("    %-10s %10.3f ms\n", "compile", bestTotalSeconds * 1000.0);
+    return SLANG_OK;
+}
+
+}
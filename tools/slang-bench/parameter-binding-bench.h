@@ -0,0 +1,19 @@
+// parameter-binding-bench.h
+#ifndef SLANG_BENCH_PARAMETER_BINDING_BENCH_H
+#define SLANG_BENCH_PARAMETER_BINDING_BENCH_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-common.h"
+
+namespace SlangBench
+{
+
+    /// Time parameter binding (the 'layout' phase) for generated code with parameterCount
+    /// global resource parameters, half bound explicitly across several spaces (in shuffled
+    /// order) and half bound automatically, and print the results.
+    /// The best time over iterationCount compiles is reported.
+SlangResult runParameterBindingBench(SlangSession* session, Slang::Int iterationCount, Slang::Index parameterCount);
+
+}
+
+#endif
@@ -0,0 +1,159 @@
+// ref-object-pool-bench.cpp
+#include "ref-object-pool-bench.h"
+
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-ref-object-pool.h"
+
+#include <stdio.h>
+
+namespace SlangBench
+{
+using namespace Slang;
+
+namespace { // anonymous
+
+// Prevents the optimizer from removing work whose result is otherwise unused
+static volatile Int g_sink;
+
+// Like `PairPseudoVal`
+struct BenchPairVal : RefObject
+{
+    SLANG_REF_OBJECT_POOL_ALLOCATED
+
+    RefPtr<RefObject> ordinaryVal;
+    RefPtr<RefObject> specialVal;
+    Int value = 0;
+};
+
+// Like `TuplePseudoVal`
+struct BenchTupleVal : RefObject
+{
+    SLANG_REF_OBJECT_POOL_ALLOCATED
+
+    List<RefPtr<RefObject>> elements;
+    Int value = 0;
+};
+
+    /// The results of one way of allocating
+struct BenchResult
+{
+    double seconds = 0.0;           ///< The best time over the iterations
+    Int objectCount = 0;            ///< The objects allocated in each iteration
+    Int heapAllocationCount = 0;    ///< Allocations made from the heap over all of the iterations (including pool blocks)
+};
+
+static double _calcSeconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+}
+
+    /// Make a tuple of pairs, like the legalized value of a `struct` with resource fields
+static RefPtr<RefObject> _makeTuple(Index elementCount, Int value)
+{
+    RefPtr<BenchTupleVal> tuple = new BenchTupleVal();
+    tuple->value = value;
+    for (Index i = 0; i < elementCount; ++i)
+    {
+        RefPtr<BenchPairVal> pair = new BenchPairVal();
+        pair->value = value + i;
+        pair->ordinaryVal = new BenchPairVal();
+        tuple->elements.add(pair);
+    }
+    return tuple;
+}
+
+    /// Build treeCount trees and hold them all (as a pass would in its maps), then free them
+static Int _runTrees(Index treeCount)
+{
+    List<RefPtr<RefObject>> trees;
+    for (Index i = 0; i < treeCount; ++i)
+    {
+        trees.add(_makeTuple(4, Int(i)));
+    }
+    Int total = 0;
+    for (auto& tree : trees)
+    {
+        total += tree.as<BenchTupleVal>()->value;
+    }
+    return total;
+}
+
+    /// Keep liveCount trees alive, replacing a random one each step, so frees are in no particular order
+static Int _runChurn(Index liveCount, Index stepCount)
+{
+    DefaultRandomGenerator randGen(0x5123);
+
+    List<RefPtr<RefObject>> live;
+    for (Index i = 0; i < liveCount; ++i)
+    {
+        live.add(_makeTuple(1 + (i & 3), Int(i)));
+    }
+    Int total = 0;
+    for (Index i = 0; i < stepCount; ++i)
+    {
+        const Index index = randGen.nextInt32UpTo(int(liveCount));
+        total += live[index].as<BenchTupleVal>()->value;
+        live[index] = _makeTuple(1 + (i & 3), Int(i));
+    }
+    return total;
+}
+
+template <typename F>
+static BenchResult _bench(bool usePool, Int iterationCount, const F& func)
+{
+    BenchResult result;
+
+    // A pool is reused between iterations, as a linkage's is between compiles
+    RefPtr<RefObjectPool> pool = usePool ? new RefObjectPool() : nullptr;
+    RefObjectPoolScope poolScope(pool);
+
+    const auto& stats = RefObjectAllocationStats::getForThread();
+    const Int startHeapCount = stats.heapCount;
+
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        const Int startObjectCount = stats.pooledCount + stats.heapCount;
+
+        const uint64_t startTick = ProcessUtil::getClockTick();
+        g_sink = func();
+        const double seconds = _calcSeconds(startTick);
+
+        result.seconds = (result.seconds == 0.0 || seconds < result.seconds) ? seconds : result.seconds;
+        result.objectCount = stats.pooledCount + stats.heapCount - startObjectCount;
+    }
+
+    result.heapAllocationCount = stats.heapCount - startHeapCount;
+    if (pool)
+    {
+        result.heapAllocationCount += pool->calcBlockCount();
+    }
+    return result;
+}
+
+template <typename F>
+static void _benchAndPrint(const char* name, Int iterationCount, const F& func)
+{
+    const BenchResult heap = _bench(false, iterationCount, func);
+    const BenchResult pooled = _bench(true, iterationCount, func);
+
+    const double heapNs = heap.seconds * 1e9 / double(heap.objectCount);
+    const double pooledNs = pooled.seconds * 1e9 / double(pooled.objectCount);
+
+    printf("%s (%d objects)\n", name, int(heap.objectCount));
+    printf("    %-22s %13s %13s %9s\n", "", "heap", "pool", "speedup");
+    printf("    %-22s %10.2f ns %10.2f ns %8.2fx\n", "time per object", heapNs, pooledNs, (pooledNs > 0.0) ? heapNs / pooledNs : 0.0);
+    printf("    %-22s %13d %13d\n", "heap allocations", int(heap.heapAllocationCount), int(pooled.heapAllocationCount));
+}
+
+} // anonymous
+
+SlangResult runRefObjectPoolBench(Int iterationCount)
+{
+    _benchAndPrint("trees", iterationCount, []() { return _runTrees(20000); });
+    _benchAndPrint("churn", iterationCount, []() { return _runChurn(1000, 50000); });
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,19 @@
+// ref-object-pool-bench.h
+#ifndef SLANG_BENCH_REF_OBJECT_POOL_BENCH_H
+#define SLANG_BENCH_REF_OBJECT_POOL_BENCH_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-common.h"
+
+namespace SlangBench
+{
+
+    /// Time creating and freeing small pool allocated `RefObject`s (shaped like the pseudo-values
+    /// made by type legalization) from the heap and from a `RefObjectPool`, and print the time per
+    /// object and the number of heap allocations each made.
+    /// The best time over iterationCount runs is reported.
+SlangResult runRefObjectPoolBench(Slang::Int iterationCount);
+
+}
+
+#endif
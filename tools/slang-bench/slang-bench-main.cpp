@@ -0,0 +1,747 @@
+// slang-bench-main.cpp
+
+// `slang-bench` measures compile throughput. It compiles each of the entries in a corpus
+// (see `corpus.txt`) a number of times with profiling enabled, and reports the time taken
+// by each phase of the compile as throughput (source lines per second for front-end
+// phases, entry points per second for the back end), along with peak memory use.
+//
+// The results can be saved as a baseline, and compared against a previously saved
+// baseline to find regressions.
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+
+#include "byte-encode-bench.h"
+#include "dictionary-bench.h"
+#include "hash-bench.h"
+#include "parameter-binding-bench.h"
+#include "ref-object-pool-bench.h"
+#include "uint-set-bench.h"
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   include <windows.h>
+#   define PSAPI_VERSION 2
+#   include <psapi.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+using namespace Slang;
+
+    /// An entry in the corpus
+struct CorpusEntry
+{
+    String name;                    ///< Name used to identify the entry in reports and baselines
+    List<String> args;              ///< slangc style options
+    List<String> genericArgs;       ///< Arguments for global generic type parameters
+};
+
+    /// A measured value
+struct Metric
+{
+    String name;
+    double value = 0.0;
+    bool isHigherBetter = true;     ///< True for throughput, false for memory
+};
+
+struct Options
+{
+    String corpusPath = "tools/slang-bench/corpus.txt";
+    String baselinePath;            ///< If set, compare against this baseline
+    String writeBaselinePath;       ///< If set, write the results as a baseline to this path
+    Int iterationCount = 5;
+    double tolerance = 0.1;         ///< The fraction a metric can be worse than the baseline before being reported
+    bool runDictionaryBench = false;    ///< If set, run the Dictionary microbenchmark instead of the corpus
+    bool runRefObjectPoolBench = false; ///< If set, run the RefObjectPool microbenchmark instead of the corpus
+    bool runByteEncodeBench = false;    ///< If set, run the ByteEncodeUtil microbenchmark instead of the corpus
+    bool runHashBench = false;          ///< If set, run the hashing microbenchmark instead of the corpus
+    bool runUIntSetBench = false;       ///< If set, run the UIntSet microbenchmark instead of the corpus
+    bool runSerialIRBench = false;      ///< If set, compare the serial IR compression options over the corpus
+    bool runParameterBindingBench = false;  ///< If set, time parameter binding for generated code instead of the corpus
+    bool runReflectionOnlyBench = false;    ///< If set, compare front-end time with and without `-reflection-only` over the corpus
+};
+
+    /// The measurements for a single phase of a corpus entry
+struct PhaseMeasure
+{
+    String category;
+    String name;
+    double seconds = 0.0;           ///< The best (lowest) total time over the iterations
+    Int64 byteCount = 0;            ///< Bytes processed by the phase, if the events give it in their detail (as "<text>, <count> bytes")
+};
+
+static size_t _getPeakMemoryUsage()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return size_t(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#   ifdef __APPLE__
+    // Reported in bytes
+    return size_t(usage.ru_maxrss);
+#   else
+    // Reported in kilobytes
+    return size_t(usage.ru_maxrss) * 1024;
+#   endif
+#endif
+}
+
+static SlangResult _parseOptions(int argc, const char*const* argv, Options& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const String arg = argv[i];
+        if (arg == "-dictionary")
+        {
+            outOptions.runDictionaryBench = true;
+            continue;
+        }
+        if (arg == "-ref-object-pool")
+        {
+            outOptions.runRefObjectPoolBench = true;
+            continue;
+        }
+        if (arg == "-byte-encode")
+        {
+            outOptions.runByteEncodeBench = true;
+            continue;
+        }
+        if (arg == "-hash")
+        {
+            outOptions.runHashBench = true;
+            continue;
+        }
+        if (arg == "-uint-set")
+        {
+            outOptions.runUIntSetBench = true;
+            continue;
+        }
+        if (arg == "-serial-ir")
+        {
+            outOptions.runSerialIRBench = true;
+            continue;
+        }
+        if (arg == "-parameter-binding")
+        {
+            outOptions.runParameterBindingBench = true;
+            continue;
+        }
+        if (arg == "-reflection-only")
+        {
+            outOptions.runReflectionOnlyBench = true;
+            continue;
+        }
+
+        if (i + 1 >= argc)
+        {
+            fprintf(stderr, "error: unknown option, or option '%s' expects a value\n", arg.getBuffer());
+            return SLANG_FAIL;
+        }
+        const String value = argv[++i];
+
+        if (arg == "-corpus")
+        {
+            outOptions.corpusPath = value;
+        }
+        else if (arg == "-baseline")
+        {
+            outOptions.baselinePath = value;
+        }
+        else if (arg == "-write-baseline")
+        {
+            outOptions.writeBaselinePath = value;
+        }
+        else if (arg == "-iterations")
+        {
+            Int count;
+            if (SLANG_FAILED(StringUtil::parseInt(value.getUnownedSlice(), count)) || count <= 0)
+            {
+                fprintf(stderr, "error: invalid iteration count '%s'\n", value.getBuffer());
+                return SLANG_FAIL;
+            }
+            outOptions.iterationCount = count;
+        }
+        else if (arg == "-tolerance")
+        {
+            Int percent;
+            if (SLANG_FAILED(StringUtil::parseInt(value.getUnownedSlice(), percent)) || percent < 0)
+            {
+                fprintf(stderr, "error: invalid tolerance '%s' (expected a percentage)\n", value.getBuffer());
+                return SLANG_FAIL;
+            }
+            outOptions.tolerance = double(percent) / 100.0;
+        }
+        else
+        {
+            fprintf(stderr, "error: unknown option '%s'\n", arg.getBuffer());
+            return SLANG_FAIL;
+        }
+    }
+    return SLANG_OK;
+}
+
+static void _splitTokens(const UnownedStringSlice& text, List<String>& outTokens)
+{
+    const char* cur = text.begin();
+    const char* end = text.end();
+    while (cur < end)
+    {
+        while (cur < end && (*cur == ' ' || *cur == '\t'))
+        {
+            cur++;
+        }
+        const char* start = cur;
+        while (cur < end && *cur != ' ' && *cur != '\t')
+        {
+            cur++;
+        }
+        if (cur > start)
+        {
+            outTokens.add(UnownedStringSlice(start, cur));
+        }
+    }
+}
+
+static SlangResult _readCorpus(const String& path, List<CorpusEntry>& outEntries)
+{
+    if (!File::exists(path))
+    {
+        fprintf(stderr, "error: cannot open corpus '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    const String text = File::readAllText(path);
+
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text.getUnownedSlice(), lines);
+
+    for (const auto& rawLine : lines)
+    {
+        const UnownedStringSlice line = rawLine.trim();
+        if (line.size() == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        const Index colonIndex = line.indexOf(':');
+        if (colonIndex < 0)
+        {
+            fprintf(stderr, "error: expected '<name>: <options>' in corpus line '%s'\n", String(line).getBuffer());
+            return SLANG_FAIL;
+        }
+
+        CorpusEntry entry;
+        entry.name = UnownedStringSlice(line.begin(), line.begin() + colonIndex).trim();
+
+        List<String> tokens;
+        _splitTokens(UnownedStringSlice(line.begin() + colonIndex + 1, line.end()), tokens);
+
+        for (Index i = 0; i < tokens.getCount(); ++i)
+        {
+            if (tokens[i] == "-generic-arg" && i + 1 < tokens.getCount())
+            {
+                entry.genericArgs.add(tokens[++i]);
+            }
+            else
+            {
+                entry.args.add(tokens[i]);
+            }
+        }
+
+        outEntries.add(entry);
+    }
+    return SLANG_OK;
+}
+
+static Index _countLines(const String& path)
+{
+    if (!File::exists(path))
+    {
+        return 0;
+    }
+    const String text = File::readAllText(path);
+    List<UnownedStringSlice> lines;
+    StringUtil::calcLines(text.getUnownedSlice(), lines);
+    return lines.getCount();
+}
+
+    /// Get the byte count from an event detail of the form "<text>, <count> bytes", or 0 if it doesn't have one
+static Int64 _parseByteCount(const UnownedStringSlice& detail)
+{
+    const UnownedStringSlice suffix = UnownedStringSlice::fromLiteral(" bytes");
+    const Index commaIndex = detail.lastIndexOf(',');
+    if (commaIndex < 0 || !detail.endsWith(suffix))
+    {
+        return 0;
+    }
+    Int count;
+    if (SLANG_FAILED(StringUtil::parseInt(UnownedStringSlice(detail.begin() + commaIndex + 1, detail.end() - suffix.size()).trim(), count)))
+    {
+        return 0;
+    }
+    return Int64(count);
+}
+
+    /// Compile the entry once, adding the time taken by each phase to outPhases.
+    /// extraArgs are added after the entry's own options.
+static SlangResult _compileEntry(SlangSession* session, const CorpusEntry& entry, const List<String>& extraArgs, List<PhaseMeasure>& outPhases, Index& outLineCount, Index& outEntryPointCount)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    List<const char*> args;
+    for (const auto& arg : entry.args)
+    {
+        args.add(arg.getBuffer());
+    }
+    for (const auto& arg : extraArgs)
+    {
+        args.add(arg.getBuffer());
+    }
+
+    SlangResult res = spProcessCommandLineArguments(request, args.getBuffer(), int(args.getCount()));
+    if (SLANG_SUCCEEDED(res) && entry.genericArgs.getCount())
+    {
+        List<const char*> genericArgs;
+        for (const auto& genericArg : entry.genericArgs)
+        {
+            genericArgs.add(genericArg.getBuffer());
+        }
+        res = spSetGlobalGenericArgs(request, int(genericArgs.getCount()), genericArgs.getBuffer());
+    }
+
+    if (SLANG_SUCCEEDED(res))
+    {
+        spSetProfilingEnabled(request, 1);
+        res = spCompile(request);
+    }
+
+    if (SLANG_FAILED(res))
+    {
+        const char* diagnostics = spGetDiagnosticOutput(request);
+        fprintf(stderr, "error: compile of '%s' failed\n%s\n", entry.name.getBuffer(), diagnostics ? diagnostics : "");
+        spDestroyCompileRequest(request);
+        return res;
+    }
+
+    // Sum the time of each phase (an IR pass may run more than once per entry point, and
+    // per entry point phases run once for each entry point)
+    outEntryPointCount = 0;
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_FAILED(spGetProfileEvent(request, i, &event)))
+        {
+            continue;
+        }
+
+        const UnownedStringSlice category(event.category);
+        const UnownedStringSlice name(event.name);
+
+        if (category == UnownedStringSlice::fromLiteral("back-end"))
+        {
+            outEntryPointCount++;
+        }
+
+        Index phaseIndex = 0;
+        for (; phaseIndex < outPhases.getCount(); ++phaseIndex)
+        {
+            const auto& phase = outPhases[phaseIndex];
+            if (phase.category.getUnownedSlice() == category && phase.name.getUnownedSlice() == name)
+            {
+                break;
+            }
+        }
+        if (phaseIndex == outPhases.getCount())
+        {
+            PhaseMeasure phase;
+            phase.category = category;
+            phase.name = name;
+            outPhases.add(phase);
+        }
+        outPhases[phaseIndex].seconds += event.durationInSeconds;
+        outPhases[phaseIndex].byteCount += event.detail ? _parseByteCount(UnownedStringSlice(event.detail)) : 0;
+    }
+
+    // All of the files read by the compile (including `#include`d and `import`ed files)
+    outLineCount = 0;
+    const int fileCount = spGetDependencyFileCount(request);
+    for (int i = 0; i < fileCount; ++i)
+    {
+        outLineCount += _countLines(spGetDependencyFilePath(request, i));
+    }
+
+    spDestroyCompileRequest(request);
+    return SLANG_OK;
+}
+
+static SlangResult _benchEntry(SlangSession* session, const CorpusEntry& entry, const Options& options, List<Metric>& ioMetrics)
+{
+    List<PhaseMeasure> bestPhases;
+    Index lineCount = 0;
+    Index entryPointCount = 0;
+
+    for (Int iteration = 0; iteration < options.iterationCount; ++iteration)
+    {
+        List<PhaseMeasure> phases;
+        SLANG_RETURN_ON_FAIL(_compileEntry(session, entry, List<String>(), phases, lineCount, entryPointCount));
+
+        // Keep the best time for each phase, as the least affected by noise
+        for (const auto& phase : phases)
+        {
+            Index bestIndex = 0;
+            for (; bestIndex < bestPhases.getCount(); ++bestIndex)
+            {
+                if (bestPhases[bestIndex].category == phase.category && bestPhases[bestIndex].name == phase.name)
+                {
+                    break;
+                }
+            }
+            if (bestIndex == bestPhases.getCount())
+            {
+                bestPhases.add(phase);
+            }
+            else if (phase.seconds < bestPhases[bestIndex].seconds)
+            {
+                bestPhases[bestIndex].seconds = phase.seconds;
+            }
+        }
+    }
+
+    printf("%s (%d lines, %d entry points)\n", entry.name.getBuffer(), int(lineCount), int(entryPointCount));
+
+    for (const auto& phase : bestPhases)
+    {
+        // Front-end phases work on the source, and everything else on entry points
+        const bool isFrontEnd = (phase.category == "front-end");
+        const double count = double(isFrontEnd ? lineCount : entryPointCount);
+        const double throughput = (phase.seconds > 0.0) ? count / phase.seconds : 0.0;
+
+        printf("    %-10s %-40s %10.3f ms %14.1f %s\n",
+            phase.category.getBuffer(),
+            phase.name.getBuffer(),
+            phase.seconds * 1000.0,
+            throughput,
+            isFrontEnd ? "lines/sec" : "entry points/sec");
+
+        // Individual IR passes are often too short to time reliably, so they are reported,
+        // but only front-end phases and the back end as a whole are compared with a baseline
+        if (phase.category == "ir-pass" || phase.category == "downstream")
+        {
+            continue;
+        }
+
+        Metric metric;
+        metric.name = entry.name + "/" + phase.category + "/" + phase.name;
+        metric.value = throughput;
+        ioMetrics.add(metric);
+    }
+
+    return SLANG_OK;
+}
+
+    /// Compile every entry with each of the serial IR compression options (see `-serial-ir-compression`),
+    /// and report the size of the serialized IR and how long it takes to write and read.
+static SlangResult _runSerialIRBench(SlangSession* session, const List<CorpusEntry>& entries, const Options& options)
+{
+    static const char* const kCompressions[] = { "none", "lite", "lite-delta", "lz4", "lz4-delta" };
+
+    struct Result
+    {
+        Int64 byteCount = 0;
+        double writeSeconds = 0.0;
+        double readSeconds = 0.0;
+    };
+    List<Result> results;
+
+    for (const char* compression : kCompressions)
+    {
+        List<String> extraArgs;
+        extraArgs.add("-serial-ir-compression");
+        extraArgs.add(compression);
+
+        Result result;
+        for (const auto& entry : entries)
+        {
+            // Keep the best time over the iterations for each entry
+            double bestWriteSeconds = -1.0;
+            double bestReadSeconds = -1.0;
+            Int64 byteCount = 0;
+            for (Int iteration = 0; iteration < options.iterationCount; ++iteration)
+            {
+                List<PhaseMeasure> phases;
+                Index lineCount = 0;
+                Index entryPointCount = 0;
+                SLANG_RETURN_ON_FAIL(_compileEntry(session, entry, extraArgs, phases, lineCount, entryPointCount));
+
+                for (const auto& phase : phases)
+                {
+                    if (phase.name == "serialize-ir")
+                    {
+                        bestWriteSeconds = (bestWriteSeconds < 0.0) ? phase.seconds : Math::Min(bestWriteSeconds, phase.seconds);
+                    }
+                    else if (phase.name == "deserialize-ir")
+                    {
+                        bestReadSeconds = (bestReadSeconds < 0.0) ? phase.seconds : Math::Min(bestReadSeconds, phase.seconds);
+                        byteCount = phase.byteCount;
+                    }
+                }
+            }
+            result.writeSeconds += Math::Max(bestWriteSeconds, 0.0);
+            result.readSeconds += Math::Max(bestReadSeconds, 0.0);
+            result.byteCount += byteCount;
+        }
+        results.add(result);
+    }
+
+    // Throughput is given in terms of the uncompressed size, so the options can be compared directly
+    const double uncompressedMegabytes = double(results[0].byteCount) / (1024.0 * 1024.0);
+
+    printf("%-12s %14s %8s %12s %12s %12s %12s\n", "compression", "bytes", "ratio", "write ms", "read ms", "write MB/s", "read MB/s");
+    for (Index i = 0; i < results.getCount(); ++i)
+    {
+        const auto& result = results[i];
+        printf("%-12s %14lld %7.2fx %12.3f %12.3f %12.1f %12.1f\n",
+            kCompressions[i],
+            (long long)result.byteCount,
+            result.byteCount ? double(results[0].byteCount) / double(result.byteCount) : 0.0,
+            result.writeSeconds * 1000.0,
+            result.readSeconds * 1000.0,
+            result.writeSeconds > 0.0 ? uncompressedMegabytes / result.writeSeconds : 0.0,
+            result.readSeconds > 0.0 ? uncompressedMegabytes / result.readSeconds : 0.0);
+    }
+    return SLANG_OK;
+}
+
+    /// Compile every entry for reflection only (see `-reflection-only`), and without codegen (see `-no-codegen`),
+    /// and report the front-end time of each, and so the time saved by not lowering to IR.
+static SlangResult _runReflectionOnlyBench(SlangSession* session, const List<CorpusEntry>& entries, const Options& options)
+{
+    static const char* const kModes[] = { "-no-codegen", "-reflection-only" };
+
+    printf("%-40s %16s %20s %12s\n", "entry", "no-codegen ms", "reflection-only ms", "saved ms");
+
+    double totalSeconds[2] = { 0.0, 0.0 };
+    for (const auto& entry : entries)
+    {
+        double bestSeconds[2] = { -1.0, -1.0 };
+        for (Index mode = 0; mode < 2; ++mode)
+        {
+            List<String> extraArgs;
+            extraArgs.add(kModes[mode]);
+
+            // Keep the best front-end time over the iterations
+            for (Int iteration = 0; iteration < options.iterationCount; ++iteration)
+            {
+                List<PhaseMeasure> phases;
+                Index lineCount = 0;
+                Index entryPointCount = 0;
+                SLANG_RETURN_ON_FAIL(_compileEntry(session, entry, extraArgs, phases, lineCount, entryPointCount));
+
+                double seconds = 0.0;
+                for (const auto& phase : phases)
+                {
+                    if (phase.category == "front-end")
+                    {
+                        seconds += phase.seconds;
+                    }
+                }
+                bestSeconds[mode] = (bestSeconds[mode] < 0.0) ? seconds : Math::Min(bestSeconds[mode], seconds);
+            }
+            totalSeconds[mode] += bestSeconds[mode];
+        }
+
+        printf("%-40s %16.3f %20.3f %12.3f\n", entry.name.getBuffer(),
+            bestSeconds[0] * 1000.0, bestSeconds[1] * 1000.0, (bestSeconds[0] - bestSeconds[1]) * 1000.0);
+    }
+
+    printf("%-40s %16.3f %20.3f %12.3f\n", "total",
+        totalSeconds[0] * 1000.0, totalSeconds[1] * 1000.0, (totalSeconds[0] - totalSeconds[1]) * 1000.0);
+    return SLANG_OK;
+}
+
+static void _writeBaseline(const String& path, const List<Metric>& metrics)
+{
+    StringBuilder builder;
+    builder << "# slang-bench baseline: <metric> <value>\n";
+    for (const auto& metric : metrics)
+    {
+        builder << metric.name << " " << metric.value << "\n";
+    }
+    File::writeAllText(path, builder);
+}
+
+    /// Compare metrics against the baseline at path. Returns SLANG_FAIL if any metric has regressed by more than the tolerance.
+static SlangResult _compareWithBaseline(const String& path, const List<Metric>& metrics, double tolerance)
+{
+    if (!File::exists(path))
+    {
+        fprintf(stderr, "error: cannot open baseline '%s'\n", path.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    Dictionary<String, double> baselineValues;
+    {
+        const String text = File::readAllText(path);
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(text.getUnownedSlice(), lines);
+        for (const auto& rawLine : lines)
+        {
+            const UnownedStringSlice line = rawLine.trim();
+            if (line.size() == 0 || line[0] == '#')
+            {
+                continue;
+            }
+            List<String> tokens;
+            _splitTokens(line, tokens);
+            if (tokens.getCount() == 2)
+            {
+                baselineValues[tokens[0]] = atof(tokens[1].getBuffer());
+            }
+        }
+    }
+
+    printf("\nComparison with baseline '%s' (tolerance %d%%)\n", path.getBuffer(), int(tolerance * 100.0 + 0.5));
+
+    Index regressionCount = 0;
+    for (const auto& metric : metrics)
+    {
+        double baselineValue;
+        if (!baselineValues.TryGetValue(metric.name, baselineValue) || baselineValue <= 0.0)
+        {
+            printf("    %-70s (not in baseline)\n", metric.name.getBuffer());
+            continue;
+        }
+
+        const double ratio = metric.value / baselineValue;
+        const bool isRegression = metric.isHigherBetter ? (ratio < 1.0 - tolerance) : (ratio > 1.0 + tolerance);
+        if (isRegression)
+        {
+            regressionCount++;
+        }
+
+        printf("    %-70s %7.2fx%s\n", metric.name.getBuffer(), ratio, isRegression ? "  REGRESSION" : "");
+    }
+
+    if (regressionCount)
+    {
+        printf("%d metric(s) regressed\n", int(regressionCount));
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static SlangResult _innerMain(int argc, const char*const* argv)
+{
+    Options options;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, options));
+
+    if (options.runDictionaryBench)
+    {
+        return SlangBench::runDictionaryBench(options.iterationCount);
+    }
+
+    if (options.runRefObjectPoolBench)
+    {
+        return SlangBench::runRefObjectPoolBench(options.iterationCount);
+    }
+
+    if (options.runByteEncodeBench)
+    {
+        return SlangBench::runByteEncodeBench(options.iterationCount);
+    }
+
+    if (options.runHashBench)
+    {
+        return SlangBench::runHashBench(options.iterationCount);
+    }
+
+    if (options.runUIntSetBench)
+    {
+        return SlangBench::runUIntSetBench(options.iterationCount);
+    }
+
+    if (options.runParameterBindingBench)
+    {
+        SlangSession* session = spCreateSession(nullptr);
+        const SlangResult res = SlangBench::runParameterBindingBench(session, options.iterationCount, 50000);
+        spDestroySession(session);
+        return res;
+    }
+
+    List<CorpusEntry> entries;
+    SLANG_RETURN_ON_FAIL(_readCorpus(options.corpusPath, entries));
+
+    SlangSession* session = spCreateSession(nullptr);
+
+    if (options.runSerialIRBench)
+    {
+        const SlangResult res = _runSerialIRBench(session, entries, options);
+        spDestroySession(session);
+        return res;
+    }
+
+    if (options.runReflectionOnlyBench)
+    {
+        const SlangResult res = _runReflectionOnlyBench(session, entries, options);
+        spDestroySession(session);
+        return res;
+    }
+
+    List<Metric> metrics;
+    SlangResult res = SLANG_OK;
+    for (const auto& entry : entries)
+    {
+        res = _benchEntry(session, entry, options, metrics);
+        if (SLANG_FAILED(res))
+        {
+            break;
+        }
+    }
+
+    spDestroySession(session);
+    SLANG_RETURN_ON_FAIL(res);
+
+    {
+        Metric metric;
+        metric.name = "peak-memory";
+        metric.value = double(_getPeakMemoryUsage());
+        metric.isHigherBetter = false;
+        metrics.add(metric);
+
+        printf("\nPeak memory: %.1f MB\n", metric.value / (1024.0 * 1024.0));
+    }
+
+    if (options.writeBaselinePath.getLength())
+    {
+        _writeBaseline(options.writeBaselinePath, metrics);
+    }
+
+    if (options.baselinePath.getLength())
+    {
+        SLANG_RETURN_ON_FAIL(_compareWithBaseline(options.baselinePath, metrics, options.tolerance));
+    }
+
+    return SLANG_OK;
+}
+
+int main(int argc, char** argv)
+{
+    const SlangResult res = _innerMain(argc, argv);
+    return SLANG_SUCCEEDED(res) ? 0 : 1;
+}
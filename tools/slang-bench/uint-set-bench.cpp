@@ -0,0 +1,183 @@
+// uint-set-bench.cpp
+#include "uint-set-bench.h"
+
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-uint-set.h"
+
+#include <stdio.h>
+
+namespace SlangBench
+{
+using namespace Slang;
+
+namespace { // anonymous
+
+typedef UIntSet::Element Element;
+
+// Prevents the optimizer from removing work whose result is otherwise unused
+static volatile Index g_sink;
+
+static double _calcSeconds(uint64_t startTick)
+{
+    return double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+}
+
+    /// Time func over iterationCount runs, returning the best time
+template <typename F>
+static double _timeBest(Int iterationCount, const F& func)
+{
+    double best = 0.0;
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        const uint64_t startTick = ProcessUtil::getClockTick();
+        g_sink = func();
+        const double seconds = _calcSeconds(startTick);
+        best = (best == 0.0 || seconds < best) ? seconds : best;
+    }
+    return best;
+}
+
+    /// The same values as a `UIntSet`, and as elements that the element at a time loops work on
+struct BenchSet
+{
+    UIntSet set;
+    List<Element> elems;
+};
+
+static void _makeSet(DefaultRandomGenerator& randGen, Index size, int density, BenchSet& out)
+{
+    out.set.resizeAndClear(UInt(size));
+    out.elems.setCount((size + 31) / 32);
+    for (auto& elem : out.elems)
+    {
+        elem = 0;
+    }
+    for (Index i = 0; i < size; ++i)
+    {
+        if (randGen.nextInt32UpTo(1000) < density)
+        {
+            out.set.add(UInt(i));
+            out.elems[i >> 5] |= Element(1) << (i & 31);
+        }
+    }
+}
+
+static Index _countBits(Element v)
+{
+    Index count = 0;
+    for (; v; v &= v - 1)
+    {
+        count++;
+    }
+    return count;
+}
+
+static void _printRow(const char* name, double scalarSeconds, double seconds, Index bitCount)
+{
+    const double scalarNs = scalarSeconds * 1e9 * 1024.0 / double(bitCount);
+    const double ns = seconds * 1e9 * 1024.0 / double(bitCount);
+    printf("    %-10s %10.2f ns %10.2f ns %8.2fx\n", name, scalarNs, ns, (ns > 0.0) ? scalarNs / ns : 0.0);
+}
+
+static void _bench(DefaultRandomGenerator& randGen, Index size, int density, Int iterationCount)
+{
+    BenchSet a, b;
+    _makeSet(randGen, size, density, a);
+    _makeSet(randGen, size, density, b);
+
+    const Index count = a.elems.getCount();
+    List<Element> scalarOut;
+    scalarOut.setCount(count);
+    UIntSet out;
+
+    const double scalarUnion = _timeBest(iterationCount, [&]() {
+        for (Index i = 0; i < count; ++i)
+            scalarOut[i] = a.elems[i] | b.elems[i];
+        return count; });
+    const double setUnion = _timeBest(iterationCount, [&]() {
+        UIntSet::calcUnion(out, a.set, b.set);
+        return count; });
+
+    const double scalarIntersect = _timeBest(iterationCount, [&]() {
+        for (Index i = 0; i < count; ++i)
+            scalarOut[i] = a.elems[i] & b.elems[i];
+        return count; });
+    const double setIntersect = _timeBest(iterationCount, [&]() {
+        UIntSet::calcIntersection(out, a.set, b.set);
+        return count; });
+
+    const double scalarSubtract = _timeBest(iterationCount, [&]() {
+        for (Index i = 0; i < count; ++i)
+            scalarOut[i] = a.elems[i] & ~b.elems[i];
+        return count; });
+    const double setSubtract = _timeBest(iterationCount, [&]() {
+        UIntSet::calcSubtract(out, a.set, b.set);
+        return count; });
+
+    Index scalarValueCount = 0;
+    const double scalarCount = _timeBest(iterationCount, [&]() {
+        scalarValueCount = 0;
+        for (Index i = 0; i < count; ++i)
+            scalarValueCount += _countBits(a.elems[i]);
+        return scalarValueCount; });
+    const double setCount = _timeBest(iterationCount, [&]() {
+        return a.set.countValues(); });
+
+    // Visit each value, summing them
+    const double scalarVisit = _timeBest(iterationCount, [&]() {
+        Index sum = 0;
+        for (Index i = 0; i < count; ++i)
+        {
+            const Element v = a.elems[i];
+            if (!v)
+                continue;
+            for (Index bit = 0; bit < 32; ++bit)
+            {
+                if (v & (Element(1) << bit))
+                    sum += (i << 5) + bit;
+            }
+        }
+        return sum; });
+    const double setVisit = _timeBest(iterationCount, [&]() {
+        Index sum = 0;
+        for (auto v : a.set)
+            sum += Index(v);
+        return sum; });
+
+    if (a.set.countValues() != scalarValueCount)
+    {
+        printf("count of values doesn't match\n");
+    }
+
+    printf("%d bits, %.1f%% set (time per 1024 bits)\n", int(size), density / 10.0);
+    printf("    %-10s %13s %13s %9s\n", "", "scalar", "UIntSet", "speedup");
+    _printRow("union", scalarUnion, setUnion, size);
+    _printRow("intersect", scalarIntersect, setIntersect, size);
+    _printRow("subtract", scalarSubtract, setSubtract, size);
+    _printRow("count", scalarCount, setCount, size);
+    _printRow("visit", scalarVisit, setVisit, size);
+}
+
+} // anonymous
+
+SlangResult runUIntSetBench(Int iterationCount)
+{
+    DefaultRandomGenerator randGen(0x2c6e10f3);
+
+    printf("UIntSet SIMD: %s\n", UIntSet::isSimdAvailable() ? "yes" : "no");
+
+    // From the instructions of a function up to those of a large module, with the density of a
+    // live set, and of a sparse work list
+    const Index sizes[] = { 4096, 65536, 1048576 };
+    for (auto size : sizes)
+    {
+        _bench(randGen, size, 500, iterationCount);
+        _bench(randGen, size, 5, iterationCount);
+    }
+
+    return SLANG_OK;
+}
+
+}
@@ -0,0 +1,18 @@
+// uint-set-bench.h
+#ifndef SLANG_BENCH_UINT_SET_BENCH_H
+#define SLANG_BENCH_UINT_SET_BENCH_H
+
+#include "../../slang.h"
+#include "../../source/core/slang-common.h"
+
+namespace SlangBench
+{
+
+    /// Time the `UIntSet` bulk operations (union, intersection, subtraction, counting values and
+    /// visiting each value) against element at a time loops, for dense and sparse sets of a range of sizes.
+    /// The best time over iterationCount runs is reported.
+SlangResult runUIntSetBench(Slang::Int iterationCount);
+
+}
+
+#endif
@@ -620,6 +620,72 @@ static Index _findLineIndex(const List<UnownedStringSlice>& lineBreaks, const ch
     return lo;
 }
 
+// Consecutive text (including `#line` directives) is output as a single SLANG_RAW, holding a string literal per line.
+// The compiler joins the literals, so the stdlib is built with far fewer appends - and a C++ compiler has
+// far fewer statements to compile. Literals are joined up to this size, as compilers limit the size of a
+// string literal (MSVC to 64K bytes).
+static const size_t kMaxRawSize = 16 * 1024;
+
+struct RawEmitter
+{
+        /// Add the text to the current SLANG_RAW (starting one if needed)
+    void emitText(StringSpan const& span)
+    {
+        UnownedStringSlice content(span), line;
+        while (StringUtil::extractLine(content, line))
+        {
+            // Include the line break, if there is one
+            const bool hasLineBreak = content.begin() != nullptr && content.begin() != line.end();
+            if (line.size() == 0 && !hasLineBreak)
+            {
+                break;
+            }
+
+            // Start a new SLANG_RAW if the current one is full
+            if (m_isOpen && m_size + line.size() + 1 > kMaxRawSize)
+            {
+                end();
+            }
+            if (!m_isOpen)
+            {
+                fputs("SLANG_RAW(\n", m_stream);
+                m_isOpen = true;
+                m_size = 0;
+            }
+
+            fputs("\"", m_stream);
+            emitStringLiteralText(m_stream, line);
+            if (hasLineBreak)
+            {
+                fputs("\\n", m_stream);
+            }
+            fputs("\"\n", m_stream);
+
+            m_size += line.size() + 1;
+
+            if (content.begin() == nullptr || content.begin() == span.end())
+            {
+                break;
+            }
+        }
+    }
+        /// End the current SLANG_RAW (if there is one)
+    void end()
+    {
+        if (m_isOpen)
+        {
+            fputs(")\n", m_stream);
+            m_isOpen = false;
+        }
+    }
+
+    RawEmitter(FILE* stream) : m_stream(stream) {}
+
+    FILE* m_stream;
+    bool m_isOpen = false;
+    size_t m_size = 0;
+};
+
 void emitTemplateNodes(
     SourceFile* sourceFile,
     FILE*   stream,
@@ -629,6 +695,8 @@ void emitTemplateNodes(
     List<UnownedStringSlice> lineBreaks;
     StringUtil::calcLines(sourceFile->text, lineBreaks);
 
+    RawEmitter rawEmitter(stream);
+
     Node* prev = nullptr;
     for (auto nn = node; nn; prev = nn, nn = nn->next)
     {
@@ -642,31 +710,33 @@ void emitTemplateNodes(
             if (lineIndex >= 0)
             {
                 StringBuilder buf;
-                buf << "SLANG_RAW(\"#line " << (lineIndex + 1) << " \\\"" << sourceFile->inputPath << "\\\"\")\n";
+                // The text that follows starts with the line break
+                buf << "#line " << (lineIndex + 1) << " \"" << sourceFile->inputPath << "\"";
 
-                emit(stream, buf.getUnownedSlice());
+                rawEmitter.emitText(buf.getUnownedSlice());
             }
         }
 
         switch (nn->flavor)
         {
         case Node::Flavor::text:
-            emit(stream, "SLANG_RAW(\"");
-            emitStringLiteralText(stream, nn->span);
-            emit(stream, "\")\n");
+            rawEmitter.emitText(nn->span);
             break;
 
         case Node::Flavor::splice:
+            rawEmitter.end();
             emit(stream, "SLANG_SPLICE(");
             emitCodeNodes(stream, nn->body);
             emit(stream, ")\n");
             break;
 
         case Node::Flavor::escape:
+            rawEmitter.end();
             emitCodeNodes(stream, nn->body);
             break;
         }  
     }
+    rawEmitter.end();
 }
 
 void usage(char const* appName)
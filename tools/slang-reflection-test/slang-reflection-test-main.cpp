@@ -1,6 +1,7 @@
 // slang-reflection-test-main.cpp
 
 #include <assert.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,17 +10,49 @@
 #include <slang-com-helper.h>
 
 #include "../../source/core/slang-test-tool-util.h"
+#include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-writer.h"
 
+    /// Writes indented text to an ISlangWriter.
+    ///
+    /// Programs can have tens of thousands of parameters, so the text is gathered in a buffer, and only
+    /// written to the ISlangWriter in large blocks (and by `flush`).
 struct PrettyWriter
 {
+    enum { kFlushSize = 64 * 1024 };
+
     bool startOfLine = true;
     int indent = 0;
+
+    ISlangWriter* writer = nullptr;
+    Slang::List<char> buffer;
+    size_t writtenCount = 0;        ///< The total number of chars written
+
+    void flush()
+    {
+        if (buffer.getCount())
+        {
+            writer->write(buffer.getBuffer(), size_t(buffer.getCount()));
+            buffer.clear();
+        }
+    }
+
+    explicit PrettyWriter(ISlangWriter* inWriter):
+        writer(inWriter)
+    {
+    }
+    ~PrettyWriter() { flush(); }
 };
 
 static void writeRaw(PrettyWriter& writer, char const* begin, char const* end)
 {
     SLANG_ASSERT(end >= begin);
-    Slang::StdWriters::getOut().write(begin, size_t(end - begin));
+    writer.buffer.addRange(begin, Slang::Index(end - begin));
+    writer.writtenCount += size_t(end - begin);
+    if (writer.buffer.getCount() >= PrettyWriter::kFlushSize)
+    {
+        writer.flush();
+    }
 }
 
 static void writeRaw(PrettyWriter& writer, char const* begin)
@@ -27,12 +60,6 @@ static void writeRaw(PrettyWriter& writer, char const* begin)
     writeRaw(writer, begin, begin + strlen(begin));
 }
 
-static void writeRawChar(PrettyWriter& writer, int c)
-{
-    char buffer[] = { (char) c, 0 };
-    writeRaw(writer, buffer, buffer + 1);
-}
-
 static void adjust(PrettyWriter& writer)
 {
     if (!writer.startOfLine)
@@ -57,55 +84,78 @@ static void dedent(PrettyWriter& writer)
 
 static void write(PrettyWriter& writer, char const* text, size_t length = 0)
 {
-    // TODO: can do this more efficiently...
+    // Text is written a line at a time, as only the start of a line needs indenting. It ends at a
+    // terminating zero, or if length is set, before the last of the length chars.
+    char const* end = nullptr;
+    if (length)
+    {
+        char const* zero = (char const*)memchr(text, 0, length - 1);
+        end = zero ? zero : text + length - 1;
+    }
+    else
+    {
+        end = text + strlen(text);
+    }
     char const* cursor = text;
-    for(;;)
+    while (cursor < end)
     {
-        char c = *cursor++;
-        if (!c) break;
-        if (length && cursor - text == length) break;
-        if (c == '\n')
+        char const* lineEnd = (char const*)memchr(cursor, '\n', size_t(end - cursor));
+        if (!lineEnd)
         {
-            writer.startOfLine = true;
+            adjust(writer);
+            writeRaw(writer, cursor, end);
+            return;
         }
-        else
+
+        if (lineEnd != cursor)
         {
             adjust(writer);
         }
+        writeRaw(writer, cursor, lineEnd + 1);
+        writer.startOfLine = true;
+        cursor = lineEnd + 1;
+    }
+}
 
-        writeRawChar(writer, c);
+static void writeFormat(PrettyWriter& writer, char const* format, ...)
+{
+    adjust(writer);
+
+    char buffer[64];
+    va_list args;
+    va_start(args, format);
+    int count = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (count > 0)
+    {
+        writeRaw(writer, buffer, buffer + ((count < int(sizeof(buffer))) ? count : int(sizeof(buffer)) - 1));
     }
 }
 
 static void write(PrettyWriter& writer, uint64_t val)
 {
-    adjust(writer);
-    Slang::StdWriters::getOut().print("%llu", (unsigned long long)val);
+    writeFormat(writer, "%llu", (unsigned long long)val);
 }
 
 static void write(PrettyWriter& writer, int64_t val)
 {
-    adjust(writer);
-    Slang::StdWriters::getOut().print("%ll", (long long)val);
+    writeFormat(writer, "%lld", (long long)val);
 }
 
 static void write(PrettyWriter& writer, int32_t val)
 {
-    adjust(writer);
-    Slang::StdWriters::getOut().print("%d", int(val));
+    writeFormat(writer, "%d", int(val));
 }
 
 static void write(PrettyWriter& writer, uint32_t val)
 {
-    adjust(writer);
-    Slang::StdWriters::getOut().print("%u", (unsigned int)val);
+    writeFormat(writer, "%u", (unsigned int)val);
 }
 
 
 static void write(PrettyWriter& writer, float val)
 {
-    adjust(writer);
-    Slang::StdWriters::getOut().print("%f", val);
+    writeFormat(writer, "%f", val);
 }
 
 static void emitReflectionVarInfoJSON(PrettyWriter& writer, slang::VariableReflection* var);
@@ -1011,20 +1061,84 @@ static void emitReflectionJSON(
         dedent(writer);
         write(writer, "\n]");
     }
+
+    auto specConstantCount = programReflection->getSpecializationConstantCount();
+    if (specConstantCount)
+    {
+        write(writer, ",\n\"specializationConstants\": [\n");
+        indent(writer);
+        for (auto ss : range(specConstantCount))
+        {
+            if (ss != 0) write(writer, ",\n");
+
+            auto specConstant = programReflection->getSpecializationConstantByIndex(ss);
+            write(writer, "{\n");
+            indent(writer);
+            emitReflectionNameInfoJSON(writer, specConstant->getName());
+            write(writer, ",\n\"constantID\": ");
+            write(writer, programReflection->getSpecializationConstantID(ss));
+            write(writer, ",\n\"type\": ");
+            emitReflectionTypeJSON(writer, specConstant->getType());
+            write(writer, ",\n\"defaultValue\": ");
+            write(writer, programReflection->getSpecializationConstantDefaultValue(ss));
+            dedent(writer);
+            write(writer, "\n}");
+        }
+        dedent(writer);
+        write(writer, "\n]");
+    }
     dedent(writer);
     write(writer, "\n}\n");
 }
 
 void emitReflectionJSON(
-    SlangReflection*    reflection)
+    SlangReflection*    reflection,
+    ISlangWriter*       out)
 {
     auto programReflection = (slang::ShaderReflection*) reflection;
 
-    PrettyWriter writer;
+    PrettyWriter writer(out);
     
     emitReflectionJSON(writer, programReflection);
 }
 
+    /// Time emitting the JSON for reflection iterationCount times, and write the times (rather than the JSON) to out
+static void timeReflectionJSON(
+    SlangReflection*    reflection,
+    int                 iterationCount,
+    ISlangWriter*       out)
+{
+    using namespace Slang;
+
+    auto programReflection = (slang::ShaderReflection*) reflection;
+
+    // The JSON is discarded, so the time is that taken to traverse the reflection and format the JSON
+    NullWriter nullWriter(WriterFlag::IsStatic);
+
+    List<double> times;
+    size_t charCount = 0;
+    for (int i = 0; i < iterationCount; ++i)
+    {
+        const uint64_t startTick = ProcessUtil::getClockTick();
+        {
+            PrettyWriter writer(&nullWriter);
+            emitReflectionJSON(writer, programReflection);
+            charCount = writer.writtenCount;
+        }
+        times.add(double(ProcessUtil::getClockTick() - startTick) * 1000.0 / double(ProcessUtil::getClockFrequency()));
+    }
+    times.sort();
+
+    WriterHelper writer(out);
+    writer.print("{\n");
+    writer.print("    \"parameters\": %u,\n", (unsigned int)programReflection->getParameterCount());
+    writer.print("    \"iterations\": %d,\n", iterationCount);
+    writer.print("    \"chars\": %llu,\n", (unsigned long long)charCount);
+    writer.print("    \"minMs\": %.6f,\n", times[0]);
+    writer.print("    \"medianMs\": %.6f\n", times[times.getCount() / 2]);
+    writer.print("}\n");
+}
+
 static SlangResult maybeDumpDiagnostic(SlangResult res, SlangCompileRequest* request)
 {
     const char* diagnostic;
@@ -1046,14 +1160,40 @@ SLANG_TEST_TOOL_API SlangResult innerMain(Slang::StdWriters* stdWriters, SlangSe
     char const* appName = "slang-reflection-test";
     if (argc > 0) appName = argv[0];
 
-    SLANG_RETURN_ON_FAIL(maybeDumpDiagnostic(spProcessCommandLineArguments(request, &argv[1], argc - 1), request));
+    // `-reflection-timing <iterations>` is handled here, and every other option is passed to Slang
+    int timingIterationCount = 0;
+    Slang::List<char const*> slangArgs;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-reflection-timing") == 0)
+        {
+            timingIterationCount = (i + 1 < argc) ? atoi(argv[++i]) : 0;
+            if (timingIterationCount <= 0)
+            {
+                Slang::StdWriters::getError().print("%s: expected a positive iteration count for '-reflection-timing'\n", appName);
+                spDestroyCompileRequest(request);
+                return SLANG_FAIL;
+            }
+            continue;
+        }
+        slangArgs.add(argv[i]);
+    }
+
+    SLANG_RETURN_ON_FAIL(maybeDumpDiagnostic(spProcessCommandLineArguments(request, slangArgs.getBuffer(), int(slangArgs.getCount())), request));
     SLANG_RETURN_ON_FAIL(maybeDumpDiagnostic(spCompile(request), request));
 
     // Okay, let's go through and emit reflection info on whatever
     // we have.
 
     SlangReflection* reflection = spGetReflection(request);
-    emitReflectionJSON(reflection);
+    if (timingIterationCount)
+    {
+        timeReflectionJSON(reflection, timingIterationCount, stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    }
+    else
+    {
+        emitReflectionJSON(reflection, stdWriters->getWriter(SLANG_WRITER_CHANNEL_STD_OUTPUT));
+    }
 
     spDestroyCompileRequest(request);
     
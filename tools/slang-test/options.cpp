@@ -178,6 +178,89 @@ static bool _isSubCommand(const char* arg)
             }
             optionsOut->adapter = *argCursor++;
         }
+        else if (strcmp(arg, "-j") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            const char* countText = *argCursor++;
+            char* countEnd = nullptr;
+            const long jobCount = strtol(countText, &countEnd, 10);
+            if (countEnd == countText || *countEnd != 0 || jobCount < 1)
+            {
+                stdError.print("error: expected a job count of at least 1 for '%s', got '%s'\n", arg, countText);
+                return SLANG_FAIL;
+            }
+            optionsOut->jobCount = Index(jobCount);
+        }
+        else if (strcmp(arg, "-shard") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            // In the form i/n, where i is from 1 to n
+            const char* shardText = *argCursor++;
+            char* indexEnd = nullptr;
+            const long shardIndex = strtol(shardText, &indexEnd, 10);
+            char* countEnd = indexEnd;
+            const long shardCount = (*indexEnd == '/') ? strtol(indexEnd + 1, &countEnd, 10) : 0;
+            if (indexEnd == shardText || *indexEnd != '/' || countEnd == indexEnd + 1 || *countEnd != 0 ||
+                shardCount < 1 || shardIndex < 1 || shardIndex > shardCount)
+            {
+                stdError.print("error: expected a shard in the form i/n (such as 1/4) for '%s', got '%s'\n", arg, shardText);
+                return SLANG_FAIL;
+            }
+            optionsOut->shardIndex = Index(shardIndex - 1);
+            optionsOut->shardCount = Index(shardCount);
+        }
+        else if (strcmp(arg, "-timing-file") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->timingFilePath = *argCursor++;
+        }
+        else if (strcmp(arg, "-reference-cache") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->referenceCachePath = *argCursor++;
+        }
+        else if (strcmp(arg, "-test-index") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            optionsOut->testIndexPath = *argCursor++;
+        }
+        else if (strcmp(arg, "-perf-tolerance") == 0)
+        {
+            if (argCursor == argEnd)
+            {
+                stdError.print("error: expected operand for '%s'\n", arg);
+                return SLANG_FAIL;
+            }
+            const char* toleranceText = *argCursor++;
+            char* toleranceEnd = nullptr;
+            const double tolerance = strtod(toleranceText, &toleranceEnd);
+            if (toleranceEnd == toleranceText || *toleranceEnd != 0 || tolerance < 0.0)
+            {
+                stdError.print("error: expected a tolerance of 0 or more (such as 0.1 for 10%%) for '%s', got '%s'\n", arg, toleranceText);
+                return SLANG_FAIL;
+            }
+            optionsOut->perfTolerance = tolerance;
+        }
         else if (strcmp(arg, "-appveyor") == 0)
         {
             optionsOut->outputMode = TestOutputMode::AppVeyor;
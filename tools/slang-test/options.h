@@ -89,6 +89,31 @@ struct Options
     // The adapter to use. If empty will match first found adapter.
     Slang::String adapter;
 
+    // The number of test files to run at the same time. Tests that use render-test (and so the GPU) are still
+    // run one at a time.
+    Slang::Index jobCount = 1;
+
+    // The test files are split into shardCount shards (balanced by the times in the timing file), and just
+    // the files of shard shardIndex are run. shardIndex is 0 based, although it is 1 based on the command line.
+    Slang::Index shardIndex = 0;
+    Slang::Index shardCount = 1;
+
+    // If set, times to run test files are read from this file (to balance shards, and run slow files first), and
+    // updated with the times of this run
+    Slang::String timingFilePath;
+
+    // If set, the output of reference compilers (such as fxc or glslang, that slang's output is compared against) is
+    // held in this directory, so they aren't run again for unchanged tests
+    Slang::String referenceCachePath;
+
+    // If set, the tests found in each test file are held in this file, so that only changed files are read and
+    // parsed for tests in later runs
+    Slang::String testIndexPath;
+
+    // The fraction a measurement of a performance test can exceed its baseline by before the test fails, for
+    // measurements where the baseline doesn't give a tolerance
+    double perfTolerance = 0.1;
+
         /// Parse the args, report any errors into stdError, and write the results into optionsOut
     static SlangResult parse(int argc, char** argv, TestCategorySet* categorySet, Slang::WriterHelper stdError, Options* optionsOut);
 };
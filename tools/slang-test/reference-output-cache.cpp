@@ -0,0 +1,269 @@
+// reference-output-cache.cpp
+
+#define _CRT_SECURE_NO_WARNINGS 1
+
+#include "reference-output-cache.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-hash.h"
+#include "../../source/core/slang-platform.h"
+#include "../../source/core/slang-string-util.h"
+
+#include <stdio.h>
+
+using namespace Slang;
+
+// Increment if the layout of entry files, or what goes into keys, changes
+static const char kEntryHeader[] = "slang-test reference output 1\n";
+
+static SlangResult _readFile(const String& path, String& outContents)
+{
+    FILE* file = fopen(path.getBuffer(), "rb");
+    if (!file)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    StringBuilder builder;
+    char buffer[4096];
+    size_t readSize;
+    while ((readSize = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    {
+        builder.Append(buffer, readSize);
+    }
+    fclose(file);
+
+    outContents = builder;
+    return SLANG_OK;
+}
+
+static SlangResult _writeFile(const String& path, const String& contents)
+{
+    // Write to a temporary file first and then move it into place, so that other
+    // runs never see a partially written file.
+    StringBuilder tempPath;
+    tempPath << path << ".tmp";
+
+    FILE* file = fopen(tempPath.getBuffer(), "wb");
+    if (!file)
+    {
+        return SLANG_FAIL;
+    }
+    const size_t size = size_t(contents.getLength());
+    const bool written = (size == 0 || fwrite(contents.getBuffer(), size, 1, file) == 1);
+    fclose(file);
+
+    if (!written)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+
+#ifdef _WIN32
+    // `rename` on Windows fails if the destination exists
+    File::remove(path);
+#endif
+    if (rename(tempPath.getBuffer(), path.getBuffer()) != 0)
+    {
+        File::remove(tempPath);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+static void _appendLengthPrefixed(const String& value, StringBuilder& out)
+{
+    out << value.getLength() << "\n" << value;
+}
+
+static SlangResult _readLengthPrefixed(UnownedStringSlice& ioRemaining, String& outValue)
+{
+    const Index lineEnd = ioRemaining.indexOf('\n');
+    Int length = 0;
+    if (lineEnd <= 0 || SLANG_FAILED(StringUtil::parseInt(UnownedStringSlice(ioRemaining.begin(), ioRemaining.begin() + lineEnd), length)) ||
+        length < 0 || length > Int(ioRemaining.size() - (lineEnd + 1)))
+    {
+        return SLANG_FAIL;
+    }
+    const char* start = ioRemaining.begin() + lineEnd + 1;
+    outValue = UnownedStringSlice(start, start + length);
+    ioRemaining = UnownedStringSlice(start + length, ioRemaining.end());
+    return SLANG_OK;
+}
+
+static void _appendSourceFile(const String& path, StringBuilder& ioKey, List<String>& ioVisited)
+{
+    if (ioVisited.indexOf(path) >= 0)
+    {
+        return;
+    }
+    ioVisited.add(path);
+
+    String contents;
+    try
+    {
+        contents = File::readAllText(path);
+    }
+    catch (const IOException&)
+    {
+        // Missing files are part of the key too, as the output will be an error
+        ioKey << "source " << path << " missing\n";
+        return;
+    }
+    ioKey << "source " << path << " " << getHashCode64(contents.getBuffer(), size_t(contents.getLength())) << "\n";
+
+    // Follow includes, which are found relative to the including file
+    const String parentDirectory = Path::getParentDirectory(path);
+    for (auto line : LineParser(contents.getUnownedSlice()))
+    {
+        const UnownedStringSlice trimmed = line.trim();
+        if (!trimmed.startsWith(UnownedStringSlice::fromLiteral("#")))
+        {
+            continue;
+        }
+        const UnownedStringSlice directive = UnownedStringSlice(trimmed.begin() + 1, trimmed.end()).trim();
+        if (!directive.startsWith(UnownedStringSlice::fromLiteral("include")))
+        {
+            continue;
+        }
+
+        const Index nameStart = directive.indexOf('"');
+        if (nameStart < 0)
+        {
+            continue;
+        }
+        const UnownedStringSlice rest(directive.begin() + nameStart + 1, directive.end());
+        const Index nameEnd = rest.indexOf('"');
+        if (nameEnd <= 0)
+        {
+            continue;
+        }
+        const String includeName = UnownedStringSlice(rest.begin(), rest.begin() + nameEnd);
+        _appendSourceFile(Path::combine(parentDirectory, includeName), ioKey, ioVisited);
+    }
+}
+
+static const char* _getPassThroughLibraryName(const String& passThrough)
+{
+    if (passThrough == "fxc")
+    {
+        return "d3dcompiler_47";
+    }
+    else if (passThrough == "dxc")
+    {
+        return "dxcompiler";
+    }
+    else if (passThrough == "glslang")
+    {
+        return "slang-glslang";
+    }
+    return nullptr;
+}
+
+const String& ReferenceOutputCache::_getLibraryIdentity(const String& binDir, const String& libraryName)
+{
+    const String libraryPath = SharedLibrary::calcPlatformPath(Path::combine(binDir, libraryName).getUnownedSlice());
+    if (const String* identityPtr = m_libraryIdentities.TryGetValue(libraryPath))
+    {
+        return *identityPtr;
+    }
+
+    StringBuilder builder;
+    builder << libraryName;
+
+    int64_t size = 0;
+    int64_t modifiedTime = 0;
+    if (SLANG_SUCCEEDED(File::getSizeAndModifiedTime(libraryPath, size, modifiedTime)))
+    {
+        builder << " " << size << " " << modifiedTime;
+    }
+    // Otherwise it's loaded from somewhere else on the system, so there is just the name
+
+    m_libraryIdentities.Add(libraryPath, builder);
+    return *m_libraryIdentities.TryGetValue(libraryPath);
+}
+
+String ReferenceOutputCache::calcKey(const String& binDir, const CommandLine& cmdLine, const String& passThrough, const String& referenceSourcePath)
+{
+    StringBuilder key;
+    key << kEntryHeader;
+    key << ProcessUtil::getCommandLineString(cmdLine) << "\n";
+
+    key << _getLibraryIdentity(binDir, "slang") << "\n";
+    if (const char* libraryName = _getPassThroughLibraryName(passThrough))
+    {
+        key << _getLibraryIdentity(binDir, libraryName) << "\n";
+    }
+
+    List<String> visited;
+    _appendSourceFile(referenceSourcePath, key, visited);
+
+    return key;
+}
+
+String ReferenceOutputCache::_getEntryPath(const String& key) const
+{
+    const uint64_t hash = getHashCode64(key.getBuffer(), size_t(key.getLength()));
+
+    char name[17];
+    for (int i = 0; i < 16; ++i)
+    {
+        name[i] = "0123456789abcdef"[(hash >> (60 - i * 4)) & 0xf];
+    }
+    name[16] = 0;
+
+    StringBuilder builder;
+    builder << name << ".reference";
+    return Path::combine(m_directory, builder);
+}
+
+bool ReferenceOutputCache::find(const String& key, ExecuteResult& outResult) const
+{
+    if (!isEnabled())
+    {
+        return false;
+    }
+
+    String contents;
+    if (SLANG_FAILED(_readFile(_getEntryPath(key), contents)))
+    {
+        return false;
+    }
+
+    UnownedStringSlice remaining = contents.getUnownedSlice();
+    String entryKey, resultCodeText, standardOutput, standardError;
+    Int resultCode = 0;
+    if (SLANG_FAILED(_readLengthPrefixed(remaining, entryKey)) || entryKey != key ||
+        SLANG_FAILED(_readLengthPrefixed(remaining, resultCodeText)) ||
+        SLANG_FAILED(StringUtil::parseInt(resultCodeText.getUnownedSlice(), resultCode)) ||
+        SLANG_FAILED(_readLengthPrefixed(remaining, standardOutput)) ||
+        SLANG_FAILED(_readLengthPrefixed(remaining, standardError)))
+    {
+        // Not an entry, or an entry for a different key with the same hash
+        return false;
+    }
+
+    outResult.resultCode = ExecuteResult::ResultCode(resultCode);
+    outResult.standardOutput = standardOutput;
+    outResult.standardError = standardError;
+
+    m_hitCount++;
+    return true;
+}
+
+SlangResult ReferenceOutputCache::add(const String& key, const ExecuteResult& result) const
+{
+    if (!isEnabled())
+    {
+        return SLANG_OK;
+    }
+
+    StringBuilder contents;
+    _appendLengthPrefixed(key, contents);
+    _appendLengthPrefixed(String(Int(result.resultCode)), contents);
+    _appendLengthPrefixed(result.standardOutput, contents);
+    _appendLengthPrefixed(result.standardError, contents);
+
+    Path::createDirectory(m_directory);
+    return _writeFile(_getEntryPath(key), contents);
+}
@@ -0,0 +1,55 @@
+// reference-output-cache.h
+
+#ifndef REFERENCE_OUTPUT_CACHE_H_INCLUDED
+#define REFERENCE_OUTPUT_CACHE_H_INCLUDED
+
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-process-util.h"
+
+/* ReferenceOutputCache holds the output of running a reference compiler (such as fxc, dxc or glslang through slangc's
+-pass-through), which is what many tests compare the output of slang against. The reference output only changes if
+the reference source, the command line or the compilers change - so for an unchanged test there is no need to run the
+reference compiler again.
+
+Outputs are held in files in a directory, so are found by later runs. The key for an output covers
+* The command line
+* The contents of the reference source, and any files it includes (found by looking for #include "...")
+* The size and modification time of the slang shared library, and the shared library of the reference compiler if it
+is found in the bin directory
+
+Only runs where the tool actually ran are held - if the compiler wasn't available or couldn't be started the result
+isn't cached. */
+class ReferenceOutputCache
+{
+public:
+        /// Set the directory outputs are held in. If empty the cache is disabled.
+    void setDirectory(const Slang::String& directory) { m_directory = directory; }
+        /// Get the directory
+    const Slang::String& getDirectory() const { return m_directory; }
+        /// True if outputs are cached
+    bool isEnabled() const { return m_directory.getLength() > 0; }
+
+        /// Calculate the key for running cmdLine, where the reference compiler reads referenceSourcePath.
+        /// passThrough is the name of the reference compiler as passed to -pass-through (eg "fxc").
+    Slang::String calcKey(const Slang::String& binDir, const Slang::CommandLine& cmdLine, const Slang::String& passThrough, const Slang::String& referenceSourcePath);
+
+        /// Find the output for key. Returns false if not found.
+    bool find(const Slang::String& key, Slang::ExecuteResult& outResult) const;
+        /// Add the output for key
+    SlangResult add(const Slang::String& key, const Slang::ExecuteResult& result) const;
+
+        /// The number of outputs found in the cache
+    Slang::Index getHitCount() const { return m_hitCount; }
+
+protected:
+    Slang::String _getEntryPath(const Slang::String& key) const;
+    const Slang::String& _getLibraryIdentity(const Slang::String& binDir, const Slang::String& libraryName);
+
+    Slang::String m_directory;
+    Slang::Dictionary<Slang::String, Slang::String> m_libraryIdentities;     ///< Identity text, keyed by library path
+
+    mutable Slang::Index m_hitCount = 0;
+};
+
+#endif // REFERENCE_OUTPUT_CACHE_H_INCLUDED
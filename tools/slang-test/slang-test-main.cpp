@@ -14,6 +14,7 @@ using namespace Slang;
 #include "os.h"
 #include "../../source/core/slang-render-api-util.h"
 #include "test-context.h"
+#include "test-discovery-index.h"
 #include "test-reporter.h"
 #include "options.h"
 #include "slangc-tool.h"
@@ -21,6 +22,7 @@ using namespace Slang;
 #include "../../source/core/slang-cpp-compiler.h"
 
 #include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-thread-pool.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "external/stb/stb_image.h"
@@ -38,6 +40,7 @@ struct TestOptions
     {
         Normal,             ///< A regular test
         Diagnostic,         ///< Diagnostic tests will always run (as form of failure is being tested)  
+        Perf,               ///< Performance tests measure a compile, and fail if it is slower (or uses more memory) than a baseline
     };
 
     Type type = Type::Normal;
@@ -186,9 +189,8 @@ String collectRestOfLine(char const** ioCursor)
 
 
 static TestResult _gatherTestOptions(
-    TestCategorySet*    categorySet, 
-    char const**    ioCursor,
-    TestOptions&    outOptions)
+    char const**                ioCursor,
+    TestDiscoveryIndex::Test&   outTest)
 {
     char const* cursor = *ioCursor;
 
@@ -214,16 +216,8 @@ static TestResult _gatherTestOptions(
                     char const* categoryEnd = cursor;
                     cursor++;
 
-                    auto categoryName = getString(categoryStart, categoryEnd);
-                    TestCategory* category = categorySet->find(categoryName);
-
-                    if(!category)
-                    {
-                        return TestResult::Fail;
-                    }
-                    
-
-                    outOptions.categories.add(category);
+                    // The category is looked up when the test is used
+                    outTest.categoryNames.add(getString(categoryStart, categoryEnd));
 
                     if( *categoryEnd == ',' )
                     {
@@ -242,12 +236,6 @@ static TestResult _gatherTestOptions(
         }
     }
 
-    // If no categories were specified, then add the default category
-    if(outOptions.categories.getCount() == 0)
-    {
-        outOptions.categories.add(categorySet->defaultCategory);
-    }
-
     if(*cursor == ':')
         cursor++;
     else
@@ -276,7 +264,7 @@ static TestResult _gatherTestOptions(
     }
     char const* commandEnd = cursor;
 
-    outOptions.command = getString(commandStart, commandEnd);
+    outTest.command = getString(commandStart, commandEnd);
 
     if(*cursor == ':')
         cursor++;
@@ -297,6 +285,7 @@ static TestResult _gatherTestOptions(
         {
         case 0: case '\r': case '\n':
             skipToEndOfLine(&cursor);
+            *ioCursor = cursor;
             return TestResult::Pass;
 
         default:
@@ -322,27 +311,13 @@ static TestResult _gatherTestOptions(
         char const* argEnd = cursor;
         assert(argBegin != argEnd);
 
-        outOptions.args.add(getString(argBegin, argEnd));
+        outTest.args.add(getString(argBegin, argEnd));
     }
 }
 
-// Try to read command-line options from the test file itself
-TestResult gatherTestsForFile(
-    TestCategorySet*    categorySet,
-    String				filePath,
-    FileTestList*       testList)
+// Read the test directives from the contents of a test file
+static void _parseTestsInFile(const String& fileContents, TestDiscoveryIndex::FileTests& outTests)
 {
-    String fileContents;
-    try
-    {
-        fileContents = Slang::File::readAllText(filePath);
-    }
-    catch (Slang::IOException)
-    {
-        return TestResult::Fail;
-    }
-
-
     // Walk through the lines of the file, looking for test commands
     char const* cursor = fileContents.begin();
 
@@ -353,37 +328,103 @@ TestResult gatherTestsForFile(
         skipHorizontalSpace(&cursor);
 
         // Look for a pattern that matches what we want
+        TestOptions::Type type = TestOptions::Type::Normal;
         if(match(&cursor, "//TEST_IGNORE_FILE"))
         {
-            return TestResult::Ignored;
+            outTests.result = TestResult::Ignored;
+            return;
         }
         else if(match(&cursor, "//TEST"))
         {
-            TestDetails testDetails;
-
-            if(_gatherTestOptions(categorySet, &cursor, testDetails.options) != TestResult::Pass)
-                return TestResult::Fail;
-
-            testList->tests.add(testDetails);
+            type = TestOptions::Type::Normal;
         }
         else if (match(&cursor, "//DIAGNOSTIC_TEST"))
         {
-            TestDetails testDetails;
-            
-            if (_gatherTestOptions(categorySet, &cursor, testDetails.options) != TestResult::Pass)
-                return TestResult::Fail;
-
-            // Mark that it is a diagnostic test
-            testDetails.options.type = TestOptions::Type::Diagnostic;
-            testList->tests.add(testDetails);
+            // Diagnostic tests always run (as a form of failure is being tested)
+            type = TestOptions::Type::Diagnostic;
+        }
+        else if (match(&cursor, "//PERF"))
+        {
+            type = TestOptions::Type::Perf;
         }
         else
         {
             skipToEndOfLine(&cursor);
+            continue;
+        }
+
+        TestDiscoveryIndex::Test test;
+        test.type = int(type);
+        if (_gatherTestOptions(&cursor, test) != TestResult::Pass)
+        {
+            outTests.result = TestResult::Fail;
+            return;
         }
+        outTests.tests.add(test);
     }
+}
 
-    return TestResult::Pass;
+// Try to read command-line options from the test file itself. If there is an index, the tests
+// are taken from it if the file hasn't changed.
+TestResult gatherTestsForFile(
+    TestCategorySet*    categorySet,
+    TestDiscoveryIndex* index,
+    String				filePath,
+    FileTestList*       testList)
+{
+    TestDiscoveryIndex::FileTests fileTests;
+    if (!index || !index->find(filePath, fileTests))
+    {
+        String fileContents;
+        try
+        {
+            fileContents = Slang::File::readAllText(filePath);
+        }
+        catch (Slang::IOException)
+        {
+            return TestResult::Fail;
+        }
+
+        _parseTestsInFile(fileContents, fileTests);
+        if (index)
+        {
+            index->add(filePath, fileTests);
+        }
+    }
+
+    if (fileTests.result == TestResult::Ignored)
+    {
+        return TestResult::Ignored;
+    }
+
+    // If a directive couldn't be parsed, the tests before it are still listed
+    for (const auto& test : fileTests.tests)
+    {
+        TestDetails testDetails;
+        TestOptions& options = testDetails.options;
+        options.type = TestOptions::Type(test.type);
+        options.command = test.command;
+        options.args = test.args;
+
+        for (const auto& categoryName : test.categoryNames)
+        {
+            TestCategory* category = categorySet->find(categoryName);
+            if (!category)
+            {
+                return TestResult::Fail;
+            }
+            options.categories.add(category);
+        }
+        // If no categories were specified, then add the default category
+        if (options.categories.getCount() == 0)
+        {
+            options.categories.add(categorySet->defaultCategory);
+        }
+
+        testList->tests.add(testDetails);
+    }
+
+    return fileTests.result;
 }
 
 Result spawnAndWaitExe(TestContext* context, const String& testPath, const CommandLine& cmdLine, ExecuteResult& outRes)
@@ -456,8 +497,14 @@ Result spawnAndWaitSharedLibrary(TestContext* context, const String& testPath, c
             args.add(cmdLine.m_args[i].value.getBuffer());
         }
 
-        SlangResult res = func(&stdWriters, context->getSession(), int(args.getCount()), args.begin());
+        // The session is shared by all tests, so undo any change a test makes to it (such as slangc's
+        // -dxc-path etc options setting the shared library loader), so it doesn't affect later tests
+        SlangSession* session = context->getSession();
+        ComPtr<ISlangSharedLibraryLoader> prevLoader(spSessionGetSharedLibraryLoader(session));
+
+        SlangResult res = func(&stdWriters, session, int(args.getCount()), args.begin());
 
+        spSessionSetSharedLibraryLoader(session, prevLoader);
         StdWriters::setSingleton(prevStdWriters);
 
         outRes.standardError = stdErrorString;
@@ -810,6 +857,13 @@ ToolReturnCode spawnAndWait(TestContext* context, const String& testPath, SpawnT
 
     const auto& options = context->options;
 
+    // Render tests run one at a time, even if test files are being run in parallel
+    std::unique_lock<std::mutex> renderTestLock;
+    if (context->renderTestMutex && Path::getFileNameWithoutExt(cmdLine.m_executable) == "render-test")
+    {
+        renderTestLock = std::unique_lock<std::mutex>(*context->renderTestMutex);
+    }
+
     SlangResult spawnResult = SLANG_FAIL;
     switch (spawnType)
     {
@@ -892,6 +946,34 @@ String findExpectedPath(const TestInput& input, const char* postFix)
     return "";
 }
 
+/* Run cmdLine, which runs a reference compiler (passThrough is the name given to -pass-through) on referenceSourcePath.
+If the context has a reference output cache, and nothing the output depends on has changed, the output is taken from
+the cache rather than running the compiler again. */
+static ToolReturnCode _spawnAndWaitReference(TestContext* context, const String& testPath, SpawnType spawnType, const CommandLine& cmdLine,
+    const String& passThrough, const String& referenceSourcePath, ExecuteResult& outExeRes)
+{
+    auto& cache = context->referenceOutputCache;
+    if (context->isCollectingRequirements() || !cache.isEnabled() || referenceSourcePath.getLength() == 0)
+    {
+        return spawnAndWait(context, testPath, spawnType, cmdLine, outExeRes);
+    }
+
+    const String key = cache.calcKey(context->options.binDir, cmdLine, passThrough, referenceSourcePath);
+    if (cache.find(key, outExeRes))
+    {
+        context->reporter->messageFormat(TestMessageType::Info, "reference output for '%s' found in cache\n", referenceSourcePath.getBuffer());
+        return getReturnCode(outExeRes);
+    }
+
+    const ToolReturnCode returnCode = spawnAndWait(context, testPath, spawnType, cmdLine, outExeRes);
+    // Only hold the output if the compiler actually ran
+    if (!TestToolUtil::isDone(returnCode))
+    {
+        cache.add(key, outExeRes);
+    }
+    return returnCode;
+}
+
 static void _initSlangCompiler(TestContext* context, CommandLine& ioCmdLine)
 {
     ioCmdLine.setExecutablePath(Path::combine(context->options.binDir, String("slangc") + ProcessUtil::getExecutableSuffix()));
@@ -1342,6 +1424,9 @@ TestResult runCrossCompilerTest(TestContext* context, TestInput& input)
     
     actualCmdLine.addArg(filePath);
 
+    String passThrough;
+    String referenceSourcePath;
+
     // TODO(JS): This should no longer be needed with TestInfo accumulated for a test
 
     const auto& args = input.testOptions->args;
@@ -1361,26 +1446,27 @@ TestResult runCrossCompilerTest(TestContext* context, TestInput& input)
         {
             case SLANG_DXIL_ASM:
             {
-                expectedCmdLine.addArg(filePath + ".hlsl");
-                expectedCmdLine.addArg("-pass-through");
-                expectedCmdLine.addArg("dxc");
+                referenceSourcePath = filePath + ".hlsl";
+                passThrough = "dxc";
                 break;
             }
             case SLANG_DXBC_ASM:
             {
-                expectedCmdLine.addArg(filePath + ".hlsl");
-                expectedCmdLine.addArg("-pass-through");
-                expectedCmdLine.addArg("fxc");
+                referenceSourcePath = filePath + ".hlsl";
+                passThrough = "fxc";
                 break;
             }
             default:
             {
-                expectedCmdLine.addArg(filePath + ".glsl");
-                expectedCmdLine.addArg("-pass-through");
-                expectedCmdLine.addArg("glslang");
+                referenceSourcePath = filePath + ".glsl";
+                passThrough = "glslang";
                 break;
             }
         }
+
+        expectedCmdLine.addArg(referenceSourcePath);
+        expectedCmdLine.addArg("-pass-through");
+        expectedCmdLine.addArg(passThrough);
     }
    
     for( auto arg : input.testOptions->args )
@@ -1390,7 +1476,7 @@ TestResult runCrossCompilerTest(TestContext* context, TestInput& input)
     }
 
     ExecuteResult expectedExeRes;
-    TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, expectedCmdLine, expectedExeRes));
+    TEST_RETURN_ON_DONE(_spawnAndWaitReference(context, outputStem, input.spawnType, expectedCmdLine, passThrough, referenceSourcePath, expectedExeRes));
 
     String expectedOutput;
     if (context->isExecuting())
@@ -1469,7 +1555,7 @@ TestResult generateHLSLBaseline(TestContext* context, TestInput& input)
     cmdLine.addArg("fxc");
 
     ExecuteResult exeRes;
-    TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, cmdLine, exeRes));
+    TEST_RETURN_ON_DONE(_spawnAndWaitReference(context, outputStem, input.spawnType, cmdLine, "fxc", filePath999, exeRes));
 
     if (context->isCollectingRequirements())
     {
@@ -1630,8 +1716,9 @@ TestResult doGLSLComparisonTestRun(TestContext* context,
         cmdLine.addArg(arg);
     }
 
+    // Only the pass through run is of the reference compiler
     ExecuteResult exeRes;
-    TEST_RETURN_ON_DONE(spawnAndWait(context, outputStem, input.spawnType, cmdLine, exeRes));
+    TEST_RETURN_ON_DONE(_spawnAndWaitReference(context, outputStem, input.spawnType, cmdLine, passThrough ? passThrough : "", passThrough ? filePath999 : String(), exeRes));
 
     if (context->isCollectingRequirements())
     {
@@ -2105,6 +2192,300 @@ TestResult runHLSLAndGLSLRenderComparisonTest(TestContext* context, TestInput& i
     return runHLSLRenderComparisonTestImpl(context, input, "-hlsl-rewrite", "-glsl-rewrite");
 }
 
+// Performance tests
+
+    /// Set the metric name in ioMetrics to value. If it's already set, keeps the smaller value if keepMin is set, otherwise the larger.
+static void _setPerfMetric(List<TestReporter::Metric>& ioMetrics, const String& name, double value, bool keepMin)
+{
+    for (auto& metric : ioMetrics)
+    {
+        if (metric.name == name)
+        {
+            metric.value = keepMin ? Math::Min(metric.value, value) : Math::Max(metric.value, value);
+            return;
+        }
+    }
+    TestReporter::Metric metric;
+    metric.name = name;
+    metric.value = value;
+    ioMetrics.add(metric);
+}
+
+    /// Compile the file once in process, with profiling enabled, and update ioMetrics with the measurements.
+    /// Times are in milliseconds, and the best time of all the compiles is kept. Memory is in bytes, and the largest is kept.
+static SlangResult _compileForPerfTest(TestContext* context, const String& filePath, const List<String>& args, List<TestReporter::Metric>& ioMetrics, String& outDiagnostics)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(context->getSession());
+
+    List<const char*> argPtrs;
+    argPtrs.add(filePath.getBuffer());
+    for (const auto& arg : args)
+    {
+        argPtrs.add(arg.getBuffer());
+    }
+
+    SlangResult res = spProcessCommandLineArguments(request, argPtrs.getBuffer(), int(argPtrs.getCount()));
+
+    const uint64_t startTick = ProcessUtil::getClockTick();
+    if (SLANG_SUCCEEDED(res))
+    {
+        spSetProfilingEnabled(request, 1);
+        res = spCompile(request);
+    }
+    const double totalTime = double(ProcessUtil::getClockTick() - startTick) * 1000.0 / double(ProcessUtil::getClockFrequency());
+
+    if (SLANG_FAILED(res))
+    {
+        const char* diagnostics = spGetDiagnosticOutput(request);
+        outDiagnostics = diagnostics ? diagnostics : "";
+        spDestroyCompileRequest(request);
+        return res;
+    }
+
+    // Phases can be run more than once in a compile (for example an IR pass is run for each entry point),
+    // so sum the time of each phase in this compile before comparing against other compiles
+    List<TestReporter::Metric> phaseTimes;
+
+    SlangInt irPeakBytes = -1;
+    SlangInt astPeakBytes = -1;
+
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_FAILED(spGetProfileEvent(request, i, &event)))
+        {
+            continue;
+        }
+
+        StringBuilder name;
+        name << "time." << event.category << "." << event.name;
+
+        bool found = false;
+        for (auto& phaseTime : phaseTimes)
+        {
+            if (phaseTime.name == name)
+            {
+                phaseTime.value += event.durationInSeconds * 1000.0;
+                found = true;
+                break;
+            }
+        }
+        if (!found)
+        {
+            TestReporter::Metric phaseTime;
+            phaseTime.name = name;
+            phaseTime.value = event.durationInSeconds * 1000.0;
+            phaseTimes.add(phaseTime);
+        }
+
+        irPeakBytes = Math::Max(irPeakBytes, Math::Max(event.memoryBefore, event.memoryAfter));
+        astPeakBytes = Math::Max(astPeakBytes, Math::Max(event.astPeakBytesBefore, event.astPeakBytesAfter));
+    }
+
+    spDestroyCompileRequest(request);
+
+    _setPerfMetric(ioMetrics, "time.total", totalTime, true);
+    for (const auto& phaseTime : phaseTimes)
+    {
+        _setPerfMetric(ioMetrics, phaseTime.name, phaseTime.value, true);
+    }
+    if (irPeakBytes >= 0)
+    {
+        _setPerfMetric(ioMetrics, "memory.ir-peak-bytes", double(irPeakBytes), false);
+    }
+    if (astPeakBytes >= 0)
+    {
+        _setPerfMetric(ioMetrics, "memory.ast-peak-bytes", double(astPeakBytes), false);
+    }
+    return SLANG_OK;
+}
+
+struct PerfBaselineEntry
+{
+    String name;
+    double value;
+    double tolerance;               ///< The fraction the value can be exceeded by, or -1 to use the -perf-tolerance option
+};
+
+    /// Parse a baseline, where each line is 'name value [tolerance]'. Blank lines, and lines starting with # are ignored.
+static SlangResult _parsePerfBaseline(const UnownedStringSlice& text, List<PerfBaselineEntry>& outEntries)
+{
+    for (auto line : LineParser(text))
+    {
+        line = line.trim();
+        if (line.size() == 0 || line[0] == '#')
+        {
+            continue;
+        }
+
+        List<UnownedStringSlice> splitSlices;
+        StringUtil::split(line, ' ', splitSlices);
+
+        List<String> fields;
+        for (const auto& slice : splitSlices)
+        {
+            if (slice.trim().size())
+            {
+                fields.add(slice.trim());
+            }
+        }
+        if (fields.getCount() < 2 || fields.getCount() > 3)
+        {
+            return SLANG_FAIL;
+        }
+
+        PerfBaselineEntry entry;
+        entry.name = fields[0];
+        entry.tolerance = -1.0;
+
+        char* end = nullptr;
+        entry.value = strtod(fields[1].getBuffer(), &end);
+        if (end == fields[1].getBuffer() || *end != 0)
+        {
+            return SLANG_FAIL;
+        }
+        if (fields.getCount() > 2)
+        {
+            entry.tolerance = strtod(fields[2].getBuffer(), &end);
+            if (end == fields[2].getBuffer() || *end != 0 || entry.tolerance < 0.0)
+            {
+                return SLANG_FAIL;
+            }
+        }
+        outEntries.add(entry);
+    }
+    return SLANG_OK;
+}
+
+TestResult runCompilePerfTest(TestContext* context, TestInput& input)
+{
+    // Compiles happen in process, so there is nothing that needs to be available
+    if (context->isCollectingRequirements())
+    {
+        return TestResult::Pass;
+    }
+
+    auto reporter = context->reporter;
+    const String& outputStem = input.outputStem;
+
+    // -perf-iterations N sets how many times the file is compiled, all other args are for the compile
+    Int iterationCount = 5;
+    List<String> args;
+    const auto& testArgs = input.testOptions->args;
+    for (Index i = 0; i < testArgs.getCount(); ++i)
+    {
+        if (testArgs[i] == "-perf-iterations" && i + 1 < testArgs.getCount())
+        {
+            if (SLANG_FAILED(StringUtil::parseInt(testArgs[i + 1].getUnownedSlice(), iterationCount)) || iterationCount < 1)
+            {
+                reporter->messageFormat(TestMessageType::RunError, "Invalid -perf-iterations '%s'\n", testArgs[i + 1].getBuffer());
+                return TestResult::Fail;
+            }
+            i++;
+            continue;
+        }
+        args.add(testArgs[i]);
+    }
+
+    List<TestReporter::Metric> metrics;
+    for (Int i = 0; i < iterationCount; ++i)
+    {
+        String diagnostics;
+        if (SLANG_FAILED(_compileForPerfTest(context, input.filePath, args, metrics, diagnostics)))
+        {
+            reporter->messageFormat(TestMessageType::TestFailure, "Compile failed\n%s", diagnostics.getBuffer());
+            return TestResult::Fail;
+        }
+    }
+
+    for (const auto& metric : metrics)
+    {
+        reporter->addMetric(metric.name, metric.value);
+    }
+
+    // Compare against the baseline
+    TestResult result = TestResult::Pass;
+
+    const String baselinePath = outputStem + ".perf-baseline";
+    List<PerfBaselineEntry> baseline;
+    String baselineText;
+    try
+    {
+        baselineText = File::readAllText(baselinePath);
+    }
+    catch (const IOException&)
+    {
+        reporter->messageFormat(TestMessageType::TestFailure, "No baseline found at '%s'\n", baselinePath.getBuffer());
+        result = TestResult::Fail;
+    }
+    if (result == TestResult::Pass && SLANG_FAILED(_parsePerfBaseline(baselineText.getUnownedSlice(), baseline)))
+    {
+        reporter->messageFormat(TestMessageType::TestFailure, "Unable to parse baseline '%s'\n", baselinePath.getBuffer());
+        result = TestResult::Fail;
+    }
+
+    for (const auto& entry : baseline)
+    {
+        const TestReporter::Metric* metric = nullptr;
+        for (const auto& candidate : metrics)
+        {
+            if (candidate.name == entry.name)
+            {
+                metric = &candidate;
+                break;
+            }
+        }
+        if (!metric)
+        {
+            reporter->messageFormat(TestMessageType::TestFailure, "'%s' is in the baseline, but wasn't measured\n", entry.name.getBuffer());
+            result = TestResult::Fail;
+            continue;
+        }
+
+        const double tolerance = (entry.tolerance >= 0.0) ? entry.tolerance : context->options.perfTolerance;
+        if (metric->value > entry.value * (1.0 + tolerance))
+        {
+            reporter->messageFormat(TestMessageType::TestFailure, "'%s' is %g, which exceeds the baseline of %g by more than %g%%\n",
+                entry.name.getBuffer(), metric->value, entry.value, tolerance * 100.0);
+            result = TestResult::Fail;
+        }
+    }
+
+    // Write out all of the measurements in the baseline format, so that a baseline can be made from them
+    if (result == TestResult::Fail)
+    {
+        StringBuilder actual;
+        for (const auto& metric : metrics)
+        {
+            // Any tolerance in the baseline is kept
+            double tolerance = -1.0;
+            for (const auto& entry : baseline)
+            {
+                if (entry.name == metric.name)
+                {
+                    tolerance = entry.tolerance;
+                    break;
+                }
+            }
+
+            // Memory is a whole number of bytes, times are output to the microsecond
+            char buffer[64];
+            sprintf(buffer, (metric.value == double(int64_t(metric.value))) ? "%.0f" : "%.3f", metric.value);
+            actual << metric.name << " " << buffer;
+            if (tolerance >= 0.0)
+            {
+                sprintf(buffer, "%g", tolerance);
+                actual << " " << buffer;
+            }
+            actual << "\n";
+        }
+        File::writeAllText(outputStem + ".perf-baseline.actual", actual);
+    }
+
+    return result;
+}
+
 TestResult skipTest(TestContext* /* context */, TestInput& /*input*/)
 {
     return TestResult::Ignored;
@@ -2136,6 +2517,12 @@ static const TestCommandInfo s_testCommandInfos[] =
     { "CPP_COMPILER_SHARED_LIBRARY",            &runCPPCompilerSharedLibrary},
 };
 
+// Commands for //PERF tests
+static const TestCommandInfo s_perfTestCommandInfos[] =
+{
+    { "COMPILE",                                &runCompilePerfTest},
+};
+
 TestResult runTest(
     TestContext*        context, 
     String const&       filePath,
@@ -2152,8 +2539,17 @@ TestResult runTest(
 
     const SpawnType defaultSpawnType = context->options.useExes ? SpawnType::UseExe : SpawnType::UseSharedLibrary;
 
-    for( const auto& command : s_testCommandInfos)
+    const TestCommandInfo* commandInfos = s_testCommandInfos;
+    Index commandInfoCount = Index(SLANG_COUNT_OF(s_testCommandInfos));
+    if (testOptions.type == TestOptions::Perf)
+    {
+        commandInfos = s_perfTestCommandInfos;
+        commandInfoCount = Index(SLANG_COUNT_OF(s_perfTestCommandInfos));
+    }
+
+    for (Index i = 0; i < commandInfoCount; ++i)
     {
+        const auto& command = commandInfos[i];
         if(testOptions.command != command.name)
             continue;
 
@@ -2292,14 +2688,14 @@ static bool _canIgnore(TestContext* context,
     return false;
 }
 
-void runTestsOnFile(
+static void _runTestsOnFile(
     TestContext*    context,
     String          filePath)
 {
     // Gather a list of tests to run
     FileTestList testList;
 
-    if( gatherTestsForFile(&context->categorySet, filePath, &testList) == TestResult::Ignored )
+    if( gatherTestsForFile(&context->categorySet, context->testDiscoveryIndex, filePath, &testList) == TestResult::Ignored )
     {
         // Test was explicitly ignored
         return;
@@ -2442,6 +2838,17 @@ void runTestsOnFile(
 }
 
 
+void runTestsOnFile(
+    TestContext*    context,
+    String          filePath)
+{
+    // Record how long the file took, so later runs can balance shards and schedule by it
+    const uint64_t startTick = ProcessUtil::getClockTick();
+    _runTestsOnFile(context, filePath);
+    const double time = double(ProcessUtil::getClockTick() - startTick) / double(ProcessUtil::getClockFrequency());
+    context->reporter->addFileTime(filePath, time);
+}
+
 static bool endsWithAllowedExtension(
     TestContext*    /*context*/,
     String          filePath)
@@ -2493,21 +2900,300 @@ static bool shouldRunTest(
     return true;
 }
 
-void runTestsInDirectory(
+static void _findTestFilesInDirectory(
     TestContext*		context,
-    String				directoryPath)
+    String				directoryPath,
+    List<String>&		ioFiles)
 {
     for (auto file : osFindFilesInDirectory(directoryPath))
     {
         if( shouldRunTest(context, file) )
         {
 //            fprintf(stderr, "slang-test: found '%s'\n", file.getBuffer());
-            runTestsOnFile(context, file);
+            ioFiles.add(file);
         }
     }
     for (auto subdir : osFindChildDirectories(directoryPath))
     {
-        runTestsInDirectory(context, subdir);
+        _findTestFilesInDirectory(context, subdir, ioFiles);
+    }
+}
+
+/* Get the expected time to run each file, from the times the reporter has (as read from the timing file). Files without
+a time are expected to take the average time of those with one. */
+static void _calcExpectedFileTimes(TestContext* context, const List<String>& files, List<double>& outTimes)
+{
+    const Index fileCount = files.getCount();
+    outTimes.setCount(fileCount);
+
+    double totalKnownTime = 0.0;
+    Index knownCount = 0;
+    for (Index i = 0; i < fileCount; ++i)
+    {
+        double time = -1.0;
+        if (context->reporter->findFileTime(files[i], time))
+        {
+            totalKnownTime += time;
+            knownCount++;
+        }
+        outTimes[i] = time;
+    }
+
+    const double defaultTime = knownCount ? (totalKnownTime / double(knownCount)) : 1.0;
+    for (auto& time : outTimes)
+    {
+        time = (time < 0.0) ? defaultTime : time;
+    }
+}
+
+/* Calculate the order of indices into times, such that the longest times are first. Equal times keep their order. */
+static void _calcLongestFirstOrder(const List<double>& times, List<Index>& outOrder)
+{
+    outOrder.setCount(times.getCount());
+    for (Index i = 0; i < times.getCount(); ++i)
+    {
+        outOrder[i] = i;
+    }
+    outOrder.sort([&](Index a, Index b) -> bool { return times[a] > times[b] || (times[a] == times[b] && a < b); });
+}
+
+/* Replace files (and their expected times) with just the files of shard shardIndex. Files are assigned, longest
+expected time first, to whichever shard has the least total time so far - so shards take about the same time, and the
+split only depends on the files and the times, so each machine running a shard calculates the same split. */
+static void _selectShardFiles(Index shardIndex, Index shardCount, List<String>& ioFiles, List<double>& ioExpectedTimes)
+{
+    List<Index> order;
+    _calcLongestFirstOrder(ioExpectedTimes, order);
+
+    List<double> shardTimes;
+    shardTimes.setCount(shardCount);
+    for (auto& shardTime : shardTimes)
+    {
+        shardTime = 0.0;
+    }
+
+    List<bool> isInShard;
+    isInShard.setCount(ioFiles.getCount());
+    for (auto fileIndex : order)
+    {
+        Index minShardIndex = 0;
+        for (Index i = 1; i < shardCount; ++i)
+        {
+            minShardIndex = (shardTimes[i] < shardTimes[minShardIndex]) ? i : minShardIndex;
+        }
+        shardTimes[minShardIndex] += ioExpectedTimes[fileIndex];
+        isInShard[fileIndex] = (minShardIndex == shardIndex);
+    }
+
+    // Keep the files in their original order
+    List<String> files;
+    List<double> expectedTimes;
+    for (Index i = 0; i < ioFiles.getCount(); ++i)
+    {
+        if (isInShard[i])
+        {
+            files.add(ioFiles[i]);
+            expectedTimes.add(ioExpectedTimes[i]);
+        }
+    }
+    ioFiles.swapWith(files);
+    ioExpectedTimes.swapWith(expectedTimes);
+}
+
+/* Runs test files on a pool of worker threads. Each worker has its own TestContext (and so its own slang session),
+and each file is run with its own buffered reporter. The results of a file are added to the context's reporter once
+it, and all the files before it, have completed - so the output is in the same order as running the files serially. */
+class ParallelTestFileRunner
+{
+public:
+    class TestFileJob : public RefObject, public ThreadPoolJob
+    {
+    public:
+        virtual void execute() SLANG_OVERRIDE
+        {
+            StdWriters::setSingleton(m_runner->m_stdWriters);
+
+            TestContext* context = m_runner->_acquireContext();
+            context->reporter = &m_reporter;
+            try
+            {
+                TestReporter::SuiteScope suiteScope(&m_reporter, "tests");
+                runTestsOnFile(context, m_filePath);
+            }
+            catch (...)
+            {
+                m_exception = std::current_exception();
+            }
+            context->reporter = nullptr;
+            m_runner->_releaseContext(context);
+
+            m_runner->_completeJob(this);
+        }
+
+        TestFileJob(ParallelTestFileRunner* runner, const String& filePath):
+            m_runner(runner),
+            m_filePath(filePath)
+        {
+            const TestReporter* reporter = runner->m_context->reporter;
+            m_reporter.init(reporter->m_outputMode);
+            m_reporter.m_dumpOutputOnFailure = reporter->m_dumpOutputOnFailure;
+            m_reporter.m_isVerbose = reporter->m_isVerbose;
+            m_reporter.m_isBuffered = true;
+        }
+
+        ParallelTestFileRunner* m_runner;
+        String m_filePath;
+        TestReporter m_reporter;
+        bool m_isComplete = false;
+        std::exception_ptr m_exception;
+    };
+
+        /// Run the tests in the files, using up to threadCount threads. Files with the longest expected times are started first.
+    SlangResult run(const List<String>& files, const List<double>& expectedTimes, Index threadCount)
+    {
+        threadCount = Math::Min(threadCount, files.getCount());
+
+        // Set up a context for each worker, sharing what the context has already worked out
+        for (Index i = 0; i < threadCount; ++i)
+        {
+            TestContext* workerContext = new TestContext;
+            m_contexts.add(workerContext);
+            SLANG_RETURN_ON_FAIL(workerContext->init());
+
+            workerContext->options = m_context->options;
+            workerContext->categorySet = m_context->categorySet;
+            workerContext->availableBackendFlags = m_context->availableBackendFlags;
+            // Work out the apis once, rather than on each worker
+            workerContext->availableRenderApiFlags = _getAvailableRenderApiFlags(m_context);
+            workerContext->isAvailableRenderApiFlagsValid = true;
+            workerContext->renderTestMutex = &m_renderTestMutex;
+            workerContext->referenceOutputCache.setDirectory(m_context->referenceOutputCache.getDirectory());
+            workerContext->testDiscoveryIndex = m_context->testDiscoveryIndex;
+            workerContext->setInnerMainFunc("slangc", &SlangCTool::innerMain);
+
+            spSessionLoadStdLib(workerContext->getSession());
+        }
+        m_freeContexts.addRange(m_contexts);
+
+        for (const auto& file : files)
+        {
+            m_jobs.add(new TestFileJob(this, file));
+        }
+
+        // Start the slowest files first, so a slow file started near the end doesn't hold up the whole run.
+        // Results are still reported in file order.
+        List<Index> jobOrder;
+        _calcLongestFirstOrder(expectedTimes, jobOrder);
+
+        {
+            ThreadPool pool(threadCount);
+            for (auto jobIndex : jobOrder)
+            {
+                pool.submit(m_jobs[jobIndex]);
+            }
+            pool.waitForAll();
+        }
+
+        // Rethrow the first exception, as a serial run would have
+        for (auto job : m_jobs)
+        {
+            if (job->m_exception)
+            {
+                std::rethrow_exception(job->m_exception);
+            }
+        }
+        return SLANG_OK;
+    }
+
+    ParallelTestFileRunner(TestContext* context):
+        m_context(context),
+        m_stdWriters(StdWriters::getSingleton())
+    {
+    }
+    ~ParallelTestFileRunner()
+    {
+        for (auto workerContext : m_contexts)
+        {
+            delete workerContext;
+        }
+    }
+
+protected:
+    TestContext* _acquireContext()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        // There is a context for each worker, so one must be free
+        SLANG_ASSERT(m_freeContexts.getCount() > 0);
+        TestContext* workerContext = m_freeContexts.getLast();
+        m_freeContexts.removeLast();
+        return workerContext;
+    }
+    void _releaseContext(TestContext* workerContext)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_freeContexts.add(workerContext);
+    }
+    void _completeJob(TestFileJob* job)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        job->m_isComplete = true;
+
+        // Report all the jobs that are complete, up to the first that isn't. Stop at an exception, so
+        // nothing after it is reported.
+        while (m_reportedCount < m_jobs.getCount())
+        {
+            TestFileJob* reportJob = m_jobs[m_reportedCount];
+            if (!reportJob->m_isComplete || reportJob->m_exception)
+            {
+                break;
+            }
+            m_context->reporter->addBufferedResults(reportJob->m_reporter);
+            m_reportedCount++;
+        }
+    }
+
+    TestContext* m_context;                         ///< The context the runner is for. Results are added to its reporter.
+    StdWriters* m_stdWriters;                       ///< The writers of the thread the runner was created on
+
+    std::mutex m_mutex;                             ///< Guards everything below, and the context's reporter whilst running
+    List<RefPtr<TestFileJob>> m_jobs;               ///< A job per file, in file order
+    Index m_reportedCount = 0;                      ///< The number of jobs that have been added to the reporter
+    List<TestContext*> m_contexts;                  ///< A context for each worker
+    List<TestContext*> m_freeContexts;              ///< The contexts not in use by a job
+
+    std::mutex m_renderTestMutex;
+};
+
+void runTestsInDirectory(
+    TestContext*		context,
+    String				directoryPath)
+{
+    const auto& options = context->options;
+
+    List<String> files;
+    _findTestFilesInDirectory(context, directoryPath, files);
+
+    List<double> expectedTimes;
+    _calcExpectedFileTimes(context, files, expectedTimes);
+
+    if (options.shardCount > 1)
+    {
+        _selectShardFiles(options.shardIndex, options.shardCount, files, expectedTimes);
+    }
+
+    if (options.jobCount > 1 && files.getCount() > 1)
+    {
+        // If the workers can't be set up, nothing has been run, so fall back to running serially
+        ParallelTestFileRunner runner(context);
+        if (SLANG_SUCCEEDED(runner.run(files, expectedTimes, options.jobCount)))
+        {
+            return;
+        }
+    }
+
+    for (const auto& file : files)
+    {
+        runTestsOnFile(context, file);
     }
 }
 
@@ -2531,6 +3217,7 @@ SlangResult innerMain(int argc, char** argv)
     auto vulkanTestCategory = categorySet.add("vulkan", fullTestCategory);
     auto unitTestCatagory = categorySet.add("unit-test", fullTestCategory);
     auto compatibilityIssueCatagory = categorySet.add("compatibility-issue", fullTestCategory);
+    /*auto perfTestCategory = */categorySet.add("perf", fullTestCategory);
     
 #if SLANG_WINDOWS_FAMILY
     auto windowsCatagory = categorySet.add("windows", fullTestCategory);
@@ -2612,6 +3299,20 @@ SlangResult innerMain(int argc, char** argv)
         return func(StdWriters::getSingleton(), context.getSession(), int(args.getCount()), args.getBuffer());
     }
 
+    context.referenceOutputCache.setDirectory(options.referenceCachePath);
+
+    TestDiscoveryIndex testDiscoveryIndex;
+    if (options.testIndexPath.getLength())
+    {
+        // If the index can't be read, it is written with the tests found in this run
+        testDiscoveryIndex.read(options.testIndexPath);
+        context.testDiscoveryIndex = &testDiscoveryIndex;
+    }
+
+    // The session is used for every test run in process, so load the stdlib now, rather than it being part of
+    // the time of the first test that needs it
+    spSessionLoadStdLib(context.getSession());
+
     if( options.includeCategories.Count() == 0 )
     {
         options.includeCategories.Add(fullTestCategory, fullTestCategory);
@@ -2636,6 +3337,12 @@ SlangResult innerMain(int argc, char** argv)
         reporter.m_dumpOutputOnFailure = options.dumpOutputOnFailure;
         reporter.m_isVerbose = options.shouldBeVerbose;
 
+        if (options.timingFilePath.getLength())
+        {
+            // If the file doesn't exist yet, it will be written at the end of the run
+            reporter.readTimings(options.timingFilePath);
+        }
+
         {
             TestReporter::SuiteScope suiteScope(&reporter, "tests");
             // Enumerate test files according to policy
@@ -2645,7 +3352,8 @@ SlangResult innerMain(int argc, char** argv)
         }
 
         // Run the unit tests (these are internal C++ tests - not specified via files in a directory) 
-        // They are registered with SLANG_UNIT_TEST macro
+        // They are registered with SLANG_UNIT_TEST macro. If sharding they are only run on the first shard.
+        if (options.shardIndex == 0)
         {
             TestReporter::SuiteScope suiteScope(&reporter, "unit tests");
             TestReporter::set(&reporter);
@@ -2683,6 +3391,16 @@ SlangResult innerMain(int argc, char** argv)
             TestReporter::set(nullptr);
         }
 
+        if (options.timingFilePath.getLength() && SLANG_FAILED(reporter.writeTimings(options.timingFilePath)))
+        {
+            StdWriters::getError().print("warning: unable to write timing file '%s'\n", options.timingFilePath.getBuffer());
+        }
+
+        if (context.testDiscoveryIndex && testDiscoveryIndex.isChanged() && SLANG_FAILED(testDiscoveryIndex.write(options.testIndexPath)))
+        {
+            StdWriters::getError().print("warning: unable to write test index '%s'\n", options.testIndexPath.getBuffer());
+        }
+
         reporter.outputSummary();
         return reporter.didAllSucceed() ? SLANG_OK : SLANG_FAIL;
     }
@@ -12,6 +12,10 @@
 #include "../../source/core/slang-cpp-compiler.h"
 
 #include "options.h"
+#include "reference-output-cache.h"
+#include "test-discovery-index.h"
+
+#include <mutex>
 
 enum class BackendType
 {
@@ -117,6 +121,17 @@ class TestContext
 
     Slang::RefPtr<Slang::CPPCompilerSet> cppCompilerSet;
 
+        /// Holds the output of reference compilers, so unchanged tests don't run them again
+    ReferenceOutputCache referenceOutputCache;
+
+        /// If set, the tests of unchanged files are taken from the index, rather than read from the files.
+        /// When test files are run in parallel the workers share the index.
+    TestDiscoveryIndex* testDiscoveryIndex = nullptr;
+
+        /// If set, held whilst render-test runs. When test files are run in parallel each worker has its own context,
+        /// but they share the adapter (and render-test has global state), so render tests are run one at a time.
+    std::mutex* renderTestMutex = nullptr;
+
 protected:
     struct SharedLibraryTool
     {
@@ -0,0 +1,222 @@
+// test-discovery-index.cpp
+
+#include "test-discovery-index.h"
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+
+using namespace Slang;
+
+// Increment if the layout of the index changes
+static const char kIndexHeader[] = "slang-test discovery index 1";
+
+namespace { // anonymous
+
+// Reads the lines of an index in order
+struct IndexReader
+{
+    bool readLine(UnownedStringSlice& outLine)
+    {
+        if (m_lineIndex >= m_lines.getCount())
+        {
+            return false;
+        }
+        outLine = m_lines[m_lineIndex++];
+        return true;
+    }
+        /// Read a line of space separated integers, which must be exactly count of them
+    bool readInts(Int* outValues, Index count)
+    {
+        UnownedStringSlice line;
+        if (!readLine(line))
+        {
+            return false;
+        }
+        List<UnownedStringSlice> slices;
+        StringUtil::split(line, ' ', slices);
+        if (slices.getCount() != count)
+        {
+            return false;
+        }
+        for (Index i = 0; i < count; ++i)
+        {
+            if (SLANG_FAILED(StringUtil::parseInt(slices[i], outValues[i])))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    bool readStrings(Int count, List<String>& outValues)
+    {
+        for (Int i = 0; i < count; ++i)
+        {
+            UnownedStringSlice line;
+            if (!readLine(line))
+            {
+                return false;
+            }
+            outValues.add(line);
+        }
+        return true;
+    }
+
+    List<UnownedStringSlice> m_lines;
+    Index m_lineIndex = 0;
+};
+
+} // anonymous
+
+SlangResult TestDiscoveryIndex::read(const String& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries = Dictionary<String, Entry>();
+    m_isChanged = false;
+
+    String text;
+    try
+    {
+        text = File::readAllText(path);
+    }
+    catch (const IOException&)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    IndexReader reader;
+    StringUtil::calcLines(text.getUnownedSlice(), reader.m_lines);
+
+    UnownedStringSlice header;
+    if (!reader.readLine(header) || header != UnownedStringSlice::fromLiteral(kIndexHeader))
+    {
+        return SLANG_FAIL;
+    }
+
+    // Each file is its path, a line with its size, modification time, result and test count, and then its tests
+    UnownedStringSlice filePath;
+    while (reader.readLine(filePath) && filePath.size())
+    {
+        Int fileValues[4];
+        if (!reader.readInts(fileValues, 4) ||
+            fileValues[2] < Int(TestResult::Ignored) || fileValues[2] > Int(TestResult::Fail))
+        {
+            m_entries = Dictionary<String, Entry>();
+            return SLANG_FAIL;
+        }
+
+        Entry entry;
+        entry.size = int64_t(fileValues[0]);
+        entry.modifiedTime = int64_t(fileValues[1]);
+        entry.tests.result = TestResult(fileValues[2]);
+
+        // Each test is a line with its type, category count and arg count, then the categories, the command and
+        // the args, each on a line of its own
+        for (Int i = 0; i < fileValues[3]; ++i)
+        {
+            Test test;
+            Int testValues[3];
+            UnownedStringSlice command;
+            if (!reader.readInts(testValues, 3) ||
+                !reader.readStrings(testValues[1], test.categoryNames) ||
+                !reader.readLine(command) ||
+                !reader.readStrings(testValues[2], test.args))
+            {
+                m_entries = Dictionary<String, Entry>();
+                return SLANG_FAIL;
+            }
+            test.type = int(testValues[0]);
+            test.command = command;
+            entry.tests.tests.add(test);
+        }
+
+        m_entries[String(filePath)] = entry;
+    }
+    return SLANG_OK;
+}
+
+SlangResult TestDiscoveryIndex::write(const String& path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Sort by path, so the file only changes where files have changed
+    List<String> filePaths;
+    for (const auto& pair : m_entries)
+    {
+        if (pair.Value.isUsed || File::exists(pair.Key))
+        {
+            filePaths.add(pair.Key);
+        }
+    }
+    filePaths.sort();
+
+    StringBuilder builder;
+    builder << kIndexHeader << "\n";
+    for (const auto& filePath : filePaths)
+    {
+        const Entry& entry = *m_entries.TryGetValue(filePath);
+        builder << filePath << "\n";
+        builder << entry.size << " " << entry.modifiedTime << " " << int(entry.tests.result) << " " << entry.tests.tests.getCount() << "\n";
+        for (const auto& test : entry.tests.tests)
+        {
+            builder << test.type << " " << test.categoryNames.getCount() << " " << test.args.getCount() << "\n";
+            for (const auto& categoryName : test.categoryNames)
+            {
+                builder << categoryName << "\n";
+            }
+            builder << test.command << "\n";
+            for (const auto& arg : test.args)
+            {
+                builder << arg << "\n";
+            }
+        }
+    }
+
+    try
+    {
+        File::writeAllText(path, builder);
+    }
+    catch (const IOException&)
+    {
+        return SLANG_FAIL;
+    }
+    m_isChanged = false;
+    return SLANG_OK;
+}
+
+bool TestDiscoveryIndex::find(const String& filePath, FileTests& outTests)
+{
+    int64_t size = 0;
+    int64_t modifiedTime = 0;
+    if (SLANG_FAILED(File::getSizeAndModifiedTime(filePath, size, modifiedTime)))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry* entry = m_entries.TryGetValue(filePath);
+    if (!entry || entry->size != size || entry->modifiedTime != modifiedTime)
+    {
+        return false;
+    }
+
+    entry->isUsed = true;
+    outTests = entry->tests;
+    m_hitCount++;
+    return true;
+}
+
+void TestDiscoveryIndex::add(const String& filePath, const FileTests& tests)
+{
+    // If the file can't be stat'd the tests would never be found, so aren't held
+    Entry entry;
+    if (SLANG_FAILED(File::getSizeAndModifiedTime(filePath, entry.size, entry.modifiedTime)))
+    {
+        return;
+    }
+    entry.isUsed = true;
+    entry.tests = tests;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[filePath] = entry;
+    m_isChanged = true;
+}
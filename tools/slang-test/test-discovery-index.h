@@ -0,0 +1,67 @@
+// test-discovery-index.h
+
+#ifndef TEST_DISCOVERY_INDEX_H_INCLUDED
+#define TEST_DISCOVERY_INDEX_H_INCLUDED
+
+#include "../../source/core/slang-string.h"
+#include "../../source/core/slang-dictionary.h"
+
+#include "test-reporter.h"
+
+#include <mutex>
+
+/* TestDiscoveryIndex holds the test directives (such as //TEST) found in each test file, so that a run only reads and
+parses the files that have changed since an earlier run. The directives of a file are used if the file's size and
+modification time are the same as when it was parsed.
+
+The index is held in a single file, which is read at the start of a run and written at the end if anything changed.
+Finding and adding files is thread safe, as with -j files are run on several threads. */
+class TestDiscoveryIndex
+{
+public:
+        /// A test directive, as written in the file
+    struct Test
+    {
+        int type = 0;                                   ///< The TestOptions::Type
+        Slang::List<Slang::String> categoryNames;       ///< Names are looked up when used, as the categories available can change
+        Slang::String command;
+        Slang::List<Slang::String> args;
+    };
+
+    struct FileTests
+    {
+        TestResult result = TestResult::Pass;           ///< Ignored if the file is marked //TEST_IGNORE_FILE, Fail if a directive couldn't be parsed
+        Slang::List<Test> tests;
+    };
+
+        /// Read the index from path. Fails (leaving the index empty) if the file isn't found or isn't an index.
+    SlangResult read(const Slang::String& path);
+        /// Write the index to path. Files that weren't found or added in this run are only kept if they still exist.
+    SlangResult write(const Slang::String& path);
+
+        /// Find the tests of the file at filePath, if it's unchanged since they were added. Returns false if not found.
+    bool find(const Slang::String& filePath, FileTests& outTests);
+        /// Add the tests of the file at filePath, as just parsed from it
+    void add(const Slang::String& filePath, const FileTests& tests);
+
+        /// True if files have been added since the index was read
+    bool isChanged() const { return m_isChanged; }
+        /// The number of files found in the index
+    Slang::Index getHitCount() const { return m_hitCount; }
+
+protected:
+    struct Entry
+    {
+        int64_t size = 0;
+        int64_t modifiedTime = 0;
+        bool isUsed = false;                            ///< True if found or added in this run
+        FileTests tests;
+    };
+
+    std::mutex m_mutex;                                 ///< Guards everything below
+    Slang::Dictionary<Slang::String, Entry> m_entries;  ///< Keyed by file path
+    bool m_isChanged = false;
+    Slang::Index m_hitCount = 0;
+};
+
+#endif // TEST_DISCOVERY_INDEX_H_INCLUDED
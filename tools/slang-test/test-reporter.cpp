@@ -3,6 +3,7 @@
 
 #include "../../source/core/slang-string-util.h"
 #include "../../source/core/slang-process-util.h"
+#include "../../source/core/slang-io.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -113,6 +114,7 @@ void TestReporter::startTest(const String& testName)
     assert(!m_inTest);
 
     m_inTest = true;
+    m_currentStartTick = ProcessUtil::getClockTick();
 
     m_numCurrentResults = 0;
     m_numFailResults = 0;
@@ -128,12 +130,23 @@ void TestReporter::endTest()
     assert(m_inTest);
 
     m_currentInfo.message = m_currentMessage;
+    m_currentInfo.executionTime = double(ProcessUtil::getClockTick() - m_currentStartTick) / double(ProcessUtil::getClockFrequency());
 
     _addResult(m_currentInfo);
 
     m_inTest = false;
 }
 
+void TestReporter::addMetric(const String& name, double value)
+{
+    assert(m_inTest);
+
+    Metric metric;
+    metric.name = name;
+    metric.value = value;
+    m_currentInfo.metrics.add(metric);
+}
+
 void TestReporter::addResult(TestResult result)
 {
     assert(m_inTest);
@@ -201,8 +214,7 @@ void TestReporter::dumpOutputDifference(const String& expectedOutput, const Stri
 
     if (m_dumpOutputOnFailure && canWriteStdError())
     {
-        fprintf(stderr, "%s", builder.getBuffer());
-        fflush(stderr);
+        _writeStdError(builder.getBuffer());
     }
 
     // Add to the m_currentInfo
@@ -279,6 +291,14 @@ void TestReporter::_addResult(const TestInfo& info)
 
     m_testInfos.add(info);
 
+    if (m_isBuffered)
+    {
+        // Hold the output with the test, so it is output with the result by addBufferedResults
+        m_testInfos.getLast().bufferedOutput = m_bufferedOutput;
+        m_bufferedOutput.Clear();
+        return;
+    }
+
     //    printf("OUTPUT_MODE: %d\n", options.outputMode);
     switch (m_outputMode)
     {
@@ -294,7 +314,14 @@ void TestReporter::_addResult(const TestInfo& info)
                     assert(!"unexpected");
                     break;
             }
-            printf("%s test: '%S'\n", resultString, info.name.toWString().begin());
+            if (info.testResult == TestResult::Ignored)
+            {
+                printf("%s test: '%S'\n", resultString, info.name.toWString().begin());
+            }
+            else
+            {
+                printf("%s test: '%S' (%.1fms)\n", resultString, info.name.toWString().begin(), info.executionTime * 1000.0);
+            }
             break;
         }
         case TestOutputMode::TeamCity:
@@ -350,7 +377,14 @@ void TestReporter::_addResult(const TestInfo& info)
                     break;
             }
 
-            printf("##teamcity[testFinished name='%s']\n", escapedTestName.begin());
+            for (const auto& metric : info.metrics)
+            {
+                StringBuilder escapedMetricName;
+                _appendEncodedTeamCityString(metric.name.getUnownedSlice(), escapedMetricName);
+                printf("##teamcity[testMetadata testName='%s' type='number' name='%s' value='%.9g']\n", escapedTestName.begin(), escapedMetricName.begin(), metric.value);
+            }
+
+            printf("##teamcity[testFinished name='%s' duration='%d']\n", escapedTestName.begin(), int(info.executionTime * 1000.0));
             fflush(stdout);
             break;
         }
@@ -384,6 +418,8 @@ void TestReporter::_addResult(const TestInfo& info)
             cmdLine.addArg("slang-test");
             cmdLine.addArg("-Outcome");
             cmdLine.addArg(resultString);
+            cmdLine.addArg("-Duration");
+            cmdLine.addArg(String(int(info.executionTime * 1000.0)));
 
             ExecuteResult exeRes;
             SlangResult res = ProcessUtil::execute(cmdLine, exeRes);
@@ -406,6 +442,123 @@ void TestReporter::_addResult(const TestInfo& info)
     }
 }
 
+void TestReporter::addBufferedResults(TestReporter& bufferedReporter)
+{
+    assert(bufferedReporter.m_isBuffered && !bufferedReporter.m_inTest);
+    assert(!m_inTest);
+
+    for (const auto& bufferedInfo : bufferedReporter.m_testInfos)
+    {
+        if (bufferedInfo.bufferedOutput.getLength())
+        {
+            _writeStdError(bufferedInfo.bufferedOutput.getBuffer());
+        }
+
+        TestInfo info(bufferedInfo);
+        info.bufferedOutput = String();
+        _addResult(info);
+    }
+
+    if (bufferedReporter.m_bufferedOutput.getLength())
+    {
+        _writeStdError(bufferedReporter.m_bufferedOutput.getBuffer());
+    }
+
+    for (const auto& pair : bufferedReporter.m_fileTimes)
+    {
+        m_fileTimes[pair.Key] = pair.Value;
+    }
+}
+
+void TestReporter::addFileTime(const String& filePath, double time)
+{
+    m_fileTimes[filePath] = time;
+}
+
+bool TestReporter::findFileTime(const String& filePath, double& outTime) const
+{
+    if (const double* timePtr = m_fileTimes.TryGetValue(filePath))
+    {
+        outTime = *timePtr;
+        return true;
+    }
+    return false;
+}
+
+SlangResult TestReporter::readTimings(const String& path)
+{
+    String text;
+    try
+    {
+        text = File::readAllText(path);
+    }
+    catch (const IOException&)
+    {
+        return SLANG_E_NOT_FOUND;
+    }
+
+    // Each line is the time in seconds, a space, and then the path (which may contain spaces)
+    for (auto line : LineParser(text.getUnownedSlice()))
+    {
+        const Index spaceIndex = line.indexOf(' ');
+        if (spaceIndex <= 0)
+        {
+            continue;
+        }
+        const String timeText(UnownedStringSlice(line.begin(), line.begin() + spaceIndex));
+        const String filePath(UnownedStringSlice(line.begin() + spaceIndex + 1, line.end()));
+
+        const double time = StringToDouble(timeText);
+        if (filePath.getLength() && time >= 0.0)
+        {
+            m_fileTimes[filePath] = time;
+        }
+    }
+    return SLANG_OK;
+}
+
+SlangResult TestReporter::writeTimings(const String& path) const
+{
+    // Sort by path, so the file only changes where times change
+    List<String> filePaths;
+    for (const auto& pair : m_fileTimes)
+    {
+        filePaths.add(pair.Key);
+    }
+    filePaths.sort();
+
+    StringBuilder builder;
+    for (const auto& filePath : filePaths)
+    {
+        char timeText[32];
+        sprintf(timeText, "%.6f", *m_fileTimes.TryGetValue(filePath));
+        builder << timeText << " " << filePath << "\n";
+    }
+
+    try
+    {
+        File::writeAllText(path, builder);
+    }
+    catch (const IOException&)
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+void TestReporter::_writeStdError(const char* text)
+{
+    if (m_isBuffered)
+    {
+        m_bufferedOutput << text;
+    }
+    else
+    {
+        fputs(text, stderr);
+        fflush(stderr);
+    }
+}
+
 void TestReporter::addTest(const String& testName, TestResult testResult)
 {
     // Can't add this way if in test
@@ -423,7 +576,7 @@ void TestReporter::message(TestMessageType type, const String& message)
     {
         if (m_isVerbose && canWriteStdError())
         {
-            fputs(message.getBuffer(), stderr);
+            _writeStdError(message.getBuffer());
         }
 
         // Just dump out if can dump out
@@ -434,13 +587,13 @@ void TestReporter::message(TestMessageType type, const String& message)
     {
         if (type == TestMessageType::RunError || type == TestMessageType::TestFailure)
         {
-            fprintf(stderr, "error: ");
-            fputs(message.getBuffer(), stderr);
-            fprintf(stderr, "\n");
+            _writeStdError("error: ");
+            _writeStdError(message.getBuffer());
+            _writeStdError("\n");
         }
         else
         {
-            fputs(message.getBuffer(), stderr);
+            _writeStdError(message.getBuffer());
         }
     }
 
@@ -529,13 +682,24 @@ void TestReporter::outputSummary()
                 const int numIgnored = (testInfo.testResult == TestResult::Ignored);
                 //int numPassed = (testInfo.testResult == TestResult::ePass);
 
-                if (testInfo.testResult == TestResult::Pass)
+                if (testInfo.testResult == TestResult::Pass && testInfo.metrics.getCount() == 0)
                 {
-                    printf("    <testcase name=\"%s\" status=\"run\"/>\n", testInfo.name.getBuffer());
+                    printf("    <testcase name=\"%s\" status=\"run\" time=\"%f\"/>\n", testInfo.name.getBuffer(), testInfo.executionTime);
                 }
                 else
                 {
-                    printf("    <testcase name=\"%s\" status=\"run\">\n", testInfo.name.getBuffer());
+                    printf("    <testcase name=\"%s\" status=\"run\" time=\"%f\">\n", testInfo.name.getBuffer(), testInfo.executionTime);
+                    if (testInfo.metrics.getCount())
+                    {
+                        printf("      <properties>\n");
+                        for (const auto& metric : testInfo.metrics)
+                        {
+                            StringBuilder buf;
+                            appendXmlEncode(metric.name, buf);
+                            printf("        <property name=\"%s\" value=\"%.9g\"/>\n", buf.getBuffer(), metric.value);
+                        }
+                        printf("      </properties>\n");
+                    }
                     switch (testInfo.testResult)
                     {
                         case TestResult::Fail:
@@ -581,6 +745,11 @@ void TestReporter::startSuite(const String& name)
 {
     m_suiteStack.add(name);
 
+    if (m_isBuffered)
+    {
+        return;
+    }
+
     switch (m_outputMode)
     {
         case TestOutputMode::TeamCity:
@@ -598,17 +767,20 @@ void TestReporter::endSuite()
 {
     assert(m_suiteStack.getCount());
 
-    switch (m_outputMode)
+    if (!m_isBuffered)
     {
-        case TestOutputMode::TeamCity:
+        switch (m_outputMode)
         {
-            const String& name = m_suiteStack.getLast();
-            StringBuilder escapedSuiteName;
-            _appendEncodedTeamCityString(name.getUnownedSlice(), escapedSuiteName);
-            printf("##teamcity[testSuiteFinished name='%s']\n", escapedSuiteName.begin());
-            break;
+            case TestOutputMode::TeamCity:
+            {
+                const String& name = m_suiteStack.getLast();
+                StringBuilder escapedSuiteName;
+                _appendEncodedTeamCityString(name.getUnownedSlice(), escapedSuiteName);
+                printf("##teamcity[testSuiteFinished name='%s']\n", escapedSuiteName.begin());
+                break;
+            }
+            default: break;
         }
-        default: break;
     }
     
     m_suiteStack.removeLast();
@@ -62,11 +62,20 @@ class TestReporter
 {
     public:
 
+    struct Metric
+    {
+        Slang::String name;
+        double value;
+    };
+
     struct TestInfo
     {
         TestResult testResult = TestResult::Ignored;
         Slang::String name;
         Slang::String message;                 ///< Message that is specific for the testResult
+        Slang::String bufferedOutput;          ///< Output to stderr whilst the test ran, if the reporter is buffered
+        double executionTime = 0.0;            ///< Time in seconds from startTest to endTest. 0 if the test wasn't run.
+        Slang::List<Metric> metrics;           ///< Measurements made by the test (such as by performance tests)
     };
     
     class TestScope
@@ -112,6 +121,9 @@ class TestReporter
     void addResultWithLocation(bool testSucceeded, const char* testText, const char* file, int line);
 
     void endTest();
+
+        /// Add a measurement to the current test, which is output with its result (in xUnit and TeamCity output)
+    void addMetric(const Slang::String& name, double value);
     
         /// Runs start/endTest and outputs the result
     TestResult addTest(const Slang::String& testName, bool isPass);
@@ -128,6 +140,18 @@ class TestReporter
     bool canWriteStdError() const;
 
     
+        /// Add the results held by a buffered reporter, outputting them as if they had been added to this reporter
+    void addBufferedResults(TestReporter& bufferedReporter);
+
+        /// Record the time taken to run all of the tests in a file
+    void addFileTime(const Slang::String& filePath, double time);
+        /// Find the time the tests in a file took, either on this run or as read by readTimings. Returns false if not known.
+    bool findFileTime(const Slang::String& filePath, double& outTime) const;
+        /// Read file times from a timing file, as written by writeTimings. Returns SLANG_E_NOT_FOUND if the file doesn't exist.
+    SlangResult readTimings(const Slang::String& path);
+        /// Write the file times to a timing file. Files that weren't run keep the times read by readTimings.
+    SlangResult writeTimings(const Slang::String& path) const;
+
         /// Returns true if all run tests succeeded
     bool didAllSucceed() const;
 
@@ -149,6 +173,8 @@ class TestReporter
 
     Slang::List<Slang::String> m_suiteStack;
 
+    Slang::Dictionary<Slang::String, double> m_fileTimes;   ///< Time in seconds to run the tests in a file, keyed by path
+
     int m_totalTestCount;
     int m_passedTestCount;
     int m_failedTestCount;
@@ -159,13 +185,17 @@ class TestReporter
     TestOutputMode m_outputMode = TestOutputMode::Default;
     bool m_dumpOutputOnFailure;
     bool m_isVerbose = false;
+    bool m_isBuffered = false;                  ///< If set nothing is output, results are just held, to be added to another reporter with addBufferedResults
 
 protected:
     
     void _addResult(const TestInfo& info);
-    
+    void _writeStdError(const char* text);
+
+    Slang::StringBuilder m_bufferedOutput;      ///< Output to stderr, that hasn't yet been held with a TestInfo
     Slang::StringBuilder m_currentMessage;
     TestInfo m_currentInfo;
+    uint64_t m_currentStartTick = 0;
     int m_numCurrentResults;
     int m_numFailResults;
 
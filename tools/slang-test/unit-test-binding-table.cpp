@@ -0,0 +1,198 @@
+// unit-test-binding-table.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct BindingTable
+{
+    List<SlangBindingTableEntry> entries;
+
+        /// Find the entry for the path and category, or nullptr if there isn't one
+    SlangBindingTableEntry* find(char const* path, SlangParameterCategory category)
+    {
+        for (auto& entry : entries)
+        {
+            if (strcmp(entry.path, path) == 0 && entry.category == category)
+                return &entry;
+        }
+        return nullptr;
+    }
+
+        /// True if the entry is the uniform data of the buffer entry with the path
+    bool isInBuffer(SlangBindingTableEntry* entry, char const* bufferPath)
+    {
+        return entry && entry->bufferIndex >= 0 && entry->bufferIndex < entries.getCount() &&
+            strcmp(entries[entry->bufferIndex].path, bufferPath) == 0;
+    }
+};
+
+} // anonymous
+
+static BindingTable _getProgramBindingTable(slang::ProgramLayout* reflection)
+{
+    BindingTable table;
+    table.entries.setCount(Index(reflection->getBindingTableEntryCount()));
+    for (Index i = 0; i < table.entries.getCount(); ++i)
+        SLANG_CHECK(SLANG_SUCCEEDED(reflection->getBindingTableEntry(i, &table.entries[i])));
+    return table;
+}
+
+static BindingTable _getGroupBindingTable(slang::EntryPointGroupLayout* group)
+{
+    BindingTable table;
+    table.entries.setCount(Index(group->getBindingTableEntryCount()));
+    for (Index i = 0; i < table.entries.getCount(); ++i)
+        SLANG_CHECK(SLANG_SUCCEEDED(group->getBindingTableEntry(i, &table.entries[i])));
+    return table;
+}
+
+static SlangCompileRequest* _compile(SlangSession* session, SlangCompileTarget target, char const* profile)
+{
+    static const char source[] =
+        "struct Material { float4 color; Texture2D albedo; SamplerState linearSampler; float roughness[3]; };\n"
+        "struct View { float4x4 viewProjection; Texture2D shadows[4]; };\n"
+        "struct Light { float3 direction; Texture2D shadowMap; };\n"
+        "struct LightSet { float4 ambient; Light lights[2]; };\n"
+        "ParameterBlock<View> gView;\n"
+        "ConstantBuffer<Material> gMaterial;\n"
+        "ConstantBuffer<LightSet> gLightSet;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(8, 4, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID, uniform float extra)\n"
+        "{\n"
+        "    gOutput[tid.x] = gMaterial.color.x * extra + gView.viewProjection[0][0] + gLightSet.lights[1].direction.x +\n"
+        "        gMaterial.albedo.SampleLevel(gMaterial.linearSampler, float2(0, 0), 0).x + gMaterial.roughness[tid.y];\n"
+        "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, target);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, profile));
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "binding-table.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+    return request;
+}
+
+static void _checkHLSLBindingTable(SlangSession* session)
+{
+    SlangCompileRequest* request = _compile(session, SLANG_HLSL, "cs_5_1");
+    auto reflection = slang::ProgramLayout::get(request);
+
+    BindingTable table = _getProgramBindingTable(reflection);
+
+    // The buffers are leaves, and the uniform data in them refers back to them
+    auto material = table.find("gMaterial", SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER);
+    SLANG_CHECK(material && material->index == 0 && material->space == 0 && material->count == 1);
+
+    auto color = table.find("gMaterial.color", SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(color && color->index == 0 && color->count == 16 && table.isInBuffer(color, "gMaterial"));
+
+    auto roughness = table.find("gMaterial.roughness", SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(roughness && roughness->index == 16 && roughness->count == 36 && table.isInBuffer(roughness, "gMaterial"));
+
+    auto albedo = table.find("gMaterial.albedo", SLANG_PARAMETER_CATEGORY_SHADER_RESOURCE);
+    SLANG_CHECK(albedo && albedo->index == 0 && albedo->space == 0 && albedo->count == 1);
+
+    auto linearSampler = table.find("gMaterial.linearSampler", SLANG_PARAMETER_CATEGORY_SAMPLER_STATE);
+    SLANG_CHECK(linearSampler && linearSampler->index == 0 && linearSampler->count == 1);
+
+    // A parameter block has its own space
+    auto view = table.find("gView", SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER);
+    SLANG_CHECK(view && view->index == 0 && view->space == 1);
+
+    auto viewProjection = table.find("gView.viewProjection", SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(viewProjection && viewProjection->index == 0 && viewProjection->count == 64 && table.isInBuffer(viewProjection, "gView"));
+
+    auto shadows = table.find("gView.shadows", SLANG_PARAMETER_CATEGORY_SHADER_RESOURCE);
+    SLANG_CHECK(shadows && shadows->index == 0 && shadows->space == 1 && shadows->count == 4);
+
+    // The resources in an array of structures cover every element
+    auto lightSet = table.find("gLightSet", SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER);
+    SLANG_CHECK(lightSet && lightSet->index == 1 && lightSet->space == 0);
+
+    auto lights = table.find("gLightSet.lights", SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(lights && lights->index == 16 && table.isInBuffer(lights, "gLightSet"));
+    SLANG_CHECK(table.find("gLightSet.lights[].direction", SLANG_PARAMETER_CATEGORY_UNIFORM) == nullptr);
+
+    auto shadowMap = table.find("gLightSet.lights[].shadowMap", SLANG_PARAMETER_CATEGORY_SHADER_RESOURCE);
+    SLANG_CHECK(shadowMap && shadowMap->index == 1 && shadowMap->count == 2);
+
+    auto output = table.find("gOutput", SLANG_PARAMETER_CATEGORY_UNORDERED_ACCESS);
+    SLANG_CHECK(output && output->index == 0 && output->count == 1 && output->typeLayout != nullptr);
+
+    // The bindings agree with those found through the fine-grained reflection (where there is a single category)
+    for (unsigned i = 0; i < reflection->getParameterCount(); ++i)
+    {
+        auto parameter = reflection->getParameterByIndex(i);
+        if (parameter->getCategory() == slang::ParameterCategory::Mixed)
+            continue;
+        auto entry = table.find(parameter->getName(), parameter->getCategory());
+        SLANG_CHECK(entry && entry->index == parameter->getBindingIndex() && entry->space == parameter->getBindingSpace());
+    }
+
+    // The parameters of the entry point are found under its name, after the global parameters
+    SLANG_CHECK(reflection->getEntryPointGroupCount() == 1);
+    BindingTable groupTable = _getGroupBindingTable(reflection->getEntryPointGroupByIndex(0));
+
+    auto entryPointBuffer = groupTable.find("computeMain", SLANG_PARAMETER_CATEGORY_CONSTANT_BUFFER);
+    SLANG_CHECK(entryPointBuffer && entryPointBuffer->index == 2);
+
+    auto extra = groupTable.find("computeMain.extra", SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(extra && extra->index == 0 && extra->count == 4 && groupTable.isInBuffer(extra, "computeMain"));
+
+    SlangBindingTableEntry entry;
+    SLANG_CHECK(SLANG_FAILED(reflection->getBindingTableEntry(reflection->getBindingTableEntryCount(), &entry)));
+
+    spDestroyCompileRequest(request);
+}
+
+static void _checkGLSLBindingTable(SlangSession* session)
+{
+    SlangCompileRequest* request = _compile(session, SLANG_GLSL, "glsl_450");
+    auto reflection = slang::ProgramLayout::get(request);
+
+    BindingTable table = _getProgramBindingTable(reflection);
+
+    // A parameter block is a descriptor set of its own
+    auto view = table.find("gView", SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT);
+    SLANG_CHECK(view && view->index == 0 && view->space == 1);
+
+    auto shadows = table.find("gView.shadows", SLANG_PARAMETER_CATEGORY_DESCRIPTOR_TABLE_SLOT);
+    SLANG_CHECK(shadows && shadows->index == 1 && shadows->space == 1 && shadows->count == 1);
+
+    auto viewProjection = table.find("gView.viewProjection", SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(viewProjection && viewProjection->index == 0 && table.isInBuffer(viewProjection, "gView"));
+
+    for (unsigned i = 0; i < reflection->getParameterCount(); ++i)
+    {
+        auto parameter = reflection->getParameterByIndex(i);
+        if (parameter->getCategory() == slang::ParameterCategory::Mixed)
+            continue;
+        auto entry = table.find(parameter->getName(), parameter->getCategory());
+        SLANG_CHECK(entry && entry->index == parameter->getBindingIndex() && entry->space == parameter->getBindingSpace());
+    }
+
+    spDestroyCompileRequest(request);
+}
+
+static void bindingTableUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    _checkHLSLBindingTable(session);
+    _checkGLSLBindingTable(session);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("BindingTable", bindingTableUnitTest);
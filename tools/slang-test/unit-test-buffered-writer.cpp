@@ -0,0 +1,70 @@
+// unit-test-buffered-writer.cpp
+
+#include "../../source/core/slang-writer.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+    /// Records each write made to it
+class RecordingWriter : public AppendBufferWriter
+{
+public:
+    typedef AppendBufferWriter Parent;
+    // ISlangWriter
+    SLANG_NO_THROW virtual SlangResult SLANG_MCALL write(const char* chars, size_t numChars) SLANG_OVERRIDE
+    {
+        m_text.append(chars, chars + numChars);
+        m_writeCount++;
+        return SLANG_OK;
+    }
+    SLANG_NO_THROW virtual void SLANG_MCALL flush() SLANG_OVERRIDE { m_flushCount++; }
+
+    RecordingWriter() :
+        Parent(WriterFlag::IsStatic | WriterFlag::IsConsole)
+    {}
+
+    StringBuilder m_text;
+    Index m_writeCount = 0;
+    Index m_flushCount = 0;
+};
+
+} // anonymous
+
+static void bufferedWriterUnitTest()
+{
+    // Small writes are held until flushed
+    {
+        RecordingWriter recorder;
+        {
+            BufferedWriter writer(&recorder, WriterFlag::IsStatic, 16);
+            SLANG_CHECK(writer.isConsole());
+
+            WriterHelper helper(&writer);
+            helper.put("abc");
+            helper.print("%d", 123);
+            SLANG_CHECK(recorder.m_writeCount == 0 && writer.getBufferedCount() == 6);
+
+            helper.flush();
+            SLANG_CHECK(recorder.m_writeCount == 1 && recorder.m_flushCount == 1 && recorder.m_text == "abc123");
+
+            // Filling the buffer writes what is held, before holding more
+            helper.put("0123456789");
+            helper.put("abcdefgh");
+            SLANG_CHECK(recorder.m_writeCount == 2 && recorder.m_text == "abc1230123456789");
+
+            // A write larger than the buffer goes straight through (after what is held)
+            helper.put("ABCDEFGHIJKLMNOPQRSTUVWXYZ");
+            SLANG_CHECK(recorder.m_writeCount == 4 && writer.getBufferedCount() == 0);
+            SLANG_CHECK(recorder.m_text == "abc1230123456789abcdefghABCDEFGHIJKLMNOPQRSTUVWXYZ");
+
+            helper.put("end");
+        }
+        // Whatever is held is written when the writer is destroyed
+        SLANG_CHECK(recorder.m_writeCount == 5 && recorder.m_text == "abc1230123456789abcdefghABCDEFGHIJKLMNOPQRSTUVWXYZend");
+    }
+}
+
+SLANG_UNIT_TEST("BufferedWriter", bufferedWriterUnitTest);
@@ -25,6 +25,26 @@ static void checkUInt32(uint32_t value)
     SLANG_CHECK(readLen == writeLen && decode == value);
 }
 
+static void checkStreamVByte(const List<uint32_t>& values)
+{
+    const size_t num = size_t(values.getCount());
+
+    List<uint8_t> encoded;
+    ByteEncodeUtil::encodeStreamVByteUInt32(values.getBuffer(), num, encoded);
+    SLANG_CHECK(size_t(encoded.getCount()) == ByteEncodeUtil::calcEncodeStreamVByteSizeUInt32(values.getBuffer(), num));
+
+    // Decoding with and without SIMD gives the same result, and doesn't write past the end
+    List<uint32_t> decoded;
+    decoded.setCount(values.getCount() + 1);
+    decoded[values.getCount()] = 0xcdcdcdcd;
+    SLANG_CHECK(ByteEncodeUtil::decodeStreamVByteUInt32(encoded.getBuffer(), num, decoded.getBuffer()) == size_t(encoded.getCount()));
+    SLANG_CHECK(memcmp(decoded.getBuffer(), values.getBuffer(), sizeof(uint32_t) * num) == 0 && decoded[values.getCount()] == 0xcdcdcdcd);
+
+    memset(decoded.getBuffer(), 0, sizeof(uint32_t) * num);
+    SLANG_CHECK(ByteEncodeUtil::decodeStreamVByteUInt32Scalar(encoded.getBuffer(), num, decoded.getBuffer()) == size_t(encoded.getCount()));
+    SLANG_CHECK(memcmp(decoded.getBuffer(), values.getBuffer(), sizeof(uint32_t) * num) == 0);
+}
+
 static void byteEncodeUnitTest()
 {
     DefaultRandomGenerator randGen(0x5346536a);
@@ -115,6 +135,27 @@ static void byteEncodeUnitTest()
         SLANG_CHECK(memcmp(decodeBuffer.begin(), initialBuffer.begin(), sizeof(uint32_t) * blockSize) == 0);
     }
 
+    // Stream vbyte, with every count up to a few SIMD groups (so every mix of SIMD and scalar decoding),
+    // and values of every byte length
+    {
+        List<uint32_t> values;
+        for (int count = 0; count < 40; ++count)
+        {
+            checkStreamVByte(values);
+
+            const int numBytes = randGen.nextInt32UpTo(4) + 1;
+            const uint32_t mask = (numBytes == 4) ? 0xffffffff : ((uint32_t(1) << (numBytes * 8)) - 1);
+            values.add(uint32_t(randGen.nextInt32()) & mask);
+        }
+
+        values.clear();
+        for (int i = 0; i < 10000; ++i)
+        {
+            values.add(uint32_t(randGen.nextInt32()) >> (randGen.nextInt32UpTo(4) * 8));
+        }
+        checkStreamVByte(values);
+    }
+
     {
         checkUInt32(uint32_t(0));
         checkUInt32(uint32_t(0x7fffff));
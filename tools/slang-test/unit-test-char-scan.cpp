@@ -0,0 +1,80 @@
+// unit-test-char-scan.cpp
+
+#include "../../source/core/slang-char-scan.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+static const char* _findFirstOf(const char* cursor, const char* end, const char* chars)
+{
+    for (; cursor < end; ++cursor)
+    {
+        for (const char* c = chars; *c; ++c)
+        {
+            if (*cursor == *c)
+            {
+                return cursor;
+            }
+        }
+    }
+    return end;
+}
+
+static void charScanUnitTest()
+{
+    // Characters the scans look for are common, so runs are of varied lengths
+    static const char alphabet[] = " \t\r\n\\*/\"'_aZz09@[`{\x80\xff";
+
+    DefaultRandomGenerator randGen(0x5423);
+
+    List<char> text;
+    for (int i = 0; i < 2000; i++)
+    {
+        const int size = randGen.nextInt32UpTo(70);
+        const int runChar = randGen.nextInt32UpTo(int(SLANG_COUNT_OF(alphabet) - 1));
+
+        text.setCount(size);
+        for (int j = 0; j < size; j++)
+        {
+            // Mostly a run of one character, to exercise scanning whole vectors
+            const int index = randGen.nextInt32UpTo(8) ? runChar : randGen.nextInt32UpTo(int(SLANG_COUNT_OF(alphabet) - 1));
+            text[j] = alphabet[index];
+        }
+
+        const char* begin = text.getBuffer();
+        const char* end = begin + size;
+
+        for (int start = 0; start <= size; start += 7)
+        {
+            const char* cursor = begin + start;
+
+            const char* spaceEnd = cursor;
+            while (spaceEnd < end && (*spaceEnd == ' ' || *spaceEnd == '\t'))
+            {
+                spaceEnd++;
+            }
+            SLANG_CHECK(CharScanUtil::skipHorizontalSpace(cursor, end) == spaceEnd);
+
+            const char* identifierEnd = cursor;
+            while (identifierEnd < end && CharScanUtil::isIdentifierChar(*identifierEnd))
+            {
+                identifierEnd++;
+            }
+            SLANG_CHECK(CharScanUtil::findIdentifierEnd(cursor, end) == identifierEnd);
+
+            SLANG_CHECK(CharScanUtil::findLineBreak(cursor, end) == _findFirstOf(cursor, end, "\n\r"));
+            SLANG_CHECK(CharScanUtil::findFirstOf(cursor, end, '*', '\\') == _findFirstOf(cursor, end, "*\\"));
+            SLANG_CHECK(CharScanUtil::findFirstOf(cursor, end, '\n', '\r', '\\') == _findFirstOf(cursor, end, "\n\r\\"));
+            SLANG_CHECK(CharScanUtil::findFirstOf(cursor, end, '"', '\\', '\n', '\r') == _findFirstOf(cursor, end, "\"\\\n\r"));
+        }
+    }
+}
+
+SLANG_UNIT_TEST("CharScan", charScanUnitTest);
@@ -0,0 +1,101 @@
+// unit-test-code-report.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SlangCompileRequest* _createRequest(SlangSession* session)
+{
+    static const char source[] =
+        "struct Light { float3 dir; float intensity; };\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "float shade(Light l, float3 n) { return max(dot(l.dir, n), 0) * l.intensity; }\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeShade(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    Light l;\n"
+        "    l.dir = float3(0, 1, 0);\n"
+        "    l.intensity = float(tid.x);\n"
+        "    gOutput[tid.x] = shade(l, float3(0, 0, 1)) + shade(l, float3(0, 1, 0));\n"
+        "}\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeClear(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = 0;\n"
+        "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spAddCodeGenTarget(request, SLANG_HLSL);
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "code-report.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeShade", SLANG_STAGE_COMPUTE);
+    spAddEntryPoint(request, translationUnitIndex, "computeClear", SLANG_STAGE_COMPUTE);
+    return request;
+}
+
+static void codeReportUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    {
+        SlangCompileRequest* request = _createRequest(session);
+        spSetCodeReportEnabled(request, 1);
+        SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+        SLANG_CHECK(spGetCodeReportEntryPointCount(request) == 2);
+
+        for (int i = 0; i < 2; ++i)
+        {
+            SlangEntryPointCodeStats stats;
+            SLANG_CHECK(SLANG_SUCCEEDED(spGetCodeReportEntryPoint(request, i, &stats)));
+            SLANG_CHECK(strcmp(stats.entryPointName, i == 0 ? "computeShade" : "computeClear") == 0);
+            SLANG_CHECK(strcmp(stats.targetName, "hlsl") == 0);
+            SLANG_CHECK(stats.instCount > 0);
+            SLANG_CHECK(stats.peakLiveValueCount > 0);
+            SLANG_CHECK(stats.temporaryCount >= 0);
+
+            // The source size is of the code actually emitted
+            const char* code = spGetEntryPointSource(request, i);
+            SLANG_CHECK(code && stats.sourceByteCount == SlangInt(strlen(code)));
+        }
+
+        // The shading entry point has more going on than the one that clears
+        SlangEntryPointCodeStats shadeStats, clearStats;
+        spGetCodeReportEntryPoint(request, 0, &shadeStats);
+        spGetCodeReportEntryPoint(request, 1, &clearStats);
+        SLANG_CHECK(shadeStats.instCount > clearStats.instCount);
+        SLANG_CHECK(shadeStats.peakLiveValueCount > clearStats.peakLiveValueCount);
+
+        SLANG_CHECK(spGetCodeReportEntryPoint(request, 2, &shadeStats) == SLANG_E_INVALID_ARG);
+
+        const char* json = spGetCodeReportJSON(request);
+        SLANG_CHECK(json != nullptr);
+        const String jsonText(json);
+        for (const char* stage : { "link", "specialize", "legalize", "optimize" })
+        {
+            StringBuilder stageName;
+            stageName << "{\"name\":\"" << stage << "\"";
+            SLANG_CHECK(jsonText.indexOf(stageName.getBuffer()) >= 0);
+        }
+        SLANG_CHECK(jsonText.indexOf("\"opCounts\":{") >= 0);
+
+        spDestroyCompileRequest(request);
+    }
+
+    // Nothing is recorded unless reports are enabled
+    {
+        SlangCompileRequest* request = _createRequest(session);
+        SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+        SLANG_CHECK(spGetCodeReportEntryPointCount(request) == 0);
+        SLANG_CHECK(spGetCodeReportJSON(request) == nullptr);
+        spDestroyCompileRequest(request);
+    }
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("CodeReport", codeReportUnitTest);
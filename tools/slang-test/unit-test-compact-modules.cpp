@@ -0,0 +1,97 @@
+// unit-test-compact-modules.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CompactResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+    SlangModuleMemoryStats stats = {};
+};
+
+} // anonymous
+
+static CompactResult _compile(SlangSession* session, bool compact, char const* source)
+{
+    CompactResult result;
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spAddSearchPath(request, ".");
+    spSetCompactModulesEnabled(request, compact);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "compact-modules.slang", source);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    result.result = spCompile(request);
+    if (SLANG_SUCCEEDED(result.result))
+    {
+        result.code = spGetEntryPointSource(request, entryPointIndex);
+        if (SLANG_FAILED(spGetModuleMemoryStats(request, "unit_test_compact_helper", &result.stats)))
+        {
+            result.result = SLANG_FAIL;
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+static void compactModulesUnitTest()
+{
+    static const char helperPath[] = "unit-test-compact-helper.slang";
+    static const char otherPath[] = "unit-test-compact-other.slang";
+    static const char headerPath[] = "unit-test-compact-header.h";
+    File::writeAllText(headerPath, "#define HEADER_SCALE 2.0\n");
+    File::writeAllText(helperPath,
+        "#include \"unit-test-compact-header.h\"\n"
+        "Texture2D<float> gHelperTexture : register(t3);\n"
+        "float helperValue(uint i) { return gHelperTexture.Load(int3(i, 0, 0)) * HEADER_SCALE; }\n");
+    // The header is included again after the helper module is compacted
+    File::writeAllText(otherPath,
+        "#include \"unit-test-compact-header.h\"\n"
+        "float otherValue() { return HEADER_SCALE + 1.0; }\n");
+
+    static const char source[] =
+        "import unit_test_compact_helper;\n"
+        "import unit_test_compact_other;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = helperValue(tid.x) + otherValue();\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+
+    const CompactResult full = _compile(session, false, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(full.result) && full.code.getLength() > 0);
+    SLANG_CHECK(full.stats.sourceBytes > 0 && full.stats.astBytes > 0 && full.stats.irBytes > 0);
+
+    // The compacted module produces the same code (including the register from the helper's
+    // AST), but no longer holds its source
+    const CompactResult compact = _compile(session, true, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(compact.result) && compact.code == full.code);
+    SLANG_CHECK(compact.code.indexOf("register(t3)") >= 0);
+    SLANG_CHECK(compact.stats.sourceBytes == 0 && compact.stats.lineTableBytes > 0);
+    SLANG_CHECK(compact.stats.irBytes == full.stats.irBytes);
+
+    spDestroySession(session);
+
+    File::remove(helperPath);
+    File::remove(otherPath);
+    File::remove(headerPath);
+}
+
+SLANG_UNIT_TEST("CompactModules", compactModulesUnitTest);
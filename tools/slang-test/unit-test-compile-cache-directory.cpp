@@ -0,0 +1,106 @@
+// unit-test-compile-cache-directory.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static bool _compile(const String& cacheDirectory, uint64_t maxSize)
+{
+    static const char source[] =
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = tid.x * 3.0f;\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    spSetCompileCacheDirectory(request, cacheDirectory.getBuffer());
+    spSetCompileCacheMaxSize(request, maxSize);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "compile-cache-directory.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const bool succeeded = SLANG_SUCCEEDED(spCompile(request));
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return succeeded;
+}
+
+static void _findFiles(const String& directory, const char* extension, List<String>& outNames)
+{
+    outNames.clear();
+    List<String> names;
+    Path::getDirectoryContents(directory, names);
+    for (const auto& name : names)
+    {
+        if (name.endsWith(extension))
+        {
+            outNames.add(name);
+        }
+    }
+}
+
+static void compileCacheDirectoryUnitTest()
+{
+    const String directory("compile-cache-directory-unit-test");
+    Path::createDirectory(directory);
+
+    // Start from an empty cache
+    {
+        List<String> names;
+        Path::getDirectoryContents(directory, names);
+        for (const auto& name : names)
+        {
+            File::remove(Path::combine(directory, name));
+        }
+    }
+
+    // An entry that no other process knows about, and the index written by earlier versions
+    const String orphanPath = Path::combine(directory, "0000000000000000.slang-cache");
+    StringBuilder orphanContents;
+    for (Index i = 0; i < 4096; ++i)
+    {
+        orphanContents << ' ';
+    }
+    File::writeAllText(orphanPath, orphanContents);
+    File::writeAllText(Path::combine(directory, "index.txt"), "0000000000000000.slang-cache 4096\n");
+
+    // Storing the new entry takes the cache over the limit, so the least recently used entry is evicted
+    SLANG_CHECK(_compile(directory, 4096));
+    SLANG_CHECK(!File::exists(orphanPath));
+    SLANG_CHECK(!File::exists(Path::combine(directory, "index.txt")));
+
+    List<String> entries;
+    _findFiles(directory, ".slang-cache", entries);
+    SLANG_CHECK(entries.getCount() == 1);
+
+    // Entries are written to temporary files that are renamed into place
+    List<String> tempFiles;
+    _findFiles(directory, ".tmp", tempFiles);
+    SLANG_CHECK(tempFiles.getCount() == 0);
+
+    // A hit leaves the entry in place
+    SLANG_CHECK(_compile(directory, 4096));
+    _findFiles(directory, ".slang-cache", entries);
+    SLANG_CHECK(entries.getCount() == 1);
+
+    for (const auto& entry : entries)
+    {
+        File::remove(Path::combine(directory, entry));
+    }
+}
+
+SLANG_UNIT_TEST("CompileCacheDirectory", compileCacheDirectoryUnitTest);
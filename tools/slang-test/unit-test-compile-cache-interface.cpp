@@ -0,0 +1,137 @@
+// unit-test-compile-cache-interface.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+#include "../../slang-com-helper.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-string-util.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+static const Guid IID_ISlangUnknown = SLANG_UUID_ISlangUnknown;
+static const Guid IID_ISlangCompileCache = SLANG_UUID_ISlangCompileCache;
+
+    /// A compile cache held in memory, that counts how it's used
+class MemoryCompileCache : public ISlangCompileCache, public RefObject
+{
+public:
+    // ISlangUnknown
+    SLANG_REF_OBJECT_IUNKNOWN_ALL
+
+    // ISlangCompileCache
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getEntries(char const* const* keys, uint32_t keyCount, ISlangBlob** outEntries) SLANG_OVERRIDE
+    {
+        m_getCount++;
+        for (uint32_t i = 0; i < keyCount; ++i)
+        {
+            ComPtr<ISlangBlob> entry;
+            m_entries.TryGetValue(keys[i], entry);
+            outEntries[i] = entry.detach();
+        }
+        return SLANG_OK;
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL putEntry(char const* key, ISlangBlob* entry) SLANG_OVERRIDE
+    {
+        m_putCount++;
+        m_entries[key] = ComPtr<ISlangBlob>(entry);
+        return SLANG_OK;
+    }
+
+    Dictionary<String, ComPtr<ISlangBlob>> m_entries;
+    Index m_getCount = 0;
+    Index m_putCount = 0;
+
+protected:
+    ISlangUnknown* getInterface(const Guid& guid)
+    {
+        return (guid == IID_ISlangUnknown || guid == IID_ISlangCompileCache) ? static_cast<ISlangCompileCache*>(this) : nullptr;
+    }
+};
+
+struct CacheTestResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+    bool wasParsed = false;
+};
+
+} // anonymous
+
+static CacheTestResult _compile(ISlangCompileCache* cache)
+{
+    static const char source[] =
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = tid.x * 2.0f;\n"
+        "}\n";
+
+    CacheTestResult result;
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    spSetCompileCache(request, cache);
+    spSetProfilingEnabled(request, true);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "compile-cache-interface.slang", source);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    result.result = spCompile(request);
+    if (SLANG_SUCCEEDED(result.result))
+    {
+        result.code = spGetEntryPointSource(request, entryPointIndex);
+    }
+
+    // Parsing is skipped when the outputs are found in the cache
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_SUCCEEDED(spGetProfileEvent(request, i, &event)) && strcmp(event.name, "parse") == 0)
+            result.wasParsed = true;
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return result;
+}
+
+static void compileCacheInterfaceUnitTest()
+{
+    RefPtr<MemoryCompileCache> cache(new MemoryCompileCache);
+
+    // A miss compiles, and stores the outputs
+    const CacheTestResult first = _compile(cache);
+    SLANG_CHECK(SLANG_SUCCEEDED(first.result) && first.wasParsed && first.code.getLength() > 0);
+    SLANG_CHECK(cache->m_getCount == 1 && cache->m_putCount == 1 && cache->m_entries.Count() == 1);
+
+    // A compile in another session finds the outputs
+    const CacheTestResult second = _compile(cache);
+    SLANG_CHECK(SLANG_SUCCEEDED(second.result) && !second.wasParsed && second.code == first.code);
+    SLANG_CHECK(cache->m_getCount == 2 && cache->m_putCount == 1);
+
+    // Entries that can't be read are ignored, and replaced
+    for (auto& pair : cache->m_entries)
+    {
+        pair.Value = StringUtil::createStringBlob("not an entry");
+    }
+    const CacheTestResult third = _compile(cache);
+    SLANG_CHECK(SLANG_SUCCEEDED(third.result) && third.wasParsed && third.code == first.code);
+    SLANG_CHECK(cache->m_putCount == 2);
+
+    const CacheTestResult fourth = _compile(cache);
+    SLANG_CHECK(SLANG_SUCCEEDED(fourth.result) && !fourth.wasParsed && fourth.code == first.code);
+}
+
+SLANG_UNIT_TEST("CompileCacheInterface", compileCacheInterfaceUnitTest);
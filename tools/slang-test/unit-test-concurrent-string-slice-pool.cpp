@@ -0,0 +1,99 @@
+// unit-test-concurrent-string-slice-pool.cpp
+
+#include "../../source/core/slang-concurrent-string-slice-pool.h"
+
+#include "test-context.h"
+
+#include <thread>
+
+using namespace Slang;
+
+static void concurrentStringSlicePoolUnitTest()
+{
+    typedef ConcurrentStringSlicePool::Handle Handle;
+
+    const Index threadCount = 4;
+    const Index nameCount = 20000;
+
+    // Every thread adds the same names, in a different order
+    List<String> names;
+    for (Index i = 0; i < nameCount; ++i)
+    {
+        StringBuilder buf;
+        buf << "name" << i;
+        names.add(buf);
+    }
+
+    ConcurrentStringSlicePool pool;
+    SLANG_CHECK(pool.add("") == ConcurrentStringSlicePool::kEmptyHandle);
+    SLANG_CHECK(pool.add((const char*)nullptr) == ConcurrentStringSlicePool::kNullHandle);
+
+    List<List<Handle>> threadHandles;
+    threadHandles.setCount(threadCount);
+
+    List<std::thread> threads;
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        List<Handle>* handles = &threadHandles[i];
+        handles->setCount(nameCount);
+        threads.add(std::thread([&, i, handles]()
+        {
+            for (Index j = 0; j < nameCount; ++j)
+            {
+                const Index nameIndex = (i & 1) ? (nameCount - 1 - j) : j;
+                (*handles)[nameIndex] = pool.add(names[nameIndex]);
+            }
+        }));
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // All threads get the same handle for a name, and it's for the right slice
+    SLANG_CHECK(pool.getSliceCount() == nameCount + ConcurrentStringSlicePool::kNumDefaultHandles);
+    for (Index j = 0; j < nameCount; ++j)
+    {
+        const Handle handle = threadHandles[0][j];
+        SLANG_CHECK(ConcurrentStringSlicePool::hasContents(handle));
+        SLANG_CHECK(pool.getSlice(handle) == names[j].getUnownedSlice());
+        SLANG_CHECK(pool.find(names[j].getUnownedSlice()) == handle);
+        for (Index i = 1; i < threadCount; ++i)
+        {
+            SLANG_CHECK(threadHandles[i][j] == handle);
+        }
+    }
+    SLANG_CHECK(!pool.has(UnownedStringSlice::fromLiteral("notAdded")));
+
+    // The order in a StringSlicePool doesn't depend on the order slices were added
+    {
+        StringSlicePool serialPool;
+        Dictionary<Handle, StringSlicePool::Handle> handleMap;
+        pool.addToPool(serialPool, &handleMap);
+
+        ConcurrentStringSlicePool reversedPool;
+        for (Index j = nameCount - 1; j >= 0; --j)
+        {
+            reversedPool.add(names[j]);
+        }
+        StringSlicePool reversedSerialPool;
+        reversedPool.addToPool(reversedSerialPool);
+
+        SLANG_CHECK(serialPool.getNumSlices() == reversedSerialPool.getNumSlices());
+        for (Index i = 0; i < serialPool.getNumSlices(); ++i)
+        {
+            SLANG_CHECK(serialPool.getSlices()[i] == reversedSerialPool.getSlices()[i]);
+        }
+
+        for (Index j = 0; j < nameCount; ++j)
+        {
+            const Handle handle = threadHandles[0][j];
+            SLANG_CHECK(serialPool.getSlice(handleMap[handle]) == pool.getSlice(handle));
+        }
+    }
+
+    pool.clear();
+    SLANG_CHECK(pool.getSliceCount() == ConcurrentStringSlicePool::kNumDefaultHandles && !pool.has(names[0].getUnownedSlice()));
+}
+
+SLANG_UNIT_TEST("ConcurrentStringSlicePool", concurrentStringSlicePoolUnitTest);
@@ -0,0 +1,110 @@
+// unit-test-cpp-compiler-cache.cpp
+
+#include "../../source/core/slang-cpp-compiler-cache.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-platform.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+// Stands in for a real compiler. 'Compiling' writes the source file contents to the output, and counts compiles.
+class FakeCPPCompiler : public CPPCompiler
+{
+public:
+    virtual SlangResult compile(const CompileOptions& options, Output& outOutput) SLANG_OVERRIDE
+    {
+        outOutput.reset();
+        m_compileCount++;
+
+        String contents = File::readAllText(options.sourceFiles[0]);
+        File::writeAllText(SharedLibrary::calcPlatformPath(options.modulePath.getUnownedSlice()), contents);
+        return SLANG_OK;
+    }
+
+    FakeCPPCompiler() : CPPCompiler(Desc(CompilerType::GCC, 1, 0)) {}
+
+    Index m_compileCount = 0;
+};
+
+} // anonymous
+
+static void _removeCacheEntry(const String& cachedModulePath)
+{
+    File::remove(SharedLibrary::calcPlatformPath(cachedModulePath.getUnownedSlice()));
+    File::remove(cachedModulePath + ".key");
+}
+
+static void cppCompilerCacheUnitTest()
+{
+    const String directory("cpp-compiler-cache-unit-test");
+    Path::createDirectory(directory);
+
+    const String sourcePath = Path::combine(directory, "source.cpp");
+    const String headerPath = Path::combine(directory, "header.h");
+    const String cacheDirectory = Path::combine(directory, "cache");
+
+    // The header holds a value unique to this run, so that entries left from earlier runs aren't found
+    StringBuilder header;
+    header << "int header = " << ProcessUtil::getClockTick() << ";\n";
+    File::writeAllText(headerPath, header);
+    File::writeAllText(sourcePath, "#include \"header.h\"\nint source = 1;\n");
+
+    RefPtr<FakeCPPCompiler> innerCompiler(new FakeCPPCompiler);
+    RefPtr<CachingCPPCompiler> compiler(new CachingCPPCompiler(innerCompiler, cacheDirectory));
+
+    CPPCompiler::CompileOptions options;
+    options.targetType = CPPCompiler::TargetType::SharedLibrary;
+    options.sourceFiles.add(sourcePath);
+    options.modulePath = Path::combine(directory, "module");
+
+    CPPCompiler::Output output;
+    String cachedModulePath;
+
+    List<String> cachedModulePaths;
+
+    // The first compile runs the compiler, the second is found in the cache
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compileCached(options, output, cachedModulePath)));
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compileCached(options, output, cachedModulePath)));
+    SLANG_CHECK(innerCompiler->m_compileCount == 1 && compiler->getHitCount() == 1);
+    cachedModulePaths.add(cachedModulePath);
+
+    // The output is left in the cache
+    const String cachedPath = SharedLibrary::calcPlatformPath(cachedModulePath.getUnownedSlice());
+    SLANG_CHECK(File::readAllText(cachedPath) == "#include \"header.h\"\nint source = 1;\n");
+
+    // Compiling to the module path copies from the cache
+    const String modulePath = SharedLibrary::calcPlatformPath(options.modulePath.getUnownedSlice());
+    File::remove(modulePath);
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compile(options, output)));
+    SLANG_CHECK(innerCompiler->m_compileCount == 1 && File::exists(modulePath));
+
+    // Changing an option that affects the output misses
+    options.optimizationLevel = CPPCompiler::OptimizationLevel::Normal;
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compileCached(options, output, cachedModulePath)));
+    SLANG_CHECK(innerCompiler->m_compileCount == 2);
+    cachedModulePaths.add(cachedModulePath);
+
+    // Changing an included header misses
+    header << "int header2 = 0;\n";
+    File::writeAllText(headerPath, header);
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compileCached(options, output, cachedModulePath)));
+    SLANG_CHECK(innerCompiler->m_compileCount == 3);
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compileCached(options, output, cachedModulePath)));
+    SLANG_CHECK(innerCompiler->m_compileCount == 3);
+    cachedModulePaths.add(cachedModulePath);
+
+    for (const auto& path : cachedModulePaths)
+    {
+        _removeCacheEntry(path);
+    }
+    File::remove(modulePath);
+    File::remove(headerPath);
+    File::remove(sourcePath);
+    File::remove(cacheDirectory);
+    File::remove(directory);
+}
+
+SLANG_UNIT_TEST("CPPCompilerCache", cppCompilerCacheUnitTest);
@@ -0,0 +1,78 @@
+// unit-test-cpp-host-callable.cpp
+
+#include "../../source/core/slang-cpp-host-callable.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void cppHostCallableUnitTest()
+{
+    RefPtr<CPPCompilerSet> compilerSet(new CPPCompilerSet);
+    CPPCompilerUtil::initializeSet(compilerSet);
+    CPPCompiler* compiler = compilerSet->getDefaultCompiler();
+    if (!compiler)
+    {
+        // Nothing to test without a compiler
+        return;
+    }
+
+    const String directory("cpp-host-callable-unit-test");
+    RefPtr<HostCallableCompiler> hostCallableCompiler(new HostCallableCompiler(compiler, directory));
+
+    CPPCompiler::CompileOptions options;
+    options.sourceType = CPPCompiler::SourceType::CPP;
+
+    // The source holds a value unique to this run, so that libraries cached by earlier runs aren't found
+    StringBuilder source;
+    source << "extern \"C\" int run = " << ProcessUtil::getClockTick() << ";\n";
+    source << "extern \"C\"\n";
+    source << "#ifdef _WIN32\n__declspec(dllexport)\n#else\n__attribute__((visibility(\"default\")))\n#endif\n";
+    source << "int add(int a, int b) { return a + b; }\n";
+
+    typedef int(*AddFunc)(int a, int b);
+
+    CPPCompiler::Output output;
+    RefPtr<HostCallableCompiler::Module> module;
+    SLANG_CHECK(SLANG_SUCCEEDED(hostCallableCompiler->compile(source.getUnownedSlice(), options, output, module)));
+    SLANG_CHECK(module && SLANG_SUCCEEDED(output.result));
+    if (!module)
+    {
+        return;
+    }
+
+    AddFunc addFunc = (AddFunc)module->findFunction("add");
+    SLANG_CHECK(addFunc && addFunc(2, 3) == 5);
+
+    // Compiling the same source again returns the module that is already loaded
+    RefPtr<HostCallableCompiler::Module> secondModule;
+    SLANG_CHECK(SLANG_SUCCEEDED(hostCallableCompiler->compile(source.getUnownedSlice(), options, output, secondModule)));
+    SLANG_CHECK(secondModule == module && hostCallableCompiler->getLoadedHitCount() == 1);
+    SLANG_CHECK(hostCallableCompiler->getCachingCompiler()->getMissCount() == 1);
+
+    // Source that fails to compile outputs messages, and no module
+    RefPtr<HostCallableCompiler::Module> errorModule;
+    SLANG_CHECK(SLANG_SUCCEEDED(hostCallableCompiler->compile(UnownedStringSlice::fromLiteral("int add(int a, int b) { return a + ; }\n"), options, output, errorModule)));
+    SLANG_CHECK(!errorModule && SLANG_FAILED(output.result));
+
+    // The libraries are unloaded before their files are removed
+    module.setNull();
+    secondModule.setNull();
+    hostCallableCompiler.setNull();
+
+    const String cacheDirectory = Path::combine(directory, "cache");
+    for (const String& subDirectory : { cacheDirectory, directory })
+    {
+        List<String> names;
+        Path::getDirectoryContents(subDirectory, names);
+        for (const auto& name : names)
+        {
+            File::remove(Path::combine(subDirectory, name));
+        }
+    }
+    File::remove(cacheDirectory);
+    File::remove(directory);
+}
+
+SLANG_UNIT_TEST("CPPHostCallable", cppHostCallableUnitTest);
@@ -0,0 +1,82 @@
+// unit-test-cpp-precompiled-header.cpp
+
+#include "../../source/core/slang-cpp-compiler.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void cppPrecompiledHeaderUnitTest()
+{
+    RefPtr<CPPCompilerSet> compilerSet(new CPPCompilerSet);
+    CPPCompilerUtil::initializeSet(compilerSet);
+    CPPCompiler* compiler = compilerSet->getDefaultCompiler();
+    if (!compiler)
+    {
+        // Nothing to test without a compiler
+        return;
+    }
+
+    const String directory("cpp-precompiled-header-unit-test");
+    Path::createDirectory(directory);
+
+    const String sourcePath = Path::combine(directory, "source.cpp");
+    File::writeAllText(sourcePath,
+        "#include \"slang-cpp-types.h\"\n"
+        "#include <stdio.h>\n"
+        "int main() { VecF3 v = VecF3_init(1, 2, 3) * 2.0f; printf(\"%g\\n\", v.x + v.y + v.z); return 0; }\n");
+
+    CPPCompiler::CompileOptions options;
+    options.sourceType = CPPCompiler::SourceType::CPP;
+    options.includePaths.add("prelude");
+
+    const String headerPath("prelude/slang-cpp-types.h");
+    const String pchDirectory = Path::combine(directory, "pch");
+
+    String precompiledHeaderPath;
+    SLANG_CHECK(SLANG_SUCCEEDED(CPPCompilerUtil::ensurePrecompiledHeader(compiler, options, headerPath, pchDirectory, precompiledHeaderPath)));
+
+    const String filePath = CPPCompilerUtil::calcPrecompiledHeaderFilePath(compiler->getDesc(), precompiledHeaderPath);
+    SLANG_CHECK(File::exists(filePath));
+
+    // It isn't rebuilt while the header is unchanged
+    int64_t size, modifiedTime;
+    SLANG_CHECK(SLANG_SUCCEEDED(File::getSizeAndModifiedTime(filePath, size, modifiedTime)));
+    {
+        String secondPath;
+        SLANG_CHECK(SLANG_SUCCEEDED(CPPCompilerUtil::ensurePrecompiledHeader(compiler, options, headerPath, pchDirectory, secondPath)));
+        SLANG_CHECK(secondPath == precompiledHeaderPath);
+
+        int64_t secondSize, secondModifiedTime;
+        SLANG_CHECK(SLANG_SUCCEEDED(File::getSizeAndModifiedTime(filePath, secondSize, secondModifiedTime)));
+        SLANG_CHECK(secondSize == size && secondModifiedTime == modifiedTime);
+    }
+
+    // A source compiled with it runs as expected
+    options.sourceFiles.add(sourcePath);
+    options.modulePath = Path::combine(directory, "source");
+    options.precompiledHeaderPath = precompiledHeaderPath;
+
+    CPPCompiler::Output output;
+    SLANG_CHECK(SLANG_SUCCEEDED(compiler->compile(options, output)) && SLANG_SUCCEEDED(output.result));
+
+    StringBuilder exePath;
+    exePath << options.modulePath << ProcessUtil::getExecutableSuffix();
+
+    CommandLine cmdLine;
+    cmdLine.setExecutablePath(exePath);
+    ExecuteResult exeRes;
+    SLANG_CHECK(SLANG_SUCCEEDED(ProcessUtil::execute(cmdLine, exeRes)));
+    SLANG_CHECK(exeRes.standardOutput.startsWith("12"));
+
+    File::remove(exePath);
+    File::remove(sourcePath);
+    File::remove(filePath);
+    File::remove(precompiledHeaderPath);
+    File::remove(Path::getParentDirectory(precompiledHeaderPath));
+    File::remove(pchDirectory);
+    File::remove(directory);
+}
+
+SLANG_UNIT_TEST("CPPPrecompiledHeader", cppPrecompiledHeaderUnitTest);
@@ -0,0 +1,117 @@
+// unit-test-dictionary.cpp
+
+#include "../../source/core/slang-dictionary.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+static void dictionaryUnitTest()
+{
+    // Compare against a simple array of 'values', where -1 means the key is absent
+    {
+        const int keyRange = 2000;
+        List<int> values;
+        values.setCount(keyRange);
+        for (auto& value : values)
+        {
+            value = -1;
+        }
+
+        Dictionary<int, int> dict;
+        DefaultRandomGenerator randGen(0x7463);
+
+        int count = 0;
+        for (int i = 0; i < 20000; i++)
+        {
+            const int key = randGen.nextInt32UpTo(keyRange);
+            const int op = randGen.nextInt32UpTo(3);
+
+            if (op == 0)
+            {
+                const bool wasAdded = dict.AddIfNotExists(key, i);
+                SLANG_CHECK(wasAdded == (values[key] < 0));
+                if (wasAdded)
+                {
+                    values[key] = i;
+                    count++;
+                }
+            }
+            else if (op == 1)
+            {
+                dict[key] = i;
+                if (values[key] < 0)
+                {
+                    count++;
+                }
+                values[key] = i;
+            }
+            else
+            {
+                dict.Remove(key);
+                if (values[key] >= 0)
+                {
+                    count--;
+                }
+                values[key] = -1;
+            }
+
+            SLANG_CHECK(dict.Count() == count);
+
+            const int checkKey = randGen.nextInt32UpTo(keyRange);
+            int value = -1;
+            const bool found = dict.TryGetValue(checkKey, value);
+            SLANG_CHECK(found == (values[checkKey] >= 0));
+            SLANG_CHECK(!found || value == values[checkKey]);
+        }
+
+        // Iteration should visit every entry once
+        int iteratedCount = 0;
+        for (const auto& pair : dict)
+        {
+            SLANG_CHECK(values[pair.Key] == pair.Value);
+            iteratedCount++;
+        }
+        SLANG_CHECK(iteratedCount == count);
+
+        // Copies are independent
+        Dictionary<int, int> copy(dict);
+        dict.Clear();
+        SLANG_CHECK(dict.Count() == 0);
+        SLANG_CHECK(copy.Count() == count);
+        for (int key = 0; key < keyRange; key++)
+        {
+            SLANG_CHECK(!dict.ContainsKey(key));
+            SLANG_CHECK(copy.ContainsKey(key) == (values[key] >= 0));
+        }
+    }
+
+    // Repeatedly adding and removing keeps working when deleted slots build up
+    {
+        Dictionary<String, int> dict;
+        for (int i = 0; i < 10000; i++)
+        {
+            StringBuilder builder;
+            builder << "key" << i;
+            const String key = builder;
+
+            dict.Add(key, i);
+            SLANG_CHECK(dict.ContainsKey(key));
+            if (i >= 8)
+            {
+                StringBuilder oldBuilder;
+                oldBuilder << "key" << (i - 8);
+                dict.Remove(oldBuilder);
+            }
+            SLANG_CHECK(dict.Count() == (i < 8 ? i + 1 : 8));
+        }
+    }
+}
+
+SLANG_UNIT_TEST("Dictionary", dictionaryUnitTest);
@@ -0,0 +1,80 @@
+// unit-test-entry-point-code.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-writer.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void _checkEntryPointCode(SlangCompileRequest* request, int targetIndex)
+{
+    size_t size = 0;
+    const void* data = spGetEntryPointCode(request, 0, &size);
+    SLANG_CHECK(data && size > 0);
+
+    // The blob holds the output rather than a copy, so getting it again returns the same blob
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointCodeBlob(request, 0, targetIndex, blob.writeRef())));
+    ComPtr<ISlangBlob> secondBlob;
+    SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointCodeBlob(request, 0, targetIndex, secondBlob.writeRef())));
+    SLANG_CHECK(blob && blob == secondBlob);
+    SLANG_CHECK(blob->getBufferPointer() == data && blob->getBufferSize() == size);
+
+    // The code written to a writer is the same
+    StringBuilder builder;
+    RefPtr<StringWriter> writer(new StringWriter(&builder, 0));
+    SLANG_CHECK(SLANG_SUCCEEDED(spWriteEntryPointCode(request, 0, targetIndex, writer)));
+    SLANG_CHECK(size_t(builder.getLength()) == size && memcmp(builder.getBuffer(), data, size) == 0);
+
+    SLANG_CHECK(spWriteEntryPointCode(request, 1, targetIndex, writer) == SLANG_ERROR_INVALID_PARAMETER);
+    SLANG_CHECK(spWriteEntryPointCode(request, 0, targetIndex + 1, writer) == SLANG_ERROR_INVALID_PARAMETER);
+    SLANG_CHECK(spWriteEntryPointCode(request, 0, targetIndex, nullptr) == SLANG_ERROR_INVALID_PARAMETER);
+}
+
+static void entryPointCodeUnitTest()
+{
+    static const char source[] =
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = tid.x * 2.0f;\n"
+        "}\n";
+
+    // Text output (HLSL), and binary output (SPIR-V generated by Slang itself, so no downstream compiler is needed)
+    const SlangCompileTarget targets[] = { SLANG_HLSL, SLANG_SPIRV };
+    const char* profiles[] = { "cs_5_0", "glsl_450" };
+
+    for (int i = 0; i < SLANG_COUNT_OF(targets); ++i)
+    {
+        SlangSession* session = spCreateSession(nullptr);
+        SlangCompileRequest* request = spCreateCompileRequest(session);
+
+        const int targetIndex = spAddCodeGenTarget(request, targets[i]);
+        spSetTargetProfile(request, targetIndex, spFindProfile(session, profiles[i]));
+        if (targets[i] == SLANG_SPIRV)
+        {
+            spSetTargetFlags(request, targetIndex, SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY);
+        }
+
+        const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "entry-point-code.slang", source);
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+        const SlangResult res = spCompile(request);
+        SLANG_CHECK(SLANG_SUCCEEDED(res));
+        if (SLANG_SUCCEEDED(res))
+        {
+            _checkEntryPointCode(request, targetIndex);
+        }
+
+        spDestroyCompileRequest(request);
+        spDestroySession(session);
+    }
+}
+
+SLANG_UNIT_TEST("EntryPointCode", entryPointCodeUnitTest);
@@ -0,0 +1,67 @@
+// unit-test-existential-dynamic-dispatch.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "interface IMaterial { float shade(float v); }\n"
+    "struct Matte : IMaterial { float albedo; float shade(float v) { return v * albedo; } }\n"
+    "struct Glossy : IMaterial { float albedo; float gloss; float shade(float v) { return v * albedo + gloss; } }\n"
+    "interface ILight { float intensity(); }\n"
+    "struct PointLight : ILight { float power; float intensity() { return power; } }\n"
+    "IMaterial gMaterial;\n"
+    "RWStructuredBuffer<float> gOutput;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID, uniform ILight light)\n"
+    "{\n"
+    "    gOutput[tid.x] = gMaterial.shade(light.intensity());\n"
+    "}\n";
+
+static String _compile(SlangSession* session, char const* materialTypeName, char const* lightTypeName)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "existential-dynamic-dispatch.slang", kSource);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    spSetTypeNameForGlobalExistentialTypeParam(request, 0, materialTypeName);
+    spSetTypeNameForEntryPointExistentialTypeParam(request, entryPointIndex, 0, lightTypeName);
+
+    String code;
+    if (SLANG_SUCCEEDED(spCompile(request)))
+    {
+        code = spGetEntryPointSource(request, entryPointIndex);
+    }
+    spDestroyCompileRequest(request);
+    return code;
+}
+
+static void existentialDynamicDispatchUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    // A concrete type specializes the call, so there is nothing to dispatch on
+    const String specialized = _compile(session, "Glossy", "PointLight");
+    SLANG_CHECK(specialized.getLength() > 0 && specialized.indexOf("switch") < 0);
+
+    // A tagged union over the closed set of materials lets one kernel serve all of them,
+    // while the light is still specialized
+    const String dynamic = _compile(session, "__TaggedUnion(Matte, Glossy)", "PointLight");
+    SLANG_CHECK(dynamic.getLength() > 0 && dynamic.indexOf("switch") >= 0);
+    SLANG_CHECK(dynamic.indexOf("case 1:") >= 0 && dynamic.indexOf("case 2:") < 0);
+
+    // Entry point existential parameters can be dispatched dynamically as well
+    const String dynamicLight = _compile(session, "Matte", "__TaggedUnion(PointLight)");
+    SLANG_CHECK(dynamicLight.getLength() > 0 && dynamicLight.indexOf("switch") >= 0);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("ExistentialDynamicDispatch", existentialDynamicDispatchUnitTest);
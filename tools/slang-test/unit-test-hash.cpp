@@ -0,0 +1,95 @@
+// unit-test-hash.cpp
+
+#include "../../source/core/slang-hash.h"
+
+#include "test-context.h"
+
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-string.h"
+
+using namespace Slang;
+
+static void hashUnitTest()
+{
+    // Strings, slices and C strings of the same characters hash the same, so can be used to look each other up
+    {
+        const char text[] = "_S3tk4mainp0p";
+        const String string(text);
+        SLANG_CHECK(string.GetHashCode() == UnownedStringSlice(text).GetHashCode());
+        SLANG_CHECK(string.GetHashCode() == GetHashCode(text));
+        SLANG_CHECK(String().GetHashCode() == UnownedStringSlice().GetHashCode());
+        SLANG_CHECK(String().GetHashCode() == GetHashCode((const char*)nullptr));
+    }
+
+    // Every length takes a different path through the hash, so check each byte of each length is hashed
+    {
+        uint8_t data[100];
+        for (size_t i = 0; i < SLANG_COUNT_OF(data); ++i)
+        {
+            data[i] = uint8_t(i);
+        }
+
+        HashSet<HashCode64> hashes;
+        for (size_t size = 0; size <= SLANG_COUNT_OF(data); ++size)
+        {
+            const HashCode64 hash = getHashCode64(data, size);
+            SLANG_CHECK(hash == getHashCode64(data, size));
+            SLANG_CHECK(hashes.Add(hash));
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                data[i] ^= 1;
+                SLANG_CHECK(hashes.Add(getHashCode64(data, size)));
+                data[i] ^= 1;
+            }
+        }
+
+        // The seed changes the hash
+        SLANG_CHECK(getHashCode64(data, 10, 1) != getHashCode64(data, 10, 2));
+    }
+
+    // Names that differ by a character, like mangled names, all have different (folded) hashes
+    {
+        HashSet<HashCode> hashes;
+        StringBuilder buf;
+        for (Int i = 0; i < 10000; ++i)
+        {
+            buf.Clear();
+            buf << "_S" << i << "Texture2Dp0p";
+            SLANG_CHECK(hashes.Add(buf.ProduceString().GetHashCode()));
+        }
+    }
+
+    // The platform's 128 bit multiply (if it has one) matches the portable one, so hashes are the same on every platform
+    {
+        const uint64_t values[] = { 0, 1, 0xffffffffull, 0x100000000ull, 0xffffffffffffffffull, 0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull };
+        for (auto a : values)
+        {
+            for (auto b : values)
+            {
+                uint64_t high, portableHigh;
+                const uint64_t low = multiply128(a, b, high);
+                const uint64_t portableLow = multiply128Portable(a, b, portableHigh);
+                SLANG_CHECK(low == portableLow && high == portableHigh);
+            }
+        }
+
+        uint64_t high;
+        SLANG_CHECK(multiply128Portable(0xffffffffffffffffull, 0xffffffffffffffffull, high) == 1 && high == 0xfffffffffffffffeull);
+
+        // Values from a 64 bit build, which every other build must also give
+        SLANG_CHECK(getHashCode64("_S3tk4mainp0p", 13) == 0xdbe014ca748225b1ull);
+        SLANG_CHECK(getHashCode64("Texture2D<float4>", 17, 7) == 0x4e12dd0640b77eecull);
+
+        // The stable hash is 32 bit FNV-1a
+        SLANG_CHECK(getStableHashCode32("", 0) == 0x811c9dc5);
+        SLANG_CHECK(getStableHashCode32("a", 1) == 0xe40c292c);
+        SLANG_CHECK(getStableHashCode32("foobar", 6) == 0xbf9cf968);
+    }
+
+    // The high bits of 64 bit values contribute
+    SLANG_CHECK(GetHashCode(int64_t(1)) != GetHashCode(int64_t(1) | (int64_t(1) << 40)));
+    SLANG_CHECK(GetHashCode(1.0) != GetHashCode(1.0 + 1e-12));
+}
+
+SLANG_UNIT_TEST("Hash", hashUnitTest);
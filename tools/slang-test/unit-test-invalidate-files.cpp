@@ -0,0 +1,102 @@
+// unit-test-invalidate-files.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct InvalidateResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+    Index parseCount = 0;
+};
+
+} // anonymous
+
+static InvalidateResult _compileAndReset(SlangCompileRequest* request, char const* source)
+{
+    InvalidateResult result;
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "invalidate-files.slang", source);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    result.result = spCompile(request);
+    if (SLANG_SUCCEEDED(result.result))
+    {
+        result.code = spGetEntryPointSource(request, entryPointIndex);
+    }
+
+    // Each module that is parsed (the translation unit, and any module it imports) has an event
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_SUCCEEDED(spGetProfileEvent(request, i, &event)) && strcmp(event.name, "parse") == 0)
+            result.parseCount++;
+    }
+
+    spResetCompileRequest(request);
+    return result;
+}
+
+static void invalidateFilesUnitTest()
+{
+    static const char helperPath[] = "unit-test-invalidate-helper.slang";
+    static const char otherPath[] = "unit-test-invalidate-other.slang";
+    File::writeAllText(helperPath, "float helperValue() { return 3; }\n");
+    File::writeAllText(otherPath, "float otherValue() { return 7; }\n");
+
+    static const char source[] =
+        "import unit_test_invalidate_helper;\n"
+        "import unit_test_invalidate_other;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = helperValue() * otherValue();\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spAddSearchPath(request, ".");
+    spSetProfilingEnabled(request, true);
+
+    const InvalidateResult first = _compileAndReset(request, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(first.result) && first.code.getLength() > 0 && first.parseCount == 3);
+
+    // Without being told, the request keeps using the modules it has loaded
+    File::writeAllText(helperPath, "float helperValue() { return 5; }\n");
+    const InvalidateResult stale = _compileAndReset(request, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(stale.result) && stale.code == first.code && stale.parseCount == 1);
+
+    // Once the file is invalidated only its module is loaded again
+    const char* paths[] = { helperPath };
+    spInvalidateFiles(request, paths, 1);
+    const InvalidateResult changed = _compileAndReset(request, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(changed.result) && changed.code != first.code && changed.parseCount == 2);
+
+    // Invalidating a file no module depends on keeps the modules
+    const char* unusedPaths[] = { "unit-test-invalidate-unused.slang" };
+    spInvalidateFiles(request, unusedPaths, 1);
+    const InvalidateResult unchanged = _compileAndReset(request, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(unchanged.result) && unchanged.code == changed.code && unchanged.parseCount == 1);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+
+    File::remove(helperPath);
+    File::remove(otherPath);
+}
+
+SLANG_UNIT_TEST("InvalidateFiles", invalidateFilesUnitTest);
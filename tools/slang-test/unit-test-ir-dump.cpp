@@ -0,0 +1,72 @@
+// unit-test-ir-dump.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void irDumpUnitTest()
+{
+    static const char source[] =
+        "RWStructuredBuffer<float> gOutput;\n"
+        "float helper(float v) { return v * 2.0; }\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void irDumpMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = helper(float(tid.x));\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+
+    const char* args[] = { "-dump-ir-dir", ".", "-dump-ir-func", "irDumpMain", "-dump-ir-changes-only" };
+    SLANG_CHECK(SLANG_SUCCEEDED(spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args))));
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "ir-dump.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "irDumpMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    // Nothing is dumped to the diagnostics
+    SLANG_CHECK(strlen(spGetDiagnosticOutput(request)) == 0);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+
+    List<String> fileNames;
+    SLANG_CHECK(SLANG_SUCCEEDED(Path::getDirectoryContents(".", fileNames)));
+
+    // The initial dump of the entry point, and at least one after a pass that changed it.
+    // The module the translation unit is lowered to is dumped too.
+    String initialText;
+    Index passDumpCount = 0;
+    Index moduleDumpCount = 0;
+    for (const auto& fileName : fileNames)
+    {
+        if (fileName == "irDumpMain-hlsl-00-initial.slang-ir")
+            initialText = File::readAllText(fileName);
+        else if (fileName.startsWith("irDumpMain-hlsl-"))
+            passDumpCount++;
+        else if (fileName == "tu0-00-initial.slang-ir")
+            moduleDumpCount++;
+        else
+            continue;
+        File::remove(fileName);
+    }
+    SLANG_CHECK(moduleDumpCount == 1);
+    SLANG_CHECK(passDumpCount > 0);
+
+    // Only the named function is dumped
+    SLANG_CHECK(initialText.indexOf("func %irDumpMain") >= 0);
+    SLANG_CHECK(initialText.indexOf("func %helper") < 0);
+}
+
+SLANG_UNIT_TEST("IRDump", irDumpUnitTest);
@@ -0,0 +1,83 @@
+// unit-test-kernel-container.cpp
+
+#include "../../source/core/slang-kernel-container.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void kernelContainerUnitTest()
+{
+    // Sizes that aren't multiples of the alignment, so that padding is needed
+    const char vertexCode[] = "vertex";
+    List<uint8_t> fragmentCode;
+    for (int i = 0; i < 1001; ++i)
+    {
+        fragmentCode.add(uint8_t(i * 7));
+    }
+
+    KernelContainerWriter writer;
+    {
+        KernelContainerWriter::Kernel kernel;
+        kernel.target = SLANG_HLSL;
+        kernel.stage = SLANG_STAGE_VERTEX;
+        kernel.entryPointIndex = 0;
+        kernel.name = "vertexMain";
+        kernel.profile = "vs_5_0";
+        kernel.data = vertexCode;
+        kernel.size = sizeof(vertexCode) - 1;
+        writer.addKernel(kernel);
+
+        kernel.target = SLANG_DXBC;
+        kernel.stage = SLANG_STAGE_FRAGMENT;
+        kernel.entryPointIndex = 1;
+        kernel.name = "fragmentMain";
+        kernel.profile = "ps_5_0";
+        kernel.data = fragmentCode.getBuffer();
+        kernel.size = size_t(fragmentCode.getCount());
+        writer.addKernel(kernel);
+    }
+    writer.addDependency("shader.slang");
+    writer.addDependency("include/common.slang");
+
+    List<uint8_t> data;
+    SLANG_CHECK(SLANG_SUCCEEDED(writer.write(data)));
+
+    KernelContainerReader reader;
+    SLANG_CHECK(SLANG_SUCCEEDED(reader.init(data.getBuffer(), size_t(data.getCount()))));
+    SLANG_CHECK(reader.getKernelCount() == 2 && reader.getDependencyCount() == 2);
+
+    SLANG_CHECK(reader.getDependency(0) == "shader.slang" && reader.getDependency(1) == "include/common.slang");
+
+    {
+        const auto kernel = reader.getKernel(0);
+        SLANG_CHECK(kernel.target == SLANG_HLSL && kernel.stage == SLANG_STAGE_VERTEX && kernel.entryPointIndex == 0);
+        SLANG_CHECK(kernel.name == "vertexMain" && kernel.profile == "vs_5_0");
+        SLANG_CHECK(kernel.size == sizeof(vertexCode) - 1 && ::memcmp(kernel.data, vertexCode, kernel.size) == 0);
+    }
+    {
+        const Index index = reader.findKernel(SLANG_DXBC, UnownedStringSlice::fromLiteral("fragmentMain"));
+        SLANG_CHECK(index == 1);
+        const auto kernel = reader.getKernel(index);
+        SLANG_CHECK(kernel.stage == SLANG_STAGE_FRAGMENT && kernel.entryPointIndex == 1 && kernel.profile == "ps_5_0");
+        SLANG_CHECK(kernel.size == size_t(fragmentCode.getCount()) && ::memcmp(kernel.data, fragmentCode.getBuffer(), kernel.size) == 0);
+    }
+
+    // Kernels are aligned and point into the container, rather than being copied
+    for (Index i = 0; i < reader.getKernelCount(); ++i)
+    {
+        const uint8_t* kernelData = (const uint8_t*)reader.getKernel(i).data;
+        SLANG_CHECK(kernelData >= data.getBuffer() && kernelData < data.getBuffer() + data.getCount());
+        SLANG_CHECK(((kernelData - data.getBuffer()) % KernelContainerBinary::kDataAlignment) == 0);
+    }
+
+    // Not found for a different target
+    SLANG_CHECK(reader.findKernel(SLANG_HLSL, UnownedStringSlice::fromLiteral("fragmentMain")) < 0);
+
+    // Truncated or damaged data is rejected
+    SLANG_CHECK(SLANG_FAILED(reader.init(data.getBuffer(), size_t(data.getCount()) - 1)));
+    data[0] = 'X';
+    SLANG_CHECK(SLANG_FAILED(reader.init(data.getBuffer(), size_t(data.getCount()))));
+}
+
+SLANG_UNIT_TEST("KernelContainer", kernelContainerUnitTest);
@@ -0,0 +1,124 @@
+// unit-test-lz4.cpp
+
+#include "../../source/core/slang-lz4-util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+static bool _checkRoundTrip(const List<uint8_t>& data)
+{
+    List<uint8_t> compressed;
+    LZ4Util::compress(data.getBuffer(), size_t(data.getCount()), compressed);
+    if (size_t(compressed.getCount()) > LZ4Util::calcMaxCompressedSize(size_t(data.getCount())))
+    {
+        return false;
+    }
+
+    List<uint8_t> decompressed;
+    decompressed.setCount(data.getCount());
+    if (SLANG_FAILED(LZ4Util::decompress(compressed.getBuffer(), size_t(compressed.getCount()), decompressed.getBuffer(), size_t(decompressed.getCount()))))
+    {
+        return false;
+    }
+    return data.getCount() == 0 || ::memcmp(data.getBuffer(), decompressed.getBuffer(), size_t(data.getCount())) == 0;
+}
+
+static void lz4UnitTest()
+{
+    DefaultRandomGenerator randGen(0x3a7c91f2);
+
+    // Empty and tiny inputs are all literals
+    for (Index size = 0; size < 20; ++size)
+    {
+        List<uint8_t> data;
+        for (Index i = 0; i < size; ++i)
+        {
+            data.add(uint8_t(i & 3));
+        }
+        SLANG_CHECK(_checkRoundTrip(data));
+    }
+
+    // Random data can't be compressed, but must not expand by more than the bound
+    {
+        List<uint8_t> data;
+        for (Index i = 0; i < 100000; ++i)
+        {
+            data.add(uint8_t(randGen.nextInt32()));
+        }
+        SLANG_CHECK(_checkRoundTrip(data));
+    }
+
+    // Runs (overlapping matches) and long literal/match lengths
+    {
+        List<uint8_t> data;
+        for (Index i = 0; i < 1000; ++i)
+        {
+            data.add(0);
+        }
+        for (Index i = 0; i < 300; ++i)
+        {
+            data.add(uint8_t(randGen.nextInt32()));
+        }
+        for (Index i = 0; i < 5000; ++i)
+        {
+            data.add(uint8_t(i % 3));
+        }
+
+        List<uint8_t> compressed;
+        LZ4Util::compress(data.getBuffer(), size_t(data.getCount()), compressed);
+        SLANG_CHECK(compressed.getCount() < data.getCount() / 4);
+        SLANG_CHECK(_checkRoundTrip(data));
+    }
+
+    // Mixed data, with matches at a range of distances
+    for (int j = 0; j < 20; ++j)
+    {
+        List<uint8_t> data;
+        const Index size = randGen.nextInt32UpTo(200000);
+        for (Index i = 0; i < size; ++i)
+        {
+            if (i > 16 && randGen.nextInt32UpTo(4) != 0)
+            {
+                data.add(data[i - 1 - randGen.nextInt32UpTo(int32_t(Math::Min(i - 1, Index(70000))))]);
+            }
+            else
+            {
+                data.add(uint8_t(randGen.nextInt32UpTo(8)));
+            }
+        }
+        SLANG_CHECK(_checkRoundTrip(data));
+    }
+
+    // Corrupt or truncated data, or the wrong size, should fail rather than overrun
+    {
+        List<uint8_t> data;
+        for (Index i = 0; i < 4000; ++i)
+        {
+            data.add(uint8_t((i * 7) % 13));
+        }
+        List<uint8_t> compressed;
+        LZ4Util::compress(data.getBuffer(), size_t(data.getCount()), compressed);
+
+        List<uint8_t> decompressed;
+        decompressed.setCount(data.getCount());
+        SLANG_CHECK(SLANG_FAILED(LZ4Util::decompress(compressed.getBuffer(), size_t(compressed.getCount() - 3), decompressed.getBuffer(), size_t(decompressed.getCount()))));
+        SLANG_CHECK(SLANG_FAILED(LZ4Util::decompress(compressed.getBuffer(), size_t(compressed.getCount()), decompressed.getBuffer(), size_t(decompressed.getCount() - 1))));
+
+        for (int j = 0; j < 100; ++j)
+        {
+            List<uint8_t> corrupt(compressed);
+            corrupt[randGen.nextInt32UpTo(int32_t(corrupt.getCount()))] = uint8_t(randGen.nextInt32());
+            // Can succeed (if the change is benign), but must not crash
+            LZ4Util::decompress(corrupt.getBuffer(), size_t(corrupt.getCount()), decompressed.getBuffer(), size_t(decompressed.getCount()));
+        }
+    }
+}
+
+SLANG_UNIT_TEST("LZ4", lz4UnitTest);
@@ -264,9 +264,37 @@ static void memoryArenaUnitTest()
     }
     {
         // Do lots of allocations and test out rewind
-        
+        MemoryArena arena(1024);
 
+        void* before = arena.allocate(16);
+        ::memset(before, 0x5a, 16);
 
+        const void* cursor = arena.getCursor();
+        {
+            MemoryArena::RewindScope outerScope(arena);
+            for (Index i = 0; i < 100; ++i)
+            {
+                // Some allocations are larger than a block
+                arena.allocate((i % 10 == 0) ? 4096 : 100);
+            }
+            {
+                MemoryArena::RewindScope innerScope(arena);
+                arena.allocate(2000);
+            }
+        }
+
+        // Everything allocated in the scope is gone, and the allocation from before it is intact
+        SLANG_CHECK(arena.getCursor() == cursor);
+        SLANG_CHECK(arena.isValid(before, 16) && hasValue((uint8_t*)before, 16, 0x5a));
+
+        // Each thread has its own temporary arena
+        MemoryArena& threadArena = MemoryArena::getThreadTemporaryArena();
+        SLANG_CHECK(&threadArena == &MemoryArena::getThreadTemporaryArena());
+        {
+            MemoryArena::RewindScope scope(threadArena);
+            void* mem = threadArena.allocate(64);
+            SLANG_CHECK(mem && threadArena.isValid(mem, 64));
+        }
     }
 }
 
@@ -0,0 +1,52 @@
+// unit-test-memory-stats.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static void memoryStatsUnitTest()
+{
+    static const char source[] =
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = float(tid.x) * 2.0;\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "memory-stats.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangMemoryStats before;
+    spGetCompileRequestMemoryStats(request, &before);
+    SLANG_CHECK(before.irBytes == 0 && before.outputBytes == 0);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    SlangMemoryStats after;
+    spGetCompileRequestMemoryStats(request, &after);
+    SLANG_CHECK(after.irBytes > 0 && after.astBytes > before.astBytes);
+    SLANG_CHECK(after.sourceBytes >= SlangInt(sizeof(source) - 1) && after.sourceLocBytes > 0);
+    SLANG_CHECK(after.nameBytes > 0 && after.cacheBytes > 0 && after.outputBytes > 0);
+
+    // The session holds the standard library
+    SlangMemoryStats sessionStats;
+    spGetSessionMemoryStats(session, &sessionStats);
+    SLANG_CHECK(sessionStats.astBytes > after.astBytes && sessionStats.sourceBytes > 0 && sessionStats.nameBytes > after.nameBytes);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("MemoryStats", memoryStatsUnitTest);
@@ -56,6 +56,16 @@ static void pathUnitTest()
 
 
     }
+    // Test listing directories (tests are run from the root of the repository)
+    {
+        List<String> names;
+        SLANG_CHECK(SLANG_SUCCEEDED(Path::getDirectoryContents("source/core", names)));
+        SLANG_CHECK(names.indexOf("slang-io.cpp") >= 0);
+        SLANG_CHECK(names.indexOf(".") < 0 && names.indexOf("..") < 0);
+
+        SLANG_CHECK(Path::getDirectoryContents("source/core/does-not-exist", names) == SLANG_E_NOT_FOUND);
+        SLANG_CHECK(Path::getDirectoryContents("source/core/slang-io.cpp", names) == SLANG_E_NOT_FOUND);
+    }
 }
 
 SLANG_UNIT_TEST("Path", pathUnitTest);
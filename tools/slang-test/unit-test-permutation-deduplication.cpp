@@ -0,0 +1,101 @@
+// unit-test-permutation-deduplication.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct PermutationResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+    bool wasParsed = false;
+};
+
+} // anonymous
+
+static PermutationResult _compilePermutation(slang::ISession* session, char const* scale, char const* unused)
+{
+    static const char source[] =
+        "#if UNUSED == 3\n"
+        "float unusedHelper() { return 3; }\n"
+        "#endif\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = tid.x * SCALE;\n"
+        "}\n";
+
+    PermutationResult result;
+
+    SlangCompileRequest* request = nullptr;
+    if (SLANG_FAILED(session->createCompileRequest(&request)))
+        return result;
+
+    spSetPermutationDeduplicationEnabled(request, true);
+    spSetProfilingEnabled(request, true);
+    spAddPreprocessorDefine(request, "SCALE", scale);
+    spAddPreprocessorDefine(request, "UNUSED", unused);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "permutation.slang", source);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    result.result = spCompile(request);
+    if (SLANG_SUCCEEDED(result.result))
+    {
+        result.code = spGetEntryPointSource(request, entryPointIndex);
+    }
+
+    // Parsing is skipped when the outputs of an earlier permutation are used
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_SUCCEEDED(spGetProfileEvent(request, i, &event)) && strcmp(event.name, "parse") == 0)
+            result.wasParsed = true;
+    }
+
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+static void permutationDeduplicationUnitTest()
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(SLANG_SUCCEEDED(slang::createGlobalSession(globalSession.writeRef())));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("cs_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    const PermutationResult first = _compilePermutation(session, "2", "1");
+    SLANG_CHECK(SLANG_SUCCEEDED(first.result) && first.wasParsed && first.code.getLength() > 0);
+
+    // A define that doesn't change the tokens reuses the first outputs
+    const PermutationResult same = _compilePermutation(session, "2", "2");
+    SLANG_CHECK(SLANG_SUCCEEDED(same.result) && !same.wasParsed && same.code == first.code);
+
+    // Defines that do change the tokens are compiled
+    const PermutationResult differentScale = _compilePermutation(session, "4", "1");
+    SLANG_CHECK(SLANG_SUCCEEDED(differentScale.result) && differentScale.wasParsed && differentScale.code != first.code);
+
+    const PermutationResult withHelper = _compilePermutation(session, "2", "3");
+    SLANG_CHECK(SLANG_SUCCEEDED(withHelper.result) && withHelper.wasParsed);
+}
+
+SLANG_UNIT_TEST("PermutationDeduplication", permutationDeduplicationUnitTest);
@@ -0,0 +1,121 @@
+// unit-test-precompiled-module.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kLibPath[] = "unit-test-precompiled-lib.slang";
+static const char kPrecompiledPath[] = "unit-test-precompiled-lib.slang-precompiled";
+
+static SlangResult _precompileLib(SlangSession* session)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    spSetOutputContainerFormat(request, SLANG_CONTAINER_FORMAT_PRECOMPILED_MODULE);
+
+    // The module is compiled with the name it is imported by
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, "unit_test_precompiled_lib");
+    spAddTranslationUnitSourceFile(request, translationUnitIndex, kLibPath);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        size_t size = 0;
+        const void* data = spGetCompileRequestCode(request, &size);
+        if (data && size)
+        {
+            FileStream stream(kPrecompiledPath, FileMode::Create);
+            stream.Write(data, Int64(size));
+        }
+        else
+        {
+            res = SLANG_FAIL;
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return res;
+}
+
+static String _compileApp(SlangSession* session)
+{
+    static const char source[] =
+        "import unit_test_precompiled_lib;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    Scaler scaler = { 2.0f };\n"
+        "    gOutput[tid.x] = offset(applyScale(scaler, float(tid.x)));\n"
+        "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spSetLineDirectiveMode(request, SLANG_LINE_DIRECTIVE_MODE_NONE);
+    spAddSearchPath(request, ".");
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "unit-test-precompiled-app.slang", source);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    String code;
+    if (SLANG_SUCCEEDED(spCompile(request)))
+    {
+        code = spGetEntryPointSource(request, entryPointIndex);
+    }
+
+    spDestroyCompileRequest(request);
+    return code;
+}
+
+static void precompiledModuleUnitTest()
+{
+    static const char libSource[] =
+        "interface IScale { float scale(float x); };\n"
+        "struct Scaler : IScale { float factor; float scale(float x) { return x * factor; } };\n"
+        "float applyScale<T : IScale>(T t, float x) { return t.scale(x) + 1.0f; }\n"
+        "float offset(float x, float y = 3.0f) { return x + y; }\n"
+        "float unused(float x) { return offset(x) * 4.0f; }\n";
+    static const char changedLibSource[] =
+        "interface IScale { float scale(float x); };\n"
+        "struct Scaler : IScale { float factor; float scale(float x) { return x - factor; } };\n"
+        "float applyScale<T : IScale>(T t, float x) { return t.scale(x) + 1.0f; }\n"
+        "float offset(float x, float y = 3.0f) { return x + y; }\n";
+    File::writeAllText(kLibPath, libSource);
+
+    File::remove(kPrecompiledPath);
+
+    SlangSession* session = spCreateSession(nullptr);
+
+    const String fromSource = _compileApp(session);
+    SLANG_CHECK(fromSource.getLength() > 0);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(_precompileLib(session)));
+
+    // Each compile is a new request, so the module is loaded each time. The IR of the
+    // precompiled module is only read as it is linked against, which gives the same code.
+    const String fromPrecompiled = _compileApp(session);
+    SLANG_CHECK(fromPrecompiled.getLength() > 0 && fromPrecompiled == fromSource);
+
+    // The precompiled module can be used without the source
+    File::remove(kLibPath);
+    SLANG_CHECK(_compileApp(session) == fromPrecompiled);
+
+    // If the source has changed the precompiled module is out of date, and the source is used
+    File::writeAllText(kLibPath, changedLibSource);
+    const String fromChangedSource = _compileApp(session);
+    SLANG_CHECK(fromChangedSource.getLength() > 0 && fromChangedSource != fromPrecompiled);
+
+    spDestroySession(session);
+
+    File::remove(kLibPath);
+    File::remove(kPrecompiledPath);
+}
+
+SLANG_UNIT_TEST("PrecompiledModule", precompiledModuleUnitTest);
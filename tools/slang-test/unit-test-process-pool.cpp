@@ -0,0 +1,104 @@
+// unit-test-process-pool.cpp
+
+#include "../../source/core/slang-process-pool.h"
+
+#include "test-context.h"
+
+#include <atomic>
+
+using namespace Slang;
+
+namespace { // anonymous
+
+class TestListener : public ProcessListener
+{
+public:
+    virtual void onOutput(ProcessOutputStream stream, const UnownedStringSlice& text) SLANG_OVERRIDE
+    {
+        // Calls are never concurrent, so no lock is needed
+        (stream == ProcessOutputStream::StandardOutput ? m_standardOutput : m_standardError).append(text);
+    }
+    virtual void onComplete(SlangResult result, const ExecuteResult& executeResult) SLANG_OVERRIDE
+    {
+        m_result = result;
+        m_resultCode = executeResult.resultCode;
+        m_completeCount++;
+    }
+
+    StringBuilder m_standardOutput;
+    StringBuilder m_standardError;
+    SlangResult m_result = SLANG_FAIL;
+    ExecuteResult::ResultCode m_resultCode = -1;
+    std::atomic<int> m_completeCount{0};
+};
+
+} // anonymous
+
+// Writes its index to stdout, "err" to stderr, and exits with its index
+static void _calcCommandLine(int index, CommandLine& outCmdLine)
+{
+    StringBuilder script;
+#if SLANG_WINDOWS_FAMILY
+    outCmdLine.setExecutableFilename("cmd");
+    outCmdLine.addArg("/c");
+    script << "echo " << index << "& >&2 echo err& exit /b " << index;
+#else
+    outCmdLine.setExecutableFilename("sh");
+    outCmdLine.addArg("-c");
+    script << "echo " << index << "; echo err 1>&2; exit " << index;
+#endif
+    outCmdLine.addArg(script);
+}
+
+static void processPoolUnitTest()
+{
+    enum { kProcessCount = 4 };
+
+    TestListener listeners[kProcessCount];
+    List<RefPtr<ProcessTask>> tasks;
+    {
+        ProcessPool pool(2);
+        SLANG_CHECK(pool.getMaxProcessCount() == 2);
+
+        for (int i = 0; i < kProcessCount; ++i)
+        {
+            CommandLine cmdLine;
+            _calcCommandLine(i, cmdLine);
+            tasks.add(pool.spawn(cmdLine, &listeners[i]));
+        }
+
+        // Each can be waited on, in any order
+        SLANG_CHECK(SLANG_SUCCEEDED(tasks[kProcessCount - 1]->wait()));
+        SLANG_CHECK(tasks[kProcessCount - 1]->isComplete());
+
+        pool.waitForAll();
+    }
+
+    for (int i = 0; i < kProcessCount; ++i)
+    {
+        ProcessTask* task = tasks[i];
+        const ExecuteResult& exeRes = task->getExecuteResult();
+        SLANG_CHECK(task->isComplete() && SLANG_SUCCEEDED(task->wait()));
+        SLANG_CHECK(exeRes.resultCode == i);
+        StringBuilder expectedOutput;
+        expectedOutput << i << "\n";
+        SLANG_CHECK(exeRes.standardOutput == expectedOutput && exeRes.standardError == "err\n");
+
+        // The listener saw all the output, and the completion
+        const TestListener& listener = listeners[i];
+        SLANG_CHECK(listener.m_completeCount == 1 && SLANG_SUCCEEDED(listener.m_result) && listener.m_resultCode == i);
+        SLANG_CHECK(listener.m_standardOutput == exeRes.standardOutput && listener.m_standardError == exeRes.standardError);
+    }
+
+    // A process that can't be run fails, and is still complete
+    {
+        ProcessPool pool(1);
+        CommandLine cmdLine;
+        cmdLine.setExecutableFilename("slang-process-pool-unit-test-missing-executable");
+        RefPtr<ProcessTask> task = pool.spawn(cmdLine);
+        task->wait();
+        SLANG_CHECK(task->isComplete());
+    }
+}
+
+SLANG_UNIT_TEST("ProcessPool", processPoolUnitTest);
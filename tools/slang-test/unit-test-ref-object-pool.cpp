@@ -0,0 +1,99 @@
+// unit-test-ref-object-pool.cpp
+
+#include "../../source/core/slang-ref-object-pool.h"
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+namespace // anonymous
+{
+
+struct PooledObject : RefObject
+{
+    SLANG_REF_OBJECT_POOL_ALLOCATED
+
+    PooledObject(Int inValue) : value(inValue) {}
+
+    Int value;
+};
+
+// Derived types use the base's allocation, whatever their size
+struct LargePooledObject : PooledObject
+{
+    LargePooledObject(Int inValue) : PooledObject(inValue) {}
+
+    uint8_t data[RefObjectPool::kMaxPooledSize];
+};
+
+} // anonymous
+
+static bool _isAligned(void* ptr)
+{
+    return (size_t(ptr) & (RefObjectPool::kAlignment - 1)) == 0;
+}
+
+static void refObjectPoolUnitTest()
+{
+    const auto& stats = RefObjectAllocationStats::getForThread();
+
+    // Without a pool objects come from the heap
+    {
+        const Int heapCount = stats.heapCount;
+        RefPtr<PooledObject> obj = new PooledObject(1);
+        SLANG_CHECK(obj->value == 1 && _isAligned(obj.Ptr()));
+        SLANG_CHECK(stats.heapCount == heapCount + 1);
+    }
+
+    RefPtr<RefObjectPool> pool = new RefObjectPool();
+    List<RefPtr<PooledObject>> objects;
+    {
+        RefObjectPoolScope scope(pool);
+        SLANG_CHECK(RefObjectPool::getCurrent() == pool);
+
+        // Objects are freed in random order, and their memory reused
+        DefaultRandomGenerator randGen(0x5123);
+        for (Int i = 0; i < 1000; ++i)
+        {
+            objects.add(new PooledObject(i));
+            if (randGen.nextInt32UpTo(3) == 0)
+            {
+                objects.removeAt(randGen.nextInt32UpTo(int(objects.getCount())));
+            }
+        }
+        SLANG_CHECK(pool->getLiveCount() == objects.getCount());
+        for (auto& obj : objects)
+        {
+            SLANG_CHECK(_isAligned(obj.Ptr()));
+        }
+
+        // Objects too large for a size class come from the heap
+        const Int heapCount = stats.heapCount;
+        RefPtr<PooledObject> large = new LargePooledObject(-1);
+        SLANG_CHECK(stats.heapCount == heapCount + 1 && pool->getLiveCount() == objects.getCount());
+
+        {
+            // Scopes nest
+            RefObjectPoolScope heapScope(nullptr);
+            SLANG_CHECK(RefObjectPool::getCurrent() == nullptr);
+        }
+        SLANG_CHECK(RefObjectPool::getCurrent() == pool);
+    }
+    SLANG_CHECK(RefObjectPool::getCurrent() == nullptr);
+
+    // The objects keep the pool alive
+    RefObjectPool* poolPtr = pool;
+    pool.setNull();
+    SLANG_CHECK(poolPtr->getLiveCount() == objects.getCount() && poolPtr->calcBlockCount() > 0);
+
+    for (Index i = 0; i < objects.getCount(); ++i)
+    {
+        SLANG_CHECK(objects[i]->value >= 0);
+    }
+    objects.clear();
+}
+
+SLANG_UNIT_TEST("RefObjectPool", refObjectPoolUnitTest);
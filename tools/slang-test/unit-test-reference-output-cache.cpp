@@ -0,0 +1,80 @@
+// unit-test-reference-output-cache.cpp
+
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+#include "os.h"
+
+using namespace Slang;
+
+static void referenceOutputCacheUnitTest()
+{
+    const String directory("reference-output-cache-unit-test");
+    Path::createDirectory(directory);
+
+    const String sourcePath = Path::combine(directory, "source.hlsl");
+    const String headerPath = Path::combine(directory, "header.h");
+    const String cacheDirectory = Path::combine(directory, "cache");
+
+    // The header holds a value unique to this run, so that entries left from earlier runs aren't found
+    StringBuilder header;
+    header << "static const int header = " << int64_t(ProcessUtil::getClockTick()) << ";\n";
+    File::writeAllText(headerPath, header);
+    File::writeAllText(sourcePath, "#include \"header.h\"\nfloat4 main() : SV_Target { return header; }\n");
+
+    CommandLine cmdLine;
+    cmdLine.setExecutableFilename("slangc");
+    cmdLine.addArg(sourcePath);
+    cmdLine.addArg("-pass-through");
+    cmdLine.addArg("fxc");
+
+    ExecuteResult result;
+    result.resultCode = 1;
+    result.standardOutput = "output\nwith lines\n";
+    result.standardError = "";
+
+    ReferenceOutputCache cache;
+
+    // Nothing is cached without a directory
+    const String key = cache.calcKey(".", cmdLine, "fxc", sourcePath);
+    SLANG_CHECK(!cache.isEnabled() && SLANG_SUCCEEDED(cache.add(key, result)));
+    ExecuteResult foundResult;
+    SLANG_CHECK(!cache.find(key, foundResult));
+
+    cache.setDirectory(cacheDirectory);
+
+    // An added output is found
+    SLANG_CHECK(!cache.find(key, foundResult));
+    SLANG_CHECK(SLANG_SUCCEEDED(cache.add(key, result)));
+    SLANG_CHECK(cache.find(key, foundResult) && cache.getHitCount() == 1);
+    SLANG_CHECK(foundResult.resultCode == result.resultCode &&
+        foundResult.standardOutput == result.standardOutput &&
+        foundResult.standardError == result.standardError);
+
+    // The key is the same if nothing changes
+    SLANG_CHECK(cache.calcKey(".", cmdLine, "fxc", sourcePath) == key);
+
+    // Changing the command line changes the key
+    CommandLine otherCmdLine(cmdLine);
+    otherCmdLine.addArg("-D");
+    otherCmdLine.addArg("OTHER");
+    SLANG_CHECK(cache.calcKey(".", otherCmdLine, "fxc", sourcePath) != key);
+
+    // As does changing an included file
+    header << "static const int header2 = 0;\n";
+    File::writeAllText(headerPath, header);
+    const String changedKey = cache.calcKey(".", cmdLine, "fxc", sourcePath);
+    SLANG_CHECK(changedKey != key && !cache.find(changedKey, foundResult));
+
+    // Directory paths passed to osFindFilesInDirectory must end with a separator
+    for (const auto& path : osFindFilesInDirectory(cacheDirectory + "/"))
+    {
+        File::remove(path);
+    }
+    File::remove(cacheDirectory);
+    File::remove(headerPath);
+    File::remove(sourcePath);
+    File::remove(directory);
+}
+
+SLANG_UNIT_TEST("ReferenceOutputCache", referenceOutputCacheUnitTest);
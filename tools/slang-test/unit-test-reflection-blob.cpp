@@ -0,0 +1,160 @@
+// unit-test-reflection-blob.cpp
+
+#include "../../slang-reflection-blob.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static bool _areStringsEqual(char const* a, char const* b)
+{
+    return (a == nullptr && b == nullptr) || (a && b && strcmp(a, b) == 0);
+}
+
+static void _checkTypeLayout(slang::TypeLayoutReflection* expected, slang::ReflectionBlob::TypeLayout typeLayout, Index depth);
+
+static void _checkVarLayout(slang::VariableLayoutReflection* expected, slang::ReflectionBlob::VariableLayout varLayout, Index depth)
+{
+    SLANG_CHECK((expected != nullptr) == bool(varLayout));
+    if (!expected || !varLayout)
+        return;
+
+    SLANG_CHECK(_areStringsEqual(expected->getVariable() ? expected->getName() : nullptr, varLayout.getName()));
+    SLANG_CHECK(_areStringsEqual(expected->getSemanticName(), varLayout.getSemanticName()));
+    SLANG_CHECK(expected->getSemanticIndex() == varLayout.getSemanticIndex());
+    SLANG_CHECK(expected->getStage() == varLayout.getStage());
+    SLANG_CHECK(expected->getBindingIndex() == varLayout.getBindingIndex());
+    SLANG_CHECK(expected->getBindingSpace() == varLayout.getBindingSpace());
+
+    for (SlangParameterCategory category = 0; category < SLANG_PARAMETER_CATEGORY_COUNT; ++category)
+    {
+        SLANG_CHECK(expected->getOffset(category) == varLayout.getOffset(category));
+        SLANG_CHECK(expected->getBindingSpace(category) == varLayout.getBindingSpace(category));
+    }
+
+    _checkTypeLayout(expected->getTypeLayout(), varLayout.getTypeLayout(), depth + 1);
+}
+
+static void _checkTypeLayout(slang::TypeLayoutReflection* expected, slang::ReflectionBlob::TypeLayout typeLayout, Index depth)
+{
+    SLANG_CHECK((expected != nullptr) == bool(typeLayout));
+    // Types can refer to themselves, so the comparison stops at some depth
+    if (!expected || !typeLayout || depth > 16)
+        return;
+
+    SLANG_CHECK(expected->getKind() == typeLayout.getKind());
+    SLANG_CHECK(_areStringsEqual(expected->getName(), typeLayout.getName()));
+    SLANG_CHECK(expected->getScalarType() == typeLayout.getScalarType());
+    SLANG_CHECK(expected->getRowCount() == typeLayout.getRowCount());
+    SLANG_CHECK(expected->getColumnCount() == typeLayout.getColumnCount());
+    SLANG_CHECK(expected->getResourceShape() == typeLayout.getResourceShape());
+    SLANG_CHECK(expected->getResourceAccess() == typeLayout.getResourceAccess());
+    SLANG_CHECK(expected->getElementCount() == typeLayout.getElementCount());
+    SLANG_CHECK(expected->getParameterCategory() == typeLayout.getParameterCategory());
+    SLANG_CHECK(expected->getMatrixLayoutMode() == typeLayout.getMatrixLayoutMode());
+
+    SLANG_CHECK(expected->getCategoryCount() == typeLayout.getCategoryCount());
+    for (unsigned i = 0; i < expected->getCategoryCount(); ++i)
+        SLANG_CHECK(expected->getCategoryByIndex(i) == typeLayout.getCategoryByIndex(i));
+
+    for (SlangParameterCategory category = 0; category < SLANG_PARAMETER_CATEGORY_COUNT; ++category)
+    {
+        SLANG_CHECK(expected->getSize(category) == typeLayout.getSize(category));
+        SLANG_CHECK(expected->getElementStride(category) == typeLayout.getElementStride(category));
+    }
+
+    if (expected->getKind() == slang::TypeReflection::Kind::Struct)
+    {
+        SLANG_CHECK(expected->getFieldCount() == typeLayout.getFieldCount());
+        for (unsigned i = 0; i < expected->getFieldCount(); ++i)
+            _checkVarLayout(expected->getFieldByIndex(i), typeLayout.getFieldByIndex(i), depth + 1);
+    }
+
+    _checkTypeLayout(expected->getElementTypeLayout(), typeLayout.getElementTypeLayout(), depth + 1);
+    _checkVarLayout(expected->getElementVarLayout(), typeLayout.getElementVarLayout(), depth + 1);
+}
+
+static void _checkReflectionBlob(SlangSession* session, SlangCompileTarget target, char const* profile)
+{
+    static const char source[] =
+        "struct Material { float4 color; Texture2D albedo; SamplerState linearSampler; float roughness[3]; };\n"
+        "struct View { float4x4 viewProjection; Texture2D shadows[4]; };\n"
+        "ParameterBlock<View> gView;\n"
+        "ConstantBuffer<Material> gMaterial;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "cbuffer Globals { float gScale; };\n"
+        "[numthreads(8, 4, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID, uniform float extra)\n"
+        "{\n"
+        "    gOutput[tid.x] = gMaterial.color.x * gScale * extra + gView.viewProjection[0][0] +\n"
+        "        gMaterial.albedo.SampleLevel(gMaterial.linearSampler, float2(0, 0), 0).x + gMaterial.roughness[tid.y];\n"
+        "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, target);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, profile));
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "reflection-blob.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    auto reflection = slang::ProgramLayout::get(request);
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_SUCCEEDED(reflection->writeBlob(blob.writeRef())));
+
+    // The reader only uses its own copy of the contents, not anything held by the request
+    List<uint8_t> data;
+    data.addRange((const uint8_t*)blob->getBufferPointer(), Index(blob->getBufferSize()));
+
+    slang::ReflectionBlob reader;
+    SLANG_CHECK(SLANG_SUCCEEDED(reader.init(data.getBuffer(), size_t(data.getCount()))));
+
+    SLANG_CHECK(reflection->getParameterCount() == reader.getParameterCount());
+    for (unsigned i = 0; i < reflection->getParameterCount(); ++i)
+        _checkVarLayout(reflection->getParameterByIndex(i), reader.getParameterByIndex(i), 0);
+
+    SLANG_CHECK(reflection->getGlobalConstantBufferBinding() == reader.getGlobalConstantBufferBinding());
+    SLANG_CHECK(reflection->getGlobalConstantBufferSize() == reader.getGlobalConstantBufferSize());
+
+    SLANG_CHECK(reflection->getEntryPointCount() == reader.getEntryPointCount());
+    for (SlangUInt i = 0; i < reflection->getEntryPointCount(); ++i)
+    {
+        auto expected = reflection->getEntryPointByIndex(i);
+        auto entryPoint = reader.getEntryPointByIndex(i);
+        SLANG_CHECK(_areStringsEqual(expected->getName(), entryPoint.getName()));
+        SLANG_CHECK(expected->getStage() == entryPoint.getStage());
+        SLANG_CHECK(bool(reader.findEntryPointByName(expected->getName())));
+
+        SlangUInt expectedSize[3], size[3];
+        expected->getComputeThreadGroupSize(3, expectedSize);
+        entryPoint.getComputeThreadGroupSize(3, size);
+        SLANG_CHECK(expectedSize[0] == size[0] && expectedSize[1] == size[1] && expectedSize[2] == size[2]);
+
+        SLANG_CHECK(expected->getParameterCount() == entryPoint.getParameterCount());
+        for (unsigned j = 0; j < expected->getParameterCount(); ++j)
+            _checkVarLayout(expected->getParameterByIndex(j), entryPoint.getParameterByIndex(j), 0);
+    }
+
+    spDestroyCompileRequest(request);
+
+    // A blob that is cut short, or isn't a reflection blob, is rejected
+    SLANG_CHECK(SLANG_FAILED(reader.init(data.getBuffer(), size_t(data.getCount()) / 2)));
+    data[0] ^= 0xff;
+    SLANG_CHECK(SLANG_FAILED(reader.init(data.getBuffer(), size_t(data.getCount()))));
+}
+
+static void reflectionBlobUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    _checkReflectionBlob(session, SLANG_HLSL, "cs_5_1");
+    _checkReflectionBlob(session, SLANG_GLSL, "glsl_450");
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("ReflectionBlob", reflectionBlobUnitTest);
@@ -0,0 +1,97 @@
+// unit-test-reset-compile-request.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct PermutationResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+    String diagnostics;
+    Index parseCount = 0;
+};
+
+} // anonymous
+
+static PermutationResult _compilePermutation(SlangCompileRequest* request, char const* scale, char const* body)
+{
+    PermutationResult result;
+
+    spAddPreprocessorDefine(request, "SCALE", scale);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "permutation.slang", body);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(translationUnitIndex == 0 && entryPointIndex == 0);
+
+    result.result = spCompile(request);
+    if (SLANG_SUCCEEDED(result.result))
+    {
+        result.code = spGetEntryPointSource(request, entryPointIndex);
+    }
+    result.diagnostics = spGetDiagnosticOutput(request);
+
+    // Each module that is parsed (the translation unit, and any module it imports) has an event
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_SUCCEEDED(spGetProfileEvent(request, i, &event)) && strcmp(event.name, "parse") == 0)
+            result.parseCount++;
+    }
+
+    spResetCompileRequest(request);
+    return result;
+}
+
+static void resetCompileRequestUnitTest()
+{
+    static const char helperPath[] = "unit-test-reset-helper.slang";
+    File::writeAllText(helperPath, "float helperValue() { return 3; }\n");
+
+    static const char source[] =
+        "import unit_test_reset_helper;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = helperValue() * SCALE;\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spAddSearchPath(request, ".");
+    spSetProfilingEnabled(request, true);
+
+    const PermutationResult first = _compilePermutation(request, "2", source);
+    SLANG_CHECK(SLANG_SUCCEEDED(first.result) && first.code.getLength() > 0 && first.parseCount == 2);
+
+    // The imported module is kept, so only the translation unit is parsed
+    const PermutationResult second = _compilePermutation(request, "4", source);
+    SLANG_CHECK(SLANG_SUCCEEDED(second.result) && second.code.getLength() > 0 && second.code != first.code && second.parseCount == 1);
+
+    // The diagnostics of a failed compile don't carry over to the next one
+    const PermutationResult failed = _compilePermutation(request, "2", "void computeMain() { undefinedFunction(); }\n");
+    SLANG_CHECK(SLANG_FAILED(failed.result) && failed.diagnostics.getLength() > 0);
+
+    const PermutationResult again = _compilePermutation(request, "2", source);
+    SLANG_CHECK(SLANG_SUCCEEDED(again.result) && again.code == first.code && again.diagnostics.getLength() == 0);
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+
+    File::remove(helperPath);
+}
+
+SLANG_UNIT_TEST("ResetCompileRequest", resetCompileRequestUnitTest);
@@ -0,0 +1,123 @@
+// unit-test-shared-module-cache.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+namespace { // anonymous
+
+struct CompileResult
+{
+    SlangResult result = SLANG_FAIL;
+    String code;
+    String diagnostics;
+    Index parseCount = 0;
+};
+
+} // anonymous
+
+static CompileResult _compile(SlangSession* session, bool useSharedModuleCache, char const* source)
+{
+    CompileResult result;
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spAddSearchPath(request, ".");
+    spSetProfilingEnabled(request, true);
+    spSetSharedModuleCacheEnabled(request, useSharedModuleCache);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "shared-module-cache.slang", source);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    result.result = spCompile(request);
+    if (SLANG_SUCCEEDED(result.result))
+    {
+        result.code = spGetEntryPointSource(request, entryPointIndex);
+    }
+    result.diagnostics = spGetDiagnosticOutput(request);
+
+    // Each module that is parsed (the translation unit, and any module it imports) has an event
+    const SlangInt eventCount = spGetProfileEventCount(request);
+    for (SlangInt i = 0; i < eventCount; ++i)
+    {
+        SlangProfileEvent event;
+        if (SLANG_SUCCEEDED(spGetProfileEvent(request, i, &event)) && strcmp(event.name, "parse") == 0)
+            result.parseCount++;
+    }
+
+    spDestroyCompileRequest(request);
+    return result;
+}
+
+static void sharedModuleCacheUnitTest()
+{
+    static const char helperPath[] = "unit-test-shared-module-helper.slang";
+    File::writeAllText(helperPath, "float helperValue() { return 3; }\nfloat otherHelperValue() { return 7; }\n");
+
+    static const char source[] =
+        "import unit_test_shared_module_helper;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = helperValue();\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+
+    const CompileResult first = _compile(session, true, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(first.result) && first.code.getLength() > 0 && first.parseCount == 2);
+
+    // Another request with the same options reuses the imported module, so only the translation unit is parsed
+    const CompileResult second = _compile(session, true, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(second.result) && second.code == first.code && second.parseCount == 1);
+
+    // The shared module's IR is linked against from its existing symbol table, which has every function
+    static const char otherSource[] =
+        "import unit_test_shared_module_helper;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = otherHelperValue();\n"
+        "}\n";
+    const CompileResult other = _compile(session, true, otherSource);
+    SLANG_CHECK(SLANG_SUCCEEDED(other.result) && other.parseCount == 1);
+    SLANG_CHECK(other.code.indexOf("(float) 7") >= 0 && other.code != first.code);
+
+    // Without the cache the module is loaded as normal
+    const CompileResult uncached = _compile(session, false, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(uncached.result) && uncached.code == first.code && uncached.parseCount == 2);
+
+    // If the file changes, the module is loaded again
+    File::writeAllText(helperPath, "float helperValue() { return 5; }\n");
+    const CompileResult changed = _compile(session, true, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(changed.result) && changed.code != first.code && changed.parseCount == 2);
+
+    // Errors in a module are reported by every request that imports it
+    File::writeAllText(helperPath, "float helperValue() { return undefinedValue; }\n");
+    const CompileResult failed = _compile(session, true, source);
+    SLANG_CHECK(SLANG_FAILED(failed.result) && failed.diagnostics.indexOf("undefinedValue") >= 0);
+    const CompileResult failedAgain = _compile(session, true, source);
+    SLANG_CHECK(SLANG_FAILED(failedAgain.result) && failedAgain.diagnostics == failed.diagnostics);
+
+    // Once it is fixed it can be shared again
+    File::writeAllText(helperPath, "float helperValue() { return 3; }\nfloat otherHelperValue() { return 7; }\n");
+    const CompileResult fixed = _compile(session, true, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(fixed.result) && fixed.code == first.code);
+    const CompileResult fixedAgain = _compile(session, true, source);
+    SLANG_CHECK(SLANG_SUCCEEDED(fixedAgain.result) && fixedAgain.code == first.code && fixedAgain.parseCount == 1);
+
+    spDestroySession(session);
+
+    File::remove(helperPath);
+}
+
+SLANG_UNIT_TEST("SharedModuleCache", sharedModuleCacheUnitTest);
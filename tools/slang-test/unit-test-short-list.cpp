@@ -0,0 +1,103 @@
+// unit-test-short-list.cpp
+
+#include "../../source/core/slang-short-list.h"
+
+#include "test-context.h"
+
+#include "../../source/core/slang-smart-pointer.h"
+
+using namespace Slang;
+
+namespace // anonymous
+{
+
+struct CountedObject : RefObject
+{
+    Int value = 0;
+};
+
+// Counts copies, to check elements are moved when a list grows
+struct CopyCounter
+{
+    static Int s_copyCount;
+
+    CopyCounter() {}
+    CopyCounter(const CopyCounter&) { s_copyCount++; }
+    CopyCounter(CopyCounter&&) {}
+    CopyCounter& operator=(const CopyCounter&) { s_copyCount++; return *this; }
+    CopyCounter& operator=(CopyCounter&&) { return *this; }
+};
+
+Int CopyCounter::s_copyCount = 0;
+
+} // anonymous
+
+static void shortListUnitTest()
+{
+    {
+        ShortList<Int, 4> list;
+        for (Int i = 0; i < 4; ++i)
+        {
+            list.add(i);
+        }
+        SLANG_CHECK(list.isShort() && list.getCount() == 4);
+
+        // Spills to the heap, keeping the elements
+        list.add(4);
+        SLANG_CHECK(!list.isShort() && list.getCount() == 5 && list.getCapacity() >= 5);
+        for (Int i = 0; i < 5; ++i)
+        {
+            SLANG_CHECK(list[i] == i);
+        }
+        SLANG_CHECK(list.indexOf(3) == 3 && !list.contains(7));
+
+        // Adding an element of the list itself when it has to grow
+        list.setCount(list.getCapacity());
+        list.add(list[0]);
+        SLANG_CHECK(list.getLast() == 0);
+
+        // Copies and moves
+        ShortList<Int, 4> copy(list);
+        SLANG_CHECK(copy.getCount() == list.getCount() && copy[4] == 4);
+        ShortList<Int, 4> moved(_Move(copy));
+        SLANG_CHECK(moved.getCount() == list.getCount() && copy.getCount() == 0 && copy.isShort());
+
+        ShortList<Int, 4> shortList;
+        shortList.add(10);
+        moved = _Move(shortList);
+        SLANG_CHECK(moved.getCount() == 1 && moved[0] == 10 && shortList.getCount() == 0);
+
+        List<Int> asList = list.toList();
+        SLANG_CHECK(asList.getCount() == list.getCount() && asList[4] == 4);
+    }
+
+    // Growing moves reference counted elements, rather than copying them
+    {
+        RefPtr<CountedObject> obj = new CountedObject();
+        {
+            ShortList<RefPtr<CountedObject>, 2> list;
+            for (Int i = 0; i < 10; ++i)
+            {
+                list.add(obj);
+            }
+            SLANG_CHECK(obj->debugGetReferenceCount() == 11);
+        }
+        SLANG_CHECK(obj->debugGetReferenceCount() == 1);
+    }
+
+    // List moves its elements when it grows, both when adding and inserting
+    {
+        List<CopyCounter> list;
+        CopyCounter counter;
+        // Fill to capacity, so the insert grows the list
+        for (Int i = 0; i < 128; ++i)
+        {
+            list.add(CopyCounter());
+        }
+        list.insert(0, counter);
+        list.addRange(&counter, 1);
+        SLANG_CHECK(CopyCounter::s_copyCount == 2);
+    }
+}
+
+SLANG_UNIT_TEST("ShortList", shortListUnitTest);
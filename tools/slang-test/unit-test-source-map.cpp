@@ -0,0 +1,143 @@
+// unit-test-source-map.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+#include "../../source/core/slang-source-map.h"
+#include "../../source/core/slang-string-util.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static SourceMap::Entry _makeEntry(uint32_t generatedLine, uint32_t generatedColumn, uint32_t fileIndex, uint32_t line, uint32_t column)
+{
+    SourceMap::Entry entry;
+    entry.generatedLine = generatedLine;
+    entry.generatedColumn = generatedColumn;
+    entry.fileIndex = fileIndex;
+    entry.line = line;
+    entry.column = column;
+    return entry;
+}
+
+static bool _isEqual(const SourceMap::Entry& a, const SourceMap::Entry& b)
+{
+    return a.generatedLine == b.generatedLine && a.generatedColumn == b.generatedColumn &&
+        a.fileIndex == b.fileIndex && a.line == b.line && a.column == b.column;
+}
+
+static void _checkSourceMapRoundTrip()
+{
+    SourceMap map;
+    SLANG_CHECK(map.addFile("a.slang") == 0);
+    SLANG_CHECK(map.addFile("b.slang") == 1);
+    SLANG_CHECK(map.addFile("a.slang") == 0);
+
+    map.addEntry(_makeEntry(1, 1, 0, 10, 5));
+    map.addEntry(_makeEntry(1, 20, 1, 3, 1));
+    map.addEntry(_makeEntry(300, 4, 0, 100000, 2));
+
+    map.offsetGeneratedLines(2);
+
+    List<uint8_t> data;
+    map.write(data);
+
+    SourceMap readMap;
+    SLANG_CHECK(SLANG_SUCCEEDED(readMap.read(data.getBuffer(), size_t(data.getCount()))));
+    SLANG_CHECK(readMap.getFileCount() == 2 && readMap.getFilePath(1) == "b.slang");
+    SLANG_CHECK(readMap.getEntryCount() == 3);
+    for (Index i = 0; i < map.getEntryCount(); ++i)
+    {
+        SLANG_CHECK(_isEqual(map.getEntry(i), readMap.getEntry(i)));
+    }
+
+    // Positions map as following a `#line` directive at each entry
+    SourceMap::Entry entry;
+    SLANG_CHECK(readMap.find(1, 1, entry) == SLANG_E_NOT_FOUND);
+    SLANG_CHECK(SLANG_SUCCEEDED(readMap.find(3, 10, entry)) && entry.fileIndex == 0 && entry.line == 10 && entry.column == 5);
+    SLANG_CHECK(SLANG_SUCCEEDED(readMap.find(3, 25, entry)) && entry.fileIndex == 1 && entry.line == 3);
+    SLANG_CHECK(SLANG_SUCCEEDED(readMap.find(5, 1, entry)) && entry.fileIndex == 1 && entry.line == 5 && entry.column == 0);
+    SLANG_CHECK(SLANG_SUCCEEDED(readMap.find(302, 4, entry)) && entry.fileIndex == 0 && entry.line == 100000);
+
+    // Truncated and corrupted maps are rejected
+    SLANG_CHECK(SLANG_FAILED(readMap.read(data.getBuffer(), size_t(data.getCount() - 1))));
+    SLANG_CHECK(SLANG_FAILED(readMap.read(data.getBuffer(), 3)));
+    data[0] ^= 0xff;
+    SLANG_CHECK(SLANG_FAILED(readMap.read(data.getBuffer(), size_t(data.getCount()))));
+    SLANG_CHECK(readMap.getEntryCount() == 0);
+}
+
+static void _checkCompileSourceMap()
+{
+    static const char source[] =
+        "RWStructuredBuffer<float> gOutput;\n"
+        "\n"
+        "float calc(float x)\n"
+        "{\n"
+        "    return x * 2.0f;\n"
+        "}\n"
+        "\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = calc(tid.x);\n"
+        "}\n";
+
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spSetLineDirectiveMode(request, SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "source-map.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    const SlangResult res = spCompile(request);
+    SLANG_CHECK(SLANG_SUCCEEDED(res));
+    if (SLANG_SUCCEEDED(res))
+    {
+        // The code is clean of line directives
+        const String code = spGetEntryPointSource(request, 0);
+        SLANG_CHECK(code.indexOf("#line") < 0);
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(spGetEntryPointSourceMap(request, 0, targetIndex, blob.writeRef())));
+
+        SourceMap map;
+        SLANG_CHECK(blob && SLANG_SUCCEEDED(map.read(blob->getBufferPointer(), blob->getBufferSize())));
+        SLANG_CHECK(map.getFileCount() == 1 && map.getFilePath(0) == "source-map.slang");
+        SLANG_CHECK(map.getEntryCount() > 0);
+
+        // The line storing to `gOutput` maps to its line in the source
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(code.getUnownedSlice(), lines);
+        bool foundStore = false;
+        for (Index i = 0; i < lines.getCount(); ++i)
+        {
+            const String line(lines[i]);
+            if (line.indexOf("gOutput") >= 0 && line.indexOf("=") >= 0)
+            {
+                SourceMap::Entry entry;
+                foundStore = SLANG_SUCCEEDED(map.find(uint32_t(i + 1), uint32_t(line.getLength()), entry)) && entry.line == 11;
+            }
+        }
+        SLANG_CHECK(foundStore);
+
+        SLANG_CHECK(spGetEntryPointSourceMap(request, 1, targetIndex, blob.writeRef()) == SLANG_ERROR_INVALID_PARAMETER);
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+}
+
+static void sourceMapUnitTest()
+{
+    _checkSourceMapRoundTrip();
+    _checkCompileSourceMap();
+}
+
+SLANG_UNIT_TEST("SourceMap", sourceMapUnitTest);
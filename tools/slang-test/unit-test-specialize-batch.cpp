@@ -0,0 +1,124 @@
+// unit-test-specialize-batch.cpp
+
+#include "../../slang.h"
+#include "../../slang-com-ptr.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static String _getEntryPointCode(slang::IProgram* program)
+{
+    ComPtr<ISlangBlob> code;
+    if (SLANG_FAILED(program->getEntryPointCode(0, 0, code.writeRef(), nullptr)))
+        return String();
+    return String((const char*)code->getBufferPointer(), (const char*)code->getBufferPointer() + code->getBufferSize());
+}
+
+static void specializeBatchUnitTest()
+{
+    static const char source[] =
+        "interface IShade { float shade(float x); };\n"
+        "interface IOffset { float offset(); };\n"
+        "struct Double : IShade { float shade(float x) { return x * 2; } };\n"
+        "struct Square : IShade { float shade(float x) { return x * x; } };\n"
+        "struct Zero : IOffset { float offset() { return 0; } };\n"
+        "struct Ten : IOffset { float unused; float offset() { return 10; } };\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "IShade gShade;\n"
+        "IOffset gOffset;\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = gShade.shade(float(tid.x)) + gOffset.offset();\n"
+        "}\n";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(SLANG_SUCCEEDED(slang::createGlobalSession(globalSession.writeRef())));
+
+    slang::TargetDesc targetDesc;
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("cs_5_0");
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.targetCount = 1;
+
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(SLANG_SUCCEEDED(globalSession->createSession(sessionDesc, session.writeRef())));
+
+    SlangCompileRequest* request = nullptr;
+    SLANG_CHECK(SLANG_SUCCEEDED(session->createCompileRequest(&request)));
+    spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "specialize-batch.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    ComPtr<slang::IProgram> program;
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompileRequest_getProgram(request, program.writeRef())));
+
+    auto reflection = slang::ProgramLayout::get(request);
+    slang::TypeReflection* shades[] = { reflection->findTypeByName("Double"), reflection->findTypeByName("Square") };
+    slang::TypeReflection* offsets[] = { reflection->findTypeByName("Zero"), reflection->findTypeByName("Ten") };
+
+    // Every combination of the types, with the types for each set adjacent
+    const Index setCount = 4;
+    List<slang::SpecializationArg> args;
+    for (Index i = 0; i < setCount; ++i)
+    {
+        slang::SpecializationArg arg;
+        arg.kind = slang::SpecializationArg::Kind::Type;
+        arg.type = shades[i & 1];
+        args.add(arg);
+        arg.type = offsets[i >> 1];
+        args.add(arg);
+    }
+
+    List<slang::IProgram*> batchPrograms;
+    batchPrograms.setCount(setCount);
+    SLANG_CHECK(SLANG_SUCCEEDED(session->specializeProgramBatch(
+        program, setCount, 2, args.getBuffer(), slang::kSpecializeBatchFlag_GenerateCode,
+        batchPrograms.getBuffer(), nullptr)));
+
+    // Each program in the batch is the same as one specialized by itself
+    for (Index i = 0; i < setCount; ++i)
+    {
+        SLANG_CHECK(batchPrograms[i] != nullptr);
+        if (!batchPrograms[i])
+            continue;
+
+        ComPtr<slang::IProgram> specializedProgram;
+        SLANG_CHECK(SLANG_SUCCEEDED(session->specializeProgram(program, 2, args.getBuffer() + i * 2, specializedProgram.writeRef(), nullptr)));
+
+        auto batchLayout = batchPrograms[i]->getLayout(0, nullptr);
+        auto layout = specializedProgram->getLayout(0, nullptr);
+        SLANG_CHECK(batchLayout && layout && batchLayout->getParameterCount() == layout->getParameterCount());
+
+        const String code = _getEntryPointCode(specializedProgram);
+        SLANG_CHECK(code.getLength() > 0 && code == _getEntryPointCode(batchPrograms[i]));
+
+        batchPrograms[i]->release();
+    }
+
+    // A type that doesn't conform to the interface of its slot fails the whole batch
+    args[2].type = offsets[0];
+    List<slang::IProgram*> failedPrograms;
+    failedPrograms.setCount(setCount);
+    for (auto& failedProgram : failedPrograms)
+        failedProgram = nullptr;
+
+    ComPtr<ISlangBlob> diagnostics;
+    SLANG_CHECK(SLANG_FAILED(session->specializeProgramBatch(
+        program, setCount, 2, args.getBuffer(), slang::kSpecializeBatchFlags_None,
+        failedPrograms.getBuffer(), diagnostics.writeRef())));
+    SLANG_CHECK(diagnostics != nullptr);
+    for (auto failedProgram : failedPrograms)
+        SLANG_CHECK(failedProgram == nullptr);
+
+    spDestroyCompileRequest(request);
+}
+
+SLANG_UNIT_TEST("SpecializeBatch", specializeBatchUnitTest);
@@ -0,0 +1,108 @@
+// unit-test-spirv-direct.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+// The kernels here are also run by the compute tests of the same names, which check their results on Vulkan.
+// As that needs a device, this checks that they are emitted directly, and are well formed, without one.
+
+static const uint32_t kSpvMagicNumber = 0x07230203;
+static const uint32_t kSpvOpEntryPoint = 15;
+static const uint32_t kSpvOpExecutionMode = 16;
+static const uint32_t kSpvExecutionModelGLCompute = 5;
+static const uint32_t kSpvExecutionModeLocalSize = 17;
+
+static SlangResult _compileSPIRV(const char* path, List<uint32_t>& outWords)
+{
+    SlangSession* session = spCreateSession(nullptr);
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_SPIRV);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "glsl_450"));
+    spSetTargetFlags(request, targetIndex, SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceFile(request, translationUnitIndex, path);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+
+    SlangResult res = spCompile(request);
+    if (SLANG_SUCCEEDED(res))
+    {
+        size_t size = 0;
+        const uint32_t* code = (const uint32_t*)spGetEntryPointCode(request, entryPointIndex, &size);
+        outWords.clear();
+        outWords.addRange(code, Index(size / sizeof(uint32_t)));
+    }
+
+    spDestroyCompileRequest(request);
+    spDestroySession(session);
+    return res;
+}
+
+    /// Returns true if words is a module emitted by the direct emitter, with a 4x1x1 compute entry point.
+    /// As with GLSL, the entry point is named main.
+static bool _isDirectComputeModule(const List<uint32_t>& words)
+{
+    // The generator is 0 for the direct emitter, and identifies glslang for the GLSL path
+    if (words.getCount() < 5 || words[0] != kSpvMagicNumber || words[2] != 0)
+    {
+        return false;
+    }
+
+    const uint32_t bound = words[3];
+    bool hasEntryPoint = false;
+    bool hasLocalSize = false;
+    for (Index i = 5; i < words.getCount(); )
+    {
+        const uint32_t wordCount = words[i] >> 16;
+        const uint32_t opcode = words[i] & 0xffff;
+        if (wordCount == 0 || i + Index(wordCount) > words.getCount())
+        {
+            return false;
+        }
+
+        if (opcode == kSpvOpEntryPoint && wordCount >= 4)
+        {
+            const char* name = (const char*)&words[i + 3];
+            hasEntryPoint = words[i + 1] == kSpvExecutionModelGLCompute && words[i + 2] < bound &&
+                strncmp(name, "main", (wordCount - 3) * sizeof(uint32_t)) == 0;
+        }
+        else if (opcode == kSpvOpExecutionMode && wordCount == 6 && words[i + 2] == kSpvExecutionModeLocalSize)
+        {
+            hasLocalSize = words[i + 3] == 4 && words[i + 4] == 1 && words[i + 5] == 1;
+        }
+        i += Index(wordCount);
+    }
+    return hasEntryPoint && hasLocalSize;
+}
+
+static void spirvDirectUnitTest()
+{
+    static const char* const directPaths[] =
+    {
+        "tests/compute/spirv-direct-scalar.slang",
+        "tests/compute/spirv-direct-vector.slang",
+        "tests/compute/spirv-direct-struct.slang",
+        "tests/compute/spirv-direct-loop.slang",
+    };
+
+    for (auto path : directPaths)
+    {
+        List<uint32_t> words;
+        SLANG_CHECK(SLANG_SUCCEEDED(_compileSPIRV(path, words)) && _isDirectComputeModule(words));
+    }
+
+    // Falls back to glslang, which may not be available
+    List<uint32_t> words;
+    if (SLANG_SUCCEEDED(_compileSPIRV("tests/compute/spirv-direct-fallback.slang", words)))
+    {
+        SLANG_CHECK(words.getCount() >= 5 && words[0] == kSpvMagicNumber && words[2] != 0);
+    }
+}
+
+SLANG_UNIT_TEST("SPIRVDirect", spirvDirectUnitTest);
@@ -0,0 +1,116 @@
+// unit-test-stream.cpp
+
+#include "../../source/core/slang-stream.h"
+
+#include "test-context.h"
+
+#include "../../source/core/slang-string-util.h"
+#include "../../source/core/slang-random-generator.h"
+
+using namespace Slang;
+
+static void streamUnitTest()
+{
+    List<uint8_t> data;
+    for (Index i = 0; i < 1000; ++i)
+    {
+        data.add(uint8_t(1 + (i * 7) % 255));
+    }
+
+    // Views of a blob's contents are not copies
+    {
+        ComPtr<ISlangBlob> blob(new StringBlob(UnownedStringSlice((const char*)data.getBuffer(), data.getCount())));
+        BlobStream stream(blob);
+        SLANG_CHECK(stream.isInMemory() && stream.CanRead() && !stream.CanWrite());
+
+        const uint8_t* view = (const uint8_t*)stream.readView(10);
+        SLANG_CHECK(view == (const uint8_t*)blob->getBufferPointer() && stream.GetPosition() == 10);
+
+        uint8_t buffer[10];
+        SLANG_CHECK(stream.Read(buffer, 10) == 10 && buffer[0] == data[10]);
+
+        // Can't view past the end
+        SLANG_CHECK(stream.readView(1000) == nullptr && stream.GetPosition() == 20);
+
+        stream.Seek(SeekOrigin::End, -5);
+        SLANG_CHECK(stream.Read(buffer, 10) == 5 && buffer[4] == data.getLast());
+
+        bool atEnd = false;
+        try
+        {
+            stream.Read(buffer, 1);
+        }
+        catch (const EndOfStreamException&)
+        {
+            atEnd = true;
+        }
+        SLANG_CHECK(atEnd && stream.IsEnd());
+    }
+
+    // A memory stream can provide views too
+    {
+        MemoryStream stream(FileAccess::ReadWrite);
+        stream.Write(data.getBuffer(), data.getCount());
+        stream.Seek(SeekOrigin::Start, 0);
+        SLANG_CHECK(stream.readView(4) == stream.m_contents.getBuffer() && stream.GetPosition() == 4);
+    }
+
+    // Buffered writes and reads, with random sizes either side of the buffer size
+    {
+        MemoryStream memoryStream(FileAccess::ReadWrite);
+        DefaultRandomGenerator randGen(0x5123);
+        {
+            BufferedStream stream(&memoryStream, 64);
+            SLANG_CHECK(!stream.isInMemory() && stream.readView(1) == nullptr);
+
+            Index offset = 0;
+            while (offset < data.getCount())
+            {
+                const Index size = Math::Min(Index(randGen.nextInt32UpTo(100)), data.getCount() - offset);
+                stream.Write(data.getBuffer() + offset, size);
+                offset += size;
+                SLANG_CHECK(stream.GetPosition() == offset);
+            }
+
+            // Patch the start, as the serializer does with sizes
+            const uint8_t patch = 0xff;
+            stream.Seek(SeekOrigin::Start, 0);
+            stream.Write(&patch, 1);
+            stream.Seek(SeekOrigin::End, 0);
+            SLANG_CHECK(stream.GetPosition() == data.getCount());
+        }
+        // Flushed when destroyed
+        SLANG_CHECK(memoryStream.m_contents.getCount() == data.getCount() && memoryStream.m_contents[0] == 0xff);
+        SLANG_CHECK(::memcmp(memoryStream.m_contents.getBuffer() + 1, data.getBuffer() + 1, data.getCount() - 1) == 0);
+
+        memoryStream.Seek(SeekOrigin::Start, 0);
+        BufferedStream stream(&memoryStream, 64);
+
+        List<uint8_t> readData;
+        readData.setCount(data.getCount());
+        Index offset = 0;
+        while (offset < data.getCount())
+        {
+            const Index size = Math::Min(Index(randGen.nextInt32UpTo(100)), data.getCount() - offset);
+            SLANG_CHECK(stream.Read(readData.getBuffer() + offset, size) == size);
+            offset += size;
+            SLANG_CHECK(stream.GetPosition() == offset);
+        }
+        SLANG_CHECK(::memcmp(readData.getBuffer() + 1, data.getBuffer() + 1, data.getCount() - 1) == 0);
+
+        // Writing after reading writes at the read position, not the end of the buffered reads
+        stream.Seek(SeekOrigin::Start, 0);
+        uint8_t buffer[2];
+        stream.Read(buffer, 2);
+        stream.Write(buffer, 1);
+        stream.flush();
+        SLANG_CHECK(memoryStream.m_contents[2] == 0xff && memoryStream.GetPosition() == 3);
+
+        // A read that can only be partly satisfied returns what there is
+        stream.Seek(SeekOrigin::End, -3);
+        uint8_t tail[8];
+        SLANG_CHECK(stream.Read(tail, 8) == 3 && tail[2] == data.getLast());
+    }
+}
+
+SLANG_UNIT_TEST("Stream", streamUnitTest);
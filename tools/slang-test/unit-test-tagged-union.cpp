@@ -0,0 +1,65 @@
+// unit-test-tagged-union.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static const char kSource[] =
+    "interface IMaterial { float shade(float v); float gloss(); }\n"
+    "struct Matte : IMaterial { float albedo; float shade(float v) { return v * albedo; } float gloss() { return 0.0; } }\n"
+    "struct Glossy : IMaterial { float albedo; float g; float shade(float v) { return v * albedo + g; } float gloss() { return g; } }\n"
+    "IMaterial gMaterial;\n"
+    "RWStructuredBuffer<float> gOutput;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void computeMain(uint3 tid : SV_DispatchThreadID)\n"
+    "{\n"
+    "    gOutput[tid.x] = gMaterial.shade(tid.x) + gMaterial.gloss();\n"
+    "}\n";
+
+static String _compile(SlangSession* session, SlangOptimizationLevel level)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, SLANG_HLSL);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, "cs_5_0"));
+    spSetOptimizationLevel(request, level);
+
+    // Validation checks that the code extracting each case is in the function using it
+    const char* args[] = { "-validate-ir" };
+    spProcessCommandLineArguments(request, args, 1);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "tagged-union.slang", kSource);
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+    spSetTypeNameForGlobalExistentialTypeParam(request, 0, "__TaggedUnion(Matte, Glossy)");
+
+    String code;
+    if (SLANG_SUCCEEDED(spCompile(request)))
+    {
+        code = spGetEntryPointSource(request, entryPointIndex);
+    }
+    spDestroyCompileRequest(request);
+    return code;
+}
+
+static void taggedUnionUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    // Each case is extracted by both methods, so is extracted by a function shared by them
+    const String code = _compile(session, SLANG_OPTIMIZATION_LEVEL_NONE);
+    SLANG_CHECK(code.indexOf("Matte_0 extractTaggedUnionPayload") >= 0);
+    SLANG_CHECK(code.indexOf("Glossy_0 extractTaggedUnionPayload") >= 0);
+    SLANG_CHECK(code.indexOf("extractTaggedUnionPayload_2") < 0);
+
+    // The functions are small enough to be inlined again when optimizing
+    const String optimizedCode = _compile(session, SLANG_OPTIMIZATION_LEVEL_DEFAULT);
+    SLANG_CHECK(optimizedCode.getLength() > 0 && optimizedCode.indexOf("extractTaggedUnionPayload") < 0);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("TaggedUnion", taggedUnionUnitTest);
@@ -0,0 +1,99 @@
+// unit-test-test-discovery-index.cpp
+
+#include "../../source/core/slang-io.h"
+
+#include "test-context.h"
+#include "test-discovery-index.h"
+
+using namespace Slang;
+
+static bool _isEqual(const List<String>& a, const List<String>& b)
+{
+    if (a.getCount() != b.getCount())
+    {
+        return false;
+    }
+    for (Index i = 0; i < a.getCount(); ++i)
+    {
+        if (a[i] != b[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool _isEqual(const TestDiscoveryIndex::FileTests& a, const TestDiscoveryIndex::FileTests& b)
+{
+    if (a.result != b.result || a.tests.getCount() != b.tests.getCount())
+    {
+        return false;
+    }
+    for (Index i = 0; i < a.tests.getCount(); ++i)
+    {
+        const auto& testA = a.tests[i];
+        const auto& testB = b.tests[i];
+        if (testA.type != testB.type || !_isEqual(testA.categoryNames, testB.categoryNames) ||
+            testA.command != testB.command || !_isEqual(testA.args, testB.args))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testDiscoveryIndexUnitTest()
+{
+    const String testPath("test-discovery-index-unit-test.slang");
+    const String indexPath("test-discovery-index-unit-test.index");
+    File::writeAllText(testPath, "//TEST(smoke,compute):COMPARE_COMPUTE:-cpu\n");
+
+    TestDiscoveryIndex::FileTests tests;
+    {
+        TestDiscoveryIndex::Test test;
+        test.type = 1;
+        test.categoryNames.add("smoke");
+        test.categoryNames.add("compute");
+        test.command = "COMPARE_COMPUTE";
+        test.args.add("-cpu");
+        tests.tests.add(test);
+
+        // A test without categories or args
+        TestDiscoveryIndex::Test otherTest;
+        otherTest.command = "SIMPLE";
+        tests.tests.add(otherTest);
+    }
+
+    TestDiscoveryIndex index;
+    TestDiscoveryIndex::FileTests foundTests;
+
+    // Files are found once added
+    SLANG_CHECK(!index.find(testPath, foundTests));
+    index.add(testPath, tests);
+    SLANG_CHECK(index.isChanged() && index.find(testPath, foundTests) && _isEqual(foundTests, tests));
+
+    // And once written, by an index that reads it
+    SLANG_CHECK(SLANG_SUCCEEDED(index.write(indexPath)) && !index.isChanged());
+    {
+        TestDiscoveryIndex readIndex;
+        SLANG_CHECK(SLANG_SUCCEEDED(readIndex.read(indexPath)) && !readIndex.isChanged());
+        SLANG_CHECK(readIndex.find(testPath, foundTests) && _isEqual(foundTests, tests) && readIndex.getHitCount() == 1);
+        SLANG_CHECK(!readIndex.find("test-discovery-index-unit-test-missing.slang", foundTests));
+    }
+
+    // A changed file isn't found
+    File::writeAllText(testPath, "//TEST(smoke,compute):COMPARE_COMPUTE:-cpu -xslang -DCHANGED\n");
+    SLANG_CHECK(!index.find(testPath, foundTests));
+
+    // A file that isn't an index isn't read
+    File::writeAllText(indexPath, "not an index\n");
+    {
+        TestDiscoveryIndex readIndex;
+        SLANG_CHECK(SLANG_FAILED(readIndex.read(indexPath)));
+    }
+
+    File::remove(testPath);
+    File::remove(indexPath);
+}
+
+SLANG_UNIT_TEST("TestDiscoveryIndex", testDiscoveryIndexUnitTest);
@@ -0,0 +1,173 @@
+// unit-test-uint-set.cpp
+
+#include "../../source/core/slang-uint-set.h"
+
+#include "test-context.h"
+
+#include "../../source/core/slang-random-generator.h"
+#include "../../source/core/slang-list.h"
+
+using namespace Slang;
+
+    /// Make a random set of values below size, returning it as a set and as a bool per value
+static UIntSet _makeSet(DefaultRandomGenerator& randGen, Index size, int density, List<bool>& outFlags)
+{
+    UIntSet set;
+    outFlags.setCount(size);
+    for (Index i = 0; i < size; ++i)
+    {
+        outFlags[i] = randGen.nextInt32UpTo(100) < density;
+        if (outFlags[i])
+        {
+            set.add(UInt(i));
+        }
+    }
+    return set;
+}
+
+    /// True if set holds exactly the values flagged in flags
+static bool _matches(const UIntSet& set, const List<bool>& flags)
+{
+    Index count = 0;
+    for (Index i = 0; i < flags.getCount(); ++i)
+    {
+        if (set.contains(UInt(i)) != flags[i])
+        {
+            return false;
+        }
+        count += Index(flags[i]);
+    }
+    if (set.countValues() != count)
+    {
+        return false;
+    }
+
+    // Visiting the values finds them in order
+    Index visitedCount = 0;
+    Index prev = -1;
+    for (Index v = set.findNext(0); v >= 0; v = set.findNext(UInt(v + 1)))
+    {
+        if (v <= prev || v >= flags.getCount() || !flags[v])
+        {
+            return false;
+        }
+        prev = v;
+        visitedCount++;
+    }
+    if (visitedCount != count)
+    {
+        return false;
+    }
+
+    // And iterating over the set finds the same values
+    visitedCount = 0;
+    prev = -1;
+    for (auto v : set)
+    {
+        if (Index(v) != set.findNext(UInt(prev + 1)))
+        {
+            return false;
+        }
+        prev = Index(v);
+        visitedCount++;
+    }
+    return visitedCount == count;
+}
+
+static void _checkOps(DefaultRandomGenerator& randGen, Index sizeA, Index sizeB, int density)
+{
+    List<bool> flagsA, flagsB;
+    const UIntSet a = _makeSet(randGen, sizeA, density, flagsA);
+    const UIntSet b = _makeSet(randGen, sizeB, density, flagsB);
+    SLANG_CHECK(_matches(a, flagsA) && _matches(b, flagsB));
+
+    const Index maxSize = Math::Max(sizeA, sizeB);
+    List<bool> unionFlags, intersectFlags, subtractFlags;
+    for (Index i = 0; i < maxSize; ++i)
+    {
+        const bool inA = i < sizeA && flagsA[i];
+        const bool inB = i < sizeB && flagsB[i];
+        unionFlags.add(inA || inB);
+        intersectFlags.add(inA && inB);
+        subtractFlags.add(inA && !inB);
+    }
+
+    UIntSet result;
+    UIntSet::calcUnion(result, a, b);
+    SLANG_CHECK(_matches(result, unionFlags));
+    UIntSet::calcIntersection(result, a, b);
+    SLANG_CHECK(_matches(result, intersectFlags));
+    UIntSet::calcSubtract(result, a, b);
+    SLANG_CHECK(_matches(result, subtractFlags));
+
+    // In place, and with the result being one of the inputs
+    result = a;
+    result.unionWith(b);
+    SLANG_CHECK(_matches(result, unionFlags));
+    result = a;
+    result.intersectWith(b);
+    SLANG_CHECK(_matches(result, intersectFlags));
+    result = a;
+    result.subtractWith(b);
+    SLANG_CHECK(_matches(result, subtractFlags));
+
+    result = b;
+    UIntSet::calcUnion(result, a, result);
+    SLANG_CHECK(_matches(result, unionFlags));
+    result = a;
+    UIntSet::calcSubtract(result, result, b);
+    SLANG_CHECK(_matches(result, subtractFlags));
+
+    // Sets are equal regardless of the size of their storage
+    UIntSet padded = a;
+    padded.resize(UInt(sizeA + 300));
+    SLANG_CHECK(padded == a && a == padded);
+    padded.add(UInt(sizeA + 200));
+    SLANG_CHECK(padded != a && a != padded);
+}
+
+static void uintSetUnitTest()
+{
+    DefaultRandomGenerator randGen(0x7a3c91e5);
+
+    {
+        UIntSet set;
+        SLANG_CHECK(set.countValues() == 0 && set.findNext(0) == -1);
+        set.add(1000);
+        SLANG_CHECK(set.countValues() == 1 && set.findNext(0) == 1000 && set.findNext(1000) == 1000 && set.findNext(1001) == -1);
+        SLANG_CHECK(set.findNext(100000) == -1);
+        SLANG_CHECK(*set.begin() == 1000 && !(++set.begin() != set.end()));
+        set.remove(1000);
+        SLANG_CHECK(set.countValues() == 0 && set.findNext(0) == -1 && !(set.begin() != set.end()));
+    }
+
+    // Values on an element boundary need the element after the ones already held
+    {
+        UIntSet set;
+        for (UInt val : { 0, 32, 64, 65, 96, 160 })
+        {
+            SLANG_CHECK(!set.contains(val));
+            set.add(val);
+            SLANG_CHECK(set.contains(val) && !set.contains(val + 1) && !set.contains(val + 32));
+        }
+        SLANG_CHECK(set.countValues() == 6);
+
+        UIntSet single;
+        single.add(64);
+        SLANG_CHECK(single.contains(64) && !single.contains(63) && !single.contains(96));
+    }
+
+    // Sizes either side of the 128 and 256 bit vector sizes, and large enough to use the vector loops
+    const Index sizes[] = { 1, 31, 32, 33, 127, 129, 255, 257, 1000, 4099 };
+    for (auto sizeA : sizes)
+    {
+        for (auto sizeB : sizes)
+        {
+            _checkOps(randGen, sizeA, sizeB, 50);
+            // Sparse sets have long runs of zero elements
+            _checkOps(randGen, sizeA, sizeB, 1);
+        }
+    }
+}
+
+SLANG_UNIT_TEST("UIntSet", uintSetUnitTest);
@@ -0,0 +1,122 @@
+// unit-test-used-parameters.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+static Index _findParameter(slang::ProgramLayout* reflection, char const* name)
+{
+    for (unsigned i = 0; i < reflection->getParameterCount(); ++i)
+    {
+        if (strcmp(reflection->getParameterByIndex(i)->getName(), name) == 0)
+            return Index(i);
+    }
+    return -1;
+}
+
+static bool _isUsed(slang::EntryPointReflection* entryPoint, Index parameterIndex)
+{
+    int used = 0;
+    SLANG_CHECK(SLANG_SUCCEEDED(entryPoint->isGlobalParameterUsed(SlangUInt(parameterIndex), &used)));
+    return used != 0;
+}
+
+static void _checkUsedParameters(SlangSession* session, SlangCompileTarget target, char const* profile)
+{
+    static const char source[] =
+        "struct Material { float4 color; Texture2D albedo; };\n"
+        "struct View { float4x4 viewProjection; Texture2D shadows; };\n"
+        "ConstantBuffer<Material> gMaterial;\n"
+        "ParameterBlock<View> gView;\n"
+        "Texture2D gUnusedTexture;\n"
+        "SamplerState gSampler;\n"
+        "RWStructuredBuffer<float> gOutput;\n"
+        "float unusedHelper() { return gUnusedTexture.Load(int3(0, 0, 0)).x; }\n"
+        "float shadow(Texture2D t) { return t.SampleLevel(gSampler, float2(0, 0), 0).x; }\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeMaterial(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = gMaterial.color.x;\n"
+        "}\n"
+        "[numthreads(4, 1, 1)]\n"
+        "void computeShadow(uint3 tid : SV_DispatchThreadID)\n"
+        "{\n"
+        "    gOutput[tid.x] = shadow(gView.shadows);\n"
+        "}\n";
+
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, target);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, profile));
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "used-parameters.slang", source);
+    spAddEntryPoint(request, translationUnitIndex, "computeMaterial", SLANG_STAGE_COMPUTE);
+    spAddEntryPoint(request, translationUnitIndex, "computeShadow", SLANG_STAGE_COMPUTE);
+
+    SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+    auto reflection = slang::ProgramLayout::get(request);
+    const Index material = _findParameter(reflection, "gMaterial");
+    const Index view = _findParameter(reflection, "gView");
+    const Index unusedTexture = _findParameter(reflection, "gUnusedTexture");
+    const Index sampler = _findParameter(reflection, "gSampler");
+    const Index output = _findParameter(reflection, "gOutput");
+    SLANG_CHECK(material >= 0 && view >= 0 && unusedTexture >= 0 && sampler >= 0 && output >= 0);
+
+    SLANG_CHECK(reflection->getEntryPointCount() == 2);
+    auto materialEntryPoint = reflection->getEntryPointByIndex(0);
+    auto shadowEntryPoint = reflection->getEntryPointByIndex(1);
+
+    SLANG_CHECK(_isUsed(materialEntryPoint, material));
+    SLANG_CHECK(!_isUsed(materialEntryPoint, view));
+    SLANG_CHECK(!_isUsed(materialEntryPoint, unusedTexture));
+    SLANG_CHECK(!_isUsed(materialEntryPoint, sampler));
+    SLANG_CHECK(_isUsed(materialEntryPoint, output));
+
+    // A parameter is used if any part of it is, even after it is split apart
+    SLANG_CHECK(!_isUsed(shadowEntryPoint, material));
+    SLANG_CHECK(_isUsed(shadowEntryPoint, view));
+    SLANG_CHECK(!_isUsed(shadowEntryPoint, unusedTexture));
+    SLANG_CHECK(_isUsed(shadowEntryPoint, sampler));
+    SLANG_CHECK(_isUsed(shadowEntryPoint, output));
+
+    uint32_t mask = 0;
+    SLANG_CHECK(SLANG_SUCCEEDED(shadowEntryPoint->getUsedGlobalParameterMask(1, &mask)));
+    SLANG_CHECK(mask == ((1u << view) | (1u << sampler) | (1u << output)));
+
+    spDestroyCompileRequest(request);
+}
+
+static void usedParametersUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    _checkUsedParameters(session, SLANG_HLSL, "cs_5_1");
+    _checkUsedParameters(session, SLANG_GLSL, "glsl_450");
+
+    // Without generating code, whether parameters are used isn't known
+    {
+        SlangCompileRequest* request = spCreateCompileRequest(session);
+        spAddCodeGenTarget(request, SLANG_HLSL);
+        spSetCompileFlags(request, SLANG_COMPILE_FLAG_NO_CODEGEN);
+        const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+        spAddTranslationUnitSourceString(request, translationUnitIndex, "no-codegen.slang",
+            "RWStructuredBuffer<float> gOutput;\n"
+            "[numthreads(4, 1, 1)] void computeMain(uint3 tid : SV_DispatchThreadID) { gOutput[tid.x] = 1; }\n");
+        spAddEntryPoint(request, translationUnitIndex, "computeMain", SLANG_STAGE_COMPUTE);
+        SLANG_CHECK(SLANG_SUCCEEDED(spCompile(request)));
+
+        int used = 0;
+        auto entryPoint = slang::ProgramLayout::get(request)->getEntryPointByIndex(0);
+        SLANG_CHECK(entryPoint->isGlobalParameterUsed(0, &used) == SLANG_E_NOT_AVAILABLE);
+
+        spDestroyCompileRequest(request);
+    }
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("UsedParameters", usedParametersUnitTest);
@@ -0,0 +1,65 @@
+// unit-test-wrapped-buffer-layout.cpp
+
+#include "../../slang.h"
+
+#include "../../source/core/slang-basic.h"
+
+#include "test-context.h"
+
+using namespace Slang;
+
+// `gParams` is legalized to a wrapped buffer, whose texture is placed after the other parameters
+static const char kSource[] =
+    "interface IShading { float shade(float v); }\n"
+    "struct Tinted : IShading { float tint; Texture2D<float> tex; float shade(float v) { return v * tint + tex.Load(int3(0, 0, 0)); } }\n"
+    "struct Params { float scale; IShading shading; }\n"
+    "ConstantBuffer<Params> gParams;\n"
+    "RWStructuredBuffer<float> gOutput;\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void mainA(uint3 tid : SV_DispatchThreadID) { gOutput[tid.x] = gParams.shading.shade(tid.x) * gParams.scale; }\n"
+    "[numthreads(4, 1, 1)]\n"
+    "void mainB(uint3 tid : SV_DispatchThreadID) { gOutput[tid.x] = gParams.shading.shade(tid.x + 1) + gParams.scale; }\n";
+
+static String _compile(SlangSession* session, SlangCompileTarget target, char const* profile, bool includeFirstEntryPoint)
+{
+    SlangCompileRequest* request = spCreateCompileRequest(session);
+    const int targetIndex = spAddCodeGenTarget(request, target);
+    spSetTargetProfile(request, targetIndex, spFindProfile(session, profile));
+    spSetLineDirectiveMode(request, SLANG_LINE_DIRECTIVE_MODE_NONE);
+
+    const int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "wrapped-buffer-layout.slang", kSource);
+    if (includeFirstEntryPoint)
+    {
+        spAddEntryPoint(request, translationUnitIndex, "mainA", SLANG_STAGE_COMPUTE);
+    }
+    const int entryPointIndex = spAddEntryPoint(request, translationUnitIndex, "mainB", SLANG_STAGE_COMPUTE);
+    spSetTypeNameForGlobalExistentialTypeParam(request, 0, "Tinted");
+
+    String code;
+    if (SLANG_SUCCEEDED(spCompile(request)))
+    {
+        code = spGetEntryPointSource(request, entryPointIndex);
+    }
+    spDestroyCompileRequest(request);
+    return code;
+}
+
+static void wrappedBufferLayoutUnitTest()
+{
+    SlangSession* session = spCreateSession(nullptr);
+
+    // The second entry point reuses the layout created for the first (which has other
+    // IR keys for the fields), and gets the same code as when it is compiled on its own
+    const String glsl = _compile(session, SLANG_GLSL, "glsl_450", true);
+    SLANG_CHECK(glsl.getLength() > 0 && glsl == _compile(session, SLANG_GLSL, "glsl_450", false));
+    SLANG_CHECK(glsl.indexOf("layout(binding = 2)\nuniform texture2D") >= 0);
+
+    const String hlsl = _compile(session, SLANG_HLSL, "cs_5_0", true);
+    SLANG_CHECK(hlsl.getLength() > 0 && hlsl == _compile(session, SLANG_HLSL, "cs_5_0", false));
+    SLANG_CHECK(hlsl.indexOf("register(t0)") >= 0);
+
+    spDestroySession(session);
+}
+
+SLANG_UNIT_TEST("WrappedBufferLayout", wrappedBufferLayoutUnitTest);